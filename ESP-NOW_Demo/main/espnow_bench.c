@@ -0,0 +1,367 @@
+/**
+ * @file espnow_bench.c
+ * @brief ESP-NOW airtime benchmark across PHY rates and payload sizes.
+ *
+ * Probes are sent at the rate under test. Report requests and reports are
+ * sent at the driver default rate, so the results of a step still arrive
+ * when the rate under test does not reach the receiver at all.
+ */
+
+#include "espnow_bench.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "espnow_rate.h"
+
+static const char *TAG = "espnow_bench";
+
+#define BENCH_VERSION           1
+#define BENCH_MSG_PROBE         4
+#define BENCH_MSG_REPORT_REQ    5
+#define BENCH_MSG_REPORT        6
+
+#define BENCH_SEND_TIMEOUT_MS   200     // Longest wait for one send callback
+#define BENCH_REPORT_TRIES      5
+#define BENCH_REPORT_WAIT_MS    100
+#define BENCH_QUEUE_LEN         4
+
+/** Probe header; the rest of the frame is filler up to the payload size. */
+typedef struct __attribute__((packed)) {
+    uint8_t  version;
+    uint8_t  msg_type;
+    uint16_t step;
+    uint16_t seq;
+} bench_probe_t;
+
+/** Report request (sender to receiver) and report (receiver to sender). */
+typedef struct __attribute__((packed)) {
+    uint8_t  version;
+    uint8_t  msg_type;
+    uint16_t step;
+    uint16_t received;      // Probes of this step that arrived
+    int8_t   rssi_avg;
+    int8_t   rssi_min;
+    int8_t   rssi_max;
+} bench_report_t;
+
+typedef struct {
+    uint8_t src_mac[6];
+    uint16_t step;
+} bench_request_t;
+
+static const uint8_t s_payload_sizes[] = { 32, 128, ESP_NOW_MAX_DATA_LEN };
+
+static QueueHandle_t s_request_queue = NULL;
+static QueueHandle_t s_report_queue = NULL;
+static SemaphoreHandle_t s_send_done = NULL;
+static volatile esp_now_send_status_t s_send_status = ESP_NOW_SEND_SUCCESS;
+static uint8_t s_channel = 1;
+
+// Receiver counters of the current step; written by the Wi-Fi task.
+static portMUX_TYPE s_count_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint16_t s_rx_step = UINT16_MAX;
+static uint16_t s_rx_count = 0;
+static int32_t s_rx_rssi_sum = 0;
+static int8_t s_rx_rssi_min = 0;
+static int8_t s_rx_rssi_max = 0;
+
+static uint32_t s_latency_us[ESPNOW_BENCH_MAX_PROBES];
+
+esp_err_t espnow_bench_init(uint8_t channel)
+{
+    s_channel = channel;
+    s_request_queue = xQueueCreate(BENCH_QUEUE_LEN, sizeof(bench_request_t));
+    s_report_queue = xQueueCreate(BENCH_QUEUE_LEN, sizeof(bench_report_t));
+    s_send_done = xSemaphoreCreateBinary();
+    if (!s_request_queue || !s_report_queue || !s_send_done) {
+        ESP_LOGE(TAG, "Failed to create benchmark queues");
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+bool espnow_bench_handle_rx(const esp_now_recv_info_t *info, const uint8_t *data, int len)
+{
+    if (len < 2 || data[0] != BENCH_VERSION ||
+        data[1] < BENCH_MSG_PROBE || data[1] > BENCH_MSG_REPORT) {
+        return false;
+    }
+
+    if (!s_request_queue || !s_report_queue) {
+        return true;
+    }
+
+    if (data[1] == BENCH_MSG_PROBE && (size_t)len >= sizeof(bench_probe_t)) {
+        bench_probe_t probe;
+        memcpy(&probe, data, sizeof(probe));
+        const int8_t rssi = (int8_t)info->rx_ctrl->rssi;
+
+        portENTER_CRITICAL(&s_count_lock);
+        if (probe.step != s_rx_step) {
+            s_rx_step = probe.step;
+            s_rx_count = 0;
+            s_rx_rssi_sum = 0;
+            s_rx_rssi_min = rssi;
+            s_rx_rssi_max = rssi;
+        }
+        s_rx_count++;
+        s_rx_rssi_sum += rssi;
+        if (rssi < s_rx_rssi_min) {
+            s_rx_rssi_min = rssi;
+        }
+        if (rssi > s_rx_rssi_max) {
+            s_rx_rssi_max = rssi;
+        }
+        portEXIT_CRITICAL(&s_count_lock);
+    } else if ((size_t)len == sizeof(bench_report_t)) {
+        bench_report_t msg;
+        memcpy(&msg, data, sizeof(msg));
+
+        if (msg.msg_type == BENCH_MSG_REPORT_REQ) {
+            bench_request_t req = { .step = msg.step };
+            memcpy(req.src_mac, info->src_addr, 6);
+            (void)xQueueSend(s_request_queue, &req, 0);
+        } else if (msg.msg_type == BENCH_MSG_REPORT) {
+            (void)xQueueSend(s_report_queue, &msg, 0);
+        }
+    }
+    return true;
+}
+
+void espnow_bench_handle_send_done(esp_now_send_status_t status)
+{
+    s_send_status = status;
+    if (s_send_done) {
+        (void)xSemaphoreGive(s_send_done);
+    }
+}
+
+/**
+ * @brief Ask the receiver how many probes of a step arrived.
+ *
+ * Args:
+ *   peer_mac: Receiver MAC.
+ *   step: Step number.
+ *   report: Output report.
+ *
+ * Returns:
+ *   esp_err_t: ESP_OK if a report arrived, ESP_ERR_TIMEOUT otherwise.
+ */
+static esp_err_t bench_fetch_report(const uint8_t peer_mac[6], uint16_t step, bench_report_t *report)
+{
+    const bench_report_t req = {
+        .version = BENCH_VERSION,
+        .msg_type = BENCH_MSG_REPORT_REQ,
+        .step = step,
+    };
+
+    xQueueReset(s_report_queue);
+    for (int attempt = 0; attempt < BENCH_REPORT_TRIES; attempt++) {
+        (void)esp_now_send(peer_mac, (const uint8_t *)&req, sizeof(req));
+
+        const int64_t deadline = esp_timer_get_time() + BENCH_REPORT_WAIT_MS * 1000;
+        int64_t now;
+        while ((now = esp_timer_get_time()) < deadline) {
+            const TickType_t wait = pdMS_TO_TICKS((deadline - now) / 1000) + 1;
+            if (xQueueReceive(s_report_queue, report, wait) == pdTRUE && report->step == step) {
+                return ESP_OK;
+            }
+        }
+    }
+    return ESP_ERR_TIMEOUT;
+}
+
+/**
+ * @brief Sort helper for latency samples.
+ */
+static int bench_compare_u32(const void *a, const void *b)
+{
+    const uint32_t x = *(const uint32_t *)a;
+    const uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Run one step: send probes at one rate and size, then print the result.
+ *
+ * Args:
+ *   peer_mac: Receiver MAC.
+ *   rate: Rate under test.
+ *   size: Frame payload size in bytes.
+ *   step: Step number carried by the probes.
+ *   probes: Number of probes.
+ *   goodput_kbps: Output delivered payload rate in kbit/s.
+ */
+static void bench_run_step(const uint8_t peer_mac[6], const espnow_rate_t *rate, uint8_t size,
+                           uint16_t step, uint16_t probes, uint32_t *goodput_kbps)
+{
+    uint8_t frame[ESP_NOW_MAX_DATA_LEN];
+    bench_probe_t *probe = (bench_probe_t *)frame;
+    uint32_t acked = 0;
+    uint32_t samples = 0;
+
+    *goodput_kbps = 0;
+
+    esp_err_t err = espnow_rate_apply(peer_mac, rate);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "%-9s %3u  rate not supported: %s", rate->name, size, esp_err_to_name(err));
+        return;
+    }
+
+    memset(frame, 0xA5, sizeof(frame));
+    probe->version = BENCH_VERSION;
+    probe->msg_type = BENCH_MSG_PROBE;
+    probe->step = step;
+
+    (void)xSemaphoreTake(s_send_done, 0);
+    const int64_t start_us = esp_timer_get_time();
+
+    // One probe at a time, so each latency is the airtime of one frame
+    // including link-layer retries, not time spent queued behind others.
+    for (uint16_t seq = 0; seq < probes; seq++) {
+        probe->seq = seq;
+        const int64_t t0 = esp_timer_get_time();
+        if (esp_now_send(peer_mac, frame, size) != ESP_OK) {
+            vTaskDelay(1);
+            continue;
+        }
+        if (xSemaphoreTake(s_send_done, pdMS_TO_TICKS(BENCH_SEND_TIMEOUT_MS)) != pdTRUE) {
+            continue;
+        }
+        s_latency_us[samples++] = (uint32_t)(esp_timer_get_time() - t0);
+        if (s_send_status == ESP_NOW_SEND_SUCCESS) {
+            acked++;
+        }
+    }
+
+    const int64_t elapsed_us = esp_timer_get_time() - start_us;
+
+    // Back to the robust default rate for the report exchange.
+    (void)espnow_rate_apply(peer_mac, &espnow_rates[ESPNOW_RATE_DEFAULT_INDEX]);
+
+    bench_report_t report = {0};
+    if (bench_fetch_report(peer_mac, step, &report) != ESP_OK) {
+        ESP_LOGW(TAG, "%-9s %3u  no report from receiver", rate->name, size);
+        return;
+    }
+
+    uint32_t p[5] = {0};     // min, p50, p90, p99, max
+    if (samples > 0) {
+        qsort(s_latency_us, samples, sizeof(s_latency_us[0]), bench_compare_u32);
+        p[0] = s_latency_us[0];
+        p[1] = s_latency_us[samples * 50 / 100];
+        p[2] = s_latency_us[samples * 90 / 100];
+        p[3] = s_latency_us[samples * 99 / 100];
+        p[4] = s_latency_us[samples - 1];
+    }
+
+    const uint32_t loss_pct10 = (probes > report.received)
+                                    ? (uint32_t)(probes - report.received) * 1000U / probes
+                                    : 0;
+    const uint32_t pkt_per_s = (elapsed_us > 0)
+                                   ? (uint32_t)((uint64_t)report.received * 1000000ULL / (uint64_t)elapsed_us)
+                                   : 0;
+    *goodput_kbps = (elapsed_us > 0)
+                        ? (uint32_t)((uint64_t)report.received * size * 8000ULL / (uint64_t)elapsed_us)
+                        : 0;
+
+    ESP_LOGI(TAG, "%-9s %3u  %4u %4" PRIu32 " %4u %3" PRIu32 ".%" PRIu32 " %5" PRIu32 " %6" PRIu32
+             "  %5" PRIu32 " %5" PRIu32 " %5" PRIu32 " %5" PRIu32 " %5" PRIu32 "  %4d %4d %4d",
+             rate->name, size, probes, acked, report.received,
+             loss_pct10 / 10, loss_pct10 % 10, pkt_per_s, *goodput_kbps,
+             p[0], p[1], p[2], p[3], p[4],
+             report.received ? report.rssi_avg : 0,
+             report.received ? report.rssi_min : 0,
+             report.received ? report.rssi_max : 0);
+}
+
+esp_err_t espnow_bench_run(const uint8_t peer_mac[6], uint16_t probes)
+{
+    if (!peer_mac || probes == 0 || probes > ESPNOW_BENCH_MAX_PROBES) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_send_done) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    static uint16_t step = 0;
+    uint32_t best_kbps = 0;
+    size_t best_rate = 0;
+    uint8_t best_size = 0;
+
+    ESP_LOGI(TAG, "rate      size  sent  ack recv loss%%  pkt/s kbit/s"
+                  "    min   p50   p90   p99   max (us)  rssi avg/min/max");
+
+    for (size_t r = 0; r < espnow_rate_count; r++) {
+        for (size_t s = 0; s < sizeof(s_payload_sizes); s++) {
+            uint32_t kbps = 0;
+            bench_run_step(peer_mac, &espnow_rates[r], s_payload_sizes[s], step++, probes, &kbps);
+            if (kbps > best_kbps) {
+                best_kbps = kbps;
+                best_rate = r;
+                best_size = s_payload_sizes[s];
+            }
+        }
+    }
+
+    (void)espnow_rate_apply(peer_mac, &espnow_rates[ESPNOW_RATE_DEFAULT_INDEX]);
+
+    if (best_kbps > 0) {
+        ESP_LOGI(TAG, "Best goodput: %s with %u-byte frames, %" PRIu32 " kbit/s",
+                 espnow_rates[best_rate].name, best_size, best_kbps);
+    } else {
+        ESP_LOGW(TAG, "No step delivered any probe");
+    }
+    return ESP_OK;
+}
+
+void espnow_bench_serve(void)
+{
+    bench_request_t req;
+
+    while (1) {
+        if (xQueueReceive(s_request_queue, &req, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        // The sender must be a peer before we can answer it.
+        if (!esp_now_is_peer_exist(req.src_mac)) {
+            esp_now_peer_info_t peer = {0};
+            memcpy(peer.peer_addr, req.src_mac, 6);
+            peer.ifidx = WIFI_IF_STA;
+            peer.channel = s_channel;
+            peer.encrypt = false;
+            if (esp_now_add_peer(&peer) != ESP_OK) {
+                ESP_LOGW(TAG, "Failed to add sender as peer");
+                continue;
+            }
+        }
+
+        bench_report_t report = {
+            .version = BENCH_VERSION,
+            .msg_type = BENCH_MSG_REPORT,
+            .step = req.step,
+        };
+
+        portENTER_CRITICAL(&s_count_lock);
+        if (s_rx_step == req.step && s_rx_count > 0) {
+            report.received = s_rx_count;
+            report.rssi_avg = (int8_t)(s_rx_rssi_sum / s_rx_count);
+            report.rssi_min = s_rx_rssi_min;
+            report.rssi_max = s_rx_rssi_max;
+        }
+        portEXIT_CRITICAL(&s_count_lock);
+
+        (void)esp_now_send(req.src_mac, (const uint8_t *)&report, sizeof(report));
+    }
+}
@@ -0,0 +1,80 @@
+/**
+ * @file espnow_bench.h
+ * @brief ESP-NOW airtime benchmark across PHY rates and payload sizes.
+ *
+ * The sender steps through every entry of espnow_rates and several payload
+ * sizes. For each step it sends a burst of probe frames to the peer at that
+ * rate, one at a time, and times each send callback. The receiver counts the
+ * probes and their RSSI and returns the totals when asked. The sender then
+ * prints one line per step with delivery, loss, goodput, latency
+ * percentiles and RSSI, and finally the step with the highest goodput.
+ */
+
+#ifndef ESPNOW_BENCH_H
+#define ESPNOW_BENCH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_now.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Largest number of probes per step. */
+#define ESPNOW_BENCH_MAX_PROBES     1000
+
+/**
+ * @brief Create the queues used by the benchmark.
+ *
+ * Args:
+ *   channel: Wi-Fi channel, used when the receiver adds the sender as a peer.
+ *
+ * Returns:
+ *   esp_err_t: ESP_OK on success, ESP_ERR_NO_MEM otherwise.
+ */
+esp_err_t espnow_bench_init(uint8_t channel);
+
+/**
+ * @brief Pass a received frame to the benchmark.
+ *
+ * Call this from the ESP-NOW receive callback.
+ *
+ * Returns:
+ *   bool: true if the frame was a benchmark frame and has been consumed.
+ */
+bool espnow_bench_handle_rx(const esp_now_recv_info_t *info, const uint8_t *data, int len);
+
+/**
+ * @brief Report a completed send to the benchmark.
+ *
+ * Call this from the ESP-NOW send callback for every frame.
+ */
+void espnow_bench_handle_send_done(esp_now_send_status_t status);
+
+/**
+ * @brief Run one sweep over all rates and payload sizes and print the results.
+ *
+ * The peer's rate is left at the driver default afterwards.
+ *
+ * Args:
+ *   peer_mac: Receiver MAC. Must be a unicast peer that was already added.
+ *   probes: Probes per step, 1 to ESPNOW_BENCH_MAX_PROBES.
+ *
+ * Returns:
+ *   esp_err_t: ESP_OK when the sweep finished.
+ */
+esp_err_t espnow_bench_run(const uint8_t peer_mac[6], uint16_t probes);
+
+/**
+ * @brief Answer benchmark report requests. Never returns.
+ */
+void espnow_bench_serve(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPNOW_BENCH_H */
@@ -0,0 +1,566 @@
+/**
+ * @file espnow_bulk.c
+ * @brief Windowed ESP-NOW bulk transfer with selective retransmit.
+ *
+ * Frames from one peer are delivered in the order they were sent, so a chunk
+ * that is still missing when a later chunk has been ACKed was lost. Every
+ * transmission gets a stamp from a running counter; when an ACK covers a
+ * chunk with a higher stamp than a missing one, the missing chunk is resent
+ * right away. A chunk that is resent gets a new stamp, so it is not resent
+ * again until something sent after it has been ACKed. The ACK timeout only
+ * matters when ACKs themselves are lost.
+ */
+
+#include "espnow_bulk.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+
+#include "esp_log.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+
+static const char *TAG = "espnow_bulk";
+
+#define BULK_VERSION            1
+#define BULK_MSG_DATA           2
+#define BULK_MSG_ACK            3
+
+#define BULK_TX_CREDITS         8       // Frames handed to the Wi-Fi driver at once
+#define BULK_RX_QUEUE_LEN       32
+#define BULK_ACK_QUEUE_LEN      8
+#define BULK_ACK_EVERY          8       // In-order chunks per ACK
+#define BULK_ACK_DELAY_MS       10      // ACK pending chunks after this much silence
+#define BULK_RTO_MS             50      // Sender ACK timeout
+#define BULK_MAX_TIMEOUTS       40      // Consecutive ACK timeouts before giving up
+#define BULK_NO_MEM_RETRIES     10      // Ticks to wait for driver buffers
+
+/** Header of every data frame. The first two bytes match app_packet_t. */
+typedef struct __attribute__((packed)) {
+    uint8_t  version;
+    uint8_t  msg_type;
+    uint16_t transfer_id;
+    uint16_t seq;
+    uint16_t total_chunks;
+    uint32_t total_bytes;
+} bulk_data_hdr_t;
+
+/** ACK: every chunk below base is received; bit i of bitmap is chunk base + i. */
+typedef struct __attribute__((packed)) {
+    uint8_t  version;
+    uint8_t  msg_type;
+    uint16_t transfer_id;
+    uint16_t base;
+    uint64_t bitmap;
+} bulk_ack_t;
+
+#define BULK_CHUNK_SIZE         (ESP_NOW_MAX_DATA_LEN - sizeof(bulk_data_hdr_t))
+
+/** Frame copied out of the receive callback. */
+typedef struct {
+    uint8_t src_mac[6];
+    uint8_t len;
+    uint8_t data[ESP_NOW_MAX_DATA_LEN];
+} bulk_rx_item_t;
+
+/** Sender state of one chunk in the window. */
+typedef struct {
+    uint32_t stamp;         // Transmission counter value of the latest send
+    int64_t  first_send_us;
+    bool     acked;
+    bool     retx_pending;
+} bulk_chunk_t;
+
+static QueueHandle_t s_data_queue = NULL;
+static QueueHandle_t s_ack_queue = NULL;
+static SemaphoreHandle_t s_tx_credits = NULL;
+static uint8_t s_channel = 1;
+static volatile uint32_t s_send_failures = 0;
+
+static uint16_t s_next_transfer_id = 0;
+
+// Receiver memory of the last completed transfer, to re-ACK late retransmissions.
+static uint16_t s_done_id = 0;
+static uint16_t s_done_chunks = 0;
+static bool s_done_valid = false;
+
+/**
+ * @brief Send a frame once a transmit credit is free.
+ *
+ * Args:
+ *   mac: Destination MAC.
+ *   frame: Frame bytes.
+ *   len: Frame length.
+ *   wait: Ticks to wait for a credit.
+ *
+ * Returns:
+ *   esp_err_t: ESP_OK if the frame was queued, ESP_ERR_TIMEOUT if no credit
+ *   or driver buffer became free, otherwise the esp_now_send() error.
+ */
+static esp_err_t bulk_send_frame(const uint8_t mac[6], const void *frame, size_t len, TickType_t wait)
+{
+    if (xSemaphoreTake(s_tx_credits, wait) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    esp_err_t err = esp_now_send(mac, (const uint8_t *)frame, len);
+    for (int retry = 0; err == ESP_ERR_ESPNOW_NO_MEM && retry < BULK_NO_MEM_RETRIES; retry++) {
+        // The driver is short of buffers; give it a tick to drain.
+        vTaskDelay(1);
+        err = esp_now_send(mac, (const uint8_t *)frame, len);
+    }
+    if (err == ESP_ERR_ESPNOW_NO_MEM) {
+        err = ESP_ERR_TIMEOUT;
+    }
+
+    if (err != ESP_OK) {
+        // No send callback will follow, so return the credit here.
+        xSemaphoreGive(s_tx_credits);
+    }
+    return err;
+}
+
+esp_err_t espnow_bulk_init(uint8_t channel)
+{
+    s_channel = channel;
+    s_data_queue = xQueueCreate(BULK_RX_QUEUE_LEN, sizeof(bulk_rx_item_t));
+    s_ack_queue = xQueueCreate(BULK_ACK_QUEUE_LEN, sizeof(bulk_ack_t));
+    s_tx_credits = xSemaphoreCreateCounting(BULK_TX_CREDITS, BULK_TX_CREDITS);
+    if (!s_data_queue || !s_ack_queue || !s_tx_credits) {
+        ESP_LOGE(TAG, "Failed to create bulk transfer queues");
+        return ESP_ERR_NO_MEM;
+    }
+
+    s_next_transfer_id = (uint16_t)esp_random();
+    return ESP_OK;
+}
+
+bool espnow_bulk_handle_rx(const esp_now_recv_info_t *info, const uint8_t *data, int len)
+{
+    if (len < 2 || data[0] != BULK_VERSION ||
+        (data[1] != BULK_MSG_DATA && data[1] != BULK_MSG_ACK)) {
+        return false;
+    }
+
+    if (!s_data_queue || !s_ack_queue) {
+        return true;
+    }
+
+    if (data[1] == BULK_MSG_ACK) {
+        if ((size_t)len == sizeof(bulk_ack_t)) {
+            bulk_ack_t ack;
+            memcpy(&ack, data, sizeof(ack));
+            (void)xQueueSend(s_ack_queue, &ack, 0);
+        }
+        return true;
+    }
+
+    if ((size_t)len <= sizeof(bulk_data_hdr_t) || len > ESP_NOW_MAX_DATA_LEN) {
+        return true;
+    }
+
+    bulk_rx_item_t item;
+    memcpy(item.src_mac, info->src_addr, 6);
+    item.len = (uint8_t)len;
+    memcpy(item.data, data, (size_t)len);
+
+    // A frame dropped here is simply retransmitted later.
+    (void)xQueueSend(s_data_queue, &item, 0);
+    return true;
+}
+
+void espnow_bulk_handle_send_done(esp_now_send_status_t status)
+{
+    if (status != ESP_NOW_SEND_SUCCESS) {
+        s_send_failures++;
+    }
+
+    if (s_tx_credits) {
+        (void)xSemaphoreGive(s_tx_credits);
+    }
+}
+
+/**
+ * @brief Apply one ACK to the sender window.
+ *
+ * Args:
+ *   ack: Received ACK.
+ *   chunks: Window ring indexed by seq % ESPNOW_BULK_MAX_WINDOW.
+ *   base: In/out first unACKed chunk.
+ *   next_seq: First chunk never sent.
+ *   stats: Latency minimum and maximum.
+ *   latency_sum: In/out sum of latency samples.
+ *   latency_count: In/out number of latency samples.
+ */
+static void bulk_apply_ack(const bulk_ack_t *ack, bulk_chunk_t *chunks, uint16_t *base,
+                           uint16_t next_seq, espnow_bulk_stats_t *stats,
+                           uint64_t *latency_sum, uint32_t *latency_count)
+{
+    const int64_t now = esp_timer_get_time();
+    uint32_t newest_stamp = 0;
+    bool any_acked = false;
+
+    for (uint16_t seq = *base; seq < next_seq; seq++) {
+        bulk_chunk_t *chunk = &chunks[seq % ESPNOW_BULK_MAX_WINDOW];
+        const uint16_t rel = (uint16_t)(seq - ack->base);
+        const bool covered = (seq < ack->base) ||
+                             (rel < 64 && (ack->bitmap & (1ULL << rel)) != 0);
+        if (!covered) {
+            continue;
+        }
+
+        if (!any_acked || (int32_t)(chunk->stamp - newest_stamp) > 0) {
+            newest_stamp = chunk->stamp;
+        }
+        any_acked = true;
+
+        if (!chunk->acked) {
+            const uint32_t latency = (uint32_t)(now - chunk->first_send_us);
+            if (latency < stats->latency_min_us) {
+                stats->latency_min_us = latency;
+            }
+            if (latency > stats->latency_max_us) {
+                stats->latency_max_us = latency;
+            }
+            *latency_sum += latency;
+            (*latency_count)++;
+            chunk->acked = true;
+            chunk->retx_pending = false;
+        }
+    }
+
+    while (*base < next_seq && chunks[*base % ESPNOW_BULK_MAX_WINDOW].acked) {
+        (*base)++;
+    }
+
+    if (!any_acked) {
+        return;
+    }
+
+    // Anything sent before the newest ACKed frame and still missing was lost.
+    for (uint16_t seq = *base; seq < next_seq; seq++) {
+        bulk_chunk_t *chunk = &chunks[seq % ESPNOW_BULK_MAX_WINDOW];
+        if (!chunk->acked && (int32_t)(newest_stamp - chunk->stamp) > 0) {
+            chunk->retx_pending = true;
+        }
+    }
+}
+
+esp_err_t espnow_bulk_send(const uint8_t peer_mac[6], uint32_t total_bytes, uint16_t window,
+                           espnow_bulk_read_fn_t read_fn, void *arg, espnow_bulk_stats_t *stats)
+{
+    if (!peer_mac || !read_fn || total_bytes == 0 ||
+        window == 0 || window > ESPNOW_BULK_MAX_WINDOW) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_ack_queue) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const uint32_t chunk_count = (total_bytes + BULK_CHUNK_SIZE - 1) / BULK_CHUNK_SIZE;
+    if (chunk_count > UINT16_MAX) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    static bulk_chunk_t chunks[ESPNOW_BULK_MAX_WINDOW];
+    uint8_t frame[ESP_NOW_MAX_DATA_LEN];
+    bulk_data_hdr_t *hdr = (bulk_data_hdr_t *)frame;
+    espnow_bulk_stats_t local = {0};
+    uint64_t latency_sum = 0;
+    uint32_t latency_count = 0;
+    uint32_t stamp = 0;
+    uint32_t timeouts_in_row = 0;
+    uint16_t base = 0;
+    uint16_t next_seq = 0;
+    esp_err_t result = ESP_OK;
+
+    memset(chunks, 0, sizeof(chunks));
+    local.latency_min_us = UINT32_MAX;
+    local.chunks = chunk_count;
+
+    hdr->version = BULK_VERSION;
+    hdr->msg_type = BULK_MSG_DATA;
+    hdr->transfer_id = s_next_transfer_id++;
+    hdr->total_chunks = (uint16_t)chunk_count;
+    hdr->total_bytes = total_bytes;
+
+    xQueueReset(s_ack_queue);
+    const uint32_t failures_at_start = s_send_failures;
+    const int64_t start_us = esp_timer_get_time();
+    int64_t last_ack_us = start_us;
+
+    while (base < chunk_count) {
+        bulk_ack_t ack;
+
+        // Drain every ACK that arrived while sending.
+        while (xQueueReceive(s_ack_queue, &ack, 0) == pdTRUE) {
+            if (ack.transfer_id != hdr->transfer_id) {
+                continue;
+            }
+            local.acks++;
+            last_ack_us = esp_timer_get_time();
+            timeouts_in_row = 0;
+            bulk_apply_ack(&ack, chunks, &base, next_seq, &local, &latency_sum, &latency_count);
+        }
+        if (base >= chunk_count) {
+            break;
+        }
+
+        // Lost chunks go first, then new chunks while the window has room.
+        uint16_t seq = next_seq;
+        for (uint16_t s = base; s < next_seq; s++) {
+            if (chunks[s % ESPNOW_BULK_MAX_WINDOW].retx_pending) {
+                seq = s;
+                break;
+            }
+        }
+        const bool is_retx = (seq != next_seq);
+        const bool can_send = is_retx ||
+                              (next_seq < chunk_count && next_seq < base + window);
+
+        if (can_send) {
+            const uint32_t offset = (uint32_t)seq * BULK_CHUNK_SIZE;
+            const size_t len = (total_bytes - offset < BULK_CHUNK_SIZE)
+                                   ? (size_t)(total_bytes - offset)
+                                   : BULK_CHUNK_SIZE;
+            hdr->seq = seq;
+            read_fn(offset, frame + sizeof(*hdr), len, arg);
+
+            esp_err_t err = bulk_send_frame(peer_mac, frame, sizeof(*hdr) + len,
+                                            pdMS_TO_TICKS(BULK_RTO_MS));
+            if (err == ESP_OK) {
+                bulk_chunk_t *chunk = &chunks[seq % ESPNOW_BULK_MAX_WINDOW];
+                if (is_retx) {
+                    chunk->retx_pending = false;
+                    local.retransmits++;
+                } else {
+                    memset(chunk, 0, sizeof(*chunk));
+                    chunk->first_send_us = esp_timer_get_time();
+                    next_seq++;
+                }
+                chunk->stamp = ++stamp;
+                local.frames_sent++;
+                continue;
+            }
+            if (err != ESP_ERR_TIMEOUT) {
+                ESP_LOGE(TAG, "esp_now_send failed: %s", esp_err_to_name(err));
+                result = err;
+                break;
+            }
+        } else {
+            // Window full: wait for the next ACK.
+            const int64_t waited_ms = (esp_timer_get_time() - last_ack_us) / 1000;
+            const TickType_t wait = (waited_ms < BULK_RTO_MS)
+                                        ? pdMS_TO_TICKS(BULK_RTO_MS - waited_ms)
+                                        : 0;
+            if (wait > 0 && xQueuePeek(s_ack_queue, &ack, wait) == pdTRUE) {
+                continue;
+            }
+        }
+
+        if ((esp_timer_get_time() - last_ack_us) < (int64_t)BULK_RTO_MS * 1000) {
+            continue;
+        }
+
+        // No ACK for a whole timeout: the ACKs were lost or the tail of the
+        // window was. Resend everything not yet ACKed.
+        local.timeouts++;
+        if (++timeouts_in_row > BULK_MAX_TIMEOUTS) {
+            ESP_LOGE(TAG, "Receiver stopped answering at chunk %u of %" PRIu32,
+                     base, chunk_count);
+            result = ESP_ERR_TIMEOUT;
+            break;
+        }
+        for (uint16_t s = base; s < next_seq; s++) {
+            if (!chunks[s % ESPNOW_BULK_MAX_WINDOW].acked) {
+                chunks[s % ESPNOW_BULK_MAX_WINDOW].retx_pending = true;
+            }
+        }
+        last_ack_us = esp_timer_get_time();
+    }
+
+    if (stats) {
+        local.elapsed_us = esp_timer_get_time() - start_us;
+        local.bytes = (result == ESP_OK) ? total_bytes : (uint32_t)base * BULK_CHUNK_SIZE;
+        local.send_failures = s_send_failures - failures_at_start;
+        if (latency_count > 0) {
+            local.latency_avg_us = (uint32_t)(latency_sum / latency_count);
+        } else {
+            local.latency_min_us = 0;
+        }
+        *stats = local;
+    }
+    return result;
+}
+
+/**
+ * @brief Send an ACK if a transmit credit is free.
+ *
+ * A skipped ACK is harmless: the next one carries the same information.
+ */
+static void bulk_send_ack(const uint8_t mac[6], uint16_t transfer_id, uint16_t base,
+                          uint64_t bitmap, espnow_bulk_stats_t *stats)
+{
+    const bulk_ack_t ack = {
+        .version = BULK_VERSION,
+        .msg_type = BULK_MSG_ACK,
+        .transfer_id = transfer_id,
+        .base = base,
+        .bitmap = bitmap,
+    };
+
+    if (bulk_send_frame(mac, &ack, sizeof(ack), 0) == ESP_OK) {
+        stats->acks++;
+    }
+}
+
+/**
+ * @brief Add the sender as a peer so ACKs can be sent back.
+ */
+static void bulk_ensure_peer(const uint8_t mac[6])
+{
+    if (esp_now_is_peer_exist(mac)) {
+        return;
+    }
+
+    esp_now_peer_info_t peer = {0};
+    memcpy(peer.peer_addr, mac, 6);
+    peer.ifidx = WIFI_IF_STA;
+    peer.channel = s_channel;
+    peer.encrypt = false;
+
+    esp_err_t err = esp_now_add_peer(&peer);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Failed to add sender as peer: %s", esp_err_to_name(err));
+    }
+}
+
+esp_err_t espnow_bulk_receive(espnow_bulk_write_fn_t write_fn, void *arg, espnow_bulk_stats_t *stats)
+{
+    if (!write_fn) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_data_queue) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    static bulk_rx_item_t item;
+    espnow_bulk_stats_t local = {0};
+    uint8_t sender[6] = {0};
+    bool active = false;
+    uint16_t transfer_id = 0;
+    uint16_t total_chunks = 0;
+    uint32_t total_bytes = 0;
+    uint16_t base = 0;
+    uint64_t bitmap = 0;          // Bit i: chunk base + i received; bit 0 stays clear
+    int32_t highest = -1;
+    uint32_t unacked = 0;
+    int64_t start_us = 0;
+
+    while (true) {
+        const TickType_t wait = (unacked > 0) ? pdMS_TO_TICKS(BULK_ACK_DELAY_MS) : portMAX_DELAY;
+
+        if (xQueueReceive(s_data_queue, &item, wait) != pdTRUE) {
+            // The sender went quiet; report what has arrived.
+            bulk_send_ack(sender, transfer_id, base, bitmap, &local);
+            unacked = 0;
+            continue;
+        }
+
+        bulk_data_hdr_t hdr;
+        memcpy(&hdr, item.data, sizeof(hdr));
+        if (hdr.msg_type != BULK_MSG_DATA || hdr.total_chunks == 0) {
+            continue;
+        }
+
+        const size_t payload_len = item.len - sizeof(hdr);
+        const uint8_t *payload = item.data + sizeof(hdr);
+
+        if (s_done_valid && hdr.transfer_id == s_done_id) {
+            // Our final ACK was lost; confirm the finished transfer again.
+            bulk_ensure_peer(item.src_mac);
+            bulk_send_ack(item.src_mac, s_done_id, s_done_chunks, 0, &local);
+            continue;
+        }
+
+        if (!active || hdr.transfer_id != transfer_id ||
+            memcmp(item.src_mac, sender, 6) != 0) {
+            if (active) {
+                ESP_LOGW(TAG, "Transfer %u abandoned at chunk %u of %u",
+                         transfer_id, base, total_chunks);
+            }
+            memcpy(sender, item.src_mac, 6);
+            bulk_ensure_peer(sender);
+            memset(&local, 0, sizeof(local));
+            active = true;
+            transfer_id = hdr.transfer_id;
+            total_chunks = hdr.total_chunks;
+            total_bytes = hdr.total_bytes;
+            base = 0;
+            bitmap = 0;
+            highest = -1;
+            unacked = 0;
+            start_us = esp_timer_get_time();
+        }
+
+        const uint16_t seq = hdr.seq;
+        const uint16_t rel = (uint16_t)(seq - base);
+        const uint32_t offset = (uint32_t)seq * BULK_CHUNK_SIZE;
+        const size_t expected_len = (total_bytes - offset < BULK_CHUNK_SIZE)
+                                        ? (size_t)(total_bytes - offset)
+                                        : BULK_CHUNK_SIZE;
+        bool ack_now = false;
+
+        if (seq >= total_chunks || payload_len != expected_len) {
+            continue;
+        }
+
+        if (seq < base || (rel < 64 && (bitmap & (1ULL << rel)) != 0)) {
+            // A retransmission of something we have: the sender missed an ACK.
+            local.duplicates++;
+            ack_now = true;
+        } else if (rel >= 64) {
+            // Beyond what one ACK can describe; the sender will resend it.
+            ack_now = true;
+        } else {
+            write_fn(offset, payload, payload_len, arg);
+            local.bytes += payload_len;
+            bitmap |= 1ULL << rel;
+            while (bitmap & 1ULL) {
+                bitmap >>= 1;
+                base++;
+            }
+
+            // A gap means frames were lost; tell the sender at once.
+            if ((int32_t)seq != highest + 1) {
+                ack_now = true;
+            }
+            if ((int32_t)seq > highest) {
+                highest = seq;
+            }
+            unacked++;
+        }
+
+        if (base >= total_chunks) {
+            local.chunks = total_chunks;
+            local.elapsed_us = esp_timer_get_time() - start_us;
+            bulk_send_ack(sender, transfer_id, base, 0, &local);
+            s_done_id = transfer_id;
+            s_done_chunks = total_chunks;
+            s_done_valid = true;
+            if (stats) {
+                *stats = local;
+            }
+            return ESP_OK;
+        }
+
+        if (ack_now || unacked >= BULK_ACK_EVERY) {
+            bulk_send_ack(sender, transfer_id, base, bitmap, &local);
+            unacked = 0;
+        }
+    }
+}
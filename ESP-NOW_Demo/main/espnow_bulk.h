@@ -0,0 +1,138 @@
+/**
+ * @file espnow_bulk.h
+ * @brief Windowed ESP-NOW bulk transfer with selective retransmit.
+ *
+ * A transfer is split into numbered chunks that fill one ESP-NOW frame each.
+ * The sender keeps up to a window of chunks in flight instead of waiting for
+ * every send callback. The receiver answers with an ACK that carries the
+ * first missing chunk and a bitmap of the chunks received after it, so the
+ * sender resends only the chunks that were lost.
+ */
+
+#ifndef ESPNOW_BULK_H
+#define ESPNOW_BULK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_now.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Largest number of chunks the sender may keep in flight. */
+#define ESPNOW_BULK_MAX_WINDOW  64
+
+/**
+ * @brief Supplies transfer data to the sender.
+ *
+ * Called once for every transmission of a chunk, including retransmissions,
+ * so the data does not need to stay in RAM.
+ *
+ * Args:
+ *   offset: Byte offset of the chunk in the transfer.
+ *   buf: Output buffer.
+ *   len: Number of bytes to copy into buf.
+ *   arg: User argument passed to espnow_bulk_send().
+ */
+typedef void (*espnow_bulk_read_fn_t)(uint32_t offset, uint8_t *buf, size_t len, void *arg);
+
+/**
+ * @brief Delivers received data to the application.
+ *
+ * Every chunk is delivered exactly once, but chunks that were retransmitted
+ * arrive after later ones, so offsets are not always increasing.
+ *
+ * Args:
+ *   offset: Byte offset of the chunk in the transfer.
+ *   data: Chunk payload.
+ *   len: Payload length in bytes.
+ *   arg: User argument passed to espnow_bulk_receive().
+ */
+typedef void (*espnow_bulk_write_fn_t)(uint32_t offset, const uint8_t *data, size_t len, void *arg);
+
+/** Transfer statistics. Fields that do not apply to a role stay zero. */
+typedef struct {
+    uint32_t bytes;             /**< Payload bytes transferred. */
+    uint32_t chunks;            /**< Chunks in the transfer. */
+    int64_t  elapsed_us;        /**< First frame to last ACK (sender) or last chunk (receiver). */
+    uint32_t frames_sent;       /**< Data frames sent, including retransmissions. */
+    uint32_t retransmits;       /**< Data frames sent again. */
+    uint32_t timeouts;          /**< ACK timeouts at the sender. */
+    uint32_t send_failures;     /**< Frames reported as failed by the send callback. */
+    uint32_t acks;              /**< ACKs received (sender) or sent (receiver). */
+    uint32_t duplicates;        /**< Chunks received more than once. */
+    uint32_t latency_min_us;    /**< Shortest time from first send to ACK of a chunk. */
+    uint32_t latency_avg_us;    /**< Average time from first send to ACK of a chunk. */
+    uint32_t latency_max_us;    /**< Longest time from first send to ACK of a chunk. */
+} espnow_bulk_stats_t;
+
+/**
+ * @brief Create the queues used by the bulk transfer.
+ *
+ * Must be called before any bulk frame can arrive.
+ *
+ * Args:
+ *   channel: Wi-Fi channel, used when the receiver adds the sender as a peer.
+ *
+ * Returns:
+ *   esp_err_t: ESP_OK on success, ESP_ERR_NO_MEM otherwise.
+ */
+esp_err_t espnow_bulk_init(uint8_t channel);
+
+/**
+ * @brief Pass a received frame to the bulk transfer.
+ *
+ * Call this first from the ESP-NOW receive callback.
+ *
+ * Returns:
+ *   bool: true if the frame was a bulk frame and has been consumed.
+ */
+bool espnow_bulk_handle_rx(const esp_now_recv_info_t *info, const uint8_t *data, int len);
+
+/**
+ * @brief Report a completed send to the bulk transfer.
+ *
+ * Call this from the ESP-NOW send callback for every frame.
+ */
+void espnow_bulk_handle_send_done(esp_now_send_status_t status);
+
+/**
+ * @brief Send one transfer to a peer and wait until every chunk is ACKed.
+ *
+ * Args:
+ *   peer_mac: Destination MAC. The peer must already be added.
+ *   total_bytes: Transfer size in bytes.
+ *   window: Chunks in flight, 1 to ESPNOW_BULK_MAX_WINDOW.
+ *   read_fn: Data source.
+ *   arg: User argument for read_fn.
+ *   stats: Optional output statistics.
+ *
+ * Returns:
+ *   esp_err_t: ESP_OK when the receiver has every chunk,
+ *   ESP_ERR_TIMEOUT when the receiver stopped answering.
+ */
+esp_err_t espnow_bulk_send(const uint8_t peer_mac[6], uint32_t total_bytes, uint16_t window,
+                           espnow_bulk_read_fn_t read_fn, void *arg, espnow_bulk_stats_t *stats);
+
+/**
+ * @brief Receive one transfer and return when it is complete.
+ *
+ * Args:
+ *   write_fn: Data sink.
+ *   arg: User argument for write_fn.
+ *   stats: Optional output statistics.
+ *
+ * Returns:
+ *   esp_err_t: ESP_OK when the transfer is complete.
+ */
+esp_err_t espnow_bulk_receive(espnow_bulk_write_fn_t write_fn, void *arg, espnow_bulk_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPNOW_BULK_H */
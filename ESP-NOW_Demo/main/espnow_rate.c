@@ -0,0 +1,55 @@
+/**
+ * @file espnow_rate.c
+ * @brief ESP-NOW PHY rate selection, including Long Range (LR) mode.
+ */
+
+#include "espnow_rate.h"
+
+#include "esp_idf_version.h"
+#include "esp_now.h"
+#include "esp_wifi.h"
+
+const espnow_rate_t espnow_rates[] = {
+    { "LR 250K",   WIFI_PHY_MODE_LR,   WIFI_PHY_RATE_LORA_250K, 250   },
+    { "LR 500K",   WIFI_PHY_MODE_LR,   WIFI_PHY_RATE_LORA_500K, 500   },
+    { "11B 1M",    WIFI_PHY_MODE_11B,  WIFI_PHY_RATE_1M_L,      1000  },
+    { "11B 2M",    WIFI_PHY_MODE_11B,  WIFI_PHY_RATE_2M,        2000  },
+    { "11B 5.5M",  WIFI_PHY_MODE_11B,  WIFI_PHY_RATE_5M_L,      5500  },
+    { "11B 11M",   WIFI_PHY_MODE_11B,  WIFI_PHY_RATE_11M_L,     11000 },
+    { "11G 6M",    WIFI_PHY_MODE_11G,  WIFI_PHY_RATE_6M,        6000  },
+    { "11G 12M",   WIFI_PHY_MODE_11G,  WIFI_PHY_RATE_12M,       12000 },
+    { "11G 24M",   WIFI_PHY_MODE_11G,  WIFI_PHY_RATE_24M,       24000 },
+    { "11G 54M",   WIFI_PHY_MODE_11G,  WIFI_PHY_RATE_54M,       54000 },
+    { "HT20 MCS0", WIFI_PHY_MODE_HT20, WIFI_PHY_RATE_MCS0_LGI,  6500  },
+    { "HT20 MCS3", WIFI_PHY_MODE_HT20, WIFI_PHY_RATE_MCS3_LGI,  26000 },
+    { "HT20 MCS7", WIFI_PHY_MODE_HT20, WIFI_PHY_RATE_MCS7_LGI,  65000 },
+};
+
+const size_t espnow_rate_count = sizeof(espnow_rates) / sizeof(espnow_rates[0]);
+
+esp_err_t espnow_rate_enable_lr(void)
+{
+    return esp_wifi_set_protocol(WIFI_IF_STA,
+                                 WIFI_PROTOCOL_11B | WIFI_PROTOCOL_11G |
+                                 WIFI_PROTOCOL_11N | WIFI_PROTOCOL_LR);
+}
+
+esp_err_t espnow_rate_apply(const uint8_t peer_mac[6], const espnow_rate_t *rate)
+{
+    if (!peer_mac || !rate) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+#if ESP_IDF_VERSION >= ESP_IDF_VERSION_VAL(5, 4, 0)
+    esp_now_rate_config_t config = {
+        .phymode = rate->phymode,
+        .rate = rate->rate,
+        .ersu = false,
+        .dcm = false,
+    };
+    return esp_now_set_peer_rate_config(peer_mac, &config);
+#else
+    // Older releases only have an interface-wide ESP-NOW rate.
+    return esp_wifi_config_espnow_rate(WIFI_IF_STA, rate->rate);
+#endif
+}
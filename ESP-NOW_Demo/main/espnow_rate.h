@@ -0,0 +1,71 @@
+/**
+ * @file espnow_rate.h
+ * @brief ESP-NOW PHY rate selection, including Long Range (LR) mode.
+ *
+ * By default the Wi-Fi driver sends ESP-NOW frames at 1 Mbps 802.11b. A
+ * faster rate shortens the airtime of each frame; an LR rate trades speed
+ * for range. The rate is set per peer, and both devices must accept LR
+ * frames for the LR rates to work.
+ */
+
+#ifndef ESPNOW_RATE_H
+#define ESPNOW_RATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "esp_wifi_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** One selectable PHY mode and rate. */
+typedef struct {
+    const char     *name;       /**< Short label for logs, e.g. "11G 24M". */
+    wifi_phy_mode_t phymode;    /**< PHY mode, e.g. WIFI_PHY_MODE_11G. */
+    wifi_phy_rate_t rate;       /**< Rate within the mode. */
+    uint32_t        kbps;       /**< Nominal rate in kbit/s. */
+} espnow_rate_t;
+
+/** Rates from the most robust to the fastest. */
+extern const espnow_rate_t espnow_rates[];
+
+/** Number of entries in espnow_rates. */
+extern const size_t espnow_rate_count;
+
+/** Index of the driver default (1 Mbps 802.11b) in espnow_rates. */
+#define ESPNOW_RATE_DEFAULT_INDEX   2
+
+/**
+ * @brief Let the station interface send and receive Long Range frames.
+ *
+ * Call after esp_wifi_start(). 802.11b/g/n stay enabled, so normal rates
+ * keep working.
+ *
+ * Returns:
+ *   esp_err_t: ESP_OK on success, otherwise the esp_wifi_set_protocol() error.
+ */
+esp_err_t espnow_rate_enable_lr(void);
+
+/**
+ * @brief Send all further frames to a peer at the given rate.
+ *
+ * With ESP-IDF before v5.4 the rate can only be set for the whole
+ * interface, so it then applies to every peer.
+ *
+ * Args:
+ *   peer_mac: Peer that was added with esp_now_add_peer().
+ *   rate: Entry of espnow_rates.
+ *
+ * Returns:
+ *   esp_err_t: ESP_OK on success, otherwise the driver error.
+ */
+esp_err_t espnow_rate_apply(const uint8_t peer_mac[6], const espnow_rate_t *rate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ESPNOW_RATE_H */
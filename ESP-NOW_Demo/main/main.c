@@ -4,7 +4,13 @@
  *
  * This project provides two firmware roles:
  * - Sender: periodically transmits a small counter packet using ESP-NOW.
- * - Receiver: receives packets and prints them from a FreeRTOS task.
+ * - Receiver: receives packets and prints per-sender statistics from a
+ *   FreeRTOS task.
+ *
+ * With bulk transfer mode enabled, the sender instead pushes large transfers
+ * through a sliding window (see espnow_bulk.h) and both roles print
+ * throughput and latency statistics. With rate benchmark mode enabled, the
+ * sender sweeps PHY rates and payload sizes (see espnow_bench.h).
  *
  * Configure the role and parameters using:
  *   idf.py menuconfig
@@ -12,7 +18,7 @@
  * Key beginner concepts demonstrated:
  * - Wi-Fi initialization (STA mode) without connecting to an AP
  * - ESP-NOW initialization and peer addressing
- * - Callback-to-task handoff using a FreeRTOS queue
+ * - Callback-to-task handoff using a lock-free ring (see spsc_ring.h)
  */
 
 #include <stdio.h>
@@ -20,24 +26,34 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include <inttypes.h>
+#include <stdatomic.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "freertos/queue.h"
 #include "freertos/event_groups.h"
 
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_event.h"
+#include "esp_timer.h"
 #include "nvs_flash.h"
 
 #include "esp_wifi.h"
 #include "esp_now.h"
 
+#include "espnow_bench.h"
+#include "espnow_bulk.h"
+#include "espnow_rate.h"
+#include "spsc_ring.h"
+
 static const char *TAG = "espnow_demo";
 
-#define RX_QUEUE_LEN            16
+#define RX_RING_LEN             256     // Must be a power of two
+#define RX_MAX_SENDERS          4
+#define RX_REPORT_MS            1000
 #define SEND_DONE_BIT           (1U << 0)
+#define BULK_PAUSE_MS           2000
+#define BENCH_PAUSE_MS          10000
 
 /** Simple application packet.
  *
@@ -55,11 +71,31 @@ typedef struct {
 
 typedef struct {
     uint8_t src_mac[6];
+    int8_t  rssi;
     int     len;
     app_packet_t pkt;
 } rx_item_t;
 
-static QueueHandle_t s_rx_queue = NULL;
+/** Receive statistics for one sender over one report interval. */
+typedef struct {
+    bool     used;
+    uint8_t  mac[6];
+    bool     have_seq;
+    uint16_t last_seq;
+    uint32_t last_counter;
+    uint32_t packets;
+    uint32_t bytes;
+    uint32_t lost;              // Sequence numbers skipped
+    uint32_t late;              // Older than the newest sequence number seen
+    uint32_t duplicates;
+    int32_t  rssi_sum;
+    int8_t   rssi_min;
+    int8_t   rssi_max;
+} rx_sender_stats_t;
+
+static spsc_ring_t s_rx_ring;
+static TaskHandle_t s_rx_task = NULL;
+static atomic_bool s_rx_sleeping = false;
 static EventGroupHandle_t s_evt = NULL;
 
 static uint8_t s_peer_mac[6] = {0};
@@ -159,6 +195,11 @@ static esp_err_t init_wifi_for_espnow(uint8_t channel)
     ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
     ESP_ERROR_CHECK(esp_wifi_start());
 
+#if CONFIG_ESPNOW_LONG_RANGE
+    // Add the Long Range protocol so LR frames can be sent and received
+    ESP_ERROR_CHECK(espnow_rate_enable_lr());
+#endif
+
     ESP_ERROR_CHECK(esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE));
 
     return ESP_OK;
@@ -181,6 +222,11 @@ static void espnow_send_cb(const uint8_t *mac_addr, esp_now_send_status_t status
 {
     (void)mac_addr;
 
+    // Return the transmit credit used by bulk transfers
+    espnow_bulk_handle_send_done(status);
+    espnow_bench_handle_send_done(status);
+
+#if !CONFIG_ESPNOW_BULK_MODE && !CONFIG_ESPNOW_BENCH_MODE
     // Signal send done event
     if (s_evt) {
         xEventGroupSetBits(s_evt, SEND_DONE_BIT);
@@ -191,6 +237,7 @@ static void espnow_send_cb(const uint8_t *mac_addr, esp_now_send_status_t status
     } else {
         ESP_LOGW(TAG, "Send status: FAIL");
     }
+#endif
 }
 
 /**
@@ -213,11 +260,17 @@ static void espnow_recv_cb(const esp_now_recv_info_t *info, const uint8_t *data,
         return;
     }
 
+    // Bulk and benchmark frames have their own queues
+    if (espnow_bulk_handle_rx(info, data, len) || espnow_bench_handle_rx(info, data, len)) {
+        return;
+    }
+
     // Create RX item
     rx_item_t item = {0};
 
-    // Copy payload source MAC
+    // Copy payload source MAC and signal strength
     memcpy(item.src_mac, info->src_addr, 6);
+    item.rssi = (int8_t)info->rx_ctrl->rssi;
 
     // Copy payload length
     item.len = len;
@@ -229,9 +282,15 @@ static void espnow_recv_cb(const esp_now_recv_info_t *info, const uint8_t *data,
         return;
     }
 
-    // Enqueue item for processing in a task
-    if (s_rx_queue) {
-        (void)xQueueSend(s_rx_queue, &item, 0);
+    // Hand the item to the receiver task; a full ring drops it and counts the drop
+    if (!spsc_ring_push(&s_rx_ring, &item)) {
+        return;
+    }
+
+    // Wake the receiver task only if it is waiting
+    atomic_thread_fence(memory_order_seq_cst);
+    if (s_rx_task && atomic_exchange(&s_rx_sleeping, false)) {
+        xTaskNotifyGive(s_rx_task);
     }
 }
 
@@ -338,11 +397,148 @@ static void sender_task(void *arg)
 }
 
 /**
- * @brief Receiver task: print packets forwarded from the receive callback.
+ * @brief Find or claim the statistics slot for a sender.
  *
- * This task demonstrates:
- * - receiving items from a FreeRTOS queue
- * - safely processing data outside the ESP-NOW callback context
+ * Args:
+ *   stats: Array of RX_MAX_SENDERS slots.
+ *   mac: Sender MAC.
+ *
+ * Returns:
+ *   Pointer to the slot, or NULL if all slots belong to other senders.
+ */
+static rx_sender_stats_t *rx_stats_slot(rx_sender_stats_t *stats, const uint8_t mac[6])
+{
+    rx_sender_stats_t *free_slot = NULL;
+
+    for (int i = 0; i < RX_MAX_SENDERS; i++) {
+        if (stats[i].used && memcmp(stats[i].mac, mac, 6) == 0) {
+            return &stats[i];
+        }
+        if (!stats[i].used && !free_slot) {
+            free_slot = &stats[i];
+        }
+    }
+
+    if (free_slot) {
+        memset(free_slot, 0, sizeof(*free_slot));
+        free_slot->used = true;
+        memcpy(free_slot->mac, mac, 6);
+    }
+    return free_slot;
+}
+
+/**
+ * @brief Add one received packet to its sender's statistics.
+ *
+ * Sequence numbers are 16-bit and wrap, so a packet counts as newer when it
+ * is less than half the sequence space ahead of the newest one seen. Each
+ * skipped number counts as lost until it arrives late.
+ *
+ * Args:
+ *   st: Sender statistics.
+ *   item: Received packet.
+ *
+ * Returns:
+ *   None.
+ */
+static void rx_stats_add(rx_sender_stats_t *st, const rx_item_t *item)
+{
+    if (st->packets == 0) {
+        st->rssi_min = item->rssi;
+        st->rssi_max = item->rssi;
+    }
+    st->packets++;
+    st->bytes += (uint32_t)item->len;
+    st->rssi_sum += item->rssi;
+    if (item->rssi < st->rssi_min) {
+        st->rssi_min = item->rssi;
+    }
+    if (item->rssi > st->rssi_max) {
+        st->rssi_max = item->rssi;
+    }
+
+    const uint16_t seq = item->pkt.seq;
+    if (!st->have_seq) {
+        st->have_seq = true;
+    } else {
+        const uint16_t ahead = (uint16_t)(seq - st->last_seq);
+        if (ahead == 0) {
+            st->duplicates++;
+            return;
+        }
+        if (ahead >= 0x8000U) {
+            st->late++;
+            if (st->lost > 0) {
+                st->lost--;
+            }
+            return;
+        }
+        st->lost += ahead - 1U;
+    }
+    st->last_seq = seq;
+    st->last_counter = item->pkt.counter;
+}
+
+/**
+ * @brief Print and reset the statistics of every sender heard from.
+ *
+ * Args:
+ *   stats: Array of RX_MAX_SENDERS slots.
+ *   ring_drops: Packets dropped because the receive ring was full.
+ *   unknown: Packets from senders beyond RX_MAX_SENDERS.
+ *   interval_us: Length of the report interval.
+ *
+ * Returns:
+ *   None.
+ */
+static void rx_stats_report(rx_sender_stats_t *stats, uint32_t ring_drops,
+                            uint32_t unknown, int64_t interval_us)
+{
+    for (int i = 0; i < RX_MAX_SENDERS; i++) {
+        rx_sender_stats_t *st = &stats[i];
+        if (!st->used || st->packets == 0) {
+            continue;
+        }
+
+        char mac_str[18] = {0};
+        mac_to_str(st->mac, mac_str, sizeof(mac_str));
+
+        const uint32_t pps = (interval_us > 0)
+                                 ? (uint32_t)((uint64_t)st->packets * 1000000ULL / (uint64_t)interval_us)
+                                 : 0;
+        ESP_LOGI(TAG, "RX %s | %" PRIu32 " pkt/s %" PRIu32 " B lost=%" PRIu32 " late=%" PRIu32
+                 " dup=%" PRIu32 " rssi=%d/%" PRId32 "/%d seq=%u counter=%" PRIu32,
+                 mac_str, pps, st->bytes, st->lost, st->late, st->duplicates,
+                 st->rssi_min, st->rssi_sum / (int32_t)st->packets, st->rssi_max,
+                 st->last_seq, st->last_counter);
+
+        // Keep the sequence state so gaps across intervals are still counted
+        st->packets = 0;
+        st->bytes = 0;
+        st->lost = 0;
+        st->late = 0;
+        st->duplicates = 0;
+        st->rssi_sum = 0;
+    }
+
+    if (ring_drops > 0 || unknown > 0) {
+        ESP_LOGW(TAG, "RX ring full: %" PRIu32 " dropped, %" PRIu32 " from untracked senders",
+                 ring_drops, unknown);
+    }
+}
+
+/**
+ * @brief Receiver task: aggregate packets forwarded from the receive callback.
+ *
+ * The callback copies each packet into a lock-free ring and returns. This
+ * task drains the ring, folds every packet into per-sender counters and
+ * prints one line per sender every RX_REPORT_MS, so logging cost no longer
+ * grows with the packet rate. Enable ESPNOW_RX_LOG_PACKETS in menuconfig to
+ * also print every packet.
+ *
+ * When the ring is empty the task sets s_rx_sleeping and waits for a task
+ * notification. The callback only notifies when it clears that flag, so a
+ * busy receiver costs no notification per packet.
  *
  * Args:
  *   arg: Unused.
@@ -354,18 +550,24 @@ static void receiver_task(void *arg)
 {
     (void)arg;
 
+    rx_sender_stats_t stats[RX_MAX_SENDERS] = {0};
+    uint32_t unknown = 0;
     rx_item_t item;
 
-    while (1) {
-        // Wait indefinitely for a received item
-        if (xQueueReceive(s_rx_queue, &item, portMAX_DELAY) == pdTRUE) {
+    int64_t report_start = esp_timer_get_time();
 
+    while (1) {
+        while (spsc_ring_pop(&s_rx_ring, &item)) {
+            rx_sender_stats_t *st = rx_stats_slot(stats, item.src_mac);
+            if (st) {
+                rx_stats_add(st, &item);
+            } else {
+                unknown++;
+            }
+
+#if CONFIG_ESPNOW_RX_LOG_PACKETS
             char mac_str[18] = {0};
-
-            // Convert source MAC to string
             mac_to_str(item.src_mac, mac_str, sizeof(mac_str));
-
-            // Print received packet details
             ESP_LOGI(TAG, "RX from %s | ver=%u type=%u seq=%u counter=%" PRIu32 " (len=%d)",
                      mac_str,
                      item.pkt.version,
@@ -373,9 +575,195 @@ static void receiver_task(void *arg)
                      item.pkt.seq,
                      item.pkt.counter,
                      item.len);
+#endif
+        }
+
+        const int64_t now = esp_timer_get_time();
+        const int64_t elapsed = now - report_start;
+        if (elapsed >= (int64_t)RX_REPORT_MS * 1000) {
+            rx_stats_report(stats, spsc_ring_take_drops(&s_rx_ring), unknown, elapsed);
+            unknown = 0;
+            report_start = now;
+            continue;
+        }
+
+        // Announce the wait, then re-check so a packet pushed in between is not missed
+        atomic_store(&s_rx_sleeping, true);
+        atomic_thread_fence(memory_order_seq_cst);
+        if (!spsc_ring_is_empty(&s_rx_ring)) {
+            atomic_store(&s_rx_sleeping, false);
+            continue;
+        }
+
+        const int64_t wait_ms = (int64_t)RX_REPORT_MS - elapsed / 1000;
+        (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait_ms) + 1);
+        atomic_store(&s_rx_sleeping, false);
+    }
+}
+
+#if CONFIG_ESPNOW_BULK_MODE
+/**
+ * @brief Print throughput and latency of one bulk transfer.
+ *
+ * Args:
+ *   stats: Statistics returned by the bulk transfer.
+ *
+ * Returns:
+ *   None.
+ */
+static void bulk_log_stats(const espnow_bulk_stats_t *stats)
+{
+    const uint32_t kbps = (stats->elapsed_us > 0)
+                              ? (uint32_t)(((uint64_t)stats->bytes * 1000000ULL / 1024ULL) / (uint64_t)stats->elapsed_us)
+                              : 0;
+
+    ESP_LOGI(TAG, "Bulk: %" PRIu32 " bytes in %" PRId64 " ms = %" PRIu32 " KB/s",
+             stats->bytes, stats->elapsed_us / 1000, kbps);
+#if CONFIG_ESPNOW_ROLE_SENDER
+    ESP_LOGI(TAG, "Bulk: %" PRIu32 " frames for %" PRIu32 " chunks, %" PRIu32 " retransmits, "
+             "%" PRIu32 " timeouts, %" PRIu32 " send failures, %" PRIu32 " ACKs",
+             stats->frames_sent, stats->chunks, stats->retransmits,
+             stats->timeouts, stats->send_failures, stats->acks);
+    ESP_LOGI(TAG, "Bulk: ACK latency min/avg/max = %" PRIu32 "/%" PRIu32 "/%" PRIu32 " us",
+             stats->latency_min_us, stats->latency_avg_us, stats->latency_max_us);
+#else
+    ESP_LOGI(TAG, "Bulk: %" PRIu32 " chunks, %" PRIu32 " duplicates, %" PRIu32 " ACKs sent",
+             stats->chunks, stats->duplicates, stats->acks);
+#endif
+}
+
+#if CONFIG_ESPNOW_ROLE_SENDER
+/**
+ * @brief Fill a bulk chunk with a test pattern derived from its offset.
+ *
+ * A real application would read firmware or log data here instead.
+ *
+ * Args:
+ *   offset: Byte offset in the transfer.
+ *   buf: Output buffer.
+ *   len: Number of bytes to fill.
+ *   arg: Unused.
+ *
+ * Returns:
+ *   None.
+ */
+static void bulk_pattern_read(uint32_t offset, uint8_t *buf, size_t len, void *arg)
+{
+    (void)arg;
+
+    for (size_t i = 0; i < len; i++) {
+        buf[i] = (uint8_t)((offset + i) * 31U + 7U);
+    }
+}
+
+/**
+ * @brief Bulk sender task: push a test transfer, print stats, repeat.
+ *
+ * Args:
+ *   arg: Unused.
+ *
+ * Returns:
+ *   None.
+ */
+static void bulk_sender_task(void *arg)
+{
+    (void)arg;
+
+    const uint32_t total_bytes = (uint32_t)CONFIG_ESPNOW_BULK_SIZE_KB * 1024U;
+
+    while (1) {
+        espnow_bulk_stats_t stats = {0};
+
+        esp_err_t err = espnow_bulk_send(s_peer_mac, total_bytes, CONFIG_ESPNOW_BULK_WINDOW,
+                                         bulk_pattern_read, NULL, &stats);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Bulk transfer failed: %s", esp_err_to_name(err));
+        }
+        bulk_log_stats(&stats);
+
+        vTaskDelay(pdMS_TO_TICKS(BULK_PAUSE_MS));
+    }
+}
+#else
+/**
+ * @brief Check a received bulk chunk against the test pattern.
+ *
+ * Args:
+ *   offset: Byte offset in the transfer.
+ *   data: Chunk payload.
+ *   len: Payload length.
+ *   arg: Pointer to a uint32_t mismatch counter.
+ *
+ * Returns:
+ *   None.
+ */
+static void bulk_pattern_check(uint32_t offset, const uint8_t *data, size_t len, void *arg)
+{
+    uint32_t *mismatches = (uint32_t *)arg;
+
+    for (size_t i = 0; i < len; i++) {
+        if (data[i] != (uint8_t)((offset + i) * 31U + 7U)) {
+            (*mismatches)++;
+        }
+    }
+}
+
+/**
+ * @brief Bulk receiver task: receive transfers, verify them, print stats.
+ *
+ * Args:
+ *   arg: Unused.
+ *
+ * Returns:
+ *   None.
+ */
+static void bulk_receiver_task(void *arg)
+{
+    (void)arg;
+
+    while (1) {
+        espnow_bulk_stats_t stats = {0};
+        uint32_t mismatches = 0;
+
+        if (espnow_bulk_receive(bulk_pattern_check, &mismatches, &stats) == ESP_OK) {
+            bulk_log_stats(&stats);
+            if (mismatches) {
+                ESP_LOGE(TAG, "Bulk: %" PRIu32 " bytes did not match the test pattern", mismatches);
+            }
+        }
+    }
+}
+#endif
+#endif
+
+#if CONFIG_ESPNOW_BENCH_MODE
+/**
+ * @brief Benchmark task: sweep rates and payload sizes (sender) or answer
+ * report requests (receiver).
+ *
+ * Args:
+ *   arg: Unused.
+ *
+ * Returns:
+ *   None.
+ */
+static void bench_task(void *arg)
+{
+    (void)arg;
+
+#if CONFIG_ESPNOW_ROLE_SENDER
+    while (1) {
+        esp_err_t err = espnow_bench_run(s_peer_mac, CONFIG_ESPNOW_BENCH_PROBES);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Benchmark failed: %s", esp_err_to_name(err));
         }
+        vTaskDelay(pdMS_TO_TICKS(BENCH_PAUSE_MS));
     }
+#else
+    espnow_bench_serve();
+#endif
 }
+#endif
 
 /**
  * @brief Application entry point.
@@ -400,6 +788,12 @@ void app_main(void)
     uint8_t channel = (uint8_t)CONFIG_ESPNOW_CHANNEL;
     ESP_ERROR_CHECK(init_wifi_for_espnow(channel));
 
+    // Create the RX ring before the receive callback can run
+    if (spsc_ring_init(&s_rx_ring, sizeof(rx_item_t), RX_RING_LEN) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create RX ring");
+        return;
+    }
+
     // Initialize ESP-NOW
     ESP_ERROR_CHECK(init_espnow());
 
@@ -418,12 +812,12 @@ void app_main(void)
     // Configure peer for ESP-NOW
     ESP_ERROR_CHECK(espnow_config_peer(s_peer_mac, channel));
 
-    // Create RX queue and event group
-    s_rx_queue = xQueueCreate(RX_QUEUE_LEN, sizeof(rx_item_t));
-    if (!s_rx_queue) {
-        ESP_LOGE(TAG, "Failed to create RX queue");
-        return;
-    }
+#if !CONFIG_ESPNOW_PHY_RATE_DRIVER && !CONFIG_ESPNOW_BENCH_MODE
+    // Send to the peer at the rate chosen in menuconfig
+    const espnow_rate_t *rate = &espnow_rates[CONFIG_ESPNOW_PHY_RATE_INDEX];
+    ESP_ERROR_CHECK(espnow_rate_apply(s_peer_mac, rate));
+    ESP_LOGI(TAG, "Peer PHY rate: %s", rate->name);
+#endif
 
     // Create event group
     s_evt = xEventGroupCreate();
@@ -432,12 +826,28 @@ void app_main(void)
         return;
     }
 
+    // Create bulk transfer and benchmark queues (unused unless their mode is enabled)
+    ESP_ERROR_CHECK(espnow_bulk_init(channel));
+    ESP_ERROR_CHECK(espnow_bench_init(channel));
+
     // Start sender or receiver task based on menuconfig
-#if CONFIG_ESPNOW_ROLE_SENDER
+#if CONFIG_ESPNOW_BENCH_MODE && CONFIG_ESPNOW_ROLE_SENDER
+    ESP_LOGI(TAG, "Role: SENDER (rate benchmark)");
+    xTaskCreate(bench_task, "bench_task", 4096, NULL, 5, NULL);
+#elif CONFIG_ESPNOW_BENCH_MODE
+    ESP_LOGI(TAG, "Role: RECEIVER (rate benchmark)");
+    xTaskCreate(bench_task, "bench_task", 4096, NULL, 5, NULL);
+#elif CONFIG_ESPNOW_BULK_MODE && CONFIG_ESPNOW_ROLE_SENDER
+    ESP_LOGI(TAG, "Role: SENDER (bulk, window=%d)", CONFIG_ESPNOW_BULK_WINDOW);
+    xTaskCreate(bulk_sender_task, "bulk_sender", 4096, NULL, 5, NULL);
+#elif CONFIG_ESPNOW_BULK_MODE
+    ESP_LOGI(TAG, "Role: RECEIVER (bulk)");
+    xTaskCreate(bulk_receiver_task, "bulk_receiver", 4096, NULL, 5, NULL);
+#elif CONFIG_ESPNOW_ROLE_SENDER
     ESP_LOGI(TAG, "Role: SENDER");
     xTaskCreate(sender_task, "sender_task", 4096, NULL, 5, NULL);
 #else
     ESP_LOGI(TAG, "Role: RECEIVER");
-    xTaskCreate(receiver_task, "receiver_task", 4096, NULL, 5, NULL);
+    xTaskCreate(receiver_task, "receiver_task", 4096, NULL, 5, &s_rx_task);
 #endif
 }
\ No newline at end of file
@@ -0,0 +1,74 @@
+/**
+ * @file spsc_ring.c
+ * @brief Lock-free single-producer, single-consumer ring of fixed-size items.
+ *
+ * head and tail run freely and are masked on use, so head - tail is the fill
+ * level even after they wrap. The producer publishes an item with a release
+ * store of head after copying it; the consumer frees a slot with a release
+ * store of tail after copying out of it. The matching acquire loads make the
+ * copies visible across the two cores.
+ */
+
+#include "spsc_ring.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+esp_err_t spsc_ring_init(spsc_ring_t *ring, size_t item_size, uint32_t capacity)
+{
+    if (!ring || item_size == 0 || capacity == 0 || (capacity & (capacity - 1)) != 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    ring->buf = malloc(item_size * capacity);
+    if (!ring->buf) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    ring->item_size = item_size;
+    ring->mask = capacity - 1;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    atomic_init(&ring->drops, 0);
+    return ESP_OK;
+}
+
+bool spsc_ring_push(spsc_ring_t *ring, const void *item)
+{
+    const unsigned head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    const unsigned tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if (head - tail > ring->mask) {
+        atomic_fetch_add_explicit(&ring->drops, 1, memory_order_relaxed);
+        return false;
+    }
+
+    memcpy(ring->buf + (size_t)(head & ring->mask) * ring->item_size, item, ring->item_size);
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return true;
+}
+
+bool spsc_ring_pop(spsc_ring_t *ring, void *item)
+{
+    const unsigned tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    const unsigned head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    if (head == tail) {
+        return false;
+    }
+
+    memcpy(item, ring->buf + (size_t)(tail & ring->mask) * ring->item_size, ring->item_size);
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+bool spsc_ring_is_empty(spsc_ring_t *ring)
+{
+    return atomic_load_explicit(&ring->head, memory_order_acquire) ==
+           atomic_load_explicit(&ring->tail, memory_order_relaxed);
+}
+
+uint32_t spsc_ring_take_drops(spsc_ring_t *ring)
+{
+    return atomic_exchange_explicit(&ring->drops, 0, memory_order_relaxed);
+}
@@ -0,0 +1,79 @@
+/**
+ * @file spsc_ring.h
+ * @brief Lock-free single-producer, single-consumer ring of fixed-size items.
+ *
+ * One task pushes and one other task pops. Neither side takes a lock or
+ * enters a critical section, so the producer (here the ESP-NOW receive
+ * callback in the Wi-Fi task) never waits for the consumer. A push into a
+ * full ring is dropped and counted.
+ */
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Ring state. Treat the fields as private. */
+typedef struct {
+    uint8_t    *buf;
+    size_t      item_size;
+    uint32_t    mask;           // capacity - 1
+    atomic_uint head;           // Next slot to write; only the producer stores it
+    atomic_uint tail;           // Next slot to read; only the consumer stores it
+    atomic_uint drops;          // Pushes rejected because the ring was full
+} spsc_ring_t;
+
+/**
+ * @brief Allocate the ring storage.
+ *
+ * Args:
+ *   ring: Ring to initialize.
+ *   item_size: Size of one item in bytes.
+ *   capacity: Number of items; must be a power of two.
+ *
+ * Returns:
+ *   esp_err_t: ESP_OK on success, ESP_ERR_INVALID_ARG for a bad capacity,
+ *   ESP_ERR_NO_MEM if the storage could not be allocated.
+ */
+esp_err_t spsc_ring_init(spsc_ring_t *ring, size_t item_size, uint32_t capacity);
+
+/**
+ * @brief Copy an item into the ring. Producer side only.
+ *
+ * Returns:
+ *   bool: true if the item was stored, false if the ring was full.
+ */
+bool spsc_ring_push(spsc_ring_t *ring, const void *item);
+
+/**
+ * @brief Copy the oldest item out of the ring. Consumer side only.
+ *
+ * Returns:
+ *   bool: true if an item was returned, false if the ring was empty.
+ */
+bool spsc_ring_pop(spsc_ring_t *ring, void *item);
+
+/**
+ * @brief Check whether the ring holds no items. Consumer side only.
+ */
+bool spsc_ring_is_empty(spsc_ring_t *ring);
+
+/**
+ * @brief Return the number of dropped pushes and reset it to zero.
+ */
+uint32_t spsc_ring_take_drops(spsc_ring_t *ring);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPSC_RING_H */
@@ -0,0 +1,113 @@
+/**
+ * @file
+ * @brief Double-buffered asynchronous pixel flushes to an esp_lcd panel
+ *
+ * The caller renders into one buffer while the SPI DMA sends the other.
+ * Buffers are handed out by lcd_flush_get_buffer() and queued with
+ * lcd_flush_submit(), which returns as soon as the transfer is queued.
+ * Completion is reported through the panel IO `on_color_trans_done` callback.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "esp_lcd_panel_io.h"
+#include "esp_lcd_panel_ops.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Flush context handle
+ */
+typedef struct lcd_flush_t *lcd_flush_handle_t;
+
+/**
+ * @brief Flush context configuration
+ */
+typedef struct {
+    esp_lcd_panel_io_handle_t io;   /*!< Panel IO whose color-done callback the flush takes over */
+    esp_lcd_panel_handle_t panel;   /*!< Panel that receives the pixels */
+    size_t buffer_size;             /*!< Size of each of the two DMA buffers, in bytes */
+} lcd_flush_config_t;
+
+/**
+ * @brief Create a flush context with two DMA-capable buffers
+ *
+ * @note  This registers the `on_color_trans_done` callback of `config->io`, replacing any set in the IO config.
+ *        Every color transfer on that IO must then go through this context.
+ *
+ * @param[in] config Flush configuration
+ * @param[out] ret_flush Returned flush handle
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_ERR_NO_MEM        if out of memory
+ *          - ESP_OK                on success
+ */
+esp_err_t lcd_flush_new(const lcd_flush_config_t *config, lcd_flush_handle_t *ret_flush);
+
+/**
+ * @brief Wait for pending transfers, release the IO callback and free the context
+ *
+ * @param[in] flush Flush handle
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_OK                on success
+ */
+esp_err_t lcd_flush_del(lcd_flush_handle_t flush);
+
+/**
+ * @brief Get the buffer to render into next
+ *
+ * Blocks only while both buffers are still being transmitted. Calling this
+ * again before lcd_flush_submit() returns the same buffer.
+ *
+ * @param[in] flush Flush handle
+ * @return Buffer of `buffer_size` bytes, or NULL if `flush` is NULL
+ */
+void *lcd_flush_get_buffer(lcd_flush_handle_t flush);
+
+/**
+ * @brief Get the size of each buffer
+ *
+ * @param[in] flush Flush handle
+ * @return Buffer size in bytes, 0 if `flush` is NULL
+ */
+size_t lcd_flush_get_buffer_size(lcd_flush_handle_t flush);
+
+/**
+ * @brief Queue the buffer from lcd_flush_get_buffer() for a panel region
+ *
+ * Returns once the transfer is queued. The buffer must not be touched
+ * afterwards; the next lcd_flush_get_buffer() hands out the other one.
+ *
+ * @param[in] flush Flush handle
+ * @param[in] x_start Start column
+ * @param[in] y_start Start row
+ * @param[in] x_end End column, exclusive
+ * @param[in] y_end End row, exclusive
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid or the region does not fit the buffer
+ *          - ESP_ERR_INVALID_STATE if no buffer was taken with lcd_flush_get_buffer()
+ *          - Error from esp_lcd_panel_draw_bitmap() otherwise
+ */
+esp_err_t lcd_flush_submit(lcd_flush_handle_t flush, int x_start, int y_start, int x_end, int y_end);
+
+/**
+ * @brief Wait until every submitted transfer has been sent
+ *
+ * @param[in] flush Flush handle
+ * @param[in] timeout Maximum time to wait
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_ERR_TIMEOUT       if transfers are still in flight after `timeout`
+ *          - ESP_OK                on success
+ */
+esp_err_t lcd_flush_wait_idle(lcd_flush_handle_t flush, TickType_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
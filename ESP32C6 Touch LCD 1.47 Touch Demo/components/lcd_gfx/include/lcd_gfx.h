@@ -0,0 +1,186 @@
+/**
+ * @file
+ * @brief Drawing primitives for an esp_lcd panel fed through lcd_flush
+ *
+ * Two drawing targets are supported:
+ * - Direct: each primitive renders into the lcd_flush buffers and is queued
+ *   for DMA right away.
+ * - Framebuffer: primitives write into a RAM copy of the screen and record
+ *   the rectangles that actually changed; lcd_gfx_flush() sends only those.
+ *
+ * Filled shapes are drawn as horizontal spans, and bitmap font glyphs are
+ * kept pre-scaled in an optional LRU cache so repeated text is a plain copy.
+ * Colors are written as given, so they must already be in panel byte order.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "lcd_flush.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Graphics context handle
+ */
+typedef struct lcd_gfx_t *lcd_gfx_handle_t;
+
+/**
+ * @brief Built-in bitmap fonts, ASCII 32 to 126
+ */
+typedef enum {
+    LCD_GFX_FONT_5X8,   /*!< 5x8 column-major font, advances 6 pixels per character at scale 1 */
+    LCD_GFX_FONT_8X12,  /*!< 8x12 row-major bold font, spacing built into the cell */
+} lcd_gfx_font_t;
+
+/**
+ * @brief Graphics context configuration
+ */
+typedef struct {
+    lcd_flush_handle_t flush;       /*!< Flush context that carries pixels to the panel */
+    int width;                      /*!< Screen width in pixels */
+    int height;                     /*!< Screen height in pixels */
+    bool use_framebuffer;           /*!< Draw into a RAM framebuffer sent by lcd_gfx_flush() instead of straight to the panel */
+    int max_dirty;                  /*!< Dirty rectangles tracked between flushes in framebuffer mode, 0 for 8 */
+    int merge_slack;                /*!< Extra pixels worth sending to save one transaction, 0 for 256 */
+    int glyph_cache_slots;          /*!< Scaled glyphs kept, 0 to disable the cache */
+    size_t glyph_slot_pixels;       /*!< Pixels per cache slot; larger glyphs bypass the cache */
+} lcd_gfx_config_t;
+
+/**
+ * @brief Create a graphics context
+ *
+ * In framebuffer mode the whole screen starts dirty, since the panel contents
+ * after reset are unknown.
+ *
+ * @param[in] config Graphics configuration
+ * @param[out] ret_gfx Returned graphics handle
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_ERR_NO_MEM        if out of memory
+ *          - ESP_OK                on success
+ */
+esp_err_t lcd_gfx_new(const lcd_gfx_config_t *config, lcd_gfx_handle_t *ret_gfx);
+
+/**
+ * @brief Free a graphics context
+ *
+ * Pending dirty rectangles are discarded. The flush context is not deleted.
+ *
+ * @param[in] gfx Graphics handle
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_OK                on success
+ */
+esp_err_t lcd_gfx_del(lcd_gfx_handle_t gfx);
+
+/**
+ * @brief Fill a rectangle, clipped to the screen
+ *
+ * @param[in] gfx Graphics handle
+ * @param[in] x Left column
+ * @param[in] y Top row
+ * @param[in] width Rectangle width
+ * @param[in] height Rectangle height
+ * @param[in] color Fill color
+ */
+void lcd_gfx_fill_rect(lcd_gfx_handle_t gfx, int x, int y, int width, int height, uint16_t color);
+
+/**
+ * @brief Fill the whole screen
+ *
+ * @param[in] gfx Graphics handle
+ * @param[in] color Fill color
+ */
+void lcd_gfx_fill_screen(lcd_gfx_handle_t gfx, uint16_t color);
+
+/**
+ * @brief Fill a circle, one horizontal span per row
+ *
+ * Row widths come from the midpoint circle algorithm, so no square roots or
+ * per-pixel distance tests are needed. Pixels outside the circle are left untouched.
+ *
+ * @param[in] gfx Graphics handle
+ * @param[in] cx Center column
+ * @param[in] cy Center row
+ * @param[in] radius Radius in pixels
+ * @param[in] color Fill color
+ */
+void lcd_gfx_fill_circle(lcd_gfx_handle_t gfx, int cx, int cy, int radius, uint16_t color);
+
+/**
+ * @brief Copy a block of pixels, clipped to the screen
+ *
+ * In framebuffer mode rows that already match are skipped and only the
+ * changed part of each row is marked dirty.
+ *
+ * @param[in] gfx Graphics handle
+ * @param[in] x Left column
+ * @param[in] y Top row
+ * @param[in] width Block width
+ * @param[in] height Block height
+ * @param[in] pixels Row-major pixels, `width * height` entries
+ */
+void lcd_gfx_blit(lcd_gfx_handle_t gfx, int x, int y, int width, int height, const uint16_t *pixels);
+
+/**
+ * @brief Draw one character of a bitmap font
+ *
+ * Characters outside ASCII 32 to 126 are drawn as a space.
+ *
+ * @param[in] gfx Graphics handle
+ * @param[in] font Font to draw with
+ * @param[in] c Character
+ * @param[in] x Left column
+ * @param[in] y Top row
+ * @param[in] color Ink color
+ * @param[in] bg_color Background color of the character cell
+ * @param[in] scale Integer scale factor, at least 1
+ */
+void lcd_gfx_draw_char(lcd_gfx_handle_t gfx, lcd_gfx_font_t font, char c, int x, int y,
+                       uint16_t color, uint16_t bg_color, int scale);
+
+/**
+ * @brief Draw a string of a bitmap font
+ *
+ * @param[in] gfx Graphics handle
+ * @param[in] font Font to draw with
+ * @param[in] str NUL-terminated string
+ * @param[in] x Left column of the first character
+ * @param[in] y Top row
+ * @param[in] color Ink color
+ * @param[in] bg_color Background color of the character cells
+ * @param[in] scale Integer scale factor, at least 1
+ * @return Column just past the last character
+ */
+int lcd_gfx_draw_string(lcd_gfx_handle_t gfx, lcd_gfx_font_t font, const char *str, int x, int y,
+                        uint16_t color, uint16_t bg_color, int scale);
+
+/**
+ * @brief Get the advance of one character of a bitmap font
+ *
+ * @param[in] font Font
+ * @param[in] scale Integer scale factor
+ * @return Horizontal distance between consecutive characters, in pixels
+ */
+int lcd_gfx_font_advance(lcd_gfx_font_t font, int scale);
+
+/**
+ * @brief Send the dirty rectangles of the framebuffer to the panel
+ *
+ * Returns once the last chunk is queued, so the caller can keep drawing
+ * while it goes out. Does nothing in direct mode.
+ *
+ * @param[in] gfx Graphics handle
+ * @return Number of pixel bytes queued
+ */
+size_t lcd_gfx_flush(lcd_gfx_handle_t gfx);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,591 @@
+#include <stdlib.h>
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "lcd_gfx.h"
+#include "font_5x8.h"
+#include "font_8x12.h"
+
+static const char *TAG = "lcd_gfx";
+
+#define LCD_GFX_DEFAULT_MAX_DIRTY    8
+#define LCD_GFX_DEFAULT_MERGE_SLACK  256
+
+// Rectangle in screen coordinates, x2/y2 exclusive
+typedef struct
+{
+    int x1;
+    int y1;
+    int x2;
+    int y2;
+} lcd_gfx_rect_t;
+
+// Cached glyph bitmap, keyed by everything that changes its pixels
+typedef struct
+{
+    uint32_t last_used;             // use counter for LRU eviction; 0 marks an empty slot
+    char c;
+    uint8_t font;
+    uint8_t scale;
+    uint16_t color;
+    uint16_t bg_color;
+} lcd_gfx_glyph_slot_t;
+
+struct lcd_gfx_t
+{
+    lcd_flush_handle_t flush;
+    int width;
+    int height;
+    int merge_slack;
+    uint16_t *framebuffer;          // shadow copy of the panel, NULL in direct mode
+    lcd_gfx_rect_t *dirty;
+    int max_dirty;
+    int dirty_count;
+    lcd_gfx_glyph_slot_t *glyph_slots;
+    uint16_t *glyph_arena;          // glyph_cache_slots * glyph_slot_pixels, row-major
+    int glyph_cache_slots;
+    size_t glyph_slot_pixels;
+    uint32_t glyph_use_counter;
+    uint32_t glyph_hits;
+    uint32_t glyph_misses;
+};
+
+esp_err_t lcd_gfx_new(const lcd_gfx_config_t *config, lcd_gfx_handle_t *ret_gfx)
+{
+    esp_err_t ret = ESP_OK;
+    struct lcd_gfx_t *gfx = NULL;
+
+    ESP_GOTO_ON_FALSE(config && config->flush && config->width > 0 && config->height > 0 && ret_gfx,
+                      ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    ESP_GOTO_ON_FALSE(config->glyph_cache_slots >= 0 && (config->glyph_cache_slots == 0 || config->glyph_slot_pixels),
+                      ESP_ERR_INVALID_ARG, err, TAG, "invalid glyph cache size");
+    gfx = (struct lcd_gfx_t *)calloc(1, sizeof(struct lcd_gfx_t));
+    ESP_GOTO_ON_FALSE(gfx, ESP_ERR_NO_MEM, err, TAG, "no mem for gfx context");
+
+    gfx->flush = config->flush;
+    gfx->width = config->width;
+    gfx->height = config->height;
+    gfx->merge_slack = config->merge_slack ? config->merge_slack : LCD_GFX_DEFAULT_MERGE_SLACK;
+
+    if (config->use_framebuffer)
+    {
+        gfx->framebuffer = heap_caps_calloc((size_t)gfx->width * gfx->height, sizeof(uint16_t), MALLOC_CAP_INTERNAL);
+        ESP_GOTO_ON_FALSE(gfx->framebuffer, ESP_ERR_NO_MEM, err, TAG, "no mem for framebuffer");
+        gfx->max_dirty = config->max_dirty ? config->max_dirty : LCD_GFX_DEFAULT_MAX_DIRTY;
+        gfx->dirty = calloc(gfx->max_dirty, sizeof(lcd_gfx_rect_t));
+        ESP_GOTO_ON_FALSE(gfx->dirty, ESP_ERR_NO_MEM, err, TAG, "no mem for dirty rectangles");
+
+        // Panel contents after reset are unknown
+        gfx->dirty[0] = (lcd_gfx_rect_t){ 0, 0, gfx->width, gfx->height };
+        gfx->dirty_count = 1;
+    }
+
+    if (config->glyph_cache_slots > 0)
+    {
+        gfx->glyph_slots = calloc(config->glyph_cache_slots, sizeof(lcd_gfx_glyph_slot_t));
+        gfx->glyph_arena = malloc(config->glyph_cache_slots * config->glyph_slot_pixels * sizeof(uint16_t));
+        ESP_GOTO_ON_FALSE(gfx->glyph_slots && gfx->glyph_arena, ESP_ERR_NO_MEM, err, TAG, "no mem for glyph cache");
+        gfx->glyph_cache_slots = config->glyph_cache_slots;
+        gfx->glyph_slot_pixels = config->glyph_slot_pixels;
+    }
+
+    *ret_gfx = gfx;
+    ESP_LOGD(TAG, "new gfx context @%p, %dx%d, %s, %d glyph slots", gfx, gfx->width, gfx->height,
+             gfx->framebuffer ? "framebuffer" : "direct", gfx->glyph_cache_slots);
+    return ESP_OK;
+
+err:
+    if (gfx)
+    {
+        free(gfx->glyph_arena);
+        free(gfx->glyph_slots);
+        free(gfx->dirty);
+        heap_caps_free(gfx->framebuffer);
+        free(gfx);
+    }
+    return ret;
+}
+
+esp_err_t lcd_gfx_del(lcd_gfx_handle_t gfx)
+{
+    ESP_RETURN_ON_FALSE(gfx, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    free(gfx->glyph_arena);
+    free(gfx->glyph_slots);
+    free(gfx->dirty);
+    heap_caps_free(gfx->framebuffer);
+    free(gfx);
+    return ESP_OK;
+}
+
+static int rect_area(const lcd_gfx_rect_t *rect)
+{
+    return (rect->x2 - rect->x1) * (rect->y2 - rect->y1);
+}
+
+static lcd_gfx_rect_t rect_union(const lcd_gfx_rect_t *a, const lcd_gfx_rect_t *b)
+{
+    lcd_gfx_rect_t result = {
+        .x1 = (a->x1 < b->x1) ? a->x1 : b->x1,
+        .y1 = (a->y1 < b->y1) ? a->y1 : b->y1,
+        .x2 = (a->x2 > b->x2) ? a->x2 : b->x2,
+        .y2 = (a->y2 > b->y2) ? a->y2 : b->y2,
+    };
+    return result;
+}
+
+/**
+ * @brief Clip a rectangle to the screen
+ *
+ * @return false if nothing is left
+ */
+static bool rect_clip(const struct lcd_gfx_t *gfx, lcd_gfx_rect_t *rect)
+{
+    if (rect->x1 < 0) rect->x1 = 0;
+    if (rect->y1 < 0) rect->y1 = 0;
+    if (rect->x2 > gfx->width) rect->x2 = gfx->width;
+    if (rect->y2 > gfx->height) rect->y2 = gfx->height;
+    return rect->x1 < rect->x2 && rect->y1 < rect->y2;
+}
+
+/**
+ * @brief Record a framebuffer region that must be sent on the next flush
+ *
+ * Rectangles are merged when their bounding box costs at most merge_slack
+ * extra pixels, since every transaction also pays for the column, row and
+ * memory-write commands. When all slots are in use the new rectangle is
+ * folded into the one it grows least.
+ */
+static void mark_dirty(struct lcd_gfx_t *gfx, lcd_gfx_rect_t rect)
+{
+    if (!rect_clip(gfx, &rect))
+    {
+        return;
+    }
+
+    // Absorb tracked rectangles that are cheaper to send together with this one
+    for (int i = 0; i < gfx->dirty_count;)
+    {
+        lcd_gfx_rect_t merged = rect_union(&rect, &gfx->dirty[i]);
+
+        if (rect_area(&merged) <= rect_area(&rect) + rect_area(&gfx->dirty[i]) + gfx->merge_slack)
+        {
+            rect = merged;
+            gfx->dirty[i] = gfx->dirty[--gfx->dirty_count];
+            i = 0;  // the grown rectangle may now absorb earlier ones
+        }
+        else
+        {
+            i++;
+        }
+    }
+
+    // Out of slots: fold into the rectangle that grows least
+    if (gfx->dirty_count == gfx->max_dirty)
+    {
+        int best = 0;
+        int best_growth = 0;
+
+        for (int i = 0; i < gfx->dirty_count; i++)
+        {
+            lcd_gfx_rect_t merged = rect_union(&rect, &gfx->dirty[i]);
+            int growth = rect_area(&merged) - rect_area(&gfx->dirty[i]);
+
+            if (i == 0 || growth < best_growth)
+            {
+                best = i;
+                best_growth = growth;
+            }
+        }
+        rect = rect_union(&rect, &gfx->dirty[best]);
+        gfx->dirty[best] = gfx->dirty[--gfx->dirty_count];
+    }
+
+    gfx->dirty[gfx->dirty_count++] = rect;
+}
+
+/**
+ * @brief Write a framebuffer row segment, growing `changed` by what differs
+ *
+ * `src` is either `width` pixels or, with `solid` set, a single color.
+ */
+static void fb_write_row(struct lcd_gfx_t *gfx, int x, int y, int width, const uint16_t *src, bool solid,
+                         lcd_gfx_rect_t *changed)
+{
+    uint16_t *dst = &gfx->framebuffer[y * gfx->width + x];
+    int first = 0;
+    int last = width - 1;
+
+    if (solid)
+    {
+        while (first < width && dst[first] == *src) first++;
+        if (first == width)
+        {
+            return;
+        }
+        while (dst[last] == *src) last--;
+        for (int i = first; i <= last; i++)
+        {
+            dst[i] = *src;
+        }
+    }
+    else
+    {
+        if (memcmp(dst, src, width * sizeof(uint16_t)) == 0)
+        {
+            return;
+        }
+        while (dst[first] == src[first]) first++;
+        while (dst[last] == src[last]) last--;
+        memcpy(dst + first, src + first, (last - first + 1) * sizeof(uint16_t));
+    }
+
+    if (x + first < changed->x1) changed->x1 = x + first;
+    if (x + last >= changed->x2) changed->x2 = x + last + 1;
+    if (y < changed->y1) changed->y1 = y;
+    if (y >= changed->y2) changed->y2 = y + 1;
+}
+
+/**
+ * @brief Fill a clipped rectangle straight through the flush buffers
+ *
+ * The first row of each band is filled and copied down, so the buffer being
+ * filled overlaps the DMA of the previous band.
+ */
+static void direct_fill(struct lcd_gfx_t *gfx, const lcd_gfx_rect_t *rect, uint16_t color)
+{
+    const int width = rect->x2 - rect->x1;
+    const int rows_per_chunk = lcd_flush_get_buffer_size(gfx->flush) / (width * sizeof(uint16_t));
+
+    for (int y = rect->y1; y < rect->y2; y += rows_per_chunk)
+    {
+        int y_end = (y + rows_per_chunk < rect->y2) ? y + rows_per_chunk : rect->y2;
+        uint16_t *buffer = lcd_flush_get_buffer(gfx->flush);
+
+        for (int i = 0; i < width; i++)
+        {
+            buffer[i] = color;
+        }
+        for (int row = 1; row < y_end - y; row++)
+        {
+            memcpy(&buffer[row * width], buffer, width * sizeof(uint16_t));
+        }
+        lcd_flush_submit(gfx->flush, rect->x1, y, rect->x2, y_end);
+    }
+}
+
+void lcd_gfx_fill_rect(lcd_gfx_handle_t gfx, int x, int y, int width, int height, uint16_t color)
+{
+    lcd_gfx_rect_t rect = { x, y, x + width, y + height };
+    if (!gfx || !rect_clip(gfx, &rect))
+    {
+        return;
+    }
+
+    if (!gfx->framebuffer)
+    {
+        direct_fill(gfx, &rect, color);
+        return;
+    }
+
+    lcd_gfx_rect_t changed = { gfx->width, gfx->height, 0, 0 };
+    for (int py = rect.y1; py < rect.y2; py++)
+    {
+        fb_write_row(gfx, rect.x1, py, rect.x2 - rect.x1, &color, true, &changed);
+    }
+    mark_dirty(gfx, changed);
+}
+
+void lcd_gfx_fill_screen(lcd_gfx_handle_t gfx, uint16_t color)
+{
+    if (gfx)
+    {
+        lcd_gfx_fill_rect(gfx, 0, 0, gfx->width, gfx->height, color);
+    }
+}
+
+/**
+ * @brief Fill one row span of a shape, clipped to the screen
+ */
+static void fill_span(struct lcd_gfx_t *gfx, int y, int x1, int x2, uint16_t color, lcd_gfx_rect_t *changed)
+{
+    lcd_gfx_rect_t rect = { x1, y, x2, y + 1 };
+    if (!rect_clip(gfx, &rect))
+    {
+        return;
+    }
+
+    if (gfx->framebuffer)
+    {
+        fb_write_row(gfx, rect.x1, y, rect.x2 - rect.x1, &color, true, changed);
+    }
+    else
+    {
+        direct_fill(gfx, &rect, color);
+    }
+}
+
+void lcd_gfx_fill_circle(lcd_gfx_handle_t gfx, int cx, int cy, int radius, uint16_t color)
+{
+    if (!gfx || radius < 0)
+    {
+        return;
+    }
+
+    lcd_gfx_rect_t changed = { gfx->width, gfx->height, 0, 0 };
+    int x = radius;
+    int y = 0;
+    int d = 1 - radius;
+
+    // Walk one octant; rows cy +/- y are x wide, and rows cy +/- x are emitted
+    // once with their widest y, just before x steps inward
+    while (x >= y)
+    {
+        fill_span(gfx, cy + y, cx - x, cx + x + 1, color, &changed);
+        if (y != 0)
+        {
+            fill_span(gfx, cy - y, cx - x, cx + x + 1, color, &changed);
+        }
+
+        if (d < 0)
+        {
+            y++;
+            d += 2 * y + 1;
+        }
+        else
+        {
+            if (x != y)
+            {
+                fill_span(gfx, cy + x, cx - y, cx + y + 1, color, &changed);
+                fill_span(gfx, cy - x, cx - y, cx + y + 1, color, &changed);
+            }
+            y++;
+            x--;
+            d += 2 * (y - x) + 1;
+        }
+    }
+
+    if (gfx->framebuffer)
+    {
+        mark_dirty(gfx, changed);
+    }
+}
+
+void lcd_gfx_blit(lcd_gfx_handle_t gfx, int x, int y, int width, int height, const uint16_t *pixels)
+{
+    lcd_gfx_rect_t rect = { x, y, x + width, y + height };
+    if (!gfx || !pixels || !rect_clip(gfx, &rect))
+    {
+        return;
+    }
+    const int span = rect.x2 - rect.x1;
+
+    if (gfx->framebuffer)
+    {
+        lcd_gfx_rect_t changed = { gfx->width, gfx->height, 0, 0 };
+        for (int py = rect.y1; py < rect.y2; py++)
+        {
+            fb_write_row(gfx, rect.x1, py, span, &pixels[(py - y) * width + (rect.x1 - x)], false, &changed);
+        }
+        mark_dirty(gfx, changed);
+        return;
+    }
+
+    const int rows_per_chunk = lcd_flush_get_buffer_size(gfx->flush) / (span * sizeof(uint16_t));
+    for (int band = rect.y1; band < rect.y2; band += rows_per_chunk)
+    {
+        int band_end = (band + rows_per_chunk < rect.y2) ? band + rows_per_chunk : rect.y2;
+        uint16_t *buffer = lcd_flush_get_buffer(gfx->flush);
+
+        for (int py = band; py < band_end; py++)
+        {
+            memcpy(&buffer[(py - band) * span], &pixels[(py - y) * width + (rect.x1 - x)], span * sizeof(uint16_t));
+        }
+        lcd_flush_submit(gfx->flush, rect.x1, band, rect.x2, band_end);
+    }
+}
+
+static int font_cols(lcd_gfx_font_t font)
+{
+    return (font == LCD_GFX_FONT_5X8) ? 5 : 8;
+}
+
+static int font_rows(lcd_gfx_font_t font)
+{
+    return (font == LCD_GFX_FONT_5X8) ? 8 : 12;
+}
+
+int lcd_gfx_font_advance(lcd_gfx_font_t font, int scale)
+{
+    // The 8x12 cell already ends in a blank column
+    return ((font == LCD_GFX_FONT_5X8) ? 6 : 8) * scale;
+}
+
+/**
+ * @brief Expand a font character into a scaled, row-major bitmap
+ *
+ * The 5x8 font stores one byte per column (bit = row); the 8x12 font stores
+ * one byte per row (bit = column). Each scaled row is built once and then
+ * copied for the vertical scale.
+ */
+static void glyph_rasterize(lcd_gfx_font_t font, char c, int scale, uint16_t color, uint16_t bg_color, uint16_t *pixels)
+{
+    const int idx = (c < 32 || c > 126) ? 0 : c - 32;
+    const int cols = font_cols(font);
+    const int rows = font_rows(font);
+    const int width = cols * scale;
+
+    for (int row = 0; row < rows; row++)
+    {
+        uint16_t *line_out = &pixels[row * scale * width];
+
+        for (int col = 0; col < cols; col++)
+        {
+            bool set = (font == LCD_GFX_FONT_5X8) ? (font_5x8[idx][col] & (1 << row))
+                                                  : (font_8x12[idx][row] & (1 << col));
+            for (int sx = 0; sx < scale; sx++)
+            {
+                line_out[col * scale + sx] = set ? color : bg_color;
+            }
+        }
+        for (int sy = 1; sy < scale; sy++)
+        {
+            memcpy(&line_out[sy * width], line_out, width * sizeof(uint16_t));
+        }
+    }
+}
+
+/**
+ * @brief Get a cached glyph bitmap, rasterizing it on a miss
+ *
+ * On a miss the least recently used slot is overwritten.
+ *
+ * @return The glyph pixels, or NULL if the cache is disabled or the glyph is larger than a slot
+ */
+static const uint16_t *glyph_cache_get(struct lcd_gfx_t *gfx, lcd_gfx_font_t font, char c, int scale,
+                                       uint16_t color, uint16_t bg_color)
+{
+    const size_t pixels = (size_t)font_cols(font) * font_rows(font) * scale * scale;
+    if (gfx->glyph_cache_slots == 0 || pixels > gfx->glyph_slot_pixels || scale > UINT8_MAX)
+    {
+        return NULL;
+    }
+
+    int victim = 0;
+    for (int i = 0; i < gfx->glyph_cache_slots; i++)
+    {
+        lcd_gfx_glyph_slot_t *slot = &gfx->glyph_slots[i];
+
+        if (slot->last_used != 0 && slot->c == c && slot->font == font && slot->scale == scale &&
+            slot->color == color && slot->bg_color == bg_color)
+        {
+            slot->last_used = ++gfx->glyph_use_counter;
+            gfx->glyph_hits++;
+            return &gfx->glyph_arena[i * gfx->glyph_slot_pixels];
+        }
+        if (slot->last_used < gfx->glyph_slots[victim].last_used)
+        {
+            victim = i;
+        }
+    }
+
+    gfx->glyph_slots[victim] = (lcd_gfx_glyph_slot_t){
+        .last_used = ++gfx->glyph_use_counter,
+        .c = c,
+        .font = (uint8_t)font,
+        .scale = (uint8_t)scale,
+        .color = color,
+        .bg_color = bg_color,
+    };
+    uint16_t *slot_pixels = &gfx->glyph_arena[victim * gfx->glyph_slot_pixels];
+    glyph_rasterize(font, c, scale, color, bg_color, slot_pixels);
+    gfx->glyph_misses++;
+    ESP_LOGD(TAG, "glyph cache miss '%c' (hits=%u, misses=%u)", c, (unsigned)gfx->glyph_hits, (unsigned)gfx->glyph_misses);
+    return slot_pixels;
+}
+
+void lcd_gfx_draw_char(lcd_gfx_handle_t gfx, lcd_gfx_font_t font, char c, int x, int y,
+                       uint16_t color, uint16_t bg_color, int scale)
+{
+    if (!gfx || scale < 1)
+    {
+        return;
+    }
+    const int width = font_cols(font) * scale;
+    const int height = font_rows(font) * scale;
+
+    const uint16_t *glyph = glyph_cache_get(gfx, font, c, scale, color, bg_color);
+    if (glyph != NULL)
+    {
+        lcd_gfx_blit(gfx, x, y, width, height, glyph);
+        return;
+    }
+
+    uint16_t *temp = malloc(width * height * sizeof(uint16_t));
+    if (temp == NULL)
+    {
+        ESP_LOGE(TAG, "no mem for glyph buffer");
+        return;
+    }
+    glyph_rasterize(font, c, scale, color, bg_color, temp);
+    lcd_gfx_blit(gfx, x, y, width, height, temp);
+    free(temp);
+}
+
+int lcd_gfx_draw_string(lcd_gfx_handle_t gfx, lcd_gfx_font_t font, const char *str, int x, int y,
+                        uint16_t color, uint16_t bg_color, int scale)
+{
+    if (!str)
+    {
+        return x;
+    }
+
+    for (int i = 0; str[i] != '\0'; i++)
+    {
+        lcd_gfx_draw_char(gfx, font, str[i], x, y, color, bg_color, scale);
+        x += lcd_gfx_font_advance(font, scale);
+    }
+    return x;
+}
+
+size_t lcd_gfx_flush(lcd_gfx_handle_t gfx)
+{
+    size_t bytes = 0;
+
+    if (!gfx || !gfx->framebuffer)
+    {
+        return 0;
+    }
+
+    const int chunk_pixels = lcd_flush_get_buffer_size(gfx->flush) / sizeof(uint16_t);
+    for (int i = 0; i < gfx->dirty_count; i++)
+    {
+        const lcd_gfx_rect_t *rect = &gfx->dirty[i];
+        const int width = rect->x2 - rect->x1;
+        const int rows_per_chunk = chunk_pixels / width;
+
+        // Copying one buffer overlaps the DMA of the other
+        for (int y = rect->y1; y < rect->y2; y += rows_per_chunk)
+        {
+            int y_end = (y + rows_per_chunk < rect->y2) ? y + rows_per_chunk : rect->y2;
+            uint16_t *buffer = lcd_flush_get_buffer(gfx->flush);
+
+            for (int row = 0; row < y_end - y; row++)
+            {
+                memcpy(&buffer[row * width],
+                       &gfx->framebuffer[(y + row) * gfx->width + rect->x1],
+                       width * sizeof(uint16_t));
+            }
+            lcd_flush_submit(gfx->flush, rect->x1, y, rect->x2, y_end);
+        }
+        bytes += rect_area(rect) * sizeof(uint16_t);
+    }
+
+    if (gfx->dirty_count > 0)
+    {
+        ESP_LOGD(TAG, "flushed %d rect(s), %u bytes", gfx->dirty_count, (unsigned)bytes);
+    }
+    gfx->dirty_count = 0;
+    return bytes;
+}
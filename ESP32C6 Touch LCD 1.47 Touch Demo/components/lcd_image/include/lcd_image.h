@@ -0,0 +1,87 @@
+/**
+ * @file
+ * @brief Streaming image decoder that draws compressed files through lcd_flush
+ *
+ * Images are read from any mounted filesystem in small chunks and decoded
+ * straight into the lcd_flush buffers, one band of full image rows per
+ * buffer. Each band is queued for DMA as soon as it is full, so decoding the
+ * next band overlaps the transfer of the previous one. RAM use is the read
+ * chunk plus the decoder state, whatever the image size.
+ *
+ * Two formats are recognized by their magic:
+ * - QOI ("qoif"), 3 or 4 channels; colors are reduced to RGB565 and alpha
+ *   is ignored.
+ * - RLE565 ("R565"), RGB565 pixels in run and literal packets, written by
+ *   tools/img_to_lcd.py.
+ *
+ * Pixels are written high byte first, the order the panel takes them over SPI.
+ */
+
+#pragma once
+
+#include "esp_err.h"
+#include "lcd_flush.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Image file formats
+ */
+typedef enum {
+    LCD_IMAGE_FORMAT_QOI,       /*!< Quite OK Image format, RGB or RGBA */
+    LCD_IMAGE_FORMAT_RLE565,    /*!< Run-length encoded RGB565 */
+} lcd_image_format_t;
+
+/**
+ * @brief Image header contents
+ */
+typedef struct {
+    lcd_image_format_t format;  /*!< File format */
+    int width;                  /*!< Width in pixels */
+    int height;                 /*!< Height in pixels */
+} lcd_image_info_t;
+
+/**
+ * @brief Read the header of an image file
+ *
+ * @param[in] path File path, including the filesystem mount point
+ * @param[out] info Returned header contents
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_ERR_NOT_FOUND     if the file cannot be opened
+ *          - ESP_ERR_NOT_SUPPORTED if the file is not a QOI or RLE565 image
+ *          - ESP_OK                on success
+ */
+esp_err_t lcd_image_get_info(const char *path, lcd_image_info_t *info);
+
+/**
+ * @brief Decode an image file onto the panel
+ *
+ * Returns once the last band is queued; use lcd_flush_wait_idle() to wait
+ * for it to reach the panel. The image is not clipped, so it must fit the
+ * panel at (`x`, `y`), and one full image row must fit a flush buffer.
+ *
+ * @note  The pixels go straight to the panel. A lcd_gfx framebuffer on the
+ *        same flush context does not see them and will overwrite them on its
+ *        next flush of that area.
+ *
+ * @param[in] flush Flush context
+ * @param[in] path File path, including the filesystem mount point
+ * @param[in] x Left column on the panel
+ * @param[in] y Top row on the panel
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_ERR_NOT_FOUND     if the file cannot be opened
+ *          - ESP_ERR_NOT_SUPPORTED if the file is not a QOI or RLE565 image
+ *          - ESP_ERR_INVALID_SIZE  if a row is larger than a flush buffer, or the data is truncated or corrupt
+ *          - ESP_ERR_NO_MEM        if out of memory
+ *          - ESP_FAIL              if reading the file failed
+ *          - Error from lcd_flush_submit() otherwise
+ */
+esp_err_t lcd_image_draw_file(lcd_flush_handle_t flush, const char *path, int x, int y);
+
+#ifdef __cplusplus
+}
+#endif
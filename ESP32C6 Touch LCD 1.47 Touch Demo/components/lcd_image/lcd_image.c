@@ -0,0 +1,425 @@
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "esp_log.h"
+#include "esp_check.h"
+#include "lcd_image.h"
+
+static const char *TAG = "lcd_image";
+
+#define LCD_IMAGE_READ_CHUNK    1024    // File bytes buffered at a time; must hold the longest packet
+
+#define QOI_HEADER_SIZE         14
+#define QOI_OP_INDEX            0x00
+#define QOI_OP_DIFF             0x40
+#define QOI_OP_LUMA             0x80
+#define QOI_OP_RUN              0xC0
+#define QOI_OP_RGB              0xFE
+#define QOI_OP_RGBA             0xFF
+#define QOI_MASK_2              0xC0
+#define QOI_MAX_OP_SIZE         5
+
+#define RLE565_HEADER_SIZE      8
+#define RLE565_RUN_FLAG         0x80    // Set: run of (n & 0x7F) + 1 copies of one pixel, clear: n + 1 literal pixels
+#define RLE565_MAX_PACKET       128
+
+typedef struct
+{
+    int fd;
+    uint8_t *data;
+    size_t len;                 // bytes held in data
+    size_t pos;                 // next byte to decode
+    bool failed;                // read() reported an error
+} image_reader_t;
+
+typedef struct
+{
+    lcd_flush_handle_t flush;
+    int x;
+    int y;
+    int width;
+    int height;
+    int band_lines;             // full image rows per flush buffer
+    int band_row;               // first image row of the band being filled
+    uint16_t *pixels;           // band being filled, NULL until the next buffer is taken
+    size_t band_pixels;         // pixels in the band being filled
+    size_t filled;              // pixels written to the band so far
+} image_sink_t;
+
+typedef struct
+{
+    uint8_t r, g, b, a;
+} qoi_rgba_t;
+
+/**
+ * @brief Make at least `count` unread bytes available at `data + pos`
+ *
+ * Unread bytes are moved to the front and the rest of the chunk is filled,
+ * so the file is read in large pieces rather than one op at a time.
+ *
+ * @return false at the end of the file or on a read error
+ */
+static bool reader_fill(image_reader_t *reader, size_t count)
+{
+    if (reader->len - reader->pos >= count)
+    {
+        return true;
+    }
+
+    memmove(reader->data, reader->data + reader->pos, reader->len - reader->pos);
+    reader->len -= reader->pos;
+    reader->pos = 0;
+    while (reader->len < count)
+    {
+        ssize_t n = read(reader->fd, reader->data + reader->len, LCD_IMAGE_READ_CHUNK - reader->len);
+        if (n <= 0)
+        {
+            reader->failed = (n < 0);
+            return false;
+        }
+        reader->len += (size_t)n;
+    }
+    return true;
+}
+
+/**
+ * @brief Get the free part of the band being filled, taking a flush buffer if needed
+ *
+ * Blocks only while both flush buffers are still being sent.
+ *
+ * @param[out] room Pixels that can be written before the band is full
+ */
+static uint16_t *sink_span(image_sink_t *sink, size_t *room)
+{
+    if (!sink->pixels)
+    {
+        int lines = sink->height - sink->band_row;
+        if (lines > sink->band_lines)
+        {
+            lines = sink->band_lines;
+        }
+        sink->pixels = (uint16_t *)lcd_flush_get_buffer(sink->flush);
+        sink->band_pixels = (size_t)lines * sink->width;
+        sink->filled = 0;
+    }
+    *room = sink->band_pixels - sink->filled;
+    return sink->pixels + sink->filled;
+}
+
+/**
+ * @brief Account for `count` pixels written after sink_span(), queuing the band once full
+ */
+static esp_err_t sink_advance(image_sink_t *sink, size_t count)
+{
+    sink->filled += count;
+    if (sink->filled < sink->band_pixels)
+    {
+        return ESP_OK;
+    }
+
+    int lines = (int)(sink->band_pixels / sink->width);
+    int top = sink->y + sink->band_row;
+    sink->pixels = NULL;
+    sink->band_row += lines;
+    return lcd_flush_submit(sink->flush, sink->x, top, sink->x + sink->width, top + lines);
+}
+
+static void fill_pixels(uint16_t *out, uint16_t color, size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        out[i] = color;
+    }
+}
+
+static inline uint32_t read_be32(const uint8_t *p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
+}
+
+/**
+ * @brief Reduce a QOI pixel to RGB565, high byte first in memory
+ */
+static inline uint16_t qoi_to_panel(qoi_rgba_t px)
+{
+    uint16_t c = (uint16_t)(((px.r & 0xF8) << 8) | ((px.g & 0xFC) << 3) | (px.b >> 3));
+    return (uint16_t)((c >> 8) | (c << 8));
+}
+
+static inline int qoi_hash(qoi_rgba_t px)
+{
+    return (px.r * 3 + px.g * 5 + px.b * 7 + px.a * 11) % 64;
+}
+
+/**
+ * @brief Decode QOI ops after the header into the sink
+ *
+ * Every valid stream ends with an 8-byte end marker, so a complete op is
+ * always available to reader_fill() until the last pixel.
+ */
+static esp_err_t decode_qoi(image_reader_t *reader, image_sink_t *sink)
+{
+    qoi_rgba_t index[64];
+    qoi_rgba_t px = { .r = 0, .g = 0, .b = 0, .a = 255 };
+    uint16_t color = qoi_to_panel(px);
+    size_t remaining = (size_t)sink->width * sink->height;
+    size_t run = 0;
+
+    memset(index, 0, sizeof(index));
+    while (remaining > 0)
+    {
+        size_t room;
+        uint16_t *out = sink_span(sink, &room);
+        size_t n = 0;
+
+        while (n < room)
+        {
+            if (run > 0)
+            {
+                size_t count = (run < room - n) ? run : room - n;
+                fill_pixels(out + n, color, count);
+                run -= count;
+                n += count;
+                continue;
+            }
+
+            if (!reader_fill(reader, QOI_MAX_OP_SIZE))
+            {
+                return reader->failed ? ESP_FAIL : ESP_ERR_INVALID_SIZE;
+            }
+            const uint8_t *op = reader->data + reader->pos;
+            uint8_t b1 = op[0];
+
+            if (b1 == QOI_OP_RGB)
+            {
+                px.r = op[1];
+                px.g = op[2];
+                px.b = op[3];
+                reader->pos += 4;
+            }
+            else if (b1 == QOI_OP_RGBA)
+            {
+                px.r = op[1];
+                px.g = op[2];
+                px.b = op[3];
+                px.a = op[4];
+                reader->pos += 5;
+            }
+            else if ((b1 & QOI_MASK_2) == QOI_OP_INDEX)
+            {
+                px = index[b1];
+                reader->pos += 1;
+            }
+            else if ((b1 & QOI_MASK_2) == QOI_OP_DIFF)
+            {
+                px.r += ((b1 >> 4) & 0x03) - 2;
+                px.g += ((b1 >> 2) & 0x03) - 2;
+                px.b += (b1 & 0x03) - 2;
+                reader->pos += 1;
+            }
+            else if ((b1 & QOI_MASK_2) == QOI_OP_LUMA)
+            {
+                int vg = (b1 & 0x3F) - 32;
+                px.r += vg - 8 + ((op[1] >> 4) & 0x0F);
+                px.g += vg;
+                px.b += vg - 8 + (op[1] & 0x0F);
+                reader->pos += 2;
+            }
+            else
+            {
+                // The run repeats the previous pixel, which is already indexed and converted
+                run = (size_t)(b1 & 0x3F) + 1;
+                reader->pos += 1;
+                continue;
+            }
+
+            index[qoi_hash(px)] = px;
+            color = qoi_to_panel(px);
+            out[n++] = color;
+        }
+
+        ESP_RETURN_ON_ERROR(sink_advance(sink, n), TAG, "band submit failed");
+        remaining -= n;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Decode RLE565 packets after the header into the sink
+ *
+ * Packets may span rows and bands; a literal that does not fit the band is
+ * copied in parts.
+ */
+static esp_err_t decode_rle565(image_reader_t *reader, image_sink_t *sink)
+{
+    size_t remaining = (size_t)sink->width * sink->height;
+    size_t run = 0;
+    size_t literal = 0;
+    uint16_t color = 0;
+
+    while (remaining > 0)
+    {
+        size_t room;
+        uint16_t *out = sink_span(sink, &room);
+        size_t n = 0;
+
+        while (n < room)
+        {
+            if (run > 0)
+            {
+                size_t count = (run < room - n) ? run : room - n;
+                fill_pixels(out + n, color, count);
+                run -= count;
+                n += count;
+                continue;
+            }
+            if (literal > 0)
+            {
+                size_t count = (literal < room - n) ? literal : room - n;
+                if (!reader_fill(reader, count * sizeof(uint16_t)))
+                {
+                    return reader->failed ? ESP_FAIL : ESP_ERR_INVALID_SIZE;
+                }
+                // Stored high byte first, which is already the panel's order
+                memcpy(out + n, reader->data + reader->pos, count * sizeof(uint16_t));
+                reader->pos += count * sizeof(uint16_t);
+                literal -= count;
+                n += count;
+                continue;
+            }
+
+            if (!reader_fill(reader, 1 + sizeof(uint16_t)))
+            {
+                return reader->failed ? ESP_FAIL : ESP_ERR_INVALID_SIZE;
+            }
+            uint8_t header = reader->data[reader->pos++];
+            if (header & RLE565_RUN_FLAG)
+            {
+                run = (size_t)(header & ~RLE565_RUN_FLAG) + 1;
+                memcpy(&color, reader->data + reader->pos, sizeof(color));
+                reader->pos += sizeof(color);
+            }
+            else
+            {
+                literal = (size_t)header + 1;
+            }
+        }
+
+        ESP_RETURN_ON_ERROR(sink_advance(sink, n), TAG, "band submit failed");
+        remaining -= n;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Parse the header at the start of the reader
+ *
+ * On success the reader is positioned at the first byte of image data.
+ */
+static esp_err_t read_header(image_reader_t *reader, lcd_image_info_t *info)
+{
+    if (!reader_fill(reader, RLE565_HEADER_SIZE))
+    {
+        return reader->failed ? ESP_FAIL : ESP_ERR_NOT_SUPPORTED;
+    }
+    const uint8_t *p = reader->data + reader->pos;
+
+    if (memcmp(p, "R565", 4) == 0)
+    {
+        info->format = LCD_IMAGE_FORMAT_RLE565;
+        info->width = p[4] | (p[5] << 8);
+        info->height = p[6] | (p[7] << 8);
+        reader->pos += RLE565_HEADER_SIZE;
+    }
+    else if (memcmp(p, "qoif", 4) == 0 && reader_fill(reader, QOI_HEADER_SIZE))
+    {
+        p = reader->data + reader->pos;
+        uint32_t width = read_be32(p + 4);
+        uint32_t height = read_be32(p + 8);
+        ESP_RETURN_ON_FALSE(width <= UINT16_MAX && height <= UINT16_MAX && (p[12] == 3 || p[12] == 4),
+                            ESP_ERR_NOT_SUPPORTED, TAG, "unsupported QOI header");
+        info->format = LCD_IMAGE_FORMAT_QOI;
+        info->width = (int)width;
+        info->height = (int)height;
+        reader->pos += QOI_HEADER_SIZE;
+    }
+    else
+    {
+        return reader->failed ? ESP_FAIL : ESP_ERR_NOT_SUPPORTED;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t reader_open(image_reader_t *reader, const char *path)
+{
+    memset(reader, 0, sizeof(*reader));
+    reader->fd = open(path, O_RDONLY);
+    ESP_RETURN_ON_FALSE(reader->fd >= 0, ESP_ERR_NOT_FOUND, TAG, "cannot open %s", path);
+    reader->data = malloc(LCD_IMAGE_READ_CHUNK);
+    if (!reader->data)
+    {
+        close(reader->fd);
+        ESP_LOGE(TAG, "no mem for read buffer");
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+static void reader_close(image_reader_t *reader)
+{
+    free(reader->data);
+    close(reader->fd);
+}
+
+esp_err_t lcd_image_get_info(const char *path, lcd_image_info_t *info)
+{
+    ESP_RETURN_ON_FALSE(path && info, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    image_reader_t reader;
+    ESP_RETURN_ON_ERROR(reader_open(&reader, path), TAG, "open failed");
+    esp_err_t ret = read_header(&reader, info);
+    reader_close(&reader);
+    return ret;
+}
+
+esp_err_t lcd_image_draw_file(lcd_flush_handle_t flush, const char *path, int x, int y)
+{
+    ESP_RETURN_ON_FALSE(flush && path && x >= 0 && y >= 0, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    esp_err_t ret = ESP_OK;
+    image_reader_t reader;
+    lcd_image_info_t info;
+    ESP_RETURN_ON_ERROR(reader_open(&reader, path), TAG, "open failed");
+    ESP_GOTO_ON_ERROR(read_header(&reader, &info), out, TAG, "%s is not a QOI or RLE565 image", path);
+
+    size_t row_bytes = (size_t)info.width * sizeof(uint16_t);
+    ESP_GOTO_ON_FALSE(info.width > 0 && info.height > 0 && row_bytes <= lcd_flush_get_buffer_size(flush),
+                      ESP_ERR_INVALID_SIZE, out, TAG, "%dx%d image does not fit a flush buffer",
+                      info.width, info.height);
+
+    image_sink_t sink = {
+        .flush = flush,
+        .x = x,
+        .y = y,
+        .width = info.width,
+        .height = info.height,
+        .band_lines = (int)(lcd_flush_get_buffer_size(flush) / row_bytes),
+    };
+    if (info.format == LCD_IMAGE_FORMAT_QOI)
+    {
+        ret = decode_qoi(&reader, &sink);
+    }
+    else
+    {
+        ret = decode_rle565(&reader, &sink);
+    }
+    ESP_GOTO_ON_ERROR(ret, out, TAG, "decoding %s failed at row %d", path, sink.band_row);
+    ESP_LOGD(TAG, "%s: %dx%d in bands of %d rows", path, info.width, info.height, sink.band_lines);
+
+out:
+    reader_close(&reader);
+    return ret;
+}
@@ -12,12 +12,15 @@
  * 
  */
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
-#include "font_5x8.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_attr.h"
 #include "esp_log.h"
 #include "esp_system.h"
+#include "esp_timer.h"
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
 #include "driver/i2c_master.h"
@@ -27,6 +30,10 @@
 #include "esp_lcd_jd9853.h"
 #include "esp_lcd_touch.h"
 #include "esp_lcd_touch_axs5106.h"
+#include "esp_littlefs.h"
+#include "lcd_flush.h"
+#include "lcd_gfx.h"
+#include "lcd_image.h"
 
 // Tag for logging
 static const char *TAG = "MAIN";
@@ -52,6 +59,34 @@ static const char *TAG = "MAIN";
 #define LCD_WIDTH       172
 #define LCD_HEIGHT      320
 #define LCD_PIXEL_CLOCK (80 * 1000 * 1000)
+#define LCD_FLUSH_LINES 20      // Full-width lines per DMA buffer; two buffers are allocated
+#define LCD_FONT_SCALE  2
+#define GLYPH_CACHE_SLOTS 24    // Scaled 5x8 glyphs kept; the test screens use about 20
+
+// Image assets, converted at build time from ../assets (see main/CMakeLists.txt)
+#ifndef ASSET_EXT
+#define ASSET_EXT       ".qoi"
+#endif
+#define ASSETS_PARTITION "assets"
+#define ASSETS_BASE_PATH "/assets"
+#define SPLASH_IMAGE    ASSETS_BASE_PATH "/splash" ASSET_EXT
+#define SPLASH_HOLD_MS  1500    // Time the boot splash stays up before the touch test screen
+
+// Touch event settings
+#define TOUCH_REPORT_INTERVAL_MS  33    // Minimum spacing of reads and MOVE events while pressed (about 30 Hz)
+#define TOUCH_RELEASE_TIMEOUT_MS  100   // Without an INT for this long while pressed, read once to check for a release
+#define TOUCH_EVENT_QUEUE_LEN     16
+#define TOUCH_TAP_MAX_MS          300   // Longest press still reported as a tap
+#define TOUCH_TAP_MAX_MOVE        12    // Pixels a tap or long press may drift
+#define TOUCH_LONG_PRESS_MS       700
+#define TOUCH_SWIPE_MIN_MOVE      50    // Pixels along the dominant axis
+#define TOUCH_SWIPE_MAX_MS        600
+
+// Touch-to-pixel latency instrumentation, off by default
+#define LATENCY_BENCH_ENABLE      0     // 1 to timestamp each redraw and log a latency histogram
+#define LATENCY_PROBE_GPIO        4     // High from the INT edge until the redraw's last DMA completes, for a scope
+#define LATENCY_BENCH_REPORT_EVERY 50   // Redraws between histogram reports
+#define LATENCY_BENCH_BUCKETS     10    // Bucket i holds samples below (250 << i) us; the last one is open-ended
 
 // Color definitions in RGB565 format
 #define COLOR_BLACK     0x0000
@@ -66,118 +101,77 @@ static const char *TAG = "MAIN";
 // Global handles
 static esp_lcd_panel_io_handle_t io_handle = NULL;
 static esp_lcd_panel_handle_t panel_handle = NULL;
+static lcd_flush_handle_t flush_handle = NULL;
+static lcd_gfx_handle_t gfx_handle = NULL;
 static esp_lcd_touch_handle_t touch_handle = NULL;
 static i2c_master_bus_handle_t i2c_bus_handle = NULL;
+static bool assets_mounted = false;
 
-/**
- * @brief Map a character to its corresponding font index.
- * 
- * @param c The character to map.
- * @return int The index of the character in the font array.
- */
-static int char_to_index(char c) {
-      if (c < 32 || c > 126) {
-          return 0;  // Return space for invalid characters
-      }
-      return c - 32;
-}
+// Touch events, raw contact changes and decoded gestures
+typedef enum {
+    TOUCH_EVENT_DOWN,
+    TOUCH_EVENT_MOVE,
+    TOUCH_EVENT_UP,
+    TOUCH_EVENT_TAP,
+    TOUCH_EVENT_LONG_PRESS,
+    TOUCH_EVENT_SWIPE_LEFT,
+    TOUCH_EVENT_SWIPE_RIGHT,
+    TOUCH_EVENT_SWIPE_UP,
+    TOUCH_EVENT_SWIPE_DOWN,
+} touch_event_type_t;
 
-/**
- * @brief Draw a character on the LCD panel
- * 
- * @param c Character to draw
- * @param x X coordinate of the top-left corner
- * @param y Y coordinate of the top-left corner
- * @param color Color of the character
- * @param bg_color Background color of the character
- * @param scale Scale factor for the character size
- */
-static void draw_char(char c, int x, int y, uint16_t color, uint16_t bg_color, int scale) {
-    int idx = char_to_index(c);
-    
-    for (int col = 0; col < 5; col++) {
-        uint8_t line = font_5x8[idx][col];
-        for (int row = 0; row < 8; row++) {
-            uint16_t pixel_color = (line & (1 << row)) ? color : bg_color;
-            
-            for (int sx = 0; sx < scale; sx++) {
-                for (int sy = 0; sy < scale; sy++) {
-                    int px = x + col * scale + sx;
-                    int py = y + row * scale + sy;
-                    if (px < LCD_WIDTH && py < LCD_HEIGHT) {
-                        esp_lcd_panel_draw_bitmap(panel_handle, px, py, px + 1, py + 1, &pixel_color);
-                    }
-                }
-            }
-        }
-    }
-}
+typedef struct {
+    touch_event_type_t type;
+    int16_t x;                  // Position of the sample; start point for gestures
+    int16_t y;
+    int64_t timestamp_us;       // esp_timer time of the INT edge, or of the read for polled samples
+    int64_t read_done_us;       // esp_timer time the I2C read that produced the event completed
+} touch_event_t;
 
-/**
- * @brief Draw a string on the LCD panel
- * 
- * @param str String to draw
- * @param x X coordinate of the top-left corner
- * @param y Y coordinate of the top-left corner
- * @param color Color of the string
- * @param bg_color Background color of the string
- * @param scale Scale factor for the string size
- */
-static void draw_string(const char *str, int x, int y, uint16_t color, uint16_t bg_color, int scale) {
-    int cursor_x = x;
-    for (int i = 0; str[i] != '\0'; i++) {
-        draw_char(str[i], cursor_x, y, color, bg_color, scale);
-        cursor_x += (6 * scale);
-    }
-}
+// Gesture decoder state for the contact in progress
+typedef struct {
+    bool pressed;
+    bool long_press_sent;
+    int16_t start_x;
+    int16_t start_y;
+    int16_t last_x;
+    int16_t last_y;
+    int64_t start_us;
+    int64_t last_move_us;       // Time of the last queued MOVE, for report-rate throttling
+} touch_gesture_t;
 
-/**
- * @brief Fill the entire screen with a single color
- * 
- * @param color Color to fill the screen with
- */
-static void fill_screen(uint16_t color)
-{
-    const int lines_per_chunk = 10;
-    uint16_t *buffer = malloc(LCD_WIDTH * lines_per_chunk * sizeof(uint16_t));
-    if (buffer == NULL) {
-        ESP_LOGE(TAG, "Failed to allocate buffer");
-        return;
-    }
-    
-    for (int i = 0; i < LCD_WIDTH * lines_per_chunk; i++) {
-        buffer[i] = color;
-    }
-    
-    for (int y = 0; y < LCD_HEIGHT; y += lines_per_chunk) {
-        int lines = (y + lines_per_chunk <= LCD_HEIGHT) ? lines_per_chunk : (LCD_HEIGHT - y);
-        esp_lcd_panel_draw_bitmap(panel_handle, 0, y, LCD_WIDTH, y + lines, buffer);
-    }
-    
-    free(buffer);
-}
+static TaskHandle_t touch_task_handle = NULL;
+static QueueHandle_t touch_event_queue = NULL;
+static int64_t touch_irq_time_us = 0;      // Time of the latest INT edge, guarded by touch_irq_lock
+static portMUX_TYPE touch_irq_lock = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t touch_events_dropped = 0;
 
-/**
- * @brief Draw a filled circle on the LCD panel
- * 
- * @param cx X coordinate of the circle center
- * @param cy Y coordinate of the circle center
- * @param radius Radius of the circle
- * @param color Color of the circle
- */
-static void draw_circle(int cx, int cy, int radius, uint16_t color) {
-    for (int y = -radius; y <= radius; y++) {
-        for (int x = -radius; x <= radius; x++) {
-            if (x*x + y*y <= radius*radius) {
-                int px = cx + x;
-                int py = cy + y;
-                if (px >= 0 && px < LCD_WIDTH && py >= 0 && py < LCD_HEIGHT) {
-                    esp_lcd_panel_draw_bitmap(panel_handle, px, py, px + 1, py + 1, &color);
-                }
-            }
-        }
-    }
-}
+#if LATENCY_BENCH_ENABLE
+// Touch-to-pixel pipeline stages, each measured from the end of the previous one
+typedef enum {
+    LATENCY_STAGE_I2C,          // INT edge to I2C read complete
+    LATENCY_STAGE_QUEUE,        // Read complete to ui_task starting the redraw
+    LATENCY_STAGE_RENDER,       // Redraw start until the last region is queued
+    LATENCY_STAGE_DMA,          // Last region queued until its SPI DMA completes
+    LATENCY_STAGE_TOTAL,        // INT edge to pixels on glass
+    LATENCY_STAGE_COUNT,
+} latency_stage_t;
+
+static const char *const latency_stage_names[LATENCY_STAGE_COUNT] = {
+    "i2c", "queue", "render", "dma", "total",
+};
+
+// Per-stage histograms and extremes, only touched by ui_task
+typedef struct {
+    uint32_t buckets[LATENCY_STAGE_COUNT][LATENCY_BENCH_BUCKETS];
+    int64_t min_us[LATENCY_STAGE_COUNT];
+    int64_t max_us[LATENCY_STAGE_COUNT];
+    int64_t sum_us[LATENCY_STAGE_COUNT];
+    uint32_t samples;
+} latency_bench_t;
+
+static latency_bench_t latency_bench;
+#endif
 
 /**
  * @brief Initialize the backlight using LEDC PWM
@@ -245,6 +239,25 @@ static esp_err_t display_init(void)
     ESP_ERROR_CHECK(esp_lcd_panel_disp_on_off(panel_handle, true));
     ESP_ERROR_CHECK(esp_lcd_panel_set_gap(panel_handle, 34, 0));
     
+    // Double-buffered flush path used by all drawing
+    lcd_flush_config_t flush_config = {
+        .io = io_handle,
+        .panel = panel_handle,
+        .buffer_size = LCD_WIDTH * LCD_FLUSH_LINES * sizeof(uint16_t),
+    };
+    ESP_ERROR_CHECK(lcd_flush_new(&flush_config, &flush_handle));
+    
+    // Draw straight through the flush buffers; glyphs are cached pre-scaled
+    lcd_gfx_config_t gfx_config = {
+        .flush = flush_handle,
+        .width = LCD_WIDTH,
+        .height = LCD_HEIGHT,
+        .use_framebuffer = false,
+        .glyph_cache_slots = GLYPH_CACHE_SLOTS,
+        .glyph_slot_pixels = 5 * 8 * LCD_FONT_SCALE * LCD_FONT_SCALE,
+    };
+    ESP_ERROR_CHECK(lcd_gfx_new(&gfx_config, &gfx_handle));
+    
     ESP_LOGI(TAG, "Display initialized successfully");
     
     return ESP_OK;
@@ -272,6 +285,30 @@ static esp_err_t i2c_init(void)
     return ESP_OK;
 }
 
+/**
+ * @brief Touch INT handler, wakes the touch task
+ * 
+ * Runs in interrupt context; only the edge time is recorded here and the
+ * I2C read is left to touch_task.
+ * 
+ * @param tp The touch handle (not used)
+ */
+static void IRAM_ATTR touch_isr(esp_lcd_touch_handle_t tp)
+{
+    BaseType_t higher_priority_woken = pdFALSE;
+
+#if LATENCY_BENCH_ENABLE
+    gpio_set_level(LATENCY_PROBE_GPIO, 1);
+#endif
+    portENTER_CRITICAL_ISR(&touch_irq_lock);
+    touch_irq_time_us = esp_timer_get_time();
+    portEXIT_CRITICAL_ISR(&touch_irq_lock);
+    if (touch_task_handle != NULL) {
+        vTaskNotifyGiveFromISR(touch_task_handle, &higher_priority_woken);
+    }
+    portYIELD_FROM_ISR(higher_priority_woken);
+}
+
 /**
  * @brief Initialize the touch controller
  * 
@@ -293,6 +330,10 @@ static esp_err_t touch_init(void)
         .y_max = LCD_HEIGHT,
         .rst_gpio_num = PIN_TOUCH_RST,
         .int_gpio_num = PIN_TOUCH_INT,
+        .levels = {
+            .interrupt = 0,     // INT pulses low when a report is ready
+        },
+        .interrupt_callback = touch_isr,
         .flags = {
             .swap_xy = 0,
             .mirror_x = 1,
@@ -306,64 +347,399 @@ static esp_err_t touch_init(void)
     return ESP_OK;
 }
 
+/**
+ * @brief Mount the read-only image partition
+ * 
+ * The demo runs without images if the partition is missing or was not
+ * flashed, so a failure is only logged.
+ * 
+ * @return esp_err_t ESP_OK on success, error code otherwise
+ */
+static esp_err_t assets_mount(void)
+{
+    esp_vfs_littlefs_conf_t conf = {
+        .base_path = ASSETS_BASE_PATH,
+        .partition_label = ASSETS_PARTITION,
+        .format_if_mount_failed = false,
+        .dont_mount = false,
+    };
+
+    esp_err_t ret = esp_vfs_littlefs_register(&conf);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Image partition not mounted: %s", esp_err_to_name(ret));
+        return ret;
+    }
+    assets_mounted = true;
+    ESP_LOGI(TAG, "Image partition mounted at %s", ASSETS_BASE_PATH);
+    return ESP_OK;
+}
+
+/**
+ * @brief Decode an image file centered on the screen and wait for it to reach the panel
+ * 
+ * @param path The image path, including the mount point.
+ * @return esp_err_t ESP_OK on success, error code otherwise 
+ */
+static esp_err_t display_image(const char *path)
+{
+    lcd_image_info_t info;
+
+    if (!assets_mounted) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    esp_err_t ret = lcd_image_get_info(path, &info);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    if (info.width > LCD_WIDTH || info.height > LCD_HEIGHT) {
+        ESP_LOGW(TAG, "%s is %dx%d, larger than the screen", path, info.width, info.height);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    // Border first, so a smaller image does not leave the previous screen around it
+    if (info.width < LCD_WIDTH || info.height < LCD_HEIGHT) {
+        lcd_gfx_fill_screen(gfx_handle, COLOR_BLACK);
+    }
+    int64_t start_us = esp_timer_get_time();
+    ret = lcd_image_draw_file(flush_handle, path, (LCD_WIDTH - info.width) / 2, (LCD_HEIGHT - info.height) / 2);
+    lcd_flush_wait_idle(flush_handle, portMAX_DELAY);
+    if (ret == ESP_OK) {
+        ESP_LOGI(TAG, "Drew %s (%dx%d) in %lld us", path, info.width, info.height,
+                 esp_timer_get_time() - start_us);
+    }
+    return ret;
+}
+
 /**
  * @brief Display the initial touch test screen
  * 
  */
 static void display_touch_test(void)
 {
-    fill_screen(COLOR_WHITE);
-    draw_string("Touch Test", 25, 80, COLOR_BLACK, COLOR_WHITE, 2);
-    draw_string("Mode", 45, 110, COLOR_BLACK, COLOR_WHITE, 2);
-    draw_string("Tap anywhere", 10, 160, COLOR_BLUE, COLOR_WHITE, 2);
-    draw_string("on screen", 20, 190, COLOR_BLUE, COLOR_WHITE, 2);
+    lcd_gfx_fill_screen(gfx_handle, COLOR_WHITE);
+    lcd_gfx_draw_string(gfx_handle, LCD_GFX_FONT_5X8, "Touch Test", 25, 80, COLOR_BLACK, COLOR_WHITE, LCD_FONT_SCALE);
+    lcd_gfx_draw_string(gfx_handle, LCD_GFX_FONT_5X8, "Mode", 45, 110, COLOR_BLACK, COLOR_WHITE, LCD_FONT_SCALE);
+    lcd_gfx_draw_string(gfx_handle, LCD_GFX_FONT_5X8, "Tap anywhere", 10, 160, COLOR_BLUE, COLOR_WHITE, LCD_FONT_SCALE);
+    lcd_gfx_draw_string(gfx_handle, LCD_GFX_FONT_5X8, "on screen", 20, 190, COLOR_BLUE, COLOR_WHITE, LCD_FONT_SCALE);
+}
+
+/**
+ * @brief Queue a touch event without blocking the reader.
+ * 
+ * If the UI falls behind, the event is dropped and counted instead of
+ * stalling I2C reads.
+ * 
+ * @param type The event type.
+ * @param x The x-coordinate.
+ * @param y The y-coordinate.
+ * @param timestamp_us The event time in microseconds.
+ */
+static void touch_post_event(touch_event_type_t type, int x, int y, int64_t timestamp_us)
+{
+    touch_event_t event = {
+        .type = type,
+        .x = (int16_t)x,
+        .y = (int16_t)y,
+        .timestamp_us = timestamp_us,
+        .read_done_us = esp_timer_get_time(),  // Events are posted right after the read that produced them
+    };
+    if (xQueueSend(touch_event_queue, &event, 0) != pdTRUE) {
+        touch_events_dropped++;
+        ESP_LOGW(TAG, "Touch event queue full, %u events dropped", (unsigned)touch_events_dropped);
+    }
+}
+
+/**
+ * @brief Feed one touch sample to the gesture decoder.
+ * 
+ * Queues DOWN, throttled MOVE and UP events for the contact, plus a
+ * LONG_PRESS while it is held still and a TAP or SWIPE when it ends.
+ * 
+ * @param g The gesture state.
+ * @param pressed Whether the panel reports a contact.
+ * @param x The x-coordinate of the contact, if pressed.
+ * @param y The y-coordinate of the contact, if pressed.
+ * @param timestamp_us The sample time in microseconds.
+ */
+static void touch_gesture_update(touch_gesture_t *g, bool pressed, int x, int y, int64_t timestamp_us)
+{
+    if (pressed && !g->pressed) {
+        *g = (touch_gesture_t){
+            .pressed = true,
+            .start_x = x,
+            .start_y = y,
+            .last_x = x,
+            .last_y = y,
+            .start_us = timestamp_us,
+            .last_move_us = timestamp_us,
+        };
+        touch_post_event(TOUCH_EVENT_DOWN, x, y, timestamp_us);
+        return;
+    }
+
+    if (!g->pressed) {
+        return;
+    }
+
+    if (pressed) {
+        if ((x != g->last_x || y != g->last_y) &&
+            timestamp_us - g->last_move_us >= TOUCH_REPORT_INTERVAL_MS * 1000LL) {
+            touch_post_event(TOUCH_EVENT_MOVE, x, y, timestamp_us);
+            g->last_move_us = timestamp_us;
+        }
+        g->last_x = x;
+        g->last_y = y;
+    }
+
+    const int dx = g->last_x - g->start_x;
+    const int dy = g->last_y - g->start_y;
+    const bool still = abs(dx) <= TOUCH_TAP_MAX_MOVE && abs(dy) <= TOUCH_TAP_MAX_MOVE;
+    const int64_t held_ms = (timestamp_us - g->start_us) / 1000;
+
+    if (pressed) {
+        if (still && !g->long_press_sent && held_ms >= TOUCH_LONG_PRESS_MS) {
+            touch_post_event(TOUCH_EVENT_LONG_PRESS, g->start_x, g->start_y, timestamp_us);
+            g->long_press_sent = true;
+        }
+        return;
+    }
+
+    // Contact ended: report where it was last seen, then classify it
+    g->pressed = false;
+    touch_post_event(TOUCH_EVENT_UP, g->last_x, g->last_y, timestamp_us);
+    if (g->long_press_sent) {
+        return;
+    }
+
+    if (held_ms <= TOUCH_SWIPE_MAX_MS && (abs(dx) >= TOUCH_SWIPE_MIN_MOVE || abs(dy) >= TOUCH_SWIPE_MIN_MOVE)) {
+        touch_event_type_t type;
+        if (abs(dx) >= abs(dy)) {
+            type = (dx > 0) ? TOUCH_EVENT_SWIPE_RIGHT : TOUCH_EVENT_SWIPE_LEFT;
+        } else {
+            type = (dy > 0) ? TOUCH_EVENT_SWIPE_DOWN : TOUCH_EVENT_SWIPE_UP;
+        }
+        touch_post_event(type, g->start_x, g->start_y, timestamp_us);
+    } else if (still && held_ms <= TOUCH_TAP_MAX_MS) {
+        touch_post_event(TOUCH_EVENT_TAP, g->start_x, g->start_y, timestamp_us);
+    }
 }
 
 /**
- * @brief Touch task to handle touch input and update display
+ * @brief Touch reader task, woken by the INT pin
+ * 
+ * While nothing touches the panel the task blocks on its notification, so
+ * there is no I2C traffic. Each INT edge triggers one read; while pressed,
+ * reads are spaced at least TOUCH_REPORT_INTERVAL_MS apart and edges that
+ * arrive in between collapse into one notification. If INT stays quiet for
+ * TOUCH_RELEASE_TIMEOUT_MS during a contact, one read is made anyway so a
+ * release and a long press are still detected.
  * 
  * @param pvParameters Pointer to task parameters (not used) 
  */
 static void touch_task(void *pvParameters)
 {
-    esp_lcd_touch_point_data_t touchpad_data[1];
+    esp_lcd_touch_point_data_t touchpad_data[1] = { 0 };
     uint8_t touchpad_cnt = 0;
+    touch_gesture_t gesture = { 0 };
+    
+    ESP_LOGI(TAG, "Touch task started");
+    
+    while (1) {
+        TickType_t wait = gesture.pressed ? pdMS_TO_TICKS(TOUCH_RELEASE_TIMEOUT_MS) : portMAX_DELAY;
+        bool woken = ulTaskNotifyTake(pdTRUE, wait) > 0;
+        int64_t timestamp_us = esp_timer_get_time();
+        if (woken) {
+            portENTER_CRITICAL(&touch_irq_lock);
+            timestamp_us = touch_irq_time_us;
+            portEXIT_CRITICAL(&touch_irq_lock);
+        }
+
+        if (esp_lcd_touch_read_data(touch_handle) != ESP_OK) {
+            continue;
+        }
+        esp_err_t ret = esp_lcd_touch_get_data(touch_handle, touchpad_data, &touchpad_cnt, 1);
+        bool pressed = (ret == ESP_OK && touchpad_cnt > 0);
+
+        touch_gesture_update(&gesture, pressed, touchpad_data[0].x, touchpad_data[0].y, timestamp_us);
+
+        if (gesture.pressed) {
+            vTaskDelay(pdMS_TO_TICKS(TOUCH_REPORT_INTERVAL_MS));
+        }
+    }
+}
+
+#if LATENCY_BENCH_ENABLE
+/**
+ * @brief Configure the latency probe pin and clear the histograms.
+ * 
+ */
+static void latency_bench_init(void)
+{
+    gpio_config_t io_conf = {
+        .pin_bit_mask = 1ULL << LATENCY_PROBE_GPIO,
+        .mode = GPIO_MODE_OUTPUT,
+    };
+    ESP_ERROR_CHECK(gpio_config(&io_conf));
+    gpio_set_level(LATENCY_PROBE_GPIO, 0);
+
+    memset(&latency_bench, 0, sizeof(latency_bench));
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        latency_bench.min_us[s] = INT64_MAX;
+    }
+    ESP_LOGI(TAG, "Latency bench enabled (probe GPIO %d)", LATENCY_PROBE_GPIO);
+}
+
+/**
+ * @brief Log the per-stage latency histograms and start a new window.
+ * 
+ */
+static void latency_bench_report(void)
+{
+    ESP_LOGI(TAG, "Touch-to-pixel latency over %u redraws (us):", (unsigned)latency_bench.samples);
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        char line[128];
+        int len = snprintf(line, sizeof(line), "%-6s min %6lld avg %6lld max %6lld |",
+                           latency_stage_names[s],
+                           latency_bench.min_us[s],
+                           latency_bench.sum_us[s] / latency_bench.samples,
+                           latency_bench.max_us[s]);
+        for (int b = 0; b < LATENCY_BENCH_BUCKETS && len < (int)sizeof(line); b++) {
+            len += snprintf(line + len, sizeof(line) - len, " %3u", (unsigned)latency_bench.buckets[s][b]);
+        }
+        ESP_LOGI(TAG, "%s", line);
+    }
+    ESP_LOGI(TAG, "buckets: <250 <500 <1m <2m <4m <8m <16m <32m <64m >=64m");
+
+    memset(&latency_bench, 0, sizeof(latency_bench));
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        latency_bench.min_us[s] = INT64_MAX;
+    }
+}
+
+/**
+ * @brief Record the timestamps of one redraw.
+ * 
+ * @param event The touch event that triggered the redraw.
+ * @param render_start_us Time ui_task started drawing.
+ * @param render_end_us Time the last region was queued.
+ * @param dma_done_us Time the last transfer completed.
+ */
+static void latency_bench_record(const touch_event_t *event, int64_t render_start_us,
+                                 int64_t render_end_us, int64_t dma_done_us)
+{
+    const int64_t stage_us[LATENCY_STAGE_COUNT] = {
+        [LATENCY_STAGE_I2C]    = event->read_done_us - event->timestamp_us,
+        [LATENCY_STAGE_QUEUE]  = render_start_us - event->read_done_us,
+        [LATENCY_STAGE_RENDER] = render_end_us - render_start_us,
+        [LATENCY_STAGE_DMA]    = dma_done_us - render_end_us,
+        [LATENCY_STAGE_TOTAL]  = dma_done_us - event->timestamp_us,
+    };
+
+    for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+        int b = 0;
+        while (b < LATENCY_BENCH_BUCKETS - 1 && stage_us[s] >= (250LL << b)) {
+            b++;
+        }
+        latency_bench.buckets[s][b]++;
+        latency_bench.sum_us[s] += stage_us[s];
+        if (stage_us[s] < latency_bench.min_us[s]) {
+            latency_bench.min_us[s] = stage_us[s];
+        }
+        if (stage_us[s] > latency_bench.max_us[s]) {
+            latency_bench.max_us[s] = stage_us[s];
+        }
+    }
+
+    if (++latency_bench.samples >= LATENCY_BENCH_REPORT_EVERY) {
+        latency_bench_report();
+    }
+}
+#endif
+
+/**
+ * @brief Get a display name for a gesture event.
+ * 
+ * @param type The event type.
+ * @return const char* The name, or NULL for raw contact events.
+ */
+static const char *touch_gesture_name(touch_event_type_t type)
+{
+    switch (type) {
+    case TOUCH_EVENT_TAP:         return "Tap";
+    case TOUCH_EVENT_LONG_PRESS:  return "Long press";
+    case TOUCH_EVENT_SWIPE_LEFT:  return "Swipe left";
+    case TOUCH_EVENT_SWIPE_RIGHT: return "Swipe right";
+    case TOUCH_EVENT_SWIPE_UP:    return "Swipe up";
+    case TOUCH_EVENT_SWIPE_DOWN:  return "Swipe down";
+    default:                      return NULL;
+    }
+}
+
+/**
+ * @brief UI task to draw touch events from the event queue
+ * 
+ * @param pvParameters Pointer to task parameters (not used) 
+ */
+static void ui_task(void *pvParameters)
+{
+    touch_event_t event;
     char coord_str[32];
     int last_x = -1, last_y = -1;
     
-    ESP_LOGI(TAG, "Touch task started");
+    if (display_image(SPLASH_IMAGE) == ESP_OK) {
+        vTaskDelay(pdMS_TO_TICKS(SPLASH_HOLD_MS));
+    }
     display_touch_test();
     
     while (1) {
-        esp_lcd_touch_read_data(touch_handle);
-        
-        // Get touch data from touch controller
-        esp_err_t ret = esp_lcd_touch_get_data(touch_handle, touchpad_data, &touchpad_cnt, 1);
-        
-        if (ret == ESP_OK && touchpad_cnt > 0) {
-            int x = touchpad_data[0].x;
-            int y = touchpad_data[0].y;
-            
-            if (x != last_x || y != last_y) {
-                ESP_LOGI(TAG, "Touch at X=%d, Y=%d", x, y);
-                
-                fill_screen(COLOR_WHITE);
-                draw_string("Touch at:", 25, 80, COLOR_BLACK, COLOR_WHITE, 2);
-                
-                sprintf(coord_str, "X: %d", x);
-                draw_string(coord_str, 40, 120, COLOR_BLUE, COLOR_WHITE, 2);
-                
-                sprintf(coord_str, "Y: %d", y);
-                draw_string(coord_str, 40, 150, COLOR_BLUE, COLOR_WHITE, 2);
-                
-                draw_circle(x, y, 12, COLOR_RED);
-                
-                last_x = x;
-                last_y = y;
+        if (xQueueReceive(touch_event_queue, &event, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+        int latency_us = (int)(esp_timer_get_time() - event.timestamp_us);
+
+        const char *gesture = touch_gesture_name(event.type);
+        if (gesture != NULL) {
+            ESP_LOGI(TAG, "%s at X=%d, Y=%d", gesture, event.x, event.y);
+            // A long press brings the splash back until the next touch
+            if (event.type == TOUCH_EVENT_LONG_PRESS && display_image(SPLASH_IMAGE) == ESP_OK) {
+                last_x = -1;
+                continue;
             }
+            lcd_gfx_fill_rect(gfx_handle, 0, 230, LCD_WIDTH, 8 * LCD_FONT_SCALE, COLOR_WHITE);
+            lcd_gfx_draw_string(gfx_handle, LCD_GFX_FONT_5X8, gesture, 20, 230, COLOR_MAGENTA, COLOR_WHITE, LCD_FONT_SCALE);
+            continue;
+        }
+        if (event.x == last_x && event.y == last_y) {
+            continue;
         }
+
+        ESP_LOGI(TAG, "Touch at X=%d, Y=%d (%d us after INT)", event.x, event.y, latency_us);
+        
+#if LATENCY_BENCH_ENABLE
+        int64_t render_start_us = esp_timer_get_time();
+#endif
+        lcd_gfx_fill_screen(gfx_handle, COLOR_WHITE);
+        lcd_gfx_draw_string(gfx_handle, LCD_GFX_FONT_5X8, "Touch at:", 25, 80, COLOR_BLACK, COLOR_WHITE, LCD_FONT_SCALE);
+        
+        sprintf(coord_str, "X: %d", event.x);
+        lcd_gfx_draw_string(gfx_handle, LCD_GFX_FONT_5X8, coord_str, 40, 120, COLOR_BLUE, COLOR_WHITE, LCD_FONT_SCALE);
+        
+        sprintf(coord_str, "Y: %d", event.y);
+        lcd_gfx_draw_string(gfx_handle, LCD_GFX_FONT_5X8, coord_str, 40, 150, COLOR_BLUE, COLOR_WHITE, LCD_FONT_SCALE);
         
-        vTaskDelay(pdMS_TO_TICKS(50));
+        lcd_gfx_fill_circle(gfx_handle, event.x, event.y, 12, COLOR_RED);
+        
+#if LATENCY_BENCH_ENABLE
+        // Waiting here serializes redraws, which is what the measurement wants
+        int64_t render_end_us = esp_timer_get_time();
+        lcd_flush_wait_idle(flush_handle, portMAX_DELAY);
+        int64_t dma_done_us = esp_timer_get_time();
+        gpio_set_level(LATENCY_PROBE_GPIO, 0);
+        latency_bench_record(&event, render_start_us, render_end_us, dma_done_us);
+#endif
+
+        last_x = event.x;
+        last_y = event.y;
     }
 }
 
@@ -386,9 +762,22 @@ void app_main(void)
 
     // Initialize touch controller
     ESP_ERROR_CHECK(touch_init());
+
+    // Mount the image partition; the demo still runs without it
+    assets_mount();
+
+#if LATENCY_BENCH_ENABLE
+    latency_bench_init();
+#endif
     
-    // Create touch handling task
-    xTaskCreate(touch_task, "touch_task", 4096, NULL, 5, NULL);
+    // Create the touch reader and the UI task that draws its events
+    touch_event_queue = xQueueCreate(TOUCH_EVENT_QUEUE_LEN, sizeof(touch_event_t));
+    if (touch_event_queue == NULL) {
+        ESP_LOGE(TAG, "Failed to create touch event queue");
+        return;
+    }
+    xTaskCreate(ui_task, "ui_task", 4096, NULL, 4, NULL);
+    xTaskCreate(touch_task, "touch_task", 4096, NULL, 5, &touch_task_handle);
     
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(1000));
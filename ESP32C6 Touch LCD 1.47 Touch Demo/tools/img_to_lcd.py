@@ -0,0 +1,262 @@
+#!/usr/bin/env python3
+"""Convert PNG or PPM images into the compressed formats read by lcd_image.
+
+Colors are reduced to RGB565 before encoding, and any alpha is blended over
+a background color, since the panel has neither more color depth nor
+transparency. Only the Python standard library is used, so the script can
+run as part of the ESP-IDF build.
+
+The output format follows the extension of the output file:
+
+    .qoi    Standard QOI, 3 channels. Because the colors are already reduced,
+            runs and index hits are more frequent than in a full-color QOI,
+            and the file still opens in any QOI viewer.
+    .rle    RLE565, laid out as:
+                "R565" u16le width, u16le height
+                1nnnnnnn p0 p1          n+1 copies of one pixel
+                0nnnnnnn p0 p1 ...      n+1 literal pixels
+            Pixels are RGB565, high byte first. Packets may wrap rows.
+
+Usage: img_to_lcd.py <input.png|input.ppm> <output.qoi|output.rle> [--background RRGGBB]
+       img_to_lcd.py --dir <input_dir> <output_dir> --format qoi|rle [--background RRGGBB]
+"""
+
+import os
+import struct
+import sys
+import zlib
+
+QOI_OP_INDEX = 0x00
+QOI_OP_DIFF = 0x40
+QOI_OP_LUMA = 0x80
+QOI_OP_RUN = 0xC0
+QOI_OP_RGB = 0xFE
+QOI_MAX_RUN = 62
+RLE_MAX_PACKET = 128
+INPUT_EXTENSIONS = (".png", ".ppm")
+
+
+def paeth(a, b, c):
+    p = a + b - c
+    pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+    if pa <= pb and pa <= pc:
+        return a
+    return b if pb <= pc else c
+
+
+def read_png(data):
+    """Decode a non-interlaced 8-bit PNG into (width, height, [(r, g, b, a), ...])."""
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("not a PNG file")
+    pos = 8
+    idat = bytearray()
+    palette = []
+    transparency = b""
+    while pos < len(data):
+        length, kind = struct.unpack_from(">I4s", data, pos)
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            width, height, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"tRNS":
+            transparency = body
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}.get(color_type)
+    if depth != 8 or channels is None or interlace:
+        raise ValueError("only non-interlaced 8-bit PNGs are supported")
+
+    raw = zlib.decompress(bytes(idat))
+    stride = width * channels
+    rows = []
+    prior = bytearray(stride)
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        row = bytearray(raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)])
+        for i in range(stride):
+            left = row[i - channels] if i >= channels else 0
+            up = prior[i]
+            up_left = prior[i - channels] if i >= channels else 0
+            if kind == 1:
+                row[i] = (row[i] + left) & 0xFF
+            elif kind == 2:
+                row[i] = (row[i] + up) & 0xFF
+            elif kind == 3:
+                row[i] = (row[i] + ((left + up) >> 1)) & 0xFF
+            elif kind == 4:
+                row[i] = (row[i] + paeth(left, up, up_left)) & 0xFF
+        rows.append(row)
+        prior = row
+
+    pixels = []
+    for row in rows:
+        for x in range(width):
+            p = row[x * channels:(x + 1) * channels]
+            if color_type == 0:
+                pixels.append((p[0], p[0], p[0], 255))
+            elif color_type == 2:
+                pixels.append((p[0], p[1], p[2], 255))
+            elif color_type == 3:
+                alpha = transparency[p[0]] if p[0] < len(transparency) else 255
+                pixels.append(palette[p[0]] + (alpha,))
+            elif color_type == 4:
+                pixels.append((p[0], p[0], p[0], p[1]))
+            else:
+                pixels.append(tuple(p))
+    return width, height, pixels
+
+
+def read_ppm(data):
+    """Decode a binary (P6) PPM with 8-bit samples."""
+    fields = []
+    pos = 0
+    while len(fields) < 4:
+        while data[pos:pos + 1].isspace():
+            pos += 1
+        if data[pos:pos + 1] == b"#":
+            pos = data.index(b"\n", pos)
+            continue
+        start = pos
+        while not data[pos:pos + 1].isspace():
+            pos += 1
+        fields.append(data[start:pos])
+    if fields[0] != b"P6" or int(fields[3]) != 255:
+        raise ValueError("only binary PPMs with 8-bit samples are supported")
+    width, height = int(fields[1]), int(fields[2])
+    body = data[pos + 1:pos + 1 + width * height * 3]
+    return width, height, [(body[i], body[i + 1], body[i + 2], 255) for i in range(0, len(body), 3)]
+
+
+def to_rgb565(pixels, background):
+    """Blend over the background and round each pixel to RGB565."""
+    out = []
+    for r, g, b, a in pixels:
+        if a != 255:
+            r = (r * a + background[0] * (255 - a) + 127) // 255
+            g = (g * a + background[1] * (255 - a) + 127) // 255
+            b = (b * a + background[2] * (255 - a) + 127) // 255
+        out.append((min(31, (r * 31 + 127) // 255) << 11)
+                   | (min(63, (g * 63 + 127) // 255) << 5)
+                   | min(31, (b * 31 + 127) // 255))
+    return out
+
+
+def encode_qoi(width, height, colors):
+    out = bytearray(b"qoif" + struct.pack(">IIBB", width, height, 3, 0))
+    index = [None] * 64
+    prev = (0, 0, 0)
+    run = 0
+    for i, c in enumerate(colors):
+        # Expand back to 8 bits the way most viewers do, so the file displays true to the panel
+        r5, g6, b5 = c >> 11, (c >> 5) & 0x3F, c & 0x1F
+        px = ((r5 << 3) | (r5 >> 2), (g6 << 2) | (g6 >> 4), (b5 << 3) | (b5 >> 2))
+        if px == prev:
+            run += 1
+            if run == QOI_MAX_RUN or i == len(colors) - 1:
+                out.append(QOI_OP_RUN | (run - 1))
+                run = 0
+            continue
+        if run:
+            out.append(QOI_OP_RUN | (run - 1))
+            run = 0
+
+        slot = (px[0] * 3 + px[1] * 5 + px[2] * 7 + 255 * 11) % 64
+        if index[slot] == px:
+            out.append(QOI_OP_INDEX | slot)
+        else:
+            index[slot] = px
+            dr = (px[0] - prev[0] + 128) % 256 - 128
+            dg = (px[1] - prev[1] + 128) % 256 - 128
+            db = (px[2] - prev[2] + 128) % 256 - 128
+            if -2 <= dr <= 1 and -2 <= dg <= 1 and -2 <= db <= 1:
+                out.append(QOI_OP_DIFF | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2))
+            elif -32 <= dg <= 31 and -8 <= dr - dg <= 7 and -8 <= db - dg <= 7:
+                out.append(QOI_OP_LUMA | (dg + 32))
+                out.append(((dr - dg + 8) << 4) | (db - dg + 8))
+            else:
+                out.append(QOI_OP_RGB)
+                out.extend(px)
+        prev = px
+    out.extend(b"\x00" * 7 + b"\x01")
+    return bytes(out)
+
+
+def encode_rle(width, height, colors):
+    out = bytearray(b"R565" + struct.pack("<HH", width, height))
+    literal = []
+
+    def flush_literal():
+        for start in range(0, len(literal), RLE_MAX_PACKET):
+            part = literal[start:start + RLE_MAX_PACKET]
+            out.append(len(part) - 1)
+            for c in part:
+                out.extend(struct.pack(">H", c))
+        literal.clear()
+
+    i = 0
+    while i < len(colors):
+        run = 1
+        while i + run < len(colors) and run < RLE_MAX_PACKET and colors[i + run] == colors[i]:
+            run += 1
+        # A pair costs the same as a run packet on its own, so only break a literal for three or more
+        if run >= 3 or (run == 2 and not literal):
+            flush_literal()
+            out.append(0x80 | (run - 1))
+            out.extend(struct.pack(">H", colors[i]))
+            i += run
+        else:
+            literal.append(colors[i])
+            i += 1
+    flush_literal()
+    return bytes(out)
+
+
+def convert(src, dst, background):
+    with open(src, "rb") as f:
+        data = f.read()
+    width, height, pixels = read_png(data) if data[:4] == b"\x89PNG" else read_ppm(data)
+    if width > 0xFFFF or height > 0xFFFF:
+        raise ValueError("image too large")
+    colors = to_rgb565(pixels, background)
+    ext = os.path.splitext(dst)[1].lower()
+    if ext == ".qoi":
+        encoded = encode_qoi(width, height, colors)
+    elif ext == ".rle":
+        encoded = encode_rle(width, height, colors)
+    else:
+        raise ValueError("output must end in .qoi or .rle")
+    with open(dst, "wb") as f:
+        f.write(encoded)
+    print(f"{src}: {width}x{height}, {width * height * 2} bytes raw -> {len(encoded)} bytes {ext[1:]}")
+
+
+def main(argv):
+    background = (0, 0, 0)
+    if "--background" in argv:
+        i = argv.index("--background")
+        value = int(argv[i + 1], 16)
+        background = ((value >> 16) & 0xFF, (value >> 8) & 0xFF, value & 0xFF)
+        del argv[i:i + 2]
+
+    if argv[:1] == ["--dir"] and len(argv) == 5 and argv[3] == "--format" and argv[4] in ("qoi", "rle"):
+        src_dir, dst_dir, fmt = argv[1], argv[2], argv[4]
+        os.makedirs(dst_dir, exist_ok=True)
+        for name in sorted(os.listdir(src_dir)):
+            base, ext = os.path.splitext(name)
+            if ext.lower() in INPUT_EXTENSIONS:
+                convert(os.path.join(src_dir, name), os.path.join(dst_dir, f"{base}.{fmt}"), background)
+    elif len(argv) == 2:
+        convert(argv[0], argv[1], background)
+    else:
+        print(__doc__.strip().split("\n\n")[-1], file=sys.stderr)
+        return 2
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv[1:]))
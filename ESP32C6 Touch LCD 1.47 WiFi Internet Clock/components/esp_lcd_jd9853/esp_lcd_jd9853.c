@@ -21,6 +21,8 @@
 
 static const char *TAG = "JD9853";
 
+#define JD9853_PANEL_LINES 320 // Gate lines scanned by the controller, the range of scroll and partial addresses
+
 static esp_err_t panel_jd9853_del(esp_lcd_panel_t *panel);
 static esp_err_t panel_jd9853_reset(esp_lcd_panel_t *panel);
 static esp_err_t panel_jd9853_init(esp_lcd_panel_t *panel);
@@ -44,6 +46,8 @@ typedef struct
     uint8_t colmod_val; // save current value of LCD_CMD_COLMOD register
     const jd9853_lcd_init_cmd_t *init_cmds;
     uint16_t init_cmds_size;
+    uint16_t scroll_top;    // First line of the vertical scrolling area
+    uint16_t scroll_height; // Lines in the vertical scrolling area
 } jd9853_panel_t;
 
 esp_err_t esp_lcd_new_panel_jd9853(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel)
@@ -108,6 +112,7 @@ esp_err_t esp_lcd_new_panel_jd9853(const esp_lcd_panel_io_handle_t io, const esp
     }
 
     jd9853->io = io;
+    jd9853->scroll_height = JD9853_PANEL_LINES;
     jd9853->reset_gpio_num = panel_dev_config->reset_gpio_num;
     jd9853->reset_level = panel_dev_config->flags.reset_active_high;
     if (panel_dev_config->vendor_config)
@@ -458,3 +463,86 @@ static esp_err_t panel_jd9853_disp_on_off(esp_lcd_panel_t *panel, bool on_off)
     ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(io, command, NULL, 0), TAG, "send command failed");
     return ESP_OK;
 }
+
+static esp_err_t jd9853_get_panel(esp_lcd_panel_handle_t panel, jd9853_panel_t **ret_jd9853)
+{
+    ESP_RETURN_ON_FALSE(panel && panel->init == panel_jd9853_init, ESP_ERR_INVALID_ARG, TAG, "not a jd9853 panel");
+    *ret_jd9853 = __containerof(panel, jd9853_panel_t, base);
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_jd9853_set_scroll_area(esp_lcd_panel_handle_t panel, uint16_t top_fixed, uint16_t scroll_height, uint16_t bottom_fixed)
+{
+    jd9853_panel_t *jd9853 = NULL;
+    ESP_RETURN_ON_ERROR(jd9853_get_panel(panel, &jd9853), TAG, "invalid panel");
+    ESP_RETURN_ON_FALSE(top_fixed + scroll_height + bottom_fixed == JD9853_PANEL_LINES, ESP_ERR_INVALID_ARG, TAG,
+                        "scroll areas must add up to %d lines", JD9853_PANEL_LINES);
+
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(jd9853->io, LCD_CMD_VSCRDEF, (uint8_t[]){
+                                                                                    (top_fixed >> 8) & 0xFF,
+                                                                                    top_fixed & 0xFF,
+                                                                                    (scroll_height >> 8) & 0xFF,
+                                                                                    scroll_height & 0xFF,
+                                                                                    (bottom_fixed >> 8) & 0xFF,
+                                                                                    bottom_fixed & 0xFF,
+                                                                                },
+                                                  6),
+                        TAG, "send command failed");
+    jd9853->scroll_top = top_fixed;
+    jd9853->scroll_height = scroll_height;
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_jd9853_set_scroll_start(esp_lcd_panel_handle_t panel, uint16_t offset)
+{
+    jd9853_panel_t *jd9853 = NULL;
+    ESP_RETURN_ON_ERROR(jd9853_get_panel(panel, &jd9853), TAG, "invalid panel");
+    ESP_RETURN_ON_FALSE(offset < jd9853->scroll_height, ESP_ERR_INVALID_ARG, TAG, "offset outside scroll area");
+
+    // VSCSAD takes the frame memory line shown at the top of the scrolling area
+    uint16_t line = jd9853->scroll_top + offset;
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(jd9853->io, LCD_CMD_VSCSAD, (uint8_t[]){
+                                                                                   (line >> 8) & 0xFF,
+                                                                                   line & 0xFF,
+                                                                               },
+                                                  2),
+                        TAG, "send command failed");
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_jd9853_set_partial_area(esp_lcd_panel_handle_t panel, uint16_t start_line, uint16_t end_line)
+{
+    jd9853_panel_t *jd9853 = NULL;
+    ESP_RETURN_ON_ERROR(jd9853_get_panel(panel, &jd9853), TAG, "invalid panel");
+    ESP_RETURN_ON_FALSE(start_line < end_line && end_line <= JD9853_PANEL_LINES, ESP_ERR_INVALID_ARG, TAG, "invalid partial area");
+
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(jd9853->io, LCD_CMD_PTLAR, (uint8_t[]){
+                                                                                  (start_line >> 8) & 0xFF,
+                                                                                  start_line & 0xFF,
+                                                                                  ((end_line - 1) >> 8) & 0xFF,
+                                                                                  (end_line - 1) & 0xFF,
+                                                                              },
+                                                  4),
+                        TAG, "send command failed");
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_jd9853_partial_mode(esp_lcd_panel_handle_t panel, bool enable)
+{
+    jd9853_panel_t *jd9853 = NULL;
+    ESP_RETURN_ON_ERROR(jd9853_get_panel(panel, &jd9853), TAG, "invalid panel");
+
+    int command = enable ? LCD_CMD_PTLON : LCD_CMD_NORON;
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(jd9853->io, command, NULL, 0), TAG, "send command failed");
+    return ESP_OK;
+}
+
+esp_err_t esp_lcd_jd9853_idle_mode(esp_lcd_panel_handle_t panel, bool enable)
+{
+    jd9853_panel_t *jd9853 = NULL;
+    ESP_RETURN_ON_ERROR(jd9853_get_panel(panel, &jd9853), TAG, "invalid panel");
+
+    int command = enable ? LCD_CMD_IDMON : LCD_CMD_IDMOFF;
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_tx_param(jd9853->io, command, NULL, 0), TAG, "send command failed");
+    return ESP_OK;
+}
@@ -57,6 +57,75 @@ typedef struct {
  */
 esp_err_t esp_lcd_new_panel_jd9853(const esp_lcd_panel_io_handle_t io, const esp_lcd_panel_dev_config_t *panel_dev_config, esp_lcd_panel_handle_t *ret_panel);
 
+/**
+ * @brief Define the vertical scrolling area (VSCRDEF)
+ *
+ * @note  Scroll and partial lines count the controller's 320 gate lines, in frame memory order. They are not
+ *        affected by `esp_lcd_panel_set_gap()`, and with `esp_lcd_panel_swap_xy()` they run along the screen's x axis.
+ *
+ * @param[in] panel LCD panel handle returned by `esp_lcd_new_panel_jd9853()`
+ * @param[in] top_fixed Lines of the fixed area before the scrolling area
+ * @param[in] scroll_height Lines of the scrolling area
+ * @param[in] bottom_fixed Lines of the fixed area after the scrolling area; the three must add up to 320
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_jd9853_set_scroll_area(esp_lcd_panel_handle_t panel, uint16_t top_fixed, uint16_t scroll_height, uint16_t bottom_fixed);
+
+/**
+ * @brief Set the vertical scroll position (VSCSAD)
+ *
+ * @note  Scrolling moves only the read pointer: frame memory is not redrawn, so new content needs to be written
+ *        only into the lines that scroll into view.
+ *
+ * @param[in] panel LCD panel handle returned by `esp_lcd_new_panel_jd9853()`
+ * @param[in] offset Line within the scrolling area shown at its top, from 0 to `scroll_height - 1`
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_jd9853_set_scroll_start(esp_lcd_panel_handle_t panel, uint16_t offset);
+
+/**
+ * @brief Set the lines shown in partial display mode (PTLAR)
+ *
+ * @param[in] panel LCD panel handle returned by `esp_lcd_new_panel_jd9853()`
+ * @param[in] start_line First displayed line
+ * @param[in] end_line Line after the last displayed one, at most 320
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_jd9853_set_partial_area(esp_lcd_panel_handle_t panel, uint16_t start_line, uint16_t end_line);
+
+/**
+ * @brief Enter partial display mode (PTLON) or return to normal mode (NORON)
+ *
+ * @note  In partial mode only the lines set by `esp_lcd_jd9853_set_partial_area()` are driven; the rest of the
+ *        panel shows the non-display color, which lowers panel power.
+ *
+ * @param[in] panel LCD panel handle returned by `esp_lcd_new_panel_jd9853()`
+ * @param[in] enable True for partial mode, false for normal mode
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_jd9853_partial_mode(esp_lcd_panel_handle_t panel, bool enable);
+
+/**
+ * @brief Enter or leave idle mode (IDMON/IDMOFF)
+ *
+ * @note  Idle mode shows 8 colors, using only the MSB of each component, for lower power on static screens.
+ *
+ * @param[in] panel LCD panel handle returned by `esp_lcd_new_panel_jd9853()`
+ * @param[in] enable True to enter idle mode
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if parameter is invalid
+ *          - ESP_OK                on success
+ */
+esp_err_t esp_lcd_jd9853_idle_mode(esp_lcd_panel_handle_t panel, bool enable);
+
 /**
  * @brief LCD panel bus configuration structure
  *
@@ -0,0 +1,175 @@
+#include <stdbool.h>
+#include <stdlib.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_check.h"
+#include "lcd_flush.h"
+
+static const char *TAG = "lcd_flush";
+
+#define LCD_FLUSH_BUFFER_COUNT  2
+
+struct lcd_flush_t
+{
+    esp_lcd_panel_io_handle_t io;
+    esp_lcd_panel_handle_t panel;
+    size_t buffer_size;
+    uint8_t *buffers[LCD_FLUSH_BUFFER_COUNT];
+    SemaphoreHandle_t free_buffers; // counts buffers not queued for DMA and not held by the caller
+    int back;                       // buffer the caller renders into next
+    bool held;                      // back buffer has been handed out and not yet submitted
+};
+
+/**
+ * @brief Panel IO callback, run in ISR context when a color transfer finishes
+ *
+ * Transfers finish in the order they were queued and buffers alternate, so
+ * the buffer released here is always the next one lcd_flush_get_buffer() returns.
+ */
+static bool lcd_flush_color_trans_done(esp_lcd_panel_io_handle_t panel_io, esp_lcd_panel_io_event_data_t *edata, void *user_ctx)
+{
+    struct lcd_flush_t *flush = (struct lcd_flush_t *)user_ctx;
+    BaseType_t task_woken = pdFALSE;
+
+    xSemaphoreGiveFromISR(flush->free_buffers, &task_woken);
+    return task_woken == pdTRUE;
+}
+
+esp_err_t lcd_flush_new(const lcd_flush_config_t *config, lcd_flush_handle_t *ret_flush)
+{
+    esp_err_t ret = ESP_OK;
+    struct lcd_flush_t *flush = NULL;
+
+    ESP_GOTO_ON_FALSE(config && config->io && config->panel && config->buffer_size && ret_flush,
+                      ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    flush = (struct lcd_flush_t *)calloc(1, sizeof(struct lcd_flush_t));
+    ESP_GOTO_ON_FALSE(flush, ESP_ERR_NO_MEM, err, TAG, "no mem for flush context");
+
+    for (int i = 0; i < LCD_FLUSH_BUFFER_COUNT; i++)
+    {
+        flush->buffers[i] = heap_caps_malloc(config->buffer_size, MALLOC_CAP_DMA);
+        ESP_GOTO_ON_FALSE(flush->buffers[i], ESP_ERR_NO_MEM, err, TAG, "no mem for DMA buffer %d", i);
+    }
+    flush->free_buffers = xSemaphoreCreateCounting(LCD_FLUSH_BUFFER_COUNT, LCD_FLUSH_BUFFER_COUNT);
+    ESP_GOTO_ON_FALSE(flush->free_buffers, ESP_ERR_NO_MEM, err, TAG, "no mem for buffer semaphore");
+
+    flush->io = config->io;
+    flush->panel = config->panel;
+    flush->buffer_size = config->buffer_size;
+
+    const esp_lcd_panel_io_callbacks_t callbacks = {
+        .on_color_trans_done = lcd_flush_color_trans_done,
+    };
+    ESP_GOTO_ON_ERROR(esp_lcd_panel_io_register_event_callbacks(flush->io, &callbacks, flush), err, TAG,
+                      "register color done callback failed");
+
+    *ret_flush = flush;
+    ESP_LOGD(TAG, "new flush context @%p, 2 x %u bytes", flush, (unsigned)flush->buffer_size);
+    return ESP_OK;
+
+err:
+    if (flush)
+    {
+        if (flush->free_buffers)
+        {
+            vSemaphoreDelete(flush->free_buffers);
+        }
+        for (int i = 0; i < LCD_FLUSH_BUFFER_COUNT; i++)
+        {
+            heap_caps_free(flush->buffers[i]);
+        }
+        free(flush);
+    }
+    return ret;
+}
+
+esp_err_t lcd_flush_del(lcd_flush_handle_t flush)
+{
+    ESP_RETURN_ON_FALSE(flush, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    lcd_flush_wait_idle(flush, portMAX_DELAY);
+
+    const esp_lcd_panel_io_callbacks_t callbacks = {
+        .on_color_trans_done = NULL,
+    };
+    esp_lcd_panel_io_register_event_callbacks(flush->io, &callbacks, NULL);
+
+    vSemaphoreDelete(flush->free_buffers);
+    for (int i = 0; i < LCD_FLUSH_BUFFER_COUNT; i++)
+    {
+        heap_caps_free(flush->buffers[i]);
+    }
+    free(flush);
+    return ESP_OK;
+}
+
+void *lcd_flush_get_buffer(lcd_flush_handle_t flush)
+{
+    if (!flush)
+    {
+        return NULL;
+    }
+
+    if (!flush->held)
+    {
+        xSemaphoreTake(flush->free_buffers, portMAX_DELAY);
+        flush->held = true;
+    }
+    return flush->buffers[flush->back];
+}
+
+size_t lcd_flush_get_buffer_size(lcd_flush_handle_t flush)
+{
+    return flush ? flush->buffer_size : 0;
+}
+
+esp_err_t lcd_flush_submit(lcd_flush_handle_t flush, int x_start, int y_start, int x_end, int y_end)
+{
+    ESP_RETURN_ON_FALSE(flush && x_start < x_end && y_start < y_end, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE((size_t)(x_end - x_start) * (y_end - y_start) * sizeof(uint16_t) <= flush->buffer_size,
+                        ESP_ERR_INVALID_ARG, TAG, "region larger than buffer");
+    ESP_RETURN_ON_FALSE(flush->held, ESP_ERR_INVALID_STATE, TAG, "no buffer taken");
+
+    esp_err_t ret = esp_lcd_panel_draw_bitmap(flush->panel, x_start, y_start, x_end, y_end, flush->buffers[flush->back]);
+    if (ret != ESP_OK)
+    {
+        // Nothing was queued, so no completion will return the buffer
+        ESP_LOGE(TAG, "draw bitmap failed: %s", esp_err_to_name(ret));
+        xSemaphoreGive(flush->free_buffers);
+    }
+    else
+    {
+        flush->back = (flush->back + 1) % LCD_FLUSH_BUFFER_COUNT;
+    }
+    flush->held = false;
+    return ret;
+}
+
+esp_err_t lcd_flush_wait_idle(lcd_flush_handle_t flush, TickType_t timeout)
+{
+    ESP_RETURN_ON_FALSE(flush, ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+
+    // Collect every buffer not held by the caller, then hand them back
+    int expected = LCD_FLUSH_BUFFER_COUNT - (flush->held ? 1 : 0);
+    int taken = 0;
+    TickType_t start = xTaskGetTickCount();
+
+    while (taken < expected)
+    {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        TickType_t remaining = (timeout == portMAX_DELAY) ? portMAX_DELAY : (elapsed < timeout ? timeout - elapsed : 0);
+        if (xSemaphoreTake(flush->free_buffers, remaining) != pdTRUE)
+        {
+            break;
+        }
+        taken++;
+    }
+    for (int i = 0; i < taken; i++)
+    {
+        xSemaphoreGive(flush->free_buffers);
+    }
+    return (taken == expected) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
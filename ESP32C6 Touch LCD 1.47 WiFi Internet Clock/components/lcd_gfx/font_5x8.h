@@ -334,4 +334,4 @@ static inline int font_5x8_is_printable(char c) {
     return (c >= 32 && c <= 126);
 }
 
-#endif // FONT_5X8_H
\ No newline at end of file
+#endif // FONT_5X8_H
@@ -0,0 +1,345 @@
+/**
+ * @file font_8x12.h
+ * @brief Maximized Bold 8x12 pixel font for ASCII characters 32-126
+ * 
+ * This font is designed to use the MAXIMUM available pixel space.
+ * Each character uses 11 rows (rows 0-10) with row 11 reserved for line spacing.
+ * 
+ * Character size: 8 columns × 12 rows
+ * Usable drawing area: 7 columns × 11 rows (last column and last row for spacing)
+ * 
+ * This font maximizes readability and visual presence by using nearly all available
+ * pixels in the 7×11 grid, creating bold, clear, highly visible characters.
+ * 
+ * Format: Each character is 12 bytes (12 rows × 8 pixels wide)
+ * Row-major storage: Each byte represents one row of 8 pixels
+ * Bit 0 = leftmost pixel, Bit 6 = rightmost usable pixel, Bit 7 = spacing
+ * 
+ * Usage:
+ *   char c = 'A';
+ *   int index = c - 32;
+ *   const uint8_t* glyph = font_8x12[index];
+ */
+
+#ifndef FONT_8X12_H
+#define FONT_8X12_H
+
+#include <stdint.h>
+
+/**
+ * Maximized Bold 8x12 ASCII font array
+ * Each character uses rows 0-10 (11 total rows), row 11 = line spacing
+ * 
+ * Index = ASCII_value - 32
+ * ASCII 32  = space
+ * ASCII 126 = tilde (~)
+ */
+static const uint8_t font_8x12[95][12] = {
+    // ASCII 32 (0x20) - Space
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    
+    // ASCII 33 (0x21) - ! (MAXIMIZED)
+    {0x0C, 0x1E, 0x1E, 0x1E, 0x1E, 0x0C, 0x0C, 0x00, 0x0C, 0x1E, 0x0C, 0x00},
+    
+    // ASCII 34 (0x22) - " (MAXIMIZED)
+    {0x36, 0x7F, 0x7F, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    
+    // ASCII 35 (0x23) - # (MAXIMIZED)
+    {0x36, 0x36, 0x7F, 0x7F, 0x36, 0x36, 0x7F, 0x7F, 0x36, 0x36, 0x00, 0x00},
+    
+    // ASCII 36 (0x24) - $ (MAXIMIZED)
+    {0x08, 0x3E, 0x7F, 0x0B, 0x1E, 0x3C, 0x68, 0x7F, 0x3E, 0x08, 0x00, 0x00},
+    
+    // ASCII 37 (0x25) - % (MAXIMIZED)
+    {0x06, 0x4F, 0x6B, 0x30, 0x18, 0x0C, 0x06, 0x6B, 0x79, 0x30, 0x00, 0x00},
+    
+    // ASCII 38 (0x26) - & (MAXIMIZED)
+    {0x1C, 0x3E, 0x36, 0x1C, 0x6E, 0x77, 0x63, 0x77, 0x7E, 0x3C, 0x00, 0x00},
+    
+    // ASCII 39 (0x27) - ' (MAXIMIZED)
+    {0x0C, 0x1E, 0x1E, 0x06, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    
+    // ASCII 40 (0x28) - ( (MAXIMIZED)
+    {0x18, 0x0C, 0x06, 0x06, 0x03, 0x03, 0x03, 0x06, 0x06, 0x0C, 0x18, 0x00},
+    
+    // ASCII 41 (0x29) - ) (MAXIMIZED)
+    {0x06, 0x0C, 0x18, 0x18, 0x30, 0x30, 0x30, 0x18, 0x18, 0x0C, 0x06, 0x00},
+    
+    // ASCII 42 (0x2A) - * (MAXIMIZED)
+    {0x00, 0x08, 0x6B, 0x3E, 0x1C, 0x7F, 0x1C, 0x3E, 0x6B, 0x08, 0x00, 0x00},
+    
+    // ASCII 43 (0x2B) - + (MAXIMIZED)
+    {0x00, 0x00, 0x18, 0x18, 0x18, 0x7E, 0x18, 0x18, 0x18, 0x00, 0x00, 0x00},
+    
+    // ASCII 44 (0x2C) - , (MAXIMIZED)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x1E, 0x0E, 0x06, 0x00},
+    
+    // ASCII 45 (0x2D) - - (MAXIMIZED)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x7E, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},
+    
+    // ASCII 46 (0x2E) - . (MAXIMIZED)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x1E, 0x1C, 0x00},
+    
+    // ASCII 47 (0x2F) - / (MAXIMIZED)
+    {0x60, 0x70, 0x30, 0x38, 0x18, 0x1C, 0x0C, 0x0E, 0x06, 0x07, 0x03, 0x00},
+    
+    // ASCII 48 (0x30) - 0 (MAXIMIZED)
+    {0x1C, 0x3E, 0x77, 0x63, 0x63, 0x63, 0x63, 0x63, 0x77, 0x3E, 0x1C, 0x00},
+    
+    // ASCII 49 (0x31) - 1 (MAXIMIZED)
+    {0x08, 0x0C, 0x0F, 0x0F, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x3F, 0x3F, 0x00},
+    
+    // ASCII 50 (0x32) - 2 (MAXIMIZED)
+    {0x1E, 0x3F, 0x73, 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x7F, 0x7F, 0x00},
+    
+    // ASCII 51 (0x33) - 3 (MAXIMIZED)
+    {0x1E, 0x3F, 0x73, 0x60, 0x1C, 0x1C, 0x60, 0x60, 0x73, 0x3F, 0x1E, 0x00},
+    
+    // ASCII 52 (0x34) - 4 (MAXIMIZED)
+    {0x30, 0x38, 0x3C, 0x3E, 0x37, 0x33, 0x7F, 0x7F, 0x30, 0x78, 0x78, 0x00},
+    
+    // ASCII 53 (0x35) - 5 (MAXIMIZED)
+    {0x7F, 0x7F, 0x03, 0x03, 0x3F, 0x7F, 0x60, 0x60, 0x73, 0x3F, 0x1E, 0x00},
+    
+    // ASCII 54 (0x36) - 6 (MAXIMIZED)
+    {0x38, 0x1C, 0x0E, 0x07, 0x3F, 0x7F, 0x63, 0x63, 0x77, 0x3E, 0x1C, 0x00},
+    
+    // ASCII 55 (0x37) - 7 (MAXIMIZED)
+    {0x7F, 0x7F, 0x60, 0x60, 0x30, 0x18, 0x18, 0x0C, 0x0C, 0x06, 0x06, 0x00},
+    
+    // ASCII 56 (0x38) - 8 (MAXIMIZED)
+    {0x1C, 0x3E, 0x77, 0x63, 0x3E, 0x1C, 0x3E, 0x63, 0x77, 0x3E, 0x1C, 0x00},
+    
+    // ASCII 57 (0x39) - 9 (MAXIMIZED)
+    {0x1C, 0x3E, 0x77, 0x63, 0x63, 0x7F, 0x7E, 0x70, 0x38, 0x1C, 0x0E, 0x00},
+    
+    // ASCII 58 (0x3A) - : (MAXIMIZED)
+    {0x00, 0x00, 0x1C, 0x1E, 0x1C, 0x00, 0x00, 0x1C, 0x1E, 0x1C, 0x00, 0x00},
+    
+    // ASCII 59 (0x3B) - ; (MAXIMIZED)
+    {0x00, 0x00, 0x1C, 0x1E, 0x1C, 0x00, 0x00, 0x1C, 0x1E, 0x0E, 0x06, 0x00},
+    
+    // ASCII 60 (0x3C) - < (MAXIMIZED)
+    {0x00, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x06, 0x0C, 0x18, 0x30, 0x00, 0x00},
+    
+    // ASCII 61 (0x3D) - = (MAXIMIZED)
+    {0x00, 0x00, 0x00, 0x7E, 0x7E, 0x00, 0x7E, 0x7E, 0x00, 0x00, 0x00, 0x00},
+    
+    // ASCII 62 (0x3E) - > (MAXIMIZED)
+    {0x00, 0x06, 0x0C, 0x18, 0x30, 0x60, 0x30, 0x18, 0x0C, 0x06, 0x00, 0x00},
+    
+    // ASCII 63 (0x3F) - ? (MAXIMIZED)
+    {0x1E, 0x3F, 0x73, 0x60, 0x30, 0x18, 0x0C, 0x00, 0x0C, 0x1E, 0x0C, 0x00},
+    
+    // ASCII 64 (0x40) - @ (MAXIMIZED)
+    {0x1C, 0x3E, 0x63, 0x7B, 0x7B, 0x7B, 0x7B, 0x3B, 0x03, 0x3F, 0x1E, 0x00},
+    
+    // ASCII 65 (0x41) - A (MAXIMIZED - EXACT FROM IMAGE)
+    {0x08, 0x1C, 0x3E, 0x63, 0x63, 0x63, 0x7F, 0x7F, 0x63, 0x63, 0x63, 0x00},
+    
+    // ASCII 66 (0x42) - B (MAXIMIZED)
+    {0x1F, 0x3F, 0x73, 0x63, 0x3F, 0x3F, 0x63, 0x63, 0x73, 0x3F, 0x1F, 0x00},
+    
+    // ASCII 67 (0x43) - C (MAXIMIZED)
+    {0x1C, 0x3E, 0x77, 0x63, 0x03, 0x03, 0x03, 0x63, 0x77, 0x3E, 0x1C, 0x00},
+    
+    // ASCII 68 (0x44) - D (MAXIMIZED)
+    {0x0F, 0x1F, 0x3B, 0x73, 0x63, 0x63, 0x63, 0x73, 0x3B, 0x1F, 0x0F, 0x00},
+    
+    // ASCII 69 (0x45) - E (MAXIMIZED)
+    {0x7F, 0x7F, 0x03, 0x03, 0x03, 0x3F, 0x3F, 0x03, 0x03, 0x7F, 0x7F, 0x00},
+    
+    // ASCII 70 (0x46) - F (MAXIMIZED)
+    {0x7F, 0x7F, 0x03, 0x03, 0x03, 0x3F, 0x3F, 0x03, 0x03, 0x03, 0x03, 0x00},
+    
+    // ASCII 71 (0x47) - G (MAXIMIZED)
+    {0x1C, 0x3E, 0x77, 0x63, 0x03, 0x03, 0x7B, 0x7B, 0x73, 0x7E, 0x6C, 0x00},
+    
+    // ASCII 72 (0x48) - H (MAXIMIZED)
+    {0x63, 0x63, 0x63, 0x63, 0x63, 0x7F, 0x7F, 0x63, 0x63, 0x63, 0x63, 0x00},
+    
+    // ASCII 73 (0x49) - I (MAXIMIZED)
+    {0x3C, 0x3C, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x3C, 0x3C, 0x00},
+    
+    // ASCII 74 (0x4A) - J (MAXIMIZED)
+    {0x78, 0x78, 0x60, 0x60, 0x60, 0x60, 0x60, 0x63, 0x63, 0x3F, 0x1E, 0x00},
+    
+    // ASCII 75 (0x4B) - K (MAXIMIZED)
+    {0x63, 0x67, 0x6F, 0x3B, 0x1F, 0x0F, 0x1F, 0x3B, 0x73, 0x63, 0x63, 0x00},
+    
+    // ASCII 76 (0x4C) - L (MAXIMIZED)
+    {0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x03, 0x7F, 0x7F, 0x00},
+    
+    // ASCII 77 (0x4D) - M (MAXIMIZED)
+    {0x63, 0x77, 0x7F, 0x7F, 0x7F, 0x6B, 0x6B, 0x63, 0x63, 0x63, 0x63, 0x00},
+    
+    // ASCII 78 (0x4E) - N (MAXIMIZED)
+    {0x63, 0x63, 0x67, 0x67, 0x6F, 0x7B, 0x73, 0x73, 0x63, 0x63, 0x63, 0x00},
+    
+    // ASCII 79 (0x4F) - O (MAXIMIZED)
+    {0x1C, 0x3E, 0x77, 0x63, 0x63, 0x63, 0x63, 0x63, 0x77, 0x3E, 0x1C, 0x00},
+    
+    // ASCII 80 (0x50) - P (MAXIMIZED)
+    {0x1F, 0x3F, 0x73, 0x63, 0x63, 0x73, 0x3F, 0x1F, 0x03, 0x03, 0x03, 0x00},
+    
+    // ASCII 81 (0x51) - Q (MAXIMIZED)
+    {0x1C, 0x3E, 0x77, 0x63, 0x63, 0x63, 0x63, 0x6B, 0x7B, 0x3E, 0x5C, 0x00},
+    
+    // ASCII 82 (0x52) - R (MAXIMIZED)
+    {0x1F, 0x3F, 0x73, 0x63, 0x63, 0x3F, 0x1F, 0x3B, 0x73, 0x63, 0x63, 0x00},
+    
+    // ASCII 83 (0x53) - S (MAXIMIZED)
+    {0x1C, 0x3E, 0x77, 0x63, 0x07, 0x1E, 0x3C, 0x70, 0x63, 0x3F, 0x1E, 0x00},
+    
+    // ASCII 84 (0x54) - T (MAXIMIZED)
+    {0x7F, 0x7F, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00},
+    
+    // ASCII 85 (0x55) - U (MAXIMIZED)
+    {0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x77, 0x3E, 0x1C, 0x00},
+    
+    // ASCII 86 (0x56) - V (MAXIMIZED)
+    {0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x77, 0x3E, 0x1C, 0x1C, 0x08, 0x00},
+    
+    // ASCII 87 (0x57) - W (MAXIMIZED)
+    {0x63, 0x63, 0x63, 0x63, 0x6B, 0x6B, 0x7F, 0x7F, 0x77, 0x63, 0x63, 0x00},
+    
+    // ASCII 88 (0x58) - X (MAXIMIZED)
+    {0x63, 0x63, 0x77, 0x3E, 0x1C, 0x08, 0x1C, 0x3E, 0x77, 0x63, 0x63, 0x00},
+    
+    // ASCII 89 (0x59) - Y (MAXIMIZED)
+    {0x63, 0x63, 0x77, 0x3E, 0x1C, 0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x00},
+    
+    // ASCII 90 (0x5A) - Z (MAXIMIZED)
+    {0x7F, 0x7F, 0x60, 0x30, 0x18, 0x0C, 0x06, 0x03, 0x03, 0x7F, 0x7F, 0x00},
+    
+    // ASCII 91 (0x5B) - [ (MAXIMIZED)
+    {0x3C, 0x3C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x3C, 0x3C, 0x00},
+    
+    // ASCII 92 (0x5C) - backslash (MAXIMIZED)
+    {0x03, 0x07, 0x06, 0x0E, 0x0C, 0x1C, 0x18, 0x38, 0x30, 0x70, 0x60, 0x00},
+    
+    // ASCII 93 (0x5D) - ] (MAXIMIZED)
+    {0x3C, 0x3C, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x3C, 0x3C, 0x00},
+    
+    // ASCII 94 (0x5E) - ^ (MAXIMIZED)
+    {0x08, 0x1C, 0x3E, 0x77, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    
+    // ASCII 95 (0x5F) - _ (MAXIMIZED)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00},
+    
+    // ASCII 96 (0x60) - ` (MAXIMIZED)
+    {0x0C, 0x1C, 0x18, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+    
+    // ASCII 97 (0x61) - a (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x1E, 0x3F, 0x73, 0x60, 0x7E, 0x7F, 0x63, 0x7F, 0x7E, 0x00},
+    
+    // ASCII 98 (0x62) - b (lowercase MAXIMIZED)
+    {0x03, 0x03, 0x03, 0x1F, 0x3F, 0x73, 0x63, 0x63, 0x73, 0x3F, 0x1F, 0x00},
+    
+    // ASCII 99 (0x63) - c (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x1C, 0x3E, 0x77, 0x63, 0x03, 0x63, 0x77, 0x3E, 0x1C, 0x00},
+    
+    // ASCII 100 (0x64) - d (lowercase MAXIMIZED)
+    {0x60, 0x60, 0x60, 0x7C, 0x7E, 0x67, 0x63, 0x63, 0x67, 0x7E, 0x7C, 0x00},
+    
+    // ASCII 101 (0x65) - e (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x1C, 0x3E, 0x77, 0x63, 0x7F, 0x7F, 0x03, 0x3F, 0x1E, 0x00},
+    
+    // ASCII 102 (0x66) - f (lowercase MAXIMIZED)
+    {0x38, 0x3C, 0x0E, 0x06, 0x3F, 0x3F, 0x06, 0x06, 0x06, 0x06, 0x06, 0x00},
+    
+    // ASCII 103 (0x67) - g (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x7C, 0x7E, 0x67, 0x63, 0x63, 0x67, 0x7E, 0x7C, 0x60, 0x3F},
+    
+    // ASCII 104 (0x68) - h (lowercase MAXIMIZED)
+    {0x03, 0x03, 0x03, 0x1F, 0x3F, 0x73, 0x63, 0x63, 0x63, 0x63, 0x63, 0x00},
+    
+    // ASCII 105 (0x69) - i (lowercase MAXIMIZED)
+    {0x0C, 0x1C, 0x0C, 0x00, 0x0E, 0x0E, 0x0C, 0x0C, 0x0C, 0x1E, 0x1E, 0x00},
+    
+    // ASCII 106 (0x6A) - j (lowercase MAXIMIZED)
+    {0x30, 0x30, 0x00, 0x38, 0x38, 0x30, 0x30, 0x30, 0x30, 0x33, 0x3F, 0x1E},
+    
+    // ASCII 107 (0x6B) - k (lowercase MAXIMIZED)
+    {0x03, 0x03, 0x03, 0x63, 0x73, 0x3B, 0x1F, 0x3B, 0x73, 0x63, 0x63, 0x00},
+    
+    // ASCII 108 (0x6C) - l (lowercase MAXIMIZED)
+    {0x0E, 0x0E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C, 0x1E, 0x1E, 0x00},
+    
+    // ASCII 109 (0x6D) - m (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x37, 0x7F, 0x7F, 0x6B, 0x6B, 0x6B, 0x63, 0x63, 0x63, 0x00},
+    
+    // ASCII 110 (0x6E) - n (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x1F, 0x3F, 0x73, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x00},
+    
+    // ASCII 111 (0x6F) - o (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x1C, 0x3E, 0x77, 0x63, 0x63, 0x63, 0x77, 0x3E, 0x1C, 0x00},
+    
+    // ASCII 112 (0x70) - p (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x1F, 0x3F, 0x73, 0x63, 0x63, 0x73, 0x3F, 0x1F, 0x03, 0x03},
+    
+    // ASCII 113 (0x71) - q (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x7C, 0x7E, 0x67, 0x63, 0x63, 0x67, 0x7E, 0x7C, 0x60, 0x60},
+    
+    // ASCII 114 (0x72) - r (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x3B, 0x3F, 0x7F, 0x67, 0x07, 0x03, 0x03, 0x03, 0x03, 0x00},
+    
+    // ASCII 115 (0x73) - s (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x1C, 0x3E, 0x77, 0x07, 0x1E, 0x38, 0x77, 0x3E, 0x1C, 0x00},
+    
+    // ASCII 116 (0x74) - t (lowercase MAXIMIZED)
+    {0x00, 0x06, 0x06, 0x3F, 0x3F, 0x06, 0x06, 0x06, 0x06, 0x3E, 0x3C, 0x00},
+    
+    // ASCII 117 (0x75) - u (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x63, 0x63, 0x63, 0x63, 0x63, 0x63, 0x77, 0x7E, 0x7C, 0x00},
+    
+    // ASCII 118 (0x76) - v (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x63, 0x63, 0x63, 0x63, 0x77, 0x3E, 0x1C, 0x1C, 0x08, 0x00},
+    
+    // ASCII 119 (0x77) - w (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x63, 0x63, 0x63, 0x6B, 0x6B, 0x7F, 0x7F, 0x77, 0x63, 0x00},
+    
+    // ASCII 120 (0x78) - x (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x63, 0x77, 0x3E, 0x1C, 0x08, 0x1C, 0x3E, 0x77, 0x63, 0x00},
+    
+    // ASCII 121 (0x79) - y (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x63, 0x63, 0x63, 0x63, 0x63, 0x67, 0x7E, 0x7C, 0x60, 0x3F},
+    
+    // ASCII 122 (0x7A) - z (lowercase MAXIMIZED)
+    {0x00, 0x00, 0x7F, 0x7F, 0x70, 0x38, 0x1C, 0x0E, 0x07, 0x7F, 0x7F, 0x00},
+    
+    // ASCII 123 (0x7B) - { (MAXIMIZED)
+    {0x70, 0x38, 0x18, 0x18, 0x0C, 0x0E, 0x0C, 0x18, 0x18, 0x38, 0x70, 0x00},
+    
+    // ASCII 124 (0x7C) - | (MAXIMIZED)
+    {0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0x00},
+    
+    // ASCII 125 (0x7D) - } (MAXIMIZED)
+    {0x0E, 0x1C, 0x18, 0x18, 0x30, 0x70, 0x30, 0x18, 0x18, 0x1C, 0x0E, 0x00},
+    
+    // ASCII 126 (0x7E) - ~ (MAXIMIZED)
+    {0x00, 0x00, 0x4C, 0x7E, 0x7F, 0x33, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}
+};
+
+/**
+ * @brief Get font glyph for a character
+ * @param c ASCII character (32-126)
+ * @return Pointer to 12-byte glyph data, or space for invalid characters
+ */
+static inline const uint8_t* font_8x12_get_glyph(char c) {
+    if (c < 32 || c > 126) {
+        return font_8x12[0];  // Return space for invalid characters
+    }
+    return font_8x12[c - 32];
+}
+
+/**
+ * @brief Check if character is printable (has a glyph)
+ * @param c ASCII character
+ * @return true if character is printable, false otherwise
+ */
+static inline int font_8x12_is_printable(char c) {
+    return (c >= 32 && c <= 126);
+}
+
+#endif // FONT_8X12_H
@@ -0,0 +1,1121 @@
+/**
+ * @file font_aa_clock.h
+ * @brief Anti-aliased proportional font for ASCII characters 32-126
+ *
+ * Generated by tools/ttf_to_aa_font.py from Lato-Regular.ttf at 40 px. Do not edit.
+ *
+ * Glyphs are 4-bit alpha, cropped to their ink box and RLE-compressed:
+ * 15811 bytes of glyph data (22971 bytes unpacked at 4 bits per pixel).
+ * See the script for the stream format.
+ */
+
+#ifndef FONT_AA_CLOCK_H
+#define FONT_AA_CLOCK_H
+
+#include <stdint.h>
+
+#define FONT_AA_FIRST_CHAR   32
+#define FONT_AA_LAST_CHAR    126
+#define FONT_AA_LINE_HEIGHT  49
+#define FONT_AA_ASCENT       40
+
+typedef struct {
+    uint16_t offset;    // Start of the RLE stream in font_aa_data
+    uint8_t width;      // Ink box size in pixels
+    uint8_t height;
+    int8_t x_offset;    // Ink box left edge relative to the pen position
+    int8_t y_offset;    // Ink box top edge relative to the line top
+    uint8_t advance;    // Pen advance in pixels
+} font_aa_glyph_t;
+
+static const font_aa_glyph_t font_aa_glyphs[] = {
+    {     0,   0,   0,   0,   0,   8 },  // ' '
+    {     0,   6,  30,   4,  11,  14 },  // '!'
+    {    79,  10,  11,   3,  11,  16 },  // '"'
+    {   136,  21,  29,   1,  11,  23 },  // '#'
+    {   365,  20,  38,   2,   7,  23 },  // '$'
+    {   634,  29,  30,   1,  11,  31 },  // '%'
+    {   974,  27,  30,   1,  11,  28 },  // '&'
+    {  1252,   4,  11,   3,  11,   9 },  // '''
+    {  1275,   9,  37,   2,   9,  12 },  // '('
+    {  1431,   9,  37,   1,   9,  12 },  // ')'
+    {  1586,  12,  14,   2,   9,  16 },  // '*'
+    {  1658,  20,  21,   2,  16,  23 },  // '+'
+    {  1756,   6,  11,   1,  35,   8 },  // ','
+    {  1791,  10,   4,   2,  26,  14 },  // '-'
+    {  1808,   6,   6,   1,  35,   8 },  // '.'
+    {  1827,  16,  32,  -1,  10,  15 },  // '/'
+    {  1956,  21,  30,   1,  11,  23 },  // '0'
+    {  2176,  18,  29,   4,  11,  23 },  // '1'
+    {  2341,  20,  29,   2,  11,  23 },  // '2'
+    {  2512,  20,  30,   2,  11,  23 },  // '3'
+    {  2714,  23,  29,   0,  11,  23 },  // '4'
+    {  2925,  19,  30,   2,  11,  23 },  // '5'
+    {  3107,  20,  30,   2,  11,  23 },  // '6'
+    {  3309,  20,  29,   2,  11,  23 },  // '7'
+    {  3455,  21,  30,   1,  11,  23 },  // '8'
+    {  3702,  19,  29,   3,  11,  23 },  // '9'
+    {  3892,   6,  21,   2,  20,  10 },  // ':'
+    {  3930,   6,  26,   2,  20,  10 },  // ';'
+    {  3984,  17,  19,   2,  17,  23 },  // '<'
+    {  4089,  18,  11,   3,  21,  23 },  // '='
+    {  4140,  17,  19,   4,  17,  23 },  // '>'
+    {  4242,  16,  30,   0,  11,  16 },  // '?'
+    {  4373,  31,  33,   1,  12,  33 },  // '@'
+    {  4743,  27,  29,   0,  11,  27 },  // 'A'
+    {  4983,  21,  29,   3,  11,  26 },  // 'B'
+    {  5209,  25,  30,   1,  11,  27 },  // 'C'
+    {  5402,  26,  29,   3,  11,  30 },  // 'D'
+    {  5639,  19,  29,   3,  11,  23 },  // 'E'
+    {  5793,  19,  29,   3,  11,  23 },  // 'F'
+    {  5950,  26,  30,   1,  11,  29 },  // 'G'
+    {  6179,  24,  29,   3,  11,  30 },  // 'H'
+    {  6390,   5,  29,   4,  11,  12 },  // 'I'
+    {  6466,  14,  30,   1,  11,  18 },  // 'J'
+    {  6620,  24,  29,   3,  11,  27 },  // 'K'
+    {  6886,  17,  29,   3,  11,  21 },  // 'L'
+    {  7030,  31,  29,   3,  11,  37 },  // 'M'
+    {  7364,  24,  29,   3,  11,  30 },  // 'N'
+    {  7621,  30,  30,   1,  11,  32 },  // 'O'
+    {  7880,  20,  29,   3,  11,  24 },  // 'P'
+    {  8071,  31,  35,   1,  11,  32 },  // 'Q'
+    {  8370,  22,  29,   3,  11,  26 },  // 'R'
+    {  8622,  19,  30,   1,  11,  21 },  // 'S'
+    {  8808,  23,  29,   0,  11,  24 },  // 'T'
+    {  8964,  23,  30,   3,  11,  29 },  // 'U'
+    {  9183,  27,  29,   0,  11,  27 },  // 'V'
+    {  9428,  41,  29,   0,  11,  41 },  // 'W'
+    {  9855,  26,  29,   0,  11,  26 },  // 'X'
+    { 10109,  25,  29,   0,  11,  25 },  // 'Y'
+    { 10315,  23,  29,   1,  11,  25 },  // 'Z'
+    { 10475,   9,  37,   2,   9,  12 },  // '['
+    { 10624,  16,  32,  -1,  10,  15 },  // 'backslash'
+    { 10751,   9,  37,   1,   9,  12 },  // ']'
+    { 10900,  17,  14,   3,  11,  23 },  // '^'
+    { 10996,  16,   3,   0,  43,  16 },  // '_'
+    { 11016,   9,   6,   0,  11,  12 },  // '`'
+    { 11044,  17,  22,   1,  19,  20 },  // 'a'
+    { 11192,  18,  31,   3,  10,  22 },  // 'b'
+    { 11388,  17,  22,   1,  19,  19 },  // 'c'
+    { 11521,  19,  31,   1,  10,  22 },  // 'd'
+    { 11735,  19,  22,   1,  19,  21 },  // 'e'
+    { 11884,  14,  30,   0,  10,  13 },  // 'f'
+    { 12039,  19,  29,   1,  19,  20 },  // 'g'
+    { 12250,  18,  30,   2,  10,  22 },  // 'h'
+    { 12449,   6,  30,   2,  10,  10 },  // 'i'
+    { 12534,  10,  38,  -2,  10,  10 },  // 'j'
+    { 12680,  18,  30,   3,  10,  21 },  // 'k'
+    { 12881,   4,  30,   3,  10,  10 },  // 'l'
+    { 12943,  29,  21,   2,  19,  33 },  // 'm'
+    { 13204,  18,  21,   2,  19,  22 },  // 'n'
+    { 13358,  20,  22,   1,  19,  22 },  // 'o'
+    { 13524,  19,  28,   2,  19,  22 },  // 'p'
+    { 13726,  19,  28,   1,  19,  22 },  // 'q'
+    { 13929,  14,  21,   2,  19,  16 },  // 'r'
+    { 14043,  15,  22,   1,  19,  17 },  // 's'
+    { 14166,  14,  28,   0,  13,  15 },  // 't'
+    { 14299,  18,  22,   2,  19,  22 },  // 'u'
+    { 14458,  20,  21,   0,  19,  20 },  // 'v'
+    { 14613,  31,  21,   0,  19,  31 },  // 'w'
+    { 14882,  20,  21,   0,  19,  20 },  // 'x'
+    { 15047,  20,  28,   0,  19,  20 },  // 'y'
+    { 15233,  17,  21,   1,  19,  18 },  // 'z'
+    { 15345,  11,  37,   0,   9,  12 },  // '{'
+    { 15509,   4,  38,   4,   9,  12 },  // '|'
+    { 15588,  11,  37,   1,   9,  12 },  // '}'
+    { 15753,  19,   8,   2,  24,  23 },  // '~'
+};
+
+static const uint8_t font_aa_data[] = {
+    0xBF, 0x08, 0xAA, 0x60, 0x0C, 0xFF, 0x90, 0x0C, 0xFF, 0x90, 0x0C, 0xFF, 0x90, 0x0C, 0xFF, 0x90,
+    0x0C, 0xFF, 0x90, 0x0C, 0xFF, 0x90, 0x0C, 0xFF, 0x90, 0x0C, 0xFF, 0x90, 0x0C, 0xFF, 0x90, 0x0C,
+    0xFF, 0xB0, 0x90, 0x0C, 0xFF, 0x90, 0x0C, 0xFF, 0x90, 0x0B, 0xFF, 0x90, 0x0B, 0xFF, 0x80, 0x0A,
+    0xFF, 0x70, 0x08, 0xFF, 0x60, 0x07, 0xFF, 0x40, 0x05, 0xFF, 0x30, 0x1F, 0xA2, 0x5A, 0x92, 0x04,
+    0xFF, 0xFE, 0x19, 0xFF, 0xFF, 0x58, 0xFF, 0xFF, 0x31, 0xDF, 0xFA, 0x00, 0x04, 0x30, 0x00, 0xBF,
+    0xAA, 0xA1, 0x00, 0x3A, 0xA8, 0xEF, 0xF2, 0x00, 0x4F, 0xFC, 0xEF, 0xF2, 0x00, 0x4F, 0xFC, 0xEF,
+    0xF2, 0x00, 0x4F, 0xFC, 0xEF, 0xF2, 0x00, 0x4F, 0xFC, 0xEF, 0xF2, 0x00, 0x4F, 0xFC, 0xEF, 0xF2,
+    0xAD, 0x00, 0x4F, 0xFB, 0xCF, 0xF0, 0x00, 0x2F, 0xFA, 0xBF, 0xD0, 0x00, 0x1F, 0xF8, 0x8F, 0xC0,
+    0x00, 0x0E, 0xF6, 0x18, 0x30, 0x00, 0x04, 0x81, 0x06, 0x8B, 0x18, 0xA6, 0x00, 0x00, 0x5A, 0x91,
+    0x08, 0x8B, 0x7F, 0xF6, 0x00, 0x00, 0x9F, 0xF5, 0x08, 0x8B, 0xAF, 0xF3, 0x00, 0x00, 0xCF, 0xF2,
+    0x08, 0x8A, 0xDF, 0xF1, 0x00, 0x01, 0xFF, 0xE0, 0x08, 0x8B, 0x1F, 0xFC, 0x00, 0x00, 0x3F, 0xFB,
+    0x08, 0x8B, 0x5F, 0xF9, 0x00, 0x00, 0x6F, 0xF8, 0x08, 0x8B, 0x8F, 0xF7, 0x00, 0x00, 0x9F, 0xF5,
+    0x08, 0x8B, 0xBF, 0xF4, 0x00, 0x00, 0xCF, 0xF2, 0x04, 0x94, 0x34, 0x44, 0xEF, 0xF4, 0x44, 0x44,
+    0xFF, 0xE4, 0x44, 0x40, 0x80, 0x51, 0x82, 0xE0, 0xC0, 0x51, 0x95, 0xB0, 0x56, 0x66, 0x9F, 0xFB,
+    0x66, 0x66, 0xAF, 0xFA, 0x66, 0x51, 0x04, 0x8B, 0x8F, 0xF6, 0x00, 0x00, 0xAF, 0xF4, 0x08, 0x8B,
+    0xBF, 0xF3, 0x00, 0x00, 0xDF, 0xF1, 0x08, 0x8A, 0xEF, 0xE0, 0x00, 0x01, 0xFF, 0xD0, 0x08, 0x8B,
+    0x2F, 0xFC, 0x00, 0x00, 0x4F, 0xFA, 0x08, 0x8B, 0x5F, 0xF9, 0x00, 0x00, 0x7F, 0xF7, 0x04, 0x95,
+    0x11, 0x11, 0x9F, 0xF6, 0x11, 0x11, 0xAF, 0xF5, 0x11, 0x10, 0x0C, 0x51, 0x82, 0xA0, 0xE0, 0x51,
+    0xA5, 0xB0, 0x58, 0x89, 0xFF, 0xE8, 0x88, 0x8A, 0xFF, 0xD8, 0x88, 0x85, 0x00, 0x00, 0x3F, 0xFB,
+    0x00, 0x00, 0x5F, 0xF9, 0x08, 0x8B, 0x6F, 0xF8, 0x00, 0x00, 0x8F, 0xF6, 0x08, 0x8B, 0x9F, 0xF5,
+    0x00, 0x00, 0xBF, 0xF3, 0x08, 0x8A, 0xCF, 0xF2, 0x00, 0x00, 0xEF, 0xF0, 0x08, 0x8B, 0x1F, 0xFE,
+    0x00, 0x00, 0x2F, 0xFC, 0x08, 0x8B, 0x3F, 0xFB, 0x00, 0x00, 0x5F, 0xF9, 0x08, 0x8B, 0x6F, 0xF8,
+    0x00, 0x00, 0x8F, 0xF6, 0x08, 0x8B, 0x9F, 0xD2, 0x00, 0x00, 0x5F, 0xF3, 0x06, 0x09, 0x82, 0x7B,
+    0x50, 0x10, 0x82, 0xDF, 0x60, 0x10, 0x82, 0xEF, 0x50, 0x10, 0x82, 0xFF, 0x40, 0x0C, 0x88, 0x38,
+    0xCD, 0xFF, 0xC9, 0x50, 0x08, 0x81, 0x3B, 0x48, 0x81, 0xD5, 0x05, 0x81, 0x5E, 0x4B, 0xBF, 0xA1,
+    0x00, 0x03, 0xFF, 0xFF, 0xA5, 0x6F, 0xF4, 0x9E, 0xFF, 0xF5, 0x00, 0x0C, 0xFF, 0xE3, 0x00, 0x5F,
+    0xE0, 0x01, 0x9F, 0xB0, 0x00, 0x3F, 0xFF, 0x40, 0x00, 0x6F, 0xD0, 0x00, 0x01, 0x00, 0x00, 0x8A,
+    0x7F, 0xFD, 0x00, 0x00, 0x7F, 0xC0, 0x08, 0x8A, 0x9F, 0xFB, 0x00, 0x00, 0x8F, 0xB0, 0x08, 0x8A,
+    0x9F, 0xFC, 0x00, 0x00, 0x9F, 0xA0, 0x08, 0x8A, 0x8F, 0xFF, 0x30, 0x00, 0xAF, 0x90, 0x08, 0x8A,
+    0x4F, 0xFF, 0xD2, 0x00, 0xBF, 0x80, 0x09, 0x89, 0xCF, 0xFF, 0xE8, 0x1C, 0xF7, 0x09, 0x81, 0x2E,
+    0x46, 0x80, 0x60, 0x0A, 0x81, 0x3C, 0x46, 0x82, 0xB6, 0x10, 0x09, 0x81, 0x6C, 0x46, 0x82, 0xE8,
+    0x10, 0x09, 0x81, 0x38, 0x46, 0x81, 0xD3, 0x09, 0x8A, 0x2F, 0xF7, 0xCF, 0xFF, 0xFE, 0x20, 0x08,
+    0x8A, 0x3F, 0xF0, 0x04, 0xDF, 0xFF, 0xA0, 0x08, 0x8A, 0x4F, 0xE0, 0x00, 0x1D, 0xFF, 0xE0, 0x08,
+    0x8B, 0x6F, 0xD0, 0x00, 0x06, 0xFF, 0xF2, 0x07, 0x8B, 0x7F, 0xC0, 0x00, 0x03, 0xFF, 0xF3, 0x07,
+    0x8B, 0x8F, 0xB0, 0x00, 0x03, 0xFF, 0xF2, 0x07, 0x8E, 0x9F, 0xA0, 0x00, 0x06, 0xFF, 0xE0, 0x05,
+    0x70, 0x04, 0xB5, 0xAF, 0x90, 0x00, 0x0C, 0xFF, 0xA0, 0x3F, 0xFC, 0x20, 0x00, 0xBF, 0x80, 0x00,
+    0x8F, 0xFF, 0x30, 0xAF, 0xFF, 0xE8, 0x20, 0xCF, 0x70, 0x3B, 0xFF, 0xF9, 0x00, 0x1C, 0x44, 0x90,
+    0xDE, 0xFD, 0xEF, 0xFF, 0xFB, 0x10, 0x00, 0x07, 0xE0, 0x4A, 0x80, 0x90, 0x06, 0x82, 0x17, 0xC0,
+    0x45, 0x82, 0xE9, 0x30, 0x0A, 0x85, 0x14, 0xFF, 0x62, 0x0E, 0x83, 0x2F, 0xF2, 0x0F, 0x83, 0x3F,
+    0xF1, 0x0F, 0x82, 0x4F, 0xF0, 0x10, 0x82, 0x4B, 0x80, 0x09, 0x89, 0x00, 0x02, 0x8C, 0xEE, 0xB5,
+    0x0C, 0x89, 0x4A, 0xA8, 0x00, 0x00, 0x5E, 0x45, 0x81, 0xB1, 0x09, 0x92, 0x3F, 0xFF, 0x30, 0x00,
+    0x3F, 0xFF, 0xA6, 0x7C, 0xFF, 0xB0, 0x08, 0x94, 0x1D, 0xFF, 0x60, 0x00, 0x0C, 0xFF, 0x50, 0x00,
+    0x0B, 0xFF, 0x50, 0x07, 0x8B, 0xAF, 0xFA, 0x00, 0x00, 0x3F, 0xFB, 0x04, 0x83, 0x2F, 0xFB, 0x06,
+    0x8C, 0x6F, 0xFD, 0x10, 0x00, 0x06, 0xFF, 0x60, 0x05, 0x82, 0xCF, 0xF0, 0x05, 0x84, 0x3F, 0xFF,
+    0x30, 0x04, 0x83, 0x8F, 0xF4, 0x05, 0x8C, 0xAF, 0xF2, 0x00, 0x00, 0x1D, 0xFF, 0x70, 0x05, 0x83,
+    0x8F, 0xF4, 0x05, 0x8B, 0xAF, 0xF2, 0x00, 0x00, 0xAF, 0xFA, 0x06, 0x83, 0x7F, 0xF5, 0x05, 0x8B,
+    0xBF, 0xF1, 0x00, 0x06, 0xFF, 0xD1, 0x06, 0x83, 0x5F, 0xF8, 0x05, 0x8A, 0xEF, 0xD0, 0x00, 0x3E,
+    0xFF, 0x30, 0x07, 0x93, 0x1E, 0xFE, 0x10, 0x00, 0x06, 0xFF, 0x80, 0x01, 0xDF, 0xF7, 0x09, 0x91,
+    0x7F, 0xFC, 0x30, 0x16, 0xEF, 0xE1, 0x00, 0x9F, 0xFB, 0x0B, 0x80, 0xB0, 0x46, 0x88, 0xE4, 0x00,
+    0x6F, 0xFD, 0x10, 0x0C, 0x8E, 0x7E, 0xFF, 0xFF, 0xB3, 0x00, 0x2E, 0xFF, 0x40, 0x0E, 0x8C, 0x14,
+    0x65, 0x20, 0x00, 0x1C, 0xFF, 0x70, 0x17, 0x8D, 0x9F, 0xFB, 0x00, 0x03, 0x9D, 0xFE, 0xB5, 0x0D,
+    0x87, 0x5F, 0xFE, 0x10, 0x07, 0x46, 0x81, 0xA1, 0x0A, 0x91, 0x2E, 0xFF, 0x40, 0x05, 0xFF, 0xE8,
+    0x67, 0xDF, 0xFA, 0x0A, 0x92, 0xCF, 0xF7, 0x00, 0x0E, 0xFE, 0x30, 0x00, 0x1C, 0xFF, 0x30, 0x08,
+    0x8A, 0x9F, 0xFB, 0x00, 0x05, 0xFF, 0x80, 0x04, 0x83, 0x4F, 0xF9, 0x07, 0x8B, 0x5F, 0xFE, 0x10,
+    0x00, 0x8F, 0xF4, 0x05, 0x82, 0xEF, 0xD0, 0x06, 0x8C, 0x2E, 0xFF, 0x40, 0x00, 0x0A, 0xFF, 0x20,
+    0x05, 0x82, 0xCF, 0xE0, 0x06, 0x83, 0xCF, 0xF8, 0x04, 0x83, 0xAF, 0xF2, 0x05, 0x82, 0xCF, 0xF0,
+    0x05, 0x83, 0x9F, 0xFB, 0x05, 0x83, 0x9F, 0xF3, 0x05, 0x82, 0xDF, 0xD0, 0x04, 0x84, 0x5F, 0xFE,
+    0x20, 0x05, 0x83, 0x7F, 0xF6, 0x04, 0x8C, 0x1F, 0xFA, 0x00, 0x00, 0x2E, 0xFF, 0x40, 0x06, 0x83,
+    0x2F, 0xFC, 0x04, 0x8B, 0x8F, 0xF5, 0x00, 0x00, 0xCF, 0xF8, 0x08, 0x92, 0x9F, 0xFB, 0x30, 0x28,
+    0xFF, 0xC0, 0x00, 0x08, 0xFF, 0xC0, 0x09, 0x81, 0x1C, 0x46, 0x89, 0xD2, 0x00, 0x05, 0xFF, 0xD2,
+    0x0A, 0x88, 0x18, 0xEF, 0xFF, 0xFA, 0x10, 0x15, 0x88, 0x14, 0x54, 0x10, 0x00, 0x00, 0x07, 0x87,
+    0x39, 0xDE, 0xFD, 0xA4, 0x10, 0x81, 0x1A, 0x47, 0x81, 0xB1, 0x0D, 0x8D, 0x1C, 0xFF, 0xFF, 0xDC,
+    0xEF, 0xFF, 0xD1, 0x0C, 0x8D, 0x8F, 0xFF, 0x92, 0x00, 0x17, 0xFF, 0xFA, 0x0B, 0x84, 0x1F, 0xFF,
+    0xA0, 0x05, 0x84, 0x7F, 0xFF, 0x20, 0x0A, 0x84, 0x5F, 0xFF, 0x20, 0x06, 0x83, 0xEF, 0xF6, 0x0A,
+    0x83, 0x7F, 0xFD, 0x07, 0x83, 0x58, 0x51, 0x0A, 0x83, 0x7F, 0xFD, 0x16, 0x84, 0x5F, 0xFF, 0x10,
+    0x15, 0x84, 0x2F, 0xFF, 0x70, 0x16, 0x84, 0xBF, 0xFE, 0x20, 0x15, 0x85, 0x3F, 0xFF, 0xC1, 0x15,
+    0x84, 0x8F, 0xFF, 0xB0, 0x14, 0x86, 0x4B, 0xFF, 0xFF, 0xB0, 0x12, 0x80, 0x90, 0x46, 0x80, 0xB0,
+    0x06, 0x83, 0x1B, 0xB8, 0x04, 0x8B, 0x1B, 0xFF, 0xF8, 0x1C, 0xFF, 0xFA, 0x05, 0x83, 0x4F, 0xFA,
+    0x04, 0x8C, 0xAF, 0xFF, 0x50, 0x01, 0xCF, 0xFF, 0xA0, 0x04, 0xA6, 0x7F, 0xF8, 0x00, 0x00, 0x5F,
+    0xFF, 0x60, 0x00, 0x01, 0xCF, 0xFF, 0xA0, 0x00, 0x0B, 0xFF, 0x50, 0x00, 0x0C, 0xFF, 0xC0, 0x05,
+    0x94, 0x1C, 0xFF, 0xFA, 0x00, 0x1E, 0xFF, 0x20, 0x00, 0x2F, 0xFF, 0x70, 0x06, 0x93, 0x1C, 0xFF,
+    0xF9, 0x06, 0xFF, 0xB0, 0x00, 0x05, 0xFF, 0xF4, 0x07, 0x92, 0x1C, 0xFF, 0xF9, 0xDF, 0xF5, 0x00,
+    0x00, 0x5F, 0xFF, 0x40, 0x08, 0x81, 0x1D, 0x44, 0x80, 0xD0, 0x04, 0x84, 0x4F, 0xFF, 0x70, 0x09,
+    0x86, 0x1D, 0xFF, 0xFF, 0x40, 0x04, 0x84, 0x1F, 0xFF, 0xC0, 0x0A, 0x85, 0x4F, 0xFF, 0xF9, 0x05,
+    0x84, 0xBF, 0xFF, 0x70, 0x08, 0x81, 0x5E, 0x44, 0x80, 0x80, 0x04, 0x86, 0x3F, 0xFF, 0xF9, 0x10,
+    0x04, 0x8A, 0x4B, 0xFF, 0xFB, 0xDF, 0xFF, 0x80, 0x04, 0x80, 0x60, 0x44, 0x90, 0xB9, 0x9B, 0xEF,
+    0xFF, 0xF9, 0x01, 0xDF, 0xFF, 0x80, 0x04, 0x81, 0x5E, 0x49, 0x8A, 0xC4, 0x00, 0x02, 0xDF, 0xFF,
+    0x80, 0x04, 0x82, 0x18, 0xE0, 0x44, 0x82, 0xEA, 0x50, 0x05, 0x85, 0x2C, 0xFF, 0xF8, 0x06, 0x84,
+    0x24, 0x54, 0x20, 0x0E, 0xAB, 0xAA, 0xA1, 0xEF, 0xF2, 0xEF, 0xF2, 0xEF, 0xF2, 0xEF, 0xF2, 0xEF,
+    0xF2, 0xEF, 0xF2, 0xCF, 0xF0, 0xBF, 0xD0, 0x8F, 0xC0, 0x18, 0x30, 0x04, 0x82, 0x3C, 0x30, 0x05,
+    0xB6, 0xBF, 0xF3, 0x00, 0x00, 0x5F, 0xFE, 0x10, 0x00, 0x0D, 0xFF, 0x70, 0x00, 0x05, 0xFF, 0xE1,
+    0x00, 0x00, 0xCF, 0xF8, 0x00, 0x00, 0x3F, 0xFF, 0x10, 0x00, 0x08, 0xFF, 0xA0, 0x04, 0x94, 0xDF,
+    0xF5, 0x00, 0x00, 0x3F, 0xFF, 0x10, 0x00, 0x07, 0xFF, 0xC0, 0x04, 0x83, 0xAF, 0xF8, 0x04, 0x83,
+    0xDF, 0xF5, 0x04, 0x8B, 0xFF, 0xF2, 0x00, 0x00, 0x2F, 0xFF, 0x04, 0x83, 0x3F, 0xFE, 0x04, 0x83,
+    0x4F, 0xFD, 0x04, 0x83, 0x5F, 0xFC, 0x04, 0x83, 0x5F, 0xFC, 0x04, 0x83, 0x5F, 0xFC, 0x04, 0x83,
+    0x4F, 0xFD, 0x04, 0x83, 0x3F, 0xFE, 0x04, 0x84, 0x1F, 0xFF, 0x10, 0x04, 0x83, 0xEF, 0xF3, 0x04,
+    0x83, 0xCF, 0xF5, 0x04, 0x83, 0x9F, 0xF9, 0x04, 0x83, 0x6F, 0xFC, 0x04, 0x84, 0x2F, 0xFF, 0x20,
+    0x04, 0x83, 0xDF, 0xF6, 0x04, 0x83, 0x8F, 0xFC, 0x04, 0x84, 0x2F, 0xFF, 0x20, 0x04, 0x83, 0xBF,
+    0xF9, 0x04, 0x84, 0x4F, 0xFE, 0x10, 0x04, 0x83, 0xCF, 0xF8, 0x04, 0x84, 0x4F, 0xFF, 0x20, 0x04,
+    0x83, 0xAF, 0xE2, 0x04, 0x83, 0x29, 0x20, 0x82, 0x05, 0xC0, 0x05, 0x83, 0x6F, 0xF7, 0x04, 0x84,
+    0x4F, 0xFE, 0x20, 0x04, 0x83, 0xBF, 0xF9, 0x04, 0x84, 0x3F, 0xFF, 0x20, 0x04, 0x83, 0xBF, 0xF8,
+    0x04, 0x83, 0x5F, 0xFE, 0x05, 0x83, 0xEF, 0xF5, 0x04, 0x83, 0x9F, 0xF9, 0x04, 0x83, 0x5F, 0xFE,
+    0x04, 0x84, 0x1F, 0xFF, 0x30, 0x04, 0x83, 0xCF, 0xF6, 0x04, 0x83, 0x9F, 0xF9, 0x04, 0x83, 0x6F,
+    0xFB, 0x04, 0x83, 0x4F, 0xFD, 0x04, 0x83, 0x3F, 0xFE, 0x04, 0x83, 0x1F, 0xFF, 0x04, 0x9E, 0x1F,
+    0xFF, 0x10, 0x00, 0x01, 0xFF, 0xF1, 0x00, 0x00, 0x1F, 0xFF, 0x10, 0x00, 0x02, 0xFF, 0xF0, 0x04,
+    0x83, 0x3F, 0xFE, 0x04, 0x83, 0x5F, 0xFD, 0x04, 0x83, 0x7F, 0xFB, 0x04, 0x83, 0x9F, 0xF8, 0x04,
+    0x94, 0xDF, 0xF5, 0x00, 0x00, 0x1F, 0xFF, 0x20, 0x00, 0x05, 0xFF, 0xD0, 0x04, 0x94, 0xAF, 0xF9,
+    0x00, 0x00, 0x1F, 0xFF, 0x40, 0x00, 0x06, 0xFF, 0xD0, 0x04, 0xA5, 0xDF, 0xF7, 0x00, 0x00, 0x5F,
+    0xFE, 0x10, 0x00, 0x0C, 0xFF, 0x80, 0x00, 0x05, 0xFF, 0xE1, 0x00, 0x00, 0x5F, 0xF6, 0x05, 0x81,
+    0x39, 0x05, 0x04, 0x81, 0x22, 0x09, 0x81, 0xED, 0x09, 0x81, 0xED, 0x04, 0xAD, 0x44, 0x00, 0x0E,
+    0xD0, 0x00, 0x53, 0xDF, 0xB2, 0x0E, 0xD0, 0x3B, 0xFB, 0x2B, 0xFF, 0x8D, 0xC9, 0xFF, 0xA2, 0x00,
+    0x5D, 0xFF, 0xFF, 0xC4, 0x04, 0xB8, 0x4D, 0xFF, 0xD4, 0x00, 0x00, 0x2A, 0xFF, 0xEE, 0xFF, 0xA2,
+    0x08, 0xFF, 0xB3, 0xEC, 0x3C, 0xFE, 0x7A, 0xD5, 0x00, 0xED, 0x00, 0x6E, 0x91, 0x10, 0x00, 0xED,
+    0x00, 0x01, 0x10, 0x04, 0x81, 0xED, 0x09, 0x81, 0xA9, 0x04, 0x07, 0x82, 0x45, 0x50, 0x10, 0x82,
+    0xEF, 0xF0, 0x10, 0x82, 0xEF, 0xF0, 0x10, 0x82, 0xEF, 0xF0, 0x10, 0x82, 0xEF, 0xF0, 0x10, 0x82,
+    0xEF, 0xF0, 0x10, 0x82, 0xEF, 0xF0, 0x10, 0x82, 0xEF, 0xF0, 0x10, 0x82, 0xEF, 0xF0, 0x08, 0x93,
+    0xBB, 0xBB, 0xBB, 0xBB, 0xFF, 0xFB, 0xBB, 0xBB, 0xBB, 0xB2, 0x52, 0x94, 0x2E, 0xEE, 0xEE, 0xEE,
+    0xEF, 0xFF, 0xEE, 0xEE, 0xEE, 0xEE, 0x20, 0x07, 0x82, 0xEF, 0xF0, 0x10, 0x82, 0xEF, 0xF0, 0x10,
+    0x82, 0xEF, 0xF0, 0x10, 0x82, 0xEF, 0xF0, 0x10, 0x82, 0xEF, 0xF0, 0x10, 0x82, 0xEF, 0xF0, 0x10,
+    0x82, 0xEF, 0xF0, 0x10, 0x82, 0xEF, 0xF0, 0x10, 0x82, 0x78, 0x80, 0x08, 0xBF, 0x02, 0x9A, 0x60,
+    0x0D, 0xFF, 0xF5, 0x2F, 0xFF, 0xFA, 0x0E, 0xFF, 0xFB, 0x04, 0xDF, 0xF9, 0x00, 0x0A, 0xF5, 0x00,
+    0x1E, 0xD0, 0x00, 0xAF, 0x60, 0x07, 0xFB, 0x00, 0x0C, 0xC1, 0x00, 0x02, 0x10, 0x81, 0x00, 0x89,
+    0x88, 0x88, 0x88, 0x88, 0x87, 0x48, 0x80, 0xD0, 0x48, 0x8A, 0xD8, 0x88, 0x88, 0x88, 0x88, 0x70,
+    0xA3, 0x02, 0x9A, 0x50, 0x0D, 0xFF, 0xF5, 0x3F, 0xFF, 0xFB, 0x2F, 0xFF, 0xF9, 0x08, 0xFF, 0xE2,
+    0x00, 0x34, 0x10, 0x0C, 0x82, 0x26, 0x70, 0x0B, 0x83, 0x1E, 0xFC, 0x0B, 0x83, 0x7F, 0xF6, 0x0B,
+    0x83, 0xDF, 0xE1, 0x0A, 0x83, 0x4F, 0xF9, 0x0B, 0x83, 0xAF, 0xF3, 0x0A, 0x83, 0x2F, 0xFC, 0x0B,
+    0x83, 0x7F, 0xF6, 0x0B, 0x83, 0xDF, 0xE1, 0x0A, 0x83, 0x4F, 0xF9, 0x0B, 0x83, 0xAF, 0xF3, 0x0A,
+    0x83, 0x2F, 0xFC, 0x0B, 0x83, 0x7F, 0xF6, 0x0B, 0x83, 0xDF, 0xE1, 0x0A, 0x83, 0x4F, 0xF9, 0x0B,
+    0x83, 0xAF, 0xF3, 0x0A, 0x83, 0x2F, 0xFC, 0x0B, 0x83, 0x7F, 0xF6, 0x0B, 0x83, 0xDF, 0xE1, 0x0A,
+    0x83, 0x5F, 0xF9, 0x0B, 0x83, 0xBF, 0xF3, 0x0A, 0x83, 0x2F, 0xFC, 0x0B, 0x83, 0x8F, 0xF6, 0x0B,
+    0x83, 0xDF, 0xE1, 0x0A, 0x83, 0x5F, 0xF9, 0x0B, 0x83, 0xBF, 0xF3, 0x0A, 0x83, 0x2F, 0xFC, 0x0B,
+    0x83, 0x8F, 0xF6, 0x0B, 0x83, 0xDF, 0xE1, 0x0A, 0x83, 0x5F, 0xF9, 0x0B, 0x83, 0xBF, 0xF3, 0x0A,
+    0x83, 0x1C, 0xC5, 0x0B, 0x05, 0x88, 0x27, 0xBE, 0xFE, 0xC8, 0x30, 0x0A, 0x80, 0x80, 0x48, 0x81,
+    0xA1, 0x06, 0x81, 0x1B, 0x4A, 0x81, 0xD2, 0x05, 0x99, 0xBF, 0xFF, 0xD7, 0x21, 0x26, 0xCF, 0xFF,
+    0xD1, 0x00, 0x00, 0x6F, 0xFF, 0xB1, 0x05, 0x8D, 0xAF, 0xFF, 0x90, 0x00, 0x1E, 0xFF, 0xD1, 0x07,
+    0x8B, 0xCF, 0xFF, 0x30, 0x06, 0xFF, 0xF6, 0x08, 0x8A, 0x3F, 0xFF, 0x90, 0x0C, 0xFF, 0xE0, 0x0A,
+    0x89, 0xBF, 0xFE, 0x01, 0xFF, 0xF9, 0x0A, 0x89, 0x7F, 0xFF, 0x45, 0xFF, 0xF5, 0x0A, 0x89, 0x3F,
+    0xFF, 0x88, 0xFF, 0xF3, 0x0B, 0x88, 0xFF, 0xFA, 0xAF, 0xFF, 0x10, 0x0B, 0x87, 0xDF, 0xFC, 0xBF,
+    0xFE, 0x0C, 0x87, 0xCF, 0xFE, 0xCF, 0xFE, 0x0C, 0x87, 0xBF, 0xFF, 0xCF, 0xFD, 0x0C, 0x87, 0xBF,
+    0xFF, 0xCF, 0xFD, 0x0C, 0x87, 0xBF, 0xFF, 0xBF, 0xFE, 0x0C, 0x87, 0xBF, 0xFE, 0xAF, 0xFF, 0x0C,
+    0x88, 0xCF, 0xFD, 0x8F, 0xFF, 0x20, 0x0B, 0x88, 0xEF, 0xFB, 0x6F, 0xFF, 0x40, 0x0A, 0x89, 0x2F,
+    0xFF, 0x93, 0xFF, 0xF8, 0x0A, 0x89, 0x5F, 0xFF, 0x60, 0xDF, 0xFC, 0x0A, 0x8A, 0xAF, 0xFF, 0x10,
+    0x8F, 0xFF, 0x30, 0x08, 0x8B, 0x1E, 0xFF, 0xB0, 0x02, 0xFF, 0xFB, 0x08, 0x8C, 0x9F, 0xFF, 0x50,
+    0x00, 0x9F, 0xFF, 0x70, 0x06, 0x99, 0x5F, 0xFF, 0xC0, 0x00, 0x01, 0xDF, 0xFF, 0x92, 0x00, 0x01,
+    0x8F, 0xFF, 0xF3, 0x04, 0x88, 0x3E, 0xFF, 0xFF, 0xCA, 0xC0, 0x44, 0x80, 0x50, 0x06, 0x81, 0x3D,
+    0x48, 0x81, 0xE4, 0x09, 0x81, 0x6C, 0x44, 0x82, 0xD7, 0x10, 0x0C, 0x84, 0x13, 0x54, 0x20, 0x07,
+    0x07, 0x83, 0x9B, 0xB5, 0x0B, 0x85, 0x1C, 0xFF, 0xF7, 0x0A, 0x86, 0x2D, 0xFF, 0xFF, 0x70, 0x09,
+    0x81, 0x4E, 0x44, 0x80, 0x70, 0x08, 0x80, 0x50, 0x46, 0x80, 0x70, 0x07, 0x89, 0x7F, 0xFF, 0xF6,
+    0xFF, 0xF7, 0x06, 0x8A, 0x9F, 0xFF, 0xE4, 0x1F, 0xFF, 0x70, 0x05, 0x8B, 0xAF, 0xFF, 0xD2, 0x01,
+    0xFF, 0xF7, 0x05, 0x8B, 0x5F, 0xFB, 0x10, 0x01, 0xFF, 0xF7, 0x06, 0x8A, 0x78, 0x00, 0x00, 0x1F,
+    0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF,
+    0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70,
+    0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C,
+    0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84,
+    0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F,
+    0xFF, 0x70, 0x06, 0x92, 0x3B, 0xBB, 0xBB, 0xCF, 0xFF, 0xDB, 0xBB, 0xBB, 0x10, 0x40, 0x4E, 0x82,
+    0x20, 0x40, 0x4E, 0x80, 0x20, 0x04, 0x89, 0x16, 0xAD, 0xFF, 0xDA, 0x61, 0x08, 0x81, 0x6E, 0x47,
+    0x81, 0xE6, 0x06, 0x80, 0xA0, 0x4B, 0x80, 0x80, 0x04, 0x98, 0x8F, 0xFF, 0xE8, 0x31, 0x24, 0xAF,
+    0xFF, 0xF5, 0x00, 0x03, 0xFF, 0xFD, 0x20, 0x05, 0x8C, 0x5F, 0xFF, 0xD0, 0x00, 0xAF, 0xFE, 0x20,
+    0x07, 0x8A, 0x9F, 0xFF, 0x40, 0x1E, 0xFF, 0x90, 0x08, 0x8A, 0x3F, 0xFF, 0x70, 0x4F, 0xFF, 0x40,
+    0x08, 0x89, 0x1F, 0xFF, 0x90, 0x14, 0x65, 0x09, 0x84, 0x1F, 0xFF, 0x90, 0x0E, 0x84, 0x2F, 0xFF,
+    0x80, 0x0E, 0x84, 0x6F, 0xFF, 0x40, 0x0E, 0x83, 0xCF, 0xFE, 0x0E, 0x84, 0x5F, 0xFF, 0x70, 0x0D,
+    0x84, 0x1D, 0xFF, 0xD0, 0x0E, 0x84, 0xBF, 0xFF, 0x30, 0x0D, 0x84, 0xAF, 0xFF, 0x60, 0x0D, 0x84,
+    0x9F, 0xFF, 0x70, 0x0D, 0x84, 0x8F, 0xFF, 0x80, 0x0D, 0x84, 0x8F, 0xFF, 0x80, 0x0D, 0x84, 0x8F,
+    0xFF, 0x90, 0x0D, 0x84, 0x8F, 0xFF, 0x90, 0x0D, 0x84, 0x8F, 0xFF, 0x90, 0x0D, 0x84, 0x8F, 0xFF,
+    0xA0, 0x0D, 0x84, 0x8F, 0xFF, 0xA0, 0x0D, 0x84, 0x8F, 0xFF, 0xA0, 0x0D, 0x93, 0x8F, 0xFF, 0xB3,
+    0x56, 0x66, 0x66, 0x66, 0x66, 0x64, 0x07, 0x51, 0x81, 0x2D, 0x51, 0x81, 0x3E, 0x51, 0x80, 0x30,
+    0x05, 0x88, 0x49, 0xCE, 0xFE, 0xC8, 0x30, 0x08, 0x81, 0x3C, 0x48, 0x81, 0xA1, 0x05, 0x80, 0x50,
+    0x4B, 0x9E, 0xC1, 0x00, 0x00, 0x3F, 0xFF, 0xFB, 0x52, 0x13, 0x7E, 0xFF, 0xFA, 0x00, 0x00, 0xCF,
+    0xFF, 0x50, 0x05, 0x8C, 0x2D, 0xFF, 0xF3, 0x00, 0x4F, 0xFF, 0x70, 0x07, 0x8B, 0x4F, 0xFF, 0x80,
+    0x09, 0xFF, 0xE1, 0x08, 0x89, 0xDF, 0xFB, 0x00, 0xDF, 0xF9, 0x09, 0x89, 0xBF, 0xFB, 0x00, 0x35,
+    0x61, 0x09, 0x83, 0xBF, 0xFA, 0x0F, 0x83, 0xEF, 0xF7, 0x0E, 0x84, 0x5F, 0xFF, 0x20, 0x0D, 0x84,
+    0x4E, 0xFF, 0x80, 0x0B, 0x86, 0x25, 0xBF, 0xFF, 0x80, 0x0A, 0x80, 0x80, 0x44, 0x81, 0xA3, 0x0B,
+    0x80, 0x80, 0x44, 0x82, 0xD7, 0x10, 0x0A, 0x89, 0x59, 0xBD, 0xFF, 0xFF, 0xD3, 0x0D, 0x86, 0x28,
+    0xFF, 0xFE, 0x20, 0x0E, 0x84, 0x4F, 0xFF, 0xA0, 0x0F, 0x84, 0x9F, 0xFF, 0x10, 0x0E, 0x84, 0x4F,
+    0xFF, 0x40, 0x0E, 0x88, 0x3F, 0xFF, 0x64, 0xBE, 0x70, 0x0A, 0x89, 0x3F, 0xFF, 0x69, 0xFF, 0xF2,
+    0x09, 0x89, 0x7F, 0xFF, 0x43, 0xFF, 0xF9, 0x08, 0x8B, 0x1D, 0xFF, 0xE0, 0x0C, 0xFF, 0xF6, 0x07,
+    0x9C, 0xAF, 0xFF, 0x80, 0x03, 0xFF, 0xFF, 0x92, 0x00, 0x00, 0x4C, 0xFF, 0xFD, 0x10, 0x00, 0x70,
+    0x44, 0x89, 0xCB, 0xBE, 0xFF, 0xFF, 0xE3, 0x04, 0x81, 0x6E, 0x49, 0x81, 0xC2, 0x06, 0x82, 0x29,
+    0xE0, 0x45, 0x81, 0xB5, 0x0B, 0x85, 0x24, 0x55, 0x31, 0x06, 0x0D, 0x84, 0x5A, 0xAA, 0x10, 0x10,
+    0x85, 0x3E, 0xFF, 0xF1, 0x0F, 0x86, 0x1D, 0xFF, 0xFF, 0x10, 0x0F, 0x80, 0xA0, 0x44, 0x80, 0x10,
+    0x0E, 0x87, 0x6F, 0xFE, 0xFF, 0xF1, 0x0D, 0x88, 0x3E, 0xFF, 0x5F, 0xFF, 0x10, 0x0C, 0x89, 0x1D,
+    0xFF, 0x91, 0xFF, 0xF1, 0x0C, 0x89, 0xAF, 0xFC, 0x11, 0xFF, 0xF1, 0x0B, 0x8A, 0x6F, 0xFE, 0x20,
+    0x1F, 0xFF, 0x10, 0x0A, 0x8B, 0x3F, 0xFF, 0x60, 0x01, 0xFF, 0xF1, 0x09, 0x8C, 0x1D, 0xFF, 0xA0,
+    0x00, 0x1F, 0xFF, 0x10, 0x09, 0x8C, 0xAF, 0xFD, 0x10, 0x00, 0x1F, 0xFF, 0x10, 0x08, 0x8D, 0x6F,
+    0xFF, 0x30, 0x00, 0x01, 0xFF, 0xF1, 0x07, 0x84, 0x3F, 0xFF, 0x70, 0x04, 0x84, 0x1F, 0xFF, 0x10,
+    0x06, 0x84, 0x1D, 0xFF, 0xB0, 0x05, 0x84, 0x1F, 0xFF, 0x10, 0x06, 0x84, 0xAF, 0xFD, 0x10, 0x05,
+    0x84, 0x1F, 0xFF, 0x10, 0x05, 0x84, 0x7F, 0xFF, 0x40, 0x06, 0x84, 0x1F, 0xFF, 0x10, 0x04, 0x84,
+    0x3F, 0xFF, 0x80, 0x07, 0xA0, 0x1F, 0xFF, 0x10, 0x00, 0x01, 0xDF, 0xFE, 0x55, 0x55, 0x55, 0x55,
+    0x56, 0xFF, 0xF5, 0x55, 0x52, 0x10, 0x54, 0x82, 0x60, 0xD0, 0x53, 0x97, 0x60, 0x37, 0x77, 0x77,
+    0x77, 0x77, 0x77, 0x77, 0xFF, 0xF7, 0x77, 0x71, 0x0D, 0x84, 0x1F, 0xFF, 0x10, 0x11, 0x84, 0x1F,
+    0xFF, 0x10, 0x11, 0x84, 0x1F, 0xFF, 0x10, 0x11, 0x84, 0x1F, 0xFF, 0x10, 0x11, 0x84, 0x1F, 0xFF,
+    0x10, 0x11, 0x84, 0x1F, 0xFF, 0x10, 0x11, 0x88, 0x1F, 0xFF, 0x10, 0x00, 0x00, 0x96, 0x00, 0x01,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xA6, 0x00, 0x00, 0x30, 0x4C, 0x85, 0x80, 0x00, 0x06, 0x4C,
+    0x92, 0x70, 0x00, 0x09, 0xFF, 0xC9, 0x99, 0x99, 0x99, 0x99, 0x70, 0x04, 0x83, 0xBF, 0xF5, 0x0E,
+    0x83, 0xEF, 0xF2, 0x0D, 0x83, 0x1F, 0xFE, 0x0E, 0x83, 0x4F, 0xFC, 0x0E, 0x83, 0x6F, 0xF9, 0x0E,
+    0x83, 0x9F, 0xF6, 0x0E, 0x89, 0xCF, 0xF4, 0x13, 0x55, 0x42, 0x08, 0x83, 0xEF, 0xFE, 0x45, 0x82,
+    0xD8, 0x10, 0x04, 0x80, 0x20, 0x4B, 0x8F, 0xE5, 0x00, 0x00, 0x3E, 0xFF, 0xEC, 0xA9, 0xAD, 0x44,
+    0x80, 0x60, 0x04, 0x81, 0x43, 0x05, 0x86, 0x2A, 0xFF, 0xFF, 0x30, 0x0D, 0x84, 0x8F, 0xFF, 0xA0,
+    0x0E, 0x84, 0xCF, 0xFF, 0x10, 0x0D, 0x84, 0x6F, 0xFF, 0x40, 0x0D, 0x84, 0x3F, 0xFF, 0x60, 0x0D,
+    0x84, 0x2F, 0xFF, 0x70, 0x0D, 0x84, 0x3F, 0xFF, 0x60, 0x0D, 0x84, 0x6F, 0xFF, 0x40, 0x0D, 0x83,
+    0xBF, 0xFE, 0x0D, 0x89, 0x4F, 0xFF, 0x90, 0x06, 0xA3, 0x07, 0x9A, 0x2D, 0xFF, 0xF2, 0x04, 0xFF,
+    0xFA, 0x30, 0x00, 0x01, 0x7E, 0xFF, 0xF7, 0x00, 0x80, 0x44, 0x83, 0xEC, 0xBC, 0x44, 0x86, 0x80,
+    0x00, 0x05, 0xD0, 0x49, 0x81, 0xE6, 0x06, 0x81, 0x6B, 0x45, 0x82, 0xD7, 0x10, 0x09, 0x85, 0x13,
+    0x55, 0x41, 0x07, 0x0A, 0x84, 0x49, 0xAA, 0x80, 0x0D, 0x85, 0x5F, 0xFF, 0xE2, 0x0C, 0x85, 0x2E,
+    0xFF, 0xF4, 0x0D, 0x84, 0xCF, 0xFF, 0x80, 0x0D, 0x84, 0x8F, 0xFF, 0xB0, 0x0D, 0x85, 0x4F, 0xFF,
+    0xD1, 0x0C, 0x85, 0x1E, 0xFF, 0xE3, 0x0D, 0x84, 0xBF, 0xFF, 0x50, 0x0D, 0x84, 0x7F, 0xFF, 0x80,
+    0x0D, 0x84, 0x4F, 0xFF, 0xB0, 0x0D, 0x85, 0x1D, 0xFF, 0xD1, 0x0D, 0x8A, 0xBF, 0xFF, 0x33, 0x78,
+    0x87, 0x30, 0x07, 0x85, 0x6F, 0xFF, 0xBD, 0x45, 0x81, 0xD6, 0x04, 0x81, 0x1E, 0x4C, 0x9E, 0xB1,
+    0x00, 0x08, 0xFF, 0xFF, 0xE8, 0x43, 0x35, 0xAF, 0xFF, 0xFA, 0x00, 0x1E, 0xFF, 0xFB, 0x10, 0x05,
+    0x8B, 0x3E, 0xFF, 0xF6, 0x05, 0xFF, 0xFC, 0x08, 0x8A, 0x3F, 0xFF, 0xD0, 0x9F, 0xFF, 0x30, 0x09,
+    0x88, 0xAF, 0xFF, 0x3C, 0xFF, 0xD0, 0x0A, 0x88, 0x5F, 0xFF, 0x6D, 0xFF, 0xA0, 0x0A, 0x88, 0x2F,
+    0xFF, 0x7C, 0xFF, 0x90, 0x0A, 0x88, 0x2F, 0xFF, 0x7A, 0xFF, 0xB0, 0x0A, 0x88, 0x3F, 0xFF, 0x57,
+    0xFF, 0xE0, 0x0A, 0x89, 0x7F, 0xFF, 0x23, 0xFF, 0xF6, 0x08, 0x8B, 0x1E, 0xFF, 0xC0, 0x0C, 0xFF,
+    0xE2, 0x07, 0x8C, 0xBF, 0xFF, 0x50, 0x03, 0xFF, 0xFE, 0x50, 0x04, 0x99, 0x4C, 0xFF, 0xFB, 0x00,
+    0x00, 0x6F, 0xFF, 0xFE, 0xB9, 0xBD, 0xFF, 0xFF, 0xC1, 0x04, 0x81, 0x5E, 0x49, 0x81, 0x91, 0x06,
+    0x82, 0x18, 0xD0, 0x44, 0x82, 0xEA, 0x30, 0x0B, 0x84, 0x24, 0x54, 0x30, 0x07, 0x94, 0x8A, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xA7, 0xC0, 0x51, 0x81, 0xAC, 0x51, 0x94, 0xA5, 0x99,
+    0x99, 0x99, 0x99, 0x99, 0x99, 0x99, 0xAF, 0xFF, 0x50, 0x0E, 0x83, 0x9F, 0xFD, 0x0E, 0x84, 0x3F,
+    0xFF, 0x60, 0x0E, 0x83, 0xAF, 0xFD, 0x0E, 0x84, 0x3F, 0xFF, 0x60, 0x0E, 0x83, 0xAF, 0xFD, 0x0E,
+    0x84, 0x3F, 0xFF, 0x60, 0x0E, 0x83, 0xBF, 0xFD, 0x0E, 0x84, 0x3F, 0xFF, 0x60, 0x0E, 0x83, 0xBF,
+    0xFD, 0x0E, 0x84, 0x4F, 0xFF, 0x60, 0x0E, 0x83, 0xBF, 0xFD, 0x0E, 0x84, 0x4F, 0xFF, 0x60, 0x0E,
+    0x83, 0xCF, 0xFD, 0x0E, 0x84, 0x4F, 0xFF, 0x60, 0x0E, 0x84, 0xCF, 0xFE, 0x10, 0x0D, 0x84, 0x5F,
+    0xFF, 0x70, 0x0E, 0x84, 0xCF, 0xFE, 0x10, 0x0D, 0x84, 0x5F, 0xFF, 0x70, 0x0E, 0x84, 0xCF, 0xFE,
+    0x10, 0x0D, 0x84, 0x5F, 0xFF, 0x70, 0x0E, 0x84, 0xDF, 0xFE, 0x10, 0x0D, 0x84, 0x5F, 0xFF, 0x70,
+    0x0E, 0x84, 0xDF, 0xFE, 0x10, 0x0D, 0x84, 0x6F, 0xFF, 0x70, 0x0E, 0x83, 0xDF, 0xFA, 0x0C, 0x05,
+    0x88, 0x38, 0xCE, 0xFE, 0xC9, 0x40, 0x09, 0x81, 0x1A, 0x48, 0x81, 0xB2, 0x06, 0x8E, 0x2D, 0xFF,
+    0xFF, 0xDC, 0xDF, 0xFF, 0xFE, 0x30, 0x05, 0x98, 0xCF, 0xFF, 0x92, 0x00, 0x01, 0x7F, 0xFF, 0xE1,
+    0x00, 0x00, 0x6F, 0xFF, 0x70, 0x06, 0x8C, 0x5F, 0xFF, 0x80, 0x00, 0x0C, 0xFF, 0xD0, 0x08, 0x8B,
+    0xAF, 0xFE, 0x00, 0x00, 0xFF, 0xF8, 0x08, 0x8B, 0x5F, 0xFF, 0x20, 0x01, 0xFF, 0xF6, 0x08, 0x8B,
+    0x4F, 0xFF, 0x30, 0x00, 0xFF, 0xF7, 0x08, 0x8B, 0x5F, 0xFF, 0x30, 0x00, 0xDF, 0xFA, 0x08, 0x8C,
+    0x8F, 0xFF, 0x00, 0x00, 0x7F, 0xFF, 0x20, 0x06, 0x8E, 0x1E, 0xFF, 0xA0, 0x00, 0x01, 0xDF, 0xFD,
+    0x20, 0x04, 0x85, 0x1B, 0xFF, 0xE2, 0x04, 0x8E, 0x3E, 0xFF, 0xE9, 0x55, 0x58, 0xEF, 0xFE, 0x40,
+    0x06, 0x81, 0x19, 0x48, 0x81, 0xA2, 0x07, 0x82, 0x29, 0xE0, 0x47, 0x81, 0xA3, 0x06, 0x8E, 0x7F,
+    0xFF, 0xFD, 0xA9, 0xAC, 0xFF, 0xFF, 0x90, 0x04, 0x85, 0x8F, 0xFF, 0xC3, 0x04, 0x8D, 0x2A, 0xFF,
+    0xFA, 0x00, 0x03, 0xFF, 0xFB, 0x08, 0x8B, 0x9F, 0xFF, 0x60, 0x0A, 0xFF, 0xF2, 0x08, 0x8A, 0x1E,
+    0xFF, 0xC0, 0x0E, 0xFF, 0xC0, 0x0A, 0x89, 0x9F, 0xFF, 0x11, 0xFF, 0xF9, 0x0A, 0x89, 0x7F, 0xFF,
+    0x31, 0xFF, 0xF9, 0x0A, 0x89, 0x7F, 0xFF, 0x30, 0xFF, 0xFB, 0x0A, 0x8A, 0x9F, 0xFF, 0x20, 0xBF,
+    0xFF, 0x20, 0x08, 0x8B, 0x1E, 0xFF, 0xE0, 0x06, 0xFF, 0xFB, 0x08, 0x8D, 0x9F, 0xFF, 0x80, 0x00,
+    0xCF, 0xFF, 0xB2, 0x04, 0x9A, 0x2A, 0xFF, 0xFE, 0x10, 0x00, 0x2E, 0xFF, 0xFF, 0xC9, 0x89, 0xBF,
+    0xFF, 0xFE, 0x40, 0x04, 0x81, 0x2B, 0x4A, 0x81, 0xD3, 0x07, 0x82, 0x4A, 0xE0, 0x45, 0x81, 0xB5,
+    0x0C, 0x85, 0x34, 0x54, 0x31, 0x06, 0x04, 0x88, 0x39, 0xCE, 0xFE, 0xC8, 0x20, 0x07, 0x81, 0x2B,
+    0x48, 0x81, 0x91, 0x04, 0x81, 0x4E, 0x4A, 0x9C, 0xD1, 0x00, 0x03, 0xEF, 0xFF, 0xA4, 0x10, 0x15,
+    0xCF, 0xFF, 0xC0, 0x00, 0xCF, 0xFF, 0x50, 0x06, 0x8A, 0x9F, 0xFF, 0x70, 0x5F, 0xFF, 0x60, 0x08,
+    0x88, 0xBF, 0xFD, 0x0A, 0xFF, 0xE0, 0x09, 0x88, 0x4F, 0xFF, 0x3E, 0xFF, 0xA0, 0x0A, 0x87, 0xFF,
+    0xF6, 0xFF, 0xF8, 0x0A, 0x87, 0xDF, 0xF8, 0xFF, 0xF8, 0x0A, 0x87, 0xEF, 0xF8, 0xEF, 0xFB, 0x09,
+    0x89, 0x2F, 0xFF, 0x7B, 0xFF, 0xE1, 0x08, 0x89, 0x8F, 0xFF, 0x56, 0xFF, 0xF9, 0x07, 0x8C, 0x3F,
+    0xFF, 0xF2, 0x0D, 0xFF, 0xF9, 0x10, 0x04, 0x92, 0x6E, 0xFF, 0xFC, 0x00, 0x3F, 0xFF, 0xFE, 0xA8,
+    0x89, 0xD0, 0x44, 0x85, 0x50, 0x00, 0x4E, 0x47, 0x84, 0xEE, 0xFF, 0xC0, 0x04, 0x8D, 0x18, 0xDF,
+    0xFF, 0xFD, 0x87, 0xFF, 0xF4, 0x07, 0x89, 0x23, 0x32, 0x02, 0xEF, 0xF9, 0x0C, 0x85, 0x1C, 0xFF,
+    0xD1, 0x0C, 0x84, 0x9F, 0xFF, 0x40, 0x0C, 0x84, 0x6F, 0xFF, 0x80, 0x0C, 0x84, 0x3E, 0xFF, 0xC0,
+    0x0C, 0x85, 0x1D, 0xFF, 0xF3, 0x0C, 0x84, 0xAF, 0xFF, 0x70, 0x0C, 0x84, 0x7F, 0xFF, 0xB0, 0x0C,
+    0x85, 0x3F, 0xFF, 0xE2, 0x0B, 0x85, 0x1D, 0xFF, 0xF6, 0x0C, 0x84, 0xBF, 0xFF, 0xA0, 0x0C, 0x85,
+    0x7F, 0xFF, 0xB1, 0x09, 0xA1, 0x03, 0xAA, 0x40, 0x2E, 0xFF, 0xF3, 0x6F, 0xFF, 0xF8, 0x5F, 0xFF,
+    0xF6, 0x0B, 0xFF, 0xC1, 0x00, 0x34, 0x38, 0xA2, 0x3A, 0xA4, 0x02, 0xEF, 0xFF, 0x36, 0xFF, 0xFF,
+    0x85, 0xFF, 0xFF, 0x60, 0xBF, 0xFC, 0x10, 0x03, 0x40, 0x00, 0xA1, 0x03, 0xAA, 0x40, 0x2E, 0xFF,
+    0xF3, 0x6F, 0xFF, 0xF8, 0x5F, 0xFF, 0xF6, 0x0B, 0xFF, 0xC1, 0x00, 0x34, 0x38, 0xBF, 0x3A, 0xA4,
+    0x01, 0xEF, 0xFF, 0x25, 0xFF, 0xFF, 0x72, 0xFF, 0xFF, 0x80, 0x6E, 0xFF, 0x60, 0x00, 0xDF, 0x20,
+    0x04, 0xFB, 0x00, 0x1C, 0xF3, 0x00, 0xAF, 0x80, 0x01, 0xEA, 0x00, 0x00, 0x30, 0x00, 0x80, 0x00,
+    0x0F, 0x80, 0x10, 0x0D, 0x82, 0x3B, 0x70, 0x0B, 0x84, 0x3A, 0xFF, 0x70, 0x09, 0x86, 0x2A, 0xFF,
+    0xFF, 0x60, 0x07, 0x87, 0x29, 0xFF, 0xFF, 0xE7, 0x06, 0x88, 0x29, 0xFF, 0xFF, 0xE7, 0x10, 0x05,
+    0x88, 0x18, 0xEF, 0xFF, 0xE8, 0x10, 0x05, 0x88, 0x18, 0xEF, 0xFF, 0xE8, 0x10, 0x06, 0x87, 0x7E,
+    0xFF, 0xFE, 0x81, 0x07, 0x86, 0x1F, 0xFF, 0xFB, 0x20, 0x0A, 0x86, 0x8F, 0xFF, 0xFE, 0x70, 0x0A,
+    0x87, 0x29, 0xFF, 0xFF, 0xD6, 0x0A, 0x87, 0x2A, 0xFF, 0xFF, 0xD6, 0x0A, 0x87, 0x3A, 0xFF, 0xFF,
+    0xD6, 0x0A, 0x87, 0x3B, 0xFF, 0xFF, 0xD6, 0x0A, 0x86, 0x4B, 0xFF, 0xFF, 0x60, 0x0B, 0x84, 0x4C,
+    0xFF, 0x70, 0x0D, 0x82, 0x5C, 0x70, 0x0F, 0x80, 0x10, 0x91, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+    0x33, 0x33, 0x31, 0x50, 0x80, 0x30, 0x50, 0x92, 0x38, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,
+    0x88, 0x10, 0x35, 0x91, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x81, 0x50, 0x80, 0x30,
+    0x50, 0x92, 0x34, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x10, 0x80, 0x10, 0x0F, 0x82,
+    0x4C, 0x50, 0x0D, 0x84, 0x4F, 0xFC, 0x40, 0x0B, 0x86, 0x3F, 0xFF, 0xFB, 0x40, 0x0A, 0x87, 0x5D,
+    0xFF, 0xFF, 0xB3, 0x0A, 0x87, 0x6D, 0xFF, 0xFF, 0xA3, 0x0A, 0x87, 0x6D, 0xFF, 0xFF, 0xA2, 0x0A,
+    0x87, 0x6D, 0xFF, 0xFF, 0x92, 0x0A, 0x87, 0x6E, 0xFF, 0xFF, 0x91, 0x09, 0x86, 0x19, 0xFF, 0xFF,
+    0x30, 0x08, 0x87, 0x5C, 0xFF, 0xFF, 0xA1, 0x06, 0x87, 0x5C, 0xFF, 0xFF, 0xA3, 0x06, 0x87, 0x5C,
+    0xFF, 0xFF, 0xB3, 0x06, 0x87, 0x5C, 0xFF, 0xFF, 0xC4, 0x06, 0x87, 0x4C, 0xFF, 0xFF, 0xC4, 0x07,
+    0x86, 0x3F, 0xFF, 0xFD, 0x50, 0x09, 0x84, 0x4F, 0xFD, 0x60, 0x0B, 0x82, 0x4D, 0x60, 0x0D, 0x81,
+    0x11, 0x0E, 0x8B, 0x00, 0x01, 0x6B, 0xDF, 0xED, 0x93, 0x05, 0x81, 0x7E, 0x47, 0x85, 0xA1, 0x00,
+    0x1C, 0x44, 0x80, 0xE0, 0x44, 0x96, 0xC0, 0x01, 0xDF, 0xF9, 0x30, 0x01, 0x5D, 0xFF, 0xF7, 0x00,
+    0x4C, 0x30, 0x05, 0x84, 0x1D, 0xFF, 0xD0, 0x0B, 0x84, 0x5F, 0xFF, 0x20, 0x0A, 0x84, 0x2F, 0xFF,
+    0x30, 0x0A, 0x84, 0x3F, 0xFF, 0x20, 0x0A, 0x83, 0x7F, 0xFE, 0x0A, 0x84, 0x2E, 0xFF, 0x90, 0x09,
+    0x85, 0x1C, 0xFF, 0xE1, 0x08, 0x85, 0x3D, 0xFF, 0xE4, 0x08, 0x85, 0x6F, 0xFF, 0xD3, 0x08, 0x85,
+    0x7F, 0xFF, 0xB1, 0x08, 0x84, 0x2F, 0xFF, 0x90, 0x0A, 0x83, 0x4F, 0xFD, 0x0B, 0x83, 0x3F, 0xFA,
+    0x0B, 0x83, 0x2F, 0xF9, 0x0B, 0x83, 0x1F, 0xF7, 0x3F, 0x1B, 0x83, 0x39, 0xA4, 0x0A, 0x85, 0x1E,
+    0xFF, 0xF3, 0x09, 0x85, 0x6F, 0xFF, 0xF8, 0x09, 0x85, 0x4F, 0xFF, 0xF7, 0x0A, 0x84, 0xBF, 0xFC,
+    0x10, 0x0B, 0x81, 0x34, 0x07, 0x0D, 0x83, 0x12, 0x32, 0x16, 0x83, 0x17, 0xBE, 0x44, 0x82, 0xD9,
+    0x40, 0x10, 0x81, 0x29, 0x4B, 0x81, 0xD6, 0x0D, 0x92, 0x7F, 0xFF, 0xFB, 0x74, 0x33, 0x35, 0x8C,
+    0xFF, 0xFC, 0x20, 0x09, 0x86, 0x1A, 0xFF, 0xE8, 0x10, 0x08, 0x85, 0x29, 0xFF, 0xE4, 0x07, 0x85,
+    0x1B, 0xFF, 0xB2, 0x0C, 0x84, 0x4E, 0xFE, 0x30, 0x06, 0x83, 0xAF, 0xF9, 0x0F, 0x84, 0x2E, 0xFD,
+    0x10, 0x04, 0x83, 0x7F, 0xFA, 0x11, 0x8C, 0x4F, 0xF9, 0x00, 0x00, 0x2E, 0xFC, 0x10, 0x12, 0x8A,
+    0x9F, 0xF2, 0x00, 0x09, 0xFF, 0x30, 0x07, 0x95, 0x28, 0xBD, 0xDD, 0xB8, 0x30, 0x00, 0x2F, 0xF7,
+    0x00, 0x1F, 0xFA, 0x06, 0x81, 0x2A, 0x47, 0x8D, 0xA0, 0x00, 0x0C, 0xFC, 0x00, 0x7F, 0xF4, 0x05,
+    0x97, 0x4E, 0xFF, 0xD8, 0x66, 0xAF, 0xF6, 0x00, 0x00, 0x8F, 0xF1, 0x0B, 0xFE, 0x05, 0x98, 0x4F,
+    0xFF, 0x70, 0x00, 0x08, 0xFF, 0x30, 0x00, 0x06, 0xFF, 0x30, 0xEF, 0xA0, 0x04, 0x84, 0x1E, 0xFF,
+    0x40, 0x04, 0x82, 0xCF, 0xE0, 0x04, 0x87, 0x5F, 0xF4, 0x2F, 0xF7, 0x04, 0x83, 0x8F, 0xF7, 0x04,
+    0x83, 0x1F, 0xFA, 0x04, 0x8F, 0x4F, 0xF4, 0x4F, 0xF6, 0x00, 0x00, 0x1E, 0xFE, 0x05, 0x83, 0x4F,
+    0xF6, 0x04, 0x8F, 0x5F, 0xF3, 0x4F, 0xF5, 0x00, 0x00, 0x4F, 0xF8, 0x05, 0x83, 0x8F, 0xF2, 0x04,
+    0x8F, 0x7F, 0xF1, 0x4F, 0xF5, 0x00, 0x00, 0x7F, 0xF5, 0x05, 0x82, 0xCF, 0xD0, 0x05, 0x8F, 0xAF,
+    0xD0, 0x3F, 0xF6, 0x00, 0x00, 0x9F, 0xF3, 0x04, 0x83, 0x2F, 0xFB, 0x04, 0x90, 0x1E, 0xF9, 0x01,
+    0xFF, 0x80, 0x00, 0x08, 0xFF, 0x40, 0x04, 0x83, 0x9F, 0xF9, 0x04, 0xBF, 0x8F, 0xF3, 0x00, 0xEF,
+    0xB0, 0x00, 0x06, 0xFF, 0x90, 0x00, 0x04, 0xFF, 0xFB, 0x00, 0x00, 0x4F, 0xF9, 0x00, 0x0A, 0xFF,
+    0x10, 0x00, 0x2F, 0xFF, 0x72, 0x38, 0xFF, 0xBF, 0xF5, 0x01, 0x6E, 0xFD, 0x8C, 0x10, 0x00, 0x6F,
+    0xF6, 0x00, 0x00, 0x80, 0x46, 0x82, 0x71, 0xE0, 0x45, 0x89, 0xC2, 0x00, 0x00, 0x1E, 0xFC, 0x04,
+    0x90, 0x8E, 0xFF, 0xFC, 0x40, 0x04, 0xEF, 0xFF, 0xE7, 0x10, 0x05, 0x83, 0x8F, 0xF6, 0x04, 0x83,
+    0x13, 0x31, 0x05, 0x82, 0x34, 0x30, 0x08, 0x84, 0x1E, 0xFE, 0x20, 0x1A, 0x84, 0x5F, 0xFD, 0x10,
+    0x1A, 0x84, 0x8F, 0xFD, 0x20, 0x1A, 0x85, 0x9F, 0xFE, 0x71, 0x0C, 0x83, 0x16, 0xE9, 0x08, 0x86,
+    0x6F, 0xFF, 0xE8, 0x30, 0x07, 0x86, 0x14, 0x9E, 0xFF, 0xE0, 0x09, 0x8D, 0x3B, 0xFF, 0xFF, 0xEB,
+    0xA9, 0x99, 0xBD, 0x44, 0x81, 0x92, 0x0B, 0x82, 0x3A, 0xE0, 0x4A, 0x82, 0xD8, 0x20, 0x10, 0x8A,
+    0x47, 0x9B, 0xBB, 0xBA, 0x86, 0x20, 0x07, 0x0A, 0x84, 0x5A, 0xAA, 0x70, 0x15, 0x85, 0xCF, 0xFF,
+    0xF1, 0x13, 0x80, 0x30, 0x44, 0x80, 0x70, 0x13, 0x80, 0x90, 0x44, 0x80, 0xD0, 0x12, 0x88, 0x1E,
+    0xFF, 0xBF, 0xFF, 0x40, 0x11, 0x88, 0x6F, 0xFF, 0x3E, 0xFF, 0xA0, 0x11, 0x89, 0xCF, 0xFD, 0x09,
+    0xFF, 0xF1, 0x0F, 0x8A, 0x3F, 0xFF, 0x70, 0x3F, 0xFF, 0x70, 0x0F, 0x8A, 0x9F, 0xFF, 0x20, 0x0C,
+    0xFF, 0xD0, 0x0E, 0x8C, 0x1E, 0xFF, 0xB0, 0x00, 0x7F, 0xFF, 0x40, 0x0D, 0x8C, 0x6F, 0xFF, 0x50,
+    0x00, 0x1F, 0xFF, 0xA0, 0x0D, 0x83, 0xCF, 0xFE, 0x04, 0x84, 0xAF, 0xFF, 0x10, 0x0B, 0x84, 0x3F,
+    0xFF, 0x80, 0x04, 0x84, 0x4F, 0xFF, 0x70, 0x0B, 0x84, 0x9F, 0xFF, 0x20, 0x05, 0x83, 0xDF, 0xFD,
+    0x0A, 0x84, 0x1E, 0xFF, 0xC0, 0x06, 0x84, 0x8F, 0xFF, 0x40, 0x09, 0x84, 0x6F, 0xFF, 0x60, 0x06,
+    0x84, 0x2F, 0xFF, 0xA0, 0x09, 0x84, 0xCF, 0xFE, 0x10, 0x07, 0x84, 0xBF, 0xFF, 0x10, 0x07, 0x84,
+    0x3F, 0xFF, 0x90, 0x08, 0x84, 0x5F, 0xFF, 0x70, 0x07, 0x92, 0x9F, 0xFF, 0xB9, 0x99, 0x99, 0x99,
+    0x99, 0xAF, 0xFF, 0xD0, 0x06, 0x81, 0x1E, 0x51, 0x80, 0x40, 0x05, 0x80, 0x60, 0x52, 0x80, 0xA0,
+    0x05, 0x9E, 0xCF, 0xFF, 0x43, 0x33, 0x33, 0x33, 0x33, 0x33, 0x3C, 0xFF, 0xF1, 0x00, 0x00, 0x3F,
+    0xFF, 0xA0, 0x0C, 0x8D, 0x6F, 0xFF, 0x70, 0x00, 0x09, 0xFF, 0xF4, 0x0C, 0x8C, 0x1F, 0xFF, 0xD0,
+    0x00, 0x1E, 0xFF, 0xD0, 0x0E, 0x8B, 0xAF, 0xFF, 0x40, 0x06, 0xFF, 0xF8, 0x0E, 0x8B, 0x4F, 0xFF,
+    0xA0, 0x0C, 0xFF, 0xF2, 0x0F, 0x89, 0xDF, 0xFF, 0x13, 0xFF, 0xFB, 0x10, 0x89, 0x7F, 0xFF, 0x79,
+    0xFF, 0xE4, 0x10, 0x84, 0x1D, 0xFF, 0xD0, 0x8E, 0x5A, 0xAA, 0xAA, 0xAA, 0xAA, 0x99, 0x74, 0x10,
+    0x05, 0x80, 0x80, 0x4D, 0x86, 0xA3, 0x00, 0x00, 0x80, 0x4F, 0x90, 0x70, 0x00, 0x8F, 0xFF, 0x96,
+    0x66, 0x66, 0x78, 0xB0, 0x44, 0x87, 0x70, 0x08, 0xFF, 0xF5, 0x07, 0x8C, 0x2B, 0xFF, 0xFE, 0x10,
+    0x8F, 0xFF, 0x50, 0x09, 0x8A, 0xCF, 0xFF, 0x60, 0x8F, 0xFF, 0x50, 0x09, 0x8A, 0x6F, 0xFF, 0x90,
+    0x8F, 0xFF, 0x50, 0x09, 0x8A, 0x3F, 0xFF, 0xB0, 0x8F, 0xFF, 0x50, 0x09, 0x8A, 0x2F, 0xFF, 0xA0,
+    0x8F, 0xFF, 0x50, 0x09, 0x8A, 0x4F, 0xFF, 0x70, 0x8F, 0xFF, 0x50, 0x09, 0x8A, 0xAF, 0xFF, 0x20,
+    0x8F, 0xFF, 0x50, 0x08, 0x8B, 0x6F, 0xFF, 0x80, 0x08, 0xFF, 0xF5, 0x06, 0x9E, 0x4A, 0xFF, 0xF9,
+    0x00, 0x08, 0xFF, 0xFD, 0xCC, 0xCC, 0xCD, 0xFF, 0xFF, 0xC5, 0x00, 0x00, 0x80, 0x4C, 0x91, 0xD7,
+    0x20, 0x00, 0x08, 0xFF, 0xFE, 0xEE, 0xEE, 0xEE, 0x45, 0x88, 0xA1, 0x00, 0x8F, 0xFF, 0x50, 0x06,
+    0x8D, 0x15, 0xBF, 0xFF, 0xD2, 0x08, 0xFF, 0xF5, 0x09, 0x8A, 0x7F, 0xFF, 0xC0, 0x8F, 0xFF, 0x50,
+    0x0A, 0x89, 0xAF, 0xFF, 0x48, 0xFF, 0xF5, 0x0A, 0x89, 0x4F, 0xFF, 0x88, 0xFF, 0xF5, 0x0A, 0x89,
+    0x2F, 0xFF, 0xA8, 0xFF, 0xF5, 0x0A, 0x89, 0x3F, 0xFF, 0xA8, 0xFF, 0xF5, 0x0A, 0x89, 0x6F, 0xFF,
+    0x88, 0xFF, 0xF5, 0x0A, 0x89, 0xCF, 0xFF, 0x48, 0xFF, 0xF5, 0x08, 0x9C, 0x1A, 0xFF, 0xFC, 0x08,
+    0xFF, 0xF6, 0x11, 0x11, 0x11, 0x24, 0x7D, 0xFF, 0xFF, 0x30, 0x80, 0x50, 0x83, 0x50, 0x08, 0x4E,
+    0x85, 0xB3, 0x00, 0x08, 0x4A, 0x83, 0xDB, 0x83, 0x04, 0x09, 0x8A, 0x59, 0xBE, 0xEF, 0xEC, 0xA6,
+    0x10, 0x0A, 0x82, 0x18, 0xE0, 0x4A, 0x81, 0x91, 0x07, 0x81, 0x5E, 0x4D, 0x81, 0xE5, 0x05, 0x80,
+    0x80, 0x44, 0x87, 0xEA, 0x76, 0x67, 0x9C, 0x44, 0x8B, 0x70, 0x00, 0x08, 0xFF, 0xFF, 0xD6, 0x07,
+    0x8F, 0x3A, 0xFF, 0xE2, 0x00, 0x06, 0xFF, 0xFF, 0xA1, 0x0A, 0x8B, 0x5D, 0x60, 0x00, 0x2E, 0xFF,
+    0xF9, 0x12, 0x84, 0x9F, 0xFF, 0xC0, 0x12, 0x85, 0x1F, 0xFF, 0xF3, 0x12, 0x84, 0x6F, 0xFF, 0xB0,
+    0x13, 0x84, 0xBF, 0xFF, 0x50, 0x13, 0x84, 0xEF, 0xFF, 0x10, 0x12, 0x84, 0x1F, 0xFF, 0xE0, 0x13,
+    0x84, 0x2F, 0xFF, 0xC0, 0x13, 0x84, 0x3F, 0xFF, 0xB0, 0x13, 0x84, 0x3F, 0xFF, 0xC0, 0x13, 0x84,
+    0x2F, 0xFF, 0xD0, 0x14, 0x83, 0xFF, 0xFF, 0x14, 0x84, 0xCF, 0xFF, 0x30, 0x13, 0x84, 0x9F, 0xFF,
+    0x80, 0x13, 0x85, 0x4F, 0xFF, 0xE1, 0x13, 0x84, 0xDF, 0xFF, 0x80, 0x13, 0x85, 0x6F, 0xFF, 0xF3,
+    0x13, 0x85, 0xCF, 0xFF, 0xE3, 0x0B, 0x8D, 0x3D, 0x60, 0x00, 0x02, 0xEF, 0xFF, 0xE7, 0x09, 0x9D,
+    0x7F, 0xFF, 0x50, 0x00, 0x04, 0xEF, 0xFF, 0xFD, 0x84, 0x10, 0x12, 0x48, 0xDF, 0xFF, 0xF5, 0x04,
+    0x81, 0x3D, 0x4E, 0x81, 0xE4, 0x06, 0x81, 0x19, 0x4C, 0x81, 0xA2, 0x09, 0x82, 0x28, 0xC0, 0x46,
+    0x82, 0xD9, 0x30, 0x0E, 0x86, 0x13, 0x45, 0x43, 0x10, 0x06, 0x8F, 0x5A, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0x98, 0x52, 0x09, 0x80, 0x80, 0x4E, 0x81, 0xC6, 0x07, 0x80, 0x80, 0x50, 0x81, 0xD4, 0x05,
+    0x8E, 0x8F, 0xFF, 0xA8, 0x88, 0x88, 0x88, 0x8A, 0xE0, 0x44, 0x80, 0x80, 0x04, 0x84, 0x8F, 0xFF,
+    0x60, 0x09, 0x8F, 0x4C, 0xFF, 0xFF, 0x90, 0x00, 0x08, 0xFF, 0xF6, 0x0B, 0x8D, 0x7F, 0xFF, 0xF7,
+    0x00, 0x08, 0xFF, 0xF6, 0x0C, 0x8C, 0x6F, 0xFF, 0xF3, 0x00, 0x8F, 0xFF, 0x60, 0x0D, 0x8B, 0x9F,
+    0xFF, 0xB0, 0x08, 0xFF, 0xF6, 0x0D, 0x8B, 0x1E, 0xFF, 0xF3, 0x08, 0xFF, 0xF6, 0x0E, 0x8A, 0x8F,
+    0xFF, 0x80, 0x8F, 0xFF, 0x60, 0x0E, 0x8A, 0x3F, 0xFF, 0xC0, 0x8F, 0xFF, 0x60, 0x0F, 0x89, 0xEF,
+    0xFF, 0x18, 0xFF, 0xF6, 0x0F, 0x89, 0xCF, 0xFF, 0x38, 0xFF, 0xF6, 0x0F, 0x89, 0xBF, 0xFF, 0x48,
+    0xFF, 0xF6, 0x0F, 0x89, 0xAF, 0xFF, 0x58, 0xFF, 0xF6, 0x0F, 0x89, 0xAF, 0xFF, 0x48, 0xFF, 0xF6,
+    0x0F, 0x89, 0xBF, 0xFF, 0x38, 0xFF, 0xF6, 0x0F, 0x89, 0xDF, 0xFF, 0x28, 0xFF, 0xF6, 0x0E, 0x8A,
+    0x2F, 0xFF, 0xE0, 0x8F, 0xFF, 0x60, 0x0E, 0x8A, 0x6F, 0xFF, 0xA0, 0x8F, 0xFF, 0x60, 0x0E, 0x8A,
+    0xCF, 0xFF, 0x50, 0x8F, 0xFF, 0x60, 0x0D, 0x8B, 0x6F, 0xFF, 0xD0, 0x08, 0xFF, 0xF6, 0x0C, 0x8C,
+    0x2E, 0xFF, 0xF5, 0x00, 0x8F, 0xFF, 0x60, 0x0B, 0x8D, 0x2D, 0xFF, 0xFB, 0x00, 0x08, 0xFF, 0xF6,
+    0x09, 0xA5, 0x17, 0xEF, 0xFF, 0xD1, 0x00, 0x08, 0xFF, 0xF7, 0x22, 0x22, 0x22, 0x23, 0x59, 0xEF,
+    0xFF, 0xFD, 0x20, 0x00, 0x08, 0x51, 0x81, 0xA1, 0x04, 0x80, 0x80, 0x4F, 0x81, 0xB4, 0x06, 0x80,
+    0x80, 0x4A, 0x84, 0xED, 0xA7, 0x20, 0x08, 0x93, 0x5A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0x18, 0x50, 0x81, 0x28, 0x50, 0x98, 0x28, 0xFF, 0xFA, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88,
+    0x81, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84,
+    0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F,
+    0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x80, 0x80, 0x4D,
+    0x84, 0x80, 0x00, 0x80, 0x4D, 0x84, 0x80, 0x00, 0x80, 0x4D, 0x9B, 0x80, 0x00, 0x8F, 0xFF, 0x61,
+    0x11, 0x11, 0x11, 0x11, 0x10, 0x00, 0x08, 0xFF, 0xF6, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84,
+    0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F,
+    0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x93, 0x8F, 0xFF,
+    0x73, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x08, 0x50, 0x81, 0x28, 0x50, 0x81, 0x28, 0x50, 0x80,
+    0x20, 0x93, 0x5A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x18, 0x50, 0x81, 0x28, 0x50,
+    0x98, 0x28, 0xFF, 0xFA, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x81, 0x8F, 0xFF, 0x60, 0x0D, 0x84,
+    0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F,
+    0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF,
+    0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x93, 0x8F, 0xFF, 0xA8, 0x88, 0x88, 0x88, 0x88, 0x88,
+    0x10, 0x08, 0x4E, 0x83, 0x20, 0x08, 0x4E, 0x9A, 0x20, 0x08, 0xFF, 0xFC, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xA1, 0x00, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60,
+    0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D,
+    0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84,
+    0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x84, 0x8F, 0xFF, 0x60, 0x0D, 0x09, 0x8A,
+    0x48, 0xBD, 0xEF, 0xED, 0xB8, 0x40, 0x0B, 0x82, 0x18, 0xE0, 0x4A, 0x82, 0xE8, 0x10, 0x07, 0x81,
+    0x6E, 0x4E, 0x81, 0xD4, 0x05, 0x80, 0x90, 0x44, 0x88, 0xEA, 0x86, 0x66, 0x8B, 0xE0, 0x44, 0x8B,
+    0x50, 0x00, 0x09, 0xFF, 0xFF, 0xD6, 0x08, 0x8F, 0x5D, 0xFF, 0xE2, 0x00, 0x07, 0xFF, 0xFF, 0x91,
+    0x0B, 0x8B, 0x7D, 0x60, 0x00, 0x2F, 0xFF, 0xF9, 0x13, 0x84, 0xAF, 0xFF, 0xB0, 0x13, 0x85, 0x2F,
+    0xFF, 0xF3, 0x13, 0x84, 0x7F, 0xFF, 0xA0, 0x14, 0x84, 0xBF, 0xFF, 0x50, 0x14, 0x84, 0xEF, 0xFF,
+    0x10, 0x13, 0x84, 0x1F, 0xFF, 0xE0, 0x14, 0x84, 0x2F, 0xFF, 0xC0, 0x14, 0x84, 0x3F, 0xFF, 0xB0,
+    0x14, 0x84, 0x3F, 0xFF, 0xC0, 0x0B, 0x8D, 0xAB, 0xBB, 0xBB, 0xBB, 0xA2, 0xFF, 0xFD, 0x0B, 0x80,
+    0xE0, 0x46, 0x85, 0xD0, 0xFF, 0xFF, 0x0B, 0x80, 0xD0, 0x46, 0x86, 0xD0, 0xCF, 0xFF, 0x30, 0x0A,
+    0x8E, 0x13, 0x33, 0x3B, 0xFF, 0xD0, 0x8F, 0xFF, 0x80, 0x0F, 0x89, 0xAF, 0xFD, 0x03, 0xFF, 0xFE,
+    0x0F, 0x8A, 0xAF, 0xFD, 0x00, 0xCF, 0xFF, 0x70, 0x0E, 0x8B, 0xAF, 0xFD, 0x00, 0x4F, 0xFF, 0xF3,
+    0x0D, 0x8C, 0xAF, 0xFD, 0x00, 0x0A, 0xFF, 0xFE, 0x30, 0x0C, 0x8D, 0xAF, 0xFD, 0x00, 0x01, 0xCF,
+    0xFF, 0xE6, 0x0A, 0x91, 0x2C, 0xFF, 0xD0, 0x00, 0x02, 0xDF, 0xFF, 0xFC, 0x62, 0x04, 0x87, 0x25,
+    0xAF, 0xFF, 0xFD, 0x04, 0x81, 0x1B, 0x45, 0x84, 0xED, 0xCD, 0xE0, 0x46, 0x80, 0x70, 0x06, 0x81,
+    0x6D, 0x4D, 0x81, 0xA2, 0x09, 0x82, 0x5A, 0xE0, 0x46, 0x83, 0xEB, 0x61, 0x0E, 0x86, 0x24, 0x55,
+    0x43, 0x10, 0x06, 0x84, 0x5A, 0xAA, 0x40, 0x0D, 0x89, 0x2A, 0xAA, 0x78, 0xFF, 0xF6, 0x0D, 0x89,
+    0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF,
+    0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF,
+    0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D,
+    0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F,
+    0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x9D, 0x3F, 0xFF, 0xB8,
+    0xFF, 0xFE, 0xDD, 0xDD, 0xDD, 0xDD, 0xDD, 0xDD, 0xDD, 0xDF, 0xFF, 0xB8, 0x55, 0x9D, 0xB8, 0xFF,
+    0xFE, 0xEE, 0xEE, 0xEE, 0xEE, 0xEE, 0xEE, 0xEE, 0xEF, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F,
+    0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8,
+    0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6,
+    0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89,
+    0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF,
+    0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF, 0xF6, 0x0D, 0x89, 0x3F, 0xFF, 0xB8, 0xFF,
+    0xF6, 0x0D, 0x84, 0x3F, 0xFF, 0xB0, 0xBF, 0x8A, 0xAA, 0x1C, 0xFF, 0xF1, 0xCF, 0xFF, 0x1C, 0xFF,
+    0xF1, 0xCF, 0xFF, 0x1C, 0xFF, 0xF1, 0xCF, 0xFF, 0x1C, 0xFF, 0xF1, 0xCF, 0xFF, 0x1C, 0xFF, 0xF1,
+    0xCF, 0xFF, 0x1C, 0xFF, 0xF1, 0xCF, 0xFF, 0xBF, 0x1C, 0xFF, 0xF1, 0xCF, 0xFF, 0x1C, 0xFF, 0xF1,
+    0xCF, 0xFF, 0x1C, 0xFF, 0xF1, 0xCF, 0xFF, 0x1C, 0xFF, 0xF1, 0xCF, 0xFF, 0x1C, 0xFF, 0xF1, 0xCF,
+    0xFF, 0x1C, 0xFF, 0xF1, 0xCF, 0xFF, 0x1C, 0xFF, 0x90, 0xF1, 0xCF, 0xFF, 0x1C, 0xFF, 0xF1, 0xCF,
+    0xFF, 0x10, 0x08, 0x84, 0x6A, 0xAA, 0x30, 0x08, 0x84, 0x9F, 0xFF, 0x40, 0x08, 0x84, 0x9F, 0xFF,
+    0x40, 0x08, 0x84, 0x9F, 0xFF, 0x40, 0x08, 0x84, 0x9F, 0xFF, 0x40, 0x08, 0x84, 0x9F, 0xFF, 0x40,
+    0x08, 0x84, 0x9F, 0xFF, 0x40, 0x08, 0x84, 0x9F, 0xFF, 0x40, 0x08, 0x84, 0x9F, 0xFF, 0x40, 0x08,
+    0x84, 0x9F, 0xFF, 0x40, 0x08, 0x84, 0x9F, 0xFF, 0x40, 0x08, 0x84, 0x9F, 0xFF, 0x40, 0x08, 0x84,
+    0x9F, 0xFF, 0x40, 0x08, 0x84, 0x9F, 0xFF, 0x40, 0x08, 0x84, 0x9F, 0xFF, 0x40, 0x08, 0x84, 0x9F,
+    0xFF, 0x40, 0x08, 0x84, 0x9F, 0xFF, 0x40, 0x08, 0x84, 0x9F, 0xFF, 0x40, 0x08, 0x84, 0x9F, 0xFF,
+    0x40, 0x08, 0x84, 0x9F, 0xFF, 0x40, 0x08, 0x84, 0xAF, 0xFF, 0x30, 0x08, 0x84, 0xCF, 0xFF, 0x10,
+    0x07, 0x84, 0x1F, 0xFF, 0xE0, 0x08, 0x84, 0x7F, 0xFF, 0x90, 0x07, 0x99, 0x3E, 0xFF, 0xF4, 0x01,
+    0x41, 0x00, 0x27, 0xEF, 0xFF, 0xB0, 0x08, 0xFF, 0xEE, 0x44, 0x84, 0xD2, 0x00, 0xA0, 0x47, 0x85,
+    0xC2, 0x00, 0x0A, 0x45, 0x81, 0xD6, 0x05, 0x85, 0x13, 0x45, 0x41, 0x06, 0x84, 0x1A, 0xAA, 0x80,
+    0x0C, 0x8A, 0x5A, 0xAA, 0x70, 0x2F, 0xFF, 0xB0, 0x0B, 0x8B, 0x6F, 0xFF, 0xD1, 0x02, 0xFF, 0xFB,
+    0x0A, 0x8C, 0x5F, 0xFF, 0xE2, 0x00, 0x2F, 0xFF, 0xB0, 0x09, 0x8D, 0x3E, 0xFF, 0xF4, 0x00, 0x02,
+    0xFF, 0xFB, 0x08, 0x8E, 0x2E, 0xFF, 0xF5, 0x00, 0x00, 0x2F, 0xFF, 0xB0, 0x07, 0x85, 0x1D, 0xFF,
+    0xF7, 0x04, 0x84, 0x2F, 0xFF, 0xB0, 0x06, 0x85, 0x1C, 0xFF, 0xF8, 0x05, 0x84, 0x2F, 0xFF, 0xB0,
+    0x06, 0x84, 0xAF, 0xFF, 0xA0, 0x06, 0x84, 0x2F, 0xFF, 0xB0, 0x05, 0x84, 0x9F, 0xFF, 0xB0, 0x07,
+    0x84, 0x2F, 0xFF, 0xB0, 0x04, 0x85, 0x7F, 0xFF, 0xC1, 0x07, 0x8E, 0x2F, 0xFF, 0xB0, 0x00, 0x05,
+    0xFF, 0xFD, 0x20, 0x08, 0x8D, 0x2F, 0xFF, 0xB0, 0x00, 0x4F, 0xFF, 0xE3, 0x09, 0x8C, 0x2F, 0xFF,
+    0xC2, 0x25, 0xEF, 0xFF, 0x40, 0x0A, 0x80, 0x20, 0x48, 0x81, 0xE4, 0x0B, 0x80, 0x20, 0x48, 0x81,
+    0xE7, 0x0B, 0x8C, 0x2F, 0xFF, 0xFD, 0xDE, 0xFF, 0xFF, 0x60, 0x0A, 0x8D, 0x2F, 0xFF, 0xB0, 0x00,
+    0x9F, 0xFF, 0xF4, 0x09, 0x8E, 0x2F, 0xFF, 0xB0, 0x00, 0x0A, 0xFF, 0xFE, 0x20, 0x08, 0x84, 0x2F,
+    0xFF, 0xB0, 0x04, 0x85, 0xBF, 0xFF, 0xD1, 0x07, 0x84, 0x2F, 0xFF, 0xB0, 0x04, 0x85, 0x1D, 0xFF,
+    0xFB, 0x07, 0x84, 0x2F, 0xFF, 0xB0, 0x05, 0x85, 0x2E, 0xFF, 0xF9, 0x06, 0x84, 0x2F, 0xFF, 0xB0,
+    0x06, 0x85, 0x3E, 0xFF, 0xF7, 0x05, 0x84, 0x2F, 0xFF, 0xB0, 0x07, 0x85, 0x5F, 0xFF, 0xF5, 0x04,
+    0x84, 0x2F, 0xFF, 0xB0, 0x08, 0x8E, 0x6F, 0xFF, 0xE3, 0x00, 0x00, 0x2F, 0xFF, 0xB0, 0x09, 0x8D,
+    0x8F, 0xFF, 0xD1, 0x00, 0x02, 0xFF, 0xFB, 0x0A, 0x8C, 0xAF, 0xFF, 0xC1, 0x00, 0x2F, 0xFF, 0xB0,
+    0x0A, 0x8C, 0x1C, 0xFF, 0xFA, 0x00, 0x2F, 0xFF, 0xB0, 0x0B, 0x8B, 0x1D, 0xFF, 0xF8, 0x02, 0xFF,
+    0xFB, 0x0C, 0x85, 0x2C, 0xFF, 0xF5, 0x84, 0x5A, 0xAA, 0x40, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B,
+    0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84,
+    0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F,
+    0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF,
+    0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50,
+    0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B,
+    0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84,
+    0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F, 0xFF, 0x50, 0x0B, 0x84, 0x8F,
+    0xFF, 0x50, 0x0B, 0x91, 0x8F, 0xFF, 0x84, 0x44, 0x44, 0x44, 0x44, 0x44, 0x38, 0x4E, 0x81, 0xB8,
+    0x4E, 0x81, 0xB8, 0x4E, 0x80, 0xB0, 0x84, 0x5A, 0xAA, 0x40, 0x14, 0x8A, 0x6A, 0xAA, 0x38, 0xFF,
+    0xFE, 0x10, 0x12, 0x8B, 0x3F, 0xFF, 0xF4, 0x8F, 0xFF, 0xF8, 0x12, 0x8C, 0xBF, 0xFF, 0xF4, 0x8F,
+    0xFF, 0xFE, 0x20, 0x10, 0x80, 0x40, 0x44, 0x81, 0x48, 0x44, 0x80, 0xA0, 0x10, 0x80, 0xC0, 0x44,
+    0x81, 0x48, 0x45, 0x80, 0x30, 0x0E, 0x80, 0x60, 0x45, 0x88, 0x48, 0xFF, 0xDE, 0xFF, 0xB0, 0x0D,
+    0x91, 0x1D, 0xFF, 0xCF, 0xFF, 0x48, 0xFF, 0xD6, 0xFF, 0xF5, 0x0C, 0x91, 0x7F, 0xFF, 0x4F, 0xFF,
+    0x48, 0xFF, 0xD0, 0xCF, 0xFD, 0x0B, 0x93, 0x1E, 0xFF, 0xA1, 0xFF, 0xF4, 0x8F, 0xFD, 0x04, 0xFF,
+    0xF7, 0x0A, 0x94, 0x9F, 0xFF, 0x21, 0xFF, 0xF4, 0x8F, 0xFD, 0x00, 0xBF, 0xFE, 0x10, 0x08, 0x95,
+    0x2F, 0xFF, 0x80, 0x1F, 0xFF, 0x48, 0xFF, 0xD0, 0x03, 0xFF, 0xF9, 0x08, 0x96, 0xAF, 0xFE, 0x10,
+    0x1F, 0xFF, 0x48, 0xFF, 0xD0, 0x00, 0x9F, 0xFF, 0x20, 0x06, 0x97, 0x3F, 0xFF, 0x70, 0x01, 0xFF,
+    0xF4, 0x8F, 0xFD, 0x00, 0x01, 0xEF, 0xFA, 0x06, 0x98, 0xCF, 0xFD, 0x00, 0x01, 0xFF, 0xF4, 0x8F,
+    0xFD, 0x00, 0x00, 0x7F, 0xFF, 0x40, 0x04, 0x99, 0x5F, 0xFF, 0x50, 0x00, 0x1F, 0xFF, 0x48, 0xFF,
+    0xD0, 0x00, 0x01, 0xDF, 0xFC, 0x04, 0x90, 0xDF, 0xFC, 0x00, 0x00, 0x1F, 0xFF, 0x48, 0xFF, 0xD0,
+    0x04, 0x99, 0x6F, 0xFF, 0x60, 0x00, 0x6F, 0xFF, 0x40, 0x00, 0x01, 0xFF, 0xF4, 0x8F, 0xFD, 0x05,
+    0x8A, 0xCF, 0xFD, 0x10, 0x1E, 0xFF, 0xB0, 0x04, 0x88, 0x1F, 0xFF, 0x48, 0xFF, 0xD0, 0x05, 0x8A,
+    0x4F, 0xFF, 0x80, 0x8F, 0xFF, 0x30, 0x04, 0x88, 0x1F, 0xFF, 0x48, 0xFF, 0xD0, 0x06, 0x88, 0xBF,
+    0xFE, 0x2E, 0xFF, 0x90, 0x05, 0x88, 0x1F, 0xFF, 0x48, 0xFF, 0xD0, 0x06, 0x88, 0x2F, 0xFF, 0xCF,
+    0xFE, 0x20, 0x05, 0x88, 0x1F, 0xFF, 0x48, 0xFF, 0xD0, 0x07, 0x80, 0x90, 0x44, 0x80, 0x80, 0x06,
+    0x88, 0x1F, 0xFF, 0x48, 0xFF, 0xD0, 0x07, 0x86, 0x1E, 0xFF, 0xFE, 0x10, 0x06, 0x88, 0x1F, 0xFF,
+    0x48, 0xFF, 0xD0, 0x08, 0x84, 0x7F, 0xFF, 0x60, 0x07, 0x88, 0x1F, 0xFF, 0x48, 0xFF, 0xD0, 0x09,
+    0x82, 0xAD, 0xA0, 0x08, 0x88, 0x1F, 0xFF, 0x48, 0xFF, 0xD0, 0x15, 0x88, 0x1F, 0xFF, 0x48, 0xFF,
+    0xD0, 0x15, 0x88, 0x1F, 0xFF, 0x48, 0xFF, 0xD0, 0x15, 0x88, 0x1F, 0xFF, 0x48, 0xFF, 0xD0, 0x15,
+    0x84, 0x1F, 0xFF, 0x40, 0x83, 0x5A, 0xA5, 0x0F, 0x88, 0x7A, 0xA7, 0x8F, 0xFF, 0x30, 0x0E, 0x89,
+    0xAF, 0xFB, 0x8F, 0xFF, 0xD1, 0x0D, 0x89, 0xAF, 0xFB, 0x8F, 0xFF, 0xFB, 0x0D, 0x84, 0xAF, 0xFB,
+    0x80, 0x44, 0x80, 0x80, 0x0C, 0x84, 0xAF, 0xFB, 0x80, 0x45, 0x80, 0x40, 0x0B, 0x84, 0xAF, 0xFB,
+    0x80, 0x45, 0x81, 0xE2, 0x0A, 0x8C, 0xAF, 0xFB, 0x8F, 0xFD, 0x9F, 0xFF, 0xC0, 0x0A, 0x8D, 0xAF,
+    0xFB, 0x8F, 0xFD, 0x0C, 0xFF, 0xF9, 0x09, 0x8E, 0xAF, 0xFB, 0x8F, 0xFD, 0x02, 0xEF, 0xFF, 0x50,
+    0x08, 0x8F, 0xAF, 0xFB, 0x8F, 0xFD, 0x00, 0x5F, 0xFF, 0xE2, 0x07, 0x90, 0xAF, 0xFB, 0x8F, 0xFD,
+    0x00, 0x08, 0xFF, 0xFD, 0x10, 0x06, 0x90, 0xAF, 0xFB, 0x8F, 0xFD, 0x00, 0x00, 0xBF, 0xFF, 0xA0,
+    0x06, 0x91, 0xAF, 0xFB, 0x8F, 0xFD, 0x00, 0x00, 0x1D, 0xFF, 0xF6, 0x05, 0x87, 0xAF, 0xFB, 0x8F,
+    0xFD, 0x04, 0x85, 0x4F, 0xFF, 0xF3, 0x04, 0x87, 0xAF, 0xFB, 0x8F, 0xFD, 0x05, 0x91, 0x7F, 0xFF,
+    0xD1, 0x00, 0x00, 0xAF, 0xFB, 0x8F, 0xFD, 0x06, 0x90, 0xAF, 0xFF, 0xB0, 0x00, 0x0A, 0xFF, 0xB8,
+    0xFF, 0xD0, 0x06, 0x90, 0x1D, 0xFF, 0xF8, 0x00, 0x0A, 0xFF, 0xB8, 0xFF, 0xD0, 0x07, 0x8F, 0x3E,
+    0xFF, 0xF4, 0x00, 0xAF, 0xFB, 0x8F, 0xFD, 0x08, 0x8E, 0x6F, 0xFF, 0xE2, 0x0A, 0xFF, 0xB8, 0xFF,
+    0xD0, 0x09, 0x8D, 0x9F, 0xFF, 0xC0, 0xAF, 0xFB, 0x8F, 0xFD, 0x09, 0x8D, 0x1C, 0xFF, 0xF9, 0xAF,
+    0xFB, 0x8F, 0xFD, 0x0A, 0x8C, 0x2E, 0xFF, 0xFD, 0xFF, 0xB8, 0xFF, 0xD0, 0x0B, 0x80, 0x50, 0x45,
+    0x84, 0xB8, 0xFF, 0xD0, 0x0C, 0x80, 0x80, 0x44, 0x84, 0xB8, 0xFF, 0xD0, 0x0D, 0x89, 0xBF, 0xFF,
+    0xFB, 0x8F, 0xFD, 0x0D, 0x89, 0x1E, 0xFF, 0xFB, 0x8F, 0xFD, 0x0E, 0x88, 0x4F, 0xFF, 0xB8, 0xFF,
+    0xD0, 0x0F, 0x83, 0x6F, 0xFB, 0x08, 0x8B, 0x15, 0x9C, 0xEF, 0xFE, 0xC9, 0x51, 0x0F, 0x82, 0x19,
+    0xE0, 0x49, 0x82, 0xE8, 0x10, 0x0C, 0x81, 0x6E, 0x4D, 0x81, 0xE5, 0x0A, 0x80, 0x90, 0x44, 0x87,
+    0xDA, 0x76, 0x67, 0xAE, 0x44, 0x80, 0x80, 0x08, 0x86, 0x9F, 0xFF, 0xFC, 0x40, 0x07, 0x86, 0x5C,
+    0xFF, 0xFF, 0x80, 0x06, 0x85, 0x6F, 0xFF, 0xF8, 0x0B, 0x85, 0x9F, 0xFF, 0xF5, 0x04, 0x85, 0x1E,
+    0xFF, 0xF7, 0x0D, 0x8E, 0x8F, 0xFF, 0xE1, 0x00, 0x00, 0x9F, 0xFF, 0xB0, 0x0F, 0x8D, 0xCF, 0xFF,
+    0x80, 0x00, 0x1E, 0xFF, 0xF2, 0x0F, 0x8C, 0x3F, 0xFF, 0xE1, 0x00, 0x6F, 0xFF, 0xA0, 0x11, 0x8B,
+    0xCF, 0xFF, 0x50, 0x0A, 0xFF, 0xF5, 0x11, 0x8B, 0x6F, 0xFF, 0x90, 0x0D, 0xFF, 0xF2, 0x11, 0x8A,
+    0x3F, 0xFF, 0xC0, 0x1F, 0xFF, 0xE0, 0x13, 0x89, 0xFF, 0xFF, 0x02, 0xFF, 0xFD, 0x13, 0x89, 0xEF,
+    0xFF, 0x12, 0xFF, 0xFC, 0x13, 0x89, 0xDF, 0xFF, 0x12, 0xFF, 0xFC, 0x13, 0x89, 0xEF, 0xFF, 0x11,
+    0xFF, 0xFD, 0x13, 0x8A, 0xFF, 0xFF, 0x00, 0xEF, 0xFF, 0x10, 0x11, 0x8B, 0x2F, 0xFF, 0xD0, 0x0B,
+    0xFF, 0xF4, 0x11, 0x8B, 0x5F, 0xFF, 0xA0, 0x07, 0xFF, 0xF8, 0x11, 0x8C, 0xAF, 0xFF, 0x70, 0x03,
+    0xFF, 0xFE, 0x10, 0x0F, 0x8D, 0x1E, 0xFF, 0xF2, 0x00, 0x0B, 0xFF, 0xF7, 0x0F, 0x8E, 0x9F, 0xFF,
+    0xA0, 0x00, 0x04, 0xFF, 0xFF, 0x30, 0x0D, 0x85, 0x4F, 0xFF, 0xF3, 0x04, 0x85, 0xAF, 0xFF, 0xE3,
+    0x0B, 0x85, 0x4E, 0xFF, 0xF9, 0x05, 0x87, 0x1D, 0xFF, 0xFF, 0x71, 0x07, 0x87, 0x18, 0xFF, 0xFF,
+    0xC1, 0x06, 0x95, 0x2D, 0xFF, 0xFF, 0xE9, 0x52, 0x11, 0x25, 0x9E, 0xFF, 0xFF, 0xC1, 0x08, 0x81,
+    0x1B, 0x4F, 0x81, 0xA1, 0x0B, 0x81, 0x6D, 0x4B, 0x81, 0xD5, 0x0F, 0x82, 0x5A, 0xE0, 0x45, 0x82,
+    0xEA, 0x50, 0x14, 0x85, 0x23, 0x54, 0x32, 0x0B, 0x8D, 0x1A, 0xAA, 0xAA, 0xAA, 0xAA, 0x98, 0x63,
+    0x05, 0x80, 0x20, 0x4C, 0x86, 0xD7, 0x10, 0x00, 0x20, 0x4E, 0x9C, 0xD3, 0x00, 0x2F, 0xFF, 0xD6,
+    0x66, 0x66, 0x79, 0xDF, 0xFF, 0xFE, 0x30, 0x2F, 0xFF, 0xB0, 0x07, 0x8B, 0x4D, 0xFF, 0xFC, 0x02,
+    0xFF, 0xFB, 0x08, 0x8A, 0x2E, 0xFF, 0xF5, 0x2F, 0xFF, 0xB0, 0x09, 0x89, 0x6F, 0xFF, 0xA2, 0xFF,
+    0xFB, 0x09, 0x89, 0x1F, 0xFF, 0xD2, 0xFF, 0xFB, 0x0A, 0x88, 0xEF, 0xFF, 0x2F, 0xFF, 0xB0, 0x0A,
+    0x88, 0xDF, 0xFF, 0x2F, 0xFF, 0xB0, 0x0A, 0x88, 0xEF, 0xFE, 0x2F, 0xFF, 0xB0, 0x09, 0x89, 0x4F,
+    0xFF, 0xB2, 0xFF, 0xFB, 0x09, 0x89, 0xBF, 0xFF, 0x72, 0xFF, 0xFB, 0x08, 0x8A, 0x9F, 0xFF, 0xE1,
+    0x2F, 0xFF, 0xB0, 0x05, 0x93, 0x15, 0xCF, 0xFF, 0xF6, 0x02, 0xFF, 0xFE, 0xCC, 0xCC, 0xCD, 0x45,
+    0x83, 0x80, 0x02, 0x4D, 0x85, 0xE5, 0x00, 0x02, 0x4A, 0x93, 0xEB, 0x61, 0x00, 0x00, 0x2F, 0xFF,
+    0xC4, 0x44, 0x44, 0x42, 0x07, 0x84, 0x2F, 0xFF, 0xB0, 0x0E, 0x84, 0x2F, 0xFF, 0xB0, 0x0E, 0x84,
+    0x2F, 0xFF, 0xB0, 0x0E, 0x84, 0x2F, 0xFF, 0xB0, 0x0E, 0x84, 0x2F, 0xFF, 0xB0, 0x0E, 0x84, 0x2F,
+    0xFF, 0xB0, 0x0E, 0x84, 0x2F, 0xFF, 0xB0, 0x0E, 0x84, 0x2F, 0xFF, 0xB0, 0x0E, 0x84, 0x2F, 0xFF,
+    0xB0, 0x0E, 0x84, 0x2F, 0xFF, 0xB0, 0x0E, 0x08, 0x8B, 0x15, 0x9C, 0xEF, 0xFE, 0xC9, 0x51, 0x10,
+    0x82, 0x19, 0xE0, 0x49, 0x82, 0xE8, 0x10, 0x0D, 0x81, 0x6E, 0x4D, 0x81, 0xE5, 0x0B, 0x80, 0x90,
+    0x44, 0x87, 0xDA, 0x76, 0x67, 0xAE, 0x44, 0x80, 0x80, 0x09, 0x86, 0x9F, 0xFF, 0xFC, 0x40, 0x07,
+    0x86, 0x5C, 0xFF, 0xFF, 0x80, 0x07, 0x85, 0x6F, 0xFF, 0xF8, 0x0B, 0x85, 0x9F, 0xFF, 0xF5, 0x05,
+    0x85, 0x1E, 0xFF, 0xF7, 0x0D, 0x85, 0x8F, 0xFF, 0xE1, 0x04, 0x84, 0x9F, 0xFF, 0xB0, 0x0F, 0x8E,
+    0xCF, 0xFF, 0x80, 0x00, 0x01, 0xEF, 0xFF, 0x20, 0x0F, 0x8D, 0x3F, 0xFF, 0xE1, 0x00, 0x06, 0xFF,
+    0xFA, 0x11, 0x8C, 0xCF, 0xFF, 0x50, 0x00, 0xAF, 0xFF, 0x50, 0x11, 0x8C, 0x6F, 0xFF, 0x90, 0x00,
+    0xDF, 0xFF, 0x20, 0x11, 0x8B, 0x3F, 0xFF, 0xC0, 0x01, 0xFF, 0xFE, 0x13, 0x8A, 0xFF, 0xFF, 0x00,
+    0x2F, 0xFF, 0xD0, 0x13, 0x8A, 0xEF, 0xFF, 0x10, 0x2F, 0xFF, 0xC0, 0x13, 0x8A, 0xDF, 0xFF, 0x10,
+    0x2F, 0xFF, 0xC0, 0x13, 0x8A, 0xEF, 0xFF, 0x10, 0x1F, 0xFF, 0xD0, 0x13, 0x8B, 0xFF, 0xFF, 0x00,
+    0x0E, 0xFF, 0xF1, 0x11, 0x8C, 0x2F, 0xFF, 0xD0, 0x00, 0xBF, 0xFF, 0x40, 0x11, 0x8C, 0x5F, 0xFF,
+    0xA0, 0x00, 0x7F, 0xFF, 0x80, 0x11, 0x8D, 0xAF, 0xFF, 0x60, 0x00, 0x3F, 0xFF, 0xE1, 0x0F, 0x8E,
+    0x1E, 0xFF, 0xF2, 0x00, 0x00, 0xBF, 0xFF, 0x70, 0x0F, 0x84, 0x9F, 0xFF, 0xA0, 0x04, 0x85, 0x4F,
+    0xFF, 0xF3, 0x0D, 0x85, 0x4F, 0xFF, 0xF3, 0x05, 0x85, 0xAF, 0xFF, 0xE3, 0x0B, 0x85, 0x4E, 0xFF,
+    0xF8, 0x06, 0x87, 0x1D, 0xFF, 0xFF, 0x71, 0x07, 0x86, 0x18, 0xFF, 0xFF, 0xC0, 0x08, 0x95, 0x2D,
+    0xFF, 0xFF, 0xE9, 0x52, 0x11, 0x25, 0x9E, 0xFF, 0xFF, 0xC1, 0x09, 0x81, 0x1B, 0x4F, 0x81, 0xA1,
+    0x0C, 0x81, 0x6D, 0x4D, 0x80, 0x80, 0x0F, 0x82, 0x5A, 0xE0, 0x45, 0x86, 0xEA, 0xEF, 0xFF, 0x70,
+    0x11, 0x8D, 0x23, 0x54, 0x32, 0x00, 0x4F, 0xFF, 0xF6, 0x19, 0x85, 0x5F, 0xFF, 0xF5, 0x19, 0x85,
+    0x6F, 0xFF, 0xF4, 0x19, 0x85, 0x7F, 0xFF, 0xE4, 0x19, 0x85, 0x8F, 0xFF, 0xE3, 0x19, 0x85, 0x7D,
+    0xEE, 0xD2, 0x8D, 0x1A, 0xAA, 0xAA, 0xAA, 0xAA, 0x98, 0x62, 0x07, 0x80, 0x20, 0x4C, 0x81, 0xD6,
+    0x05, 0x80, 0x20, 0x4E, 0xA0, 0xC2, 0x00, 0x00, 0x2F, 0xFF, 0xD6, 0x66, 0x66, 0x7A, 0xEF, 0xFF,
+    0xFD, 0x10, 0x00, 0x2F, 0xFF, 0xB0, 0x07, 0x8D, 0x6E, 0xFF, 0xF9, 0x00, 0x02, 0xFF, 0xFB, 0x08,
+    0x8C, 0x4F, 0xFF, 0xF1, 0x00, 0x2F, 0xFF, 0xB0, 0x09, 0x8B, 0xAF, 0xFF, 0x50, 0x02, 0xFF, 0xFB,
+    0x09, 0x8B, 0x6F, 0xFF, 0x70, 0x02, 0xFF, 0xFB, 0x09, 0x8B, 0x5F, 0xFF, 0x70, 0x02, 0xFF, 0xFB,
+    0x09, 0x8B, 0x6F, 0xFF, 0x60, 0x02, 0xFF, 0xFB, 0x09, 0x8B, 0x9F, 0xFF, 0x30, 0x02, 0xFF, 0xFB,
+    0x08, 0x8C, 0x2E, 0xFF, 0xD0, 0x00, 0x2F, 0xFF, 0xB0, 0x07, 0x8D, 0x1C, 0xFF, 0xF5, 0x00, 0x02,
+    0xFF, 0xFB, 0x05, 0x95, 0x27, 0xEF, 0xFF, 0x90, 0x00, 0x02, 0xFF, 0xFE, 0xBB, 0xBB, 0xCE, 0x44,
+    0x80, 0x80, 0x04, 0x80, 0x20, 0x4C, 0x81, 0xB3, 0x05, 0x80, 0x20, 0x4A, 0x81, 0xD2, 0x07, 0x8D,
+    0x2F, 0xFF, 0xB1, 0x11, 0x2B, 0xFF, 0xF9, 0x07, 0x8E, 0x2F, 0xFF, 0xB0, 0x00, 0x01, 0xDF, 0xFF,
+    0x50, 0x06, 0x84, 0x2F, 0xFF, 0xB0, 0x04, 0x85, 0x4F, 0xFF, 0xE2, 0x05, 0x84, 0x2F, 0xFF, 0xB0,
+    0x05, 0x84, 0x8F, 0xFF, 0xC0, 0x05, 0x84, 0x2F, 0xFF, 0xB0, 0x06, 0x84, 0xCF, 0xFF, 0x80, 0x04,
+    0x84, 0x2F, 0xFF, 0xB0, 0x06, 0x8E, 0x2E, 0xFF, 0xF4, 0x00, 0x00, 0x2F, 0xFF, 0xB0, 0x07, 0x8D,
+    0x5F, 0xFF, 0xE2, 0x00, 0x02, 0xFF, 0xFB, 0x08, 0x8C, 0x9F, 0xFF, 0xB0, 0x00, 0x2F, 0xFF, 0xB0,
+    0x08, 0x8C, 0x1D, 0xFF, 0xF7, 0x00, 0x2F, 0xFF, 0xB0, 0x09, 0x8B, 0x3F, 0xFF, 0xF4, 0x02, 0xFF,
+    0xFB, 0x0A, 0x8A, 0x7F, 0xFF, 0xD1, 0x2F, 0xFF, 0xB0, 0x0B, 0x84, 0x9F, 0xFF, 0xA0, 0x05, 0x88,
+    0x5A, 0xDE, 0xFE, 0xC9, 0x40, 0x07, 0x81, 0x4D, 0x48, 0x81, 0xC4, 0x04, 0x80, 0x50, 0x4C, 0x9B,
+    0x80, 0x00, 0x3F, 0xFF, 0xFC, 0x74, 0x45, 0x8D, 0xFF, 0xFC, 0x00, 0x0C, 0xFF, 0xF7, 0x06, 0x8A,
+    0x7E, 0xF5, 0x00, 0x3F, 0xFF, 0x90, 0x08, 0x89, 0x25, 0x00, 0x07, 0xFF, 0xF2, 0x0D, 0x83, 0x9F,
+    0xFF, 0x0E, 0x84, 0x9F, 0xFF, 0x10, 0x0D, 0x84, 0x7F, 0xFF, 0x70, 0x0D, 0x85, 0x3F, 0xFF, 0xF6,
+    0x0D, 0x86, 0xCF, 0xFF, 0xFC, 0x50, 0x0B, 0x81, 0x3E, 0x44, 0x82, 0xE9, 0x40, 0x09, 0x81, 0x3E,
+    0x46, 0x82, 0xE8, 0x20, 0x07, 0x82, 0x18, 0xE0, 0x47, 0x81, 0x81, 0x08, 0x82, 0x5A, 0xE0, 0x45,
+    0x81, 0xC1, 0x0A, 0x81, 0x5A, 0x44, 0x80, 0xA0, 0x0C, 0x86, 0x2B, 0xFF, 0xFF, 0x30, 0x0D, 0x84,
+    0xAF, 0xFF, 0x80, 0x0D, 0x84, 0x2F, 0xFF, 0xB0, 0x0E, 0x83, 0xEF, 0xFB, 0x0E, 0x83, 0xEF, 0xFA,
+    0x0D, 0x88, 0x2F, 0xFF, 0x70, 0x7A, 0x20, 0x09, 0x89, 0x8F, 0xFF, 0x33, 0xFF, 0xE5, 0x07, 0x9A,
+    0x5F, 0xFF, 0xC0, 0xAF, 0xFF, 0xFC, 0x51, 0x00, 0x03, 0x9F, 0xFF, 0xF3, 0x01, 0xB0, 0x45, 0x81,
+    0xED, 0x45, 0x86, 0x60, 0x00, 0x07, 0xE0, 0x49, 0x81, 0xE5, 0x05, 0x82, 0x17, 0xC0, 0x45, 0x82,
+    0xD7, 0x10, 0x09, 0x85, 0x13, 0x55, 0x42, 0x06, 0x97, 0x5A, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xA7, 0x55, 0x80, 0x70, 0x55, 0x96, 0x49, 0x99, 0x99, 0x99, 0x9A, 0xFF,
+    0xFE, 0x99, 0x99, 0x99, 0x99, 0x90, 0x08, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0,
+    0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11,
+    0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84,
+    0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F,
+    0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF,
+    0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0,
+    0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11,
+    0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84, 0x2F, 0xFF, 0xB0, 0x11, 0x84,
+    0x2F, 0xFF, 0xB0, 0x08, 0x84, 0x8A, 0xAA, 0x10, 0x0D, 0x88, 0x9A, 0xAA, 0xCF, 0xFF, 0x10, 0x0D,
+    0x88, 0xDF, 0xFF, 0xCF, 0xFF, 0x10, 0x0D, 0x88, 0xDF, 0xFF, 0xCF, 0xFF, 0x10, 0x0D, 0x88, 0xDF,
+    0xFF, 0xCF, 0xFF, 0x10, 0x0D, 0x88, 0xDF, 0xFF, 0xCF, 0xFF, 0x10, 0x0D, 0x88, 0xDF, 0xFF, 0xCF,
+    0xFF, 0x10, 0x0D, 0x88, 0xDF, 0xFF, 0xCF, 0xFF, 0x10, 0x0D, 0x88, 0xDF, 0xFF, 0xCF, 0xFF, 0x10,
+    0x0D, 0x88, 0xDF, 0xFF, 0xCF, 0xFF, 0x10, 0x0D, 0x88, 0xDF, 0xFF, 0xCF, 0xFF, 0x10, 0x0D, 0x88,
+    0xDF, 0xFF, 0xCF, 0xFF, 0x10, 0x0D, 0x88, 0xDF, 0xFF, 0xCF, 0xFF, 0x10, 0x0D, 0x88, 0xDF, 0xFF,
+    0xCF, 0xFF, 0x10, 0x0D, 0x88, 0xDF, 0xFF, 0xCF, 0xFF, 0x10, 0x0D, 0x88, 0xDF, 0xFF, 0xCF, 0xFF,
+    0x10, 0x0D, 0x88, 0xDF, 0xFF, 0xCF, 0xFF, 0x10, 0x0D, 0x88, 0xDF, 0xFF, 0xCF, 0xFF, 0x10, 0x0D,
+    0x88, 0xDF, 0xFF, 0xCF, 0xFF, 0x10, 0x0D, 0x88, 0xDF, 0xFF, 0xAF, 0xFF, 0x30, 0x0D, 0x88, 0xEF,
+    0xFE, 0x8F, 0xFF, 0x60, 0x0C, 0x89, 0x3F, 0xFF, 0xB4, 0xFF, 0xFB, 0x0C, 0x8A, 0x8F, 0xFF, 0x80,
+    0xEF, 0xFF, 0x40, 0x0A, 0x8C, 0x1E, 0xFF, 0xF3, 0x08, 0xFF, 0xFD, 0x10, 0x09, 0x8D, 0xBF, 0xFF,
+    0xB0, 0x01, 0xDF, 0xFF, 0xD3, 0x06, 0x8A, 0x1B, 0xFF, 0xFF, 0x30, 0x00, 0x30, 0x44, 0x8C, 0xA5,
+    0x21, 0x24, 0x9E, 0xFF, 0xFF, 0x60, 0x04, 0x81, 0x4E, 0x4D, 0x80, 0x70, 0x06, 0x81, 0x2C, 0x4A,
+    0x81, 0xD4, 0x09, 0x82, 0x4A, 0xE0, 0x45, 0x81, 0xC6, 0x0E, 0x85, 0x34, 0x55, 0x31, 0x07, 0x84,
+    0x7A, 0xA9, 0x20, 0x10, 0x89, 0x19, 0xAA, 0x96, 0xFF, 0xFA, 0x10, 0x8A, 0x8F, 0xFF, 0x80, 0xEF,
+    0xFF, 0x10, 0x0F, 0x8A, 0xDF, 0xFF, 0x20, 0x8F, 0xFF, 0x70, 0x0E, 0x8B, 0x5F, 0xFF, 0xB0, 0x02,
+    0xFF, 0xFD, 0x0E, 0x8C, 0xBF, 0xFF, 0x50, 0x00, 0xBF, 0xFF, 0x40, 0x0C, 0x8D, 0x2F, 0xFF, 0xD0,
+    0x00, 0x05, 0xFF, 0xFA, 0x0C, 0x84, 0x8F, 0xFF, 0x80, 0x04, 0x84, 0xEF, 0xFF, 0x10, 0x0B, 0x84,
+    0xDF, 0xFF, 0x20, 0x04, 0x84, 0x8F, 0xFF, 0x70, 0x0A, 0x84, 0x5F, 0xFF, 0xA0, 0x05, 0x84, 0x2F,
+    0xFF, 0xD0, 0x0A, 0x84, 0xBF, 0xFF, 0x40, 0x06, 0x84, 0xAF, 0xFF, 0x40, 0x08, 0x84, 0x2F, 0xFF,
+    0xD0, 0x07, 0x84, 0x4F, 0xFF, 0xA0, 0x08, 0x84, 0x8F, 0xFF, 0x70, 0x08, 0x84, 0xDF, 0xFF, 0x10,
+    0x07, 0x84, 0xDF, 0xFF, 0x10, 0x08, 0x84, 0x7F, 0xFF, 0x70, 0x06, 0x84, 0x4F, 0xFF, 0xA0, 0x09,
+    0x84, 0x1F, 0xFF, 0xD0, 0x06, 0x84, 0xAF, 0xFF, 0x40, 0x0A, 0x84, 0xAF, 0xFF, 0x40, 0x04, 0x84,
+    0x2F, 0xFF, 0xD0, 0x0B, 0x84, 0x4F, 0xFF, 0xA0, 0x04, 0x84, 0x7F, 0xFF, 0x70, 0x0C, 0x8D, 0xDF,
+    0xFF, 0x20, 0x00, 0x0D, 0xFF, 0xE1, 0x0C, 0x8C, 0x7F, 0xFF, 0x70, 0x00, 0x4F, 0xFF, 0x90, 0x0D,
+    0x8C, 0x1E, 0xFF, 0xD0, 0x00, 0xAF, 0xFF, 0x30, 0x0E, 0x8A, 0x9F, 0xFF, 0x40, 0x2F, 0xFF, 0xC0,
+    0x0F, 0x8A, 0x3F, 0xFF, 0xA0, 0x7F, 0xFF, 0x60, 0x10, 0x89, 0xCF, 0xFF, 0x1D, 0xFF, 0xE1, 0x10,
+    0x88, 0x6F, 0xFF, 0x7F, 0xFF, 0x90, 0x11, 0x88, 0x1E, 0xFF, 0xEF, 0xFF, 0x30, 0x12, 0x80, 0x90,
+    0x44, 0x80, 0xB0, 0x13, 0x80, 0x30, 0x44, 0x80, 0x50, 0x14, 0x84, 0xCF, 0xFF, 0xE0, 0x15, 0x84,
+    0x5F, 0xFF, 0x80, 0x0A, 0x84, 0x6A, 0xAA, 0x40, 0x0C, 0x84, 0x18, 0xA9, 0x10, 0x0C, 0x89, 0x4A,
+    0xAA, 0x45, 0xFF, 0xFD, 0x0C, 0x84, 0x7F, 0xFF, 0x70, 0x0C, 0x8A, 0xEF, 0xFF, 0x21, 0xFF, 0xFF,
+    0x30, 0x0B, 0x84, 0xCF, 0xFF, 0xC0, 0x0B, 0x8B, 0x3F, 0xFF, 0xC0, 0x0B, 0xFF, 0xF7, 0x0A, 0x80,
+    0x20, 0x44, 0x80, 0x20, 0x0A, 0x8B, 0x8F, 0xFF, 0x70, 0x06, 0xFF, 0xFC, 0x0A, 0x80, 0x70, 0x44,
+    0x80, 0x70, 0x0A, 0x8C, 0xCF, 0xFF, 0x20, 0x02, 0xFF, 0xFF, 0x10, 0x09, 0x80, 0xC0, 0x44, 0x80,
+    0xC0, 0x09, 0x8D, 0x2F, 0xFF, 0xD0, 0x00, 0x0C, 0xFF, 0xF6, 0x08, 0x88, 0x2F, 0xFF, 0x9F, 0xFF,
+    0x20, 0x08, 0x8D, 0x6F, 0xFF, 0x80, 0x00, 0x07, 0xFF, 0xFA, 0x08, 0x88, 0x7F, 0xFD, 0x2F, 0xFF,
+    0x70, 0x08, 0x8D, 0xBF, 0xFF, 0x30, 0x00, 0x03, 0xFF, 0xFE, 0x08, 0x88, 0xCF, 0xF8, 0x0C, 0xFF,
+    0xC0, 0x07, 0x84, 0x1F, 0xFF, 0xE0, 0x05, 0x84, 0xDF, 0xFF, 0x40, 0x06, 0x8A, 0x3F, 0xFF, 0x30,
+    0x7F, 0xFF, 0x20, 0x06, 0x84, 0x5F, 0xFF, 0x90, 0x05, 0x84, 0x8F, 0xFF, 0x80, 0x06, 0x8A, 0x8F,
+    0xFD, 0x00, 0x2F, 0xFF, 0x70, 0x06, 0x84, 0x9F, 0xFF, 0x40, 0x05, 0x84, 0x4F, 0xFF, 0xD0, 0x06,
+    0x8A, 0xDF, 0xF8, 0x00, 0x0C, 0xFF, 0xC0, 0x06, 0x83, 0xEF, 0xFE, 0x07, 0x84, 0xEF, 0xFF, 0x20,
+    0x04, 0x8C, 0x3F, 0xFF, 0x30, 0x00, 0x7F, 0xFF, 0x20, 0x04, 0x84, 0x3F, 0xFF, 0xA0, 0x07, 0x84,
+    0x9F, 0xFF, 0x70, 0x04, 0x8C, 0x8F, 0xFD, 0x00, 0x00, 0x2F, 0xFF, 0x70, 0x04, 0x84, 0x8F, 0xFF,
+    0x50, 0x07, 0x84, 0x5F, 0xFF, 0xB0, 0x04, 0x83, 0xDF, 0xF8, 0x04, 0x83, 0xCF, 0xFC, 0x04, 0x84,
+    0xCF, 0xFF, 0x10, 0x07, 0x8D, 0x1E, 0xFF, 0xF1, 0x00, 0x03, 0xFF, 0xF3, 0x04, 0x8C, 0x7F, 0xFF,
+    0x30, 0x00, 0x2F, 0xFF, 0xB0, 0x09, 0x8B, 0xAF, 0xFF, 0x50, 0x00, 0x8F, 0xFD, 0x05, 0x8C, 0x2F,
+    0xFF, 0x80, 0x00, 0x6F, 0xFF, 0x60, 0x09, 0x8B, 0x6F, 0xFF, 0xA0, 0x00, 0xDF, 0xF8, 0x06, 0x8B,
+    0xCF, 0xFD, 0x00, 0x0B, 0xFF, 0xF2, 0x09, 0x8B, 0x1F, 0xFF, 0xE0, 0x03, 0xFF, 0xF3, 0x06, 0x8A,
+    0x7F, 0xFF, 0x30, 0x1E, 0xFF, 0xC0, 0x0B, 0x89, 0xBF, 0xFF, 0x40, 0x8F, 0xFD, 0x07, 0x8A, 0x2F,
+    0xFF, 0x80, 0x4F, 0xFF, 0x70, 0x0B, 0x89, 0x6F, 0xFF, 0x80, 0xDF, 0xF8, 0x08, 0x89, 0xCF, 0xFD,
+    0x09, 0xFF, 0xF3, 0x0B, 0x89, 0x2F, 0xFF, 0xC3, 0xFF, 0xF3, 0x08, 0x88, 0x7F, 0xFF, 0x3D, 0xFF,
+    0xD0, 0x0D, 0x87, 0xCF, 0xFF, 0x8F, 0xFD, 0x09, 0x88, 0x2F, 0xFF, 0x8F, 0xFF, 0x80, 0x0D, 0x87,
+    0x7F, 0xFF, 0xEF, 0xF8, 0x0A, 0x87, 0xCF, 0xFE, 0xFF, 0xF4, 0x0D, 0x80, 0x30, 0x45, 0x80, 0x30,
+    0x0A, 0x80, 0x70, 0x44, 0x80, 0xE0, 0x0F, 0x85, 0xDF, 0xFF, 0xFD, 0x0B, 0x80, 0x20, 0x44, 0x80,
+    0x90, 0x0F, 0x85, 0x8F, 0xFF, 0xF8, 0x0C, 0x85, 0xCF, 0xFF, 0xF4, 0x0F, 0x85, 0x4F, 0xFF, 0xF3,
+    0x0C, 0x84, 0x7F, 0xFF, 0xE0, 0x11, 0x83, 0xEF, 0xFD, 0x0D, 0x84, 0x2F, 0xFF, 0xA0, 0x08, 0x85,
+    0x1A, 0xAA, 0xA3, 0x0D, 0x8C, 0x3A, 0xAA, 0x90, 0x08, 0xFF, 0xFD, 0x10, 0x0B, 0x8D, 0x1D, 0xFF,
+    0xF4, 0x00, 0x0C, 0xFF, 0xF9, 0x0B, 0x8E, 0x8F, 0xFF, 0x90, 0x00, 0x03, 0xFF, 0xFF, 0x40, 0x09,
+    0x85, 0x4F, 0xFF, 0xD1, 0x04, 0x84, 0x7F, 0xFF, 0xD0, 0x08, 0x85, 0x1D, 0xFF, 0xF3, 0x06, 0x84,
+    0xCF, 0xFF, 0x80, 0x07, 0x84, 0x9F, 0xFF, 0x80, 0x07, 0x85, 0x3F, 0xFF, 0xF3, 0x05, 0x84, 0x4F,
+    0xFF, 0xC0, 0x09, 0x84, 0x7F, 0xFF, 0xC0, 0x04, 0x85, 0x1D, 0xFF, 0xF3, 0x0A, 0x8D, 0xCF, 0xFF,
+    0x70, 0x00, 0x09, 0xFF, 0xF7, 0x0B, 0x8C, 0x2E, 0xFF, 0xF2, 0x00, 0x4F, 0xFF, 0xB0, 0x0D, 0x8B,
+    0x6F, 0xFF, 0xC0, 0x1D, 0xFF, 0xE2, 0x0E, 0x89, 0xBF, 0xFF, 0x79, 0xFF, 0xF6, 0x0F, 0x88, 0x2E,
+    0xFF, 0xEF, 0xFF, 0xA0, 0x11, 0x80, 0x60, 0x44, 0x81, 0xE1, 0x11, 0x80, 0x10, 0x44, 0x80, 0xC0,
+    0x12, 0x80, 0xA0, 0x45, 0x80, 0x80, 0x10, 0x89, 0x5F, 0xFF, 0xBE, 0xFF, 0xF3, 0x0E, 0x8A, 0x1E,
+    0xFF, 0xE2, 0x6F, 0xFF, 0xC0, 0x0E, 0x8B, 0xAF, 0xFF, 0x70, 0x0C, 0xFF, 0xF7, 0x0C, 0x8D, 0x5F,
+    0xFF, 0xC0, 0x00, 0x2F, 0xFF, 0xF2, 0x0A, 0x8E, 0x1E, 0xFF, 0xE2, 0x00, 0x00, 0x7F, 0xFF, 0xC0,
+    0x0A, 0x84, 0xAF, 0xFF, 0x70, 0x05, 0x84, 0xDF, 0xFF, 0x70, 0x08, 0x84, 0x5F, 0xFF, 0xC0, 0x06,
+    0x85, 0x3F, 0xFF, 0xE2, 0x06, 0x85, 0x2E, 0xFF, 0xE2, 0x07, 0x84, 0x9F, 0xFF, 0xC0, 0x06, 0x84,
+    0xBF, 0xFF, 0x70, 0x08, 0x85, 0x1D, 0xFF, 0xF7, 0x04, 0x84, 0x6F, 0xFF, 0xC0, 0x0A, 0x8E, 0x5F,
+    0xFF, 0xE2, 0x00, 0x02, 0xEF, 0xFE, 0x20, 0x0B, 0x8C, 0xAF, 0xFF, 0xB0, 0x00, 0xBF, 0xFF, 0x70,
+    0x0C, 0x8B, 0x1E, 0xFF, 0xF6, 0x06, 0xFF, 0xFB, 0x0E, 0x85, 0x5F, 0xFF, 0xE2, 0x84, 0x7A, 0xAA,
+    0x40, 0x0E, 0x8A, 0x2A, 0xAA, 0x92, 0xFF, 0xFE, 0x20, 0x0D, 0x8A, 0xDF, 0xFF, 0x50, 0x8F, 0xFF,
+    0xA0, 0x0C, 0x8C, 0x7F, 0xFF, 0xB0, 0x01, 0xDF, 0xFF, 0x40, 0x0A, 0x8D, 0x1E, 0xFF, 0xF2, 0x00,
+    0x05, 0xFF, 0xFC, 0x0A, 0x84, 0x9F, 0xFF, 0x80, 0x04, 0x84, 0xBF, 0xFF, 0x60, 0x08, 0x84, 0x3F,
+    0xFF, 0xD0, 0x05, 0x85, 0x2E, 0xFF, 0xE1, 0x07, 0x84, 0xCF, 0xFF, 0x40, 0x06, 0x84, 0x7F, 0xFF,
+    0x90, 0x06, 0x84, 0x6F, 0xFF, 0xA0, 0x08, 0x84, 0xDF, 0xFF, 0x30, 0x04, 0x85, 0x1E, 0xFF, 0xE2,
+    0x08, 0x84, 0x4F, 0xFF, 0xB0, 0x04, 0x84, 0x8F, 0xFF, 0x70, 0x0A, 0x8C, 0xAF, 0xFF, 0x50, 0x00,
+    0x2F, 0xFF, 0xC0, 0x0B, 0x8C, 0x2E, 0xFF, 0xD1, 0x00, 0xBF, 0xFF, 0x40, 0x0C, 0x8A, 0x7F, 0xFF,
+    0x80, 0x5F, 0xFF, 0x90, 0x0E, 0x89, 0xCF, 0xFE, 0x1C, 0xFF, 0xE1, 0x0E, 0x88, 0x3F, 0xFF, 0xAF,
+    0xFF, 0x60, 0x10, 0x80, 0x90, 0x44, 0x80, 0xC0, 0x11, 0x86, 0x1E, 0xFF, 0xFF, 0x30, 0x12, 0x84,
+    0x7F, 0xFF, 0x90, 0x13, 0x84, 0x5F, 0xFF, 0x80, 0x13, 0x84, 0x5F, 0xFF, 0x80, 0x13, 0x84, 0x5F,
+    0xFF, 0x80, 0x13, 0x84, 0x5F, 0xFF, 0x80, 0x13, 0x84, 0x5F, 0xFF, 0x80, 0x13, 0x84, 0x5F, 0xFF,
+    0x80, 0x13, 0x84, 0x5F, 0xFF, 0x80, 0x13, 0x84, 0x5F, 0xFF, 0x80, 0x13, 0x84, 0x5F, 0xFF, 0x80,
+    0x13, 0x84, 0x5F, 0xFF, 0x80, 0x13, 0x84, 0x5F, 0xFF, 0x80, 0x09, 0x98, 0x05, 0xAA, 0xAA, 0xAA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x50, 0x80, 0x53, 0x82, 0x70, 0x80, 0x53, 0x96, 0x40,
+    0x48, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0x88, 0xEF, 0xFF, 0xB0, 0x10, 0x85, 0x6F, 0xFF, 0xE1,
+    0x0F, 0x85, 0x2E, 0xFF, 0xF4, 0x10, 0x84, 0xCF, 0xFF, 0x90, 0x10, 0x84, 0x8F, 0xFF, 0xC0, 0x10,
+    0x85, 0x3F, 0xFF, 0xF3, 0x0F, 0x85, 0x1D, 0xFF, 0xF7, 0x10, 0x84, 0xAF, 0xFF, 0xB0, 0x10, 0x85,
+    0x5F, 0xFF, 0xE1, 0x0F, 0x85, 0x2E, 0xFF, 0xF5, 0x10, 0x84, 0xBF, 0xFF, 0x90, 0x10, 0x85, 0x7F,
+    0xFF, 0xD1, 0x0F, 0x85, 0x3F, 0xFF, 0xF3, 0x0F, 0x85, 0x1D, 0xFF, 0xF7, 0x10, 0x84, 0x9F, 0xFF,
+    0xB0, 0x10, 0x85, 0x5F, 0xFF, 0xE2, 0x0F, 0x85, 0x2E, 0xFF, 0xF5, 0x10, 0x84, 0xBF, 0xFF, 0x90,
+    0x10, 0x85, 0x7F, 0xFF, 0xD1, 0x0F, 0x85, 0x3F, 0xFF, 0xF3, 0x0F, 0x85, 0x1D, 0xFF, 0xF7, 0x10,
+    0x84, 0x9F, 0xFF, 0xB0, 0x10, 0x97, 0x5F, 0xFF, 0xF4, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33, 0x33,
+    0x30, 0x1E, 0x53, 0x81, 0x24, 0x54, 0x81, 0x24, 0x54, 0x80, 0x20, 0x89, 0x2A, 0xAA, 0xAA, 0xAA,
+    0x22, 0x46, 0x8D, 0x32, 0xFF, 0xEA, 0xAA, 0x91, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83,
+    0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83,
+    0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83,
+    0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83,
+    0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83,
+    0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83,
+    0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83,
+    0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83, 0x2F, 0xFD, 0x04, 0x83,
+    0x2F, 0xFD, 0x04, 0x89, 0x2F, 0xFE, 0x88, 0x88, 0x02, 0x46, 0x89, 0x32, 0xBB, 0xBB, 0xBB, 0xB2,
+    0x83, 0x27, 0x61, 0x0B, 0x83, 0x1E, 0xFC, 0x0C, 0x83, 0x9F, 0xF4, 0x0B, 0x83, 0x3F, 0xFA, 0x0C,
+    0x83, 0xCF, 0xF1, 0x0B, 0x83, 0x6F, 0xF7, 0x0B, 0x83, 0x1E, 0xFD, 0x0C, 0x83, 0x9F, 0xF4, 0x0B,
+    0x83, 0x3F, 0xFA, 0x0C, 0x83, 0xCF, 0xF1, 0x0B, 0x83, 0x6F, 0xF7, 0x0B, 0x83, 0x1E, 0xFD, 0x0C,
+    0x83, 0x9F, 0xF4, 0x0B, 0x83, 0x3F, 0xFA, 0x0C, 0x83, 0xCF, 0xF1, 0x0B, 0x83, 0x6F, 0xF7, 0x0B,
+    0x83, 0x1E, 0xFD, 0x0C, 0x83, 0x9F, 0xF4, 0x0B, 0x83, 0x3F, 0xFA, 0x0C, 0x83, 0xCF, 0xF1, 0x0B,
+    0x83, 0x6F, 0xF7, 0x0B, 0x83, 0x1E, 0xFD, 0x0C, 0x83, 0x9F, 0xF4, 0x0B, 0x83, 0x3F, 0xFA, 0x0C,
+    0x83, 0xCF, 0xF2, 0x0B, 0x83, 0x6F, 0xF7, 0x0B, 0x83, 0x1E, 0xFD, 0x0C, 0x83, 0x9F, 0xF4, 0x0B,
+    0x83, 0x3F, 0xFA, 0x0C, 0x83, 0xCF, 0xF2, 0x0B, 0x83, 0x6F, 0xF7, 0x0C, 0x82, 0x8C, 0xA0, 0x89,
+    0x2A, 0xAA, 0xAA, 0xAA, 0x23, 0x46, 0x89, 0x20, 0x9A, 0xAA, 0xEF, 0xF2, 0x04, 0x83, 0xDF, 0xF2,
+    0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2,
+    0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2,
+    0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2,
+    0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2,
+    0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2,
+    0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2,
+    0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2, 0x04, 0x83, 0xDF, 0xF2,
+    0x04, 0x83, 0xDF, 0xF2, 0x04, 0x8D, 0xDF, 0xF2, 0x07, 0x88, 0x8E, 0xFF, 0x23, 0x46, 0x89, 0x22,
+    0xBB, 0xBB, 0xBB, 0xB2, 0x06, 0x82, 0x9A, 0x80, 0x0C, 0x84, 0x5F, 0xFF, 0x40, 0x0B, 0x84, 0xDF,
+    0xFF, 0xC0, 0x0A, 0x80, 0x60, 0x44, 0x80, 0x60, 0x08, 0x88, 0x1E, 0xFF, 0x7F, 0xFD, 0x10, 0x07,
+    0x88, 0x8F, 0xFC, 0x0B, 0xFF, 0x70, 0x06, 0x8A, 0x2F, 0xFF, 0x40, 0x3F, 0xFE, 0x10, 0x05, 0x8A,
+    0xAF, 0xFA, 0x00, 0x09, 0xFF, 0x90, 0x04, 0x94, 0x3F, 0xFF, 0x20, 0x00, 0x1E, 0xFF, 0x20, 0x00,
+    0x0B, 0xFF, 0x90, 0x04, 0x8B, 0x7F, 0xFA, 0x00, 0x05, 0xFF, 0xE1, 0x04, 0x8A, 0x1D, 0xFF, 0x40,
+    0x0D, 0xFF, 0x70, 0x06, 0x89, 0x6F, 0xFC, 0x06, 0xFF, 0xD1, 0x07, 0x87, 0xCF, 0xF5, 0x34, 0x41,
+    0x08, 0x83, 0x14, 0x43, 0x8F, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xA8, 0x4E, 0x90, 0xBA,
+    0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0xAA, 0x80, 0x98, 0x1C, 0xFF, 0xE6, 0x00, 0x00, 0x1C, 0xFF,
+    0xE2, 0x00, 0x00, 0x2D, 0xFF, 0xB0, 0x04, 0x84, 0x2E, 0xFF, 0x50, 0x04, 0x84, 0x3E, 0xFD, 0x10,
+    0x04, 0x83, 0x4B, 0xB5, 0x05, 0x86, 0x36, 0x89, 0x97, 0x20, 0x07, 0x81, 0x6D, 0x46, 0x87, 0xA1,
+    0x00, 0x00, 0x2B, 0x49, 0x99, 0xD1, 0x00, 0x1D, 0xFF, 0xFD, 0x74, 0x46, 0xCF, 0xFF, 0xA0, 0x00,
+    0xAF, 0xE6, 0x05, 0x89, 0xBF, 0xFF, 0x30, 0x01, 0x51, 0x06, 0x84, 0x2F, 0xFF, 0x70, 0x0C, 0x83,
+    0xDF, 0xFA, 0x0C, 0x83, 0xBF, 0xFC, 0x0C, 0x83, 0xBF, 0xFC, 0x08, 0x87, 0x23, 0x45, 0xCF, 0xFC,
+    0x04, 0x83, 0x37, 0xBE, 0x46, 0x85, 0xC0, 0x00, 0x4C, 0x46, 0x9C, 0xEE, 0xFF, 0xC0, 0x08, 0xFF,
+    0xFE, 0xA6, 0x31, 0x00, 0xAF, 0xFC, 0x06, 0xFF, 0xF8, 0x10, 0x05, 0x88, 0xAF, 0xFC, 0x0D, 0xFF,
+    0x90, 0x07, 0x88, 0xAF, 0xFC, 0x2F, 0xFF, 0x40, 0x07, 0x88, 0xAF, 0xFC, 0x2F, 0xFF, 0x50, 0x06,
+    0x89, 0x3E, 0xFF, 0xC0, 0xEF, 0xFB, 0x05, 0x99, 0x5E, 0xFF, 0xFC, 0x09, 0xFF, 0xFB, 0x53, 0x46,
+    0xCF, 0xFA, 0xFF, 0xC0, 0x1D, 0x47, 0x89, 0xD3, 0x3F, 0xFC, 0x00, 0x1A, 0x44, 0x90, 0xD7, 0x10,
+    0x0C, 0xFC, 0x00, 0x00, 0x14, 0x54, 0x20, 0x07, 0x83, 0x67, 0x74, 0x0D, 0x83, 0xEF, 0xF9, 0x0D,
+    0x83, 0xEF, 0xF9, 0x0D, 0x83, 0xEF, 0xF9, 0x0D, 0x83, 0xEF, 0xF9, 0x0D, 0x83, 0xEF, 0xF9, 0x0D,
+    0x83, 0xEF, 0xF9, 0x0D, 0x83, 0xEF, 0xF9, 0x0D, 0x83, 0xEF, 0xF9, 0x0D, 0x8C, 0xEF, 0xF9, 0x00,
+    0x02, 0x68, 0x87, 0x40, 0x04, 0x86, 0xEF, 0xF9, 0x02, 0xA0, 0x45, 0x8A, 0xD4, 0x00, 0x0E, 0xFF,
+    0x94, 0xE0, 0x48, 0x9A, 0x50, 0x0E, 0xFF, 0xCF, 0xFC, 0x74, 0x47, 0xCF, 0xFF, 0xF3, 0x0E, 0xFF,
+    0xFF, 0x60, 0x05, 0x8A, 0x9F, 0xFF, 0xB0, 0xEF, 0xFF, 0x50, 0x07, 0x88, 0xCF, 0xFF, 0x2E, 0xFF,
+    0xA0, 0x08, 0x88, 0x6F, 0xFF, 0x6E, 0xFF, 0x90, 0x08, 0x88, 0x1F, 0xFF, 0xAE, 0xFF, 0x90, 0x09,
+    0x87, 0xDF, 0xFC, 0xEF, 0xF9, 0x09, 0x87, 0xCF, 0xFD, 0xEF, 0xF9, 0x09, 0x87, 0xBF, 0xFE, 0xEF,
+    0xF9, 0x09, 0x87, 0xCF, 0xFD, 0xEF, 0xF9, 0x09, 0x87, 0xDF, 0xFC, 0xEF, 0xF9, 0x08, 0x88, 0x1F,
+    0xFF, 0xAE, 0xFF, 0x90, 0x08, 0x88, 0x4F, 0xFF, 0x7E, 0xFF, 0x90, 0x08, 0x89, 0xAF, 0xFF, 0x2E,
+    0xFF, 0xD1, 0x06, 0x8B, 0x5F, 0xFF, 0xA0, 0xEF, 0xFF, 0xC3, 0x04, 0x9D, 0x5E, 0xFF, 0xF2, 0x0E,
+    0xFF, 0xDF, 0xFB, 0x88, 0x9D, 0xFF, 0xFF, 0x60, 0x0E, 0xFF, 0x58, 0x47, 0x92, 0xE5, 0x00, 0x0E,
+    0xFE, 0x20, 0x5C, 0xFF, 0xFF, 0xE9, 0x20, 0x0A, 0x83, 0x24, 0x43, 0x06, 0x05, 0x87, 0x15, 0x78,
+    0x87, 0x41, 0x06, 0x82, 0x19, 0xE0, 0x45, 0x88, 0xE8, 0x10, 0x00, 0x03, 0xE0, 0x49, 0x99, 0xD3,
+    0x00, 0x3E, 0xFF, 0xFC, 0x64, 0x35, 0x9E, 0xFF, 0x50, 0x0D, 0xFF, 0xF7, 0x05, 0x89, 0x1A, 0x80,
+    0x06, 0xFF, 0xF8, 0x0B, 0x84, 0xCF, 0xFE, 0x10, 0x0A, 0x84, 0x2F, 0xFF, 0x90, 0x0B, 0x84, 0x5F,
+    0xFF, 0x50, 0x0B, 0x84, 0x7F, 0xFF, 0x30, 0x0B, 0x84, 0x8F, 0xFF, 0x20, 0x0B, 0x84, 0x8F, 0xFF,
+    0x20, 0x0B, 0x84, 0x7F, 0xFF, 0x40, 0x0B, 0x84, 0x4F, 0xFF, 0x60, 0x0B, 0x84, 0x1F, 0xFF, 0xA0,
+    0x0C, 0x84, 0xBF, 0xFF, 0x20, 0x0B, 0x84, 0x5F, 0xFF, 0xB0, 0x07, 0x8A, 0x36, 0x00, 0x0B, 0xFF,
+    0xFA, 0x10, 0x04, 0x99, 0x7F, 0xF6, 0x00, 0x1D, 0xFF, 0xFE, 0xA8, 0x89, 0xEF, 0xFF, 0x90, 0x00,
+    0x2C, 0x49, 0x80, 0x70, 0x05, 0x81, 0x6C, 0x44, 0x82, 0xD8, 0x20, 0x08, 0x84, 0x13, 0x43, 0x10,
+    0x04, 0x0D, 0x84, 0x27, 0x77, 0x20, 0x0D, 0x84, 0x4F, 0xFF, 0x50, 0x0D, 0x84, 0x4F, 0xFF, 0x50,
+    0x0D, 0x84, 0x4F, 0xFF, 0x50, 0x0D, 0x84, 0x4F, 0xFF, 0x50, 0x0D, 0x84, 0x4F, 0xFF, 0x50, 0x0D,
+    0x84, 0x4F, 0xFF, 0x50, 0x0D, 0x84, 0x4F, 0xFF, 0x50, 0x0D, 0x84, 0x4F, 0xFF, 0x50, 0x05, 0x92,
+    0x37, 0x99, 0x85, 0x00, 0x4F, 0xFF, 0x50, 0x00, 0x03, 0xC0, 0x45, 0x8A, 0xD5, 0x4F, 0xFF, 0x50,
+    0x00, 0x60, 0x49, 0x91, 0xAF, 0xFF, 0x50, 0x04, 0xFF, 0xFF, 0xA5, 0x33, 0x5A, 0x44, 0x87, 0x50,
+    0x1E, 0xFF, 0xF5, 0x05, 0x8B, 0x4E, 0xFF, 0xF5, 0x07, 0xFF, 0xF7, 0x07, 0x89, 0x6F, 0xFF, 0x50,
+    0xDF, 0xFD, 0x08, 0x89, 0x4F, 0xFF, 0x52, 0xFF, 0xF8, 0x08, 0x89, 0x4F, 0xFF, 0x55, 0xFF, 0xF5,
+    0x08, 0x89, 0x4F, 0xFF, 0x57, 0xFF, 0xF3, 0x08, 0x89, 0x4F, 0xFF, 0x58, 0xFF, 0xF2, 0x08, 0x89,
+    0x4F, 0xFF, 0x58, 0xFF, 0xF2, 0x08, 0x89, 0x4F, 0xFF, 0x58, 0xFF, 0xF3, 0x08, 0x89, 0x4F, 0xFF,
+    0x56, 0xFF, 0xF5, 0x08, 0x89, 0x4F, 0xFF, 0x53, 0xFF, 0xF8, 0x08, 0x89, 0x4F, 0xFF, 0x50, 0xEF,
+    0xFD, 0x08, 0x8A, 0x7F, 0xFF, 0x50, 0xAF, 0xFF, 0x60, 0x06, 0x92, 0x5F, 0xFF, 0xF5, 0x03, 0xFF,
+    0xFE, 0x50, 0x00, 0x01, 0x80, 0x44, 0x97, 0x50, 0x09, 0xFF, 0xFF, 0xDA, 0x9B, 0xEF, 0xF5, 0xFF,
+    0xF5, 0x00, 0x0A, 0x47, 0x99, 0xE4, 0x0D, 0xFF, 0x50, 0x00, 0x06, 0xDF, 0xFF, 0xFE, 0x81, 0x00,
+    0x9F, 0xF5, 0x05, 0x83, 0x24, 0x42, 0x08, 0x05, 0x86, 0x15, 0x78, 0x87, 0x40, 0x09, 0x82, 0x19,
+    0xE0, 0x45, 0x81, 0xD5, 0x06, 0x81, 0x3E, 0x49, 0x80, 0x90, 0x04, 0x97, 0x3E, 0xFF, 0xE8, 0x31,
+    0x13, 0x9F, 0xFF, 0x80, 0x00, 0x1D, 0xFF, 0xD2, 0x05, 0x8B, 0x5F, 0xFF, 0x30, 0x07, 0xFF, 0xF3,
+    0x07, 0x89, 0x9F, 0xFA, 0x00, 0xDF, 0xFA, 0x08, 0x89, 0x3F, 0xFE, 0x02, 0xFF, 0xF5, 0x09, 0x97,
+    0xEF, 0xF3, 0x5F, 0xFF, 0x65, 0x55, 0x55, 0x55, 0x55, 0x5E, 0xFF, 0x57, 0x50, 0x97, 0x58, 0xFF,
+    0xFD, 0xDD, 0xDD, 0xDD, 0xDD, 0xDD, 0xDD, 0xD3, 0x7F, 0xFF, 0x0E, 0x84, 0x6F, 0xFF, 0x20, 0x0D,
+    0x84, 0x3F, 0xFF, 0x50, 0x0E, 0x83, 0xEF, 0xF9, 0x0E, 0x84, 0xAF, 0xFF, 0x20, 0x0D, 0x84, 0x3F,
+    0xFF, 0xB0, 0x08, 0x8B, 0x26, 0x00, 0x00, 0x9F, 0xFF, 0xC2, 0x04, 0x97, 0x28, 0xFF, 0x90, 0x00,
+    0x0B, 0xFF, 0xFF, 0xC9, 0x89, 0xBF, 0xFF, 0xFB, 0x04, 0x80, 0x90, 0x4A, 0x80, 0x80, 0x06, 0x82,
+    0x3A, 0xE0, 0x44, 0x82, 0xD8, 0x20, 0x0A, 0x84, 0x24, 0x43, 0x10, 0x05, 0x09, 0x81, 0x11, 0x07,
+    0x87, 0x17, 0xCF, 0xFF, 0xD2, 0x04, 0x81, 0x2D, 0x45, 0x97, 0x20, 0x00, 0x01, 0xDF, 0xFF, 0xEB,
+    0xA9, 0x10, 0x00, 0x08, 0xFF, 0xF8, 0x08, 0x83, 0xEF, 0xFB, 0x08, 0x84, 0x2F, 0xFF, 0x60, 0x08,
+    0x84, 0x4F, 0xFF, 0x30, 0x08, 0x84, 0x4F, 0xFF, 0x30, 0x08, 0x84, 0x4F, 0xFF, 0x30, 0x05, 0x8E,
+    0x6D, 0xDE, 0xFF, 0xFD, 0xDD, 0xDD, 0xD1, 0x70, 0x4B, 0x96, 0x11, 0x7A, 0xCF, 0xFF, 0xCB, 0xBB,
+    0xBB, 0x00, 0x00, 0x4F, 0xFF, 0x40, 0x08, 0x84, 0x4F, 0xFF, 0x40, 0x08, 0x84, 0x4F, 0xFF, 0x40,
+    0x08, 0x84, 0x4F, 0xFF, 0x40, 0x08, 0x84, 0x4F, 0xFF, 0x40, 0x08, 0x84, 0x4F, 0xFF, 0x40, 0x08,
+    0x84, 0x4F, 0xFF, 0x40, 0x08, 0x84, 0x4F, 0xFF, 0x40, 0x08, 0x84, 0x4F, 0xFF, 0x40, 0x08, 0x84,
+    0x4F, 0xFF, 0x40, 0x08, 0x84, 0x4F, 0xFF, 0x40, 0x08, 0x84, 0x4F, 0xFF, 0x40, 0x08, 0x84, 0x4F,
+    0xFF, 0x40, 0x08, 0x84, 0x4F, 0xFF, 0x40, 0x08, 0x84, 0x4F, 0xFF, 0x40, 0x08, 0x84, 0x4F, 0xFF,
+    0x40, 0x08, 0x84, 0x4F, 0xFF, 0x40, 0x05, 0x04, 0x86, 0x15, 0x89, 0x97, 0x30, 0x09, 0x81, 0x2A,
+    0x46, 0x8A, 0xD7, 0x77, 0x77, 0x50, 0x03, 0xE0, 0x4D, 0x99, 0xC0, 0x1D, 0xFF, 0xE6, 0x10, 0x03,
+    0xAF, 0xFF, 0xFE, 0xB6, 0x07, 0xFF, 0xE2, 0x05, 0x8B, 0x9F, 0xFD, 0x00, 0x00, 0xCF, 0xF9, 0x06,
+    0x8B, 0x1F, 0xFF, 0x30, 0x00, 0xEF, 0xF6, 0x07, 0x8A, 0xDF, 0xF5, 0x00, 0x0E, 0xFF, 0x60, 0x07,
+    0x8A, 0xDF, 0xF5, 0x00, 0x0B, 0xFF, 0x90, 0x06, 0x8C, 0x1F, 0xFF, 0x20, 0x00, 0x6F, 0xFE, 0x20,
+    0x05, 0x83, 0x9F, 0xFC, 0x04, 0x8D, 0xCF, 0xFE, 0x51, 0x00, 0x2A, 0xFF, 0xF4, 0x04, 0x8C, 0x2D,
+    0xFF, 0xFF, 0xEE, 0xFF, 0xFF, 0x60, 0x06, 0x81, 0x3E, 0x46, 0x81, 0xB3, 0x06, 0x89, 0x4E, 0xF8,
+    0x36, 0x76, 0x51, 0x07, 0x83, 0x1E, 0xFD, 0x0E, 0x84, 0x4F, 0xFD, 0x10, 0x0D, 0x8B, 0x4F, 0xFF,
+    0xE9, 0x65, 0x44, 0x31, 0x07, 0x80, 0xD0, 0x49, 0x89, 0xEB, 0x71, 0x00, 0x00, 0x2D, 0x4B, 0x9A,
+    0xE3, 0x00, 0x3C, 0xFE, 0x66, 0x88, 0x9A, 0xBE, 0xFF, 0xFF, 0xD0, 0x3E, 0xFD, 0x20, 0x07, 0x89,
+    0x3B, 0xFF, 0xF4, 0xBF, 0xF5, 0x09, 0x88, 0x1F, 0xFF, 0x5E, 0xFF, 0x20, 0x0A, 0x87, 0xFF, 0xF4,
+    0xEF, 0xF5, 0x09, 0x89, 0x5F, 0xFE, 0x0A, 0xFF, 0xE4, 0x07, 0x9B, 0x5E, 0xFF, 0x60, 0x2E, 0xFF,
+    0xFC, 0x86, 0x55, 0x69, 0xDF, 0xFF, 0x90, 0x00, 0x3D, 0x4A, 0x81, 0xE7, 0x05, 0x82, 0x5B, 0xE0,
+    0x45, 0x82, 0xC7, 0x10, 0x09, 0x85, 0x24, 0x54, 0x31, 0x06, 0x84, 0x17, 0x77, 0x30, 0x0C, 0x84,
+    0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F,
+    0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x84, 0x1F, 0xFF,
+    0x70, 0x0C, 0x84, 0x1F, 0xFF, 0x70, 0x0C, 0x99, 0x1F, 0xFF, 0x70, 0x00, 0x37, 0x88, 0x73, 0x00,
+    0x00, 0x1F, 0xFF, 0x70, 0x4C, 0x45, 0x89, 0xB2, 0x00, 0x1F, 0xFF, 0x77, 0x48, 0x9B, 0xD2, 0x01,
+    0xFF, 0xFD, 0xFF, 0xC7, 0x44, 0x7D, 0xFF, 0xFB, 0x01, 0xFF, 0xFF, 0xE5, 0x04, 0x8B, 0x1C, 0xFF,
+    0xF3, 0x1F, 0xFF, 0xD2, 0x06, 0x89, 0x4F, 0xFF, 0x71, 0xFF, 0xF7, 0x08, 0x88, 0xEF, 0xFA, 0x1F,
+    0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFB, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70,
+    0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88,
+    0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC,
+    0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF,
+    0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08,
+    0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x83, 0xCF,
+    0xFC, 0xA2, 0x00, 0x12, 0x00, 0x08, 0xFF, 0xB1, 0x3F, 0xFF, 0xF7, 0x6F, 0xFF, 0xFA, 0x2F, 0xFF,
+    0xF6, 0x04, 0xCD, 0x70, 0x13, 0xBF, 0x34, 0x43, 0x00, 0xAF, 0xFD, 0x00, 0xAF, 0xFD, 0x00, 0xAF,
+    0xFD, 0x00, 0xAF, 0xFD, 0x00, 0xAF, 0xFD, 0x00, 0xAF, 0xFD, 0x00, 0xAF, 0xFD, 0x00, 0xAF, 0xFD,
+    0x00, 0xAF, 0xFD, 0x00, 0xAF, 0xFD, 0xBC, 0x00, 0xAF, 0xFD, 0x00, 0xAF, 0xFD, 0x00, 0xAF, 0xFD,
+    0x00, 0xAF, 0xFD, 0x00, 0xAF, 0xFD, 0x00, 0xAF, 0xFD, 0x00, 0xAF, 0xFD, 0x00, 0xAF, 0xFD, 0x00,
+    0xAF, 0xFD, 0x00, 0xAF, 0xFD, 0x00, 0x05, 0x81, 0x12, 0x06, 0xA2, 0x8F, 0xFB, 0x10, 0x00, 0x03,
+    0xFF, 0xFF, 0x70, 0x00, 0x06, 0xFF, 0xFF, 0xA0, 0x00, 0x02, 0xFF, 0xFF, 0x60, 0x04, 0x83, 0x4C,
+    0xD7, 0x23, 0x83, 0x34, 0x43, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF,
+    0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF,
+    0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF,
+    0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF,
+    0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF,
+    0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xAF, 0xFD, 0x05, 0x83, 0xCF,
+    0xFC, 0x04, 0x90, 0x2F, 0xFF, 0x90, 0x06, 0x78, 0xEF, 0xFF, 0x40, 0x00, 0x45, 0x91, 0x90, 0x01,
+    0xFF, 0xFF, 0xE7, 0x00, 0x00, 0x14, 0x43, 0x04, 0x83, 0x67, 0x74, 0x0D, 0x83, 0xEF, 0xF9, 0x0D,
+    0x83, 0xEF, 0xF9, 0x0D, 0x83, 0xEF, 0xF9, 0x0D, 0x83, 0xEF, 0xF9, 0x0D, 0x83, 0xEF, 0xF9, 0x0D,
+    0x83, 0xEF, 0xF9, 0x0D, 0x83, 0xEF, 0xF9, 0x0D, 0x83, 0xEF, 0xF9, 0x0D, 0x83, 0xEF, 0xF9, 0x08,
+    0x88, 0x44, 0x43, 0x0E, 0xFF, 0x90, 0x06, 0x8A, 0x1C, 0xFF, 0xE3, 0x0E, 0xFF, 0x90, 0x05, 0x8B,
+    0x1B, 0xFF, 0xE3, 0x00, 0xEF, 0xF9, 0x05, 0x8B, 0xBF, 0xFF, 0x40, 0x00, 0xEF, 0xF9, 0x04, 0x95,
+    0xAF, 0xFF, 0x50, 0x00, 0x0E, 0xFF, 0x90, 0x00, 0x09, 0xFF, 0xF5, 0x04, 0x8B, 0xEF, 0xF9, 0x00,
+    0x08, 0xFF, 0xF6, 0x05, 0x8A, 0xEF, 0xF9, 0x00, 0x7F, 0xFF, 0x70, 0x06, 0x89, 0xEF, 0xFA, 0x27,
+    0xFF, 0xF8, 0x07, 0x80, 0xE0, 0x46, 0x80, 0x90, 0x08, 0x80, 0xE0, 0x46, 0x81, 0xE2, 0x07, 0x89,
+    0xEF, 0xFB, 0x57, 0xFF, 0xFC, 0x07, 0x8A, 0xEF, 0xF9, 0x00, 0x7F, 0xFF, 0x90, 0x06, 0x8B, 0xEF,
+    0xF9, 0x00, 0x0A, 0xFF, 0xF6, 0x05, 0x8C, 0xEF, 0xF9, 0x00, 0x01, 0xCF, 0xFF, 0x30, 0x04, 0x95,
+    0xEF, 0xF9, 0x00, 0x00, 0x2E, 0xFF, 0xD1, 0x00, 0x00, 0xEF, 0xF9, 0x04, 0x8C, 0x4F, 0xFF, 0xB0,
+    0x00, 0x0E, 0xFF, 0x90, 0x05, 0x8B, 0x7F, 0xFF, 0x80, 0x00, 0xEF, 0xF9, 0x06, 0x8A, 0xAF, 0xFF,
+    0x50, 0x0E, 0xFF, 0x90, 0x06, 0x8A, 0x1C, 0xFF, 0xE3, 0x0E, 0xFF, 0x90, 0x07, 0x85, 0x2D, 0xFF,
+    0xD1, 0xBF, 0x47, 0x76, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD,
+    0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD,
+    0xAF, 0xFD, 0xB7, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF,
+    0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0xAF, 0xFD, 0x8C,
+    0x04, 0x42, 0x00, 0x01, 0x68, 0x86, 0x10, 0x05, 0x90, 0x47, 0x88, 0x61, 0x00, 0x00, 0x1F, 0xFE,
+    0x00, 0x80, 0x44, 0x86, 0xE4, 0x00, 0x05, 0xE0, 0x45, 0x89, 0x80, 0x00, 0x1F, 0xFF, 0x2B, 0x47,
+    0x82, 0x30, 0x70, 0x48, 0xB1, 0xA0, 0x01, 0xFF, 0xFD, 0xFE, 0x84, 0x48, 0xEF, 0xFB, 0x4F, 0xFD,
+    0x74, 0x59, 0xFF, 0xFF, 0x50, 0x1F, 0xFF, 0xFB, 0x10, 0x00, 0x03, 0xEF, 0xFD, 0xFA, 0x04, 0x8B,
+    0x4F, 0xFF, 0xC0, 0x1F, 0xFF, 0xC1, 0x05, 0x85, 0x9F, 0xFF, 0xE1, 0x05, 0x89, 0x9F, 0xFF, 0x21,
+    0xFF, 0xF7, 0x06, 0x84, 0x4F, 0xFF, 0x90, 0x06, 0x89, 0x5F, 0xFF, 0x41, 0xFF, 0xF7, 0x06, 0x84,
+    0x3F, 0xFF, 0x60, 0x06, 0x89, 0x3F, 0xFF, 0x51, 0xFF, 0xF7, 0x06, 0x84, 0x2F, 0xFF, 0x60, 0x06,
+    0x89, 0x3F, 0xFF, 0x61, 0xFF, 0xF7, 0x06, 0x84, 0x2F, 0xFF, 0x60, 0x06, 0x89, 0x3F, 0xFF, 0x61,
+    0xFF, 0xF7, 0x06, 0x84, 0x2F, 0xFF, 0x60, 0x06, 0x89, 0x3F, 0xFF, 0x61, 0xFF, 0xF7, 0x06, 0x84,
+    0x2F, 0xFF, 0x60, 0x06, 0x89, 0x3F, 0xFF, 0x61, 0xFF, 0xF7, 0x06, 0x84, 0x2F, 0xFF, 0x60, 0x06,
+    0x89, 0x3F, 0xFF, 0x61, 0xFF, 0xF7, 0x06, 0x84, 0x2F, 0xFF, 0x60, 0x06, 0x89, 0x3F, 0xFF, 0x61,
+    0xFF, 0xF7, 0x06, 0x84, 0x2F, 0xFF, 0x60, 0x06, 0x89, 0x3F, 0xFF, 0x61, 0xFF, 0xF7, 0x06, 0x84,
+    0x2F, 0xFF, 0x60, 0x06, 0x89, 0x3F, 0xFF, 0x61, 0xFF, 0xF7, 0x06, 0x84, 0x2F, 0xFF, 0x60, 0x06,
+    0x89, 0x3F, 0xFF, 0x61, 0xFF, 0xF7, 0x06, 0x84, 0x2F, 0xFF, 0x60, 0x06, 0x89, 0x3F, 0xFF, 0x61,
+    0xFF, 0xF7, 0x06, 0x84, 0x2F, 0xFF, 0x60, 0x06, 0x89, 0x3F, 0xFF, 0x61, 0xFF, 0xF7, 0x06, 0x84,
+    0x2F, 0xFF, 0x60, 0x06, 0x89, 0x3F, 0xFF, 0x61, 0xFF, 0xF7, 0x06, 0x84, 0x2F, 0xFF, 0x60, 0x06,
+    0x84, 0x3F, 0xFF, 0x60, 0x99, 0x04, 0x42, 0x00, 0x00, 0x37, 0x88, 0x73, 0x00, 0x00, 0x1F, 0xFE,
+    0x00, 0x4C, 0x45, 0x89, 0xB2, 0x00, 0x1F, 0xFF, 0x27, 0x48, 0x9B, 0xD2, 0x01, 0xFF, 0xFB, 0xFF,
+    0xC7, 0x44, 0x7D, 0xFF, 0xFB, 0x01, 0xFF, 0xFF, 0xE5, 0x04, 0x8B, 0x1C, 0xFF, 0xF3, 0x1F, 0xFF,
+    0xD2, 0x06, 0x89, 0x4F, 0xFF, 0x71, 0xFF, 0xF7, 0x08, 0x88, 0xEF, 0xFA, 0x1F, 0xFF, 0x70, 0x08,
+    0x88, 0xCF, 0xFB, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF,
+    0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F,
+    0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70,
+    0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88,
+    0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC,
+    0x1F, 0xFF, 0x70, 0x08, 0x88, 0xCF, 0xFC, 0x1F, 0xFF, 0x70, 0x08, 0x83, 0xCF, 0xFC, 0x05, 0x87,
+    0x14, 0x78, 0x87, 0x51, 0x09, 0x82, 0x18, 0xE0, 0x46, 0x81, 0xA2, 0x06, 0x81, 0x3D, 0x4A, 0x80,
+    0x60, 0x04, 0x98, 0x3E, 0xFF, 0xFB, 0x64, 0x45, 0xAF, 0xFF, 0xF6, 0x00, 0x00, 0xDF, 0xFF, 0x50,
+    0x05, 0x8C, 0x3E, 0xFF, 0xE2, 0x00, 0x7F, 0xFF, 0x70, 0x07, 0x8A, 0x4F, 0xFF, 0xA0, 0x0D, 0xFF,
+    0xD0, 0x09, 0x89, 0xAF, 0xFF, 0x12, 0xFF, 0xF8, 0x09, 0x89, 0x5F, 0xFF, 0x56, 0xFF, 0xF5, 0x09,
+    0x89, 0x2F, 0xFF, 0x97, 0xFF, 0xF3, 0x0A, 0x88, 0xFF, 0xFA, 0x8F, 0xFF, 0x20, 0x0A, 0x88, 0xEF,
+    0xFB, 0x8F, 0xFF, 0x20, 0x0A, 0x88, 0xEF, 0xFB, 0x7F, 0xFF, 0x30, 0x0A, 0x88, 0xFF, 0xFA, 0x5F,
+    0xFF, 0x50, 0x09, 0x89, 0x2F, 0xFF, 0x81, 0xFF, 0xF9, 0x09, 0x8A, 0x6F, 0xFF, 0x40, 0xBF, 0xFE,
+    0x10, 0x08, 0x8A, 0xCF, 0xFE, 0x00, 0x5F, 0xFF, 0xA0, 0x07, 0x8D, 0x6F, 0xFF, 0x80, 0x00, 0xAF,
+    0xFF, 0x91, 0x04, 0x98, 0x7F, 0xFF, 0xD1, 0x00, 0x01, 0xCF, 0xFF, 0xEA, 0x88, 0xAD, 0xFF, 0xFE,
+    0x30, 0x04, 0x81, 0x1A, 0x49, 0x81, 0xC2, 0x07, 0x82, 0x4A, 0xE0, 0x44, 0x81, 0xC6, 0x0C, 0x84,
+    0x34, 0x43, 0x10, 0x06, 0x8D, 0x04, 0x42, 0x00, 0x00, 0x37, 0x99, 0x74, 0x04, 0x87, 0x1F, 0xFE,
+    0x00, 0x3C, 0x45, 0x8A, 0xC3, 0x00, 0x01, 0xFF, 0xF2, 0x60, 0x49, 0x9C, 0x40, 0x01, 0xFF, 0xF9,
+    0xFF, 0xB6, 0x44, 0x7D, 0xFF, 0xFE, 0x10, 0x1F, 0xFF, 0xFE, 0x50, 0x05, 0x8B, 0xAF, 0xFF, 0x90,
+    0x1F, 0xFF, 0xE3, 0x06, 0x8A, 0x1E, 0xFF, 0xE1, 0x1F, 0xFF, 0x80, 0x08, 0x89, 0x8F, 0xFF, 0x41,
+    0xFF, 0xF7, 0x08, 0x89, 0x3F, 0xFF, 0x81, 0xFF, 0xF7, 0x08, 0x89, 0x1F, 0xFF, 0xA1, 0xFF, 0xF7,
+    0x09, 0x88, 0xEF, 0xFB, 0x1F, 0xFF, 0x70, 0x09, 0x88, 0xEF, 0xFC, 0x1F, 0xFF, 0x70, 0x09, 0x88,
+    0xEF, 0xFB, 0x1F, 0xFF, 0x70, 0x09, 0x88, 0xFF, 0xFA, 0x1F, 0xFF, 0x70, 0x08, 0x89, 0x2F, 0xFF,
+    0x81, 0xFF, 0xF7, 0x08, 0x89, 0x6F, 0xFF, 0x41, 0xFF, 0xF7, 0x08, 0x89, 0xCF, 0xFE, 0x11, 0xFF,
+    0xFC, 0x07, 0x8C, 0x7F, 0xFF, 0x80, 0x1F, 0xFF, 0xFB, 0x20, 0x04, 0x87, 0x7F, 0xFF, 0xE1, 0x01,
+    0x45, 0x91, 0xB8, 0x89, 0xDF, 0xFF, 0xF4, 0x00, 0x1F, 0xFF, 0x9C, 0x47, 0xA3, 0xE4, 0x00, 0x01,
+    0xFF, 0xF7, 0x07, 0xEF, 0xFF, 0xFE, 0x81, 0x00, 0x00, 0x1F, 0xFF, 0x70, 0x00, 0x24, 0x42, 0x06,
+    0x84, 0x1F, 0xFF, 0x70, 0x0D, 0x84, 0x1F, 0xFF, 0x70, 0x0D, 0x84, 0x1F, 0xFF, 0x70, 0x0D, 0x84,
+    0x1F, 0xFF, 0x70, 0x0D, 0x84, 0x1F, 0xFF, 0x70, 0x0D, 0x84, 0x1D, 0xDD, 0x60, 0x0D, 0x05, 0x92,
+    0x37, 0x99, 0x85, 0x00, 0x01, 0x44, 0x10, 0x00, 0x03, 0xC0, 0x45, 0x8A, 0xD5, 0x0B, 0xFF, 0x50,
+    0x00, 0x60, 0x49, 0x91, 0x7E, 0xFF, 0x50, 0x04, 0xFF, 0xFF, 0xA5, 0x33, 0x5A, 0x44, 0x87, 0x50,
+    0x1E, 0xFF, 0xF5, 0x05, 0x8B, 0x4E, 0xFF, 0xF5, 0x07, 0xFF, 0xF7, 0x07, 0x89, 0x6F, 0xFF, 0x50,
+    0xDF, 0xFD, 0x08, 0x89, 0x4F, 0xFF, 0x52, 0xFF, 0xF8, 0x08, 0x89, 0x4F, 0xFF, 0x55, 0xFF, 0xF5,
+    0x08, 0x89, 0x4F, 0xFF, 0x57, 0xFF, 0xF3, 0x08, 0x89, 0x4F, 0xFF, 0x58, 0xFF, 0xF2, 0x08, 0x89,
+    0x4F, 0xFF, 0x58, 0xFF, 0xF2, 0x08, 0x89, 0x4F, 0xFF, 0x58, 0xFF, 0xF3, 0x08, 0x89, 0x4F, 0xFF,
+    0x56, 0xFF, 0xF5, 0x08, 0x89, 0x4F, 0xFF, 0x53, 0xFF, 0xF8, 0x08, 0x89, 0x4F, 0xFF, 0x50, 0xEF,
+    0xFD, 0x08, 0x8A, 0x7F, 0xFF, 0x50, 0xAF, 0xFF, 0x60, 0x06, 0x92, 0x5F, 0xFF, 0xF5, 0x03, 0xFF,
+    0xFE, 0x50, 0x00, 0x01, 0x80, 0x44, 0x97, 0x50, 0x09, 0xFF, 0xFF, 0xDA, 0x9B, 0xEF, 0xF8, 0xFF,
+    0xF5, 0x00, 0x0A, 0x47, 0x99, 0xE4, 0x4F, 0xFF, 0x50, 0x00, 0x06, 0xDF, 0xFF, 0xFE, 0x81, 0x04,
+    0xFF, 0xF5, 0x05, 0x8C, 0x24, 0x42, 0x00, 0x00, 0x4F, 0xFF, 0x50, 0x0D, 0x84, 0x4F, 0xFF, 0x50,
+    0x0D, 0x84, 0x4F, 0xFF, 0x50, 0x0D, 0x84, 0x4F, 0xFF, 0x50, 0x0D, 0x84, 0x4F, 0xFF, 0x50, 0x0D,
+    0x84, 0x4F, 0xFF, 0x50, 0x0D, 0x84, 0x3D, 0xDD, 0x40, 0x95, 0x04, 0x42, 0x00, 0x00, 0x48, 0x98,
+    0x40, 0x1F, 0xFE, 0x00, 0x3C, 0x44, 0x87, 0x21, 0xFF, 0xF2, 0x3E, 0x45, 0xA3, 0x01, 0xFF, 0xF4,
+    0xDF, 0xFF, 0xDE, 0xFC, 0x01, 0xFF, 0xFB, 0xFE, 0x51, 0x00, 0x22, 0x01, 0xFF, 0xFF, 0xE2, 0x06,
+    0x85, 0x1F, 0xFF, 0xF4, 0x07, 0x84, 0x1F, 0xFF, 0xB0, 0x08, 0x84, 0x1F, 0xFF, 0x70, 0x08, 0x84,
+    0x1F, 0xFF, 0x70, 0x08, 0x84, 0x1F, 0xFF, 0x70, 0x08, 0x84, 0x1F, 0xFF, 0x70, 0x08, 0x84, 0x1F,
+    0xFF, 0x70, 0x08, 0x84, 0x1F, 0xFF, 0x70, 0x08, 0x84, 0x1F, 0xFF, 0x70, 0x08, 0x84, 0x1F, 0xFF,
+    0x70, 0x08, 0x84, 0x1F, 0xFF, 0x70, 0x08, 0x84, 0x1F, 0xFF, 0x70, 0x08, 0x84, 0x1F, 0xFF, 0x70,
+    0x08, 0x84, 0x1F, 0xFF, 0x70, 0x08, 0x84, 0x1F, 0xFF, 0x70, 0x08, 0x04, 0x85, 0x47, 0x88, 0x74,
+    0x06, 0x81, 0x6E, 0x45, 0x86, 0xE8, 0x10, 0x00, 0xA0, 0x49, 0x95, 0xD2, 0x06, 0xFF, 0xFB, 0x52,
+    0x13, 0x8E, 0xFD, 0x00, 0xDF, 0xFA, 0x05, 0x88, 0x17, 0x30, 0x2F, 0xFF, 0x30, 0x09, 0x84, 0x3F,
+    0xFF, 0x30, 0x09, 0x85, 0x1F, 0xFF, 0xB1, 0x09, 0x86, 0xBF, 0xFF, 0xE7, 0x20, 0x07, 0x81, 0x2E,
+    0x44, 0x82, 0xC7, 0x20, 0x05, 0x81, 0x2B, 0x46, 0x81, 0xA2, 0x05, 0x82, 0x39, 0xE0, 0x45, 0x80,
+    0x50, 0x07, 0x87, 0x49, 0xEF, 0xFF, 0xE2, 0x08, 0x85, 0x1A, 0xFF, 0xF7, 0x0A, 0x83, 0xDF, 0xFA,
+    0x0A, 0x83, 0xAF, 0xF9, 0x0A, 0x87, 0xDF, 0xF7, 0x1D, 0xD5, 0x05, 0x95, 0x7F, 0xFF, 0x28, 0xFF,
+    0xFC, 0x64, 0x46, 0xBF, 0xFF, 0x80, 0x2C, 0x49, 0x86, 0x90, 0x00, 0x05, 0xB0, 0x45, 0x81, 0xB4,
+    0x06, 0x85, 0x13, 0x55, 0x31, 0x04, 0x04, 0x82, 0xAC, 0x80, 0x09, 0x83, 0x1F, 0xFA, 0x09, 0x83,
+    0x3F, 0xFA, 0x09, 0x83, 0x5F, 0xFA, 0x09, 0x83, 0x7F, 0xFA, 0x09, 0x83, 0x9F, 0xFA, 0x09, 0x83,
+    0xBF, 0xFA, 0x05, 0x8E, 0x18, 0xAC, 0xFF, 0xFE, 0xDD, 0xDD, 0xD6, 0x20, 0x4B, 0x96, 0x70, 0xAB,
+    0xBF, 0xFF, 0xEB, 0xBB, 0xBB, 0x50, 0x00, 0x0E, 0xFF, 0xA0, 0x09, 0x83, 0xEF, 0xFA, 0x09, 0x83,
+    0xEF, 0xFA, 0x09, 0x83, 0xEF, 0xFA, 0x09, 0x83, 0xEF, 0xFA, 0x09, 0x83, 0xEF, 0xFA, 0x09, 0x83,
+    0xEF, 0xFA, 0x09, 0x83, 0xEF, 0xFA, 0x09, 0x83, 0xEF, 0xFA, 0x09, 0x83, 0xEF, 0xFA, 0x09, 0x83,
+    0xEF, 0xFA, 0x09, 0x83, 0xEF, 0xFA, 0x09, 0x83, 0xEF, 0xFA, 0x09, 0x88, 0xCF, 0xFE, 0x20, 0x02,
+    0x70, 0x04, 0x8F, 0x8F, 0xFF, 0xEA, 0xAE, 0xF5, 0x00, 0x00, 0x1E, 0x46, 0x80, 0xB0, 0x04, 0x88,
+    0x2C, 0xFF, 0xFF, 0xE7, 0x10, 0x06, 0x86, 0x24, 0x53, 0x00, 0x00, 0x83, 0x24, 0x44, 0x08, 0x88,
+    0x14, 0x44, 0x18, 0xFF, 0xF0, 0x08, 0x88, 0x4F, 0xFF, 0x58, 0xFF, 0xF0, 0x08, 0x88, 0x4F, 0xFF,
+    0x58, 0xFF, 0xF0, 0x08, 0x88, 0x4F, 0xFF, 0x58, 0xFF, 0xF0, 0x08, 0x88, 0x4F, 0xFF, 0x58, 0xFF,
+    0xF0, 0x08, 0x88, 0x4F, 0xFF, 0x58, 0xFF, 0xF0, 0x08, 0x88, 0x4F, 0xFF, 0x58, 0xFF, 0xF0, 0x08,
+    0x88, 0x4F, 0xFF, 0x58, 0xFF, 0xF0, 0x08, 0x88, 0x4F, 0xFF, 0x58, 0xFF, 0xF0, 0x08, 0x88, 0x4F,
+    0xFF, 0x58, 0xFF, 0xF0, 0x08, 0x88, 0x4F, 0xFF, 0x58, 0xFF, 0xF0, 0x08, 0x88, 0x4F, 0xFF, 0x58,
+    0xFF, 0xF0, 0x08, 0x88, 0x4F, 0xFF, 0x58, 0xFF, 0xF0, 0x08, 0x89, 0x4F, 0xFF, 0x58, 0xFF, 0xF1,
+    0x07, 0x89, 0x4F, 0xFF, 0x56, 0xFF, 0xF3, 0x07, 0x89, 0x5F, 0xFF, 0x53, 0xFF, 0xF9, 0x06, 0x8B,
+    0x3D, 0xFF, 0xF5, 0x0D, 0xFF, 0xF6, 0x04, 0x9B, 0x7E, 0xFF, 0xFF, 0x50, 0x5F, 0xFF, 0xFC, 0x98,
+    0xAE, 0xFF, 0x8F, 0xFF, 0x50, 0x08, 0x48, 0x8A, 0x60, 0xDF, 0xF5, 0x00, 0x05, 0xD0, 0x44, 0x87,
+    0xA2, 0x00, 0x9F, 0xF5, 0x04, 0x84, 0x24, 0x53, 0x10, 0x07, 0x83, 0x24, 0x43, 0x0B, 0x88, 0x14,
+    0x44, 0x5F, 0xFF, 0x50, 0x0A, 0x88, 0xBF, 0xFC, 0x0E, 0xFF, 0xC0, 0x09, 0x8A, 0x2F, 0xFF, 0x60,
+    0x8F, 0xFF, 0x30, 0x08, 0x8A, 0x8F, 0xFE, 0x10, 0x2F, 0xFF, 0x90, 0x08, 0x8A, 0xEF, 0xF9, 0x00,
+    0x0A, 0xFF, 0xE0, 0x07, 0x8C, 0x5F, 0xFF, 0x20, 0x00, 0x4F, 0xFF, 0x50, 0x06, 0x83, 0xBF, 0xFB,
+    0x04, 0x83, 0xDF, 0xFB, 0x05, 0x84, 0x2F, 0xFF, 0x50, 0x04, 0x84, 0x7F, 0xFF, 0x20, 0x04, 0x83,
+    0x8F, 0xFE, 0x05, 0x84, 0x1F, 0xFF, 0x80, 0x04, 0x83, 0xEF, 0xF8, 0x06, 0x8C, 0xAF, 0xFE, 0x00,
+    0x00, 0x5F, 0xFF, 0x20, 0x06, 0x8B, 0x4F, 0xFF, 0x50, 0x00, 0xBF, 0xFB, 0x08, 0x8A, 0xDF, 0xFB,
+    0x00, 0x2F, 0xFF, 0x50, 0x08, 0x89, 0x7F, 0xFF, 0x20, 0x8F, 0xFD, 0x09, 0x89, 0x1E, 0xFF, 0x80,
+    0xEF, 0xF7, 0x0A, 0x88, 0x9F, 0xFD, 0x4F, 0xFF, 0x20, 0x0A, 0x87, 0x3F, 0xFF, 0x9F, 0xFA, 0x0C,
+    0x80, 0xC0, 0x44, 0x80, 0x40, 0x0C, 0x85, 0x6F, 0xFF, 0xFD, 0x0D, 0x85, 0x1E, 0xFF, 0xF7, 0x0E,
+    0x84, 0x9F, 0xFF, 0x10, 0x06, 0x83, 0x34, 0x42, 0x09, 0x82, 0x45, 0x30, 0x09, 0x88, 0x34, 0x41,
+    0x7F, 0xFF, 0x30, 0x07, 0x84, 0x5F, 0xFF, 0x30, 0x07, 0x89, 0x5F, 0xFF, 0x22, 0xFF, 0xF7, 0x07,
+    0x84, 0xAF, 0xFF, 0x80, 0x07, 0x89, 0xAF, 0xFC, 0x00, 0xCF, 0xFC, 0x06, 0x85, 0x1F, 0xFF, 0xFD,
+    0x07, 0x8A, 0xEF, 0xF7, 0x00, 0x8F, 0xFF, 0x10, 0x05, 0x80, 0x50, 0x44, 0x80, 0x30, 0x05, 0x8B,
+    0x4F, 0xFF, 0x20, 0x03, 0xFF, 0xF6, 0x05, 0x86, 0xAF, 0xFA, 0xFF, 0x80, 0x05, 0x8B, 0x8F, 0xFD,
+    0x00, 0x00, 0xDF, 0xFA, 0x04, 0x87, 0x1E, 0xFE, 0x3F, 0xFC, 0x05, 0x8B, 0xDF, 0xF8, 0x00, 0x00,
+    0x8F, 0xFE, 0x04, 0xAF, 0x5F, 0xF9, 0x0D, 0xFF, 0x20, 0x00, 0x03, 0xFF, 0xF3, 0x00, 0x00, 0x3F,
+    0xFF, 0x40, 0x00, 0x0A, 0xFF, 0x40, 0x9F, 0xF7, 0x00, 0x00, 0x7F, 0xFD, 0x05, 0x98, 0xDF, 0xF8,
+    0x00, 0x00, 0xEF, 0xE0, 0x04, 0xFF, 0xC0, 0x00, 0x0C, 0xFF, 0x80, 0x05, 0x98, 0x8F, 0xFD, 0x00,
+    0x05, 0xFF, 0x90, 0x00, 0xEF, 0xF2, 0x00, 0x1F, 0xFF, 0x30, 0x05, 0x97, 0x4F, 0xFF, 0x20, 0x0A,
+    0xFF, 0x40, 0x00, 0x9F, 0xF6, 0x00, 0x6F, 0xFD, 0x07, 0x96, 0xEF, 0xF7, 0x00, 0xEF, 0xE0, 0x00,
+    0x04, 0xFF, 0xB0, 0x0A, 0xFF, 0x90, 0x07, 0x88, 0x9F, 0xFB, 0x04, 0xFF, 0x90, 0x04, 0x88, 0xEF,
+    0xF1, 0x0E, 0xFF, 0x40, 0x07, 0x88, 0x4F, 0xFF, 0x19, 0xFF, 0x40, 0x04, 0x87, 0x9F, 0xF6, 0x4F,
+    0xFE, 0x09, 0x86, 0xEF, 0xF4, 0xEF, 0xE0, 0x05, 0x87, 0x4F, 0xFA, 0x8F, 0xF9, 0x09, 0x86, 0x9F,
+    0xFA, 0xFF, 0x90, 0x06, 0x86, 0xEF, 0xEC, 0xFF, 0x40, 0x09, 0x80, 0x40, 0x44, 0x80, 0x40, 0x06,
+    0x85, 0xAF, 0xFF, 0xFE, 0x0B, 0x84, 0xEF, 0xFF, 0xE0, 0x07, 0x85, 0x5F, 0xFF, 0xF9, 0x0B, 0x84,
+    0xAF, 0xFF, 0x90, 0x07, 0x85, 0x1E, 0xFF, 0xF5, 0x0B, 0x84, 0x5F, 0xFF, 0x40, 0x08, 0x83, 0x9F,
+    0xFE, 0x06, 0x84, 0x04, 0x44, 0x30, 0x09, 0x8A, 0x24, 0x44, 0x10, 0xAF, 0xFF, 0x60, 0x07, 0x8C,
+    0x1E, 0xFF, 0xB0, 0x01, 0xDF, 0xFE, 0x20, 0x06, 0x8C, 0xAF, 0xFE, 0x20, 0x00, 0x4F, 0xFF, 0xB0,
+    0x05, 0x84, 0x5F, 0xFF, 0x50, 0x04, 0x8D, 0x8F, 0xFF, 0x50, 0x00, 0x02, 0xEF, 0xF9, 0x05, 0x8D,
+    0x1D, 0xFF, 0xE1, 0x00, 0x0B, 0xFF, 0xD1, 0x06, 0x8B, 0x3F, 0xFF, 0xA0, 0x06, 0xFF, 0xF4, 0x08,
+    0x89, 0x7F, 0xFF, 0x52, 0xEF, 0xF8, 0x0A, 0x87, 0xCF, 0xFE, 0xAF, 0xFC, 0x0B, 0x87, 0x2E, 0xFF,
+    0xFF, 0xE2, 0x0C, 0x85, 0x8F, 0xFF, 0xFA, 0x0C, 0x81, 0x1D, 0x44, 0x80, 0x30, 0x0B, 0x87, 0x9F,
+    0xFD, 0xDF, 0xFC, 0x0A, 0x89, 0x5F, 0xFF, 0x65, 0xFF, 0xF8, 0x08, 0x8B, 0x1E, 0xFF, 0xB0, 0x0A,
+    0xFF, 0xF3, 0x07, 0x8B, 0xAF, 0xFE, 0x20, 0x01, 0xEF, 0xFD, 0x06, 0x8D, 0x5F, 0xFF, 0x60, 0x00,
+    0x06, 0xFF, 0xF8, 0x04, 0x84, 0x2E, 0xFF, 0xA0, 0x05, 0x8D, 0xBF, 0xFF, 0x30, 0x00, 0x0B, 0xFF,
+    0xE1, 0x05, 0x8C, 0x2E, 0xFF, 0xD1, 0x00, 0x6F, 0xFF, 0x50, 0x07, 0x8A, 0x7F, 0xFF, 0x80, 0x2E,
+    0xFF, 0x90, 0x09, 0x84, 0xBF, 0xFF, 0x40, 0x83, 0x24, 0x43, 0x0B, 0x88, 0x14, 0x44, 0x6F, 0xFF,
+    0x70, 0x0A, 0x88, 0xBF, 0xFC, 0x0E, 0xFF, 0xD0, 0x09, 0x8A, 0x2F, 0xFF, 0x60, 0x8F, 0xFF, 0x50,
+    0x08, 0x8A, 0x8F, 0xFE, 0x10, 0x1F, 0xFF, 0xB0, 0x07, 0x8C, 0x1E, 0xFF, 0x80, 0x00, 0xAF, 0xFF,
+    0x30, 0x06, 0x8C, 0x6F, 0xFF, 0x20, 0x00, 0x3F, 0xFF, 0x90, 0x06, 0x83, 0xCF, 0xFA, 0x04, 0x84,
+    0xBF, 0xFE, 0x10, 0x04, 0x84, 0x3F, 0xFF, 0x40, 0x04, 0x84, 0x5F, 0xFF, 0x70, 0x04, 0x83, 0x9F,
+    0xFC, 0x06, 0x8C, 0xDF, 0xFD, 0x00, 0x00, 0x1E, 0xFF, 0x60, 0x06, 0x8C, 0x7F, 0xFF, 0x40, 0x00,
+    0x7F, 0xFE, 0x10, 0x06, 0x8B, 0x1E, 0xFF, 0xB0, 0x00, 0xDF, 0xF8, 0x08, 0x8A, 0x9F, 0xFF, 0x20,
+    0x4F, 0xFF, 0x20, 0x08, 0x89, 0x2F, 0xFF, 0x80, 0xAF, 0xFA, 0x0A, 0x88, 0xAF, 0xFE, 0x2F, 0xFF,
+    0x40, 0x0A, 0x87, 0x4F, 0xFF, 0xBF, 0xFC, 0x0C, 0x80, 0xC0, 0x44, 0x80, 0x60, 0x0C, 0x85, 0x6F,
+    0xFF, 0xFE, 0x0E, 0x84, 0xEF, 0xFF, 0x80, 0x0E, 0x84, 0x8F, 0xFF, 0x20, 0x0E, 0x83, 0xAF, 0xFA,
+    0x0E, 0x84, 0x2F, 0xFF, 0x30, 0x0E, 0x83, 0x9F, 0xFC, 0x0E, 0x84, 0x1E, 0xFF, 0x50, 0x0E, 0x83,
+    0x8F, 0xFE, 0x0E, 0x84, 0x1E, 0xFF, 0x70, 0x0E, 0x84, 0x7F, 0xFF, 0x10, 0x0E, 0x83, 0xBD, 0xD7,
+    0x0A, 0x91, 0x04, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x00, 0x4E, 0x81, 0x10, 0x4E, 0x90,
+    0x10, 0x88, 0x88, 0x88, 0x88, 0x88, 0xAF, 0xFF, 0x90, 0x0B, 0x84, 0xCF, 0xFD, 0x10, 0x0A, 0x84,
+    0x8F, 0xFE, 0x30, 0x0A, 0x84, 0x5F, 0xFF, 0x60, 0x0A, 0x84, 0x2E, 0xFF, 0xA0, 0x0B, 0x84, 0xCF,
+    0xFD, 0x10, 0x0A, 0x84, 0x8F, 0xFE, 0x30, 0x0A, 0x84, 0x5F, 0xFF, 0x60, 0x0A, 0x84, 0x2E, 0xFF,
+    0xA0, 0x0B, 0x84, 0xCF, 0xFD, 0x10, 0x0A, 0x84, 0x8F, 0xFE, 0x30, 0x0A, 0x84, 0x5F, 0xFF, 0x60,
+    0x0A, 0x84, 0x2E, 0xFF, 0xA0, 0x0B, 0x84, 0xCF, 0xFD, 0x10, 0x0A, 0x84, 0x8F, 0xFE, 0x30, 0x0A,
+    0x91, 0x4F, 0xFF, 0xEB, 0xBB, 0xBB, 0xBB, 0xBB, 0xB7, 0x09, 0x4D, 0x82, 0xA0, 0x90, 0x4D, 0x81,
+    0xA0, 0x05, 0xA2, 0x48, 0x9A, 0x20, 0x00, 0x03, 0xCF, 0xFF, 0xF4, 0x00, 0x02, 0xEF, 0xFE, 0xBA,
+    0x10, 0x00, 0xBF, 0xFB, 0x10, 0x04, 0x84, 0x2F, 0xFF, 0x20, 0x05, 0x83, 0x5F, 0xFC, 0x06, 0x83,
+    0x6F, 0xFB, 0x06, 0x83, 0x6F, 0xFB, 0x06, 0x83, 0x4F, 0xFD, 0x06, 0x83, 0x2F, 0xFF, 0x07, 0x83,
+    0xEF, 0xF2, 0x06, 0x83, 0xBF, 0xF5, 0x06, 0x83, 0x8F, 0xF7, 0x06, 0x83, 0x6F, 0xF9, 0x06, 0x83,
+    0x6F, 0xFA, 0x06, 0x83, 0x7F, 0xF8, 0x05, 0x8E, 0x1D, 0xFF, 0x30, 0x00, 0x01, 0x9E, 0xFF, 0x70,
+    0x04, 0x84, 0x2F, 0xFE, 0x50, 0x05, 0x85, 0x1A, 0xEF, 0xE5, 0x06, 0x84, 0x2E, 0xFF, 0x20, 0x06,
+    0x83, 0x8F, 0xF8, 0x06, 0x83, 0x6F, 0xF9, 0x06, 0x83, 0x6F, 0xF9, 0x06, 0x83, 0x8F, 0xF8, 0x06,
+    0x83, 0xBF, 0xF5, 0x06, 0x83, 0xDF, 0xF3, 0x05, 0x83, 0x1F, 0xFF, 0x06, 0x83, 0x4F, 0xFD, 0x06,
+    0x83, 0x5F, 0xFB, 0x06, 0x83, 0x6F, 0xFB, 0x06, 0x83, 0x5F, 0xFC, 0x06, 0x84, 0x2F, 0xFF, 0x10,
+    0x06, 0x83, 0xCF, 0xFA, 0x06, 0x92, 0x3F, 0xFF, 0xD9, 0x81, 0x00, 0x00, 0x4D, 0xFF, 0xFF, 0x40,
+    0x04, 0x85, 0x16, 0x9B, 0xB3, 0xBF, 0x4A, 0xA4, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5,
+    0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5,
+    0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0xBF, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F,
+    0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F,
+    0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x97, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5, 0x6F, 0xF5,
+    0x6F, 0xF5, 0x5D, 0xD5, 0x84, 0x2A, 0x98, 0x40, 0x05, 0x92, 0x4F, 0xFF, 0xFC, 0x30, 0x00, 0x01,
+    0xAB, 0xEF, 0xFE, 0x20, 0x05, 0x84, 0x1B, 0xFF, 0xB0, 0x06, 0x84, 0x2F, 0xFF, 0x20, 0x06, 0x83,
+    0xCF, 0xF5, 0x06, 0x83, 0xBF, 0xF6, 0x06, 0x83, 0xBF, 0xF6, 0x06, 0x83, 0xDF, 0xF4, 0x06, 0x83,
+    0xFF, 0xF2, 0x05, 0x83, 0x2F, 0xFE, 0x06, 0x83, 0x5F, 0xFB, 0x06, 0x83, 0x7F, 0xF8, 0x06, 0x83,
+    0x9F, 0xF6, 0x06, 0x83, 0xAF, 0xF6, 0x06, 0x83, 0x8F, 0xF7, 0x06, 0x84, 0x3F, 0xFD, 0x10, 0x06,
+    0x85, 0x7F, 0xFE, 0x91, 0x05, 0x84, 0x5E, 0xFF, 0x20, 0x04, 0x8E, 0x5E, 0xFE, 0xA1, 0x00, 0x00,
+    0x2F, 0xFE, 0x20, 0x05, 0x83, 0x8F, 0xF8, 0x06, 0x83, 0x9F, 0xF6, 0x06, 0x83, 0x9F, 0xF6, 0x06,
+    0x83, 0x8F, 0xF8, 0x06, 0x83, 0x5F, 0xFB, 0x06, 0x83, 0x3F, 0xFD, 0x07, 0x83, 0xFF, 0xF1, 0x06,
+    0x83, 0xDF, 0xF4, 0x06, 0x83, 0xBF, 0xF5, 0x06, 0x83, 0xBF, 0xF6, 0x06, 0x83, 0xCF, 0xF5, 0x05,
+    0x84, 0x1F, 0xFF, 0x20, 0x05, 0xA2, 0xAF, 0xFB, 0x00, 0x01, 0x89, 0xDF, 0xFE, 0x30, 0x00, 0x4F,
+    0xFF, 0xFD, 0x40, 0x00, 0x03, 0xBB, 0x96, 0x10, 0x04, 0x0F, 0x8A, 0x66, 0x50, 0x00, 0x03, 0x55,
+    0x20, 0x06, 0x98, 0x2F, 0xFC, 0x00, 0x5E, 0xFF, 0xFF, 0xC6, 0x10, 0x00, 0x08, 0xFF, 0x90, 0x50,
+    0x47, 0x90, 0xE9, 0x54, 0x9F, 0xFF, 0x51, 0xEF, 0xFE, 0xAA, 0xE0, 0x48, 0x8B, 0xC0, 0x6F, 0xFD,
+    0x10, 0x00, 0x5B, 0x45, 0x86, 0xC1, 0x09, 0xFF, 0x60, 0x05, 0x8C, 0x26, 0xAA, 0x95, 0x00, 0x08,
+    0xBB, 0x30, 0x0E,
+};
+
+#endif
@@ -11,21 +11,24 @@
  * @date 2025-12-04
  * 
  */
+#include <stddef.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <time.h>
-#include "font_5x8.h"
-#include "font_8x12.h"
+#include "font_aa_clock.h"
 #include <sys/time.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
+#include "esp_attr.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
 #include "esp_system.h"
-#include "esp_wifi.h"
-#include "esp_event.h"
-#include "esp_netif.h"
 #include "esp_sntp.h"
+#include "esp_pm.h"
+#include "esp_rom_crc.h"
+#include "nvs.h"
 #include "nvs_flash.h"
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
@@ -33,6 +36,10 @@
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_jd9853.h"
+#include "lcd_flush.h"
+#include "lcd_gfx.h"
+#include "timestamp.h"
+#include "wifi_sta.h"
 
 // Tag for logging
 static const char *TAG = "MAIN";
@@ -41,13 +48,28 @@ static const char *TAG = "MAIN";
 #define WIFI_SSID      "WIFI_SSID"
 #define WIFI_PASSWORD  "WIFI_PASSWORD"
 
-// WiFi event group
-#define WIFI_CONNECTED_BIT BIT0
-#define WIFI_FAIL_BIT      BIT1
-static EventGroupHandle_t wifi_event_group;
-static int wifi_retry_num = 0;
 #define MAX_WIFI_RETRY 5
 
+// Time sync event group
+#define TIME_SYNCED_BIT    BIT0
+static EventGroupHandle_t sync_event_group;
+
+// Low-power mode: WiFi only for SNTP, auto light-sleep, dimmed backlight
+#define LOW_POWER_MODE              0       // 1 to enable; needs CONFIG_PM_ENABLE and CONFIG_FREERTOS_USE_TICKLESS_IDLE
+#define LOW_POWER_SHOW_SECONDS      0       // 0 shows HH:MM and redraws once a minute
+#define LOW_POWER_RESYNC_HOURS      6       // WiFi is brought up this often to resync the time
+#define LOW_POWER_SYNC_TIMEOUT_S    30
+#define LOW_POWER_BACKLIGHT_DUTY    256     // Of 1024; dimmed level after the first sync
+#define LOW_POWER_FADE_MS           1500
+#define LOW_POWER_MIN_FREQ_MHZ      40      // CPU frequency when not sleeping and idle
+
+// Clock state kept across resets, so the time can be shown before WiFi is up
+#define CLOCK_STATE_MAGIC           0x434C4B31  // "CLK1"
+#define CLOCK_NVS_NAMESPACE         "clock"
+#define CLOCK_NVS_KEY               "state"
+#define CLOCK_DRIFT_MIN_INTERVAL_S  900     // Shorter sync intervals are dominated by SNTP jitter
+#define CLOCK_DRIFT_LIMIT_PPB       1000000 // Measurements beyond +/-1000 ppm are discarded
+
 // Pin definitions
 #define PIN_MOSI        2
 #define PIN_SCLK        1
@@ -97,41 +119,86 @@ static int wifi_retry_num = 0;
 
 #define FONT_8x5    1    
 #define FONT_8x12   2
-#define SELECTED_FONT FONT_8x5
+#define FONT_AA     3   // Anti-aliased proportional font from font_aa_clock.h; ignores FONT_SCALE
+#define SELECTED_FONT FONT_AA
 
 // Character width based on selected font
 #if SELECTED_FONT == FONT_8x5
     #define CHAR_WIDTH 5
     #define CHAR_HEIGHT 8
     #define LINE_SPACING 3
+    #define TEXT_HEIGHT (8 * FONT_SCALE)
+    #define TEXT_X_ADJUST (34 / 2)
 #elif SELECTED_FONT == FONT_8x12
     #define CHAR_WIDTH 8
     #define CHAR_HEIGHT 12
     #define LINE_SPACING 15
+    #define TEXT_HEIGHT (8 * FONT_SCALE)
+    #define TEXT_X_ADJUST (34 / 2)
+#elif SELECTED_FONT == FONT_AA
+    #define CHAR_WIDTH 5                        // Bitmap fallback only; AA glyph widths come from the font
+    #define CHAR_HEIGHT 8
+    #define LINE_SPACING 0                      // The line height already includes the font's leading
+    #define TEXT_HEIGHT FONT_AA_LINE_HEIGHT
+    #define TEXT_X_ADJUST 0                     // text_width() is exact, no centering correction needed
 #else
-    ESP_LOGE(TAG, "No font selected. Define SELECTED_FONT as FONT_8x5 or FONT_8x12.");
+    #error "No font selected. Define SELECTED_FONT as FONT_8x5, FONT_8x12 or FONT_AA."
 #endif 
 
+// Render layer settings
+#define RENDER_MAX_DIRTY     8                  // Dirty rectangles tracked between flushes
+#define RENDER_FLUSH_PIXELS  (LCD_WIDTH * 16)   // Pixels per DMA buffer; two are allocated
+#define RENDER_MERGE_SLACK   256                // Extra pixels worth sending to save one transaction
+
+// Glyph cache settings
+#if SELECTED_FONT == FONT_AA
+#define GLYPH_CACHE_SLOTS   0       // Bitmap fonts unused; AA text is decoded straight into text_line_buffer
+#else
+#define GLYPH_CACHE_SLOTS   20      // Distinct glyphs kept; the clock uses about 20
+#endif
+#define GLYPH_SLOT_PIXELS   (CHAR_WIDTH * CHAR_HEIGHT * FONT_SCALE * FONT_SCALE)  // Larger glyphs bypass the cache
+
 // Global handles
 static esp_lcd_panel_io_handle_t io_handle = NULL;
 static esp_lcd_panel_handle_t panel_handle = NULL;
+static lcd_flush_handle_t flush_handle = NULL;  // Double-buffered DMA path to the panel
+static lcd_gfx_handle_t gfx_handle = NULL;      // Framebuffer, dirty tracking and glyph cache
+
+#if SELECTED_FONT == FONT_AA
+// One full-width text line, composed here before it is blitted into the framebuffer
+static uint16_t text_line_buffer[LCD_WIDTH * FONT_AA_LINE_HEIGHT];
+#endif
 
 // WiFi and time sync variables
-static bool time_synced = false;
+static volatile bool time_synced = false;      // Set by the SNTP callback
+static volatile bool time_valid = false;       // Set once the clock holds a synced or estimated time
+
+/**
+ * @brief Last SNTP sync and the measured clock drift
+ * 
+ * A copy lives in RTC memory, which survives software resets, panics and
+ * watchdog resets along with the RTC timer behind gettimeofday(), and a copy
+ * in NVS keeps the drift through a power cycle.
+ */
+typedef struct {
+    int64_t last_sync_us;       // UTC at the last SNTP sync
+    int64_t correction_us;      // Drift corrections applied to the clock since then
+    int32_t drift_ppb;          // Clock rate error, positive when it runs fast
+    uint32_t drift_samples;     // Sync intervals the drift was measured over, 0 if unknown
+    uint32_t magic;
+    uint32_t crc;
+} clock_state_t;
+
+static RTC_NOINIT_ATTR clock_state_t rtc_clock_state;
 
 // Prototypes functions
-static void fill_screen(uint16_t color);
-static int char_to_index(char c);
-static void draw_char(char c, int x, int y, uint16_t color, uint16_t bg_color, int scale);
-static void draw_char_8x5(char c, int x, int y, uint16_t color, uint16_t bg_color, int scale);
-static void draw_char_8x12(char c, int x, int y, uint16_t color, uint16_t bg_color, int scale);
+static esp_err_t render_init(void);
 static void draw_string(const char *str, int x, int y, uint16_t color, uint16_t bg_color, int scale);
+static int text_width(const char *str);
 static void fill_screen(uint16_t color);
 static void backlight_init(void);
 static esp_err_t display_portrait_init(void);
 static esp_err_t display_landscape_init(void);
-static void wifi_event_handler(void* arg, esp_event_base_t event_base,
-                                int32_t event_id, void* event_data);
 static esp_err_t wifi_init_sta(void);
 void time_sync_notification_cb(struct timeval *tv);
 static void sntp_initialize(void);
@@ -140,183 +207,174 @@ static void display_datetime(void);
 static void display_connecting(void);
 static void display_failed(void);
 static void time_display_task(void *pvParameters);
+static bool clock_restore(void);
+static void clock_record_sync(const struct timeval *tv);
+static void time_sync_task(void *pvParameters);
+#if LOW_POWER_MODE
+static void low_power_enter(void);
+static void time_resync_task(void *pvParameters);
+#endif
 
 /**
- * @brief Map a character to its corresponding font index.
+ * @brief Create the flush path and the framebuffer graphics context.
  * 
- * @param c The character to map.
- * @return int The index of the character in the font array.
+ * Drawing functions write into a framebuffer in internal RAM and the
+ * graphics context records the rectangles whose pixels changed.
+ * lcd_gfx_flush() then sends only those rectangles to the panel. The whole
+ * screen starts dirty because the panel contents after reset are unknown.
+ * Must run after the display is initialized.
+ * 
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if a buffer cannot be allocated
  */
-static int char_to_index(char c) {
-      if (c < 32 || c > 126) {
-          return 0;  // Return space for invalid characters
-      }
-      return c - 32;
+static esp_err_t render_init(void) {
+    lcd_flush_config_t flush_config = {
+        .io = io_handle,
+        .panel = panel_handle,
+        .buffer_size = RENDER_FLUSH_PIXELS * sizeof(uint16_t),
+    };
+    ESP_ERROR_CHECK(lcd_flush_new(&flush_config, &flush_handle));
+
+    lcd_gfx_config_t gfx_config = {
+        .flush = flush_handle,
+        .width = LCD_WIDTH,
+        .height = LCD_HEIGHT,
+        .use_framebuffer = true,
+        .max_dirty = RENDER_MAX_DIRTY,
+        .merge_slack = RENDER_MERGE_SLACK,
+        .glyph_cache_slots = GLYPH_CACHE_SLOTS,
+        .glyph_slot_pixels = GLYPH_SLOT_PIXELS,
+    };
+    esp_err_t ret = lcd_gfx_new(&gfx_config, &gfx_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create graphics context");
+        return ret;
+    }
+
+    ESP_LOGI(TAG, "Render layer initialized (%d KB framebuffer)",
+             (int)(LCD_WIDTH * LCD_HEIGHT * sizeof(uint16_t) / 1024));
+    return ESP_OK;
 }
 
+
+#if SELECTED_FONT == FONT_AA
 /**
- * @brief Draw a character at the specified position with given colors and scale.
+ * @brief Look up an AA glyph, mapping characters outside the font to space.
  * 
- * @param c The character to draw.
- * @param x The x-coordinate of the top-left corner where the character will be drawn.
- * @param y The y-coordinate of the top-left corner where the character will be drawn.
- * @param color The color of the character pixels.
- * @param bg_color The background color for the character pixels.
- * @param scale The scaling factor for the character size.
+ * @param c The character.
+ * @return const font_aa_glyph_t* The glyph metrics.
  */
-static void draw_char(char c, int x, int y, uint16_t color, uint16_t bg_color, int scale) {
-#if SELECTED_FONT == FONT_8x5
-    draw_char_8x5(c, x, y, color, bg_color, scale);
-#elif SELECTED_FONT == FONT_8x12
-    draw_char_8x12(c, x, y, color, bg_color, scale);
-#endif
+static const font_aa_glyph_t *font_aa_glyph(char c) {
+    if (c < FONT_AA_FIRST_CHAR || c > FONT_AA_LAST_CHAR) {
+        c = ' ';
+    }
+    return &font_aa_glyphs[c - FONT_AA_FIRST_CHAR];
 }
 
 /**
- * @brief Draw a character using the 8x5 font - BUFFERED VERSION
+ * @brief Blend two colors in panel byte order.
  * 
- * This buffered version uses column-by-column processing with a buffer
- * to reduce SPI transactions and improve performance.
+ * @param fg The foreground color.
+ * @param bg The background color.
+ * @param alpha Foreground coverage, 0 to 15.
+ * @return uint16_t The blended color in panel byte order.
+ */
+static uint16_t blend_color(uint16_t fg, uint16_t bg, int alpha) {
+    fg = (uint16_t)((fg << 8) | (fg >> 8));
+    bg = (uint16_t)((bg << 8) | (bg >> 8));
+
+    const int r = (((fg >> 11) & 0x1F) * alpha + ((bg >> 11) & 0x1F) * (15 - alpha) + 7) / 15;
+    const int g = (((fg >> 5) & 0x3F) * alpha + ((bg >> 5) & 0x3F) * (15 - alpha) + 7) / 15;
+    const int b = ((fg & 0x1F) * alpha + (bg & 0x1F) * (15 - alpha) + 7) / 15;
+
+    const uint16_t out = (uint16_t)((r << 11) | (g << 5) | b);
+    return (uint16_t)((out << 8) | (out >> 8));
+}
+
+/**
+ * @brief Decode one RLE glyph into text_line_buffer.
  * 
- * Original: 5 cols × 8 rows × scale² = 360 SPI transactions (scale=3)
- * Buffered: 5 cols × scale = 15 SPI transactions (scale=3)
- * Improvement: 24x fewer transactions
+ * The stream format is described in tools/ttf_to_aa_font.py. Transparent runs
+ * are skipped so neighbouring glyphs whose boxes overlap are not erased.
+ * Partial pixels over the background use the precomputed ramp; over a
+ * neighbour's ink they are blended with what is already there.
  * 
- * @param c The character to draw.
- * @param x The x-coordinate of the top-left corner where the character will be drawn.
- * @param y The y-coordinate of the top-left corner where the character will be drawn.
- * @param color The color of the character pixels.
- * @param bg_color The background color for the character pixels.
- * @param scale The scaling factor for the character size.
+ * @param glyph The glyph to draw.
+ * @param x Left edge of the ink box in line buffer coordinates.
+ * @param y Top edge of the ink box in line buffer coordinates.
+ * @param color The text color.
+ * @param bg_color The background color the line buffer was cleared to.
+ * @param ramp Blends of color over bg_color for each alpha value.
  */
-static void draw_char_8x5(char c, int x, int y, uint16_t color, uint16_t bg_color, int scale) {
-    int idx = char_to_index(c);
-    
-    // Allocate buffer for one scaled column (height = 8 * scale)
-    const int col_height = 8 * scale;
-    uint16_t *col_buffer = (uint16_t *)malloc(col_height * sizeof(uint16_t));
-    
-    if (col_buffer == NULL) {
-        ESP_LOGE(TAG, "Failed to allocate column buffer for 8x5 font");
-        return;
-    }
-    
-    // Process each column (0 to 4)
-    for (int col = 0; col < 5; col++) {
-        uint8_t line = font_5x8[idx][col];
-        
-        // Build the column buffer
-        int buffer_idx = 0;
-        
-        for (int row = 0; row < 8; row++) {
-            // Check if this row's bit is set
-            uint16_t pixel_color = (line & (1 << row)) ? color : bg_color;
-            
-            // Repeat this pixel vertically for scaling
-            for (int sy = 0; sy < scale; sy++) {
-                col_buffer[buffer_idx++] = pixel_color;
+static void font_aa_decode(const font_aa_glyph_t *glyph, int x, int y, uint16_t color, uint16_t bg_color,
+                           const uint16_t ramp[16]) {
+    const uint8_t *data = &font_aa_data[glyph->offset];
+    const int total = glyph->width * glyph->height;
+    int pos = 0;
+
+    while (pos < total) {
+        const uint8_t code = *data++;
+        const int count = (code & 0x3F) + 1;
+        const int kind = code >> 6;
+
+        for (int i = 0; i < count; i++, pos++) {
+            int alpha;
+            if (kind == 2) {
+                alpha = (i & 1) ? (data[i / 2] & 0x0F) : (data[i / 2] >> 4);
+            } else {
+                alpha = (kind == 1) ? 15 : 0;
             }
-        }
-        
-        // Draw this scaled column (width = scale, height = col_height)
-        for (int sx = 0; sx < scale; sx++) {
-            int px = x + col * scale + sx;
-            
-            if (px >= 0 && px < LCD_WIDTH) {
-                // Draw the entire column in one transaction
-                int draw_y1 = y;
-                int draw_y2 = y + col_height;
-                
-                // Clip to screen boundaries
-                if (draw_y1 < 0) draw_y1 = 0;
-                if (draw_y2 > LCD_HEIGHT) draw_y2 = LCD_HEIGHT;
-                
-                if (draw_y1 < draw_y2) {
-                    // Draw vertical strip
-                    esp_lcd_panel_draw_bitmap(panel_handle, 
-                                               px, draw_y1, 
-                                               px + 1, draw_y2, 
-                                               col_buffer);
-                }
+            if (alpha == 0) {
+                continue;
+            }
+
+            const int px = x + pos % glyph->width;
+            const int py = y + pos / glyph->width;
+            if (px < 0 || px >= LCD_WIDTH || py < 0 || py >= FONT_AA_LINE_HEIGHT) {
+                continue;
             }
+
+            uint16_t *dst = &text_line_buffer[py * LCD_WIDTH + px];
+            *dst = (*dst == bg_color || alpha == 15) ? ramp[alpha] : blend_color(color, *dst, alpha);
+        }
+        if (kind == 2) {
+            data += (count + 1) / 2;
         }
     }
-    
-    free(col_buffer);
 }
 
 /**
- * @brief Draw a character using the 8x12 font - CORRECTED VERSION
+ * @brief Draw a string in the anti-aliased font into the framebuffer.
  * 
- * This version uses COLUMN-BY-COLUMN buffering to match the approach
- * used in draw_char_8x5. Each column is buffered and drawn as a vertical strip.
+ * The whole screen-wide band of the line is composed in text_line_buffer,
+ * starting from the background color, so text that got shorter is cleared
+ * as well. lcd_gfx_blit() then marks only the pixels that actually changed.
  * 
- * This eliminates flickering while maintaining correct text rendering.
- * 
- * @param c The character to draw.
- * @param x The x-coordinate of the top-left corner where the character will be drawn.
- * @param y The y-coordinate of the top-left corner where the character will be drawn.
- * @param color The color of the character pixels.
- * @param bg_color The background color for the character pixels.
- * @param scale The scaling factor for the character size.
+ * @param str The string to draw.
+ * @param x The x-coordinate of the pen at the start of the string.
+ * @param y The y-coordinate of the top of the line.
+ * @param color The text color.
+ * @param bg_color The background color.
  */
-static void draw_char_8x12(char c, int x, int y, uint16_t color, uint16_t bg_color, int scale) {
-    // Get the character index in the font array
-    int idx = char_to_index(c);
-    
-    // Allocate buffer for one scaled column (height = 12 * scale)
-    const int col_height = 12 * scale;
-    uint16_t *col_buffer = (uint16_t *)malloc(col_height * sizeof(uint16_t));
-    
-    if (col_buffer == NULL) {
-        ESP_LOGE(TAG, "Failed to allocate column buffer");
-        return;
+static void draw_string_aa(const char *str, int x, int y, uint16_t color, uint16_t bg_color) {
+    uint16_t ramp[16];
+    for (int alpha = 0; alpha < 16; alpha++) {
+        ramp[alpha] = blend_color(color, bg_color, alpha);
     }
-    
-    // Process each column (0 to 7)
-    for (int col = 0; col < 8; col++) {
-        
-        // Build the column buffer by extracting this column from all rows
-        int buffer_idx = 0;
-        
-        for (int row = 0; row < 12; row++) {
-            uint8_t line = font_8x12[idx][row];
-            
-            // Check if this column's bit is set in this row
-            uint16_t pixel_color = (line & (1 << col)) ? color : bg_color;
-            
-            // Repeat this pixel vertically for scaling
-            for (int sy = 0; sy < scale; sy++) {
-                col_buffer[buffer_idx++] = pixel_color;
-            }
-        }
-        
-        // Now draw this scaled column (width = scale, height = col_height)
-        for (int sx = 0; sx < scale; sx++) {
-            int px = x + col * scale + sx;
-            
-            if (px >= 0 && px < LCD_WIDTH) {
-                // Draw the entire column in one transaction
-                int draw_y1 = y;
-                int draw_y2 = y + col_height;
-                
-                // Clip to screen
-                if (draw_y1 < 0) draw_y1 = 0;
-                if (draw_y2 > LCD_HEIGHT) draw_y2 = LCD_HEIGHT;
-                
-                if (draw_y1 < draw_y2) {
-                    // Draw vertical strip
-                    esp_lcd_panel_draw_bitmap(panel_handle, 
-                                               px, draw_y1, 
-                                               px + 1, draw_y2, 
-                                               col_buffer);
-                }
-            }
-        }
+
+    for (int i = 0; i < LCD_WIDTH * FONT_AA_LINE_HEIGHT; i++) {
+        text_line_buffer[i] = bg_color;
     }
-    
-    free(col_buffer);
+
+    int pen_x = x;
+    for (int i = 0; str[i] != '\0'; i++) {
+        const font_aa_glyph_t *glyph = font_aa_glyph(str[i]);
+        font_aa_decode(glyph, pen_x + glyph->x_offset, glyph->y_offset, color, bg_color, ramp);
+        pen_x += glyph->advance;
+    }
+
+    lcd_gfx_blit(gfx_handle, 0, y, LCD_WIDTH, FONT_AA_LINE_HEIGHT, text_line_buffer);
 }
+#endif
 
 /**
  * @brief Draw a string at the specified position with given colors and scale.
@@ -329,37 +387,46 @@ static void draw_char_8x12(char c, int x, int y, uint16_t color, uint16_t bg_col
  * @param scale The scaling factor for the character size.
  */
 static void draw_string(const char *str, int x, int y, uint16_t color, uint16_t bg_color, int scale) {
-    int cursor_x = x;
+#if SELECTED_FONT == FONT_AA
+    (void)scale;
+    draw_string_aa(str, x, y, color, bg_color);
+#else
+    lcd_gfx_draw_string(gfx_handle, (SELECTED_FONT == FONT_8x12) ? LCD_GFX_FONT_8X12 : LCD_GFX_FONT_5X8,
+                        str, x, y, color, bg_color, scale);
+#endif
+}
+
+/**
+ * @brief Get the width in pixels of a string in the selected font.
+ * 
+ * Bitmap fonts keep their original centering width of CHAR_WIDTH pixels per
+ * character at FONT_SCALE; the AA font sums the glyph advances.
+ * 
+ * @param str The string to measure.
+ * @return int The width in pixels.
+ */
+static int text_width(const char *str) {
+#if SELECTED_FONT == FONT_AA
+    int width = 0;
     for (int i = 0; str[i] != '\0'; i++) {
-        draw_char(str[i], cursor_x, y, color, bg_color, scale);
-        cursor_x += (6 * scale); // 5 pixels + 1 pixel spacing
+        width += font_aa_glyph(str[i])->advance;
     }
+    return width;
+#else
+    return strlen(str) * (CHAR_WIDTH * FONT_SCALE);
+#endif
 }
 
 /**
  * @brief Fill the entire screen with a specified color.
  * 
+ * The framebuffer is updated immediately; the panel changes on the next lcd_gfx_flush().
+ * 
  * @param color The color to fill the screen with.
  */
 static void fill_screen(uint16_t color)
 {
-    const int lines_per_chunk = 1;//10;
-    uint16_t *buffer = malloc(LCD_WIDTH * lines_per_chunk * sizeof(uint16_t));
-    if (buffer == NULL) {
-        ESP_LOGE(TAG, "Failed to allocate buffer");
-        return;
-    }
-    
-    for (int i = 0; i < LCD_WIDTH * lines_per_chunk; i++) {
-        buffer[i] = color;
-    }
-    
-    for (int y = 0; y < LCD_HEIGHT; y += lines_per_chunk) {
-        int lines = (y + lines_per_chunk <= LCD_HEIGHT) ? lines_per_chunk : (LCD_HEIGHT - y);
-        esp_lcd_panel_draw_bitmap(panel_handle, 0, y, LCD_WIDTH, y + lines, buffer);
-    }
-    
-    free(buffer);
+    lcd_gfx_fill_screen(gfx_handle, color);
 }
 
 /**
@@ -373,7 +440,11 @@ static void backlight_init(void)
         .timer_num = LEDC_TIMER_0,
         .duty_resolution = LEDC_TIMER_10_BIT,
         .freq_hz = 5000,
+#if LOW_POWER_MODE
+        .clk_cfg = LEDC_USE_RC_FAST_CLK     // Keeps the PWM running in light sleep
+#else
         .clk_cfg = LEDC_AUTO_CLK
+#endif
     };
     ESP_ERROR_CHECK(ledc_timer_config(&ledc_timer));
 
@@ -387,6 +458,9 @@ static void backlight_init(void)
         .hpoint = 0
     };
     ESP_ERROR_CHECK(ledc_channel_config(&ledc_channel));
+#if LOW_POWER_MODE
+    ESP_ERROR_CHECK(ledc_fade_func_install(0));
+#endif
     
     ESP_LOGI(TAG, "Backlight initialized on GPIO %d", PIN_BL);
 }
@@ -527,108 +601,206 @@ static esp_err_t display_landscape_init(void) {
 }
 
 /**
- * @brief Handle WiFi events
- * 
- * @param arg User-defined argument
- * @param event_base Event base
- * @param event_id Event ID
- * @param event_data Event data
- */
-static void wifi_event_handler(void* arg, esp_event_base_t event_base,
-                                int32_t event_id, void* event_data) {
-    // Handle station start event
-    if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) {
-        esp_wifi_connect();
-    // Handle disconnection and retry logic
-    } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
-        if (wifi_retry_num < MAX_WIFI_RETRY) {
-            esp_wifi_connect();
-            wifi_retry_num++;
-            ESP_LOGI(TAG, "Retry to connect to the AP (attempt %d/%d)", wifi_retry_num, MAX_WIFI_RETRY);
-        } else {
-            xEventGroupSetBits(wifi_event_group, WIFI_FAIL_BIT);
-        }
-        ESP_LOGI(TAG, "Connect to the AP failed");
-    // Handle successful IP acquisition
-    } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) {
-        ip_event_got_ip_t* event = (ip_event_got_ip_t*) event_data;
-        ESP_LOGI(TAG, "Got IP:" IPSTR, IP2STR(&event->ip_info.ip));
-        wifi_retry_num = 0;
-        xEventGroupSetBits(wifi_event_group, WIFI_CONNECTED_BIT);
-    }
-}
-
-/**
- * @brief Initialize WiFi in station mode   
+ * @brief Initialize WiFi in station mode and wait for an IP address
+ * 
+ * The power-save profile comes from the "Wi-Fi station" menu. Only SNTP
+ * uses the link, and its replies usually arrive while the radio is still
+ * awake from sending the request, so sdkconfig.defaults picks the
+ * low-power profile.
  * 
  * @return esp_err_t ESP_OK on success, error code otherwise 
  */
 static esp_err_t wifi_init_sta(void)
 {
-    wifi_event_group = xEventGroupCreate();
-
-    ESP_ERROR_CHECK(esp_netif_init());
-    ESP_ERROR_CHECK(esp_event_loop_create_default());
-    esp_netif_create_default_wifi_sta();
-
-    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
-    ESP_ERROR_CHECK(esp_wifi_init(&cfg));
-
-    esp_event_handler_instance_t instance_any_id;
-    esp_event_handler_instance_t instance_got_ip;
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT,
-                                                        ESP_EVENT_ANY_ID,
-                                                        &wifi_event_handler,
-                                                        NULL,
-                                                        &instance_any_id));
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(IP_EVENT,
-                                                        IP_EVENT_STA_GOT_IP,
-                                                        &wifi_event_handler,
-                                                        NULL,
-                                                        &instance_got_ip));
-
-    // Configure WiFi connection settings for station mode
-    wifi_config_t wifi_config = {
-        .sta = {
-            .ssid = WIFI_SSID,
-            .password = WIFI_PASSWORD,
-            .threshold.authmode = WIFI_AUTH_WPA2_PSK,
-        },
-    };
+    sync_event_group = xEventGroupCreate();
 
-    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
-    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config));
-    ESP_ERROR_CHECK(esp_wifi_start());
+    const wifi_sta_config_t wifi_config = {
+        .ssid = WIFI_SSID,
+        .password = WIFI_PASSWORD,
+        .max_retries = MAX_WIFI_RETRY,
+    };
+    ESP_ERROR_CHECK(wifi_sta_init(&wifi_config));
 
     ESP_LOGI(TAG, "WiFi initialization finished.");
 
     // Wait for connection or failure
-    EventBits_t bits = xEventGroupWaitBits(wifi_event_group,
-            WIFI_CONNECTED_BIT | WIFI_FAIL_BIT,
-            pdFALSE,
-            pdFALSE,
-            portMAX_DELAY);
-
-    if (bits & WIFI_CONNECTED_BIT) {
+    esp_err_t ret = wifi_sta_connect(NULL, portMAX_DELAY);
+    if (ret == ESP_OK) {
         ESP_LOGI(TAG, "Connected to AP SSID:%s", WIFI_SSID);
-        return ESP_OK;
-    } else if (bits & WIFI_FAIL_BIT) {
-        ESP_LOGE(TAG, "Failed to connect to SSID:%s", WIFI_SSID);
-        return ESP_FAIL;
     } else {
-        ESP_LOGE(TAG, "UNEXPECTED EVENT");
-        return ESP_FAIL;
+        ESP_LOGE(TAG, "Failed to connect to SSID:%s", WIFI_SSID);
+    }
+    return ret;
+}
+
+/**
+ * @brief Compute the CRC of a clock state record
+ * 
+ * @param state The record.
+ * @return uint32_t CRC of every field before crc.
+ */
+static uint32_t clock_state_crc(const clock_state_t *state) {
+    return esp_rom_crc32_le(0, (const uint8_t *)state, offsetof(clock_state_t, crc));
+}
+
+/**
+ * @brief Check that a clock state record was written by clock_state_save()
+ * 
+ * @param state The record.
+ * @return true if the magic and CRC match
+ */
+static bool clock_state_valid(const clock_state_t *state) {
+    return state->magic == CLOCK_STATE_MAGIC && state->crc == clock_state_crc(state);
+}
+
+/**
+ * @brief Seal the RTC clock state and optionally copy it to NVS
+ * 
+ * @param to_nvs true to write the NVS copy as well
+ */
+static void clock_state_save(bool to_nvs) {
+    rtc_clock_state.magic = CLOCK_STATE_MAGIC;
+    rtc_clock_state.crc = clock_state_crc(&rtc_clock_state);
+    if (!to_nvs) {
+        return;
+    }
+
+    nvs_handle_t nvs;
+    esp_err_t ret = nvs_open(CLOCK_NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (ret == ESP_OK) {
+        ret = nvs_set_blob(nvs, CLOCK_NVS_KEY, &rtc_clock_state, sizeof(rtc_clock_state));
+        if (ret == ESP_OK) {
+            ret = nvs_commit(nvs);
+        }
+        nvs_close(nvs);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Clock state not saved to NVS (%s)", esp_err_to_name(ret));
     }
 }
 
+/**
+ * @brief Restore the clock state and estimate the current time
+ * 
+ * After any reset but a power-on or brownout the RTC timer has kept
+ * counting, so the system time is still set; it is moved back by the drift
+ * measured at earlier syncs for the time elapsed since the last one. After
+ * a power cycle the time is unknown, but the drift is taken from NVS so the
+ * next warm boot can already correct for it. Must run after nvs_flash_init()
+ * and timestamp_init().
+ * 
+ * @return true if the clock holds a usable time that can be shown at once
+ */
+static bool clock_restore(void) {
+    const esp_reset_reason_t reason = esp_reset_reason();
+    const bool warm = reason != ESP_RST_POWERON && reason != ESP_RST_BROWNOUT && reason != ESP_RST_UNKNOWN;
+
+    if (!warm || !clock_state_valid(&rtc_clock_state)) {
+        clock_state_t stored;
+        size_t size = sizeof(stored);
+        nvs_handle_t nvs;
+        bool loaded = false;
+        if (nvs_open(CLOCK_NVS_NAMESPACE, NVS_READONLY, &nvs) == ESP_OK) {
+            loaded = nvs_get_blob(nvs, CLOCK_NVS_KEY, &stored, &size) == ESP_OK &&
+                     size == sizeof(stored) && clock_state_valid(&stored);
+            nvs_close(nvs);
+        }
+        if (loaded) {
+            rtc_clock_state = stored;
+            rtc_clock_state.correction_us = 0;
+        } else {
+            memset(&rtc_clock_state, 0, sizeof(rtc_clock_state));
+        }
+        clock_state_save(false);
+    }
+
+    if (!warm || !timestamp_is_valid()) {
+        ESP_LOGI(TAG, "No time kept across reset, waiting for SNTP");
+        return false;
+    }
+    if (rtc_clock_state.last_sync_us == 0) {
+        ESP_LOGI(TAG, "Showing RTC time, no sync recorded yet");
+        return true;
+    }
+
+    const int64_t now_us = timestamp_now_us();
+    const int64_t elapsed_us = now_us - rtc_clock_state.last_sync_us;
+    if (elapsed_us < 0) {
+        ESP_LOGW(TAG, "RTC time is before the last sync, waiting for SNTP");
+        return false;
+    }
+
+    // Correction owed for the whole interval, less what earlier boots applied
+    const int64_t owed_us = (elapsed_us / 1000) * rtc_clock_state.drift_ppb / 1000000;
+    const int64_t delta_us = owed_us - rtc_clock_state.correction_us;
+    if (delta_us != 0) {
+        const int64_t corrected_us = now_us - delta_us;
+        const struct timeval tv = {
+            .tv_sec = (time_t)(corrected_us / 1000000),
+            .tv_usec = (suseconds_t)(corrected_us % 1000000),
+        };
+        settimeofday(&tv, NULL);
+        timestamp_sync();
+        rtc_clock_state.correction_us = owed_us;
+        clock_state_save(false);
+    }
+
+    ESP_LOGI(TAG, "Showing RTC time, %lld s since last sync, drift %ld ppb, corrected by %lld ms",
+             (long long)(elapsed_us / 1000000), (long)rtc_clock_state.drift_ppb, (long long)(owed_us / 1000));
+    return true;
+}
+
+/**
+ * @brief Measure the drift against a new SNTP time and record the sync
+ * 
+ * Called before timestamp_sync(), while timestamps still follow the clock
+ * as it ran before SNTP set it. The drift is only measured when that clock
+ * was valid and has run at least CLOCK_DRIFT_MIN_INTERVAL_S since the last
+ * sync, and is averaged with earlier measurements.
+ * 
+ * @param tv The time SNTP just set.
+ */
+static void clock_record_sync(const struct timeval *tv) {
+    const int64_t synced_us = (int64_t)tv->tv_sec * 1000000 + tv->tv_usec;
+    const int64_t interval_us = synced_us - rtc_clock_state.last_sync_us;
+
+    if (timestamp_is_valid() && rtc_clock_state.last_sync_us != 0 &&
+        interval_us >= CLOCK_DRIFT_MIN_INTERVAL_S * 1000000LL) {
+        // How far ahead the clock would be without the corrections clock_restore() made
+        const int64_t error_us = timestamp_now_us() - synced_us + rtc_clock_state.correction_us;
+        const int64_t drift_ppb = error_us * 1000 / (interval_us / 1000000);
+
+        if (drift_ppb > -CLOCK_DRIFT_LIMIT_PPB && drift_ppb < CLOCK_DRIFT_LIMIT_PPB) {
+            rtc_clock_state.drift_ppb = rtc_clock_state.drift_samples == 0
+                ? (int32_t)drift_ppb
+                : (int32_t)((3 * (int64_t)rtc_clock_state.drift_ppb + drift_ppb) / 4);
+            rtc_clock_state.drift_samples++;
+            ESP_LOGI(TAG, "Clock error %lld ms over %lld s, drift now %ld ppb", (long long)(error_us / 1000),
+                     (long long)(interval_us / 1000000), (long)rtc_clock_state.drift_ppb);
+        } else {
+            ESP_LOGW(TAG, "Ignoring clock error of %lld ms, the clock was probably not running",
+                     (long long)(error_us / 1000));
+        }
+    }
+
+    rtc_clock_state.last_sync_us = synced_us;
+    rtc_clock_state.correction_us = 0;
+    clock_state_save(true);
+}
+
 /**
  * @brief SNTP time synchronization notification callback
  * 
  * @param tv Pointer to timeval structure
  */
 void time_sync_notification_cb(struct timeval *tv) {
+    clock_record_sync(tv);
+    // The clock was just set; re-anchor the timestamps the display reads
+    timestamp_sync();
     ESP_LOGI(TAG, "Time synchronized!");
     time_synced = true;
+    time_valid = true;
+    xEventGroupSetBits(sync_event_group, TIME_SYNCED_BIT);
 }
 
 /**
@@ -661,8 +833,8 @@ static void get_formatted_time(char *date_str, char *time_str) {
     time_t now;
     struct tm timeinfo;
     
-    // Get current time
-    time(&now);
+    // Get current time (no system call, see the timestamp component)
+    now = (time_t)(timestamp_now_us() / 1000000);
     
     // Convert to local time
     localtime_r(&now, &timeinfo);
@@ -670,8 +842,13 @@ static void get_formatted_time(char *date_str, char *time_str) {
     // Format date: "Dec 03, 2024"
     strftime(date_str, 32, "%b %d %Y", &timeinfo);
     
+#if LOW_POWER_MODE && !LOW_POWER_SHOW_SECONDS
+    // Format time: "03:45 PM"
+    strftime(time_str, 32, "%I:%M %p", &timeinfo);
+#else
     // Format time: "03:45:30 PM"
     strftime(time_str, 32, "%I:%M:%S %p", &timeinfo);
+#endif
 }
 
 /**
@@ -687,20 +864,21 @@ static void display_datetime(void) {
 
     // Calculate starting Y position to center the text block
     int num_lines = 2;
-    int text_height = 8 * FONT_SCALE; // Each character is 8 pixels tall in the 5x8 font
+    int text_height = TEXT_HEIGHT;
     int line_spacing = LINE_SPACING;//3; // Spacing between lines
     int total_text_height = (text_height * num_lines) + (line_spacing * (num_lines - 1));
     int start_y = (LCD_HEIGHT - total_text_height) / 2;
 
     // Display line 1 centered
-    int line_1_len = strlen(date_str);
-    int line_1_x = ((LCD_WIDTH - (line_1_len * (CHAR_WIDTH * FONT_SCALE))) / 2) - (34 / 2); 
+    int line_1_x = ((LCD_WIDTH - text_width(date_str)) / 2) - TEXT_X_ADJUST;
     draw_string(date_str, line_1_x, start_y, FOREGROUND_COLOR, BACKGROUND_COLOR, FONT_SCALE);
 
     // Display line 2 centered
-    int line_2_len = strlen(time_str);
-    int line_2_x = ((LCD_WIDTH - (line_2_len * (CHAR_WIDTH * FONT_SCALE))) / 2) - (34 / 2); 
+    int line_2_x = ((LCD_WIDTH - text_width(time_str)) / 2) - TEXT_X_ADJUST;
     draw_string(time_str, line_2_x, start_y + text_height + line_spacing, FOREGROUND_COLOR, BACKGROUND_COLOR, FONT_SCALE);
+
+    // Send only the pixels that changed since the last second
+    lcd_gfx_flush(gfx_handle);
 }
 
 /**
@@ -713,22 +891,22 @@ static void display_connecting(void) {
 
     // Calculate starting Y position to center the text block
     int num_lines = 2;
-    int text_height = 8 * FONT_SCALE; // Each character is 8 pixels tall in the 5x8 font
+    int text_height = TEXT_HEIGHT;
     int line_spacing = LINE_SPACING;//3; // Spacing between lines
     int total_text_height = (text_height * num_lines) + (line_spacing * (num_lines - 1));
     int start_y = (LCD_HEIGHT - total_text_height) / 2;
 
     // Display line 1 centered
     char line_1[] = "Connecting";
-    int line_1_len = strlen(line_1);
-    int line_1_x = ((LCD_WIDTH - (line_1_len * (CHAR_WIDTH * FONT_SCALE))) / 2) - (34 / 2); 
+    int line_1_x = ((LCD_WIDTH - text_width(line_1)) / 2) - TEXT_X_ADJUST;
     draw_string(line_1, line_1_x, start_y, FOREGROUND_COLOR, BACKGROUND_COLOR, FONT_SCALE);
 
     // Display line 2 centered
     char line_2[] = "to WiFi...";
-    int line_2_len = strlen(line_2);
-    int line_2_x = ((LCD_WIDTH - (line_2_len * (CHAR_WIDTH * FONT_SCALE))) / 2) - (34 / 2); 
+    int line_2_x = ((LCD_WIDTH - text_width(line_2)) / 2) - TEXT_X_ADJUST;
     draw_string(line_2, line_2_x, start_y + text_height + line_spacing, FOREGROUND_COLOR, BACKGROUND_COLOR, FONT_SCALE);
+
+    lcd_gfx_flush(gfx_handle);
 }
 
 /**
@@ -741,28 +919,27 @@ static void display_failed(void) {
 
     // Calculate starting Y position to center the text block
     int num_lines = 3;
-    int text_height = 8 * FONT_SCALE; // Each character is 8 pixels tall in the 5x8 font
+    int text_height = TEXT_HEIGHT;
     int line_spacing = LINE_SPACING;//3; // Spacing between lines
     int total_text_height = (text_height * num_lines) + (line_spacing * (num_lines - 1));
     int start_y = (LCD_HEIGHT - total_text_height) / 2;
 
     // Display line 1 centered
     char line_1[] = "WiFi";
-    int line_1_len = strlen(line_1);
-    int line_1_x = ((LCD_WIDTH - (line_1_len * (CHAR_WIDTH * FONT_SCALE))) / 2) - (34 / 2); 
+    int line_1_x = ((LCD_WIDTH - text_width(line_1)) / 2) - TEXT_X_ADJUST;
     draw_string(line_1, line_1_x, start_y, FOREGROUND_COLOR, BACKGROUND_COLOR, FONT_SCALE);
 
     // Display line 2 centered
     char line_2[] = "Connection";   
-    int line_2_len = strlen(line_2);
-    int line_2_x =  ((LCD_WIDTH - (line_2_len * (CHAR_WIDTH * FONT_SCALE))) / 2) - (34 / 2); 
+    int line_2_x = ((LCD_WIDTH - text_width(line_2)) / 2) - TEXT_X_ADJUST;
     draw_string(line_2, line_2_x, start_y + text_height + line_spacing, FOREGROUND_COLOR, BACKGROUND_COLOR, FONT_SCALE);
 
     // Display line 3 centered
     char line_3[] = "Failed!";
-    int line_3_len = strlen(line_3);
-    int line_3_x = ((LCD_WIDTH - (line_3_len * (CHAR_WIDTH * FONT_SCALE))) / 2) - (34 / 2); 
+    int line_3_x = ((LCD_WIDTH - text_width(line_3)) / 2) - TEXT_X_ADJUST;
     draw_string(line_3, line_3_x, start_y + 2 * (text_height + line_spacing), FOREGROUND_COLOR, BACKGROUND_COLOR, FONT_SCALE);
+
+    lcd_gfx_flush(gfx_handle);
 }
 
 /**
@@ -776,44 +953,184 @@ static void display_time_sync_failed(void) {
 
     // Calculate starting Y position to center the text block
     int num_lines = 3;
-    int text_height = 8 * FONT_SCALE; // Each character is 8 pixels tall in the 5x8 font
+    int text_height = TEXT_HEIGHT;
     int line_spacing = LINE_SPACING;//3; // Spacing between lines
     int total_text_height = (text_height * num_lines) + (line_spacing * (num_lines - 1));
     int start_y = (LCD_HEIGHT - total_text_height) / 2;
 
     // Display line 1 centered
     char line_1[] = "Time Sync";
-    int line_1_len = strlen(line_1);
-    int line_1_x = ((LCD_WIDTH - (line_1_len * (CHAR_WIDTH * FONT_SCALE))) / 2) - (34 / 2); 
+    int line_1_x = ((LCD_WIDTH - text_width(line_1)) / 2) - TEXT_X_ADJUST;
     draw_string(line_1, line_1_x, start_y, FOREGROUND_COLOR, BACKGROUND_COLOR, FONT_SCALE);
 
     // Display line 2 centered
     char line_2[] = "Failed!";   
-    int line_2_len = strlen(line_2);
-    int line_2_x = ((LCD_WIDTH - (line_2_len * (CHAR_WIDTH * FONT_SCALE))) / 2) - (34 / 2); 
+    int line_2_x = ((LCD_WIDTH - text_width(line_2)) / 2) - TEXT_X_ADJUST;
     draw_string(line_2, line_2_x, start_y + text_height + line_spacing, FOREGROUND_COLOR, BACKGROUND_COLOR, FONT_SCALE);
+
+    lcd_gfx_flush(gfx_handle);
 }
 
+#if LOW_POWER_MODE
+/**
+ * @brief Get the time until the displayed time next changes
+ * 
+ * Waking on the wall-clock boundary, rather than every fixed period, keeps
+ * the display in step after a resync moves the clock.
+ * 
+ * @return TickType_t Ticks until the next second, or minute without seconds
+ */
+static TickType_t ticks_to_next_update(void) {
+    int64_t period_us = LOW_POWER_SHOW_SECONDS ? 1000000LL : 60000000LL;
+    int64_t now_us = timestamp_now_us();
+    int64_t wait_us = period_us - (now_us % period_us);
+
+    // Round up so the wake lands just after the boundary, not just before it
+    return pdMS_TO_TICKS((wait_us + 999) / 1000) + 1;
+}
+
+/**
+ * @brief Switch to the low-power configuration after the first time sync
+ * 
+ * WiFi and SNTP are stopped, the backlight fades to LOW_POWER_BACKLIGHT_DUTY
+ * and automatic light sleep is enabled. Between redraws the only wake-ups
+ * are the display and resync tasks' own timeouts.
+ */
+static void low_power_enter(void) {
+    esp_sntp_stop();
+    wifi_sta_stop();
+
+    ledc_set_fade_with_time(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, LOW_POWER_BACKLIGHT_DUTY, LOW_POWER_FADE_MS);
+    ledc_fade_start(LEDC_LOW_SPEED_MODE, LEDC_CHANNEL_0, LEDC_FADE_NO_WAIT);
+
+    esp_pm_config_t pm_config = {
+        .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .min_freq_mhz = LOW_POWER_MIN_FREQ_MHZ,
+        .light_sleep_enable = true,
+    };
+    esp_err_t ret = esp_pm_configure(&pm_config);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "Light sleep not enabled (%s); check CONFIG_PM_ENABLE", esp_err_to_name(ret));
+    }
+    ESP_LOGI(TAG, "Low-power mode: WiFi off, backlight %d/1024, resync every %d h",
+             LOW_POWER_BACKLIGHT_DUTY, LOW_POWER_RESYNC_HOURS);
+}
+
+/**
+ * @brief Task to bring WiFi up periodically and resync the time
+ * 
+ * A failed resync is not fatal: the RTC keeps counting and the next
+ * attempt comes one interval later.
+ * 
+ * @param pvParameters Pointer to task parameters (not used) 
+ */
+static void time_resync_task(void *pvParameters) {
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(LOW_POWER_RESYNC_HOURS * 3600ULL * 1000ULL));
+
+        ESP_LOGI(TAG, "Resyncing time");
+        xEventGroupClearBits(sync_event_group, TIME_SYNCED_BIT);
+
+        EventBits_t bits = 0;
+        if (wifi_sta_connect(NULL, pdMS_TO_TICKS(LOW_POWER_SYNC_TIMEOUT_S * 1000)) == ESP_OK) {
+            esp_sntp_init();
+            bits = xEventGroupWaitBits(sync_event_group, TIME_SYNCED_BIT,
+                                       pdFALSE, pdFALSE, pdMS_TO_TICKS(LOW_POWER_SYNC_TIMEOUT_S * 1000));
+            esp_sntp_stop();
+        }
+        if (!(bits & TIME_SYNCED_BIT)) {
+            ESP_LOGW(TAG, "Resync failed, keeping RTC time");
+        }
+
+        wifi_sta_stop();
+    }
+}
+#endif
+
 /**
  * @brief Task to update time display every second  
  * 
+ * In low-power mode the task instead sleeps until the next second or
+ * minute boundary. Either way only the digits that changed are sent,
+ * since lcd_gfx_flush() sends just the dirty pixels.
+ * 
  * @param pvParameters Pointer to task parameters (not used) 
  */
 static void time_display_task(void *pvParameters) {
     // Clear screen
     fill_screen(BACKGROUND_COLOR);
     
+#if LOW_POWER_MODE
+    while (1) {
+        display_datetime();
+        vTaskDelay(ticks_to_next_update());
+    }
+#else
     // Initialize the xLastWakeTime variable with the current time
     TickType_t xLastWakeTime = xTaskGetTickCount();
     const TickType_t xFrequency = pdMS_TO_TICKS(1000);
     
     // Update every second
     while (1) {
-        if (time_synced) {
+        if (time_valid) {
             display_datetime();
         }
         vTaskDelayUntil(&xLastWakeTime, xFrequency);
     }
+#endif
+}
+
+/**
+ * @brief Task to connect WiFi and take the first SNTP sync
+ * 
+ * When the clock is already shown from the RTC a failure only leaves the
+ * estimate uncorrected; otherwise the failure is shown on the screen.
+ * 
+ * @param pvParameters Non-zero if time_display_task is already running
+ */
+static void time_sync_task(void *pvParameters) {
+    const bool display_running = (intptr_t)pvParameters != 0;
+
+    // Initialize WiFi
+    esp_err_t ret = wifi_init_sta();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "WiFi initialization failed");
+        if (!display_running) {
+            display_failed();
+        }
+        vTaskDelete(NULL);
+    }
+
+    // Initialize SNTP
+    sntp_initialize();
+
+    // Wait for time to be synchronized
+    ESP_LOGI(TAG, "Waiting for time synchronization...");
+    int retry = 0;
+    while (!time_synced && retry < 30) {
+        vTaskDelay(pdMS_TO_TICKS(1000));
+        retry++;
+    }
+
+    if (time_synced) {
+        ESP_LOGI(TAG, "Time synchronized successfully");
+        if (!display_running) {
+            // Create task to update display
+            xTaskCreate(time_display_task, "time_display", 4096, NULL, 5, NULL);
+        }
+    } else if (display_running) {
+        ESP_LOGW(TAG, "Time synchronization failed, keeping RTC time");
+    } else {
+        ESP_LOGE(TAG, "Time synchronization failed");
+        display_time_sync_failed();
+        vTaskDelete(NULL);
+    }
+
+#if LOW_POWER_MODE
+    low_power_enter();
+    xTaskCreate(time_resync_task, "time_resync", 4096, NULL, 3, NULL);
+#endif
+    vTaskDelete(NULL);
 }
 
 /**
@@ -833,6 +1150,8 @@ void app_main(void) {
     }
     ESP_ERROR_CHECK(ret);
 
+    timestamp_init();
+
     // Initialize display based on orientation
     #if DISPLAY_ORIENTATION == DISPLAY_PORTRAIT_MODE
         // Initialize display in portrait mode
@@ -844,43 +1163,27 @@ void app_main(void) {
         ESP_LOGE(TAG, "Invalid DISPLAY_ORIENTATION value");
     #endif 
 
-    // Initialize backlight
-    backlight_init();
-    
-    // Show connecting message
-    display_connecting();
-    
-    // Initialize WiFi
-    ret = wifi_init_sta();
-    if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "WiFi initialization failed");
-        display_failed();
-        return;
-    }
-    
+    // Initialize framebuffer and double-buffered flush
+    ESP_ERROR_CHECK(render_init());
+
     // Set timezone to Miami, USA (EST/EDT)
     setenv("TZ", "EST5EDT,M3.2.0/2,M11.1.0/2", 1);
     tzset();
     ESP_LOGI(TAG, "Timezone set to Miami, USA (EST/EDT)");
-    
-    // Initialize SNTP
-    sntp_initialize();
-    
-    // Wait for time to be synchronized
-    ESP_LOGI(TAG, "Waiting for time synchronization...");
-    int retry = 0;
-    while (!time_synced && retry < 30) {
-        vTaskDelay(pdMS_TO_TICKS(1000));
-        retry++;
-    }
 
-    if (time_synced) {
-        ESP_LOGI(TAG, "Time synchronized successfully");
+    // Draw the first frame before the backlight comes on, so no garbage is seen
+    time_valid = clock_restore();
+    if (time_valid) {
         fill_screen(BACKGROUND_COLOR);
-        // Create task to update display
+        display_datetime();
         xTaskCreate(time_display_task, "time_display", 4096, NULL, 5, NULL);
     } else {
-        ESP_LOGE(TAG, "Time synchronization failed");
-        display_time_sync_failed();
+        display_connecting();
     }
-}
\ No newline at end of file
+
+    // Initialize backlight
+    backlight_init();
+
+    // WiFi and SNTP take seconds; the estimated time is on screen meanwhile
+    xTaskCreate(time_sync_task, "time_sync", 4096, (void *)(intptr_t)time_valid, 4, NULL);
+}
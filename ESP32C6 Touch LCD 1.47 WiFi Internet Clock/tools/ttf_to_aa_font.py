@@ -0,0 +1,395 @@
+#!/usr/bin/env python3
+"""Convert a TrueType font into an anti-aliased, RLE-compressed C font table.
+
+Glyphs are rasterized with 16 sub-scanlines and exact horizontal coverage,
+quantized to 4-bit alpha, cropped to their ink box and run-length encoded.
+The output header is read by the clock's font_aa renderer (see main.c).
+Only the Python standard library is used, so the script can run as part of
+the ESP-IDF build.
+
+RLE stream, row-major over each glyph's ink box, runs may wrap rows:
+    00nnnnnn            n+1 transparent pixels (alpha 0)
+    01nnnnnn            n+1 opaque pixels (alpha 15)
+    10nnnnnn a0a1 ...   n+1 literal pixels, two 4-bit alphas per byte,
+                        first pixel in the high nibble
+
+Usage: ttf_to_aa_font.py <font.ttf> <pixel_size> <output.h> [--tabular-digits]
+"""
+
+import math
+import os
+import struct
+import sys
+
+FIRST_CHAR = 32
+LAST_CHAR = 126
+SUB_SCANLINES = 16
+CURVE_STEPS = 8
+MAX_RUN = 64
+MIN_SOLID_RUN = 5
+
+
+class TrueTypeFont:
+    """Just enough of the TrueType format to outline and measure glyphs."""
+
+    def __init__(self, data):
+        self.data = data
+        num_tables = struct.unpack_from(">H", data, 4)[0]
+        self.tables = {}
+        for i in range(num_tables):
+            tag, _, offset, length = struct.unpack_from(">4sIII", data, 12 + 16 * i)
+            self.tables[tag.decode("latin-1")] = (offset, length)
+
+        head = self.tables["head"][0]
+        self.units_per_em = struct.unpack_from(">H", data, head + 18)[0]
+        self.long_loca = struct.unpack_from(">h", data, head + 50)[0] == 1
+
+        hhea = self.tables["hhea"][0]
+        self.ascender, self.descender, self.line_gap = struct.unpack_from(">hhh", data, hhea + 4)
+        self.num_hmetrics = struct.unpack_from(">H", data, hhea + 34)[0]
+        self.num_glyphs = struct.unpack_from(">H", data, self.tables["maxp"][0] + 4)[0]
+        self.cmap = self._read_cmap()
+
+    def _read_cmap(self):
+        base = self.tables["cmap"][0]
+        count = struct.unpack_from(">H", self.data, base + 2)[0]
+        for i in range(count):
+            platform, encoding, offset = struct.unpack_from(">HHI", self.data, base + 4 + 8 * i)
+            sub = base + offset
+            if (platform, encoding) in ((3, 1), (0, 3)) and struct.unpack_from(">H", self.data, sub)[0] == 4:
+                return self._read_cmap4(sub)
+        raise ValueError("font has no Unicode BMP (format 4) cmap")
+
+    def _read_cmap4(self, sub):
+        seg_count = struct.unpack_from(">H", self.data, sub + 6)[0] // 2
+        ends = sub + 14
+        starts = ends + 2 * seg_count + 2
+        deltas = starts + 2 * seg_count
+        range_offsets = deltas + 2 * seg_count
+        mapping = {}
+        for seg in range(seg_count):
+            end = struct.unpack_from(">H", self.data, ends + 2 * seg)[0]
+            start = struct.unpack_from(">H", self.data, starts + 2 * seg)[0]
+            delta = struct.unpack_from(">h", self.data, deltas + 2 * seg)[0]
+            range_offset = struct.unpack_from(">H", self.data, range_offsets + 2 * seg)[0]
+            for code in range(max(start, FIRST_CHAR), min(end, LAST_CHAR) + 1):
+                if range_offset == 0:
+                    glyph = (code + delta) & 0xFFFF
+                else:
+                    addr = range_offsets + 2 * seg + range_offset + 2 * (code - start)
+                    glyph = struct.unpack_from(">H", self.data, addr)[0]
+                    if glyph:
+                        glyph = (glyph + delta) & 0xFFFF
+                mapping[code] = glyph
+        return mapping
+
+    def advance(self, glyph):
+        hmtx = self.tables["hmtx"][0]
+        index = min(glyph, self.num_hmetrics - 1)
+        return struct.unpack_from(">H", self.data, hmtx + 4 * index)[0]
+
+    def _glyph_offset(self, glyph):
+        loca = self.tables["loca"][0]
+        if self.long_loca:
+            start, end = struct.unpack_from(">II", self.data, loca + 4 * glyph)
+        else:
+            start, end = (2 * v for v in struct.unpack_from(">HH", self.data, loca + 2 * glyph))
+        return (self.tables["glyf"][0] + start) if end > start else None
+
+    def contours(self, glyph, depth=0):
+        """Return the glyph outline as lists of (x, y, on_curve) in font units."""
+        offset = self._glyph_offset(glyph)
+        if offset is None or depth > 8:
+            return []
+        num_contours = struct.unpack_from(">h", self.data, offset)[0]
+        if num_contours >= 0:
+            return self._simple_contours(offset, num_contours)
+        return self._composite_contours(offset, depth)
+
+    def _simple_contours(self, offset, num_contours):
+        pos = offset + 10
+        end_points = struct.unpack_from(">%dH" % num_contours, self.data, pos)
+        pos += 2 * num_contours
+        instruction_length = struct.unpack_from(">H", self.data, pos)[0]
+        pos += 2 + instruction_length
+        num_points = end_points[-1] + 1 if num_contours else 0
+
+        flags = []
+        while len(flags) < num_points:
+            flag = self.data[pos]
+            pos += 1
+            flags.append(flag)
+            if flag & 0x08:
+                repeat = self.data[pos]
+                pos += 1
+                flags.extend([flag] * repeat)
+        flags = flags[:num_points]
+
+        def read_coords(short_bit, same_bit):
+            nonlocal pos
+            values, value = [], 0
+            for flag in flags:
+                if flag & short_bit:
+                    delta = self.data[pos]
+                    pos += 1
+                    value += delta if flag & same_bit else -delta
+                elif not flag & same_bit:
+                    value += struct.unpack_from(">h", self.data, pos)[0]
+                    pos += 2
+                values.append(value)
+            return values
+
+        xs = read_coords(0x02, 0x10)
+        ys = read_coords(0x04, 0x20)
+        contours, start = [], 0
+        for end in end_points:
+            contours.append([(xs[i], ys[i], bool(flags[i] & 0x01)) for i in range(start, end + 1)])
+            start = end + 1
+        return contours
+
+    def _composite_contours(self, offset, depth):
+        pos = offset + 10
+        contours = []
+        while True:
+            flags, glyph = struct.unpack_from(">HH", self.data, pos)
+            pos += 4
+            if flags & 0x0001:
+                dx, dy = struct.unpack_from(">hh", self.data, pos)
+                pos += 4
+            else:
+                dx, dy = struct.unpack_from(">bb", self.data, pos)
+                pos += 2
+            if not flags & 0x0002:
+                dx = dy = 0  # Point matching is not supported; place at the origin
+            a, b, c, d = 1.0, 0.0, 0.0, 1.0
+            if flags & 0x0008:
+                a = d = struct.unpack_from(">h", self.data, pos)[0] / 16384.0
+                pos += 2
+            elif flags & 0x0040:
+                a, d = (v / 16384.0 for v in struct.unpack_from(">hh", self.data, pos))
+                pos += 4
+            elif flags & 0x0080:
+                a, b, c, d = (v / 16384.0 for v in struct.unpack_from(">hhhh", self.data, pos))
+                pos += 8
+            for contour in self.contours(glyph, depth + 1):
+                contours.append([(a * x + c * y + dx, b * x + d * y + dy, on) for x, y, on in contour])
+            if not flags & 0x0020:
+                break
+        return contours
+
+
+def flatten(contour):
+    """Turn a TrueType quadratic contour into a closed polyline."""
+    if not contour:
+        return []
+    points = list(contour)
+    # Start on an on-curve point, inserting an implied one if there is none
+    for i, point in enumerate(points):
+        if point[2]:
+            points = points[i:] + points[:i]
+            break
+    else:
+        x0, y0, _ = points[0]
+        x1, y1, _ = points[1 % len(points)]
+        points.insert(0, ((x0 + x1) / 2, (y0 + y1) / 2, True))
+
+    poly = [(points[0][0], points[0][1])]
+    control = None
+    for x, y, on in points[1:] + points[:1]:
+        if on:
+            if control is None:
+                poly.append((x, y))
+            else:
+                poly.extend(quad(poly[-1], control, (x, y)))
+                control = None
+        else:
+            if control is not None:
+                mid = ((control[0] + x) / 2, (control[1] + y) / 2)
+                poly.extend(quad(poly[-1], control, mid))
+            control = (x, y)
+    return poly
+
+
+def quad(p0, p1, p2):
+    out = []
+    for step in range(1, CURVE_STEPS + 1):
+        t = step / CURVE_STEPS
+        u = 1 - t
+        out.append((u * u * p0[0] + 2 * u * t * p1[0] + t * t * p2[0],
+                    u * u * p0[1] + 2 * u * t * p1[1] + t * t * p2[1]))
+    return out
+
+
+def rasterize(polys, width, height):
+    """Non-zero winding fill with exact horizontal coverage, returns 0.0-1.0 per pixel."""
+    coverage = [[0.0] * width for _ in range(height)]
+    edges = []
+    for poly in polys:
+        for i in range(len(poly)):
+            (x0, y0), (x1, y1) = poly[i], poly[(i + 1) % len(poly)]
+            if y0 != y1:
+                edges.append((x0, y0, x1, y1, 1 if y1 > y0 else -1))
+
+    for row in range(height):
+        for sub in range(SUB_SCANLINES):
+            sy = row + (sub + 0.5) / SUB_SCANLINES
+            crossings = []
+            for x0, y0, x1, y1, winding in edges:
+                if min(y0, y1) <= sy < max(y0, y1):
+                    crossings.append((x0 + (sy - y0) * (x1 - x0) / (y1 - y0), winding))
+            crossings.sort()
+            wind = 0
+            for i, (x, w) in enumerate(crossings[:-1]):
+                wind += w
+                if wind != 0:
+                    add_span(coverage[row], x, crossings[i + 1][0], width)
+    weight = 1.0 / SUB_SCANLINES
+    return [[min(1.0, c * weight) for c in line] for line in coverage]
+
+
+def add_span(line, xa, xb, width):
+    xa, xb = max(0.0, xa), min(float(width), xb)
+    if xb <= xa:
+        return
+    first, last = int(xa), min(int(math.ceil(xb)) - 1, width - 1)
+    for px in range(first, last + 1):
+        line[px] += min(xb, px + 1) - max(xa, px)
+
+
+def encode(alphas):
+    """RLE-encode a flat list of 4-bit alphas."""
+    out = bytearray()
+    i = 0
+    while i < len(alphas):
+        value = alphas[i]
+        run = 1
+        while i + run < len(alphas) and alphas[i + run] == value and run < MAX_RUN:
+            run += 1
+        if value in (0, 15) and run >= MIN_SOLID_RUN:
+            out.append((0x00 if value == 0 else 0x40) | (run - 1))
+            i += run
+            continue
+        # Literal run until the next solid run long enough to pay for its own code byte
+        start = i
+        while i < len(alphas) and i - start < MAX_RUN:
+            if alphas[i] in (0, 15) and alphas[i:i + MIN_SOLID_RUN] == [alphas[i]] * MIN_SOLID_RUN:
+                break
+            i += 1
+        literal = alphas[start:i]
+        out.append(0x80 | (len(literal) - 1))
+        for j in range(0, len(literal), 2):
+            low = literal[j + 1] if j + 1 < len(literal) else 0
+            out.append((literal[j] << 4) | low)
+    return out
+
+
+def build(font, pixel_size, tabular_digits):
+    scale = pixel_size / font.units_per_em
+    ascent = int(math.ceil(font.ascender * scale))
+    line_height = ascent + int(math.ceil(-font.descender * scale))
+    advances = {code: int(round(font.advance(font.cmap.get(code, 0)) * scale))
+                for code in range(FIRST_CHAR, LAST_CHAR + 1)}
+    digit_advance = max(advances[code] for code in range(ord("0"), ord("9") + 1))
+
+    glyphs, blob = [], bytearray()
+    for code in range(FIRST_CHAR, LAST_CHAR + 1):
+        glyph = font.cmap.get(code, 0)
+        polys = [flatten(c) for c in font.contours(glyph)]
+        points = [p for poly in polys for p in poly]
+        advance = advances[code]
+        shift = 0
+        if tabular_digits and chr(code).isdigit():
+            shift = (digit_advance - advance) // 2
+            advance = digit_advance
+
+        if not points:
+            glyphs.append((len(blob), 0, 0, 0, 0, advance))
+            continue
+
+        # Pixel space: x right from the pen, y down from the line top
+        px = [(x * scale + shift, ascent - y * scale) for poly in polys for x, y in poly]
+        left = int(math.floor(min(x for x, _ in px)))
+        top = int(math.floor(min(y for _, y in px)))
+        width = int(math.ceil(max(x for x, _ in px))) - left
+        height = int(math.ceil(max(y for _, y in px))) - top
+        shifted = [[(x * scale + shift - left, ascent - y * scale - top) for x, y in poly] for poly in polys]
+        alphas = [[int(round(c * 15)) for c in line] for line in rasterize(shifted, width, height)]
+
+        # Crop empty borders left by rounding
+        while alphas and not any(alphas[0]):
+            alphas.pop(0)
+            top += 1
+        while alphas and not any(alphas[-1]):
+            alphas.pop()
+        while alphas and not any(line[0] for line in alphas):
+            alphas = [line[1:] for line in alphas]
+            left += 1
+        while alphas and not any(line[-1] for line in alphas):
+            alphas = [line[:-1] for line in alphas]
+
+        width = len(alphas[0]) if alphas else 0
+        height = len(alphas)
+        glyphs.append((len(blob), width, height, left, top, advance))
+        blob += encode([a for line in alphas for a in line])
+
+    return line_height, ascent, glyphs, blob
+
+
+def write_header(path, source, pixel_size, line_height, ascent, glyphs, blob):
+    raw_bytes = sum((g[1] * g[2] + 1) // 2 for g in glyphs)
+    guard = "FONT_AA_CLOCK_H"
+    with open(path, "w") as f:
+        f.write("/**\n")
+        f.write(" * @file font_aa_clock.h\n")
+        f.write(" * @brief Anti-aliased proportional font for ASCII characters %d-%d\n" % (FIRST_CHAR, LAST_CHAR))
+        f.write(" *\n")
+        f.write(" * Generated by tools/ttf_to_aa_font.py from %s at %d px. Do not edit.\n" % (source, pixel_size))
+        f.write(" *\n")
+        f.write(" * Glyphs are 4-bit alpha, cropped to their ink box and RLE-compressed:\n")
+        f.write(" * %d bytes of glyph data (%d bytes unpacked at 4 bits per pixel).\n" % (len(blob), raw_bytes))
+        f.write(" * See the script for the stream format.\n")
+        f.write(" */\n\n")
+        f.write("#ifndef %s\n#define %s\n\n#include <stdint.h>\n\n" % (guard, guard))
+        f.write("#define FONT_AA_FIRST_CHAR   %d\n" % FIRST_CHAR)
+        f.write("#define FONT_AA_LAST_CHAR    %d\n" % LAST_CHAR)
+        f.write("#define FONT_AA_LINE_HEIGHT  %d\n" % line_height)
+        f.write("#define FONT_AA_ASCENT       %d\n\n" % ascent)
+        f.write("typedef struct {\n")
+        f.write("    uint16_t offset;    // Start of the RLE stream in font_aa_data\n")
+        f.write("    uint8_t width;      // Ink box size in pixels\n")
+        f.write("    uint8_t height;\n")
+        f.write("    int8_t x_offset;    // Ink box left edge relative to the pen position\n")
+        f.write("    int8_t y_offset;    // Ink box top edge relative to the line top\n")
+        f.write("    uint8_t advance;    // Pen advance in pixels\n")
+        f.write("} font_aa_glyph_t;\n\n")
+        f.write("static const font_aa_glyph_t font_aa_glyphs[] = {\n")
+        for code, (offset, width, height, left, top, advance) in zip(range(FIRST_CHAR, LAST_CHAR + 1), glyphs):
+            label = chr(code) if chr(code) not in "\\" else "backslash"
+            f.write("    { %5d, %3d, %3d, %3d, %3d, %3d },  // '%s'\n" % (offset, width, height, left, top, advance, label))
+        f.write("};\n\n")
+        f.write("static const uint8_t font_aa_data[] = {\n")
+        for i in range(0, len(blob), 16):
+            f.write("    " + ", ".join("0x%02X" % b for b in blob[i:i + 16]) + ",\n")
+        f.write("};\n\n#endif\n")
+
+
+def main():
+    args = [a for a in sys.argv[1:] if not a.startswith("--")]
+    if len(args) != 3:
+        print(__doc__, file=sys.stderr)
+        return 1
+
+    src, size, dst = args[0], int(args[1]), args[2]
+    with open(src, "rb") as f:
+        font = TrueTypeFont(f.read())
+    line_height, ascent, glyphs, blob = build(font, size, "--tabular-digits" in sys.argv)
+    if len(blob) > 0xFFFF or any(not (-128 <= g[3] < 128 and -128 <= g[4] < 128) or max(g[1], g[2], g[5]) > 255
+                                 for g in glyphs):
+        print("font too large for the table format; use a smaller pixel size", file=sys.stderr)
+        return 1
+    write_header(dst, os.path.basename(src), size, line_height, ascent, glyphs, blob)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -9,13 +9,13 @@
  * - Load switch gating
  * - PFET high-side gating using a driver stage
  *
- * The demo focuses on safe sequencing:
+ * The demo focuses on safe sequencing (pg_sequencer.c):
  * 1) Enable gated rail
- * 2) Wait for stabilization
+ * 2) Wait for the rail to rise and the peripheral to report ready
  * 3) Perform "work" (sensor read stub)
  * 4) Put buses into a safe state (avoid back-powering)
- * 5) Disable gated rail
- * 6) Enter deep sleep
+ * 5) Disable gated rail, as soon as the measurement is done
+ * 6) Enter deep sleep once communication has finished
  *
  * Notes:
  * - This demo intentionally keeps I2C handling as a stub to stay hardware-agnostic.
@@ -32,7 +32,10 @@
 #include "esp_log.h"
 #include "esp_random.h"
 
+#include "energy_profiler.h"
+
 #include "power_gating.h"
+#include "pg_sequencer.h"
 #include "bus_safe.h"
 #include "sleep_ctrl.h"
 
@@ -45,6 +48,8 @@ static const char *TAG = "main";
 
 static EventGroupHandle_t s_evt;
 
+static pg_rail_t s_sensor_rail;
+
 /**
  * @brief Build the power gating configuration from Kconfig.
  *
@@ -85,6 +90,39 @@ static bus_safe_config_t build_bus_config_from_kconfig(void)
     return cfg;
 }
 
+/**
+ * @brief Build the sensor rail profile from Kconfig.
+ *
+ * @return pg_rail_profile_t profile.
+ */
+static pg_rail_profile_t build_rail_profile_from_kconfig(void)
+{
+    pg_rail_profile_t p = {
+        .name = "sensor",
+        .set_enabled = pg_set_enabled,
+        .turn_on_ms = CONFIG_PG_TURN_ON_MS,
+        .ready_method = PG_READY_DELAY,
+        .settle_ms = CONFIG_PG_STABILIZE_MS,
+        .i2c_scl_gpio = CONFIG_PG_BUS_I2C_SCL_GPIO,
+        .i2c_sda_gpio = CONFIG_PG_BUS_I2C_SDA_GPIO,
+        .ready_gpio = -1,
+        .turn_off_ms = CONFIG_PG_TURN_OFF_MS,
+    };
+
+#if CONFIG_PG_READY_GPIO
+    p.ready_method = PG_READY_GPIO;
+    p.settle_ms = CONFIG_PG_READY_TIMEOUT_MS;
+    p.ready_gpio = CONFIG_PG_READY_PIN;
+    p.ready_active_high = CONFIG_PG_READY_ACTIVE_HIGH;
+#elif CONFIG_PG_READY_I2C_ACK
+    p.ready_method = PG_READY_I2C_ACK;
+    p.settle_ms = CONFIG_PG_READY_TIMEOUT_MS;
+    p.i2c_addr = CONFIG_PG_SENSOR_I2C_ADDR;
+#endif
+
+    return p;
+}
+
 /**
  * @brief Fake sensor read to simulate a real peripheral transaction.
  *
@@ -103,7 +141,10 @@ static uint32_t fake_sensor_read(void)
 }
 
 /**
- * @brief Measurement task: powers on rail, reads sensor, signals completion.
+ * @brief Measurement task: powers on rail, reads sensor, powers rail off.
+ *
+ * The rail is switched off as soon as the sample is taken, so it is not
+ * held on through the communication window.
  *
  * @param arg Unused.
  */
@@ -114,18 +155,25 @@ static void task_measurement(void *arg)
     const pg_config_t *pg = pg_get_config();
 
     ESP_LOGI(TAG, "Measurement: enabling rail (GPIO=%d)", pg->enable_gpio);
-    pg_set_enabled(true);
+    energy_profiler_mark(ENERGY_PHASE_SENSOR);
 
     // Wait for rail rise time and sensor startup.
-    vTaskDelay(pdMS_TO_TICKS(pg->stabilize_ms));
-
-    uint32_t sample = fake_sensor_read();
+    if (pg_seq_power_on(&s_sensor_rail) == ESP_OK) {
+        uint32_t sample = fake_sensor_read();
 
 #if CONFIG_PG_LOG_SAMPLE
-    ESP_LOGI(TAG, "Measurement: sample=%" PRIu32, sample);
+        ESP_LOGI(TAG, "Measurement: sample=%" PRIu32, sample);
+#else
+        (void)sample;
 #endif
+    } else {
+        ESP_LOGW(TAG, "Measurement: sensor not ready, sample skipped");
+    }
 
     // In real code: deinit I2C/SPI here before cutting power.
+    pg_seq_power_off(&s_sensor_rail);
+    energy_profiler_mark(ENERGY_PHASE_ACTIVE);
+
     xEventGroupSetBits(s_evt, EVT_MEAS_DONE);
 
     // Delete self when done.
@@ -149,7 +197,9 @@ static void task_comm(void *arg)
 
     // Simulate a short communication window.
     ESP_LOGI(TAG, "Comm: simulated transmit");
+    energy_profiler_mark(ENERGY_PHASE_RADIO);
     vTaskDelay(pdMS_TO_TICKS(50));
+    energy_profiler_mark(ENERGY_PHASE_ACTIVE);
 
     // Create event to signal completion.
     xEventGroupSetBits(s_evt, EVT_COMM_DONE);
@@ -159,11 +209,11 @@ static void task_comm(void *arg)
 }
 
 /**
- * @brief Power manager task: orchestrates shutdown, gates rail, and sleeps.
+ * @brief Power manager task: orchestrates shutdown and sleeps.
  *
- * This task owns the power transition. It waits for other tasks to complete,
- * applies bus-safe states to prevent phantom powering, gates off the rail,
- * and enters deep sleep.
+ * This task owns the transition to deep sleep. It waits for other tasks to
+ * complete, makes sure the rail is off with the bus in its safe state, and
+ * enters deep sleep.
  *
  * @param arg Unused.
  */
@@ -174,16 +224,11 @@ static void task_power_manager(void *arg)
     // Wait for measurement and communication to complete.  
     xEventGroupWaitBits(s_evt, EVT_MEAS_DONE | EVT_COMM_DONE, pdFALSE, pdTRUE, portMAX_DELAY);
 
-    // Apply bus-safe states before powering off the rail.
-    ESP_LOGI(TAG, "Power manager: applying bus-safe state");
-    bus_safe_apply_before_power_off();
-
-    // Disable the gated rail.
-    ESP_LOGI(TAG, "Power manager: disabling rail");
-    pg_set_enabled(false);
-
-    // Small delay to allow rail to collapse, helpful when measuring.
-    vTaskDelay(pdMS_TO_TICKS(5));
+    // The measurement task normally has powered the rail off already.
+    if (s_sensor_rail.powered) {
+        ESP_LOGI(TAG, "Power manager: disabling rail");
+        pg_seq_power_off(&s_sensor_rail);
+    }
 
     // Enter deep sleep until next measurement cycle.
     sleep_ctrl_enter_deep_sleep(CONFIG_PG_WAKE_INTERVAL_S);
@@ -191,6 +236,9 @@ static void task_power_manager(void *arg)
 
 void app_main(void)
 {
+    // Start the energy cycle first so boot time is not lost.
+    energy_profiler_init();
+
     // Create synchronization primitive first.
     s_evt = xEventGroupCreate();
 
@@ -202,6 +250,8 @@ void app_main(void)
     pg_config_t pg_cfg = build_pg_config_from_kconfig();
     pg_init(&pg_cfg);
 
+    s_sensor_rail.profile = build_rail_profile_from_kconfig();
+
     ESP_LOGI(TAG, "Boot: starting tasks");
 
     // Create application tasks.
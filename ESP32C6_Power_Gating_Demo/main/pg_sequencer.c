@@ -0,0 +1,224 @@
+/**
+ * @file pg_sequencer.c
+ * @brief Power-up / power-down sequencing for gated rails.
+ *
+ * A fixed stabilize delay has to cover the slowest rail and the slowest
+ * peripheral start-up, so it keeps the rail on longer than most wakes need.
+ * The sequencer instead waits only for the rail rise time and then for the
+ * peripheral itself to report ready:
+ *
+ * - a data-ready or ready GPIO, caught with an edge interrupt
+ * - an I2C address ACK, polled with a probe every millisecond
+ *
+ * Both are bounded by the profile's settle time. The measured enable-to-ready
+ * and enable-to-disable times are logged on every wake, which shows how long
+ * the rail really has to be on.
+ */
+
+#include "pg_sequencer.h"
+
+#include <inttypes.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "driver/gpio.h"
+#include "driver/i2c_master.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "bus_safe.h"
+
+static const char *TAG = "pg_seq";
+
+/** I2C clock for the ACK probe. */
+#define PG_SEQ_I2C_HZ           100000
+
+/** Wait between I2C probes. */
+#define PG_SEQ_POLL_MS          1
+
+/**
+ * @brief Milliseconds since an esp_timer time stamp.
+ *
+ * @param since_us Earlier esp_timer_get_time() value.
+ * @return uint32_t elapsed milliseconds.
+ */
+static uint32_t pg_seq_elapsed_ms(int64_t since_us)
+{
+    return (uint32_t)((esp_timer_get_time() - since_us) / 1000);
+}
+
+/**
+ * @brief Ready-pin edge interrupt: wakes the waiting task.
+ *
+ * @param arg Handle of the task in pg_seq_wait_gpio().
+ */
+static void IRAM_ATTR pg_seq_ready_isr(void *arg)
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR((TaskHandle_t)arg, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief Wait for the ready GPIO to reach its active level.
+ *
+ * @param p Rail profile.
+ * @param deadline_us esp_timer time at which to give up.
+ * @return true if the pin became active before the deadline.
+ */
+static bool pg_seq_wait_gpio(const pg_rail_profile_t *p, int64_t deadline_us)
+{
+    gpio_num_t pin = (gpio_num_t)p->ready_gpio;
+    int active = p->ready_active_high ? 1 : 0;
+
+    gpio_config_t io = {
+        .pin_bit_mask = (1ULL << p->ready_gpio),
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_DISABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = p->ready_active_high ? GPIO_INTR_POSEDGE : GPIO_INTR_NEGEDGE,
+    };
+    gpio_config(&io);
+
+    esp_err_t err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "GPIO ISR service: %s", esp_err_to_name(err));
+        return false;
+    }
+
+    // Drop a notification left over from an earlier wait.
+    ulTaskNotifyTake(pdTRUE, 0);
+    gpio_isr_handler_add(pin, pg_seq_ready_isr, xTaskGetCurrentTaskHandle());
+
+    // The pin may already be active; the edge would then never come.
+    bool ready = (gpio_get_level(pin) == active);
+    int64_t now = esp_timer_get_time();
+    while (!ready && now < deadline_us) {
+        TickType_t ticks = pdMS_TO_TICKS((deadline_us - now + 999) / 1000);
+        ulTaskNotifyTake(pdTRUE, ticks > 0 ? ticks : 1);
+        ready = (gpio_get_level(pin) == active);
+        now = esp_timer_get_time();
+    }
+
+    gpio_isr_handler_remove(pin);
+    gpio_set_intr_type(pin, GPIO_INTR_DISABLE);
+    return ready;
+}
+
+/**
+ * @brief Probe the peripheral's I2C address until it ACKs.
+ *
+ * The bus driver exists only for the probe, so the pins are free for the
+ * application driver and for bus_safe afterwards.
+ *
+ * @param p Rail profile.
+ * @param deadline_us esp_timer time at which to give up.
+ * @return true if the address was ACKed before the deadline.
+ */
+static bool pg_seq_wait_i2c(const pg_rail_profile_t *p, int64_t deadline_us)
+{
+    i2c_master_bus_config_t bus_cfg = {
+        .i2c_port = I2C_NUM_0,
+        .sda_io_num = (gpio_num_t)p->i2c_sda_gpio,
+        .scl_io_num = (gpio_num_t)p->i2c_scl_gpio,
+        .clk_source = I2C_CLK_SRC_DEFAULT,
+        .glitch_ignore_cnt = 7,
+        .flags.enable_internal_pullup = true,
+    };
+    i2c_master_bus_handle_t bus;
+    esp_err_t err = i2c_new_master_bus(&bus_cfg, &bus);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "I2C bus for ready probe: %s", esp_err_to_name(err));
+        return false;
+    }
+
+    bool ready = false;
+    do {
+        if (i2c_master_probe(bus, p->i2c_addr, PG_SEQ_POLL_MS) == ESP_OK) {
+            ready = true;
+            break;
+        }
+        vTaskDelay(pdMS_TO_TICKS(PG_SEQ_POLL_MS));
+    } while (esp_timer_get_time() < deadline_us);
+
+    i2c_del_master_bus(bus);
+    return ready;
+}
+
+esp_err_t pg_seq_power_on(pg_rail_t *rail)
+{
+    if (rail == NULL || rail->profile.set_enabled == NULL) {
+        ESP_LOGE(TAG, "rail or set_enabled is NULL");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const pg_rail_profile_t *p = &rail->profile;
+
+    rail->on_since_us = esp_timer_get_time();
+    rail->powered = true;
+    rail->ready = false;
+    rail->ready_ms = 0;
+    rail->on_ms = 0;
+    p->set_enabled(true);
+
+    // Nothing answers before the rail is up.
+    if (p->turn_on_ms > 0) {
+        vTaskDelay(pdMS_TO_TICKS(p->turn_on_ms));
+    }
+
+    int64_t deadline_us = esp_timer_get_time() + (int64_t)p->settle_ms * 1000;
+
+    switch (p->ready_method) {
+        case PG_READY_GPIO:
+            rail->ready = pg_seq_wait_gpio(p, deadline_us);
+            break;
+        case PG_READY_I2C_ACK:
+            rail->ready = pg_seq_wait_i2c(p, deadline_us);
+            break;
+        case PG_READY_DELAY:
+        default:
+            if (p->settle_ms > 0) {
+                vTaskDelay(pdMS_TO_TICKS(p->settle_ms));
+            }
+            rail->ready = true;
+            break;
+    }
+
+    rail->ready_ms = pg_seq_elapsed_ms(rail->on_since_us);
+
+    if (!rail->ready) {
+        ESP_LOGW(TAG, "%s: not ready after %" PRIu32 " ms", p->name, rail->ready_ms);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    ESP_LOGI(TAG, "%s: ready after %" PRIu32 " ms (limit %" PRIu32 " ms)",
+             p->name, rail->ready_ms, p->turn_on_ms + p->settle_ms);
+    return ESP_OK;
+}
+
+void pg_seq_power_off(pg_rail_t *rail)
+{
+    if (rail == NULL || rail->profile.set_enabled == NULL) {
+        ESP_LOGE(TAG, "rail or set_enabled is NULL");
+        return;
+    }
+
+    const pg_rail_profile_t *p = &rail->profile;
+
+    // Bus pins must be high-Z before the peripheral loses power.
+    bus_safe_apply_before_power_off();
+    p->set_enabled(false);
+
+    if (rail->powered) {
+        rail->on_ms = pg_seq_elapsed_ms(rail->on_since_us);
+        rail->powered = false;
+        ESP_LOGI(TAG, "%s: on for %" PRIu32 " ms (%" PRIu32 " ms to ready)",
+                 p->name, rail->on_ms, rail->ready_ms);
+    }
+
+    if (p->turn_off_ms > 0) {
+        vTaskDelay(pdMS_TO_TICKS(p->turn_off_ms));
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** How the sequencer decides that a powered peripheral is ready. */
+typedef enum {
+    PG_READY_DELAY = 0,     /**< Fixed settle time, no feedback. */
+    PG_READY_GPIO = 1,      /**< Peripheral asserts a data-ready / ready pin. */
+    PG_READY_I2C_ACK = 2,   /**< Peripheral ACKs its I2C address. */
+} pg_ready_method_t;
+
+/**
+ * @brief Power-up and power-down profile of one gated rail.
+ */
+typedef struct {
+    const char *name;
+
+    /** Switches the rail; pg_set_enabled for the demo rail. */
+    void (*set_enabled)(bool enable);
+
+    /** Rail rise time. Readiness is not checked before it has passed. */
+    uint32_t turn_on_ms;
+
+    pg_ready_method_t ready_method;
+
+    /**
+     * PG_READY_DELAY: settle time after turn_on_ms.
+     * Other methods: longest wait for the ready signal after turn_on_ms.
+     */
+    uint32_t settle_ms;
+
+    /** PG_READY_GPIO: ready input and the level that means ready. */
+    int ready_gpio;
+    bool ready_active_high;
+
+    /** PG_READY_I2C_ACK: bus pins and 7-bit peripheral address. */
+    int i2c_scl_gpio;
+    int i2c_sda_gpio;
+    uint8_t i2c_addr;
+
+    /** Discharge time after the rail is switched off. */
+    uint32_t turn_off_ms;
+} pg_rail_profile_t;
+
+/**
+ * @brief One rail under sequencer control.
+ *
+ * The fields after the profile are written by the sequencer; treat them as
+ * read-only.
+ */
+typedef struct {
+    pg_rail_profile_t profile;
+
+    bool powered;
+    bool ready;
+    int64_t on_since_us;    /**< esp_timer time at which the rail was enabled. */
+    uint32_t ready_ms;      /**< Enable to ready, as measured this wake. */
+    uint32_t on_ms;         /**< Enable to disable, as measured this wake. */
+} pg_rail_t;
+
+/**
+ * @brief Power a rail up and wait until its peripheral is ready.
+ *
+ * Enables the rail, waits the turn-on time, then waits for the ready
+ * signal selected in the profile. The time to ready is measured and logged.
+ *
+ * The rail stays on when the peripheral does not become ready; the caller
+ * still calls pg_seq_power_off().
+ *
+ * @param rail Rail to power up.
+ * @return ESP_OK when the peripheral is ready,
+ *         ESP_ERR_TIMEOUT when it did not become ready within settle_ms,
+ *         ESP_ERR_INVALID_ARG for a NULL rail or missing set_enabled.
+ */
+esp_err_t pg_seq_power_on(pg_rail_t *rail);
+
+/**
+ * @brief Put the bus in a safe state, power the rail down and log its on-time.
+ *
+ * Calls bus_safe_apply_before_power_off() before the rail is switched off
+ * and waits the turn-off time afterwards. Deinitialize any bus driver that
+ * uses the bus pins before calling this.
+ *
+ * @param rail Rail to power down.
+ */
+void pg_seq_power_off(pg_rail_t *rail);
+
+#ifdef __cplusplus
+}
+#endif
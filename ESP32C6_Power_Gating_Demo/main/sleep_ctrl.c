@@ -15,6 +15,8 @@
 #include "esp_sleep.h"
 #include "esp_log.h"
 
+#include "energy_profiler.h"
+
 static const char *TAG = "sleep";
 
 /**
@@ -39,6 +41,9 @@ void sleep_ctrl_enter_deep_sleep(uint32_t wake_interval_s)
     // Timer wakeup.
     esp_sleep_enable_timer_wakeup(sleep_seconds_to_us(wake_interval_s));
 
+    // Close this cycle's energy accounting; the sleep is booked on the next wake.
+    energy_profiler_enter_sleep();
+
     // Enter deep sleep.
     ESP_LOGI(TAG, "Entering deep sleep now");
     esp_deep_sleep_start();
@@ -4,7 +4,10 @@
 #define APP_WIFI_PASSWORD        CONFIG_APP_WIFI_PASSWORD
 
 #define APP_OTA_FIRMWARE_URL     CONFIG_APP_OTA_FIRMWARE_URL
+#define APP_OTA_PATCH_URL        CONFIG_APP_OTA_PATCH_URL
 #define APP_OTA_TRIGGER_URL      CONFIG_APP_OTA_TRIGGER_URL
+#define APP_OTA_CHUNK_KB         CONFIG_APP_OTA_CHUNK_KB
+#define APP_OTA_RETRIES          CONFIG_APP_OTA_RETRIES
 
 #define APP_OTA_ALLOW_NO_TIME    CONFIG_APP_OTA_ALLOW_WITHOUT_TIME
 #define APP_OTA_MAINT_START_HOUR CONFIG_APP_OTA_MAINT_START_HOUR
@@ -1,10 +1,12 @@
+#include <string.h>
+
 #include "esp_log.h"
 #include "esp_secure_boot.h"
 #include "esp_flash_encrypt.h"
 #include "nvs_flash.h"
 
 #include "app_cfg.h"
-#include "wifi_station.h"
+#include "wifi_sta.h"
 #include "ota_manager.h"
 
 static const char *TAG = "app_main";
@@ -19,6 +21,37 @@ static void log_security_state(void)
     ESP_LOGI(TAG, "Flash Encryption enabled: %s", esp_flash_encryption_enabled() ? "YES" : "NO");
 }
 
+/**
+ * @brief Connect to the AP set in menuconfig
+ * 
+ * @return esp_err_t ESP_OK once an IP address is assigned, error code otherwise
+ */
+static esp_err_t wifi_start(void)
+{
+    if (strlen(APP_WIFI_SSID) == 0) {
+        ESP_LOGE(TAG, "CONFIG_APP_WIFI_SSID is empty. Set it in menuconfig.");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Power-save profile, listen interval and DTIM period come from the
+    // "Wi-Fi station" menu.
+    const wifi_sta_config_t cfg = {
+        .ssid = APP_WIFI_SSID,
+        .password = APP_WIFI_PASSWORD,
+        .max_retries = 10,
+    };
+    esp_err_t err = wifi_sta_init(&cfg);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    err = wifi_sta_connect(NULL, pdMS_TO_TICKS(20000));
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Wi-Fi connection did not complete");
+    }
+    return err;
+}
+
 /**
  * @brief Platform initialization
  * 
@@ -35,7 +68,7 @@ static void platform_init(void)
     }
 
     // Start Wi-Fi station. Wi-Fi station connect (SSID/password from menuconfig)
-    ESP_ERROR_CHECK(wifi_station_start());
+    ESP_ERROR_CHECK(wifi_start());
 }
 
 /**
@@ -0,0 +1,877 @@
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include "esp_log.h"
+#include "esp_err.h"
+#include "esp_app_desc.h"
+#include "esp_app_format.h"
+#include "esp_delta_ota.h"
+#include "esp_efuse.h"
+#include "esp_http_client.h"
+#include "esp_ota_ops.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+#include "nvs.h"
+
+#include "app_cfg.h"
+#include "ota_download.h"
+
+static const char *TAG = "ota_dl";
+
+#define OTA_CHUNK_SIZE          (APP_OTA_CHUNK_KB * 1024)
+#define OTA_CHUNK_COUNT         3           // one downloading, one writing, one spare
+#define OTA_HTTP_RX_BUFFER      4096
+#define OTA_READ_SIZE           8192        // bytes per esp_http_client_read()
+#define OTA_ERASE_BLOCK         (64 * 1024) // block erase is faster than 16 sector erases
+#define OTA_SECTOR_SIZE         4096
+#define OTA_SAVE_EVERY_BYTES    (64 * 1024)
+#define OTA_LOG_EVERY_BYTES     (128 * 1024)
+#define OTA_WRITE_ALIGN         16          // flash encryption block size
+#define OTA_RETRY_DELAY_MS      2000
+#define OTA_ETAG_MAX            64
+
+#define OTA_NVS_NAMESPACE       "ota_resume"
+#define OTA_NVS_KEY             "state"
+#define OTA_RESUME_VERSION      1
+
+/* Header written by esp_delta_ota_patch_gen.py in front of the detools patch. */
+#define OTA_PATCH_HEADER_SIZE   64
+#define OTA_PATCH_MAGIC         0xfccdde10
+#define OTA_PATCH_DIGEST_SIZE   32
+
+#define ALIGN_UP(x, a)          ((((x) + (a) - 1) / (a)) * (a))
+#define ALIGN_DOWN(x, a)        (((x) / (a)) * (a))
+
+/* Download progress kept in NVS between attempts and across reboots. */
+typedef struct {
+    uint32_t version;
+    uint32_t url_crc;
+    uint32_t partition_addr;
+    uint32_t image_size;
+    uint32_t written;           // bytes known to be in flash
+    char etag[OTA_ETAG_MAX];
+} ota_resume_state_t;
+
+typedef struct {
+    uint8_t *data;
+    uint32_t offset;            // image offset of data[0]
+    uint32_t len;
+} ota_chunk_t;
+
+typedef struct {
+    const esp_partition_t *partition;
+    esp_ota_handle_t handle;
+    QueueHandle_t free_q;
+    QueueHandle_t full_q;
+    TaskHandle_t owner;
+    ota_chunk_t chunks[OTA_CHUNK_COUNT];
+    ota_chunk_t *cur;           // chunk being filled
+    uint8_t *rx_buf;
+    ota_resume_state_t state;   // `written` belongs to the writer task once it runs
+    uint32_t rx_offset;         // next response body byte to request
+    uint32_t rx_total;          // response body size: image or patch
+    uint32_t out_offset;        // next image byte to hand to the writer
+    uint32_t erase_limit;
+    uint32_t erased_end;        // writer task only
+    uint32_t saved;             // writer task only
+    bool queued;                // a chunk has been handed to the writer
+    volatile esp_err_t writer_err;
+    esp_delta_ota_handle_t patcher;     // NULL for a full image download
+    uint8_t patch_header[OTA_PATCH_HEADER_SIZE];
+    uint32_t patch_header_len;
+    ota_download_stats_t stats; // erase_ms and write_ms belong to the writer task
+    esp_http_client_handle_t client;    // kept across attempts for TLS resumption
+} ota_pipeline_t;
+
+/* Response headers captured by the HTTP event handler. */
+typedef struct {
+    char etag[OTA_ETAG_MAX];
+    uint32_t range_start;
+    uint32_t range_total;
+} ota_response_t;
+
+/**
+ * @brief Load resume state that matches this URL and target partition
+ *
+ * @param state Output; zeroed when there is nothing to resume
+ * @param url_crc CRC32 of the firmware URL
+ * @param partition Target OTA partition
+ */
+static void ota_resume_load(ota_resume_state_t *state, uint32_t url_crc,
+                            const esp_partition_t *partition)
+{
+    ota_resume_state_t saved = {0};
+    size_t len = sizeof(saved);
+    nvs_handle_t nvs;
+
+    memset(state, 0, sizeof(*state));
+    state->version = OTA_RESUME_VERSION;
+    state->url_crc = url_crc;
+    state->partition_addr = partition->address;
+
+    if (nvs_open(OTA_NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK) {
+        return;
+    }
+    esp_err_t err = nvs_get_blob(nvs, OTA_NVS_KEY, &saved, &len);
+    nvs_close(nvs);
+
+    if (err != ESP_OK || len != sizeof(saved) ||
+        saved.version != OTA_RESUME_VERSION ||
+        saved.url_crc != url_crc ||
+        saved.partition_addr != partition->address ||
+        saved.image_size == 0 || saved.image_size > partition->size ||
+        saved.written == 0 || saved.written > saved.image_size) {
+        return;
+    }
+
+    *state = saved;
+    state->etag[OTA_ETAG_MAX - 1] = 0;
+
+    // A download that finished but was never verified re-fetches its last
+    // block, so at least one write reaches esp_ota_end() in this session.
+    if (state->written == state->image_size) {
+        state->written = state->image_size - 1;
+    }
+    state->written = ALIGN_DOWN(state->written, OTA_WRITE_ALIGN);
+}
+
+/**
+ * @brief Store resume state in NVS
+ *
+ * @param state State to store
+ */
+static void ota_resume_save(const ota_resume_state_t *state)
+{
+    nvs_handle_t nvs;
+    if (nvs_open(OTA_NVS_NAMESPACE, NVS_READWRITE, &nvs) != ESP_OK) {
+        return;
+    }
+    if (nvs_set_blob(nvs, OTA_NVS_KEY, state, sizeof(*state)) == ESP_OK) {
+        nvs_commit(nvs);
+    }
+    nvs_close(nvs);
+}
+
+/**
+ * @brief Forget any stored resume state
+ */
+static void ota_resume_clear(void)
+{
+    nvs_handle_t nvs;
+    if (nvs_open(OTA_NVS_NAMESPACE, NVS_READWRITE, &nvs) != ESP_OK) {
+        return;
+    }
+    if (nvs_erase_key(nvs, OTA_NVS_KEY) == ESP_OK) {
+        nvs_commit(nvs);
+    }
+    nvs_close(nvs);
+}
+
+/**
+ * @brief Capture the ETag and Content-Range response headers
+ *
+ * @param evt HTTP client event
+ * @return esp_err_t Always ESP_OK
+ */
+static esp_err_t ota_http_event(esp_http_client_event_t *evt)
+{
+    ota_response_t *resp = (ota_response_t *)evt->user_data;
+    if (evt->event_id != HTTP_EVENT_ON_HEADER || !resp) {
+        return ESP_OK;
+    }
+
+    if (strcasecmp(evt->header_key, "ETag") == 0) {
+        strlcpy(resp->etag, evt->header_value, sizeof(resp->etag));
+    } else if (strcasecmp(evt->header_key, "Content-Range") == 0) {
+        // Format: "bytes <start>-<end>/<total>"
+        const char *start = strchr(evt->header_value, ' ');
+        const char *total = strchr(evt->header_value, '/');
+        if (start && total) {
+            resp->range_start = (uint32_t)strtoul(start + 1, NULL, 10);
+            resp->range_total = (uint32_t)strtoul(total + 1, NULL, 10);
+        }
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Reject images for another chip or with a revoked secure version
+ *
+ * Runs on the first chunk, so a wrong image is refused before the download
+ * continues. esp_ota_end() still verifies the complete image.
+ *
+ * @param data First bytes of the image
+ * @param len Number of bytes available
+ * @return esp_err_t ESP_OK if the image may be installed
+ */
+static esp_err_t ota_check_image_header(const uint8_t *data, uint32_t len)
+{
+    const size_t desc_offset = sizeof(esp_image_header_t) + sizeof(esp_image_segment_header_t);
+    esp_image_header_t header;
+    esp_app_desc_t desc;
+
+    if (len < desc_offset + sizeof(desc)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    memcpy(&header, data, sizeof(header));
+    memcpy(&desc, data + desc_offset, sizeof(desc));
+
+    if (header.magic != ESP_IMAGE_HEADER_MAGIC || header.chip_id != CONFIG_IDF_FIRMWARE_CHIP_ID ||
+        desc.magic_word != ESP_APP_DESC_MAGIC_WORD) {
+        ESP_LOGE(TAG, "Not a firmware image for this chip");
+        return ESP_ERR_OTA_VALIDATE_FAILED;
+    }
+
+    ESP_LOGI(TAG, "Incoming firmware %s (secure version %" PRIu32 ")",
+             desc.version, (uint32_t)desc.secure_version);
+
+#ifdef CONFIG_BOOTLOADER_APP_ANTI_ROLLBACK
+    if (!esp_efuse_check_secure_version(desc.secure_version)) {
+        ESP_LOGE(TAG, "Secure version is lower than the eFuse value");
+        return ESP_ERR_OTA_SMALL_SEC_VER;
+    }
+#endif
+    return ESP_OK;
+}
+
+/**
+ * @brief Reject a patch that was not built against the running firmware
+ *
+ * @param header Patch header
+ * @return esp_err_t ESP_OK if the patch applies to the running partition
+ */
+static esp_err_t ota_check_patch_header(const uint8_t *header)
+{
+    uint32_t magic;
+    uint8_t digest[OTA_PATCH_DIGEST_SIZE];
+
+    memcpy(&magic, header, sizeof(magic));
+    if (magic != OTA_PATCH_MAGIC) {
+        ESP_LOGE(TAG, "Not a delta patch");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t err = esp_partition_get_sha256(esp_ota_get_running_partition(), digest);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (memcmp(digest, header + sizeof(magic), sizeof(digest)) != 0) {
+        ESP_LOGW(TAG, "Patch was built for different base firmware");
+        return ESP_ERR_INVALID_VERSION;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Erase flash up to one block past the end of the next write
+ *
+ * Staying a block ahead means the following chunk normally finds its
+ * sectors already erased.
+ *
+ * @param p Pipeline state
+ * @param end Image offset just past the data about to be written
+ * @return esp_err_t ESP_OK on success
+ */
+static esp_err_t ota_erase_ahead(ota_pipeline_t *p, uint32_t end)
+{
+    uint32_t target = ALIGN_UP(end, OTA_ERASE_BLOCK) + OTA_ERASE_BLOCK;
+    if (target > p->erase_limit) {
+        target = p->erase_limit;
+    }
+    if (target <= p->erased_end) {
+        return ESP_OK;
+    }
+
+    int64_t t0 = esp_timer_get_time();
+    esp_err_t err = esp_partition_erase_range(p->partition, p->erased_end, target - p->erased_end);
+    p->stats.erase_ms += (uint32_t)((esp_timer_get_time() - t0) / 1000);
+    if (err == ESP_OK) {
+        p->erased_end = target;
+    }
+    return err;
+}
+
+/**
+ * @brief Writer task: erase ahead and write chunks while the next one downloads
+ *
+ * A NULL chunk ends the task. After an error the remaining chunks are
+ * returned unwritten so the downloader never blocks.
+ *
+ * @param arg Pipeline state
+ */
+static void ota_writer_task(void *arg)
+{
+    ota_pipeline_t *p = (ota_pipeline_t *)arg;
+    ota_chunk_t *chunk = NULL;
+
+    while (xQueueReceive(p->full_q, &chunk, portMAX_DELAY) == pdTRUE && chunk) {
+        if (p->writer_err == ESP_OK) {
+            esp_err_t err = ota_erase_ahead(p, chunk->offset + chunk->len);
+            if (err == ESP_OK) {
+                int64_t t0 = esp_timer_get_time();
+                err = esp_ota_write_with_offset(p->handle, chunk->data, chunk->len, chunk->offset);
+                p->stats.write_ms += (uint32_t)((esp_timer_get_time() - t0) / 1000);
+            }
+            if (err == ESP_OK) {
+                p->state.written = chunk->offset + chunk->len;
+                // A delta download cannot resume, so only full images save progress.
+                if (!p->patcher && p->state.written - p->saved >= OTA_SAVE_EVERY_BYTES) {
+                    ota_resume_save(&p->state);
+                    p->saved = p->state.written;
+                }
+            } else {
+                ESP_LOGE(TAG, "Flash write at 0x%" PRIx32 " failed: %s",
+                         chunk->offset, esp_err_to_name(err));
+                p->writer_err = err;
+            }
+        }
+        xQueueSend(p->free_q, &chunk, portMAX_DELAY);
+    }
+
+    xTaskNotifyGive(p->owner);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Hand the current chunk to the writer
+ *
+ * The chunk holding the start of the image is checked first.
+ *
+ * @param p Pipeline state
+ * @return esp_err_t ESP_OK on success
+ */
+static esp_err_t ota_submit(ota_pipeline_t *p)
+{
+    if (p->cur->offset == 0) {
+        esp_err_t err = ota_check_image_header(p->cur->data, p->cur->len);
+        if (err != ESP_OK) {
+            p->cur->len = 0;
+            return err;
+        }
+    }
+
+    xQueueSend(p->full_q, &p->cur, portMAX_DELAY);
+    p->queued = true;
+    p->cur = NULL;
+    return ESP_OK;
+}
+
+/**
+ * @brief Append image bytes to the current chunk, submitting full chunks
+ *
+ * @param p Pipeline state
+ * @param data Image bytes
+ * @param len Number of bytes
+ * @return esp_err_t ESP_OK on success
+ */
+static esp_err_t ota_emit(ota_pipeline_t *p, const uint8_t *data, uint32_t len)
+{
+    while (len > 0) {
+        if (p->writer_err != ESP_OK) {
+            return p->writer_err;
+        }
+
+        if (!p->cur) {
+            xQueueReceive(p->free_q, &p->cur, portMAX_DELAY);
+            p->cur->offset = p->out_offset;
+            p->cur->len = 0;
+        }
+
+        uint32_t n = OTA_CHUNK_SIZE - p->cur->len;
+        if (n > len) {
+            n = len;
+        }
+        if (p->out_offset + n > p->partition->size) {
+            ESP_LOGE(TAG, "Image does not fit the OTA partition");
+            return ESP_ERR_INVALID_SIZE;
+        }
+
+        memcpy(p->cur->data + p->cur->len, data, n);
+        p->cur->len += n;
+        p->out_offset += n;
+        data += n;
+        len -= n;
+
+        if (p->cur->len == OTA_CHUNK_SIZE) {
+            esp_err_t err = ota_submit(p);
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Patcher output callback: bytes of the new image
+ */
+static esp_err_t ota_patch_write(const uint8_t *buf, size_t size, void *user_data)
+{
+    return ota_emit((ota_pipeline_t *)user_data, buf, (uint32_t)size);
+}
+
+/**
+ * @brief Patcher input callback: bytes of the running firmware
+ */
+static esp_err_t ota_base_read(uint8_t *buf, size_t size, int src_offset)
+{
+    return esp_partition_read(esp_ota_get_running_partition(), (size_t)src_offset, buf, size);
+}
+
+/**
+ * @brief Pass response body bytes to the image or to the patcher
+ *
+ * @param p Pipeline state
+ * @param data Body bytes
+ * @param len Number of bytes
+ * @return esp_err_t ESP_OK on success; any error is fatal for this download
+ */
+static esp_err_t ota_consume(ota_pipeline_t *p, const uint8_t *data, uint32_t len)
+{
+    if (!p->patcher) {
+        return ota_emit(p, data, len);
+    }
+
+    if (p->patch_header_len < OTA_PATCH_HEADER_SIZE) {
+        uint32_t n = OTA_PATCH_HEADER_SIZE - p->patch_header_len;
+        if (n > len) {
+            n = len;
+        }
+        memcpy(p->patch_header + p->patch_header_len, data, n);
+        p->patch_header_len += n;
+        data += n;
+        len -= n;
+
+        if (p->patch_header_len == OTA_PATCH_HEADER_SIZE) {
+            esp_err_t err = ota_check_patch_header(p->patch_header);
+            if (err != ESP_OK) {
+                return err;
+            }
+        }
+    }
+
+    if (len == 0) {
+        return ESP_OK;
+    }
+    return esp_delta_ota_feed_patch(p->patcher, data, (int)len);
+}
+
+/**
+ * @brief Download the response body from `p->rx_offset` to its end
+ *
+ * A partly filled chunk stays in `p->cur`, so the next attempt continues
+ * filling it. The connection is closed afterwards; the client keeps the
+ * TLS session, so the next attempt resumes it instead of a full handshake.
+ *
+ * @param p Pipeline state
+ * @param fatal Set when retrying cannot help
+ * @return esp_err_t ESP_OK once the whole body has been received
+ */
+static esp_err_t ota_fetch(ota_pipeline_t *p, bool *fatal)
+{
+    esp_http_client_handle_t client = p->client;
+    ota_response_t resp = {0};
+    esp_http_client_set_user_data(client, &resp);
+
+    // Ask for the rest of the body. If-Range makes the server send the
+    // whole file instead when it has changed since the first request.
+    char range[32];
+    esp_http_client_delete_header(client, "Range");
+    esp_http_client_delete_header(client, "If-Range");
+    if (p->rx_offset > 0) {
+        snprintf(range, sizeof(range), "bytes=%" PRIu32 "-", p->rx_offset);
+        esp_http_client_set_header(client, "Range", range);
+        if (p->state.etag[0]) {
+            esp_http_client_set_header(client, "If-Range", p->state.etag);
+        }
+    }
+
+    int64_t t0 = esp_timer_get_time();
+    esp_err_t err = esp_http_client_open(client, 0);
+    if (p->stats.attempts++ == 0) {
+        p->stats.connect_ms = (uint32_t)((esp_timer_get_time() - t0) / 1000);
+    }
+    if (err != ESP_OK) {
+        esp_http_client_close(client);
+        return err;
+    }
+
+    int64_t content_length = esp_http_client_fetch_headers(client);
+    int status = esp_http_client_get_status_code(client);
+
+    if (content_length < 0) {
+        ESP_LOGW(TAG, "No response from server");
+        err = ESP_FAIL;
+    } else if (status == 206 && p->rx_offset > 0) {
+        if (resp.range_start != p->rx_offset || resp.range_total != p->rx_total) {
+            ESP_LOGE(TAG, "Range response does not match the stored download");
+            *fatal = true;
+            err = ESP_ERR_INVALID_RESPONSE;
+        }
+    } else if (status == 200) {
+        if (p->rx_offset > 0) {
+            if (p->queued || p->patcher) {
+                // Data from the old file is already in the pipeline.
+                ESP_LOGE(TAG, "File changed on the server during download");
+                *fatal = true;
+                err = ESP_ERR_INVALID_RESPONSE;
+            } else {
+                ESP_LOGW(TAG, "Server sent the whole image, restarting from 0");
+                p->rx_offset = 0;
+                p->out_offset = 0;
+                p->state.written = 0;
+                p->erased_end = 0;
+                p->saved = 0;
+                if (p->cur) {
+                    p->cur->offset = 0;
+                    p->cur->len = 0;
+                }
+            }
+        }
+        if (err == ESP_OK) {
+            if (content_length <= 0 || content_length > (int64_t)p->partition->size) {
+                ESP_LOGE(TAG, "Invalid download size %" PRId64, content_length);
+                *fatal = true;
+                err = ESP_ERR_INVALID_SIZE;
+            } else {
+                p->rx_total = (uint32_t)content_length;
+                strlcpy(p->state.etag, resp.etag, sizeof(p->state.etag));
+                if (!p->patcher) {
+                    p->state.image_size = p->rx_total;
+                    p->erase_limit = ALIGN_UP(p->rx_total, OTA_SECTOR_SIZE);
+                }
+            }
+        }
+    } else {
+        ESP_LOGE(TAG, "HTTP status %d", status);
+        *fatal = (status < 500);
+        err = ESP_FAIL;
+    }
+
+    while (err == ESP_OK && p->rx_offset < p->rx_total) {
+        uint32_t want = p->rx_total - p->rx_offset;
+        if (want > OTA_READ_SIZE) {
+            want = OTA_READ_SIZE;
+        }
+
+        int r = esp_http_client_read(client, (char *)p->rx_buf, (int)want);
+        if (r <= 0) {
+            ESP_LOGW(TAG, "Connection lost at %" PRIu32 "/%" PRIu32 " bytes",
+                     p->rx_offset, p->rx_total);
+            err = ESP_FAIL;
+            break;
+        }
+
+        p->rx_offset += (uint32_t)r;
+        p->stats.bytes += (uint32_t)r;
+        if (p->rx_offset / OTA_LOG_EVERY_BYTES != (p->rx_offset - (uint32_t)r) / OTA_LOG_EVERY_BYTES) {
+            ESP_LOGI(TAG, "Downloaded %" PRIu32 "/%" PRIu32 " bytes", p->rx_offset, p->rx_total);
+        }
+
+        err = ota_consume(p, p->rx_buf, (uint32_t)r);
+        if (err != ESP_OK) {
+            *fatal = true;
+        }
+    }
+
+    esp_http_client_close(client);
+    return err;
+}
+
+/**
+ * @brief Create the HTTP client used for every attempt of one download
+ *
+ * @param url HTTPS URL of the image or patch
+ * @param cert_pem Pinned server certificate
+ * @return esp_http_client_handle_t Client, or NULL when out of memory
+ */
+static esp_http_client_handle_t ota_client_create(const char *url, const char *cert_pem)
+{
+    esp_http_client_config_t http_cfg = {
+        .url = url,
+        .cert_pem = cert_pem,
+        .timeout_ms = 15000,
+        .keep_alive_enable = true,
+        .buffer_size = OTA_HTTP_RX_BUFFER,
+        .event_handler = ota_http_event,
+#if CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
+        .save_client_session = true,
+#endif
+    };
+    return esp_http_client_init(&http_cfg);
+}
+
+/**
+ * @brief Allocate buffers and queues and start the writer task
+ *
+ * @param p Pipeline state
+ * @return esp_err_t ESP_OK on success
+ */
+static esp_err_t ota_pipeline_start(ota_pipeline_t *p)
+{
+    p->free_q = xQueueCreate(OTA_CHUNK_COUNT, sizeof(ota_chunk_t *));
+    p->full_q = xQueueCreate(OTA_CHUNK_COUNT + 1, sizeof(ota_chunk_t *));
+    p->rx_buf = malloc(OTA_READ_SIZE);
+    if (!p->free_q || !p->full_q || !p->rx_buf) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    for (int i = 0; i < OTA_CHUNK_COUNT; i++) {
+        ota_chunk_t *chunk = &p->chunks[i];
+        chunk->data = malloc(OTA_CHUNK_SIZE);
+        if (!chunk->data) {
+            return ESP_ERR_NO_MEM;
+        }
+        xQueueSend(p->free_q, &chunk, 0);
+    }
+
+    p->owner = xTaskGetCurrentTaskHandle();
+    BaseType_t ok = xTaskCreate(ota_writer_task, "ota_writer", 4096, p, 6, NULL);
+    return (ok == pdPASS) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+/**
+ * @brief Free the HTTP client, patcher, buffers and queues
+ *
+ * @param p Pipeline state; the writer task must have exited
+ */
+static void ota_pipeline_free(ota_pipeline_t *p)
+{
+    if (p->client) {
+        esp_http_client_cleanup(p->client);
+    }
+    if (p->patcher) {
+        esp_delta_ota_deinit(p->patcher);
+    }
+    for (int i = 0; i < OTA_CHUNK_COUNT; i++) {
+        free(p->chunks[i].data);
+    }
+    free(p->rx_buf);
+    if (p->free_q) {
+        vQueueDelete(p->free_q);
+    }
+    if (p->full_q) {
+        vQueueDelete(p->full_q);
+    }
+    free(p);
+}
+
+/**
+ * @brief Prepare the pipeline for a full image, resuming stored progress
+ *
+ * @param p Pipeline state
+ * @param url Firmware HTTPS URL
+ */
+static void ota_prepare_full(ota_pipeline_t *p, const char *url)
+{
+    uint32_t url_crc = esp_rom_crc32_le(0, (const uint8_t *)url, strlen(url));
+    ota_resume_load(&p->state, url_crc, p->partition);
+
+    p->rx_offset = p->state.written;
+    p->out_offset = p->state.written;
+    p->rx_total = p->state.image_size;
+    p->erase_limit = ALIGN_UP(p->state.image_size, OTA_SECTOR_SIZE);
+
+    // Everything below `written` is in flash and its erase block was erased
+    // before the first write, so erasing resumes at the next block.
+    p->erased_end = ALIGN_UP(p->state.written, OTA_ERASE_BLOCK);
+    if (p->erased_end > p->erase_limit) {
+        p->erased_end = p->erase_limit;
+    }
+    p->saved = p->state.written;
+
+    if (p->rx_offset > 0) {
+        ESP_LOGI(TAG, "Resuming download at %" PRIu32 "/%" PRIu32 " bytes",
+                 p->rx_offset, p->rx_total);
+    }
+}
+
+/**
+ * @brief Prepare the pipeline for a patch against the running firmware
+ *
+ * @param p Pipeline state
+ * @return esp_err_t ESP_OK on success
+ */
+static esp_err_t ota_prepare_delta(ota_pipeline_t *p)
+{
+    esp_delta_ota_cfg_t cfg = {
+        .user_data = p,
+        .read_cb = ota_base_read,
+        .write_cb = ota_patch_write,
+    };
+
+    p->patcher = esp_delta_ota_init(&cfg);
+    if (!p->patcher) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    // The patched image overwrites whatever a paused full download left.
+    ota_resume_clear();
+    p->erase_limit = p->partition->size;
+    return ESP_OK;
+}
+
+/**
+ * @brief Download, write and verify an image or patch
+ *
+ * @param url HTTPS URL of the image or patch
+ * @param cert_pem Pinned server certificate
+ * @param delta true if `url` serves a patch against the running firmware
+ * @return esp_err_t ESP_OK when the new image is selected for boot
+ */
+static esp_err_t ota_run(const char *url, const char *cert_pem, bool delta,
+                         ota_download_stats_t *stats)
+{
+    if (stats) {
+        memset(stats, 0, sizeof(*stats));
+    }
+
+    ota_pipeline_t *p = calloc(1, sizeof(*p));
+    if (!p) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    p->partition = esp_ota_get_next_update_partition(NULL);
+    if (!p->partition) {
+        free(p);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    esp_err_t err = ESP_OK;
+    if (delta) {
+        err = ota_prepare_delta(p);
+    } else {
+        ota_prepare_full(p, url);
+    }
+    if (err == ESP_OK) {
+        p->client = ota_client_create(url, cert_pem);
+        err = p->client ? ESP_OK : ESP_ERR_NO_MEM;
+    }
+    if (err != ESP_OK) {
+        ota_pipeline_free(p);
+        return err;
+    }
+
+    // Sequential-write mode skips the up-front erase; the writer task erases.
+    err = esp_ota_begin(p->partition, OTA_WITH_SEQUENTIAL_WRITES, &p->handle);
+    if (err != ESP_OK) {
+        ota_pipeline_free(p);
+        return err;
+    }
+
+    err = ota_pipeline_start(p);
+    if (err != ESP_OK) {
+        esp_ota_abort(p->handle);
+        ota_pipeline_free(p);
+        return err;
+    }
+
+    int64_t start_us = esp_timer_get_time();
+    bool fatal = false;
+
+    for (int attempt = 1; attempt <= APP_OTA_RETRIES; attempt++) {
+        err = ota_fetch(p, &fatal);
+        if (err == ESP_OK || fatal || attempt == APP_OTA_RETRIES) {
+            break;
+        }
+        ESP_LOGW(TAG, "Download attempt %d/%d failed: %s", attempt, APP_OTA_RETRIES,
+                 esp_err_to_name(err));
+        vTaskDelay(pdMS_TO_TICKS(OTA_RETRY_DELAY_MS));
+    }
+    p->stats.download_ms = (uint32_t)((esp_timer_get_time() - start_us) / 1000);
+
+    // The patcher holds back output until the whole patch is applied.
+    if (err == ESP_OK && p->patcher) {
+        err = esp_delta_ota_finalize(p->patcher);
+        fatal = (err != ESP_OK);
+    }
+    if (err == ESP_OK && p->cur && p->cur->len > 0) {
+        err = ota_submit(p);
+        fatal = (err != ESP_OK);
+    }
+
+    // Hand over a partly filled chunk. After a failure only whole
+    // encryption blocks of a resumable download are kept, so the resume
+    // offset stays aligned.
+    if (p->cur) {
+        if (err != ESP_OK) {
+            p->cur->len = (fatal || p->patcher) ? 0 : ALIGN_DOWN(p->cur->len, OTA_WRITE_ALIGN);
+        }
+        xQueueSend(p->cur->len ? p->full_q : p->free_q, &p->cur, portMAX_DELAY);
+        p->cur = NULL;
+    }
+
+    ota_chunk_t *end_marker = NULL;
+    xQueueSend(p->full_q, &end_marker, portMAX_DELAY);
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    if (err == ESP_OK && p->writer_err != ESP_OK) {
+        err = p->writer_err;
+        fatal = true;
+    }
+
+    if (err != ESP_OK) {
+        esp_ota_abort(p->handle);
+        if (!delta) {
+            if (fatal) {
+                ota_resume_clear();
+            } else if (p->state.written > 0) {
+                ota_resume_save(&p->state);
+                ESP_LOGW(TAG, "Download paused at %" PRIu32 "/%" PRIu32 " bytes",
+                         p->state.written, p->state.image_size);
+            }
+        }
+        if (stats) {
+            *stats = p->stats;
+        }
+        ota_pipeline_free(p);
+        return fatal ? err : ESP_ERR_TIMEOUT;
+    }
+
+    // Verifies the whole image, including the Secure Boot signature, so an
+    // image stitched from several sessions or rebuilt from a patch is
+    // checked end to end.
+    int64_t verify_start_us = esp_timer_get_time();
+    err = esp_ota_end(p->handle);
+    p->stats.verify_ms = (uint32_t)((esp_timer_get_time() - verify_start_us) / 1000);
+    if (err == ESP_OK) {
+        err = esp_ota_set_boot_partition(p->partition);
+    }
+    if (!delta) {
+        ota_resume_clear();
+    }
+
+    if (err == ESP_OK) {
+        int64_t elapsed_ms = (esp_timer_get_time() - start_us) / 1000;
+        ESP_LOGI(TAG, "Downloaded %" PRIu32 " bytes for a %" PRIu32 " byte image in %" PRId64 " ms",
+                 p->stats.bytes, p->out_offset, elapsed_ms);
+    } else {
+        ESP_LOGE(TAG, "Image rejected: %s", esp_err_to_name(err));
+    }
+
+    if (stats) {
+        *stats = p->stats;
+    }
+    ota_pipeline_free(p);
+    return err;
+}
+
+esp_err_t ota_download_run(const char *url, const char *cert_pem, ota_download_stats_t *stats)
+{
+    return ota_run(url, cert_pem, false, stats);
+}
+
+esp_err_t ota_download_delta_run(const char *patch_url, const char *cert_pem,
+                                 ota_download_stats_t *stats)
+{
+    return ota_run(patch_url, cert_pem, true, stats);
+}
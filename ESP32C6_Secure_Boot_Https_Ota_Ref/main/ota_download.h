@@ -0,0 +1,60 @@
+#pragma once
+#include <stdint.h>
+#include "esp_err.h"
+
+/* Timing of one download, filled in by the run functions below. */
+typedef struct {
+    uint32_t attempts;      // HTTP connections opened
+    uint32_t connect_ms;    // first connection: DNS, TCP and TLS handshake
+    uint32_t bytes;         // response body bytes received in this call
+    uint32_t download_ms;   // first request to last byte, including retries
+    uint32_t erase_ms;      // flash erase time in the writer task
+    uint32_t write_ms;      // flash write time in the writer task
+    uint32_t verify_ms;     // esp_ota_end(): image and signature check
+} ota_download_stats_t;
+
+/*
+ * ota_download_run
+ *
+ * Downloads the firmware image at `url` into the next OTA partition and
+ * makes it the boot partition. The TLS connection is pinned to `cert_pem`.
+ *
+ * The download uses HTTP Range requests, so a dropped connection resumes
+ * where it stopped instead of starting over. Progress is stored in NVS,
+ * so a later call (also after a reboot) continues the same image as long
+ * as the URL, image size and ETag are unchanged. Flash erase and write run
+ * in a separate writer task while the next chunk downloads.
+ *
+ * The complete image is verified (including the Secure Boot signature)
+ * before the boot partition is changed. The caller restarts the device.
+ * If `stats` is not NULL it receives the timing of this call.
+ *
+ * Returns:
+ *   ESP_OK when the new image is verified and selected for the next boot,
+ *   otherwise an error code. Progress is kept for the next call unless the
+ *   image was rejected or could not be written.
+ */
+esp_err_t ota_download_run(const char *url, const char *cert_pem, ota_download_stats_t *stats);
+
+/*
+ * ota_download_delta_run
+ *
+ * Downloads a binary patch from `patch_url` and applies it against the
+ * running firmware, streaming the rebuilt image into the next OTA
+ * partition. The patch is produced by esp_delta_ota_patch_gen.py from the
+ * signed image that is currently running and the new signed image.
+ *
+ * The patch header names the base firmware by its SHA-256; a patch for a
+ * different base is refused before anything is written. The rebuilt image
+ * goes through the same verification as a full download. A dropped
+ * connection resumes within the call, but nothing is kept across calls.
+ * `stats` works as for ota_download_run().
+ *
+ * Returns:
+ *   ESP_OK when the new image is verified and selected for the next boot,
+ *   ESP_ERR_TIMEOUT when the server could not be reached or the connection
+ *   kept dropping, otherwise the error that ruled out this patch
+ *   (ESP_ERR_INVALID_VERSION for a patch against other firmware).
+ */
+esp_err_t ota_download_delta_run(const char *patch_url, const char *cert_pem,
+                                 ota_download_stats_t *stats);
@@ -1,3 +1,4 @@
+#include <inttypes.h>
 #include <string.h>
 #include <sys/socket.h>
 #include <netdb.h>
@@ -10,20 +11,66 @@
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_system.h"
-#include "esp_https_ota.h"
+#include "esp_timer.h"
+#include "esp_app_desc.h"
 #include "esp_http_client.h"
 #include "driver/gpio.h"
 #include "esp_sntp.h"
 #include "esp_netif_sntp.h"
 
 #include "app_cfg.h"
+#include "ota_download.h"
 #include "ota_manager.h"
+#include "wifi_sta.h"
 
 static const char *TAG = "ota_mgr";
 
 extern const char server_root_cert_pem_start[] asm("_binary_server_root_cert_pem_start");
 extern const char server_root_cert_pem_end[]   asm("_binary_server_root_cert_pem_end");
 
+#define OTA_REPORT_VERSION 1
+
+/* Why a requested update did not start. */
+typedef enum {
+    OTA_DEFER_NONE = 0,
+    OTA_DEFER_WINDOW,
+    OTA_DEFER_BATTERY,
+    OTA_DEFER_NETWORK,
+} ota_defer_reason_t;
+
+typedef enum {
+    OTA_REPORT_DEFERRED = 1,
+    OTA_REPORT_DELTA,
+    OTA_REPORT_FULL,
+} ota_report_event_t;
+
+/* Telemetry POSTed to the trigger URL; little-endian, 44 bytes. */
+typedef struct __attribute__((packed)) {
+    uint8_t version;            // OTA_REPORT_VERSION
+    uint8_t event;              // ota_report_event_t
+    uint8_t defer_reason;       // latest ota_defer_reason_t
+    uint8_t attempts;           // HTTP connections of the download
+    int32_t result;             // esp_err_t of the download, 0 for a deferral
+    uint16_t deferred_window;   // deferrals since the last report
+    uint16_t deferred_battery;
+    uint16_t deferred_network;
+    uint16_t battery_mv;
+    uint16_t dns_ms;            // from the last readiness check
+    uint16_t tcp_ms;
+    uint32_t connect_ms;        // first download connection, including TLS
+    uint32_t bytes;
+    uint32_t bytes_per_s;
+    uint32_t download_ms;
+    uint32_t flash_ms;          // erase and write
+    uint32_t verify_ms;
+} ota_report_t;
+
+_Static_assert(sizeof(ota_report_t) == 44, "report layout is part of the server protocol");
+
+static ota_report_t s_report;
+static esp_http_client_handle_t s_trigger_client;
+static ota_defer_reason_t s_defer_reported = OTA_DEFER_NONE;
+
 /**
  * @brief Parse HTTPS host from URL
  * 
@@ -144,6 +191,46 @@ static bool ota_button_pressed(void)
     return (level1 == 0) && (level2 == 0);
 }
 
+/**
+ * @brief Capture the first body byte of a trigger poll
+ *
+ * @param evt HTTP client event
+ * @return esp_err_t Always ESP_OK
+ */
+static esp_err_t trigger_http_event(esp_http_client_event_t *evt)
+{
+    char *reply = (char *)evt->user_data;
+    if (evt->event_id == HTTP_EVENT_ON_DATA && reply && *reply == 0 && evt->data_len > 0) {
+        *reply = ((const char *)evt->data)[0];
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Get the client shared by trigger polls and reports
+ *
+ * @return esp_http_client_handle_t Client, or NULL when out of memory
+ */
+static esp_http_client_handle_t trigger_client(void)
+{
+    // Keep-alive reuses the connection between polls. When the server has
+    // closed it, the saved TLS session avoids a full handshake.
+    if (!s_trigger_client) {
+        esp_http_client_config_t cfg = {
+            .url = APP_OTA_TRIGGER_URL,
+            .cert_pem = server_root_cert_pem_start,
+            .timeout_ms = 5000,
+            .keep_alive_enable = true,
+            .event_handler = trigger_http_event,
+#if CONFIG_ESP_TLS_CLIENT_SESSION_TICKETS
+            .save_client_session = true,
+#endif
+        };
+        s_trigger_client = esp_http_client_init(&cfg);
+    }
+    return s_trigger_client;
+}
+
 /** 
  * @brief Check if cloud trigger requests OTA 
  * 
@@ -156,34 +243,24 @@ static bool cloud_trigger_requested(void)
         return false;
     }
 
-    const char *cert_pem = server_root_cert_pem_start;
-    esp_http_client_config_t cfg = {
-        .url = APP_OTA_TRIGGER_URL,
-        .cert_pem = cert_pem,
-        .timeout_ms = 5000,
-    };
-
-    esp_http_client_handle_t client = esp_http_client_init(&cfg);
+    esp_http_client_handle_t client = trigger_client();
     if (!client) {
         return false;
     }
 
-    bool requested = false;
-    if (esp_http_client_open(client, 0) == ESP_OK) {
-        char buf[8] = {0};
-        int r = esp_http_client_read(client, buf, sizeof(buf) - 1);
-        if (r > 0 && buf[0] == '1') {
-            requested = true;
-        }
-        esp_http_client_close(client);
-    }
-    esp_http_client_cleanup(client);
-    return requested;
+    char reply = 0;
+    esp_http_client_set_user_data(client, &reply);
+    esp_http_client_set_method(client, HTTP_METHOD_GET);
+    esp_err_t err = esp_http_client_perform(client);
+    esp_http_client_set_user_data(client, NULL);
+    return (err == ESP_OK) && (reply == '1');
 }
 
 /** 
  * @brief Check if network is ready for OTA 
  * 
+ * Records DNS and TCP connect times in the pending report.
+ * 
  * @param https_url Firmware HTTPS URL
  * @return true if ready, false otherwise 
  */
@@ -208,7 +285,11 @@ static bool network_ready_check(const char *https_url)
     };
     struct addrinfo *res = NULL;
 
+    int64_t t0 = esp_timer_get_time();
     int err = getaddrinfo(host, "443", &hints, &res);
+    int64_t t1 = esp_timer_get_time();
+    s_report.dns_ms = (uint16_t)((t1 - t0) / 1000);
+    s_report.tcp_ms = 0;
     if (err != 0 || !res) {
         return false;
     }
@@ -223,12 +304,135 @@ static bool network_ready_check(const char *https_url)
     if (connect(s, res->ai_addr, res->ai_addrlen) == 0) {
         ok = true;
     }
+    s_report.tcp_ms = (uint16_t)((esp_timer_get_time() - t1) / 1000);
 
     close(s);
     freeaddrinfo(res);
     return ok;
 }
 
+/**
+ * @brief Send the pending report and start a new one
+ *
+ * @param event What the report describes
+ */
+static void ota_report_send(ota_report_event_t event)
+{
+    // Logs the report and POSTs it to the optional trigger URL. Counters
+    // are kept for the next report if delivery fails.
+    ota_report_t r = s_report;
+    r.version = OTA_REPORT_VERSION;
+    r.event = (uint8_t)event;
+
+    ESP_LOGI(TAG, "Report %d: defer %d (w%u b%u n%u) dns %u ms tcp %u ms connect %" PRIu32
+             " ms, %" PRIu32 " B at %" PRIu32 " B/s, flash %" PRIu32 " ms, verify %" PRIu32 " ms",
+             r.event, r.defer_reason, r.deferred_window, r.deferred_battery, r.deferred_network,
+             r.dns_ms, r.tcp_ms, r.connect_ms, r.bytes, r.bytes_per_s, r.flash_ms, r.verify_ms);
+
+    esp_err_t err = ESP_OK;
+    if (strlen(APP_OTA_TRIGGER_URL) > 0) {
+        esp_http_client_handle_t client = trigger_client();
+        if (!client) {
+            return;
+        }
+        esp_http_client_set_method(client, HTTP_METHOD_POST);
+        esp_http_client_set_header(client, "Content-Type", "application/octet-stream");
+        esp_http_client_set_post_field(client, (const char *)&r, sizeof(r));
+        err = esp_http_client_perform(client);
+        esp_http_client_set_post_field(client, NULL, 0);
+        esp_http_client_delete_header(client, "Content-Type");
+    }
+
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Report not delivered: %s", esp_err_to_name(err));
+        return;
+    }
+    memset(&s_report, 0, sizeof(s_report));
+    s_report.defer_reason = r.defer_reason;
+}
+
+/**
+ * @brief Count a deferred update, reporting when the reason changes
+ *
+ * @param reason Gate that held the update back
+ */
+static void ota_defer(ota_defer_reason_t reason)
+{
+    // A trigger can stay pending for hours, so only a new reason is sent.
+    switch (reason) {
+    case OTA_DEFER_WINDOW:
+        s_report.deferred_window++;
+        break;
+    case OTA_DEFER_BATTERY:
+        s_report.deferred_battery++;
+        break;
+    case OTA_DEFER_NETWORK:
+        s_report.deferred_network++;
+        break;
+    default:
+        break;
+    }
+    s_report.defer_reason = (uint8_t)reason;
+
+    if (reason != s_defer_reported) {
+        s_defer_reported = reason;
+        ota_report_send(OTA_REPORT_DEFERRED);
+    }
+}
+
+/**
+ * @brief Report the outcome and timing of one download
+ *
+ * @param event OTA_REPORT_DELTA or OTA_REPORT_FULL
+ * @param err Result of the download
+ * @param stats Timing returned by the downloader
+ */
+static void ota_report_download(ota_report_event_t event, esp_err_t err,
+                                const ota_download_stats_t *stats)
+{
+    s_report.result = err;
+    s_report.attempts = (uint8_t)(stats->attempts > UINT8_MAX ? UINT8_MAX : stats->attempts);
+    s_report.connect_ms = stats->connect_ms;
+    s_report.bytes = stats->bytes;
+    s_report.bytes_per_s = stats->download_ms
+                               ? (uint32_t)((uint64_t)stats->bytes * 1000 / stats->download_ms)
+                               : 0;
+    s_report.download_ms = stats->download_ms;
+    s_report.flash_ms = stats->erase_ms + stats->write_ms;
+    s_report.verify_ms = stats->verify_ms;
+
+    // The next deferral is news again after an attempt.
+    s_defer_reported = OTA_DEFER_NONE;
+    ota_report_send(event);
+}
+
+/**
+ * @brief Build the patch URL for the running firmware
+ *
+ * @param out Buffer for the URL
+ * @param out_len Length of out buffer
+ * @return bool true if a patch URL is configured and fits
+ */
+static bool build_patch_url(char *out, size_t out_len)
+{
+    // Replaces the optional {version} token with the running app version.
+    static const char token[] = "{version}";
+    const char *tmpl = APP_OTA_PATCH_URL;
+    if (tmpl[0] == '\0') {
+        return false;
+    }
+
+    const char *at = strstr(tmpl, token);
+    int n;
+    if (at) {
+        n = snprintf(out, out_len, "%.*s%s%s", (int)(at - tmpl), tmpl,
+                     esp_app_get_description()->version, at + strlen(token));
+    } else {
+        n = snprintf(out, out_len, "%s", tmpl);
+    }
+    return n > 0 && (size_t)n < out_len;
+}
+
 /**
  * @brief Perform HTTPS OTA update 
  * 
@@ -237,32 +441,48 @@ static bool network_ready_check(const char *https_url)
  */
 static esp_err_t https_ota_run(const char *firmware_url)
 {
-    // Performs HTTPS OTA with certificate pinning.
+    // Performs HTTPS OTA with certificate pinning. A delta patch is tried
+    // first when configured. An interrupted full download resumes from the
+    // progress stored in NVS.
     const char *cert_pem = server_root_cert_pem_start;
     size_t cert_len = (size_t)(server_root_cert_pem_end - server_root_cert_pem_start);
     if (cert_len < 32) {
         return ESP_ERR_INVALID_SIZE;
     }
 
-    // Configure HTTPS OTA
-    esp_http_client_config_t http_cfg = {
-        .url = firmware_url,
-        .cert_pem = cert_pem,
-        .timeout_ms = 15000,
-        .keep_alive_enable = true,
-    };
-
-    // OTA configuration
-    esp_https_ota_config_t ota_cfg = {
-        .http_config = &http_cfg,
-    };
+    // Every TLS record the server sends would otherwise wait for the next
+    // DTIM wake. The link is otherwise idle, so modem sleep comes back after.
+    wifi_sta_ps_profile_t idle_profile = wifi_sta_get_ps_profile();
+    wifi_sta_set_ps_profile(WIFI_STA_PS_LOW_LATENCY);
+
+    esp_err_t err;
+    ota_download_stats_t stats;
+    char patch_url[256];
+    if (build_patch_url(patch_url, sizeof(patch_url))) {
+        err = ota_download_delta_run(patch_url, cert_pem, &stats);
+        ota_report_download(OTA_REPORT_DELTA, err, &stats);
+        if (err == ESP_OK) {
+            vTaskDelay(pdMS_TO_TICKS(500));
+            esp_restart();
+        }
+        if (err == ESP_ERR_TIMEOUT) {
+            // Server unreachable: the full image would fail the same way.
+            ESP_LOGW(TAG, "Delta OTA interrupted, retrying later");
+            wifi_sta_set_ps_profile(idle_profile);
+            return err;
+        }
+        ESP_LOGW(TAG, "Delta OTA unavailable (%s), using full image", esp_err_to_name(err));
+    }
 
-    // Start HTTPS OTA
-    esp_err_t err = esp_https_ota(&ota_cfg);
+    // Download, write and verify the image
+    err = ota_download_run(firmware_url, cert_pem, &stats);
+    ota_report_download(OTA_REPORT_FULL, err, &stats);
     if (err == ESP_OK) {
         vTaskDelay(pdMS_TO_TICKS(500));
         esp_restart();
     }
+    ESP_LOGW(TAG, "OTA failed: %s", esp_err_to_name(err));
+    wifi_sta_set_ps_profile(idle_profile);
     return err;
 }
 
@@ -301,19 +521,23 @@ static void ota_decision_task(void *arg)
 
         // Check maintenance window
         if (!in_maintenance_window()) {
+            ota_defer(OTA_DEFER_WINDOW);
             vTaskDelay(pdMS_TO_TICKS(APP_OTA_POLL_PERIOD_MS));
             continue;
         }
 
         // Check battery voltage
         int batt_mv = read_battery_mv();
+        s_report.battery_mv = (uint16_t)batt_mv;
         if (batt_mv < APP_BATT_MIN_MV) {
+            ota_defer(OTA_DEFER_BATTERY);
             vTaskDelay(pdMS_TO_TICKS(APP_OTA_POLL_PERIOD_MS));
             continue;
         }
 
         // Check network readiness
         if (!network_ready_check(APP_OTA_FIRMWARE_URL)) {
+            ota_defer(OTA_DEFER_NETWORK);
             vTaskDelay(pdMS_TO_TICKS(APP_OTA_POLL_PERIOD_MS));
             continue;
         }
@@ -10,6 +10,9 @@
  * - battery is above threshold
  * - basic network readiness checks pass
  *
+ * Deferrals and download timing are reported to the trigger URL when one
+ * is configured.
+ *
  * Returns:
  *   ESP_OK if the task was created, otherwise error.
  */
@@ -6,6 +6,8 @@
  *   - Define custom user eFuse fields in main/esp_efuse_custom_table.csv.
  *   - Generate esp_efuse_custom_table.c and esp_efuse_custom_table.h during the build.
  *   - Read and optionally program the custom fields using the ESP-IDF eFuse API.
+ *   - Burn all fields with one batch commit, and cache the verified record in
+ *     RTC memory so warm boots skip the eFuse reads and the CRC check.
  *
  * Safety notes:
  *   - eFuses are one-time programmable (0 -> 1). Burning is irreversible.
@@ -25,12 +27,46 @@
 #include "esp_log.h"
 
 #include "esp_efuse.h"
+#include "esp_attr.h"
+#include "esp_system.h"
+#include "esp_timer.h"
 
 // Generated at build time from main/esp_efuse_custom_table.csv
 #include "esp_efuse_custom_table.h"
 
 static const char *TAG = "custom_efuse_demo";
 
+// Bytes covered by the CRC: SERIAL_NUMBER[16] + HW_REV[2] + FEATURE_FLAGS[4]
+#define PROVISIONING_PAYLOAD_LEN    (16 + 2 + 4)
+
+/**
+ * @brief Contents of the custom eFuse fields.
+ */
+typedef struct {
+    uint8_t serial[16];     /*!< SERIAL_NUMBER, ASCII padded with 0x00 */
+    uint16_t hw_rev;        /*!< HW_REV */
+    uint32_t flags;         /*!< FEATURE_FLAGS */
+    uint16_t crc16;         /*!< PROVISIONING_CRC16 */
+} provisioning_record_t;
+
+#if CONFIG_DEMO_PROVISIONING_CACHE
+#define PROVISIONING_CACHE_MAGIC    0x50524F56u     // "PROV"
+
+/**
+ * @brief Verified provisioning record kept in RTC memory across warm resets.
+ *
+ * The magic and its complement together make it unlikely that random
+ * power-up contents pass as a valid entry.
+ */
+typedef struct {
+    uint32_t magic;
+    provisioning_record_t record;
+    uint32_t magic_inv;
+} provisioning_cache_t;
+
+static RTC_NOINIT_ATTR provisioning_cache_t s_provisioning_cache;
+#endif
+
 /**
  * @brief Compute CRC-16/CCITT-FALSE over a byte buffer.
  *
@@ -62,135 +98,186 @@ static uint16_t crc16_ccitt_false(const uint8_t *data, size_t len)
 }
 
 /**
- * @brief Read and print the custom fields.
+ * @brief Read all custom fields into a record.
  *
- * This function reads the custom fields defined in the custom CSV table:
+ * One pass over the four fields of the custom CSV table:
  *   - USER_DATA.SERIAL_NUMBER (128 bits)
  *   - USER_DATA.HW_REV (16 bits)
  *   - USER_DATA.FEATURE_FLAGS (32 bits)
  *   - USER_DATA.PROVISIONING_CRC16 (16 bits)
  *
+ * @param rec Output record.
  * @return esp_err_t ESP_OK on success.
  */
-static esp_err_t efuse_read_custom_fields(void)
+static esp_err_t efuse_read_record(provisioning_record_t *rec)
 {
-    // SERIAL_NUMBER is 16 bytes ASCII, padded with 0x00.
-    uint8_t serial_raw[16] = {0};
-    uint16_t hw_rev = 0;
-    uint32_t flags = 0;
-    uint16_t crc16_stored = 0;
+    memset(rec, 0, sizeof(*rec));
 
-    esp_err_t err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_SERIAL_NUMBER, serial_raw, sizeof(serial_raw) * 8);
+    esp_err_t err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_SERIAL_NUMBER, rec->serial, sizeof(rec->serial) * 8);
     if (err != ESP_OK) {
         return err;
     }
-
-    err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_HW_REV, &hw_rev, sizeof(hw_rev) * 8);
-    if (err != ESP_OK) {
-        return err;
-    }
-
-    err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_FEATURE_FLAGS, &flags, sizeof(flags) * 8);
+    err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_HW_REV, &rec->hw_rev, sizeof(rec->hw_rev) * 8);
     if (err != ESP_OK) {
         return err;
     }
-
-    err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_PROVISIONING_CRC16, &crc16_stored, sizeof(crc16_stored) * 8);
+    err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_FEATURE_FLAGS, &rec->flags, sizeof(rec->flags) * 8);
     if (err != ESP_OK) {
         return err;
     }
-
-    // Convert serial to a printable C string.
-    char serial_str[17] = {0};
-    memcpy(serial_str, serial_raw, 16);
-
-    ESP_LOGI(TAG, "SERIAL_NUMBER: '%s'", serial_str);
-    ESP_LOGI(TAG, "HW_REV: 0x%04X (%u)", hw_rev, (unsigned)hw_rev);
-    ESP_LOGI(TAG, "FEATURE_FLAGS: 0x%08" PRIX32, flags);
-    ESP_LOGI(TAG, "PROVISIONING_CRC16: 0x%04X", crc16_stored);
-
-    // Build the same 22-byte payload used for CRC computation.
-    uint8_t payload[16 + 2 + 4] = {0};
-    memcpy(&payload[0], serial_raw, 16);
-    payload[16] = (uint8_t)(hw_rev & 0xFF);
-    payload[17] = (uint8_t)((hw_rev >> 8) & 0xFF);
-    payload[18] = (uint8_t)(flags & 0xFF);
-    payload[19] = (uint8_t)((flags >> 8) & 0xFF);
-    payload[20] = (uint8_t)((flags >> 16) & 0xFF);
-    payload[21] = (uint8_t)((flags >> 24) & 0xFF);
-
-    uint16_t crc16_calc = crc16_ccitt_false(payload, sizeof(payload));
-    ESP_LOGI(TAG, "CRC16 recalculated: 0x%04X", crc16_calc);
-
-    if (crc16_stored == 0) {
-        ESP_LOGW(TAG, "CRC16 stored is 0x0000 (likely not provisioned yet)");
-    } else if (crc16_stored != crc16_calc) {
-        ESP_LOGW(TAG, "CRC16 mismatch (stored != calculated)");
-    } else {
-        ESP_LOGI(TAG, "CRC16 check: OK");
-    }
-
-    return ESP_OK;
+    return esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_PROVISIONING_CRC16, &rec->crc16, sizeof(rec->crc16) * 8);
 }
 
 /**
- * @brief Check whether custom eFuse fields look provisioned (CRC present and self-consistent).
+ * @brief Build the 22-byte payload covered by the CRC (SERIAL_NUMBER[16] + HW_REV[2] + FEATURE_FLAGS[4]).
  *
- * This helper reads the current custom fields, recomputes CRC16 over the stored payload,
- * and returns true if the stored CRC is non-zero and matches the computed CRC.
+ * HW_REV and FEATURE_FLAGS are stored little-endian, as they sit in the eFuse block.
+ *
+ * @param rec     Record to serialize.
+ * @param payload Output buffer.
+ */
+static void record_payload(const provisioning_record_t *rec, uint8_t payload[PROVISIONING_PAYLOAD_LEN])
+{
+    memcpy(&payload[0], rec->serial, 16);
+    payload[16] = (uint8_t)(rec->hw_rev & 0xFF);
+    payload[17] = (uint8_t)((rec->hw_rev >> 8) & 0xFF);
+    payload[18] = (uint8_t)(rec->flags & 0xFF);
+    payload[19] = (uint8_t)((rec->flags >> 8) & 0xFF);
+    payload[20] = (uint8_t)((rec->flags >> 16) & 0xFF);
+    payload[21] = (uint8_t)((rec->flags >> 24) & 0xFF);
+}
+
+/**
+ * @brief Check whether a record looks provisioned (CRC present and self-consistent).
  *
  * Note:
  * - This does NOT guarantee the content matches any particular "desired" values.
  * - It is intended as a safety gate to prevent repeated programming attempts.
  *
- * @param out_is_ok_crc Optional output flag indicating CRC match status.
- * @return true if the device appears provisioned; false otherwise.
+ * @param rec Record read from eFuse.
+ * @return true if the stored CRC is non-zero and matches the payload.
  */
-static bool efuse_is_provisioned(bool *out_is_ok_crc)
+static bool record_is_provisioned(const provisioning_record_t *rec)
 {
-    uint8_t serial_raw[16] = {0};
-    uint16_t hw_rev = 0;
-    uint32_t flags = 0;
-    uint16_t crc16_stored = 0;
+    uint8_t payload[PROVISIONING_PAYLOAD_LEN];
+    record_payload(rec, payload);
+    return (rec->crc16 != 0) && (rec->crc16 == crc16_ccitt_false(payload, sizeof(payload)));
+}
 
-    if (out_is_ok_crc) {
-        *out_is_ok_crc = false;
+#if CONFIG_DEMO_PROVISIONING_CACHE
+/**
+ * @brief Return the cached record if this boot may trust it.
+ *
+ * RTC_NOINIT memory holds garbage after power-up and can be corrupted by a
+ * brownout, so the cache is only used after resets that keep RTC memory
+ * intact (software reset, panic, watchdog, deep-sleep wake).
+ *
+ * @param rec Output record.
+ * @return true if a valid cached record was copied.
+ */
+static bool provisioning_cache_load(provisioning_record_t *rec)
+{
+    switch (esp_reset_reason()) {
+    case ESP_RST_SW:
+    case ESP_RST_PANIC:
+    case ESP_RST_INT_WDT:
+    case ESP_RST_TASK_WDT:
+    case ESP_RST_WDT:
+    case ESP_RST_DEEPSLEEP:
+        break;
+    default:
+        return false;
     }
 
-    esp_err_t err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_SERIAL_NUMBER, serial_raw, sizeof(serial_raw) * 8);
-    if (err != ESP_OK) {
+    if (s_provisioning_cache.magic != PROVISIONING_CACHE_MAGIC ||
+        s_provisioning_cache.magic_inv != ~PROVISIONING_CACHE_MAGIC) {
         return false;
     }
-    err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_HW_REV, &hw_rev, sizeof(hw_rev) * 8);
-    if (err != ESP_OK) {
-        return false;
+    *rec = s_provisioning_cache.record;
+    return true;
+}
+
+/**
+ * @brief Store a verified record for the next warm boot.
+ *
+ * @param rec Record whose CRC has been checked.
+ */
+static void provisioning_cache_store(const provisioning_record_t *rec)
+{
+    s_provisioning_cache.record = *rec;
+    s_provisioning_cache.magic = PROVISIONING_CACHE_MAGIC;
+    s_provisioning_cache.magic_inv = ~PROVISIONING_CACHE_MAGIC;
+}
+#endif
+
+/**
+ * @brief Get the provisioning record, from the RTC cache on warm boots or from eFuse otherwise.
+ *
+ * A record read from eFuse is cached only if its CRC checks out, so an
+ * unprovisioned device is read again on every boot until provisioning succeeds.
+ *
+ * @param rec        Output record.
+ * @param out_cached Set to true when the record came from the cache.
+ * @return esp_err_t ESP_OK on success.
+ */
+static esp_err_t provisioning_get(provisioning_record_t *rec, bool *out_cached)
+{
+    *out_cached = false;
+
+#if CONFIG_DEMO_PROVISIONING_CACHE
+    if (provisioning_cache_load(rec)) {
+        *out_cached = true;
+        return ESP_OK;
     }
-    err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_FEATURE_FLAGS, &flags, sizeof(flags) * 8);
+#endif
+
+    esp_err_t err = efuse_read_record(rec);
     if (err != ESP_OK) {
-        return false;
+        return err;
     }
-    err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_PROVISIONING_CRC16, &crc16_stored, sizeof(crc16_stored) * 8);
-    if (err != ESP_OK) {
-        return false;
+
+#if CONFIG_DEMO_PROVISIONING_CACHE
+    if (record_is_provisioned(rec)) {
+        provisioning_cache_store(rec);
     }
+#endif
+    return ESP_OK;
+}
 
-    uint8_t payload[16 + 2 + 4] = {0};
-    memcpy(&payload[0], serial_raw, 16);
-    payload[16] = (uint8_t)(hw_rev & 0xFF);
-    payload[17] = (uint8_t)((hw_rev >> 8) & 0xFF);
-    payload[18] = (uint8_t)(flags & 0xFF);
-    payload[19] = (uint8_t)((flags >> 8) & 0xFF);
-    payload[20] = (uint8_t)((flags >> 16) & 0xFF);
-    payload[21] = (uint8_t)((flags >> 24) & 0xFF);
+/**
+ * @brief Print a provisioning record and its CRC status.
+ *
+ * @param rec    Record to print.
+ * @param cached True if the record came from the RTC cache (CRC verified on an earlier boot).
+ */
+static void print_record(const provisioning_record_t *rec, bool cached)
+{
+    // Convert serial to a printable C string.
+    char serial_str[17] = {0};
+    memcpy(serial_str, rec->serial, 16);
 
-    uint16_t crc16_calc = crc16_ccitt_false(payload, sizeof(payload));
-    bool ok = (crc16_stored != 0) && (crc16_stored == crc16_calc);
+    ESP_LOGI(TAG, "SERIAL_NUMBER: '%s'", serial_str);
+    ESP_LOGI(TAG, "HW_REV: 0x%04X (%u)", rec->hw_rev, (unsigned)rec->hw_rev);
+    ESP_LOGI(TAG, "FEATURE_FLAGS: 0x%08" PRIX32, rec->flags);
+    ESP_LOGI(TAG, "PROVISIONING_CRC16: 0x%04X", rec->crc16);
 
-    if (out_is_ok_crc) {
-        *out_is_ok_crc = ok;
+    if (cached) {
+        ESP_LOGI(TAG, "CRC16 check: OK (verified on an earlier boot)");
+        return;
     }
 
-    return ok;
+    uint8_t payload[PROVISIONING_PAYLOAD_LEN];
+    record_payload(rec, payload);
+    uint16_t crc16_calc = crc16_ccitt_false(payload, sizeof(payload));
+    ESP_LOGI(TAG, "CRC16 recalculated: 0x%04X", crc16_calc);
+
+    if (rec->crc16 == 0) {
+        ESP_LOGW(TAG, "CRC16 stored is 0x0000 (likely not provisioned yet)");
+    } else if (rec->crc16 != crc16_calc) {
+        ESP_LOGW(TAG, "CRC16 mismatch (stored != calculated)");
+    } else {
+        ESP_LOGI(TAG, "CRC16 check: OK");
+    }
 }
 
 /**
@@ -205,230 +292,136 @@ static bool efuse_is_provisioned(bool *out_is_ok_crc)
  * IMPORTANT:
  * - In virtual eFuse mode, this modifies the virtual store only.
  * - When CONFIG_EFUSE_VIRTUAL is disabled, this will burn real eFuses.
- * - Batch mode is used because user blocks on ESP32-S3 use Reed-Solomon encoding.
- *
- * @param serial_ascii Null-terminated serial string (up to 16 chars are stored).
- * @param hw_rev       Hardware revision.
- * @param flags        Feature flags.
- * @return esp_err_t ESP_OK on success.
- */
-/**
- * @brief Program the custom fields and store a CRC16.
- *
- * This function burns:
- *   - SERIAL_NUMBER (16 bytes, padded)
- *   - HW_REV (uint16)
- *   - FEATURE_FLAGS (uint32)
- *   - PROVISIONING_CRC16 (CRC-16 over the fixed payload)
- *
- * IMPORTANT:
- * - In virtual eFuse mode, this modifies the virtual store only.
- * - When CONFIG_EFUSE_VIRTUAL is disabled, this will burn real eFuses.
- * - Batch mode is used because user blocks on ESP32-S3 use Reed-Solomon encoding.
+ * - All four fields are staged in one batch and burned by a single
+ *   esp_efuse_batch_write_commit(). Batch mode is also required because
+ *   user blocks on ESP32-S3 use Reed-Solomon encoding, which is computed
+ *   over the whole block at burn time.
  *
  * Idempotency and safety:
  * - ESP-IDF forbids "re-programming" bits that are already set to 1.
  * - To keep this demo safe across reboots (especially with virtual eFuses persisted in flash),
- *   this function first checks whether the device appears provisioned (CRC is present and matches).
- * - If provisioned, the function returns ESP_OK without attempting any write.
+ *   the caller passes the record it read at boot; if that record is provisioned
+ *   (CRC is present and matches), the function returns ESP_OK without attempting any write.
  * - If not provisioned, the function will only stage NEW bits that transition 0 -> 1.
  * - If existing bits would require clearing (1 -> 0), the function fails with ESP_ERR_INVALID_STATE.
+ * - On success, cur is updated to the burned values.
  *
+ * @param cur          Current eFuse contents, as read at boot; updated on success.
  * @param serial_ascii Null-terminated serial string (up to 16 chars are stored).
  * @param hw_rev       Hardware revision.
  * @param flags        Feature flags.
  * @return esp_err_t ESP_OK on success.
  */
-static esp_err_t efuse_program_custom_fields(const char *serial_ascii, uint16_t hw_rev, uint32_t flags)
+static esp_err_t efuse_program_custom_fields(provisioning_record_t *cur, const char *serial_ascii,
+                                             uint16_t hw_rev, uint32_t flags)
 {
-    if (serial_ascii == NULL) {
+    if (cur == NULL || serial_ascii == NULL) {
         return ESP_ERR_INVALID_ARG;
     }
 
     // If the device already looks provisioned, do not attempt to re-program.
     // This avoids ESP_ERR_EFUSE_REPEATED_PROG on subsequent boots/runs.
-    bool crc_ok = false;
-    if (efuse_is_provisioned(&crc_ok) && crc_ok) {
+    if (record_is_provisioned(cur)) {
         ESP_LOGI(TAG, "Device already provisioned (CRC OK). Skipping eFuse programming.");
         return ESP_OK;
     }
 
-    // Desired payload (SERIAL_NUMBER[16] + HW_REV[2] + FEATURE_FLAGS[4])
-    // Zero init ensures short serial strings are padded with 0x00.
-    uint8_t desired_payload[16 + 2 + 4] = {0};
+    // Desired record. Zero init ensures short serial strings are padded with 0x00.
+    provisioning_record_t desired = {0};
 
     // Copy up to 16 bytes from the serial string (no overread).
     size_t n = strlen(serial_ascii);
     if (n > 16) {
         n = 16;
     }
-    memcpy(&desired_payload[0], serial_ascii, n);
-
-    // HW_REV (little-endian)
-    desired_payload[16] = (uint8_t)(hw_rev & 0xFF);
-    desired_payload[17] = (uint8_t)((hw_rev >> 8) & 0xFF);
-
-    // FEATURE_FLAGS (little-endian)
-    desired_payload[18] = (uint8_t)(flags & 0xFF);
-    desired_payload[19] = (uint8_t)((flags >> 8) & 0xFF);
-    desired_payload[20] = (uint8_t)((flags >> 16) & 0xFF);
-    desired_payload[21] = (uint8_t)((flags >> 24) & 0xFF);
-
-    // Compute CRC16 over the fixed payload.
-    const uint16_t desired_crc16 = crc16_ccitt_false(desired_payload, sizeof(desired_payload));
-    const uint8_t desired_crc_le[2] = {
-        (uint8_t)(desired_crc16 & 0xFF),
-        (uint8_t)((desired_crc16 >> 8) & 0xFF),
-    };
+    memcpy(desired.serial, serial_ascii, n);
+    desired.hw_rev = hw_rev;
+    desired.flags = flags;
 
-    // Read current values so we can:
+    // Compute CRC16 over the fixed payload (SERIAL_NUMBER[16] + HW_REV[2] + FEATURE_FLAGS[4]).
+    uint8_t desired_payload[PROVISIONING_PAYLOAD_LEN];
+    record_payload(&desired, desired_payload);
+    desired.crc16 = crc16_ccitt_false(desired_payload, sizeof(desired_payload));
+
+    // Bring current and desired values into the same little-endian byte layout
+    // (payload followed by the CRC) so they can be compared bit by bit:
     //  1) refuse programming if it would require clearing bits (1 -> 0)
     //  2) stage only NEW bits (avoid repeated programming)
-    uint8_t cur_serial[16] = {0};
-    uint16_t cur_hw_rev = 0;
-    uint32_t cur_flags = 0;
-    uint16_t cur_crc16 = 0;
-
-    esp_err_t err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_SERIAL_NUMBER, cur_serial, sizeof(cur_serial) * 8);
-    if (err != ESP_OK) {
-        return err;
-    }
-    err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_HW_REV, &cur_hw_rev, sizeof(cur_hw_rev) * 8);
-    if (err != ESP_OK) {
-        return err;
-    }
-    err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_FEATURE_FLAGS, &cur_flags, sizeof(cur_flags) * 8);
-    if (err != ESP_OK) {
-        return err;
-    }
-    err = esp_efuse_read_field_blob(ESP_EFUSE_USER_DATA_PROVISIONING_CRC16, &cur_crc16, sizeof(cur_crc16) * 8);
-    if (err != ESP_OK) {
-        return err;
-    }
-
-    // Convert current HW/flags/CRC to little-endian byte arrays for bitwise checks.
-    const uint8_t cur_hw_le[2] = {
-        (uint8_t)(cur_hw_rev & 0xFF),
-        (uint8_t)((cur_hw_rev >> 8) & 0xFF),
-    };
-    const uint8_t cur_flags_le[4] = {
-        (uint8_t)(cur_flags & 0xFF),
-        (uint8_t)((cur_flags >> 8) & 0xFF),
-        (uint8_t)((cur_flags >> 16) & 0xFF),
-        (uint8_t)((cur_flags >> 24) & 0xFF),
+    uint8_t cur_bytes[PROVISIONING_PAYLOAD_LEN + 2];
+    uint8_t desired_bytes[PROVISIONING_PAYLOAD_LEN + 2];
+    record_payload(cur, cur_bytes);
+    cur_bytes[22] = (uint8_t)(cur->crc16 & 0xFF);
+    cur_bytes[23] = (uint8_t)((cur->crc16 >> 8) & 0xFF);
+    memcpy(desired_bytes, desired_payload, sizeof(desired_payload));
+    desired_bytes[22] = (uint8_t)(desired.crc16 & 0xFF);
+    desired_bytes[23] = (uint8_t)((desired.crc16 >> 8) & 0xFF);
+
+    // Field boundaries inside the 24-byte layout, for staging and error messages.
+    static const struct {
+        const esp_efuse_desc_t **field;
+        const char *name;
+        uint8_t offset;
+        uint8_t len;
+    } fields[] = {
+        { ESP_EFUSE_USER_DATA_SERIAL_NUMBER,      "SERIAL_NUMBER", 0,  16 },
+        { ESP_EFUSE_USER_DATA_HW_REV,             "HW_REV",        16, 2  },
+        { ESP_EFUSE_USER_DATA_FEATURE_FLAGS,      "FEATURE_FLAGS", 18, 4  },
+        { ESP_EFUSE_USER_DATA_PROVISIONING_CRC16, "CRC16",         22, 2  },
     };
-    const uint8_t cur_crc_le[2] = {
-        (uint8_t)(cur_crc16 & 0xFF),
-        (uint8_t)((cur_crc16 >> 8) & 0xFF),
-    };
-
-    // Helper lambda-like macro: detect if we'd need to clear any bits (illegal for eFuses).
-#define EFUSE_CONFLICT_EXISTS(cur_b, desired_b) (((cur_b) & (uint8_t)(~(desired_b))) != 0)
 
-    for (size_t i = 0; i < 16; i++) {
-        if (EFUSE_CONFLICT_EXISTS(cur_serial[i], desired_payload[i])) {
-            ESP_LOGE(TAG, "SERIAL_NUMBER conflict: would require clearing bits at byte %u", (unsigned)i);
-            return ESP_ERR_INVALID_STATE;
-        }
-    }
-    for (size_t i = 0; i < 2; i++) {
-        if (EFUSE_CONFLICT_EXISTS(cur_hw_le[i], desired_payload[16 + i])) {
-            ESP_LOGE(TAG, "HW_REV conflict: would require clearing bits at byte %u", (unsigned)i);
-            return ESP_ERR_INVALID_STATE;
-        }
-    }
-    for (size_t i = 0; i < 4; i++) {
-        if (EFUSE_CONFLICT_EXISTS(cur_flags_le[i], desired_payload[18 + i])) {
-            ESP_LOGE(TAG, "FEATURE_FLAGS conflict: would require clearing bits at byte %u", (unsigned)i);
-            return ESP_ERR_INVALID_STATE;
-        }
-    }
-    for (size_t i = 0; i < 2; i++) {
-        if (EFUSE_CONFLICT_EXISTS(cur_crc_le[i], desired_crc_le[i])) {
-            ESP_LOGE(TAG, "CRC16 conflict: would require clearing bits at byte %u", (unsigned)i);
-            return ESP_ERR_INVALID_STATE;
+    // Delta buffer: only bits that transition 0 -> 1.
+    uint8_t delta[PROVISIONING_PAYLOAD_LEN + 2] = {0};
+    bool need[4] = {false};
+    bool need_any = false;
+
+    for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) {
+        for (size_t i = fields[f].offset; i < (size_t)fields[f].offset + fields[f].len; i++) {
+            // eFuse bits can only be set, never cleared.
+            if ((cur_bytes[i] & (uint8_t)(~desired_bytes[i])) != 0) {
+                ESP_LOGE(TAG, "%s conflict: would require clearing bits at byte %u",
+                         fields[f].name, (unsigned)(i - fields[f].offset));
+                return ESP_ERR_INVALID_STATE;
+            }
+            delta[i] = (uint8_t)(desired_bytes[i] & (uint8_t)(~cur_bytes[i]));
+            need[f] |= (delta[i] != 0);
         }
+        need_any |= need[f];
     }
 
-    // Build delta buffers: stage only bits that transition 0 -> 1.
-    uint8_t serial_delta[16] = {0};
-    uint8_t hw_delta[2] = {0};
-    uint8_t flags_delta[4] = {0};
-    uint8_t crc_delta[2] = {0};
-
-    bool need_serial = false;
-    bool need_hw = false;
-    bool need_flags = false;
-    bool need_crc = false;
-
-    for (size_t i = 0; i < 16; i++) {
-        serial_delta[i] = (uint8_t)(desired_payload[i] & (uint8_t)(~cur_serial[i]));
-        need_serial |= (serial_delta[i] != 0);
-    }
-    for (size_t i = 0; i < 2; i++) {
-        hw_delta[i] = (uint8_t)(desired_payload[16 + i] & (uint8_t)(~cur_hw_le[i]));
-        need_hw |= (hw_delta[i] != 0);
-    }
-    for (size_t i = 0; i < 4; i++) {
-        flags_delta[i] = (uint8_t)(desired_payload[18 + i] & (uint8_t)(~cur_flags_le[i]));
-        need_flags |= (flags_delta[i] != 0);
-    }
-    for (size_t i = 0; i < 2; i++) {
-        crc_delta[i] = (uint8_t)(desired_crc_le[i] & (uint8_t)(~cur_crc_le[i]));
-        need_crc |= (crc_delta[i] != 0);
-    }
-
-    if (!need_serial && !need_hw && !need_flags && !need_crc) {
+    if (!need_any) {
         ESP_LOGI(TAG, "No new bits to program. Skipping commit.");
         return ESP_OK;
     }
 
-    // Begin batch write mode (required for RS-coded user blocks on ESP32-S3).
-    err = esp_efuse_batch_write_begin();
+    // Begin batch write mode: writes below only go to the staging registers.
+    esp_err_t err = esp_efuse_batch_write_begin();
     if (err != ESP_OK) {
         return err;
     }
 
     // Stage only the deltas. This avoids repeated-programming errors.
-    if (need_serial) {
-        err = esp_efuse_write_field_blob(ESP_EFUSE_USER_DATA_SERIAL_NUMBER, serial_delta, 16 * 8);
-        if (err != ESP_OK) {
-            esp_efuse_batch_write_cancel();
-            return err;
-        }
-    }
-
-    if (need_hw) {
-        err = esp_efuse_write_field_blob(ESP_EFUSE_USER_DATA_HW_REV, hw_delta, 2 * 8);
-        if (err != ESP_OK) {
-            esp_efuse_batch_write_cancel();
-            return err;
+    for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) {
+        if (!need[f]) {
+            continue;
         }
-    }
-
-    if (need_flags) {
-        err = esp_efuse_write_field_blob(ESP_EFUSE_USER_DATA_FEATURE_FLAGS, flags_delta, 4 * 8);
+        err = esp_efuse_write_field_blob(fields[f].field, &delta[fields[f].offset], fields[f].len * 8);
         if (err != ESP_OK) {
             esp_efuse_batch_write_cancel();
             return err;
         }
     }
 
-    if (need_crc) {
-        err = esp_efuse_write_field_blob(ESP_EFUSE_USER_DATA_PROVISIONING_CRC16, crc_delta, 2 * 8);
-        if (err != ESP_OK) {
-            esp_efuse_batch_write_cancel();
-            return err;
-        }
-    }
-
-    // Burn staged bits.
+    // One burn for all staged bits.
     err = esp_efuse_batch_write_commit();
     if (err != ESP_OK) {
         return err;
     }
 
-    ESP_LOGI(TAG, "Provisioning committed (CRC16=0x%04X)", desired_crc16);
+    *cur = desired;
+#if CONFIG_DEMO_PROVISIONING_CACHE
+    provisioning_cache_store(cur);
+#endif
+    ESP_LOGI(TAG, "Provisioning committed (CRC16=0x%04X)", desired.crc16);
     return ESP_OK;
 }
 
@@ -436,37 +429,55 @@ static esp_err_t efuse_program_custom_fields(const char *serial_ascii, uint16_t
  * @brief ESP-IDF application entry point.
  *
  * Behavior:
- * - Always reads and prints the custom fields.
+ * - Gets the provisioning record: from the RTC cache on warm boots, otherwise from eFuse.
  * - If CONFIG_DEMO_PROGRAM_EFUSE is enabled, it attempts to provision example values.
+ * - Prints the custom fields (and validates the CRC when they were read from eFuse).
  */
 void app_main(void)
 {
     ESP_LOGI(TAG, "Custom eFuse demo starting (target=%s)", CONFIG_IDF_TARGET);
 
-    // Optional programming step.
+    provisioning_record_t rec;
+    bool cached = false;
+    int64_t t0 = esp_timer_get_time();
+    esp_err_t err = provisioning_get(&rec, &cached);
+    int64_t t_read = esp_timer_get_time() - t0;
+    const bool have_record = (err == ESP_OK);
+    if (!have_record) {
+        ESP_LOGE(TAG, "Read failed: %s", esp_err_to_name(err));
+    } else {
+        ESP_LOGI(TAG, "Provisioning record %s in %" PRId64 " us",
+                 cached ? "taken from RTC cache" : "read from eFuse", t_read);
+    }
+
+    // Optional programming step. A cached record is provisioned by definition.
 #if CONFIG_DEMO_PROGRAM_EFUSE
-    ESP_LOGW(TAG, "CONFIG_DEMO_PROGRAM_EFUSE is enabled. Provisioning will be attempted.");
+    if (have_record && !cached) {
+        ESP_LOGW(TAG, "CONFIG_DEMO_PROGRAM_EFUSE is enabled. Provisioning will be attempted.");
 
-    // Example values.
-    // NOTE: Keep these constant for a demo. In production, these come from a provisioning system.
-    const char *serial = "SN-ESP32S3-0001";
-    uint16_t hw_rev = 0x0001;
-    uint32_t flags = 0x0000000F;
+        // Example values.
+        // NOTE: Keep these constant for a demo. In production, these come from a provisioning system.
+        const char *serial = "SN-ESP32S3-0001";
+        uint16_t hw_rev = 0x0001;
+        uint32_t flags = 0x0000000F;
 
-    esp_err_t err = efuse_program_custom_fields(serial, hw_rev, flags);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Provisioning failed: %s", esp_err_to_name(err));
+        t0 = esp_timer_get_time();
+        err = efuse_program_custom_fields(&rec, serial, hw_rev, flags);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Provisioning failed: %s", esp_err_to_name(err));
+        } else {
+            ESP_LOGI(TAG, "Provisioning step took %" PRId64 " us", esp_timer_get_time() - t0);
+        }
     }
 #endif
 
-    // Read and display fields (and validate CRC).
-    err = efuse_read_custom_fields();
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Read failed: %s", esp_err_to_name(err));
+    // Display fields (and validate CRC).
+    if (have_record) {
+        print_record(&rec, cached);
     }
 
     // Idle loop.
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(2000));
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,235 @@
+/*
+ * Cached directory listings and filesystem usage for the LittleFS demo.
+ */
+
+#include "fs_cache.h"
+
+#include <dirent.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "esp_littlefs.h"
+#include "esp_log.h"
+
+static const char *TAG = "fs_cache";
+
+/**
+ * @brief One cached directory listing
+ */
+typedef struct {
+    bool valid;
+    bool truncated;
+    uint32_t last_used;
+    char path[FS_CACHE_PATH_MAX];
+    size_t count;
+    fs_cache_entry_t entries[FS_CACHE_MAX_ENTRIES];
+} fs_cache_dir_t;
+
+static SemaphoreHandle_t s_lock;
+static const char *s_partition_label;
+static fs_cache_dir_t s_dirs[FS_CACHE_MAX_DIRS];
+static uint32_t s_use_clock;
+static bool s_usage_valid;
+static size_t s_usage_total;
+static size_t s_usage_used;
+
+/**
+ * @brief Pick the slot for a directory: its current slot, a free one, or the LRU one
+ *
+ * @param dirpath Path to directory
+ * @return fs_cache_dir_t* Slot to use
+ */
+static fs_cache_dir_t *find_slot(const char *dirpath)
+{
+    fs_cache_dir_t *victim = &s_dirs[0];
+
+    for (size_t i = 0; i < FS_CACHE_MAX_DIRS; i++) {
+        fs_cache_dir_t *slot = &s_dirs[i];
+        if (slot->valid && strcmp(slot->path, dirpath) == 0) {
+            return slot;
+        }
+        // Prefer an empty slot, then the least recently used one
+        if (!slot->valid) {
+            if (victim->valid) {
+                victim = slot;
+            }
+        } else if (victim->valid && slot->last_used < victim->last_used) {
+            victim = slot;
+        }
+    }
+
+    victim->valid = false;
+    return victim;
+}
+
+/**
+ * @brief Read a directory from LittleFS into a cache slot
+ *
+ * @param slot Slot to fill
+ * @param dirpath Path to directory
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if opendir fails
+ */
+static esp_err_t load_dir(fs_cache_dir_t *slot, const char *dirpath)
+{
+    // Open directory
+    DIR *dir = opendir(dirpath);
+    if (!dir) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    strlcpy(slot->path, dirpath, sizeof(slot->path));
+    slot->count = 0;
+    slot->truncated = false;
+
+    // Read entries and stat each one once
+    struct dirent *ent;
+    while ((ent = readdir(dir)) != NULL) {
+        if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0) {
+            continue;
+        }
+
+        if (slot->count >= FS_CACHE_MAX_ENTRIES) {
+            slot->truncated = true;
+            break;
+        }
+
+        fs_cache_entry_t *entry = &slot->entries[slot->count];
+        if (strlcpy(entry->name, ent->d_name, sizeof(entry->name)) >= sizeof(entry->name)) {
+            ESP_LOGW(TAG, "Name too long to cache, skipping: %s/%s", dirpath, ent->d_name);
+            slot->truncated = true;
+            continue;
+        }
+
+        char fullpath[FS_CACHE_PATH_MAX + FS_CACHE_NAME_MAX];
+        snprintf(fullpath, sizeof(fullpath), "%s/%s", dirpath, ent->d_name);
+
+        struct stat st;
+        if (stat(fullpath, &st) == 0) {
+            entry->is_dir = S_ISDIR(st.st_mode);
+            entry->size = (size_t)st.st_size;
+        } else {
+            entry->is_dir = false;
+            entry->size = 0;
+        }
+        slot->count++;
+    }
+
+    // Close directory
+    closedir(dir);
+
+    slot->valid = true;
+    return ESP_OK;
+}
+
+esp_err_t fs_cache_init(const char *partition_label)
+{
+    if (s_lock == NULL) {
+        s_lock = xSemaphoreCreateMutex();
+        if (s_lock == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    s_partition_label = partition_label;
+    memset(s_dirs, 0, sizeof(s_dirs));
+    s_usage_valid = false;
+    xSemaphoreGive(s_lock);
+
+    return ESP_OK;
+}
+
+esp_err_t fs_cache_list(const char *dirpath,
+                        fs_cache_entry_t *entries,
+                        size_t capacity,
+                        size_t *count,
+                        bool *truncated)
+{
+    if (!dirpath || !count || !truncated || (!entries && capacity > 0) ||
+        strlen(dirpath) >= FS_CACHE_PATH_MAX) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_lock == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+
+    // Serve from RAM when the listing is still valid
+    fs_cache_dir_t *slot = find_slot(dirpath);
+    esp_err_t ret = ESP_OK;
+    if (!slot->valid) {
+        ret = load_dir(slot, dirpath);
+    }
+
+    if (ret == ESP_OK) {
+        slot->last_used = ++s_use_clock;
+        const size_t n = (slot->count < capacity) ? slot->count : capacity;
+        memcpy(entries, slot->entries, n * sizeof(entries[0]));
+        *count = n;
+        *truncated = slot->truncated || (n < slot->count);
+    }
+
+    xSemaphoreGive(s_lock);
+    return ret;
+}
+
+esp_err_t fs_cache_usage(size_t *total, size_t *used)
+{
+    if (!total || !used) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_lock == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+
+    esp_err_t ret = ESP_OK;
+    if (!s_usage_valid) {
+        ret = esp_littlefs_info(s_partition_label, &s_usage_total, &s_usage_used);
+        s_usage_valid = (ret == ESP_OK);
+    }
+
+    if (ret == ESP_OK) {
+        *total = s_usage_total;
+        *used = s_usage_used;
+    }
+
+    xSemaphoreGive(s_lock);
+    return ret;
+}
+
+void fs_cache_invalidate(const char *path)
+{
+    if (!path || s_lock == NULL) {
+        return;
+    }
+
+    // The parent directory's listing holds the entry for path
+    const char *slash = strrchr(path, '/');
+    const size_t parent_len = slash ? (size_t)(slash - path) : 0;
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+
+    for (size_t i = 0; i < FS_CACHE_MAX_DIRS; i++) {
+        fs_cache_dir_t *slot = &s_dirs[i];
+        if (!slot->valid) {
+            continue;
+        }
+
+        const bool is_parent = strlen(slot->path) == parent_len &&
+                               strncmp(slot->path, path, parent_len) == 0;
+        if (is_parent || strcmp(slot->path, path) == 0) {
+            slot->valid = false;
+        }
+    }
+    s_usage_valid = false;
+
+    xSemaphoreGive(s_lock);
+}
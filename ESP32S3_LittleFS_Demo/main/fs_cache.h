@@ -0,0 +1,83 @@
+/*
+ * Cached directory listings and filesystem usage for the LittleFS demo.
+ *
+ * Listings and usage are read from LittleFS once and served from RAM until
+ * a writer calls fs_cache_invalidate() for a path inside the cached tree.
+ */
+
+#ifndef FS_CACHE_H
+#define FS_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FS_CACHE_MAX_DIRS     4
+#define FS_CACHE_MAX_ENTRIES  16
+#define FS_CACHE_NAME_MAX     32
+#define FS_CACHE_PATH_MAX     64
+
+/**
+ * @brief One cached directory entry
+ */
+typedef struct {
+    char name[FS_CACHE_NAME_MAX];
+    bool is_dir;
+    size_t size;
+} fs_cache_entry_t;
+
+/**
+ * @brief Initialize the cache
+ *
+ * @param partition_label LittleFS partition label used for usage queries
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if the lock cannot be created
+ */
+esp_err_t fs_cache_init(const char *partition_label);
+
+/**
+ * @brief Copy the listing of a directory, reading LittleFS only on a cache miss
+ *
+ * @param dirpath Path to directory
+ * @param entries Destination array
+ * @param capacity Number of elements in entries
+ * @param count Receives the number of entries copied
+ * @param truncated Receives true when the directory holds more entries than
+ *        FS_CACHE_MAX_ENTRIES or capacity
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NOT_FOUND if the directory
+ *         cannot be opened, ESP_ERR_INVALID_ARG for bad arguments
+ */
+esp_err_t fs_cache_list(const char *dirpath,
+                        fs_cache_entry_t *entries,
+                        size_t capacity,
+                        size_t *count,
+                        bool *truncated);
+
+/**
+ * @brief Get filesystem usage, querying LittleFS only on a cache miss
+ *
+ * @param total Receives the partition capacity in bytes
+ * @param used Receives the used bytes
+ * @return esp_err_t ESP_OK on success, otherwise the esp_littlefs_info() error
+ */
+esp_err_t fs_cache_usage(size_t *total, size_t *used);
+
+/**
+ * @brief Drop cached data affected by a change to a path
+ *
+ * Invalidates the listing of the directory containing path, the listing of
+ * path itself if it is a cached directory, and the usage figures.
+ *
+ * @param path File or directory that was created, written, renamed, or removed
+ */
+void fs_cache_invalidate(const char *path);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
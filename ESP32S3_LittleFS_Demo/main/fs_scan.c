@@ -0,0 +1,345 @@
+/*
+ * Background integrity scan of the LittleFS partition.
+ */
+
+#include "fs_scan.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+
+#include "esp_log.h"
+
+#include "fs_cache.h"
+#include "lz_stream.h"
+
+static const char *TAG = "fs_scan";
+
+#define FS_SCAN_MAGIC        0x4E414353  // "SCAN"
+#define FS_SCAN_CHUNK_SIZE   512
+#define FS_SCAN_SAVE_EVERY   8           // Files between watermark saves
+#define FS_SCAN_TASK_STACK   4096
+#define FS_SCAN_CORE         (portNUM_PROCESSORS - 1)
+
+/**
+ * @brief Watermark persisted in config.state_path
+ */
+typedef struct {
+    uint32_t magic;
+    uint32_t passes_completed;
+    char last_verified[FS_SCAN_PATH_MAX];   // Empty when no pass is in progress
+} fs_scan_watermark_t;
+
+static fs_scan_config_t s_config;
+static SemaphoreHandle_t s_lock;
+static SemaphoreHandle_t s_done;
+static TaskHandle_t s_task;
+static volatile bool s_stop;
+
+static fs_scan_progress_t s_progress;
+static fs_scan_watermark_t s_mark;
+static bool s_resuming;
+static uint32_t s_unsaved;
+
+// Only the scan task touches these
+static char s_chunk[FS_SCAN_CHUNK_SIZE];
+static lz_stream_reader_t s_reader;
+
+/**
+ * @brief Load the watermark, starting fresh if it is missing or unreadable
+ */
+static void load_watermark(void)
+{
+    memset(&s_mark, 0, sizeof(s_mark));
+
+    FILE *f = fopen(s_config.state_path, "r");
+    if (!f) {
+        return;
+    }
+
+    fs_scan_watermark_t mark;
+    if (fread(&mark, 1, sizeof(mark), f) == sizeof(mark) && mark.magic == FS_SCAN_MAGIC) {
+        mark.last_verified[FS_SCAN_PATH_MAX - 1] = '\0';
+        s_mark = mark;
+    }
+    fclose(f);
+}
+
+/**
+ * @brief Save the watermark
+ *
+ * LittleFS commits a file's new contents atomically on close, so a reset
+ * leaves either the old or the new watermark.
+ */
+static void save_watermark(void)
+{
+    s_mark.magic = FS_SCAN_MAGIC;
+    s_unsaved = 0;
+
+    FILE *f = fopen(s_config.state_path, "w");
+    if (!f) {
+        ESP_LOGW(TAG, "fopen(w) failed for %s: errno=%d (%s)",
+                 s_config.state_path, errno, strerror(errno));
+        return;
+    }
+    fwrite(&s_mark, 1, sizeof(s_mark), f);
+    fclose(f);
+    fs_cache_invalidate(s_config.state_path);
+}
+
+/**
+ * @brief Check whether a path names an lz_stream file
+ *
+ * @param path File path
+ * @return true if path ends in ".lz"
+ */
+static bool is_compressed(const char *path)
+{
+    const char *dot = strrchr(path, '.');
+    return dot && strcmp(dot, ".lz") == 0;
+}
+
+/**
+ * @brief Read one file end to end
+ *
+ * @param path File path
+ * @param bytes Receives the number of bytes read
+ * @return esp_err_t ESP_OK if the file read cleanly, ESP_ERR_INVALID_STATE if
+ *         stopped partway, otherwise the read or CRC error
+ */
+static esp_err_t verify_file(const char *path, size_t *bytes)
+{
+    esp_err_t ret = ESP_OK;
+    size_t n = 0;
+    *bytes = 0;
+
+    if (is_compressed(path)) {
+        // Decoding checks every block's CRC
+        ret = lz_stream_reader_open(&s_reader, path);
+        while (ret == ESP_OK && !s_stop) {
+            ret = lz_stream_read(&s_reader, s_chunk, sizeof(s_chunk), &n);
+            if (n == 0) {
+                break;
+            }
+            *bytes += n;
+        }
+        if (s_reader.file) {
+            lz_stream_reader_close(&s_reader);
+        }
+    } else {
+        // Reading every block makes LittleFS walk and check the file's metadata
+        FILE *f = fopen(path, "r");
+        if (!f) {
+            return ESP_FAIL;
+        }
+        while (!s_stop && (n = fread(s_chunk, 1, sizeof(s_chunk), f)) > 0) {
+            *bytes += n;
+        }
+        if (ferror(f)) {
+            ret = ESP_FAIL;
+        }
+        fclose(f);
+    }
+
+    if (ret == ESP_OK && s_stop) {
+        ret = ESP_ERR_INVALID_STATE;
+    }
+    return ret;
+}
+
+/**
+ * @brief Verify one file and record the outcome
+ *
+ * @param path File path
+ */
+static void scan_file(const char *path)
+{
+    size_t bytes = 0;
+    esp_err_t ret = verify_file(path, &bytes);
+    if (ret == ESP_ERR_INVALID_STATE) {
+        return;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    if (ret == ESP_OK) {
+        s_progress.files_verified++;
+        s_progress.bytes_verified += bytes;
+        strlcpy(s_progress.last_verified, path, sizeof(s_progress.last_verified));
+    } else {
+        s_progress.files_failed++;
+        strlcpy(s_progress.last_failed, path, sizeof(s_progress.last_failed));
+    }
+    xSemaphoreGive(s_lock);
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Integrity check failed for %s: %s", path, esp_err_to_name(ret));
+    }
+
+    // Failed files count as visited so a bad file cannot stall the scan
+    strlcpy(s_mark.last_verified, path, sizeof(s_mark.last_verified));
+    if (++s_unsaved >= FS_SCAN_SAVE_EVERY) {
+        save_watermark();
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(s_config.pause_ms));
+}
+
+/**
+ * @brief Walk a directory depth-first, verifying files after the watermark
+ *
+ * @param dirpath Path to directory
+ */
+static void scan_dir(const char *dirpath)
+{
+    DIR *dir = opendir(dirpath);
+    if (!dir) {
+        ESP_LOGW(TAG, "opendir failed for %s: errno=%d (%s)", dirpath, errno, strerror(errno));
+        return;
+    }
+
+    struct dirent *ent;
+    while (!s_stop && (ent = readdir(dir)) != NULL) {
+        if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0) {
+            continue;
+        }
+
+        char fullpath[FS_SCAN_PATH_MAX];
+        int written = snprintf(fullpath, sizeof(fullpath), "%s/%s", dirpath, ent->d_name);
+        if (written < 0 || written >= (int)sizeof(fullpath)) {
+            ESP_LOGW(TAG, "Path too long, skipping: %s/%s", dirpath, ent->d_name);
+            continue;
+        }
+        if (strcmp(fullpath, s_config.state_path) == 0) {
+            continue;
+        }
+
+        struct stat st;
+        if (stat(fullpath, &st) == 0 && S_ISDIR(st.st_mode)) {
+            scan_dir(fullpath);
+            continue;
+        }
+
+        // Skip what the interrupted pass already covered
+        if (s_resuming) {
+            s_resuming = (strcmp(fullpath, s_mark.last_verified) != 0);
+            continue;
+        }
+
+        scan_file(fullpath);
+    }
+
+    closedir(dir);
+}
+
+/**
+ * @brief Scan task: one pass over the tree, resuming from the watermark
+ *
+ * @param arg Unused
+ */
+static void scan_task(void *arg)
+{
+    (void)arg;
+
+    load_watermark();
+    s_resuming = (s_mark.last_verified[0] != '\0');
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    s_progress.resumed = s_resuming;
+    s_progress.passes_completed = s_mark.passes_completed;
+    xSemaphoreGive(s_lock);
+
+    ESP_LOGI(TAG, "Scan %s on core %d", s_resuming ? "resuming" : "starting", xPortGetCoreID());
+
+    scan_dir(s_config.root);
+
+    // Watermark file vanished since it was saved; cover the whole tree
+    if (s_resuming && !s_stop) {
+        ESP_LOGW(TAG, "Watermark %s not found, rescanning from start", s_mark.last_verified);
+        s_resuming = false;
+        scan_dir(s_config.root);
+    }
+
+    if (!s_stop) {
+        s_mark.passes_completed++;
+        s_mark.last_verified[0] = '\0';
+    }
+    save_watermark();
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    s_progress.state = s_stop ? FS_SCAN_STOPPED : FS_SCAN_DONE;
+    s_progress.passes_completed = s_mark.passes_completed;
+    xSemaphoreGive(s_lock);
+
+    ESP_LOGI(TAG, "Scan %s: verified=%u failed=%u bytes=%llu",
+             s_stop ? "stopped" : "complete",
+             (unsigned)s_progress.files_verified, (unsigned)s_progress.files_failed,
+             (unsigned long long)s_progress.bytes_verified);
+
+    // Signal fs_scan_stop() and exit
+    xSemaphoreGive(s_done);
+    vTaskDelete(NULL);
+}
+
+esp_err_t fs_scan_start(const fs_scan_config_t *config)
+{
+    if (!config || !config->root || !config->state_path) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_task != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (s_lock == NULL) {
+        s_lock = xSemaphoreCreateMutex();
+        s_done = xSemaphoreCreateBinary();
+        if (s_lock == NULL || s_done == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    s_config = *config;
+    s_stop = false;
+    memset(&s_progress, 0, sizeof(s_progress));
+    s_progress.state = FS_SCAN_RUNNING;
+
+    // Below the app's tasks, on the core the app does not start on
+    if (xTaskCreatePinnedToCore(scan_task, "fs_scan", FS_SCAN_TASK_STACK, NULL,
+                                tskIDLE_PRIORITY + 1, &s_task, FS_SCAN_CORE) != pdPASS) {
+        s_task = NULL;
+        s_progress.state = FS_SCAN_IDLE;
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+void fs_scan_stop(void)
+{
+    if (s_task == NULL) {
+        return;
+    }
+
+    s_stop = true;
+    xSemaphoreTake(s_done, portMAX_DELAY);
+    s_task = NULL;
+}
+
+void fs_scan_get_progress(fs_scan_progress_t *progress)
+{
+    if (!progress) {
+        return;
+    }
+    if (s_lock == NULL) {
+        memset(progress, 0, sizeof(*progress));
+        return;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    *progress = s_progress;
+    xSemaphoreGive(s_lock);
+}
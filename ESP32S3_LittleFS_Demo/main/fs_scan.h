@@ -0,0 +1,85 @@
+/*
+ * Background integrity scan of the LittleFS partition.
+ *
+ * After mount, a low-priority task on the second core reads every file end
+ * to end, checking lz_stream block CRCs for compressed logs. Progress is
+ * saved as a "last verified" watermark so a scan cut short by a reset picks
+ * up where it stopped, and the application never waits for it.
+ */
+
+#ifndef FS_SCAN_H
+#define FS_SCAN_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FS_SCAN_PATH_MAX  64
+
+/**
+ * @brief Scanner state
+ */
+typedef enum {
+    FS_SCAN_IDLE = 0,
+    FS_SCAN_RUNNING,
+    FS_SCAN_DONE,
+    FS_SCAN_STOPPED,
+} fs_scan_state_t;
+
+/**
+ * @brief Scanner settings
+ */
+typedef struct {
+    const char *root;           // Directory to scan, normally the mount point
+    const char *state_path;     // Watermark file; skipped by the scan
+    uint32_t pause_ms;          // Delay between files to leave flash bandwidth to the app
+} fs_scan_config_t;
+
+/**
+ * @brief Snapshot of scan progress
+ */
+typedef struct {
+    fs_scan_state_t state;
+    bool resumed;               // This pass continued one interrupted earlier
+    uint32_t passes_completed;  // Full passes finished, persisted across boots
+    uint32_t files_verified;    // Files read cleanly this boot
+    uint32_t files_failed;      // Files that could not be read or failed a CRC
+    uint64_t bytes_verified;
+    char last_verified[FS_SCAN_PATH_MAX];
+    char last_failed[FS_SCAN_PATH_MAX];
+} fs_scan_progress_t;
+
+/**
+ * @brief Start the scan task
+ *
+ * @param config Settings; strings must stay valid while the scan runs
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_STATE if started and not yet stopped,
+ *         ESP_ERR_NO_MEM if the task cannot be created
+ */
+esp_err_t fs_scan_start(const fs_scan_config_t *config);
+
+/**
+ * @brief Stop the scan task, saving the watermark, and wait for it to exit
+ *
+ * Must be called before the filesystem is unmounted.
+ */
+void fs_scan_stop(void);
+
+/**
+ * @brief Copy current scan progress
+ *
+ * @param progress Receives the snapshot
+ */
+void fs_scan_get_progress(fs_scan_progress_t *progress);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,275 @@
+/*
+ * Buffered, size-rotated log appender for the LittleFS demo.
+ */
+
+#include "log_appender.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "fs_cache.h"
+
+static const char *TAG = "log_appender";
+
+/**
+ * @brief Open the log file in append mode and record its size
+ *
+ * @param appender Appender whose path to open
+ * @return esp_err_t ESP_OK on success, ESP_FAIL if fopen fails
+ */
+static esp_err_t open_file(log_appender_t *appender)
+{
+    appender->file = fopen(appender->path, "a");
+    if (!appender->file) {
+        ESP_LOGE(TAG, "fopen(a) failed for %s: errno=%d (%s)",
+                 appender->path, errno, strerror(errno));
+        return ESP_FAIL;
+    }
+
+    // The RAM buffer already batches writes; skip the stdio copy
+    setvbuf(appender->file, NULL, _IONBF, 0);
+
+    struct stat st;
+    appender->file_size = (stat(appender->path, &st) == 0) ? (size_t)st.st_size : 0;
+    return ESP_OK;
+}
+
+/**
+ * @brief Shift <path> to <path>.1, <path>.1 to <path>.2, ... and start a new file
+ *
+ * @param appender Appender to rotate
+ * @return esp_err_t ESP_OK on success, ESP_FAIL if the new file cannot be opened
+ */
+static esp_err_t rotate(log_appender_t *appender)
+{
+    char from[LOG_APPENDER_PATH_MAX + 4];
+    char to[LOG_APPENDER_PATH_MAX + 4];
+
+    fclose(appender->file);
+    appender->file = NULL;
+
+    // Oldest backup is dropped; with no backups the log simply restarts
+    const unsigned keep = appender->config.max_backups;
+    snprintf(to, sizeof(to), "%s.%u", appender->path, keep);
+    unlink(keep > 0 ? to : appender->path);
+
+    for (unsigned i = keep; i > 0; i--) {
+        if (i > 1) {
+            snprintf(from, sizeof(from), "%s.%u", appender->path, i - 1);
+        } else {
+            strlcpy(from, appender->path, sizeof(from));
+        }
+        snprintf(to, sizeof(to), "%s.%u", appender->path, i);
+
+        if (rename(from, to) != 0 && errno != ENOENT) {
+            ESP_LOGW(TAG, "rename %s -> %s failed: errno=%d", from, to, errno);
+        }
+    }
+
+    fs_cache_invalidate(appender->path);
+    ESP_LOGI(TAG, "Rotated %s", appender->path);
+    return open_file(appender);
+}
+
+/**
+ * @brief Append bytes to the file, rotating first if they would overflow it
+ *
+ * @param appender Appender holding the lock
+ * @param data Bytes to write
+ * @param len Number of bytes
+ * @return esp_err_t ESP_OK on success, ESP_FAIL on a write error
+ */
+static esp_err_t append_bytes(log_appender_t *appender, const void *data, size_t len)
+{
+    if (appender->file_size > 0 &&
+        appender->file_size + len > appender->config.max_file_size) {
+        esp_err_t ret = rotate(appender);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    size_t n = fwrite(data, 1, len, appender->file);
+    appender->file_size += n;
+    return (n == len) ? ESP_OK : ESP_FAIL;
+}
+
+/**
+ * @brief Write text to the file, compressing it if configured, and sync
+ *
+ * @param appender Appender holding the lock
+ * @param data Text to write
+ * @param len Number of bytes
+ * @return esp_err_t ESP_OK on success, ESP_FAIL on a write or sync error
+ */
+static esp_err_t write_through(log_appender_t *appender, const char *data, size_t len)
+{
+    esp_err_t ret = ESP_OK;
+
+    if (!appender->config.compress) {
+        ret = append_bytes(appender, data, len);
+    } else {
+        // One self-contained block per LZ_STREAM_BLOCK_MAX bytes of text
+        for (size_t off = 0; off < len && ret == ESP_OK; off += LZ_STREAM_BLOCK_MAX) {
+            const size_t chunk = (len - off < LZ_STREAM_BLOCK_MAX) ? len - off : LZ_STREAM_BLOCK_MAX;
+            const size_t packed_len = lz_stream_encode(data + off, chunk, appender->packed);
+            ret = append_bytes(appender, appender->packed, packed_len);
+        }
+    }
+    fs_cache_invalidate(appender->path);
+
+    // One sync per batch
+    if (ret != ESP_OK || !appender->file || fsync(fileno(appender->file)) != 0) {
+        ESP_LOGE(TAG, "Write to %s failed: errno=%d (%s)",
+                 appender->path, errno, strerror(errno));
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Flush the buffer; caller holds the lock
+ *
+ * @param appender Appender holding the lock
+ * @return esp_err_t ESP_OK on success, ESP_FAIL on a write error
+ */
+static esp_err_t flush_locked(log_appender_t *appender)
+{
+    if (appender->buffered == 0) {
+        return ESP_OK;
+    }
+    if (!appender->file) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // Lines are dropped on failure so a full filesystem cannot wedge logging
+    esp_err_t ret = write_through(appender, appender->buffer, appender->buffered);
+    appender->buffered = 0;
+    return ret;
+}
+
+/**
+ * @brief Check whether the oldest buffered line has waited long enough
+ *
+ * @param appender Appender holding the lock
+ * @return true if a flush is due
+ */
+static bool flush_due(const log_appender_t *appender)
+{
+    const int64_t age_us = esp_timer_get_time() - appender->oldest_us;
+    return appender->buffered > 0 &&
+           age_us >= (int64_t)appender->config.flush_interval_ms * 1000;
+}
+
+esp_err_t log_appender_open(log_appender_t *appender, const log_appender_config_t *config)
+{
+    if (!appender || !config || !config->path ||
+        strlen(config->path) >= LOG_APPENDER_PATH_MAX ||
+        config->flush_bytes == 0 || config->flush_bytes > LOG_APPENDER_BUFFER_SIZE ||
+        config->max_file_size < LOG_APPENDER_BUFFER_SIZE) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(appender, 0, sizeof(*appender));
+    appender->config = *config;
+    strlcpy(appender->path, config->path, sizeof(appender->path));
+    appender->config.path = appender->path;
+
+    appender->lock = xSemaphoreCreateMutex();
+    if (!appender->lock) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    esp_err_t ret = open_file(appender);
+    if (ret != ESP_OK) {
+        vSemaphoreDelete(appender->lock);
+        appender->lock = NULL;
+    }
+    return ret;
+}
+
+esp_err_t log_appender_write(log_appender_t *appender, const char *text)
+{
+    if (!appender || !appender->lock || !text) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const size_t len = strlen(text);
+    esp_err_t ret = ESP_OK;
+
+    xSemaphoreTake(appender->lock, portMAX_DELAY);
+
+    // Make room, or pass oversized text straight through
+    if (appender->buffered + len > LOG_APPENDER_BUFFER_SIZE) {
+        ret = flush_locked(appender);
+    }
+
+    if (len > LOG_APPENDER_BUFFER_SIZE) {
+        if (ret == ESP_OK) {
+            ret = write_through(appender, text, len);
+        }
+    } else {
+        if (appender->buffered == 0) {
+            appender->oldest_us = esp_timer_get_time();
+        }
+        memcpy(appender->buffer + appender->buffered, text, len);
+        appender->buffered += len;
+
+        if (appender->buffered >= appender->config.flush_bytes || flush_due(appender)) {
+            esp_err_t flush_ret = flush_locked(appender);
+            if (ret == ESP_OK) {
+                ret = flush_ret;
+            }
+        }
+    }
+
+    xSemaphoreGive(appender->lock);
+    return ret;
+}
+
+esp_err_t log_appender_poll(log_appender_t *appender)
+{
+    if (!appender || !appender->lock) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    xSemaphoreTake(appender->lock, portMAX_DELAY);
+    esp_err_t ret = flush_due(appender) ? flush_locked(appender) : ESP_OK;
+    xSemaphoreGive(appender->lock);
+    return ret;
+}
+
+esp_err_t log_appender_flush(log_appender_t *appender)
+{
+    if (!appender || !appender->lock) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    xSemaphoreTake(appender->lock, portMAX_DELAY);
+    esp_err_t ret = flush_locked(appender);
+    xSemaphoreGive(appender->lock);
+    return ret;
+}
+
+void log_appender_close(log_appender_t *appender)
+{
+    if (!appender || !appender->lock) {
+        return;
+    }
+
+    xSemaphoreTake(appender->lock, portMAX_DELAY);
+    flush_locked(appender);
+    if (appender->file) {
+        fclose(appender->file);
+        appender->file = NULL;
+    }
+    xSemaphoreGive(appender->lock);
+
+    vSemaphoreDelete(appender->lock);
+    appender->lock = NULL;
+}
@@ -0,0 +1,112 @@
+/*
+ * Buffered, size-rotated log appender for the LittleFS demo.
+ *
+ * The log file stays open for the lifetime of the appender. Lines collect
+ * in a RAM buffer and reach LittleFS in one write when the buffer passes
+ * a size threshold or its oldest line passes an age threshold, so frequent
+ * logging costs one open, write, and sync per batch instead of per line.
+ * With compression enabled each batch is written as lz_stream blocks, and
+ * size limits apply to the compressed bytes on flash.
+ */
+
+#ifndef LOG_APPENDER_H
+#define LOG_APPENDER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "esp_err.h"
+
+#include "lz_stream.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LOG_APPENDER_BUFFER_SIZE  1024
+#define LOG_APPENDER_PATH_MAX     64
+
+/**
+ * @brief Appender settings
+ */
+typedef struct {
+    const char *path;           // Log file path
+    size_t flush_bytes;         // Flush once this many bytes are buffered
+    uint32_t flush_interval_ms; // Flush once the oldest buffered line is this old
+    size_t max_file_size;       // Rotate before the file would grow past this size
+    uint8_t max_backups;        // Rotated files kept as <path>.1 ... <path>.N
+    bool compress;              // Write LZSS blocks readable with lz_stream_read()
+} log_appender_config_t;
+
+/**
+ * @brief Appender state; owned by the caller, touched only through this API
+ */
+typedef struct {
+    log_appender_config_t config;
+    char path[LOG_APPENDER_PATH_MAX];
+    FILE *file;
+    size_t file_size;
+    size_t buffered;
+    int64_t oldest_us;
+    SemaphoreHandle_t lock;
+    char buffer[LOG_APPENDER_BUFFER_SIZE];
+    uint8_t packed[LZ_STREAM_BLOCK_BOUND];  // Encoder output when compressing
+} log_appender_t;
+
+/**
+ * @brief Open the log file for appending and keep it open
+ *
+ * @param appender Appender to initialize
+ * @param config Settings; config->path is copied
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_ARG for bad settings,
+ *         ESP_ERR_NO_MEM if the lock cannot be created, ESP_FAIL if fopen fails
+ */
+esp_err_t log_appender_open(log_appender_t *appender, const log_appender_config_t *config);
+
+/**
+ * @brief Buffer text for the log, flushing when a threshold is reached
+ *
+ * Safe to call from several tasks. Text longer than the buffer is written
+ * straight through after the pending lines.
+ *
+ * @param appender Open appender
+ * @param text Text to append, normally one line ending in '\n'
+ * @return esp_err_t ESP_OK on success, otherwise the flush or write error
+ */
+esp_err_t log_appender_write(log_appender_t *appender, const char *text);
+
+/**
+ * @brief Flush buffered lines if the age threshold has passed
+ *
+ * Call periodically so a quiet log still reaches flash on time.
+ *
+ * @param appender Open appender
+ * @return esp_err_t ESP_OK on success, otherwise the flush error
+ */
+esp_err_t log_appender_poll(log_appender_t *appender);
+
+/**
+ * @brief Write buffered lines to the file and sync it
+ *
+ * @param appender Open appender
+ * @return esp_err_t ESP_OK on success, ESP_FAIL if the write or sync fails
+ */
+esp_err_t log_appender_flush(log_appender_t *appender);
+
+/**
+ * @brief Flush and close the log file
+ *
+ * @param appender Open appender
+ */
+void log_appender_close(log_appender_t *appender);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,338 @@
+/*
+ * Block-compressed log files for the LittleFS demo.
+ */
+
+#include "lz_stream.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+
+static const char *TAG = "lz_stream";
+
+#define LZ_MAGIC          0x5A4C  // "LZ"
+#define LZ_FLAG_STORED    0x01    // Payload is the raw text
+
+// Token layout: 1 flag bit, then an 8-bit literal or a 10-bit offset and 5-bit length
+#define LZ_OFFSET_BITS    10
+#define LZ_LENGTH_BITS    5
+#define LZ_MIN_MATCH      3
+#define LZ_MAX_MATCH      (LZ_MIN_MATCH + (1 << LZ_LENGTH_BITS) - 1)
+
+_Static_assert((1 << LZ_OFFSET_BITS) >= LZ_STREAM_BLOCK_MAX, "offset field must span a block");
+
+/**
+ * @brief Block header, stored little-endian in front of each payload
+ */
+typedef struct {
+    uint16_t magic;
+    uint8_t flags;
+    uint8_t reserved;
+    uint16_t raw_len;
+    uint16_t stored_len;
+    uint32_t crc;               // CRC32 of the raw text
+} lz_block_header_t;
+
+_Static_assert(sizeof(lz_block_header_t) == LZ_STREAM_HEADER_SIZE, "header layout");
+
+/**
+ * @brief MSB-first bit writer that refuses to grow past a cap
+ */
+typedef struct {
+    uint8_t *out;
+    size_t cap;
+    size_t pos;
+    uint32_t acc;
+    unsigned nbits;
+    bool overflow;
+} bit_writer_t;
+
+/**
+ * @brief MSB-first bit reader over a bounded buffer
+ */
+typedef struct {
+    const uint8_t *in;
+    size_t len;
+    size_t pos;
+    uint32_t acc;
+    unsigned nbits;
+} bit_reader_t;
+
+static void put_bits(bit_writer_t *w, uint32_t value, unsigned count)
+{
+    w->acc = (w->acc << count) | (value & ((1u << count) - 1));
+    w->nbits += count;
+
+    while (w->nbits >= 8) {
+        w->nbits -= 8;
+        if (w->pos >= w->cap) {
+            w->overflow = true;
+            return;
+        }
+        w->out[w->pos++] = (uint8_t)(w->acc >> w->nbits);
+    }
+}
+
+static void flush_bits(bit_writer_t *w)
+{
+    if (w->nbits > 0) {
+        put_bits(w, 0, 8 - w->nbits);
+    }
+}
+
+static bool get_bits(bit_reader_t *r, unsigned count, uint32_t *value)
+{
+    while (r->nbits < count) {
+        if (r->pos >= r->len) {
+            return false;
+        }
+        r->acc = (r->acc << 8) | r->in[r->pos++];
+        r->nbits += 8;
+    }
+
+    r->nbits -= count;
+    *value = (r->acc >> r->nbits) & ((1u << count) - 1);
+    return true;
+}
+
+/**
+ * @brief Find the longest earlier match for src[pos...] within the block
+ *
+ * @param src Block text
+ * @param len Block length
+ * @param pos Current position
+ * @param best_offset Receives the distance back to the match
+ * @return size_t Match length, 0 if shorter than LZ_MIN_MATCH
+ */
+static size_t find_match(const char *src, size_t len, size_t pos, size_t *best_offset)
+{
+    const size_t limit = (len - pos < LZ_MAX_MATCH) ? len - pos : LZ_MAX_MATCH;
+    size_t best_len = 0;
+
+    if (limit < LZ_MIN_MATCH) {
+        return 0;
+    }
+
+    // Nearest candidates first; matches may overlap the current position
+    for (size_t cand = pos; cand-- > 0;) {
+        if (src[cand] != src[pos] || src[cand + best_len] != src[pos + best_len]) {
+            continue;
+        }
+
+        size_t n = 0;
+        while (n < limit && src[cand + n] == src[pos + n]) {
+            n++;
+        }
+        if (n > best_len) {
+            best_len = n;
+            *best_offset = pos - cand;
+            if (n == limit) {
+                break;
+            }
+        }
+    }
+
+    return (best_len >= LZ_MIN_MATCH) ? best_len : 0;
+}
+
+size_t lz_stream_encode(const char *src, size_t len, uint8_t *dst)
+{
+    if (!src || !dst || len == 0 || len > LZ_STREAM_BLOCK_MAX) {
+        return 0;
+    }
+
+    lz_block_header_t header = {
+        .magic = LZ_MAGIC,
+        .raw_len = (uint16_t)len,
+        .crc = esp_rom_crc32_le(0, (const uint8_t *)src, len),
+    };
+
+    // Compressed output must come out strictly smaller than the text
+    bit_writer_t w = {
+        .out = dst + LZ_STREAM_HEADER_SIZE,
+        .cap = len - 1,
+    };
+
+    size_t pos = 0;
+    while (pos < len && !w.overflow) {
+        size_t offset = 0;
+        size_t match = find_match(src, len, pos, &offset);
+
+        if (match > 0) {
+            put_bits(&w, 0, 1);
+            put_bits(&w, (uint32_t)(offset - 1), LZ_OFFSET_BITS);
+            put_bits(&w, (uint32_t)(match - LZ_MIN_MATCH), LZ_LENGTH_BITS);
+            pos += match;
+        } else {
+            put_bits(&w, 1, 1);
+            put_bits(&w, (uint8_t)src[pos], 8);
+            pos++;
+        }
+    }
+    flush_bits(&w);
+
+    // Store incompressible text as is
+    if (w.overflow) {
+        header.flags = LZ_FLAG_STORED;
+        header.stored_len = (uint16_t)len;
+        memcpy(dst + LZ_STREAM_HEADER_SIZE, src, len);
+    } else {
+        header.stored_len = (uint16_t)w.pos;
+    }
+
+    memcpy(dst, &header, sizeof(header));
+    return LZ_STREAM_HEADER_SIZE + header.stored_len;
+}
+
+/**
+ * @brief Expand an LZSS payload into exactly raw_len bytes
+ *
+ * @param in Payload
+ * @param in_len Payload length
+ * @param out Destination of raw_len bytes
+ * @param raw_len Expected text length
+ * @return true if the payload decoded cleanly
+ */
+static bool decode_payload(const uint8_t *in, size_t in_len, char *out, size_t raw_len)
+{
+    bit_reader_t r = {
+        .in = in,
+        .len = in_len,
+    };
+
+    size_t pos = 0;
+    while (pos < raw_len) {
+        uint32_t flag;
+        uint32_t value;
+        if (!get_bits(&r, 1, &flag)) {
+            return false;
+        }
+
+        if (flag) {
+            if (!get_bits(&r, 8, &value)) {
+                return false;
+            }
+            out[pos++] = (char)value;
+            continue;
+        }
+
+        uint32_t length;
+        if (!get_bits(&r, LZ_OFFSET_BITS, &value) || !get_bits(&r, LZ_LENGTH_BITS, &length)) {
+            return false;
+        }
+        const size_t offset = value + 1;
+        length += LZ_MIN_MATCH;
+        if (offset > pos || length > raw_len - pos) {
+            return false;
+        }
+
+        // Byte by byte so overlapping matches repeat correctly
+        for (uint32_t i = 0; i < length; i++, pos++) {
+            out[pos] = out[pos - offset];
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Read and decode the next block into the reader's buffer
+ *
+ * @param reader Open reader with no unread bytes
+ * @return esp_err_t ESP_OK on success (len is 0 at end of stream),
+ *         ESP_ERR_INVALID_CRC if the block is corrupt
+ */
+static esp_err_t load_block(lz_stream_reader_t *reader)
+{
+    lz_block_header_t header;
+
+    reader->pos = 0;
+    reader->len = 0;
+
+    size_t n = fread(&header, 1, sizeof(header), reader->file);
+    if (n == 0) {
+        return ESP_OK;
+    }
+
+    if (n == sizeof(header) &&
+        (header.magic != LZ_MAGIC || header.raw_len == 0 ||
+         header.raw_len > LZ_STREAM_BLOCK_MAX || header.stored_len > LZ_STREAM_BLOCK_MAX)) {
+        ESP_LOGE(TAG, "Bad block header");
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    if (n < sizeof(header) ||
+        fread(reader->packed, 1, header.stored_len, reader->file) != header.stored_len) {
+        ESP_LOGW(TAG, "Truncated block at end of file, ignoring");
+        return ESP_OK;
+    }
+
+    // Decode into raw and confirm it matches what was written
+    bool ok;
+    if (header.flags & LZ_FLAG_STORED) {
+        ok = (header.stored_len == header.raw_len);
+        if (ok) {
+            memcpy(reader->raw, reader->packed, header.raw_len);
+        }
+    } else {
+        ok = decode_payload(reader->packed, header.stored_len, reader->raw, header.raw_len);
+    }
+
+    if (!ok || esp_rom_crc32_le(0, (const uint8_t *)reader->raw, header.raw_len) != header.crc) {
+        ESP_LOGE(TAG, "Block failed to decode");
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    reader->len = header.raw_len;
+    return ESP_OK;
+}
+
+esp_err_t lz_stream_reader_open(lz_stream_reader_t *reader, const char *path)
+{
+    if (!reader || !path) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(reader, 0, sizeof(*reader));
+    reader->file = fopen(path, "r");
+    if (!reader->file) {
+        ESP_LOGE(TAG, "fopen(r) failed for %s: errno=%d (%s)", path, errno, strerror(errno));
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+esp_err_t lz_stream_read(lz_stream_reader_t *reader, char *buf, size_t cap, size_t *out_len)
+{
+    if (!reader || !reader->file || !buf || !out_len) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *out_len = 0;
+    if (reader->pos == reader->len) {
+        esp_err_t ret = load_block(reader);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    // Hand out what is left of the current block
+    size_t n = reader->len - reader->pos;
+    if (n > cap) {
+        n = cap;
+    }
+    memcpy(buf, reader->raw + reader->pos, n);
+    reader->pos += n;
+    *out_len = n;
+    return ESP_OK;
+}
+
+void lz_stream_reader_close(lz_stream_reader_t *reader)
+{
+    if (reader && reader->file) {
+        fclose(reader->file);
+        reader->file = NULL;
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Block-compressed log files for the LittleFS demo.
+ *
+ * A compressed file is a sequence of self-contained blocks, each holding at
+ * most LZ_STREAM_BLOCK_MAX bytes of text. Blocks use LZSS with a window the
+ * size of the block, so writer and reader only ever hold one block in RAM and
+ * a file can be appended to after a reboot without restoring encoder state.
+ */
+
+#ifndef LZ_STREAM_H
+#define LZ_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define LZ_STREAM_BLOCK_MAX    1024
+#define LZ_STREAM_HEADER_SIZE  12
+#define LZ_STREAM_BLOCK_BOUND  (LZ_STREAM_HEADER_SIZE + LZ_STREAM_BLOCK_MAX)
+
+/**
+ * @brief Encode one block of text
+ *
+ * Falls back to storing the text uncompressed when LZSS does not shrink it.
+ *
+ * @param src Text to encode
+ * @param len Number of bytes, at most LZ_STREAM_BLOCK_MAX
+ * @param dst Destination of at least LZ_STREAM_BLOCK_BOUND bytes
+ * @return size_t Encoded block size including the header, 0 if len is out of range
+ */
+size_t lz_stream_encode(const char *src, size_t len, uint8_t *dst);
+
+/**
+ * @brief Streaming reader state; owned by the caller
+ */
+typedef struct {
+    FILE *file;
+    size_t pos;                                 // Next unread byte in raw
+    size_t len;                                 // Decoded bytes in raw
+    char raw[LZ_STREAM_BLOCK_MAX];
+    uint8_t packed[LZ_STREAM_BLOCK_MAX];
+} lz_stream_reader_t;
+
+/**
+ * @brief Open a compressed file for reading
+ *
+ * @param reader Reader to initialize
+ * @param path Path to compressed file
+ * @return esp_err_t ESP_OK on success, ESP_FAIL if fopen fails
+ */
+esp_err_t lz_stream_reader_open(lz_stream_reader_t *reader, const char *path);
+
+/**
+ * @brief Read decompressed text
+ *
+ * A block cut short at the end of the file, as left by a power loss during
+ * a write, ends the stream instead of failing it.
+ *
+ * @param reader Open reader
+ * @param buf Destination buffer
+ * @param cap Size of buf
+ * @param out_len Receives the number of bytes read; 0 at end of stream
+ * @return esp_err_t ESP_OK on success, ESP_ERR_INVALID_CRC if a block is corrupt
+ */
+esp_err_t lz_stream_read(lz_stream_reader_t *reader, char *buf, size_t cap, size_t *out_len);
+
+/**
+ * @brief Close the reader's file
+ *
+ * @param reader Open reader
+ */
+void lz_stream_reader_close(lz_stream_reader_t *reader);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -19,6 +19,11 @@
 #include "esp_log.h"
 #include "esp_littlefs.h"
 
+#include "fs_cache.h"
+#include "fs_scan.h"
+#include "log_appender.h"
+#include "lz_stream.h"
+
 static const char *TAG = "littlefs_demo";
 
 /**
@@ -55,7 +60,8 @@ static esp_err_t littlefs_mount(void)
         ESP_LOGW(TAG, "Mounted, but failed to query info: %s", esp_err_to_name(ret));
     }
 
-    return ESP_OK;
+    // Start the listing and usage cache for this partition
+    return fs_cache_init(conf.partition_label);
 }
 
 /**
@@ -89,6 +95,7 @@ static void ensure_dir(const char *path)
 
     // Create directory
     if (mkdir(path, 0775) == 0) {
+        fs_cache_invalidate(path);
         ESP_LOGI(TAG, "Created directory: %s", path);
         return;
     }
@@ -116,6 +123,7 @@ static void write_text_file(const char *path, const char *text)
     
     // Close file
     fclose(f);
+    fs_cache_invalidate(path);
 
     ESP_LOGI(TAG, "Wrote %u bytes to %s", (unsigned)n, path);
 }
@@ -140,6 +148,7 @@ static void append_text_file(const char *path, const char *text)
     
     // Close file
     fclose(f);
+    fs_cache_invalidate(path);
 
     ESP_LOGI(TAG, "Appended %u bytes to %s", (unsigned)n, path);
 }
@@ -173,54 +182,81 @@ static void read_text_file(const char *path)
 }
 
 /**
- * @brief List directory contents   
+ * @brief Read and log contents of a compressed text file 
  * 
- * @param dirpath Path to directory to list 
+ * @param path Path to file written by a compressing log_appender 
  */
-static void list_dir(const char *dirpath)
+static void read_compressed_text_file(const char *path)
 {
-    // Open directory
-    DIR *dir = opendir(dirpath);
-    if (!dir) {
-        ESP_LOGE(TAG, "opendir failed for %s: errno=%d (%s)", dirpath, errno, strerror(errno));
+    // Reader holds one decoded block; keep it off the task stack
+    static lz_stream_reader_t reader;
+
+    // Open file for reading
+    if (lz_stream_reader_open(&reader, path) != ESP_OK) {
         return;
     }
 
-    ESP_LOGI(TAG, "Directory listing for: %s", dirpath);
+    ESP_LOGI(TAG, "---- Begin file: %s ----", path);
 
-    // Read entries
-    struct dirent *ent;
-    while ((ent = readdir(dir)) != NULL) {
-        // Skip "." and ".."
-        if (strcmp(ent->d_name, ".") == 0 || strcmp(ent->d_name, "..") == 0) {
-            continue;
+    // Decompress in chunks and log complete lines
+    char line[128];
+    size_t line_len = 0;
+    char chunk[64];
+    size_t n = 0;
+    esp_err_t ret;
+    while ((ret = lz_stream_read(&reader, chunk, sizeof(chunk), &n)) == ESP_OK && n > 0) {
+        for (size_t i = 0; i < n; i++) {
+            line[line_len++] = chunk[i];
+            if (chunk[i] == '\n' || line_len == sizeof(line) - 1) {
+                line[line_len] = '\0';
+                ESP_LOGI(TAG, "%s", line);
+                line_len = 0;
+            }
         }
+    }
 
-        char fullpath[256];
-        int written = snprintf(
-            fullpath,
-            sizeof(fullpath),
-            "%s/%s",
-            dirpath,
-            ent->d_name
-        );
-
-        if (written < 0 || written >= (int)sizeof(fullpath)) {
-            ESP_LOGW(TAG, "Path truncated, skipping: %s/%s", dirpath, ent->d_name);
-            continue;
-        }
+    if (line_len > 0) {
+        line[line_len] = '\0';
+        ESP_LOGI(TAG, "%s", line);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Decompression failed for %s: %s", path, esp_err_to_name(ret));
+    }
 
-        struct stat st;
-        if (stat(fullpath, &st) == 0) {
-            const char *type = S_ISDIR(st.st_mode) ? "DIR " : "FILE";
-            ESP_LOGI(TAG, "  %s  %s  size=%u", type, ent->d_name, (unsigned)st.st_size);
-        } else {
-            ESP_LOGI(TAG, "  ?    %s", ent->d_name);
-        }
+    // Close file
+    lz_stream_reader_close(&reader);
+    ESP_LOGI(TAG, "---- End file ----");
+}
+
+/**
+ * @brief List directory contents from the listing cache
+ * 
+ * @param dirpath Path to directory to list 
+ */
+static void list_dir(const char *dirpath)
+{
+    fs_cache_entry_t entries[FS_CACHE_MAX_ENTRIES];
+    size_t count = 0;
+    bool truncated = false;
+
+    // Fetch listing; LittleFS is only read on a cache miss
+    esp_err_t ret = fs_cache_list(dirpath, entries, FS_CACHE_MAX_ENTRIES, &count, &truncated);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Listing failed for %s: %s", dirpath, esp_err_to_name(ret));
+        return;
     }
 
-    // Close directory
-    closedir(dir);
+    ESP_LOGI(TAG, "Directory listing for: %s", dirpath);
+
+    // Log entries
+    for (size_t i = 0; i < count; i++) {
+        const char *type = entries[i].is_dir ? "DIR " : "FILE";
+        ESP_LOGI(TAG, "  %s  %s  size=%u", type, entries[i].name, (unsigned)entries[i].size);
+    }
+
+    if (truncated) {
+        ESP_LOGW(TAG, "  ... listing truncated");
+    }
 }
 
 /**
@@ -232,10 +268,10 @@ static void show_fs_info(void)
     size_t total = 0;
     size_t used = 0;
 
-    // Query LittleFS usage
-    esp_err_t ret = esp_littlefs_info("littlefs", &total, &used);
+    // Query usage; LittleFS is only read after a write
+    esp_err_t ret = fs_cache_usage(&total, &used);
     if (ret != ESP_OK) {
-        ESP_LOGE(TAG, "esp_littlefs_info failed: %s", esp_err_to_name(ret));
+        ESP_LOGE(TAG, "fs_cache_usage failed: %s", esp_err_to_name(ret));
         return;
     }
 
@@ -243,6 +279,27 @@ static void show_fs_info(void)
              (unsigned)used, (unsigned)total, (unsigned)(total - used));
 }
 
+/**
+ * @brief Show background integrity scan progress
+ * 
+ */
+static void show_scan_progress(void)
+{
+    static const char *states[] = { "idle", "running", "done", "stopped" };
+    fs_scan_progress_t p;
+
+    // Snapshot progress
+    fs_scan_get_progress(&p);
+
+    ESP_LOGI(TAG, "Integrity scan: %s%s, verified=%u failed=%u bytes=%llu passes=%u",
+             states[p.state], p.resumed ? " (resumed)" : "",
+             (unsigned)p.files_verified, (unsigned)p.files_failed,
+             (unsigned long long)p.bytes_verified, (unsigned)p.passes_completed);
+    if (p.files_failed > 0) {
+        ESP_LOGW(TAG, "Last failed file: %s", p.last_failed);
+    }
+}
+
 /**
  * @brief Application main entry point
  * 
@@ -258,6 +315,17 @@ void app_main(void)
         return;
     }
 
+    // Verify existing files in the background instead of before startup
+    const fs_scan_config_t scan_cfg = {
+        .root = "/littlefs",
+        .state_path = "/littlefs/.fs_scan",
+        .pause_ms = 20,
+    };
+    ret = fs_scan_start(&scan_cfg);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "fs_scan_start failed: %s", esp_err_to_name(ret));
+    }
+
     // Prepare directories and files
     const char *base_dir = "/littlefs";
     const char *cfg_dir  = "/littlefs/config";
@@ -269,7 +337,7 @@ void app_main(void)
 
     // File paths
     const char *cfg_path = "/littlefs/config/device.cfg";
-    const char *log_path = "/littlefs/logs/boot.log";
+    const char *log_path = "/littlefs/logs/boot.lz";
 
     // Write initial config file
     write_text_file(cfg_path,
@@ -280,8 +348,27 @@ void app_main(void)
     // Append to config file
     append_text_file(cfg_path, "log_enabled=true\n");
 
-    // Write initial log file
-    append_text_file(log_path, "boot=ok\n");
+    // Keep the log open, batch appends in RAM, and compress each batch
+    static log_appender_t boot_log;
+    const log_appender_config_t log_cfg = {
+        .path = log_path,
+        .flush_bytes = 512,
+        .flush_interval_ms = 5000,
+        .max_file_size = 16 * 1024,
+        .max_backups = 2,
+        .compress = true,
+    };
+    ret = log_appender_open(&boot_log, &log_cfg);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "log_appender_open failed: %s", esp_err_to_name(ret));
+        fs_scan_stop();
+        littlefs_unmount();
+        return;
+    }
+
+    // Write initial log line and make it durable before continuing
+    log_appender_write(&boot_log, "boot=ok\n");
+    log_appender_flush(&boot_log);
 
     // Read back files
     read_text_file(cfg_path);
@@ -298,16 +385,24 @@ void app_main(void)
     for (int i = 0; i < 5; i++) {
         char buf[64];
         snprintf(buf, sizeof(buf), "tick=%d\n", i);
-        append_text_file(log_path, buf);
+        log_appender_write(&boot_log, buf);
+        log_appender_poll(&boot_log);
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
 
+    // Flush remaining lines and release the handle
+    log_appender_close(&boot_log);
+
     // Final read of log file
-    read_text_file(log_path);
+    read_compressed_text_file(log_path);
     
     // Final filesystem usage
     show_fs_info();
 
+    // Scan must finish or save its watermark before unmount
+    show_scan_progress();
+    fs_scan_stop();
+
     // Optional unmount (usually not required in embedded apps)
     littlefs_unmount();
 
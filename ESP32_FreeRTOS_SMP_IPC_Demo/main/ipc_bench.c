@@ -0,0 +1,443 @@
+/**
+ * @file ipc_bench.c
+ * @brief Round-trip benchmark of FreeRTOS IPC primitives on one core and across cores.
+ *
+ * Each measurement is a ping-pong: the initiator sends a payload to the
+ * responder over one channel and waits for it to come back over a second
+ * channel of the same kind. The initiator timestamps every round trip with
+ * the CPU cycle counter (CCOUNT on Xtensa). Both timestamps are read on the
+ * initiator core, so the counters of the two cores never need to agree.
+ *
+ * Primitives:
+ *   - queue:    xQueueSend / xQueueReceive with payload-sized items
+ *   - notify:   payload copied to a shared slot, then xTaskNotifyGive
+ *   - stream:   stream buffer with the trigger level set to the payload size
+ *   - message:  message buffer, one message per payload
+ *   - event:    payload copied to a shared slot, then an event group bit
+ *   - ring:     lock-free single-producer/single-consumer ring, receiver polls
+ */
+
+#include "ipc_bench.h"
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/event_groups.h"
+#include "freertos/stream_buffer.h"
+#include "freertos/message_buffer.h"
+
+#include "esp_cpu.h"
+#include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
+
+static const char *TAG = "IPC_BENCH";
+
+#define BENCH_MAX_PAYLOAD   256
+#define BENCH_WARMUP        32      // Round trips run before timing starts
+#define BENCH_TASK_STACK    4096
+#define BENCH_TASK_PRIO     8
+#define BENCH_RING_SLOTS    8       // Power of two
+#define BENCH_EVENT_BIT     (1 << 0)
+
+static const size_t s_payload_sizes[] = {4, 32, BENCH_MAX_PAYLOAD};
+
+/* ------------------------ Lock-free ring ------------------------ */
+
+/**
+ * @brief Single-producer/single-consumer ring of fixed-size slots.
+ *
+ * head is written only by the producer and tail only by the consumer. The
+ * release store of head publishes the slot contents; the acquire load on the
+ * other core makes them visible before they are read.
+ */
+typedef struct {
+    uint32_t head;
+    uint32_t tail;
+    uint8_t slots[BENCH_RING_SLOTS][BENCH_MAX_PAYLOAD];
+} spsc_ring_t;
+
+/* ------------------------- Channel ops -------------------------- */
+
+/**
+ * @brief One direction of a ping-pong.
+ */
+typedef struct {
+    QueueHandle_t queue;
+    StreamBufferHandle_t stream;    // Also used for message buffers
+    EventGroupHandle_t events;
+    spsc_ring_t *ring;
+    uint8_t *shared;                // Payload slot for signal-only primitives
+    TaskHandle_t receiver;          // Notification target
+} bench_chan_t;
+
+typedef struct {
+    const char *name;
+    bool (*create)(bench_chan_t *ch, size_t payload);
+    void (*destroy)(bench_chan_t *ch);
+    void (*send)(bench_chan_t *ch, const uint8_t *buf, size_t len);
+    void (*recv)(bench_chan_t *ch, uint8_t *buf, size_t len);
+} bench_ops_t;
+
+static bool queue_create(bench_chan_t *ch, size_t payload)
+{
+    ch->queue = xQueueCreate(1, payload);
+    return ch->queue != NULL;
+}
+
+static void queue_destroy(bench_chan_t *ch)
+{
+    vQueueDelete(ch->queue);
+}
+
+static void queue_send(bench_chan_t *ch, const uint8_t *buf, size_t len)
+{
+    (void)len;
+    (void)xQueueSend(ch->queue, buf, portMAX_DELAY);
+}
+
+static void queue_recv(bench_chan_t *ch, uint8_t *buf, size_t len)
+{
+    (void)len;
+    (void)xQueueReceive(ch->queue, buf, portMAX_DELAY);
+}
+
+static bool shared_create(bench_chan_t *ch, size_t payload)
+{
+    ch->shared = malloc(payload);
+    return ch->shared != NULL;
+}
+
+static void shared_destroy(bench_chan_t *ch)
+{
+    free(ch->shared);
+}
+
+static void notify_send(bench_chan_t *ch, const uint8_t *buf, size_t len)
+{
+    memcpy(ch->shared, buf, len);
+    xTaskNotifyGive(ch->receiver);
+}
+
+static void notify_recv(bench_chan_t *ch, uint8_t *buf, size_t len)
+{
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    memcpy(buf, ch->shared, len);
+}
+
+static bool stream_create(bench_chan_t *ch, size_t payload)
+{
+    // Trigger at a full payload so the receiver wakes once per message
+    ch->stream = xStreamBufferCreate(payload * 2, payload);
+    return ch->stream != NULL;
+}
+
+static void stream_destroy(bench_chan_t *ch)
+{
+    vStreamBufferDelete(ch->stream);
+}
+
+static void stream_send(bench_chan_t *ch, const uint8_t *buf, size_t len)
+{
+    (void)xStreamBufferSend(ch->stream, buf, len, portMAX_DELAY);
+}
+
+static void stream_recv(bench_chan_t *ch, uint8_t *buf, size_t len)
+{
+    size_t got = 0;
+    while (got < len) {
+        got += xStreamBufferReceive(ch->stream, buf + got, len - got, portMAX_DELAY);
+    }
+}
+
+static bool message_create(bench_chan_t *ch, size_t payload)
+{
+    // Each message is stored with a size_t length header
+    ch->stream = xMessageBufferCreate((payload + sizeof(size_t)) * 2);
+    return ch->stream != NULL;
+}
+
+static void message_send(bench_chan_t *ch, const uint8_t *buf, size_t len)
+{
+    (void)xMessageBufferSend(ch->stream, buf, len, portMAX_DELAY);
+}
+
+static void message_recv(bench_chan_t *ch, uint8_t *buf, size_t len)
+{
+    (void)xMessageBufferReceive(ch->stream, buf, len, portMAX_DELAY);
+}
+
+static bool event_create(bench_chan_t *ch, size_t payload)
+{
+    ch->events = xEventGroupCreate();
+    if (ch->events == NULL) {
+        return false;
+    }
+    if (!shared_create(ch, payload)) {
+        vEventGroupDelete(ch->events);
+        return false;
+    }
+    return true;
+}
+
+static void event_destroy(bench_chan_t *ch)
+{
+    vEventGroupDelete(ch->events);
+    shared_destroy(ch);
+}
+
+static void event_send(bench_chan_t *ch, const uint8_t *buf, size_t len)
+{
+    memcpy(ch->shared, buf, len);
+    (void)xEventGroupSetBits(ch->events, BENCH_EVENT_BIT);
+}
+
+static void event_recv(bench_chan_t *ch, uint8_t *buf, size_t len)
+{
+    (void)xEventGroupWaitBits(ch->events, BENCH_EVENT_BIT, pdTRUE, pdTRUE, portMAX_DELAY);
+    memcpy(buf, ch->shared, len);
+}
+
+static bool ring_create(bench_chan_t *ch, size_t payload)
+{
+    (void)payload;
+    ch->ring = calloc(1, sizeof(spsc_ring_t));
+    return ch->ring != NULL;
+}
+
+static void ring_destroy(bench_chan_t *ch)
+{
+    free(ch->ring);
+}
+
+static void ring_send(bench_chan_t *ch, const uint8_t *buf, size_t len)
+{
+    spsc_ring_t *r = ch->ring;
+    const uint32_t head = r->head;
+
+    while (head - __atomic_load_n(&r->tail, __ATOMIC_ACQUIRE) >= BENCH_RING_SLOTS) {
+        taskYIELD();
+    }
+    memcpy(r->slots[head & (BENCH_RING_SLOTS - 1)], buf, len);
+    __atomic_store_n(&r->head, head + 1, __ATOMIC_RELEASE);
+}
+
+static void ring_recv(bench_chan_t *ch, uint8_t *buf, size_t len)
+{
+    spsc_ring_t *r = ch->ring;
+    const uint32_t tail = r->tail;
+
+    // Poll; the yield lets an equal-priority sender on the same core run
+    while (__atomic_load_n(&r->head, __ATOMIC_ACQUIRE) == tail) {
+        taskYIELD();
+    }
+    memcpy(buf, r->slots[tail & (BENCH_RING_SLOTS - 1)], len);
+    __atomic_store_n(&r->tail, tail + 1, __ATOMIC_RELEASE);
+}
+
+static const bench_ops_t s_primitives[] = {
+    {"queue",   queue_create,   queue_destroy,  queue_send,   queue_recv},
+    {"notify",  shared_create,  shared_destroy, notify_send,  notify_recv},
+    {"stream",  stream_create,  stream_destroy, stream_send,  stream_recv},
+    {"message", message_create, stream_destroy, message_send, message_recv},
+    {"event",   event_create,   event_destroy,  event_send,   event_recv},
+    {"ring",    ring_create,    ring_destroy,   ring_send,    ring_recv},
+};
+
+/* ------------------------- Ping-pong ---------------------------- */
+
+/**
+ * @brief State shared by the two tasks of one benchmark cell.
+ */
+typedef struct {
+    const bench_ops_t *ops;
+    bench_chan_t ping;              // Initiator -> responder
+    bench_chan_t pong;              // Responder -> initiator
+    size_t payload;
+    uint32_t rounds;                // Timed round trips
+    uint32_t *cycles;               // One entry per timed round trip
+    int64_t elapsed_us;
+    SemaphoreHandle_t done;
+} bench_cell_t;
+
+/**
+ * @brief Responder: echo every payload back to the initiator.
+ *
+ * Args:
+ *   arg: The benchmark cell.
+ */
+static void responder_task(void *arg)
+{
+    bench_cell_t *cell = (bench_cell_t *)arg;
+    uint8_t buf[BENCH_MAX_PAYLOAD];
+
+    for (uint32_t i = 0; i < BENCH_WARMUP + cell->rounds; i++) {
+        cell->ops->recv(&cell->ping, buf, cell->payload);
+        cell->ops->send(&cell->pong, buf, cell->payload);
+    }
+
+    xSemaphoreGive(cell->done);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Initiator: time each round trip with the cycle counter.
+ *
+ * Args:
+ *   arg: The benchmark cell.
+ */
+static void initiator_task(void *arg)
+{
+    bench_cell_t *cell = (bench_cell_t *)arg;
+    uint8_t buf[BENCH_MAX_PAYLOAD];
+
+    memset(buf, 0xA5, sizeof(buf));
+    cell->pong.receiver = xTaskGetCurrentTaskHandle();
+
+    for (uint32_t i = 0; i < BENCH_WARMUP; i++) {
+        cell->ops->send(&cell->ping, buf, cell->payload);
+        cell->ops->recv(&cell->pong, buf, cell->payload);
+    }
+
+    const int64_t start_us = esp_timer_get_time();
+    for (uint32_t i = 0; i < cell->rounds; i++) {
+        const uint32_t t0 = esp_cpu_get_cycle_count();
+        cell->ops->send(&cell->ping, buf, cell->payload);
+        cell->ops->recv(&cell->pong, buf, cell->payload);
+        cell->cycles[i] = esp_cpu_get_cycle_count() - t0;
+    }
+    cell->elapsed_us = esp_timer_get_time() - start_us;
+
+    xSemaphoreGive(cell->done);
+    vTaskDelete(NULL);
+}
+
+static int compare_u32(const void *a, const void *b)
+{
+    const uint32_t x = *(const uint32_t *)a;
+    const uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Convert a cycle count at a given percentile into nanoseconds.
+ *
+ * Args:
+ *   sorted: Round-trip cycle counts in ascending order.
+ *   n:      Number of entries.
+ *   pct:    Percentile, 0..100.
+ */
+static uint32_t percentile_ns(const uint32_t *sorted, uint32_t n, uint32_t pct)
+{
+    uint32_t idx = (uint32_t)(((uint64_t)(n - 1) * pct) / 100);
+    return (uint32_t)(((uint64_t)sorted[idx] * 1000) / esp_rom_get_cpu_ticks_per_us());
+}
+
+/**
+ * @brief Run one primitive/placement/payload cell and log its result.
+ *
+ * Args:
+ *   ops:            Primitive under test.
+ *   initiator_core: Core of the timing task.
+ *   responder_core: Core of the echo task.
+ *   payload:        Bytes moved in each direction per round trip.
+ *   cycles:         Scratch array with room for CONFIG_SMP_IPC_BENCH_ROUNDS entries.
+ */
+static void run_cell(const bench_ops_t *ops, int initiator_core, int responder_core,
+                     size_t payload, uint32_t *cycles)
+{
+    bench_cell_t cell = {
+        .ops = ops,
+        .payload = payload,
+        .rounds = CONFIG_SMP_IPC_BENCH_ROUNDS,
+        .cycles = cycles,
+    };
+
+    cell.done = xSemaphoreCreateCounting(2, 0);
+    if (cell.done == NULL || !ops->create(&cell.ping, payload)) {
+        ESP_LOGE(TAG, "%s: failed to create channel", ops->name);
+        goto cleanup_done;
+    }
+    if (!ops->create(&cell.pong, payload)) {
+        ESP_LOGE(TAG, "%s: failed to create channel", ops->name);
+        goto cleanup_ping;
+    }
+
+    // The responder exists before the initiator sends its first ping
+    BaseType_t ok_r = xTaskCreatePinnedToCore(responder_task, "bench_resp", BENCH_TASK_STACK,
+                                              &cell, BENCH_TASK_PRIO, &cell.ping.receiver, responder_core);
+    if (ok_r != pdPASS) {
+        ESP_LOGE(TAG, "%s: failed to create responder", ops->name);
+        goto cleanup_pong;
+    }
+    BaseType_t ok_i = xTaskCreatePinnedToCore(initiator_task, "bench_init", BENCH_TASK_STACK,
+                                              &cell, BENCH_TASK_PRIO, NULL, initiator_core);
+    if (ok_i != pdPASS) {
+        // The responder is still waiting for its first ping
+        ESP_LOGE(TAG, "%s: failed to create initiator", ops->name);
+        vTaskDelete(cell.ping.receiver);
+        goto cleanup_pong;
+    }
+
+    (void)xSemaphoreTake(cell.done, portMAX_DELAY);
+    (void)xSemaphoreTake(cell.done, portMAX_DELAY);
+
+    qsort(cycles, cell.rounds, sizeof(uint32_t), compare_u32);
+
+    const uint32_t msgs_per_s = (cell.elapsed_us > 0)
+        ? (uint32_t)(((uint64_t)cell.rounds * 2 * 1000000) / (uint64_t)cell.elapsed_us)
+        : 0;
+
+    ESP_LOGI(TAG, "%-7s %-5s %4u B | p50 %6lu  p90 %6lu  p99 %6lu  max %7lu ns | %7lu msg/s",
+             ops->name, (initiator_core == responder_core) ? "same" : "cross", (unsigned)payload,
+             (unsigned long)percentile_ns(cycles, cell.rounds, 50),
+             (unsigned long)percentile_ns(cycles, cell.rounds, 90),
+             (unsigned long)percentile_ns(cycles, cell.rounds, 99),
+             (unsigned long)percentile_ns(cycles, cell.rounds, 100),
+             (unsigned long)msgs_per_s);
+
+cleanup_pong:
+    ops->destroy(&cell.pong);
+cleanup_ping:
+    ops->destroy(&cell.ping);
+cleanup_done:
+    if (cell.done != NULL) {
+        vSemaphoreDelete(cell.done);
+    }
+}
+
+void ipc_bench_run(void)
+{
+    const int initiator_core = CONFIG_SMP_IPC_PRODUCER_CORE;
+    const int placements[] = {CONFIG_SMP_IPC_PRODUCER_CORE, CONFIG_SMP_IPC_CONSUMER_CORE};
+
+    uint32_t *cycles = malloc(CONFIG_SMP_IPC_BENCH_ROUNDS * sizeof(uint32_t));
+    if (cycles == NULL) {
+        ESP_LOGE(TAG, "Benchmark: failed to allocate %d samples", CONFIG_SMP_IPC_BENCH_ROUNDS);
+        return;
+    }
+
+    ESP_LOGI(TAG, "Round-trip latency, %d rounds per cell, CPU %lu MHz",
+             CONFIG_SMP_IPC_BENCH_ROUNDS, (unsigned long)esp_rom_get_cpu_ticks_per_us());
+    ESP_LOGI(TAG, "msg/s counts both directions (two messages per round trip)");
+
+    for (size_t p = 0; p < sizeof(s_primitives) / sizeof(s_primitives[0]); p++) {
+        for (size_t c = 0; c < sizeof(placements) / sizeof(placements[0]); c++) {
+            if (c > 0 && placements[c] == placements[0]) {
+                continue;   // Producer and consumer core are the same; cross-core is not configured
+            }
+            for (size_t s = 0; s < sizeof(s_payload_sizes) / sizeof(s_payload_sizes[0]); s++) {
+                run_cell(&s_primitives[p], initiator_core, placements[c], s_payload_sizes[s], cycles);
+            }
+        }
+    }
+
+    free(cycles);
+    ESP_LOGI(TAG, "Benchmark complete");
+}
@@ -0,0 +1,16 @@
+/**
+ * @file ipc_bench.h
+ * @brief Round-trip benchmark of FreeRTOS IPC primitives on one core and across cores.
+ */
+
+#pragma once
+
+/**
+ * @brief Run the full benchmark matrix and log one result line per cell.
+ *
+ * Every primitive is measured as a ping-pong between an initiator and a
+ * responder task, first with both tasks on the producer core and then with
+ * the responder on the consumer core, at each payload size. Blocks until the
+ * whole matrix is done.
+ */
+void ipc_bench_run(void);
@@ -5,6 +5,7 @@
  * This project demonstrates two practical inter-core communication patterns on ESP32:
  *   1) Queue-based producer/consumer where tasks are pinned to different cores.
  *   2) Task notification-based signaling where tasks are pinned to different cores.
+ * A third mode benchmarks the IPC primitives against each other (see ipc_bench.c).
  *
  * The goal is to provide a ready-to-build reference you can reuse in real projects:
  * - Pin tasks to specific cores to reduce jitter and isolate workloads.
@@ -25,6 +26,8 @@
 #include "esp_log.h"
 #include "esp_system.h"
 
+#include "ipc_bench.h"
+
 static const char *TAG = "SMP_IPC";
 
 /* -------------------------- Queue Demo -------------------------- */
@@ -231,6 +234,9 @@ void app_main(void)
 #elif CONFIG_SMP_IPC_DEMO_MODE_NOTIFY
     ESP_LOGI(TAG, "Running demo mode: Task Notifications");
     run_notify_demo();
+#elif CONFIG_SMP_IPC_DEMO_MODE_BENCH
+    ESP_LOGI(TAG, "Running demo mode: IPC benchmark");
+    ipc_bench_run();
 #else
     ESP_LOGW(TAG, "No demo mode selected");
 #endif
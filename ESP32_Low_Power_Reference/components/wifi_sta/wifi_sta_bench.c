@@ -0,0 +1,209 @@
+/**
+ * @file
+ * @brief Round-trip time and current of each power-save profile
+ */
+
+#include "wifi_sta.h"
+
+#include <inttypes.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <netdb.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "driver/gpio.h"
+#include "esp_check.h"
+#include "esp_log.h"
+#include "lwip/inet.h"
+#include "ping/ping_sock.h"
+
+static const char *TAG = "wifi_sta_bench";
+
+/* Current samples are taken this often during both windows. */
+#define SAMPLE_MS   20U
+
+typedef struct {
+    SemaphoreHandle_t done;
+    uint32_t rtt_sum_ms;
+    uint32_t rtt_min_ms;
+    uint32_t rtt_max_ms;
+    uint16_t received;
+} ping_run_t;
+
+typedef struct {
+    uint64_t sum_ua;
+    uint32_t samples;
+} current_avg_t;
+
+static void on_ping_success(esp_ping_handle_t hdl, void *args)
+{
+    ping_run_t *run = args;
+    uint32_t rtt_ms = 0;
+    esp_ping_get_profile(hdl, ESP_PING_PROF_TIMEGAP, &rtt_ms, sizeof(rtt_ms));
+
+    run->rtt_sum_ms += rtt_ms;
+    if (run->received == 0 || rtt_ms < run->rtt_min_ms) {
+        run->rtt_min_ms = rtt_ms;
+    }
+    if (rtt_ms > run->rtt_max_ms) {
+        run->rtt_max_ms = rtt_ms;
+    }
+    run->received++;
+}
+
+static void on_ping_end(esp_ping_handle_t hdl, void *args)
+{
+    (void)hdl;
+    ping_run_t *run = args;
+    xSemaphoreGive(run->done);
+}
+
+static void sample_current(const wifi_sta_bench_config_t *config, current_avg_t *avg)
+{
+    uint32_t ua;
+    if (config->read_current_ua != NULL && config->read_current_ua(config->ctx, &ua)) {
+        avg->sum_ua += ua;
+        avg->samples++;
+    }
+}
+
+static uint32_t current_mean(const current_avg_t *avg)
+{
+    return (avg->samples > 0) ? (uint32_t)(avg->sum_ua / avg->samples) : 0U;
+}
+
+/**
+ * @brief Resolve the ping target, the gateway when no host is given
+ */
+static esp_err_t resolve_target(const char *host, ip_addr_t *target)
+{
+    memset(target, 0, sizeof(*target));
+
+    if (host == NULL) {
+        esp_netif_ip_info_t ip_info;
+        ESP_RETURN_ON_FALSE(esp_netif_get_ip_info(wifi_sta_get_netif(), &ip_info) == ESP_OK &&
+                            ip_info.gw.addr != 0,
+                            ESP_ERR_NOT_FOUND, TAG, "no gateway");
+        target->type = IPADDR_TYPE_V4;
+        ip_2_ip4(target)->addr = ip_info.gw.addr;
+        return ESP_OK;
+    }
+
+    struct addrinfo hints = {
+        .ai_family = AF_INET,
+    };
+    struct addrinfo *res = NULL;
+    ESP_RETURN_ON_FALSE(getaddrinfo(host, NULL, &hints, &res) == 0 && res != NULL,
+                        ESP_ERR_NOT_FOUND, TAG, "cannot resolve %s", host);
+    const struct sockaddr_in *addr = (const struct sockaddr_in *)res->ai_addr;
+    target->type = IPADDR_TYPE_V4;
+    inet_addr_to_ip4addr(ip_2_ip4(target), &addr->sin_addr);
+    freeaddrinfo(res);
+    return ESP_OK;
+}
+
+/**
+ * @brief Idle window, then ping window, in the active profile
+ */
+static esp_err_t measure(const wifi_sta_bench_config_t *config, const ip_addr_t *target,
+                         wifi_sta_bench_result_t *result)
+{
+    if (config->marker_gpio >= 0) {
+        gpio_set_level(config->marker_gpio, 1);
+    }
+
+    current_avg_t idle = {0};
+    for (uint32_t t = 0; t < config->idle_ms; t += SAMPLE_MS) {
+        vTaskDelay(pdMS_TO_TICKS(SAMPLE_MS));
+        sample_current(config, &idle);
+    }
+    result->idle_ua = current_mean(&idle);
+
+    ping_run_t run = {
+        .done = xSemaphoreCreateBinary(),
+    };
+    ESP_RETURN_ON_FALSE(run.done != NULL, ESP_ERR_NO_MEM, TAG, "semaphore failed");
+
+    esp_ping_config_t ping_config = ESP_PING_DEFAULT_CONFIG();
+    ping_config.target_addr = *target;
+    ping_config.count = config->ping_count;
+    ping_config.interval_ms = config->ping_interval_ms;
+
+    esp_ping_callbacks_t callbacks = {
+        .cb_args = &run,
+        .on_ping_success = on_ping_success,
+        .on_ping_end = on_ping_end,
+    };
+
+    esp_ping_handle_t ping;
+    esp_err_t err = esp_ping_new_session(&ping_config, &callbacks, &ping);
+    if (err == ESP_OK) {
+        current_avg_t active = {0};
+        esp_ping_start(ping);
+        while (xSemaphoreTake(run.done, pdMS_TO_TICKS(SAMPLE_MS)) != pdTRUE) {
+            sample_current(config, &active);
+        }
+        esp_ping_delete_session(ping);
+
+        result->sent = config->ping_count;
+        result->received = run.received;
+        result->rtt_min_ms = run.rtt_min_ms;
+        result->rtt_max_ms = run.rtt_max_ms;
+        result->rtt_avg_ms = (run.received > 0) ? run.rtt_sum_ms / run.received : 0U;
+        result->ping_ua = current_mean(&active);
+    }
+
+    vSemaphoreDelete(run.done);
+    if (config->marker_gpio >= 0) {
+        gpio_set_level(config->marker_gpio, 0);
+    }
+    return err;
+}
+
+esp_err_t wifi_sta_bench_run(const wifi_sta_bench_config_t *config,
+                             wifi_sta_bench_result_t results[3])
+{
+    ESP_RETURN_ON_FALSE(config != NULL && results != NULL && config->ping_count > 0,
+                        ESP_ERR_INVALID_ARG, TAG, "invalid argument");
+    ESP_RETURN_ON_FALSE(wifi_sta_is_connected(), ESP_ERR_WIFI_NOT_CONNECT, TAG, "not connected");
+
+    ip_addr_t target;
+    ESP_RETURN_ON_ERROR(resolve_target(config->host, &target), TAG, "no target");
+
+    if (config->marker_gpio >= 0) {
+        gpio_reset_pin(config->marker_gpio);
+        gpio_set_direction(config->marker_gpio, GPIO_MODE_OUTPUT);
+        gpio_set_level(config->marker_gpio, 0);
+    }
+
+    static const wifi_sta_ps_profile_t PROFILES[3] = {
+        WIFI_STA_PS_LOW_LATENCY, WIFI_STA_PS_BALANCED, WIFI_STA_PS_LOW_POWER,
+    };
+    wifi_sta_ps_profile_t previous = wifi_sta_get_ps_profile();
+    esp_err_t err = ESP_OK;
+
+    for (int i = 0; i < 3 && err == ESP_OK; i++) {
+        memset(&results[i], 0, sizeof(results[i]));
+        results[i].profile = PROFILES[i];
+        err = wifi_sta_set_ps_profile(PROFILES[i]);
+        if (err == ESP_OK) {
+            vTaskDelay(pdMS_TO_TICKS(config->settle_ms));
+            err = measure(config, &target, &results[i]);
+        }
+    }
+    wifi_sta_set_ps_profile(previous);
+    ESP_RETURN_ON_ERROR(err, TAG, "benchmark failed");
+
+    ESP_LOGI(TAG, "%-12s %5s %7s %7s %7s %7s %9s %9s", "profile", "loss",
+             "rtt_min", "rtt_avg", "rtt_max", "wake_ms", "idle_uA", "ping_uA");
+    for (int i = 0; i < 3; i++) {
+        const wifi_sta_bench_result_t *r = &results[i];
+        ESP_LOGI(TAG, "%-12s %3u/%-2u %7" PRIu32 " %7" PRIu32 " %7" PRIu32 " %7" PRIu32
+                 " %9" PRIu32 " %9" PRIu32,
+                 wifi_sta_ps_profile_name(r->profile), (unsigned)(r->sent - r->received),
+                 (unsigned)r->sent, r->rtt_min_ms, r->rtt_avg_ms, r->rtt_max_ms,
+                 wifi_sta_wake_period_ms(r->profile), r->idle_ua, r->ping_ua);
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file pm_profile.h
+ * @brief Runtime power-management profiles and scoped frequency boosts.
+ *
+ * A profile sets the limits passed to esp_pm_configure(): the CPU may run
+ * between a minimum and the maximum frequency, and the idle task may enter
+ * automatic light sleep. The profile can change at runtime, for example to
+ * keep the clock high while a user waits on a response.
+ *
+ * ESP-IDF already raises the clock while a task is running and drops it when
+ * all tasks block. A section that blocks on hardware in the middle of its
+ * work, such as a socket send, a DMA transfer or a display flush, would fall
+ * back to the minimum frequency while it waits and run slower when it
+ * resumes. PM_BOOST_SCOPE() holds a PM lock for the rest of the enclosing
+ * block so the section keeps the maximum CPU or APB frequency throughout.
+ *
+ * Time spent in each profile and under each boost is reported per wake.
+ * With CONFIG_PM_PROFILING, the ESP-IDF table of time spent in each
+ * frequency mode is printed as well.
+ */
+
+/** Frequency and sleep limits, from fastest to most frugal. */
+typedef enum {
+    PM_PROFILE_PERFORMANCE, // fixed maximum frequency, no light sleep
+    PM_PROFILE_BALANCED,    // LP_PM_BALANCED_MIN_MHZ when idle, light sleep
+    PM_PROFILE_ECO,         // LP_PM_ECO_MIN_MHZ when idle, light sleep
+    PM_PROFILE_COUNT,
+} pm_profile_t;
+
+/** Clock a boost holds at its maximum. */
+typedef enum {
+    PM_BOOST_CPU,   // CPU frequency, for compute between blocking calls
+    PM_BOOST_APB,   // APB frequency, for peripheral transfers
+    PM_BOOST_COUNT,
+} pm_boost_kind_t;
+
+/** A held boost. Zero since_us means nothing is held. */
+typedef struct {
+    pm_boost_kind_t kind;
+    int64_t since_us;
+} pm_boost_t;
+
+/**
+ * @brief Create the boost locks and apply the profile chosen in menuconfig.
+ *
+ * Light sleep is only requested when FreeRTOS tickless idle is enabled.
+ *
+ * @return ESP_OK, or the error from esp_pm_configure() or lock creation.
+ */
+esp_err_t pm_profile_init(void);
+
+/**
+ * @brief Switch to another profile.
+ *
+ * Held boosts stay in effect. On error the previous profile remains active.
+ *
+ * @param profile Profile to apply.
+ * @return ESP_OK, ESP_ERR_INVALID_STATE before pm_profile_init(), or the
+ *         error from esp_pm_configure().
+ */
+esp_err_t pm_profile_set(pm_profile_t profile);
+
+/**
+ * @brief Profile currently applied.
+ */
+pm_profile_t pm_profile_get(void);
+
+/**
+ * @brief Short name of a profile, for logs.
+ */
+const char *pm_profile_name(pm_profile_t profile);
+
+/**
+ * @brief Hold the maximum frequency of one clock until pm_boost_end().
+ *
+ * Boosts nest and may be held by several tasks at once. Before
+ * pm_profile_init() the call does nothing.
+ *
+ * @param kind Clock to hold.
+ * @return Handle to pass to pm_boost_end().
+ */
+pm_boost_t pm_boost_begin(pm_boost_kind_t kind);
+
+/**
+ * @brief Release a boost taken with pm_boost_begin().
+ *
+ * Safe to call twice or on a boost that was not taken.
+ *
+ * @param boost Boost to release.
+ */
+void pm_boost_end(pm_boost_t *boost);
+
+/**
+ * @brief Hold a boost until the enclosing block is left, by any path.
+ *
+ * At most one per block. Uses the GCC cleanup attribute.
+ */
+#define PM_BOOST_SCOPE(kind) \
+    pm_boost_t pm_boost_scope_ __attribute__((cleanup(pm_boost_end))) = pm_boost_begin(kind)
+
+/**
+ * @brief Log time per profile and boost for this wake.
+ *
+ * Logs at INFO. Call right before deep sleep.
+ */
+void pm_profile_report(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file sample_buffer.h
+ * @brief Sensor readings kept in RTC memory across deep sleep.
+ *
+ * Wi-Fi association costs far more energy than taking a reading. Buffering
+ * readings in RTC slow memory lets the device wake, sample and go back to
+ * sleep several times, then send all readings in one connection.
+ *
+ * The buffer survives deep sleep but not a power cycle. It is not
+ * thread-safe; callers serialize access.
+ */
+
+/** Maximum number of readings held. */
+#define SAMPLE_BUFFER_CAPACITY 64
+
+/** One sensor reading. */
+typedef struct {
+    uint32_t seq;       // running reading number, survives deep sleep
+    uint32_t time_s;    // RTC time in seconds when the reading was taken
+    int16_t adc_mv;     // sensor voltage
+    uint8_t wake_cause; // esp_sleep_wakeup_cause_t of the wake
+    uint8_t reserved;
+} sample_t;
+
+/**
+ * @brief Validate the buffer after a wake.
+ *
+ * Clears the buffer if its RTC contents are inconsistent, for example after
+ * a firmware update changed the layout.
+ */
+void sample_buffer_init(void);
+
+/**
+ * @brief Append a reading.
+ *
+ * When the buffer is full, the oldest reading is dropped and counted.
+ *
+ * @param adc_mv Sensor voltage.
+ * @param wake_cause Wake cause of the current cycle.
+ */
+void sample_buffer_push(int16_t adc_mv, uint8_t wake_cause);
+
+/**
+ * @brief Append a reading taken earlier.
+ *
+ * Same as sample_buffer_push(), for readings collected while the main CPU
+ * slept (for example by the ULP coprocessor).
+ *
+ * @param adc_mv Sensor voltage.
+ * @param wake_cause Wake cause of the cycle that collected the reading.
+ * @param time_s RTC time in seconds when the reading was taken.
+ */
+void sample_buffer_push_at(int16_t adc_mv, uint8_t wake_cause, uint32_t time_s);
+
+/**
+ * @brief Number of readings held.
+ */
+size_t sample_buffer_count(void);
+
+/**
+ * @brief Number of readings dropped because the buffer was full.
+ */
+uint32_t sample_buffer_dropped(void);
+
+/**
+ * @brief Copy the oldest readings without removing them.
+ *
+ * @param out Destination array.
+ * @param max Capacity of out.
+ * @return Number of readings copied.
+ */
+size_t sample_buffer_peek(sample_t *out, size_t max);
+
+/**
+ * @brief Remove the oldest readings after they were delivered.
+ *
+ * Also resets the dropped counter, which was reported with them.
+ *
+ * @param count Number of readings to remove.
+ */
+void sample_buffer_consume(size_t count);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file ulp_monitor.h
+ * @brief Sensor sampling on the ULP RISC-V coprocessor.
+ *
+ * Booting the main CPU for every reading costs milliamps for tens of
+ * milliseconds. The ULP program (ulp/ulp_adc_sampler.c) instead reads the
+ * ADC on its own timer while the chip stays in deep sleep, keeps the raw
+ * values in RTC memory, and wakes the main CPU only when a reading crosses
+ * the alert threshold or a full batch is waiting.
+ *
+ * Available on targets with the RISC-V ULP (ESP32-S2, ESP32-S3) when
+ * CONFIG_LP_ULP_SAMPLING is enabled.
+ */
+
+/**
+ * @brief Configure the ADC for the ULP, load the program and start its timer.
+ *
+ * Call on a cold boot. The program keeps running through deep sleep and
+ * later wakes; loading it again discards readings it has not handed over.
+ *
+ * @return ESP_OK on success, otherwise an ESP-IDF error code.
+ */
+esp_err_t ulp_monitor_start(void);
+
+/**
+ * @brief Move the ULP's readings into the sample buffer.
+ *
+ * Pauses the ULP timer while copying, converts the raw values to mV and
+ * stamps each reading with the time it was taken.
+ *
+ * @param wake_cause Wake cause stored with the readings.
+ * @param alert Set to true if the ULP saw a rising threshold crossing.
+ * @return Number of readings moved.
+ */
+size_t ulp_monitor_collect(uint8_t wake_cause, bool *alert);
+
+#ifdef __cplusplus
+}
+#endif
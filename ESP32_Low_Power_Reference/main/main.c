@@ -6,10 +6,14 @@
  * firmware techniques that directly impact battery life:
  *
  * 1) Event-driven FreeRTOS tasks (block, do not poll)
- * 2) ESP-IDF power management (DFS + optional automatic light sleep)
+ * 2) ESP-IDF power management (DFS + optional automatic light sleep), with
+ *    runtime profiles and boosts held around hot sections
  * 3) Deep sleep duty-cycling (wake -> work -> sleep)
  * 4) Explicit Wi-Fi lifecycle (connect -> short transaction -> shutdown)
  * 5) Basic GPIO wake (EXT0) to avoid periodic wakeups when possible
+ * 6) Batched sampling: readings wait in RTC memory, Wi-Fi runs once per batch
+ * 7) Optional ULP sampling: the ULP coprocessor reads the sensor while the
+ *    main CPU sleeps, and wakes it only for a threshold crossing or a batch
  *
  * Build:
  *   idf.py set-target esp32
@@ -19,17 +23,28 @@
 
 #include <inttypes.h>
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
+#include "freertos/semphr.h"
 
+#include "esp_attr.h"
 #include "esp_log.h"
-#include "esp_pm.h"
 #include "esp_sleep.h"
+#include "esp_timer.h"
 #include "driver/gpio.h"
 
+#include "energy_profiler.h"
+#include "pm_profile.h"
+#include "sample_buffer.h"
 #include "wifi_manager.h"
+#include "wifi_sta.h"
+#if CONFIG_LP_ULP_SAMPLING
+#include "ulp_monitor.h"
+#endif
 
 static const char *TAG = "lp_ref";
 
@@ -39,22 +54,31 @@ static const char *TAG = "lp_ref";
 
 static TaskHandle_t s_button_task;
 
+// Serializes work bursts from app_main and the button task.
+static SemaphoreHandle_t s_work_lock;
+
+#if !CONFIG_LP_ULP_SAMPLING
+// Set while readings are at or above the alert threshold (survives deep sleep).
+static RTC_DATA_ATTR bool s_alert_active;
+#endif
+
 /**
  * @brief Configure ESP-IDF power management (DFS + optional light sleep).
  *
  * In ESP-IDF, automatic frequency scaling and automatic light sleep only work
  * when the scheduler has no runnable tasks. This means your application must
  * block on events (queues, notifications, event groups) instead of polling.
+ *
+ * The frequency limits come from the profile chosen in menuconfig and can be
+ * changed at runtime with pm_profile_set().
  */
 static void enable_power_management(void)
 {
 #if CONFIG_PM_ENABLE
-    esp_pm_config_t cfg = {
-        .max_freq_mhz = 240,
-        .min_freq_mhz = 40,
-        .light_sleep_enable = true,
-    };
-    ESP_ERROR_CHECK(esp_pm_configure(&cfg));
+    esp_err_t err = pm_profile_init();
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "power management not configured: %s", esp_err_to_name(err));
+    }
 #endif
 }
 
@@ -85,14 +109,172 @@ static inline void sensor_power_set(bool on)
     gpio_set_level(GPIO_SENSOR_PWR, on ? 1 : 0);
 }
 
+#if !CONFIG_LP_ULP_SAMPLING
+/**
+ * @brief Check a reading against the alert threshold.
+ *
+ * Only a rising crossing counts, so a value that stays high does not bring
+ * Wi-Fi up on every wake.
+ *
+ * @return true if this reading starts a new alert.
+ */
+static bool alert_triggered(int adc_mv)
+{
+#if CONFIG_LP_ALERT_THRESHOLD_MV > 0
+    bool above = adc_mv >= CONFIG_LP_ALERT_THRESHOLD_MV;
+    bool rising = above && !s_alert_active;
+    s_alert_active = above;
+    return rising;
+#else
+    (void)adc_mv;
+    return false;
+#endif
+}
+#endif
+
+#if CONFIG_LP_WIFI_PS_BENCH
+// Set once the profiles were compared; cleared by a power cycle.
+static RTC_DATA_ATTR bool s_ps_bench_done;
+
+static bool read_profiler_current(void *ctx, uint32_t *ua)
+{
+    (void)ctx;
+    return energy_profiler_read_current(ua);
+}
+
+/**
+ * @brief Compare the Wi-Fi power-save profiles once per power-on.
+ *
+ * Without a current sensor only the round-trip times are meaningful; the
+ * marker GPIO lets an external meter take the current instead.
+ */
+static void wifi_ps_bench(void)
+{
+    if (s_ps_bench_done) {
+        return;
+    }
+    s_ps_bench_done = true;
+
+    const wifi_sta_bench_config_t cfg = {
+        .host = NULL,
+        .ping_count = CONFIG_LP_WIFI_PS_BENCH_PINGS,
+        .ping_interval_ms = 200,
+        .idle_ms = 3000,
+        .settle_ms = 500,
+        .marker_gpio = CONFIG_LP_WIFI_PS_BENCH_MARKER_GPIO,
+        .read_current_ua = read_profiler_current,
+    };
+    wifi_sta_bench_result_t results[3];
+    esp_err_t err = wifi_sta_bench_run(&cfg, results);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "power-save bench failed: %s", esp_err_to_name(err));
+        return;
+    }
+    for (int i = 0; i < 3; i++) {
+        const wifi_sta_bench_result_t *r = &results[i];
+        ESP_LOGW(TAG, "ps %-11s rtt %" PRIu32 "/%" PRIu32 "/%" PRIu32 " ms, %u/%u replies, "
+                 "idle %" PRIu32 " uA, pinging %" PRIu32 " uA",
+                 wifi_sta_ps_profile_name(r->profile), r->rtt_min_ms, r->rtt_avg_ms,
+                 r->rtt_max_ms, (unsigned)r->received, (unsigned)r->sent,
+                 r->idle_ua, r->ping_ua);
+    }
+}
+#endif
+
+/**
+ * @brief Send every buffered reading in one transmission.
+ *
+ * Readings are removed only after the send succeeds; otherwise they wait
+ * for the next batch.
+ */
+static void flush_samples(void)
+{
+    static sample_t batch[SAMPLE_BUFFER_CAPACITY];
+    size_t n = sample_buffer_peek(batch, SAMPLE_BUFFER_CAPACITY);
+    if (n == 0) {
+        return;
+    }
+
+    // The send blocks on the network between bursts of work; keep the CPU
+    // at full speed so each burst finishes quickly and the radio turns off
+    // sooner.
+    PM_BOOST_SCOPE(PM_BOOST_CPU);
+
+    // One header line plus one CSV line (seq,time_s,adc_mv,wake_cause) per reading.
+    size_t cap = 48 + n * 40;
+    char *text = malloc(cap);
+    if (text == NULL) {
+        return;
+    }
+    size_t len = (size_t)snprintf(text, cap, "batch n=%u dropped=%" PRIu32 "\n",
+                                  (unsigned)n, sample_buffer_dropped());
+    for (size_t i = 0; i < n && len < cap; i++) {
+        len += (size_t)snprintf(text + len, cap - len, "%" PRIu32 ",%" PRIu32 ",%d,%u\n",
+                                batch[i].seq, batch[i].time_s, batch[i].adc_mv,
+                                batch[i].wake_cause);
+    }
+    if (len >= cap) {
+        len = cap - 1;
+    }
+
+#ifdef CONFIG_LP_ENABLE_WIFI
+    // Wi-Fi work should be connect -> short TX -> shutdown.
+    energy_profiler_mark(ENERGY_PHASE_RADIO);
+    esp_err_t err = wifi_manager_connect(CONFIG_LP_WIFI_CONNECT_TIMEOUT_MS);
+    if (err == ESP_OK) {
+#if CONFIG_LP_WIFI_PS_BENCH
+        wifi_ps_bench();
+#endif
+        err = wifi_manager_send(CONFIG_LP_WIFI_TX_HOST,
+                                CONFIG_LP_WIFI_TX_PORT,
+                                text, len,
+                                3000);
+        if (err != ESP_OK) {
+            // A reused lease may no longer be valid; rejoin from scratch next time.
+            wifi_manager_forget_ap();
+        }
+    }
+    wifi_manager_shutdown();
+    energy_profiler_mark(ENERGY_PHASE_ACTIVE);
+#else
+    // No radio: the log stands in for the transmission.
+    esp_err_t err = ESP_OK;
+    ESP_LOGW(TAG, "%.*s", (int)len, text);
+#endif
+    free(text);
+
+    if (err == ESP_OK) {
+        sample_buffer_consume(n);
+        ESP_LOGW(TAG, "sent batch of %u readings", (unsigned)n);
+    } else {
+        ESP_LOGW(TAG, "batch kept (%u readings): %s", (unsigned)n, esp_err_to_name(err));
+    }
+}
+
 /**
  * @brief Perform a short "work burst".
  *
  * Replace this with your real sampling and network transaction. The key is to
- * keep the active window short and deterministic.
+ * keep the active window short and deterministic. Most bursts only sample;
+ * Wi-Fi comes up when the batch is full or an event needs reporting now.
+ * With ULP sampling, the readings were already taken during sleep and the
+ * burst only collects them.
+ *
+ * @param wake_cause Wake cause stored with the reading.
+ * @param send_now Send the buffer regardless of its fill level.
  */
-static void do_work_burst(void)
+static void do_work_burst(esp_sleep_wakeup_cause_t wake_cause, bool send_now)
 {
+    xSemaphoreTake(s_work_lock, portMAX_DELAY);
+
+    energy_profiler_mark(ENERGY_PHASE_SENSOR);
+
+#if CONFIG_LP_ULP_SAMPLING
+    bool alert = false;
+    size_t collected = ulp_monitor_collect((uint8_t)wake_cause, &alert);
+    ESP_LOGW(TAG, "collected %u ULP readings (%u/%d buffered)",
+             (unsigned)collected, (unsigned)sample_buffer_count(), CONFIG_LP_BATCH_SIZE);
+#else
     // Simulate powering a sensor, waiting for settle time, then reading it.
     sensor_power_set(true);
     vTaskDelay(pdMS_TO_TICKS(10));
@@ -102,18 +284,25 @@ static void do_work_burst(void)
 
     sensor_power_set(false);
 
-    ESP_LOGW(TAG, "sample: adc_mv=%d", fake_mv);
+    sample_buffer_push((int16_t)fake_mv, (uint8_t)wake_cause);
+    ESP_LOGW(TAG, "sample: adc_mv=%d (%u/%d buffered)",
+             fake_mv, (unsigned)sample_buffer_count(), CONFIG_LP_BATCH_SIZE);
 
-#ifdef CONFIG_LP_ENABLE_WIFI
-    // Wi-Fi work should be connect -> short TX -> shutdown.
-    esp_err_t err = wifi_manager_connect(CONFIG_LP_WIFI_CONNECT_TIMEOUT_MS);
-    if (err == ESP_OK) {
-        (void)wifi_manager_demo_tx(CONFIG_LP_WIFI_TX_HOST,
-                                  CONFIG_LP_WIFI_TX_PORT,
-                                  3000);
-    }
-    wifi_manager_shutdown();
+    bool alert = alert_triggered(fake_mv);
 #endif
+
+    energy_profiler_mark(ENERGY_PHASE_ACTIVE);
+
+    if (alert) {
+        ESP_LOGW(TAG, "threshold event -> send now");
+        send_now = true;
+    }
+
+    if (send_now || sample_buffer_count() >= CONFIG_LP_BATCH_SIZE) {
+        flush_samples();
+    }
+
+    xSemaphoreGive(s_work_lock);
 }
 
 /**
@@ -121,8 +310,13 @@ static void do_work_burst(void)
  */
 static void configure_wake_sources(void)
 {
+#if CONFIG_LP_ULP_SAMPLING
+    // The ULP decides when the main CPU is needed; no periodic wake.
+    ESP_ERROR_CHECK(esp_sleep_enable_ulp_wakeup());
+#else
     // Periodic wake
     ESP_ERROR_CHECK(esp_sleep_enable_timer_wakeup((uint64_t)CONFIG_LP_REPORT_PERIOD_SEC * 1000000ULL));
+#endif
 
 #if CONFIG_LP_ENABLE_GPIO_WAKE
     // EXT0 uses a single RTC IO pin and level trigger.
@@ -137,7 +331,21 @@ static void configure_wake_sources(void)
  */
 static void enter_deep_sleep_now(void)
 {
+    // Charge per cycle is reported by the energy profiler every
+    // CONFIG_ENERGY_PROFILER_REPORT_CYCLES wakes.
+    wifi_manager_stats_t wifi;
+    wifi_manager_get_stats(&wifi);
+    uint32_t active_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    ESP_LOGW(TAG, "wake: active %" PRIu32 " ms, wifi connect %" PRIu32 " ms (%s), radio %" PRIu32 " ms",
+             active_ms, wifi.connect_ms, wifi.fast ? "cached" : "scan", wifi.radio_on_ms);
+    pm_profile_report();
+    energy_profiler_enter_sleep();
+
+#if CONFIG_LP_ULP_SAMPLING
+    ESP_LOGW(TAG, "entering deep sleep (ULP sampling)");
+#else
     ESP_LOGW(TAG, "entering deep sleep (%d s)", CONFIG_LP_REPORT_PERIOD_SEC);
+#endif
     esp_deep_sleep_start();
 }
 
@@ -186,7 +394,16 @@ static void button_task(void *arg)
     while (1) {
         ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
         ESP_LOGW(TAG, "button event -> work burst");
-        do_work_burst();
+
+#if CONFIG_LP_PM_BUTTON_PERFORMANCE
+        // Someone is waiting on this burst: trade current for latency.
+        pm_profile_t previous = pm_profile_get();
+        pm_profile_set(PM_PROFILE_PERFORMANCE);
+        do_work_burst(ESP_SLEEP_WAKEUP_UNDEFINED, true);
+        pm_profile_set(previous);
+#else
+        do_work_burst(ESP_SLEEP_WAKEUP_UNDEFINED, true);
+#endif
 
         // In a real product, you may choose to sleep immediately after the event.
         // This reference keeps running until the periodic deep sleep occurs.
@@ -195,6 +412,14 @@ static void button_task(void *arg)
 
 void app_main(void)
 {
+    // Book the sleep that just ended and time this wake. The profiler
+    // reports at INFO, below this project's default WARN log level.
+    esp_log_level_set("energy", ESP_LOG_INFO);
+    energy_profiler_init();
+
+    // Profile changes and the per-wake frequency report are INFO as well.
+    esp_log_level_set("pm_profile", ESP_LOG_INFO);
+
     // Enable ESP-IDF power management (DFS + optional light sleep).
     enable_power_management();
     
@@ -205,6 +430,23 @@ void app_main(void)
     esp_sleep_wakeup_cause_t cause = esp_sleep_get_wakeup_cause();
     ESP_LOGW(TAG, "wakeup cause=%d", (int)cause);
 
+    // Readings from earlier wakes are still in RTC memory.
+    sample_buffer_init();
+    s_work_lock = xSemaphoreCreateMutex();
+
+#if CONFIG_LP_ULP_SAMPLING
+    // The ULP keeps running through deep sleep; load it only on a cold boot
+    // (or an unexpected wake, which means it may not be running).
+    if (cause != ESP_SLEEP_WAKEUP_ULP && cause != ESP_SLEEP_WAKEUP_EXT0) {
+        esp_err_t err = ulp_monitor_start();
+        if (err != ESP_OK) {
+            // Without the ULP nothing would wake the CPU; retry from a reset.
+            ESP_LOGE(TAG, "ULP start failed (%s) - restarting", esp_err_to_name(err));
+            esp_restart();
+        }
+    }
+#endif
+
     // Configure deep sleep wake sources early.
     configure_wake_sources();
 
@@ -220,8 +462,9 @@ void app_main(void)
 #endif
 
     // Perform one work burst after boot/wake, then go back to deep sleep.
-    // This is the typical duty-cycled architecture for battery nodes.
-    do_work_burst();
+    // This is the typical duty-cycled architecture for battery nodes. A
+    // GPIO wake is a user event, so its batch goes out immediately.
+    do_work_burst(cause, cause == ESP_SLEEP_WAKEUP_EXT0);
 
     // Give logs a moment to flush. Keep this short.
     vTaskDelay(pdMS_TO_TICKS(50));
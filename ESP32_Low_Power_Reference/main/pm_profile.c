@@ -0,0 +1,261 @@
+#include "pm_profile.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "esp_log.h"
+#include "esp_pm.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "pm_profile";
+
+static const char *const PROFILE_NAMES[PM_PROFILE_COUNT] = {
+    [PM_PROFILE_PERFORMANCE] = "performance",
+    [PM_PROFILE_BALANCED] = "balanced",
+    [PM_PROFILE_ECO] = "eco",
+};
+
+const char *pm_profile_name(pm_profile_t profile)
+{
+    return (profile < PM_PROFILE_COUNT) ? PROFILE_NAMES[profile] : "?";
+}
+
+#if CONFIG_PM_ENABLE
+
+#define MAX_MHZ CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ
+
+// esp_pm_configure() rejects light sleep without tickless idle.
+#if CONFIG_FREERTOS_USE_TICKLESS_IDLE
+#define LIGHT_SLEEP_AVAILABLE true
+#else
+#define LIGHT_SLEEP_AVAILABLE false
+#endif
+
+#if CONFIG_LP_PM_PROFILE_PERFORMANCE
+#define DEFAULT_PROFILE PM_PROFILE_PERFORMANCE
+#elif CONFIG_LP_PM_PROFILE_BALANCED
+#define DEFAULT_PROFILE PM_PROFILE_BALANCED
+#else
+#define DEFAULT_PROFILE PM_PROFILE_ECO
+#endif
+
+typedef struct {
+    int min_mhz;
+    bool light_sleep;
+} profile_limits_t;
+
+static const profile_limits_t PROFILE_LIMITS[PM_PROFILE_COUNT] = {
+    [PM_PROFILE_PERFORMANCE] = { MAX_MHZ, false },
+    [PM_PROFILE_BALANCED] = { CONFIG_LP_PM_BALANCED_MIN_MHZ, true },
+    [PM_PROFILE_ECO] = { CONFIG_LP_PM_ECO_MIN_MHZ, true },
+};
+
+static const esp_pm_lock_type_t BOOST_LOCK_TYPES[PM_BOOST_COUNT] = {
+    [PM_BOOST_CPU] = ESP_PM_CPU_FREQ_MAX,
+    [PM_BOOST_APB] = ESP_PM_APB_FREQ_MAX,
+};
+
+static const char *const BOOST_NAMES[PM_BOOST_COUNT] = {
+    [PM_BOOST_CPU] = "cpu",
+    [PM_BOOST_APB] = "apb",
+};
+
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static bool s_ready;
+static pm_profile_t s_profile = DEFAULT_PROFILE;
+static int64_t s_profile_since_us;
+static int64_t s_profile_us[PM_PROFILE_COUNT];
+static esp_pm_lock_handle_t s_boost_locks[PM_BOOST_COUNT];
+static uint32_t s_boost_count[PM_BOOST_COUNT];
+static int64_t s_boost_us[PM_BOOST_COUNT];
+
+static int min_mhz_of(pm_profile_t profile)
+{
+    int mhz = PROFILE_LIMITS[profile].min_mhz;
+    return (mhz < MAX_MHZ) ? mhz : MAX_MHZ;
+}
+
+static esp_err_t apply_profile(pm_profile_t profile)
+{
+    esp_pm_config_t cfg = {
+        .max_freq_mhz = MAX_MHZ,
+        .min_freq_mhz = min_mhz_of(profile),
+        .light_sleep_enable = PROFILE_LIMITS[profile].light_sleep && LIGHT_SLEEP_AVAILABLE,
+    };
+    esp_err_t err = esp_pm_configure(&cfg);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "%s profile rejected: %s", pm_profile_name(profile), esp_err_to_name(err));
+        return err;
+    }
+
+    ESP_LOGI(TAG, "%s: %d-%d MHz, light sleep %s", pm_profile_name(profile),
+             cfg.min_freq_mhz, cfg.max_freq_mhz, cfg.light_sleep_enable ? "on" : "off");
+    return ESP_OK;
+}
+
+esp_err_t pm_profile_init(void)
+{
+    for (int kind = 0; kind < PM_BOOST_COUNT; kind++) {
+        if (s_boost_locks[kind] != NULL) {
+            continue;
+        }
+        esp_err_t err = esp_pm_lock_create(BOOST_LOCK_TYPES[kind], 0, BOOST_NAMES[kind],
+                                           &s_boost_locks[kind]);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+
+    esp_err_t err = apply_profile(DEFAULT_PROFILE);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    s_profile = DEFAULT_PROFILE;
+    s_profile_since_us = esp_timer_get_time();
+    s_ready = true;
+    portEXIT_CRITICAL(&s_lock);
+    return ESP_OK;
+}
+
+esp_err_t pm_profile_set(pm_profile_t profile)
+{
+    if (profile >= PM_PROFILE_COUNT) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!s_ready) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (profile == pm_profile_get()) {
+        return ESP_OK;
+    }
+
+    esp_err_t err = apply_profile(profile);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_lock);
+    s_profile_us[s_profile] += now - s_profile_since_us;
+    s_profile = profile;
+    s_profile_since_us = now;
+    portEXIT_CRITICAL(&s_lock);
+    return ESP_OK;
+}
+
+pm_profile_t pm_profile_get(void)
+{
+    portENTER_CRITICAL(&s_lock);
+    pm_profile_t profile = s_profile;
+    portEXIT_CRITICAL(&s_lock);
+    return profile;
+}
+
+pm_boost_t pm_boost_begin(pm_boost_kind_t kind)
+{
+    pm_boost_t boost = { .kind = kind, .since_us = 0 };
+
+    if (s_ready && kind < PM_BOOST_COUNT &&
+        esp_pm_lock_acquire(s_boost_locks[kind]) == ESP_OK) {
+        boost.since_us = esp_timer_get_time();
+    }
+    return boost;
+}
+
+void pm_boost_end(pm_boost_t *boost)
+{
+    if (boost->since_us == 0) {
+        return;
+    }
+
+    int64_t held_us = esp_timer_get_time() - boost->since_us;
+    boost->since_us = 0;
+    esp_pm_lock_release(s_boost_locks[boost->kind]);
+
+    portENTER_CRITICAL(&s_lock);
+    s_boost_count[boost->kind]++;
+    s_boost_us[boost->kind] += held_us;
+    portEXIT_CRITICAL(&s_lock);
+}
+
+void pm_profile_report(void)
+{
+    if (!s_ready) {
+        return;
+    }
+
+    int64_t profile_us[PM_PROFILE_COUNT];
+    uint32_t boost_count[PM_BOOST_COUNT];
+    int64_t boost_us[PM_BOOST_COUNT];
+
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_lock);
+    for (int p = 0; p < PM_PROFILE_COUNT; p++) {
+        profile_us[p] = s_profile_us[p];
+    }
+    profile_us[s_profile] += now - s_profile_since_us;
+    for (int kind = 0; kind < PM_BOOST_COUNT; kind++) {
+        boost_count[kind] = s_boost_count[kind];
+        boost_us[kind] = s_boost_us[kind];
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    ESP_LOGI(TAG, "time this wake:");
+    for (int p = 0; p < PM_PROFILE_COUNT; p++) {
+        if (profile_us[p] == 0) {
+            continue;
+        }
+        ESP_LOGI(TAG, "  %-11s %6" PRId64 " ms (%d-%d MHz)", PROFILE_NAMES[p],
+                 profile_us[p] / 1000, min_mhz_of((pm_profile_t)p), MAX_MHZ);
+    }
+    for (int kind = 0; kind < PM_BOOST_COUNT; kind++) {
+        ESP_LOGI(TAG, "  boost %s    %6" PRId64 " ms in %" PRIu32 " sections", BOOST_NAMES[kind],
+                 boost_us[kind] / 1000, boost_count[kind]);
+    }
+
+#if CONFIG_PM_PROFILING
+    // Time actually spent at each frequency, including the IDF's own locks.
+    esp_pm_dump_locks(stdout);
+#endif
+}
+
+#else // !CONFIG_PM_ENABLE
+
+esp_err_t pm_profile_init(void)
+{
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+esp_err_t pm_profile_set(pm_profile_t profile)
+{
+    (void)profile;
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+pm_profile_t pm_profile_get(void)
+{
+    return PM_PROFILE_PERFORMANCE;
+}
+
+pm_boost_t pm_boost_begin(pm_boost_kind_t kind)
+{
+    pm_boost_t boost = { .kind = kind, .since_us = 0 };
+    return boost;
+}
+
+void pm_boost_end(pm_boost_t *boost)
+{
+    (void)boost;
+}
+
+void pm_profile_report(void)
+{
+}
+
+#endif // CONFIG_PM_ENABLE
@@ -0,0 +1,90 @@
+#include "sample_buffer.h"
+
+#include <string.h>
+#include <sys/time.h>
+
+#include "esp_attr.h"
+
+// Changes whenever the RTC layout below changes.
+#define SAMPLE_BUFFER_MAGIC 0x53424631u
+
+// RTC slow memory keeps its contents through deep sleep.
+static RTC_DATA_ATTR uint32_t s_magic;
+static RTC_DATA_ATTR sample_t s_samples[SAMPLE_BUFFER_CAPACITY];
+static RTC_DATA_ATTR uint32_t s_head;     // index of the oldest reading
+static RTC_DATA_ATTR uint32_t s_count;
+static RTC_DATA_ATTR uint32_t s_next_seq;
+static RTC_DATA_ATTR uint32_t s_dropped;
+
+void sample_buffer_init(void)
+{
+    if (s_magic == SAMPLE_BUFFER_MAGIC &&
+        s_head < SAMPLE_BUFFER_CAPACITY &&
+        s_count <= SAMPLE_BUFFER_CAPACITY) {
+        return;
+    }
+
+    memset(s_samples, 0, sizeof(s_samples));
+    s_head = 0;
+    s_count = 0;
+    s_next_seq = 0;
+    s_dropped = 0;
+    s_magic = SAMPLE_BUFFER_MAGIC;
+}
+
+void sample_buffer_push(int16_t adc_mv, uint8_t wake_cause)
+{
+    // The RTC timer keeps counting in deep sleep, so this stays monotonic
+    // across wakes even before the clock is synchronized.
+    struct timeval now;
+    gettimeofday(&now, NULL);
+
+    sample_buffer_push_at(adc_mv, wake_cause, (uint32_t)now.tv_sec);
+}
+
+void sample_buffer_push_at(int16_t adc_mv, uint8_t wake_cause, uint32_t time_s)
+{
+    if (s_count == SAMPLE_BUFFER_CAPACITY) {
+        // Keep the newest readings; the oldest is least useful.
+        s_head = (s_head + 1) % SAMPLE_BUFFER_CAPACITY;
+        s_count--;
+        s_dropped++;
+    }
+
+    sample_t *s = &s_samples[(s_head + s_count) % SAMPLE_BUFFER_CAPACITY];
+    s->seq = s_next_seq++;
+    s->time_s = time_s;
+    s->adc_mv = adc_mv;
+    s->wake_cause = wake_cause;
+    s->reserved = 0;
+    s_count++;
+}
+
+size_t sample_buffer_count(void)
+{
+    return s_count;
+}
+
+uint32_t sample_buffer_dropped(void)
+{
+    return s_dropped;
+}
+
+size_t sample_buffer_peek(sample_t *out, size_t max)
+{
+    size_t n = (s_count < max) ? s_count : max;
+    for (size_t i = 0; i < n; i++) {
+        out[i] = s_samples[(s_head + i) % SAMPLE_BUFFER_CAPACITY];
+    }
+    return n;
+}
+
+void sample_buffer_consume(size_t count)
+{
+    if (count > s_count) {
+        count = s_count;
+    }
+    s_head = (s_head + count) % SAMPLE_BUFFER_CAPACITY;
+    s_count -= count;
+    s_dropped = 0;
+}
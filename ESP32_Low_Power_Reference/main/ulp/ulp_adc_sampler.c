@@ -0,0 +1,90 @@
+/**
+ * @file ulp_adc_sampler.c
+ * @brief ULP RISC-V program: periodic ADC sampling while the main CPU sleeps.
+ *
+ * The ULP timer starts this program every sample period. Each run reads one
+ * ADC1 channel, appends the raw value to a buffer in RTC slow memory, and
+ * wakes the main CPU only when
+ *   - a reading rises to or above the threshold, or
+ *   - the buffer holds a full batch.
+ *
+ * The build system prefixes every global symbol with "ulp_" in the generated
+ * header (ulp_adc_sampler.h), so main-side code uses ulp_sample_count,
+ * ulp_samples, and so on.
+ */
+
+#include <stdint.h>
+#include "ulp_riscv_utils.h"
+#include "ulp_riscv_adc_ulp_core.h"
+
+/* Buffer slots; must match ULP_SAMPLE_SLOTS in ulp_monitor.c. */
+#define SAMPLE_SLOTS        32U
+
+/* Bits in wake_reason. */
+#define WAKE_THRESHOLD      (1U << 0)
+#define WAKE_BATCH_FULL     (1U << 1)
+
+/* ---- Set by the main CPU before the program starts --------------------- */
+
+/** ADC1 channel to read. */
+volatile uint32_t adc_channel = 0;
+
+/** Raw value that counts as an alert; 0 disables the threshold wake. */
+volatile uint32_t threshold_raw = 0;
+
+/** Readings that make up a batch. */
+volatile uint32_t batch_size = 1;
+
+/* ---- Shared with the main CPU ------------------------------------------ */
+
+/** Raw readings, oldest first. The main CPU empties the buffer on wake. */
+volatile uint32_t samples[SAMPLE_SLOTS];
+
+/** Readings in samples[]. */
+volatile uint32_t sample_count = 0;
+
+/** Readings lost because the main CPU did not empty a full buffer. */
+volatile uint32_t overflow = 0;
+
+/** Set while readings are at or above the threshold. */
+volatile uint32_t alert_active = 0;
+
+/** Why the main CPU was woken; cleared by the main CPU. */
+volatile uint32_t wake_reason = 0;
+
+/**
+ * @brief ULP RISC-V entry point — invoked on every ULP timer tick.
+ */
+int main(void)
+{
+    uint32_t raw = (uint32_t)ulp_riscv_adc_read_channel(ADC_UNIT_1, (int)adc_channel);
+
+    if (sample_count < SAMPLE_SLOTS) {
+        samples[sample_count++] = raw;
+    } else {
+        overflow++;
+    }
+
+    if (threshold_raw != 0U) {
+        // Only a rising crossing wakes the CPU, so a value that stays
+        // high does not wake it on every tick.
+        uint32_t above = (raw >= threshold_raw) ? 1U : 0U;
+        if (above && !alert_active) {
+            wake_reason |= WAKE_THRESHOLD;
+        }
+        alert_active = above;
+    }
+
+    if (sample_count >= batch_size) {
+        wake_reason |= WAKE_BATCH_FULL;
+    }
+
+    if (wake_reason != 0U) {
+        // Repeats on every tick until the main CPU clears wake_reason.
+        ulp_riscv_wakeup_main_processor();
+    }
+
+    // Halt until the next timer tick.
+    ulp_riscv_halt();
+    return 0;
+}
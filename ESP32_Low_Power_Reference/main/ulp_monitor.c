@@ -0,0 +1,130 @@
+#include "ulp_monitor.h"
+
+#include <inttypes.h>
+#include <sys/time.h>
+
+#include "esp_log.h"
+#include "esp_sleep.h"
+#include "ulp_adc.h"
+#include "ulp_riscv.h"
+
+#include "sample_buffer.h"
+
+// Generated by ulp_embed_binary(): the ULP program's globals with a "ulp_" prefix.
+#include "ulp_adc_sampler.h"
+
+static const char *TAG = "ulp_mon";
+
+// Size of samples[] in ulp/ulp_adc_sampler.c.
+#define ULP_SAMPLE_SLOTS        32
+
+// Bits in ulp_wake_reason, as set by the ULP program.
+#define ULP_WAKE_THRESHOLD      (1U << 0)
+
+// 12-bit reading at 12 dB attenuation. The linear scale is uncalibrated;
+// use adc_cali on the main CPU if the readings need to be accurate.
+#define ULP_ADC_MAX_RAW         4095
+#define ULP_ADC_FULL_SCALE_MV   3100
+
+_Static_assert(CONFIG_LP_BATCH_SIZE <= ULP_SAMPLE_SLOTS, "LP_BATCH_SIZE exceeds the ULP buffer");
+
+extern const uint8_t ulp_adc_sampler_bin_start[] asm("_binary_ulp_adc_sampler_bin_start");
+extern const uint8_t ulp_adc_sampler_bin_end[] asm("_binary_ulp_adc_sampler_bin_end");
+
+static uint32_t mv_to_raw(uint32_t mv)
+{
+    uint32_t raw = mv * ULP_ADC_MAX_RAW / ULP_ADC_FULL_SCALE_MV;
+    return raw > ULP_ADC_MAX_RAW ? ULP_ADC_MAX_RAW : raw;
+}
+
+static int16_t raw_to_mv(uint32_t raw)
+{
+    return (int16_t)(raw * ULP_ADC_FULL_SCALE_MV / ULP_ADC_MAX_RAW);
+}
+
+esp_err_t ulp_monitor_start(void)
+{
+    ulp_adc_cfg_t adc = {
+        .adc_n = ADC_UNIT_1,
+        .channel = (adc_channel_t)CONFIG_LP_ULP_ADC_CHANNEL,
+        .atten = ADC_ATTEN_DB_12,
+        .width = ADC_BITWIDTH_12,
+        .ulp_mode = ADC_ULP_MODE_RISCV,
+    };
+    esp_err_t err = ulp_adc_init(&adc);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "ulp_adc_init: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    err = ulp_riscv_load_binary(ulp_adc_sampler_bin_start,
+                                (size_t)(ulp_adc_sampler_bin_end - ulp_adc_sampler_bin_start));
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "ulp_riscv_load_binary: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    // Loading resets the program's globals; set the inputs before it runs.
+    ulp_adc_channel = CONFIG_LP_ULP_ADC_CHANNEL;
+    ulp_batch_size = CONFIG_LP_BATCH_SIZE;
+#if CONFIG_LP_ALERT_THRESHOLD_MV > 0
+    ulp_threshold_raw = mv_to_raw(CONFIG_LP_ALERT_THRESHOLD_MV);
+#else
+    ulp_threshold_raw = 0;
+#endif
+
+    err = ulp_set_wakeup_period(0, (uint32_t)CONFIG_LP_ULP_SAMPLE_PERIOD_MS * 1000U);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "ulp_set_wakeup_period: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    err = ulp_riscv_run();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "ulp_riscv_run: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    ESP_LOGW(TAG, "ULP sampling ADC1 ch%d every %d ms",
+             CONFIG_LP_ULP_ADC_CHANNEL, CONFIG_LP_ULP_SAMPLE_PERIOD_MS);
+    return ESP_OK;
+}
+
+size_t ulp_monitor_collect(uint8_t wake_cause, bool *alert)
+{
+    // Keep the ULP from appending while the buffer is read and reset.
+    ulp_riscv_timer_stop();
+
+    uint32_t count = ulp_sample_count;
+    if (count > ULP_SAMPLE_SLOTS) {
+        count = ULP_SAMPLE_SLOTS;
+    }
+    uint32_t reason = ulp_wake_reason;
+    uint32_t overflow = ulp_overflow;
+
+    // The newest reading is from the last tick; earlier ones are one
+    // sample period apart.
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    uint64_t now_ms = (uint64_t)now.tv_sec * 1000U + (uint64_t)now.tv_usec / 1000U;
+
+    // Exported arrays appear as a single uint32_t in the generated header.
+    const volatile uint32_t *samples = &ulp_samples;
+    for (uint32_t i = 0; i < count; i++) {
+        uint64_t age_ms = (uint64_t)(count - 1 - i) * CONFIG_LP_ULP_SAMPLE_PERIOD_MS;
+        uint64_t taken_ms = (now_ms > age_ms) ? now_ms - age_ms : 0;
+        sample_buffer_push_at(raw_to_mv(samples[i]), wake_cause, (uint32_t)(taken_ms / 1000U));
+    }
+
+    ulp_sample_count = 0;
+    ulp_overflow = 0;
+    ulp_wake_reason = 0;
+
+    ulp_riscv_timer_resume();
+
+    if (overflow != 0) {
+        ESP_LOGW(TAG, "ULP buffer overflowed: %" PRIu32 " readings lost", overflow);
+    }
+    *alert = (reason & ULP_WAKE_THRESHOLD) != 0;
+    return count;
+}
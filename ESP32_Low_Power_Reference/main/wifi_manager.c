@@ -1,47 +1,52 @@
 #include "wifi_manager.h"
 
+#include <inttypes.h>
 #include <string.h>
 #include <sys/socket.h>
+#include <sys/time.h>
 #include <netdb.h>
 
 #include "freertos/FreeRTOS.h"
-#include "freertos/event_groups.h"
 
-#include "esp_event.h"
+#include "esp_attr.h"
+#include "esp_check.h"
 #include "esp_log.h"
 #include "esp_netif.h"
-#include "esp_wifi.h"
+#include "esp_timer.h"
 #include "nvs_flash.h"
+#include "wifi_sta.h"
 
 static const char *TAG = "wifi_mgr";
 
-// Event bits
-#define WIFI_CONNECTED_BIT BIT0
-#define WIFI_FAIL_BIT      BIT1
+#if CONFIG_LP_WIFI_FAST_RECONNECT
+#define WIFI_FAST_RECONNECT 1
+#else
+#define WIFI_FAST_RECONNECT 0
+#endif
 
-static EventGroupHandle_t s_wifi_event_group;
+// Changes whenever the RTC layout of wifi_cache_t changes.
+#define WIFI_CACHE_MAGIC 0x57434131u
+
+/**
+ * Association and lease details from the last successful connect. Kept in
+ * RTC memory so the next wake can skip the channel scan and DHCP.
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t bssid[6];
+    uint8_t channel;
+    bool has_lease;
+    esp_netif_ip_info_t ip_info;
+    esp_netif_dns_info_t dns;
+    int64_t lease_time_s;   // RTC time when DHCP handed out the lease
+} wifi_cache_t;
+
+static RTC_DATA_ATTR wifi_cache_t s_cache;
+static wifi_manager_stats_t s_stats;
+static int64_t s_radio_on_us;   // esp_timer time of the current connect, 0 when off
+
+#ifdef CONFIG_LP_ENABLE_WIFI
 static esp_netif_t *s_sta_netif;
-static int s_retry_num;
-
-static void wifi_event_handler(void *arg,
-                               esp_event_base_t event_base,
-                               int32_t event_id,
-                               void *event_data)
-{
-    if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) {
-        esp_wifi_connect();
-    } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
-        if (s_retry_num < 3) {
-            s_retry_num++;
-            esp_wifi_connect();
-        } else {
-            xEventGroupSetBits(s_wifi_event_group, WIFI_FAIL_BIT);
-        }
-    } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) {
-        s_retry_num = 0;
-        xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
-    }
-}
 
 static esp_err_t wifi_manager_init_once(void)
 {
@@ -58,32 +63,139 @@ static esp_err_t wifi_manager_init_once(void)
     }
     ESP_RETURN_ON_ERROR(err, TAG, "nvs_flash_init failed");
 
-    ESP_ERROR_CHECK(esp_netif_init());
-    ESP_ERROR_CHECK(esp_event_loop_create_default());
+    // Modem sleep only matters between connect and shutdown; the profile,
+    // listen interval and DTIM period come from the "Wi-Fi station" menu.
+    const wifi_sta_config_t cfg = {
+        .ssid = CONFIG_LP_WIFI_SSID,
+        .password = CONFIG_LP_WIFI_PASSWORD,
+        .max_retries = 3,
+    };
+    ESP_RETURN_ON_ERROR(wifi_sta_init(&cfg), TAG, "wifi init failed");
+    s_sta_netif = wifi_sta_get_netif();
 
-    s_sta_netif = esp_netif_create_default_wifi_sta();
-    if (s_sta_netif == NULL) {
-        return ESP_FAIL;
+    initialized = true;
+    return ESP_OK;
+}
+#endif
+
+/**
+ * @brief RTC time in seconds; keeps counting through deep sleep.
+ */
+static int64_t rtc_seconds(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return now.tv_sec;
+}
+
+static bool cache_valid(void)
+{
+    return s_cache.magic == WIFI_CACHE_MAGIC &&
+           s_cache.channel >= 1 && s_cache.channel <= 14;
+}
+
+/**
+ * @brief Check whether the cached DHCP lease may be reused without DHCP.
+ */
+static bool lease_usable(void)
+{
+#if CONFIG_LP_WIFI_IP_CACHED_LEASE
+    int64_t age = rtc_seconds() - s_cache.lease_time_s;
+    return cache_valid() && s_cache.has_lease &&
+           age >= 0 && age < CONFIG_LP_WIFI_LEASE_REUSE_SEC;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Select static addressing or DHCP for the next connect.
+ *
+ * @param use_lease Apply the cached lease instead of running DHCP.
+ * @return true if the address was set without DHCP.
+ */
+static bool apply_ip_config(bool use_lease)
+{
+#if CONFIG_LP_WIFI_IP_STATIC
+    (void)use_lease;
+    esp_netif_ip_info_t ip_info = {0};
+    ip_info.ip.addr = esp_ip4addr_aton(CONFIG_LP_WIFI_STATIC_IP);
+    ip_info.gw.addr = esp_ip4addr_aton(CONFIG_LP_WIFI_STATIC_GW);
+    ip_info.netmask.addr = esp_ip4addr_aton(CONFIG_LP_WIFI_STATIC_NETMASK);
+
+    esp_netif_dns_info_t dns = {0};
+    dns.ip.type = ESP_IPADDR_TYPE_V4;
+    dns.ip.u_addr.ip4.addr = esp_ip4addr_aton(CONFIG_LP_WIFI_STATIC_DNS);
+
+    esp_netif_dhcpc_stop(s_sta_netif);
+    esp_netif_set_ip_info(s_sta_netif, &ip_info);
+    esp_netif_set_dns_info(s_sta_netif, ESP_NETIF_DNS_MAIN, &dns);
+    return true;
+#else
+    if (use_lease) {
+        esp_netif_dhcpc_stop(s_sta_netif);
+        esp_netif_set_ip_info(s_sta_netif, &s_cache.ip_info);
+        esp_netif_set_dns_info(s_sta_netif, ESP_NETIF_DNS_MAIN, &s_cache.dns);
+        return true;
     }
+    // No-op if DHCP is already running.
+    esp_netif_dhcpc_start(s_sta_netif);
+    return false;
+#endif
+}
 
-    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
-    ESP_ERROR_CHECK(esp_wifi_init(&cfg));
+/**
+ * @brief Remember the AP, and a fresh DHCP lease, for the next wake.
+ *
+ * @param from_dhcp The address in use came from DHCP on this connect.
+ */
+static void cache_save(bool from_dhcp)
+{
+    wifi_sta_ap_t ap;
+    if (wifi_sta_get_ap(&ap) != ESP_OK) {
+        return;
+    }
 
-    // Register event handlers
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT,
-                                                        ESP_EVENT_ANY_ID,
-                                                        &wifi_event_handler,
-                                                        NULL,
-                                                        NULL));
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(IP_EVENT,
-                                                        IP_EVENT_STA_GOT_IP,
-                                                        &wifi_event_handler,
-                                                        NULL,
-                                                        NULL));
+    memcpy(s_cache.bssid, ap.bssid, sizeof(s_cache.bssid));
+    s_cache.channel = ap.channel;
 
-    initialized = true;
-    return ESP_OK;
+    // A reused lease keeps its original time, so it still expires.
+    if (from_dhcp) {
+        s_cache.has_lease = esp_netif_get_ip_info(s_sta_netif, &s_cache.ip_info) == ESP_OK &&
+                            esp_netif_get_dns_info(s_sta_netif, ESP_NETIF_DNS_MAIN, &s_cache.dns) == ESP_OK;
+        s_cache.lease_time_s = rtc_seconds();
+    }
+    s_cache.magic = WIFI_CACHE_MAGIC;
+}
+
+/**
+ * @brief Start Wi-Fi and wait for an IP address.
+ *
+ * @param fast Join the cached BSSID on its channel instead of scanning.
+ * @param timeout_ms Maximum time to wait for connection.
+ * @return ESP_OK on success, otherwise an ESP-IDF error code.
+ */
+static esp_err_t connect_once(bool fast, uint32_t timeout_ms)
+{
+    // With a known channel and BSSID a single channel is probed instead of
+    // all of them.
+    wifi_sta_ap_t ap;
+    if (fast) {
+        memcpy(ap.bssid, s_cache.bssid, sizeof(ap.bssid));
+        ap.channel = s_cache.channel;
+    }
+
+    bool no_dhcp = apply_ip_config(fast && lease_usable());
+
+    esp_err_t err = wifi_sta_connect(fast ? &ap : NULL, pdMS_TO_TICKS(timeout_ms));
+    if (err == ESP_OK) {
+        cache_save(!no_dhcp);
+    } else {
+        ESP_LOGW(TAG, "connect %s", (err == ESP_ERR_TIMEOUT) ? "timeout" : "failed");
+    }
+    return err;
 }
+#endif
 
 esp_err_t wifi_manager_connect(uint32_t timeout_ms)
 {
@@ -93,61 +205,61 @@ esp_err_t wifi_manager_connect(uint32_t timeout_ms)
 #else
     ESP_RETURN_ON_ERROR(wifi_manager_init_once(), TAG, "wifi init failed");
 
-    if (s_wifi_event_group == NULL) {
-        s_wifi_event_group = xEventGroupCreate();
-        if (s_wifi_event_group == NULL) {
-            return ESP_ERR_NO_MEM;
-        }
+    int64_t start_us = esp_timer_get_time();
+    if (s_radio_on_us == 0) {
+        s_radio_on_us = start_us;
     }
 
-    s_retry_num = 0;
-
-    wifi_config_t wifi_config = {0};
-    strlcpy((char *)wifi_config.sta.ssid, CONFIG_LP_WIFI_SSID, sizeof(wifi_config.sta.ssid));
-    strlcpy((char *)wifi_config.sta.password, CONFIG_LP_WIFI_PASSWORD, sizeof(wifi_config.sta.password));
-
-    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
-    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config));
+    bool fast = WIFI_FAST_RECONNECT && cache_valid();
+    esp_err_t err = connect_once(fast, timeout_ms);
 
-    // For connected-but-idle periods, enable modem sleep.
-    ESP_ERROR_CHECK(esp_wifi_set_ps(WIFI_PS_MIN_MODEM));
+    if (err != ESP_OK && fast) {
+        // The AP moved channel or was replaced: forget it and scan.
+        ESP_LOGW(TAG, "fast reconnect failed, scanning");
+        wifi_manager_forget_ap();
 
-    ESP_ERROR_CHECK(esp_wifi_start());
-
-    EventBits_t bits = xEventGroupWaitBits(
-        s_wifi_event_group,
-        WIFI_CONNECTED_BIT | WIFI_FAIL_BIT,
-        pdTRUE,
-        pdFALSE,
-        pdMS_TO_TICKS(timeout_ms));
-
-    if (bits & WIFI_CONNECTED_BIT) {
-        ESP_LOGI(TAG, "connected");
-        return ESP_OK;
+        uint32_t spent_ms = (uint32_t)((esp_timer_get_time() - start_us) / 1000);
+        if (spent_ms < timeout_ms) {
+            fast = false;
+            err = connect_once(false, timeout_ms - spent_ms);
+        }
     }
 
-    if (bits & WIFI_FAIL_BIT) {
-        ESP_LOGW(TAG, "connect failed");
-        return ESP_FAIL;
+    s_stats.connect_ms = (uint32_t)((esp_timer_get_time() - start_us) / 1000);
+    s_stats.fast = fast;
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "connected in %" PRIu32 " ms (%s)",
+                 s_stats.connect_ms, fast ? "cached AP" : "full scan");
     }
+    return err;
+#endif
+}
 
-    ESP_LOGW(TAG, "connect timeout");
-    return ESP_ERR_TIMEOUT;
+void wifi_manager_forget_ap(void)
+{
+#ifdef CONFIG_LP_ENABLE_WIFI
+    s_cache.magic = 0;
 #endif
 }
 
-esp_err_t wifi_manager_demo_tx(const char *host, uint16_t port, uint32_t timeout_ms)
+void wifi_manager_get_stats(wifi_manager_stats_t *stats)
 {
-#ifndef CONFIG_LP_ENABLE_WIFI
-    (void)host;
-    (void)port;
-    (void)timeout_ms;
-    return ESP_ERR_NOT_SUPPORTED;
-#else
-    if (host == NULL || host[0] == '\0') {
-        return ESP_ERR_INVALID_ARG;
+    *stats = s_stats;
+#ifdef CONFIG_LP_ENABLE_WIFI
+    if (s_radio_on_us != 0) {
+        stats->radio_on_ms += (uint32_t)((esp_timer_get_time() - s_radio_on_us) / 1000);
     }
+#endif
+}
 
+#ifdef CONFIG_LP_ENABLE_WIFI
+/**
+ * @brief Open a TCP connection with send/receive timeouts.
+ *
+ * @return Socket descriptor, or -1 on failure.
+ */
+static int tcp_connect(const char *host, uint16_t port, uint32_t timeout_ms)
+{
     char port_str[8] = {0};
     snprintf(port_str, sizeof(port_str), "%u", (unsigned)port);
 
@@ -159,13 +271,13 @@ esp_err_t wifi_manager_demo_tx(const char *host, uint16_t port, uint32_t timeout
     int err = getaddrinfo(host, port_str, &hints, &res);
     if (err != 0 || res == NULL) {
         ESP_LOGW(TAG, "getaddrinfo failed (%d)", err);
-        return ESP_FAIL;
+        return -1;
     }
 
     int sock = socket(res->ai_family, res->ai_socktype, res->ai_protocol);
     if (sock < 0) {
         freeaddrinfo(res);
-        return ESP_FAIL;
+        return -1;
     }
 
     // Set connect timeout.
@@ -181,6 +293,26 @@ esp_err_t wifi_manager_demo_tx(const char *host, uint16_t port, uint32_t timeout
     if (rc != 0) {
         close(sock);
         ESP_LOGW(TAG, "TCP connect failed");
+        return -1;
+    }
+    return sock;
+}
+#endif
+
+esp_err_t wifi_manager_demo_tx(const char *host, uint16_t port, uint32_t timeout_ms)
+{
+#ifndef CONFIG_LP_ENABLE_WIFI
+    (void)host;
+    (void)port;
+    (void)timeout_ms;
+    return ESP_ERR_NOT_SUPPORTED;
+#else
+    if (host == NULL || host[0] == '\0') {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int sock = tcp_connect(host, port, timeout_ms);
+    if (sock < 0) {
         return ESP_FAIL;
     }
 
@@ -190,17 +322,60 @@ esp_err_t wifi_manager_demo_tx(const char *host, uint16_t port, uint32_t timeout
 #endif
 }
 
+esp_err_t wifi_manager_send(const char *host, uint16_t port,
+                            const void *data, size_t len, uint32_t timeout_ms)
+{
+#ifndef CONFIG_LP_ENABLE_WIFI
+    (void)host;
+    (void)port;
+    (void)data;
+    (void)len;
+    (void)timeout_ms;
+    return ESP_ERR_NOT_SUPPORTED;
+#else
+    if (host == NULL || host[0] == '\0' || (data == NULL && len > 0)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int sock = tcp_connect(host, port, timeout_ms);
+    if (sock < 0) {
+        return ESP_FAIL;
+    }
+
+    const uint8_t *p = data;
+    size_t left = len;
+    while (left > 0) {
+        int n = send(sock, p, left, 0);
+        if (n <= 0) {
+            close(sock);
+            ESP_LOGW(TAG, "send failed after %u of %u bytes",
+                     (unsigned)(len - left), (unsigned)len);
+            return ESP_FAIL;
+        }
+        p += n;
+        left -= (size_t)n;
+    }
+
+    // Half-close so the peer sees the end of the batch before we tear down.
+    shutdown(sock, SHUT_WR);
+    close(sock);
+    ESP_LOGI(TAG, "sent %u bytes", (unsigned)len);
+    return ESP_OK;
+#endif
+}
+
 void wifi_manager_shutdown(void)
 {
 #ifndef CONFIG_LP_ENABLE_WIFI
     return;
 #else
-    // Best-effort shutdown; ignore errors to keep code simple.
-    esp_wifi_disconnect();
-    esp_wifi_stop();
-    esp_wifi_deinit();
+    // Frees the driver; the netif and event handlers stay for the next wake
+    // of this boot, if any.
+    wifi_sta_deinit();
 
-    // Leave event loop and netif in place for simplicity. In a strict
-    // connect-once-per-boot deep sleep design, this is acceptable.
+    if (s_radio_on_us != 0) {
+        s_stats.radio_on_ms += (uint32_t)((esp_timer_get_time() - s_radio_on_us) / 1000);
+        s_radio_on_us = 0;
+    }
 #endif
 }
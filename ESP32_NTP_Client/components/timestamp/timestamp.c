@@ -0,0 +1,111 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/time.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
+#include "timestamp.h"
+
+// A system time read bracketed by esp_timer reads wider than this was
+// interrupted or preempted, and is taken again
+#define TIMESTAMP_SAMPLE_MAX_US  50
+#define TIMESTAMP_SAMPLE_TRIES   8
+
+// Sequence lock: odd while the offset is being written. The 64-bit offset
+// takes two stores on these 32-bit cores, so readers check that the sequence
+// was even and unchanged around their read.
+static volatile uint32_t s_seq;
+static volatile int64_t s_offset_us;
+static volatile bool s_valid;
+
+// Serializes writers only; readers never take it
+static portMUX_TYPE s_write_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * @brief Publish a new offset under the sequence lock
+ *
+ * The critical section keeps an interrupt on this core from reading a half
+ * written offset, and keeps two writers on different cores apart.
+ */
+static void timestamp_publish(int64_t offset_us, bool valid)
+{
+    taskENTER_CRITICAL(&s_write_lock);
+    __atomic_store_n(&s_seq, s_seq + 1, __ATOMIC_RELAXED);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    s_offset_us = offset_us;
+    s_valid = valid;
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+    __atomic_store_n(&s_seq, s_seq + 1, __ATOMIC_RELAXED);
+    taskEXIT_CRITICAL(&s_write_lock);
+}
+
+/**
+ * @brief Read the offset, retrying while a writer is active
+ */
+static inline IRAM_ATTR int64_t timestamp_offset_us(void)
+{
+    uint32_t seq;
+    int64_t offset_us;
+    do {
+        seq = __atomic_load_n(&s_seq, __ATOMIC_ACQUIRE);
+        offset_us = s_offset_us;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+    } while ((seq & 1) || seq != __atomic_load_n(&s_seq, __ATOMIC_RELAXED));
+    return offset_us;
+}
+
+/**
+ * @brief Sample the system time and esp_timer together
+ *
+ * @param[out] offset_us System time minus esp_timer, in microseconds
+ * @return true if the system clock is set
+ */
+static bool timestamp_sample(int64_t *offset_us)
+{
+    struct timeval tv;
+    int64_t before_us = 0;
+    int64_t after_us = 0;
+
+    for (int i = 0; i < TIMESTAMP_SAMPLE_TRIES; i++) {
+        before_us = esp_timer_get_time();
+        gettimeofday(&tv, NULL);
+        after_us = esp_timer_get_time();
+        if (after_us - before_us <= TIMESTAMP_SAMPLE_MAX_US) {
+            break;
+        }
+    }
+
+    int64_t wall_us = (int64_t)tv.tv_sec * 1000000 + tv.tv_usec;
+    *offset_us = wall_us - (before_us + (after_us - before_us) / 2);
+    return tv.tv_sec >= TIMESTAMP_VALID_AFTER_S;
+}
+
+void timestamp_init(void)
+{
+    int64_t offset_us;
+    bool valid = timestamp_sample(&offset_us);
+    timestamp_publish(offset_us, valid);
+}
+
+esp_err_t timestamp_sync(void)
+{
+    int64_t offset_us;
+    bool valid = timestamp_sample(&offset_us);
+    timestamp_publish(offset_us, valid);
+    return valid ? ESP_OK : ESP_ERR_INVALID_STATE;
+}
+
+bool timestamp_is_valid(void)
+{
+    return s_valid;
+}
+
+int64_t IRAM_ATTR timestamp_now_us(void)
+{
+    return esp_timer_get_time() + timestamp_offset_us();
+}
+
+int64_t IRAM_ATTR timestamp_from_mono_us(int64_t mono_us)
+{
+    return mono_us + timestamp_offset_us();
+}
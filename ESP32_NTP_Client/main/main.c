@@ -9,8 +9,8 @@
  *   3) Configure and start SNTP to synchronize the system clock
  *   4) Spawn a FreeRTOS task that prints the current local time every second
  *
- * The code uses the ESP-IDF Wi-Fi station example pattern with retry logic, an
- * event group for synchronization, and the modern SNTP API (`esp_sntp.h`).
+ * The code uses the shared `wifi_sta` component for the station (retry logic,
+ * power-save profile) and the modern SNTP API (`esp_sntp.h`).
  * Once SNTP completes the first sync, we set/confirm the timezone (from Kconfig)
  * and keep printing human-readable timestamps.
  *
@@ -21,12 +21,21 @@
  *     Example Configuration → Timezone (POSIX format, e.g., "EST5EDT,M3.2.0/2,M11.1.0/2")
  * - Flash and monitor: `idf.py -p <PORT> flash monitor`
  *
+ * @section Discipline Disciplined mode
+ * With NTP_DISCIPLINE_ENABLE set in `ntp_discipline.h` (the default), the clock is
+ * kept by `ntp_discipline.c` instead: Wi-Fi is only brought up for each sync, the
+ * oscillator drift is measured and slewed out with `adjtime()`, and the sync
+ * interval grows from minutes to hours as the drift estimate settles.
+ *
  * @section Notes Notes
  * - Timezone must be a valid POSIX TZ string. For example:
  *     "UTC0" for UTC,
  *     "EST5EDT,M3.2.0/2,M11.1.0/2" for US Eastern with DST.
  * - The SNTP servers can be customized (e.g., regional pool servers or a local NTP).
  * - Printing uses `localtime_r()`; if you need UTC, use `gmtime_r()`.
+ * - Other tasks (and ISRs) that need microsecond UTC stamps should call
+ *   `timestamp_now_us()` from the `timestamp` component rather than
+ *   `gettimeofday()`; both sync paths keep it anchored to the system clock.
  */
 
 #include <string.h>
@@ -36,77 +45,38 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
-#include "freertos/event_groups.h"
 
-#include "esp_wifi.h"
-#include "esp_event.h"
 #include "esp_log.h"
 #include "nvs_flash.h"
 #include "esp_system.h"
-#include "esp_netif.h"
 #include "esp_err.h"
 
 #include "esp_sntp.h"   // Modern SNTP API header in ESP-IDF
 
+#include "ntp_discipline.h"
+#include "timestamp.h"
+#include "wifi_sta.h"
+
 // ---------- Kconfig bindings ----------
 #define WIFI_SSID       CONFIG_WIFI_SSID
 #define WIFI_PASS       CONFIG_WIFI_PASSWORD
 #define EXAMPLE_TZ      CONFIG_TIMEZONE
 #define MAX_RETRY       10
-
-// ---------- Event group bits ----------
-#define WIFI_CONNECTED_BIT   BIT0
-#define WIFI_FAIL_BIT        BIT1
+#define LINK_TIMEOUT_MS 15000   // Wi-Fi reconnect limit for each disciplined sync
 
 static const char *TAG = "NTP_APP";
-static EventGroupHandle_t s_wifi_event_group;
-static int s_retry_num = 0;
-
-/**
- * @brief Wi-Fi event/IP handlers for station mode connection management.
- *
- * @details
- * - On WIFI_EVENT_STA_START → esp_wifi_connect()
- * - On WIFI_EVENT_STA_DISCONNECTED → retry up to MAX_RETRY times
- * - On IP_EVENT_STA_GOT_IP → set WIFI_CONNECTED_BIT
- *
- * @param arg     User argument (unused)
- * @param event_base Event loop base (Wi-Fi/IP)
- * @param event_id   Event ID
- * @param event_data Opaque pointer to event-specific data
- */
-static void wifi_event_handler(void *arg,
-                               esp_event_base_t event_base,
-                               int32_t event_id,
-                               void *event_data)
-{
-    if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) {
-        esp_wifi_connect();
-    } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
-        if (s_retry_num < MAX_RETRY) {
-            esp_wifi_connect();
-            s_retry_num++;
-            ESP_LOGW(TAG, "Retrying to connect to the AP... (%d/%d)", s_retry_num, MAX_RETRY);
-        } else {
-            xEventGroupSetBits(s_wifi_event_group, WIFI_FAIL_BIT);
-        }
-        ESP_LOGW(TAG, "Disconnected from AP");
-    } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) {
-        ip_event_got_ip_t *event = (ip_event_got_ip_t *) event_data;
-        ESP_LOGI(TAG, "Got IP: " IPSTR, IP2STR(&event->ip_info.ip));
-        s_retry_num = 0;
-        xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
-    }
-}
 
 /**
  * @brief Initialize Wi-Fi in station (STA) mode and block until IP acquired or fail.
  *
  * @details
- * Creates default netif, registers Wi-Fi/IP event handlers, initializes the Wi-Fi
- * driver, sets the SSID/PASS, starts STA, and waits on an event group for either
- * `WIFI_CONNECTED_BIT` or `WIFI_FAIL_BIT`. This function returns when the station
- * is connected (IP assigned) or when retries are exhausted.
+ * The `wifi_sta` component creates the default netif and event loop, registers
+ * the Wi-Fi/IP handlers and retries up to MAX_RETRY times. This function returns
+ * when the station is connected (IP assigned) or when retries are exhausted.
+ *
+ * Modem sleep is off: the AP would hold each NTP reply until the next DTIM
+ * beacon, adding up to one DTIM period to the return path only. That
+ * asymmetric delay goes straight into the measured offset.
  *
  * @return esp_err_t
  * - ESP_OK when connected and IP acquired
@@ -114,50 +84,59 @@ static void wifi_event_handler(void *arg,
  */
 static esp_err_t wifi_init_and_wait_ip(void)
 {
-    s_wifi_event_group = xEventGroupCreate();
-    ESP_ERROR_CHECK(esp_netif_init());
-    ESP_ERROR_CHECK(esp_event_loop_create_default());
-
-    esp_netif_create_default_wifi_sta();
-
-    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
-    ESP_ERROR_CHECK(esp_wifi_init(&cfg));
-
-    // Register event handlers
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(
-                        WIFI_EVENT, ESP_EVENT_ANY_ID, &wifi_event_handler, NULL, NULL));
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(
-                        IP_EVENT, IP_EVENT_STA_GOT_IP, &wifi_event_handler, NULL, NULL));
-
-    wifi_config_t wifi_config = { 0 };
-    strlcpy((char *)wifi_config.sta.ssid, WIFI_SSID, sizeof(wifi_config.sta.ssid));
-    strlcpy((char *)wifi_config.sta.password, WIFI_PASS, sizeof(wifi_config.sta.password));
-    wifi_config.sta.threshold.authmode = WIFI_AUTH_WPA2_PSK;  // adjust if your AP differs
-    wifi_config.sta.sae_pwe_h2e = WPA3_SAE_PWE_BOTH;          // compatible setting
-
-    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
-    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config));
-    ESP_ERROR_CHECK(esp_wifi_start());
+    const wifi_sta_config_t wifi_config = {
+        .ssid = WIFI_SSID,
+        .password = WIFI_PASS,
+        .max_retries = MAX_RETRY,
+        .ps_profile = WIFI_STA_PS_LOW_LATENCY,
+    };
+    ESP_ERROR_CHECK(wifi_sta_init(&wifi_config));
 
     ESP_LOGI(TAG, "Wi-Fi STA started, connecting to SSID:\"%s\"", WIFI_SSID);
 
-    // Wait until either the connection is established (WIFI_CONNECTED_BIT) or connection failed
-    EventBits_t bits = xEventGroupWaitBits(
-        s_wifi_event_group,
-        WIFI_CONNECTED_BIT | WIFI_FAIL_BIT,
-        pdFALSE,
-        pdFALSE,
-        portMAX_DELAY);
-
-    if (bits & WIFI_CONNECTED_BIT) {
+    esp_err_t err = wifi_sta_connect(NULL, portMAX_DELAY);
+    if (err == ESP_OK) {
         ESP_LOGI(TAG, "Connected to AP");
-        return ESP_OK;
     } else {
         ESP_LOGE(TAG, "Failed to connect to AP after %d retries", MAX_RETRY);
-        return ESP_FAIL;
     }
+    return err;
 }
 
+#if NTP_DISCIPLINE_ENABLE
+/**
+ * @brief Bring Wi-Fi back up for a disciplined sync.
+ *
+ * @details
+ * The first sync reuses the connection made by `wifi_init_and_wait_ip()`. Later
+ * syncs restart the station and wait for an IP again (DHCP included).
+ *
+ * @return esp_err_t
+ * - ESP_OK when an IP is assigned
+ * - ESP_FAIL / ESP_ERR_TIMEOUT when the AP could not be joined
+ */
+static esp_err_t wifi_link_up(void)
+{
+    esp_err_t err = wifi_sta_connect(NULL, pdMS_TO_TICKS(LINK_TIMEOUT_MS));
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Wi-Fi not available for sync");
+    }
+    return err;
+}
+
+/**
+ * @brief Turn Wi-Fi off between disciplined syncs.
+ *
+ * @return esp_err_t Always ESP_OK.
+ */
+static esp_err_t wifi_link_down(void)
+{
+    wifi_sta_stop();
+    return ESP_OK;
+}
+#endif
+
+#if !NTP_DISCIPLINE_ENABLE
 /**
  * @brief SNTP time sync callback for logging.
  *
@@ -170,6 +149,7 @@ static esp_err_t wifi_init_and_wait_ip(void)
 static void time_sync_notification_cb(struct timeval *tv)
 {
     (void) tv;
+    timestamp_sync();
     ESP_LOGI(TAG, "Time synchronization event received");
 }
 
@@ -239,13 +219,17 @@ static esp_err_t sntp_start_and_wait(int wait_seconds)
 
     return ESP_OK;
 }
+#endif
 
 /**
  * @brief FreeRTOS task that prints the local time every second.
  *
  * @details
- * Loops forever, reading the current system time, converting to local time, and
- * printing in a human-readable ISO-like format. If you need UTC, switch to `gmtime_r()`.
+ * Sleeps until the next whole second of UTC, then reads the time,
+ * converts it to local time and prints it in a human-readable ISO-like format.
+ * Waking on the second boundary keeps the printed seconds in step with the
+ * (possibly slewed) clock instead of drifting against a fixed 1000 ms delay.
+ * If you need UTC, switch to `gmtime_r()`.
  *
  * @param pvParameters Unused
  */
@@ -255,7 +239,10 @@ static void print_time_task(void *pvParameters)
     char buf[64];
 
     while (true) {
-        time_t now = time(NULL);
+        int64_t now_us = timestamp_now_us();
+        vTaskDelay(pdMS_TO_TICKS(1000 - (now_us % 1000000) / 1000) + 1);
+
+        time_t now = (time_t)(timestamp_now_us() / 1000000);
         struct tm local = {0};
 
         // Convert to local time (use gmtime_r() for UTC)
@@ -266,7 +253,6 @@ static void print_time_task(void *pvParameters)
         strftime(buf, sizeof(buf), "%Y-%m-%d %I:%M:%S %p %Z", &local);
 
         printf("[TIME] %s\n", buf);
-        vTaskDelay(pdMS_TO_TICKS(1000));
     }
 }
 
@@ -276,7 +262,7 @@ static void print_time_task(void *pvParameters)
  * @details
  * - Initializes NVS (required by Wi-Fi)
  * - Connects to Wi-Fi and waits for IP
- * - Starts SNTP and waits for the first synchronization
+ * - Starts SNTP (continuous or disciplined) and waits for the first synchronization
  * - Creates the `print_time_task`
  */
 void app_main(void)
@@ -288,12 +274,24 @@ void app_main(void)
         ESP_ERROR_CHECK(nvs_flash_init());
     }
 
+    timestamp_init();
+
     // Connect to Wi-Fi
     ESP_ERROR_CHECK(wifi_init_and_wait_ip());
 
+#if NTP_DISCIPLINE_ENABLE
+    // Sync task owns Wi-Fi from here on and turns it off between syncs
+    ESP_ERROR_CHECK(ntp_discipline_start(wifi_link_up, wifi_link_down));
+    ESP_ERROR_CHECK(ntp_discipline_wait_first_sync(30000));  // wait up to 30s for first sync
+
+    setenv("TZ", EXAMPLE_TZ, 1);
+    tzset();
+    ESP_LOGI(TAG, "Timezone set to: %s", EXAMPLE_TZ);
+#else
     // Start SNTP and wait for time
     ESP_ERROR_CHECK(sntp_start_and_wait(30));  // wait up to 30s for first sync
+#endif
 
     // Spawn the periodic printer
     xTaskCreate(print_time_task, "print_time_task", 3072, NULL, 5, NULL);
-}
\ No newline at end of file
+}
@@ -0,0 +1,299 @@
+/*
+ * @file ntp_discipline.c
+ * @brief Drift-compensating NTP client: measure, slew, and adapt the sync interval.
+ *
+ * @details
+ * The ESP-IDF SNTP client normally sets the clock itself. Here `sntp_sync_time()`
+ * (a weak function in ESP-IDF) is replaced so each NTP reply only records the
+ * offset between server and local time. The sync task then decides:
+ *   - offset >= NTP_STEP_THRESHOLD_MS (or first sync): step with settimeofday()
+ *   - otherwise: slew with adjtime() and refine the drift estimate
+ *
+ * The drift estimate is the offset divided by the time since the previous
+ * sync. Because the drift is already being corrected between syncs, each new
+ * offset is the error of the estimate, and half of it is folded in.
+ *
+ * Every step and every slew is followed by timestamp_sync(), so the shared
+ * timestamp service tracks the disciplined clock.
+ */
+#include "ntp_discipline.h"
+
+#if NTP_DISCIPLINE_ENABLE
+
+#include <stdlib.h>
+#include <sys/time.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/event_groups.h"
+#include "freertos/semphr.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_sntp.h"
+#include "timestamp.h"
+
+// ---------- Event group bits ----------
+#define SYNC_DONE_BIT        BIT0
+#define FIRST_SYNC_BIT       BIT1
+
+// Shortest span over which a drift estimate is taken; shorter spans are mostly SNTP jitter
+#define MIN_DRIFT_SPAN_S     60
+
+static const char *TAG = "NTP_DISC";
+
+static EventGroupHandle_t s_events;
+static SemaphoreHandle_t s_clock_lock;
+static esp_timer_handle_t s_drift_timer;
+static ntp_link_fn_t s_link_up;
+static ntp_link_fn_t s_link_down;
+
+// Written by sntp_sync_time() in the lwIP thread, read by the sync task after SYNC_DONE_BIT
+static int64_t s_reply_offset_us;
+static int64_t s_reply_mono_us;
+
+static bool s_clock_set;
+static int64_t s_last_sync_mono_us;
+static double s_drift_ppm;
+static bool s_drift_valid;
+static double s_drift_carry_us;
+static uint32_t s_interval_s = NTP_MIN_INTERVAL_S;
+static uint32_t s_syncs;
+static int32_t s_last_offset_us;
+
+/**
+ * @brief Return the part of an earlier adjtime() still to be applied, in microseconds.
+ */
+static int64_t pending_slew_us(void)
+{
+    struct timeval remaining = {0};
+    adjtime(NULL, &remaining);
+    return (int64_t)remaining.tv_sec * 1000000 + remaining.tv_usec;
+}
+
+/**
+ * @brief Add `delta_us` to the slew in progress.
+ *
+ * @details
+ * A new adjtime() call replaces the one in progress, so the remaining part of
+ * the old adjustment is carried over. Caller holds s_clock_lock.
+ */
+static void slew_add_us(int64_t delta_us)
+{
+    int64_t total_us = pending_slew_us() + delta_us;
+    struct timeval delta = {
+        .tv_sec = (time_t)(total_us / 1000000),
+        .tv_usec = (suseconds_t)(total_us % 1000000),
+    };
+    if (adjtime(&delta, NULL) != 0) {
+        ESP_LOGW(TAG, "adjtime(%lld us) failed", (long long)total_us);
+    }
+}
+
+/**
+ * @brief Called by the SNTP client with the server time of each reply.
+ *
+ * @details
+ * Replaces the ESP-IDF implementation, so the clock is not touched here. The
+ * offset already accounts for any slew that is still in progress.
+ *
+ * @param tv Server time, corrected for the round trip.
+ */
+void sntp_sync_time(struct timeval *tv)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    int64_t server_us = (int64_t)tv->tv_sec * 1000000 + tv->tv_usec;
+    int64_t local_us = (int64_t)now.tv_sec * 1000000 + now.tv_usec;
+
+    s_reply_offset_us = server_us - local_us - pending_slew_us();
+    s_reply_mono_us = esp_timer_get_time();
+    sntp_set_sync_status(SNTP_SYNC_STATUS_COMPLETED);
+    xEventGroupSetBits(s_events, SYNC_DONE_BIT);
+}
+
+/**
+ * @brief Periodic drift correction, run from the esp_timer task.
+ *
+ * @details
+ * Slews the clock by drift * NTP_DRIFT_PERIOD_S. The fraction below one
+ * microsecond is carried to the next period so small drifts are not lost.
+ */
+static void drift_timer_cb(void *arg)
+{
+    (void) arg;
+    xSemaphoreTake(s_clock_lock, portMAX_DELAY);
+    if (s_drift_valid) {
+        s_drift_carry_us += s_drift_ppm * NTP_DRIFT_PERIOD_S;
+        int64_t whole_us = (int64_t)s_drift_carry_us;
+        if (whole_us != 0) {
+            s_drift_carry_us -= (double)whole_us;
+            slew_add_us(whole_us);
+        }
+    }
+    // adjtime() moves the clock gradually, so re-anchor on every period,
+    // including while the slew from the last measurement is still running
+    timestamp_sync();
+    xSemaphoreGive(s_clock_lock);
+}
+
+/**
+ * @brief Apply one NTP measurement: step or slew, update the drift, pick the next interval.
+ *
+ * @param offset_us Server time minus local time.
+ * @param mono_us   esp_timer time of the measurement.
+ */
+static void apply_measurement(int64_t offset_us, int64_t mono_us)
+{
+    xSemaphoreTake(s_clock_lock, portMAX_DELAY);
+
+    if (!s_clock_set || llabs(offset_us) >= (int64_t)NTP_STEP_THRESHOLD_MS * 1000) {
+        // Far off: step, and do not count this span toward the drift estimate.
+        // The offset was measured against the clock plus the pending slew, so
+        // cancel the slew and include it in the step.
+        int64_t pending_us = pending_slew_us();
+        struct timeval none = {0};
+        adjtime(&none, NULL);
+        struct timeval now;
+        gettimeofday(&now, NULL);
+        int64_t target_us = (int64_t)now.tv_sec * 1000000 + now.tv_usec + pending_us + offset_us;
+        struct timeval tv = {
+            .tv_sec = (time_t)(target_us / 1000000),
+            .tv_usec = (suseconds_t)(target_us % 1000000),
+        };
+        settimeofday(&tv, NULL);
+        s_interval_s = NTP_MIN_INTERVAL_S;
+        ESP_LOGI(TAG, "Clock stepped by %lld ms", (long long)(offset_us / 1000));
+    } else {
+        double span_s = (double)(mono_us - s_last_sync_mono_us) / 1e6;
+        if (span_s >= MIN_DRIFT_SPAN_S) {
+            double residual_ppm = (double)offset_us / span_s;
+            s_drift_ppm += s_drift_valid ? residual_ppm / 2 : residual_ppm;
+            s_drift_valid = true;
+        }
+        slew_add_us(offset_us);
+
+        // Classic NTP poll adaptation: back off while the clock holds, tighten when it does not
+        int64_t target_us = (int64_t)NTP_TARGET_ACCURACY_MS * 1000;
+        if (!s_drift_valid) {
+            s_interval_s = NTP_MIN_INTERVAL_S;
+        } else if (llabs(offset_us) <= target_us / 2) {
+            s_interval_s *= 2;
+        } else if (llabs(offset_us) > target_us) {
+            s_interval_s /= 2;
+        }
+        if (s_interval_s < NTP_MIN_INTERVAL_S) {
+            s_interval_s = NTP_MIN_INTERVAL_S;
+        } else if (s_interval_s > NTP_MAX_INTERVAL_S) {
+            s_interval_s = NTP_MAX_INTERVAL_S;
+        }
+    }
+
+    s_clock_set = true;
+    s_last_sync_mono_us = mono_us;
+    // A first step can be decades; the status only needs to show it was large
+    s_last_offset_us = (int32_t)((offset_us > INT32_MAX) ? INT32_MAX
+                                 : (offset_us < INT32_MIN) ? INT32_MIN : offset_us);
+    s_syncs++;
+    timestamp_sync();
+
+    xSemaphoreGive(s_clock_lock);
+}
+
+/**
+ * @brief Sync loop: link up, one NTP exchange, link down, sleep until the next sync.
+ *
+ * @param pvParameters Unused
+ */
+static void ntp_discipline_task(void *pvParameters)
+{
+    (void) pvParameters;
+
+    while (true) {
+        bool got_reply = false;
+        int64_t link_start_us = esp_timer_get_time();
+
+        if (s_link_up() == ESP_OK) {
+            xEventGroupClearBits(s_events, SYNC_DONE_BIT);
+            esp_sntp_init();
+            EventBits_t bits = xEventGroupWaitBits(s_events, SYNC_DONE_BIT, pdFALSE, pdFALSE,
+                                                   pdMS_TO_TICKS(NTP_SYNC_TIMEOUT_MS));
+            esp_sntp_stop();
+            got_reply = (bits & SYNC_DONE_BIT) != 0;
+        }
+        if (s_link_down != NULL) {
+            s_link_down();
+        }
+        uint32_t link_ms = (uint32_t)((esp_timer_get_time() - link_start_us) / 1000);
+
+        uint32_t sleep_s = NTP_MIN_INTERVAL_S;
+        if (got_reply) {
+            apply_measurement(s_reply_offset_us, s_reply_mono_us);
+            xEventGroupSetBits(s_events, FIRST_SYNC_BIT);
+
+            ntp_discipline_status_t st;
+            ntp_discipline_get_status(&st);
+            sleep_s = st.interval_s;
+            ESP_LOGI(TAG, "Sync %lu: offset %+.3f ms, drift %+.2f ppm%s, link on %lu ms, next in %lu s",
+                     (unsigned long)st.syncs, st.last_offset_us / 1000.0, st.drift_ppm,
+                     st.drift_valid ? "" : " (measuring)", (unsigned long)link_ms,
+                     (unsigned long)sleep_s);
+        } else {
+            // Keep the learned interval; just try again soon
+            ESP_LOGW(TAG, "No NTP reply, retrying in %lu s", (unsigned long)sleep_s);
+        }
+
+        // Seconds times the tick rate stays within 32 bits even at the maximum interval
+        vTaskDelay((TickType_t)sleep_s * configTICK_RATE_HZ);
+    }
+}
+
+esp_err_t ntp_discipline_start(ntp_link_fn_t link_up, ntp_link_fn_t link_down)
+{
+    s_link_up = link_up;
+    s_link_down = link_down;
+
+    s_events = xEventGroupCreate();
+    s_clock_lock = xSemaphoreCreateMutex();
+    if (s_events == NULL || s_clock_lock == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    // One request per sync; the task stops the client after each reply
+    esp_sntp_setoperatingmode(SNTP_OPMODE_POLL);
+    esp_sntp_setservername(0, NTP_SERVER);
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = drift_timer_cb,
+        .name = "ntp_drift",
+    };
+    if (esp_timer_create(&timer_args, &s_drift_timer) != ESP_OK ||
+        esp_timer_start_periodic(s_drift_timer, (uint64_t)NTP_DRIFT_PERIOD_S * 1000000) != ESP_OK) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (xTaskCreate(ntp_discipline_task, "ntp_discipline", 3072, NULL, 5, NULL) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t ntp_discipline_wait_first_sync(uint32_t timeout_ms)
+{
+    EventBits_t bits = xEventGroupWaitBits(s_events, FIRST_SYNC_BIT, pdFALSE, pdFALSE,
+                                           pdMS_TO_TICKS(timeout_ms));
+    return (bits & FIRST_SYNC_BIT) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+void ntp_discipline_get_status(ntp_discipline_status_t *out)
+{
+    xSemaphoreTake(s_clock_lock, portMAX_DELAY);
+    out->syncs = s_syncs;
+    out->last_offset_us = s_last_offset_us;
+    out->drift_ppm = (float)s_drift_ppm;
+    out->drift_valid = s_drift_valid;
+    out->interval_s = s_interval_s;
+    xSemaphoreGive(s_clock_lock);
+}
+
+#endif // NTP_DISCIPLINE_ENABLE
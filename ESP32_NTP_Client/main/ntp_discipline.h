@@ -0,0 +1,77 @@
+/*
+ * @file ntp_discipline.h
+ * @brief Drift-compensating NTP client that only needs the network during a sync.
+ *
+ * @details
+ * The local oscillator drift is measured from the clock offset found at each
+ * sync. Between syncs a periodic timer slews the system clock by the estimated
+ * drift with `adjtime()`, so the clock stays close to true time while Wi-Fi is
+ * off. The sync interval doubles while the offsets stay within
+ * NTP_TARGET_ACCURACY_MS and halves when they do not.
+ */
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+// ---------- Mode ----------
+// 1: drift-disciplined client with the network up only during syncs.
+// 0: the continuous SNTP client in main.c (ESP-IDF sets the clock itself).
+#define NTP_DISCIPLINE_ENABLE       1
+
+// ---------- Tuning ----------
+#define NTP_SERVER                  "pool.ntp.org"
+#define NTP_MIN_INTERVAL_S          300         // first syncs, and after large errors
+#define NTP_MAX_INTERVAL_S          (12 * 3600) // once the drift is well known
+#define NTP_TARGET_ACCURACY_MS      5           // offset allowed at a sync before the interval shrinks
+#define NTP_STEP_THRESHOLD_MS       1000        // larger offsets are stepped, smaller ones slewed
+#define NTP_DRIFT_PERIOD_S          10          // how often the drift correction is applied
+#define NTP_SYNC_TIMEOUT_MS         15000       // wait for an NTP reply per attempt
+
+/**
+ * @brief Brings the network link up for a sync, or takes it down afterwards.
+ *
+ * @return ESP_OK when the link is ready (ignored for link-down).
+ */
+typedef esp_err_t (*ntp_link_fn_t)(void);
+
+/**
+ * @brief Snapshot of the discipline state, for logging.
+ */
+typedef struct {
+    uint32_t syncs;           // successful syncs
+    int32_t last_offset_us;   // server time minus local time at the last sync
+    float drift_ppm;          // estimated oscillator drift being corrected
+    bool drift_valid;         // a drift estimate exists
+    uint32_t interval_s;      // time until the next sync
+} ntp_discipline_status_t;
+
+/**
+ * @brief Start the sync task and the drift correction timer.
+ *
+ * @details
+ * The task calls `link_up`, queries the NTP server, calls `link_down`, and
+ * sleeps until the next sync. The first sync steps the clock; later ones slew it.
+ *
+ * @param link_up    Called before each sync; the sync is skipped on error.
+ * @param link_down  Called after each sync, successful or not. May be NULL.
+ * @return esp_err_t ESP_OK, or ESP_ERR_NO_MEM if the task or timer could not be created.
+ */
+esp_err_t ntp_discipline_start(ntp_link_fn_t link_up, ntp_link_fn_t link_down);
+
+/**
+ * @brief Block until the first successful sync set the clock.
+ *
+ * @param timeout_ms Maximum time to wait.
+ * @return esp_err_t ESP_OK, or ESP_ERR_TIMEOUT.
+ */
+esp_err_t ntp_discipline_wait_first_sync(uint32_t timeout_ms);
+
+/**
+ * @brief Copy the current discipline state.
+ *
+ * @param out Receives the state.
+ */
+void ntp_discipline_get_status(ntp_discipline_status_t *out);
@@ -11,12 +11,18 @@
  *   5) DMA-friendly bulk reads (bigger max_transfer_sz + DMA-capable buffers).
  *   6) Write/erase flow: Write Enable (0x06), Page Program (0x02), optional Sector Erase (0x20),
  *      and status polling with 0x05 (WIP bit).
+ *   7) Multi-line reads: Dual Output (0x3B), Quad Output (0x6B) and Quad I/O (0xEB) after
+ *      setting the Quad Enable (QE) bit, with a MB/s benchmark against 0x03 and 0x0B.
+ *   8) Asynchronous writes: a task programs queued pages, sleeps on an esp_timer between WIP
+ *      polls, erases ahead with 64KB Block Erase (0xD8), and reports through a callback.
  *
  * Wiring (example):
  *   - ESP32 GPIO23  -> W25Q32 MOSI (DI)
  *   - ESP32 GPIO19  -> W25Q32 MISO (DO)
  *   - ESP32 GPIO18  -> W25Q32 SCLK (CLK)
  *   - ESP32 GPIO5   -> W25Q32 CS   (CS#)
+ *   - ESP32 GPIO22  -> W25Q32 WP#  (IO2, quad modes only)
+ *   - ESP32 GPIO21  -> W25Q32 HOLD#(IO3, quad modes only)
  *   - 3.3V          -> VCC
  *   - GND           -> GND
  *
@@ -27,8 +33,8 @@
  * Notes:
  *   - Page size is typically 256 bytes; page program must not cross page boundaries.
  *   - Sector erase shown is 4KB (0x20). Use with caution; it will erase data.
- *   - For simplicity, this demo uses blocking transactions.
- *   - If you prefer higher throughput, consider queued transactions and reusing TX/RX buffers.
+ *   - Single reads and write/erase use blocking transactions; bulk reads and streams keep up to
+ *     FLASH_PIPELINE_DEPTH transactions queued so chunks transfer back to back.
  */
 
 #include "driver/spi_master.h"
@@ -39,16 +45,23 @@
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
 
 #include <string.h>   // memcpy, memset
 #include <stdlib.h>   // malloc, free
 #include <inttypes.h> // PRIu32, PRIx32
 
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+
 /* ---------- User Pin Mapping (adjust as needed) ---------- */
 #define PIN_NUM_MISO 19
 #define PIN_NUM_MOSI 23
 #define PIN_NUM_CLK  18
 #define PIN_NUM_CS    5
+#define PIN_NUM_WP   22   /* IO2 in quad modes; set to -1 if not wired */
+#define PIN_NUM_HD   21   /* IO3 in quad modes; set to -1 if not wired */
 
 /* ---------- Flash Command Opcodes ---------- */
 #define CMD_READ_ID        0x9F   /*!< JEDEC ID: Manufacturer, MemoryType, Capacity */
@@ -58,23 +71,157 @@
 #define CMD_FAST_READ      0x0B   /*!< Fast Read (requires dummy cycles) */
 #define CMD_PAGE_PROGRAM   0x02   /*!< Page Program (up to 256 bytes, no crossing page boundary) */
 #define CMD_SECTOR_ERASE   0x20   /*!< Sector Erase 4KB (optional; destructive) */
+#define CMD_BLOCK_ERASE_64K 0xD8  /*!< Block Erase 64KB (optional; destructive) */
+#define CMD_RDSR2          0x35   /*!< Read Status Register-2 (QE is bit1) */
+#define CMD_WRSR1          0x01   /*!< Write Status Register-1 (SR1, SR2 on older parts) */
+#define CMD_WRSR2          0x31   /*!< Write Status Register-2 */
+#define CMD_READ_DUAL_OUT  0x3B   /*!< Dual Output Read: 1-1-2, 8 dummy clocks */
+#define CMD_READ_QUAD_OUT  0x6B   /*!< Quad Output Read: 1-1-4, 8 dummy clocks */
+#define CMD_READ_QUAD_IO   0xEB   /*!< Quad I/O Read: 1-4-4, mode byte + 4 dummy clocks */
+#define CMD_READ_SFDP      0x5A   /*!< Read SFDP: 24-bit address, 8 dummy clocks */
 
 /* ---------- Device Characteristics (common for W25Qxx) ---------- */
 #define FLASH_PAGE_SIZE        256U
 #define FLASH_SECTOR_SIZE      4096U
+#define FLASH_BLOCK_SIZE       65536U
 #define FAST_READ_DUMMY_BITS   8      /* 8 dummy bits (1 dummy byte) for 0x0B on many chips */
+#define SR2_QE                 0x02   /* Quad Enable: WP#/HOLD# become IO2/IO3 */
+#define SR1_QE                 0x40   /* Quad Enable on parts with QE in SR1 (SFDP QER 2) */
+#define QUAD_IO_MODE_BITS      0xFF   /* M7-0 after the address; not 0xAx, so no continuous read */
+#define FLASH_PIPELINE_DEPTH   3      /* Read transactions queued at once (<= queue_size) */
+#define FLASH_WRITE_QUEUE_PAGES 8     /* Pages buffered between producer and write engine */
+#define FLASH_CACHE_DEFAULT_LINES 8   /* 4KB read cache lines (32KB, in PSRAM when present) */
+
+/* ---------- SFDP (JESD216) ---------- */
+#define SFDP_SIGNATURE         0x50444653U  /* "SFDP", little-endian */
+#define SFDP_BFPT_ID           0xFF00       /* Basic Flash Parameter Table */
+#define SFDP_BFPT_MAX_DWORDS   16           /* DW1..DW16 cover everything used here */
+#define SFDP_QER_UNKNOWN       0xFF         /* No DW15: fall back to the SR2 probing in enable_quad */
+
+/* ---------- Clock Tuning ---------- */
+#define FLASH_CLOCK_INIT_HZ    (8 * 1000 * 1000)    /* Safe clock for ID/SFDP/reference reads */
+#define FLASH_CLOCK_MAX_HZ     (80 * 1000 * 1000)   /* ESP32 SPI master ceiling on IO_MUX pins */
+#define FLASH_TUNE_LEN         4096U                /* Bytes compared per mode per step */
+#define FLASH_TUNE_PASSES      3                    /* Clean passes required to accept a step */
+
+/* ---------- Read Modes ---------- */
+
+/**
+ * @brief Read commands selectable for bulk reads, slowest first.
+ */
+typedef enum {
+    FLASH_READ_SLOW = 0,    /*!< 0x03, 1-1-1 */
+    FLASH_READ_FAST,        /*!< 0x0B, 1-1-1 + dummy */
+    FLASH_READ_DUAL_OUT,    /*!< 0x3B, 1-1-2 */
+    FLASH_READ_QUAD_OUT,    /*!< 0x6B, 1-1-4, needs QE */
+    FLASH_READ_QUAD_IO,     /*!< 0xEB, 1-4-4, needs QE */
+    FLASH_READ_MODE_COUNT,
+} flash_read_mode_t;
+
+/**
+ * @brief Wire format of one read command.
+ *
+ * dummy_bits is counted in SPI clock cycles, as the SPI master programs it.
+ * For 0xEB the mode bits are sent after the 24-bit address (address_bits - 24 of them,
+ * 8 on W25Q). The defaults match W25Q parts; spi_flash_probe_sfdp() overwrites the
+ * opcode, dummy/mode cycles and 'supported' from the chip's own parameter table.
+ */
+typedef struct {
+    const char *name;
+    uint8_t cmd;
+    uint8_t address_bits;
+    uint8_t dummy_bits;
+    uint32_t flags;
+    bool needs_quad;
+    bool supported;
+} flash_read_op_t;
+
+static flash_read_op_t s_read_ops[FLASH_READ_MODE_COUNT] = {
+    [FLASH_READ_SLOW]     = { "Slow 0x03",     CMD_READ_DATA,     24, 0,                    0,                                           false, true },
+    [FLASH_READ_FAST]     = { "Fast 0x0B",     CMD_FAST_READ,     24, FAST_READ_DUMMY_BITS, 0,                                           false, true },
+    [FLASH_READ_DUAL_OUT] = { "Dual Out 0x3B", CMD_READ_DUAL_OUT, 24, 8,                    SPI_TRANS_MODE_DIO,                          false, true },
+    [FLASH_READ_QUAD_OUT] = { "Quad Out 0x6B", CMD_READ_QUAD_OUT, 24, 8,                    SPI_TRANS_MODE_QIO,                          true,  true },
+    [FLASH_READ_QUAD_IO]  = { "Quad I/O 0xEB", CMD_READ_QUAD_IO,  32, 4,                    SPI_TRANS_MODE_QIO | SPI_TRANS_MULTILINE_ADDR, true,  true },
+};
 
 /* ---------- Logging ---------- */
 static const char *TAG = "SPI_Flash";
 
+/**
+ * @brief Consumer for spi_flash_read_stream(); 'data' is valid only during the call.
+ */
+typedef esp_err_t (*flash_chunk_consumer_t)(void *ctx, uint32_t address, const uint8_t *data, size_t len);
+
+/**
+ * @brief Completion callback for the asynchronous write engine; runs in the engine task.
+ */
+typedef void (*flash_write_done_cb_t)(void *ctx, esp_err_t result, size_t bytes_written);
+
 /* ---------- SPI Device Handle ---------- */
 static spi_device_handle_t g_spi = NULL;
 
+/* ---------- Quad Mode State ---------- */
+static bool g_quad_ready = false;   /* QE set and IO2/IO3 wired */
+
+/* ---------- Discovered Device Parameters ---------- */
+
+/**
+ * @brief Geometry and commands of the attached part; W25Q defaults until SFDP is read.
+ */
+typedef struct {
+    bool from_sfdp;           /*!< Filled from the chip's BFPT */
+    uint32_t size_bytes;      /*!< 0 if unknown */
+    uint8_t erase_4k_cmd;     /*!< 0 if the part has no 4KB erase */
+    uint8_t erase_64k_cmd;    /*!< 0 if the part has no 64KB erase */
+    uint8_t qe_type;          /*!< BFPT DW15 Quad Enable Requirements, or SFDP_QER_UNKNOWN */
+    int clock_hz;             /*!< Current SPI clock */
+} flash_params_t;
+
+static flash_params_t g_flash = {
+    .erase_4k_cmd  = CMD_SECTOR_ERASE,
+    .erase_64k_cmd = CMD_BLOCK_ERASE_64K,
+    .qe_type       = SFDP_QER_UNKNOWN,
+};
+
+/**
+ * @brief Add (or re-add) the flash device on SPI3_HOST at 'clock_hz'.
+ *
+ * The SPI master fixes the clock per device handle, so changing it means removing
+ * and re-adding the device. Only call while no transactions are queued.
+ *
+ * @param clock_hz  SPI clock in Hz.
+ *
+ * @retval ESP_OK on success; g_spi is valid.
+ * @retval esp_err_t from spi_bus_add_device() (g_spi is NULL).
+ */
+static esp_err_t spi_flash_add_device(int clock_hz)
+{
+    if (g_spi) {
+        ESP_RETURN_ON_ERROR(spi_bus_remove_device(g_spi), TAG, "remove device failed");
+        g_spi = NULL;
+    }
+
+    spi_device_interface_config_t devcfg = {
+        .clock_speed_hz = clock_hz,
+        .mode = 0,                         // Mode 0 (CPOL=0, CPHA=0)
+        .spics_io_num = PIN_NUM_CS,        // CS pin
+        .queue_size = 4,                   // >= FLASH_PIPELINE_DEPTH
+        // Half-duplex is required for the dual/quad read modes (cmd+addr then read).
+        .flags = SPI_DEVICE_HALFDUPLEX,
+        .command_bits = 0,   // use per-transaction sizes
+        .address_bits = 0,   // use per-transaction sizes
+    };
+
+    ESP_RETURN_ON_ERROR(spi_bus_add_device(SPI3_HOST, &devcfg, &g_spi), TAG, "add device failed");
+    g_flash.clock_hz = clock_hz;
+    return ESP_OK;
+}
+
 /**
  * @brief Initialize the SPI bus and add the external flash device.
  *
  * Sets up SPI3_HOST (VSPI equivalent in ESP-IDF v5.x) with a larger max_transfer_sz
- * to support DMA-friendly bulk transfers. Adds the flash device at a modest clock.
+ * to support DMA-friendly bulk transfers. Adds the flash device at FLASH_CLOCK_INIT_HZ.
  * This configuration is suitable for common SPI flash parts (e.g., W25Q32 family).
  *
  * @note On ESP-IDF v4.x, replace SPI3_HOST with VSPI_HOST.
@@ -88,25 +235,15 @@ static void spi_flash_init(void)
         .miso_io_num = PIN_NUM_MISO,
         .mosi_io_num = PIN_NUM_MOSI,
         .sclk_io_num = PIN_NUM_CLK,
-        .quadwp_io_num = -1,
-        .quadhd_io_num = -1,
+        .quadwp_io_num = PIN_NUM_WP,    // IO2 for 0x6B/0xEB
+        .quadhd_io_num = PIN_NUM_HD,    // IO3 for 0x6B/0xEB
         .max_transfer_sz = 32 * 1024,   // Larger for DMA-friendly bulk reads
     };
 
     ESP_ERROR_CHECK(spi_bus_initialize(SPI3_HOST, &buscfg, SPI_DMA_CH_AUTO));
 
-    spi_device_interface_config_t devcfg = {
-        .clock_speed_hz = 8 * 1000 * 1000, // 8 MHz (raise once stable)
-        .mode = 0,                         // Mode 0 (CPOL=0, CPHA=0)
-        .spics_io_num = PIN_NUM_CS,        // CS pin
-        .queue_size = 4,
-        // Fast read is half-duplex (cmd+addr then read). This flag can help, but is optional.
-        .flags = SPI_DEVICE_HALFDUPLEX,
-        .command_bits = 0,   // use per-transaction sizes
-        .address_bits = 0,   // use per-transaction sizes
-    };
-
-    ESP_ERROR_CHECK(spi_bus_add_device(SPI3_HOST, &devcfg, &g_spi));
+    // Start slow; spi_flash_autotune_clock() raises it once the part is known
+    ESP_ERROR_CHECK(spi_flash_add_device(FLASH_CLOCK_INIT_HZ));
     ESP_LOGI(TAG, "SPI Flash device initialized on SPI3_HOST (VSPI).");
 }
 
@@ -220,44 +357,460 @@ static esp_err_t spi_flash_read_fast(uint32_t address, uint8_t *data, size_t len
 }
 
 /**
- * @brief DMA-friendly bulk read loop using fast read (0x0B) and large transfers.
+ * @brief Fastest read mode the attached part supports and the board can use now.
+ *
+ * @return flash_read_mode_t Highest usable entry of s_read_ops.
+ */
+static flash_read_mode_t spi_flash_best_read_mode(void)
+{
+    for (int m = FLASH_READ_MODE_COUNT - 1; m > FLASH_READ_FAST; --m) {
+        const flash_read_op_t *op = &s_read_ops[m];
+        if (op->supported && (!op->needs_quad || g_quad_ready)) return (flash_read_mode_t)m;
+    }
+    return FLASH_READ_FAST;
+}
+
+/**
+ * @brief Fill a read transaction for any of the supported read commands.
+ *
+ * The command, address width, dummy cycles and line mode come from s_read_ops.
+ * 0x3B/0x6B send command and address on one line and return data on 2/4 lines;
+ * 0xEB also sends the address and mode bits on 4 lines.
+ *
+ * @param t        Transaction to fill (must stay valid until the transfer completes).
+ * @param address  24-bit start address in flash.
+ * @param data     Output buffer (must be non-NULL; DMA-capable for large reads).
+ * @param length   Number of bytes to read (must be > 0).
+ * @param mode     Read command to use.
+ *
+ * @retval ESP_OK on success; t ready to transmit or queue.
+ * @retval ESP_ERR_INVALID_ARG on bad args.
+ * @retval ESP_ERR_INVALID_STATE if a quad mode is requested before QE is set.
+ * @retval ESP_ERR_NOT_SUPPORTED if the part's SFDP does not list the mode.
+ */
+static esp_err_t spi_flash_build_read(spi_transaction_ext_t *t, uint32_t address, uint8_t *data, size_t length,
+                                      flash_read_mode_t mode)
+{
+    if (!t || !data || length == 0 || mode >= FLASH_READ_MODE_COUNT) return ESP_ERR_INVALID_ARG;
+
+    const flash_read_op_t *op = &s_read_ops[mode];
+    if (!op->supported) return ESP_ERR_NOT_SUPPORTED;
+    if (op->needs_quad && !g_quad_ready) return ESP_ERR_INVALID_STATE;
+
+    memset(t, 0, sizeof(*t));
+
+    t->base.flags     = SPI_TRANS_VARIABLE_CMD | SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_DUMMY | op->flags;
+    t->base.length    = 8 * length;
+    t->base.rxlength  = 8 * length;
+    t->base.rx_buffer = data;
+
+    t->command_bits = 8;
+    t->address_bits = op->address_bits;
+    t->dummy_bits   = op->dummy_bits;
+
+    t->base.cmd  = op->cmd;
+    t->base.addr = address & 0x00FFFFFFu;
+    if (op->address_bits > 24) {
+        // 0xEB: address followed by the mode bits, all on IO0-IO3
+        const unsigned mode_bits = op->address_bits - 24;
+        t->base.addr = (t->base.addr << mode_bits) | (QUAD_IO_MODE_BITS & ((1u << mode_bits) - 1));
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Read 'length' bytes with any of the supported read commands.
+ *
+ * Blocking single transaction; see spi_flash_build_read() for the wire format.
+ *
+ * @param address  24-bit start address in flash.
+ * @param data     Output buffer (must be non-NULL; DMA-capable for large reads).
+ * @param length   Number of bytes to read (must be > 0).
+ * @param mode     Read command to use.
+ *
+ * @retval ESP_OK on success; data filled.
+ * @retval ESP_ERR_INVALID_ARG on bad args.
+ * @retval ESP_ERR_INVALID_STATE if a quad mode is requested before QE is set.
+ * @retval esp_err_t underlying SPI error.
+ */
+static esp_err_t spi_flash_read_mode(uint32_t address, uint8_t *data, size_t length, flash_read_mode_t mode)
+{
+    spi_transaction_ext_t t;
+    ESP_RETURN_ON_ERROR(spi_flash_build_read(&t, address, data, length, mode), TAG, "bad read args");
+    return spi_device_transmit(g_spi, &t.base);
+}
+
+/**
+ * @brief Collect results for transactions still queued on the device.
+ *
+ * Queued transactions must be retrieved before their buffers are reused or freed,
+ * including on error paths.
+ *
+ * @param in_flight  Number of transactions queued and not yet retrieved.
+ *
+ * @return void
+ */
+static void spi_flash_drain(int in_flight)
+{
+    spi_transaction_t *done = NULL;
+    while (in_flight-- > 0) {
+        spi_device_get_trans_result(g_spi, &done, portMAX_DELAY);
+    }
+}
+
+/**
+ * @brief DMA bulk read with up to FLASH_PIPELINE_DEPTH transactions queued at once.
  *
- * Splits the read into chunks that fit into the device's configured max_transfer_sz.
- * Allocates DMA-capable buffers (if needed) and reads directly into 'out' using
- * fast read with dummy cycles. Uses blocking transactions in a loop for simplicity.
+ * Splits the read into chunks that fit into the device's configured max_transfer_sz
+ * and queues them with spi_device_queue_trans(), each reading straight into its slice
+ * of 'out'. The driver starts the next queued chunk from the ISR as soon as one ends,
+ * so there is no task round trip between chunks.
  *
  * @param address    Start address.
- * @param out        Output buffer (must be non-NULL).
+ * @param out        Output buffer (must be non-NULL and DMA-capable).
  * @param length     Total number of bytes to read.
  * @param chunk_max  Max payload per transaction (<= device/bus limit).
+ * @param mode       Read command; FLASH_READ_QUAD_IO is fastest once QE is set.
  *
  * @retval ESP_OK on full success.
  * @retval esp_err_t on first failure encountered.
  */
-static esp_err_t spi_flash_read_bulk_dma(uint32_t address, uint8_t *out, size_t length, size_t chunk_max)
+static esp_err_t spi_flash_read_bulk_dma(uint32_t address, uint8_t *out, size_t length, size_t chunk_max,
+                                         flash_read_mode_t mode)
 {
     if (!out || length == 0) return ESP_ERR_INVALID_ARG;
 
     // Guard chunk size (leave room if you switch to TX/RX buffers)
     if (chunk_max == 0) chunk_max = 16 * 1024;
 
-    size_t remaining = length;
-    uint32_t curr = address;
-    uint8_t *dst = out;
+    spi_transaction_ext_t trans[FLASH_PIPELINE_DEPTH];
+    size_t queued = 0;     // bytes handed to the driver
+    size_t completed = 0;  // bytes finished
+    int in_flight = 0;
+    int slot = 0;
+
+    while (completed < length) {
+        // Keep the queue full
+        while (in_flight < FLASH_PIPELINE_DEPTH && queued < length) {
+            size_t this_len = (length - queued) > chunk_max ? chunk_max : (length - queued);
+
+            esp_err_t err = spi_flash_build_read(&trans[slot], address + queued, out + queued, this_len, mode);
+            if (err == ESP_OK) err = spi_device_queue_trans(g_spi, &trans[slot].base, portMAX_DELAY);
+            if (err != ESP_OK) {
+                spi_flash_drain(in_flight);
+                return err;
+            }
+
+            queued += this_len;
+            slot = (slot + 1) % FLASH_PIPELINE_DEPTH;
+            in_flight++;
+        }
+
+        // Retire the oldest chunk
+        spi_transaction_t *done = NULL;
+        esp_err_t err = spi_device_get_trans_result(g_spi, &done, portMAX_DELAY);
+        if (err != ESP_OK) {
+            spi_flash_drain(in_flight - 1);
+            return err;
+        }
+        completed += done->rxlength / 8;
+        in_flight--;
+    }
+    return ESP_OK;
+}
 
-    while (remaining > 0) {
-        size_t this_len = remaining > chunk_max ? chunk_max : remaining;
+/**
+ * @brief Stream a region through a consumer callback with rotating DMA buffers.
+ *
+ * Allocates FLASH_PIPELINE_DEPTH DMA-capable chunk buffers and keeps all but the one
+ * being consumed queued on the bus: while 'consumer' processes chunk N, chunks N+1
+ * and N+2 are already transferring. Chunks are delivered in address order.
+ *
+ * @param address    Start address.
+ * @param length     Total number of bytes to read.
+ * @param chunk_len  Bytes per chunk (<= max_transfer_sz).
+ * @param mode       Read command to use.
+ * @param consumer   Called once per chunk; returning anything but ESP_OK stops the stream.
+ * @param ctx        Passed through to 'consumer'.
+ *
+ * @retval ESP_OK when every chunk was consumed.
+ * @retval ESP_ERR_INVALID_ARG on bad args.
+ * @retval ESP_ERR_NO_MEM if buffer allocation failed.
+ * @retval esp_err_t SPI error or the consumer's error.
+ */
+static esp_err_t spi_flash_read_stream(uint32_t address, size_t length, size_t chunk_len, flash_read_mode_t mode,
+                                       flash_chunk_consumer_t consumer, void *ctx)
+{
+    if (!consumer || length == 0 || chunk_len == 0) return ESP_ERR_INVALID_ARG;
 
-        esp_err_t err = spi_flash_read_fast(curr, dst, this_len, FAST_READ_DUMMY_BITS);
-        if (err != ESP_OK) return err;
+    uint8_t *bufs[FLASH_PIPELINE_DEPTH] = {0};
+    spi_transaction_ext_t trans[FLASH_PIPELINE_DEPTH];
+    esp_err_t err = ESP_OK;
+
+    for (int i = 0; i < FLASH_PIPELINE_DEPTH; ++i) {
+        bufs[i] = (uint8_t *)heap_caps_malloc(chunk_len, MALLOC_CAP_DMA);
+        if (!bufs[i]) err = ESP_ERR_NO_MEM;
+    }
+
+    size_t queued = 0;     // bytes handed to the driver
+    size_t consumed = 0;   // bytes delivered to the consumer
+    int in_flight = 0;
+    int slot = 0;
+
+    while (err == ESP_OK && consumed < length) {
+        // Refill every free buffer before waiting
+        while (in_flight < FLASH_PIPELINE_DEPTH && queued < length) {
+            size_t this_len = (length - queued) > chunk_len ? chunk_len : (length - queued);
+
+            err = spi_flash_build_read(&trans[slot], address + queued, bufs[slot], this_len, mode);
+            if (err == ESP_OK) err = spi_device_queue_trans(g_spi, &trans[slot].base, portMAX_DELAY);
+            if (err != ESP_OK) break;
+
+            queued += this_len;
+            slot = (slot + 1) % FLASH_PIPELINE_DEPTH;
+            in_flight++;
+        }
+        if (err != ESP_OK) break;
+
+        // Hand the oldest finished chunk to the consumer while the rest transfer
+        spi_transaction_t *done = NULL;
+        err = spi_device_get_trans_result(g_spi, &done, portMAX_DELAY);
+        if (err != ESP_OK) break;
+        in_flight--;
+
+        const size_t done_len = done->rxlength / 8;
+        err = consumer(ctx, address + consumed, (const uint8_t *)done->rx_buffer, done_len);
+        consumed += done_len;
+    }
+
+    spi_flash_drain(in_flight);
+    for (int i = 0; i < FLASH_PIPELINE_DEPTH; ++i) free(bufs[i]);
+    return err;
+}
+
+/* ---------- Sector Read Cache ---------- */
+
+/**
+ * @brief Read cache counters.
+ */
+typedef struct {
+    uint32_t hits;            /*!< Sector lookups served from RAM */
+    uint32_t misses;          /*!< Sector lookups that read flash */
+    uint32_t readaheads;      /*!< Next-sector fills after a sequential miss */
+    uint32_t evictions;       /*!< Valid lines replaced */
+    uint32_t invalidations;   /*!< Lines dropped by program/erase */
+} flash_cache_stats_t;
+
+/**
+ * @brief One cached sector.
+ */
+typedef struct {
+    bool valid;
+    uint32_t sector;          /*!< address / FLASH_SECTOR_SIZE */
+    uint32_t last_used;       /*!< LRU stamp */
+    uint8_t *data;            /*!< FLASH_SECTOR_SIZE bytes */
+} flash_cache_line_t;
+
+static struct {
+    flash_cache_line_t *lines;
+    size_t line_count;
+    uint8_t *storage;         /*!< line_count * FLASH_SECTOR_SIZE, PSRAM when available */
+    uint8_t *bounce;          /*!< DMA-capable fill buffer (PSRAM is not a DMA target on ESP32) */
+    SemaphoreHandle_t lock;
+    uint32_t clock;
+    uint32_t last_miss;       /*!< Sector of the previous miss, for readahead */
+    flash_cache_stats_t stats;
+} g_cache;
+
+/**
+ * @brief Allocate the read cache: 'lines' sector-sized lines, preferring PSRAM.
+ *
+ * @param lines  Number of 4KB lines (e.g. FLASH_CACHE_DEFAULT_LINES).
+ *
+ * @retval ESP_OK on success.
+ * @retval ESP_ERR_INVALID_ARG if lines is 0.
+ * @retval ESP_ERR_INVALID_STATE if already initialized.
+ * @retval ESP_ERR_NO_MEM if allocation failed.
+ */
+static esp_err_t flash_cache_init(size_t lines)
+{
+    if (lines == 0) return ESP_ERR_INVALID_ARG;
+    if (g_cache.lines) return ESP_ERR_INVALID_STATE;
+
+    g_cache.storage = (uint8_t *)heap_caps_malloc(lines * FLASH_SECTOR_SIZE, MALLOC_CAP_SPIRAM);
+    if (!g_cache.storage) {
+        ESP_LOGW(TAG, "No PSRAM for read cache, using internal RAM");
+        g_cache.storage = (uint8_t *)heap_caps_malloc(lines * FLASH_SECTOR_SIZE, MALLOC_CAP_8BIT);
+    }
+    g_cache.lines  = (flash_cache_line_t *)calloc(lines, sizeof(flash_cache_line_t));
+    g_cache.bounce = (uint8_t *)heap_caps_malloc(FLASH_SECTOR_SIZE, MALLOC_CAP_DMA);
+    g_cache.lock   = xSemaphoreCreateMutex();
+    if (!g_cache.storage || !g_cache.lines || !g_cache.bounce || !g_cache.lock) {
+        free(g_cache.storage); free(g_cache.lines); free(g_cache.bounce);
+        if (g_cache.lock) vSemaphoreDelete(g_cache.lock);
+        memset(&g_cache, 0, sizeof(g_cache));
+        return ESP_ERR_NO_MEM;
+    }
+
+    for (size_t i = 0; i < lines; ++i) g_cache.lines[i].data = g_cache.storage + i * FLASH_SECTOR_SIZE;
+    g_cache.line_count = lines;
+    g_cache.last_miss = UINT32_MAX;
+    ESP_LOGI(TAG, "Read cache: %u x %u-byte lines", (unsigned)lines, (unsigned)FLASH_SECTOR_SIZE);
+    return ESP_OK;
+}
+
+/**
+ * @brief Find a sector's line, or NULL; caller holds the lock.
+ *
+ * @param sector  Sector index.
+ *
+ * @return flash_cache_line_t* Line holding the sector, or NULL.
+ */
+static flash_cache_line_t *flash_cache_lookup(uint32_t sector)
+{
+    for (size_t i = 0; i < g_cache.line_count; ++i) {
+        if (g_cache.lines[i].valid && g_cache.lines[i].sector == sector) return &g_cache.lines[i];
+    }
+    return NULL;
+}
 
-        curr += this_len;
-        dst  += this_len;
-        remaining -= this_len;
+/**
+ * @brief Load a sector into a free or least recently used line; caller holds the lock.
+ *
+ * @param sector  Sector index.
+ * @param line    Out: the filled line.
+ *
+ * @retval ESP_OK on success.
+ * @retval esp_err_t on SPI error (the victim line is left invalid).
+ */
+static esp_err_t flash_cache_fill(uint32_t sector, flash_cache_line_t **line)
+{
+    flash_cache_line_t *victim = &g_cache.lines[0];
+    for (size_t i = 0; i < g_cache.line_count; ++i) {
+        flash_cache_line_t *l = &g_cache.lines[i];
+        if (!l->valid) { victim = l; break; }
+        if (l->last_used < victim->last_used) victim = l;
     }
+    if (victim->valid) g_cache.stats.evictions++;
+    victim->valid = false;
+
+    // Fastest mode available; fill through the DMA bounce buffer
+    const flash_read_mode_t mode = spi_flash_best_read_mode();
+    ESP_RETURN_ON_ERROR(spi_flash_read_bulk_dma(sector * FLASH_SECTOR_SIZE, g_cache.bounce, FLASH_SECTOR_SIZE,
+                                                FLASH_SECTOR_SIZE, mode), TAG, "cache fill failed");
+    memcpy(victim->data, g_cache.bounce, FLASH_SECTOR_SIZE);
+
+    victim->sector = sector;
+    victim->valid = true;
+    victim->last_used = ++g_cache.clock;
+    *line = victim;
     return ESP_OK;
 }
 
+/**
+ * @brief Read through the cache; any range, split on sector boundaries.
+ *
+ * A miss loads the whole sector. A miss on the sector right after the previous miss
+ * also loads the following sector, so sequential scans stay one sector ahead.
+ *
+ * @param address  Start address.
+ * @param data     Output buffer (any memory).
+ * @param length   Number of bytes to read.
+ *
+ * @retval ESP_OK on success.
+ * @retval ESP_ERR_INVALID_ARG on bad args.
+ * @retval ESP_ERR_INVALID_STATE if the cache is not initialized.
+ * @retval esp_err_t on SPI error.
+ */
+static esp_err_t flash_cache_read(uint32_t address, uint8_t *data, size_t length)
+{
+    if (!data || length == 0) return ESP_ERR_INVALID_ARG;
+    if (!g_cache.lines) return ESP_ERR_INVALID_STATE;
+
+    esp_err_t err = ESP_OK;
+    xSemaphoreTake(g_cache.lock, portMAX_DELAY);
+
+    while (length > 0 && err == ESP_OK) {
+        const uint32_t sector = address / FLASH_SECTOR_SIZE;
+        const uint32_t off = address % FLASH_SECTOR_SIZE;
+        const size_t n = (FLASH_SECTOR_SIZE - off) < length ? (FLASH_SECTOR_SIZE - off) : length;
+
+        flash_cache_line_t *line = flash_cache_lookup(sector);
+        if (line) {
+            g_cache.stats.hits++;
+            line->last_used = ++g_cache.clock;
+        } else {
+            g_cache.stats.misses++;
+            err = flash_cache_fill(sector, &line);
+            if (err != ESP_OK) break;
+
+            // Sequential access: prefetch the next sector too
+            if (sector == g_cache.last_miss + 1 && g_cache.line_count > 1 && !flash_cache_lookup(sector + 1)) {
+                flash_cache_line_t *ahead = NULL;
+                line->last_used = ++g_cache.clock;      // keep 'line' from being the victim
+                if (flash_cache_fill(sector + 1, &ahead) == ESP_OK) g_cache.stats.readaheads++;
+                line->last_used = ++g_cache.clock;
+            }
+            g_cache.last_miss = sector;
+        }
+
+        memcpy(data, line->data + off, n);
+        address += n;
+        data    += n;
+        length  -= n;
+    }
+
+    xSemaphoreGive(g_cache.lock);
+    return err;
+}
+
+/**
+ * @brief Drop cached sectors overlapping [address, address + length).
+ *
+ * Called from the program/erase paths so the cache never returns stale data.
+ *
+ * @param address  Start of the modified range.
+ * @param length   Length of the modified range.
+ *
+ * @return void
+ */
+static void flash_cache_invalidate(uint32_t address, size_t length)
+{
+    if (!g_cache.lines || length == 0) return;
+
+    const uint32_t first = address / FLASH_SECTOR_SIZE;
+    const uint32_t last = (address + length - 1) / FLASH_SECTOR_SIZE;
+
+    xSemaphoreTake(g_cache.lock, portMAX_DELAY);
+    for (size_t i = 0; i < g_cache.line_count; ++i) {
+        flash_cache_line_t *l = &g_cache.lines[i];
+        if (l->valid && l->sector >= first && l->sector <= last) {
+            l->valid = false;
+            g_cache.stats.invalidations++;
+        }
+    }
+    xSemaphoreGive(g_cache.lock);
+}
+
+/**
+ * @brief Copy the cache counters.
+ *
+ * @param stats  Out: counters since init.
+ *
+ * @return void
+ */
+static void flash_cache_get_stats(flash_cache_stats_t *stats)
+{
+    if (!stats) return;
+    memset(stats, 0, sizeof(*stats));
+    if (!g_cache.lines) return;
+
+    xSemaphoreTake(g_cache.lock, portMAX_DELAY);
+    *stats = g_cache.stats;
+    xSemaphoreGive(g_cache.lock);
+}
+
 /**
  * @brief Issue Write Enable (0x06) to set the WEL bit before program/erase.
  *
@@ -327,24 +880,24 @@ static esp_err_t spi_flash_wait_ready(uint32_t timeout_ms)
 }
 
 /**
- * @brief Page Program (0x02) up to 256 bytes at 'address' (must not cross page boundary).
+ * @brief Send WREN + Page Program (0x02) without waiting for the program to finish.
  *
- * Caller must ensure:
- *  - Length <= 256.
- *  - Address and length do not cross a 256-byte page boundary.
+ * Same constraints as spi_flash_page_program(). The caller owns 'tx' and must keep
+ * it until the transaction returns; it is reused so the write engine does not
+ * allocate per page.
  *
  * @param address  24-bit destination address.
  * @param data     Pointer to data to write.
  * @param length   Number of bytes to write (<= 256).
+ * @param tx       DMA-capable scratch of at least 4 + length bytes.
  *
- * @retval ESP_OK on success.
+ * @retval ESP_OK once the flash has accepted the page (WIP now set).
  * @retval ESP_ERR_INVALID_ARG for bad inputs.
- * @retval ESP_ERR_NO_MEM if allocation failed.
  * @retval esp_err_t underlying SPI error.
  */
-static esp_err_t spi_flash_page_program(uint32_t address, const uint8_t *data, size_t length)
+static esp_err_t spi_flash_issue_page_program(uint32_t address, const uint8_t *data, size_t length, uint8_t *tx)
 {
-    if (!data || length == 0 || length > FLASH_PAGE_SIZE) return ESP_ERR_INVALID_ARG;
+    if (!data || !tx || length == 0 || length > FLASH_PAGE_SIZE) return ESP_ERR_INVALID_ARG;
 
     // Check boundary
     uint32_t page_off = address & (FLASH_PAGE_SIZE - 1);
@@ -355,9 +908,6 @@ static esp_err_t spi_flash_page_program(uint32_t address, const uint8_t *data, s
     const size_t kHdr = 4; // 0x02 + 24-bit address
     size_t total = kHdr + length;
 
-    uint8_t *tx = (uint8_t *)heap_caps_malloc(total, MALLOC_CAP_DMA);
-    if (!tx) return ESP_ERR_NO_MEM;
-
     tx[0] = CMD_PAGE_PROGRAM;
     tx[1] = (address >> 16) & 0xFF;
     tx[2] = (address >> 8)  & 0xFF;
@@ -368,7 +918,35 @@ static esp_err_t spi_flash_page_program(uint32_t address, const uint8_t *data, s
     t.length    = 8 * total;
     t.tx_buffer = tx;
 
-    esp_err_t err = spi_device_transmit(g_spi, &t);
+    // Cached copy goes stale as soon as the flash starts programming
+    flash_cache_invalidate(address, length);
+    return spi_device_transmit(g_spi, &t);
+}
+
+/**
+ * @brief Page Program (0x02) up to 256 bytes at 'address' (must not cross page boundary).
+ *
+ * Caller must ensure:
+ *  - Length <= 256.
+ *  - Address and length do not cross a 256-byte page boundary.
+ *
+ * @param address  24-bit destination address.
+ * @param data     Pointer to data to write.
+ * @param length   Number of bytes to write (<= 256).
+ *
+ * @retval ESP_OK on success.
+ * @retval ESP_ERR_INVALID_ARG for bad inputs.
+ * @retval ESP_ERR_NO_MEM if allocation failed.
+ * @retval esp_err_t underlying SPI error.
+ */
+static esp_err_t spi_flash_page_program(uint32_t address, const uint8_t *data, size_t length)
+{
+    if (!data || length == 0 || length > FLASH_PAGE_SIZE) return ESP_ERR_INVALID_ARG;
+
+    uint8_t *tx = (uint8_t *)heap_caps_malloc(4 + length, MALLOC_CAP_DMA);
+    if (!tx) return ESP_ERR_NO_MEM;
+
+    esp_err_t err = spi_flash_issue_page_program(address, data, length, tx);
     free(tx);
     if (err != ESP_OK) return err;
 
@@ -413,19 +991,20 @@ static esp_err_t spi_flash_write_buffer(uint32_t address, const uint8_t *data, s
 }
 
 /**
- * @brief (Optional) Sector Erase 4KB (0x20) at 'address' (sector-aligned recommended).
+ * @brief Send WREN + an erase command without waiting for the erase to finish.
  *
- * @param address  Address within the sector to erase (commonly aligned to 4KB).
+ * @param cmd      g_flash.erase_4k_cmd or g_flash.erase_64k_cmd.
+ * @param address  Address within the sector/block to erase.
  *
- * @retval ESP_OK on success.
- * @retval esp_err_t on SPI or timeout errors.
+ * @retval ESP_OK once the flash has accepted the erase (WIP now set).
+ * @retval esp_err_t on SPI error.
  */
-static esp_err_t spi_flash_sector_erase(uint32_t address)
+static esp_err_t spi_flash_issue_erase(uint8_t cmd, uint32_t address)
 {
     ESP_RETURN_ON_ERROR(spi_flash_write_enable(), TAG, "WREN failed");
 
     uint8_t tx[4] = {
-        CMD_SECTOR_ERASE,
+        cmd,
         (uint8_t)((address >> 16) & 0xFF),
         (uint8_t)((address >> 8)  & 0xFF),
         (uint8_t)( address        & 0xFF),
@@ -435,23 +1014,998 @@ static esp_err_t spi_flash_sector_erase(uint32_t address)
     t.length    = 8 * sizeof(tx);
     t.tx_buffer = tx;
 
+    // Drop every cached sector the erase covers
+    const uint32_t size = (cmd == g_flash.erase_64k_cmd) ? FLASH_BLOCK_SIZE : FLASH_SECTOR_SIZE;
+    flash_cache_invalidate(address & ~(size - 1), size);
+
     ESP_RETURN_ON_ERROR(spi_device_transmit(g_spi, &t), TAG, "Erase tx failed");
+    return ESP_OK;
+}
+
+/**
+ * @brief (Optional) Sector Erase 4KB (0x20) at 'address' (sector-aligned recommended).
+ *
+ * @param address  Address within the sector to erase (commonly aligned to 4KB).
+ *
+ * @retval ESP_OK on success.
+ * @retval ESP_ERR_NOT_SUPPORTED if the part has no 4KB erase.
+ * @retval esp_err_t on SPI or timeout errors.
+ */
+static esp_err_t spi_flash_sector_erase(uint32_t address)
+{
+    if (g_flash.erase_4k_cmd == 0) return ESP_ERR_NOT_SUPPORTED;
+    ESP_RETURN_ON_ERROR(spi_flash_issue_erase(g_flash.erase_4k_cmd, address), TAG, "Sector erase failed");
     return spi_flash_wait_ready(4000); // Sector erase can take milliseconds
 }
 
 /**
- * @brief Demo entry: init bus/device, read ID, slow read, fast read, DMA bulk read,
- *        (optional) erase+program+verify flow.
+ * @brief (Optional) Block Erase 64KB (0xD8) at 'address' (block-aligned recommended).
  *
- * @return void
+ * One 64KB erase takes roughly a third of the time of sixteen 4KB sector erases.
+ *
+ * @param address  Address within the block to erase (commonly aligned to 64KB).
+ *
+ * @retval ESP_OK on success.
+ * @retval ESP_ERR_NOT_SUPPORTED if the part has no 64KB erase.
+ * @retval esp_err_t on SPI or timeout errors.
  */
-void app_main(void)
+static esp_err_t spi_flash_block_erase_64k(uint32_t address)
 {
-    // Initialize SPI bus and add flash device to the bus
-    spi_flash_init();
+    if (g_flash.erase_64k_cmd == 0) return ESP_ERR_NOT_SUPPORTED;
+    ESP_RETURN_ON_ERROR(spi_flash_issue_erase(g_flash.erase_64k_cmd, address), TAG, "Block erase failed");
+    return spi_flash_wait_ready(4000); // 64KB erase is typically 150 ms, up to 2 s
+}
 
-    // --- JEDEC ID ---
-    spi_flash_read_id();
+/* ---------- Asynchronous Write Engine ---------- */
+
+/**
+ * @brief Message from producers to the write engine task.
+ */
+typedef struct {
+    enum { WRITE_MSG_BEGIN, WRITE_MSG_PAGE, WRITE_MSG_END } type;
+    uint32_t address;                 /*!< BEGIN: region start; PAGE: page address */
+    uint32_t length;                  /*!< BEGIN: region length; PAGE: bytes in data */
+    bool erase;                       /*!< BEGIN: erase the region ahead of programming */
+    flash_write_done_cb_t done_cb;    /*!< BEGIN: completion callback (may be NULL) */
+    void *ctx;                        /*!< BEGIN: callback argument */
+    uint8_t data[FLASH_PAGE_SIZE];    /*!< PAGE: payload */
+} flash_write_msg_t;
+
+/**
+ * @brief Write engine state; touched only by the engine task.
+ */
+typedef struct {
+    bool active;
+    bool erase;
+    uint32_t start;
+    uint32_t end;                     /*!< One past the last byte of the region */
+    uint32_t erased_end;              /*!< Everything below this (from start) is erased */
+    uint32_t written;
+    esp_err_t status;                 /*!< First error; later pages are skipped */
+    flash_write_done_cb_t done_cb;
+    void *ctx;
+} flash_write_job_t;
+
+static QueueHandle_t g_write_queue = NULL;
+static TaskHandle_t g_write_task = NULL;
+static esp_timer_handle_t g_poll_timer = NULL;
+static uint8_t *g_write_tx = NULL;            /* DMA scratch for page programs */
+static flash_write_msg_t g_write_stage;       /* Producer-side page being filled */
+
+/**
+ * @brief esp_timer callback: wake the engine task to poll WIP.
+ *
+ * @param arg  Engine task handle.
+ *
+ * @return void
+ */
+static void write_poll_timer_cb(void *arg)
+{
+    xTaskNotifyGive((TaskHandle_t)arg);
+}
+
+/**
+ * @brief Wait for WIP=0 by sleeping on a timer between Status Register-1 polls.
+ *
+ * The first poll is after 'first_us' (typical operation time), then every 'period_us'.
+ * The task is blocked in between, so the CPU is free while the flash works.
+ *
+ * @param first_us    Delay before the first poll.
+ * @param period_us   Delay between later polls.
+ * @param timeout_us  Give up after this long.
+ *
+ * @retval ESP_OK if ready within timeout.
+ * @retval ESP_ERR_TIMEOUT if still busy after timeout.
+ * @retval esp_err_t on SPI error.
+ */
+static esp_err_t write_engine_wait_idle(uint32_t first_us, uint32_t period_us, uint32_t timeout_us)
+{
+    const int64_t start = esp_timer_get_time();
+    uint32_t delay_us = first_us;
+
+    for (;;) {
+        ESP_RETURN_ON_ERROR(esp_timer_start_once(g_poll_timer, delay_us), TAG, "poll timer failed");
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        uint8_t sr1 = 0;
+        ESP_RETURN_ON_ERROR(spi_flash_read_status1(&sr1), TAG, "RDSR1 failed");
+        if ((sr1 & 0x01) == 0) return ESP_OK; // WIP == 0 => ready
+
+        if (esp_timer_get_time() - start > timeout_us) return ESP_ERR_TIMEOUT;
+        delay_us = period_us;
+    }
+}
+
+/**
+ * @brief Erase the next unit of the current job's region.
+ *
+ * Uses a 64KB block erase (0xD8) when the part has one and the next 64KB is aligned
+ * and entirely inside the region, otherwise a 4KB sector erase (0x20).
+ *
+ * @param job  Active job with erased_end < end.
+ *
+ * @retval ESP_OK on success.
+ * @retval esp_err_t on SPI or timeout errors.
+ */
+static esp_err_t write_engine_erase_next(flash_write_job_t *job)
+{
+    const uint32_t addr = job->erased_end;
+    const bool block = g_flash.erase_64k_cmd != 0 &&
+                       (addr % FLASH_BLOCK_SIZE) == 0 && (job->end - addr) >= FLASH_BLOCK_SIZE;
+
+    if (block) {
+        ESP_RETURN_ON_ERROR(spi_flash_issue_erase(g_flash.erase_64k_cmd, addr), TAG, "Block erase failed");
+        ESP_RETURN_ON_ERROR(write_engine_wait_idle(100000, 5000, 4000000), TAG, "Block erase wait failed");
+        job->erased_end += FLASH_BLOCK_SIZE;
+    } else {
+        ESP_RETURN_ON_ERROR(spi_flash_issue_erase(g_flash.erase_4k_cmd, addr), TAG, "Sector erase failed");
+        ESP_RETURN_ON_ERROR(write_engine_wait_idle(30000, 1000, 4000000), TAG, "Sector erase wait failed");
+        job->erased_end += FLASH_SECTOR_SIZE;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Write engine task: programs queued pages and erases ahead when idle.
+ *
+ * While a job with erase enabled has unerased space left and no page is waiting,
+ * the task erases the next sector/block instead of sleeping, so slow producers
+ * (network, decompression) find the region already erased when their data arrives.
+ *
+ * @param arg  Unused.
+ *
+ * @return void
+ */
+static void write_engine_task(void *arg)
+{
+    (void)arg;
+    flash_write_job_t job = {0};
+    static flash_write_msg_t msg;
+
+    for (;;) {
+        const bool can_erase_ahead = job.active && job.erase && job.status == ESP_OK && job.erased_end < job.end;
+        if (xQueueReceive(g_write_queue, &msg, can_erase_ahead ? 0 : portMAX_DELAY) != pdTRUE) {
+            job.status = write_engine_erase_next(&job);
+            continue;
+        }
+
+        switch (msg.type) {
+        case WRITE_MSG_BEGIN:
+            job = (flash_write_job_t){
+                .active     = true,
+                .erase      = msg.erase,
+                .start      = msg.address,
+                .end        = msg.address + msg.length,
+                .erased_end = msg.address & ~(FLASH_SECTOR_SIZE - 1),
+                .status     = ESP_OK,
+                .done_cb    = msg.done_cb,
+                .ctx        = msg.ctx,
+            };
+            break;
+
+        case WRITE_MSG_PAGE:
+            if (!job.active || job.status != ESP_OK) break;
+
+            // The page must land in erased flash
+            while (job.erase && job.status == ESP_OK && msg.address + msg.length > job.erased_end) {
+                job.status = write_engine_erase_next(&job);
+            }
+            if (job.status != ESP_OK) break;
+
+            job.status = spi_flash_issue_page_program(msg.address, msg.data, msg.length, g_write_tx);
+            if (job.status == ESP_OK) {
+                job.status = write_engine_wait_idle(400, 100, 300000); // tPP typ. 0.4-0.7 ms
+            }
+            if (job.status == ESP_OK) job.written += msg.length;
+            break;
+
+        case WRITE_MSG_END:
+            if (job.status != ESP_OK) {
+                ESP_LOGE(TAG, "Async write @0x%06" PRIx32 " failed after %" PRIu32 " bytes: %s",
+                         job.start, job.written, esp_err_to_name(job.status));
+            }
+            if (job.done_cb) job.done_cb(job.ctx, job.status, job.written);
+            job.active = false;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Start the asynchronous write engine (task, page queue, poll timer).
+ *
+ * @note While a job is running the engine owns g_spi; other tasks must wait for the
+ *       completion callback before issuing their own transactions.
+ *
+ * @retval ESP_OK on success or if already started.
+ * @retval ESP_ERR_NO_MEM if a resource could not be created.
+ */
+static esp_err_t flash_write_engine_start(void)
+{
+    if (g_write_task) return ESP_OK;
+
+    g_write_tx = (uint8_t *)heap_caps_malloc(4 + FLASH_PAGE_SIZE, MALLOC_CAP_DMA);
+    g_write_queue = xQueueCreate(FLASH_WRITE_QUEUE_PAGES, sizeof(flash_write_msg_t));
+    if (!g_write_tx || !g_write_queue) return ESP_ERR_NO_MEM;
+
+    if (xTaskCreate(write_engine_task, "flash_write", 4096, NULL, 5, &g_write_task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    const esp_timer_create_args_t targs = {
+        .callback = write_poll_timer_cb,
+        .arg = g_write_task,
+        .name = "flash_poll",
+    };
+    return esp_timer_create(&targs, &g_poll_timer);
+}
+
+/**
+ * @brief Begin an asynchronous write of 'length' bytes at 'address'.
+ *
+ * Follow with flash_write_append() calls totalling 'length' bytes and one
+ * flash_write_end(). Only one producer task may use these at a time.
+ *
+ * @param address  Start address.
+ * @param length   Total bytes that will be appended.
+ * @param erase    Erase the region first (whole 4KB sectors covering it; 64KB blocks
+ *                 where aligned), ahead of programming.
+ * @param done_cb  Called from the engine task when the job ends (may be NULL).
+ * @param ctx      Passed to done_cb.
+ *
+ * @retval ESP_OK on success.
+ * @retval ESP_ERR_INVALID_STATE if the engine is not started.
+ * @retval ESP_ERR_INVALID_ARG on bad args.
+ * @retval ESP_ERR_NOT_SUPPORTED if erase is requested and the part has no 4KB erase.
+ */
+static esp_err_t flash_write_begin(uint32_t address, size_t length, bool erase,
+                                   flash_write_done_cb_t done_cb, void *ctx)
+{
+    if (!g_write_queue) return ESP_ERR_INVALID_STATE;
+    if (length == 0) return ESP_ERR_INVALID_ARG;
+    if (erase && g_flash.erase_4k_cmd == 0) return ESP_ERR_NOT_SUPPORTED;
+
+    flash_write_msg_t *m = &g_write_stage;
+    m->type    = WRITE_MSG_BEGIN;
+    m->address = address;
+    m->length  = length;
+    m->erase   = erase;
+    m->done_cb = done_cb;
+    m->ctx     = ctx;
+    xQueueSend(g_write_queue, m, portMAX_DELAY);
+
+    // Stage the first page
+    m->type    = WRITE_MSG_PAGE;
+    m->length  = 0;
+    return ESP_OK;
+}
+
+/**
+ * @brief Append data to the write started by flash_write_begin().
+ *
+ * Copies into page messages; blocks (yielding) when FLASH_WRITE_QUEUE_PAGES pages are
+ * already waiting, so the caller's buffer can be reused as soon as this returns.
+ *
+ * @param data    Bytes to append.
+ * @param length  Number of bytes.
+ *
+ * @retval ESP_OK on success.
+ * @retval ESP_ERR_INVALID_STATE if the engine is not started.
+ * @retval ESP_ERR_INVALID_ARG on bad args.
+ */
+static esp_err_t flash_write_append(const uint8_t *data, size_t length)
+{
+    if (!g_write_queue) return ESP_ERR_INVALID_STATE;
+    if (!data && length > 0) return ESP_ERR_INVALID_ARG;
+
+    flash_write_msg_t *m = &g_write_stage;
+    while (length > 0) {
+        // Room left in the page starting at m->address
+        size_t room = FLASH_PAGE_SIZE - ((m->address + m->length) & (FLASH_PAGE_SIZE - 1));
+        size_t n = length < room ? length : room;
+
+        memcpy(m->data + m->length, data, n);
+        m->length += n;
+        data += n;
+        length -= n;
+
+        // Page boundary reached: hand it to the engine
+        if (n == room) {
+            xQueueSend(g_write_queue, m, portMAX_DELAY);
+            m->address += m->length;
+            m->length = 0;
+        }
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Finish the write; done_cb runs once every queued page is programmed.
+ *
+ * @retval ESP_OK on success.
+ * @retval ESP_ERR_INVALID_STATE if the engine is not started.
+ */
+static esp_err_t flash_write_end(void)
+{
+    if (!g_write_queue) return ESP_ERR_INVALID_STATE;
+
+    flash_write_msg_t *m = &g_write_stage;
+    if (m->length > 0) {
+        xQueueSend(g_write_queue, m, portMAX_DELAY);
+    }
+    m->type = WRITE_MSG_END;
+    m->length = 0;
+    xQueueSend(g_write_queue, m, portMAX_DELAY);
+    return ESP_OK;
+}
+
+/**
+ * @brief Asynchronously write a buffer: begin + append + end in one call.
+ *
+ * Returns once every page is queued (or copied into the queue), not when programmed.
+ *
+ * @param address  Start address.
+ * @param data     Input buffer (may be reused after return).
+ * @param length   Number of bytes to program.
+ * @param erase    Erase the covered sectors ahead of programming.
+ * @param done_cb  Completion callback, from the engine task (may be NULL).
+ * @param ctx      Passed to done_cb.
+ *
+ * @retval ESP_OK on success.
+ * @retval esp_err_t from flash_write_begin().
+ */
+static esp_err_t spi_flash_write_async(uint32_t address, const uint8_t *data, size_t length, bool erase,
+                                       flash_write_done_cb_t done_cb, void *ctx)
+{
+    if (!data) return ESP_ERR_INVALID_ARG;
+    ESP_RETURN_ON_ERROR(flash_write_begin(address, length, erase, done_cb, ctx), TAG, "begin failed");
+    ESP_RETURN_ON_ERROR(flash_write_append(data, length), TAG, "append failed");
+    return flash_write_end();
+}
+
+/**
+ * @brief Read Status Register-2 (0x35) and return it in 'status'.
+ *
+ * @param status  Out parameter for status register value.
+ *
+ * @retval ESP_OK on success.
+ * @retval esp_err_t on SPI error.
+ */
+static esp_err_t spi_flash_read_status2(uint8_t *status)
+{
+    if (!status) return ESP_ERR_INVALID_ARG;
+
+    spi_transaction_ext_t t = {0};
+    t.base.flags     = SPI_TRANS_VARIABLE_CMD | SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_DUMMY |
+                       SPI_TRANS_USE_RXDATA;
+    t.base.cmd       = CMD_RDSR2;
+    t.base.rxlength  = 8;
+    t.base.length    = 8;
+    t.command_bits   = 8;
+
+    esp_err_t err = spi_device_transmit(g_spi, &t.base);
+    if (err == ESP_OK) *status = t.base.rx_data[0];
+    return err;
+}
+
+/**
+ * @brief Set the Quad Enable bit (SR2 bit1) so IO2/IO3 can carry data.
+ *
+ * Tries Write Status Register-2 (0x31) first; parts without it take SR1+SR2 through
+ * 0x01. QE is non-volatile, so this only writes the register once per chip.
+ * When SFDP reported the Quad Enable Requirements (BFPT DW15), parts without a QE bit
+ * skip the write and parts with QE in SR1 bit6 (e.g. Macronix) get that bit instead.
+ *
+ * @note WP#/HOLD# stop working as protect/hold inputs once QE is set.
+ *
+ * @retval ESP_OK if QE reads back set.
+ * @retval ESP_ERR_NOT_SUPPORTED if IO2/IO3 are not wired or the QE scheme is not handled.
+ * @retval ESP_FAIL if the chip did not accept the bit.
+ * @retval esp_err_t on SPI or timeout errors.
+ */
+static esp_err_t spi_flash_enable_quad(void)
+{
+    if (PIN_NUM_WP < 0 || PIN_NUM_HD < 0) return ESP_ERR_NOT_SUPPORTED;
+
+    if (g_flash.qe_type == 0) {
+        // No QE bit: IO2/IO3 switch to data whenever a quad command runs
+        g_quad_ready = true;
+        ESP_LOGI(TAG, "Quad Enable not required (SFDP)");
+        return ESP_OK;
+    }
+    if (g_flash.qe_type == 2) {
+        // QE is SR1 bit6, written with a one-byte 0x01
+        uint8_t sr1 = 0;
+        ESP_RETURN_ON_ERROR(spi_flash_read_status1(&sr1), TAG, "RDSR1 failed");
+        if ((sr1 & SR1_QE) == 0) {
+            ESP_RETURN_ON_ERROR(spi_flash_write_enable(), TAG, "WREN failed");
+            uint8_t tx[2] = { CMD_WRSR1, (uint8_t)(sr1 | SR1_QE) };
+            spi_transaction_t t = {0};
+            t.length    = 8 * sizeof(tx);
+            t.tx_buffer = tx;
+            ESP_RETURN_ON_ERROR(spi_device_transmit(g_spi, &t), TAG, "WRSR1 failed");
+            ESP_RETURN_ON_ERROR(spi_flash_wait_ready(50), TAG, "WRSR1 timeout");
+            ESP_RETURN_ON_ERROR(spi_flash_read_status1(&sr1), TAG, "RDSR1 failed");
+        }
+        if ((sr1 & SR1_QE) == 0) return ESP_FAIL;
+
+        g_quad_ready = true;
+        ESP_LOGI(TAG, "Quad Enable set (SR1=0x%02X)", sr1);
+        return ESP_OK;
+    }
+    if (g_flash.qe_type == 3) return ESP_ERR_NOT_SUPPORTED;   // SR2 bit7 via 0x3F/0x3E
+
+    uint8_t sr2 = 0;
+    ESP_RETURN_ON_ERROR(spi_flash_read_status2(&sr2), TAG, "RDSR2 failed");
+
+    if ((sr2 & SR2_QE) == 0) {
+        // Write SR2 directly (0x31)
+        ESP_RETURN_ON_ERROR(spi_flash_write_enable(), TAG, "WREN failed");
+        uint8_t tx2[2] = { CMD_WRSR2, (uint8_t)(sr2 | SR2_QE) };
+        spi_transaction_t t = {0};
+        t.length    = 8 * sizeof(tx2);
+        t.tx_buffer = tx2;
+        ESP_RETURN_ON_ERROR(spi_device_transmit(g_spi, &t), TAG, "WRSR2 failed");
+        ESP_RETURN_ON_ERROR(spi_flash_wait_ready(50), TAG, "WRSR2 timeout");
+        ESP_RETURN_ON_ERROR(spi_flash_read_status2(&sr2), TAG, "RDSR2 failed");
+    }
+
+    if ((sr2 & SR2_QE) == 0) {
+        // Older parts: write SR1 and SR2 together (0x01)
+        uint8_t sr1 = 0;
+        ESP_RETURN_ON_ERROR(spi_flash_read_status1(&sr1), TAG, "RDSR1 failed");
+        ESP_RETURN_ON_ERROR(spi_flash_write_enable(), TAG, "WREN failed");
+        uint8_t tx1[3] = { CMD_WRSR1, sr1, (uint8_t)(sr2 | SR2_QE) };
+        spi_transaction_t t = {0};
+        t.length    = 8 * sizeof(tx1);
+        t.tx_buffer = tx1;
+        ESP_RETURN_ON_ERROR(spi_device_transmit(g_spi, &t), TAG, "WRSR1 failed");
+        ESP_RETURN_ON_ERROR(spi_flash_wait_ready(50), TAG, "WRSR1 timeout");
+        ESP_RETURN_ON_ERROR(spi_flash_read_status2(&sr2), TAG, "RDSR2 failed");
+    }
+
+    if ((sr2 & SR2_QE) == 0) return ESP_FAIL;
+
+    g_quad_ready = true;
+    ESP_LOGI(TAG, "Quad Enable set (SR2=0x%02X)", sr2);
+    return ESP_OK;
+}
+
+/* ---------- SFDP Discovery and Clock Tuning ---------- */
+
+/**
+ * @brief Read 'length' bytes of the SFDP area (0x5A, 1-1-1, 8 dummy clocks).
+ *
+ * @param address  Byte offset in the SFDP area.
+ * @param data     Output buffer (must be non-NULL).
+ * @param length   Number of bytes to read (must be > 0).
+ *
+ * @retval ESP_OK on success; data filled.
+ * @retval ESP_ERR_INVALID_ARG on bad args.
+ * @retval esp_err_t underlying SPI error.
+ */
+static esp_err_t spi_flash_read_sfdp(uint32_t address, uint8_t *data, size_t length)
+{
+    if (!data || length == 0) return ESP_ERR_INVALID_ARG;
+
+    spi_transaction_ext_t t = {0};
+    t.base.flags     = SPI_TRANS_VARIABLE_CMD | SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_DUMMY;
+    t.base.cmd       = CMD_READ_SFDP;
+    t.base.addr      = address & 0x00FFFFFFu;
+    t.base.length    = 8 * length;
+    t.base.rxlength  = 8 * length;
+    t.base.rx_buffer = data;
+    t.command_bits   = 8;
+    t.address_bits   = 24;
+    t.dummy_bits     = 8;
+
+    return spi_device_transmit(g_spi, &t.base);
+}
+
+/**
+ * @brief Little-endian 32-bit load from an SFDP buffer.
+ *
+ * @param p  Pointer to 4 bytes.
+ *
+ * @return uint32_t Decoded value.
+ */
+static uint32_t sfdp_le32(const uint8_t *p)
+{
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/**
+ * @brief Apply one BFPT fast-read descriptor to s_read_ops.
+ *
+ * @param mode       Entry to update.
+ * @param supported  Support bit from BFPT DW1.
+ * @param desc       Descriptor: [4:0] dummy clocks, [7:5] mode clocks, [15:8] opcode.
+ *
+ * @return void
+ */
+static void sfdp_apply_read(flash_read_mode_t mode, bool supported, uint16_t desc)
+{
+    flash_read_op_t *op = &s_read_ops[mode];
+    op->supported = supported && (desc >> 8) != 0;
+    if (!op->supported) return;
+
+    const uint8_t dummy = desc & 0x1F;
+    const uint8_t mode_clocks = (desc >> 5) & 0x07;
+    op->cmd = (uint8_t)(desc >> 8);
+
+    if (op->flags & SPI_TRANS_MULTILINE_ADDR) {
+        // 1-4-4: mode bits follow the address, 4 per clock; past 8 bits they are don't-care
+        const uint8_t sent = mode_clocks > 2 ? 2 : mode_clocks;
+        op->address_bits = 24 + 4 * sent;
+        op->dummy_bits = dummy + (mode_clocks - sent);
+    } else {
+        // 1-1-x: the flash ignores the mode clocks, so they are just more dummy
+        op->dummy_bits = dummy + mode_clocks;
+    }
+}
+
+/**
+ * @brief Read the Basic Flash Parameter Table and adapt the driver to the part.
+ *
+ * Fills g_flash (density, 4KB/64KB erase opcodes, Quad Enable scheme) and the
+ * opcode, dummy/mode cycles and 'supported' flag of the dual/quad entries in
+ * s_read_ops. Without SFDP the W25Q defaults stay in place.
+ *
+ * @retval ESP_OK on success.
+ * @retval ESP_ERR_NOT_FOUND if the part has no SFDP or no usable BFPT.
+ * @retval ESP_ERR_NOT_SUPPORTED if the part only takes 4-byte addresses.
+ * @retval esp_err_t on SPI error.
+ */
+static esp_err_t spi_flash_probe_sfdp(void)
+{
+    uint8_t hdr[8];
+    ESP_RETURN_ON_ERROR(spi_flash_read_sfdp(0, hdr, sizeof(hdr)), TAG, "SFDP header read failed");
+    if (sfdp_le32(hdr) != SFDP_SIGNATURE) {
+        ESP_LOGW(TAG, "No SFDP signature; keeping W25Q defaults");
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // Parameter headers follow the 8-byte SFDP header; take the newest BFPT 1.x
+    const unsigned nph = hdr[6] + 1u;
+    uint32_t bfpt_ptr = 0;
+    unsigned bfpt_words = 0;
+    uint8_t bfpt_minor = 0;
+    for (unsigned i = 0; i < nph; ++i) {
+        uint8_t ph[8];
+        ESP_RETURN_ON_ERROR(spi_flash_read_sfdp(8 + 8 * i, ph, sizeof(ph)), TAG, "SFDP param header read failed");
+        const uint16_t id = (uint16_t)((ph[7] << 8) | ph[0]);
+        if (id != SFDP_BFPT_ID || ph[2] != 1) continue;
+        if (bfpt_ptr == 0 || ph[1] >= bfpt_minor) {
+            bfpt_ptr   = (uint32_t)ph[4] | ((uint32_t)ph[5] << 8) | ((uint32_t)ph[6] << 16);
+            bfpt_words = ph[3];
+            bfpt_minor = ph[1];
+        }
+    }
+    if (bfpt_ptr == 0 || bfpt_words < 9) {
+        ESP_LOGW(TAG, "SFDP has no usable BFPT; keeping W25Q defaults");
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (bfpt_words > SFDP_BFPT_MAX_DWORDS) bfpt_words = SFDP_BFPT_MAX_DWORDS;
+
+    uint8_t raw[4 * SFDP_BFPT_MAX_DWORDS];
+    ESP_RETURN_ON_ERROR(spi_flash_read_sfdp(bfpt_ptr, raw, 4 * bfpt_words), TAG, "BFPT read failed");
+    uint32_t dw[SFDP_BFPT_MAX_DWORDS + 1] = {0};   // 1-based, as numbered in JESD216
+    for (unsigned i = 0; i < bfpt_words; ++i) dw[i + 1] = sfdp_le32(raw + 4 * i);
+
+    // DW1[18:17]: 2 = 4-byte addresses only, which the 24-bit commands here cannot reach
+    if (((dw[1] >> 17) & 0x3) == 0x2) {
+        ESP_LOGE(TAG, "Part requires 4-byte addressing; not supported");
+        return ESP_ERR_NOT_SUPPORTED;
+    }
+
+    // DW2: density in bits, either N+1 or 2^N
+    uint32_t size = 0;
+    if (dw[2] & 0x80000000u) {
+        const uint32_t n = dw[2] & 0x7FFFFFFFu;
+        if (n >= 3 && n < 35) size = 1u << (n - 3);
+    } else {
+        size = dw[2] / 8 + 1;
+    }
+    if (size > (16u << 20)) {
+        ESP_LOGW(TAG, "%u MiB part: only the first 16 MiB are reachable with 3-byte addresses",
+                 (unsigned)(size >> 20));
+    }
+
+    // DW8/DW9: up to four erase types as (size exponent, opcode) pairs
+    uint8_t erase_4k = 0, erase_64k = 0;
+    for (int i = 0; i < 4; ++i) {
+        const uint32_t w = dw[8 + i / 2] >> (16 * (i % 2));
+        const uint8_t exp = w & 0xFF;
+        if (exp == 12) erase_4k  = (uint8_t)(w >> 8);
+        if (exp == 16) erase_64k = (uint8_t)(w >> 8);
+    }
+    // DW1[1:0] == 01 also advertises a 4KB erase, with its opcode in [15:8]
+    if (erase_4k == 0 && (dw[1] & 0x3) == 0x1) erase_4k = (uint8_t)(dw[1] >> 8);
+    if (erase_4k == 0) ESP_LOGW(TAG, "No 4KB erase listed; sector erase and erase-ahead are disabled");
+
+    // DW1 support bits with the DW3/DW4 descriptors
+    sfdp_apply_read(FLASH_READ_DUAL_OUT, dw[1] & (1u << 16), (uint16_t)(dw[4] & 0xFFFF));
+    sfdp_apply_read(FLASH_READ_QUAD_IO,  dw[1] & (1u << 21), (uint16_t)(dw[3] & 0xFFFF));
+    sfdp_apply_read(FLASH_READ_QUAD_OUT, dw[1] & (1u << 22), (uint16_t)(dw[3] >> 16));
+
+    g_flash.from_sfdp     = true;
+    g_flash.size_bytes    = size;
+    g_flash.erase_4k_cmd  = erase_4k;
+    g_flash.erase_64k_cmd = erase_64k;
+    g_flash.qe_type       = (bfpt_words >= 15) ? (uint8_t)((dw[15] >> 20) & 0x7) : SFDP_QER_UNKNOWN;
+
+    ESP_LOGI(TAG, "SFDP BFPT 1.%u: %u KiB, erase 4K=0x%02X 64K=0x%02X, QER=%d",
+             bfpt_minor, (unsigned)(size / 1024), erase_4k, erase_64k,
+             g_flash.qe_type == SFDP_QER_UNKNOWN ? -1 : g_flash.qe_type);
+    for (int m = FLASH_READ_DUAL_OUT; m < FLASH_READ_MODE_COUNT; ++m) {
+        const flash_read_op_t *op = &s_read_ops[m];
+        if (op->supported) {
+            ESP_LOGI(TAG, "  %-14s opcode 0x%02X, %u addr bits, %u dummy clocks",
+                     op->name, op->cmd, op->address_bits, op->dummy_bits);
+        } else {
+            ESP_LOGI(TAG, "  %-14s not supported", op->name);
+        }
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Read the 3-byte JEDEC ID (0x9F) into 'id'.
+ *
+ * @param id  Out: manufacturer, memory type, capacity.
+ *
+ * @retval ESP_OK on success.
+ * @retval esp_err_t on SPI error.
+ */
+static esp_err_t spi_flash_read_jedec(uint8_t id[3])
+{
+    spi_transaction_ext_t t = {0};
+    t.base.flags     = SPI_TRANS_VARIABLE_CMD | SPI_TRANS_VARIABLE_ADDR | SPI_TRANS_VARIABLE_DUMMY |
+                       SPI_TRANS_USE_RXDATA;
+    t.base.cmd       = CMD_READ_ID;
+    t.base.rxlength  = 24;
+    t.base.length    = 24;
+    t.command_bits   = 8;
+
+    esp_err_t err = spi_device_transmit(g_spi, &t.base);
+    if (err == ESP_OK) memcpy(id, t.base.rx_data, 3);
+    return err;
+}
+
+/**
+ * @brief One verify pass at the current clock: JEDEC ID plus every usable read mode.
+ *
+ * @param id_ref   JEDEC ID read at FLASH_CLOCK_INIT_HZ.
+ * @param ref_crc  CRC of FLASH_TUNE_LEN bytes at 0x000000, slow-read at FLASH_CLOCK_INIT_HZ.
+ * @param buf      DMA-capable scratch of FLASH_TUNE_LEN bytes.
+ *
+ * @return true if everything matched.
+ */
+static bool spi_flash_tune_check(const uint8_t id_ref[3], uint32_t ref_crc, uint8_t *buf)
+{
+    uint8_t id[3];
+    if (spi_flash_read_jedec(id) != ESP_OK || memcmp(id, id_ref, sizeof(id)) != 0) {
+        ESP_LOGW(TAG, "    JEDEC ID mismatch");
+        return false;
+    }
+
+    for (int m = 0; m < FLASH_READ_MODE_COUNT; ++m) {
+        const flash_read_op_t *op = &s_read_ops[m];
+        if (!op->supported || (op->needs_quad && !g_quad_ready)) continue;
+
+        memset(buf, 0, FLASH_TUNE_LEN);
+        if (spi_flash_read_bulk_dma(0x000000, buf, FLASH_TUNE_LEN, FLASH_TUNE_LEN, (flash_read_mode_t)m) != ESP_OK ||
+            esp_rom_crc32_le(0, buf, FLASH_TUNE_LEN) != ref_crc) {
+            ESP_LOGW(TAG, "    %s mismatch", op->name);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Raise the SPI clock step by step while verify reads stay clean.
+ *
+ * The reference is the JEDEC ID and a slow read of FLASH_TUNE_LEN bytes at 0x000000,
+ * both taken at FLASH_CLOCK_INIT_HZ. Each step re-adds the device at the next divider
+ * of the 80 MHz APB clock and must pass spi_flash_tune_check() FLASH_TUNE_PASSES times.
+ * The first failing step ends the search and the last clean clock is kept, so every
+ * read mode the driver may issue is safe at the final setting.
+ *
+ * The BFPT has no clock limit for these read modes, so the ceiling is FLASH_CLOCK_MAX_HZ
+ * and the verify reads decide. Call after spi_flash_enable_quad() and before the write
+ * engine starts.
+ *
+ * @retval ESP_OK with the device at the fastest clean clock.
+ * @retval ESP_ERR_NO_MEM if the scratch buffer could not be allocated.
+ * @retval esp_err_t on SPI error at FLASH_CLOCK_INIT_HZ or if the device could not be re-added.
+ */
+static esp_err_t spi_flash_autotune_clock(void)
+{
+    static const int kSteps[] = {      // 80 MHz / 8, 5, 4, 3, 2, 1
+        10 * 1000 * 1000, 16 * 1000 * 1000, 20 * 1000 * 1000,
+        26666667,         40 * 1000 * 1000, FLASH_CLOCK_MAX_HZ,
+    };
+
+    uint8_t id_ref[3];
+    ESP_RETURN_ON_ERROR(spi_flash_read_jedec(id_ref), TAG, "JEDEC read failed");
+
+    uint8_t *buf = (uint8_t *)heap_caps_malloc(FLASH_TUNE_LEN, MALLOC_CAP_DMA);
+    if (!buf) return ESP_ERR_NO_MEM;
+
+    esp_err_t err = spi_flash_read_bulk_dma(0x000000, buf, FLASH_TUNE_LEN, FLASH_TUNE_LEN, FLASH_READ_SLOW);
+    if (err != ESP_OK) {
+        free(buf);
+        return err;
+    }
+    const uint32_t ref_crc = esp_rom_crc32_le(0, buf, FLASH_TUNE_LEN);
+
+    // Erased or blank data hides stuck or swapped data lines
+    size_t i = 1;
+    while (i < FLASH_TUNE_LEN && buf[i] == buf[0]) ++i;
+    if (i == FLASH_TUNE_LEN) {
+        ESP_LOGW(TAG, "Tune region is all 0x%02X; program varied data at 0x000000 for a stronger check", buf[0]);
+    }
+
+    int good_hz = g_flash.clock_hz;
+    ESP_LOGI(TAG, "Clock tuning from %.2f MHz", good_hz / 1e6);
+    for (size_t s = 0; s < sizeof(kSteps) / sizeof(kSteps[0]); ++s) {
+        if (kSteps[s] <= good_hz) continue;
+
+        bool ok = (spi_flash_add_device(kSteps[s]) == ESP_OK);
+        for (int pass = 0; ok && pass < FLASH_TUNE_PASSES; ++pass) {
+            ok = spi_flash_tune_check(id_ref, ref_crc, buf);
+        }
+        if (!ok) {
+            ESP_LOGW(TAG, "  %6.2f MHz: failed, stopping", kSteps[s] / 1e6);
+            break;
+        }
+        ESP_LOGI(TAG, "  %6.2f MHz: OK", kSteps[s] / 1e6);
+        good_hz = kSteps[s];
+    }
+    free(buf);
+
+    // Step back if the last attempt failed
+    if (!g_spi || g_flash.clock_hz != good_hz) {
+        ESP_RETURN_ON_ERROR(spi_flash_add_device(good_hz), TAG, "restore clock failed");
+    }
+    ESP_LOGI(TAG, "SPI clock set to %.2f MHz", good_hz / 1e6);
+    return ESP_OK;
+}
+
+/**
+ * @brief Stream consumer that folds each chunk into a running CRC32.
+ *
+ * @param ctx      Pointer to the running uint32_t CRC.
+ * @param address  Flash address of the chunk (unused).
+ * @param data     Chunk contents.
+ * @param len      Chunk length.
+ *
+ * @retval ESP_OK always.
+ */
+static esp_err_t crc_consumer(void *ctx, uint32_t address, const uint8_t *data, size_t len)
+{
+    (void)address;
+    uint32_t *crc = (uint32_t *)ctx;
+    *crc = esp_rom_crc32_le(*crc, data, len);
+    return ESP_OK;
+}
+
+/**
+ * @brief Benchmark every read mode over the same region and report MB/s.
+ *
+ * Reads 'length' bytes with each mode through spi_flash_read_bulk_dma(), times the
+ * pass with esp_timer, and checks the data against the slow-read CRC so a mis-wired
+ * IO2/IO3 or wrong dummy count shows up as a mismatch instead of a fast number.
+ * Then compares blocking, queued and streamed reads of the fastest available mode.
+ *
+ * @param address  Start address of the region to read.
+ * @param length   Bytes per pass (<= available DMA heap).
+ *
+ * @return void
+ */
+static void spi_flash_benchmark_reads(uint32_t address, size_t length)
+{
+    uint8_t *buf = (uint8_t *)heap_caps_malloc(length, MALLOC_CAP_DMA);
+    if (!buf) {
+        ESP_LOGE(TAG, "Benchmark buffer (%u bytes) allocation failed", (unsigned)length);
+        return;
+    }
+
+    uint32_t ref_crc = 0;
+    ESP_LOGI(TAG, "Read benchmark: %u bytes @0x%06" PRIx32, (unsigned)length, address);
+
+    for (int m = 0; m < FLASH_READ_MODE_COUNT; ++m) {
+        const flash_read_op_t *op = &s_read_ops[m];
+        if (!op->supported) {
+            ESP_LOGW(TAG, "  %-14s skipped (not in SFDP)", op->name);
+            continue;
+        }
+        if (op->needs_quad && !g_quad_ready) {
+            ESP_LOGW(TAG, "  %-14s skipped (QE not set)", op->name);
+            continue;
+        }
+
+        memset(buf, 0, length);
+        const int64_t t0 = esp_timer_get_time();
+        esp_err_t err = spi_flash_read_bulk_dma(address, buf, length, 16 * 1024, (flash_read_mode_t)m);
+        const int64_t us = esp_timer_get_time() - t0;
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "  %-14s failed: %s", op->name, esp_err_to_name(err));
+            continue;
+        }
+
+        // Slow read is the reference every faster mode must match
+        const uint32_t crc = esp_rom_crc32_le(0, buf, length);
+        if (m == FLASH_READ_SLOW) ref_crc = crc;
+
+        const double mbps = (double)length / (double)us;   // bytes/us == MB/s
+        ESP_LOGI(TAG, "  %-14s %7.3f MB/s (%6" PRId64 " us) %s",
+                 op->name, mbps, us, crc == ref_crc ? "data OK" : "DATA MISMATCH");
+    }
+
+    // Blocking vs queued in small chunks, where per-transaction gaps dominate
+    const flash_read_mode_t best = spi_flash_best_read_mode();
+    const size_t chunk = 4 * 1024;
+    ESP_LOGI(TAG, "Pipeline benchmark: %s, %u-byte chunks", s_read_ops[best].name, (unsigned)chunk);
+
+    int64_t t0 = esp_timer_get_time();
+    esp_err_t err = ESP_OK;
+    for (size_t off = 0; off < length && err == ESP_OK; off += chunk) {
+        size_t n = (length - off) > chunk ? chunk : (length - off);
+        err = spi_flash_read_mode(address + off, buf + off, n, best);
+    }
+    int64_t us = esp_timer_get_time() - t0;
+    ESP_LOGI(TAG, "  %-14s %7.3f MB/s %s", "Blocking", (double)length / (double)us,
+             err == ESP_OK && esp_rom_crc32_le(0, buf, length) == ref_crc ? "data OK" : "FAILED");
+
+    t0 = esp_timer_get_time();
+    err = spi_flash_read_bulk_dma(address, buf, length, chunk, best);
+    us = esp_timer_get_time() - t0;
+    ESP_LOGI(TAG, "  %-14s %7.3f MB/s %s", "Queued", (double)length / (double)us,
+             err == ESP_OK && esp_rom_crc32_le(0, buf, length) == ref_crc ? "data OK" : "FAILED");
+
+    // Stream computes the CRC in the consumer while later chunks transfer
+    uint32_t stream_crc = 0;
+    t0 = esp_timer_get_time();
+    err = spi_flash_read_stream(address, length, chunk, best, crc_consumer, &stream_crc);
+    us = esp_timer_get_time() - t0;
+    ESP_LOGI(TAG, "  %-14s %7.3f MB/s %s", "Stream+CRC", (double)length / (double)us,
+             err == ESP_OK && stream_crc == ref_crc ? "data OK" : "FAILED");
+
+    free(buf);
+}
+
+/**
+ * @brief Compare uncached and cached small random reads over one region.
+ *
+ * Each uncached record read pays a full command/address/dummy transaction; the
+ * cached pass pays one sector fill per distinct sector and then memcpy from RAM.
+ * Both passes use the same pseudo-random offsets and are checked against each other.
+ *
+ * @param address  Start of the region (sector aligned).
+ * @param span     Region size in bytes.
+ * @param records  Number of reads per pass.
+ *
+ * @return void
+ */
+static void spi_flash_benchmark_cache(uint32_t address, size_t span, size_t records)
+{
+    enum { RECORD_LEN = 32 };
+    uint8_t rec[RECORD_LEN];
+    uint32_t seed = 0x12345678, crc_raw = 0, crc_cached = 0;
+    esp_err_t err = ESP_OK;
+
+    ESP_LOGI(TAG, "Cache benchmark: %u x %u-byte reads in %u bytes @0x%06" PRIx32,
+             (unsigned)records, (unsigned)RECORD_LEN, (unsigned)span, address);
+
+    int64_t t0 = esp_timer_get_time();
+    for (size_t i = 0; i < records && err == ESP_OK; ++i) {
+        seed = seed * 1664525u + 1013904223u;   // LCG: same sequence for both passes
+        const uint32_t off = (seed >> 8) % (span / RECORD_LEN) * RECORD_LEN;
+        err = spi_flash_read_fast(address + off, rec, RECORD_LEN, 8);
+        crc_raw = esp_rom_crc32_le(crc_raw, rec, RECORD_LEN);
+    }
+    const int64_t us_raw = esp_timer_get_time() - t0;
+
+    flash_cache_stats_t before;
+    flash_cache_get_stats(&before);
+
+    seed = 0x12345678;
+    t0 = esp_timer_get_time();
+    for (size_t i = 0; i < records && err == ESP_OK; ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        const uint32_t off = (seed >> 8) % (span / RECORD_LEN) * RECORD_LEN;
+        err = flash_cache_read(address + off, rec, RECORD_LEN);
+        crc_cached = esp_rom_crc32_le(crc_cached, rec, RECORD_LEN);
+    }
+    const int64_t us_cached = esp_timer_get_time() - t0;
+
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "  Cache benchmark failed: %s", esp_err_to_name(err));
+        return;
+    }
+
+    flash_cache_stats_t after;
+    flash_cache_get_stats(&after);
+    ESP_LOGI(TAG, "  %-14s %8" PRId64 " us", "Uncached", us_raw);
+    ESP_LOGI(TAG, "  %-14s %8" PRId64 " us %s", "Cached", us_cached,
+             crc_raw == crc_cached ? "data OK" : "DATA MISMATCH");
+    ESP_LOGI(TAG, "  hits=%" PRIu32 " misses=%" PRIu32 " readaheads=%" PRIu32 " evictions=%" PRIu32,
+             after.hits - before.hits, after.misses - before.misses,
+             after.readaheads - before.readaheads, after.evictions - before.evictions);
+}
+
+/**
+ * @brief Result slot filled by async_write_done().
+ */
+typedef struct {
+    SemaphoreHandle_t done;
+    esp_err_t err;
+    size_t bytes;
+} async_write_result_t;
+
+/**
+ * @brief Write engine completion callback used by the demo.
+ *
+ * @param ctx            async_write_result_t to fill.
+ * @param result         Job status.
+ * @param bytes_written  Bytes programmed.
+ *
+ * @return void
+ */
+static void async_write_done(void *ctx, esp_err_t result, size_t bytes_written)
+{
+    async_write_result_t *r = (async_write_result_t *)ctx;
+    r->err = result;
+    r->bytes = bytes_written;
+    xSemaphoreGive(r->done);
+}
+
+/**
+ * @brief Demo entry: init bus/device, read ID, SFDP + clock tuning, slow/fast/DMA bulk read,
+ *        read benchmark, (optional) erase+program+verify flow, async 64KB write.
+ *
+ * @return void
+ */
+void app_main(void)
+{
+    // Initialize SPI bus and add flash device to the bus
+    spi_flash_init();
+
+    // --- JEDEC ID ---
+    spi_flash_read_id();
+
+    // --- SFDP discovery, Quad Enable, clock tuning ---
+    esp_err_t serr = spi_flash_probe_sfdp();
+    if (serr != ESP_OK) {
+        ESP_LOGW(TAG, "SFDP unavailable: %s", esp_err_to_name(serr));
+    }
+    esp_err_t qerr = spi_flash_enable_quad();
+    if (qerr != ESP_OK) {
+        ESP_LOGW(TAG, "Quad modes unavailable: %s", esp_err_to_name(qerr));
+    }
+    ESP_ERROR_CHECK(spi_flash_autotune_clock());
 
     // --- Slow Read (0x03) 16 bytes @ 0x000000 ---
     uint8_t slow_buf[16] = {0};
@@ -472,11 +2026,18 @@ void app_main(void)
     uint8_t *bulk = (uint8_t *)heap_caps_malloc(BULK_LEN, MALLOC_CAP_DMA);
     configASSERT(bulk != NULL);
     memset(bulk, 0, BULK_LEN);
-    ESP_ERROR_CHECK(spi_flash_read_bulk_dma(0x000000, bulk, BULK_LEN, 16 * 1024));
+    ESP_ERROR_CHECK(spi_flash_read_bulk_dma(0x000000, bulk, BULK_LEN, 16 * 1024, FLASH_READ_FAST));
     ESP_LOGI(TAG, "Bulk fast read 1 KiB done (showing first 32 bytes):");
     for (size_t i = 0; i < 32; ++i) printf("%02X ", bulk[i]);
     printf("\n");
 
+    // --- Read mode benchmark (64 KiB @ 0x000000) ---
+    spi_flash_benchmark_reads(0x000000, 64 * 1024);
+
+    // --- Sector read cache: random 32-byte records in the first 64 KiB ---
+    ESP_ERROR_CHECK(flash_cache_init(FLASH_CACHE_DEFAULT_LINES));
+    spi_flash_benchmark_cache(0x000000, 64 * 1024, 1000);
+
     // ===== OPTIONAL: ERASE + PROGRAM + VERIFY DEMO =====
     // WARNING: This erases a 4KB sector. Pick a known-safe offset on your chip!
     const uint32_t demo_addr = 0x001000; // Choose a sector you can safely modify
@@ -498,5 +2059,45 @@ void app_main(void)
     bool ok = (memcmp(pattern, verify, sizeof(pattern)) == 0);
     ESP_LOGI(TAG, "Verify %s", ok ? "OK ✅" : "FAILED ❌");
 
+    // The sector was cached by the benchmark; erase/program must have dropped it
+    memset(verify, 0, sizeof(verify));
+    ESP_ERROR_CHECK(flash_cache_read(demo_addr, verify, sizeof(verify)));
+    ESP_LOGI(TAG, "Cached read after program %s",
+             memcmp(pattern, verify, sizeof(pattern)) == 0 ? "OK ✅" : "STALE ❌");
+
+    // ===== OPTIONAL: ASYNC 64 KiB WRITE WITH ERASE-AHEAD =====
+    // WARNING: This erases the 64KB block at async_addr.
+    const uint32_t async_addr = 0x010000;
+    enum { ASYNC_LEN = 64 * 1024 };
+    uint8_t *asset = (uint8_t *)heap_caps_malloc(ASYNC_LEN, MALLOC_CAP_DMA);
+    configASSERT(asset != NULL);
+    for (size_t i = 0; i < ASYNC_LEN; ++i) asset[i] = (uint8_t)(i * 7 + (i >> 8));
+
+    ESP_ERROR_CHECK(flash_write_engine_start());
+    async_write_result_t result = { .done = xSemaphoreCreateBinary() };
+    configASSERT(result.done != NULL);
+
+    ESP_LOGW(TAG, "Async erase+program 64 KiB at 0x%06" PRIx32 " (demo)", async_addr);
+    const int64_t t0 = esp_timer_get_time();
+    ESP_ERROR_CHECK(spi_flash_write_async(async_addr, asset, ASYNC_LEN, true, async_write_done, &result));
+    const int64_t queued_us = esp_timer_get_time() - t0;
+
+    // This task is free until the callback fires
+    xSemaphoreTake(result.done, portMAX_DELAY);
+    const int64_t total_us = esp_timer_get_time() - t0;
+    ESP_LOGI(TAG, "Async write: %s, %u bytes, queued in %" PRId64 " us, done in %" PRId64 " us (%.1f KB/s)",
+             esp_err_to_name(result.err), (unsigned)result.bytes, queued_us, total_us,
+             (double)ASYNC_LEN * 1000.0 / (double)total_us);
+
+    // Verify with a pipelined read into the bulk buffer, 1 KiB at a time
+    bool async_ok = (result.err == ESP_OK);
+    for (size_t off = 0; async_ok && off < ASYNC_LEN; off += BULK_LEN) {
+        async_ok = spi_flash_read_bulk_dma(async_addr + off, bulk, BULK_LEN, 16 * 1024, FLASH_READ_FAST) == ESP_OK &&
+                   memcmp(bulk, asset + off, BULK_LEN) == 0;
+    }
+    ESP_LOGI(TAG, "Async verify %s", async_ok ? "OK ✅" : "FAILED ❌");
+
+    vSemaphoreDelete(result.done);
+    free(asset);
     free(bulk);
 }
\ No newline at end of file
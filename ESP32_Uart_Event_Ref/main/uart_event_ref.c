@@ -8,6 +8,8 @@
  * - Run a dedicated RX task that blocks on the event queue, then reads available data.
  * - Handle common UART error events (FIFO overflow, buffer full, frame/parity errors).
  * - Implement a simple CR/LF line protocol to show a real notice-and-respond workflow.
+ * - Optionally receive through UHCI + GDMA instead of FIFO interrupts, for
+ *   sustained multi-Mbaud streams (UART_RX_MODE_UHCI).
  *
  * Wiring (default pins):
  * - USB-UART TX -> ESP32 RX (GPIO16)
@@ -30,6 +32,7 @@
 #include "esp_err.h"
 #include "esp_timer.h"
 #include "esp_check.h"
+#include "esp_heap_caps.h"
 
 
 /* ---------- User-tunable settings (keep simple; can be moved to menuconfig later) ---------- */
@@ -51,6 +54,21 @@
 
 #define LINE_BUF_SIZE           256
 
+/* RX path: FIFO interrupts via the UART driver, or UHCI + GDMA straight into RAM */
+#define UART_RX_MODE_EVENT      0
+#define UART_RX_MODE_UHCI       1
+#define UART_RX_MODE            UART_RX_MODE_EVENT
+
+#define UHCI_RX_BUF_SIZE        4096   // Each of the two DMA buffers
+#define UHCI_RX_QUEUE_LEN       16     // Received chunks waiting for the RX task
+#define UHCI_RX_IDLE_SYMBOLS    10     // Line idle time (in symbols) that ends a chunk
+
+/* RX instrumentation report */
+#define STATS_REPORT_PERIOD_MS  5000
+#define STATS_TASK_STACK        3072
+#define STATS_TASK_PRIO         2
+#define UART_BITS_PER_BYTE      10     // 8N1: start + 8 data + stop
+
 static const char *TAG = "uart_ref";
 static QueueHandle_t s_uart_evt_queue = NULL;
 
@@ -60,6 +78,44 @@ static uint32_t s_parity_err_count = 0;
 static uint32_t s_fifo_ovf_count = 0;
 static uint32_t s_buf_full_count = 0;
 
+/**
+ * @brief RX instrumentation, reported every STATS_REPORT_PERIOD_MS.
+ *
+ * Totals only grow; the peak and max fields cover one report period and are
+ * cleared by the report task.
+ */
+typedef struct {
+    uint32_t rx_bytes;              // Total bytes read
+    uint32_t rx_events;             // Total UART_DATA events
+    size_t peak_ring_fill;          // Most bytes waiting in the driver ring buffer
+    uint32_t peak_evt_queue;        // Most events queued, including the one taken
+    uint32_t max_latency_us;        // Longest estimated ISR-to-task latency
+    uint64_t latency_sum_us;        // For the average over rx_events
+    uint32_t max_handle_us;         // Longest time spent handling one event
+} uart_rx_stats_t;
+
+static uart_rx_stats_t s_rx_stats;
+static portMUX_TYPE s_rx_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+#if UART_RX_MODE == UART_RX_MODE_UHCI
+#include "driver/uhci.h"   // UHCI (UART DMA) driver, ESP-IDF v5.5 and later
+
+/**
+ * @brief One block of received bytes, delivered by GDMA at an idle line or a full buffer.
+ */
+typedef struct {
+    uint8_t *data;
+    size_t len;
+    bool buffer_done;   // Last chunk of this DMA buffer; the other one takes over
+} uhci_rx_chunk_t;
+
+static uhci_controller_handle_t s_uhci = NULL;
+static QueueHandle_t s_uhci_rx_queue = NULL;
+static uint8_t *s_uhci_rx_buf[2] = {NULL, NULL};
+static uint32_t s_uhci_rx_chunks = 0;
+static uint32_t s_uhci_rx_dropped = 0;
+#endif
+
 // Optional: signal UART ready to other tasks 
 static EventGroupHandle_t s_sys_eg = NULL;
 #define SYS_EG_UART_READY_BIT   (1U << 0)
@@ -124,6 +180,77 @@ static esp_err_t uart_init_event_mode(void)
     return ESP_OK;
 }
 
+#if UART_RX_MODE == UART_RX_MODE_UHCI
+/**
+ * @brief UHCI RX callback (ISR context): pass the received block to the RX task.
+ *
+ * Called at every DMA EOF, i.e. when the line goes idle or a buffer fills. The
+ * data stays in the DMA buffer; only a pointer and a length are queued.
+ *
+ * @param uhci_ctrl UHCI controller handle.
+ * @param edata Received block.
+ * @param user_ctx Unused.
+ * @return bool true if a higher-priority task was woken.
+ */
+static bool uhci_rx_event_cb(uhci_controller_handle_t uhci_ctrl, const uhci_rx_event_data_t *edata, void *user_ctx)
+{
+    (void)uhci_ctrl;
+    (void)user_ctx;
+
+    BaseType_t woken = pdFALSE;
+    uhci_rx_chunk_t chunk = {
+        .data = edata->data,
+        .len = edata->recv_size,
+        .buffer_done = edata->flags.totally_received,
+    };
+
+    if (xQueueSendFromISR(s_uhci_rx_queue, &chunk, &woken) != pdTRUE) {
+        s_uhci_rx_dropped++;
+    }
+    return woken == pdTRUE;
+}
+
+/**
+ * @brief Move UART reception from FIFO interrupts to UHCI + GDMA.
+ *
+ * The UART driver stays installed for TX and error events, but its RX FIFO
+ * interrupts are disabled; UHCI drains the FIFO by DMA into two buffers used
+ * in turn. A chunk ends when the line has been idle for UHCI_RX_IDLE_SYMBOLS,
+ * which marks frame boundaries without any per-threshold interrupt.
+ *
+ * @return esp_err_t ESP_OK on success, otherwise an ESP-IDF error code.
+ */
+static esp_err_t uart_init_uhci_rx(void)
+{
+    uhci_controller_config_t uhci_cfg = {
+        .uart_port = UART_PORT,
+        .tx_trans_queue_depth = 1,
+        .max_transmit_size = 64,
+        .max_receive_internal_mem = UHCI_RX_BUF_SIZE,
+        .dma_burst_size = 32,
+        .rx_eof_flags.idle_eof = 1,
+    };
+    uhci_event_callbacks_t uhci_cbs = {
+        .on_rx_trans_event = uhci_rx_event_cb,
+    };
+
+    s_uhci_rx_queue = xQueueCreate(UHCI_RX_QUEUE_LEN, sizeof(uhci_rx_chunk_t));
+    ESP_RETURN_ON_FALSE(s_uhci_rx_queue != NULL, ESP_ERR_NO_MEM, TAG, "UHCI RX queue alloc failed");
+
+    for (int i = 0; i < 2; i++) {
+        s_uhci_rx_buf[i] = heap_caps_calloc(1, UHCI_RX_BUF_SIZE, MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL);
+        ESP_RETURN_ON_FALSE(s_uhci_rx_buf[i] != NULL, ESP_ERR_NO_MEM, TAG, "UHCI RX buffer alloc failed");
+    }
+
+    ESP_RETURN_ON_ERROR(uart_disable_rx_intr(UART_PORT), TAG, "uart_disable_rx_intr failed");
+    ESP_RETURN_ON_ERROR(uart_set_rx_timeout(UART_PORT, UHCI_RX_IDLE_SYMBOLS), TAG, "uart_set_rx_timeout failed");
+    ESP_RETURN_ON_ERROR(uhci_new_controller(&uhci_cfg, &s_uhci), TAG, "uhci_new_controller failed");
+    ESP_RETURN_ON_ERROR(uhci_register_event_callbacks(s_uhci, &uhci_cbs, NULL), TAG, "uhci callbacks failed");
+
+    return uhci_receive(s_uhci, s_uhci_rx_buf[0], UHCI_RX_BUF_SIZE);
+}
+#endif
+
 /**
  * @brief Reset UART input state after an overflow/buffer-full condition.
  *
@@ -141,6 +268,56 @@ static void uart_recover_from_overflow(void)
     }
 }
 
+/**
+ * @brief Record the queue and buffer state seen when a UART_DATA event is taken.
+ *
+ * The driver does not timestamp events, so the ISR-to-task latency is estimated
+ * from the backlog: bytes buffered beyond the event's own size arrived after the
+ * ISR posted it, at one byte per UART_BITS_PER_BYTE bit times. This is a lower
+ * bound, and exact while data keeps streaming.
+ *
+ * @param buffered Bytes waiting in the driver ring buffer.
+ * @param event_size Bytes reported by the event.
+ * @param queued Events in the queue, including the one just taken.
+ */
+static void uart_stats_record_event(size_t buffered, size_t event_size, uint32_t queued)
+{
+    size_t backlog = (buffered > event_size) ? (buffered - event_size) : 0;
+    uint32_t latency_us = (uint32_t)(((uint64_t)backlog * UART_BITS_PER_BYTE * 1000000ULL) / UART_BAUDRATE);
+
+    taskENTER_CRITICAL(&s_rx_stats_lock);
+    s_rx_stats.rx_events++;
+    s_rx_stats.latency_sum_us += latency_us;
+    if (buffered > s_rx_stats.peak_ring_fill) {
+        s_rx_stats.peak_ring_fill = buffered;
+    }
+    if (queued > s_rx_stats.peak_evt_queue) {
+        s_rx_stats.peak_evt_queue = queued;
+    }
+    if (latency_us > s_rx_stats.max_latency_us) {
+        s_rx_stats.max_latency_us = latency_us;
+    }
+    taskEXIT_CRITICAL(&s_rx_stats_lock);
+}
+
+/**
+ * @brief Record the bytes read and the time spent handling one UART_DATA event.
+ *
+ * @param bytes Bytes read (ignored if negative).
+ * @param handle_us Time spent reading and parsing, in microseconds.
+ */
+static void uart_stats_record_handled(int bytes, uint32_t handle_us)
+{
+    taskENTER_CRITICAL(&s_rx_stats_lock);
+    if (bytes > 0) {
+        s_rx_stats.rx_bytes += (uint32_t)bytes;
+    }
+    if (handle_us > s_rx_stats.max_handle_us) {
+        s_rx_stats.max_handle_us = handle_us;
+    }
+    taskEXIT_CRITICAL(&s_rx_stats_lock);
+}
+
 /**
  * @brief Handle a complete received line.
  *
@@ -176,6 +353,12 @@ static void handle_line(const char *line)
                  ", fifo_ovf=%" PRIu32 ", buf_full=%" PRIu32 "\r\n",
                  s_frame_err_count, s_parity_err_count, s_fifo_ovf_count, s_buf_full_count);
         uart_write_str(msg);
+#if UART_RX_MODE == UART_RX_MODE_UHCI
+        snprintf(msg, sizeof(msg),
+                 "uhci: chunks=%" PRIu32 ", dropped=%" PRIu32 "\r\n",
+                 s_uhci_rx_chunks, s_uhci_rx_dropped);
+        uart_write_str(msg);
+#endif
         return;
     }
 
@@ -261,12 +444,20 @@ static void uart_event_task(void *arg)
 
         switch (evt.type) {
             case UART_DATA: {
+                int64_t start_us = esp_timer_get_time();
+                size_t buffered = 0;
+
+                // Everything buffered beyond this event's bytes arrived after the ISR posted it.
+                uart_get_buffered_data_len(UART_PORT, &buffered);
+                uart_stats_record_event(buffered, evt.size, uxQueueMessagesWaiting(s_uart_evt_queue) + 1);
+
                 // Read the bytes associated with this event
                 int to_read = (evt.size < (int)sizeof(rx)) ? evt.size : (int)sizeof(rx);
                 int n = uart_read_bytes(UART_PORT, rx, to_read, 0);
                 if (n > 0) {
                     line_accumulator_feed(rx, n, line_buf, &line_len);
                 }
+                uart_stats_record_handled(n, (uint32_t)(esp_timer_get_time() - start_us));
                 break;
             }
 
@@ -302,6 +493,98 @@ static void uart_event_task(void *arg)
     }
 }
 
+#if UART_RX_MODE == UART_RX_MODE_UHCI
+/**
+ * @brief FreeRTOS task: consume GDMA-received chunks and feed the line accumulator.
+ *
+ * Same line interface as uart_event_task(), but the task wakes once per idle
+ * line or full buffer instead of once per FIFO threshold. When a DMA buffer is
+ * complete, the other one is armed first, then the chunk is parsed; the two
+ * buffers form a circular chain, so a buffer is only rearmed after all of its
+ * chunks have been processed.
+ *
+ * @param arg Unused.
+ */
+static void uart_uhci_rx_task(void *arg)
+{
+    (void)arg;
+
+    uhci_rx_chunk_t chunk;
+    int active = 0;
+
+    char line_buf[LINE_BUF_SIZE];
+    size_t line_len = 0;
+
+    ESP_LOGI(TAG, "UART UHCI RX task started (port=%d, baud=%d)", (int)UART_PORT, UART_BAUDRATE);
+
+    while (1) {
+        if (xQueueReceive(s_uhci_rx_queue, &chunk, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        if (chunk.buffer_done) {
+            active ^= 1;
+            if (uhci_receive(s_uhci, s_uhci_rx_buf[active], UHCI_RX_BUF_SIZE) != ESP_OK) {
+                ESP_LOGW(TAG, "UHCI rearm failed");
+            }
+        }
+
+        int64_t start_us = esp_timer_get_time();
+
+        s_uhci_rx_chunks++;
+        line_accumulator_feed(chunk.data, (int)chunk.len, line_buf, &line_len);
+        uart_stats_record_handled((int)chunk.len, (uint32_t)(esp_timer_get_time() - start_us));
+    }
+}
+#endif
+
+/**
+ * @brief FreeRTOS task: log RX throughput, buffer/queue headroom and error counts.
+ *
+ * Use the peaks to size UART_RX_BUF_SIZE and UART_EVT_QUEUE_LEN, and the
+ * latency and handling times to choose RX_TASK_PRIO, instead of guessing.
+ *
+ * @param arg Unused.
+ */
+static void uart_stats_task(void *arg)
+{
+    (void)arg;
+
+    uart_rx_stats_t snap;
+    uint32_t prev_bytes = 0;
+    uint32_t prev_events = 0;
+    uint64_t prev_latency_sum = 0;
+
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(STATS_REPORT_PERIOD_MS));
+
+        taskENTER_CRITICAL(&s_rx_stats_lock);
+        snap = s_rx_stats;
+        s_rx_stats.peak_ring_fill = 0;
+        s_rx_stats.peak_evt_queue = 0;
+        s_rx_stats.max_latency_us = 0;
+        s_rx_stats.max_handle_us = 0;
+        taskEXIT_CRITICAL(&s_rx_stats_lock);
+
+        uint32_t events = snap.rx_events - prev_events;
+        uint32_t avg_latency_us = events ? (uint32_t)((snap.latency_sum_us - prev_latency_sum) / events) : 0;
+
+        ESP_LOGI(TAG, "rx %" PRIu32 " B/s, %" PRIu32 " events | ring peak %u/%d B | evt queue peak %" PRIu32 "/%d",
+                 (uint32_t)((uint64_t)(snap.rx_bytes - prev_bytes) * 1000U / STATS_REPORT_PERIOD_MS),
+                 events,
+                 (unsigned)snap.peak_ring_fill, UART_RX_BUF_SIZE,
+                 snap.peak_evt_queue, UART_EVT_QUEUE_LEN);
+        ESP_LOGI(TAG, "latency avg %" PRIu32 " us, max %" PRIu32 " us | handling max %" PRIu32
+                 " us | fifo_ovf=%" PRIu32 " buf_full=%" PRIu32 " frame_err=%" PRIu32 " parity_err=%" PRIu32,
+                 avg_latency_us, snap.max_latency_us, snap.max_handle_us,
+                 s_fifo_ovf_count, s_buf_full_count, s_frame_err_count, s_parity_err_count);
+
+        prev_bytes = snap.rx_bytes;
+        prev_events = snap.rx_events;
+        prev_latency_sum = snap.latency_sum_us;
+    }
+}
+
 /**
  * @brief FreeRTOS task: periodically transmit a heartbeat over UART.
  *
@@ -342,6 +625,12 @@ void app_main(void)
     // Initialize UART in event mode
     ESP_ERROR_CHECK(uart_init_event_mode());
 
+#if UART_RX_MODE == UART_RX_MODE_UHCI
+    // Hand RX over to UHCI + GDMA; the event task still reports errors
+    ESP_ERROR_CHECK(uart_init_uhci_rx());
+    xTaskCreate(uart_uhci_rx_task, "uart_uhci_rx", RX_TASK_STACK, NULL, RX_TASK_PRIO + 1, NULL);
+#endif
+
     // Print banner
     uart_write_str("\r\n");
     uart_write_str("=== ESP32 UART Event Reference ===\r\n");
@@ -351,6 +640,9 @@ void app_main(void)
     // Create the UART event task
     xTaskCreate(uart_event_task, "uart_event_task", RX_TASK_STACK, NULL, RX_TASK_PRIO, NULL);
     
+    // Create the RX instrumentation report task
+    xTaskCreate(uart_stats_task, "uart_stats_task", STATS_TASK_STACK, NULL, STATS_TASK_PRIO, NULL);
+
     // Create a TX heartbeat task
     xTaskCreate(uart_tx_heartbeat_task, "uart_tx_hb_task", TX_TASK_STACK, NULL, TX_TASK_PRIO, NULL);
 }
\ No newline at end of file
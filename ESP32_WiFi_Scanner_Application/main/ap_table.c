@@ -0,0 +1,199 @@
+/**
+ * @file ap_table.c
+ * @brief Open-addressing hash table of access points, keyed by BSSID
+ *
+ * Linear probing over a power-of-two slot array. Removal shifts the
+ * following entries of the probe run back instead of leaving tombstones,
+ * so lookups never slow down as APs come and go.
+ */
+
+#include "ap_table.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include "esp_log.h"
+
+// Logging tag
+static const char *TAG = "AP_Table";
+
+static ap_entry_t *s_slots = NULL;
+static size_t s_capacity = 0;
+static size_t s_count = 0;
+static uint32_t s_age_out_ms = 0;
+static uint8_t s_rssi_report_db = 0;
+
+/**
+ * @brief FNV-1a hash of a BSSID
+ *
+ * The low bytes of a BSSID are close to random, but vendors often assign
+ * neighbouring addresses to the radios of one AP, so all six bytes are mixed.
+ *
+ * @param bssid 6-byte MAC address
+ * @return size_t Hash value
+ */
+static size_t bssid_hash(const uint8_t *bssid) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < 6; i++) {
+        hash ^= bssid[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**
+ * @brief Find the slot holding a BSSID, or the empty slot where it would go
+ *
+ * @param slots Slot array
+ * @param capacity Number of slots (power of two, never full)
+ * @param bssid 6-byte MAC address
+ * @return size_t Slot index
+ */
+static size_t find_slot(const ap_entry_t *slots, size_t capacity, const uint8_t *bssid) {
+    size_t mask = capacity - 1;
+    size_t i = bssid_hash(bssid) & mask;
+    while (slots[i].used && memcmp(slots[i].bssid, bssid, 6) != 0) {
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+/**
+ * @brief Move all entries into a slot array of the given size
+ *
+ * @param capacity New number of slots (power of two)
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if allocation failed
+ */
+static esp_err_t rehash(size_t capacity) {
+    ap_entry_t *slots = calloc(capacity, sizeof(ap_entry_t));
+    if (!slots) {
+        return ESP_ERR_NO_MEM;
+    }
+    for (size_t i = 0; i < s_capacity; i++) {
+        if (s_slots[i].used) {
+            slots[find_slot(slots, capacity, s_slots[i].bssid)] = s_slots[i];
+        }
+    }
+    free(s_slots);
+    s_slots = slots;
+    s_capacity = capacity;
+    return ESP_OK;
+}
+
+/**
+ * @brief Remove the entry in a slot and close the gap in its probe run
+ *
+ * Each following entry moves into the hole unless its home slot lies
+ * between the hole and its current position, where lookups would no
+ * longer reach it.
+ *
+ * @param index Slot to clear
+ */
+static void remove_at(size_t index) {
+    size_t mask = s_capacity - 1;
+    size_t hole = index;
+    size_t j = index;
+    while (true) {
+        j = (j + 1) & mask;
+        if (!s_slots[j].used) {
+            break;
+        }
+        size_t home = bssid_hash(s_slots[j].bssid) & mask;
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            s_slots[hole] = s_slots[j];
+            hole = j;
+        }
+    }
+    memset(&s_slots[hole], 0, sizeof(ap_entry_t));
+    s_count--;
+}
+
+esp_err_t ap_table_init(size_t initial_capacity, uint32_t age_out_ms, uint8_t rssi_report_db) {
+    size_t capacity = 8;
+    while (capacity < initial_capacity) {
+        capacity *= 2;
+    }
+
+    free(s_slots);
+    s_slots = calloc(capacity, sizeof(ap_entry_t));
+    if (!s_slots) {
+        s_capacity = 0;
+        return ESP_ERR_NO_MEM;
+    }
+    s_capacity = capacity;
+    s_count = 0;
+    s_age_out_ms = age_out_ms;
+    s_rssi_report_db = rssi_report_db;
+    return ESP_OK;
+}
+
+esp_err_t ap_table_update(const wifi_ap_record_t *record, uint32_t now_ms) {
+    // Keep the load factor at or below 3/4 so probe runs stay short
+    if ((s_count + 1) * 4 > s_capacity * 3) {
+        esp_err_t ret = rehash(s_capacity * 2);
+        if (ret != ESP_OK) {
+            ESP_LOGW(TAG, "Cannot grow table beyond %u slots", (unsigned)s_capacity);
+            if (s_count + 1 >= s_capacity) {
+                return ret;
+            }
+        }
+    }
+
+    ap_entry_t *entry = &s_slots[find_slot(s_slots, s_capacity, record->bssid)];
+    if (!entry->used) {
+        memcpy(entry->bssid, record->bssid, 6);
+        entry->rssi_avg = record->rssi;
+        entry->used = 1;
+        entry->is_new = 1;
+        entry->channel = record->primary;
+        s_count++;
+    } else {
+        entry->rssi_avg += AP_TABLE_RSSI_EMA_WEIGHT * (record->rssi - entry->rssi_avg);
+        if (entry->channel != record->primary) {
+            entry->channel = record->primary;
+            entry->channel_changed = 1;
+        }
+    }
+
+    // Hidden networks can reveal their SSID later in a probe response
+    if (record->ssid[0] != '\0' || entry->is_new) {
+        memcpy(entry->ssid, record->ssid, sizeof(entry->ssid));
+        entry->ssid[sizeof(entry->ssid) - 1] = '\0';
+    }
+    entry->authmode = record->authmode;
+    entry->last_seen_ms = now_ms;
+    return ESP_OK;
+}
+
+void ap_table_report(uint32_t now_ms, ap_table_report_cb_t cb, void *ctx) {
+    size_t i = 0;
+    while (i < s_capacity) {
+        ap_entry_t *entry = &s_slots[i];
+        if (!entry->used) {
+            i++;
+            continue;
+        }
+
+        if (now_ms - entry->last_seen_ms >= s_age_out_ms) {
+            cb(AP_EVENT_LOST, entry, ctx);
+            // The shift may pull a later entry into this slot, so look at it again
+            remove_at(i);
+            continue;
+        }
+
+        int8_t rssi = (int8_t)lroundf(entry->rssi_avg);
+        if (entry->is_new) {
+            entry->rssi_reported = rssi;
+            cb(AP_EVENT_NEW, entry, ctx);
+        } else if (entry->channel_changed || abs(rssi - entry->rssi_reported) >= s_rssi_report_db) {
+            entry->rssi_reported = rssi;
+            cb(AP_EVENT_CHANGED, entry, ctx);
+        }
+        entry->is_new = 0;
+        entry->channel_changed = 0;
+        i++;
+    }
+}
+
+size_t ap_table_count(void) {
+    return s_count;
+}
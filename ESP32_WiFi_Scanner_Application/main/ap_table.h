@@ -0,0 +1,100 @@
+/**
+ * @file ap_table.h
+ * @brief Access point database for the continuous scanner
+ *
+ * Keeps every access point heard by the channel-hopping scanner in a hash
+ * table keyed by BSSID. Each entry holds an exponential moving average of the
+ * RSSI, the channel, and the time the AP was last heard. The table grows as
+ * needed, so the number of tracked APs is limited only by the heap.
+ *
+ * Instead of listing the whole table, ap_table_report() hands out the
+ * changes since the previous report: new APs, APs whose channel or averaged
+ * RSSI moved, and APs that were not heard for the age-out time.
+ */
+
+#ifndef AP_TABLE_H
+#define AP_TABLE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "esp_wifi_types.h"
+
+// Weight of a new RSSI sample in the moving average (1/4 smooths single-beacon fades)
+#define AP_TABLE_RSSI_EMA_WEIGHT    0.25f
+
+/**
+ * @brief Kind of change passed to the report callback
+ */
+typedef enum {
+    AP_EVENT_NEW,       // First heard since startup or since it aged out
+    AP_EVENT_CHANGED,   // Channel changed or the RSSI average moved past the report threshold
+    AP_EVENT_LOST,      // Not heard for the age-out time; removed after the callback
+} ap_event_t;
+
+/**
+ * @brief One tracked access point
+ */
+typedef struct {
+    uint8_t bssid[6];
+    char ssid[33];
+    uint8_t channel;
+    wifi_auth_mode_t authmode;
+    float rssi_avg;             // Moving average in dBm
+    int8_t rssi_reported;       // Average as of the last report, for delta detection
+    uint32_t last_seen_ms;
+    uint8_t used : 1;
+    uint8_t is_new : 1;         // Not reported yet
+    uint8_t channel_changed : 1;
+} ap_entry_t;
+
+/**
+ * @brief Called by ap_table_report() once per changed entry
+ *
+ * @param event What changed
+ * @param entry The entry; only valid during the call
+ * @param ctx User pointer given to ap_table_report()
+ */
+typedef void (*ap_table_report_cb_t)(ap_event_t event, const ap_entry_t *entry, void *ctx);
+
+/**
+ * @brief Allocate the table
+ *
+ * @param initial_capacity Starting number of slots (rounded up to a power of two)
+ * @param age_out_ms An AP not heard for this long is reported lost and removed
+ * @param rssi_report_db Change of the RSSI average that is worth reporting
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if the slots could not be allocated
+ */
+esp_err_t ap_table_init(size_t initial_capacity, uint32_t age_out_ms, uint8_t rssi_report_db);
+
+/**
+ * @brief Record one sighting of an access point
+ *
+ * Inserts the AP if it is unknown, otherwise folds the RSSI into the
+ * average and refreshes the last-seen time. The table doubles when it
+ * becomes more than 3/4 full.
+ *
+ * @param record Scan record of the AP
+ * @param now_ms Current time in milliseconds
+ * @return esp_err_t ESP_OK on success, ESP_ERR_NO_MEM if the table could not grow
+ */
+esp_err_t ap_table_update(const wifi_ap_record_t *record, uint32_t now_ms);
+
+/**
+ * @brief Report the changes since the last call and age out silent APs
+ *
+ * @param now_ms Current time in milliseconds
+ * @param cb Called for each new, changed or lost AP
+ * @param ctx Passed through to cb
+ */
+void ap_table_report(uint32_t now_ms, ap_table_report_cb_t cb, void *ctx);
+
+/**
+ * @brief Number of access points currently tracked
+ *
+ * @return size_t Entry count
+ */
+size_t ap_table_count(void);
+
+#endif // AP_TABLE_H
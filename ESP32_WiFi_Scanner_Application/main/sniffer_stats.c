@@ -0,0 +1,418 @@
+/**
+ * @file sniffer_stats.c
+ * @brief Promiscuous receive callback, per-core counters and the report task
+ *
+ * The WiFi driver calls the receive callback from its own task for every
+ * frame, so the callback must return quickly or the driver starts dropping
+ * frames on a busy channel. It only adds to counters owned by the core it
+ * runs on. Each counter has a single writer and is read with plain 32-bit
+ * loads, so no lock is needed on either side. The report task keeps a copy
+ * of the previous values and prints the differences.
+ *
+ * The BSSID table of each core fills up over time. When it is 3/4 full the
+ * report task asks the callback to clear it. Only the callback writes the
+ * table, so the reset happens inside the callback and the reporter sees it
+ * through the reset_ack counter.
+ */
+
+#include "sniffer_stats.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_wifi.h"
+#include "esp_log.h"
+
+#define SNIFFER_CHANNELS    14
+#define FRAME_TYPES         4       // Management, control, data, misc (wifi_promiscuous_pkt_type_t)
+#define BSSID_MAX_PROBES    16      // Bounds the work per frame when the table is crowded
+
+// Logging tag
+static const char *TAG = "Sniffer";
+
+/**
+ * @brief Traffic seen for one BSSID
+ */
+typedef struct {
+    uint8_t bssid[6];
+    uint8_t channel;        // 1-based
+    uint8_t used;           // Stored last, with release order, once bssid is written
+    uint32_t frames;
+    uint32_t bytes;
+    uint32_t rssi_neg_sum;  // Sum of -RSSI, for the average
+} bssid_counter_t;
+
+/**
+ * @brief Counters written by the receive callback running on one core
+ */
+typedef struct {
+    uint32_t frames[SNIFFER_CHANNELS][FRAME_TYPES];
+    uint32_t bytes[SNIFFER_CHANNELS];
+    uint32_t rssi_neg_sum[SNIFFER_CHANNELS];
+    uint32_t bssid_overflow;
+    uint32_t reset_ack;     // Equals reset_request once the BSSID table was cleared
+    bssid_counter_t bssids[SNIFFER_BSSID_SLOTS];
+} core_counters_t;
+
+/**
+ * @brief One line of the BSSID ranking
+ */
+typedef struct {
+    uint8_t bssid[6];
+    uint8_t channel;
+    uint32_t frames;
+    uint32_t bytes;
+    uint32_t rssi_neg_sum;
+} bssid_delta_t;
+
+// Written by the receive callback only, one set per core
+static core_counters_t s_counters[portNUM_PROCESSORS];
+// Written by the report task only
+static uint32_t s_reset_request[portNUM_PROCESSORS];
+static core_counters_t s_prev[portNUM_PROCESSORS];
+static uint32_t s_prev_dwell_ms[SNIFFER_CHANNELS];
+static bssid_delta_t s_deltas[portNUM_PROCESSORS * SNIFFER_BSSID_SLOTS];
+// Written by the channel hopping task only
+static uint32_t s_dwell_ms[SNIFFER_CHANNELS];
+
+/**
+ * @brief Add to a counter that has a single writer
+ *
+ * @param counter Counter to update
+ * @param n Amount to add
+ */
+static inline void counter_add(uint32_t *counter, uint32_t n) {
+    __atomic_store_n(counter, *counter + n, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Read a counter written by another task
+ *
+ * @param counter Counter to read
+ * @return uint32_t Current value
+ */
+static inline uint32_t counter_load(const uint32_t *counter) {
+    return __atomic_load_n(counter, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Find the BSSID of an 802.11 frame
+ *
+ * Management frames carry it in address 3. For data frames the position
+ * depends on the ToDS/FromDS bits. Control frames and frames between two
+ * APs (both bits set) are not attributed to a BSSID.
+ *
+ * @param frame Frame starting at the MAC header
+ * @param type Frame type reported by the driver
+ * @param len Frame length
+ * @return const uint8_t* BSSID, or NULL
+ */
+static const uint8_t *frame_bssid(const uint8_t *frame, wifi_promiscuous_pkt_type_t type, uint32_t len) {
+    if (len < 24) {
+        return NULL;
+    }
+    if (type == WIFI_PKT_MGMT) {
+        return frame + 16;
+    }
+    if (type == WIFI_PKT_DATA) {
+        switch (frame[1] & 0x03) {
+            case 0:  return frame + 16;    // Ad hoc / direct link: address 3
+            case 1:  return frame + 4;     // ToDS: address 1
+            case 2:  return frame + 10;    // FromDS: address 2
+            default: return NULL;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Count a frame for its BSSID, inserting the BSSID if needed
+ *
+ * @param counters Counters of the current core
+ * @param bssid BSSID of the frame
+ * @param channel 1-based channel
+ * @param len Frame length
+ * @param rssi_neg Negated RSSI
+ */
+static void count_bssid(core_counters_t *counters, const uint8_t *bssid, uint8_t channel,
+                        uint32_t len, uint32_t rssi_neg) {
+    uint32_t key = ((uint32_t)bssid[2] << 24) | ((uint32_t)bssid[3] << 16) |
+                   ((uint32_t)bssid[4] << 8) | bssid[5];
+    size_t index = (key * 2654435761u) % SNIFFER_BSSID_SLOTS;
+
+    for (int probe = 0; probe < BSSID_MAX_PROBES; probe++) {
+        bssid_counter_t *slot = &counters->bssids[index];
+        if (!slot->used) {
+            memcpy(slot->bssid, bssid, 6);
+            slot->channel = channel;
+            __atomic_store_n(&slot->used, 1, __ATOMIC_RELEASE);
+        }
+        if (memcmp(slot->bssid, bssid, 6) == 0) {
+            counter_add(&slot->frames, 1);
+            counter_add(&slot->bytes, len);
+            counter_add(&slot->rssi_neg_sum, rssi_neg);
+            return;
+        }
+        index = (index + 1) % SNIFFER_BSSID_SLOTS;
+    }
+    counter_add(&counters->bssid_overflow, 1);
+}
+
+/**
+ * @brief Promiscuous receive callback
+ *
+ * Runs in the WiFi driver task for every frame and only updates counters.
+ *
+ * @param buf wifi_promiscuous_pkt_t of the frame
+ * @param type Frame type
+ */
+static void sniffer_rx_cb(void *buf, wifi_promiscuous_pkt_type_t type) {
+    const wifi_promiscuous_pkt_t *pkt = (const wifi_promiscuous_pkt_t *)buf;
+    int core = xPortGetCoreID();
+    core_counters_t *counters = &s_counters[core];
+
+    uint8_t channel = pkt->rx_ctrl.channel;
+    if (channel < 1 || channel > SNIFFER_CHANNELS || (int)type >= FRAME_TYPES) {
+        return;
+    }
+
+    uint32_t request = __atomic_load_n(&s_reset_request[core], __ATOMIC_ACQUIRE);
+    if (counters->reset_ack != request) {
+        memset(counters->bssids, 0, sizeof(counters->bssids));
+        counters->bssid_overflow = 0;
+        __atomic_store_n(&counters->reset_ack, request, __ATOMIC_RELEASE);
+    }
+
+    uint32_t len = pkt->rx_ctrl.sig_len;
+    uint32_t rssi_neg = (uint32_t)(-pkt->rx_ctrl.rssi);
+    counter_add(&counters->frames[channel - 1][type], 1);
+    counter_add(&counters->bytes[channel - 1], len);
+    counter_add(&counters->rssi_neg_sum[channel - 1], rssi_neg);
+
+    const uint8_t *bssid = frame_bssid(pkt->payload, type, len);
+    // Group addresses show up as address 3 of broadcast probe requests
+    if (bssid != NULL && !(bssid[0] & 0x01)) {
+        count_bssid(counters, bssid, channel, len, rssi_neg);
+    }
+}
+
+/**
+ * @brief Collect the BSSID traffic of one core since the last report
+ *
+ * @param core Core whose table is read
+ * @param count Number of entries already in s_deltas; updated
+ * @return uint32_t Frames that did not fit in the table
+ */
+static uint32_t collect_bssids(int core, size_t *count) {
+    core_counters_t *counters = &s_counters[core];
+    core_counters_t *prev = &s_prev[core];
+
+    uint32_t ack = __atomic_load_n(&counters->reset_ack, __ATOMIC_ACQUIRE);
+    if (ack != prev->reset_ack) {
+        // Cleared since the last report; everything in the table is new
+        memset(prev->bssids, 0, sizeof(prev->bssids));
+        prev->bssid_overflow = 0;
+        prev->reset_ack = ack;
+    }
+
+    size_t used = 0;
+    size_t first = *count;
+    for (size_t i = 0; i < SNIFFER_BSSID_SLOTS; i++) {
+        bssid_counter_t *slot = &counters->bssids[i];
+        if (!__atomic_load_n(&slot->used, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+        used++;
+        uint32_t frames = counter_load(&slot->frames);
+        uint32_t bytes = counter_load(&slot->bytes);
+        uint32_t rssi = counter_load(&slot->rssi_neg_sum);
+        if (frames != prev->bssids[i].frames) {
+            bssid_delta_t *delta = &s_deltas[(*count)++];
+            memcpy(delta->bssid, slot->bssid, 6);
+            delta->channel = slot->channel;
+            delta->frames = frames - prev->bssids[i].frames;
+            delta->bytes = bytes - prev->bssids[i].bytes;
+            delta->rssi_neg_sum = rssi - prev->bssids[i].rssi_neg_sum;
+        }
+        prev->bssids[i].frames = frames;
+        prev->bssids[i].bytes = bytes;
+        prev->bssids[i].rssi_neg_sum = rssi;
+    }
+    uint32_t overflow = counter_load(&counters->bssid_overflow);
+    uint32_t overflow_delta = overflow - prev->bssid_overflow;
+    prev->bssid_overflow = overflow;
+
+    if (__atomic_load_n(&counters->reset_ack, __ATOMIC_ACQUIRE) != ack) {
+        // Cleared while being read: drop this core's BSSIDs for this interval
+        *count = first;
+        memset(prev->bssids, 0, sizeof(prev->bssids));
+        prev->bssid_overflow = 0;
+        prev->reset_ack = __atomic_load_n(&counters->reset_ack, __ATOMIC_ACQUIRE);
+        return 0;
+    }
+    if (used * 4 >= SNIFFER_BSSID_SLOTS * 3) {
+        __atomic_store_n(&s_reset_request[core], s_reset_request[core] + 1, __ATOMIC_RELEASE);
+    }
+    return overflow_delta;
+}
+
+/**
+ * @brief Print the traffic per channel and the busiest BSSIDs since the last report
+ *
+ * Rates are per second of listening time on the channel, not per second of
+ * wall time, since the radio only spends part of each sweep on a channel.
+ */
+static void sniffer_report(void) {
+    uint32_t channel_frames[SNIFFER_CHANNELS] = { 0 };
+    bool header = false;
+
+    for (int ch = 0; ch < SNIFFER_CHANNELS; ch++) {
+        uint32_t dwell = counter_load(&s_dwell_ms[ch]);
+        uint32_t dwell_ms = dwell - s_prev_dwell_ms[ch];
+        s_prev_dwell_ms[ch] = dwell;
+
+        uint32_t frames[FRAME_TYPES] = { 0 };
+        uint32_t bytes = 0;
+        uint32_t rssi_neg_sum = 0;
+        for (int core = 0; core < portNUM_PROCESSORS; core++) {
+            core_counters_t *counters = &s_counters[core];
+            core_counters_t *prev = &s_prev[core];
+            for (int t = 0; t < FRAME_TYPES; t++) {
+                uint32_t v = counter_load(&counters->frames[ch][t]);
+                frames[t] += v - prev->frames[ch][t];
+                prev->frames[ch][t] = v;
+            }
+            uint32_t v = counter_load(&counters->bytes[ch]);
+            bytes += v - prev->bytes[ch];
+            prev->bytes[ch] = v;
+            v = counter_load(&counters->rssi_neg_sum[ch]);
+            rssi_neg_sum += v - prev->rssi_neg_sum[ch];
+            prev->rssi_neg_sum[ch] = v;
+        }
+        if (dwell_ms == 0) {
+            continue;
+        }
+
+        uint32_t total = frames[WIFI_PKT_MGMT] + frames[WIFI_PKT_CTRL] + frames[WIFI_PKT_DATA] +
+                         frames[WIFI_PKT_MISC];
+        channel_frames[ch] = total;
+        if (!header) {
+            printf("\n── Channel traffic (per second of listening) ──\n");
+            header = true;
+        }
+        printf("ch %2d: %6lu fr/s  (mgmt %lu, ctrl %lu, data %lu)  %7.1f kB/s",
+               ch + 1, (unsigned long)((uint64_t)total * 1000 / dwell_ms),
+               (unsigned long)((uint64_t)frames[WIFI_PKT_MGMT] * 1000 / dwell_ms),
+               (unsigned long)((uint64_t)frames[WIFI_PKT_CTRL] * 1000 / dwell_ms),
+               (unsigned long)((uint64_t)frames[WIFI_PKT_DATA] * 1000 / dwell_ms),
+               (double)bytes / dwell_ms);
+        if (total > 0) {
+            printf("  avg %d dBm", -(int)(rssi_neg_sum / total));
+        }
+        printf("\n");
+    }
+    if (!header) {
+        return;
+    }
+
+    size_t count = 0;
+    uint32_t overflow = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        overflow += collect_bssids(core, &count);
+    }
+
+    // Merge BSSIDs that were counted on both cores
+    for (size_t i = 0; i < count; i++) {
+        for (size_t j = i + 1; j < count; j++) {
+            if (memcmp(s_deltas[i].bssid, s_deltas[j].bssid, 6) == 0) {
+                s_deltas[i].frames += s_deltas[j].frames;
+                s_deltas[i].bytes += s_deltas[j].bytes;
+                s_deltas[i].rssi_neg_sum += s_deltas[j].rssi_neg_sum;
+                s_deltas[j--] = s_deltas[--count];
+            }
+        }
+    }
+
+    printf("── Busiest BSSIDs ──\n");
+    for (int rank = 0; rank < SNIFFER_TOP_BSSIDS && (size_t)rank < count; rank++) {
+        // Selection sort, stopped after the entries that get printed
+        size_t best = rank;
+        for (size_t i = rank + 1; i < count; i++) {
+            if (s_deltas[i].frames > s_deltas[best].frames) {
+                best = i;
+            }
+        }
+        bssid_delta_t top = s_deltas[best];
+        s_deltas[best] = s_deltas[rank];
+        s_deltas[rank] = top;
+
+        uint32_t on_channel = channel_frames[top.channel - 1];
+        printf("%02x:%02x:%02x:%02x:%02x:%02x  ch %2d  %6lu frames (%3lu%% of channel)  %7.1f kB  avg %d dBm\n",
+               top.bssid[0], top.bssid[1], top.bssid[2], top.bssid[3], top.bssid[4], top.bssid[5],
+               top.channel, (unsigned long)top.frames,
+               (unsigned long)(on_channel ? (uint64_t)top.frames * 100 / on_channel : 0),
+               top.bytes / 1024.0, -(int)(top.rssi_neg_sum / top.frames));
+    }
+    if (overflow > 0) {
+        ESP_LOGW(TAG, "%lu frames from BSSIDs beyond the table size", (unsigned long)overflow);
+    }
+}
+
+/**
+ * @brief Low-priority task printing the statistics every SNIFFER_REPORT_MS
+ *
+ * @param pvParameters Task parameters (unused)
+ */
+static void sniffer_report_task(void *pvParameters) {
+    TickType_t last_wake = xTaskGetTickCount();
+    while (1) {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(SNIFFER_REPORT_MS));
+        sniffer_report();
+    }
+}
+
+esp_err_t sniffer_stats_init(void) {
+    wifi_promiscuous_filter_t filter = {
+        .filter_mask = WIFI_PROMIS_FILTER_MASK_MGMT | WIFI_PROMIS_FILTER_MASK_CTRL |
+                       WIFI_PROMIS_FILTER_MASK_DATA,
+    };
+    esp_err_t ret = esp_wifi_set_promiscuous_filter(&filter);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to set promiscuous filter: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    // Control frames are filtered separately; count all subtypes
+    wifi_promiscuous_filter_t ctrl_filter = {
+        .filter_mask = WIFI_PROMIS_CTRL_FILTER_MASK_ALL,
+    };
+    esp_wifi_set_promiscuous_ctrl_filter(&ctrl_filter);
+
+    ret = esp_wifi_set_promiscuous_rx_cb(sniffer_rx_cb);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to register promiscuous callback: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    if (xTaskCreate(sniffer_report_task, "sniffer_report", SNIFFER_REPORT_TASK_STACK, NULL,
+                    SNIFFER_REPORT_TASK_PRIO, NULL) != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create report task");
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+esp_err_t sniffer_stats_start(void) {
+    return esp_wifi_set_promiscuous(true);
+}
+
+void sniffer_stats_stop(void) {
+    esp_wifi_set_promiscuous(false);
+}
+
+void sniffer_stats_add_dwell(uint8_t channel, uint32_t ms) {
+    if (channel >= 1 && channel <= SNIFFER_CHANNELS) {
+        counter_add(&s_dwell_ms[channel - 1], ms);
+    }
+}
@@ -0,0 +1,63 @@
+/**
+ * @file sniffer_stats.h
+ * @brief Promiscuous-mode frame statistics for channel selection
+ *
+ * While promiscuous mode is on, every received frame is counted by type,
+ * channel and BSSID. The receive callback only increments counters. Each
+ * core has its own set, so the callback takes no lock and never waits for
+ * the reporter. A low-priority task reads the counters periodically and
+ * prints per-channel traffic and the busiest BSSIDs for the interval.
+ *
+ * Channel hopping stays with the caller: it tunes the radio, sniffs for a
+ * while and reports the time spent with sniffer_stats_add_dwell(), which
+ * turns the frame counts into per-second rates.
+ */
+
+#ifndef SNIFFER_STATS_H
+#define SNIFFER_STATS_H
+
+#include <stdint.h>
+#include "esp_err.h"
+
+// BSSIDs tracked per core; further BSSIDs are counted as overflow until the next reset
+#define SNIFFER_BSSID_SLOTS         128
+
+// Reporting
+#define SNIFFER_REPORT_MS           10000   // Statistics interval
+#define SNIFFER_TOP_BSSIDS          5       // Busiest BSSIDs listed per report
+#define SNIFFER_REPORT_TASK_STACK   4096
+#define SNIFFER_REPORT_TASK_PRIO    1       // Below the scanner, just above idle
+
+/**
+ * @brief Register the promiscuous callback and start the report task
+ *
+ * WiFi must be initialized and started. Promiscuous mode stays off until
+ * sniffer_stats_start().
+ *
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t sniffer_stats_init(void);
+
+/**
+ * @brief Turn promiscuous mode on; frames are counted from now on
+ *
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+esp_err_t sniffer_stats_start(void);
+
+/**
+ * @brief Turn promiscuous mode off, e.g. before a scan
+ */
+void sniffer_stats_stop(void);
+
+/**
+ * @brief Add time spent listening on a channel
+ *
+ * Call from a single task (the one that hops channels).
+ *
+ * @param channel Channel the radio was tuned to (1-14)
+ * @param ms Time spent there with promiscuous mode on
+ */
+void sniffer_stats_add_dwell(uint8_t channel, uint32_t ms);
+
+#endif // SNIFFER_STATS_H
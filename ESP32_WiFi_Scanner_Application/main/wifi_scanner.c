@@ -13,6 +13,10 @@
  * - Proper resource management and error handling
  * - FreeRTOS task-based architecture
  * - Memory-safe operations with bounds checking
+ * - Continuous mode: passive one-channel-at-a-time scanning into an AP
+ *   database, reporting only new, changed and lost access points
+ * - Optional promiscuous capture between sweeps for per-channel and
+ *   per-BSSID traffic statistics
  * 
  * Hardware Requirements:
  * - ESP32 development board with WiFi capability
@@ -26,6 +30,7 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <math.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
@@ -34,12 +39,28 @@
 #include "esp_event.h"
 #include "nvs_flash.h"
 #include "esp_netif.h"
+#include "esp_timer.h"
+#include "ap_table.h"
+#include "sniffer_stats.h"
 
 // Configuration constants
 #define WIFI_SCAN_INTERVAL_MS    10000  // Scan every 10 seconds
 #define MAX_AP_COUNT            20      // Maximum number of APs to scan
 #define SCAN_TIMEOUT_MS         5000    // Timeout for scan operation
 
+// Continuous scanner configuration
+#define CONTINUOUS_SCAN_MODE    1       // 1: hop channels passively and report changes, 0: periodic full scans
+#define SCAN_CHANNEL_FIRST      1
+#define SCAN_CHANNEL_LAST       13      // 11 in the US, 13 in most other regions
+#define CHANNEL_DWELL_MS        120     // Passive listen per channel; beacons come every ~102 ms
+#define AP_TABLE_INITIAL_SLOTS  32      // Grows on demand, there is no upper limit
+#define AP_AGE_OUT_MS           60000   // Report an AP as lost after this long without a beacon
+#define AP_RSSI_REPORT_DB       5       // Report an AP again when its average RSSI moves this much
+
+// Traffic statistics (continuous mode only)
+#define SNIFFER_STATS_ENABLE    0       // 1: after each scan sweep, sniff every channel in promiscuous mode
+#define SNIFFER_DWELL_MS        250     // Capture time per channel
+
 // FreeRTOS task configuration
 #define WIFI_SCANNER_TASK_STACK_SIZE    4096
 #define WIFI_SCANNER_TASK_PRIORITY      5
@@ -74,6 +95,7 @@ static const char* get_auth_mode_string(wifi_auth_mode_t authmode) {
     }
 }
 
+#if !CONTINUOUS_SCAN_MODE
 /**
  * @brief Convert RSSI value to signal strength description
  * 
@@ -212,6 +234,131 @@ static esp_err_t perform_wifi_scan(void) {
     
     return ESP_OK;
 }
+#endif
+
+#if CONTINUOUS_SCAN_MODE
+/**
+ * @brief Print one change reported by the AP table
+ * 
+ * Called by ap_table_report() for each access point that appeared, moved
+ * or disappeared since the previous sweep, as a single line per AP.
+ * 
+ * @param event Kind of change
+ * @param entry The access point
+ * @param ctx Pointer to an int[3] of new/changed/lost counters
+ */
+static void print_ap_event(ap_event_t event, const ap_entry_t *entry, void *ctx) {
+    int *counts = (int *)ctx;
+    static const char *const labels[] = { "+ NEW ", "~ MOVE", "- LOST" };
+
+    char bssid_str[18];
+    snprintf(bssid_str, sizeof(bssid_str), "%02x:%02x:%02x:%02x:%02x:%02x",
+             entry->bssid[0], entry->bssid[1], entry->bssid[2],
+             entry->bssid[3], entry->bssid[4], entry->bssid[5]);
+
+    printf("%s %s  ch %2d  %4d dBm  %-15s  %s\n", labels[event], bssid_str, entry->channel,
+           (int)lroundf(entry->rssi_avg), get_auth_mode_string(entry->authmode),
+           entry->ssid[0] ? entry->ssid : "<hidden>");
+    counts[event]++;
+}
+
+/**
+ * @brief Listen passively on one channel and feed every AP heard into the table
+ * 
+ * The radio stays on the channel for CHANNEL_DWELL_MS and only collects
+ * beacons, so no probe requests are sent. The results are read one record
+ * at a time, which keeps the memory use constant however many APs answer.
+ * 
+ * @param channel Channel to scan
+ * @return esp_err_t ESP_OK on success, error code on failure
+ */
+static esp_err_t scan_channel(uint8_t channel) {
+    wifi_scan_config_t scan_config = {
+        .channel = channel,
+        .show_hidden = true,
+        .scan_type = WIFI_SCAN_TYPE_PASSIVE,
+        .scan_time = {
+            .passive = CHANNEL_DWELL_MS
+        }
+    };
+
+    esp_err_t ret = esp_wifi_scan_start(&scan_config, true);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to scan channel %d: %s", channel, esp_err_to_name(ret));
+        return ret;
+    }
+
+    uint16_t ap_count = 0;
+    esp_wifi_scan_get_ap_num(&ap_count);
+
+    uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    wifi_ap_record_t record;
+    for (uint16_t i = 0; i < ap_count; i++) {
+        if (esp_wifi_scan_get_ap_record(&record) != ESP_OK) {
+            break;
+        }
+        if (ap_table_update(&record, now_ms) != ESP_OK) {
+            ESP_LOGW(TAG, "AP table full, dropping the rest of channel %d", channel);
+            break;
+        }
+    }
+
+    // Free whatever was not read back
+    esp_wifi_clear_ap_list();
+    return ESP_OK;
+}
+
+#if SNIFFER_STATS_ENABLE
+/**
+ * @brief Capture traffic on every channel in turn
+ * 
+ * Promiscuous mode is only on during this sweep, since it would disturb
+ * the scans. The frames are counted by sniffer_stats.c; this function just
+ * tunes the radio and records how long it listened on each channel.
+ */
+static void sniffer_sweep(void) {
+    if (sniffer_stats_start() != ESP_OK) {
+        return;
+    }
+    for (uint8_t channel = SCAN_CHANNEL_FIRST; channel <= SCAN_CHANNEL_LAST; channel++) {
+        if (esp_wifi_set_channel(channel, WIFI_SECOND_CHAN_NONE) != ESP_OK) {
+            continue;
+        }
+        int64_t start_us = esp_timer_get_time();
+        vTaskDelay(pdMS_TO_TICKS(SNIFFER_DWELL_MS));
+        sniffer_stats_add_dwell(channel, (uint32_t)((esp_timer_get_time() - start_us) / 1000));
+    }
+    sniffer_stats_stop();
+}
+#endif
+
+/**
+ * @brief Sweep all channels once, then print the changes since the last sweep
+ * 
+ * A sweep takes about (SCAN_CHANNEL_LAST - SCAN_CHANNEL_FIRST + 1) *
+ * CHANNEL_DWELL_MS, during which the radio is never away from any one
+ * channel for longer than a single dwell.
+ * 
+ * @param sweep Sweep number, for the summary line
+ */
+static void continuous_scan_sweep(uint32_t sweep) {
+    for (uint8_t channel = SCAN_CHANNEL_FIRST; channel <= SCAN_CHANNEL_LAST; channel++) {
+        scan_channel(channel);
+    }
+
+    int counts[3] = { 0 };
+    ap_table_report((uint32_t)(esp_timer_get_time() / 1000), print_ap_event, counts);
+    if (counts[AP_EVENT_NEW] || counts[AP_EVENT_CHANGED] || counts[AP_EVENT_LOST]) {
+        ESP_LOGI(TAG, "Sweep %lu: %u APs tracked, %d new, %d changed, %d lost", (unsigned long)sweep,
+                 (unsigned)ap_table_count(), counts[AP_EVENT_NEW], counts[AP_EVENT_CHANGED],
+                 counts[AP_EVENT_LOST]);
+    }
+
+#if SNIFFER_STATS_ENABLE
+    sniffer_sweep();
+#endif
+}
+#endif
 
 /**
  * @brief Initialize WiFi subsystem for scanning operations
@@ -316,6 +463,28 @@ static void wifi_scanner_task(void *pvParameters) {
         return;
     }
     
+#if CONTINUOUS_SCAN_MODE
+    ret = ap_table_init(AP_TABLE_INITIAL_SLOTS, AP_AGE_OUT_MS, AP_RSSI_REPORT_DB);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to allocate AP table, terminating task");
+        vTaskDelete(NULL);
+        return;
+    }
+
+#if SNIFFER_STATS_ENABLE
+    ret = sniffer_stats_init();
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to set up traffic statistics, terminating task");
+        vTaskDelete(NULL);
+        return;
+    }
+#endif
+
+    // Back-to-back sweeps; each channel scan blocks only for its own dwell time
+    for (uint32_t sweep = 1; ; sweep++) {
+        continuous_scan_sweep(sweep);
+    }
+#else
     // Main scanning loop
     while (1) {
         ESP_LOGI(TAG, "═══ Starting new scan cycle ═══");
@@ -331,6 +500,7 @@ static void wifi_scanner_task(void *pvParameters) {
         // Wait for the configured interval before next scan
         vTaskDelay(pdMS_TO_TICKS(WIFI_SCAN_INTERVAL_MS));
     }
+#endif
 }
 
 /**
@@ -342,8 +512,13 @@ static void wifi_scanner_task(void *pvParameters) {
  */
 void app_main(void) {
     ESP_LOGI(TAG, "ESP32 WiFi Scanner Application Starting...");
+#if CONTINUOUS_SCAN_MODE
+    ESP_LOGI(TAG, "Continuous passive scan: channels %d-%d, %d ms per channel",
+             SCAN_CHANNEL_FIRST, SCAN_CHANNEL_LAST, CHANNEL_DWELL_MS);
+#else
     ESP_LOGI(TAG, "Scan interval: %d seconds", WIFI_SCAN_INTERVAL_MS / 1000);
     ESP_LOGI(TAG, "Maximum APs to display: %d", MAX_AP_COUNT);
+#endif
     
     // Create WiFi scanner task
     BaseType_t task_created = xTaskCreate(
@@ -0,0 +1,239 @@
+/**
+ * @file coop_sched.c
+ * @brief Run-to-completion event scheduler (see coop_sched.h).
+ *
+ * One FreeRTOS queue per priority class holds the pending events. Posting
+ * wakes the loop task with a task notification; the loop then drains the
+ * queues highest class first, one event per dispatch, and goes back to the
+ * highest class after every dispatch so a burst of low-priority work cannot
+ * hold up a high-priority event by more than one slice.
+ */
+
+#include "coop_sched.h"
+
+#include <inttypes.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/queue.h"
+#include "freertos/task.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#define TAG "coop_sched"
+
+static const coop_handler_desc_t *s_handlers = NULL;
+static size_t s_handler_count = 0;
+static coop_type_stats_t *s_stats = NULL;
+
+static QueueHandle_t s_queues[COOP_PRIO_COUNT];
+static TaskHandle_t s_loop_task = NULL;
+
+/*
+ * A continuation that did not fit back into its full queue. It runs before
+ * the rest of its class so the job is never lost.
+ */
+static coop_event_t s_carry[COOP_PRIO_COUNT];
+static bool s_carry_valid[COOP_PRIO_COUNT];
+
+static const char *const k_prio_names[COOP_PRIO_COUNT] = { "high", "normal", "low" };
+
+esp_err_t coop_sched_init(const coop_handler_desc_t *handlers, size_t handler_count, size_t queue_len)
+{
+    if (handlers == NULL || handler_count == 0 || handler_count > UINT16_MAX || queue_len == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t i = 0; i < handler_count; i++) {
+        if (handlers[i].handler == NULL || handlers[i].prio >= COOP_PRIO_COUNT) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    s_stats = calloc(handler_count, sizeof(coop_type_stats_t));
+    if (s_stats == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    for (int p = 0; p < COOP_PRIO_COUNT; p++) {
+        s_queues[p] = xQueueCreate(queue_len, sizeof(coop_event_t));
+        if (s_queues[p] == NULL) {
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    s_handlers = handlers;
+    s_handler_count = handler_count;
+
+    return ESP_OK;
+}
+
+bool coop_sched_post(uint16_t type, uint32_t arg)
+{
+    if (type >= s_handler_count) {
+        return false;
+    }
+
+    coop_event_t e = {
+        .type = type,
+        .step = 0,
+        .arg = arg,
+        .post_us = esp_timer_get_time(),
+    };
+
+    if (xQueueSend(s_queues[s_handlers[type].prio], &e, 0) != pdTRUE) {
+        return false;
+    }
+
+    if (s_loop_task != NULL) {
+        xTaskNotifyGive(s_loop_task);
+    }
+
+    return true;
+}
+
+bool coop_sched_post_from_isr(uint16_t type, uint32_t arg, BaseType_t *higher_prio_task_woken)
+{
+    if (type >= s_handler_count) {
+        return false;
+    }
+
+    coop_event_t e = {
+        .type = type,
+        .step = 0,
+        .arg = arg,
+        .post_us = esp_timer_get_time(),
+    };
+
+    if (xQueueSendFromISR(s_queues[s_handlers[type].prio], &e, higher_prio_task_woken) != pdTRUE) {
+        return false;
+    }
+
+    if (s_loop_task != NULL) {
+        vTaskNotifyGiveFromISR(s_loop_task, higher_prio_task_woken);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Take the next event to dispatch, highest priority class first.
+ *
+ * Args:
+ *   e: Receives the event.
+ *
+ * Returns:
+ *   true if an event was taken, false if every class is empty.
+ */
+static bool coop_sched_next(coop_event_t *e)
+{
+    for (int p = 0; p < COOP_PRIO_COUNT; p++) {
+        if (s_carry_valid[p]) {
+            *e = s_carry[p];
+            s_carry_valid[p] = false;
+            return true;
+        }
+
+        if (xQueueReceive(s_queues[p], e, 0) == pdTRUE) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Run one slice of an event and account for it.
+ *
+ * Args:
+ *   e: Event to dispatch; updated by the handler.
+ *
+ * Returns:
+ *   None
+ */
+static void coop_sched_dispatch(coop_event_t *e)
+{
+    const coop_handler_desc_t *desc = &s_handlers[e->type];
+    coop_type_stats_t *st = &s_stats[e->type];
+
+    const int64_t start_us = esp_timer_get_time();
+
+    // Latency is measured to the first slice only; continuations wait by design
+    if (e->step == 0) {
+        uint32_t latency_us = (uint32_t)(start_us - e->post_us);
+        st->started++;
+        st->latency_sum_us += latency_us;
+        if (latency_us > st->latency_max_us) {
+            st->latency_max_us = latency_us;
+        }
+    }
+
+    const coop_result_t result = desc->handler(e);
+    const uint32_t exec_us = (uint32_t)(esp_timer_get_time() - start_us);
+
+    st->slices++;
+    if (exec_us > st->exec_max_us) {
+        st->exec_max_us = exec_us;
+    }
+
+    if (desc->budget_us > 0 && exec_us > desc->budget_us) {
+        st->overruns++;
+        ESP_LOGW(TAG, "overrun: %s step=%u took %" PRIu32 " us (budget %" PRIu32 " us)",
+                 desc->name, (unsigned)e->step, exec_us, desc->budget_us);
+    }
+
+    if (result != COOP_CONTINUE) {
+        st->events++;
+        return;
+    }
+
+    // Back of its class, so other events of the same class get a turn
+    if (xQueueSend(s_queues[desc->prio], e, 0) != pdTRUE) {
+        s_carry[desc->prio] = *e;
+        s_carry_valid[desc->prio] = true;
+    }
+}
+
+void coop_sched_log_stats(void)
+{
+    for (size_t t = 0; t < s_handler_count; t++) {
+        coop_type_stats_t *st = &s_stats[t];
+        const coop_handler_desc_t *desc = &s_handlers[t];
+
+        uint32_t latency_avg_us = (st->started > 0) ? (uint32_t)(st->latency_sum_us / st->started) : 0;
+
+        ESP_LOGI(TAG, "%-8s prio=%-6s events=%" PRIu32 " slices=%" PRIu32
+                 " latency avg/max=%" PRIu32 "/%" PRIu32 " us exec max=%" PRIu32 " us"
+                 " budget=%" PRIu32 " us overruns=%" PRIu32,
+                 desc->name, k_prio_names[desc->prio], st->events, st->slices,
+                 latency_avg_us, st->latency_max_us, st->exec_max_us,
+                 desc->budget_us, st->overruns);
+
+        memset(st, 0, sizeof(*st));
+    }
+}
+
+void coop_sched_run(uint32_t stats_period_ms)
+{
+    s_loop_task = xTaskGetCurrentTaskHandle();
+
+    TickType_t last_stats = xTaskGetTickCount();
+    const TickType_t stats_period = pdMS_TO_TICKS(stats_period_ms);
+
+    while (true) {
+        coop_event_t e;
+
+        if (coop_sched_next(&e)) {
+            coop_sched_dispatch(&e);
+        } else {
+            // Events posted before this task registered are found on the next pass
+            ulTaskNotifyTake(pdTRUE, (stats_period > 0) ? stats_period : portMAX_DELAY);
+        }
+
+        if (stats_period > 0 && (xTaskGetTickCount() - last_stats) >= stats_period) {
+            last_stats = xTaskGetTickCount();
+            coop_sched_log_stats();
+        }
+    }
+}
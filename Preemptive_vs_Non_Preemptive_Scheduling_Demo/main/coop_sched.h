@@ -0,0 +1,154 @@
+/**
+ * @file coop_sched.h
+ * @brief Run-to-completion event scheduler for running many small jobs on one task stack.
+ *
+ * Handlers are registered once in a table indexed by event type. Each type
+ * belongs to a priority class; the scheduler always dispatches the oldest
+ * event of the highest non-empty class. Handlers run to completion, but a
+ * long job can return COOP_CONTINUE to be re-queued behind the events of its
+ * class and resume later from event->step. Every dispatch is timed against
+ * the handler's budget, and queue latency is tracked per event type.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "esp_err.h"
+
+/**
+ * @brief Priority classes, highest first.
+ */
+typedef enum {
+    COOP_PRIO_HIGH = 0,
+    COOP_PRIO_NORMAL,
+    COOP_PRIO_LOW,
+    COOP_PRIO_COUNT,
+} coop_prio_t;
+
+/**
+ * @brief What a handler asks the scheduler to do after it returns.
+ */
+typedef enum {
+    COOP_DONE = 0,      /* The event is finished */
+    COOP_CONTINUE,      /* Re-queue the event; the handler has advanced event->step */
+} coop_result_t;
+
+/**
+ * @brief An event as seen by its handler.
+ *
+ * Fields:
+ *   type: Index into the handler table.
+ *   step: 0 on the first dispatch; a handler that returns COOP_CONTINUE sets
+ *         it to where the next slice should resume.
+ *   arg: Value passed to coop_sched_post().
+ *   post_us: Time the event was posted (esp_timer clock).
+ */
+typedef struct {
+    uint16_t type;
+    uint16_t step;
+    uint32_t arg;
+    int64_t post_us;
+} coop_event_t;
+
+typedef coop_result_t (*coop_handler_t)(coop_event_t *event);
+
+/**
+ * @brief Static description of one event type.
+ *
+ * Fields:
+ *   name: Short name used in logs.
+ *   handler: Function that processes the event.
+ *   prio: Priority class of the event type.
+ *   budget_us: Longest a single dispatch may take before it is logged as an overrun.
+ */
+typedef struct {
+    const char *name;
+    coop_handler_t handler;
+    coop_prio_t prio;
+    uint32_t budget_us;
+} coop_handler_desc_t;
+
+/**
+ * @brief Per-type statistics since the last coop_sched_log_stats().
+ *
+ * Fields:
+ *   started: Events that had their first slice.
+ *   events: Events completed.
+ *   slices: Dispatches, including continuations.
+ *   overruns: Dispatches that exceeded the budget.
+ *   latency_max_us: Longest time from post to first dispatch.
+ *   latency_sum_us: Sum of those times, for the average.
+ *   exec_max_us: Longest single dispatch.
+ */
+typedef struct {
+    uint32_t started;
+    uint32_t events;
+    uint32_t slices;
+    uint32_t overruns;
+    uint32_t latency_max_us;
+    uint64_t latency_sum_us;
+    uint32_t exec_max_us;
+} coop_type_stats_t;
+
+/**
+ * @brief Create the scheduler queues.
+ *
+ * Args:
+ *   handlers: Handler table; must stay valid for the lifetime of the scheduler.
+ *   handler_count: Number of entries, which is also the number of event types.
+ *   queue_len: Capacity of each priority class queue.
+ *
+ * Returns:
+ *   ESP_OK, ESP_ERR_INVALID_ARG for a bad table or ESP_ERR_NO_MEM.
+ */
+esp_err_t coop_sched_init(const coop_handler_desc_t *handlers, size_t handler_count, size_t queue_len);
+
+/**
+ * @brief Post an event from task or timer context without blocking.
+ *
+ * Args:
+ *   type: Event type.
+ *   arg: Value handed to the handler in event->arg.
+ *
+ * Returns:
+ *   true if the event was queued, false if its class queue was full.
+ */
+bool coop_sched_post(uint16_t type, uint32_t arg);
+
+/**
+ * @brief Post an event from an ISR.
+ *
+ * Args:
+ *   type: Event type.
+ *   arg: Value handed to the handler in event->arg.
+ *   higher_prio_task_woken: Set to pdTRUE if a context switch should be requested.
+ *
+ * Returns:
+ *   true if the event was queued, false if its class queue was full.
+ */
+bool coop_sched_post_from_isr(uint16_t type, uint32_t arg, BaseType_t *higher_prio_task_woken);
+
+/**
+ * @brief Run the dispatch loop in the calling task. Never returns.
+ *
+ * Args:
+ *   stats_period_ms: How often to log statistics; 0 disables the log.
+ *
+ * Returns:
+ *   None
+ */
+void coop_sched_run(uint32_t stats_period_ms);
+
+/**
+ * @brief Log per-type latency and budget statistics and reset them.
+ *
+ * Must be called from the task running coop_sched_run(), i.e. from a handler.
+ *
+ * Returns:
+ *   None
+ */
+void coop_sched_log_stats(void);
@@ -4,7 +4,8 @@
  *
  * This project provides two selectable demo modes:
  * - Preemptive: Multiple FreeRTOS tasks with priorities and a mutex-protected shared counter.
- * - Cooperative: A single run-to-completion event loop with timer-posted events.
+ * - Cooperative: A single run-to-completion event loop with timer-posted events,
+ *   priority classes, per-handler budgets and sliced long jobs (coop_sched.c).
  *
  * Select mode in:
  *   idf.py menuconfig
@@ -26,6 +27,10 @@
 
 #include "esp_log.h"
 
+#if CONFIG_DEMO_MODE_COOPERATIVE
+#include "coop_sched.h"
+#endif
+
 #define TAG "sched_demo"
 
 /**
@@ -178,21 +183,19 @@ static void start_preemptive_demo(void)
 /* ========================================================================= */
 #if CONFIG_DEMO_MODE_COOPERATIVE
 
-// Event IDs
+// Event types; the values index g_coop_handlers
 typedef enum {
-    EVT_SENSOR = 1,
-    EVT_NET    = 2,
-    EVT_UI     = 3,
+    EVT_SENSOR = 0,
+    EVT_NET,
+    EVT_UI,
+    EVT_COUNT,
 } demo_event_id_t;
 
-// Event payload
-typedef struct {
-    demo_event_id_t id;
-    uint32_t tick;
-} demo_event_t;
+// NET work is split into slices so it never blocks UI events for long
+#define NET_WORK_TOTAL_ITERS  260000
+#define NET_WORK_SLICE_ITERS  65000
 
 // Global variables
-static QueueHandle_t g_evt_q = NULL;
 static TimerHandle_t g_evt_timer = NULL;
 static uint32_t g_coop_counter = 0;
 
@@ -207,12 +210,7 @@ static uint32_t g_coop_counter = 0;
  */
 static void post_event_from_timer(demo_event_id_t id)
 {
-    demo_event_t e = {
-        .id = id,
-        .tick = (uint32_t)xTaskGetTickCount(),
-    };
-
-    if (xQueueSend(g_evt_q, &e, 0) != pdTRUE) {
+    if (!coop_sched_post((uint16_t)id, (uint32_t)xTaskGetTickCount())) {
         ESP_LOGW(TAG, "[COOP] queue full, drop id=%d", (int)id);
     }
 }
@@ -242,53 +240,78 @@ static void coop_timer_cb(TimerHandle_t tmr)
  * @brief Handle SENSOR event to completion.
  *
  * Args:
- *   e: Event payload.
+ *   e: Event; arg holds the tick it was posted at.
  *
  * Returns:
- *   None
+ *   COOP_DONE
  */
-static void handle_sensor_event(const demo_event_t *e)
+static coop_result_t handle_sensor_event(coop_event_t *e)
 {
     // Simulate sensor processing work
     demo_cpu_work(180000);
     g_coop_counter += 1;
-    ESP_LOGI(TAG, "[COOP] SENSOR: tick=%u counter=%u", (unsigned)e->tick, (unsigned)g_coop_counter);
+    ESP_LOGI(TAG, "[COOP] SENSOR: tick=%u counter=%u", (unsigned)e->arg, (unsigned)g_coop_counter);
+    return COOP_DONE;
 }
 
 /**
- * @brief Handle NET event to completion.
+ * @brief Handle one slice of a NET event.
+ *
+ * Each call does NET_WORK_SLICE_ITERS of work and asks to be continued until
+ * NET_WORK_TOTAL_ITERS are done, letting queued UI and SENSOR events run in
+ * between.
  *
  * Args:
- *   e: Event payload.
+ *   e: Event; step counts the slices already done.
  *
  * Returns:
- *   None
+ *   COOP_CONTINUE until the last slice, then COOP_DONE
  */
-static void handle_net_event(const demo_event_t *e)
+static coop_result_t handle_net_event(coop_event_t *e)
 {
     // Simulate network processing work
-    demo_cpu_work(260000);
+    demo_cpu_work(NET_WORK_SLICE_ITERS);
+    e->step++;
+
+    if ((uint32_t)e->step * NET_WORK_SLICE_ITERS < NET_WORK_TOTAL_ITERS) {
+        return COOP_CONTINUE;
+    }
+
     g_coop_counter += 2;
-    ESP_LOGI(TAG, "[COOP] NET: tick=%u counter=%u", (unsigned)e->tick, (unsigned)g_coop_counter);
+    ESP_LOGI(TAG, "[COOP] NET: tick=%u slices=%u counter=%u",
+             (unsigned)e->arg, (unsigned)e->step, (unsigned)g_coop_counter);
+    return COOP_DONE;
 }
 
 /**
  * @brief Handle UI event to completion.
  *
  * Args:
- *   e: Event payload.
+ *   e: Event; arg holds the tick it was posted at.
  *
  * Returns:
- *   None
+ *   COOP_DONE
  */
-static void handle_ui_event(const demo_event_t *e)
+static coop_result_t handle_ui_event(coop_event_t *e)
 {
     // Simulate UI processing work
     demo_cpu_work(120000);
     g_coop_counter += 3;
-    ESP_LOGI(TAG, "[COOP] UI: tick=%u counter=%u", (unsigned)e->tick, (unsigned)g_coop_counter);
+    ESP_LOGI(TAG, "[COOP] UI: tick=%u counter=%u", (unsigned)e->arg, (unsigned)g_coop_counter);
+    return COOP_DONE;
 }
 
+/*
+ * Handler table. UI is the latency-sensitive path, NET is bulk work. The
+ * budgets are per dispatch (per slice for NET) and only illustrative; an
+ * overrun is logged, never enforced.
+ */
+static const coop_handler_desc_t g_coop_handlers[EVT_COUNT] = {
+    [EVT_SENSOR] = { "SENSOR", handle_sensor_event, COOP_PRIO_NORMAL, 5000 },
+    [EVT_NET]    = { "NET",    handle_net_event,    COOP_PRIO_LOW,    2000 },
+    [EVT_UI]     = { "UI",     handle_ui_event,     COOP_PRIO_HIGH,   3000 },
+};
+
 /**
  * @brief Cooperative main loop task: run handlers to completion.
  *
@@ -302,33 +325,19 @@ static void coop_main_loop_task(void *arg)
 {
     (void)arg;
 
-    demo_event_t e;
-    while (true) {
-        // Wait indefinitely for the next event
-        if (xQueueReceive(g_evt_q, &e, portMAX_DELAY) == pdTRUE) {
-            switch (e.id) {
-                case EVT_SENSOR: handle_sensor_event(&e); break;
-                case EVT_NET:    handle_net_event(&e); break;
-                case EVT_UI:     handle_ui_event(&e); break;
-                default:
-                    ESP_LOGW(TAG, "[COOP] unknown event id=%d", (int)e.id);
-                    break;
-            }
-        }
-    }
+    coop_sched_run(CONFIG_COOP_STATS_PERIOD_MS);
 }
 
 /**
- * @brief Start the cooperative demo (queue + timer + 1 task).
+ * @brief Start the cooperative demo (scheduler + timer + 1 task).
  *
  * Returns:
  *   None
  */
 static void start_cooperative_demo(void)
 {
-    // Create the event queue
-    g_evt_q = xQueueCreate(CONFIG_COOP_EVENT_QUEUE_LEN, sizeof(demo_event_t));
-    if (g_evt_q == NULL) {
+    // Create the per-priority event queues
+    if (coop_sched_init(g_coop_handlers, EVT_COUNT, CONFIG_COOP_EVENT_QUEUE_LEN) != ESP_OK) {
         ESP_LOGE(TAG, "Failed to create event queue");
         return;
     }
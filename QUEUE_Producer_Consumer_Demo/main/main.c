@@ -11,6 +11,10 @@ What this demo shows:
   - Producer task periodically sending structured messages
   - Consumer task receiving and logging messages
   - Basic timeout handling (send and receive)
+  - Passing large messages by pointer from a fixed-block pool (msg_pool.c)
+  - Bursty producer with adaptive backpressure (block, drop-oldest,
+    drop-newest) chosen from the queue fill level
+  - Consumer draining up to CONSUMER_BATCH_MAX messages per wake
   - Clean, beginner-friendly patterns
 
 Build and flash (example):
@@ -22,6 +26,7 @@ Notes:
 */
 
 #include <stdio.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <inttypes.h>
 
@@ -31,65 +36,259 @@ Notes:
 
 #include "esp_log.h"
 
+#include "msg_pool.h"
+
 /* ------------------------- Configuration ------------------------- */
 #define DEMO_QUEUE_LENGTH          (8)
 #define PRODUCER_PERIOD_MS         (1000)
 #define PRODUCER_SEND_TIMEOUT_MS   (50)
 #define CONSUMER_RECV_TIMEOUT_MS   (2000)
 
+#define FRAME_MAX_BYTES            (1024)  /* Capacity of one message */
+#define FRAME_BYTES                (512)   /* Bytes the demo producer fills per frame */
+/* Every queue slot can hold a block, plus one being filled and one being processed */
+#define MSG_POOL_BLOCKS            (DEMO_QUEUE_LENGTH + 2)
+#define POOL_ALLOC_TIMEOUT_MS      (50)
+#define STATS_EVERY_N_MSGS         (100)
+
+/* Burst load: the producer sends this many messages back-to-back every period */
+#define PRODUCER_BURST_LEN         (20)
+
+/* Maximum messages the consumer handles per wake; 1 = one message per wake */
+#define CONSUMER_BATCH_MAX         (8)
+
+/* Backpressure thresholds, in queued messages */
+#define QUEUE_HIGH_WATERMARK       (6)     /* At or above: stop blocking the producer */
+#define QUEUE_LOW_WATERMARK        (2)     /* At or below: back to blocking */
+#define DROP_OLDEST_MAX_IN_ROW     (8)     /* Evictions in a row before new messages are dropped instead */
+
+/* Both tasks share a core so the priorities below decide who runs */
+#define DEMO_TASK_CORE             (0)
+#define PRODUCER_TASK_PRIORITY     (5)
+#if CONSUMER_BATCH_MAX > 1
+/* Below the producer: a burst piles up in the queue and is drained in one wake */
+#define CONSUMER_TASK_PRIORITY     (4)
+#else
+/* Above the producer: every send wakes the consumer for that one message */
+#define CONSUMER_TASK_PRIORITY     (6)
+#endif
+
 /* ------------------------- Types ------------------------- */
 
 /**
  * message_t
  *
- * A small packet passed from the producer task to the consumer task.
+ * A sensor frame passed from the producer task to the consumer task.
+ *
+ * Messages live in a pool and only pointers travel through the queue, so a
+ * 1 KB frame costs the same to send as a 4-byte value. Whoever holds the
+ * pointer owns the message: the producer until xQueueSend() succeeds, the
+ * consumer from xQueueReceive() until it calls msg_pool_free().
  *
  * Fields:
  *  - seq: Monotonic sequence number generated by the producer.
  *  - tick: Current FreeRTOS tick count at the time of sending.
- *  - payload: Example payload data (can represent sensor reading, etc.).
+ *  - length: Number of valid bytes in data.
+ *  - checksum: 16-bit sum of the valid bytes, checked by the consumer.
+ *  - data: Frame contents (can represent a block of sensor samples, etc.).
  */
 typedef struct {
     uint32_t seq;
     TickType_t tick;
-    int32_t payload;
+    uint16_t length;
+    uint16_t checksum;
+    uint8_t data[FRAME_MAX_BYTES];
 } message_t;
 
+/**
+ * backpressure_policy_t
+ *
+ * What the producer does when the queue is full.
+ *
+ * Values:
+ *  - BP_BLOCK: Wait up to PRODUCER_SEND_TIMEOUT_MS for a free slot (lossless
+ *    while the consumer keeps up).
+ *  - BP_DROP_OLDEST: Evict the oldest queued message to make room, so the
+ *    freshest data gets through and the producer never waits.
+ *  - BP_DROP_NEWEST: Drop the new message; the cheapest option under
+ *    sustained overload.
+ */
+typedef enum {
+    BP_BLOCK = 0,
+    BP_DROP_OLDEST,
+    BP_DROP_NEWEST,
+} backpressure_policy_t;
+
+/**
+ * flow_stats_t
+ *
+ * Counters shared between the tasks. Each field has a single writer, so no
+ * lock is needed for 32-bit updates.
+ *
+ * Fields:
+ *  - sent: Messages the producer placed in the queue.
+ *  - dropped_newest: New messages dropped by the producer.
+ *  - dropped_oldest: Queued messages evicted by the producer.
+ *  - policy_switches: Backpressure policy changes.
+ *  - consumed: Messages processed by the consumer.
+ *  - consumer_wakes: Times the consumer found the queue empty and had to
+ *    sleep until a producer woke it. Each wake costs one context switch into
+ *    the consumer and one back out.
+ */
+typedef struct {
+    volatile uint32_t sent;
+    volatile uint32_t dropped_newest;
+    volatile uint32_t dropped_oldest;
+    volatile uint32_t policy_switches;
+    volatile uint32_t consumed;
+    volatile uint32_t consumer_wakes;
+} flow_stats_t;
+
 /* ------------------------- Globals ------------------------- */
 static const char *TAG = "queue_demo";
 static QueueHandle_t g_msg_queue = NULL;
+static msg_pool_t *g_msg_pool = NULL;
+static flow_stats_t g_flow;
+
+static const char *const k_policy_names[] = {
+    [BP_BLOCK] = "block",
+    [BP_DROP_OLDEST] = "drop-oldest",
+    [BP_DROP_NEWEST] = "drop-newest",
+};
 
 /* ------------------------- Functions ------------------------- */
 
 /**
- * make_message
+ * frame_checksum
+ *
+ * Compute a simple 16-bit sum over a byte buffer.
+ *
+ * Args:
+ *  data: Bytes to sum.
+ *  length: Number of bytes.
+ *
+ * Returns:
+ *  The sum, truncated to 16 bits.
+ */
+static uint16_t frame_checksum(const uint8_t *data, uint16_t length)
+{
+    uint16_t sum = 0;
+    for (uint16_t i = 0; i < length; i++) {
+        sum = (uint16_t)(sum + data[i]);
+    }
+    return sum;
+}
+
+/**
+ * fill_message
  *
- * Create a message_t instance with a predictable payload pattern.
+ * Fill a pooled message with a predictable frame pattern.
  *
  * Args:
+ *  msg: Message owned by the caller.
  *  seq: Message sequence number.
+ */
+static void fill_message(message_t *msg, uint32_t seq)
+{
+    msg->seq = seq;
+    msg->tick = xTaskGetTickCount();
+    msg->length = FRAME_BYTES;
+
+    /* Example frame:
+       In real firmware, this could be a burst of ADC samples, an IMU FIFO dump, etc. */
+    for (uint16_t i = 0; i < msg->length; i++) {
+        msg->data[i] = (uint8_t)(seq + i);
+    }
+    msg->checksum = frame_checksum(msg->data, msg->length);
+}
+
+/**
+ * select_policy
+ *
+ * Pick the backpressure policy from the current queue fill level.
+ *
+ * Below the high watermark the producer blocks, which loses nothing while the
+ * consumer keeps up. At the high watermark it stops waiting and evicts the
+ * oldest message instead. If evictions go on for DROP_OLDEST_MAX_IN_ROW sends
+ * the overload is not a short burst, so it drops new messages and saves the
+ * eviction work. Only once the queue drains to the low watermark does it go
+ * back to blocking; the gap between the marks keeps it from flapping.
+ *
+ * Args:
+ *  current: Policy in use.
+ *  level: Messages waiting in the queue.
+ *  evictions_in_row: Sends in a row that needed an eviction.
  *
  * Returns:
- *  A fully initialized message_t.
+ *  The policy for the next send.
  */
-static message_t make_message(uint32_t seq)
+static backpressure_policy_t select_policy(backpressure_policy_t current,
+                                           UBaseType_t level,
+                                           uint32_t evictions_in_row)
 {
-    message_t msg = {0};
-    msg.seq = seq;
-    msg.tick = xTaskGetTickCount();
+    if (level <= QUEUE_LOW_WATERMARK) {
+        return BP_BLOCK;
+    }
+    if (level < QUEUE_HIGH_WATERMARK) {
+        return current;
+    }
+    if (current == BP_DROP_NEWEST || evictions_in_row >= DROP_OLDEST_MAX_IN_ROW) {
+        return BP_DROP_NEWEST;
+    }
+    return BP_DROP_OLDEST;
+}
 
-    /* Example payload:
-       In real firmware, this could be an ADC sample, GPIO state, sensor value, etc. */
-    msg.payload = (int32_t)(seq * 10);
+/**
+ * send_with_policy
+ *
+ * Send a message pointer, handling a full queue the way the policy says.
+ * On return the message belongs to the consumer if true was returned, and
+ * has been given back to the pool otherwise.
+ *
+ * Args:
+ *  msg: Message owned by the caller.
+ *  policy: Backpressure policy to apply.
+ *  evicted: Set to true if an older message was evicted to make room.
+ *
+ * Returns:
+ *  true if the message was queued.
+ */
+static bool send_with_policy(message_t *msg, backpressure_policy_t policy, bool *evicted)
+{
+    const TickType_t wait = (policy == BP_BLOCK) ? pdMS_TO_TICKS(PRODUCER_SEND_TIMEOUT_MS) : 0;
+
+    *evicted = false;
+
+    if (xQueueSend(g_msg_queue, &msg, wait) == pdPASS) {
+        return true;
+    }
+
+    if (policy == BP_DROP_OLDEST) {
+        message_t *oldest = NULL;
+
+        /* The consumer may have emptied a slot meanwhile, then nothing is evicted */
+        if (xQueueReceive(g_msg_queue, &oldest, 0) == pdPASS) {
+            msg_pool_free(g_msg_pool, oldest);
+            g_flow.dropped_oldest++;
+            *evicted = true;
+        }
+        if (xQueueSend(g_msg_queue, &msg, 0) == pdPASS) {
+            return true;
+        }
+    }
 
-    return msg;
+    /* Still ours: give it back */
+    msg_pool_free(g_msg_pool, msg);
+    g_flow.dropped_newest++;
+    return false;
 }
 
 /**
  * producer_task
  *
- * Producer task that periodically creates a message and sends it to the queue.
- * If the queue is full, it logs a warning and continues.
+ * Producer task that sends a burst of PRODUCER_BURST_LEN messages every
+ * period. Each message is taken from the pool, filled and sent by pointer,
+ * with the backpressure policy re-evaluated before every send.
  *
  * Args:
  *  pvParameters: Unused.
@@ -99,33 +298,125 @@ static void producer_task(void *pvParameters)
     (void)pvParameters;
 
     uint32_t seq = 0;
+    backpressure_policy_t policy = BP_BLOCK;
+    uint32_t evictions_in_row = 0;
 
     while (1) {
-        seq++;
-        message_t msg = make_message(seq);
-
-        BaseType_t ok = xQueueSend(
-            g_msg_queue,
-            &msg,
-            pdMS_TO_TICKS(PRODUCER_SEND_TIMEOUT_MS)
-        );
-
-        if (ok == pdPASS) {
-            ESP_LOGI(TAG, "Producer sent: seq=%" PRIu32 " payload=%" PRIi32 " tick=%" PRIu32,
-                     msg.seq, msg.payload, (uint32_t)msg.tick);
-        } else {
-            ESP_LOGW(TAG, "Producer drop (queue full): seq=%" PRIu32, msg.seq);
+        const uint32_t first_seq = seq + 1;
+        uint32_t burst_sent = 0;
+
+        for (int i = 0; i < PRODUCER_BURST_LEN; i++) {
+            seq++;
+
+            message_t *msg = msg_pool_alloc(g_msg_pool, pdMS_TO_TICKS(POOL_ALLOC_TIMEOUT_MS));
+            if (msg == NULL) {
+                ESP_LOGW(TAG, "Producer drop (pool empty): seq=%" PRIu32, seq);
+                g_flow.dropped_newest++;
+                continue;
+            }
+
+            fill_message(msg, seq);
+
+            backpressure_policy_t next = select_policy(policy,
+                                                       uxQueueMessagesWaiting(g_msg_queue),
+                                                       evictions_in_row);
+            if (next != policy) {
+                ESP_LOGI(TAG, "Backpressure: %s -> %s (queued=%u)",
+                         k_policy_names[policy], k_policy_names[next],
+                         (unsigned)uxQueueMessagesWaiting(g_msg_queue));
+                policy = next;
+                g_flow.policy_switches++;
+                evictions_in_row = 0;
+            }
+
+            bool evicted;
+            if (send_with_policy(msg, policy, &evicted)) {
+                /* The consumer owns the message now; don't touch msg below */
+                ESP_LOGD(TAG, "Producer sent: seq=%" PRIu32, seq);
+                g_flow.sent++;
+                burst_sent++;
+                evictions_in_row = evicted ? (evictions_in_row + 1) : 0;
+            } else {
+                ESP_LOGD(TAG, "Producer drop (queue full): seq=%" PRIu32, seq);
+            }
         }
 
+        ESP_LOGI(TAG, "Producer burst: seq=%" PRIu32 "..%" PRIu32 " queued=%" PRIu32 " policy=%s",
+                 first_seq, seq, burst_sent, k_policy_names[policy]);
+
         vTaskDelay(pdMS_TO_TICKS(PRODUCER_PERIOD_MS));
     }
 }
 
+/**
+ * log_stats
+ *
+ * Log throughput, the consumer's context-switch ratio, backpressure
+ * counters and the usage counters of the message pool.
+ *
+ * Args:
+ *  window_msgs: Messages consumed since the previous report.
+ *  window_ticks: Ticks elapsed since the previous report.
+ */
+static void log_stats(uint32_t window_msgs, TickType_t window_ticks)
+{
+    msg_pool_stats_t st;
+    msg_pool_get_stats(g_msg_pool, &st);
+
+    const uint32_t consumed = g_flow.consumed;
+    const uint32_t wakes = g_flow.consumer_wakes;
+    const uint32_t window_ms = (uint32_t)pdTICKS_TO_MS(window_ticks);
+
+    ESP_LOGI(TAG, "Flow: consumed=%" PRIu32 " rate=%" PRIu32 " msg/s wakes=%" PRIu32
+             " switches/msg=%.2f sent=%" PRIu32 " dropped_oldest=%" PRIu32
+             " dropped_newest=%" PRIu32 " policy_switches=%" PRIu32,
+             consumed,
+             (window_ms > 0) ? (window_msgs * 1000u / window_ms) : 0,
+             wakes,
+             (consumed > 0) ? (2.0 * wakes / consumed) : 0.0,
+             g_flow.sent, g_flow.dropped_oldest, g_flow.dropped_newest, g_flow.policy_switches);
+
+    ESP_LOGI(TAG, "Pool: in_use=%" PRIu32 "/%" PRIu32 " high_water=%" PRIu32
+             " alloc_ok=%" PRIu32 " exhausted=%" PRIu32 " bad_free=%" PRIu32 " poison_errors=%" PRIu32,
+             st.in_use, st.block_count, st.high_water,
+             st.alloc_ok, st.alloc_failed, st.bad_free, st.poison_errors);
+}
+
+/**
+ * process_message
+ *
+ * Verify a received message and give it back to the pool.
+ *
+ * Args:
+ *  msg: Message owned by the caller; must not be used after this returns.
+ *  max_age: Raised to the message age if that is larger.
+ *
+ * Returns:
+ *  true if the checksum matched.
+ */
+static bool process_message(message_t *msg, TickType_t *max_age)
+{
+    const bool intact = (frame_checksum(msg->data, msg->length) == msg->checksum);
+    const TickType_t age = xTaskGetTickCount() - msg->tick;
+
+    ESP_LOGD(TAG, "Consumer got : seq=%" PRIu32 " bytes=%u checksum=%s age_ticks=%" PRIu32,
+             msg->seq, (unsigned)msg->length, intact ? "ok" : "BAD", (uint32_t)age);
+
+    if (age > *max_age) {
+        *max_age = age;
+    }
+
+    msg_pool_free(g_msg_pool, msg);
+    return intact;
+}
+
 /**
  * consumer_task
  *
- * Consumer task that receives messages from the queue and processes them.
- * If no message arrives within the timeout, it logs a heartbeat message.
+ * Consumer task that blocks for the first message, then drains up to
+ * CONSUMER_BATCH_MAX - 1 more without blocking, so a burst is handled in a
+ * single wake. Every message is verified and returned to the pool. If no
+ * message arrives within the timeout, it logs a heartbeat message.
  *
  * Args:
  *  pvParameters: Unused.
@@ -134,22 +425,51 @@ static void consumer_task(void *pvParameters)
 {
     (void)pvParameters;
 
-    message_t msg;
+    uint32_t window_msgs = 0;
+    TickType_t window_start = xTaskGetTickCount();
 
     while (1) {
-        BaseType_t ok = xQueueReceive(
-            g_msg_queue,
-            &msg,
-            pdMS_TO_TICKS(CONSUMER_RECV_TIMEOUT_MS)
-        );
-
-        if (ok == pdPASS) {
-            ESP_LOGI(TAG, "Consumer got : seq=%" PRIu32 " payload=%" PRIi32 " age_ticks=%" PRIu32,
-                     msg.seq,
-                     msg.payload,
-                     (uint32_t)(xTaskGetTickCount() - msg.tick));
-        } else {
+        message_t *msg = NULL;
+
+        /* Racy by a message at most: a send between the check and the receive
+           is counted as a wake although the receive then returns at once */
+        const bool will_sleep = (uxQueueMessagesWaiting(g_msg_queue) == 0);
+
+        if (xQueueReceive(g_msg_queue, &msg, pdMS_TO_TICKS(CONSUMER_RECV_TIMEOUT_MS)) != pdPASS) {
             ESP_LOGI(TAG, "Consumer waiting... (no messages within %d ms)", CONSUMER_RECV_TIMEOUT_MS);
+            continue;
+        }
+        if (will_sleep) {
+            g_flow.consumer_wakes++;
+        }
+
+        /* We own each message until process_message() returns it to the pool */
+        const uint32_t first_seq = msg->seq;
+        uint32_t last_seq;
+        uint32_t batch = 0;
+        uint32_t bad = 0;
+        TickType_t max_age = 0;
+
+        do {
+            last_seq = msg->seq;
+            if (!process_message(msg, &max_age)) {
+                bad++;
+            }
+            batch++;
+        } while (batch < CONSUMER_BATCH_MAX && xQueueReceive(g_msg_queue, &msg, 0) == pdPASS);
+
+        g_flow.consumed += batch;
+
+        ESP_LOGI(TAG, "Consumer batch: n=%" PRIu32 " seq=%" PRIu32 "..%" PRIu32
+                 " bad=%" PRIu32 " max_age_ticks=%" PRIu32,
+                 batch, first_seq, last_seq, bad, (uint32_t)max_age);
+
+        window_msgs += batch;
+        if (window_msgs >= STATS_EVERY_N_MSGS) {
+            const TickType_t now = xTaskGetTickCount();
+            log_stats(window_msgs, now - window_start);
+            window_msgs = 0;
+            window_start = now;
         }
     }
 }
@@ -157,14 +477,20 @@ static void consumer_task(void *pvParameters)
 /**
  * create_demo_queue
  *
- * Create the FreeRTOS queue used for producer-consumer messaging.
+ * Create the message pool and the FreeRTOS queue used for producer-consumer
+ * messaging. The queue carries message_t pointers, not messages.
  *
  * Returns:
- *  true if queue was created successfully, false otherwise.
+ *  true if both were created successfully, false otherwise.
  */
 static bool create_demo_queue(void)
 {
-    g_msg_queue = xQueueCreate(DEMO_QUEUE_LENGTH, sizeof(message_t));
+    g_msg_pool = msg_pool_create(sizeof(message_t), MSG_POOL_BLOCKS);
+    if (g_msg_pool == NULL) {
+        return false;
+    }
+
+    g_msg_queue = xQueueCreate(DEMO_QUEUE_LENGTH, sizeof(message_t *));
     return (g_msg_queue != NULL);
 }
 
@@ -175,14 +501,18 @@ static bool create_demo_queue(void)
  *
  * Notes:
  *  - Stack sizes are conservative for a demo.
- *  - Priorities are set so the consumer can run promptly when messages arrive.
+ *  - With batch draining the consumer runs below the producer so bursts
+ *    accumulate; with CONSUMER_BATCH_MAX of 1 it runs above it and handles
+ *    each message as soon as it is sent.
  */
 static void start_demo_tasks(void)
 {
     const uint32_t stack_words = 2048; /* words, not bytes, in ESP-IDF task creation */
 
-    xTaskCreate(producer_task, "producer_task", stack_words, NULL, 5, NULL);
-    xTaskCreate(consumer_task, "consumer_task", stack_words, NULL, 6, NULL);
+    xTaskCreatePinnedToCore(producer_task, "producer_task", stack_words, NULL,
+                            PRODUCER_TASK_PRIORITY, NULL, DEMO_TASK_CORE);
+    xTaskCreatePinnedToCore(consumer_task, "consumer_task", stack_words, NULL,
+                            CONSUMER_TASK_PRIORITY, NULL, DEMO_TASK_CORE);
 }
 
 /**
@@ -200,8 +530,12 @@ void app_main(void)
         return;
     }
 
-    ESP_LOGI(TAG, "Queue created: length=%d item_size=%u",
-             DEMO_QUEUE_LENGTH, (unsigned)sizeof(message_t));
+    ESP_LOGI(TAG, "Queue created: length=%d item_size=%u (pool: %d x %u bytes)",
+             DEMO_QUEUE_LENGTH, (unsigned)sizeof(message_t *),
+             MSG_POOL_BLOCKS, (unsigned)sizeof(message_t));
+    ESP_LOGI(TAG, "Burst of %d every %d ms, consumer batch up to %d, watermarks %d/%d",
+             PRODUCER_BURST_LEN, PRODUCER_PERIOD_MS, CONSUMER_BATCH_MAX,
+             QUEUE_LOW_WATERMARK, QUEUE_HIGH_WATERMARK);
 
     start_demo_tasks();
 
@@ -0,0 +1,259 @@
+/*
+File: msg_pool.c
+Project: queue_producer_consumer_demo
+
+Purpose:
+  Fixed-block message pool with a free list (see msg_pool.h).
+
+Design:
+  - Every block starts with a small header followed by the user data.
+  - Free blocks are chained through the header into a singly linked list.
+    Taking and returning a block is a push/pop on that list inside a short
+    critical section.
+  - A counting semaphore tracks the number of free blocks so that
+    msg_pool_alloc() can block with a timeout when the pool is empty.
+*/
+
+#include "msg_pool.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/semphr.h"
+
+#include "esp_log.h"
+
+/* ------------------------- Configuration ------------------------- */
+#define BLOCK_MAGIC_FREE     (0x46524545u)   /* "FREE" */
+#define BLOCK_MAGIC_OWNED    (0x4F574E44u)   /* "OWND" */
+#define BLOCK_NONE           (0xFFFFu)       /* End of the free list */
+#define POISON_FREE_BYTE     (0xDD)          /* Fills a block while it is free */
+#define POISON_ALLOC_BYTE    (0xCD)          /* Fills a block handed out, until the owner writes it */
+
+/* ------------------------- Types ------------------------- */
+
+/**
+ * block_hdr_t
+ *
+ * Bookkeeping stored in front of every block.
+ *
+ * Fields:
+ *  - magic: BLOCK_MAGIC_FREE or BLOCK_MAGIC_OWNED; catches double frees.
+ *  - next: Index of the next free block while this one is free.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t next;
+    uint16_t reserved;
+} block_hdr_t;
+
+struct msg_pool {
+    uint8_t *storage;
+    size_t block_size;
+    size_t stride;
+    uint16_t block_count;
+    uint16_t free_head;
+    SemaphoreHandle_t available;
+    portMUX_TYPE lock;
+    msg_pool_stats_t stats;
+};
+
+/* ------------------------- Globals ------------------------- */
+static const char *TAG = "msg_pool";
+
+/* ------------------------- Helpers ------------------------- */
+
+static block_hdr_t *block_header(const msg_pool_t *pool, uint16_t index)
+{
+    return (block_hdr_t *)(pool->storage + (size_t)index * pool->stride);
+}
+
+static uint8_t *block_data(const msg_pool_t *pool, uint16_t index)
+{
+    return (uint8_t *)block_header(pool, index) + sizeof(block_hdr_t);
+}
+
+/**
+ * block_index
+ *
+ * Map a data pointer back to its block index.
+ *
+ * Args:
+ *  pool: Pool to search.
+ *  block: Pointer as returned by msg_pool_alloc().
+ *  index: Receives the block index.
+ *
+ * Returns:
+ *  true if the pointer is the start of a block in this pool.
+ */
+static bool block_index(const msg_pool_t *pool, const void *block, uint16_t *index)
+{
+    const uint8_t *p = (const uint8_t *)block;
+    const uint8_t *first = pool->storage + sizeof(block_hdr_t);
+
+    if (p < first) {
+        return false;
+    }
+
+    size_t offset = (size_t)(p - first);
+    if ((offset % pool->stride) != 0 || (offset / pool->stride) >= pool->block_count) {
+        return false;
+    }
+
+    *index = (uint16_t)(offset / pool->stride);
+    return true;
+}
+
+#if MSG_POOL_DEBUG_POISON
+/**
+ * poison_intact
+ *
+ * Check that a free block still holds the poison pattern.
+ *
+ * Args:
+ *  data: Block data.
+ *  size: Bytes to check.
+ *
+ * Returns:
+ *  true if no byte was changed while the block was free.
+ */
+static bool poison_intact(const uint8_t *data, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        if (data[i] != POISON_FREE_BYTE) {
+            return false;
+        }
+    }
+    return true;
+}
+#endif
+
+/* ------------------------- API ------------------------- */
+
+msg_pool_t *msg_pool_create(size_t block_size, size_t block_count)
+{
+    if (block_size == 0 || block_count == 0 || block_count >= BLOCK_NONE) {
+        return NULL;
+    }
+
+    msg_pool_t *pool = calloc(1, sizeof(msg_pool_t));
+    if (pool == NULL) {
+        return NULL;
+    }
+
+    /* Keep every header 4-byte aligned */
+    pool->block_size = block_size;
+    pool->stride = sizeof(block_hdr_t) + ((block_size + 3u) & ~(size_t)3u);
+    pool->block_count = (uint16_t)block_count;
+    pool->storage = malloc(pool->stride * block_count);
+    pool->available = xSemaphoreCreateCounting(block_count, block_count);
+    portMUX_INITIALIZE(&pool->lock);
+
+    if (pool->storage == NULL || pool->available == NULL) {
+        if (pool->available != NULL) {
+            vSemaphoreDelete(pool->available);
+        }
+        free(pool->storage);
+        free(pool);
+        return NULL;
+    }
+
+    /* Chain all blocks into the free list, lowest index first */
+    for (uint16_t i = 0; i < pool->block_count; i++) {
+        block_hdr_t *hdr = block_header(pool, i);
+        hdr->magic = BLOCK_MAGIC_FREE;
+        hdr->next = (uint16_t)((i + 1u < pool->block_count) ? (i + 1u) : BLOCK_NONE);
+#if MSG_POOL_DEBUG_POISON
+        memset(block_data(pool, i), POISON_FREE_BYTE, block_size);
+#endif
+    }
+    pool->free_head = 0;
+    pool->stats.block_count = pool->block_count;
+
+    return pool;
+}
+
+void *msg_pool_alloc(msg_pool_t *pool, TickType_t timeout)
+{
+    /* The semaphore count equals the length of the free list, so a
+       successful take guarantees the pop below finds a block. */
+    if (xSemaphoreTake(pool->available, timeout) != pdTRUE) {
+        portENTER_CRITICAL(&pool->lock);
+        pool->stats.alloc_failed++;
+        portEXIT_CRITICAL(&pool->lock);
+        return NULL;
+    }
+
+    portENTER_CRITICAL(&pool->lock);
+    uint16_t index = pool->free_head;
+    block_hdr_t *hdr = block_header(pool, index);
+    pool->free_head = hdr->next;
+    hdr->magic = BLOCK_MAGIC_OWNED;
+    hdr->next = BLOCK_NONE;
+    pool->stats.alloc_ok++;
+    pool->stats.in_use++;
+    if (pool->stats.in_use > pool->stats.high_water) {
+        pool->stats.high_water = pool->stats.in_use;
+    }
+    portEXIT_CRITICAL(&pool->lock);
+
+    uint8_t *data = block_data(pool, index);
+
+#if MSG_POOL_DEBUG_POISON
+    if (!poison_intact(data, pool->block_size)) {
+        ESP_LOGE(TAG, "Block %u was written after it was freed", (unsigned)index);
+        portENTER_CRITICAL(&pool->lock);
+        pool->stats.poison_errors++;
+        portEXIT_CRITICAL(&pool->lock);
+    }
+    memset(data, POISON_ALLOC_BYTE, pool->block_size);
+#endif
+
+    return data;
+}
+
+bool msg_pool_free(msg_pool_t *pool, void *block)
+{
+    uint16_t index;
+
+    if (block == NULL || !block_index(pool, block, &index)) {
+        ESP_LOGE(TAG, "Free of a pointer outside the pool: %p", block);
+        portENTER_CRITICAL(&pool->lock);
+        pool->stats.bad_free++;
+        portEXIT_CRITICAL(&pool->lock);
+        return false;
+    }
+
+    /* Claim the block first so a racing double free cannot pass the check too */
+    portENTER_CRITICAL(&pool->lock);
+    block_hdr_t *hdr = block_header(pool, index);
+    if (hdr->magic != BLOCK_MAGIC_OWNED) {
+        pool->stats.bad_free++;
+        portEXIT_CRITICAL(&pool->lock);
+        ESP_LOGE(TAG, "Double free of block %u", (unsigned)index);
+        return false;
+    }
+    hdr->magic = BLOCK_MAGIC_FREE;
+    portEXIT_CRITICAL(&pool->lock);
+
+#if MSG_POOL_DEBUG_POISON
+    /* Not on the free list yet, so nobody else can be using it */
+    memset(block, POISON_FREE_BYTE, pool->block_size);
+#endif
+
+    portENTER_CRITICAL(&pool->lock);
+    hdr->next = pool->free_head;
+    pool->free_head = index;
+    pool->stats.in_use--;
+    portEXIT_CRITICAL(&pool->lock);
+
+    xSemaphoreGive(pool->available);
+    return true;
+}
+
+void msg_pool_get_stats(msg_pool_t *pool, msg_pool_stats_t *out)
+{
+    portENTER_CRITICAL(&pool->lock);
+    *out = pool->stats;
+    portEXIT_CRITICAL(&pool->lock);
+}
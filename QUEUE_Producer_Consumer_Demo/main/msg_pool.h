@@ -0,0 +1,115 @@
+/*
+File: msg_pool.h
+Project: queue_producer_consumer_demo
+
+Purpose:
+  Fixed-block message pool for passing large messages through a FreeRTOS
+  queue by pointer instead of by value.
+
+How it is used:
+  - The producer takes a block with msg_pool_alloc() and fills it.
+  - It sends only the pointer through the queue. From that moment the block
+    belongs to the consumer; the producer must not touch it again.
+  - The consumer processes the block and gives it back with msg_pool_free().
+
+  All blocks come from one allocation made by msg_pool_create(), so the
+  message path never calls malloc/free and cannot fragment the heap.
+
+Notes:
+  - Set MSG_POOL_DEBUG_POISON to 1 to fill freed blocks with a pattern and
+    check it on the next allocation. This catches writes through a pointer
+    that was already given back (use after free).
+*/
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+
+#ifndef MSG_POOL_DEBUG_POISON
+#define MSG_POOL_DEBUG_POISON      (0)
+#endif
+
+/**
+ * msg_pool_stats_t
+ *
+ * Counters describing how the pool has been used since it was created.
+ *
+ * Fields:
+ *  - block_count: Number of blocks in the pool.
+ *  - in_use: Blocks currently owned by a task.
+ *  - high_water: Largest value in_use has reached.
+ *  - alloc_ok: Successful allocations.
+ *  - alloc_failed: Allocations that timed out because the pool was empty.
+ *  - bad_free: Frees of a foreign pointer or of a block that was already free.
+ *  - poison_errors: Blocks found modified while free (poison mode only).
+ */
+typedef struct {
+    uint32_t block_count;
+    uint32_t in_use;
+    uint32_t high_water;
+    uint32_t alloc_ok;
+    uint32_t alloc_failed;
+    uint32_t bad_free;
+    uint32_t poison_errors;
+} msg_pool_stats_t;
+
+typedef struct msg_pool msg_pool_t;
+
+/**
+ * msg_pool_create
+ *
+ * Allocate a pool of equally sized blocks.
+ *
+ * Args:
+ *  block_size: Usable bytes per block.
+ *  block_count: Number of blocks (1..65535).
+ *
+ * Returns:
+ *  The pool, or NULL if memory could not be allocated.
+ */
+msg_pool_t *msg_pool_create(size_t block_size, size_t block_count);
+
+/**
+ * msg_pool_alloc
+ *
+ * Take a block from the pool. The caller owns it until it frees it or hands
+ * it to another task.
+ *
+ * Args:
+ *  pool: Pool to allocate from.
+ *  timeout: Ticks to wait for a block when all are in use.
+ *
+ * Returns:
+ *  Pointer to block_size bytes, or NULL if no block became free in time.
+ */
+void *msg_pool_alloc(msg_pool_t *pool, TickType_t timeout);
+
+/**
+ * msg_pool_free
+ *
+ * Give a block back to the pool. Only the current owner may do this.
+ *
+ * Args:
+ *  pool: Pool the block came from.
+ *  block: Pointer returned by msg_pool_alloc().
+ *
+ * Returns:
+ *  true if the block was returned, false if the pointer does not belong to
+ *  the pool or the block is already free.
+ */
+bool msg_pool_free(msg_pool_t *pool, void *block);
+
+/**
+ * msg_pool_get_stats
+ *
+ * Copy the usage counters of a pool.
+ *
+ * Args:
+ *  pool: Pool to inspect.
+ *  out: Receives the counters.
+ */
+void msg_pool_get_stats(msg_pool_t *pool, msg_pool_stats_t *out);
@@ -0,0 +1,171 @@
+/**
+ * @file bus_owner.c
+ * @brief Dedicated task that owns a shared bus and serves write requests from a queue.
+ */
+
+#include "bus_owner.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "freertos/task.h"
+#include "freertos/queue.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#define TAG "bus_owner"
+
+#define BUS_OWNER_TASK_STACK     3072
+
+typedef struct {
+    uint8_t addr;
+    uint8_t len;
+    uint8_t data[BUS_OWNER_MAX_PAYLOAD];
+    TaskHandle_t client;
+    int64_t post_us;
+} bus_request_t;
+
+typedef struct {
+    uint32_t served;
+    uint32_t rejected;           /* Queue stayed full for the client's timeout */
+    uint32_t depth_max;          /* Requests waiting when one was taken, plus itself */
+    uint64_t queue_total_us;
+    uint32_t queue_max_us;
+    uint64_t service_total_us;
+    uint32_t service_max_us;
+} bus_owner_stats_t;
+
+static QueueHandle_t s_queue = NULL;
+static bus_owner_write_fn_t s_write_fn = NULL;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+static bus_owner_stats_t s_stats;
+
+/**
+ * @brief Owner task: execute requests in arrival order and notify each client.
+ *
+ * Args:
+ *   arg: Unused (NULL).
+ *
+ * Returns:
+ *   None (FreeRTOS task).
+ */
+static void bus_owner_task(void *arg)
+{
+    (void)arg;
+
+    bus_request_t req;
+
+    while (true) {
+        if (xQueueReceive(s_queue, &req, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        const uint32_t depth = (uint32_t)uxQueueMessagesWaiting(s_queue) + 1U;
+        const int64_t start_us = esp_timer_get_time();
+        const esp_err_t result = s_write_fn(req.addr, (req.len > 0) ? req.data : NULL, req.len);
+        const int64_t end_us = esp_timer_get_time();
+
+        const uint32_t queue_us = (uint32_t)(start_us - req.post_us);
+        const uint32_t service_us = (uint32_t)(end_us - start_us);
+
+        taskENTER_CRITICAL(&s_stats_lock);
+        s_stats.served++;
+        s_stats.queue_total_us += queue_us;
+        s_stats.service_total_us += service_us;
+        if (queue_us > s_stats.queue_max_us) {
+            s_stats.queue_max_us = queue_us;
+        }
+        if (service_us > s_stats.service_max_us) {
+            s_stats.service_max_us = service_us;
+        }
+        if (depth > s_stats.depth_max) {
+            s_stats.depth_max = depth;
+        }
+        taskEXIT_CRITICAL(&s_stats_lock);
+
+        // esp_err_t values fit the 32-bit notification value
+        xTaskNotify(req.client, (uint32_t)result, eSetValueWithOverwrite);
+    }
+}
+
+esp_err_t bus_owner_start(bus_owner_write_fn_t write_fn, UBaseType_t priority)
+{
+    if (write_fn == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_queue != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_queue = xQueueCreate(BUS_OWNER_QUEUE_LENGTH, sizeof(bus_request_t));
+    if (s_queue == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    s_write_fn = write_fn;
+
+    if (xTaskCreate(bus_owner_task, "bus_owner", BUS_OWNER_TASK_STACK, NULL, priority, NULL) != pdPASS) {
+        vQueueDelete(s_queue);
+        s_queue = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t bus_owner_write(uint8_t addr, const uint8_t *data, size_t len, TickType_t queue_timeout)
+{
+    if (s_queue == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (len > BUS_OWNER_MAX_PAYLOAD || (len > 0 && data == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    bus_request_t req = {
+        .addr = addr,
+        .len = (uint8_t)len,
+        .client = xTaskGetCurrentTaskHandle(),
+    };
+    if (len > 0) {
+        memcpy(req.data, data, len);
+    }
+
+    // Drop any stale notification so the wait below only sees our reply
+    (void)ulTaskNotifyTake(pdTRUE, 0);
+
+    req.post_us = esp_timer_get_time();
+    if (xQueueSend(s_queue, &req, queue_timeout) != pdTRUE) {
+        taskENTER_CRITICAL(&s_stats_lock);
+        s_stats.rejected++;
+        taskEXIT_CRITICAL(&s_stats_lock);
+        ESP_LOGW(TAG, "request for 0x%02x rejected, queue full", addr);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    // Once queued the request is always answered, within the bound described in bus_owner.h
+    uint32_t result = 0;
+    (void)xTaskNotifyWait(0, UINT32_MAX, &result, portMAX_DELAY);
+
+    return (esp_err_t)result;
+}
+
+void bus_owner_log_stats(void)
+{
+    bus_owner_stats_t s;
+
+    taskENTER_CRITICAL(&s_stats_lock);
+    s = s_stats;
+    memset(&s_stats, 0, sizeof(s_stats));
+    taskEXIT_CRITICAL(&s_stats_lock);
+
+    const uint32_t queue_avg_us = (s.served > 0) ? (uint32_t)(s.queue_total_us / s.served) : 0;
+    const uint32_t service_avg_us = (s.served > 0) ? (uint32_t)(s.service_total_us / s.served) : 0;
+
+    ESP_LOGI(TAG, "served=%" PRIu32 " rejected=%" PRIu32 " depth max=%" PRIu32 "/%d",
+             s.served, s.rejected, s.depth_max, BUS_OWNER_QUEUE_LENGTH);
+    ESP_LOGI(TAG, "queue wait avg/max=%" PRIu32 "/%" PRIu32 " us service avg/max=%" PRIu32 "/%" PRIu32 " us",
+             queue_avg_us, s.queue_max_us, service_avg_us, s.service_max_us);
+}
@@ -0,0 +1,77 @@
+/**
+ * @file bus_owner.h
+ * @brief Dedicated task that owns a shared bus and serves write requests from a queue.
+ *
+ * Instead of every client locking the bus with a mutex, clients post a small
+ * request and block on a task notification until the owner has executed it.
+ * Only the owner ever touches the bus, so there is no lock to hold and no
+ * priority inversion. A client's worst-case latency is bounded by the number
+ * of requests queued ahead of it times the longest transaction.
+ *
+ * The owner uses the client's default task notification to return the result,
+ * so a client must not use that notification for anything else.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "esp_err.h"
+
+/* Largest payload a single request can carry (copied into the queue). */
+#define BUS_OWNER_MAX_PAYLOAD    8
+/* Number of requests that can wait for the owner. */
+#define BUS_OWNER_QUEUE_LENGTH   4
+
+/**
+ * @brief Performs one write transaction on the bus. Runs in the owner task.
+ *
+ * Args:
+ *   addr: 7-bit device address.
+ *   data: Payload, or NULL when len is 0.
+ *   len: Payload length in bytes.
+ *
+ * Returns:
+ *   Result handed back to the client.
+ */
+typedef esp_err_t (*bus_owner_write_fn_t)(uint8_t addr, const uint8_t *data, size_t len);
+
+/**
+ * @brief Create the request queue and start the owner task.
+ *
+ * Args:
+ *   write_fn: Transaction callback; must itself complete in bounded time.
+ *   priority: Owner task priority; should be at least that of its highest client.
+ *
+ * Returns:
+ *   ESP_OK, ESP_ERR_INVALID_ARG if write_fn is NULL, ESP_ERR_INVALID_STATE if
+ *   already started, or ESP_ERR_NO_MEM.
+ */
+esp_err_t bus_owner_start(bus_owner_write_fn_t write_fn, UBaseType_t priority);
+
+/**
+ * @brief Queue a write and wait for the owner to execute it.
+ *
+ * Args:
+ *   addr: 7-bit device address.
+ *   data: Payload, or NULL when len is 0.
+ *   len: Payload length, at most BUS_OWNER_MAX_PAYLOAD.
+ *   queue_timeout: How long to wait for space in the queue, in ticks.
+ *
+ * Returns:
+ *   The transaction result, ESP_ERR_TIMEOUT if the queue stayed full,
+ *   ESP_ERR_INVALID_ARG for an oversized payload, or ESP_ERR_INVALID_STATE
+ *   if the owner is not running.
+ */
+esp_err_t bus_owner_write(uint8_t addr, const uint8_t *data, size_t len, TickType_t queue_timeout);
+
+/**
+ * @brief Log queue-wait and service-time statistics and start a new window.
+ *
+ * Returns:
+ *   None
+ */
+void bus_owner_log_stats(void);
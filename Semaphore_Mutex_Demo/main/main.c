@@ -2,8 +2,11 @@
  * @file main.c
  * @brief Practical FreeRTOS synchronization demo on ESP32 using ESP-IDF.
  *
- * This single-file demo integrates three real-world synchronization patterns:
+ * This demo integrates three real-world synchronization patterns:
  * 1) Mutex: Protect a shared I2C bus across multiple tasks (resource protection).
+ *    The mutex is instrumented (tracked_mutex.c) to report hold time, wait time,
+ *    contention and priority-inversion events; alternatively a dedicated
+ *    bus-owner task (bus_owner.c) serves the bus from a request queue.
  * 2) Binary semaphore: Signal a task from a GPIO ISR (event notification).
  * 3) Counting semaphore: Limit concurrent access to a pool of identical resources.
  *
@@ -18,6 +21,7 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -29,6 +33,9 @@
 #include "driver/gpio.h"
 #include "driver/i2c.h"
 
+#include "tracked_mutex.h"
+#include "bus_owner.h"
+
 /* --------------------------- Configuration --------------------------- */
 
 #define TAG "sync_demo"
@@ -41,14 +48,32 @@
 #define DEMO_I2C_SDA_GPIO        GPIO_NUM_8
 #define DEMO_I2C_SCL_GPIO        GPIO_NUM_9
 #define DEMO_I2C_FREQ_HZ         100000
+#define DEMO_I2C_TXN_TIMEOUT_MS  20
+
+/* Shared-bus access strategy: 0 = instrumented mutex, 1 = bus-owner task. */
+#define DEMO_I2C_USE_BUS_OWNER   0
+/* How long a client waits for the mutex, or for space in the owner's queue. */
+#define DEMO_I2C_WAIT_MS         500
+
+/* Period of the bus statistics report. */
+#define DEMO_STATS_PERIOD_MS     5000
 
 /* Counting semaphore resource pool example. */
 #define BUFFER_POOL_SIZE         3
 #define WORKER_TASK_COUNT        5
 
+/* Task priorities. The EEPROM task sits below the workers so that a sensor
+ * request arriving while it holds the bus is a real priority inversion. */
+#define PRIO_GPIO_EVENT          10
+#define PRIO_I2C_SENSOR          6
+#define PRIO_BUS_OWNER           6
+#define PRIO_WORKER              4
+#define PRIO_I2C_EEPROM          3
+#define PRIO_STATS               2
+
 /* --------------------------- Globals --------------------------- */
 
-static SemaphoreHandle_t g_i2c_mutex = NULL;
+static tracked_mutex_t g_i2c_mutex;
 static SemaphoreHandle_t g_gpio_sem = NULL;
 static SemaphoreHandle_t g_pool_sem = NULL;
 
@@ -56,12 +81,15 @@ static SemaphoreHandle_t g_pool_sem = NULL;
 
 static esp_err_t demo_i2c_init(void);
 static void demo_gpio_init(void);
+static esp_err_t demo_i2c_write(uint8_t addr, const uint8_t *data, size_t len);
+static esp_err_t demo_i2c_access(const char *who, uint8_t addr, const uint8_t *data, size_t len);
 
 static void i2c_task_sensor(void *arg);
 static void i2c_task_eeprom(void *arg);
 
 static void gpio_event_task(void *arg);
 static void worker_task(void *arg);
+static void stats_task(void *arg);
 
 static void IRAM_ATTR gpio_isr_handler(void *arg);
 
@@ -126,6 +154,87 @@ static void demo_gpio_init(void)
     ESP_ERROR_CHECK(gpio_isr_handler_add(DEMO_GPIO_INPUT, gpio_isr_handler, (void *)DEMO_GPIO_INPUT));
 }
 
+/**
+ * @brief Perform one I2C write transaction. The caller must own the bus.
+ *
+ * Args:
+ *   addr: 7-bit device address.
+ *   data: Bytes written after the address, or NULL when len is 0.
+ *   len: Number of data bytes.
+ *
+ * Returns:
+ *   Result of i2c_master_cmd_begin(), or ESP_ERR_NO_MEM.
+ */
+static esp_err_t demo_i2c_write(uint8_t addr, const uint8_t *data, size_t len)
+{
+    // Create and initialize an I2C commands list with a given buffer
+    i2c_cmd_handle_t cmd = i2c_cmd_link_create();
+    if (cmd == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    // Start the I2C command sequence
+    i2c_master_start(cmd);
+
+    // Write the device address
+    i2c_master_write_byte(cmd, (addr << 1) | I2C_MASTER_WRITE, true);
+
+    // Write the payload, if any
+    if (len > 0) {
+        i2c_master_write(cmd, data, len, true);
+    }
+
+    // End the I2C command sequence
+    i2c_master_stop(cmd);
+
+    // Execute the I2C command; the timeout bounds how long the bus is held
+    esp_err_t err = i2c_master_cmd_begin(DEMO_I2C_PORT, cmd, pdMS_TO_TICKS(DEMO_I2C_TXN_TIMEOUT_MS));
+
+    // Delete the I2C commands list to free resources
+    i2c_cmd_link_delete(cmd);
+
+    return err;
+}
+
+/**
+ * @brief Run one I2C write on the shared bus using the configured strategy.
+ *
+ * With DEMO_I2C_USE_BUS_OWNER the request is queued to the bus-owner task;
+ * otherwise the caller locks the instrumented mutex and performs the
+ * transaction itself.
+ *
+ * Args:
+ *   who: Client name for logging.
+ *   addr: 7-bit device address.
+ *   data: Payload, or NULL when len is 0.
+ *   len: Payload length in bytes.
+ *
+ * Returns:
+ *   ESP_ERR_TIMEOUT if the bus could not be obtained within DEMO_I2C_WAIT_MS,
+ *   otherwise the transaction result.
+ */
+static esp_err_t demo_i2c_access(const char *who, uint8_t addr, const uint8_t *data, size_t len)
+{
+#if DEMO_I2C_USE_BUS_OWNER
+    // A full queue is reported by the bus owner itself
+    esp_err_t err = bus_owner_write(addr, data, len, pdMS_TO_TICKS(DEMO_I2C_WAIT_MS));
+    ESP_LOGI(TAG, "I2C %s: bus owner returned %s", who, esp_err_to_name(err));
+    return err;
+#else
+    if (tracked_mutex_take(&g_i2c_mutex, pdMS_TO_TICKS(DEMO_I2C_WAIT_MS)) != pdTRUE) {
+        ESP_LOGW(TAG, "I2C %s: failed to lock bus (timeout)", who);
+        return ESP_ERR_TIMEOUT;
+    }
+
+    ESP_LOGI(TAG, "I2C %s: bus locked", who);
+    esp_err_t err = demo_i2c_write(addr, data, len);
+    ESP_LOGI(TAG, "I2C %s: bus released", who);
+
+    tracked_mutex_give(&g_i2c_mutex);
+    return err;
+#endif
+}
+
 /* --------------------------- ISR --------------------------- */
 
 /**
@@ -164,7 +273,8 @@ static void IRAM_ATTR gpio_isr_handler(void *arg)
  *
  * The task takes the I2C mutex, performs a minimal I2C transaction stub (or just
  * a short critical region), then releases the mutex. This represents the common
- * "shared bus" scenario in embedded firmware.
+ * "shared bus" scenario in embedded firmware. It runs above the EEPROM task, so
+ * its waits on the mutex are counted as priority-inversion events.
  *
  * Args:
  *   arg: Unused (NULL).
@@ -177,32 +287,8 @@ static void i2c_task_sensor(void *arg)
     (void)arg;
 
     while (true) {
-        if (xSemaphoreTake(g_i2c_mutex, pdMS_TO_TICKS(500)) == pdTRUE) {
-            ESP_LOGI(TAG, "I2C SENSOR: bus locked");
-
-            // Create and initialize an I2C commands list with a given buffer
-            i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-            
-            // Start the I2C command sequence
-            i2c_master_start(cmd);
-            
-            // Wtrite to device address 0x48 (typical temp sensor)
-            i2c_master_write_byte(cmd, (0x48 << 1) | I2C_MASTER_WRITE, true);
-            
-            // End the I2C command sequence
-            i2c_master_stop(cmd);
-            
-            // Execute the I2C command
-            (void)i2c_master_cmd_begin(DEMO_I2C_PORT, cmd, pdMS_TO_TICKS(20));
-            
-            // Delete the I2C commands list to free resources
-            i2c_cmd_link_delete(cmd);
-
-            ESP_LOGI(TAG, "I2C SENSOR: bus released");
-            xSemaphoreGive(g_i2c_mutex);
-        } else {
-            ESP_LOGW(TAG, "I2C SENSOR: failed to lock bus (timeout)");
-        }
+        // Address-only write to 0x48 (typical temp sensor)
+        (void)demo_i2c_access("SENSOR", 0x48, NULL, 0);
 
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
@@ -212,7 +298,9 @@ static void i2c_task_sensor(void *arg)
  * @brief Task B: pretend to write to EEPROM over I2C, protected by a mutex.
  *
  * This task competes with the sensor task for the same I2C bus mutex.
- * The point is not successful I2C I/O, but correct mutual exclusion.
+ * The point is not successful I2C I/O, but correct mutual exclusion. It runs
+ * below the workers: while it holds the bus, only priority inheritance keeps
+ * them from delaying a waiting sensor task.
  *
  * Args:
  *   arg: Unused (NULL).
@@ -224,37 +312,12 @@ static void i2c_task_eeprom(void *arg)
 {
     (void)arg;
 
+    // Word address 0x00 followed by one byte of "data"
+    static const uint8_t payload[] = { 0x00, 0xAA };
+
     while (true) {
-        if (xSemaphoreTake(g_i2c_mutex, pdMS_TO_TICKS(500)) == pdTRUE) {
-            ESP_LOGI(TAG, "I2C EEPROM: bus locked");
-
-            // Create and initialize an I2C commands list with a given buffer
-            i2c_cmd_handle_t cmd = i2c_cmd_link_create();
-
-            // Start the I2C command sequence
-            i2c_master_start(cmd);
-            
-            // Write to device address 0x50 (typical EEPROM)
-            i2c_master_write_byte(cmd, (0x50 << 1) | I2C_MASTER_WRITE, true);
-            
-            // Write two bytes of "data".
-            i2c_master_write_byte(cmd, 0x00, true);
-            i2c_master_write_byte(cmd, 0xAA, true);
-
-            // End the I2C command sequence
-            i2c_master_stop(cmd);
-            
-            // Execute the I2C command
-            (void)i2c_master_cmd_begin(DEMO_I2C_PORT, cmd, pdMS_TO_TICKS(20));
-            
-            // Delete the I2C commands list to free resources
-            i2c_cmd_link_delete(cmd);
-
-            ESP_LOGI(TAG, "I2C EEPROM: bus released");
-            xSemaphoreGive(g_i2c_mutex);
-        } else {
-            ESP_LOGW(TAG, "I2C EEPROM: failed to lock bus (timeout)");
-        }
+        // Write to 0x50 (typical EEPROM)
+        (void)demo_i2c_access("EEPROM", 0x50, payload, sizeof(payload));
 
         vTaskDelay(pdMS_TO_TICKS(2000));
     }
@@ -323,6 +386,33 @@ static void worker_task(void *arg)
     }
 }
 
+/**
+ * @brief Task: periodically report shared-bus statistics.
+ *
+ * Logs the instrumented mutex statistics, or the bus-owner queue statistics
+ * when DEMO_I2C_USE_BUS_OWNER is set. Each report covers one window.
+ *
+ * Args:
+ *   arg: Unused (NULL).
+ *
+ * Returns:
+ *   None (FreeRTOS task).
+ */
+static void stats_task(void *arg)
+{
+    (void)arg;
+
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(DEMO_STATS_PERIOD_MS));
+
+#if DEMO_I2C_USE_BUS_OWNER
+        bus_owner_log_stats();
+#else
+        tracked_mutex_log_stats(&g_i2c_mutex);
+#endif
+    }
+}
+
 /* --------------------------- App Entry --------------------------- */
 
 /**
@@ -330,6 +420,7 @@ static void worker_task(void *arg)
  *
  * This function initializes:
  * - I2C driver (for the mutex-protected shared bus demo)
+ * - Optionally the bus-owner task that replaces the mutex
  * - GPIO interrupt + binary semaphore (for ISR-to-task signaling demo)
  * - Counting semaphore (resource pool demo)
  * Then it starts tasks for each scenario.
@@ -342,11 +433,11 @@ void app_main(void)
     ESP_LOGI(TAG, "Starting Semaphore vs Mutex demo");
 
     // Create primitives first (best practice).
-    g_i2c_mutex = xSemaphoreCreateMutex();
+    esp_err_t mutex_err = tracked_mutex_init(&g_i2c_mutex, "i2c_bus");
     g_gpio_sem = xSemaphoreCreateBinary();
     g_pool_sem = xSemaphoreCreateCounting(BUFFER_POOL_SIZE, BUFFER_POOL_SIZE);
 
-    if (g_i2c_mutex == NULL || g_gpio_sem == NULL || g_pool_sem == NULL) {
+    if (mutex_err != ESP_OK || g_gpio_sem == NULL || g_pool_sem == NULL) {
         ESP_LOGE(TAG, "Failed to create synchronization primitives");
         return;
     }
@@ -361,13 +452,23 @@ void app_main(void)
     // GPIO init for interrupt demo.
     demo_gpio_init();
 
+#if DEMO_I2C_USE_BUS_OWNER
+    // The owner task becomes the only code that touches the I2C bus.
+    err = bus_owner_start(demo_i2c_write, PRIO_BUS_OWNER);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start bus owner (%s)", esp_err_to_name(err));
+        return;
+    }
+#endif
+
     // Start tasks. 
-    xTaskCreate(i2c_task_sensor, "i2c_sensor", 4096, NULL, 5, NULL);
-    xTaskCreate(i2c_task_eeprom, "i2c_eeprom", 4096, NULL, 5, NULL);
-    xTaskCreate(gpio_event_task, "gpio_evt", 3072, NULL, 10, NULL);
+    xTaskCreate(i2c_task_sensor, "i2c_sensor", 4096, NULL, PRIO_I2C_SENSOR, NULL);
+    xTaskCreate(i2c_task_eeprom, "i2c_eeprom", 4096, NULL, PRIO_I2C_EEPROM, NULL);
+    xTaskCreate(gpio_event_task, "gpio_evt", 3072, NULL, PRIO_GPIO_EVENT, NULL);
+    xTaskCreate(stats_task, "bus_stats", 3072, NULL, PRIO_STATS, NULL);
 
     for (int i = 0; i < WORKER_TASK_COUNT; i++) {
-        xTaskCreate(worker_task, "worker", 3072, (void *)(intptr_t)i, 4, NULL);
+        xTaskCreate(worker_task, "worker", 3072, (void *)(intptr_t)i, PRIO_WORKER, NULL);
     }
 
     ESP_LOGI(TAG, "Tasks started. Press BOOT (GPIO0) to trigger GPIO semaphore.");
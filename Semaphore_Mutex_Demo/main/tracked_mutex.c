@@ -0,0 +1,115 @@
+/**
+ * @file tracked_mutex.c
+ * @brief FreeRTOS mutex wrapper with hold/wait/contention/inversion statistics.
+ */
+
+#include "tracked_mutex.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "freertos/task.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#define TAG "tracked_mutex"
+
+esp_err_t tracked_mutex_init(tracked_mutex_t *m, const char *name)
+{
+    memset(m, 0, sizeof(*m));
+    m->name = name;
+    portMUX_INITIALIZE(&m->lock);
+
+    m->handle = xSemaphoreCreateMutex();
+    return (m->handle != NULL) ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+BaseType_t tracked_mutex_take(tracked_mutex_t *m, TickType_t timeout)
+{
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    const UBaseType_t my_priority = uxTaskPriorityGet(NULL);
+
+    // Sample the holder before blocking; holder_priority is its own priority
+    // captured at its take, before any inheritance boost from us
+    taskENTER_CRITICAL(&m->lock);
+    const TaskHandle_t holder = m->holder;
+    const UBaseType_t holder_priority = m->holder_priority;
+    taskEXIT_CRITICAL(&m->lock);
+
+    const bool contended = (holder != NULL) && (holder != self);
+    const bool inversion = contended && (my_priority > holder_priority);
+
+    const int64_t start_us = esp_timer_get_time();
+    const BaseType_t taken = xSemaphoreTake(m->handle, timeout);
+    const int64_t now_us = esp_timer_get_time();
+    const uint32_t wait_us = (uint32_t)(now_us - start_us);
+
+    taskENTER_CRITICAL(&m->lock);
+    if (taken == pdTRUE) {
+        m->holder = self;
+        m->holder_priority = my_priority;
+        m->acquired_us = now_us;
+
+        m->stats.takes++;
+        m->stats.wait_total_us += wait_us;
+        if (wait_us > m->stats.wait_max_us) {
+            m->stats.wait_max_us = wait_us;
+        }
+    } else {
+        m->stats.timeouts++;
+    }
+
+    if (contended) {
+        m->stats.contended++;
+    }
+    if (inversion) {
+        m->stats.inversions++;
+        if (wait_us > m->stats.inversion_max_us) {
+            m->stats.inversion_max_us = wait_us;
+        }
+    }
+    taskEXIT_CRITICAL(&m->lock);
+
+    return taken;
+}
+
+void tracked_mutex_give(tracked_mutex_t *m)
+{
+    const int64_t now_us = esp_timer_get_time();
+
+    taskENTER_CRITICAL(&m->lock);
+    const uint32_t hold_us = (uint32_t)(now_us - m->acquired_us);
+    m->stats.hold_total_us += hold_us;
+    if (hold_us > m->stats.hold_max_us) {
+        m->stats.hold_max_us = hold_us;
+    }
+    m->holder = NULL;
+    taskEXIT_CRITICAL(&m->lock);
+
+    xSemaphoreGive(m->handle);
+}
+
+void tracked_mutex_snapshot(tracked_mutex_t *m, tracked_mutex_stats_t *out)
+{
+    taskENTER_CRITICAL(&m->lock);
+    *out = m->stats;
+    memset(&m->stats, 0, sizeof(m->stats));
+    taskEXIT_CRITICAL(&m->lock);
+}
+
+void tracked_mutex_log_stats(tracked_mutex_t *m)
+{
+    tracked_mutex_stats_t s;
+    tracked_mutex_snapshot(m, &s);
+
+    const uint32_t wait_avg_us = (s.takes > 0) ? (uint32_t)(s.wait_total_us / s.takes) : 0;
+    const uint32_t hold_avg_us = (s.takes > 0) ? (uint32_t)(s.hold_total_us / s.takes) : 0;
+
+    ESP_LOGI(TAG, "%s: takes=%" PRIu32 " timeouts=%" PRIu32 " contended=%" PRIu32
+             " inversions=%" PRIu32 " (max %" PRIu32 " us)",
+             m->name, s.takes, s.timeouts, s.contended, s.inversions, s.inversion_max_us);
+    ESP_LOGI(TAG, "%s: wait avg/max=%" PRIu32 "/%" PRIu32 " us hold avg/max=%" PRIu32 "/%" PRIu32 " us",
+             m->name, wait_avg_us, s.wait_max_us, hold_avg_us, s.hold_max_us);
+}
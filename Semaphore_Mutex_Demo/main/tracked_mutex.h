@@ -0,0 +1,110 @@
+/**
+ * @file tracked_mutex.h
+ * @brief FreeRTOS mutex wrapper that measures hold time, wait time, contention
+ *        and priority-inversion events.
+ *
+ * A take counts as contended when another task held the mutex at the moment
+ * of the call. It counts as a priority-inversion event when the waiter's
+ * priority was higher than the holder's own priority. FreeRTOS priority
+ * inheritance then boosts the holder, and the waiter's wait time for such
+ * takes is tracked separately as the inversion time.
+ *
+ * Statistics are windowed: tracked_mutex_log_stats() prints and clears them.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "esp_err.h"
+
+/**
+ * @brief Counters for one statistics window. Times are in microseconds.
+ */
+typedef struct {
+    uint32_t takes;             /* Successful takes */
+    uint32_t timeouts;          /* Takes that gave up */
+    uint32_t contended;         /* Takes that found the mutex held by another task */
+    uint32_t inversions;        /* Contended takes by a higher-priority waiter */
+    uint64_t wait_total_us;
+    uint32_t wait_max_us;
+    uint32_t inversion_max_us;  /* Longest wait of an inversion event */
+    uint64_t hold_total_us;
+    uint32_t hold_max_us;
+} tracked_mutex_stats_t;
+
+/**
+ * @brief Instrumented mutex. Treat the fields as private.
+ */
+typedef struct {
+    const char *name;
+    SemaphoreHandle_t handle;
+    TaskHandle_t holder;
+    UBaseType_t holder_priority;
+    int64_t acquired_us;
+    portMUX_TYPE lock;
+    tracked_mutex_stats_t stats;
+} tracked_mutex_t;
+
+/**
+ * @brief Create the underlying mutex.
+ *
+ * Args:
+ *   m: Mutex to initialize.
+ *   name: Name used in the statistics log; must outlive the mutex.
+ *
+ * Returns:
+ *   ESP_OK, or ESP_ERR_NO_MEM if the mutex could not be created.
+ */
+esp_err_t tracked_mutex_init(tracked_mutex_t *m, const char *name);
+
+/**
+ * @brief Take the mutex, recording wait time and contention.
+ *
+ * Args:
+ *   m: Mutex.
+ *   timeout: Maximum time to wait, in ticks.
+ *
+ * Returns:
+ *   pdTRUE if the mutex was taken, pdFALSE on timeout.
+ */
+BaseType_t tracked_mutex_take(tracked_mutex_t *m, TickType_t timeout);
+
+/**
+ * @brief Give the mutex back, recording the hold time.
+ *
+ * Must be called by the task that took it.
+ *
+ * Args:
+ *   m: Mutex.
+ *
+ * Returns:
+ *   None
+ */
+void tracked_mutex_give(tracked_mutex_t *m);
+
+/**
+ * @brief Copy the current window's statistics and start a new window.
+ *
+ * Args:
+ *   m: Mutex.
+ *   out: Receives the statistics.
+ *
+ * Returns:
+ *   None
+ */
+void tracked_mutex_snapshot(tracked_mutex_t *m, tracked_mutex_stats_t *out);
+
+/**
+ * @brief Log the current window's statistics and start a new window.
+ *
+ * Args:
+ *   m: Mutex.
+ *
+ * Returns:
+ *   None
+ */
+void tracked_mutex_log_stats(tracked_mutex_t *m);
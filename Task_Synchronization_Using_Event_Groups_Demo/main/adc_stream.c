@@ -0,0 +1,288 @@
+/**
+ * @file adc_stream.c
+ *
+ * @brief Continuous (DMA) ADC sampling with decimation and batch mV conversion.
+ */
+
+#include "adc_stream.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "freertos/task.h"
+
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_adc/adc_continuous.h"
+#include "esp_adc/adc_cali.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include "soc/soc_caps.h"
+
+#define TAG "ADC_STREAM"
+
+#define ADC_STREAM_FRAME_BYTES   (ADC_STREAM_FRAME_SAMPLES * SOC_ADC_DIGI_RESULT_BYTES)
+
+/* The ESP32 DMA uses the type 1 result layout, later chips type 2. */
+#if CONFIG_IDF_TARGET_ESP32
+#define ADC_STREAM_OUTPUT_FORMAT     ADC_DIGI_OUTPUT_FORMAT_TYPE1
+#define ADC_STREAM_GET_CHANNEL(p)    ((p)->type1.channel)
+#define ADC_STREAM_GET_DATA(p)       ((p)->type1.data)
+#else
+#define ADC_STREAM_OUTPUT_FORMAT     ADC_DIGI_OUTPUT_FORMAT_TYPE2
+#define ADC_STREAM_GET_CHANNEL(p)    ((p)->type2.channel)
+#define ADC_STREAM_GET_DATA(p)       ((p)->type2.data)
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* State                                                                       */
+/* -------------------------------------------------------------------------- */
+
+static adc_continuous_handle_t s_handle = NULL;
+static adc_cali_handle_t s_cali = NULL;
+static TaskHandle_t s_consumer = NULL;
+
+static adc_channel_t s_channel;
+static uint32_t s_decimation = 1;
+
+static volatile uint32_t s_overflows = 0;
+
+/* Decimation block carried between reads */
+static uint32_t s_block_sum = 0;
+static uint32_t s_block_count = 0;
+
+static uint8_t s_frame[ADC_STREAM_FRAME_BYTES];
+
+/* -------------------------------------------------------------------------- */
+/* Driver Callbacks (ISR context)                                              */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * on_conv_done
+ *
+ * @brief Frame-done callback: wake the consumer, nothing else.
+ *
+ * @return true if a higher-priority task was woken.
+ */
+static bool IRAM_ATTR on_conv_done(adc_continuous_handle_t handle,
+                                   const adc_continuous_evt_data_t *edata,
+                                   void *user_data)
+{
+    (void)handle;
+    (void)edata;
+    (void)user_data;
+
+    BaseType_t woken = pdFALSE;
+    if (s_consumer != NULL) {
+        vTaskNotifyGiveFromISR(s_consumer, &woken);
+    }
+    return woken == pdTRUE;
+}
+
+/**
+ * on_pool_ovf
+ *
+ * @brief Pool-overflow callback: the consumer fell behind by a whole pool.
+ *
+ * @return false; no task is woken.
+ */
+static bool IRAM_ATTR on_pool_ovf(adc_continuous_handle_t handle,
+                                  const adc_continuous_evt_data_t *edata,
+                                  void *user_data)
+{
+    (void)handle;
+    (void)edata;
+    (void)user_data;
+
+    s_overflows++;
+    return false;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Helpers                                                                     */
+/* -------------------------------------------------------------------------- */
+
+/**
+ * create_calibration
+ *
+ * @brief Creates the best calibration scheme the target supports.
+ *
+ * @param cfg Stream configuration.
+ *
+ * @return Calibration handle, or NULL if no scheme is available (e.g. eFuse
+ *         not burnt).
+ */
+static adc_cali_handle_t create_calibration(const adc_stream_config_t *cfg)
+{
+    adc_cali_handle_t handle = NULL;
+    esp_err_t err = ESP_ERR_NOT_SUPPORTED;
+
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+    adc_cali_curve_fitting_config_t curve_cfg = {
+        .unit_id = cfg->unit,
+        .chan = cfg->channel,
+        .atten = cfg->atten,
+        .bitwidth = ADC_BITWIDTH_DEFAULT,
+    };
+    err = adc_cali_create_scheme_curve_fitting(&curve_cfg, &handle);
+#elif ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+    adc_cali_line_fitting_config_t line_cfg = {
+        .unit_id = cfg->unit,
+        .atten = cfg->atten,
+        .bitwidth = ADC_BITWIDTH_DEFAULT,
+    };
+    err = adc_cali_create_scheme_line_fitting(&line_cfg, &handle);
+#else
+    (void)cfg;
+#endif
+
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "No ADC calibration (%s), reporting raw codes", esp_err_to_name(err));
+        return NULL;
+    }
+    return handle;
+}
+
+/**
+ * decimate_frame
+ *
+ * @brief Folds one frame of raw results into decimated outputs.
+ *
+ * @param data     Raw DMA results.
+ * @param len      Length of data in bytes.
+ * @param[out] out Receives completed block averages.
+ *
+ * @return Number of values written to out.
+ */
+static size_t decimate_frame(const uint8_t *data, uint32_t len, int *out)
+{
+    size_t n_out = 0;
+
+    for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= len; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        const adc_digi_output_data_t *p = (const adc_digi_output_data_t *)&data[i];
+
+        if (ADC_STREAM_GET_CHANNEL(p) != (uint32_t)s_channel) {
+            continue;
+        }
+
+        s_block_sum += ADC_STREAM_GET_DATA(p);
+        if (++s_block_count == s_decimation) {
+            out[n_out++] = (int)((s_block_sum + s_decimation / 2U) / s_decimation);
+            s_block_sum = 0;
+            s_block_count = 0;
+        }
+    }
+    return n_out;
+}
+
+/* -------------------------------------------------------------------------- */
+/* Public API                                                                  */
+/* -------------------------------------------------------------------------- */
+
+esp_err_t adc_stream_init(const adc_stream_config_t *cfg)
+{
+    if (s_handle != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (cfg == NULL || cfg->decimation == 0 ||
+        cfg->sample_hz < SOC_ADC_SAMPLE_FREQ_THRES_LOW ||
+        cfg->sample_hz > SOC_ADC_SAMPLE_FREQ_THRES_HIGH) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    adc_continuous_handle_cfg_t handle_cfg = {
+        .max_store_buf_size = ADC_STREAM_FRAME_BYTES * ADC_STREAM_POOL_FRAMES,
+        .conv_frame_size = ADC_STREAM_FRAME_BYTES,
+    };
+    esp_err_t err = adc_continuous_new_handle(&handle_cfg, &s_handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    adc_digi_pattern_config_t pattern = {
+        .atten = cfg->atten,
+        .channel = cfg->channel & 0x7,
+        .unit = cfg->unit,
+        .bit_width = SOC_ADC_DIGI_MAX_BITWIDTH,
+    };
+    adc_continuous_config_t dig_cfg = {
+        .pattern_num = 1,
+        .adc_pattern = &pattern,
+        .sample_freq_hz = cfg->sample_hz,
+        .conv_mode = (cfg->unit == ADC_UNIT_1) ? ADC_CONV_SINGLE_UNIT_1 : ADC_CONV_SINGLE_UNIT_2,
+        .format = ADC_STREAM_OUTPUT_FORMAT,
+    };
+
+    err = adc_continuous_config(s_handle, &dig_cfg);
+    if (err == ESP_OK) {
+        adc_continuous_evt_cbs_t cbs = {
+            .on_conv_done = on_conv_done,
+            .on_pool_ovf = on_pool_ovf,
+        };
+        err = adc_continuous_register_event_callbacks(s_handle, &cbs, NULL);
+    }
+    if (err != ESP_OK) {
+        adc_continuous_deinit(s_handle);
+        s_handle = NULL;
+        return err;
+    }
+
+    s_channel = cfg->channel;
+    s_decimation = cfg->decimation;
+    s_cali = create_calibration(cfg);
+
+    ESP_LOGI(TAG, "Continuous ADC: %" PRIu32 " Hz, /%" PRIu32 " decimation, %d-sample frames",
+             cfg->sample_hz, cfg->decimation, ADC_STREAM_FRAME_SAMPLES);
+    return ESP_OK;
+}
+
+esp_err_t adc_stream_start(void)
+{
+    if (s_handle == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_consumer = xTaskGetCurrentTaskHandle();
+    return adc_continuous_start(s_handle);
+}
+
+size_t adc_stream_read(int *out, size_t max_out, TickType_t timeout)
+{
+    const size_t per_frame_max = ADC_STREAM_FRAME_SAMPLES / s_decimation + 1U;
+    size_t n_out = 0;
+
+    if (s_handle == NULL || max_out < per_frame_max) {
+        return 0;
+    }
+
+    // One notification per finished frame; take them all and drain the pool
+    if (ulTaskNotifyTake(pdTRUE, timeout) == 0) {
+        return 0;
+    }
+
+    while (max_out - n_out >= per_frame_max) {
+        uint32_t got = 0;
+        if (adc_continuous_read(s_handle, s_frame, sizeof(s_frame), &got, 0) != ESP_OK) {
+            break;
+        }
+        n_out += decimate_frame(s_frame, got, &out[n_out]);
+    }
+
+    // Batch conversion of the decimated values only
+    if (s_cali != NULL) {
+        for (size_t i = 0; i < n_out; i++) {
+            (void)adc_cali_raw_to_voltage(s_cali, out[i], &out[i]);
+        }
+    }
+
+    return n_out;
+}
+
+bool adc_stream_is_calibrated(void)
+{
+    return s_cali != NULL;
+}
+
+uint32_t adc_stream_overflows(void)
+{
+    return s_overflows;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file adc_stream.h
+ *
+ * @brief Continuous (DMA) ADC sampling with decimation and batch mV conversion.
+ *
+ * The ADC digital controller samples one channel at a fixed rate and DMA
+ * fills conversion frames of ADC_STREAM_FRAME_SAMPLES results. The driver's
+ * frame-done callback only notifies the consumer task, so the task wakes once
+ * per frame instead of once per sample. The consumer averages every
+ * `decimation` raw samples into one output and converts the whole batch of
+ * outputs to millivolts with the ADC calibration scheme.
+ *
+ * Averaging happens on raw codes before calibration. The calibration curve is
+ * close to linear over the small spread of one block, so the error is far
+ * below the ADC noise.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "esp_err.h"
+#include "hal/adc_types.h"
+
+/* Raw results per DMA conversion frame (one frame-done callback each). */
+#define ADC_STREAM_FRAME_SAMPLES   256
+/* Frames the driver can buffer before it reports a pool overflow. */
+#define ADC_STREAM_POOL_FRAMES     4
+
+/**
+ * @brief Stream configuration.
+ */
+typedef struct {
+    adc_unit_t unit;
+    adc_channel_t channel;
+    adc_atten_t atten;
+    uint32_t sample_hz;     /**< Raw conversion rate in Hz. */
+    uint32_t decimation;    /**< Raw samples averaged into one output (>= 1). */
+} adc_stream_config_t;
+
+/**
+ * adc_stream_init
+ *
+ * @brief Creates the continuous-mode driver, calibration and frame callback.
+ *
+ * Conversions do not start until adc_stream_start() is called.
+ *
+ * @param cfg Stream configuration.
+ *
+ * @return
+ * - ESP_OK on success
+ * - ESP_ERR_INVALID_ARG if the rate or decimation is out of range
+ * - ESP_ERR_INVALID_STATE if already initialized
+ * - Driver error code on failure
+ */
+esp_err_t adc_stream_init(const adc_stream_config_t *cfg);
+
+/**
+ * adc_stream_start
+ *
+ * @brief Starts conversions and makes the calling task the frame consumer.
+ *
+ * @return
+ * - ESP_OK on success
+ * - ESP_ERR_INVALID_STATE if not initialized
+ * - Driver error code on failure
+ */
+esp_err_t adc_stream_start(void);
+
+/**
+ * adc_stream_read
+ *
+ * @brief Waits for DMA frames, then decimates and converts everything pending.
+ *
+ * Must be called from the task that called adc_stream_start(). Partial
+ * decimation blocks are carried over to the next call.
+ *
+ * @param[out] out     Receives decimated values, in mV when calibrated,
+ *                     otherwise raw codes (see adc_stream_is_calibrated()).
+ * @param max_out      Capacity of out; must be at least
+ *                     ADC_STREAM_FRAME_SAMPLES / decimation + 1.
+ * @param timeout      How long to wait for a frame.
+ *
+ * @return Number of values written to out (0 on timeout).
+ */
+size_t adc_stream_read(int *out, size_t max_out, TickType_t timeout);
+
+/**
+ * adc_stream_is_calibrated
+ *
+ * @brief Reports whether adc_stream_read() returns millivolts.
+ *
+ * @return true if a calibration scheme is active.
+ */
+bool adc_stream_is_calibrated(void);
+
+/**
+ * adc_stream_overflows
+ *
+ * @brief Number of times the driver pool filled up and dropped a frame.
+ *
+ * @return Overflow count since init.
+ */
+uint32_t adc_stream_overflows(void);
@@ -11,7 +11,7 @@
  * Demonstrated use cases include:
  * - System startup barrier (waiting for multiple subsystems to initialize)
  * - OR vs AND event wait logic
- * - ADC sampling readiness signaling
+ * - ADC sampling readiness signaling (continuous DMA mode or oneshot reads)
  * - GPIO stability monitoring
  * - Simulated I2C temperature sensing
  * - Aggregation of multi-source readiness into a single payload
@@ -19,8 +19,9 @@
  *
  * Important design note:
  * Event Groups are used strictly for signaling state and readiness.
- * They are NOT used for data transfer. Shared data is kept minimal and
- * intentionally simple for demonstration purposes.
+ * They are NOT used for data transfer. Producers publish their values into
+ * a double-buffered sampling round (sampling_round.c) guarded by a sequence
+ * lock, so the aggregator reads a consistent snapshot without any mutex.
  *
  * Target:
  * - ESP32-S3
@@ -31,6 +32,7 @@
 
 #include <stdio.h>
 #include <inttypes.h>
+#include <limits.h>
 #include <string.h>
 
 #include "freertos/FreeRTOS.h"
@@ -45,6 +47,9 @@
 #include "esp_adc/adc_oneshot.h"
 #include "hal/adc_types.h"
 
+#include "adc_stream.h"
+#include "sampling_round.h"
+
 /* -------------------------------------------------------------------------- */
 /* Configuration                                                              */
 /* -------------------------------------------------------------------------- */
@@ -55,6 +60,18 @@
 #define DEMO_ADC_UNIT   ADC_UNIT_1
 #define DEMO_ADC_CHANNEL ADC_CHANNEL_0
 
+/*
+ * ADC acquisition mode. Continuous mode samples at DEMO_ADC_SAMPLE_HZ via DMA
+ * and wakes adc_task once per frame; oneshot mode reads one conversion every
+ * DEMO_ADC_PUBLISH_MS.
+ */
+#define DEMO_ADC_CONTINUOUS    1
+#define DEMO_ADC_SAMPLE_HZ     20000   /* Raw rate, 20 kS/s */
+#define DEMO_ADC_DECIMATION    20      /* Averaged down to 1 kS/s */
+#define DEMO_ADC_PUBLISH_MS    500     /* Window published to the sampling round */
+#define DEMO_ADC_STATS_WINDOWS 10      /* Log window statistics every N windows */
+#define DEMO_ADC_BATCH_MAX     (ADC_STREAM_POOL_FRAMES * (ADC_STREAM_FRAME_SAMPLES / DEMO_ADC_DECIMATION + 1))
+
 #define STACK_SMALL   3072
 #define STACK_MEDIUM  4096
 
@@ -65,6 +82,8 @@
 #define PRIO_AGGREGATOR  7
 #define PRIO_DIAG        5
 
+#define ROUND_TIMEOUT_MS 3000
+
 /* -------------------------------------------------------------------------- */
 /* Event Bits                                                                  */
 /* -------------------------------------------------------------------------- */
@@ -87,11 +106,16 @@
 /* -------------------------------------------------------------------------- */
 
 static EventGroupHandle_t g_evt = NULL;
+#if !DEMO_ADC_CONTINUOUS
 static adc_oneshot_unit_handle_t g_adc_handle = NULL;
+#endif
 
-static volatile int   g_last_adc_raw   = 0;
-static volatile float g_last_temp_c    = 0.0f;
-static volatile int   g_last_gpio_lvl  = 0;
+/* Data-ready bit raised by each sampling round source */
+static const EventBits_t k_src_ready_bits[SAMPLE_SRC_COUNT] = {
+    [SAMPLE_SRC_ADC]  = EVT_ADC_READY,
+    [SAMPLE_SRC_TEMP] = EVT_TEMP_READY,
+    [SAMPLE_SRC_GPIO] = EVT_GPIO_READY,
+};
 
 /* -------------------------------------------------------------------------- */
 /* Utility Functions                                                           */
@@ -132,6 +156,29 @@ static esp_err_t init_gpio_input(gpio_num_t pin)
     return gpio_config(&cfg);
 }
 
+#if DEMO_ADC_CONTINUOUS
+/**
+ * init_adc_continuous
+ *
+ * @brief Initializes the continuous-mode ADC stream on the demo channel.
+ *
+ * @return
+ * - ESP_OK on success
+ * - ESP_FAIL or error code on failure
+ */
+static esp_err_t init_adc_continuous(void)
+{
+    const adc_stream_config_t cfg = {
+        .unit = DEMO_ADC_UNIT,
+        .channel = DEMO_ADC_CHANNEL,
+        .atten = ADC_ATTEN_DB_11,
+        .sample_hz = DEMO_ADC_SAMPLE_HZ,
+        .decimation = DEMO_ADC_DECIMATION,
+    };
+
+    return adc_stream_init(&cfg);
+}
+#else
 /**
  * init_adc_oneshot
  *
@@ -159,6 +206,67 @@ static esp_err_t init_adc_oneshot(void)
 
     return adc_oneshot_config_channel(g_adc_handle, DEMO_ADC_CHANNEL, &chan_cfg);
 }
+#endif
+
+/**
+ * src_mask_to_bits
+ *
+ * @brief Converts a SAMPLE_SRC mask into the matching data-ready event bits.
+ *
+ * @param mask Mask with bit n set for source n.
+ *
+ * @return EventBits_t Data-ready bits for the sources in mask.
+ */
+static EventBits_t src_mask_to_bits(uint32_t mask)
+{
+    EventBits_t bits = 0;
+
+    for (int src = 0; src < SAMPLE_SRC_COUNT; src++) {
+        if (mask & (1U << src)) {
+            bits |= k_src_ready_bits[src];
+        }
+    }
+    return bits;
+}
+
+/**
+ * publish_sample
+ *
+ * @brief Publishes a value into the open sampling round and raises its ready bit.
+ *
+ * @param src   Producer publishing the value.
+ * @param value Value to publish.
+ */
+static void publish_sample(sample_src_t src, sample_value_t value)
+{
+    sampling_round_publish(src, value);
+    xEventGroupSetBits(g_evt, k_src_ready_bits[src]);
+}
+
+/**
+ * log_round_timeout
+ *
+ * @brief Logs which producers have not yet published into the open round.
+ */
+static void log_round_timeout(void)
+{
+    sample_round_t round;
+    sampling_round_peek(&round);
+
+    const uint32_t missing = SAMPLE_SRC_ALL_MASK & ~sampling_round_present_mask(&round);
+    const uint32_t age_ms = (uint32_t)((esp_timer_get_time() - round.opened_us) / 1000);
+
+    char names[32] = "";
+    for (int src = 0; src < SAMPLE_SRC_COUNT; src++) {
+        if (missing & (1U << src)) {
+            strlcat(names, " ", sizeof(names));
+            strlcat(names, sampling_round_src_name((sample_src_t)src), sizeof(names));
+        }
+    }
+
+    ESP_LOGW(APP_TAG, "Aggregator timeout: round %" PRIu32 " open for %" PRIu32 " ms, waiting on:%s",
+             round.id, age_ms, names);
+}
 
 /* -------------------------------------------------------------------------- */
 /* FreeRTOS Tasks                                                              */
@@ -186,9 +294,16 @@ static void init_task(void *arg)
         xEventGroupSetBits(g_evt, EVT_GPIO_INIT);
     }
 
-    // Initialize ADC oneshot and set event bit if successful
-    if (init_adc_oneshot() == ESP_OK) {
+    // Initialize the ADC and set event bit if successful
+#if DEMO_ADC_CONTINUOUS
+    esp_err_t adc_err = init_adc_continuous();
+#else
+    esp_err_t adc_err = init_adc_oneshot();
+#endif
+    if (adc_err == ESP_OK) {
         xEventGroupSetBits(g_evt, EVT_ADC_INIT);
+    } else {
+        ESP_LOGE(APP_TAG, "ADC init failed: %s", esp_err_to_name(adc_err));
     }
     
     // Simulate I2C initialization
@@ -205,10 +320,14 @@ static void init_task(void *arg)
 /**
  * adc_task
  *
- * @brief Periodically samples ADC and signals data readiness.
+ * @brief Samples the ADC and signals data readiness.
  *
- * This task waits for ADC initialization to complete, then periodically
- * reads raw ADC values and signals readiness using an Event Group bit.
+ * This task waits for ADC initialization to complete. In continuous mode it
+ * starts the DMA stream and sleeps until a frame is done; each wakeup yields
+ * a batch of decimated, calibrated millivolt values. Every
+ * DEMO_ADC_PUBLISH_MS the window mean is published into the sampling round,
+ * and the window peak-to-peak (the vibration amplitude) is logged
+ * periodically. In oneshot mode it reads one raw value per period instead.
  *
  * @param arg Unused.
  */
@@ -219,17 +338,66 @@ static void adc_task(void *arg)
     // Block until ADC initialization is complete
     xEventGroupWaitBits(g_evt, EVT_ADC_INIT, pdFALSE, pdTRUE, portMAX_DELAY);
 
+#if DEMO_ADC_CONTINUOUS
+    static int batch[DEMO_ADC_BATCH_MAX];
+
+    if (adc_stream_start() != ESP_OK) {
+        ESP_LOGE(APP_TAG, "ADC stream failed to start");
+        vTaskDelete(NULL);
+    }
+
+    int64_t window_start_us = esp_timer_get_time();
+    int64_t window_sum = 0;
+    uint32_t window_count = 0;
+    int window_min = INT_MAX;
+    int window_max = INT_MIN;
+    uint32_t windows = 0;
+
+    while (1) {
+        // Sleeps until the next DMA frame; no wakeup per sample
+        size_t n = adc_stream_read(batch, DEMO_ADC_BATCH_MAX, pdMS_TO_TICKS(DEMO_ADC_PUBLISH_MS));
+
+        for (size_t i = 0; i < n; i++) {
+            window_sum += batch[i];
+            if (batch[i] < window_min) window_min = batch[i];
+            if (batch[i] > window_max) window_max = batch[i];
+        }
+        window_count += n;
+
+        const int64_t now_us = esp_timer_get_time();
+        if (now_us - window_start_us < (int64_t)DEMO_ADC_PUBLISH_MS * 1000) {
+            continue;
+        }
+
+        if (window_count > 0) {
+            // Publish the window mean and set the ADC ready bit
+            publish_sample(SAMPLE_SRC_ADC, (sample_value_t){ .i = (int32_t)(window_sum / window_count) });
+
+            if (++windows % DEMO_ADC_STATS_WINDOWS == 0) {
+                ESP_LOGI(APP_TAG, "ADC window: %" PRIu32 " values, mean %d, p-p %d %s, overflows %" PRIu32,
+                         window_count, (int)(window_sum / window_count), window_max - window_min,
+                         adc_stream_is_calibrated() ? "mV" : "raw", adc_stream_overflows());
+            }
+        }
+
+        window_start_us = now_us;
+        window_sum = 0;
+        window_count = 0;
+        window_min = INT_MAX;
+        window_max = INT_MIN;
+    }
+#else
     while (1) {
         int raw = 0;
         
-        // Set ADC ready event bit upon successful read
+        // Publish the sample and set the ADC ready bit upon successful read
         if (adc_oneshot_read(g_adc_handle, DEMO_ADC_CHANNEL, &raw) == ESP_OK) {
-            g_last_adc_raw = raw;
-            xEventGroupSetBits(g_evt, EVT_ADC_READY);
+            publish_sample(SAMPLE_SRC_ADC, (sample_value_t){ .i = raw });
         }
         
-        vTaskDelay(pdMS_TO_TICKS(500));
+        vTaskDelay(pdMS_TO_TICKS(DEMO_ADC_PUBLISH_MS));
     }
+#endif
 }
 
 /**
@@ -257,10 +425,8 @@ static void temp_task(void *arg)
         if (temp > 28.0f) direction = -1;
         if (temp < 22.0f) direction = 1;
 
-        g_last_temp_c = temp;
-        
-        // Set the temperature ready event bit
-        xEventGroupSetBits(g_evt, EVT_TEMP_READY);
+        // Publish the reading and set the temperature ready event bit
+        publish_sample(SAMPLE_SRC_TEMP, (sample_value_t){ .f = temp });
 
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
@@ -294,8 +460,6 @@ static void gpio_task(void *arg)
         
         // Read current GPIO level
         int cur = gpio_get_level(DEMO_GPIO_INPUT);
-        
-        g_last_gpio_lvl = cur;
 
         // Check for stability
         if (cur == last) {
@@ -305,9 +469,9 @@ static void gpio_task(void *arg)
             last = cur;
         }
 
-        // Set readiness bit if stable for 3 consecutive reads
+        // Publish the level and set the readiness bit if stable for 3 consecutive reads
         if (stable_count >= 3) {
-            xEventGroupSetBits(g_evt, EVT_GPIO_READY);
+            publish_sample(SAMPLE_SRC_GPIO, (sample_value_t){ .i = cur });
             stable_count = 0;
         }
 
@@ -321,8 +485,13 @@ static void gpio_task(void *arg)
  * @brief Aggregates data once all producers have reported readiness.
  *
  * This task demonstrates AND-based Event Group synchronization.
- * It waits until ADC, temperature, and GPIO readiness bits are all set.
- * A timeout is used to detect partial system failures.
+ * It waits until ADC, temperature, and GPIO readiness bits are all set,
+ * then closes the sampling round and formats the snapshot it got back.
+ * The event bits only wake the task; the round itself decides whether every
+ * producer has really published, and a bit that raced with the previous
+ * round close just makes the task wait for the remaining producers.
+ * A timeout is used to detect partial system failures and report which
+ * producers the round is still waiting on.
  *
  * @param arg Unused.
  */
@@ -333,28 +502,59 @@ static void aggregator_task(void *arg)
     // Block until system initialization is complete
     xEventGroupWaitBits(g_evt, EVT_ALL_INIT_MASK, pdFALSE, pdTRUE, portMAX_DELAY);
 
+    EventBits_t waiting = EVT_ALL_DATA_MASK;
+    uint32_t worst_ms = 0;
+
     while (1) {
-        // Block until all data-ready events are set, with timeout
+        // Block until all awaited data-ready events are set, with timeout
         EventBits_t bits = xEventGroupWaitBits(
             g_evt,
-            EVT_ALL_DATA_MASK,
+            waiting,
             pdTRUE,
             pdTRUE,
-            pdMS_TO_TICKS(3000)
+            pdMS_TO_TICKS(ROUND_TIMEOUT_MS)
         );
 
-        // Check if all data-ready bits are set
-        if ((bits & EVT_ALL_DATA_MASK) != EVT_ALL_DATA_MASK) {
-            ESP_LOGW(APP_TAG, "Aggregator timeout waiting for data");
+        // Check if all awaited data-ready bits are set
+        if ((bits & waiting) != waiting) {
+            log_round_timeout();
+            continue;
+        }
+
+        sample_round_t round;
+        uint32_t missing = 0;
+        if (!sampling_round_try_close(&round, &missing)) {
+            waiting = src_mask_to_bits(missing);
             continue;
         }
+        waiting = EVT_ALL_DATA_MASK;
+
+        // The producer that published last held the round open the longest
+        sample_src_t slowest = SAMPLE_SRC_ADC;
+        int64_t slowest_us = 0;
+        for (int src = 0; src < SAMPLE_SRC_COUNT; src++) {
+            int64_t latency_us = round.first_us[src] - round.opened_us;
+            if (latency_us > slowest_us) {
+                slowest_us = latency_us;
+                slowest = (sample_src_t)src;
+            }
+        }
+
+        const uint32_t slowest_ms = (uint32_t)(slowest_us / 1000);
+        if (slowest_ms > worst_ms) {
+            worst_ms = slowest_ms;
+        }
 
         char payload[160];
         snprintf(payload, sizeof(payload),
-                 "{\"ts_ms\":%" PRIu32 ",\"adc\":%d,\"temp\":%.2f,\"gpio\":%d}",
-                 millis(), g_last_adc_raw, g_last_temp_c, g_last_gpio_lvl);
+                 "{\"ts_ms\":%" PRIu32 ",\"round\":%" PRIu32 ",\"adc\":%" PRId32
+                 ",\"temp\":%.2f,\"gpio\":%" PRId32 "}",
+                 millis(), round.id, round.value[SAMPLE_SRC_ADC].i,
+                 round.value[SAMPLE_SRC_TEMP].f, round.value[SAMPLE_SRC_GPIO].i);
 
         ESP_LOGI(APP_TAG, "Payload: %s", payload);
+        ESP_LOGI(APP_TAG, "Round %" PRIu32 ": slowest producer %s after %" PRIu32 " ms (worst %" PRIu32 " ms)",
+                 round.id, sampling_round_src_name(slowest), slowest_ms, worst_ms);
         vTaskDelay(pdMS_TO_TICKS(200));
     }
 }
@@ -415,6 +615,9 @@ void app_main(void) {
         return;
     }
 
+    // Open the first sampling round before any producer runs
+    ESP_ERROR_CHECK(sampling_round_init());
+
 
     // Create demo tasks
     xTaskCreatePinnedToCore(init_task, "init_task", STACK_SMALL, NULL, PRIO_INIT, NULL, 0);
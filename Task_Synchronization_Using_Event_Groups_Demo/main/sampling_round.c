@@ -0,0 +1,178 @@
+/**
+ * @file sampling_round.c
+ *
+ * @brief Double-buffered sampling rounds guarded by multi-writer sequence locks.
+ */
+
+#include "sampling_round.h"
+
+#include <stdatomic.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_timer.h"
+
+/* -------------------------------------------------------------------------- */
+/* Buffers                                                                     */
+/* -------------------------------------------------------------------------- */
+
+typedef struct {
+    atomic_uint writers;    /* Writers currently inside the buffer */
+    atomic_uint seq;        /* Bumped at the end of every write */
+    sample_round_t data;
+} round_buffer_t;
+
+static round_buffer_t s_buffers[2];
+static atomic_uint s_open_id;
+
+static round_buffer_t *buffer_for(uint32_t id)
+{
+    return &s_buffers[id & 1U];
+}
+
+/**
+ * write_begin / write_end
+ *
+ * @brief Bracket a write so readers can detect it.
+ */
+static void write_begin(round_buffer_t *buf)
+{
+    atomic_fetch_add_explicit(&buf->writers, 1U, memory_order_acq_rel);
+}
+
+static void write_end(round_buffer_t *buf)
+{
+    atomic_fetch_add_explicit(&buf->seq, 1U, memory_order_release);
+    atomic_fetch_sub_explicit(&buf->writers, 1U, memory_order_release);
+}
+
+/**
+ * read_consistent
+ *
+ * @brief Copies a buffer, retrying until no write overlapped the copy.
+ *
+ * The reader may outrank a writer it interrupted, so instead of spinning it
+ * sleeps for a tick between attempts to let the writer finish.
+ *
+ * @param buf      Buffer to copy.
+ * @param[out] out Receives the copy.
+ */
+static void read_consistent(round_buffer_t *buf, sample_round_t *out)
+{
+    while (1) {
+        const unsigned seq = atomic_load_explicit(&buf->seq, memory_order_acquire);
+
+        if (atomic_load_explicit(&buf->writers, memory_order_acquire) == 0U) {
+            memcpy(out, &buf->data, sizeof(*out));
+            atomic_thread_fence(memory_order_acquire);
+
+            if (atomic_load_explicit(&buf->writers, memory_order_relaxed) == 0U &&
+                atomic_load_explicit(&buf->seq, memory_order_relaxed) == seq) {
+                return;
+            }
+        }
+
+        vTaskDelay(1);
+    }
+}
+
+/* -------------------------------------------------------------------------- */
+/* Public API                                                                  */
+/* -------------------------------------------------------------------------- */
+
+esp_err_t sampling_round_init(void)
+{
+    memset(s_buffers, 0, sizeof(s_buffers));
+
+    round_buffer_t *buf = buffer_for(1U);
+    buf->data.id = 1U;
+    buf->data.opened_us = esp_timer_get_time();
+
+    atomic_store_explicit(&s_open_id, 1U, memory_order_release);
+    return ESP_OK;
+}
+
+void sampling_round_publish(sample_src_t src, sample_value_t value)
+{
+    if ((unsigned)src >= SAMPLE_SRC_COUNT) {
+        return;
+    }
+
+    while (1) {
+        const uint32_t id = atomic_load_explicit(&s_open_id, memory_order_acquire);
+        round_buffer_t *buf = buffer_for(id);
+
+        write_begin(buf);
+        if (buf->data.first_us[src] == 0) {
+            buf->data.first_us[src] = esp_timer_get_time();
+        }
+        buf->data.value[src] = value;
+        write_end(buf);
+
+        // Closed under us: the value landed in the old round, repeat it in the new one
+        if (atomic_load_explicit(&s_open_id, memory_order_acquire) == id) {
+            return;
+        }
+    }
+}
+
+uint32_t sampling_round_present_mask(const sample_round_t *round)
+{
+    uint32_t mask = 0;
+
+    for (int src = 0; src < SAMPLE_SRC_COUNT; src++) {
+        if (round->first_us[src] != 0) {
+            mask |= 1U << src;
+        }
+    }
+    return mask;
+}
+
+bool sampling_round_try_close(sample_round_t *out, uint32_t *missing)
+{
+    const uint32_t id = atomic_load_explicit(&s_open_id, memory_order_acquire);
+    round_buffer_t *closing = buffer_for(id);
+
+    sample_round_t current;
+    read_consistent(closing, &current);
+
+    const uint32_t absent = SAMPLE_SRC_ALL_MASK & ~sampling_round_present_mask(&current);
+    if (missing != NULL) {
+        *missing = absent;
+    }
+    if (absent != 0U) {
+        return false;
+    }
+
+    // Prepare the other buffer, then publish it as the open round
+    round_buffer_t *next = buffer_for(id + 1U);
+    write_begin(next);
+    memset(&next->data, 0, sizeof(next->data));
+    next->data.id = id + 1U;
+    next->data.opened_us = esp_timer_get_time();
+    write_end(next);
+
+    atomic_store_explicit(&s_open_id, id + 1U, memory_order_release);
+
+    // Producers that loaded the old id may still be finishing a write
+    read_consistent(closing, out);
+    return true;
+}
+
+void sampling_round_peek(sample_round_t *out)
+{
+    const uint32_t id = atomic_load_explicit(&s_open_id, memory_order_acquire);
+    read_consistent(buffer_for(id), out);
+}
+
+const char *sampling_round_src_name(sample_src_t src)
+{
+    switch (src) {
+    case SAMPLE_SRC_ADC:  return "ADC";
+    case SAMPLE_SRC_TEMP: return "TEMP";
+    case SAMPLE_SRC_GPIO: return "GPIO";
+    default:              return "?";
+    }
+}
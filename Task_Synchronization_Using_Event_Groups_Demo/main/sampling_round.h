@@ -0,0 +1,126 @@
+/**
+ * @file sampling_round.h
+ *
+ * @brief Double-buffered sampling rounds shared between producers and one aggregator.
+ *
+ * Producers publish their latest value into the currently open round. The
+ * aggregator closes the round once every producer has published, which opens
+ * the other buffer for the next round, and then copies the closed round out.
+ *
+ * Each buffer is guarded by a sequence lock that tolerates several writers:
+ * writers count themselves in and bump a sequence number on the way out, and
+ * the reader retries until it has copied the buffer with no writer inside and
+ * an unchanged sequence number. No mutex is taken on either side. Each producer
+ * only writes its own slot, so writers never conflict with each other.
+ *
+ * The module does not touch event groups; callers keep using event bits to
+ * wake the aggregator and treat sampling_round_try_close() as the authority on
+ * whether a round is complete.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+/**
+ * @brief Producers that contribute to a sampling round.
+ */
+typedef enum {
+    SAMPLE_SRC_ADC = 0,
+    SAMPLE_SRC_TEMP,
+    SAMPLE_SRC_GPIO,
+    SAMPLE_SRC_COUNT
+} sample_src_t;
+
+#define SAMPLE_SRC_ALL_MASK ((1U << SAMPLE_SRC_COUNT) - 1U)
+
+/**
+ * @brief One published value; the producer decides which member is used.
+ */
+typedef union {
+    int32_t i;
+    float f;
+} sample_value_t;
+
+/**
+ * @brief Contents of one sampling round.
+ */
+typedef struct {
+    uint32_t id;                               /**< Round number, starting at 1. */
+    int64_t opened_us;                         /**< esp_timer time the round was opened. */
+    int64_t first_us[SAMPLE_SRC_COUNT];        /**< First publish per source, 0 if none. */
+    sample_value_t value[SAMPLE_SRC_COUNT];    /**< Latest value per source. */
+} sample_round_t;
+
+/**
+ * sampling_round_init
+ *
+ * @brief Opens round 1. Must be called before any producer starts.
+ *
+ * @return
+ * - ESP_OK on success
+ */
+esp_err_t sampling_round_init(void);
+
+/**
+ * sampling_round_publish
+ *
+ * @brief Stores a producer's latest value in the open round.
+ *
+ * If the round is closed while the value is being written, the value is
+ * written again into the newly opened round, so a completed call always
+ * leaves the value in the round that was open when it returned.
+ *
+ * @param src   Producer publishing the value.
+ * @param value Value to store.
+ */
+void sampling_round_publish(sample_src_t src, sample_value_t value);
+
+/**
+ * sampling_round_try_close
+ *
+ * @brief Closes the open round if every source has published into it.
+ *
+ * @param[out] out     Receives a consistent copy of the closed round.
+ * @param[out] missing Receives the SAMPLE_SRC mask of sources still missing
+ *                     when the round could not be closed. May be NULL.
+ *
+ * @return
+ * - true if the round was closed and copied to out
+ * - false if sources are missing (out is not written)
+ */
+bool sampling_round_try_close(sample_round_t *out, uint32_t *missing);
+
+/**
+ * sampling_round_peek
+ *
+ * @brief Copies the open round without closing it, for diagnostics.
+ *
+ * @param[out] out Receives a consistent copy of the open round.
+ */
+void sampling_round_peek(sample_round_t *out);
+
+/**
+ * sampling_round_present_mask
+ *
+ * @brief Returns the SAMPLE_SRC mask of sources that published into a round.
+ *
+ * @param round Round to inspect.
+ *
+ * @return Mask with bit n set when source n is present.
+ */
+uint32_t sampling_round_present_mask(const sample_round_t *round);
+
+/**
+ * sampling_round_src_name
+ *
+ * @brief Returns a short name for a source, for logging.
+ *
+ * @param src Source.
+ *
+ * @return Static string.
+ */
+const char *sampling_round_src_name(sample_src_t src);
@@ -7,7 +7,13 @@
  *  - Event-driven UART reception (UART driver event queue).
  *  - Fast RX task that forwards bytes to a StreamBuffer (burst absorption).
  *  - Parser task that converts a byte stream into newline-delimited commands.
- *  - TX task that is the only UART writer, fed by a FreeRTOS queue (no interleaving).
+ *  - Optional pattern framing: the UART detects '\n' and the RX task hands
+ *    complete lines to the parser in place, one wakeup per line.
+ *  - Optional binary framing for high baud rates: COBS frames with CRC-32,
+ *    sequence numbers, ACK/retransmit and throughput/error counters.
+ *  - TX task that is the only UART writer (no interleaving). Text responses are
+ *    coalesced in one buffer and flushed in large writes; binary frames go
+ *    through a FreeRTOS queue one frame at a time.
  *
  * Test (typical):
  *  1) Connect an external USB-UART adapter to the configured pins:
@@ -42,11 +48,13 @@
 #include "esp_log.h"
 #include "esp_err.h"
 
+#include "uart_frame.h"
+
 // UART configuration
 #define UART_PORT              UART_NUM_1
 #define UART_TX_PIN            GPIO_NUM_17
 #define UART_RX_PIN            GPIO_NUM_18
-#define UART_BAUD_RATE         115200
+#define UART_BAUD_RATE         ((UART_FRAMING == UART_FRAMING_COBS) ? 2000000 : 115200)
 
 #define UART_RX_BUF_SIZE       4096
 #define UART_TX_BUF_SIZE       2048
@@ -56,6 +64,29 @@
 #define STREAM_BUF_SIZE        4096
 #define STREAM_TRIG_LEVEL      1
 
+// TX coalescing (text modes): producers append, the TX task flushes in bulk
+#define TX_AGG_BUF_SIZE        2048
+#define TX_AGG_FLUSH_BYTES     256  // Flush as soon as this much is pending...
+#define TX_AGG_DEADLINE_MS     2    // ...or this long after the first pending byte
+
+// RX framing modes
+#define UART_FRAMING_STREAM    0   // Byte stream + line accumulator
+#define UART_FRAMING_LINES     1   // '\n' pattern detection + line slices
+#define UART_FRAMING_COBS      2   // 0x00 pattern detection + binary COBS/CRC frames
+#define UART_FRAMING           UART_FRAMING_LINES
+
+#define UART_FRAME_DELIMITER   ((UART_FRAMING == UART_FRAMING_COBS) ? 0x00 : '\n')
+#define UART_PATTERN_QUEUE_LEN 16
+#define LINE_POOL_CHUNKS       4
+#define LINE_POOL_CHUNK_SIZE   ((UART_FRAMING == UART_FRAMING_COBS) ? 2048 : 512)
+#define LINE_QUEUE_LEN         16
+
+// Binary frame protocol (UART_FRAMING_COBS)
+#define UART_FRAME_ACK_ENABLE      1
+#define UART_FRAME_ACK_TIMEOUT_MS  20
+#define UART_FRAME_MAX_RETRIES     3
+#define UART_FRAME_STATS_PERIOD_MS 5000
+
 static const char *TAG = "uart_ref";
 
 /**
@@ -81,10 +112,70 @@ typedef struct {
     size_t len;
 } line_acc_t;
 
+#if UART_FRAMING != UART_FRAMING_STREAM
+/**
+ * @brief One received line or frame, stored in place in a line pool chunk.
+ *
+ * The line is NULL terminated where its delimiter (or "\r\n") was. The parser
+ * must return the chunk with line_pool_release() once it is done with it.
+ */
+typedef struct {
+    char *line;
+    size_t len;
+    uint8_t chunk;
+} line_slice_t;
+#endif
+
 static QueueHandle_t uart_evt_queue = NULL;
-static StreamBufferHandle_t rx_stream = NULL;
+
+#if UART_FRAMING == UART_FRAMING_COBS
 static QueueHandle_t tx_queue = NULL;
+#else
+// TX coalescing ring. Producers append whole messages under tx_agg_lock; the
+// TX task is the only reader, so it can write the pending bytes out unlocked.
+static uint8_t tx_agg_buf[TX_AGG_BUF_SIZE];
+static size_t tx_agg_head;     ///< Next write index
+static size_t tx_agg_tail;     ///< Next read index (TX task only)
+static size_t tx_agg_pending;  ///< Bytes between tail and head
+static portMUX_TYPE tx_agg_lock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t tx_task_handle = NULL;
+#endif
 
+#if UART_FRAMING != UART_FRAMING_STREAM
+// RX reads straight into these chunks; lines are handed to the parser without copying.
+static uint8_t line_pool[LINE_POOL_CHUNKS][LINE_POOL_CHUNK_SIZE];
+static uint8_t line_pool_refs[LINE_POOL_CHUNKS];
+static portMUX_TYPE line_pool_lock = portMUX_INITIALIZER_UNLOCKED;
+static QueueHandle_t line_pool_free = NULL;
+static QueueHandle_t line_queue = NULL;
+#else
+static StreamBufferHandle_t rx_stream = NULL;
+#endif
+
+#if UART_FRAMING == UART_FRAMING_COBS
+/**
+ * @brief Binary protocol counters.
+ *
+ * RX fields are written only by the parser task and TX fields only by the TX
+ * task; the stats task reads them without a lock (32-bit reads are atomic).
+ */
+typedef struct {
+    uint32_t rx_frames;
+    uint32_t rx_bytes;
+    uint32_t rx_cobs_errors;
+    uint32_t rx_crc_errors;
+    uint32_t rx_duplicates;
+    uint32_t tx_frames;
+    uint32_t tx_bytes;
+    uint32_t tx_retransmits;
+    uint32_t tx_failed;
+} uart_frame_stats_t;
+
+static uart_frame_stats_t frame_stats;
+static QueueHandle_t ack_queue = NULL;
+#endif
+
+#if UART_FRAMING == UART_FRAMING_STREAM
 /**
  * @brief Reset a line accumulator to an empty state.
  *
@@ -131,12 +222,63 @@ static int line_acc_push(line_acc_t *a, const uint8_t *data, size_t n)
     }
     return 0;
 }
+#endif
+
+#if UART_FRAMING != UART_FRAMING_STREAM
+/**
+ * @brief Take a free chunk from the line pool.
+ *
+ * The caller holds one reference; each line handed out adds another.
+ *
+ * @return uint8_t Index of the chunk.
+ */
+static uint8_t line_pool_acquire(void)
+{
+    uint8_t chunk;
+
+    xQueueReceive(line_pool_free, &chunk, portMAX_DELAY);
+    line_pool_refs[chunk] = 1;
+    return chunk;
+}
+
+/**
+ * @brief Add a reference to a line pool chunk.
+ *
+ * @param[in] chunk Index of the chunk.
+ */
+static void line_pool_retain(uint8_t chunk)
+{
+    taskENTER_CRITICAL(&line_pool_lock);
+    line_pool_refs[chunk]++;
+    taskEXIT_CRITICAL(&line_pool_lock);
+}
 
+/**
+ * @brief Drop a reference to a line pool chunk; the last one frees it.
+ *
+ * @param[in] chunk Index of the chunk.
+ */
+static void line_pool_release(uint8_t chunk)
+{
+    bool is_free;
+
+    taskENTER_CRITICAL(&line_pool_lock);
+    is_free = (--line_pool_refs[chunk] == 0);
+    taskEXIT_CRITICAL(&line_pool_lock);
+
+    if (is_free) {
+        (void)xQueueSend(line_pool_free, &chunk, 0);
+    }
+}
+#endif
+
+#if UART_FRAMING == UART_FRAMING_COBS
 /**
  * @brief Enqueue a string for asynchronous UART transmission.
  *
  * The TX task is the only task that calls uart_write_bytes(), which prevents
  * output interleaving and makes it easy to rate-limit or prioritize if needed.
+ * In binary mode each call becomes one DATA frame.
  *
  * @param[in] s NULL-terminated string to send.
  * @return bool true on success, false on failure (queue full or message too large).
@@ -158,6 +300,56 @@ static bool tx_send_str(const char *s)
 
     return (xQueueSend(tx_queue, &msg, pdMS_TO_TICKS(20)) == pdTRUE);
 }
+#else
+/**
+ * @brief Append a string to the TX coalescing buffer without blocking.
+ *
+ * The TX task is the only task that calls uart_write_bytes(). Producers only
+ * copy into the shared buffer inside a short critical section, so they never
+ * wait on the UART driver. A message is appended whole or not at all.
+ *
+ * The TX task is woken when the buffer goes from empty to non-empty (it then
+ * waits up to TX_AGG_DEADLINE_MS for more) and again when TX_AGG_FLUSH_BYTES
+ * are pending, so a burst of short responses leaves in a few large writes.
+ *
+ * @param[in] s NULL-terminated string to send.
+ * @return bool true on success, false if the buffer has no room for it.
+ */
+static bool tx_send_str(const char *s)
+{
+    size_t n = strlen(s);
+    size_t before;
+    size_t first;
+
+    if (n == 0) {
+        return true;
+    }
+
+    portENTER_CRITICAL(&tx_agg_lock);
+    before = tx_agg_pending;
+    if (n > TX_AGG_BUF_SIZE - before) {
+        portEXIT_CRITICAL(&tx_agg_lock);
+        return false;
+    }
+
+    // Copy in at most two pieces around the end of the ring.
+    first = TX_AGG_BUF_SIZE - tx_agg_head;
+    if (first > n) {
+        first = n;
+    }
+    memcpy(&tx_agg_buf[tx_agg_head], s, first);
+    memcpy(tx_agg_buf, s + first, n - first);
+    tx_agg_head = (tx_agg_head + n) % TX_AGG_BUF_SIZE;
+    tx_agg_pending = before + n;
+    portEXIT_CRITICAL(&tx_agg_lock);
+
+    if (before == 0 || (before < TX_AGG_FLUSH_BYTES && before + n >= TX_AGG_FLUSH_BYTES)) {
+        xTaskNotifyGive(tx_task_handle);
+    }
+
+    return true;
+}
+#endif
 
 /**
  * @brief Handle a completed newline-delimited command line.
@@ -232,24 +424,55 @@ static void uart_ref_init(void)
                                  UART_PIN_NO_CHANGE,
                                  UART_PIN_NO_CHANGE));
 
+#if UART_FRAMING != UART_FRAMING_STREAM
+    // Raise UART_PATTERN_DET for every delimiter; the RX task reads up to it.
+    ESP_ERROR_CHECK(uart_enable_pattern_det_baud_intr(UART_PORT, UART_FRAME_DELIMITER, 1, 9, 0, 0));
+    ESP_ERROR_CHECK(uart_pattern_queue_reset(UART_PORT, UART_PATTERN_QUEUE_LEN));
+
+    // Create the line pool and the queue of completed lines
+    line_pool_free = xQueueCreate(LINE_POOL_CHUNKS, sizeof(uint8_t));
+    line_queue = xQueueCreate(LINE_QUEUE_LEN, sizeof(line_slice_t));
+    if (line_pool_free == NULL || line_queue == NULL) {
+        ESP_LOGE(TAG, "Failed to create line pool");
+        abort();
+    }
+    for (uint8_t i = 0; i < LINE_POOL_CHUNKS; i++) {
+        (void)xQueueSend(line_pool_free, &i, 0);
+    }
+#endif
+
+#if UART_FRAMING == UART_FRAMING_COBS
+    uart_frame_init();
+    ack_queue = xQueueCreate(4, sizeof(uint16_t));
+    if (ack_queue == NULL) {
+        ESP_LOGE(TAG, "Failed to create ACK queue");
+        abort();
+    }
+#endif
+
+#if UART_FRAMING == UART_FRAMING_STREAM
     // Create RX stream buffer
     rx_stream = xStreamBufferCreate(STREAM_BUF_SIZE, STREAM_TRIG_LEVEL);
     if (rx_stream == NULL) {
         ESP_LOGE(TAG, "Failed to create RX stream buffer");
         abort();
     }
+#endif
 
+#if UART_FRAMING == UART_FRAMING_COBS
     // Create TX queue
     tx_queue = xQueueCreate(10, sizeof(uart_tx_msg_t));
     if (tx_queue == NULL) {
         ESP_LOGE(TAG, "Failed to create TX queue");
         abort();
     }
+#endif
 
     ESP_LOGI(TAG, "UART initialized on port %d (TX=%d, RX=%d) @ %d baud",
              (int)UART_PORT, (int)UART_TX_PIN, (int)UART_RX_PIN, (int)UART_BAUD_RATE);
 }
 
+#if UART_FRAMING == UART_FRAMING_STREAM
 /**
  * @brief UART RX task: consumes UART driver events and forwards bytes to a StreamBuffer.
  *
@@ -368,7 +591,325 @@ static void uart_parser_task(void *arg)
         }
     }
 }
+#else
+/**
+ * @brief Hand one complete line (or frame) in the current chunk to the parser.
+ *
+ * The '\n' (and a preceding '\r') is overwritten with '\0' in place, so the
+ * parser gets a NULL-terminated string without a copy. COBS frames end in
+ * 0x00 already; empty frames between back-to-back delimiters are skipped.
+ *
+ * @param[in] chunk Index of the chunk holding the line.
+ * @param[in] start Offset of the first byte of the line.
+ * @param[in] newline Offset of the terminating delimiter.
+ */
+static void line_slice_post(uint8_t chunk, size_t start, size_t newline)
+{
+    char *line = (char *)&line_pool[chunk][start];
+    size_t len = newline - start;
+    line_slice_t slice;
+
+    if (UART_FRAMING == UART_FRAMING_COBS && len == 0) {
+        return;
+    }
+    if (UART_FRAMING == UART_FRAMING_LINES && len > 0 && line[len - 1] == '\r') {
+        len--;
+    }
+    line[len] = '\0';
+
+    slice.line = line;
+    slice.len = len;
+    slice.chunk = chunk;
+
+    line_pool_retain(chunk);
+    if (xQueueSend(line_queue, &slice, 0) != pdTRUE) {
+        ESP_LOGW(TAG, "Line queue full, dropped %u byte line", (unsigned)len);
+        line_pool_release(chunk);
+    }
+}
 
+/**
+ * @brief UART RX task for pattern framing: reads lines straight into the line pool.
+ *
+ * The UART raises UART_PATTERN_DET for each delimiter ('\n', or 0x00 for COBS
+ * frames), so this task wakes per line instead of per byte. It reads everything buffered into the current chunk,
+ * finds line ends with memchr() and posts each line as a slice. A partial line
+ * at the end of a full chunk is moved to a fresh chunk in one memcpy(); a line
+ * longer than a whole chunk is dropped.
+ *
+ * UART_DATA events are ignored; bytes wait in the driver buffer until their
+ * newline arrives.
+ *
+ * @param[in] arg Unused.
+ */
+static void uart_rx_pattern_task(void *arg)
+{
+    (void)arg;
+
+    uart_event_t evt;
+    uint8_t chunk = line_pool_acquire();
+    size_t fill = 0;        // Bytes written to the chunk
+    size_t line_start = 0;  // Offset of the first unfinished line
+
+    while (1) {
+        if (xQueueReceive(uart_evt_queue, &evt, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        if (evt.type == UART_PATTERN_DET) {
+            size_t buffered = 0;
+
+            (void)uart_get_buffered_data_len(UART_PORT, &buffered);
+
+            while (buffered > 0) {
+                if (fill == LINE_POOL_CHUNK_SIZE) {
+                    size_t tail = fill - line_start;
+
+                    if (line_start == 0) {
+                        // Overflow: the line fills a whole chunk, drop it.
+                        ESP_LOGW(TAG, "Line longer than %d bytes dropped", LINE_POOL_CHUNK_SIZE);
+                        fill = 0;
+                    } else {
+                        uint8_t next = line_pool_acquire();
+
+                        memcpy(line_pool[next], &line_pool[chunk][line_start], tail);
+                        line_pool_release(chunk);
+                        chunk = next;
+                        fill = tail;
+                    }
+                    line_start = 0;
+                }
+
+                size_t space = LINE_POOL_CHUNK_SIZE - fill;
+                int n = uart_read_bytes(UART_PORT,
+                                        &line_pool[chunk][fill],
+                                        (buffered < space) ? buffered : space,
+                                        0);
+                if (n <= 0) {
+                    break;
+                }
+
+                // Scan only the new bytes for line ends.
+                size_t scan = fill;
+                fill += (size_t)n;
+                buffered -= (size_t)n;
+
+                uint8_t *nl;
+                while ((nl = memchr(&line_pool[chunk][scan], UART_FRAME_DELIMITER, fill - scan)) != NULL) {
+                    size_t newline = (size_t)(nl - line_pool[chunk]);
+
+                    line_slice_post(chunk, line_start, newline);
+                    line_start = newline + 1;
+                    scan = line_start;
+                }
+            }
+
+            // Everything up to the last newline has been read; drop the stale positions.
+            while (uart_pattern_pop_pos(UART_PORT) != -1) {
+            }
+            continue;
+        }
+
+        if (evt.type == UART_FIFO_OVF || evt.type == UART_BUFFER_FULL) {
+            ESP_LOGW(TAG, "UART overflow/buffer full, flushing input");
+            uart_flush_input(UART_PORT);
+            xQueueReset(uart_evt_queue);
+            (void)uart_pattern_queue_reset(UART_PORT, UART_PATTERN_QUEUE_LEN);
+            fill = line_start;
+            continue;
+        }
+
+        if (evt.type == UART_FRAME_ERR) {
+            ESP_LOGW(TAG, "UART frame error");
+            continue;
+        }
+
+        if (evt.type == UART_PARITY_ERR) {
+            ESP_LOGW(TAG, "UART parity error");
+            continue;
+        }
+    }
+}
+
+#if UART_FRAMING == UART_FRAMING_LINES
+/**
+ * @brief Parser task for pattern framing: handles one complete line per wakeup.
+ *
+ * @param[in] arg Unused.
+ */
+static void uart_line_parser_task(void *arg)
+{
+    (void)arg;
+
+    line_slice_t slice;
+
+    while (1) {
+        if (xQueueReceive(line_queue, &slice, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        ESP_LOGI(TAG, "CMD: %s", slice.line);
+        handle_line(slice.line);
+        line_pool_release(slice.chunk);
+    }
+}
+#else
+/**
+ * @brief Send an ACK frame for a received sequence number.
+ *
+ * ACKs bypass the TX queue: the TX task may itself be blocked waiting for the
+ * peer's ACK, and queuing ours behind it would stall both sides until their
+ * retries run out. One uart_write_bytes() call per frame keeps the bytes
+ * contiguous, since the driver serializes concurrent writers.
+ *
+ * @param[in] seq Sequence number to acknowledge.
+ */
+static void frame_send_ack(uint16_t seq)
+{
+    uint8_t buf[UART_FRAME_HEADER_SIZE + UART_FRAME_CRC_SIZE + 2];
+    uart_frame_t ack = {
+        .type = UART_FRAME_ACK,
+        .seq = seq,
+    };
+    size_t n = uart_frame_encode(&ack, buf, sizeof(buf));
+
+    if (n > 0) {
+        uart_write_bytes(UART_PORT, (const char *)buf, n);
+    }
+}
+
+/**
+ * @brief Parser task for binary framing: decodes one COBS frame per wakeup.
+ *
+ * Frames are decoded in place in the line pool. DATA payloads are handled as
+ * commands (the payload is NULL terminated over the already checked CRC);
+ * ACK frames are passed to the TX task. A DATA frame that repeats the last
+ * sequence number is a retransmit after a lost ACK: it is ACKed again but not
+ * handled twice.
+ *
+ * @param[in] arg Unused.
+ */
+static void uart_frame_parser_task(void *arg)
+{
+    (void)arg;
+
+    line_slice_t slice;
+    uart_frame_t frame;
+    uint16_t last_rx_seq = 0;
+    bool have_rx_seq = false;
+
+    while (1) {
+        if (xQueueReceive(line_queue, &slice, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        frame_stats.rx_bytes += slice.len + 1;
+
+        switch (uart_frame_decode((uint8_t *)slice.line, slice.len, &frame)) {
+        case UART_FRAME_OK:
+            break;
+        case UART_FRAME_ERR_CRC:
+            frame_stats.rx_crc_errors++;
+            line_pool_release(slice.chunk);
+            continue;
+        default:
+            frame_stats.rx_cobs_errors++;
+            line_pool_release(slice.chunk);
+            continue;
+        }
+
+        frame_stats.rx_frames++;
+
+        if (frame.type == UART_FRAME_ACK) {
+            (void)xQueueSend(ack_queue, &frame.seq, 0);
+        } else if (frame.type == UART_FRAME_DATA) {
+            if (frame.flags & UART_FRAME_FLAG_ACK_REQ) {
+                frame_send_ack(frame.seq);
+            }
+
+            if (have_rx_seq && frame.seq == last_rx_seq) {
+                frame_stats.rx_duplicates++;
+            } else {
+                last_rx_seq = frame.seq;
+                have_rx_seq = true;
+
+                frame.payload[frame.len] = '\0';
+                handle_line((const char *)frame.payload);
+            }
+        }
+
+        line_pool_release(slice.chunk);
+    }
+}
+
+/**
+ * @brief Wait for the ACK of one sequence number.
+ *
+ * @param[in] seq Sequence number sent.
+ * @return bool true if the ACK arrived within UART_FRAME_ACK_TIMEOUT_MS.
+ */
+static bool frame_wait_ack(uint16_t seq)
+{
+    TickType_t start = xTaskGetTickCount();
+    TickType_t timeout = pdMS_TO_TICKS(UART_FRAME_ACK_TIMEOUT_MS);
+    uint16_t acked;
+
+    while (1) {
+        TickType_t elapsed = xTaskGetTickCount() - start;
+
+        if (elapsed >= timeout) {
+            return false;
+        }
+        if (xQueueReceive(ack_queue, &acked, timeout - elapsed) != pdTRUE) {
+            return false;
+        }
+        if (acked == seq) {
+            return true;
+        }
+        // A late ACK for an earlier frame; keep waiting.
+    }
+}
+
+/**
+ * @brief Stats task: logs binary protocol throughput and error rates.
+ *
+ * @param[in] arg Unused.
+ */
+static void uart_frame_stats_task(void *arg)
+{
+    (void)arg;
+
+    uart_frame_stats_t prev = {0};
+
+    while (1) {
+        vTaskDelay(pdMS_TO_TICKS(UART_FRAME_STATS_PERIOD_MS));
+
+        uart_frame_stats_t now = frame_stats;
+        uint32_t rx_frames = now.rx_frames - prev.rx_frames;
+        uint32_t rx_errors = (now.rx_crc_errors - prev.rx_crc_errors) +
+                             (now.rx_cobs_errors - prev.rx_cobs_errors);
+        uint32_t rx_total = rx_frames + rx_errors;
+
+        ESP_LOGI(TAG,
+                 "RX %u B/s, %u frames, %u errors (%u.%02u%%), %u dup | TX %u B/s, %u frames, %u retx, %u failed",
+                 (unsigned)((now.rx_bytes - prev.rx_bytes) * 1000U / UART_FRAME_STATS_PERIOD_MS),
+                 (unsigned)rx_frames,
+                 (unsigned)rx_errors,
+                 (unsigned)(rx_total ? (rx_errors * 100U) / rx_total : 0U),
+                 (unsigned)(rx_total ? ((rx_errors * 10000U) / rx_total) % 100U : 0U),
+                 (unsigned)(now.rx_duplicates - prev.rx_duplicates),
+                 (unsigned)((now.tx_bytes - prev.tx_bytes) * 1000U / UART_FRAME_STATS_PERIOD_MS),
+                 (unsigned)(now.tx_frames - prev.tx_frames),
+                 (unsigned)(now.tx_retransmits - prev.tx_retransmits),
+                 (unsigned)(now.tx_failed - prev.tx_failed));
+
+        prev = now;
+    }
+}
+#endif
+#endif
+
+#if UART_FRAMING == UART_FRAMING_COBS
 /**
  * @brief UART TX task: the only task that writes to UART.
  *
@@ -382,6 +923,8 @@ static void uart_tx_task(void *arg)
     (void)arg;
 
     uart_tx_msg_t msg;
+    static uint8_t encoded[UART_FRAME_MAX_ENCODED];
+    uint16_t tx_seq = 0;
 
     while (1) {
         // Wait for a message to send
@@ -389,13 +932,105 @@ static void uart_tx_task(void *arg)
             continue;
         }
 
-        // Send the message via UART
-        uart_write_bytes(UART_PORT, (const char *)msg.data, msg.len);
+        // Wrap the message in a DATA frame; stop-and-wait until it is ACKed.
+        uart_frame_t frame = {
+            .type = UART_FRAME_DATA,
+            .flags = UART_FRAME_ACK_ENABLE ? UART_FRAME_FLAG_ACK_REQ : 0,
+            .seq = tx_seq++,
+            .payload = msg.data,
+            .len = msg.len,
+        };
+        size_t n = uart_frame_encode(&frame, encoded, sizeof(encoded));
+
+        xQueueReset(ack_queue);
+        for (int attempt = 0; n > 0; attempt++) {
+            uart_write_bytes(UART_PORT, (const char *)encoded, n);
+            frame_stats.tx_frames++;
+            frame_stats.tx_bytes += n;
+
+            if (!UART_FRAME_ACK_ENABLE || frame_wait_ack(frame.seq)) {
+                break;
+            }
+            if (attempt == UART_FRAME_MAX_RETRIES) {
+                frame_stats.tx_failed++;
+                break;
+            }
+            frame_stats.tx_retransmits++;
+        }
 
         // Wait for transmission to complete
         uart_wait_tx_done(UART_PORT, pdMS_TO_TICKS(100));
     }
 }
+#else
+/**
+ * @brief Write everything pending in the TX coalescing buffer to the UART.
+ *
+ * Pending bytes are written as at most two contiguous pieces per pass; the
+ * loop repeats if producers appended more in the meantime.
+ */
+static void tx_agg_flush(void)
+{
+    size_t pending;
+    size_t chunk;
+
+    while (1) {
+        portENTER_CRITICAL(&tx_agg_lock);
+        pending = tx_agg_pending;
+        portEXIT_CRITICAL(&tx_agg_lock);
+
+        if (pending == 0) {
+            return;
+        }
+
+        chunk = TX_AGG_BUF_SIZE - tx_agg_tail;
+        if (chunk > pending) {
+            chunk = pending;
+        }
+
+        // Producers never touch bytes between tail and head, so no lock here.
+        uart_write_bytes(UART_PORT, (const char *)&tx_agg_buf[tx_agg_tail], chunk);
+        tx_agg_tail = (tx_agg_tail + chunk) % TX_AGG_BUF_SIZE;
+
+        portENTER_CRITICAL(&tx_agg_lock);
+        tx_agg_pending -= chunk;
+        portEXIT_CRITICAL(&tx_agg_lock);
+    }
+}
+
+/**
+ * @brief UART TX task: the only task that writes to UART.
+ *
+ * Sleeps until tx_send_str() signals the first pending byte, gives further
+ * messages up to TX_AGG_DEADLINE_MS to join unless TX_AGG_FLUSH_BYTES are
+ * already pending, then hands all of them to the driver at once.
+ *
+ * @param[in] arg Unused.
+ */
+static void uart_tx_task(void *arg)
+{
+    (void)arg;
+
+    // Wait at least one tick, otherwise a 100 Hz tick rate would round 2 ms down to 0.
+    const TickType_t deadline = (pdMS_TO_TICKS(TX_AGG_DEADLINE_MS) > 0)
+                                ? pdMS_TO_TICKS(TX_AGG_DEADLINE_MS) : 1;
+    size_t pending;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        portENTER_CRITICAL(&tx_agg_lock);
+        pending = tx_agg_pending;
+        portEXIT_CRITICAL(&tx_agg_lock);
+
+        if (pending < TX_AGG_FLUSH_BYTES) {
+            (void)ulTaskNotifyTake(pdTRUE, deadline);
+        }
+
+        tx_agg_flush();
+    }
+}
+#endif
 
 /**
  * @brief ESP-IDF application entry point.
@@ -408,9 +1043,23 @@ void app_main(void)
     uart_ref_init();
 
     // Priorities: RX slightly higher than parser; TX similar to parser.
+    // TX starts first so tx_send_str() always has a task to wake.
+#if UART_FRAMING == UART_FRAMING_COBS
+    xTaskCreate(uart_tx_task,       "uart_tx",     3072, NULL, 10, NULL);
+#else
+    xTaskCreate(uart_tx_task,       "uart_tx",     3072, NULL, 10, &tx_task_handle);
+#endif
+#if UART_FRAMING == UART_FRAMING_LINES
+    xTaskCreate(uart_rx_pattern_task,  "uart_rx_pat", 4096, NULL, 12, NULL);
+    xTaskCreate(uart_line_parser_task, "uart_parser", 4096, NULL, 10, NULL);
+#elif UART_FRAMING == UART_FRAMING_COBS
+    xTaskCreate(uart_rx_pattern_task,   "uart_rx_pat", 4096, NULL, 12, NULL);
+    xTaskCreate(uart_frame_parser_task, "uart_parser", 4096, NULL, 10, NULL);
+    xTaskCreate(uart_frame_stats_task,  "uart_stats",  3072, NULL, 5,  NULL);
+#else
     xTaskCreate(uart_rx_event_task, "uart_rx_evt", 4096, NULL, 12, NULL);
     xTaskCreate(uart_parser_task,   "uart_parser", 4096, NULL, 10, NULL);
-    xTaskCreate(uart_tx_task,       "uart_tx",     3072, NULL, 10, NULL);
+#endif
 
     (void)tx_send_str("READY\n");
 }
\ No newline at end of file
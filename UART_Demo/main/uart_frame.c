@@ -0,0 +1,199 @@
+/**
+ * @file uart_frame.c
+ * @brief COBS framing and table-driven CRC-32 for the binary UART protocol.
+ */
+
+#include "uart_frame.h"
+
+#include <string.h>
+
+static uint32_t crc32_table[256];
+
+/**
+ * @brief COBS encoder state; bytes are appended one at a time.
+ */
+typedef struct {
+    uint8_t *out;
+    size_t out_size;
+    size_t pos;       ///< Next write position
+    size_t code_pos;  ///< Position of the pending code byte
+    uint8_t code;     ///< Value of the pending code byte
+    bool overflow;
+} cobs_writer_t;
+
+/**
+ * @brief Start a COBS block by reserving its code byte.
+ *
+ * @param[in,out] w Encoder state.
+ */
+static void cobs_open_block(cobs_writer_t *w)
+{
+    w->code_pos = w->pos++;
+    w->code = 1;
+    if (w->pos > w->out_size) {
+        w->overflow = true;
+    }
+}
+
+/**
+ * @brief Append one raw byte to the COBS output.
+ *
+ * @param[in,out] w Encoder state.
+ * @param[in] byte Raw byte.
+ */
+static void cobs_put(cobs_writer_t *w, uint8_t byte)
+{
+    if (w->overflow) {
+        return;
+    }
+
+    if (byte != 0) {
+        if (w->pos >= w->out_size) {
+            w->overflow = true;
+            return;
+        }
+        w->out[w->pos++] = byte;
+        w->code++;
+    }
+
+    // A zero ends the block; so does a full block of 254 data bytes.
+    if (byte == 0 || w->code == 0xFF) {
+        w->out[w->code_pos] = w->code;
+        cobs_open_block(w);
+    }
+}
+
+/**
+ * @brief Append a buffer to the COBS output.
+ *
+ * @param[in,out] w Encoder state.
+ * @param[in] data Raw bytes.
+ * @param[in] len Number of bytes.
+ */
+static void cobs_put_all(cobs_writer_t *w, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        cobs_put(w, data[i]);
+    }
+}
+
+/**
+ * @brief Advance a CRC-32 over more data.
+ *
+ * @param[in] crc Running CRC (pre-inverted).
+ * @param[in] data Bytes to add.
+ * @param[in] len Number of bytes.
+ * @return uint32_t Updated running CRC.
+ */
+static uint32_t crc32_update(uint32_t crc, const uint8_t *data, size_t len)
+{
+    for (size_t i = 0; i < len; i++) {
+        crc = crc32_table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+void uart_frame_init(void)
+{
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t c = i;
+        for (int bit = 0; bit < 8; bit++) {
+            c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+        }
+        crc32_table[i] = c;
+    }
+}
+
+uint32_t uart_frame_crc32(const uint8_t *data, size_t len)
+{
+    return ~crc32_update(0xFFFFFFFFu, data, len);
+}
+
+size_t uart_frame_encode(const uart_frame_t *frame, uint8_t *out, size_t out_size)
+{
+    uint8_t header[UART_FRAME_HEADER_SIZE];
+    uint8_t crc_bytes[UART_FRAME_CRC_SIZE];
+    cobs_writer_t w = {
+        .out = out,
+        .out_size = out_size,
+    };
+    uint32_t crc;
+
+    if (frame->len > UART_FRAME_MAX_PAYLOAD || out_size == 0) {
+        return 0;
+    }
+
+    header[0] = frame->type;
+    header[1] = frame->flags;
+    header[2] = (uint8_t)(frame->seq & 0xFF);
+    header[3] = (uint8_t)(frame->seq >> 8);
+
+    crc = crc32_update(0xFFFFFFFFu, header, sizeof(header));
+    crc = ~crc32_update(crc, frame->payload, frame->len);
+    for (int i = 0; i < UART_FRAME_CRC_SIZE; i++) {
+        crc_bytes[i] = (uint8_t)(crc >> (8 * i));
+    }
+
+    cobs_open_block(&w);
+    cobs_put_all(&w, header, sizeof(header));
+    cobs_put_all(&w, frame->payload, frame->len);
+    cobs_put_all(&w, crc_bytes, sizeof(crc_bytes));
+
+    // Close the last block and add the delimiter.
+    if (w.overflow || w.pos >= out_size) {
+        return 0;
+    }
+    out[w.code_pos] = w.code;
+    out[w.pos++] = 0x00;
+
+    return w.pos;
+}
+
+uart_frame_status_t uart_frame_decode(uint8_t *buf, size_t len, uart_frame_t *frame)
+{
+    size_t read = 0;
+    size_t write = 0;
+    uint32_t crc;
+    uint32_t received_crc;
+    size_t raw_len;
+
+    // COBS decode in place; the write index never passes the read index.
+    while (read < len) {
+        uint8_t code = buf[read++];
+
+        if (code == 0 || read + code - 1 > len) {
+            return UART_FRAME_ERR_COBS;
+        }
+
+        memmove(&buf[write], &buf[read], code - 1);
+        write += code - 1;
+        read += code - 1;
+
+        // A short block stands for a zero, except at the very end.
+        if (code < 0xFF && read < len) {
+            buf[write++] = 0;
+        }
+    }
+    raw_len = write;
+
+    if (raw_len < UART_FRAME_HEADER_SIZE + UART_FRAME_CRC_SIZE) {
+        return UART_FRAME_ERR_SHORT;
+    }
+
+    crc = uart_frame_crc32(buf, raw_len - UART_FRAME_CRC_SIZE);
+    received_crc = (uint32_t)buf[raw_len - 4] |
+                   ((uint32_t)buf[raw_len - 3] << 8) |
+                   ((uint32_t)buf[raw_len - 2] << 16) |
+                   ((uint32_t)buf[raw_len - 1] << 24);
+    if (crc != received_crc) {
+        return UART_FRAME_ERR_CRC;
+    }
+
+    frame->type = buf[0];
+    frame->flags = buf[1];
+    frame->seq = (uint16_t)(buf[2] | (buf[3] << 8));
+    frame->payload = &buf[UART_FRAME_HEADER_SIZE];
+    frame->len = raw_len - UART_FRAME_HEADER_SIZE - UART_FRAME_CRC_SIZE;
+
+    return UART_FRAME_OK;
+}
@@ -0,0 +1,92 @@
+/**
+ * @file uart_frame.h
+ * @brief Binary frame layer: COBS framing, CRC-32 and sequence numbers.
+ *
+ * Wire format of one frame:
+ *
+ *   COBS( type | flags | seq_lo | seq_hi | payload... | crc32 (LE) ) 0x00
+ *
+ * COBS removes every 0x00 from the encoded bytes, so 0x00 only ever appears
+ * as the frame delimiter and a receiver can resynchronize at the next one.
+ * The CRC-32 (IEEE 802.3, reflected, table driven) covers the header and
+ * the payload.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define UART_FRAME_HEADER_SIZE   4
+#define UART_FRAME_CRC_SIZE      4
+#define UART_FRAME_MAX_PAYLOAD   1024
+
+/** Largest raw frame: header, payload and CRC. */
+#define UART_FRAME_MAX_RAW       (UART_FRAME_HEADER_SIZE + UART_FRAME_MAX_PAYLOAD + UART_FRAME_CRC_SIZE)
+
+/** Largest frame on the wire: COBS overhead of one byte per 254, plus the delimiter. */
+#define UART_FRAME_MAX_ENCODED   (UART_FRAME_MAX_RAW + (UART_FRAME_MAX_RAW / 254) + 2)
+
+/** Set in flags when the sender wants an ACK frame back for this sequence number. */
+#define UART_FRAME_FLAG_ACK_REQ  0x01
+
+typedef enum {
+    UART_FRAME_DATA = 0x01,
+    UART_FRAME_ACK  = 0x02,
+} uart_frame_type_t;
+
+typedef enum {
+    UART_FRAME_OK = 0,
+    UART_FRAME_ERR_COBS,   ///< Malformed COBS encoding
+    UART_FRAME_ERR_SHORT,  ///< Shorter than a header and CRC
+    UART_FRAME_ERR_CRC,    ///< CRC mismatch
+} uart_frame_status_t;
+
+/**
+ * @brief One decoded or to-be-encoded frame.
+ *
+ * On decode, @c payload points into the caller's buffer.
+ */
+typedef struct {
+    uint8_t type;
+    uint8_t flags;
+    uint16_t seq;
+    uint8_t *payload;
+    size_t len;
+} uart_frame_t;
+
+/**
+ * @brief Build the CRC-32 lookup table. Call once before any other function.
+ */
+void uart_frame_init(void);
+
+/**
+ * @brief Compute the CRC-32 of a buffer.
+ *
+ * @param[in] data Bytes to checksum.
+ * @param[in] len Number of bytes.
+ * @return uint32_t The CRC-32.
+ */
+uint32_t uart_frame_crc32(const uint8_t *data, size_t len);
+
+/**
+ * @brief Encode a frame for the wire, including the trailing 0x00 delimiter.
+ *
+ * @param[in] frame Frame to encode; @c len must not exceed UART_FRAME_MAX_PAYLOAD.
+ * @param[out] out Output buffer.
+ * @param[in] out_size Size of @p out; UART_FRAME_MAX_ENCODED always suffices.
+ * @return size_t Number of bytes written, or 0 if the frame does not fit.
+ */
+size_t uart_frame_encode(const uart_frame_t *frame, uint8_t *out, size_t out_size);
+
+/**
+ * @brief Decode one frame in place.
+ *
+ * @param[in,out] buf Encoded bytes between two delimiters, without the 0x00.
+ *                    Overwritten with the decoded frame.
+ * @param[in] len Number of bytes in @p buf.
+ * @param[out] frame Decoded frame; @c payload points into @p buf.
+ * @return uart_frame_status_t UART_FRAME_OK or the reason the frame was rejected.
+ */
+uart_frame_status_t uart_frame_decode(uint8_t *buf, size_t len, uart_frame_t *frame);
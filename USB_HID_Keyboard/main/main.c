@@ -52,14 +52,18 @@
 #define COMMAND_DELAY_MS    500         // Delay between commands
 #define LONG_DELAY_MS       1000        // Delay for slow operations
 #define KEY_PRESS_DELAY_MS  100         // Key press duration
+#define HID_POLL_INTERVAL_MS 1          // Report interval requested from the host
+#define TYPING_QUEUE_LENGTH 256         // Keystrokes buffered for the typing task
 
 // Task priorities
 #define AUTOMATION_TASK_PRIORITY    4
 #define LED_TASK_PRIORITY           3
+#define TYPING_TASK_PRIORITY        5
 
 // Task stack sizes
 #define AUTOMATION_TASK_STACK_SIZE  4096
 #define LED_TASK_STACK_SIZE         2048
+#define TYPING_TASK_STACK_SIZE      3072
 
 // HID Report ID
 #define HID_REPORT_ID_KEYBOARD 1
@@ -102,9 +106,13 @@ static const char *TAG = "USB_HID_KEYBOARD";
 static QueueHandle_t button_event_queue = NULL;
 static SemaphoreHandle_t keyboard_mutex = NULL;
 static TaskHandle_t automation_task_handle = NULL;
+static QueueHandle_t typing_queue = NULL;
+static SemaphoreHandle_t typing_done = NULL;
+static TaskHandle_t typing_task_handle = NULL;
 
 // State variables
 static volatile bool automation_running = false;
+static volatile bool typing_failed = false;
 
 // LED control queue
 typedef enum
@@ -177,7 +185,7 @@ static const uint8_t _config_desc[] = {
                        sizeof(hid_keyboard_report_descriptor),
                        EPNUM_HID,
                        HID_REPORT_LEN,
-                       10)};
+                       HID_POLL_INTERVAL_MS)};
 
 // -------- String Descriptors --------
 // Tiny table of UTF-8 strings; IDF converts to UTF-16 internally.
@@ -190,6 +198,131 @@ static const char *_string_desc[] = {
 };
 static const int _string_desc_count = sizeof(_string_desc) / sizeof(_string_desc[0]);
 
+// ============================================================================
+// Keyboard Layout
+// ============================================================================
+
+/**
+ * One keystroke for the typing task: a keycode with its modifier.
+ * A keycode of TYPING_END_OF_STRING marks the end of a typed string.
+ */
+typedef struct
+{
+    uint8_t modifier;
+    uint8_t keycode;
+} key_stroke_t;
+
+#define TYPING_END_OF_STRING 0x00
+
+#define KEY(code)     {0, (code)}
+#define SHIFTED(code) {KEYBOARD_MODIFIER_LEFTSHIFT, (code)}
+
+/**
+ * ASCII to HID keystroke map for a US host keyboard layout.
+ * Characters without an entry are skipped when typing. To type on a host
+ * configured for another layout, replace the entries for that layout.
+ */
+static const key_stroke_t us_layout[128] = {
+    ['\b'] = KEY(0x2A),
+    ['\t'] = KEY(0x2B),
+    ['\n'] = KEY(0x28),
+    [' '] = KEY(0x2C),
+    ['!'] = SHIFTED(0x1E),
+    ['"'] = SHIFTED(0x34),
+    ['#'] = SHIFTED(0x20),
+    ['$'] = SHIFTED(0x21),
+    ['%'] = SHIFTED(0x22),
+    ['&'] = SHIFTED(0x24),
+    ['\''] = KEY(0x34),
+    ['('] = SHIFTED(0x26),
+    [')'] = SHIFTED(0x27),
+    ['*'] = SHIFTED(0x25),
+    ['+'] = SHIFTED(0x2E),
+    [','] = KEY(0x36),
+    ['-'] = KEY(0x2D),
+    ['.'] = KEY(0x37),
+    ['/'] = KEY(0x38),
+    ['0'] = KEY(0x27),
+    ['1'] = KEY(0x1E),
+    ['2'] = KEY(0x1F),
+    ['3'] = KEY(0x20),
+    ['4'] = KEY(0x21),
+    ['5'] = KEY(0x22),
+    ['6'] = KEY(0x23),
+    ['7'] = KEY(0x24),
+    ['8'] = KEY(0x25),
+    ['9'] = KEY(0x26),
+    [':'] = SHIFTED(0x33),
+    [';'] = KEY(0x33),
+    ['<'] = SHIFTED(0x36),
+    ['='] = KEY(0x2E),
+    ['>'] = SHIFTED(0x37),
+    ['?'] = SHIFTED(0x38),
+    ['@'] = SHIFTED(0x1F),
+    ['A'] = SHIFTED(0x04),
+    ['B'] = SHIFTED(0x05),
+    ['C'] = SHIFTED(0x06),
+    ['D'] = SHIFTED(0x07),
+    ['E'] = SHIFTED(0x08),
+    ['F'] = SHIFTED(0x09),
+    ['G'] = SHIFTED(0x0A),
+    ['H'] = SHIFTED(0x0B),
+    ['I'] = SHIFTED(0x0C),
+    ['J'] = SHIFTED(0x0D),
+    ['K'] = SHIFTED(0x0E),
+    ['L'] = SHIFTED(0x0F),
+    ['M'] = SHIFTED(0x10),
+    ['N'] = SHIFTED(0x11),
+    ['O'] = SHIFTED(0x12),
+    ['P'] = SHIFTED(0x13),
+    ['Q'] = SHIFTED(0x14),
+    ['R'] = SHIFTED(0x15),
+    ['S'] = SHIFTED(0x16),
+    ['T'] = SHIFTED(0x17),
+    ['U'] = SHIFTED(0x18),
+    ['V'] = SHIFTED(0x19),
+    ['W'] = SHIFTED(0x1A),
+    ['X'] = SHIFTED(0x1B),
+    ['Y'] = SHIFTED(0x1C),
+    ['Z'] = SHIFTED(0x1D),
+    ['['] = KEY(0x2F),
+    ['\\'] = KEY(0x31),
+    [']'] = KEY(0x30),
+    ['^'] = SHIFTED(0x23),
+    ['_'] = SHIFTED(0x2D),
+    ['`'] = KEY(0x35),
+    ['a'] = KEY(0x04),
+    ['b'] = KEY(0x05),
+    ['c'] = KEY(0x06),
+    ['d'] = KEY(0x07),
+    ['e'] = KEY(0x08),
+    ['f'] = KEY(0x09),
+    ['g'] = KEY(0x0A),
+    ['h'] = KEY(0x0B),
+    ['i'] = KEY(0x0C),
+    ['j'] = KEY(0x0D),
+    ['k'] = KEY(0x0E),
+    ['l'] = KEY(0x0F),
+    ['m'] = KEY(0x10),
+    ['n'] = KEY(0x11),
+    ['o'] = KEY(0x12),
+    ['p'] = KEY(0x13),
+    ['q'] = KEY(0x14),
+    ['r'] = KEY(0x15),
+    ['s'] = KEY(0x16),
+    ['t'] = KEY(0x17),
+    ['u'] = KEY(0x18),
+    ['v'] = KEY(0x19),
+    ['w'] = KEY(0x1A),
+    ['x'] = KEY(0x1B),
+    ['y'] = KEY(0x1C),
+    ['z'] = KEY(0x1D),
+    ['{'] = SHIFTED(0x2F),
+    ['|'] = SHIFTED(0x31),
+    ['}'] = SHIFTED(0x30),
+    ['~'] = SHIFTED(0x35),
+};
+
 // ============================================================================
 // Function prototypes
 // ============================================================================
@@ -276,6 +409,21 @@ void tud_hid_set_report_cb(uint8_t instance, uint8_t report_id,
     (void)bufsize;
 }
 
+/**
+ * Invoked when an IN report has been delivered to the host
+ * Wakes the typing task so the next report goes out in the next frame
+ */
+void tud_hid_report_complete_cb(uint8_t instance, uint8_t const *report,
+                                uint16_t len)
+{
+    (void)instance;
+    (void)report;
+    (void)len;
+    if (typing_task_handle != NULL) {
+        xTaskNotifyGive(typing_task_handle);
+    }
+}
+
 /**
  * Invoked when GET HID REPORT DESCRIPTOR is received
  * Application return pointer to descriptor
@@ -425,78 +573,136 @@ static void keyboard_press_key(uint8_t modifier, uint8_t keycode)
 }
 
 /**
- * Types a string character by character
+* @brief Wait for the HID endpoint without polling.
+*
+* Unlike `hid_wait_ready()`, this sleeps on the notification sent by
+* `tud_hid_report_complete_cb()`, so the typing task wakes as soon as the
+* previous report has been delivered instead of after a fixed 5 ms step.
+* It must only be called from the typing task.
+*
+* @return true if the HID interface became ready before HID_READY_TIMEOUT_MS.
+*/
+static bool typing_wait_ready(void) {
+    const TickType_t start = xTaskGetTickCount();
+    const TickType_t timeout = pdMS_TO_TICKS(HID_READY_TIMEOUT_MS);
+
+    while (!tud_hid_ready()) {
+        const TickType_t elapsed = xTaskGetTickCount() - start;
+        if (!usb_is_ready() || elapsed >= timeout) {
+            return false;
+        }
+        ulTaskNotifyTake(pdTRUE, timeout - elapsed);
+    }
+    return true;
+}
+
+/**
+ * Sends one report from the typing task
  *
- * @param str String to type
+ * @param report Report to send
+ * @return true if the report was queued on the endpoint
  */
-static void keyboard_type_string(const char *str)
-{
-    for (size_t i = 0; str[i] != '\0'; i++)
-    {
-        uint8_t keycode = 0;
-        uint8_t modifier = 0;
+static bool typing_send_report(const hid_keyboard_report_t *report) {
+    if (xSemaphoreTake(keyboard_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
+        return false;
+    }
 
-        // Convert ASCII to HID keycode
-        char c = str[i];
+    bool result = typing_wait_ready() &&
+                  tud_hid_keyboard_report(HID_REPORT_ID_KEYBOARD,
+                                          report->modifier,
+                                          report->keycode);
+    xSemaphoreGive(keyboard_mutex);
+    return result;
+}
 
-        if (c >= 'a' && c <= 'z')
-        {
-            keycode = HID_KEY_A + (c - 'a');
-        }
-        else if (c >= 'A' && c <= 'Z')
-        {
-            keycode = HID_KEY_A + (c - 'A');
-            modifier = KEYBOARD_MODIFIER_LEFTSHIFT;
-        }
-        else if (c >= '1' && c <= '9')
-        {
-            keycode = 0x1E + (c - '1'); // 1-9 keys
-        }
-        else if (c == '0')
-        {
-            keycode = 0x27;
-        }
-        else if (c == ' ')
-        {
-            keycode = HID_KEY_SPACE;
-        }
-        else if (c == '\n')
-        {
-            keycode = HID_KEY_ENTER;
-        }
-        else if (c == '.')
-        {
-            keycode = 0x37;
-        }
-        else if (c == ':')
-        {
-            keycode = 0x33;
-            modifier = KEYBOARD_MODIFIER_LEFTSHIFT;
-        }
-        else if (c == '/')
+/**
+ * Typing task
+ * Turns queued keystrokes into HID reports, one report per USB frame.
+ *
+ * Each report presses the next key, which also releases the previous one, so
+ * a character costs a single report. An extra report is sent only when the
+ * modifier changes (so the host applies it before the key) or when the same
+ * key repeats (the host needs to see it released first).
+ *
+ * @param pvParameters Task parameters (unused)
+ */
+static void typing_task(void *pvParameters)
+{
+    key_stroke_t stroke;
+    hid_keyboard_report_t report = {0};
+    bool ok = true;
+
+    while (1)
+    {
+        if (xQueueReceive(typing_queue, &stroke, portMAX_DELAY) != pdTRUE)
         {
-            keycode = 0x38;
+            continue;
         }
-        else if (c == '-')
+
+        if (stroke.keycode == TYPING_END_OF_STRING)
         {
-            keycode = 0x2D;
+            if (ok && (report.modifier != 0 || report.keycode[0] != 0))
+            {
+                memset(&report, 0, sizeof(report));
+                ok = typing_send_report(&report);
+            }
+            memset(&report, 0, sizeof(report));
+            typing_failed = !ok;
+            ok = true;
+            xSemaphoreGive(typing_done);
+            continue;
         }
-        else if (c == '=')
+
+        // After a failure, drop the rest of the string
+        if (!ok)
         {
-            keycode = 0x2E;
+            continue;
         }
-        else if (c == '!')
+
+        if (stroke.modifier != report.modifier || stroke.keycode == report.keycode[0])
         {
-            keycode = 0x1E; // 1 key
-            modifier = KEYBOARD_MODIFIER_LEFTSHIFT;
+            report.modifier = stroke.modifier;
+            report.keycode[0] = 0;
+            ok = typing_send_report(&report);
         }
-        else
+
+        report.keycode[0] = stroke.keycode;
+        ok = ok && typing_send_report(&report);
+    }
+}
+
+/**
+ * Types a string through the typing task
+ *
+ * Characters are mapped with the keyboard layout table and queued; the call
+ * returns once the whole string has been typed and all keys are released.
+ * Characters missing from the layout are skipped.
+ *
+ * @param str String to type
+ */
+static void keyboard_type_string(const char *str)
+{
+    for (size_t i = 0; str[i] != '\0'; i++)
+    {
+        const unsigned char c = (unsigned char)str[i];
+        if (c >= sizeof(us_layout) / sizeof(us_layout[0]) || us_layout[c].keycode == 0)
         {
             continue; // Skip unsupported characters
         }
+        xQueueSend(typing_queue, &us_layout[c], portMAX_DELAY);
+    }
+
+    const key_stroke_t end = {0, TYPING_END_OF_STRING};
+    xQueueSend(typing_queue, &end, portMAX_DELAY);
+    xSemaphoreTake(typing_done, portMAX_DELAY);
+
+    if (typing_failed) {
+        ESP_LOGW(TAG, "USB/HID not ready; typing aborted");
 
-        keyboard_press_key(modifier, keycode);
-        vTaskDelay(pdMS_TO_TICKS(50)); // Human-like typing speed
+        // If automation task is running, terminate it
+        if (automation_running) {
+            delete_automation_task();
+        }
     }
 }
 
@@ -1117,7 +1323,10 @@ void app_main(void)
     button_event_queue = xQueueCreate(10, sizeof(uint32_t));
     led_queue = xQueueCreate(10, sizeof(led_message_t));
     keyboard_mutex = xSemaphoreCreateMutex();    
-    if (button_event_queue == NULL || led_queue == NULL || keyboard_mutex == NULL) {
+    typing_queue = xQueueCreate(TYPING_QUEUE_LENGTH, sizeof(key_stroke_t));
+    typing_done = xSemaphoreCreateBinary();
+    if (button_event_queue == NULL || led_queue == NULL || keyboard_mutex == NULL ||
+        typing_queue == NULL || typing_done == NULL) {
         ESP_LOGE(TAG, "Failed to create queues or mutex");
         return;
     }
@@ -1128,6 +1337,10 @@ void app_main(void)
     // Initialize USB HID
     init_usb_hid();
 
+    // Start typing task
+    xTaskCreate(typing_task, "typing_task", TYPING_TASK_STACK_SIZE,
+                NULL, TYPING_TASK_PRIORITY, &typing_task_handle);
+
     // Start LED control task
     xTaskCreate(led_task, "led_task", LED_TASK_STACK_SIZE,
                 NULL, LED_TASK_PRIORITY, NULL);
@@ -0,0 +1,67 @@
+/**
+ * @file
+ * @brief Task stack high-water profiling with persistent worst cases
+ *
+ * A background task samples uxTaskGetSystemState() and keeps, per task name,
+ * the smallest stack high-water mark (fewest bytes never used) ever seen.
+ * New minimums are copied to RTC no-init memory right away, so they survive
+ * the panic or watchdog reset a stack problem usually ends in, and to NVS at
+ * a limited rate, so they also survive power loss.
+ *
+ * FreeRTOS does not expose the size a task was created with, so the
+ * application passes it with stack_profiler_set_stack_size(). Tasks with a
+ * known size get a recommended size (worst usage plus a margin, rounded up)
+ * and the bytes that would be reclaimed; the others only show their headroom.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Load the persisted worst cases and start sampling
+ *
+ * NVS must already be initialized. Merges the NVS and RTC records, logs the
+ * worst cases from earlier boots (including an overflow recorded by
+ * stack_profiler_note_overflow()) and starts the sampler task.
+ *
+ * @return ESP_OK, ESP_ERR_INVALID_STATE if already started, ESP_ERR_NO_MEM,
+ *         or an NVS error
+ */
+esp_err_t stack_profiler_start(void);
+
+/**
+ * @brief Tell the profiler how large a task's stack is
+ *
+ * Call with the same value passed to xTaskCreate(). Safe from any task,
+ * before or after stack_profiler_start().
+ *
+ * @param task_name   Task name as passed to xTaskCreate()
+ * @param stack_bytes Stack size in bytes
+ */
+void stack_profiler_set_stack_size(const char *task_name, uint32_t stack_bytes);
+
+/**
+ * @brief Record that a task overflowed its stack
+ *
+ * Meant for vApplicationStackOverflowHook(). Only writes RTC memory, so it
+ * is safe to call right before aborting; the overflow is reported on the
+ * next boot.
+ *
+ * @param task_name Name of the task that overflowed
+ */
+void stack_profiler_note_overflow(const char *task_name);
+
+/**
+ * @brief Log the worst case, headroom and recommended size of every task
+ */
+void stack_profiler_report(void);
+
+#ifdef __cplusplus
+}
+#endif
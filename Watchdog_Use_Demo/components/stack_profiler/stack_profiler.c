@@ -0,0 +1,397 @@
+/**
+ * @file
+ * @brief Task stack high-water profiling with persistent worst cases
+ */
+
+#include "stack_profiler.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include "sdkconfig.h"
+
+#if CONFIG_STACK_PROFILER
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+#include "nvs.h"
+
+static const char *TAG = "stack_prof";
+
+#define STORE_MAGIC         0x53544B31U
+#define NVS_NAMESPACE       "stack_prof"
+#define NVS_KEY_RECORDS     "records"
+#define SIZE_ROUND_BYTES    256U
+#define SAMPLER_STACK_BYTES 3072
+#define SAMPLER_PRIORITY    1
+
+/* Worst case of one task across all boots. */
+typedef struct {
+    char name[configMAX_TASK_NAME_LEN];
+    uint32_t min_free;      /* Bytes; ESP-IDF stacks are counted in bytes. */
+} stack_record_t;
+
+/* Mirror of s_records that survives software resets; checked with a CRC. */
+typedef struct {
+    uint32_t magic;
+    uint32_t count;
+    stack_record_t records[CONFIG_STACK_PROFILER_MAX_TASKS];
+    char overflow_task[configMAX_TASK_NAME_LEN];
+    uint32_t crc;
+} rtc_store_t;
+
+typedef struct {
+    char name[configMAX_TASK_NAME_LEN];
+    uint32_t bytes;
+} stack_size_t;
+
+static RTC_NOINIT_ATTR rtc_store_t s_rtc;
+
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static stack_record_t s_records[CONFIG_STACK_PROFILER_MAX_TASKS];
+static uint32_t s_record_count;
+static stack_size_t s_sizes[CONFIG_STACK_PROFILER_MAX_TASKS];
+static uint32_t s_size_count;
+
+/* Sampler task only. */
+static TaskStatus_t s_status[CONFIG_STACK_PROFILER_MAX_TASKS];
+static stack_record_t s_nvs_copy[CONFIG_STACK_PROFILER_MAX_TASKS];
+static TaskHandle_t s_task;
+
+static void copy_name(char *dst, const char *src)
+{
+    strncpy(dst, src, configMAX_TASK_NAME_LEN - 1);
+    dst[configMAX_TASK_NAME_LEN - 1] = '\0';
+}
+
+static uint32_t rtc_crc(void)
+{
+    return esp_rom_crc32_le(0, (const uint8_t *)&s_rtc, offsetof(rtc_store_t, crc));
+}
+
+static bool rtc_valid(void)
+{
+    return s_rtc.magic == STORE_MAGIC &&
+           s_rtc.count <= CONFIG_STACK_PROFILER_MAX_TASKS &&
+           s_rtc.crc == rtc_crc();
+}
+
+/* Caller holds s_lock. Leaves overflow_task as it is. */
+static void rtc_sync_locked(void)
+{
+    s_rtc.magic = STORE_MAGIC;
+    s_rtc.count = s_record_count;
+    memcpy(s_rtc.records, s_records, s_record_count * sizeof(s_records[0]));
+    s_rtc.crc = rtc_crc();
+}
+
+/**
+ * @brief Fold one observation into s_records
+ *
+ * Caller holds s_lock.
+ *
+ * @return true if this is a new task or a new worst case
+ */
+static bool merge_locked(const char *name, uint32_t min_free)
+{
+    for (uint32_t i = 0; i < s_record_count; i++) {
+        if (strncmp(s_records[i].name, name, configMAX_TASK_NAME_LEN) == 0) {
+            if (min_free < s_records[i].min_free) {
+                s_records[i].min_free = min_free;
+                return true;
+            }
+            return false;
+        }
+    }
+
+    if (s_record_count == CONFIG_STACK_PROFILER_MAX_TASKS) {
+        return false;
+    }
+
+    copy_name(s_records[s_record_count].name, name);
+    s_records[s_record_count].min_free = min_free;
+    s_record_count++;
+    return true;
+}
+
+/* Caller holds s_lock. Returns 0 when the size is unknown. */
+static uint32_t size_of_locked(const char *name)
+{
+    for (uint32_t i = 0; i < s_size_count; i++) {
+        if (strncmp(s_sizes[i].name, name, configMAX_TASK_NAME_LEN) == 0) {
+            return s_sizes[i].bytes;
+        }
+    }
+    return 0;
+}
+
+static esp_err_t nvs_load(void)
+{
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs);
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        return ESP_OK;      /* First boot. */
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    size_t len = sizeof(s_nvs_copy);
+    err = nvs_get_blob(nvs, NVS_KEY_RECORDS, s_nvs_copy, &len);
+    nvs_close(nvs);
+
+    if (err == ESP_ERR_NVS_NOT_FOUND) {
+        return ESP_OK;
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    taskENTER_CRITICAL(&s_lock);
+    for (size_t i = 0; i < len / sizeof(s_nvs_copy[0]); i++) {
+        s_nvs_copy[i].name[configMAX_TASK_NAME_LEN - 1] = '\0';
+        merge_locked(s_nvs_copy[i].name, s_nvs_copy[i].min_free);
+    }
+    taskEXIT_CRITICAL(&s_lock);
+    return ESP_OK;
+}
+
+static esp_err_t nvs_save(void)
+{
+    taskENTER_CRITICAL(&s_lock);
+    uint32_t count = s_record_count;
+    memcpy(s_nvs_copy, s_records, count * sizeof(s_records[0]));
+    taskEXIT_CRITICAL(&s_lock);
+
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    err = nvs_set_blob(nvs, NVS_KEY_RECORDS, s_nvs_copy, count * sizeof(s_nvs_copy[0]));
+    if (err == ESP_OK) {
+        err = nvs_commit(nvs);
+    }
+    nvs_close(nvs);
+    return err;
+}
+
+/**
+ * @brief Take one high-water sample of every task
+ *
+ * @return true if any worst case changed
+ */
+static bool sample(void)
+{
+    static bool s_warned;
+    UBaseType_t n = uxTaskGetSystemState(s_status, CONFIG_STACK_PROFILER_MAX_TASKS, NULL);
+
+    if (n == 0) {
+        /* uxTaskGetSystemState() fills nothing when the array is too small. */
+        if (!s_warned) {
+            ESP_LOGW(TAG, "more than %d tasks; raise STACK_PROFILER_MAX_TASKS",
+                     CONFIG_STACK_PROFILER_MAX_TASKS);
+            s_warned = true;
+        }
+        return false;
+    }
+
+    bool changed = false;
+    taskENTER_CRITICAL(&s_lock);
+    for (UBaseType_t i = 0; i < n; i++) {
+        changed |= merge_locked(s_status[i].pcTaskName, s_status[i].usStackHighWaterMark);
+    }
+    if (changed) {
+        rtc_sync_locked();
+    }
+    taskEXIT_CRITICAL(&s_lock);
+    return changed;
+}
+
+static void sampler_task(void *arg)
+{
+    (void)arg;
+    bool dirty = false;
+    int64_t last_commit_us = esp_timer_get_time();
+    int64_t last_report_us = last_commit_us;
+    TickType_t wake = xTaskGetTickCount();
+
+    for (;;) {
+        vTaskDelayUntil(&wake, pdMS_TO_TICKS(CONFIG_STACK_PROFILER_SAMPLE_MS));
+
+        dirty |= sample();
+        int64_t now_us = esp_timer_get_time();
+
+        if (dirty && now_us - last_commit_us >= CONFIG_STACK_PROFILER_NVS_COMMIT_S * 1000000LL) {
+            esp_err_t err = nvs_save();
+            if (err == ESP_OK) {
+                dirty = false;
+            } else {
+                ESP_LOGW(TAG, "NVS save failed: %s", esp_err_to_name(err));
+            }
+            last_commit_us = now_us;
+        }
+
+#if CONFIG_STACK_PROFILER_REPORT_S > 0
+        if (now_us - last_report_us >= CONFIG_STACK_PROFILER_REPORT_S * 1000000LL) {
+            last_report_us = now_us;
+            stack_profiler_report();
+        }
+#else
+        (void)last_report_us;
+#endif
+    }
+}
+
+esp_err_t stack_profiler_start(void)
+{
+    if (s_task != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t err = nvs_load();
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    bool from_rtc = false;
+    char overflow[configMAX_TASK_NAME_LEN] = "";
+
+    taskENTER_CRITICAL(&s_lock);
+    if (rtc_valid()) {
+        /* Worst cases reached after the last NVS write, up to the reset. */
+        for (uint32_t i = 0; i < s_rtc.count; i++) {
+            from_rtc |= merge_locked(s_rtc.records[i].name, s_rtc.records[i].min_free);
+        }
+        copy_name(overflow, s_rtc.overflow_task);
+        if (overflow[0] != '\0') {
+            from_rtc |= merge_locked(overflow, 0);
+        }
+    }
+    /* Power-on garbage or a reported overflow; start the mirror afresh. */
+    s_rtc.overflow_task[0] = '\0';
+    rtc_sync_locked();
+    taskEXIT_CRITICAL(&s_lock);
+
+    if (overflow[0] != '\0') {
+        ESP_LOGE(TAG, "previous boot ended in a stack overflow in task %s", overflow);
+    }
+    if (from_rtc) {
+        err = nvs_save();
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "NVS save failed: %s", esp_err_to_name(err));
+        }
+    }
+
+    ESP_LOGI(TAG, "worst cases from previous boots:");
+    stack_profiler_report();
+
+    if (xTaskCreate(sampler_task, "stack_prof", SAMPLER_STACK_BYTES, NULL,
+                    SAMPLER_PRIORITY, &s_task) != pdPASS) {
+        s_task = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+    stack_profiler_set_stack_size("stack_prof", SAMPLER_STACK_BYTES);
+    return ESP_OK;
+}
+
+void stack_profiler_set_stack_size(const char *task_name, uint32_t stack_bytes)
+{
+    taskENTER_CRITICAL(&s_lock);
+    uint32_t i = 0;
+    while (i < s_size_count && strncmp(s_sizes[i].name, task_name, configMAX_TASK_NAME_LEN) != 0) {
+        i++;
+    }
+    if (i < CONFIG_STACK_PROFILER_MAX_TASKS) {
+        copy_name(s_sizes[i].name, task_name);
+        s_sizes[i].bytes = stack_bytes;
+        if (i == s_size_count) {
+            s_size_count++;
+        }
+    }
+    taskEXIT_CRITICAL(&s_lock);
+}
+
+void stack_profiler_note_overflow(const char *task_name)
+{
+    /* May run with the scheduler suspended and the stack already corrupt;
+     * no locks and no logging. */
+    if (!rtc_valid()) {
+        s_rtc.magic = STORE_MAGIC;
+        s_rtc.count = 0;
+    }
+    copy_name(s_rtc.overflow_task, task_name != NULL ? task_name : "?");
+    s_rtc.crc = rtc_crc();
+}
+
+void stack_profiler_report(void)
+{
+    uint32_t total_reclaim = 0;
+
+    taskENTER_CRITICAL(&s_lock);
+    uint32_t count = s_record_count;
+    taskEXIT_CRITICAL(&s_lock);
+
+    if (count == 0) {
+        ESP_LOGI(TAG, "  (no data)");
+        return;
+    }
+
+    for (uint32_t i = 0; i < count; i++) {
+        taskENTER_CRITICAL(&s_lock);
+        stack_record_t rec = s_records[i];
+        uint32_t size = size_of_locked(rec.name);
+        taskEXIT_CRITICAL(&s_lock);
+
+        if (size == 0) {
+            ESP_LOGI(TAG, "  %-16s worst free %5lu B (size unknown)",
+                     rec.name, (unsigned long)rec.min_free);
+            continue;
+        }
+
+        uint32_t used = (rec.min_free < size) ? size - rec.min_free : size;
+        uint32_t want = (uint32_t)(((uint64_t)used * (100 + CONFIG_STACK_PROFILER_MARGIN_PCT) + 99) / 100);
+        want = (want + SIZE_ROUND_BYTES - 1) / SIZE_ROUND_BYTES * SIZE_ROUND_BYTES;
+
+        if (want < size) {
+            total_reclaim += size - want;
+            ESP_LOGI(TAG, "  %-16s size %5lu B, worst used %5lu B -> recommend %5lu B (reclaim %lu B)",
+                     rec.name, (unsigned long)size, (unsigned long)used,
+                     (unsigned long)want, (unsigned long)(size - want));
+        } else {
+            ESP_LOGW(TAG, "  %-16s size %5lu B, worst used %5lu B -> recommend %5lu B (grow)",
+                     rec.name, (unsigned long)size, (unsigned long)used, (unsigned long)want);
+        }
+    }
+
+    ESP_LOGI(TAG, "  reclaimable with %d%% margin: %lu B",
+             CONFIG_STACK_PROFILER_MARGIN_PCT, (unsigned long)total_reclaim);
+}
+
+#else /* !CONFIG_STACK_PROFILER */
+
+esp_err_t stack_profiler_start(void)
+{
+    return ESP_OK;
+}
+
+void stack_profiler_set_stack_size(const char *task_name, uint32_t stack_bytes)
+{
+    (void)task_name;
+    (void)stack_bytes;
+}
+
+void stack_profiler_note_overflow(const char *task_name)
+{
+    (void)task_name;
+}
+
+void stack_profiler_report(void)
+{
+}
+
+#endif /* CONFIG_STACK_PROFILER */
@@ -0,0 +1,253 @@
+/**
+ * @file        hb_supervisor.c
+ *
+ * @brief       Heartbeat supervisor implementation (see hb_supervisor.h).
+ *
+ * Check-ins are observed when the supervisor swaps the mask out, so interval
+ * samples are quantized to the check period. That keeps hb_supervisor_beat()
+ * down to one atomic OR with no timestamp; the quantization is the price.
+ */
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_task_wdt.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "hb_supervisor.h"
+
+#define TAG "HB_SUPERVISOR"
+
+#define HB_SUPERVISOR_TASK_STACK     3072
+#define HB_SUPERVISOR_TASK_PRIORITY  (configMAX_PRIORITIES - 2)
+
+// -----------------------------------------------------------------------------
+// State
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Per-task bookkeeping. Written by hb_supervisor_register() before the
+ *        task's bit is published in s_registered_mask, afterwards only by the
+ *        supervisor task.
+ */
+typedef struct {
+    const char *name;
+    uint32_t period_ms;
+    int64_t last_seen_us;                                /**< Last observed check-in */
+    uint32_t intervals_ms[HB_SUPERVISOR_INTERVAL_SAMPLES];
+    uint32_t interval_count;                             /**< Total samples ever written */
+    uint32_t near_misses;                                /**< Since the last report */
+    bool late;
+} hb_slot_t;
+
+static hb_slot_t s_slots[HB_SUPERVISOR_MAX_TASKS];
+static uint32_t s_slot_count = 0;
+static portMUX_TYPE s_register_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static atomic_uint_least32_t s_registered_mask = 0;
+static atomic_uint_least32_t s_checkin_mask = 0;
+
+static TaskHandle_t s_task = NULL;
+static uint32_t s_check_period_ms = 0;
+
+// -----------------------------------------------------------------------------
+// Helpers
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief qsort comparator for uint32_t values.
+ */
+static int cmp_u32(const void *a, const void *b)
+{
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Records a heartbeat interval for a slot and flags near-misses.
+ *
+ * @param slot        Slot that checked in.
+ * @param interval_ms Time since its previous observed check-in.
+ */
+static void record_interval(hb_slot_t *slot, uint32_t interval_ms)
+{
+    slot->intervals_ms[slot->interval_count % HB_SUPERVISOR_INTERVAL_SAMPLES] = interval_ms;
+    slot->interval_count++;
+
+    // Late check-ins are still inside the deadline here, so they only warn
+    if ((uint64_t)interval_ms * 100 > (uint64_t)slot->period_ms * HB_SUPERVISOR_NEAR_MISS_PCT) {
+        slot->near_misses++;
+        ESP_LOGW(TAG, "[%s] near-miss: %lu ms since last check-in (period %lu ms)",
+                 slot->name, (unsigned long)interval_ms, (unsigned long)slot->period_ms);
+    }
+}
+
+/**
+ * @brief Logs p50/p90/p99/max of the recent intervals of every task.
+ *
+ * @param registered Mask of registered slots.
+ */
+static void report_intervals(uint32_t registered)
+{
+    uint32_t sorted[HB_SUPERVISOR_INTERVAL_SAMPLES];
+
+    for (uint32_t i = 0; i < HB_SUPERVISOR_MAX_TASKS; ++i) {
+        if ((registered & (1UL << i)) == 0) {
+            continue;
+        }
+
+        hb_slot_t *slot = &s_slots[i];
+        uint32_t n = slot->interval_count < HB_SUPERVISOR_INTERVAL_SAMPLES
+                         ? slot->interval_count
+                         : HB_SUPERVISOR_INTERVAL_SAMPLES;
+
+        if (n == 0) {
+            ESP_LOGI(TAG, "[%s] period=%lu ms: no check-ins yet", slot->name,
+                     (unsigned long)slot->period_ms);
+            continue;
+        }
+
+        memcpy(sorted, slot->intervals_ms, n * sizeof(sorted[0]));
+        qsort(sorted, n, sizeof(sorted[0]), cmp_u32);
+
+        ESP_LOGI(TAG, "[%s] period=%lu ms intervals(n=%lu) p50=%lu p90=%lu p99=%lu max=%lu ms near-misses=%lu",
+                 slot->name, (unsigned long)slot->period_ms, (unsigned long)n,
+                 (unsigned long)sorted[(n - 1) * 50 / 100],
+                 (unsigned long)sorted[(n - 1) * 90 / 100],
+                 (unsigned long)sorted[(n - 1) * 99 / 100],
+                 (unsigned long)sorted[n - 1],
+                 (unsigned long)slot->near_misses);
+
+        slot->near_misses = 0;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Supervisor task
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief Periodic pass over all registered tasks; feeds the TWDT when all are on time.
+ *
+ * @param pvParameter Unused task parameter (pass NULL).
+ */
+static void hb_supervisor_task(void *pvParameter)
+{
+    (void)pvParameter;
+
+    ESP_ERROR_CHECK(esp_task_wdt_add(NULL));  // the only application task on the TWDT
+
+    TickType_t last_wake = xTaskGetTickCount();
+    int64_t last_report_us = esp_timer_get_time();
+
+    while (1) {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(s_check_period_ms));
+
+        uint32_t registered = atomic_load_explicit(&s_registered_mask, memory_order_acquire);
+        uint32_t beats = atomic_exchange_explicit(&s_checkin_mask, 0, memory_order_relaxed);
+        int64_t now_us = esp_timer_get_time();
+        bool all_on_time = true;
+
+        for (uint32_t i = 0; i < HB_SUPERVISOR_MAX_TASKS; ++i) {
+            uint32_t bit = 1UL << i;
+            if ((registered & bit) == 0) {
+                continue;
+            }
+
+            hb_slot_t *slot = &s_slots[i];
+
+            if (beats & bit) {
+                record_interval(slot, (uint32_t)((now_us - slot->last_seen_us) / 1000));
+                slot->last_seen_us = now_us;
+                if (slot->late) {
+                    slot->late = false;
+                    ESP_LOGW(TAG, "[%s] checked in again", slot->name);
+                }
+            }
+
+            uint32_t silent_ms = (uint32_t)((now_us - slot->last_seen_us) / 1000);
+            if (silent_ms > slot->period_ms * HB_SUPERVISOR_DEADLINE_PERIODS) {
+                all_on_time = false;
+                if (!slot->late) {
+                    slot->late = true;
+                    ESP_LOGE(TAG, "[%s] missed its deadline (%lu ms silent, period %lu ms); withholding TWDT feed",
+                             slot->name, (unsigned long)silent_ms, (unsigned long)slot->period_ms);
+                }
+            }
+        }
+
+        if (all_on_time) {
+            ESP_ERROR_CHECK(esp_task_wdt_reset());
+        }
+
+        if (now_us - last_report_us >= (int64_t)HB_SUPERVISOR_REPORT_MS * 1000) {
+            last_report_us = now_us;
+            report_intervals(registered);
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Public API
+// -----------------------------------------------------------------------------
+
+esp_err_t hb_supervisor_start(uint32_t check_period_ms)
+{
+    if (s_task != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (check_period_ms == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    s_check_period_ms = check_period_ms;
+
+    if (xTaskCreate(hb_supervisor_task, "HbSupervisor", HB_SUPERVISOR_TASK_STACK, NULL,
+                    HB_SUPERVISOR_TASK_PRIORITY, &s_task) != pdPASS) {
+        s_task = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t hb_supervisor_register(const char *name, uint32_t period_ms, hb_id_t *out_id)
+{
+    if (name == NULL || period_ms == 0 || out_id == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    taskENTER_CRITICAL(&s_register_lock);
+    uint32_t index = s_slot_count;
+    if (index < HB_SUPERVISOR_MAX_TASKS) {
+        s_slot_count++;
+    }
+    taskEXIT_CRITICAL(&s_register_lock);
+
+    if (index >= HB_SUPERVISOR_MAX_TASKS) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    hb_slot_t *slot = &s_slots[index];
+    memset(slot, 0, sizeof(*slot));
+    slot->name = name;
+    slot->period_ms = period_ms;
+    slot->last_seen_us = esp_timer_get_time();
+
+    // Publish the filled slot to the supervisor
+    atomic_fetch_or_explicit(&s_registered_mask, 1UL << index, memory_order_release);
+
+    *out_id = (hb_id_t)index;
+    ESP_LOGI(TAG, "[%s] registered: period %lu ms, deadline %lu ms", name,
+             (unsigned long)period_ms, (unsigned long)(period_ms * HB_SUPERVISOR_DEADLINE_PERIODS));
+    return ESP_OK;
+}
+
+void hb_supervisor_beat(hb_id_t id)
+{
+    atomic_fetch_or_explicit(&s_checkin_mask, 1UL << id, memory_order_relaxed);
+}
@@ -0,0 +1,72 @@
+/**
+ * @file        hb_supervisor.h
+ *
+ * @brief       Heartbeat supervisor that feeds the Task Watchdog on behalf of
+ *              all registered tasks.
+ *
+ * Instead of subscribing every task to the TWDT, each task registers the period
+ * at which it expects to check in and then calls hb_supervisor_beat() once per
+ * loop. A check-in is a single atomic OR of the task's bit into a shared mask.
+ *
+ * The supervisor task is the only application task subscribed to the TWDT. On
+ * every pass it swaps the mask out, updates the last check-in time of every task
+ * whose bit was set and feeds the TWDT only if no task has gone longer than its
+ * deadline without checking in. A task that misses its deadline therefore
+ * resets the device through the normal TWDT timeout, while check-ins that were
+ * late but still inside the deadline are logged as near-misses. Heartbeat
+ * interval percentiles are logged periodically for every task.
+ */
+
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+
+/** Maximum number of supervised tasks (one bit each in the check-in mask). */
+#define HB_SUPERVISOR_MAX_TASKS         32
+
+/** A task is late once it has not checked in for this many of its periods. */
+#define HB_SUPERVISOR_DEADLINE_PERIODS  2
+
+/** Check-in intervals above this percentage of the period count as near-misses. */
+#define HB_SUPERVISOR_NEAR_MISS_PCT     150
+
+/** Number of recent heartbeat intervals kept per task for the percentiles. */
+#define HB_SUPERVISOR_INTERVAL_SAMPLES  32
+
+/** Interval between interval-percentile reports. */
+#define HB_SUPERVISOR_REPORT_MS         10000
+
+/** Identifier returned by hb_supervisor_register() and passed to hb_supervisor_beat(). */
+typedef uint8_t hb_id_t;
+
+/**
+ * @brief Starts the supervisor task and subscribes it to the TWDT.
+ *
+ * The TWDT must already be initialized. The check period bounds how precisely
+ * intervals are measured and should be well below both the shortest heartbeat
+ * period and the TWDT timeout.
+ *
+ * @param check_period_ms Time between supervisor passes, in milliseconds.
+ * @return ESP_OK, ESP_ERR_INVALID_STATE if already started, or ESP_ERR_NO_MEM.
+ */
+esp_err_t hb_supervisor_start(uint32_t check_period_ms);
+
+/**
+ * @brief Registers a task with the supervisor.
+ *
+ * Registration counts as the first check-in, so the deadline starts now.
+ *
+ * @param name      Name used in logs; must remain valid for the lifetime of the program.
+ * @param period_ms Expected time between calls to hb_supervisor_beat().
+ * @param out_id    Receives the identifier to pass to hb_supervisor_beat().
+ * @return ESP_OK, ESP_ERR_INVALID_ARG, or ESP_ERR_NO_MEM when all slots are taken.
+ */
+esp_err_t hb_supervisor_register(const char *name, uint32_t period_ms, hb_id_t *out_id);
+
+/**
+ * @brief Checks in for a registered task. Safe from any task.
+ *
+ * @param id Identifier returned by hb_supervisor_register().
+ */
+void hb_supervisor_beat(hb_id_t id);
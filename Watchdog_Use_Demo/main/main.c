@@ -5,11 +5,13 @@
  * @brief       ESP32 Task Watchdog (TWDT) demo with healthy, stuck, and flaky tasks,
  *              plus a deliberate stack overflow using the FreeRTOS stack overflow hook.
  *
- * This example configures the Task Watchdog Timer (WDT) and launches four tasks:
- *  - Healthy task: feeds the TWDT once per second (well-behaved).
- *  - Stuck task: never feeds the TWDT (simulates hard deadlock).
- *  - Flaky task: intermittently feeds the TWDT, then intentionally skips feeding long
- *    enough to trip the watchdog (simulates intermittent bugs).
+ * This example configures the Task Watchdog Timer (WDT), starts a heartbeat
+ * supervisor (hb_supervisor.c) that is the only application task subscribed to the
+ * TWDT, and launches four tasks:
+ *  - Healthy task: checks in once per second (well-behaved).
+ *  - Stuck task: never checks in (simulates hard deadlock).
+ *  - Flaky task: checks in with one late (near-miss) heartbeat, then intentionally
+ *    stops long enough to trip the watchdog (simulates intermittent bugs).
  *  - Tiny-stack task: created with a very small stack and a function that consumes
  *    stack aggressively, causing a deliberate stack overflow. The overflow is caught
  *    by FreeRTOS via vApplicationStackOverflowHook().
@@ -19,6 +21,8 @@
  *    Component config → FreeRTOS → Check for stack overflow → Method B (2).
  *  - TWDT can be auto-initialized by menuconfig; this code tolerates both cases.
  *  - TWDT timeout is 5 seconds in this demo.
+ *  - A task that misses its heartbeat deadline makes the supervisor stop feeding
+ *    the TWDT, so the reset happens through the normal TWDT timeout.
  *
  * @version     0.3
  * @date        2025-10-02
@@ -32,9 +36,22 @@
 #include "esp_task_wdt.h"
 #include "esp_log.h"
 #include "esp_system.h"
+#include "nvs_flash.h"
+#include "hb_supervisor.h"
+#include "stack_profiler.h"
 
 #define TAG "DAY27_WDT"
 
+// Supervisor pass period; must be well below the heartbeat periods and the TWDT timeout
+#define HB_CHECK_PERIOD_MS  100
+
+// Heartbeat period registered by the watched tasks
+#define HB_TASK_PERIOD_MS   1000
+
+// Stack sizes in bytes (ESP-IDF counts FreeRTOS stacks in bytes, not words)
+#define DEMO_TASK_STACK     2048
+#define TINY_TASK_STACK     256
+
 // -----------------------------------------------------------------------------
 // Forward declarations
 // -----------------------------------------------------------------------------
@@ -49,47 +66,50 @@ static void chew_stack_and_work(size_t bytes_to_burn, int iters);
 // -----------------------------------------------------------------------------
 
 /**
- * @brief Healthy task that simulates normal operation and regularly feeds TWDT.
+ * @brief Healthy task that simulates normal operation and checks in regularly.
  *
- * The task is added to the Task WDT watch list and resets (feeds) it every 1000 ms.
- * This represents a well-behaved, responsive task.
+ * The task registers a 1000 ms heartbeat with the supervisor and checks in every
+ * 1000 ms. This represents a well-behaved, responsive task.
  *
  * @param pvParameter Unused task parameter (pass NULL).
  */
 static void healthy_task(void *pvParameter)
 {
-    ESP_ERROR_CHECK(esp_task_wdt_add(NULL));  // watch this task
+    hb_id_t hb;
+    ESP_ERROR_CHECK(hb_supervisor_register("Healthy", HB_TASK_PERIOD_MS, &hb));
     while (1) {
-        ESP_LOGI(TAG, "[Healthy] feeding TWDT");
-        ESP_ERROR_CHECK(esp_task_wdt_reset());
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        ESP_LOGI(TAG, "[Healthy] heartbeat");
+        hb_supervisor_beat(hb);
+        vTaskDelay(pdMS_TO_TICKS(HB_TASK_PERIOD_MS));
     }
 }
 
 /**
- * @brief Stuck task that simulates a deadlock (never feeds the TWDT).
+ * @brief Stuck task that simulates a deadlock (never checks in).
  *
- * The task is added to the Task WDT watch list but intentionally never calls
- * esp_task_wdt_reset(). After the TWDT timeout elapses, the system will panic/reset
- * (depending on configuration).
+ * The task registers a heartbeat but intentionally never calls hb_supervisor_beat().
+ * Once its deadline passes the supervisor stops feeding the TWDT, and after the
+ * TWDT timeout elapses the system will panic/reset (depending on configuration).
  *
  * @param pvParameter Unused task parameter (pass NULL).
  */
 static void stuck_task(void *pvParameter)
 {
-    ESP_ERROR_CHECK(esp_task_wdt_add(NULL));  // watch this task
-    ESP_LOGW(TAG, "[Stuck] will block forever without feeding TWDT...");
+    hb_id_t hb;
+    ESP_ERROR_CHECK(hb_supervisor_register("Stuck", HB_TASK_PERIOD_MS, &hb));
+    ESP_LOGW(TAG, "[Stuck] will block forever without checking in...");
     while (1) {
         // Busy wait to simulate a hard lock (no feeds, no delays)
     }
 }
 
 /**
- * @brief Flaky task that intermittently feeds the TWDT and then skips feeding to trigger it.
+ * @brief Flaky task that checks in irregularly and then stops checking in to trigger the TWDT.
  *
  * Behavior pattern (repeats):
- *  - Phase A: Feed the watchdog 3 times (every 1s).
- *  - Phase B: Intentionally skip feeding for 6s (greater than the 5s timeout).
+ *  - Phase A: Check in 3 times; the last gap is 1.6s, which the supervisor logs as
+ *    a near-miss (late, but inside the 2s deadline).
+ *  - Phase B: Intentionally skip checking in for 6s (deadline plus 5s TWDT timeout).
  *
  * This simulates an intermittent bug where a task sometimes behaves and sometimes stalls.
  *
@@ -97,19 +117,21 @@ static void stuck_task(void *pvParameter)
  */
 static void flaky_task(void *pvParameter)
 {
-    ESP_ERROR_CHECK(esp_task_wdt_add(NULL));  // watch this task
+    hb_id_t hb;
+    ESP_ERROR_CHECK(hb_supervisor_register("Flaky", HB_TASK_PERIOD_MS, &hb));
     int cycle = 0;
 
     while (1) {
-        // Phase A: behave for ~3 seconds
+        // Phase A: behave for ~3.6 seconds, running slow on the last iteration
         for (int i = 0; i < 3; ++i) {
-            ESP_LOGI(TAG, "[Flaky] cycle %d: feeding TWDT (%d/3)", cycle, i + 1);
-            ESP_ERROR_CHECK(esp_task_wdt_reset());
-            vTaskDelay(pdMS_TO_TICKS(1000));
+            ESP_LOGI(TAG, "[Flaky] cycle %d: heartbeat (%d/3)", cycle, i + 1);
+            hb_supervisor_beat(hb);
+            vTaskDelay(pdMS_TO_TICKS(i == 2 ? 1600 : HB_TASK_PERIOD_MS));
         }
+        hb_supervisor_beat(hb);
 
-        // Phase B: misbehave for ~6 seconds (exceeds 5s TWDT timeout)
-        ESP_LOGW(TAG, "[Flaky] cycle %d: simulating stall (>5s) without feeding...", cycle);
+        // Phase B: misbehave for ~6 seconds (exceeds deadline plus 5s TWDT timeout)
+        ESP_LOGW(TAG, "[Flaky] cycle %d: simulating stall (>5s) without checking in...", cycle);
         vTaskDelay(pdMS_TO_TICKS(6000));
 
         // If we are still alive here, either TWDT didn't panic (e.g., trigger_panic=false)
@@ -131,7 +153,7 @@ static void flaky_task(void *pvParameter)
  */
 static void tiny_stack_task(void *pvParameter)
 {
-    // Not adding this task to TWDT; the goal is stack overflow, not watchdog.
+    // Not registering this task; the goal is stack overflow, not watchdog.
     ESP_LOGI(TAG, "[TinyStack] starting with very small stack; will chew stack...");
     while (1) {
         // Burn ~2 KB per call; repeat enough times to exceed the small stack.
@@ -192,6 +214,8 @@ void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
     (void)xTask;
     // Use early logging to increase odds of printing before abort/reset.
     ESP_EARLY_LOGE(TAG, "Stack overflow detected in task: %s", pcTaskName ? pcTaskName : "(unknown)");
+    // Kept in RTC memory across the reset and reported by the stack profiler on the next boot.
+    stack_profiler_note_overflow(pcTaskName);
     esp_system_abort("Stack overflow");
 }
 
@@ -203,11 +227,13 @@ void vApplicationStackOverflowHook(TaskHandle_t xTask, char *pcTaskName)
  * @brief Main application entry: configures TWDT and launches demo tasks.
  *
  * - Configures Task WDT to a 5s timeout, panic on timeout, and monitors idle tasks.
- * - Adds app_main itself to the TWDT watch list (optional but useful for demo).
+ * - Starts the heartbeat supervisor, which feeds the TWDT for all registered tasks.
+ * - Starts the stack profiler, which logs worst-case stack usage from earlier boots
+ *   and recommended stack sizes.
  * - Creates four tasks:
- *     1) Healthy (feeds every 1s)
- *     2) Stuck (never feeds)
- *     3) Flaky (alternates feeding and stalling > timeout)
+ *     1) Healthy (checks in every 1s)
+ *     2) Stuck (never checks in)
+ *     3) Flaky (alternates checking in and stalling > deadline + timeout)
  *     4) TinyStack (very small stack to trigger stack overflow hook)
  */
 void app_main(void)
@@ -227,18 +253,33 @@ void app_main(void)
         ESP_ERROR_CHECK(err);
     }
 
-    // Monitor app_main itself (optional)
-    ESP_ERROR_CHECK(esp_task_wdt_add(NULL));
+    // NVS holds the stack profiler's worst cases across power cycles
+    err = nvs_flash_init();
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        err = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(err);
+
+    stack_profiler_set_stack_size("main", CONFIG_ESP_MAIN_TASK_STACK_SIZE);
+    stack_profiler_set_stack_size("HealthyTask", DEMO_TASK_STACK);
+    stack_profiler_set_stack_size("StuckTask", DEMO_TASK_STACK);
+    stack_profiler_set_stack_size("FlakyTask", DEMO_TASK_STACK);
+    stack_profiler_set_stack_size("TinyStackTask", TINY_TASK_STACK);
+    ESP_ERROR_CHECK(stack_profiler_start());
+
+    // The supervisor is the only application task on the TWDT; the tasks below
+    // register heartbeats with it instead of calling esp_task_wdt_add().
+    ESP_ERROR_CHECK(hb_supervisor_start(HB_CHECK_PERIOD_MS));
 
     // Create demo tasks.
-    // NOTE: Stack sizes are in words (32-bit). 2048 words ≈ 8 KB on Xtensa.
-    xTaskCreate(healthy_task,   "HealthyTask",   2048, NULL, 5, NULL);
-    xTaskCreate(stuck_task,     "StuckTask",     2048, NULL, 5, NULL);
-    xTaskCreate(flaky_task,     "FlakyTask",     2048, NULL, 5, NULL);
+    xTaskCreate(healthy_task,   "HealthyTask",   DEMO_TASK_STACK, NULL, 5, NULL);
+    xTaskCreate(stuck_task,     "StuckTask",     DEMO_TASK_STACK, NULL, 5, NULL);
+    xTaskCreate(flaky_task,     "FlakyTask",     DEMO_TASK_STACK, NULL, 5, NULL);
 
     // Create a tiny-stack task to force a stack overflow.
-    // 256 words ≈ 1 KB; combined with chew_stack_and_work() it should overflow quickly.
-    xTaskCreate(tiny_stack_task, "TinyStackTask", 256,  NULL, 4, NULL);
+    // 256 bytes; combined with chew_stack_and_work() it should overflow quickly.
+    xTaskCreate(tiny_stack_task, "TinyStackTask", TINY_TASK_STACK, NULL, 4, NULL);
 
     ESP_LOGI(TAG, "Tasks started. Expect TWDT events and a stack overflow demo soon.");
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+/**
+ * @file
+ * @brief Microsecond UTC timestamps from esp_timer plus a wall-clock offset
+ *
+ * The service keeps one 64-bit offset between esp_timer (monotonic, counts
+ * from boot) and UTC. A timestamp is esp_timer_get_time() plus that offset, so
+ * reading one costs no system call, no lock and no mutex, and works from an
+ * ISR. The offset is published with a sequence lock: readers retry in the rare
+ * case they overlap an update, writers never block readers.
+ *
+ * The offset is refreshed by timestamp_sync(), to be called whenever the
+ * system clock is set or slewed (for example from an SNTP sync callback).
+ * Between calls the timestamps follow the esp_timer oscillator.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Wall-clock seconds below this (2023-11-14) mean the clock has not been set
+ */
+#define TIMESTAMP_VALID_AFTER_S  1700000000LL
+
+/**
+ * @brief Anchor the service to the current system time
+ *
+ * Call once at startup. After a deep-sleep wake the system time is still
+ * valid, so timestamps are usable at once; on a cold boot they become valid at
+ * the first timestamp_sync() after the clock is set.
+ */
+void timestamp_init(void);
+
+/**
+ * @brief Re-read the system time and publish a new offset
+ *
+ * Call after settimeofday(), after an SNTP sync, and periodically while
+ * adjtime() is slewing the clock. Not for ISR context: it reads the time
+ * with gettimeofday().
+ *
+ * @return
+ *          - ESP_ERR_INVALID_STATE if the system clock is not set yet
+ *          - ESP_OK                on success
+ */
+esp_err_t timestamp_sync(void);
+
+/**
+ * @brief Check whether timestamps refer to real UTC time
+ *
+ * @return true once the offset was taken from a set clock
+ */
+bool timestamp_is_valid(void);
+
+/**
+ * @brief Current UTC time in microseconds since the Unix epoch
+ *
+ * Lock-free and ISR-safe (placed in IRAM). Before the clock is set the value
+ * counts from 1970 plus the time since boot.
+ *
+ * @return UTC time in microseconds
+ */
+int64_t timestamp_now_us(void);
+
+/**
+ * @brief Convert an esp_timer_get_time() value taken earlier to UTC microseconds
+ *
+ * Lets a hot path store only the cheap monotonic value and convert it later,
+ * e.g. when a batch of samples is sent.
+ *
+ * @param[in] mono_us Value returned by esp_timer_get_time()
+ * @return UTC time in microseconds
+ */
+int64_t timestamp_from_mono_us(int64_t mono_us);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,322 @@
+/**
+ * @file
+ * @brief Wi-Fi station with retry, reconnect and power-save profiles
+ */
+
+#include "wifi_sta.h"
+
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "sdkconfig.h"
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "esp_check.h"
+#include "esp_event.h"
+#include "esp_log.h"
+#include "esp_wifi.h"
+
+static const char *TAG = "wifi_sta";
+
+#define CONNECTED_BIT       BIT0
+#define FAIL_BIT            BIT1
+
+/* Default beacon interval of most APs: 100 TU of 1024 us. */
+#define BEACON_INTERVAL_US  102400U
+
+static EventGroupHandle_t s_events;
+static esp_netif_t *s_netif;
+static char s_ssid[33];
+static char s_password[65];
+static wifi_auth_mode_t s_auth_threshold;
+static uint8_t s_max_retries;
+static uint16_t s_listen_interval;
+static uint8_t s_dtim_period;
+static wifi_sta_ps_profile_t s_profile;
+static int s_retry_num;
+static volatile bool s_stopping;
+static bool s_driver_ready;
+static bool s_started;
+static char s_ip_str[16] = "0.0.0.0";
+
+static const char *const PROFILE_NAMES[] = {
+    [WIFI_STA_PS_DEFAULT] = "default",
+    [WIFI_STA_PS_LOW_LATENCY] = "low-latency",
+    [WIFI_STA_PS_BALANCED] = "balanced",
+    [WIFI_STA_PS_LOW_POWER] = "low-power",
+};
+
+static wifi_sta_ps_profile_t default_profile(void)
+{
+#if CONFIG_WIFI_STA_PS_PROFILE_LOW_LATENCY
+    return WIFI_STA_PS_LOW_LATENCY;
+#elif CONFIG_WIFI_STA_PS_PROFILE_LOW_POWER
+    return WIFI_STA_PS_LOW_POWER;
+#else
+    return WIFI_STA_PS_BALANCED;
+#endif
+}
+
+static wifi_ps_type_t ps_mode(wifi_sta_ps_profile_t profile)
+{
+    switch (profile) {
+    case WIFI_STA_PS_LOW_LATENCY:
+        return WIFI_PS_NONE;
+    case WIFI_STA_PS_LOW_POWER:
+        return WIFI_PS_MAX_MODEM;
+    default:
+        return WIFI_PS_MIN_MODEM;
+    }
+}
+
+static void event_handler(void *arg, esp_event_base_t event_base,
+                          int32_t event_id, void *event_data)
+{
+    (void)arg;
+
+    if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) {
+        esp_wifi_connect();
+    } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
+        const wifi_event_sta_disconnected_t *event = event_data;
+        xEventGroupClearBits(s_events, CONNECTED_BIT);
+        strlcpy(s_ip_str, "0.0.0.0", sizeof(s_ip_str));
+
+        // Leaving on our own account (wifi_sta_stop, a reconnect) is not a failure.
+        if (s_stopping || event->reason == WIFI_REASON_ASSOC_LEAVE) {
+            return;
+        }
+        if (s_retry_num < s_max_retries) {
+            s_retry_num++;
+            ESP_LOGW(TAG, "disconnected (reason %d), retry %d/%d",
+                     event->reason, s_retry_num, s_max_retries);
+            esp_wifi_connect();
+        } else {
+            ESP_LOGW(TAG, "connect failed (reason %d)", event->reason);
+            xEventGroupSetBits(s_events, FAIL_BIT);
+        }
+    } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) {
+        const ip_event_got_ip_t *event = event_data;
+        snprintf(s_ip_str, sizeof(s_ip_str), IPSTR, IP2STR(&event->ip_info.ip));
+        ESP_LOGI(TAG, "got ip %s", s_ip_str);
+        s_retry_num = 0;
+        xEventGroupSetBits(s_events, CONNECTED_BIT);
+    }
+}
+
+/**
+ * @brief Initialize the driver after wifi_sta_init() or wifi_sta_deinit()
+ */
+static esp_err_t driver_init(void)
+{
+    if (s_driver_ready) {
+        return ESP_OK;
+    }
+
+    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
+    ESP_RETURN_ON_ERROR(esp_wifi_init(&cfg), TAG, "esp_wifi_init failed");
+
+    // The configuration is set again on every connect; keeping it in flash
+    // would only cost a write per start.
+    esp_wifi_set_storage(WIFI_STORAGE_RAM);
+    ESP_RETURN_ON_ERROR(esp_wifi_set_mode(WIFI_MODE_STA), TAG, "set mode failed");
+    ESP_RETURN_ON_ERROR(esp_wifi_set_ps(ps_mode(s_profile)), TAG, "set power save failed");
+
+    s_driver_ready = true;
+    return ESP_OK;
+}
+
+esp_err_t wifi_sta_init(const wifi_sta_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(config != NULL && config->ssid != NULL, ESP_ERR_INVALID_ARG,
+                        TAG, "missing SSID");
+    ESP_RETURN_ON_FALSE(s_events == NULL, ESP_ERR_INVALID_STATE, TAG, "already initialized");
+
+    strlcpy(s_ssid, config->ssid, sizeof(s_ssid));
+    strlcpy(s_password, (config->password != NULL) ? config->password : "", sizeof(s_password));
+    s_auth_threshold = (config->auth_threshold != WIFI_AUTH_OPEN)
+                       ? config->auth_threshold : WIFI_AUTH_WPA2_PSK;
+    if (s_password[0] == '\0') {
+        s_auth_threshold = WIFI_AUTH_OPEN;
+    }
+    s_max_retries = (config->max_retries != 0) ? config->max_retries : CONFIG_WIFI_STA_MAX_RETRIES;
+
+    // The AP releases buffered broadcasts right after a DTIM beacon; a wake
+    // that falls between two of them would miss ARP requests.
+    s_dtim_period = (config->dtim_period != 0) ? config->dtim_period : CONFIG_WIFI_STA_DTIM_PERIOD;
+    uint16_t listen = (config->listen_interval != 0)
+                      ? config->listen_interval : CONFIG_WIFI_STA_LISTEN_INTERVAL;
+    s_listen_interval = (uint16_t)((listen + s_dtim_period - 1U) / s_dtim_period * s_dtim_period);
+
+    s_profile = (config->ps_profile != WIFI_STA_PS_DEFAULT) ? config->ps_profile : default_profile();
+    ESP_RETURN_ON_FALSE(s_profile <= WIFI_STA_PS_LOW_POWER, ESP_ERR_INVALID_ARG,
+                        TAG, "unknown profile");
+
+    esp_err_t err = esp_netif_init();
+    ESP_RETURN_ON_FALSE(err == ESP_OK || err == ESP_ERR_INVALID_STATE, err, TAG, "esp_netif_init failed");
+    err = esp_event_loop_create_default();
+    ESP_RETURN_ON_FALSE(err == ESP_OK || err == ESP_ERR_INVALID_STATE, err, TAG, "event loop failed");
+
+    s_netif = esp_netif_create_default_wifi_sta();
+    ESP_RETURN_ON_FALSE(s_netif != NULL, ESP_ERR_NO_MEM, TAG, "netif failed");
+
+    s_events = xEventGroupCreate();
+    ESP_RETURN_ON_FALSE(s_events != NULL, ESP_ERR_NO_MEM, TAG, "event group failed");
+
+    ESP_RETURN_ON_ERROR(esp_event_handler_instance_register(WIFI_EVENT, ESP_EVENT_ANY_ID,
+                                                            &event_handler, NULL, NULL),
+                        TAG, "register failed");
+    ESP_RETURN_ON_ERROR(esp_event_handler_instance_register(IP_EVENT, IP_EVENT_STA_GOT_IP,
+                                                            &event_handler, NULL, NULL),
+                        TAG, "register failed");
+
+    ESP_LOGI(TAG, "power save: %s, listen interval %u, DTIM %u",
+             PROFILE_NAMES[s_profile], s_listen_interval, s_dtim_period);
+    return driver_init();
+}
+
+esp_err_t wifi_sta_connect(const wifi_sta_ap_t *ap, TickType_t timeout)
+{
+    ESP_RETURN_ON_FALSE(s_events != NULL, ESP_ERR_INVALID_STATE, TAG, "not initialized");
+    if (wifi_sta_is_connected()) {
+        return ESP_OK;
+    }
+    ESP_RETURN_ON_ERROR(driver_init(), TAG, "driver init failed");
+
+    // A driver that gave up retrying, or is retrying with stale settings,
+    // starts over from a clean state.
+    if (s_started) {
+        s_stopping = true;
+        esp_wifi_stop();
+        s_started = false;
+    }
+
+    wifi_config_t wifi_config = {
+        .sta = {
+            .threshold.authmode = s_auth_threshold,
+            .sae_pwe_h2e = WPA3_SAE_PWE_BOTH,
+            .scan_method = WIFI_FAST_SCAN,
+            // Sent to the AP at association, so later profile switches need
+            // no reconnect. Only WIFI_PS_MAX_MODEM uses it.
+            .listen_interval = s_listen_interval,
+        },
+    };
+    strlcpy((char *)wifi_config.sta.ssid, s_ssid, sizeof(wifi_config.sta.ssid));
+    strlcpy((char *)wifi_config.sta.password, s_password, sizeof(wifi_config.sta.password));
+
+    // With a known BSSID and channel a single channel is probed instead of
+    // all of them.
+    if (ap != NULL) {
+        memcpy(wifi_config.sta.bssid, ap->bssid, sizeof(wifi_config.sta.bssid));
+        wifi_config.sta.bssid_set = true;
+        wifi_config.sta.channel = ap->channel;
+    }
+
+    s_retry_num = 0;
+    s_stopping = false;
+    xEventGroupClearBits(s_events, CONNECTED_BIT | FAIL_BIT);
+
+    ESP_RETURN_ON_ERROR(esp_wifi_set_config(WIFI_IF_STA, &wifi_config), TAG, "set config failed");
+    ESP_RETURN_ON_ERROR(esp_wifi_start(), TAG, "start failed");
+    s_started = true;
+
+    EventBits_t bits = xEventGroupWaitBits(s_events, CONNECTED_BIT | FAIL_BIT,
+                                           pdFALSE, pdFALSE, timeout);
+    if (bits & CONNECTED_BIT) {
+        return ESP_OK;
+    }
+    return (bits & FAIL_BIT) ? ESP_FAIL : ESP_ERR_TIMEOUT;
+}
+
+void wifi_sta_stop(void)
+{
+    if (!s_started) {
+        return;
+    }
+    s_stopping = true;
+    esp_wifi_disconnect();
+    esp_wifi_stop();
+    s_started = false;
+    xEventGroupClearBits(s_events, CONNECTED_BIT);
+    strlcpy(s_ip_str, "0.0.0.0", sizeof(s_ip_str));
+}
+
+void wifi_sta_deinit(void)
+{
+    wifi_sta_stop();
+    if (s_driver_ready) {
+        esp_wifi_deinit();
+        s_driver_ready = false;
+    }
+}
+
+bool wifi_sta_is_connected(void)
+{
+    return (s_events != NULL) && (xEventGroupGetBits(s_events) & CONNECTED_BIT);
+}
+
+esp_netif_t *wifi_sta_get_netif(void)
+{
+    return s_netif;
+}
+
+const char *wifi_sta_get_ip_str(void)
+{
+    return s_ip_str;
+}
+
+esp_err_t wifi_sta_get_ap(wifi_sta_ap_t *ap)
+{
+    wifi_ap_record_t record;
+    if (!s_started || esp_wifi_sta_get_ap_info(&record) != ESP_OK) {
+        return ESP_ERR_WIFI_NOT_CONNECT;
+    }
+    memcpy(ap->bssid, record.bssid, sizeof(ap->bssid));
+    ap->channel = record.primary;
+    return ESP_OK;
+}
+
+esp_err_t wifi_sta_set_ps_profile(wifi_sta_ps_profile_t profile)
+{
+    if (profile == WIFI_STA_PS_DEFAULT) {
+        profile = default_profile();
+    }
+    ESP_RETURN_ON_FALSE(profile <= WIFI_STA_PS_LOW_POWER, ESP_ERR_INVALID_ARG, TAG, "unknown profile");
+
+    if (s_driver_ready) {
+        ESP_RETURN_ON_ERROR(esp_wifi_set_ps(ps_mode(profile)), TAG, "set power save failed");
+    }
+    s_profile = profile;
+    ESP_LOGI(TAG, "power save: %s, inbound delay up to %" PRIu32 " ms",
+             PROFILE_NAMES[profile], wifi_sta_wake_period_ms(profile));
+    return ESP_OK;
+}
+
+wifi_sta_ps_profile_t wifi_sta_get_ps_profile(void)
+{
+    return (s_profile != WIFI_STA_PS_DEFAULT) ? s_profile : default_profile();
+}
+
+const char *wifi_sta_ps_profile_name(wifi_sta_ps_profile_t profile)
+{
+    return (profile <= WIFI_STA_PS_LOW_POWER) ? PROFILE_NAMES[profile] : "?";
+}
+
+uint32_t wifi_sta_wake_period_ms(wifi_sta_ps_profile_t profile)
+{
+    if (profile == WIFI_STA_PS_DEFAULT) {
+        profile = default_profile();
+    }
+    uint8_t dtim = (s_dtim_period != 0) ? s_dtim_period : CONFIG_WIFI_STA_DTIM_PERIOD;
+
+    switch (profile) {
+    case WIFI_STA_PS_LOW_LATENCY:
+        return 0;
+    case WIFI_STA_PS_LOW_POWER: {
+        uint32_t listen = (s_listen_interval != 0) ? s_listen_interval : CONFIG_WIFI_STA_LISTEN_INTERVAL;
+        return listen * BEACON_INTERVAL_US / 1000U;
+    }
+    default:
+        return dtim * BEACON_INTERVAL_US / 1000U;
+    }
+}
@@ -1,114 +1,198 @@
 #include "dht.h"
+#include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
-#include "rom/ets_sys.h"
 
 static const char *TAG = "DHT";
 
+// RMT tick of 1 us, so symbol durations are in microseconds
+#define DHT_RMT_RESOLUTION_HZ 1000000
+
+// Pulses shorter than this are glitches; a line idle for longer ends the capture
+#define DHT_GLITCH_NS         1000
+#define DHT_IDLE_NS           200000
+
+// The response is 80 us low then 80 us high; data bits are 50 us low then
+// 26-28 us high for a 0 or 70 us high for a 1
+#define DHT_RESPONSE_MIN_US   60
+#define DHT_BIT_ONE_MIN_US    48
+#define DHT_BIT_LOW_MAX_US    100
+
+// Maximum time for the 40 bits to arrive after the start signal
+#define DHT_FRAME_TIMEOUT_MS  10
+
+/**
+ * @brief RMT receive-done callback, called from the RMT interrupt when the line has been idle
+ *        for DHT_IDLE_NS. Passes the captured symbols to the reading task.
+ *
+ * @param channel RMT channel that finished receiving
+ * @param edata Received symbols
+ * @param user_ctx Queue of the DHT sensor
+ * @return true if a higher-priority task was woken
+ */
+static bool dht_rx_done_callback(rmt_channel_handle_t channel, const rmt_rx_done_event_data_t *edata,
+                                 void *user_ctx)
+{
+    BaseType_t high_task_wakeup = pdFALSE;
+    xQueueSendFromISR((QueueHandle_t)user_ctx, edata, &high_task_wakeup);
+    return high_task_wakeup == pdTRUE;
+}
+
 /**
- * @brief Initialize the DHT sensor with the specified GPIO pin and sensor type. 
- *        This function sets up the sensor structure with the provided configuration and 
- *        prepares it for reading data. The GPIO pin will be used to 
- * 
- * @param sensor Pointer to the DHT sensor structure to be initialized 
- * @param gpio_num The GPIO pin number to which the DHT sensor is connected 
- * @param type The type of DHT sensor (e.g., DHT11, DHT22) to be initialized 
- * @return esp_err_t ESP_OK on successful initialization, or an appropriate error code on failure 
+ * @brief Initialize the DHT sensor with the specified GPIO pin and sensor type.
+ *        This function sets up an RMT receive channel on the data pin, so the pulse train of a
+ *        reading is captured in hardware, and configures the pin as an open-drain output with
+ *        pull-up for the start signal.
+ *
+ * @param sensor Pointer to the DHT sensor structure to be initialized
+ * @param gpio_num The GPIO pin number to which the DHT sensor is connected
+ * @param type The type of DHT sensor (e.g., DHT11, DHT22) to be initialized
+ * @return esp_err_t ESP_OK on successful initialization, or an appropriate error code on failure
  */
 esp_err_t dht_init(dht_sensor_t *sensor, gpio_num_t gpio_num, int type) {
+    memset(sensor, 0, sizeof(*sensor));
     sensor->gpio_num = gpio_num;
     sensor->type = type;
+
+    sensor->rx_done_queue = xQueueCreate(1, sizeof(rmt_rx_done_event_data_t));
+    if (sensor->rx_done_queue == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    rmt_rx_channel_config_t rx_config = {
+        .gpio_num = gpio_num,
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = DHT_RMT_RESOLUTION_HZ,
+        .mem_block_symbols = DHT_RMT_SYMBOLS,
+    };
+    esp_err_t err = rmt_new_rx_channel(&rx_config, &sensor->rx_channel);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to create RMT RX channel: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    rmt_rx_event_callbacks_t callbacks = {
+        .on_recv_done = dht_rx_done_callback,
+    };
+    err = rmt_rx_register_event_callbacks(sensor->rx_channel, &callbacks, sensor->rx_done_queue);
+    if (err == ESP_OK) {
+        err = rmt_enable(sensor->rx_channel);
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    // The RMT input stays connected while the pin drives the start signal as open drain.
+    gpio_set_direction(gpio_num, GPIO_MODE_INPUT_OUTPUT_OD);
+    gpio_set_pull_mode(gpio_num, GPIO_PULLUP_ONLY);
+    gpio_set_level(gpio_num, 1);
     return ESP_OK;
 }
 
 /**
- * @brief Wait for the specified GPIO pin to reach the desired state (HIGH or LOW) within a given timeout period. 
- * 
- * @param pin The GPIO pin number to monitor for the specified state 
- * @param state The desired state to wait for (0 for LOW, 1 for HIGH) 
- * @param timeout_us The maximum time to wait for the pin to reach the desired state, in microseconds 
- * @return esp_err_t ESP_OK if the pin reaches the desired state within the timeout, 
- *         or ESP_ERR_TIMEOUT if the timeout is exceeded without reaching the state 
+ * @brief Flatten RMT symbols into alternating pulses and decode the 40 data bits. The response
+ *        (a low and a high pulse of at least DHT_RESPONSE_MIN_US each) marks the start; each of
+ *        the next 40 low/high pairs is one bit, a 1 when the high pulse is long.
+ *
+ * @param symbols Captured RMT symbols
+ * @param num_symbols Number of captured symbols
+ * @param data Receives the 5 data bytes
+ * @return esp_err_t ESP_OK if 40 bits were decoded, or ESP_ERR_INVALID_RESPONSE
  */
-static esp_err_t dht_await_pin_state(gpio_num_t pin, int state, int timeout_us) {
-    int elapsed = 0;
-    while (gpio_get_level(pin) != state) {
-        if (elapsed > timeout_us) {
-            return ESP_ERR_TIMEOUT;
+static esp_err_t dht_decode(const rmt_symbol_word_t *symbols, size_t num_symbols, uint8_t data[5]) {
+    // Each symbol holds two pulses; a zero duration marks the end of the capture.
+    uint16_t durations[DHT_RMT_SYMBOLS * 2];
+    uint8_t levels[DHT_RMT_SYMBOLS * 2];
+    size_t num_pulses = 0;
+    for (size_t i = 0; i < num_symbols; i++) {
+        durations[num_pulses] = symbols[i].duration0;
+        levels[num_pulses++] = symbols[i].level0;
+        durations[num_pulses] = symbols[i].duration1;
+        levels[num_pulses++] = symbols[i].level1;
+    }
+
+    size_t p = 0;
+    while (p + 1 < num_pulses &&
+           !(levels[p] == 0 && durations[p] >= DHT_RESPONSE_MIN_US &&
+             levels[p + 1] == 1 && durations[p + 1] >= DHT_RESPONSE_MIN_US)) {
+        p++;
+    }
+    p += 2;
+    if (p + 80 > num_pulses) {
+        ESP_LOGE(TAG, "Incomplete frame: %u pulses", (unsigned)num_pulses);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    memset(data, 0, 5);
+    for (int i = 0; i < 40; i++, p += 2) {
+        if (levels[p] != 0 || levels[p + 1] != 1 || durations[p] > DHT_BIT_LOW_MAX_US ||
+            durations[p + 1] == 0) {
+            ESP_LOGE(TAG, "Malformed bit %d", i);
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+        if (durations[p + 1] >= DHT_BIT_ONE_MIN_US) {
+            data[i / 8] |= (1 << (7 - (i % 8)));
         }
-        ets_delay_us(1);
-        elapsed++;
     }
     return ESP_OK;
 }
 
 /**
- * @brief Read temperature and humidity data from the DHT sensor. This function sends the start signal 
- *        to the sensor, waits for the response, and then reads the 40 bits of data representing humidity 
- *        and temperature. It also verifies the checksum to ensure data integrity before parsing the values 
- *        based on the sensor type (DHT11 or DHT22). The read values are returned through the provided pointers. 
- * 
- * @param sensor Pointer to the DHT sensor structure containing the GPIO pin and sensor type information 
- * @param temperature Pointer to a float variable where the read temperature value will be stored 
- * @param humidity Pointer to a float variable where the read humidity value will be stored 
- * @return esp_err_t ESP_OK if the reading is successful and the checksum is valid, or an appropriate error 
- *                   code on failure (e.g., timeout, checksum failure) 
+ * @brief Read temperature and humidity data from the DHT sensor. This function sends the start signal
+ *        to the sensor and lets the RMT peripheral capture the response and the 40 data bits, so the
+ *        CPU is free (and interrupts may run) during the transfer. The pulse widths are decoded
+ *        afterwards and the checksum is verified before parsing the values based on the sensor
+ *        type (DHT11 or DHT22). The read values are returned through the provided pointers.
+ *
+ * @param sensor Pointer to the DHT sensor structure containing the GPIO pin and sensor type information
+ * @param temperature Pointer to a float variable where the read temperature value will be stored
+ * @param humidity Pointer to a float variable where the read humidity value will be stored
+ * @return esp_err_t ESP_OK if the reading is successful and the checksum is valid, or an appropriate error
+ *                   code on failure (e.g., timeout, checksum failure)
  */
 esp_err_t dht_read(dht_sensor_t *sensor, float *temperature, float *humidity) {
     uint8_t data[5] = {0};
-    int bit_idx = 0;
-    
+    rmt_rx_done_event_data_t rx_data;
+
     // Send start signal
-    gpio_set_direction(sensor->gpio_num, GPIO_MODE_OUTPUT);
     gpio_set_level(sensor->gpio_num, 0);
     vTaskDelay(pdMS_TO_TICKS(20));
+
+    // Arm the receiver, then release the line; the sensor answers about 30 us later
+    rmt_receive_config_t rx_config = {
+        .signal_range_min_ns = DHT_GLITCH_NS,
+        .signal_range_max_ns = DHT_IDLE_NS,
+    };
+    xQueueReset(sensor->rx_done_queue);
+    esp_err_t err = rmt_receive(sensor->rx_channel, sensor->symbols, sizeof(sensor->symbols), &rx_config);
     gpio_set_level(sensor->gpio_num, 1);
-    ets_delay_us(40);
-    
-    // Switch to input mode
-    gpio_set_direction(sensor->gpio_num, GPIO_MODE_INPUT);
-    
-    // Wait for DHT response
-    if (dht_await_pin_state(sensor->gpio_num, 0, 80) != ESP_OK) {
-        ESP_LOGE(TAG, "Timeout waiting for DHT response LOW");
-        return ESP_ERR_TIMEOUT;
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start RMT receive: %s", esp_err_to_name(err));
+        return err;
     }
-    if (dht_await_pin_state(sensor->gpio_num, 1, 80) != ESP_OK) {
-        ESP_LOGE(TAG, "Timeout waiting for DHT response HIGH");
-        return ESP_ERR_TIMEOUT;
-    }
-    if (dht_await_pin_state(sensor->gpio_num, 0, 80) != ESP_OK) {
-        ESP_LOGE(TAG, "Timeout waiting for DHT data start");
+
+    // Wait for the capture to end
+    if (xQueueReceive(sensor->rx_done_queue, &rx_data, pdMS_TO_TICKS(DHT_FRAME_TIMEOUT_MS) + 1) != pdTRUE) {
+        ESP_LOGE(TAG, "Timeout waiting for DHT data");
+        // Restart the channel so the pending receive does not block the next reading.
+        rmt_disable(sensor->rx_channel);
+        rmt_enable(sensor->rx_channel);
         return ESP_ERR_TIMEOUT;
     }
-    
-    // Read 40 bits of data
-    for (int i = 0; i < 40; i++) {
-        if (dht_await_pin_state(sensor->gpio_num, 1, 50) != ESP_OK) {
-            ESP_LOGE(TAG, "Timeout waiting for bit start");
-            return ESP_ERR_TIMEOUT;
-        }
-        
-        ets_delay_us(30);
-        
-        if (gpio_get_level(sensor->gpio_num) == 1) {
-            data[i / 8] |= (1 << (7 - (i % 8)));
-        }
-        
-        if (dht_await_pin_state(sensor->gpio_num, 0, 50) != ESP_OK) {
-            ESP_LOGE(TAG, "Timeout waiting for bit end");
-            return ESP_ERR_TIMEOUT;
-        }
+
+    err = dht_decode(rx_data.received_symbols, rx_data.num_symbols, data);
+    if (err != ESP_OK) {
+        return err;
     }
-    
+
     // Verify checksum
     uint8_t checksum = data[0] + data[1] + data[2] + data[3];
     if (checksum != data[4]) {
         ESP_LOGE(TAG, "Checksum failed: calculated=0x%02x, received=0x%02x", checksum, data[4]);
         return ESP_ERR_INVALID_CRC;
     }
-    
+
     // Parse data based on sensor type
     if (sensor->type == DHT_TYPE_DHT11) {
         *humidity = data[0];
@@ -120,7 +204,7 @@ esp_err_t dht_read(dht_sensor_t *sensor, float *temperature, float *humidity) {
             *temperature = -*temperature;
         }
     }
-    
+
     ESP_LOGI(TAG, "Temperature: %.1f°C, Humidity: %.1f%%", *temperature, *humidity);
     return ESP_OK;
-}
\ No newline at end of file
+}
@@ -2,17 +2,26 @@
 #define DHT_H
 
 #include "driver/gpio.h"
+#include "driver/rmt_rx.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
 #include "esp_err.h"
 
 #define DHT_TYPE_DHT11 0
 #define DHT_TYPE_DHT22 1
 
+// RMT symbols captured per reading: start pulse, response, 40 bits and the end pulse need 43
+#define DHT_RMT_SYMBOLS 64
+
 typedef struct {
     gpio_num_t gpio_num;
     int type;
+    rmt_channel_handle_t rx_channel;
+    QueueHandle_t rx_done_queue;
+    rmt_symbol_word_t symbols[DHT_RMT_SYMBOLS];
 } dht_sensor_t;
 
 esp_err_t dht_init(dht_sensor_t *sensor, gpio_num_t gpio_num, int type);
 esp_err_t dht_read(dht_sensor_t *sensor, float *temperature, float *humidity);
 
-#endif // DHT_H
\ No newline at end of file
+#endif // DHT_H
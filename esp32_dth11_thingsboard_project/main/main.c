@@ -1,15 +1,23 @@
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
+#include <sys/time.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
 #include "esp_system.h"
-#include "esp_wifi.h"
+#include "esp_sleep.h"
+#include "esp_attr.h"
+#include "esp_timer.h"
 #include "esp_event.h"
 #include "esp_log.h"
 #include "nvs_flash.h"
+#include "esp_netif_sntp.h"
 #include "mqtt_client.h"
 #include "dht.h"
+#include "telemetry_buffer.h"
+#include "timestamp.h"
+#include "wifi_sta.h"
 
 // WiFi Configuration
 #define WIFI_SSID      "YOUR_WIFI_SSID"
@@ -28,123 +36,110 @@
 // Reading interval in seconds
 #define READING_INTERVAL_SEC 10
 
+// Telemetry batching: readings are published together once this many are
+// buffered, or when the oldest has waited TELEMETRY_FLUSH_SEC
+#define TELEMETRY_BATCH_SIZE 6
+#define TELEMETRY_FLUSH_SEC  60
+
+// NTP server used to timestamp readings
+#define SNTP_SERVER "pool.ntp.org"
+
+// Node mode: 0 keeps Wi-Fi and MQTT connected between readings; 1 deep-sleeps
+// between readings and only connects when a batch is due (battery nodes)
+#define NODE_DEEP_SLEEP 0
+
+// Deep-sleep mode limits for each connection phase; a node that misses one
+// keeps its readings and tries again at the next due batch
+#define WIFI_CONNECT_TIMEOUT_MS 5000
+#define MQTT_CONNECT_TIMEOUT_MS 5000
+#define PUBLISH_ACK_TIMEOUT_MS  3000
+#define SNTP_SYNC_TIMEOUT_MS    3000
+
 static const char *TAG = "MAIN";
 
-static EventGroupHandle_t s_wifi_event_group;
-static int s_retry_num = 0;
+static EventGroupHandle_t s_mqtt_event_group;
 static esp_mqtt_client_handle_t mqtt_client = NULL;
 static dht_sensor_t dht_sensor;
 
-#define WIFI_CONNECTED_BIT BIT0
-#define WIFI_FAIL_BIT      BIT1
-#define MQTT_CONNECTED_BIT BIT2
+#define MQTT_CONNECTED_BIT BIT0
 
-/**
- * @brief WiFi event handler to manage connection and disconnection events 
- * 
- * @param arg User-defined argument (not used in this case)   
- * @param event_base Event base for the WiFi events 
- * @param event_id ID of the WiFi event (e.g., start, disconnected) 
- * @param event_data Data associated with the WiFi event (e.g., connection details, error information) 
- */
-static void wifi_event_handler(void* arg, esp_event_base_t event_base,
-                                int32_t event_id, void* event_data)
-{
-    if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_START) {
-        esp_wifi_connect();
-    } else if (event_base == WIFI_EVENT && event_id == WIFI_EVENT_STA_DISCONNECTED) {
-        if (s_retry_num < WIFI_MAX_RETRY) {
-            esp_wifi_connect();
-            s_retry_num++;
-            ESP_LOGI(TAG, "Retry to connect to the AP");
-        } else {
-            xEventGroupSetBits(s_wifi_event_group, WIFI_FAIL_BIT);
-        }
-        ESP_LOGI(TAG,"Connect to the AP fail");
-    } else if (event_base == IP_EVENT && event_id == IP_EVENT_STA_GOT_IP) {
-        ip_event_got_ip_t* event = (ip_event_got_ip_t*) event_data;
-        ESP_LOGI(TAG, "Got IP:" IPSTR, IP2STR(&event->ip_info.ip));
-        s_retry_num = 0;
-        xEventGroupSetBits(s_wifi_event_group, WIFI_CONNECTED_BIT);
-    }
-}
+#if NODE_DEEP_SLEEP
+// Access point of the last successful connection, kept across deep sleep so the
+// next radio wake can join it without a full channel scan
+#define WIFI_CACHE_MAGIC 0x57494649u
+
+typedef struct {
+    uint32_t magic;
+    uint8_t bssid[6];
+    uint8_t channel;
+} wifi_cache_t;
+
+static RTC_DATA_ATTR wifi_cache_t s_wifi_cache;
+static RTC_DATA_ATTR uint32_t s_wake_count;
+#endif
 
 /**
  * @brief Initialize WiFi in station mode and connect to the specified SSID and password 
  * 
+ * Retries, reconnects and modem sleep are handled by the wifi_sta component. Every 
+ * message of this node is sent by the node itself (publishes, keepalives), so the 
+ * low-power profile from sdkconfig.defaults costs little latency: the radio stays 
+ * awake briefly after each transmission for the broker's answer.
+ * 
+ * @param timeout Maximum time to wait for an IP address 
+ * @return esp_err_t ESP_OK when connected, ESP_FAIL when the retries ran out, or ESP_ERR_TIMEOUT 
  */
-static esp_err_t wifi_init_sta(void)
+static esp_err_t wifi_init_sta(TickType_t timeout)
 {
-    // Create an event group to manage WiFi connection events and states. This allows the main 
-    // application to wait for specific events (e.g., connected, failed) before proceeding with MQTT initialization.
-    s_wifi_event_group = xEventGroupCreate();
-
-    // Initialize the TCP/IP stack and the default event loop, and create a default WiFi station network interface.
-    ESP_ERROR_CHECK(esp_netif_init());
-    ESP_ERROR_CHECK(esp_event_loop_create_default());
-    esp_netif_create_default_wifi_sta();
-
-    // Configure WiFi initialization settings and initialize the WiFi driver with the specified configuration.
-    wifi_init_config_t cfg = WIFI_INIT_CONFIG_DEFAULT();
-    ESP_ERROR_CHECK(esp_wifi_init(&cfg));
-
-    // Register event handlers for WiFi and IP events to manage connection status 
-    // and handle IP acquisition.
-    esp_event_handler_instance_t instance_any_id;
-    esp_event_handler_instance_t instance_got_ip;
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(WIFI_EVENT,
-                                                        ESP_EVENT_ANY_ID,
-                                                        &wifi_event_handler,
-                                                        NULL,
-                                                        &instance_any_id));
-    ESP_ERROR_CHECK(esp_event_handler_instance_register(IP_EVENT,
-                                                        IP_EVENT_STA_GOT_IP,
-                                                        &wifi_event_handler,
-                                                        NULL,
-                                                        &instance_got_ip));
-
-    // Configure WiFi connection settings (SSID and password) and set the 
-    // authentication mode to WPA2-PSK.
-    wifi_config_t wifi_config = {
-        .sta = {
-            .ssid = WIFI_SSID,
-            .password = WIFI_PASS,
-            .threshold.authmode = WIFI_AUTH_WPA2_PSK,
-        },
+    // Event group for the MQTT connection state, set from the MQTT event handler.
+    s_mqtt_event_group = xEventGroupCreate();
+
+    const wifi_sta_config_t wifi_config = {
+        .ssid = WIFI_SSID,
+        .password = WIFI_PASS,
+        .max_retries = WIFI_MAX_RETRY,
     };
-    ESP_ERROR_CHECK(esp_wifi_set_mode(WIFI_MODE_STA));
-    
-    // Set WiFi configuration and connect to the AP using the specified SSID and password. 
-    // This will trigger the WiFi event handler to manage the connection
-    ESP_ERROR_CHECK(esp_wifi_set_config(WIFI_IF_STA, &wifi_config));
-    
-    // Start WiFi and wait for connection
-    ESP_ERROR_CHECK(esp_wifi_start());
+    ESP_ERROR_CHECK(wifi_sta_init(&wifi_config));
+
+    const wifi_sta_ap_t *ap = NULL;
+#if NODE_DEEP_SLEEP
+    // Join the cached AP on its channel directly instead of scanning.
+    wifi_sta_ap_t cached;
+    if (s_wifi_cache.magic == WIFI_CACHE_MAGIC) {
+        memcpy(cached.bssid, s_wifi_cache.bssid, sizeof(cached.bssid));
+        cached.channel = s_wifi_cache.channel;
+        ap = &cached;
+    }
+#endif
 
     ESP_LOGI(TAG, "wifi_init_sta finished.");
 
-    // Wait for the connection to the AP to be established or failed, and set the 
-    // appropriate event bits based on the outcome. This allows the main application to 
-    // proceed with MQTT initialization only after a successful Wi
-    EventBits_t bits = xEventGroupWaitBits(s_wifi_event_group,
-            WIFI_CONNECTED_BIT | WIFI_FAIL_BIT,
-            pdFALSE,
-            pdFALSE,
-            portMAX_DELAY);
-
-    // Check the event bits to determine if the connection was successful or if it failed, 
-    // and log the appropriate message. This provides feedback on the WiFi connection status 
-    // and allows for troubleshooting if needed.
-    if (bits & WIFI_CONNECTED_BIT) {
+    // Wait for the connection to the AP to be established or failed. This allows the main 
+    // application to proceed with MQTT initialization only after a successful WiFi connection.
+    esp_err_t err = wifi_sta_connect(ap, timeout);
+    if (err == ESP_OK) {
         ESP_LOGI(TAG, "Connected to AP SSID:%s", WIFI_SSID);
+#if NODE_DEEP_SLEEP
+        wifi_sta_ap_t joined;
+        if (wifi_sta_get_ap(&joined) == ESP_OK) {
+            memcpy(s_wifi_cache.bssid, joined.bssid, sizeof(s_wifi_cache.bssid));
+            s_wifi_cache.channel = joined.channel;
+            s_wifi_cache.magic = WIFI_CACHE_MAGIC;
+        }
+#endif
         return ESP_OK;
-    } else if (bits & WIFI_FAIL_BIT) {
+    }
+
+#if NODE_DEEP_SLEEP
+    // The AP may have moved to another channel; scan again next time.
+    s_wifi_cache.magic = 0;
+#endif
+    if (err == ESP_FAIL) {
         ESP_LOGI(TAG, "Failed to connect to SSID:%s", WIFI_SSID);
-        return ESP_FAIL;
     } else {
-        ESP_LOGE(TAG, "UNEXPECTED EVENT");
-        return ESP_FAIL;
+        ESP_LOGE(TAG, "Timeout connecting to SSID:%s", WIFI_SSID);
     }
+    return err;
 }
 
 /**
@@ -164,13 +159,13 @@ static void mqtt_event_handler(void *handler_args, esp_event_base_t base, int32_
         // connected to the MQTT broker. This allows the sensor task to start publishing telemetry data.
         case MQTT_EVENT_CONNECTED:
             ESP_LOGI(TAG, "MQTT_EVENT_CONNECTED");
-            xEventGroupSetBits(s_wifi_event_group, MQTT_CONNECTED_BIT);
+            xEventGroupSetBits(s_mqtt_event_group, MQTT_CONNECTED_BIT);
             break;
         // Clear MQTT_CONNECTED_BIT on disconnection to indicate that the client is no longer 
         // connected to the MQTT broker. This allows the sensor task to
         case MQTT_EVENT_DISCONNECTED:
             ESP_LOGI(TAG, "MQTT_EVENT_DISCONNECTED");
-            xEventGroupClearBits(s_wifi_event_group, MQTT_CONNECTED_BIT);
+            xEventGroupClearBits(s_mqtt_event_group, MQTT_CONNECTED_BIT);
             break;
         // Handle other MQTT events as needed (e.g., published, subscribed, data received)
         case MQTT_EVENT_ERROR:
@@ -195,6 +190,11 @@ static void mqtt_init(void)
     esp_mqtt_client_config_t mqtt_cfg = {
         .broker.address.uri = uri,
         .credentials.username = THINGSBOARD_TOKEN,
+#if NODE_DEEP_SLEEP
+        // Persistent session: the broker keeps the session under the client ID
+        // (derived from the MAC) while the node sleeps, so reconnects resume it
+        .session.disable_clean_session = true,
+#endif
     };
     mqtt_client = esp_mqtt_client_init(&mqtt_cfg);
     
@@ -208,36 +208,31 @@ static void mqtt_init(void)
 }
 
 /**
- * @brief Publish the temperature and humidity telemetry data to ThingsBoard using MQTT 
+ * @brief SNTP sync callback: re-anchor the timestamp service to the clock just set
  * 
- * @param temperature The temperature value to be published 
- * @param humidity The humidity value to be published 
+ * @param tv Time received from the server
  */
-static void publish_telemetry(float temperature, float humidity)
+static void sntp_sync_cb(struct timeval *tv)
 {
-    char payload[128];
+    timestamp_sync();
+}
 
-    // Create JSON payload with temperature and humidity values
-    snprintf(payload, sizeof(payload), 
-             "{\"temperature\":%.1f,\"humidity\":%.1f}", 
-             temperature, humidity);
-    
-    // Publish telemetry data to ThingsBoard
-    int msg_id = esp_mqtt_client_publish(mqtt_client, 
-                                         "v1/devices/me/telemetry", 
-                                         payload, 
-                                         0, 
-                                         1, 
-                                         0);
-    if (msg_id > 0) {
-        ESP_LOGI(TAG, "Published telemetry: %s", payload);
-    } else {
-        ESP_LOGE(TAG, "Failed to publish telemetry");
-    }
+/**
+ * @brief Start the SNTP client so readings can be stamped with the wall-clock time
+ * 
+ */
+static void sntp_start(void)
+{
+    esp_sntp_config_t sntp_config = ESP_NETIF_SNTP_DEFAULT_CONFIG(SNTP_SERVER);
+    sntp_config.sync_cb = sntp_sync_cb;
+    esp_netif_sntp_init(&sntp_config);
 }
 
+#if !NODE_DEEP_SLEEP
 /**
- * @brief Task to read temperature and humidity from the DHT sensor at regular intervals, 
+ * @brief Task to read temperature and humidity from the DHT sensor at regular intervals
+ *        and hand the readings to the telemetry buffer. Readings are taken whether or not
+ *        MQTT is connected; the buffer publishes them in batches or keeps them in flash.
  * 
  * @param pvParameters 
  */
@@ -247,29 +242,135 @@ static void sensor_task(void *pvParameters)
     float humidity = 0.0;
     
     while (1) {
-        // Wait for MQTT connection
-        EventBits_t bits = xEventGroupWaitBits(s_wifi_event_group,
-                                                MQTT_CONNECTED_BIT,
-                                                pdFALSE,
-                                                pdFALSE,
-                                                portMAX_DELAY);
+        // Read data from DHT sensor
+        esp_err_t result = dht_read(&dht_sensor, &temperature, &humidity);
         
-        // If MQTT is connected, read sensor data and publish telemetry
-        if (bits & MQTT_CONNECTED_BIT) {
-            // Read data from DHT sensor
-            esp_err_t result = dht_read(&dht_sensor, &temperature, &humidity);
-            
-            // If reading is successful, publish telemetry to ThingsBoard
-            if (result == ESP_OK) {
-                publish_telemetry(temperature, humidity);
-            } else {
-                ESP_LOGE(TAG, "Failed to read DHT sensor: %s", esp_err_to_name(result));
-            }
+        // If reading is successful, add it to the telemetry buffer
+        if (result == ESP_OK) {
+            telemetry_buffer_add(temperature, humidity);
+        } else {
+            ESP_LOGE(TAG, "Failed to read DHT sensor: %s", esp_err_to_name(result));
+        }
+
+        // Flush a full or aged batch, and drain readings queued during an outage
+        // as soon as the broker is reachable again
+        bool connected = (xEventGroupGetBits(s_mqtt_event_group) & MQTT_CONNECTED_BIT) != 0;
+        if (telemetry_buffer_flush_due() || (connected && telemetry_buffer_queued() > 0)) {
+            telemetry_buffer_flush(mqtt_client, connected);
         }
         
         vTaskDelay(pdMS_TO_TICKS(READING_INTERVAL_SEC * 1000));
     }
 }
+#endif
+
+#if NODE_DEEP_SLEEP
+/**
+ * @brief Wait until the broker has acknowledged every QoS 1 message in the MQTT outbox 
+ * 
+ * @param timeout_ms Maximum time to wait 
+ * @return true if the outbox is empty 
+ */
+static bool mqtt_wait_outbox_empty(uint32_t timeout_ms)
+{
+    int64_t deadline_us = esp_timer_get_time() + (int64_t)timeout_ms * 1000;
+    while (esp_mqtt_client_get_outbox_size(mqtt_client) > 0) {
+        if (esp_timer_get_time() >= deadline_us) {
+            return false;
+        }
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+    return true;
+}
+
+/**
+ * @brief Log how long each phase of this wake took, then deep-sleep until the next reading. 
+ *        The sleep time is shortened by the time spent awake so readings stay on schedule. 
+ * 
+ * @param read_ms Time spent reading the sensor 
+ * @param wifi_ms Wi-Fi connect time, 0 if the radio stayed off 
+ * @param mqtt_ms MQTT connect time 
+ * @param publish_ms Publish and acknowledgement time 
+ */
+static void node_sleep(uint32_t read_ms, uint32_t wifi_ms, uint32_t mqtt_ms, uint32_t publish_ms)
+{
+    uint32_t awake_ms = (uint32_t)(esp_timer_get_time() / 1000);
+    ESP_LOGI(TAG, "Wake %lu: read %lu ms, wifi %lu ms, mqtt %lu ms, publish %lu ms, awake %lu ms",
+             (unsigned long)s_wake_count, (unsigned long)read_ms, (unsigned long)wifi_ms,
+             (unsigned long)mqtt_ms, (unsigned long)publish_ms, (unsigned long)awake_ms);
+
+    uint64_t interval_ms = (uint64_t)READING_INTERVAL_SEC * 1000;
+    uint64_t sleep_ms = (awake_ms < interval_ms) ? interval_ms - awake_ms : 1000;
+    esp_sleep_enable_timer_wakeup(sleep_ms * 1000);
+    esp_deep_sleep_start();
+}
+
+/**
+ * @brief One deep-sleep node cycle: read the sensor, and when a batch is due connect Wi-Fi 
+ *        (cached AP), resume the MQTT session, publish and wait for the acknowledgements. 
+ *        Every path ends in deep sleep; readings that could not be sent stay buffered 
+ *        in RTC memory or queued in flash. 
+ * 
+ */
+static void node_run_cycle(void)
+{
+    s_wake_count++;
+
+    // Read the sensor and buffer the reading
+    int64_t t0 = esp_timer_get_time();
+    float temperature = 0.0;
+    float humidity = 0.0;
+    esp_err_t result = dht_read(&dht_sensor, &temperature, &humidity);
+    if (result == ESP_OK) {
+        telemetry_buffer_add(temperature, humidity);
+    } else {
+        ESP_LOGE(TAG, "Failed to read DHT sensor: %s", esp_err_to_name(result));
+    }
+    uint32_t read_ms = (uint32_t)((esp_timer_get_time() - t0) / 1000);
+
+    // Most wakes end here without turning the radio on
+    if (!telemetry_buffer_flush_due()) {
+        node_sleep(read_ms, 0, 0, 0);
+    }
+
+    // Connect Wi-Fi, using the AP cached in RTC memory
+    t0 = esp_timer_get_time();
+    esp_err_t err = wifi_init_sta(pdMS_TO_TICKS(WIFI_CONNECT_TIMEOUT_MS));
+    uint32_t wifi_ms = (uint32_t)((esp_timer_get_time() - t0) / 1000);
+    if (err != ESP_OK) {
+        telemetry_buffer_flush(NULL, false);
+        wifi_sta_stop();
+        node_sleep(read_ms, wifi_ms, 0, 0);
+    }
+
+    // The system time survives deep sleep; only block on SNTP until it was set once
+    sntp_start();
+    if (!timestamp_is_valid()) {
+        esp_netif_sntp_sync_wait(pdMS_TO_TICKS(SNTP_SYNC_TIMEOUT_MS));
+    }
+
+    // Resume the persistent MQTT session
+    t0 = esp_timer_get_time();
+    mqtt_init();
+    EventBits_t bits = xEventGroupWaitBits(s_mqtt_event_group, MQTT_CONNECTED_BIT, pdFALSE, pdFALSE,
+                                           pdMS_TO_TICKS(MQTT_CONNECT_TIMEOUT_MS));
+    uint32_t mqtt_ms = (uint32_t)((esp_timer_get_time() - t0) / 1000);
+
+    // Publish with QoS 1 and wait for the PUBACKs before the connection is cut
+    t0 = esp_timer_get_time();
+    bool connected = (bits & MQTT_CONNECTED_BIT) != 0;
+    telemetry_buffer_flush(mqtt_client, connected);
+    if (connected && !mqtt_wait_outbox_empty(PUBLISH_ACK_TIMEOUT_MS)) {
+        ESP_LOGW(TAG, "Not all publishes were acknowledged before sleep");
+    }
+    uint32_t publish_ms = (uint32_t)((esp_timer_get_time() - t0) / 1000);
+
+    esp_mqtt_client_disconnect(mqtt_client);
+    esp_mqtt_client_stop(mqtt_client);
+    wifi_sta_stop();
+    node_sleep(read_ms, wifi_ms, mqtt_ms, publish_ms);
+}
+#endif
 
 /**
  * @brief Main application entry point: initializes NVS, WiFi, MQTT, and starts the sensor reading task 
@@ -287,18 +388,31 @@ void app_main(void)
     }
     ESP_ERROR_CHECK(ret);
     
+    // Anchor the timestamps; after a deep-sleep wake the clock is already set
+    timestamp_init();
+    
     // Initialize DHT sensor
     ESP_LOGI(TAG, "Initializing DHT sensor on GPIO %d", DHT_GPIO);
-    dht_init(&dht_sensor, DHT_GPIO, DHT_TYPE);
+    ESP_ERROR_CHECK(dht_init(&dht_sensor, DHT_GPIO, DHT_TYPE));
     
+    // Initialize the telemetry buffer and reload readings queued before a reboot
+    ESP_ERROR_CHECK(telemetry_buffer_init(TELEMETRY_BATCH_SIZE, TELEMETRY_FLUSH_SEC));
+
+#if NODE_DEEP_SLEEP
+    // Acknowledged publishes, so nothing is lost when the node sleeps right after
+    telemetry_buffer_set_live_qos(1);
+    node_run_cycle();
+#else
     // Initialize WiFi
     ESP_LOGI(TAG, "Initializing WiFi");
-    // Initialize WiFi
-    if (wifi_init_sta() != ESP_OK) {
+    if (wifi_init_sta(portMAX_DELAY) != ESP_OK) {
         ESP_LOGE(TAG, "WiFi initialization failed");
         return;
     }
     
+    // Start SNTP so buffered readings carry their capture time
+    sntp_start();
+    
     // Initialize MQTT
     ESP_LOGI(TAG, "Initializing MQTT");
     mqtt_init();
@@ -307,4 +421,5 @@ void app_main(void)
     xTaskCreate(sensor_task, "sensor_task", 4096, NULL, 5, NULL);
     
     ESP_LOGI(TAG, "Application started successfully");
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,400 @@
+#include "telemetry_buffer.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_rtc_time.h"
+#include "esp_system.h"
+#include "nvs.h"
+#include "timestamp.h"
+
+static const char *TAG = "TELEMETRY";
+
+#define TELEMETRY_TOPIC    "v1/devices/me/telemetry"
+#define NVS_NAMESPACE      "telemetry"
+#define NVS_KEY_QUEUE      "queue"
+
+// Live batches default to QoS 0 so the client does not wait for a PUBACK per
+// message; the flash backlog uses QoS 1 because it is deleted once handed over.
+#define DEFAULT_LIVE_QOS   0
+#define BACKLOG_QOS        1
+
+// Marks the RTC copy of the buffer as valid after a deep-sleep wake
+#define BUFFER_MAGIC       0x54424246u
+
+// Longest array element: {"ts":1700000000000,"values":{"temperature":-40.0,"humidity":100.0}},
+#define MAX_ENTRY_LEN      80
+
+typedef enum {
+    TS_UNIX = 0,    // ts_ms is Unix time in milliseconds
+    TS_UPTIME,      // ts_ms is RTC time; converted once the clock is set
+    TS_NONE,        // captured in an earlier boot before the clock was set
+} ts_kind_t;
+
+typedef struct {
+    int64_t ts_ms;
+    int16_t temperature_dc;     // 0.1 degC
+    uint16_t humidity_dpct;     // 0.1 %RH
+    uint8_t ts_kind;
+    uint8_t reserved[3];
+} telemetry_reading_t;
+
+// Kept in RTC memory so a deep-sleep node can collect a batch over several wakes
+static RTC_DATA_ATTR telemetry_reading_t s_buffer[TELEMETRY_BUFFER_CAPACITY];
+static RTC_DATA_ATTR size_t s_buffer_count;
+static RTC_DATA_ATTR int64_t s_buffer_first_ms;
+static RTC_DATA_ATTR uint32_t s_buffer_magic;
+
+static telemetry_reading_t s_queue[TELEMETRY_QUEUE_CAPACITY];
+static size_t s_queue_count;
+
+static size_t s_batch_size = TELEMETRY_BUFFER_CAPACITY;
+static int64_t s_flush_interval_ms;
+static int s_live_qos = DEFAULT_LIVE_QOS;
+
+static char s_payload[TELEMETRY_PUBLISH_MAX * MAX_ENTRY_LEN + 2];
+
+/**
+ * @brief Get the current Unix time in milliseconds from the timestamp service
+ *
+ * @param out_ms Receives the time
+ * @return true if the clock has been set by SNTP, false otherwise
+ */
+static bool unix_time_ms(int64_t *out_ms)
+{
+    if (!timestamp_is_valid()) {
+        return false;
+    }
+    *out_ms = timestamp_now_us() / 1000;
+    return true;
+}
+
+/**
+ * @brief Get the time since power-up in milliseconds. The RTC timer keeps counting in
+ *        deep sleep, so stamps taken before a sleep stay comparable after the wake.
+ *
+ * @return int64_t RTC time in milliseconds
+ */
+static int64_t rtc_time_ms(void)
+{
+    return (int64_t)(esp_rtc_get_time_us() / 1000);
+}
+
+/**
+ * @brief Convert uptime stamps to Unix time once the clock is set. Readings taken
+ *        before SNTP finished get their real capture time instead of the send time.
+ *
+ * @param readings Readings to update in place
+ * @param count Number of readings
+ */
+static void resolve_timestamps(telemetry_reading_t *readings, size_t count)
+{
+    int64_t now_unix_ms;
+    if (!unix_time_ms(&now_unix_ms)) {
+        return;
+    }
+    int64_t now_uptime_ms = rtc_time_ms();
+    for (size_t i = 0; i < count; i++) {
+        if (readings[i].ts_kind == TS_UPTIME) {
+            readings[i].ts_ms = now_unix_ms - (now_uptime_ms - readings[i].ts_ms);
+            readings[i].ts_kind = TS_UNIX;
+        }
+    }
+}
+
+/**
+ * @brief Write the offline queue to NVS. An empty queue erases the key.
+ *
+ * @return esp_err_t ESP_OK on success, or the NVS error
+ */
+static esp_err_t queue_save(void)
+{
+    nvs_handle_t nvs;
+    esp_err_t err = nvs_open(NVS_NAMESPACE, NVS_READWRITE, &nvs);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (s_queue_count > 0) {
+        err = nvs_set_blob(nvs, NVS_KEY_QUEUE, s_queue, s_queue_count * sizeof(s_queue[0]));
+    } else {
+        err = nvs_erase_key(nvs, NVS_KEY_QUEUE);
+        if (err == ESP_ERR_NVS_NOT_FOUND) {
+            err = ESP_OK;
+        }
+    }
+    if (err == ESP_OK) {
+        err = nvs_commit(nvs);
+    }
+    nvs_close(nvs);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to save offline queue: %s", esp_err_to_name(err));
+    }
+    return err;
+}
+
+/**
+ * @brief Load the offline queue left in NVS by an earlier boot
+ *
+ */
+static void queue_load(void)
+{
+    nvs_handle_t nvs;
+    s_queue_count = 0;
+    if (nvs_open(NVS_NAMESPACE, NVS_READONLY, &nvs) != ESP_OK) {
+        return;
+    }
+    size_t len = sizeof(s_queue);
+    if (nvs_get_blob(nvs, NVS_KEY_QUEUE, s_queue, &len) == ESP_OK) {
+        s_queue_count = len / sizeof(s_queue[0]);
+    }
+    nvs_close(nvs);
+
+    // RTC time restarts at power-up, so uptime stamps from an earlier boot cannot
+    // be converted any more. A deep-sleep wake keeps the RTC time.
+    if (esp_reset_reason() == ESP_RST_DEEPSLEEP) {
+        return;
+    }
+    for (size_t i = 0; i < s_queue_count; i++) {
+        if (s_queue[i].ts_kind == TS_UPTIME) {
+            s_queue[i].ts_kind = TS_NONE;
+        }
+    }
+    if (s_queue_count > 0) {
+        ESP_LOGI(TAG, "Loaded %u queued readings from flash", (unsigned)s_queue_count);
+    }
+}
+
+/**
+ * @brief Move readings to the end of the offline queue, dropping the oldest
+ *        queued readings if the queue is full, and save it to flash
+ *
+ * @param readings Readings to append
+ * @param count Number of readings
+ * @return esp_err_t ESP_OK on success, or the NVS error
+ */
+static esp_err_t queue_append(const telemetry_reading_t *readings, size_t count)
+{
+    if (count > TELEMETRY_QUEUE_CAPACITY) {
+        readings += count - TELEMETRY_QUEUE_CAPACITY;
+        count = TELEMETRY_QUEUE_CAPACITY;
+    }
+    size_t overflow = (s_queue_count + count > TELEMETRY_QUEUE_CAPACITY)
+                          ? s_queue_count + count - TELEMETRY_QUEUE_CAPACITY
+                          : 0;
+    if (overflow > 0) {
+        ESP_LOGW(TAG, "Offline queue full, dropping %u oldest readings", (unsigned)overflow);
+        memmove(s_queue, s_queue + overflow, (s_queue_count - overflow) * sizeof(s_queue[0]));
+        s_queue_count -= overflow;
+    }
+    memcpy(s_queue + s_queue_count, readings, count * sizeof(s_queue[0]));
+    s_queue_count += count;
+    return queue_save();
+}
+
+/**
+ * @brief Format readings as a ThingsBoard telemetry array. Readings with a
+ *        known time use the {"ts", "values"} form; the others take the server time.
+ *
+ * @param readings Readings to format
+ * @param count Number of readings, at most TELEMETRY_PUBLISH_MAX
+ * @return int Length of the payload in s_payload
+ */
+static int format_batch(const telemetry_reading_t *readings, size_t count)
+{
+    int len = 0;
+    s_payload[len++] = '[';
+    for (size_t i = 0; i < count; i++) {
+        const telemetry_reading_t *r = &readings[i];
+        const char *sep = (i + 1 < count) ? "," : "";
+        float temperature = r->temperature_dc / 10.0f;
+        float humidity = r->humidity_dpct / 10.0f;
+        if (r->ts_kind == TS_UNIX) {
+            len += snprintf(s_payload + len, sizeof(s_payload) - len,
+                            "{\"ts\":%" PRId64 ",\"values\":{\"temperature\":%.1f,\"humidity\":%.1f}}%s",
+                            r->ts_ms, temperature, humidity, sep);
+        } else {
+            len += snprintf(s_payload + len, sizeof(s_payload) - len,
+                            "{\"temperature\":%.1f,\"humidity\":%.1f}%s",
+                            temperature, humidity, sep);
+        }
+    }
+    s_payload[len++] = ']';
+    s_payload[len] = '\0';
+    return len;
+}
+
+/**
+ * @brief Publish readings in messages of up to TELEMETRY_PUBLISH_MAX readings.
+ *        The messages are queued back to back without waiting for the broker.
+ *
+ * @param client MQTT client handle
+ * @param readings Readings to publish
+ * @param count Number of readings
+ * @param qos MQTT QoS for the messages
+ * @return size_t Number of readings handed to the client; less than count if a publish failed
+ */
+static size_t publish_readings(esp_mqtt_client_handle_t client, const telemetry_reading_t *readings,
+                               size_t count, int qos)
+{
+    size_t sent = 0;
+    while (sent < count) {
+        size_t chunk = count - sent;
+        if (chunk > TELEMETRY_PUBLISH_MAX) {
+            chunk = TELEMETRY_PUBLISH_MAX;
+        }
+        int len = format_batch(readings + sent, chunk);
+        int msg_id = esp_mqtt_client_publish(client, TELEMETRY_TOPIC, s_payload, len, qos, 0);
+        if (msg_id < 0) {
+            ESP_LOGE(TAG, "Failed to publish %u readings", (unsigned)chunk);
+            break;
+        }
+        ESP_LOGI(TAG, "Published %u readings (%d bytes, QoS %d)", (unsigned)chunk, len, qos);
+        sent += chunk;
+    }
+    return sent;
+}
+
+/**
+ * @brief Initialize the telemetry buffer and load readings queued in flash by an earlier boot.
+ *        After a deep-sleep wake the readings buffered before the sleep are kept.
+ *        NVS must be initialized first.
+ *
+ * @param batch_size Readings that trigger a flush, at most TELEMETRY_BUFFER_CAPACITY
+ * @param flush_interval_sec Age of the oldest buffered reading that triggers a flush
+ * @return esp_err_t ESP_OK on success, or ESP_ERR_INVALID_ARG for a zero batch size
+ */
+esp_err_t telemetry_buffer_init(size_t batch_size, int flush_interval_sec)
+{
+    if (batch_size == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_batch_size = (batch_size > TELEMETRY_BUFFER_CAPACITY) ? TELEMETRY_BUFFER_CAPACITY : batch_size;
+    s_flush_interval_ms = (int64_t)flush_interval_sec * 1000;
+    if (esp_reset_reason() != ESP_RST_DEEPSLEEP || s_buffer_magic != BUFFER_MAGIC) {
+        s_buffer_count = 0;
+        s_buffer_magic = BUFFER_MAGIC;
+    }
+    queue_load();
+    return ESP_OK;
+}
+
+/**
+ * @brief Add a reading to the buffer, stamped with the current time. If the buffer is full
+ *        its contents are moved to the offline queue first.
+ *
+ * @param temperature Temperature in degrees Celsius
+ * @param humidity Relative humidity in percent
+ * @return esp_err_t ESP_OK on success, or the NVS error if the buffer had to be spilled to flash
+ */
+esp_err_t telemetry_buffer_add(float temperature, float humidity)
+{
+    esp_err_t err = ESP_OK;
+    if (s_buffer_count == TELEMETRY_BUFFER_CAPACITY) {
+        resolve_timestamps(s_buffer, s_buffer_count);
+        err = queue_append(s_buffer, s_buffer_count);
+        s_buffer_count = 0;
+    }
+
+    telemetry_reading_t *r = &s_buffer[s_buffer_count];
+    memset(r, 0, sizeof(*r));
+    int64_t now_uptime_ms = rtc_time_ms();
+    if (unix_time_ms(&r->ts_ms)) {
+        r->ts_kind = TS_UNIX;
+    } else {
+        r->ts_ms = now_uptime_ms;
+        r->ts_kind = TS_UPTIME;
+    }
+    r->temperature_dc = (int16_t)(temperature * 10.0f + (temperature < 0 ? -0.5f : 0.5f));
+    r->humidity_dpct = (uint16_t)(humidity * 10.0f + 0.5f);
+
+    if (s_buffer_count == 0) {
+        s_buffer_first_ms = now_uptime_ms;
+    }
+    s_buffer_count++;
+    return err;
+}
+
+/**
+ * @brief Check whether the buffer holds a full batch or its oldest reading has waited
+ *        for the flush interval
+ *
+ * @return true if telemetry_buffer_flush() should be called
+ */
+bool telemetry_buffer_flush_due(void)
+{
+    if (s_buffer_count == 0) {
+        return false;
+    }
+    if (s_buffer_count >= s_batch_size) {
+        return true;
+    }
+    return rtc_time_ms() - s_buffer_first_ms >= s_flush_interval_ms;
+}
+
+/**
+ * @brief Send buffered readings to ThingsBoard, or keep them in flash while offline.
+ *        When connected, the offline queue is sent first (oldest readings first), then
+ *        the buffer. Readings that cannot be published are moved to the offline queue.
+ *
+ * @param client MQTT client handle
+ * @param connected true if the MQTT client is connected to the broker
+ * @return esp_err_t ESP_OK if everything was published, ESP_FAIL if readings remain queued,
+ *                   or the NVS error if the queue could not be saved
+ */
+esp_err_t telemetry_buffer_flush(esp_mqtt_client_handle_t client, bool connected)
+{
+    esp_err_t err = ESP_OK;
+    resolve_timestamps(s_buffer, s_buffer_count);
+
+    if (connected && s_queue_count > 0) {
+        resolve_timestamps(s_queue, s_queue_count);
+        size_t sent = publish_readings(client, s_queue, s_queue_count, BACKLOG_QOS);
+        if (sent > 0) {
+            memmove(s_queue, s_queue + sent, (s_queue_count - sent) * sizeof(s_queue[0]));
+            s_queue_count -= sent;
+            err = queue_save();
+        }
+        if (s_queue_count > 0) {
+            // Keep the order: newer readings wait behind the backlog.
+            connected = false;
+        }
+    }
+
+    size_t sent = connected ? publish_readings(client, s_buffer, s_buffer_count, s_live_qos) : 0;
+    if (sent < s_buffer_count) {
+        esp_err_t queue_err = queue_append(s_buffer + sent, s_buffer_count - sent);
+        if (queue_err != ESP_OK) {
+            err = queue_err;
+        }
+        ESP_LOGI(TAG, "Queued %u readings in flash (%u total)",
+                 (unsigned)(s_buffer_count - sent), (unsigned)s_queue_count);
+    }
+    s_buffer_count = 0;
+
+    if (err == ESP_OK && s_queue_count > 0) {
+        err = ESP_FAIL;
+    }
+    return err;
+}
+
+/**
+ * @brief Get the number of readings waiting in the offline queue
+ *
+ * @return size_t Number of queued readings
+ */
+size_t telemetry_buffer_queued(void)
+{
+    return s_queue_count;
+}
+
+/**
+ * @brief Set the QoS for live batches. QoS 1 lets the caller wait for the broker's
+ *        acknowledgement, e.g. before deep sleep ends the connection.
+ *
+ * @param qos MQTT QoS, 0 or 1
+ */
+void telemetry_buffer_set_live_qos(int qos)
+{
+    s_live_qos = qos;
+}
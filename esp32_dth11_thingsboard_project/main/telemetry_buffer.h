@@ -0,0 +1,25 @@
+#ifndef TELEMETRY_BUFFER_H
+#define TELEMETRY_BUFFER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+#include "mqtt_client.h"
+
+// Readings held in RAM before a flush is forced
+#define TELEMETRY_BUFFER_CAPACITY 32
+
+// Readings kept in flash while MQTT is down; the oldest are dropped beyond this
+#define TELEMETRY_QUEUE_CAPACITY  256
+
+// Readings per MQTT message when the flash queue is drained
+#define TELEMETRY_PUBLISH_MAX     32
+
+esp_err_t telemetry_buffer_init(size_t batch_size, int flush_interval_sec);
+esp_err_t telemetry_buffer_add(float temperature, float humidity);
+bool telemetry_buffer_flush_due(void);
+esp_err_t telemetry_buffer_flush(esp_mqtt_client_handle_t client, bool connected);
+size_t telemetry_buffer_queued(void);
+void telemetry_buffer_set_live_qos(int qos);
+
+#endif // TELEMETRY_BUFFER_H
@@ -4,6 +4,7 @@
 #include <string.h>
 
 #include "eeprom_24lc256.h"
+#include "eeprom_kv.h"
 #include "esp_check.h"
 #include "esp_err.h"
 #include "esp_log.h"
@@ -12,11 +13,20 @@
 #include "i2c_bus.h"
 #include "i2c_scanner.h"
 #include "sdkconfig.h"
+#include "sensor_poller.h"
 #include "ssd1306.h"
 #include "tmp102.h"
 
+#if CONFIG_APP_TMP102_MODE_ALERT
+#include "driver/gpio.h"
+#include "esp_attr.h"
+#include "freertos/semphr.h"
+#endif
+
 #define MAX_SCANNED_DEVICES 16
 #define SENSOR_READ_INTERVAL_MS 2000
+#define KV_KEY_BOOT_COUNT 0
+#define POLLER_STATS_INTERVAL_MS 60000
 
 static const char *TAG = "app";
 
@@ -25,12 +35,21 @@ static tmp102_t s_tmp102;
 static bool s_tmp102_available;
 #endif
 
+#if CONFIG_APP_TMP102_MODE_ALERT
+static SemaphoreHandle_t s_tmp102_alert;
+#endif
+
+#if !CONFIG_APP_TMP102_MODE_ALERT
+static sensor_poller_device_t s_polled_devices[SENSOR_POLLER_MAX_DEVICES];
+#endif
+
 #if CONFIG_APP_ENABLE_SSD1306_DEMO
 static ssd1306_t s_ssd1306;
 #endif
 
 #if CONFIG_APP_ENABLE_EEPROM_DEMO
 static eeprom_24lc256_t s_eeprom;
+static eeprom_kv_t s_eeprom_kv;
 #endif
 
 /**
@@ -59,7 +78,117 @@ static bool address_was_detected(const uint8_t *addresses,
     return false;
 }
 
+#if CONFIG_APP_TMP102_MODE_ALERT
+/**
+ * @brief Wakes the periodic loop when the TMP102 ALERT pin changes state.
+ *
+ * @param argument Unused handler argument.
+ */
+static void IRAM_ATTR tmp102_alert_isr(void *argument)
+{
+    (void)argument;
+
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    xSemaphoreGiveFromISR(s_tmp102_alert, &higher_priority_task_woken);
+    if (higher_priority_task_woken == pdTRUE) {
+        portYIELD_FROM_ISR();
+    }
+}
+
+/**
+ * @brief Configures the ALERT GPIO and its edge interrupt.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+static esp_err_t init_tmp102_alert_gpio(void)
+{
+    s_tmp102_alert = xSemaphoreCreateBinary();
+    ESP_RETURN_ON_FALSE(s_tmp102_alert != NULL,
+                        ESP_ERR_NO_MEM,
+                        TAG,
+                        "Failed to create TMP102 alert semaphore");
+
+    // ALERT is open drain and active low; both edges are of interest.
+    const gpio_config_t alert_config = {
+        .pin_bit_mask = 1ULL << CONFIG_APP_TMP102_ALERT_GPIO,
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_ANYEDGE,
+    };
+
+    ESP_RETURN_ON_ERROR(gpio_config(&alert_config),
+                        TAG,
+                        "Failed to configure TMP102 ALERT GPIO");
+
+    const esp_err_t result = gpio_install_isr_service(0);
+    ESP_RETURN_ON_FALSE((result == ESP_OK) || (result == ESP_ERR_INVALID_STATE),
+                        result,
+                        TAG,
+                        "Failed to install GPIO ISR service");
+
+    return gpio_isr_handler_add(CONFIG_APP_TMP102_ALERT_GPIO,
+                                tmp102_alert_isr,
+                                NULL);
+}
+#endif
+
 #if CONFIG_APP_ENABLE_TMP102_DEMO
+/**
+ * @brief Reads the TMP102 in the configured operating mode.
+ *
+ * @param temperature_c Output pointer that receives temperature in degrees C.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+static esp_err_t read_tmp102(float *temperature_c)
+{
+#if CONFIG_APP_TMP102_MODE_ONE_SHOT
+    return tmp102_read_one_shot_c(&s_tmp102, temperature_c);
+#else
+    return tmp102_read_temperature_c(&s_tmp102, temperature_c);
+#endif
+}
+
+/**
+ * @brief Applies the operating mode selected in menuconfig.
+ *
+ * Continuous mode keeps the power-on configuration. Alert mode slows the
+ * conversion rate and arms the comparator; one-shot mode shuts the sensor
+ * down between readings.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+static esp_err_t configure_tmp102_mode(void)
+{
+#if CONFIG_APP_TMP102_MODE_ALERT
+    const tmp102_config_t config = {
+        .conversion_rate = TMP102_RATE_0_25_HZ,
+        .alert_mode = TMP102_ALERT_COMPARATOR,
+        .fault_queue = 2,
+        .low_limit_c = (float)CONFIG_APP_TMP102_LOW_LIMIT_C,
+        .high_limit_c = (float)CONFIG_APP_TMP102_HIGH_LIMIT_C,
+    };
+
+    ESP_RETURN_ON_ERROR(tmp102_configure(&s_tmp102, &config),
+                        TAG,
+                        "Failed to configure TMP102 alert mode");
+    return init_tmp102_alert_gpio();
+#elif CONFIG_APP_TMP102_MODE_ONE_SHOT
+    // The limits are unused in shutdown mode but must still be ordered.
+    const tmp102_config_t config = {
+        .shutdown = true,
+        .fault_queue = 1,
+        .low_limit_c = 75.0f,
+        .high_limit_c = 80.0f,
+    };
+
+    return tmp102_configure(&s_tmp102, &config);
+#else
+    return ESP_OK;
+#endif
+}
+
 /**
  * @brief Initializes and reads the optional TMP102 demonstration device.
  *
@@ -84,8 +213,15 @@ static void run_tmp102_demo(bool detected)
         return;
     }
 
+    result = configure_tmp102_mode();
+    if (result != ESP_OK) {
+        ESP_LOGE(TAG, "TMP102 mode setup failed: %s",
+                 esp_err_to_name(result));
+        return;
+    }
+
     float temperature_c = 0.0f;
-    result = tmp102_read_temperature_c(&s_tmp102, &temperature_c);
+    result = read_tmp102(&temperature_c);
     if (result == ESP_OK) {
         ESP_LOGI(TAG, "TMP102 temperature: %.2f C", temperature_c);
         s_tmp102_available = true;
@@ -132,6 +268,47 @@ static void run_ssd1306_demo(bool detected)
 #endif
 
 #if CONFIG_APP_ENABLE_EEPROM_DEMO
+/**
+ * @brief Increments a boot counter kept in the wear-levelled key/value store.
+ */
+static void run_eeprom_kv_demo(void)
+{
+    esp_err_t result = eeprom_kv_init(&s_eeprom_kv,
+                                      &s_eeprom,
+                                      CONFIG_APP_EEPROM_KV_BASE_ADDRESS,
+                                      CONFIG_APP_EEPROM_KV_SLOT_COUNT);
+    if (result != ESP_OK) {
+        ESP_LOGE(TAG, "EEPROM key/value store initialization failed: %s",
+                 esp_err_to_name(result));
+        return;
+    }
+
+    uint32_t boot_count = 0;
+    size_t length = 0;
+    result = eeprom_kv_get(&s_eeprom_kv,
+                           KV_KEY_BOOT_COUNT,
+                           &boot_count,
+                           sizeof(boot_count),
+                           &length);
+    if ((result != ESP_OK) || (length != sizeof(boot_count))) {
+        boot_count = 0;
+    }
+
+    boot_count++;
+    result = eeprom_kv_set(&s_eeprom_kv,
+                           KV_KEY_BOOT_COUNT,
+                           &boot_count,
+                           sizeof(boot_count));
+    if (result == ESP_OK) {
+        ESP_LOGI(TAG, "Boot count: %u (slot %u)",
+                 (unsigned int)boot_count,
+                 (unsigned int)s_eeprom_kv.entries[KV_KEY_BOOT_COUNT].slot);
+    } else {
+        ESP_LOGE(TAG, "Failed to store boot count: %s",
+                 esp_err_to_name(result));
+    }
+}
+
 /**
  * @brief Performs a non-destructive EEPROM write and readback test.
  *
@@ -201,42 +378,117 @@ static void run_eeprom_demo(bool detected)
         ESP_LOGE(TAG, "24LC256 readback data did not match the test pattern");
     }
 
-    // Restore the saved bytes so the demonstration is non-destructive.
+    // Restore the saved bytes so the demonstration is non-destructive. The
+    // flush makes sure the last staged page reaches nonvolatile memory.
     result = eeprom_24lc256_write(&s_eeprom,
                                   CONFIG_APP_EEPROM_TEST_ADDRESS,
                                   original_data,
                                   sizeof(original_data));
+    if (result == ESP_OK) {
+        result = eeprom_24lc256_flush(&s_eeprom);
+    }
     if (result == ESP_OK) {
         ESP_LOGI(TAG, "Original EEPROM bytes restored");
     } else {
         ESP_LOGE(TAG, "Failed to restore original EEPROM bytes: %s",
                  esp_err_to_name(result));
     }
+
+    run_eeprom_kv_demo();
+}
+#endif
+
+#if CONFIG_APP_ENABLE_TMP102_DEMO && !CONFIG_APP_TMP102_MODE_ALERT
+/**
+ * @brief Polling table read function for the TMP102.
+ *
+ * @param context Unused table context.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+static esp_err_t poll_tmp102(void *context)
+{
+    (void)context;
+
+    float temperature_c = 0.0f;
+    const esp_err_t result = read_tmp102(&temperature_c);
+    if (result == ESP_OK) {
+        ESP_LOGI(TAG, "Temperature: %.2f C", temperature_c);
+    }
+
+    return result;
 }
 #endif
 
+#if CONFIG_APP_TMP102_MODE_ALERT
 /**
- * @brief Periodically reads the TMP102 after the startup demonstrations.
+ * @brief Reads the TMP102 whenever ALERT changes state.
+ *
+ * The loop sleeps until the ALERT interrupt fires, or until the heartbeat
+ * interval passes, instead of polling.
  */
 static void run_periodic_tasks(void)
 {
     while (true) {
-#if CONFIG_APP_ENABLE_TMP102_DEMO
-        if (s_tmp102_available) {
-            float temperature_c = 0.0f;
-            const esp_err_t result = tmp102_read_temperature_c(&s_tmp102,
-                                                                &temperature_c);
-            if (result == ESP_OK) {
-                ESP_LOGI(TAG, "Temperature: %.2f C", temperature_c);
-            } else {
-                ESP_LOGE(TAG, "Periodic TMP102 read failed: %s",
-                         esp_err_to_name(result));
-            }
+        if (!s_tmp102_available) {
+            vTaskDelay(pdMS_TO_TICKS(SENSOR_READ_INTERVAL_MS));
+            continue;
         }
+
+        float temperature_c = 0.0f;
+        const esp_err_t result = read_tmp102(&temperature_c);
+        if (result == ESP_OK) {
+            ESP_LOGI(TAG, "Temperature: %.2f C (alert %s)", temperature_c,
+                     (gpio_get_level(CONFIG_APP_TMP102_ALERT_GPIO) == 0)
+                         ? "active"
+                         : "clear");
+        } else {
+            ESP_LOGE(TAG, "Periodic TMP102 read failed: %s",
+                     esp_err_to_name(result));
+        }
+
+        (void)xSemaphoreTake(s_tmp102_alert,
+                             pdMS_TO_TICKS(CONFIG_APP_TMP102_ALERT_HEARTBEAT_S * 1000));
+    }
+}
+#else
+/**
+ * @brief Hands the detected sensors to the polling scheduler.
+ *
+ * Each sensor gets an entry with its own period in the polling table, and
+ * this task then only logs the read statistics.
+ */
+static void run_periodic_tasks(void)
+{
+    size_t polled_count = 0;
+
+#if CONFIG_APP_ENABLE_TMP102_DEMO
+    if (s_tmp102_available) {
+        s_polled_devices[polled_count++] = (sensor_poller_device_t){
+            .name = "TMP102",
+            .bus = 0,
+            .period_ms = SENSOR_READ_INTERVAL_MS,
+            .priority = 0,
+            .read = poll_tmp102,
+        };
+    }
 #endif
-        vTaskDelay(pdMS_TO_TICKS(SENSOR_READ_INTERVAL_MS));
+
+    if (polled_count > 0) {
+        const esp_err_t result = sensor_poller_start(s_polled_devices,
+                                                     polled_count);
+        if (result != ESP_OK) {
+            ESP_LOGE(TAG, "Sensor polling failed to start: %s",
+                     esp_err_to_name(result));
+        }
+    }
+
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(POLLER_STATS_INTERVAL_MS));
+        sensor_poller_log_stats();
     }
 }
+#endif
 
 /**
  * @brief Application entry point.
@@ -253,10 +505,14 @@ void app_main(void)
     // Initialize the shared I2C bus and scan for devices.
     ESP_ERROR_CHECK(app_i2c_bus_init());
     
-    // Scan the bus and store the detected addresses in the array.
-    ESP_ERROR_CHECK(i2c_scanner_scan(detected_addresses,
-                                     MAX_SCANNED_DEVICES,
-                                     &detected_count));
+    // Scan the bus and store the detected addresses in the array. A bus
+    // fault ends the scan early; the demos then skip the missing devices.
+    const esp_err_t scan_result = i2c_scanner_scan(detected_addresses,
+                                                   MAX_SCANNED_DEVICES,
+                                                   &detected_count);
+    if (scan_result != ESP_OK) {
+        ESP_LOGE(TAG, "I2C scan failed: %s", esp_err_to_name(scan_result));
+    }
 
     const size_t stored_count = (detected_count < MAX_SCANNED_DEVICES)
                                     ? detected_count
@@ -3,12 +3,13 @@
 #include <string.h>
 
 #include "esp_check.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
 #include "i2c_bus.h"
 
 #define EEPROM_TRANSACTION_TIMEOUT_MS 200
-#define EEPROM_WRITE_CYCLE_MS         6
+#define EEPROM_WRITE_CYCLE_MAX_US     10000
+#define EEPROM_POLL_TIMEOUT_MS        5
 
 static const char *TAG = "24lc256";
 
@@ -27,7 +28,79 @@ static bool transfer_is_in_range(uint16_t memory_address, size_t data_length)
 }
 
 /**
- * @brief Writes one chunk that does not cross an EEPROM page boundary.
+ * @brief Waits for the previous page write cycle to finish.
+ *
+ * The 24LC256 does not acknowledge its address while it programs a page, so
+ * the first acknowledged probe marks the end of the write cycle. This is
+ * usually about 3 ms, well below the 5 ms maximum.
+ *
+ * @param eeprom Initialized EEPROM context.
+ *
+ * @return ESP_OK when the EEPROM is ready. ESP_ERR_TIMEOUT when it did not
+ *         acknowledge within EEPROM_WRITE_CYCLE_MAX_US.
+ */
+static esp_err_t wait_until_ready(eeprom_24lc256_t *eeprom)
+{
+    if (!eeprom->write_in_progress) {
+        return ESP_OK;
+    }
+
+    const int64_t start_us = esp_timer_get_time();
+
+    while (app_i2c_bus_probe(eeprom->address,
+                             EEPROM_POLL_TIMEOUT_MS) != ESP_OK) {
+        if ((esp_timer_get_time() - start_us) > EEPROM_WRITE_CYCLE_MAX_US) {
+            ESP_LOGE(TAG, "EEPROM write cycle did not complete");
+            return ESP_ERR_TIMEOUT;
+        }
+    }
+
+    eeprom->write_in_progress = false;
+    return ESP_OK;
+}
+
+/**
+ * @brief Reads bytes without committing the staged page.
+ *
+ * @param eeprom Initialized EEPROM context.
+ * @param memory_address First EEPROM byte address.
+ * @param data Destination buffer.
+ * @param data_length Number of bytes to read.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+static esp_err_t read_raw(eeprom_24lc256_t *eeprom,
+                          uint16_t memory_address,
+                          uint8_t *data,
+                          size_t data_length)
+{
+    ESP_RETURN_ON_ERROR(wait_until_ready(eeprom),
+                        TAG,
+                        "EEPROM is busy");
+
+    const uint8_t address_bytes[2] = {
+        (uint8_t)(memory_address >> 8),
+        (uint8_t)(memory_address & 0xFFU),
+    };
+
+    const app_i2c_transaction_t transaction = {
+        .device_handle = eeprom->device_handle,
+        .priority = APP_I2C_PRIORITY_NORMAL,
+        .write_data = address_bytes,
+        .write_length = sizeof(address_bytes),
+        .read_data = data,
+        .read_length = data_length,
+        .timeout_ms = EEPROM_TRANSACTION_TIMEOUT_MS,
+    };
+
+    return app_i2c_bus_execute(&transaction);
+}
+
+/**
+ * @brief Starts a write of one chunk that does not cross a page boundary.
+ *
+ * The function returns as soon as the bytes are on the bus. The write cycle
+ * finishes in the background and is awaited by the next access.
  *
  * @param eeprom Initialized EEPROM context.
  * @param memory_address First EEPROM byte address.
@@ -36,27 +109,133 @@ static bool transfer_is_in_range(uint16_t memory_address, size_t data_length)
  *
  * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
  */
-static esp_err_t write_page_chunk(const eeprom_24lc256_t *eeprom,
+static esp_err_t write_page_chunk(eeprom_24lc256_t *eeprom,
                                   uint16_t memory_address,
                                   const uint8_t *data,
                                   size_t data_length)
 {
-    uint8_t transmit_buffer[EEPROM_24LC256_PAGE_SIZE + 2];
+    ESP_RETURN_ON_ERROR(wait_until_ready(eeprom),
+                        TAG,
+                        "EEPROM is busy");
+
+    // 24LC256 devices use a two-byte big-endian memory address. It is sent
+    // as a prefix, so the data goes out without a copy.
+    const uint8_t address_bytes[2] = {
+        (uint8_t)(memory_address >> 8),
+        (uint8_t)(memory_address & 0xFFU),
+    };
 
-    // 24LC256 devices use a two-byte big-endian memory address.
-    transmit_buffer[0] = (uint8_t)(memory_address >> 8);
-    transmit_buffer[1] = (uint8_t)(memory_address & 0xFFU);
-    memcpy(&transmit_buffer[2], data, data_length);
+    const app_i2c_transaction_t transaction = {
+        .device_handle = eeprom->device_handle,
+        .priority = APP_I2C_PRIORITY_NORMAL,
+        .prefix = address_bytes,
+        .prefix_length = sizeof(address_bytes),
+        .write_data = data,
+        .write_length = data_length,
+        .timeout_ms = EEPROM_TRANSACTION_TIMEOUT_MS,
+    };
 
-    ESP_RETURN_ON_ERROR(i2c_master_transmit(eeprom->device_handle,
-                                             transmit_buffer,
-                                             data_length + 2,
-                                             EEPROM_TRANSACTION_TIMEOUT_MS),
+    ESP_RETURN_ON_ERROR(app_i2c_bus_execute(&transaction),
                         TAG,
                         "EEPROM page write failed");
 
-    // The EEPROM needs time to program the internal nonvolatile array.
-    vTaskDelay(pdMS_TO_TICKS(EEPROM_WRITE_CYCLE_MS));
+    eeprom->write_in_progress = true;
+    return ESP_OK;
+}
+
+/**
+ * @brief Writes the staged page range, if any.
+ *
+ * @param eeprom Initialized EEPROM context.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+static esp_err_t commit_staged_page(eeprom_24lc256_t *eeprom)
+{
+    if (!eeprom->page_staged) {
+        return ESP_OK;
+    }
+
+    const uint8_t start = eeprom->staged_start;
+    const esp_err_t result = write_page_chunk(eeprom,
+                                              (uint16_t)(eeprom->staged_page + start),
+                                              &eeprom->page_buffer[start],
+                                              (size_t)(eeprom->staged_end - start));
+    if (result == ESP_OK) {
+        eeprom->page_staged = false;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Merges bytes that lie inside one page into the staged page.
+ *
+ * A different staged page is committed first. A gap between the staged
+ * range and the new bytes is filled from the EEPROM so the page can still be
+ * written in one cycle. A completely staged page is committed immediately.
+ *
+ * @param eeprom Initialized EEPROM context.
+ * @param memory_address First EEPROM byte address.
+ * @param data Source buffer.
+ * @param data_length Number of bytes, all inside one page.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+static esp_err_t stage_page_chunk(eeprom_24lc256_t *eeprom,
+                                  uint16_t memory_address,
+                                  const uint8_t *data,
+                                  size_t data_length)
+{
+    const uint16_t page = (uint16_t)(memory_address & ~(EEPROM_24LC256_PAGE_SIZE - 1U));
+    const uint8_t start = (uint8_t)(memory_address - page);
+    const uint8_t end = (uint8_t)(start + data_length);
+
+    if (eeprom->page_staged && (eeprom->staged_page != page)) {
+        ESP_RETURN_ON_ERROR(commit_staged_page(eeprom),
+                            TAG,
+                            "Failed to commit staged page 0x%04X",
+                            eeprom->staged_page);
+    }
+
+    if (!eeprom->page_staged) {
+        eeprom->staged_page = page;
+        eeprom->staged_start = start;
+        eeprom->staged_end = end;
+    } else {
+        // Read-modify-write: fill any gap so the union stays contiguous.
+        if (start > eeprom->staged_end) {
+            ESP_RETURN_ON_ERROR(read_raw(eeprom,
+                                         (uint16_t)(page + eeprom->staged_end),
+                                         &eeprom->page_buffer[eeprom->staged_end],
+                                         (size_t)(start - eeprom->staged_end)),
+                                TAG,
+                                "Failed to read page gap");
+        } else if (end < eeprom->staged_start) {
+            ESP_RETURN_ON_ERROR(read_raw(eeprom,
+                                         (uint16_t)(page + end),
+                                         &eeprom->page_buffer[end],
+                                         (size_t)(eeprom->staged_start - end)),
+                                TAG,
+                                "Failed to read page gap");
+        }
+
+        if (start < eeprom->staged_start) {
+            eeprom->staged_start = start;
+        }
+        if (end > eeprom->staged_end) {
+            eeprom->staged_end = end;
+        }
+    }
+
+    memcpy(&eeprom->page_buffer[start], data, data_length);
+    eeprom->page_staged = true;
+
+    if ((eeprom->staged_start == 0U) &&
+        (eeprom->staged_end == EEPROM_24LC256_PAGE_SIZE)) {
+        return commit_staged_page(eeprom);
+    }
+
     return ESP_OK;
 }
 
@@ -98,7 +277,7 @@ esp_err_t eeprom_24lc256_init(eeprom_24lc256_t *eeprom,
  * @param data_length Number of bytes to read.
  * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
  */
-esp_err_t eeprom_24lc256_read(const eeprom_24lc256_t *eeprom,
+esp_err_t eeprom_24lc256_read(eeprom_24lc256_t *eeprom,
                               uint16_t memory_address,
                               uint8_t *data,
                               size_t data_length)
@@ -124,17 +303,11 @@ esp_err_t eeprom_24lc256_read(const eeprom_24lc256_t *eeprom,
                         TAG,
                         "Read exceeds EEPROM capacity");
 
-    const uint8_t address_bytes[2] = {
-        (uint8_t)(memory_address >> 8),
-        (uint8_t)(memory_address & 0xFFU),
-    };
+    ESP_RETURN_ON_ERROR(commit_staged_page(eeprom),
+                        TAG,
+                        "Failed to commit staged page before read");
 
-    return i2c_master_transmit_receive(eeprom->device_handle,
-                                       address_bytes,
-                                       sizeof(address_bytes),
-                                       data,
-                                       data_length,
-                                       EEPROM_TRANSACTION_TIMEOUT_MS);
+    return read_raw(eeprom, memory_address, data, data_length);
 }
 
 /**
@@ -146,7 +319,7 @@ esp_err_t eeprom_24lc256_read(const eeprom_24lc256_t *eeprom,
  * @param data_length Number of bytes to write.
  * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
  */
-esp_err_t eeprom_24lc256_write(const eeprom_24lc256_t *eeprom,
+esp_err_t eeprom_24lc256_write(eeprom_24lc256_t *eeprom,
                                uint16_t memory_address,
                                const uint8_t *data,
                                size_t data_length)
@@ -183,7 +356,7 @@ esp_err_t eeprom_24lc256_write(const eeprom_24lc256_t *eeprom,
                                         ? bytes_remaining
                                         : page_space;
 
-        ESP_RETURN_ON_ERROR(write_page_chunk(eeprom,
+        ESP_RETURN_ON_ERROR(stage_page_chunk(eeprom,
                                               current_address,
                                               &data[source_offset],
                                               chunk_length),
@@ -199,6 +372,30 @@ esp_err_t eeprom_24lc256_write(const eeprom_24lc256_t *eeprom,
     return ESP_OK;
 }
 
+/**
+ * @brief Commits staged data and waits for the write cycle to finish.
+ *
+ * @param eeprom Initialized EEPROM context.
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+esp_err_t eeprom_24lc256_flush(eeprom_24lc256_t *eeprom)
+{
+    ESP_RETURN_ON_FALSE(eeprom != NULL,
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "EEPROM context is NULL");
+    ESP_RETURN_ON_FALSE(eeprom->initialized,
+                        ESP_ERR_INVALID_STATE,
+                        TAG,
+                        "EEPROM is not initialized");
+
+    ESP_RETURN_ON_ERROR(commit_staged_page(eeprom),
+                        TAG,
+                        "Failed to commit staged page");
+
+    return wait_until_ready(eeprom);
+}
+
 /**
  * @brief Deinitializes the EEPROM.
  *
@@ -216,6 +413,10 @@ esp_err_t eeprom_24lc256_deinit(eeprom_24lc256_t *eeprom)
         return ESP_OK;
     }
 
+    ESP_RETURN_ON_ERROR(eeprom_24lc256_flush(eeprom),
+                        TAG,
+                        "Failed to flush EEPROM before deinit");
+
     ESP_RETURN_ON_ERROR(app_i2c_bus_remove_device(eeprom->device_handle),
                         TAG,
                         "Failed to remove EEPROM device");
@@ -0,0 +1,311 @@
+#include "eeprom_kv.h"
+
+#include <string.h>
+
+#include "esp_check.h"
+#include "esp_rom_crc.h"
+
+#define EEPROM_KV_MAGIC        0xA5U
+#define EEPROM_KV_HEADER_SIZE  8U
+#define EEPROM_KV_CRC_SIZE     4U
+
+static const char *TAG = "eeprom_kv";
+
+/*
+ * Record layout in one page:
+ *
+ *   magic | key | length | reserved | sequence (LE) | value... | crc32 (LE)
+ *
+ * The CRC covers the header and the value. Only the header, value, and CRC
+ * are written, so short values also keep the bus transfer short.
+ */
+
+/**
+ * @brief Returns the EEPROM address of a slot.
+ *
+ * @param store Store context.
+ * @param slot Slot number.
+ *
+ * @return First byte address of the slot.
+ */
+static uint16_t slot_address(const eeprom_kv_t *store, uint16_t slot)
+{
+    return (uint16_t)(store->base_address +
+                      ((uint32_t)slot * EEPROM_24LC256_PAGE_SIZE));
+}
+
+/**
+ * @brief Reads a little-endian 32-bit value.
+ *
+ * @param bytes Source bytes.
+ *
+ * @return Decoded value.
+ */
+static uint32_t get_u32_le(const uint8_t *bytes)
+{
+    return (uint32_t)bytes[0] |
+           ((uint32_t)bytes[1] << 8) |
+           ((uint32_t)bytes[2] << 16) |
+           ((uint32_t)bytes[3] << 24);
+}
+
+/**
+ * @brief Writes a little-endian 32-bit value.
+ *
+ * @param bytes Destination bytes.
+ * @param value Value to encode.
+ */
+static void put_u32_le(uint8_t *bytes, uint32_t value)
+{
+    bytes[0] = (uint8_t)value;
+    bytes[1] = (uint8_t)(value >> 8);
+    bytes[2] = (uint8_t)(value >> 16);
+    bytes[3] = (uint8_t)(value >> 24);
+}
+
+/**
+ * @brief Checks whether a slot holds the latest record of any key.
+ *
+ * @param store Store context.
+ * @param slot Slot number.
+ *
+ * @return True when overwriting the slot would lose a key's only copy.
+ */
+static bool slot_is_live(const eeprom_kv_t *store, uint16_t slot)
+{
+    for (size_t key = 0; key < EEPROM_KV_MAX_KEYS; ++key) {
+        if (store->entries[key].valid && (store->entries[key].slot == slot)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Validates one slot image and adds it to the RAM index.
+ *
+ * @param store Store context.
+ * @param slot Slot number.
+ * @param record Page contents of the slot.
+ *
+ * @return True when the slot holds a valid record.
+ */
+static bool index_record(eeprom_kv_t *store,
+                         uint16_t slot,
+                         const uint8_t *record)
+{
+    const uint8_t key = record[1];
+    const uint8_t length = record[2];
+
+    if ((record[0] != EEPROM_KV_MAGIC) ||
+        (key >= EEPROM_KV_MAX_KEYS) ||
+        (length > EEPROM_KV_MAX_VALUE_SIZE)) {
+        return false;
+    }
+
+    const size_t crc_offset = EEPROM_KV_HEADER_SIZE + length;
+    const uint32_t crc = esp_rom_crc32_le(0, record, crc_offset);
+    if (crc != get_u32_le(&record[crc_offset])) {
+        return false;
+    }
+
+    const uint32_t sequence = get_u32_le(&record[4]);
+    eeprom_kv_entry_t *entry = &store->entries[key];
+
+    if (!entry->valid || (sequence > entry->sequence)) {
+        entry->valid = true;
+        entry->slot = slot;
+        entry->sequence = sequence;
+        entry->length = length;
+        memcpy(entry->value, &record[EEPROM_KV_HEADER_SIZE], length);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Initializes the key/value store.
+ *
+ * @param store Store context to initialize.
+ * @param eeprom Initialized EEPROM context.
+ * @param base_address Page-aligned first address of the record region.
+ * @param slot_count Number of pages in the region.
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+esp_err_t eeprom_kv_init(eeprom_kv_t *store,
+                         eeprom_24lc256_t *eeprom,
+                         uint16_t base_address,
+                         uint16_t slot_count)
+{
+    ESP_RETURN_ON_FALSE((store != NULL) && (eeprom != NULL),
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Store or EEPROM context is NULL");
+    ESP_RETURN_ON_FALSE((base_address % EEPROM_24LC256_PAGE_SIZE) == 0U,
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Record region is not page aligned");
+    ESP_RETURN_ON_FALSE((slot_count > EEPROM_KV_MAX_KEYS) &&
+                            (((uint32_t)base_address +
+                              ((uint32_t)slot_count * EEPROM_24LC256_PAGE_SIZE)) <=
+                             EEPROM_24LC256_CAPACITY_BYTES),
+                        ESP_ERR_INVALID_SIZE,
+                        TAG,
+                        "Invalid record region size");
+
+    memset(store, 0, sizeof(*store));
+    store->eeprom = eeprom;
+    store->base_address = base_address;
+    store->slot_count = slot_count;
+
+    uint8_t record[EEPROM_24LC256_PAGE_SIZE];
+    bool found = false;
+    uint32_t newest_sequence = 0;
+    uint16_t newest_slot = 0;
+
+    for (uint16_t slot = 0; slot < slot_count; ++slot) {
+        ESP_RETURN_ON_ERROR(eeprom_24lc256_read(eeprom,
+                                                slot_address(store, slot),
+                                                record,
+                                                sizeof(record)),
+                            TAG,
+                            "Failed to read record slot %u",
+                            slot);
+
+        if (!index_record(store, slot, record)) {
+            continue;
+        }
+
+        const uint32_t sequence = get_u32_le(&record[4]);
+        if (!found || (sequence > newest_sequence)) {
+            found = true;
+            newest_sequence = sequence;
+            newest_slot = slot;
+        }
+    }
+
+    // Continue the ring right after the newest record.
+    if (found) {
+        store->next_sequence = newest_sequence + 1U;
+        store->next_slot = (uint16_t)((newest_slot + 1U) % slot_count);
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Reads a value from the RAM index.
+ *
+ * @param store Initialized store context.
+ * @param key Key to read.
+ * @param value Destination buffer.
+ * @param value_size Size of the destination buffer.
+ * @param length Output pointer for the value length.
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+esp_err_t eeprom_kv_get(const eeprom_kv_t *store,
+                        uint8_t key,
+                        void *value,
+                        size_t value_size,
+                        size_t *length)
+{
+    ESP_RETURN_ON_FALSE((store != NULL) && (key < EEPROM_KV_MAX_KEYS),
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Invalid store or key");
+    ESP_RETURN_ON_FALSE((value != NULL) && (length != NULL),
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Output pointer is NULL");
+
+    const eeprom_kv_entry_t *entry = &store->entries[key];
+    if (!entry->valid) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    ESP_RETURN_ON_FALSE(entry->length <= value_size,
+                        ESP_ERR_INVALID_SIZE,
+                        TAG,
+                        "Value buffer is too small");
+
+    memcpy(value, entry->value, entry->length);
+    *length = entry->length;
+    return ESP_OK;
+}
+
+/**
+ * @brief Appends a new record for a key.
+ *
+ * @param store Initialized store context.
+ * @param key Key to write.
+ * @param value Value bytes.
+ * @param length Value length.
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+esp_err_t eeprom_kv_set(eeprom_kv_t *store,
+                        uint8_t key,
+                        const void *value,
+                        size_t length)
+{
+    ESP_RETURN_ON_FALSE((store != NULL) && (key < EEPROM_KV_MAX_KEYS),
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Invalid store or key");
+    ESP_RETURN_ON_FALSE((value != NULL) || (length == 0),
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Value is NULL");
+    ESP_RETURN_ON_FALSE(length <= EEPROM_KV_MAX_VALUE_SIZE,
+                        ESP_ERR_INVALID_SIZE,
+                        TAG,
+                        "Value is too large");
+
+    eeprom_kv_entry_t *entry = &store->entries[key];
+    if (entry->valid && (entry->length == length) &&
+        (memcmp(entry->value, value, length) == 0)) {
+        return ESP_OK;
+    }
+
+    // Never overwrite the latest record of any key, including this one, so a
+    // reset during the write always leaves the previous value readable.
+    uint16_t slot = store->next_slot;
+    while (slot_is_live(store, slot)) {
+        slot = (uint16_t)((slot + 1U) % store->slot_count);
+    }
+
+    uint8_t record[EEPROM_24LC256_PAGE_SIZE];
+    record[0] = EEPROM_KV_MAGIC;
+    record[1] = key;
+    record[2] = (uint8_t)length;
+    record[3] = 0xFF;
+    put_u32_le(&record[4], store->next_sequence);
+    if (length > 0) {
+        memcpy(&record[EEPROM_KV_HEADER_SIZE], value, length);
+    }
+
+    const size_t crc_offset = EEPROM_KV_HEADER_SIZE + length;
+    put_u32_le(&record[crc_offset], esp_rom_crc32_le(0, record, crc_offset));
+
+    ESP_RETURN_ON_ERROR(eeprom_24lc256_write(store->eeprom,
+                                             slot_address(store, slot),
+                                             record,
+                                             crc_offset + EEPROM_KV_CRC_SIZE),
+                        TAG,
+                        "Failed to write record slot %u",
+                        slot);
+    ESP_RETURN_ON_ERROR(eeprom_24lc256_flush(store->eeprom),
+                        TAG,
+                        "Failed to flush record slot %u",
+                        slot);
+
+    entry->valid = true;
+    entry->slot = slot;
+    entry->sequence = store->next_sequence;
+    entry->length = (uint8_t)length;
+    memcpy(entry->value, &record[EEPROM_KV_HEADER_SIZE], length);
+
+    store->next_sequence++;
+    store->next_slot = (uint16_t)((slot + 1U) % store->slot_count);
+    return ESP_OK;
+}
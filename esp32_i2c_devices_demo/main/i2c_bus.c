@@ -1,12 +1,34 @@
 #include "i2c_bus.h"
 
+#include <stdbool.h>
+
 #include "driver/gpio.h"
 #include "esp_check.h"
 #include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
 #include "sdkconfig.h"
 
+#define SCHEDULER_QUEUE_LENGTH   8
+#define SCHEDULER_TASK_STACK     3072
+#define SCHEDULER_TASK_PRIORITY  10
+
 static const char *TAG = "i2c_bus";
 static i2c_master_bus_handle_t s_bus_handle;
+static QueueHandle_t s_high_queue;
+static QueueHandle_t s_normal_queue;
+static TaskHandle_t s_scheduler_task;
+
+/**
+ * @brief Completion state shared between app_i2c_bus_execute() and the
+ *        scheduler task.
+ */
+typedef struct {
+    SemaphoreHandle_t done;
+    esp_err_t result;
+} sync_wait_t;
 
 /**
  * @brief Converts the configured integer port into an ESP-IDF port value.
@@ -18,6 +40,138 @@ static i2c_port_num_t get_i2c_port(void)
     return (i2c_port_num_t)CONFIG_APP_I2C_PORT;
 }
 
+/**
+ * @brief Runs one write-then-read transaction, or one chunk of a write.
+ *
+ * @param transaction Transaction to run.
+ * @param offset Number of write bytes already sent; advanced by this call.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+static esp_err_t run_step(const app_i2c_transaction_t *transaction,
+                          size_t *offset)
+{
+    if (transaction->read_length > 0) {
+        *offset = transaction->write_length;
+        return i2c_master_transmit_receive(transaction->device_handle,
+                                           transaction->write_data,
+                                           transaction->write_length,
+                                           transaction->read_data,
+                                           transaction->read_length,
+                                           transaction->timeout_ms);
+    }
+
+    size_t length = transaction->write_length - *offset;
+    if ((transaction->chunk_size > 0) && (length > transaction->chunk_size)) {
+        length = transaction->chunk_size;
+    }
+
+    // The prefix and the data slice go out as one transaction without a copy.
+    i2c_master_transmit_multi_buffer_info_t buffers[2];
+    size_t buffer_count = 0;
+
+    if (transaction->prefix_length > 0) {
+        buffers[buffer_count].write_buffer = (uint8_t *)transaction->prefix;
+        buffers[buffer_count].buffer_size = transaction->prefix_length;
+        ++buffer_count;
+    }
+
+    if (length > 0) {
+        buffers[buffer_count].write_buffer =
+            (uint8_t *)&transaction->write_data[*offset];
+        buffers[buffer_count].buffer_size = length;
+        ++buffer_count;
+    }
+
+    *offset += length;
+    return i2c_master_multi_buffer_transmit(transaction->device_handle,
+                                            buffers,
+                                            buffer_count,
+                                            transaction->timeout_ms);
+}
+
+/**
+ * @brief Reports the result of a finished transaction.
+ *
+ * @param transaction Finished transaction.
+ * @param result Transaction result.
+ */
+static void complete(const app_i2c_transaction_t *transaction,
+                     esp_err_t result)
+{
+    if (transaction->on_done != NULL) {
+        transaction->on_done(result, transaction->context);
+    }
+}
+
+/**
+ * @brief Scheduler task that owns all queued bus traffic.
+ *
+ * Queued high-priority transactions always run first. A normal transaction
+ * runs one chunk at a time, and the high-priority queue is checked again
+ * before each chunk, so a sensor read waits for at most one chunk.
+ *
+ * @param argument Unused task argument.
+ */
+static void scheduler_task(void *argument)
+{
+    (void)argument;
+
+    app_i2c_transaction_t current;
+    app_i2c_transaction_t urgent;
+    bool current_active = false;
+    size_t current_offset = 0;
+
+    while (true) {
+        if (xQueueReceive(s_high_queue, &urgent, 0) == pdTRUE) {
+            size_t offset = 0;
+            esp_err_t result = ESP_OK;
+
+            while ((result == ESP_OK) && (offset < urgent.write_length)) {
+                result = run_step(&urgent, &offset);
+            }
+            if ((result == ESP_OK) && (urgent.write_length == 0)) {
+                result = run_step(&urgent, &offset);
+            }
+
+            complete(&urgent, result);
+            continue;
+        }
+
+        if (!current_active) {
+            if (xQueueReceive(s_normal_queue, &current, 0) != pdTRUE) {
+                // A submit between the empty checks and here leaves a
+                // notification pending, so this cannot miss work.
+                (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+                continue;
+            }
+
+            current_active = true;
+            current_offset = 0;
+        }
+
+        const esp_err_t result = run_step(&current, &current_offset);
+        if ((result != ESP_OK) || (current_offset >= current.write_length)) {
+            complete(&current, result);
+            current_active = false;
+        }
+    }
+}
+
+/**
+ * @brief Completion callback used by app_i2c_bus_execute().
+ *
+ * @param result Transaction result.
+ * @param context Pointer to the caller's sync_wait_t.
+ */
+static void sync_done(esp_err_t result, void *context)
+{
+    sync_wait_t *wait = (sync_wait_t *)context;
+
+    wait->result = result;
+    xSemaphoreGive(wait->done);
+}
+
 /**
  * @brief Initializes the I2C bus.
  *
@@ -44,6 +198,22 @@ esp_err_t app_i2c_bus_init(void)
                         TAG,
                         "Failed to create I2C master bus");
 
+    s_high_queue = xQueueCreate(SCHEDULER_QUEUE_LENGTH,
+                                sizeof(app_i2c_transaction_t));
+    s_normal_queue = xQueueCreate(SCHEDULER_QUEUE_LENGTH,
+                                  sizeof(app_i2c_transaction_t));
+    if ((s_high_queue == NULL) || (s_normal_queue == NULL) ||
+        (xTaskCreate(scheduler_task,
+                     "i2c_sched",
+                     SCHEDULER_TASK_STACK,
+                     NULL,
+                     SCHEDULER_TASK_PRIORITY,
+                     &s_scheduler_task) != pdPASS)) {
+        ESP_LOGE(TAG, "Failed to start I2C bus scheduler");
+        (void)app_i2c_bus_deinit();
+        return ESP_ERR_NO_MEM;
+    }
+
     ESP_LOGI(TAG,
              "I2C bus initialized: port=%d SDA=%d SCL=%d",
              CONFIG_APP_I2C_PORT,
@@ -63,6 +233,20 @@ esp_err_t app_i2c_bus_deinit(void)
         return ESP_OK;
     }
 
+    // Queued transactions are dropped; callers must let the bus go idle first.
+    if (s_scheduler_task != NULL) {
+        vTaskDelete(s_scheduler_task);
+        s_scheduler_task = NULL;
+    }
+    if (s_high_queue != NULL) {
+        vQueueDelete(s_high_queue);
+        s_high_queue = NULL;
+    }
+    if (s_normal_queue != NULL) {
+        vQueueDelete(s_normal_queue);
+        s_normal_queue = NULL;
+    }
+
     ESP_RETURN_ON_ERROR(i2c_del_master_bus(s_bus_handle),
                         TAG,
                         "Failed to delete I2C master bus");
@@ -152,3 +336,83 @@ esp_err_t app_i2c_bus_probe(uint16_t address, int timeout_ms)
 
     return i2c_master_probe(s_bus_handle, address, timeout_ms);
 }
+
+/**
+ * @brief Queues a transaction for the bus scheduler.
+ *
+ * @param transaction Transaction to queue.
+ * @return ESP_OK if queued, otherwise an error code.
+ */
+esp_err_t app_i2c_bus_submit(const app_i2c_transaction_t *transaction)
+{
+    ESP_RETURN_ON_FALSE(s_scheduler_task != NULL,
+                        ESP_ERR_INVALID_STATE,
+                        TAG,
+                        "I2C bus is not initialized");
+    ESP_RETURN_ON_FALSE((transaction != NULL) &&
+                            (transaction->device_handle != NULL),
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Invalid I2C transaction");
+    ESP_RETURN_ON_FALSE((transaction->write_length == 0) ||
+                            (transaction->write_data != NULL),
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Write buffer is NULL");
+    ESP_RETURN_ON_FALSE((transaction->read_length == 0) ||
+                            (transaction->read_data != NULL),
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Read buffer is NULL");
+    ESP_RETURN_ON_FALSE((transaction->prefix_length == 0) ||
+                            (transaction->prefix != NULL),
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Prefix buffer is NULL");
+
+    QueueHandle_t queue = (transaction->priority == APP_I2C_PRIORITY_HIGH)
+                              ? s_high_queue
+                              : s_normal_queue;
+
+    ESP_RETURN_ON_FALSE(xQueueSend(queue, transaction, 0) == pdTRUE,
+                        ESP_ERR_NO_MEM,
+                        TAG,
+                        "I2C transaction queue is full");
+
+    xTaskNotifyGive(s_scheduler_task);
+    return ESP_OK;
+}
+
+/**
+ * @brief Queues a transaction and waits for its result.
+ *
+ * @param transaction Transaction to run.
+ * @return Result of the transaction, otherwise a queueing error code.
+ */
+esp_err_t app_i2c_bus_execute(const app_i2c_transaction_t *transaction)
+{
+    ESP_RETURN_ON_FALSE(transaction != NULL,
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Invalid I2C transaction");
+
+    StaticSemaphore_t semaphore_storage;
+    sync_wait_t wait = {
+        .done = xSemaphoreCreateBinaryStatic(&semaphore_storage),
+        .result = ESP_FAIL,
+    };
+
+    app_i2c_transaction_t queued = *transaction;
+    queued.on_done = sync_done;
+    queued.context = &wait;
+
+    ESP_RETURN_ON_ERROR(app_i2c_bus_submit(&queued),
+                        TAG,
+                        "Failed to queue I2C transaction");
+
+    // Every driver call has its own timeout, so completion always arrives.
+    (void)xSemaphoreTake(wait.done, portMAX_DELAY);
+    vSemaphoreDelete(wait.done);
+
+    return wait.result;
+}
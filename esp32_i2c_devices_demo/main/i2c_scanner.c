@@ -1,15 +1,229 @@
 #include "i2c_scanner.h"
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "driver/gpio.h"
+#include "esp_attr.h"
 #include "esp_check.h"
 #include "esp_log.h"
+#include "esp_rom_crc.h"
 #include "i2c_bus.h"
+#include "sdkconfig.h"
 
 #define I2C_FIRST_USABLE_ADDRESS 0x08
 #define I2C_LAST_USABLE_ADDRESS  0x77
-#define I2C_PROBE_TIMEOUT_MS      30
+#define I2C_FAULT_TIMEOUT_LIMIT   3
+#define I2C_SCAN_CACHE_CAPACITY   16
+#define I2C_SCAN_CACHE_MAGIC      0x5343414EU
+#define I2C_FINGERPRINT_NONE      0xFF
 
 static const char *TAG = "i2c_scanner";
 
+/**
+ * @brief Known chip whose identity can be read from an ID register.
+ */
+typedef struct {
+    uint8_t first_address;
+    uint8_t last_address;
+    uint8_t id_register;
+    uint8_t chip_id;
+    const char *name;
+} i2c_fingerprint_t;
+
+/**
+ * @brief Result of the last scan, kept across deep sleep when caching is on.
+ */
+typedef struct {
+    uint32_t magic;
+    uint8_t count;
+    uint8_t addresses[I2C_SCAN_CACHE_CAPACITY];
+    uint8_t fingerprints[I2C_SCAN_CACHE_CAPACITY];
+    uint32_t crc;
+} i2c_scan_cache_t;
+
+// Devices whose address alone is ambiguous, identified by WHO_AM_I-style
+// registers. Entries sharing an address range are tried in order.
+static const i2c_fingerprint_t s_fingerprints[] = {
+    {0x18, 0x19, 0x0F, 0x33, "LIS3DH"},
+    {0x1D, 0x1D, 0x00, 0xE5, "ADXL345"},
+    {0x1E, 0x1E, 0x0A, 0x48, "HMC5883L"},
+    {0x29, 0x29, 0xC0, 0xEE, "VL53L0X"},
+    {0x39, 0x39, 0x92, 0xAB, "APDS-9960"},
+    {0x53, 0x53, 0x00, 0xE5, "ADXL345"},
+    {0x5A, 0x5B, 0x20, 0x81, "CCS811"},
+    {0x68, 0x69, 0x75, 0x68, "MPU-6050"},
+    {0x68, 0x69, 0x75, 0x71, "MPU-9250"},
+    {0x68, 0x69, 0x00, 0xEA, "ICM-20948"},
+    {0x76, 0x77, 0xD0, 0x58, "BMP280"},
+    {0x76, 0x77, 0xD0, 0x60, "BME280"},
+    {0x76, 0x77, 0xD0, 0x61, "BME680"},
+};
+
+#if CONFIG_APP_I2C_SCAN_CACHE
+static RTC_DATA_ATTR i2c_scan_cache_t s_scan;
+#else
+static i2c_scan_cache_t s_scan;
+#endif
+
+/**
+ * @brief Computes the checksum of the scan result.
+ *
+ * @param scan Scan result.
+ * @return CRC-32 of every field before crc.
+ */
+static uint32_t scan_crc(const i2c_scan_cache_t *scan)
+{
+    return esp_rom_crc32_le(0,
+                            (const uint8_t *)scan,
+                            offsetof(i2c_scan_cache_t, crc));
+}
+
+/**
+ * @brief Reads a chip ID register and matches it against the table.
+ *
+ * @param address Address that acknowledged a probe.
+ * @return Index into s_fingerprints, or I2C_FINGERPRINT_NONE.
+ */
+static uint8_t fingerprint_device(uint8_t address)
+{
+    i2c_master_dev_handle_t device = NULL;
+    uint8_t result = I2C_FINGERPRINT_NONE;
+
+    for (size_t index = 0;
+         index < (sizeof(s_fingerprints) / sizeof(s_fingerprints[0]));
+         ++index) {
+        const i2c_fingerprint_t *entry = &s_fingerprints[index];
+        if ((address < entry->first_address) ||
+            (address > entry->last_address)) {
+            continue;
+        }
+
+        if ((device == NULL) &&
+            (app_i2c_bus_add_device(address,
+                                    CONFIG_APP_I2C_CLOCK_HZ,
+                                    &device) != ESP_OK)) {
+            break;
+        }
+
+        uint8_t chip_id = 0;
+        if ((i2c_master_transmit_receive(device,
+                                         &entry->id_register,
+                                         1,
+                                         &chip_id,
+                                         1,
+                                         CONFIG_APP_I2C_SCAN_PROBE_TIMEOUT_MS) == ESP_OK) &&
+            (chip_id == entry->chip_id)) {
+            result = (uint8_t)index;
+            break;
+        }
+    }
+
+    if (device != NULL) {
+        (void)app_i2c_bus_remove_device(device);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Checks that both bus lines are released before probing.
+ *
+ * @return True when SDA and SCL read high.
+ */
+static bool bus_lines_idle(void)
+{
+    return (gpio_get_level(CONFIG_APP_I2C_SDA_GPIO) == 1) &&
+           (gpio_get_level(CONFIG_APP_I2C_SCL_GPIO) == 1);
+}
+
+/**
+ * @brief Confirms that every cached address still responds.
+ *
+ * @return True when the cached scan result can be reused.
+ */
+static bool cached_scan_is_current(void)
+{
+#if CONFIG_APP_I2C_SCAN_CACHE
+    if ((s_scan.magic != I2C_SCAN_CACHE_MAGIC) ||
+        (s_scan.count > I2C_SCAN_CACHE_CAPACITY) ||
+        (s_scan.crc != scan_crc(&s_scan))) {
+        return false;
+    }
+
+    for (size_t index = 0; index < s_scan.count; ++index) {
+        if (app_i2c_bus_probe(s_scan.addresses[index],
+                              CONFIG_APP_I2C_SCAN_PROBE_TIMEOUT_MS) != ESP_OK) {
+            return false;
+        }
+    }
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Probes the whole address range into s_scan.
+ *
+ * @param found_count Output pointer to the number of found devices.
+ * @return ESP_OK after a completed scan, or ESP_ERR_TIMEOUT on a bus fault.
+ */
+static esp_err_t run_full_scan(size_t *found_count)
+{
+    memset(&s_scan, 0, sizeof(s_scan));
+
+    if (!bus_lines_idle()) {
+        ESP_LOGE(TAG, "SDA or SCL is held low; check pull-ups and wiring");
+        return ESP_ERR_TIMEOUT;
+    }
+
+    unsigned int consecutive_timeouts = 0;
+
+    for (uint16_t address = I2C_FIRST_USABLE_ADDRESS;
+         address <= I2C_LAST_USABLE_ADDRESS;
+         ++address) {
+        const esp_err_t result = app_i2c_bus_probe(address,
+                                                   CONFIG_APP_I2C_SCAN_PROBE_TIMEOUT_MS);
+
+        // A missing target NACKs at once. Timeouts mean the bus itself is not
+        // completing transfers, so stop instead of waiting on every address.
+        if (result == ESP_ERR_TIMEOUT) {
+            if (++consecutive_timeouts >= I2C_FAULT_TIMEOUT_LIMIT) {
+                ESP_LOGE(TAG,
+                         "Scan stopped at 0x%02X: bus is not responding",
+                         address);
+                return ESP_ERR_TIMEOUT;
+            }
+            continue;
+        }
+
+        consecutive_timeouts = 0;
+        if (result != ESP_OK) {
+            continue;
+        }
+
+        if (s_scan.count < I2C_SCAN_CACHE_CAPACITY) {
+            s_scan.addresses[s_scan.count] = (uint8_t)address;
+            s_scan.fingerprints[s_scan.count] =
+                fingerprint_device((uint8_t)address);
+            ++s_scan.count;
+        }
+
+        ++(*found_count);
+    }
+
+    // A result too large to cache is rescanned after the next wakeup.
+    if (*found_count <= I2C_SCAN_CACHE_CAPACITY) {
+        s_scan.magic = I2C_SCAN_CACHE_MAGIC;
+        s_scan.crc = scan_crc(&s_scan);
+    }
+
+    return ESP_OK;
+}
+
 /**
  * @brief Scans the I2C bus for devices.
  *
@@ -28,20 +242,28 @@ esp_err_t i2c_scanner_scan(uint8_t *addresses,
                         "found_count is NULL");
 
     *found_count = 0;
-    ESP_LOGI(TAG, "Scanning I2C addresses 0x08 through 0x77");
+    esp_err_t result = ESP_OK;
 
-    for (uint16_t address = I2C_FIRST_USABLE_ADDRESS;
-         address <= I2C_LAST_USABLE_ADDRESS;
-         ++address) {
-        const esp_err_t result = app_i2c_bus_probe(address,
-                                                   I2C_PROBE_TIMEOUT_MS);
+    if (cached_scan_is_current()) {
+        *found_count = s_scan.count;
+        ESP_LOGI(TAG, "Reusing cached scan of %u device(s)",
+                 (unsigned)*found_count);
+    } else {
+        ESP_LOGI(TAG, "Scanning I2C addresses 0x08 through 0x77");
+        result = run_full_scan(found_count);
+    }
 
-        if (result == ESP_OK) {
-            if ((addresses != NULL) && (*found_count < capacity)) {
-                addresses[*found_count] = (uint8_t)address;
-            }
+    for (size_t index = 0; index < s_scan.count; ++index) {
+        const uint8_t address = s_scan.addresses[index];
+
+        if ((addresses != NULL) && (index < capacity)) {
+            addresses[index] = address;
+        }
 
-            ++(*found_count);
+        const char *name = i2c_scanner_device_name(address);
+        if (name != NULL) {
+            ESP_LOGI(TAG, "Found device at 0x%02X (%s)", address, name);
+        } else {
             ESP_LOGI(TAG, "Found device at 0x%02X", address);
         }
     }
@@ -52,5 +274,25 @@ esp_err_t i2c_scanner_scan(uint8_t *addresses,
         ESP_LOGI(TAG, "Scan complete: %u device(s)", (unsigned)*found_count);
     }
 
-    return ESP_OK;
+    return result;
+}
+
+/**
+ * @brief Looks up the fingerprinted chip name of a scanned address.
+ *
+ * @param address Seven-bit I2C address.
+ * @return Chip name, or NULL when unknown.
+ */
+const char *i2c_scanner_device_name(uint8_t address)
+{
+    for (size_t index = 0; index < s_scan.count; ++index) {
+        const uint8_t fingerprint = s_scan.fingerprints[index];
+
+        if ((s_scan.addresses[index] == address) &&
+            (fingerprint < (sizeof(s_fingerprints) / sizeof(s_fingerprints[0])))) {
+            return s_fingerprints[fingerprint].name;
+        }
+    }
+
+    return NULL;
 }
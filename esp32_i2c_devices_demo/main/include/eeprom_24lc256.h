@@ -13,11 +13,22 @@
 
 /**
  * @brief 24LC256 EEPROM driver context.
+ *
+ * Writes are staged one page at a time in page_buffer, so several small
+ * writes to the same page cost a single write cycle. After a page write the
+ * driver returns at once; the next access waits for the write cycle by ACK
+ * polling instead of sleeping for a fixed time.
  */
 typedef struct {
     i2c_master_dev_handle_t device_handle;
     uint8_t address;
     bool initialized;
+    bool write_in_progress;
+    bool page_staged;
+    uint16_t staged_page;
+    uint8_t staged_start;
+    uint8_t staged_end;
+    uint8_t page_buffer[EEPROM_24LC256_PAGE_SIZE];
 } eeprom_24lc256_t;
 
 /**
@@ -36,6 +47,8 @@ esp_err_t eeprom_24lc256_init(eeprom_24lc256_t *eeprom,
 /**
  * @brief Reads bytes from EEPROM memory.
  *
+ * Staged writes are committed first, so the read returns the latest data.
+ *
  * @param eeprom Initialized EEPROM context.
  * @param memory_address First 16-bit memory address to read.
  * @param data Destination buffer.
@@ -43,7 +56,7 @@ esp_err_t eeprom_24lc256_init(eeprom_24lc256_t *eeprom,
  *
  * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
  */
-esp_err_t eeprom_24lc256_read(const eeprom_24lc256_t *eeprom,
+esp_err_t eeprom_24lc256_read(eeprom_24lc256_t *eeprom,
                               uint16_t memory_address,
                               uint8_t *data,
                               size_t data_length);
@@ -51,6 +64,15 @@ esp_err_t eeprom_24lc256_read(const eeprom_24lc256_t *eeprom,
 /**
  * @brief Writes bytes while respecting 64-byte EEPROM page boundaries.
  *
+ * Every page touched is staged in the context before it is written. A page
+ * is written as soon as it is complete, or when a later write, read, flush,
+ * or deinit moves on. The last partial page of a write can therefore remain
+ * staged after this function returns; call eeprom_24lc256_flush() when the
+ * data must be in nonvolatile memory.
+ *
+ * Writes to separate parts of one page are merged into one write cycle. The
+ * bytes between them are read back from the EEPROM first.
+ *
  * @param eeprom Initialized EEPROM context.
  * @param memory_address First 16-bit memory address to write.
  * @param data Source buffer.
@@ -58,13 +80,24 @@ esp_err_t eeprom_24lc256_read(const eeprom_24lc256_t *eeprom,
  *
  * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
  */
-esp_err_t eeprom_24lc256_write(const eeprom_24lc256_t *eeprom,
+esp_err_t eeprom_24lc256_write(eeprom_24lc256_t *eeprom,
                                uint16_t memory_address,
                                const uint8_t *data,
                                size_t data_length);
 
 /**
- * @brief Releases the EEPROM device handle.
+ * @brief Commits the staged page and waits until its write cycle finishes.
+ *
+ * @param eeprom Initialized EEPROM context.
+ *
+ * @return ESP_OK on success. ESP_ERR_TIMEOUT when the EEPROM does not
+ *         acknowledge within the maximum write cycle time. Otherwise, an
+ *         ESP-IDF error code is returned.
+ */
+esp_err_t eeprom_24lc256_flush(eeprom_24lc256_t *eeprom);
+
+/**
+ * @brief Flushes staged data and releases the EEPROM device handle.
  *
  * @param eeprom Driver context to deinitialize.
  *
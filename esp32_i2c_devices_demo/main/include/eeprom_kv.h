@@ -0,0 +1,99 @@
+#ifndef EEPROM_KV_H
+#define EEPROM_KV_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "eeprom_24lc256.h"
+#include "esp_err.h"
+
+#define EEPROM_KV_MAX_KEYS        8U
+#define EEPROM_KV_RECORD_OVERHEAD 12U
+#define EEPROM_KV_MAX_VALUE_SIZE  (EEPROM_24LC256_PAGE_SIZE - EEPROM_KV_RECORD_OVERHEAD)
+
+/**
+ * @brief Latest stored value of one key, cached in RAM.
+ */
+typedef struct {
+    bool valid;
+    uint16_t slot;
+    uint32_t sequence;
+    uint8_t length;
+    uint8_t value[EEPROM_KV_MAX_VALUE_SIZE];
+} eeprom_kv_entry_t;
+
+/**
+ * @brief Wear-levelled key/value store context.
+ *
+ * The store owns a region of whole EEPROM pages. Each page is one record
+ * slot holding a key, a sequence number, the value, and a CRC-32. Updates are
+ * appended to the next free slot in a ring, so repeated updates of one key
+ * are spread across the region instead of wearing out a single page. The
+ * latest record of every key is found at boot and kept in RAM.
+ */
+typedef struct {
+    eeprom_24lc256_t *eeprom;
+    uint16_t base_address;
+    uint16_t slot_count;
+    uint16_t next_slot;
+    uint32_t next_sequence;
+    eeprom_kv_entry_t entries[EEPROM_KV_MAX_KEYS];
+} eeprom_kv_t;
+
+/**
+ * @brief Scans the record region and builds the RAM index.
+ *
+ * Slots with a bad CRC, for example from a write interrupted by a reset, are
+ * ignored; the previous record of that key stays valid.
+ *
+ * @param store Store context to initialize.
+ * @param eeprom Initialized EEPROM context. It must outlive the store.
+ * @param base_address Page-aligned first address of the record region.
+ * @param slot_count Number of pages in the region. It must be larger than
+ *        EEPROM_KV_MAX_KEYS so a free slot always exists.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+esp_err_t eeprom_kv_init(eeprom_kv_t *store,
+                         eeprom_24lc256_t *eeprom,
+                         uint16_t base_address,
+                         uint16_t slot_count);
+
+/**
+ * @brief Copies the latest value of a key from the RAM index.
+ *
+ * @param store Initialized store context.
+ * @param key Key from 0 to EEPROM_KV_MAX_KEYS - 1.
+ * @param value Destination buffer.
+ * @param value_size Size of the destination buffer in bytes.
+ * @param length Output pointer that receives the stored value length.
+ *
+ * @return ESP_OK on success. ESP_ERR_NOT_FOUND when the key has no value, or
+ *         ESP_ERR_INVALID_SIZE when the value does not fit in the buffer.
+ */
+esp_err_t eeprom_kv_get(const eeprom_kv_t *store,
+                        uint8_t key,
+                        void *value,
+                        size_t value_size,
+                        size_t *length);
+
+/**
+ * @brief Stores a new value for a key.
+ *
+ * The record is written to the next free slot and flushed before the RAM
+ * index is updated. Storing the value a key already has writes nothing.
+ *
+ * @param store Initialized store context.
+ * @param key Key from 0 to EEPROM_KV_MAX_KEYS - 1.
+ * @param value Value bytes.
+ * @param length Value length, at most EEPROM_KV_MAX_VALUE_SIZE bytes.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+esp_err_t eeprom_kv_set(eeprom_kv_t *store,
+                        uint8_t key,
+                        const void *value,
+                        size_t length);
+
+#endif
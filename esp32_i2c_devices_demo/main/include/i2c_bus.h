@@ -68,4 +68,76 @@ esp_err_t app_i2c_bus_remove_device(i2c_master_dev_handle_t device_handle);
  */
 esp_err_t app_i2c_bus_probe(uint16_t address, int timeout_ms);
 
+/**
+ * @brief Scheduling class of a queued bus transaction.
+ *
+ * High-priority transactions run before any queued normal transaction and
+ * may run between the chunks of a normal transaction that is in progress.
+ */
+typedef enum {
+    APP_I2C_PRIORITY_HIGH,
+    APP_I2C_PRIORITY_NORMAL,
+} app_i2c_priority_t;
+
+/**
+ * @brief Completion callback of a queued bus transaction.
+ *
+ * The callback runs in the bus scheduler task. It must not block and must not
+ * wait for another transaction to complete.
+ *
+ * @param result ESP_OK, or the first error reported by the I2C driver.
+ * @param context Value of app_i2c_transaction_t::context.
+ */
+typedef void (*app_i2c_done_cb_t)(esp_err_t result, void *context);
+
+/**
+ * @brief One transaction for the bus scheduler.
+ *
+ * When read_length is nonzero the transaction is a write followed by a
+ * repeated-start read, and it is never chunked. Otherwise it is a write. A
+ * write with chunk_size greater than zero is split into transactions of at
+ * most chunk_size data bytes, each preceded by the prefix bytes, so that
+ * high-priority transactions can run in between.
+ *
+ * All buffers must stay valid until the completion callback runs.
+ */
+typedef struct {
+    i2c_master_dev_handle_t device_handle;
+    app_i2c_priority_t priority;
+    const uint8_t *prefix;
+    size_t prefix_length;
+    const uint8_t *write_data;
+    size_t write_length;
+    uint8_t *read_data;
+    size_t read_length;
+    size_t chunk_size;
+    int timeout_ms;
+    app_i2c_done_cb_t on_done;
+    void *context;
+} app_i2c_transaction_t;
+
+/**
+ * @brief Queues a transaction without waiting for it.
+ *
+ * The descriptor is copied, but the buffers it points to are not.
+ *
+ * @param transaction Transaction to queue.
+ *
+ * @return ESP_OK when queued. ESP_ERR_INVALID_STATE when the bus is not
+ *         initialized, or ESP_ERR_NO_MEM when the priority queue is full.
+ */
+esp_err_t app_i2c_bus_submit(const app_i2c_transaction_t *transaction);
+
+/**
+ * @brief Queues a transaction and waits until it completes.
+ *
+ * The on_done and context fields of the transaction are ignored. Must not be
+ * called from a completion callback.
+ *
+ * @param transaction Transaction to run.
+ *
+ * @return Result of the transaction, or an error from app_i2c_bus_submit().
+ */
+esp_err_t app_i2c_bus_execute(const app_i2c_transaction_t *transaction);
+
 #endif
@@ -9,6 +9,16 @@
 /**
  * @brief Scans the usable seven-bit I2C address range.
  *
+ * Each address is probed with the short APP_I2C_SCAN_PROBE_TIMEOUT_MS
+ * timeout. The scan stops early when SDA or SCL is held low before it starts,
+ * or when several probes in a row time out, which points to missing pull-ups
+ * or a stuck target rather than absent devices.
+ *
+ * Responding addresses are matched against a table of known chip ID
+ * registers. When APP_I2C_SCAN_CACHE is enabled, the result is kept in RTC
+ * memory. After a deep sleep wakeup only the cached addresses are probed, and
+ * the full scan runs only if one of them no longer responds.
+ *
  * @param addresses Optional output array that receives discovered addresses.
  * @param capacity Number of entries available in the output array.
  * @param found_count Output pointer that receives the number of detected
@@ -16,10 +26,21 @@
  *        is too small.
  *
  * @return ESP_OK after a completed scan. ESP_ERR_INVALID_ARG is returned when
- *         found_count is NULL.
+ *         found_count is NULL, and ESP_ERR_TIMEOUT when a bus fault stopped
+ *         the scan. found_count is valid in both cases.
  */
 esp_err_t i2c_scanner_scan(uint8_t *addresses,
                            size_t capacity,
                            size_t *found_count);
 
+/**
+ * @brief Returns the chip identified at an address by the last scan.
+ *
+ * @param address Seven-bit I2C address.
+ *
+ * @return Chip name, or NULL when the address did not respond or its chip ID
+ *         did not match the fingerprint table.
+ */
+const char *i2c_scanner_device_name(uint8_t address);
+
 #endif
@@ -0,0 +1,92 @@
+#ifndef SENSOR_POLLER_H
+#define SENSOR_POLLER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#define SENSOR_POLLER_MAX_DEVICES 16
+#define SENSOR_POLLER_MAX_BUSES   2
+
+/**
+ * @brief Reads one device.
+ *
+ * The function runs in the poller task of the device's bus and should store
+ * its result in the context. While it blocks, other devices of the same bus
+ * wait, so long waits such as a one-shot conversion delay them.
+ *
+ * @param context Context pointer from the device table entry.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+typedef esp_err_t (*sensor_poller_read_t)(void *context);
+
+/**
+ * @brief One entry of the polling table.
+ *
+ * Devices with the same bus value share one poller task and are read one at
+ * a time. Use a separate bus value for each physical I2C bus so the buses
+ * are polled concurrently.
+ */
+typedef struct {
+    const char *name;
+    uint8_t bus;
+    uint32_t period_ms;
+    uint8_t priority;
+    sensor_poller_read_t read;
+    void *context;
+} sensor_poller_device_t;
+
+/**
+ * @brief Read statistics of one device.
+ *
+ * Latency is measured around the read function, so it includes time spent
+ * waiting for the bus as well as the transfer itself. A missed deadline is
+ * counted when a read starts one full period or more after it was due.
+ */
+typedef struct {
+    uint32_t reads;
+    uint32_t errors;
+    uint32_t missed_deadlines;
+    uint32_t last_latency_us;
+    uint32_t max_latency_us;
+    uint64_t total_latency_us;
+} sensor_poller_stats_t;
+
+/**
+ * @brief Starts polling the devices in a table.
+ *
+ * One task is created per bus that appears in the table. Each task keeps the
+ * next deadline of its devices, sleeps until the earliest one, and then reads
+ * every device that is due back to back in deadline order. Devices due at
+ * the same time are read in ascending priority value, so 0 runs first.
+ *
+ * The table is not copied and must stay valid while polling runs.
+ *
+ * @param devices Device table.
+ * @param count Number of entries, at most SENSOR_POLLER_MAX_DEVICES.
+ *
+ * @return ESP_OK on success. ESP_ERR_INVALID_STATE when polling already runs.
+ *         Otherwise, an ESP-IDF error code is returned.
+ */
+esp_err_t sensor_poller_start(const sensor_poller_device_t *devices,
+                              size_t count);
+
+/**
+ * @brief Copies the statistics of one device.
+ *
+ * @param index Index of the device in the table passed to
+ *        sensor_poller_start().
+ * @param stats Output pointer that receives the statistics.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+esp_err_t sensor_poller_get_stats(size_t index, sensor_poller_stats_t *stats);
+
+/**
+ * @brief Logs the statistics of every polled device.
+ */
+void sensor_poller_log_stats(void);
+
+#endif
@@ -9,15 +9,22 @@
 
 #define SSD1306_WIDTH 128
 #define SSD1306_HEIGHT 64
+#define SSD1306_PAGE_COUNT (SSD1306_HEIGHT / 8)
 #define SSD1306_FRAMEBUFFER_SIZE (SSD1306_WIDTH * SSD1306_HEIGHT / 8)
 
 /**
  * @brief SSD1306 display context for a 128x64 monochrome panel.
+ *
+ * Drawing functions record which pages and columns changed, and
+ * ssd1306_refresh() sends only that region, straight from the framebuffer.
  */
 typedef struct {
     i2c_master_dev_handle_t device_handle;
     uint8_t address;
     uint8_t framebuffer[SSD1306_FRAMEBUFFER_SIZE];
+    uint8_t dirty_pages;
+    uint8_t dirty_column_start;
+    uint8_t dirty_column_end;
     bool initialized;
 } ssd1306_t;
 
@@ -62,13 +69,18 @@ void ssd1306_draw_pixel(ssd1306_t *display,
 void ssd1306_draw_demo_pattern(ssd1306_t *display);
 
 /**
- * @brief Sends the complete framebuffer to the display.
+ * @brief Sends the changed part of the framebuffer to the display.
+ *
+ * The changed pages and columns are sent as one address window. The data is
+ * queued on the bus scheduler at normal priority in page-sized chunks, so
+ * high-priority sensor reads are not held up by a full-screen update.
+ * Nothing is sent when the framebuffer is unchanged.
  *
  * @param display Initialized display context.
  *
  * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
  */
-esp_err_t ssd1306_refresh(const ssd1306_t *display);
+esp_err_t ssd1306_refresh(ssd1306_t *display);
 
 /**
  * @brief Releases the SSD1306 device handle.
@@ -7,12 +7,49 @@
 #include "driver/i2c_master.h"
 #include "esp_err.h"
 
+/**
+ * @brief Conversion rate in continuous-conversion mode.
+ */
+typedef enum {
+    TMP102_RATE_0_25_HZ = 0,
+    TMP102_RATE_1_HZ = 1,
+    TMP102_RATE_4_HZ = 2,
+    TMP102_RATE_8_HZ = 3,
+} tmp102_conversion_rate_t;
+
+/**
+ * @brief Behavior of the ALERT output.
+ */
+typedef enum {
+    /** ALERT is active while the temperature is above the high limit, until
+     *  it falls below the low limit (thermostat with hysteresis). */
+    TMP102_ALERT_COMPARATOR = 0,
+    /** ALERT pulses active on each limit crossing and stays active until any
+     *  register is read. */
+    TMP102_ALERT_INTERRUPT = 1,
+} tmp102_alert_mode_t;
+
+/**
+ * @brief TMP102 operating configuration.
+ */
+typedef struct {
+    tmp102_conversion_rate_t conversion_rate;
+    bool extended_mode;          /**< 13-bit range up to 150 C. */
+    bool shutdown;               /**< Stop converting; use tmp102_read_one_shot_c(). */
+    tmp102_alert_mode_t alert_mode;
+    bool alert_active_high;
+    uint8_t fault_queue;         /**< Consecutive faults before ALERT: 1, 2, 4, or 6. */
+    float low_limit_c;
+    float high_limit_c;
+} tmp102_config_t;
+
 /**
  * @brief TMP102 device context.
  */
 typedef struct {
     i2c_master_dev_handle_t device_handle;
     uint8_t address;
+    uint8_t configuration[2];
     bool initialized;
 } tmp102_t;
 
@@ -40,6 +77,31 @@ esp_err_t tmp102_init(tmp102_t *sensor,
 esp_err_t tmp102_read_temperature_c(const tmp102_t *sensor,
                                     float *temperature_c);
 
+/**
+ * @brief Writes the limit registers and the configuration register.
+ *
+ * @param sensor Initialized driver context.
+ * @param config Configuration to apply.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+esp_err_t tmp102_configure(tmp102_t *sensor, const tmp102_config_t *config);
+
+/**
+ * @brief Runs one conversion in shutdown mode and reads the result.
+ *
+ * The sensor must be configured with shutdown set. It stays in shutdown
+ * between calls and draws about 0.5 uA.
+ *
+ * @param sensor Initialized driver context.
+ * @param temperature_c Output pointer that receives temperature in degrees C.
+ *
+ * @return ESP_OK on success. ESP_ERR_TIMEOUT when the conversion does not
+ *         finish. Otherwise, an ESP-IDF error code is returned.
+ */
+esp_err_t tmp102_read_one_shot_c(const tmp102_t *sensor,
+                                 float *temperature_c);
+
 /**
  * @brief Releases the TMP102 device handle.
  *
@@ -0,0 +1,220 @@
+#include "sensor_poller.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define POLLER_TASK_STACK     3072
+#define POLLER_TASK_PRIORITY  5
+
+static const char *TAG = "sensor_poller";
+static const sensor_poller_device_t *s_devices;
+static size_t s_device_count;
+static int64_t s_next_due_us[SENSOR_POLLER_MAX_DEVICES];
+static sensor_poller_stats_t s_stats[SENSOR_POLLER_MAX_DEVICES];
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * @brief Finds the device of a bus with the earliest deadline.
+ *
+ * @param bus Bus index.
+ * @return Table index of the device. Ties go to the lower priority value.
+ */
+static size_t earliest_device(uint8_t bus)
+{
+    size_t earliest = SENSOR_POLLER_MAX_DEVICES;
+
+    for (size_t index = 0; index < s_device_count; ++index) {
+        if (s_devices[index].bus != bus) {
+            continue;
+        }
+
+        if ((earliest == SENSOR_POLLER_MAX_DEVICES) ||
+            (s_next_due_us[index] < s_next_due_us[earliest]) ||
+            ((s_next_due_us[index] == s_next_due_us[earliest]) &&
+             (s_devices[index].priority < s_devices[earliest].priority))) {
+            earliest = index;
+        }
+    }
+
+    return earliest;
+}
+
+/**
+ * @brief Reads one due device and records its statistics.
+ *
+ * @param index Table index of the device.
+ */
+static void read_device(size_t index)
+{
+    const sensor_poller_device_t *device = &s_devices[index];
+    const int64_t period_us = (int64_t)device->period_ms * 1000;
+
+    const int64_t start_us = esp_timer_get_time();
+    const esp_err_t result = device->read(device->context);
+    const uint32_t latency_us = (uint32_t)(esp_timer_get_time() - start_us);
+
+    // Deadlines advance at a fixed rate. A device that fell a whole period
+    // behind is realigned instead of being read several times in a row.
+    int64_t next_due_us = s_next_due_us[index] + period_us;
+    const bool missed = (next_due_us <= start_us);
+    if (missed) {
+        next_due_us = start_us + period_us;
+    }
+    s_next_due_us[index] = next_due_us;
+
+    portENTER_CRITICAL(&s_stats_lock);
+    sensor_poller_stats_t *stats = &s_stats[index];
+    ++stats->reads;
+    if (result != ESP_OK) {
+        ++stats->errors;
+    }
+    if (missed) {
+        ++stats->missed_deadlines;
+    }
+    stats->last_latency_us = latency_us;
+    if (latency_us > stats->max_latency_us) {
+        stats->max_latency_us = latency_us;
+    }
+    stats->total_latency_us += latency_us;
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    if (result != ESP_OK) {
+        ESP_LOGW(TAG, "%s read failed: %s", device->name,
+                 esp_err_to_name(result));
+    }
+}
+
+/**
+ * @brief Polls the devices of one bus in earliest-deadline order.
+ *
+ * @param argument Bus index cast to a pointer.
+ */
+static void poller_task(void *argument)
+{
+    const uint8_t bus = (uint8_t)(uintptr_t)argument;
+
+    while (true) {
+        const size_t index = earliest_device(bus);
+        const int64_t wait_us = s_next_due_us[index] - esp_timer_get_time();
+
+        if (wait_us > 0) {
+            const TickType_t ticks = pdMS_TO_TICKS((uint32_t)((wait_us + 999) / 1000));
+            vTaskDelay((ticks > 0) ? ticks : 1);
+            continue;
+        }
+
+        // Every device already due is read back to back before sleeping.
+        read_device(index);
+    }
+}
+
+/**
+ * @brief Validates the table and starts one poller task per bus.
+ *
+ * @param devices Device table.
+ * @param count Number of entries.
+ * @return ESP_OK if successful, otherwise an error code.
+ */
+esp_err_t sensor_poller_start(const sensor_poller_device_t *devices,
+                              size_t count)
+{
+    ESP_RETURN_ON_FALSE(s_devices == NULL,
+                        ESP_ERR_INVALID_STATE,
+                        TAG,
+                        "Polling already started");
+    ESP_RETURN_ON_FALSE((devices != NULL) && (count > 0) &&
+                            (count <= SENSOR_POLLER_MAX_DEVICES),
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Invalid device table");
+
+    bool bus_used[SENSOR_POLLER_MAX_BUSES] = {false};
+
+    for (size_t index = 0; index < count; ++index) {
+        ESP_RETURN_ON_FALSE((devices[index].read != NULL) &&
+                                (devices[index].period_ms > 0) &&
+                                (devices[index].bus < SENSOR_POLLER_MAX_BUSES),
+                            ESP_ERR_INVALID_ARG,
+                            TAG,
+                            "Invalid entry for device %u",
+                            (unsigned)index);
+        bus_used[devices[index].bus] = true;
+    }
+
+    const int64_t now_us = esp_timer_get_time();
+    for (size_t index = 0; index < count; ++index) {
+        s_next_due_us[index] = now_us;
+    }
+    memset(s_stats, 0, sizeof(s_stats));
+    s_devices = devices;
+    s_device_count = count;
+
+    for (uint8_t bus = 0; bus < SENSOR_POLLER_MAX_BUSES; ++bus) {
+        if (!bus_used[bus]) {
+            continue;
+        }
+
+        ESP_RETURN_ON_FALSE(xTaskCreate(poller_task,
+                                        "sensor_poller",
+                                        POLLER_TASK_STACK,
+                                        (void *)(uintptr_t)bus,
+                                        POLLER_TASK_PRIORITY,
+                                        NULL) == pdPASS,
+                            ESP_ERR_NO_MEM,
+                            TAG,
+                            "Failed to create poller task for bus %u",
+                            bus);
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Copies the statistics of one device.
+ *
+ * @param index Table index of the device.
+ * @param stats Output pointer for the statistics.
+ * @return ESP_OK if successful, otherwise an error code.
+ */
+esp_err_t sensor_poller_get_stats(size_t index, sensor_poller_stats_t *stats)
+{
+    ESP_RETURN_ON_FALSE((index < s_device_count) && (stats != NULL),
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Invalid device index or output pointer");
+
+    portENTER_CRITICAL(&s_stats_lock);
+    *stats = s_stats[index];
+    portEXIT_CRITICAL(&s_stats_lock);
+    return ESP_OK;
+}
+
+/**
+ * @brief Logs one line of statistics per device.
+ */
+void sensor_poller_log_stats(void)
+{
+    for (size_t index = 0; index < s_device_count; ++index) {
+        sensor_poller_stats_t stats;
+        (void)sensor_poller_get_stats(index, &stats);
+
+        const uint32_t average_us =
+            (stats.reads > 0) ? (uint32_t)(stats.total_latency_us / stats.reads)
+                              : 0;
+
+        ESP_LOGI(TAG,
+                 "%s: reads=%lu errors=%lu missed=%lu latency avg=%lu max=%lu us",
+                 s_devices[index].name,
+                 (unsigned long)stats.reads,
+                 (unsigned long)stats.errors,
+                 (unsigned long)stats.missed_deadlines,
+                 (unsigned long)average_us,
+                 (unsigned long)stats.max_latency_us);
+    }
+}
@@ -10,9 +10,12 @@
 #define SSD1306_CONTROL_COMMAND 0x00
 #define SSD1306_CONTROL_DATA    0x40
 #define SSD1306_TIMEOUT_MS      200
-#define SSD1306_PAGE_COUNT      8
+#define SSD1306_ALL_PAGES       0xFF
+#define SSD1306_CHUNK_SIZE      SSD1306_WIDTH
 
 static const char *TAG = "ssd1306";
+static const uint8_t s_command_control = SSD1306_CONTROL_COMMAND;
+static const uint8_t s_data_control = SSD1306_CONTROL_DATA;
 
 /**
  * @brief Sends a sequence of command bytes to the display.
@@ -36,53 +39,75 @@ static esp_err_t write_commands(const ssd1306_t *display,
                         TAG,
                         "Command buffer is NULL");
 
-    uint8_t buffer[32];
-    ESP_RETURN_ON_FALSE(command_count <= (sizeof(buffer) - 1),
-                        ESP_ERR_INVALID_SIZE,
-                        TAG,
-                        "Command sequence is too large");
+    const app_i2c_transaction_t transaction = {
+        .device_handle = display->device_handle,
+        .priority = APP_I2C_PRIORITY_NORMAL,
+        .prefix = &s_command_control,
+        .prefix_length = sizeof(s_command_control),
+        .write_data = commands,
+        .write_length = command_count,
+        .timeout_ms = SSD1306_TIMEOUT_MS,
+    };
 
-    buffer[0] = SSD1306_CONTROL_COMMAND;
-    memcpy(&buffer[1], commands, command_count);
+    return app_i2c_bus_execute(&transaction);
+}
 
-    return i2c_master_transmit(display->device_handle,
-                               buffer,
-                               command_count + 1,
-                               SSD1306_TIMEOUT_MS);
+/**
+ * @brief Marks a column range of one or more pages as changed.
+ *
+ * @param display Display context.
+ * @param pages Bit mask of changed pages.
+ * @param column_start First changed column.
+ * @param column_end Last changed column.
+ */
+static void mark_dirty(ssd1306_t *display,
+                       uint8_t pages,
+                       uint8_t column_start,
+                       uint8_t column_end)
+{
+    if (display->dirty_pages == 0U) {
+        display->dirty_column_start = column_start;
+        display->dirty_column_end = column_end;
+    } else {
+        if (column_start < display->dirty_column_start) {
+            display->dirty_column_start = column_start;
+        }
+        if (column_end > display->dirty_column_end) {
+            display->dirty_column_end = column_end;
+        }
+    }
+
+    display->dirty_pages |= pages;
 }
 
 /**
- * @brief Sends one display page from the framebuffer.
+ * @brief Sends a framebuffer window through the bus scheduler.
+ *
+ * The window goes out in place, in chunks of one page width, each preceded
+ * by the data control byte. Queued sensor reads can run between chunks.
  *
  * @param display Initialized display context.
- * @param page Page number from 0 through 7.
+ * @param offset Framebuffer offset of the first byte.
+ * @param length Number of bytes to send.
  *
  * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
  */
-static esp_err_t write_page(const ssd1306_t *display, uint8_t page)
+static esp_err_t write_data(const ssd1306_t *display,
+                            size_t offset,
+                            size_t length)
 {
-    uint8_t page_buffer[SSD1306_WIDTH + 1];
-    page_buffer[0] = SSD1306_CONTROL_DATA;
-    memcpy(&page_buffer[1],
-           &display->framebuffer[(size_t)page * SSD1306_WIDTH],
-           SSD1306_WIDTH);
-
-    const uint8_t page_commands[] = {
-        (uint8_t)(0xB0U | page),
-        0x00,
-        0x10,
+    const app_i2c_transaction_t transaction = {
+        .device_handle = display->device_handle,
+        .priority = APP_I2C_PRIORITY_NORMAL,
+        .prefix = &s_data_control,
+        .prefix_length = sizeof(s_data_control),
+        .write_data = &display->framebuffer[offset],
+        .write_length = length,
+        .chunk_size = SSD1306_CHUNK_SIZE,
+        .timeout_ms = SSD1306_TIMEOUT_MS,
     };
 
-    ESP_RETURN_ON_ERROR(write_commands(display,
-                                       page_commands,
-                                       sizeof(page_commands)),
-                        TAG,
-                        "Failed to select SSD1306 page");
-
-    return i2c_master_transmit(display->device_handle,
-                               page_buffer,
-                               sizeof(page_buffer),
-                               SSD1306_TIMEOUT_MS);
+    return app_i2c_bus_execute(&transaction);
 }
 
 /**
@@ -161,6 +186,7 @@ void ssd1306_clear(ssd1306_t *display)
     }
 
     memset(display->framebuffer, 0, sizeof(display->framebuffer));
+    mark_dirty(display, SSD1306_ALL_PAGES, 0, SSD1306_WIDTH - 1);
 }
 
 /**
@@ -184,12 +210,17 @@ void ssd1306_draw_pixel(ssd1306_t *display,
 
     const size_t index = (size_t)x + ((size_t)(y / 8U) * SSD1306_WIDTH);
     const uint8_t mask = (uint8_t)(1U << (y % 8U));
+    const uint8_t previous = display->framebuffer[index];
 
     if (enabled) {
         display->framebuffer[index] |= mask;
     } else {
         display->framebuffer[index] &= (uint8_t)~mask;
     }
+
+    if (display->framebuffer[index] != previous) {
+        mark_dirty(display, (uint8_t)(1U << (y / 8U)), x, x);
+    }
 }
 
 /**
@@ -238,7 +269,7 @@ void ssd1306_draw_demo_pattern(ssd1306_t *display)
  * @param display Initialized display context.
  * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
  */
-esp_err_t ssd1306_refresh(const ssd1306_t *display)
+esp_err_t ssd1306_refresh(ssd1306_t *display)
 {
     ESP_RETURN_ON_FALSE(display != NULL,
                         ESP_ERR_INVALID_ARG,
@@ -249,13 +280,54 @@ esp_err_t ssd1306_refresh(const ssd1306_t *display)
                         TAG,
                         "SSD1306 is not initialized");
 
-    for (uint8_t page = 0; page < SSD1306_PAGE_COUNT; ++page) {
-        ESP_RETURN_ON_ERROR(write_page(display, page),
-                            TAG,
-                            "Failed to update SSD1306 page %u",
-                            page);
+    if (display->dirty_pages == 0U) {
+        return ESP_OK;
+    }
+
+    uint8_t page_start = 0;
+    while ((display->dirty_pages & (1U << page_start)) == 0U) {
+        ++page_start;
+    }
+
+    uint8_t page_end = SSD1306_PAGE_COUNT - 1;
+    while ((display->dirty_pages & (1U << page_end)) == 0U) {
+        --page_end;
+    }
+
+    uint8_t column_start = display->dirty_column_start;
+    uint8_t column_end = display->dirty_column_end;
+
+    // Across several pages, a partial column range is not contiguous in the
+    // framebuffer, so send whole pages to keep it to one data transaction.
+    if (page_start != page_end) {
+        column_start = 0;
+        column_end = SSD1306_WIDTH - 1;
     }
 
+    // Horizontal addressing wraps inside this window, so the data can follow
+    // as one stream.
+    const uint8_t window_commands[] = {
+        0x21, column_start, column_end,
+        0x22, page_start, page_end,
+    };
+
+    ESP_RETURN_ON_ERROR(write_commands(display,
+                                       window_commands,
+                                       sizeof(window_commands)),
+                        TAG,
+                        "Failed to set SSD1306 address window");
+
+    const size_t offset = ((size_t)page_start * SSD1306_WIDTH) + column_start;
+    const size_t length = ((size_t)(page_end - page_start) * SSD1306_WIDTH) +
+                          (size_t)(column_end - column_start) + 1U;
+
+    ESP_RETURN_ON_ERROR(write_data(display, offset, length),
+                        TAG,
+                        "Failed to update SSD1306 pages %u-%u",
+                        page_start,
+                        page_end);
+
+    display->dirty_pages = 0;
     return ESP_OK;
 }
 
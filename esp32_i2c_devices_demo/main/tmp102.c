@@ -3,13 +3,107 @@
 #include <string.h>
 
 #include "esp_check.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "i2c_bus.h"
 
 #define TMP102_TEMPERATURE_REGISTER 0x00
+#define TMP102_CONFIG_REGISTER      0x01
+#define TMP102_TLOW_REGISTER        0x02
+#define TMP102_THIGH_REGISTER       0x03
 #define TMP102_TRANSACTION_TIMEOUT_MS 100
 
+// Configuration register, first byte.
+#define TMP102_CONFIG_OS            0x80U
+#define TMP102_CONFIG_FAULT_SHIFT   3U
+#define TMP102_CONFIG_POL           0x04U
+#define TMP102_CONFIG_TM            0x02U
+#define TMP102_CONFIG_SD            0x01U
+// Configuration register, second byte.
+#define TMP102_CONFIG_RATE_SHIFT    6U
+#define TMP102_CONFIG_EM            0x10U
+
+// A conversion takes 26 ms typical and 35 ms maximum.
+#define TMP102_ONE_SHOT_POLL_MS     10
+#define TMP102_ONE_SHOT_TIMEOUT_MS  60
+
 static const char *TAG = "tmp102";
 
+/**
+ * @brief Reads one 16-bit register.
+ *
+ * @param sensor Initialized sensor context.
+ * @param register_address Register pointer value.
+ * @param value Output buffer for the two register bytes, MSB first.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+static esp_err_t read_register(const tmp102_t *sensor,
+                               uint8_t register_address,
+                               uint8_t value[2])
+{
+    // High priority: the read only waits for the current display chunk.
+    const app_i2c_transaction_t transaction = {
+        .device_handle = sensor->device_handle,
+        .priority = APP_I2C_PRIORITY_HIGH,
+        .write_data = &register_address,
+        .write_length = sizeof(register_address),
+        .read_data = value,
+        .read_length = 2,
+        .timeout_ms = TMP102_TRANSACTION_TIMEOUT_MS,
+    };
+
+    return app_i2c_bus_execute(&transaction);
+}
+
+/**
+ * @brief Writes one 16-bit register.
+ *
+ * @param sensor Initialized sensor context.
+ * @param register_address Register pointer value.
+ * @param value The two register bytes, MSB first.
+ *
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+static esp_err_t write_register(const tmp102_t *sensor,
+                                uint8_t register_address,
+                                const uint8_t value[2])
+{
+    const app_i2c_transaction_t transaction = {
+        .device_handle = sensor->device_handle,
+        .priority = APP_I2C_PRIORITY_HIGH,
+        .prefix = &register_address,
+        .prefix_length = sizeof(register_address),
+        .write_data = value,
+        .write_length = 2,
+        .timeout_ms = TMP102_TRANSACTION_TIMEOUT_MS,
+    };
+
+    return app_i2c_bus_execute(&transaction);
+}
+
+/**
+ * @brief Encodes a temperature for the TLOW or THIGH register.
+ *
+ * @param temperature_c Temperature in degrees C.
+ * @param extended_mode True for the 13-bit extended format.
+ * @param encoded Output register bytes, MSB first.
+ */
+static void encode_limit(float temperature_c,
+                         bool extended_mode,
+                         uint8_t encoded[2])
+{
+    // One LSB is 0.0625 C in both formats; round to the nearest step.
+    const float steps = temperature_c / 0.0625f;
+    const int16_t value = (int16_t)((steps >= 0.0f) ? (steps + 0.5f)
+                                                    : (steps - 0.5f));
+    const uint16_t bits = (uint16_t)value << (extended_mode ? 3 : 4);
+
+    encoded[0] = (uint8_t)(bits >> 8);
+    encoded[1] = (uint8_t)(bits & 0xFFU);
+}
+
 /**
  * @brief Initializes the TMP102 temperature sensor.
  *
@@ -62,32 +156,174 @@ esp_err_t tmp102_read_temperature_c(const tmp102_t *sensor,
                         TAG,
                         "Temperature output pointer is NULL");
 
-    const uint8_t register_address = TMP102_TEMPERATURE_REGISTER;
     uint8_t raw_bytes[2] = {0};
 
-    ESP_RETURN_ON_ERROR(i2c_master_transmit_receive(sensor->device_handle,
-                                                     &register_address,
-                                                     sizeof(register_address),
-                                                     raw_bytes,
-                                                     sizeof(raw_bytes),
-                                                     TMP102_TRANSACTION_TIMEOUT_MS),
+    ESP_RETURN_ON_ERROR(read_register(sensor,
+                                      TMP102_TEMPERATURE_REGISTER,
+                                      raw_bytes),
                         TAG,
                         "Failed to read TMP102 temperature register");
 
     // The normal-mode result is a signed 12-bit value in bits 15 through 4.
+    // Bit 0 is set in extended mode, where the value has 13 bits.
+    const bool extended_mode = (raw_bytes[1] & 0x01U) != 0U;
     int16_t raw_temperature = (int16_t)(((uint16_t)raw_bytes[0] << 8) |
                                         raw_bytes[1]);
-    raw_temperature >>= 4;
+    raw_temperature >>= extended_mode ? 3 : 4;
 
-    // Sign-extend bit 11 because the value was shifted inside a 16-bit type.
-    if ((raw_temperature & 0x0800) != 0) {
-        raw_temperature |= (int16_t)0xF000;
+    // Sign-extend because the value was shifted inside a 16-bit type.
+    const int16_t sign_bit = extended_mode ? 0x1000 : 0x0800;
+    if ((raw_temperature & sign_bit) != 0) {
+        raw_temperature |= (int16_t)(extended_mode ? 0xE000 : 0xF000);
     }
 
     *temperature_c = (float)raw_temperature * 0.0625f;
     return ESP_OK;
 }
 
+/**
+ * @brief Configures conversion, shutdown, and ALERT behavior.
+ *
+ * @param sensor Initialized sensor context.
+ * @param config Configuration to apply.
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+esp_err_t tmp102_configure(tmp102_t *sensor, const tmp102_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(sensor != NULL,
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Sensor context is NULL");
+    ESP_RETURN_ON_FALSE(sensor->initialized,
+                        ESP_ERR_INVALID_STATE,
+                        TAG,
+                        "TMP102 is not initialized");
+    ESP_RETURN_ON_FALSE(config != NULL,
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Configuration is NULL");
+    ESP_RETURN_ON_FALSE(config->low_limit_c < config->high_limit_c,
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Low limit must be below high limit");
+
+    uint8_t fault_bits;
+    switch (config->fault_queue) {
+    case 0:
+    case 1:
+        fault_bits = 0;
+        break;
+    case 2:
+        fault_bits = 1;
+        break;
+    case 4:
+        fault_bits = 2;
+        break;
+    case 6:
+        fault_bits = 3;
+        break;
+    default:
+        ESP_LOGE(TAG, "Unsupported fault queue length %u", config->fault_queue);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint8_t low_limit[2];
+    uint8_t high_limit[2];
+    encode_limit(config->low_limit_c, config->extended_mode, low_limit);
+    encode_limit(config->high_limit_c, config->extended_mode, high_limit);
+
+    // Write the limits first so ALERT does not act on stale values.
+    ESP_RETURN_ON_ERROR(write_register(sensor,
+                                       TMP102_TLOW_REGISTER,
+                                       low_limit),
+                        TAG,
+                        "Failed to write TMP102 low limit");
+    ESP_RETURN_ON_ERROR(write_register(sensor,
+                                       TMP102_THIGH_REGISTER,
+                                       high_limit),
+                        TAG,
+                        "Failed to write TMP102 high limit");
+
+    uint8_t configuration[2];
+    configuration[0] = (uint8_t)(fault_bits << TMP102_CONFIG_FAULT_SHIFT);
+    if (config->alert_active_high) {
+        configuration[0] |= TMP102_CONFIG_POL;
+    }
+    if (config->alert_mode == TMP102_ALERT_INTERRUPT) {
+        configuration[0] |= TMP102_CONFIG_TM;
+    }
+    if (config->shutdown) {
+        configuration[0] |= TMP102_CONFIG_SD;
+    }
+
+    configuration[1] = (uint8_t)(((uint8_t)config->conversion_rate & 0x03U)
+                                 << TMP102_CONFIG_RATE_SHIFT);
+    if (config->extended_mode) {
+        configuration[1] |= TMP102_CONFIG_EM;
+    }
+
+    ESP_RETURN_ON_ERROR(write_register(sensor,
+                                       TMP102_CONFIG_REGISTER,
+                                       configuration),
+                        TAG,
+                        "Failed to write TMP102 configuration");
+
+    memcpy(sensor->configuration, configuration, sizeof(configuration));
+    return ESP_OK;
+}
+
+/**
+ * @brief Triggers one conversion in shutdown mode and reads the result.
+ *
+ * @param sensor Initialized sensor context in shutdown mode.
+ * @param temperature_c Output pointer to the temperature in Celsius.
+ * @return ESP_OK on success. Otherwise, an ESP-IDF error code is returned.
+ */
+esp_err_t tmp102_read_one_shot_c(const tmp102_t *sensor,
+                                 float *temperature_c)
+{
+    ESP_RETURN_ON_FALSE(sensor != NULL,
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Sensor context is NULL");
+    ESP_RETURN_ON_FALSE(sensor->initialized &&
+                            ((sensor->configuration[0] & TMP102_CONFIG_SD) != 0U),
+                        ESP_ERR_INVALID_STATE,
+                        TAG,
+                        "TMP102 is not configured for shutdown mode");
+
+    const uint8_t start[2] = {
+        (uint8_t)(sensor->configuration[0] | TMP102_CONFIG_OS),
+        sensor->configuration[1],
+    };
+
+    ESP_RETURN_ON_ERROR(write_register(sensor, TMP102_CONFIG_REGISTER, start),
+                        TAG,
+                        "Failed to start TMP102 one-shot conversion");
+
+    // OS reads back as 1 once the conversion has finished.
+    uint8_t configuration[2] = {0};
+    int waited_ms = 0;
+    do {
+        vTaskDelay(pdMS_TO_TICKS(TMP102_ONE_SHOT_POLL_MS));
+        waited_ms += TMP102_ONE_SHOT_POLL_MS;
+
+        ESP_RETURN_ON_ERROR(read_register(sensor,
+                                          TMP102_CONFIG_REGISTER,
+                                          configuration),
+                            TAG,
+                            "Failed to poll TMP102 conversion");
+    } while (((configuration[0] & TMP102_CONFIG_OS) == 0U) &&
+             (waited_ms < TMP102_ONE_SHOT_TIMEOUT_MS));
+
+    ESP_RETURN_ON_FALSE((configuration[0] & TMP102_CONFIG_OS) != 0U,
+                        ESP_ERR_TIMEOUT,
+                        TAG,
+                        "TMP102 one-shot conversion timed out");
+
+    return tmp102_read_temperature_c(sensor, temperature_c);
+}
+
 /**
  * @brief Deinitializes the TMP102 temperature sensor.
  *
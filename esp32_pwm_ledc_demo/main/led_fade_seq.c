@@ -0,0 +1,244 @@
+#include "led_fade_seq.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_attr.h"
+#include "esp_check.h"
+#include "esp_err.h"
+#include "esp_log.h"
+
+static const char *TAG = "led_fade_seq";
+
+static bool s_fade_service_installed = false;
+
+/**
+ * @brief Converts a perceived brightness level into a raw LEDC duty value.
+ *
+ * The eye responds roughly to the square of the duty cycle, so a linear
+ * duty ramp looks like it rushes through the dark end and crawls at the top.
+ * Squaring the level gives a ramp that looks even.
+ *
+ * Args:
+ *     level: Brightness from 0 to FADE_SEQ_LEVEL_MAX.
+ *     max_duty: Maximum raw duty value of the channel.
+ *
+ * Returns:
+ *     Raw LEDC duty value.
+ */
+static uint32_t level_to_duty(uint32_t level, uint32_t max_duty)
+{
+    if (level > FADE_SEQ_LEVEL_MAX) {
+        level = FADE_SEQ_LEVEL_MAX;
+    }
+
+    return (uint32_t)(((uint64_t)level * level * max_duty) /
+                      ((uint64_t)FADE_SEQ_LEVEL_MAX * FADE_SEQ_LEVEL_MAX));
+}
+
+/**
+ * @brief Fade-end callback, called from the LEDC interrupt.
+ *
+ * Args:
+ *     param: Event description from the LEDC driver.
+ *     user_arg: Sequencer that owns the channel.
+ *
+ * Returns:
+ *     true when a higher-priority task was woken and a yield is needed.
+ */
+static IRAM_ATTR bool fade_seq_on_fade_end(const ledc_cb_param_t *param, void *user_arg)
+{
+    fade_seq_t *seq = (fade_seq_t *)user_arg;
+    BaseType_t task_woken = pdFALSE;
+
+    if (param->event == LEDC_FADE_END_EVT && seq->waiter != NULL) {
+        vTaskNotifyGiveFromISR(seq->waiter, &task_woken);
+    }
+
+    return task_woken == pdTRUE;
+}
+
+/**
+ * @brief Moves every channel to a new raw duty in one synchronized hardware fade.
+ *
+ * All fades are programmed first and then started back to back, so the
+ * channels begin within a few register writes of each other. Channels that
+ * are already at their target are left alone because they would not raise a
+ * fade-end event.
+ *
+ * Args:
+ *     seq: Sequencer.
+ *     target: Raw duty value per channel.
+ *     time_ms: Fade duration. Zero sets the duty immediately.
+ *
+ * Returns:
+ *     ESP_OK when every channel reached its target.
+ *     ESP_ERR_TIMEOUT when a fade-end event did not arrive in time.
+ */
+static esp_err_t fade_seq_run_segment(fade_seq_t *seq, const uint32_t *target, uint32_t time_ms)
+{
+    uint32_t pending_mask = 0U;
+    size_t pending_count = 0U;
+
+    // Drop events left over from an earlier timeout
+    (void)ulTaskNotifyTake(pdTRUE, 0);
+
+    for (size_t index = 0U; index < seq->channel_count; index++) {
+        const fade_seq_channel_t *ch = &seq->channels[index];
+
+        if (target[index] == seq->duty[index]) {
+            continue;
+        }
+
+        if (time_ms == 0U) {
+            ESP_RETURN_ON_ERROR(ledc_set_duty(ch->speed_mode, ch->channel, target[index]), TAG, "Failed to set duty");
+            ESP_RETURN_ON_ERROR(ledc_update_duty(ch->speed_mode, ch->channel), TAG, "Failed to update duty");
+            seq->duty[index] = target[index];
+            continue;
+        }
+
+        ESP_RETURN_ON_ERROR(
+            ledc_set_fade_with_time(ch->speed_mode, ch->channel, target[index], (int)time_ms),
+            TAG,
+            "Failed to set fade"
+        );
+        pending_mask |= 1U << index;
+        pending_count++;
+    }
+
+    if (pending_count == 0U) {
+        return ESP_OK;
+    }
+
+    for (size_t index = 0U; index < seq->channel_count; index++) {
+        if ((pending_mask & (1U << index)) != 0U) {
+            const fade_seq_channel_t *ch = &seq->channels[index];
+            ESP_RETURN_ON_ERROR(
+                ledc_fade_start(ch->speed_mode, ch->channel, LEDC_FADE_NO_WAIT),
+                TAG,
+                "Failed to start fade"
+            );
+        }
+    }
+
+    // Sleep until every channel has reported the end of its fade
+    const TickType_t timeout = pdMS_TO_TICKS(time_ms + FADE_SEQ_TIMEOUT_MARGIN_MS);
+    while (pending_count > 0U) {
+        if (ulTaskNotifyTake(pdFALSE, timeout) == 0U) {
+            ESP_LOGW(TAG, "Fade-end event missing for %u channel(s)", (unsigned)pending_count);
+            return ESP_ERR_TIMEOUT;
+        }
+        pending_count--;
+    }
+
+    for (size_t index = 0U; index < seq->channel_count; index++) {
+        if ((pending_mask & (1U << index)) != 0U) {
+            seq->duty[index] = target[index];
+        }
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Ramps every channel to the levels of one keyframe.
+ *
+ * Ramps that are long enough are split into FADE_SEQ_CURVE_SEGMENTS linear
+ * hardware fades that follow the brightness curve.
+ *
+ * Args:
+ *     seq: Sequencer.
+ *     keyframe: Target levels and ramp time.
+ *
+ * Returns:
+ *     ESP_OK when the ramp finished.
+ *     ESP_ERR_TIMEOUT when a fade-end event did not arrive in time.
+ */
+static esp_err_t fade_seq_ramp(fade_seq_t *seq, const fade_keyframe_t *keyframe)
+{
+    uint32_t start_level[FADE_SEQ_MAX_CHANNELS];
+    uint32_t target[FADE_SEQ_MAX_CHANNELS];
+    uint32_t segments = 1U;
+
+    if (keyframe->ramp_ms >= (FADE_SEQ_CURVE_SEGMENTS * FADE_SEQ_MIN_SEGMENT_MS)) {
+        segments = FADE_SEQ_CURVE_SEGMENTS;
+    }
+
+    for (size_t index = 0U; index < seq->channel_count; index++) {
+        const uint32_t max_duty = seq->channels[index].max_duty;
+        start_level[index] = (uint32_t)lroundf(sqrtf((float)seq->duty[index] / (float)max_duty) *
+                                                (float)FADE_SEQ_LEVEL_MAX);
+    }
+
+    for (uint32_t segment = 1U; segment <= segments; segment++) {
+        for (size_t index = 0U; index < seq->channel_count; index++) {
+            const int32_t from = (int32_t)start_level[index];
+            const int32_t to = (int32_t)keyframe->level[index];
+            const int32_t level = from + ((to - from) * (int32_t)segment) / (int32_t)segments;
+
+            target[index] = level_to_duty((uint32_t)level, seq->channels[index].max_duty);
+        }
+
+        ESP_RETURN_ON_ERROR(fade_seq_run_segment(seq, target, keyframe->ramp_ms / segments), TAG, "Ramp failed");
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t fade_seq_init(fade_seq_t *seq, const fade_seq_channel_t *channels, size_t channel_count)
+{
+    ESP_RETURN_ON_FALSE(seq != NULL && channels != NULL, ESP_ERR_INVALID_ARG, TAG, "seq or channels is NULL");
+    ESP_RETURN_ON_FALSE(channel_count > 0U && channel_count <= FADE_SEQ_MAX_CHANNELS,
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid channel count");
+
+    if (!s_fade_service_installed) {
+        ESP_RETURN_ON_ERROR(ledc_fade_func_install(0), TAG, "Failed to install fade service");
+        s_fade_service_installed = true;
+    }
+
+    seq->channels = channels;
+    seq->channel_count = channel_count;
+    seq->waiter = NULL;
+
+    for (size_t index = 0U; index < channel_count; index++) {
+        const fade_seq_channel_t *ch = &channels[index];
+        ledc_cbs_t callbacks = {
+            .fade_cb = fade_seq_on_fade_end,
+        };
+
+        ESP_RETURN_ON_FALSE(ch->max_duty > 0U, ESP_ERR_INVALID_ARG, TAG, "max_duty is zero");
+        ESP_RETURN_ON_ERROR(ledc_cb_register(ch->speed_mode, ch->channel, &callbacks, seq),
+                            TAG, "Failed to register fade callback");
+
+        // Ramps start from whatever duty the channel was left at
+        seq->duty[index] = ledc_get_duty(ch->speed_mode, ch->channel);
+        if (seq->duty[index] > ch->max_duty) {
+            seq->duty[index] = ch->max_duty;
+        }
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t fade_seq_play(fade_seq_t *seq, const fade_keyframe_t *keyframes, size_t keyframe_count)
+{
+    ESP_RETURN_ON_FALSE(seq != NULL && seq->channels != NULL, ESP_ERR_INVALID_ARG, TAG, "Sequencer not initialized");
+    ESP_RETURN_ON_FALSE(keyframes != NULL || keyframe_count == 0U, ESP_ERR_INVALID_ARG, TAG, "keyframes is NULL");
+
+    seq->waiter = xTaskGetCurrentTaskHandle();
+
+    esp_err_t err = ESP_OK;
+    for (size_t index = 0U; index < keyframe_count && err == ESP_OK; index++) {
+        err = fade_seq_ramp(seq, &keyframes[index]);
+
+        if (err == ESP_OK && keyframes[index].hold_ms > 0U) {
+            vTaskDelay(pdMS_TO_TICKS(keyframes[index].hold_ms));
+        }
+    }
+
+    seq->waiter = NULL;
+
+    return err;
+}
@@ -0,0 +1,95 @@
+#ifndef LED_FADE_SEQ_H
+#define LED_FADE_SEQ_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "driver/ledc.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of LEDC channels one sequencer drives together. */
+#define FADE_SEQ_MAX_CHANNELS       4U
+
+/** Full brightness. Keyframe levels are perceived brightness in permille. */
+#define FADE_SEQ_LEVEL_MAX          1000U
+
+/** Linear hardware fades used to approximate the brightness curve of one ramp. */
+#define FADE_SEQ_CURVE_SEGMENTS     4U
+
+/** Shortest hardware fade; shorter ramps are not split into curve segments. */
+#define FADE_SEQ_MIN_SEGMENT_MS     40U
+
+/** Extra time allowed for a fade-end event before a ramp is reported as stuck. */
+#define FADE_SEQ_TIMEOUT_MARGIN_MS  100U
+
+/**
+ * @brief One LEDC channel driven by a sequencer.
+ *
+ * The timer and channel must already be configured with ledc_timer_config()
+ * and ledc_channel_config().
+ */
+typedef struct {
+    ledc_mode_t speed_mode;
+    ledc_channel_t channel;
+    uint32_t max_duty;
+} fade_seq_channel_t;
+
+/**
+ * @brief One step of an animation.
+ *
+ * Every channel ramps from its current level to its entry in level[] in
+ * ramp_ms, all channels starting together. The levels are then held for
+ * hold_ms before the next keyframe. A ramp_ms of 0 jumps straight to the
+ * new levels; a keyframe that repeats the current levels is a pure hold.
+ */
+typedef struct {
+    uint16_t level[FADE_SEQ_MAX_CHANNELS];
+    uint32_t ramp_ms;
+    uint32_t hold_ms;
+} fade_keyframe_t;
+
+/**
+ * @brief Sequencer state. Treat as opaque; set up with fade_seq_init().
+ */
+typedef struct {
+    const fade_seq_channel_t *channels;
+    size_t channel_count;
+    uint32_t duty[FADE_SEQ_MAX_CHANNELS];
+    TaskHandle_t waiter;
+} fade_seq_t;
+
+/**
+ * @brief Prepares a sequencer for a group of LEDC channels.
+ *
+ * Installs the LEDC fade service on first use and registers a fade-end
+ * callback for every channel. The channel array must stay valid for the
+ * lifetime of the sequencer.
+ *
+ * @return ESP_OK when the sequencer is ready.
+ * @return ESP_ERR_INVALID_ARG when the channel list is empty or too long.
+ */
+esp_err_t fade_seq_init(fade_seq_t *seq, const fade_seq_channel_t *channels, size_t channel_count);
+
+/**
+ * @brief Plays a list of keyframes and returns when the last one is done.
+ *
+ * The fades run in the LEDC hardware. The calling task blocks until the
+ * fade-end interrupts of all channels in a ramp have arrived, and sleeps
+ * through holds, so the CPU wakes only a few times per keyframe. Only one
+ * task may play on a sequencer at a time.
+ *
+ * @return ESP_OK when all keyframes were played.
+ * @return ESP_ERR_TIMEOUT when a fade-end event did not arrive in time.
+ */
+esp_err_t fade_seq_play(fade_seq_t *seq, const fade_keyframe_t *keyframes, size_t keyframe_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LED_FADE_SEQ_H */
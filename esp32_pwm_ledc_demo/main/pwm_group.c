@@ -0,0 +1,144 @@
+#include "pwm_group.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_check.h"
+#include "esp_err.h"
+#include "esp_log.h"
+
+static const char *TAG = "pwm_group";
+
+esp_err_t pwm_group_init(pwm_group_t *group, const pwm_group_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(group != NULL && config != NULL, ESP_ERR_INVALID_ARG, TAG, "group or config is NULL");
+    ESP_RETURN_ON_FALSE(config->channels != NULL, ESP_ERR_INVALID_ARG, TAG, "channels is NULL");
+    ESP_RETURN_ON_FALSE(config->channel_count > 0U && config->channel_count <= PWM_GROUP_MAX_CHANNELS,
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid channel count");
+
+    memset(group, 0, sizeof(*group));
+    group->config = *config;
+    group->max_duty = (1U << config->resolution_bits) - 1U;
+    portMUX_INITIALIZE(&group->lock);
+
+    for (uint32_t percent = 0U; percent <= 100U; percent++) {
+        group->percent_duty[percent] = (percent * group->max_duty) / 100U;
+    }
+
+    // One timer for the whole group keeps every channel on the same period boundaries
+    ledc_timer_config_t timer_config = {
+        .speed_mode = config->speed_mode,
+        .timer_num = config->timer,
+        .duty_resolution = config->resolution,
+        .freq_hz = config->frequency_hz,
+        .clk_cfg = LEDC_AUTO_CLK,
+    };
+
+    ESP_RETURN_ON_ERROR(ledc_timer_config(&timer_config), TAG, "Failed to configure LEDC timer");
+
+    for (size_t index = 0U; index < config->channel_count; index++) {
+        const pwm_group_channel_t *ch = &config->channels[index];
+
+        ESP_RETURN_ON_FALSE(ch->phase_percent < 100U, ESP_ERR_INVALID_ARG, TAG, "phase must be below 100%%");
+
+        // The output goes high when the counter reaches hpoint. Staggering the
+        // hpoints spreads the switching edges, and the load current, over the period.
+        group->hpoint[index] = (ch->phase_percent * (group->max_duty + 1U)) / 100U;
+
+        ledc_channel_config_t channel_config = {
+            .gpio_num = ch->gpio_num,
+            .speed_mode = config->speed_mode,
+            .channel = ch->channel,
+            .intr_type = LEDC_INTR_DISABLE,
+            .timer_sel = config->timer,
+            .duty = 0U,
+            .hpoint = (int)group->hpoint[index],
+            .flags.output_invert = 0,
+        };
+
+        ESP_RETURN_ON_ERROR(ledc_channel_config(&channel_config), TAG, "Failed to configure LEDC channel");
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t pwm_group_stage_duty(pwm_group_t *group, size_t index, uint32_t duty)
+{
+    ESP_RETURN_ON_FALSE(group != NULL, ESP_ERR_INVALID_ARG, TAG, "group is NULL");
+    ESP_RETURN_ON_FALSE(index < group->config.channel_count, ESP_ERR_INVALID_ARG, TAG, "index out of range");
+
+    if (duty > group->max_duty) {
+        duty = group->max_duty;
+    }
+
+    group->staged_duty[index] = duty;
+    group->staged_mask |= 1U << index;
+
+    return ESP_OK;
+}
+
+esp_err_t pwm_group_stage_percent(pwm_group_t *group, size_t index, uint32_t percent)
+{
+    ESP_RETURN_ON_FALSE(group != NULL, ESP_ERR_INVALID_ARG, TAG, "group is NULL");
+
+    if (percent > 100U) {
+        percent = 100U;
+    }
+
+    return pwm_group_stage_duty(group, index, group->percent_duty[percent]);
+}
+
+esp_err_t pwm_group_commit(pwm_group_t *group)
+{
+    ESP_RETURN_ON_FALSE(group != NULL, ESP_ERR_INVALID_ARG, TAG, "group is NULL");
+
+    const pwm_group_config_t *config = &group->config;
+    const uint32_t mask = group->staged_mask;
+
+    if (mask == 0U) {
+        return ESP_OK;
+    }
+
+    // Writing duty and hpoint does not change the outputs yet; the hardware
+    // keeps using the old values until the channel is told to update.
+    for (size_t index = 0U; index < config->channel_count; index++) {
+        if ((mask & (1U << index)) != 0U) {
+            ESP_RETURN_ON_ERROR(
+                ledc_set_duty_with_hpoint(config->speed_mode, config->channels[index].channel,
+                                          group->staged_duty[index], group->hpoint[index]),
+                TAG,
+                "Failed to set duty"
+            );
+        }
+    }
+
+    // Issue the update requests without being preempted between channels
+    esp_err_t err = ESP_OK;
+    portENTER_CRITICAL(&group->lock);
+    for (size_t index = 0U; index < config->channel_count && err == ESP_OK; index++) {
+        if ((mask & (1U << index)) != 0U) {
+            err = ledc_update_duty(config->speed_mode, config->channels[index].channel);
+        }
+    }
+    portEXIT_CRITICAL(&group->lock);
+
+    ESP_RETURN_ON_ERROR(err, TAG, "Failed to update duty");
+
+    group->staged_mask = 0U;
+
+    return ESP_OK;
+}
+
+esp_err_t pwm_group_set_frequency(pwm_group_t *group, uint32_t frequency_hz)
+{
+    ESP_RETURN_ON_FALSE(group != NULL, ESP_ERR_INVALID_ARG, TAG, "group is NULL");
+    ESP_RETURN_ON_FALSE(frequency_hz > 0U, ESP_ERR_INVALID_ARG, TAG, "frequency is zero");
+
+    ESP_RETURN_ON_ERROR(ledc_set_freq(group->config.speed_mode, group->config.timer, frequency_hz),
+                        TAG, "Failed to set frequency");
+    group->config.frequency_hz = frequency_hz;
+
+    return ESP_OK;
+}
@@ -0,0 +1,112 @@
+#ifndef PWM_GROUP_H
+#define PWM_GROUP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "driver/ledc.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Maximum number of LEDC channels in one group. */
+#define PWM_GROUP_MAX_CHANNELS  4U
+
+/**
+ * @brief One output of a PWM group.
+ */
+typedef struct {
+    ledc_channel_t channel;
+    int gpio_num;
+    /** Start of the high phase as a share of the period, 0 to 99 percent. */
+    uint32_t phase_percent;
+} pwm_group_channel_t;
+
+/**
+ * @brief Channels that share one LEDC timer.
+ */
+typedef struct {
+    ledc_mode_t speed_mode;
+    ledc_timer_t timer;
+    ledc_timer_bit_t resolution;
+    uint32_t resolution_bits;
+    uint32_t frequency_hz;
+    const pwm_group_channel_t *channels;
+    size_t channel_count;
+} pwm_group_config_t;
+
+/**
+ * @brief Group state. Treat as opaque; set up with pwm_group_init().
+ */
+typedef struct {
+    pwm_group_config_t config;
+    uint32_t max_duty;
+    uint32_t percent_duty[101];
+    uint32_t hpoint[PWM_GROUP_MAX_CHANNELS];
+    uint32_t staged_duty[PWM_GROUP_MAX_CHANNELS];
+    uint32_t staged_mask;
+    portMUX_TYPE lock;
+} pwm_group_t;
+
+/**
+ * @brief Configures the shared timer and every channel of a group.
+ *
+ * All channels start at zero duty. The channel array must stay valid for the
+ * lifetime of the group.
+ *
+ * @return ESP_OK when the timer and all channels are configured.
+ * @return ESP_ERR_INVALID_ARG when the configuration is invalid.
+ */
+esp_err_t pwm_group_init(pwm_group_t *group, const pwm_group_config_t *config);
+
+/**
+ * @brief Stages a raw duty value for one channel of the group.
+ *
+ * Nothing changes on the outputs until pwm_group_commit().
+ *
+ * @return ESP_OK when the duty is staged.
+ * @return ESP_ERR_INVALID_ARG when the index is out of range.
+ */
+esp_err_t pwm_group_stage_duty(pwm_group_t *group, size_t index, uint32_t duty);
+
+/**
+ * @brief Stages a duty cycle percentage for one channel of the group.
+ *
+ * The raw duty comes from a table built for the group resolution by
+ * pwm_group_init(), so no division happens per update.
+ *
+ * @return ESP_OK when the duty is staged.
+ * @return ESP_ERR_INVALID_ARG when the index is out of range.
+ */
+esp_err_t pwm_group_stage_percent(pwm_group_t *group, size_t index, uint32_t percent);
+
+/**
+ * @brief Applies every staged duty value together.
+ *
+ * The duty and phase registers are written first. The update requests for
+ * all channels are then issued back to back with interrupts masked. The
+ * hardware latches each request at the next overflow of the shared timer,
+ * so all channels switch in the same period unless an overflow falls inside
+ * that window of well under a microsecond.
+ *
+ * @return ESP_OK when the update is committed.
+ */
+esp_err_t pwm_group_commit(pwm_group_t *group);
+
+/**
+ * @brief Changes the frequency of the shared timer.
+ *
+ * Duty values and phase offsets are kept in timer ticks, so every channel
+ * keeps its duty cycle and phase relation at the new frequency.
+ *
+ * @return ESP_OK when the frequency is updated.
+ */
+esp_err_t pwm_group_set_frequency(pwm_group_t *group, uint32_t frequency_hz);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PWM_GROUP_H */
@@ -1,4 +1,7 @@
 #include "pwm_ledc_demo.h"
+#include "led_fade_seq.h"
+#include "pwm_group.h"
+#include "tone_player.h"
 
 #include <stdbool.h>
 #include <stddef.h>
@@ -13,7 +16,13 @@
 #include "esp_log.h"
 
 #define LED_GPIO                CONFIG_PWM_DEMO_LED_GPIO
+#if CONFIG_PWM_DEMO_ENABLE_LED2
+#define LED2_GPIO               CONFIG_PWM_DEMO_LED2_GPIO
+#endif
 #define MOTOR_GPIO              CONFIG_PWM_DEMO_MOTOR_GPIO
+#if CONFIG_PWM_DEMO_ENABLE_MOTOR2
+#define MOTOR2_GPIO             CONFIG_PWM_DEMO_MOTOR2_GPIO
+#endif
 #define BUZZER_GPIO             CONFIG_PWM_DEMO_BUZZER_GPIO
 #define SERVO_GPIO              CONFIG_PWM_DEMO_SERVO_GPIO
 
@@ -25,6 +34,8 @@
 #define LED_PWM_RES_BITS        10U
 #define LED_PWM_MAX_DUTY        ((1U << LED_PWM_RES_BITS) - 1U)
 
+#define LED2_PWM_CHANNEL        LEDC_CHANNEL_4
+
 #define MOTOR_PWM_MODE          LEDC_LOW_SPEED_MODE
 #define MOTOR_PWM_TIMER         LEDC_TIMER_1
 #define MOTOR_PWM_CHANNEL       LEDC_CHANNEL_1
@@ -32,14 +43,14 @@
 #define MOTOR_PWM_RESOLUTION    LEDC_TIMER_10_BIT
 #define MOTOR_PWM_RES_BITS      10U
 #define MOTOR_PWM_MAX_DUTY      ((1U << MOTOR_PWM_RES_BITS) - 1U)
+#define MOTOR2_PWM_CHANNEL      LEDC_CHANNEL_5
+#define MOTOR2_PHASE_PERCENT    50U
 
 #define BUZZER_PWM_MODE         LEDC_LOW_SPEED_MODE
 #define BUZZER_PWM_TIMER        LEDC_TIMER_2
 #define BUZZER_PWM_CHANNEL      LEDC_CHANNEL_2
-#define BUZZER_PWM_FREQ_HZ      1000U
 #define BUZZER_PWM_RESOLUTION   LEDC_TIMER_10_BIT
 #define BUZZER_PWM_RES_BITS     10U
-#define BUZZER_PWM_MAX_DUTY     ((1U << BUZZER_PWM_RES_BITS) - 1U)
 
 #define SERVO_PWM_MODE          LEDC_LOW_SPEED_MODE
 #define SERVO_PWM_TIMER         LEDC_TIMER_3
@@ -52,10 +63,11 @@
 #define SERVO_MIN_PULSE_US      1000U
 #define SERVO_CENTER_PULSE_US   1500U
 #define SERVO_MAX_PULSE_US      2000U
+// Raw duty per microsecond of pulse width, 16.16 fixed point
+#define SERVO_DUTY_PER_US_Q16   ((uint32_t)(((uint64_t)SERVO_PWM_MAX_DUTY << 16) / SERVO_PERIOD_US))
 
 #define DEMO_STEP_DELAY_MS      350U
 #define SERVO_STEP_DELAY_MS     900U
-#define LED_FADE_DELAY_MS       8U
 
 static const char *TAG = "pwm_ledc_demo";
 
@@ -86,34 +98,84 @@ static const pwm_output_t s_led_pwm = {
     .gpio_num = LED_GPIO,
 };
 
-#if CONFIG_PWM_DEMO_ENABLE_MOTOR
+#if CONFIG_PWM_DEMO_ENABLE_LED2
 /**
- * @brief LEDC output description for the motor PWM channel.
+ * @brief LEDC output description for the second LED. It shares the LED timer.
  * 
  */
-static const pwm_output_t s_motor_pwm = {
+static const pwm_output_t s_led2_pwm = {
+    .speed_mode = LED_PWM_MODE,
+    .timer = LED_PWM_TIMER,
+    .channel = LED2_PWM_CHANNEL,
+    .resolution = LED_PWM_RESOLUTION,
+    .resolution_bits = LED_PWM_RES_BITS,
+    .frequency_hz = LED_PWM_FREQ_HZ,
+    .gpio_num = LED2_GPIO,
+};
+#endif
+
+/**
+ * @brief Channels animated by the LED fade sequencer.
+ */
+static const fade_seq_channel_t s_led_fade_channels[] = {
+    { .speed_mode = LED_PWM_MODE, .channel = LED_PWM_CHANNEL, .max_duty = LED_PWM_MAX_DUTY },
+#if CONFIG_PWM_DEMO_ENABLE_LED2
+    { .speed_mode = LED_PWM_MODE, .channel = LED2_PWM_CHANNEL, .max_duty = LED_PWM_MAX_DUTY },
+#endif
+};
+
+/**
+ * @brief LED animation. Levels are perceived brightness in permille; the
+ * second column is ignored when the second LED is disabled.
+ */
+static const fade_keyframe_t s_led_keyframes[] = {
+    { .level = {1000U, 0U},    .ramp_ms = 1000U, .hold_ms = 300U },  // LED up
+    { .level = {0U, 1000U},    .ramp_ms = 1000U, .hold_ms = 300U },  // Cross-fade to LED2
+    { .level = {500U, 500U},   .ramp_ms = 600U,  .hold_ms = 0U },    // Meet in the middle
+    { .level = {1000U, 1000U}, .ramp_ms = 0U,    .hold_ms = 200U },  // Flash
+    { .level = {0U, 0U},       .ramp_ms = 1000U, .hold_ms = 0U },    // Both out
+};
+
+static fade_seq_t s_led_fade_seq;
+
+#if CONFIG_PWM_DEMO_ENABLE_MOTOR
+/**
+ * @brief Motor outputs. The second motor switches on half a period after
+ * the first, so the two drivers never draw their inrush current together.
+ */
+static const pwm_group_channel_t s_motor_channels[] = {
+    { .channel = MOTOR_PWM_CHANNEL, .gpio_num = MOTOR_GPIO, .phase_percent = 0U },
+#if CONFIG_PWM_DEMO_ENABLE_MOTOR2
+    { .channel = MOTOR2_PWM_CHANNEL, .gpio_num = MOTOR2_GPIO, .phase_percent = MOTOR2_PHASE_PERCENT },
+#endif
+};
+
+/**
+ * @brief LEDC timer shared by all motor outputs.
+ */
+static const pwm_group_config_t s_motor_group_config = {
     .speed_mode = MOTOR_PWM_MODE,
     .timer = MOTOR_PWM_TIMER,
-    .channel = MOTOR_PWM_CHANNEL,
     .resolution = MOTOR_PWM_RESOLUTION,
     .resolution_bits = MOTOR_PWM_RES_BITS,
     .frequency_hz = MOTOR_PWM_FREQ_HZ,
-    .gpio_num = MOTOR_GPIO,
+    .channels = s_motor_channels,
+    .channel_count = sizeof(s_motor_channels) / sizeof(s_motor_channels[0]),
 };
+
+static pwm_group_t s_motor_group;
 #endif
 
 #if CONFIG_PWM_DEMO_ENABLE_BUZZER
 /**
- * @brief LEDC output description for the buzzer PWM channel.
- * 
+ * @brief LEDC timer and channel used by the buzzer tone player.
  */
-static const pwm_output_t s_buzzer_pwm = {
+static const tone_player_config_t s_buzzer_config = {
     .speed_mode = BUZZER_PWM_MODE,
     .timer = BUZZER_PWM_TIMER,
     .channel = BUZZER_PWM_CHANNEL,
     .resolution = BUZZER_PWM_RESOLUTION,
     .resolution_bits = BUZZER_PWM_RES_BITS,
-    .frequency_hz = BUZZER_PWM_FREQ_HZ,
     .gpio_num = BUZZER_GPIO,
 };
 #endif
@@ -148,25 +210,6 @@ static uint32_t pwm_get_max_duty(const pwm_output_t *pwm)
     return (1U << pwm->resolution_bits) - 1U;
 }
 
-/**
- * @brief Converts a percentage value into a raw LEDC duty value.
- *
- * Args:
- *     percent: Duty cycle percentage from 0 to 100.
- *     max_duty: Maximum raw duty value for the configured PWM resolution.
- *
- * Returns:
- *     Raw LEDC duty value matching the requested percentage.
- */
-static uint32_t pwm_percent_to_duty(uint32_t percent, uint32_t max_duty)
-{
-    if (percent > 100U) {
-        percent = 100U;
-    }
-
-    return (percent * max_duty) / 100U;
-}
-
 /**
  * @brief Converts a servo pulse width into a raw LEDC duty value.
  *
@@ -175,10 +218,13 @@ static uint32_t pwm_percent_to_duty(uint32_t percent, uint32_t max_duty)
  *
  * Returns:
  *     Raw LEDC duty value that generates the requested pulse width.
+ *
+ * The duty-per-microsecond factor is a compile-time constant, so the
+ * conversion is one multiply and one shift.
  */
 static uint32_t servo_pulse_us_to_duty(uint32_t pulse_width_us)
 {
-    return (pulse_width_us * SERVO_PWM_MAX_DUTY) / SERVO_PERIOD_US;
+    return (uint32_t)(((uint64_t)pulse_width_us * SERVO_DUTY_PER_US_Q16) >> 16);
 }
 
 /**
@@ -258,65 +304,22 @@ static esp_err_t pwm_set_duty_raw(const pwm_output_t *pwm, uint32_t duty)
     return ESP_OK;
 }
 
-/**
- * @brief Sets a duty cycle percentage on one PWM output.
- *
- * Args:
- *     pwm: Pointer to the PWM output description.
- *     percent: Duty cycle percentage from 0 to 100.
- *
- * Returns:
- *     ESP_OK when the duty cycle is updated successfully.
- *     ESP_ERR_INVALID_ARG when the configuration is invalid.
- */
-static esp_err_t pwm_set_duty_percent(const pwm_output_t *pwm, uint32_t percent)
-{
-    ESP_RETURN_ON_FALSE(pwm != NULL, ESP_ERR_INVALID_ARG, TAG, "pwm is NULL");
-
-    const uint32_t duty = pwm_percent_to_duty(percent, pwm_get_max_duty(pwm));
-
-    return pwm_set_duty_raw(pwm, duty);
-}
-
-/**
- * @brief Changes the PWM frequency of a configured LEDC timer.
- *
- * Args:
- *     pwm: Pointer to the PWM output description.
- *     frequency_hz: New PWM frequency in hertz.
- *
- * Returns:
- *     ESP_OK when the frequency is updated successfully.
- *     ESP_ERR_INVALID_ARG when the configuration is invalid.
- */
-static esp_err_t pwm_set_frequency(const pwm_output_t *pwm, uint32_t frequency_hz)
-{
-    ESP_RETURN_ON_FALSE(pwm != NULL, ESP_ERR_INVALID_ARG, TAG, "pwm is NULL");
-    ESP_RETURN_ON_FALSE(frequency_hz > 0U, ESP_ERR_INVALID_ARG, TAG, "frequency is zero");
-
-    ESP_RETURN_ON_ERROR(ledc_set_freq(pwm->speed_mode, pwm->timer, frequency_hz), TAG, "Failed to set frequency");
-
-    return ESP_OK;
-}
-
 /**
  * @brief Runs a smooth LED fade demonstration.
+ *
+ * The fades run in the LEDC hardware. This task sleeps until the fade-end
+ * interrupt of each keyframe instead of waking for every duty step.
  */
 static void demo_led_dimming(void)
 {
+#if CONFIG_PWM_DEMO_ENABLE_LED2
+    ESP_LOGI(TAG, "LED dimming demo on GPIO %d and GPIO %d", LED_GPIO, LED2_GPIO);
+#else
     ESP_LOGI(TAG, "LED dimming demo on GPIO %d", LED_GPIO);
+#endif
 
-    for (uint32_t duty = 0U; duty <= LED_PWM_MAX_DUTY; duty += 8U) {
-        ESP_ERROR_CHECK(pwm_set_duty_raw(&s_led_pwm, duty));
-        vTaskDelay(pdMS_TO_TICKS(LED_FADE_DELAY_MS));
-    }
-
-    for (int32_t duty = (int32_t)LED_PWM_MAX_DUTY; duty >= 0; duty -= 8) {
-        ESP_ERROR_CHECK(pwm_set_duty_raw(&s_led_pwm, (uint32_t)duty));
-        vTaskDelay(pdMS_TO_TICKS(LED_FADE_DELAY_MS));
-    }
-
-    ESP_ERROR_CHECK(pwm_set_duty_raw(&s_led_pwm, 0U));
+    ESP_ERROR_CHECK(fade_seq_play(&s_led_fade_seq, s_led_keyframes,
+                                  sizeof(s_led_keyframes) / sizeof(s_led_keyframes[0])));
 }
 
 #if CONFIG_PWM_DEMO_ENABLE_MOTOR
@@ -325,16 +328,28 @@ static void demo_led_dimming(void)
  *
  * The GPIO must drive an external motor driver, MOSFET stage, or H-bridge. The
  * ESP32 GPIO must not be connected directly to a motor.
+ *
+ * Every speed change is staged for all motors and committed at once, so both
+ * motors always run the same PWM period at the same duty.
  */
 static void demo_motor_speed(void)
 {
     const uint32_t speed_steps[] = {0U, 25U, 50U, 75U, 100U, 50U, 0U};
 
+#if CONFIG_PWM_DEMO_ENABLE_MOTOR2
+    ESP_LOGI(TAG, "Motor PWM demo on GPIO %d and GPIO %d. Use external motor drivers.", MOTOR_GPIO, MOTOR2_GPIO);
+#else
     ESP_LOGI(TAG, "Motor PWM demo on GPIO %d. Use an external motor driver.", MOTOR_GPIO);
+#endif
 
     for (size_t index = 0U; index < (sizeof(speed_steps) / sizeof(speed_steps[0])); index++) {
         ESP_LOGI(TAG, "Motor duty: %lu%%", (unsigned long)speed_steps[index]);
-        ESP_ERROR_CHECK(pwm_set_duty_percent(&s_motor_pwm, speed_steps[index]));
+
+        for (size_t motor = 0U; motor < s_motor_group_config.channel_count; motor++) {
+            ESP_ERROR_CHECK(pwm_group_stage_percent(&s_motor_group, motor, speed_steps[index]));
+        }
+        ESP_ERROR_CHECK(pwm_group_commit(&s_motor_group));
+
         vTaskDelay(pdMS_TO_TICKS(DEMO_STEP_DELAY_MS));
     }
 }
@@ -344,24 +359,24 @@ static void demo_motor_speed(void)
 /**
  * @brief Runs a passive buzzer tone demonstration.
  *
- * The function changes the LEDC timer frequency to generate different tones.
- * A 50 percent duty cycle is used to create a square-wave-like signal.
+ * The tone player switches notes from a timer callback by reprogramming the
+ * LEDC timer divider. A 50 percent duty cycle is used to create a
+ * square-wave-like signal. This task only waits for the melody to end.
  */
 static void demo_buzzer_tones(void)
 {
-    const uint32_t tones_hz[] = {523U, 659U, 784U, 1047U};
-    const uint32_t half_duty = BUZZER_PWM_MAX_DUTY / 2U;
-
-    ESP_LOGI(TAG, "Passive buzzer demo on GPIO %d", BUZZER_GPIO);
+    static const tone_note_t melody[] = {
+        { .frequency_hz = 523U,  .duration_ms = DEMO_STEP_DELAY_MS },
+        { .frequency_hz = 659U,  .duration_ms = DEMO_STEP_DELAY_MS },
+        { .frequency_hz = 784U,  .duration_ms = DEMO_STEP_DELAY_MS },
+        { .frequency_hz = 1047U, .duration_ms = DEMO_STEP_DELAY_MS },
+    };
 
-    for (size_t index = 0U; index < (sizeof(tones_hz) / sizeof(tones_hz[0])); index++) {
-        ESP_LOGI(TAG, "Buzzer tone: %lu Hz", (unsigned long)tones_hz[index]);
-        ESP_ERROR_CHECK(pwm_set_frequency(&s_buzzer_pwm, tones_hz[index]));
-        ESP_ERROR_CHECK(pwm_set_duty_raw(&s_buzzer_pwm, half_duty));
-        vTaskDelay(pdMS_TO_TICKS(DEMO_STEP_DELAY_MS));
-    }
+    ESP_LOGI(TAG, "Passive buzzer demo on GPIO %d: %u notes", BUZZER_GPIO,
+             (unsigned)(sizeof(melody) / sizeof(melody[0])));
 
-    ESP_ERROR_CHECK(pwm_set_duty_raw(&s_buzzer_pwm, 0U));
+    ESP_ERROR_CHECK(tone_player_play(melody, sizeof(melody) / sizeof(melody[0])));
+    ESP_ERROR_CHECK(tone_player_wait(portMAX_DELAY));
 }
 #endif
 
@@ -426,12 +441,23 @@ esp_err_t pwm_demo_init(void)
 
     ESP_RETURN_ON_ERROR(pwm_output_init(&s_led_pwm, 0U), TAG, "Failed to initialize LED PWM");
 
+#if CONFIG_PWM_DEMO_ENABLE_LED2
+    ESP_RETURN_ON_ERROR(pwm_output_init(&s_led2_pwm, 0U), TAG, "Failed to initialize second LED PWM");
+#endif
+
+    ESP_RETURN_ON_ERROR(
+        fade_seq_init(&s_led_fade_seq, s_led_fade_channels,
+                      sizeof(s_led_fade_channels) / sizeof(s_led_fade_channels[0])),
+        TAG,
+        "Failed to initialize LED fade sequencer"
+    );
+
 #if CONFIG_PWM_DEMO_ENABLE_MOTOR
-    ESP_RETURN_ON_ERROR(pwm_output_init(&s_motor_pwm, 0U), TAG, "Failed to initialize motor PWM");
+    ESP_RETURN_ON_ERROR(pwm_group_init(&s_motor_group, &s_motor_group_config), TAG, "Failed to initialize motor PWM");
 #endif
 
 #if CONFIG_PWM_DEMO_ENABLE_BUZZER
-    ESP_RETURN_ON_ERROR(pwm_output_init(&s_buzzer_pwm, 0U), TAG, "Failed to initialize buzzer PWM");
+    ESP_RETURN_ON_ERROR(tone_player_init(&s_buzzer_config), TAG, "Failed to initialize buzzer PWM");
 #endif
 
 #if CONFIG_PWM_DEMO_ENABLE_SERVO
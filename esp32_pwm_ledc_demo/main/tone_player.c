@@ -0,0 +1,220 @@
+#include "tone_player.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "freertos/semphr.h"
+#include "esp_check.h"
+#include "esp_err.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "soc/soc.h"
+#include "soc/soc_caps.h"
+
+/*
+ * Where the LEDC can run from the 80 MHz APB clock, the clock divider of
+ * every note is computed before playback and written straight to the timer.
+ * Other targets let the driver derive the divider on each note change.
+ */
+#if SOC_LEDC_SUPPORT_APB_CLOCK
+#define TONE_PLAYER_CACHED_DIVIDER  1
+#else
+#define TONE_PLAYER_CACHED_DIVIDER  0
+#endif
+
+/** LEDC clock dividers are fixed-point with 8 fractional bits and 10 integer bits. */
+#define TONE_DIVIDER_FRAC_BITS      8U
+#define TONE_DIVIDER_MIN            (1U << TONE_DIVIDER_FRAC_BITS)
+#define TONE_DIVIDER_MAX            ((1U << 18) - 1U)
+
+static const char *TAG = "tone_player";
+
+/**
+ * @brief A note prepared for playback.
+ */
+typedef struct {
+    uint32_t divider;
+    uint16_t frequency_hz;
+    uint16_t duration_ms;
+} tone_step_t;
+
+static tone_player_config_t s_config;
+static uint32_t s_half_duty;
+static esp_timer_handle_t s_note_timer = NULL;
+static SemaphoreHandle_t s_done = NULL;
+
+static tone_step_t s_steps[TONE_PLAYER_MAX_NOTES];
+static size_t s_step_count;
+static size_t s_step_index;
+static volatile bool s_playing = false;
+
+/**
+ * @brief Switches the buzzer to the next note, or silences it after the last one.
+ *
+ * Runs in the esp_timer task when the previous note has lasted its time.
+ *
+ * Args:
+ *     arg: Unused.
+ */
+static void tone_player_step(void *arg)
+{
+    (void)arg;
+
+    if (s_step_index >= s_step_count) {
+        (void)ledc_set_duty(s_config.speed_mode, s_config.channel, 0U);
+        (void)ledc_update_duty(s_config.speed_mode, s_config.channel);
+        s_playing = false;
+        xSemaphoreGive(s_done);
+        return;
+    }
+
+    const tone_step_t *step = &s_steps[s_step_index++];
+    uint32_t duty = 0U;
+
+    if (step->frequency_hz != 0U) {
+#if TONE_PLAYER_CACHED_DIVIDER
+        esp_err_t err = ledc_timer_set(s_config.speed_mode, s_config.timer, step->divider,
+                                       s_config.resolution_bits, LEDC_SCLK);
+#else
+        esp_err_t err = ledc_set_freq(s_config.speed_mode, s_config.timer, step->frequency_hz);
+#endif
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "Failed to set %u Hz: %s", (unsigned)step->frequency_hz, esp_err_to_name(err));
+        } else {
+            duty = s_half_duty;
+        }
+    }
+
+    (void)ledc_set_duty(s_config.speed_mode, s_config.channel, duty);
+    (void)ledc_update_duty(s_config.speed_mode, s_config.channel);
+
+    (void)esp_timer_start_once(s_note_timer, (uint64_t)step->duration_ms * 1000U);
+}
+
+/**
+ * @brief Computes the LEDC clock divider that produces a tone frequency.
+ *
+ * Args:
+ *     frequency_hz: Tone frequency in hertz.
+ *     divider: Receives the fixed-point clock divider.
+ *
+ * Returns:
+ *     ESP_OK when the frequency can be reached at the configured resolution.
+ *     ESP_ERR_INVALID_ARG when it is too low or too high.
+ */
+static esp_err_t tone_compute_divider(uint32_t frequency_hz, uint32_t *divider)
+{
+#if TONE_PLAYER_CACHED_DIVIDER
+    const uint64_t ticks_per_period = (uint64_t)frequency_hz << s_config.resolution_bits;
+    const uint64_t value = (((uint64_t)APB_CLK_FREQ << TONE_DIVIDER_FRAC_BITS) + (ticks_per_period / 2U)) /
+                           ticks_per_period;
+
+    ESP_RETURN_ON_FALSE(value >= TONE_DIVIDER_MIN && value <= TONE_DIVIDER_MAX, ESP_ERR_INVALID_ARG, TAG,
+                        "%lu Hz is out of range", (unsigned long)frequency_hz);
+
+    *divider = (uint32_t)value;
+#else
+    (void)frequency_hz;
+    *divider = 0U;
+#endif
+
+    return ESP_OK;
+}
+
+esp_err_t tone_player_init(const tone_player_config_t *config)
+{
+    ESP_RETURN_ON_FALSE(config != NULL, ESP_ERR_INVALID_ARG, TAG, "config is NULL");
+    ESP_RETURN_ON_FALSE(s_note_timer == NULL, ESP_ERR_INVALID_STATE, TAG, "already initialized");
+
+    s_config = *config;
+    s_half_duty = ((1U << config->resolution_bits) - 1U) / 2U;
+
+    // The starting frequency is replaced by the first note
+    ledc_timer_config_t timer_config = {
+        .speed_mode = config->speed_mode,
+        .timer_num = config->timer,
+        .duty_resolution = config->resolution,
+        .freq_hz = 1000U,
+#if TONE_PLAYER_CACHED_DIVIDER
+        .clk_cfg = LEDC_USE_APB_CLK,
+#else
+        .clk_cfg = LEDC_AUTO_CLK,
+#endif
+    };
+
+    ESP_RETURN_ON_ERROR(ledc_timer_config(&timer_config), TAG, "Failed to configure LEDC timer");
+
+    ledc_channel_config_t channel_config = {
+        .gpio_num = config->gpio_num,
+        .speed_mode = config->speed_mode,
+        .channel = config->channel,
+        .intr_type = LEDC_INTR_DISABLE,
+        .timer_sel = config->timer,
+        .duty = 0U,
+        .hpoint = 0,
+        .flags.output_invert = 0,
+    };
+
+    ESP_RETURN_ON_ERROR(ledc_channel_config(&channel_config), TAG, "Failed to configure LEDC channel");
+
+    s_done = xSemaphoreCreateBinary();
+    ESP_RETURN_ON_FALSE(s_done != NULL, ESP_ERR_NO_MEM, TAG, "Failed to create semaphore");
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = tone_player_step,
+        .name = "tone_player",
+    };
+
+    ESP_RETURN_ON_ERROR(esp_timer_create(&timer_args, &s_note_timer), TAG, "Failed to create note timer");
+
+    return ESP_OK;
+}
+
+esp_err_t tone_player_play(const tone_note_t *notes, size_t note_count)
+{
+    ESP_RETURN_ON_FALSE(s_note_timer != NULL, ESP_ERR_INVALID_STATE, TAG, "not initialized");
+    ESP_RETURN_ON_FALSE(!s_playing, ESP_ERR_INVALID_STATE, TAG, "melody already playing");
+    ESP_RETURN_ON_FALSE(notes != NULL && note_count > 0U && note_count <= TONE_PLAYER_MAX_NOTES,
+                        ESP_ERR_INVALID_ARG, TAG, "Invalid melody");
+
+    for (size_t index = 0U; index < note_count; index++) {
+        tone_step_t *step = &s_steps[index];
+
+        step->frequency_hz = notes[index].frequency_hz;
+        step->duration_ms = notes[index].duration_ms;
+        step->divider = 0U;
+
+        if (step->frequency_hz != 0U) {
+            ESP_RETURN_ON_ERROR(tone_compute_divider(step->frequency_hz, &step->divider), TAG, "Invalid note");
+        }
+    }
+
+    s_step_count = note_count;
+    s_step_index = 0U;
+    s_playing = true;
+    (void)xSemaphoreTake(s_done, 0);
+
+    // Sound the first note now; the timer takes over from there
+    tone_player_step(NULL);
+
+    return ESP_OK;
+}
+
+esp_err_t tone_player_wait(TickType_t timeout)
+{
+    ESP_RETURN_ON_FALSE(s_done != NULL, ESP_ERR_INVALID_STATE, TAG, "not initialized");
+
+    if (!s_playing) {
+        return ESP_OK;
+    }
+
+    if (xSemaphoreTake(s_done, timeout) != pdTRUE) {
+        return ESP_ERR_TIMEOUT;
+    }
+
+    // Leave the semaphore given so later waits return at once
+    xSemaphoreGive(s_done);
+
+    return ESP_OK;
+}
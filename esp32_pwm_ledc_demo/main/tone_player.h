@@ -0,0 +1,70 @@
+#ifndef TONE_PLAYER_H
+#define TONE_PLAYER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "driver/ledc.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Longest melody the player accepts. */
+#define TONE_PLAYER_MAX_NOTES   32U
+
+/**
+ * @brief One note of a melody. A frequency of 0 is a rest.
+ */
+typedef struct {
+    uint16_t frequency_hz;
+    uint16_t duration_ms;
+} tone_note_t;
+
+/**
+ * @brief LEDC timer and channel that drive the buzzer.
+ */
+typedef struct {
+    ledc_mode_t speed_mode;
+    ledc_timer_t timer;
+    ledc_channel_t channel;
+    ledc_timer_bit_t resolution;
+    uint32_t resolution_bits;
+    int gpio_num;
+} tone_player_config_t;
+
+/**
+ * @brief Configures the buzzer timer and channel and creates the note timer.
+ *
+ * @return ESP_OK when the player is ready.
+ * @return ESP_ERR_INVALID_STATE when the player is already initialized.
+ */
+esp_err_t tone_player_init(const tone_player_config_t *config);
+
+/**
+ * @brief Starts playing a melody and returns immediately.
+ *
+ * The timer settings of every note are computed here, before the first
+ * note sounds. The notes are then switched from an esp_timer callback, so
+ * the caller is free until the melody ends. The note array is copied.
+ *
+ * @return ESP_OK when playback started.
+ * @return ESP_ERR_INVALID_STATE when a melody is already playing.
+ * @return ESP_ERR_INVALID_ARG when a note frequency is out of range for the timer.
+ */
+esp_err_t tone_player_play(const tone_note_t *notes, size_t note_count);
+
+/**
+ * @brief Waits for the current melody to finish.
+ *
+ * @return ESP_OK when no melody is playing any more.
+ * @return ESP_ERR_TIMEOUT when the melody is still playing after timeout.
+ */
+esp_err_t tone_player_wait(TickType_t timeout);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TONE_PLAYER_H */
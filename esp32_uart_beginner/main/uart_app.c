@@ -1,4 +1,5 @@
 #include <ctype.h>
+#include <stdarg.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -12,6 +13,8 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
+#include "uart_cmd.h"
+
 #define APP_UART_PORT ((uart_port_t)CONFIG_APP_UART_PORT_NUM)
 #define APP_UART_TX_PIN CONFIG_APP_UART_TX_PIN
 #define APP_UART_RX_PIN CONFIG_APP_UART_RX_PIN
@@ -88,82 +91,144 @@ static esp_err_t app_uart_write_text(const char *text)
 }
 
 /**
- * @brief Converts a command line to uppercase in place.
+ * @brief Appends formatted text to a response buffer.
  *
- * Converting commands to uppercase makes the command interface
- * case-insensitive while leaving the parser simple for beginners.
+ * @param response Response buffer.
+ * @param response_size Size of response in bytes.
+ * @param length Number of bytes already used in response.
+ * @param format printf-style format string.
  *
- * @param text Mutable null-terminated command string.
+ * @return New response length, limited to the buffer size.
  */
-static void app_uart_to_uppercase(char *text)
+static size_t app_uart_append(
+    char *response,
+    size_t response_size,
+    size_t length,
+    const char *format,
+    ...
+)
 {
-    if (text == NULL) {
-        return;
+    if (length >= response_size) {
+        return length;
     }
 
-    while (*text != '\0') {
-        *text = (char)toupper((unsigned char)*text);
-        text++;
+    va_list args;
+    va_start(args, format);
+    const int written = vsnprintf(
+        &response[length],
+        response_size - length,
+        format,
+        args
+    );
+    va_end(args);
+
+    if (written < 0) {
+        return length;
     }
+
+    return length + (size_t)written;
 }
 
+static size_t app_uart_cmd_clear(int argc, char **argv, char *response, size_t response_size);
+static size_t app_uart_cmd_echo(int argc, char **argv, char *response, size_t response_size);
+static size_t app_uart_cmd_help(int argc, char **argv, char *response, size_t response_size);
+static size_t app_uart_cmd_ping(int argc, char **argv, char *response, size_t response_size);
+static size_t app_uart_cmd_status(int argc, char **argv, char *response, size_t response_size);
+
+/*
+ * Command table. Entries must stay sorted by name because dispatch uses a
+ * binary search; app_main() checks the order at startup.
+ */
+static const uart_cmd_t app_uart_commands[] = {
+    { "CLEAR",  "Print blank lines in the terminal",        0U, 0U,                      app_uart_cmd_clear },
+    { "ECHO",   "Return the text following ECHO",           0U, UART_CMD_MAX_ARGS - 1U, app_uart_cmd_echo },
+    { "HELP",   "Show this command list",                   0U, 0U,                      app_uart_cmd_help },
+    { "PING",   "Verify that the UART link is working",     0U, 0U,                      app_uart_cmd_ping },
+    { "STATUS", "Show the UART configuration and uptime",   0U, 0U,                      app_uart_cmd_status },
+};
+
+#define APP_UART_COMMAND_COUNT (sizeof(app_uart_commands) / sizeof(app_uart_commands[0]))
+
 /**
- * @brief Removes leading and trailing ASCII spaces from a string.
- *
- * @param text Mutable null-terminated string.
- *
- * @return Pointer to the first non-space character inside the original buffer.
+ * @brief Prints blank lines in the terminal.
  */
-static char *app_uart_trim(char *text)
+static size_t app_uart_cmd_clear(int argc, char **argv, char *response, size_t response_size)
 {
-    if (text == NULL) {
-        return NULL;
-    }
+    (void)argc;
+    (void)argv;
+
+    return app_uart_append(response, response_size, 0U, "\r\n\r\n\r\n\r\n\r\n");
+}
 
-    while ((*text == ' ') || (*text == '\t')) {
-        text++;
+/**
+ * @brief Returns the arguments, separated by single spaces.
+ */
+static size_t app_uart_cmd_echo(int argc, char **argv, char *response, size_t response_size)
+{
+    size_t length = 0U;
+
+    for (int index = 1; index < argc; index++) {
+        length = app_uart_append(
+            response,
+            response_size,
+            length,
+            (index > 1) ? " %s" : "%s",
+            argv[index]
+        );
     }
 
-    char *end = text + strlen(text);
-    while ((end > text) && ((end[-1] == ' ') || (end[-1] == '\t'))) {
-        end--;
+    return app_uart_append(response, response_size, length, "\r\n");
+}
+
+/**
+ * @brief Lists every command in the table with its description.
+ */
+static size_t app_uart_cmd_help(int argc, char **argv, char *response, size_t response_size)
+{
+    (void)argc;
+    (void)argv;
+
+    size_t length = app_uart_append(response, response_size, 0U, "\r\nSupported commands:\r\n");
+
+    for (size_t index = 0U; index < APP_UART_COMMAND_COUNT; index++) {
+        length = app_uart_append(
+            response,
+            response_size,
+            length,
+            "  %-7s - %s\r\n",
+            app_uart_commands[index].name,
+            app_uart_commands[index].help
+        );
     }
 
-    *end = '\0';
-    return text;
+    return app_uart_append(response, response_size, length, "\r\n");
 }
 
 /**
- * @brief Sends the list of commands supported by the example.
+ * @brief Answers PONG to confirm the link.
  */
-static void app_uart_send_help(void)
+static size_t app_uart_cmd_ping(int argc, char **argv, char *response, size_t response_size)
 {
-    static const char help_text[] =
-        "\r\nSupported commands:\r\n"
-        "  HELP    - Show this command list\r\n"
-        "  PING    - Verify that the UART link is working\r\n"
-        "  STATUS  - Show the UART configuration and uptime\r\n"
-        "  ECHO x  - Return the text following ECHO\r\n"
-        "  CLEAR   - Print blank lines in the terminal\r\n"
-        "\r\n";
-
-    ESP_ERROR_CHECK(app_uart_write_text(help_text));
+    (void)argc;
+    (void)argv;
+
+    return app_uart_append(response, response_size, 0U, "PONG\r\n");
 }
 
 /**
- * @brief Sends a status report over UART.
- *
- * The report includes the selected UART controller, GPIO assignments, baud
- * rate, and application uptime.
+ * @brief Reports the UART controller, GPIO assignments, baud rate, and uptime.
  */
-static void app_uart_send_status(void)
+static size_t app_uart_cmd_status(int argc, char **argv, char *response, size_t response_size)
 {
-    char response[192];
+    (void)argc;
+    (void)argv;
+
     const int64_t uptime_ms = esp_timer_get_time() / 1000;
 
-    const int length = snprintf(
+    return app_uart_append(
         response,
-        sizeof(response),
+        response_size,
+        0U,
         "UART%d status:\r\n"
         "  TX GPIO: %d\r\n"
         "  RX GPIO: %d\r\n"
@@ -175,62 +240,53 @@ static void app_uart_send_status(void)
         APP_UART_BAUD_RATE,
         (long long)uptime_ms
     );
-
-    if ((length < 0) || ((size_t)length >= sizeof(response))) {
-        ESP_LOGE(TAG, "Failed to format UART status response");
-        return;
-    }
-
-    ESP_ERROR_CHECK(app_uart_write((const uint8_t *)response, (size_t)length));
 }
 
 /**
  * @brief Executes one complete command received from the UART terminal.
  *
+ * The line is tokenized and looked up in app_uart_commands. The handler
+ * formats its reply into a static buffer, which is sent with one UART write.
+ *
  * @param command_line Mutable null-terminated command line without CR or LF.
  */
 static void app_uart_process_command(char *command_line)
 {
-    char *command = app_uart_trim(command_line);
-    if ((command == NULL) || (*command == '\0')) {
-        return;
-    }
-
-    // Keep a copy of the original text so the ECHO payload preserves its case.
-    char original[APP_UART_LINE_BUFFER_SIZE];
-    (void)snprintf(original, sizeof(original), "%s", command);
+    // Only the receive task calls this function, so one buffer is enough.
+    static char response[UART_CMD_RESPONSE_SIZE];
+    size_t response_length = 0U;
 
-    app_uart_to_uppercase(command);
-
-    if (strcmp(command, "HELP") == 0) {
-        app_uart_send_help();
+    if (command_line == NULL) {
         return;
     }
 
-    if (strcmp(command, "PING") == 0) {
-        ESP_ERROR_CHECK(app_uart_write_text("PONG\r\n"));
-        return;
-    }
-
-    if (strcmp(command, "STATUS") == 0) {
-        app_uart_send_status();
-        return;
-    }
-
-    if (strcmp(command, "CLEAR") == 0) {
-        ESP_ERROR_CHECK(app_uart_write_text("\r\n\r\n\r\n\r\n\r\n"));
-        return;
-    }
+    const uart_cmd_status_t status = uart_cmd_dispatch(
+        app_uart_commands,
+        APP_UART_COMMAND_COUNT,
+        command_line,
+        response,
+        sizeof(response),
+        &response_length
+    );
 
-    if (strncmp(command, "ECHO ", 5U) == 0) {
-        ESP_ERROR_CHECK(app_uart_write_text(&original[5]));
-        ESP_ERROR_CHECK(app_uart_write_text("\r\n"));
-        return;
+    switch (status) {
+    case UART_CMD_OK:
+        ESP_ERROR_CHECK(app_uart_write((const uint8_t *)response, response_length));
+        break;
+    case UART_CMD_UNKNOWN:
+        ESP_ERROR_CHECK(
+            app_uart_write_text("Unknown command. Type HELP for a command list.\r\n")
+        );
+        break;
+    case UART_CMD_BAD_ARGS:
+        ESP_ERROR_CHECK(
+            app_uart_write_text("Wrong number of arguments. Type HELP for a command list.\r\n")
+        );
+        break;
+    case UART_CMD_EMPTY:
+    default:
+        break;
     }
-
-    ESP_ERROR_CHECK(
-        app_uart_write_text("Unknown command. Type HELP for a command list.\r\n")
-    );
 }
 
 /**
@@ -407,6 +463,9 @@ static esp_err_t app_uart_init(void)
  */
 void app_main(void)
 {
+    // A mis-sorted command table would make lookups miss, so fail early.
+    ESP_ERROR_CHECK(uart_cmd_check_table(app_uart_commands, APP_UART_COMMAND_COUNT));
+
     // Initialize the UART driver and GPIO routing, then start the receive task.
     ESP_ERROR_CHECK(app_uart_init());
 
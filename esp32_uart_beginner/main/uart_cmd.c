@@ -0,0 +1,139 @@
+#include "uart_cmd.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief Compares a verb with a table entry for bsearch().
+ *
+ * @param key Pointer to the uppercase verb string.
+ * @param element Pointer to a uart_cmd_t entry.
+ *
+ * @return Negative, zero, or positive, in the same sense as strcmp().
+ */
+static int uart_cmd_compare(const void *key, const void *element)
+{
+    const char *verb = (const char *)key;
+    const uart_cmd_t *command = (const uart_cmd_t *)element;
+
+    return strcmp(verb, command->name);
+}
+
+/**
+ * @brief Splits a line into space- or tab-separated tokens.
+ *
+ * @param line Mutable null-terminated line.
+ * @param argv Output token array with UART_CMD_MAX_ARGS entries.
+ * @param too_many Set to true when tokens remain after argv is full.
+ *
+ * @return Number of tokens stored in argv.
+ */
+static int uart_cmd_tokenize(char *line, char **argv, bool *too_many)
+{
+    int argc = 0;
+
+    *too_many = false;
+
+    while (*line != '\0') {
+        while ((*line == ' ') || (*line == '\t')) {
+            *line++ = '\0';
+        }
+
+        if (*line == '\0') {
+            break;
+        }
+
+        if (argc == (int)UART_CMD_MAX_ARGS) {
+            *too_many = true;
+            break;
+        }
+
+        argv[argc++] = line;
+
+        while ((*line != '\0') && (*line != ' ') && (*line != '\t')) {
+            line++;
+        }
+    }
+
+    return argc;
+}
+
+esp_err_t uart_cmd_check_table(const uart_cmd_t *table, size_t count)
+{
+    if ((table == NULL) && (count > 0U)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t index = 0U; index < count; index++) {
+        const uart_cmd_t *command = &table[index];
+
+        if ((command->name == NULL) || (command->handler == NULL) ||
+            (command->min_args > command->max_args) ||
+            (command->max_args >= UART_CMD_MAX_ARGS)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        for (const char *c = command->name; *c != '\0'; c++) {
+            if (islower((unsigned char)*c)) {
+                return ESP_ERR_INVALID_ARG;
+            }
+        }
+
+        // Strictly increasing order also rules out duplicate names.
+        if ((index > 0U) && (strcmp(table[index - 1U].name, command->name) >= 0)) {
+            return ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    return ESP_OK;
+}
+
+uart_cmd_status_t uart_cmd_dispatch(
+    const uart_cmd_t *table,
+    size_t count,
+    char *line,
+    char *response,
+    size_t response_size,
+    size_t *response_length
+)
+{
+    char *argv[UART_CMD_MAX_ARGS];
+    bool too_many = false;
+
+    *response_length = 0U;
+
+    const int argc = uart_cmd_tokenize(line, argv, &too_many);
+    if (argc == 0) {
+        return UART_CMD_EMPTY;
+    }
+
+    for (char *c = argv[0]; *c != '\0'; c++) {
+        *c = (char)toupper((unsigned char)*c);
+    }
+
+    const uart_cmd_t *command = bsearch(
+        argv[0],
+        table,
+        count,
+        sizeof(table[0]),
+        uart_cmd_compare
+    );
+    if (command == NULL) {
+        return UART_CMD_UNKNOWN;
+    }
+
+    const unsigned int arg_count = (unsigned int)argc - 1U;
+    if (too_many || (arg_count < command->min_args) ||
+        (arg_count > command->max_args)) {
+        return UART_CMD_BAD_ARGS;
+    }
+
+    size_t length = command->handler(argc, argv, response, response_size);
+    if (length >= response_size) {
+        length = (response_size > 0U) ? (response_size - 1U) : 0U;
+    }
+
+    *response_length = length;
+    return UART_CMD_OK;
+}
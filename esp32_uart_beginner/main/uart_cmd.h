@@ -0,0 +1,105 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "esp_err.h"
+
+/**
+ * @file uart_cmd.h
+ * @brief Table-driven command dispatcher for line-based UART terminals.
+ *
+ * A command table is a constant array of uart_cmd_t entries sorted by name.
+ * Each received line is split into a fixed argv array, the verb is found with
+ * a binary search, and the handler formats its response into a buffer owned
+ * by the dispatcher. The caller then sends that buffer with a single write.
+ *
+ * The module has no UART dependency, so another UART project can copy
+ * uart_cmd.c and uart_cmd.h unchanged and provide its own table.
+ */
+
+/** Maximum number of tokens in one command line, including the verb. */
+#define UART_CMD_MAX_ARGS 8U
+
+/** Size of the response buffer; HELP output for the whole table must fit. */
+#ifndef UART_CMD_RESPONSE_SIZE
+#define UART_CMD_RESPONSE_SIZE 1024U
+#endif
+
+/**
+ * @brief Command handler.
+ *
+ * @param argc Number of tokens in argv; argv[0] is the uppercased verb.
+ * @param argv Tokens in their original case, except argv[0].
+ * @param response Buffer for the response text.
+ * @param response_size Size of response in bytes.
+ *
+ * @return Number of response bytes written, excluding any terminator.
+ */
+typedef size_t (*uart_cmd_handler_t)(
+    int argc,
+    char **argv,
+    char *response,
+    size_t response_size
+);
+
+/**
+ * @brief One entry of a command table.
+ */
+typedef struct {
+    const char *name;           /**< Uppercase verb used as the search key. */
+    const char *help;           /**< One-line description for HELP output. */
+    unsigned int min_args;      /**< Minimum number of arguments after the verb. */
+    unsigned int max_args;      /**< Maximum number of arguments after the verb. */
+    uart_cmd_handler_t handler; /**< Function that formats the response. */
+} uart_cmd_t;
+
+/**
+ * @brief Result of dispatching one command line.
+ */
+typedef enum {
+    UART_CMD_OK = 0,       /**< A handler ran and filled the response. */
+    UART_CMD_EMPTY,        /**< The line held no tokens. */
+    UART_CMD_UNKNOWN,      /**< No table entry matches the verb. */
+    UART_CMD_BAD_ARGS,     /**< The argument count is outside the entry's range. */
+} uart_cmd_status_t;
+
+/**
+ * @brief Verifies that a command table is sorted and usable.
+ *
+ * Call once at startup. Dispatch relies on the table being sorted by name,
+ * so an unsorted table would silently miss commands.
+ *
+ * @param table Command table.
+ * @param count Number of entries in table.
+ *
+ * @return
+ *     - ESP_OK: The table is sorted with unique uppercase names and handlers.
+ *     - ESP_ERR_INVALID_ARG: The table is NULL, unsorted, or has a bad entry.
+ */
+esp_err_t uart_cmd_check_table(const uart_cmd_t *table, size_t count);
+
+/**
+ * @brief Tokenizes a command line and runs the matching handler.
+ *
+ * The line is modified in place: separators become terminators and the verb
+ * is converted to uppercase. Tokens beyond UART_CMD_MAX_ARGS are treated as
+ * too many arguments.
+ *
+ * @param table Command table checked with uart_cmd_check_table().
+ * @param count Number of entries in table.
+ * @param line Mutable null-terminated command line.
+ * @param response Buffer that receives the handler's response.
+ * @param response_size Size of response in bytes.
+ * @param response_length Receives the response length; 0 unless UART_CMD_OK.
+ *
+ * @return Dispatch result.
+ */
+uart_cmd_status_t uart_cmd_dispatch(
+    const uart_cmd_t *table,
+    size_t count,
+    char *line,
+    char *response,
+    size_t response_size,
+    size_t *response_length
+);
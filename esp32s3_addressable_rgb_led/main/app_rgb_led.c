@@ -1,26 +1,111 @@
 #include "app_rgb_led.h"
 
+#include <inttypes.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#include "driver/rmt_tx.h"
+#include "esp_attr.h"
 #include "esp_check.h"
-#include "led_strip.h"
+#include "esp_heap_caps.h"
+#include "soc/soc_caps.h"
+
+#include "rgb_led_encoder.h"
+
+#define APP_RGB_LED_RESOLUTION_HZ       (10 * 1000 * 1000)
+#define APP_RGB_LED_RESET_US            280U
+#define APP_RGB_LED_BYTES_PER_LED       3U
+#define APP_RGB_LED_TX_BUFFER_COUNT     2
+#define APP_RGB_LED_MEM_SYMBOLS         64
+#define APP_RGB_LED_DMA_MEM_SYMBOLS     1024
 
 static const char *TAG = "app_rgb_led";
 
-static led_strip_handle_t s_strip;
+typedef struct {
+    rmt_channel_handle_t channel;
+    rmt_encoder_handle_t encoder;
+    uint32_t first_led;
+    uint32_t done_buffer;           /* Transmit buffer of this strip's next completion */
+} app_rgb_led_strip_t;
+
+static app_rgb_led_strip_t s_strips[APP_RGB_LED_MAX_STRIPS];
+static uint32_t s_strip_count;
+static uint32_t s_strip_led_count;
+static rmt_sync_manager_handle_t s_sync_manager;
 static uint32_t s_led_count;
 static uint8_t s_brightness = 32;
+static float s_gamma = 1.0f;
+static app_rgb_led_rgb_t s_white_balance = { .red = 255, .green = 255, .blue = 255 };
+static bool s_dithering;
+static uint32_t s_frame_count;
+
+/* Unscaled RGB frame that the application draws into. */
+static app_rgb_led_rgb_t *s_frame;
+
+/* GRB bytes after brightness and gamma; one buffer may be in flight while the other is filled. */
+static uint8_t *s_tx_buffers[APP_RGB_LED_TX_BUFFER_COUNT];
+static uint32_t s_tx_next;
+static SemaphoreHandle_t s_tx_free;
+
+/* Strips still sending each transmit buffer; the buffer is free again at zero. */
+static uint32_t s_tx_pending[APP_RGB_LED_TX_BUFFER_COUNT];
+static portMUX_TYPE s_tx_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/*
+ * Gamma, white balance and brightness folded into one table per channel,
+ * rebuilt when any of them changes. The 8.8 tables keep the fraction for
+ * temporal dithering; the 8-bit tables are the rounded values.
+ */
+enum {
+    LUT_RED = 0,
+    LUT_GREEN,
+    LUT_BLUE,
+    LUT_CHANNEL_COUNT,
+};
+static uint8_t s_channel_lut[LUT_CHANNEL_COUNT][256];
+static uint16_t s_channel_lut16[LUT_CHANNEL_COUNT][256];
+
+/* Eight dither thresholds in bit-reversed order, so every run of frames averages out. */
+static const uint8_t s_dither_thresholds[8] = { 0, 128, 64, 192, 32, 160, 96, 224 };
+
+static app_rgb_led_frame_done_cb_t s_frame_done_cb;
+static void *s_frame_done_ctx;
 
 /**
- * @brief Scales an 8-bit color channel by the configured brightness value.
- *
- * Args:
- *     value: Original color channel value from 0 to 255.
+ * @brief Rebuilds the channel lookup tables.
  *
- * Returns:
- *     Brightness-scaled color channel value from 0 to 255.
+ * Each entry is value^gamma * brightness * white_balance, scaled so 255
+ * at full brightness and balance stays 255. This is the only place with
+ * floating point; present() only looks values up.
  */
-static uint8_t scale_channel(uint8_t value)
+static void rebuild_channel_lut(void)
 {
-    return (uint8_t)(((uint16_t)value * s_brightness) / 255U);
+    const uint8_t balance[LUT_CHANNEL_COUNT] = {
+        [LUT_RED] = s_white_balance.red,
+        [LUT_GREEN] = s_white_balance.green,
+        [LUT_BLUE] = s_white_balance.blue,
+    };
+
+    for (uint32_t value = 0; value < 256U; value++) {
+        float corrected = (float)value;
+
+        if (s_gamma != 1.0f) {
+            corrected = powf((float)value / 255.0f, s_gamma) * 255.0f;
+        }
+        for (uint32_t channel = 0; channel < LUT_CHANNEL_COUNT; channel++) {
+            const float scaled = corrected * (float)s_brightness * (float)balance[channel] / (255.0f * 255.0f);
+            const uint32_t fixed = (uint32_t)lroundf(scaled * 256.0f);
+
+            const uint16_t entry = (uint16_t)((fixed > 0xFF00U) ? 0xFF00U : fixed);
+
+            s_channel_lut16[channel][value] = entry;
+            s_channel_lut[channel][value] = (uint8_t)((entry + 0x80U) >> 8);
+        }
+    }
 }
 
 /**
@@ -31,7 +116,76 @@ static uint8_t scale_channel(uint8_t value)
  */
 static bool is_initialized(void)
 {
-    return s_strip != NULL;
+    return s_strip_count > 0;
+}
+
+/**
+ * @brief RMT transmit-done callback, run in interrupt context.
+ *
+ * Each strip finishes its transmissions in the order they were queued and
+ * the transmit buffers alternate, so every strip tracks which buffer its
+ * next completion belongs to. The last strip to finish a buffer releases
+ * it, and that buffer is always the next one app_rgb_led_present() fills.
+ */
+static bool IRAM_ATTR on_trans_done(rmt_channel_handle_t channel, const rmt_tx_done_event_data_t *edata, void *user_ctx)
+{
+    app_rgb_led_strip_t *strip = user_ctx;
+    BaseType_t task_woken = pdFALSE;
+    bool frame_done;
+
+    portENTER_CRITICAL_ISR(&s_tx_lock);
+    frame_done = (--s_tx_pending[strip->done_buffer] == 0U);
+    portEXIT_CRITICAL_ISR(&s_tx_lock);
+    strip->done_buffer = (strip->done_buffer + 1U) % APP_RGB_LED_TX_BUFFER_COUNT;
+
+    if (frame_done) {
+        xSemaphoreGiveFromISR(s_tx_free, &task_woken);
+        if (s_frame_done_cb != NULL) {
+            s_frame_done_cb(s_frame_done_ctx);
+        }
+    }
+
+    return task_woken == pdTRUE;
+}
+
+/**
+ * @brief Releases every resource held by the driver.
+ */
+static void release_resources(void)
+{
+    if (s_sync_manager != NULL) {
+        rmt_del_sync_manager(s_sync_manager);
+        s_sync_manager = NULL;
+    }
+    for (uint32_t i = 0; i < APP_RGB_LED_MAX_STRIPS; i++) {
+        app_rgb_led_strip_t *strip = &s_strips[i];
+
+        if (strip->channel != NULL) {
+            rmt_disable(strip->channel);
+            rmt_del_channel(strip->channel);
+        }
+        if (strip->encoder != NULL) {
+            rmt_del_encoder(strip->encoder);
+        }
+        *strip = (app_rgb_led_strip_t){ 0 };
+    }
+    s_strip_count = 0;
+    s_strip_led_count = 0;
+    if (s_tx_free != NULL) {
+        vSemaphoreDelete(s_tx_free);
+        s_tx_free = NULL;
+    }
+    for (int i = 0; i < APP_RGB_LED_TX_BUFFER_COUNT; i++) {
+        heap_caps_free(s_tx_buffers[i]);
+        s_tx_buffers[i] = NULL;
+    }
+    free(s_frame);
+    s_frame = NULL;
+    s_led_count = 0;
+    s_tx_next = 0;
+    memset(s_tx_pending, 0, sizeof(s_tx_pending));
+    s_frame_done_cb = NULL;
+    s_frame_done_ctx = NULL;
 }
 
 /**
@@ -45,35 +199,99 @@ static bool is_initialized(void)
  */
 esp_err_t app_rgb_led_init(const app_rgb_led_config_t *config)
 {
+    esp_err_t ret = ESP_OK;
+
     ESP_RETURN_ON_FALSE(config != NULL, ESP_ERR_INVALID_ARG, TAG, "Configuration is NULL");
     ESP_RETURN_ON_FALSE(config->led_count > 0, ESP_ERR_INVALID_ARG, TAG, "LED count must be greater than zero");
+    ESP_RETURN_ON_FALSE(config->gamma >= 0.0f, ESP_ERR_INVALID_ARG, TAG, "Gamma must not be negative");
+    ESP_RETURN_ON_FALSE(config->strip_count <= APP_RGB_LED_MAX_STRIPS, ESP_ERR_INVALID_ARG, TAG,
+                        "Too many strips");
     ESP_RETURN_ON_FALSE(!is_initialized(), ESP_ERR_INVALID_STATE, TAG, "Driver already initialized");
 
-    led_strip_config_t strip_config = {
-        .strip_gpio_num = config->gpio_num,
-        .max_leds = config->led_count,
-        .led_model = LED_MODEL_WS2812,
-        .color_component_format = LED_STRIP_COLOR_COMPONENT_FMT_GRB,
-        .flags = {
-            .invert_out = false,
-        },
-    };
+    const uint32_t strip_count = (config->strip_count > 1U) ? config->strip_count : 1U;
+    ESP_RETURN_ON_FALSE(config->led_count % strip_count == 0U, ESP_ERR_INVALID_ARG, TAG,
+                        "LED count must divide evenly between the strips");
 
-    led_strip_rmt_config_t rmt_config = {
-        .clk_src = RMT_CLK_SRC_DEFAULT,
-        .resolution_hz = 10 * 1000 * 1000,
-        .mem_block_symbols = 64,
-        .flags = {
-            .with_dma = config->enable_dma,
-        },
-    };
+    const size_t tx_size = config->led_count * APP_RGB_LED_BYTES_PER_LED;
 
-    ESP_RETURN_ON_ERROR(led_strip_new_rmt_device(&strip_config, &rmt_config, &s_strip), TAG, "Failed to create LED strip device");
+    s_frame = calloc(config->led_count, sizeof(app_rgb_led_rgb_t));
+    ESP_GOTO_ON_FALSE(s_frame != NULL, ESP_ERR_NO_MEM, err, TAG, "No memory for pixel frame");
+    for (int i = 0; i < APP_RGB_LED_TX_BUFFER_COUNT; i++) {
+        s_tx_buffers[i] = heap_caps_calloc(1, tx_size, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+        ESP_GOTO_ON_FALSE(s_tx_buffers[i] != NULL, ESP_ERR_NO_MEM, err, TAG, "No memory for transmit buffer");
+    }
+    s_tx_free = xSemaphoreCreateCounting(APP_RGB_LED_TX_BUFFER_COUNT, APP_RGB_LED_TX_BUFFER_COUNT);
+    ESP_GOTO_ON_FALSE(s_tx_free != NULL, ESP_ERR_NO_MEM, err, TAG, "No memory for transmit semaphore");
+
+    const rgb_led_encoder_config_t encoder_config = {
+        .resolution_hz = APP_RGB_LED_RESOLUTION_HZ,
+        .reset_us = APP_RGB_LED_RESET_US,
+    };
+    const rmt_tx_event_callbacks_t callbacks = {
+        .on_trans_done = on_trans_done,
+    };
+    rmt_channel_handle_t channels[APP_RGB_LED_MAX_STRIPS] = { 0 };
+
+    for (uint32_t i = 0; i < strip_count; i++) {
+        app_rgb_led_strip_t *strip = &s_strips[i];
+        const bool with_dma = config->enable_dma && i == 0U;
+
+        /* Several strips share the RMT memory, so each one keeps to a single block. */
+        const rmt_tx_channel_config_t channel_config = {
+            .gpio_num = (strip_count > 1U) ? config->strip_gpio_nums[i] : config->gpio_num,
+            .clk_src = RMT_CLK_SRC_DEFAULT,
+            .resolution_hz = APP_RGB_LED_RESOLUTION_HZ,
+            .mem_block_symbols = with_dma ? APP_RGB_LED_DMA_MEM_SYMBOLS
+                                 : (strip_count > 1U) ? SOC_RMT_MEM_WORDS_PER_CHANNEL : APP_RGB_LED_MEM_SYMBOLS,
+            .trans_queue_depth = APP_RGB_LED_TX_BUFFER_COUNT,
+            .flags = {
+                .invert_out = false,
+                .with_dma = with_dma,
+            },
+        };
+
+        ESP_GOTO_ON_ERROR(rgb_led_encoder_new(&encoder_config, &strip->encoder), err, TAG,
+                          "Failed to create LED encoder");
+        ESP_GOTO_ON_ERROR(rmt_new_tx_channel(&channel_config, &strip->channel), err, TAG,
+                          "Failed to create RMT channel for strip %" PRIu32, i);
+        ESP_GOTO_ON_ERROR(rmt_tx_register_event_callbacks(strip->channel, &callbacks, strip), err, TAG,
+                          "Failed to register RMT callback");
+        ESP_GOTO_ON_ERROR(rmt_enable(strip->channel), err, TAG, "Failed to enable RMT channel");
+
+        strip->first_led = i * (config->led_count / strip_count);
+        channels[i] = strip->channel;
+    }
+    s_strip_count = strip_count;
+
+#if SOC_RMT_SUPPORT_TX_SYNCHRO
+    /* Start every strip on the same clock edge, so the frame appears at once. */
+    if (strip_count > 1U) {
+        const rmt_sync_manager_config_t sync_config = {
+            .tx_channel_array = channels,
+            .array_size = strip_count,
+        };
+        ESP_GOTO_ON_ERROR(rmt_new_sync_manager(&sync_config, &s_sync_manager), err, TAG,
+                          "Failed to create RMT sync manager");
+    }
+#endif
 
     s_led_count = config->led_count;
+    s_strip_led_count = config->led_count / strip_count;
     s_brightness = config->brightness;
+    s_gamma = (config->gamma > 0.0f) ? config->gamma : 1.0f;
+    s_dithering = config->enable_dithering;
+    if (config->white_balance.red != 0 || config->white_balance.green != 0 || config->white_balance.blue != 0) {
+        s_white_balance = config->white_balance;
+    } else {
+        s_white_balance = (app_rgb_led_rgb_t){ .red = 255, .green = 255, .blue = 255 };
+    }
+    rebuild_channel_lut();
 
     return app_rgb_led_clear();
+
+err:
+    release_resources();
+    return ret;
 }
 
 /**
@@ -86,13 +304,10 @@ esp_err_t app_rgb_led_deinit(void)
 {
     ESP_RETURN_ON_FALSE(is_initialized(), ESP_ERR_INVALID_STATE, TAG, "Driver is not initialized");
 
-    esp_err_t err = led_strip_del(s_strip);
-    if (err == ESP_OK) {
-        s_strip = NULL;
-        s_led_count = 0;
-    }
+    ESP_RETURN_ON_ERROR(app_rgb_led_wait_done(-1), TAG, "Failed to finish pending frames");
+    release_resources();
 
-    return err;
+    return ESP_OK;
 }
 
 /**
@@ -108,7 +323,47 @@ esp_err_t app_rgb_led_set_brightness(uint8_t brightness)
 {
     ESP_RETURN_ON_FALSE(is_initialized(), ESP_ERR_INVALID_STATE, TAG, "Driver is not initialized");
 
-    s_brightness = brightness;
+    if (brightness != s_brightness) {
+        s_brightness = brightness;
+        rebuild_channel_lut();
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Sets the per-channel white balance.
+ *
+ * Args:
+ *     white_balance: Scale for each channel (0-255).
+ *
+ * Returns:
+ *     ESP_OK if successful, otherwise an error code.
+ */
+esp_err_t app_rgb_led_set_white_balance(app_rgb_led_rgb_t white_balance)
+{
+    ESP_RETURN_ON_FALSE(is_initialized(), ESP_ERR_INVALID_STATE, TAG, "Driver is not initialized");
+
+    if (memcmp(&white_balance, &s_white_balance, sizeof(white_balance)) != 0) {
+        s_white_balance = white_balance;
+        rebuild_channel_lut();
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Enables or disables temporal dithering.
+ *
+ * Args:
+ *     enable: True to dither, false to round.
+ *
+ * Returns:
+ *     ESP_OK if successful, otherwise an error code.
+ */
+esp_err_t app_rgb_led_set_dithering(bool enable)
+{
+    ESP_RETURN_ON_FALSE(is_initialized(), ESP_ERR_INVALID_STATE, TAG, "Driver is not initialized");
+
+    s_dithering = enable;
     return ESP_OK;
 }
 
@@ -140,13 +395,7 @@ esp_err_t app_rgb_led_set_pixel(uint32_t index, uint8_t red, uint8_t green, uint
     ESP_RETURN_ON_FALSE(is_initialized(), ESP_ERR_INVALID_STATE, TAG, "Driver is not initialized");
     ESP_RETURN_ON_FALSE(index < s_led_count, ESP_ERR_INVALID_ARG, TAG, "LED index is out of range");
 
-    ESP_RETURN_ON_ERROR(led_strip_set_pixel(s_strip,
-                                            index,
-                                            scale_channel(red),
-                                            scale_channel(green),
-                                            scale_channel(blue)),
-                        TAG,
-                        "Failed to set LED pixel");
+    s_frame[index] = (app_rgb_led_rgb_t){ .red = red, .green = green, .blue = blue };
 
     return app_rgb_led_refresh();
 }
@@ -195,14 +444,9 @@ esp_err_t app_rgb_led_fill(uint8_t red, uint8_t green, uint8_t blue)
 {
     ESP_RETURN_ON_FALSE(is_initialized(), ESP_ERR_INVALID_STATE, TAG, "Driver is not initialized");
 
+    const app_rgb_led_rgb_t color = { .red = red, .green = green, .blue = blue };
     for (uint32_t index = 0; index < s_led_count; index++) {
-        ESP_RETURN_ON_ERROR(led_strip_set_pixel(s_strip,
-                                                index,
-                                                scale_channel(red),
-                                                scale_channel(green),
-                                                scale_channel(blue)),
-                            TAG,
-                            "Failed to set LED pixel");
+        s_frame[index] = color;
     }
 
     return app_rgb_led_refresh();
@@ -218,7 +462,8 @@ esp_err_t app_rgb_led_clear(void)
 {
     ESP_RETURN_ON_FALSE(is_initialized(), ESP_ERR_INVALID_STATE, TAG, "Driver is not initialized");
 
-    return led_strip_clear(s_strip);
+    memset(s_frame, 0, s_led_count * sizeof(app_rgb_led_rgb_t));
+    return app_rgb_led_refresh();
 }
 
 /**
@@ -228,10 +473,164 @@ esp_err_t app_rgb_led_clear(void)
  *     ESP_OK if successful, otherwise an error code.
  */
 esp_err_t app_rgb_led_refresh(void)
+{
+    ESP_RETURN_ON_ERROR(app_rgb_led_present(), TAG, "Failed to present frame");
+
+    return app_rgb_led_wait_done(-1);
+}
+
+/**
+ * @brief Gets the pixel frame for the next present.
+ *
+ * Returns:
+ *     Pointer to the frame, or NULL if the driver is not initialized.
+ */
+app_rgb_led_rgb_t *app_rgb_led_get_frame(void)
+{
+    return s_frame;
+}
+
+/**
+ * @brief Gets the number of LEDs in the frame.
+ *
+ * Returns:
+ *     The LED count.
+ */
+uint32_t app_rgb_led_get_count(void)
+{
+    return s_led_count;
+}
+
+/**
+ * @brief Recovers from a frame that only some strips accepted.
+ *
+ * Strips that did not queue the frame will never complete its buffer, so
+ * the per-strip completion order no longer matches. Drains every strip,
+ * then restarts the buffer bookkeeping from a clean state.
+ *
+ * Args:
+ *     queued: Number of strips that queued the frame.
+ */
+static void abort_present(uint32_t queued)
+{
+    bool release;
+
+    portENTER_CRITICAL(&s_tx_lock);
+    s_tx_pending[s_tx_next] -= s_strip_count - queued;
+    release = (s_tx_pending[s_tx_next] == 0U);
+    portEXIT_CRITICAL(&s_tx_lock);
+    if (release) {
+        xSemaphoreGive(s_tx_free);
+    }
+
+    for (uint32_t i = 0; i < s_strip_count; i++) {
+        rmt_tx_wait_all_done(s_strips[i].channel, -1);
+        s_strips[i].done_buffer = 0;
+    }
+    memset(s_tx_pending, 0, sizeof(s_tx_pending));
+    s_tx_next = 0;
+}
+
+/**
+ * @brief Converts the frame to scaled GRB bytes and starts sending them.
+ *
+ * Returns:
+ *     ESP_OK if successful, otherwise an error code.
+ */
+esp_err_t app_rgb_led_present(void)
 {
     ESP_RETURN_ON_FALSE(is_initialized(), ESP_ERR_INVALID_STATE, TAG, "Driver is not initialized");
 
-    return led_strip_refresh(s_strip);
+    xSemaphoreTake(s_tx_free, portMAX_DELAY);
+
+    /* One lookup per channel; no multiplies or divides in the per-pixel loop. */
+    uint8_t *out = s_tx_buffers[s_tx_next];
+    const app_rgb_led_rgb_t *pixel = s_frame;
+    if (s_dithering) {
+        /*
+         * Add a threshold below one output step to the 8.8 value and keep the
+         * integer part. The threshold cycles over eight frames and is offset
+         * per pixel, so the fraction averages out in time without the whole
+         * strip stepping together.
+         */
+        const uint32_t frame = s_frame_count++;
+        for (uint32_t index = 0; index < s_led_count; index++, pixel++, out += APP_RGB_LED_BYTES_PER_LED) {
+            const uint32_t threshold = s_dither_thresholds[(frame + index) & 7U];
+            out[0] = (uint8_t)((s_channel_lut16[LUT_GREEN][pixel->green] + threshold) >> 8);
+            out[1] = (uint8_t)((s_channel_lut16[LUT_RED][pixel->red] + threshold) >> 8);
+            out[2] = (uint8_t)((s_channel_lut16[LUT_BLUE][pixel->blue] + threshold) >> 8);
+        }
+    } else {
+        for (uint32_t index = 0; index < s_led_count; index++, pixel++, out += APP_RGB_LED_BYTES_PER_LED) {
+            out[0] = s_channel_lut[LUT_GREEN][pixel->green];
+            out[1] = s_channel_lut[LUT_RED][pixel->red];
+            out[2] = s_channel_lut[LUT_BLUE][pixel->blue];
+        }
+    }
+
+    const rmt_transmit_config_t tx_config = {
+        .loop_count = 0,
+    };
+    const size_t strip_bytes = s_strip_led_count * APP_RGB_LED_BYTES_PER_LED;
+
+    portENTER_CRITICAL(&s_tx_lock);
+    s_tx_pending[s_tx_next] = s_strip_count;
+    portEXIT_CRITICAL(&s_tx_lock);
+
+    for (uint32_t i = 0; i < s_strip_count; i++) {
+        const app_rgb_led_strip_t *strip = &s_strips[i];
+        esp_err_t err = rmt_transmit(strip->channel, strip->encoder,
+                                     s_tx_buffers[s_tx_next] + strip->first_led * APP_RGB_LED_BYTES_PER_LED,
+                                     strip_bytes, &tx_config);
+        if (err != ESP_OK) {
+            abort_present(i);
+            ESP_LOGE(TAG, "Failed to transmit frame on strip %" PRIu32 ": %s", i, esp_err_to_name(err));
+            return err;
+        }
+    }
+
+    s_tx_next = (s_tx_next + 1U) % APP_RGB_LED_TX_BUFFER_COUNT;
+    return ESP_OK;
+}
+
+/**
+ * @brief Waits until every presented frame has been sent.
+ *
+ * Args:
+ *     timeout_ms: Maximum wait in milliseconds, or -1 to wait forever.
+ *
+ * Returns:
+ *     ESP_OK if successful, otherwise an error code.
+ */
+esp_err_t app_rgb_led_wait_done(int timeout_ms)
+{
+    ESP_RETURN_ON_FALSE(is_initialized(), ESP_ERR_INVALID_STATE, TAG, "Driver is not initialized");
+
+    for (uint32_t i = 0; i < s_strip_count; i++) {
+        ESP_RETURN_ON_ERROR(rmt_tx_wait_all_done(s_strips[i].channel, timeout_ms), TAG,
+                            "Strip %" PRIu32 " did not finish", i);
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Registers the frame-done callback.
+ *
+ * Args:
+ *     callback: Function to call from the RMT interrupt, or NULL.
+ *     user_ctx: Pointer passed to the callback.
+ *
+ * Returns:
+ *     ESP_OK if successful, otherwise an error code.
+ */
+esp_err_t app_rgb_led_register_frame_done_cb(app_rgb_led_frame_done_cb_t callback, void *user_ctx)
+{
+    ESP_RETURN_ON_FALSE(is_initialized(), ESP_ERR_INVALID_STATE, TAG, "Driver is not initialized");
+
+    s_frame_done_cb = NULL;
+    s_frame_done_ctx = user_ctx;
+    s_frame_done_cb = callback;
+    return ESP_OK;
 }
 
 /**
@@ -10,6 +10,9 @@
 extern "C" {
 #endif
 
+/* Parallel strips are limited by the RMT TX channels; the ESP32-S3 has four. */
+#define APP_RGB_LED_MAX_STRIPS 4
+
 typedef enum {
     APP_RGB_LED_COLOR_OFF = 0,
     APP_RGB_LED_COLOR_RED,
@@ -34,11 +37,31 @@ typedef struct {
     uint32_t led_count;
     uint8_t brightness;
     bool enable_dma;
+    float gamma;
+    app_rgb_led_rgb_t white_balance;                /* Per-channel scale; all zero means 255, 255, 255 */
+    bool enable_dithering;
+    uint32_t strip_count;                           /* 0 or 1 drives a single strip on gpio_num */
+    int strip_gpio_nums[APP_RGB_LED_MAX_STRIPS];    /* One data pin per strip when strip_count > 1 */
 } app_rgb_led_config_t;
 
+/**
+ * @brief Called from the RMT interrupt when a presented frame has been sent.
+ *
+ * Args:
+ *     user_ctx: Context pointer given at registration.
+ */
+typedef void (*app_rgb_led_frame_done_cb_t)(void *user_ctx);
+
 /**
  * @brief Initializes the addressable RGB LED driver.
  *
+ * With strip_count above 1, the frame of led_count pixels is split into
+ * consecutive segments of led_count / strip_count pixels, one per strip
+ * (led_count must divide evenly), and every strip is sent on its
+ * own RMT channel at the same time. The refresh time then depends on the
+ * longest segment instead of the whole chain. DMA, when enabled, is used
+ * by the first strip only.
+ *
  * Args:
  *     config: Pointer to the RGB LED configuration structure.
  *
@@ -71,6 +94,40 @@ esp_err_t app_rgb_led_deinit(void);
  */
 esp_err_t app_rgb_led_set_brightness(uint8_t brightness);
 
+/**
+ * @brief Sets the per-channel white balance.
+ *
+ * Each channel is scaled by its value / 255 on top of brightness and gamma,
+ * for example to pull the blue of a cold-white strip down. The scaling is
+ * folded into the channel lookup tables, so it costs nothing per frame.
+ *
+ * Args:
+ *     white_balance: Scale for each channel from 0 to 255.
+ *
+ * Returns:
+ *     ESP_OK on success.
+ *     ESP_ERR_INVALID_STATE if the driver was not initialized.
+ */
+esp_err_t app_rgb_led_set_white_balance(app_rgb_led_rgb_t white_balance);
+
+/**
+ * @brief Enables or disables temporal dithering.
+ *
+ * At low brightness a channel only has a few output levels, and slow fades
+ * step visibly between them. With dithering, each present() rounds a pixel
+ * up or down so the average over eight frames matches the exact scaled
+ * value. It only helps when frames are presented continuously, such as by
+ * the effect engine.
+ *
+ * Args:
+ *     enable: True to dither, false to round to the nearest level.
+ *
+ * Returns:
+ *     ESP_OK on success.
+ *     ESP_ERR_INVALID_STATE if the driver was not initialized.
+ */
+esp_err_t app_rgb_led_set_dithering(bool enable);
+
 /**
  * @brief Gets the current global brightness value.
  *
@@ -152,6 +209,8 @@ esp_err_t app_rgb_led_clear(void);
 /**
  * @brief Refreshes the physical LED strip using the current pixel buffer.
  *
+ * Same as app_rgb_led_present() followed by app_rgb_led_wait_done(-1).
+ *
  * Returns:
  *     ESP_OK on success.
  *     ESP_ERR_INVALID_STATE if the driver was not initialized.
@@ -159,6 +218,71 @@ esp_err_t app_rgb_led_clear(void);
  */
 esp_err_t app_rgb_led_refresh(void);
 
+/**
+ * @brief Gets the pixel frame that the next app_rgb_led_present() call sends.
+ *
+ * The frame holds led_count unscaled RGB pixels and keeps its contents
+ * between presents, so callers may update only what changed. Writing it
+ * never blocks and does not disturb a transmission in progress.
+ *
+ * Returns:
+ *     Pointer to the frame, or NULL if the driver was not initialized.
+ */
+app_rgb_led_rgb_t *app_rgb_led_get_frame(void);
+
+/**
+ * @brief Gets the number of LEDs in the frame.
+ *
+ * Returns:
+ *     LED count, or 0 if the driver was not initialized.
+ */
+uint32_t app_rgb_led_get_count(void);
+
+/**
+ * @brief Sends the current frame without waiting for the transmission.
+ *
+ * Brightness, gamma and white balance are applied in one table-lookup
+ * pass, with optional dithering, that writes the frame in GRB order into
+ * one of two transmit buffers. The RMT channels then send that buffer in
+ * the background, each strip its own segment. This call blocks only while
+ * both transmit buffers are still in flight.
+ *
+ * Returns:
+ *     ESP_OK on success.
+ *     ESP_ERR_INVALID_STATE if the driver was not initialized.
+ *     Another ESP-IDF error code if the transmission cannot be queued.
+ */
+esp_err_t app_rgb_led_present(void);
+
+/**
+ * @brief Waits until every presented frame has been sent.
+ *
+ * Args:
+ *     timeout_ms: Maximum wait in milliseconds for each strip, or -1 to wait forever.
+ *
+ * Returns:
+ *     ESP_OK on success.
+ *     ESP_ERR_INVALID_STATE if the driver was not initialized.
+ *     ESP_ERR_TIMEOUT if frames are still being sent after the timeout.
+ */
+esp_err_t app_rgb_led_wait_done(int timeout_ms);
+
+/**
+ * @brief Registers a callback for the end of each presented frame.
+ *
+ * The callback runs in interrupt context once the last strip has sent the
+ * frame, and must not block.
+ *
+ * Args:
+ *     callback: Function to call, or NULL to remove it.
+ *     user_ctx: Pointer passed to the callback.
+ *
+ * Returns:
+ *     ESP_OK on success.
+ *     ESP_ERR_INVALID_STATE if the driver was not initialized.
+ */
+esp_err_t app_rgb_led_register_frame_done_cb(app_rgb_led_frame_done_cb_t callback, void *user_ctx);
+
 /**
  * @brief Converts a predefined color into RGB values.
  *
@@ -1,3 +1,4 @@
+#include <inttypes.h>
 #include <stdint.h>
 
 #include "freertos/FreeRTOS.h"
@@ -7,12 +8,14 @@
 #include "esp_log.h"
 
 #include "app_rgb_led.h"
+#include "rgb_led_effects.h"
 
 #define RGB_LED_GPIO              48
 #define RGB_LED_COUNT             1
 #define RGB_LED_BRIGHTNESS        32
-#define RGB_LED_DEMO_DELAY_MS     700
 #define RGB_LED_STATUS_BLINK_MS   150
+#define RGB_LED_EFFECTS_FPS       60
+#define RGB_LED_EFFECT_SHOW_MS    8000
 
 static const char *TAG = "rgb_led_app";
 
@@ -93,43 +96,74 @@ static void show_system_status(system_status_t status)
 }
 
 /**
- * @brief Runs a simple color wheel demonstration on one addressable RGB LED.
+ * @brief Effect presets shown in turn by the effect engine.
  */
-static void run_color_cycle_demo(void)
-{
-    static const app_rgb_led_color_t colors[] = {
-        APP_RGB_LED_COLOR_RED,
-        APP_RGB_LED_COLOR_GREEN,
-        APP_RGB_LED_COLOR_BLUE,
-        APP_RGB_LED_COLOR_WHITE,
-        APP_RGB_LED_COLOR_YELLOW,
-        APP_RGB_LED_COLOR_CYAN,
-        APP_RGB_LED_COLOR_MAGENTA,
-        APP_RGB_LED_COLOR_ORANGE,
-        APP_RGB_LED_COLOR_PURPLE,
-        APP_RGB_LED_COLOR_OFF,
-    };
-
-    for (uint32_t i = 0; i < (sizeof(colors) / sizeof(colors[0])); i++) {
-        ESP_ERROR_CHECK(app_rgb_led_set_color(colors[i]));
-        delay_ms(RGB_LED_DEMO_DELAY_MS);
-    }
-}
+typedef struct {
+    const char *name;
+    rgb_led_effect_layer_t layers[RGB_LED_EFFECTS_MAX_LAYERS];
+} effect_preset_t;
+
+static const effect_preset_t s_effect_presets[] = {
+    {
+        .name = "rainbow",
+        .layers = {
+            { .type = RGB_LED_EFFECT_RAINBOW, .period_ms = 4000, .size = 0 },
+        },
+    },
+    {
+        .name = "chase over rainbow",
+        .layers = {
+            { .type = RGB_LED_EFFECT_RAINBOW, .period_ms = 8000, .size = 0 },
+            {
+                .type = RGB_LED_EFFECT_CHASE,
+                .blend = RGB_LED_BLEND_ALPHA,
+                .opacity = 192,
+                .color = { .red = 255, .green = 255, .blue = 255 },
+                .period_ms = 2000,
+                .size = 6,
+            },
+        },
+    },
+    {
+        .name = "breathing",
+        .layers = {
+            {
+                .type = RGB_LED_EFFECT_FADE,
+                .color = { .red = 0, .green = 255, .blue = 64 },
+                .period_ms = 3000,
+            },
+        },
+    },
+    {
+        .name = "fire",
+        .layers = {
+            { .type = RGB_LED_EFFECT_FIRE, .size = 55 },
+        },
+    },
+};
 
 /**
- * @brief Runs a brightness ramp demonstration using the green channel.
+ * @brief Shows each effect preset in turn and logs the frame-time statistics.
  */
-static void run_brightness_demo(void)
+static void run_effect_presets(void)
 {
-    for (uint16_t brightness = 8; brightness <= 64; brightness += 8) {
-        ESP_ERROR_CHECK(app_rgb_led_set_brightness((uint8_t)brightness));
-        ESP_ERROR_CHECK(app_rgb_led_set_color(APP_RGB_LED_COLOR_GREEN));
-        delay_ms(180);
+    for (uint32_t i = 0; i < (sizeof(s_effect_presets) / sizeof(s_effect_presets[0])); i++) {
+        const effect_preset_t *preset = &s_effect_presets[i];
+
+        rgb_led_effects_clear_layers();
+        for (uint32_t layer = 0; layer < RGB_LED_EFFECTS_MAX_LAYERS; layer++) {
+            ESP_ERROR_CHECK(rgb_led_effects_set_layer(layer, &preset->layers[layer]));
+        }
+        rgb_led_effects_get_stats(NULL);
+        delay_ms(RGB_LED_EFFECT_SHOW_MS);
+
+        rgb_led_effects_stats_t stats;
+        rgb_led_effects_get_stats(&stats);
+        ESP_LOGI(TAG, "Effect %s: %" PRIu32 " frames, avg %" PRIu32 " us, max %" PRIu32 " us of %" PRIu32
+                 " us budget, %" PRIu32 " over budget, %" PRIu32 " missed ticks",
+                 preset->name, stats.frames, stats.avg_frame_us, stats.max_frame_us, stats.budget_us,
+                 stats.over_budget, stats.missed_ticks);
     }
-
-    ESP_ERROR_CHECK(app_rgb_led_set_brightness(RGB_LED_BRIGHTNESS));
-    ESP_ERROR_CHECK(app_rgb_led_set_color(APP_RGB_LED_COLOR_OFF));
-    delay_ms(400);
 }
 
 /**
@@ -143,6 +177,7 @@ void app_main(void)
         .led_count = RGB_LED_COUNT,
         .brightness = RGB_LED_BRIGHTNESS,
         .enable_dma = false,
+        .enable_dithering = true,
     };
 
     // Initialize the RGB LED driver and run the demo sequence.
@@ -156,12 +191,9 @@ void app_main(void)
     show_system_status(SYSTEM_STATUS_OTA_UPDATE);
     show_system_status(SYSTEM_STATUS_ERROR);
 
-    // Run the color cycle and brightness demo in an infinite loop.
+    // Hand the LED over to the effect engine and cycle through the presets.
+    ESP_ERROR_CHECK(rgb_led_effects_start(RGB_LED_EFFECTS_FPS));
     while (1) {
-        // Run the color cycle and brightness demo in an infinite loop.
-        run_color_cycle_demo();
-        
-        // Run the brightness demo after the color cycle.
-        run_brightness_demo();
+        run_effect_presets();
     }
 }
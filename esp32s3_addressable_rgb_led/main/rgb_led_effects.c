@@ -0,0 +1,531 @@
+#include "rgb_led_effects.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_check.h"
+#include "esp_random.h"
+#include "esp_timer.h"
+
+#define RGB_LED_EFFECTS_MIN_FPS         1U
+#define RGB_LED_EFFECTS_MAX_FPS         200U
+#define RGB_LED_EFFECTS_TASK_STACK      3072
+#define RGB_LED_EFFECTS_TASK_PRIORITY   6
+#define RGB_LED_EFFECTS_SPARK_ZONE      7U
+
+static const char *TAG = "rgb_led_effects";
+
+typedef struct {
+    rgb_led_effect_layer_t config;
+    uint32_t phase;                 /* Position in the cycle, a full turn is 1 << 32 */
+    uint32_t step;                  /* Phase increment per frame */
+    uint8_t *heat;                  /* Fire heat per LED */
+} effect_layer_t;
+
+static effect_layer_t s_layers[RGB_LED_EFFECTS_MAX_LAYERS];
+static portMUX_TYPE s_layer_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static esp_timer_handle_t s_timer;
+static TaskHandle_t s_task;
+static volatile bool s_stop_requested;
+static app_rgb_led_rgb_t *s_scratch;
+static uint32_t s_led_count;
+static uint32_t s_fps;
+static uint32_t s_rng_state = 1;
+
+static rgb_led_effects_stats_t s_stats;
+static uint64_t s_frame_us_sum;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/* First quadrant of a sine wave in Q8, 65 points so the peak is exact. */
+static const uint8_t s_quarter_sine[65] = {
+      0,   6,  13,  19,  25,  31,  37,  44,  50,  56,  62,  68,  74,  80,  86,  92,
+     98, 103, 109, 115, 120, 126, 131, 136, 142, 147, 152, 157, 162, 167, 171, 176,
+    180, 185, 189, 193, 197, 201, 205, 208, 212, 215, 219, 222, 225, 228, 231, 233,
+    236, 238, 240, 242, 244, 246, 247, 249, 250, 251, 252, 253, 254, 254, 255, 255,
+    255,
+};
+
+/**
+ * @brief Computes an unsigned sine wave in fixed point.
+ *
+ * Args:
+ *     angle: Angle in 1/256 turns.
+ *
+ * Returns:
+ *     (1 - cos) / 2 scaled to 0..255, so angle 0 is dark and 128 is full.
+ */
+static uint8_t wave8(uint8_t angle)
+{
+    /* Shift by a quarter turn so the wave starts at its minimum. */
+    const uint8_t a = (uint8_t)(angle - 64U);
+    const uint8_t quadrant = a >> 6;
+    const uint8_t offset = a & 0x3FU;
+    const uint8_t s = (quadrant & 1U) ? s_quarter_sine[64U - offset] : s_quarter_sine[offset];
+
+    return (quadrant & 2U) ? (uint8_t)(127U - (s >> 1)) : (uint8_t)(128U + (s >> 1));
+}
+
+/**
+ * @brief Scales a channel by an 8-bit factor, with 255 leaving it unchanged.
+ */
+static inline uint8_t scale8(uint8_t value, uint8_t scale)
+{
+    return (uint8_t)(((uint16_t)value * (scale + 1U)) >> 8);
+}
+
+/**
+ * @brief Converts a hue on a 0..1535 wheel to a fully saturated RGB color.
+ *
+ * Args:
+ *     hue: Hue, six sectors of 256 steps.
+ *
+ * Returns:
+ *     RGB color at full value.
+ */
+static app_rgb_led_rgb_t hue_to_rgb(uint32_t hue)
+{
+    const uint8_t rise = (uint8_t)(hue & 0xFFU);
+    const uint8_t fall = (uint8_t)(255U - rise);
+
+    switch ((hue >> 8) % 6U) {
+    case 0:
+        return (app_rgb_led_rgb_t){ .red = 255, .green = rise, .blue = 0 };
+    case 1:
+        return (app_rgb_led_rgb_t){ .red = fall, .green = 255, .blue = 0 };
+    case 2:
+        return (app_rgb_led_rgb_t){ .red = 0, .green = 255, .blue = rise };
+    case 3:
+        return (app_rgb_led_rgb_t){ .red = 0, .green = fall, .blue = 255 };
+    case 4:
+        return (app_rgb_led_rgb_t){ .red = rise, .green = 0, .blue = 255 };
+    default:
+        return (app_rgb_led_rgb_t){ .red = 255, .green = 0, .blue = fall };
+    }
+}
+
+/**
+ * @brief Maps a fire heat value to black, red, yellow and white.
+ */
+static app_rgb_led_rgb_t heat_to_rgb(uint8_t heat)
+{
+    /* Scale 0..255 to 0..191, three bands of 64. */
+    const uint8_t t = (uint8_t)(((uint16_t)heat * 191U) >> 8);
+    const uint8_t ramp = (uint8_t)((t & 0x3FU) << 2);
+
+    if (t & 0x80U) {
+        return (app_rgb_led_rgb_t){ .red = 255, .green = 255, .blue = ramp };
+    }
+    if (t & 0x40U) {
+        return (app_rgb_led_rgb_t){ .red = 255, .green = ramp, .blue = 0 };
+    }
+    return (app_rgb_led_rgb_t){ .red = ramp, .green = 0, .blue = 0 };
+}
+
+/**
+ * @brief Returns a fast pseudo-random byte for the fire effect.
+ *
+ * A xorshift generator; esp_random() is only used to seed it.
+ */
+static uint8_t random8(void)
+{
+    s_rng_state ^= s_rng_state << 13;
+    s_rng_state ^= s_rng_state >> 17;
+    s_rng_state ^= s_rng_state << 5;
+    return (uint8_t)(s_rng_state >> 24);
+}
+
+/**
+ * @brief Renders a scrolling rainbow.
+ */
+static void render_rainbow(const effect_layer_t *layer, app_rgb_led_rgb_t *out)
+{
+    const uint32_t spread = (layer->config.size > 0U) ? layer->config.size : s_led_count;
+    const uint32_t base = ((layer->phase >> 16) * 1536U) >> 16;
+    const uint32_t hue_step_q8 = (1536U << 8) / spread;
+
+    for (uint32_t i = 0; i < s_led_count; i++) {
+        out[i] = hue_to_rgb(base + ((i * hue_step_q8) >> 8));
+    }
+}
+
+/**
+ * @brief Renders a moving dot with a fading tail.
+ */
+static void render_chase(const effect_layer_t *layer, app_rgb_led_rgb_t *out)
+{
+    const uint32_t tail = (layer->config.size > 0U) ? layer->config.size : 1U;
+    const uint32_t head = ((layer->phase >> 16) * s_led_count) >> 16;
+    const uint32_t fade_step = 256U / tail;
+    const app_rgb_led_rgb_t color = layer->config.color;
+
+    for (uint32_t i = 0; i < s_led_count; i++) {
+        const uint32_t distance = (head + s_led_count - i) % s_led_count;
+
+        if (distance >= tail) {
+            out[i] = (app_rgb_led_rgb_t){ 0 };
+            continue;
+        }
+        const uint8_t level = (uint8_t)(255U - distance * fade_step);
+        out[i] = (app_rgb_led_rgb_t){
+            .red = scale8(color.red, level),
+            .green = scale8(color.green, level),
+            .blue = scale8(color.blue, level),
+        };
+    }
+}
+
+/**
+ * @brief Renders the whole strip breathing in one color.
+ */
+static void render_fade(const effect_layer_t *layer, app_rgb_led_rgb_t *out)
+{
+    const uint8_t level = wave8((uint8_t)(layer->phase >> 24));
+    const app_rgb_led_rgb_t color = {
+        .red = scale8(layer->config.color.red, level),
+        .green = scale8(layer->config.color.green, level),
+        .blue = scale8(layer->config.color.blue, level),
+    };
+
+    for (uint32_t i = 0; i < s_led_count; i++) {
+        out[i] = color;
+    }
+}
+
+/**
+ * @brief Renders one step of a 1D fire simulation.
+ *
+ * Every cell cools by a random amount, heat drifts up the strip, and new
+ * sparks appear near index 0.
+ */
+static void render_fire(const effect_layer_t *layer, app_rgb_led_rgb_t *out)
+{
+    uint8_t *heat = layer->heat;
+    const uint32_t cooling = (layer->config.size > 0U) ? layer->config.size : 55U;
+    const uint32_t max_cool = ((cooling * 10U) / s_led_count) + 2U;
+
+    for (uint32_t i = 0; i < s_led_count; i++) {
+        const uint32_t cool = random8() % max_cool;
+        heat[i] = (heat[i] > cool) ? (uint8_t)(heat[i] - cool) : 0U;
+    }
+
+    for (uint32_t i = s_led_count - 1U; i >= 2U; i--) {
+        heat[i] = (uint8_t)(((uint32_t)heat[i - 1U] + heat[i - 2U] + heat[i - 2U]) / 3U);
+    }
+
+    if (random8() < 120U) {
+        const uint32_t zone = (s_led_count < RGB_LED_EFFECTS_SPARK_ZONE) ? s_led_count : RGB_LED_EFFECTS_SPARK_ZONE;
+        const uint32_t spark = random8() % zone;
+        const uint32_t boosted = heat[spark] + 160U + (random8() % 96U);
+        heat[spark] = (boosted > 255U) ? 255U : (uint8_t)boosted;
+    }
+
+    for (uint32_t i = 0; i < s_led_count; i++) {
+        out[i] = heat_to_rgb(heat[i]);
+    }
+}
+
+/**
+ * @brief Blends a rendered layer into the frame.
+ */
+static void blend_layer(app_rgb_led_rgb_t *dst, const app_rgb_led_rgb_t *src, rgb_led_blend_t blend, uint8_t opacity)
+{
+    switch (blend) {
+    case RGB_LED_BLEND_ADD:
+        for (uint32_t i = 0; i < s_led_count; i++) {
+            const uint32_t r = (uint32_t)dst[i].red + src[i].red;
+            const uint32_t g = (uint32_t)dst[i].green + src[i].green;
+            const uint32_t b = (uint32_t)dst[i].blue + src[i].blue;
+            dst[i] = (app_rgb_led_rgb_t){
+                .red = (r > 255U) ? 255U : (uint8_t)r,
+                .green = (g > 255U) ? 255U : (uint8_t)g,
+                .blue = (b > 255U) ? 255U : (uint8_t)b,
+            };
+        }
+        break;
+
+    case RGB_LED_BLEND_ALPHA: {
+        /* Q8 weights that sum to 256, so 255 opacity copies the source exactly. */
+        const uint32_t a = opacity + 1U;
+        const uint32_t na = 256U - a;
+        for (uint32_t i = 0; i < s_led_count; i++) {
+            dst[i] = (app_rgb_led_rgb_t){
+                .red = (uint8_t)((src[i].red * a + dst[i].red * na) >> 8),
+                .green = (uint8_t)((src[i].green * a + dst[i].green * na) >> 8),
+                .blue = (uint8_t)((src[i].blue * a + dst[i].blue * na) >> 8),
+            };
+        }
+        break;
+    }
+
+    case RGB_LED_BLEND_REPLACE:
+    default:
+        memcpy(dst, src, s_led_count * sizeof(app_rgb_led_rgb_t));
+        break;
+    }
+}
+
+/**
+ * @brief Renders and presents one frame.
+ */
+static void render_frame(void)
+{
+    app_rgb_led_rgb_t *frame = app_rgb_led_get_frame();
+    bool first = true;
+
+    memset(frame, 0, s_led_count * sizeof(app_rgb_led_rgb_t));
+
+    for (uint32_t index = 0; index < RGB_LED_EFFECTS_MAX_LAYERS; index++) {
+        /* Render from a snapshot so set_layer() never tears a frame. */
+        portENTER_CRITICAL(&s_layer_lock);
+        const effect_layer_t layer = s_layers[index];
+        s_layers[index].phase += s_layers[index].step;
+        portEXIT_CRITICAL(&s_layer_lock);
+
+        if (layer.config.type == RGB_LED_EFFECT_NONE) {
+            continue;
+        }
+
+        /* The bottom layer renders straight into the frame when it would only be copied. */
+        app_rgb_led_rgb_t *out = (first && layer.config.blend == RGB_LED_BLEND_REPLACE) ? frame : s_scratch;
+
+        switch (layer.config.type) {
+        case RGB_LED_EFFECT_RAINBOW:
+            render_rainbow(&layer, out);
+            break;
+        case RGB_LED_EFFECT_CHASE:
+            render_chase(&layer, out);
+            break;
+        case RGB_LED_EFFECT_FADE:
+            render_fade(&layer, out);
+            break;
+        case RGB_LED_EFFECT_FIRE:
+            render_fire(&layer, out);
+            break;
+        default:
+            break;
+        }
+
+        if (out != frame) {
+            blend_layer(frame, out, layer.config.blend, layer.config.opacity);
+        }
+        first = false;
+    }
+
+    app_rgb_led_present();
+}
+
+/**
+ * @brief Periodic timer callback; hands the frame to the render task.
+ */
+static void frame_timer_cb(void *arg)
+{
+    xTaskNotifyGive(s_task);
+}
+
+/**
+ * @brief Render task, one frame per timer tick.
+ *
+ * If rendering ever takes longer than a frame, the extra ticks collapse
+ * into one notification and are counted as missed, so the animation slows
+ * down instead of queueing up behind.
+ */
+static void render_task(void *arg)
+{
+    const uint32_t budget_us = 1000000U / s_fps;
+
+    while (!s_stop_requested) {
+        const uint32_t ticks = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(1000));
+        if (ticks == 0U || s_stop_requested) {
+            continue;
+        }
+
+        const int64_t start_us = esp_timer_get_time();
+        render_frame();
+        const uint32_t frame_us = (uint32_t)(esp_timer_get_time() - start_us);
+
+        portENTER_CRITICAL(&s_stats_lock);
+        s_stats.frames++;
+        s_stats.missed_ticks += ticks - 1U;
+        s_stats.budget_us = budget_us;
+        s_stats.last_frame_us = frame_us;
+        if (frame_us > s_stats.max_frame_us) {
+            s_stats.max_frame_us = frame_us;
+        }
+        if (frame_us > budget_us) {
+            s_stats.over_budget++;
+        }
+        s_frame_us_sum += frame_us;
+        portEXIT_CRITICAL(&s_stats_lock);
+    }
+
+    app_rgb_led_wait_done(-1);
+    s_task = NULL;
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Frees the scratch frame and the fire heat buffers.
+ */
+static void free_buffers(void)
+{
+    free(s_scratch);
+    s_scratch = NULL;
+    for (uint32_t i = 0; i < RGB_LED_EFFECTS_MAX_LAYERS; i++) {
+        free(s_layers[i].heat);
+        s_layers[i].heat = NULL;
+    }
+}
+
+/**
+ * @brief Computes the per-frame phase step of a layer.
+ */
+static uint32_t phase_step(uint32_t period_ms, uint32_t fps)
+{
+    if (period_ms == 0U || fps == 0U) {
+        return 0U;
+    }
+    /* A full turn is 1 << 32, spread over period_ms * fps / 1000 frames. */
+    return (uint32_t)((1000ULL << 32) / ((uint64_t)period_ms * fps));
+}
+
+/**
+ * @brief Starts the effect engine.
+ *
+ * Args:
+ *     fps: Frames per second.
+ *
+ * Returns:
+ *     ESP_OK if successful, otherwise an error code.
+ */
+esp_err_t rgb_led_effects_start(uint32_t fps)
+{
+    esp_err_t ret = ESP_OK;
+
+    ESP_RETURN_ON_FALSE(fps >= RGB_LED_EFFECTS_MIN_FPS && fps <= RGB_LED_EFFECTS_MAX_FPS, ESP_ERR_INVALID_ARG, TAG,
+                        "Frame rate is out of range");
+    ESP_RETURN_ON_FALSE(s_task == NULL, ESP_ERR_INVALID_STATE, TAG, "Engine already running");
+    ESP_RETURN_ON_FALSE(app_rgb_led_get_frame() != NULL, ESP_ERR_INVALID_STATE, TAG, "LED driver is not initialized");
+
+    s_led_count = app_rgb_led_get_count();
+    s_fps = fps;
+    s_rng_state = esp_random() | 1U;
+
+    s_scratch = calloc(s_led_count, sizeof(app_rgb_led_rgb_t));
+    ESP_GOTO_ON_FALSE(s_scratch != NULL, ESP_ERR_NO_MEM, err, TAG, "No memory for scratch frame");
+    for (uint32_t i = 0; i < RGB_LED_EFFECTS_MAX_LAYERS; i++) {
+        s_layers[i].heat = calloc(s_led_count, sizeof(uint8_t));
+        ESP_GOTO_ON_FALSE(s_layers[i].heat != NULL, ESP_ERR_NO_MEM, err, TAG, "No memory for fire buffer");
+        s_layers[i].step = phase_step(s_layers[i].config.period_ms, fps);
+    }
+
+    rgb_led_effects_get_stats(NULL);
+    s_stop_requested = false;
+    ESP_GOTO_ON_FALSE(xTaskCreate(render_task, "rgb_effects", RGB_LED_EFFECTS_TASK_STACK, NULL,
+                                  RGB_LED_EFFECTS_TASK_PRIORITY, &s_task) == pdPASS,
+                      ESP_ERR_NO_MEM, err, TAG, "Failed to create render task");
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = frame_timer_cb,
+        .name = "rgb_effects",
+    };
+    ESP_GOTO_ON_ERROR(esp_timer_create(&timer_args, &s_timer), err_task, TAG, "Failed to create frame timer");
+    ESP_GOTO_ON_ERROR(esp_timer_start_periodic(s_timer, 1000000ULL / fps), err_timer, TAG, "Failed to start frame timer");
+
+    ESP_LOGI(TAG, "Effect engine started: %u LEDs at %u FPS", (unsigned)s_led_count, (unsigned)fps);
+    return ESP_OK;
+
+err_timer:
+    esp_timer_delete(s_timer);
+    s_timer = NULL;
+err_task:
+    s_stop_requested = true;
+    while (s_task != NULL) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+err:
+    free_buffers();
+    return ret;
+}
+
+/**
+ * @brief Stops the effect engine.
+ *
+ * Returns:
+ *     ESP_OK if successful, otherwise an error code.
+ */
+esp_err_t rgb_led_effects_stop(void)
+{
+    ESP_RETURN_ON_FALSE(s_task != NULL, ESP_ERR_INVALID_STATE, TAG, "Engine is not running");
+
+    esp_timer_stop(s_timer);
+    esp_timer_delete(s_timer);
+    s_timer = NULL;
+
+    s_stop_requested = true;
+    xTaskNotifyGive(s_task);
+    while (s_task != NULL) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+
+    free_buffers();
+    return ESP_OK;
+}
+
+/**
+ * @brief Sets one effect layer.
+ *
+ * Args:
+ *     index: Layer index.
+ *     layer: Layer settings.
+ *
+ * Returns:
+ *     ESP_OK if successful, otherwise an error code.
+ */
+esp_err_t rgb_led_effects_set_layer(uint32_t index, const rgb_led_effect_layer_t *layer)
+{
+    ESP_RETURN_ON_FALSE(index < RGB_LED_EFFECTS_MAX_LAYERS && layer != NULL, ESP_ERR_INVALID_ARG, TAG,
+                        "Invalid layer");
+
+    portENTER_CRITICAL(&s_layer_lock);
+    s_layers[index].config = *layer;
+    s_layers[index].phase = 0;
+    s_layers[index].step = phase_step(layer->period_ms, s_fps);
+    portEXIT_CRITICAL(&s_layer_lock);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Disables every layer.
+ */
+void rgb_led_effects_clear_layers(void)
+{
+    portENTER_CRITICAL(&s_layer_lock);
+    for (uint32_t i = 0; i < RGB_LED_EFFECTS_MAX_LAYERS; i++) {
+        s_layers[i].config.type = RGB_LED_EFFECT_NONE;
+    }
+    portEXIT_CRITICAL(&s_layer_lock);
+}
+
+/**
+ * @brief Copies and resets the frame-time statistics.
+ *
+ * Args:
+ *     stats: Receives the statistics, or NULL to only reset them.
+ */
+void rgb_led_effects_get_stats(rgb_led_effects_stats_t *stats)
+{
+    portENTER_CRITICAL(&s_stats_lock);
+    if (stats != NULL) {
+        *stats = s_stats;
+        stats->avg_frame_us = (s_stats.frames > 0U) ? (uint32_t)(s_frame_us_sum / s_stats.frames) : 0U;
+    }
+    s_stats = (rgb_led_effects_stats_t){ .budget_us = s_stats.budget_us };
+    s_frame_us_sum = 0;
+    portEXIT_CRITICAL(&s_stats_lock);
+}
@@ -0,0 +1,113 @@
+#ifndef RGB_LED_EFFECTS_H
+#define RGB_LED_EFFECTS_H
+
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#include "app_rgb_led.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RGB_LED_EFFECTS_MAX_LAYERS 4
+
+typedef enum {
+    RGB_LED_EFFECT_NONE = 0,
+    RGB_LED_EFFECT_RAINBOW,
+    RGB_LED_EFFECT_CHASE,
+    RGB_LED_EFFECT_FADE,
+    RGB_LED_EFFECT_FIRE,
+} rgb_led_effect_type_t;
+
+typedef enum {
+    RGB_LED_BLEND_REPLACE = 0,
+    RGB_LED_BLEND_ADD,
+    RGB_LED_BLEND_ALPHA,
+} rgb_led_blend_t;
+
+typedef struct {
+    rgb_led_effect_type_t type;
+    rgb_led_blend_t blend;
+    uint8_t opacity;            /* Used by RGB_LED_BLEND_ALPHA, 255 is opaque. */
+    app_rgb_led_rgb_t color;    /* Chase and fade color. */
+    uint32_t period_ms;         /* One animation cycle; 0 freezes the layer. */
+    uint16_t size;              /* LEDs per hue wheel (rainbow), tail length (chase) or cooling (fire). */
+} rgb_led_effect_layer_t;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t missed_ticks;
+    uint32_t over_budget;
+    uint32_t budget_us;
+    uint32_t last_frame_us;
+    uint32_t avg_frame_us;
+    uint32_t max_frame_us;
+} rgb_led_effects_stats_t;
+
+/**
+ * @brief Starts the effect engine at a fixed frame rate.
+ *
+ * A periodic esp_timer wakes a render task once per frame. The task renders
+ * every active layer in fixed point, blends them into the app_rgb_led frame
+ * and presents it. The driver must already be initialized and should not be
+ * written through its per-pixel calls while the engine runs.
+ *
+ * Args:
+ *     fps: Frames per second, from 1 to 200.
+ *
+ * Returns:
+ *     ESP_OK on success.
+ *     ESP_ERR_INVALID_ARG if the frame rate is out of range.
+ *     ESP_ERR_INVALID_STATE if the engine is running or the driver was not initialized.
+ *     ESP_ERR_NO_MEM if the render buffers or task cannot be allocated.
+ */
+esp_err_t rgb_led_effects_start(uint32_t fps);
+
+/**
+ * @brief Stops the effect engine and waits for the last frame to be sent.
+ *
+ * Layers are kept, so a later start resumes the same effects.
+ *
+ * Returns:
+ *     ESP_OK on success.
+ *     ESP_ERR_INVALID_STATE if the engine is not running.
+ */
+esp_err_t rgb_led_effects_stop(void);
+
+/**
+ * @brief Sets or replaces one effect layer.
+ *
+ * Layers are composed from index 0 upwards, each blended over the result of
+ * the ones below. The change takes effect from the next frame and restarts
+ * the layer's animation.
+ *
+ * Args:
+ *     index: Layer index, below RGB_LED_EFFECTS_MAX_LAYERS.
+ *     layer: Layer settings; type RGB_LED_EFFECT_NONE disables the layer.
+ *
+ * Returns:
+ *     ESP_OK on success.
+ *     ESP_ERR_INVALID_ARG if an argument is invalid.
+ */
+esp_err_t rgb_led_effects_set_layer(uint32_t index, const rgb_led_effect_layer_t *layer);
+
+/**
+ * @brief Disables every layer.
+ */
+void rgb_led_effects_clear_layers(void);
+
+/**
+ * @brief Copies the frame-time statistics and starts a new window.
+ *
+ * Args:
+ *     stats: Receives the statistics since the previous call.
+ */
+void rgb_led_effects_get_stats(rgb_led_effects_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
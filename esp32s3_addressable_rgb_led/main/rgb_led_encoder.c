@@ -0,0 +1,173 @@
+#include "rgb_led_encoder.h"
+
+#include <stdlib.h>
+
+#include "esp_check.h"
+
+static const char *TAG = "rgb_led_encoder";
+
+/* WS2812 bit timing in nanoseconds. */
+#define WS2812_T0H_NS 300U
+#define WS2812_T0L_NS 900U
+#define WS2812_T1H_NS 900U
+#define WS2812_T1L_NS 300U
+
+typedef struct {
+    rmt_encoder_t base;
+    rmt_encoder_t *bytes_encoder;
+    rmt_encoder_t *copy_encoder;
+    int state;
+    rmt_symbol_word_t reset_code;
+} rgb_led_encoder_t;
+
+/**
+ * @brief Converts a duration in nanoseconds to RMT ticks.
+ *
+ * Args:
+ *     resolution_hz: RMT channel resolution in hertz.
+ *     ns: Duration in nanoseconds.
+ *
+ * Returns:
+ *     Duration in RMT ticks, rounded to the nearest tick.
+ */
+static uint32_t ns_to_ticks(uint32_t resolution_hz, uint32_t ns)
+{
+    return (uint32_t)(((uint64_t)resolution_hz * ns + 500000000ULL) / 1000000000ULL);
+}
+
+/**
+ * @brief Encodes the color bytes, then the reset code.
+ *
+ * The RMT driver calls this repeatedly as channel memory frees up. The state
+ * records which part was interrupted when the memory filled.
+ */
+static size_t rgb_led_encode(rmt_encoder_t *encoder, rmt_channel_handle_t channel,
+                             const void *primary_data, size_t data_size, rmt_encode_state_t *ret_state)
+{
+    rgb_led_encoder_t *led_encoder = __containerof(encoder, rgb_led_encoder_t, base);
+    rmt_encode_state_t session_state = RMT_ENCODING_RESET;
+    rmt_encode_state_t state = RMT_ENCODING_RESET;
+    size_t encoded_symbols = 0;
+
+    switch (led_encoder->state) {
+    case 0:
+        encoded_symbols += led_encoder->bytes_encoder->encode(led_encoder->bytes_encoder, channel,
+                                                              primary_data, data_size, &session_state);
+        if (session_state & RMT_ENCODING_COMPLETE) {
+            led_encoder->state = 1;
+        }
+        if (session_state & RMT_ENCODING_MEM_FULL) {
+            state |= RMT_ENCODING_MEM_FULL;
+            break;
+        }
+        /* fall-through */
+    case 1:
+        encoded_symbols += led_encoder->copy_encoder->encode(led_encoder->copy_encoder, channel,
+                                                             &led_encoder->reset_code,
+                                                             sizeof(led_encoder->reset_code), &session_state);
+        if (session_state & RMT_ENCODING_COMPLETE) {
+            led_encoder->state = RMT_ENCODING_RESET;
+            state |= RMT_ENCODING_COMPLETE;
+        }
+        if (session_state & RMT_ENCODING_MEM_FULL) {
+            state |= RMT_ENCODING_MEM_FULL;
+        }
+        break;
+    default:
+        break;
+    }
+
+    *ret_state = state;
+    return encoded_symbols;
+}
+
+static esp_err_t rgb_led_encoder_del(rmt_encoder_t *encoder)
+{
+    rgb_led_encoder_t *led_encoder = __containerof(encoder, rgb_led_encoder_t, base);
+
+    rmt_del_encoder(led_encoder->bytes_encoder);
+    rmt_del_encoder(led_encoder->copy_encoder);
+    free(led_encoder);
+    return ESP_OK;
+}
+
+static esp_err_t rgb_led_encoder_reset(rmt_encoder_t *encoder)
+{
+    rgb_led_encoder_t *led_encoder = __containerof(encoder, rgb_led_encoder_t, base);
+
+    rmt_encoder_reset(led_encoder->bytes_encoder);
+    rmt_encoder_reset(led_encoder->copy_encoder);
+    led_encoder->state = RMT_ENCODING_RESET;
+    return ESP_OK;
+}
+
+/**
+ * @brief Creates the WS2812 RMT encoder.
+ *
+ * Args:
+ *     config: Pointer to the encoder configuration.
+ *     ret_encoder: Receives the new encoder handle.
+ *
+ * Returns:
+ *     ESP_OK if successful, otherwise an error code.
+ */
+esp_err_t rgb_led_encoder_new(const rgb_led_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder)
+{
+    esp_err_t ret = ESP_OK;
+    rgb_led_encoder_t *led_encoder = NULL;
+
+    ESP_RETURN_ON_FALSE(config != NULL && ret_encoder != NULL, ESP_ERR_INVALID_ARG, TAG, "Invalid argument");
+    ESP_RETURN_ON_FALSE(config->resolution_hz > 0, ESP_ERR_INVALID_ARG, TAG, "Resolution must be greater than zero");
+
+    led_encoder = calloc(1, sizeof(rgb_led_encoder_t));
+    ESP_RETURN_ON_FALSE(led_encoder != NULL, ESP_ERR_NO_MEM, TAG, "No memory for LED encoder");
+
+    led_encoder->base.encode = rgb_led_encode;
+    led_encoder->base.del = rgb_led_encoder_del;
+    led_encoder->base.reset = rgb_led_encoder_reset;
+
+    const uint32_t res = config->resolution_hz;
+    const rmt_bytes_encoder_config_t bytes_config = {
+        .bit0 = {
+            .level0 = 1,
+            .duration0 = ns_to_ticks(res, WS2812_T0H_NS),
+            .level1 = 0,
+            .duration1 = ns_to_ticks(res, WS2812_T0L_NS),
+        },
+        .bit1 = {
+            .level0 = 1,
+            .duration0 = ns_to_ticks(res, WS2812_T1H_NS),
+            .level1 = 0,
+            .duration1 = ns_to_ticks(res, WS2812_T1L_NS),
+        },
+        .flags.msb_first = 1,
+    };
+    ESP_GOTO_ON_ERROR(rmt_new_bytes_encoder(&bytes_config, &led_encoder->bytes_encoder), err, TAG,
+                      "Failed to create bytes encoder");
+
+    const rmt_copy_encoder_config_t copy_config = {};
+    ESP_GOTO_ON_ERROR(rmt_new_copy_encoder(&copy_config, &led_encoder->copy_encoder), err, TAG,
+                      "Failed to create copy encoder");
+
+    /* The latch period is split over both halves of one symbol. */
+    const uint32_t reset_ticks = ns_to_ticks(res, config->reset_us * 1000U) / 2U;
+    led_encoder->reset_code = (rmt_symbol_word_t){
+        .level0 = 0,
+        .duration0 = reset_ticks,
+        .level1 = 0,
+        .duration1 = reset_ticks,
+    };
+
+    *ret_encoder = &led_encoder->base;
+    return ESP_OK;
+
+err:
+    if (led_encoder->bytes_encoder != NULL) {
+        rmt_del_encoder(led_encoder->bytes_encoder);
+    }
+    if (led_encoder->copy_encoder != NULL) {
+        rmt_del_encoder(led_encoder->copy_encoder);
+    }
+    free(led_encoder);
+    return ret;
+}
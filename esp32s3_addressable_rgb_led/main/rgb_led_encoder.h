@@ -0,0 +1,41 @@
+#ifndef RGB_LED_ENCODER_H
+#define RGB_LED_ENCODER_H
+
+#include <stdint.h>
+
+#include "driver/rmt_encoder.h"
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint32_t resolution_hz;
+    uint32_t reset_us;
+} rgb_led_encoder_config_t;
+
+/**
+ * @brief Creates an RMT encoder for WS2812-compatible LED data.
+ *
+ * The encoder turns a buffer of already ordered and scaled color bytes into
+ * WS2812 bit symbols, followed by one reset (latch) low period. Bytes are
+ * encoded on the fly as the RMT memory or DMA buffer drains, so the payload
+ * must stay valid until the transmission completes.
+ *
+ * Args:
+ *     config: Pointer to the encoder configuration.
+ *     ret_encoder: Receives the new encoder handle.
+ *
+ * Returns:
+ *     ESP_OK on success.
+ *     ESP_ERR_INVALID_ARG if an argument is invalid.
+ *     ESP_ERR_NO_MEM if the encoder cannot be allocated.
+ */
+esp_err_t rgb_led_encoder_new(const rgb_led_encoder_config_t *config, rmt_encoder_handle_t *ret_encoder);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
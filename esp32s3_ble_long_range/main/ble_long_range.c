@@ -1,10 +1,12 @@
 #include "ble_long_range.h"
 
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
+#include "conn_profile.h"
 #include "esp_bt.h"
 #include "esp_bt_main.h"
 #include "esp_check.h"
@@ -12,22 +14,48 @@
 #include "esp_gatt_common_api.h"
 #include "esp_gatts_api.h"
 #include "esp_log.h"
+#include "esp_pm.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/stream_buffer.h"
 #include "freertos/task.h"
+#include "link_controller.h"
 #include "nvs_flash.h"
 
 #define DEVICE_NAME                 "ESP32S3-LR-BLE"
 #define PROFILE_APP_ID              0
 #define SERVICE_INSTANCE_ID         0
 #define EXT_ADV_INSTANCE            0
-#define TELEMETRY_MAX_LENGTH        64
+#define TELEMETRY_MAX_LENGTH        128
 #define CONTROL_MAX_LENGTH          20
+#define STREAM_MAX_LENGTH           512     /* Largest attribute value; MTU 517 minus 3. */
+#define STREAM_BUFFER_SIZE          16384
+#define STREAM_BURST_BYTES          8192
+#define STREAM_MAX_IN_FLIGHT        6
+#define STREAM_IDLE_POLL_MS         20
+#define STREAM_REPORT_MS            2000
+#define STREAM_RECORD_SIZE          8
+#define ATT_DEFAULT_MTU             23
+#define ATT_LOCAL_MTU               517
 #define RSSI_FILTER_ALPHA_NUM       1
 #define RSSI_FILTER_ALPHA_DEN       8
-#define RSSI_STRONG_DBM             (-67)
-#define RSSI_MODERATE_DBM           (-82)
-#define RSSI_WEAK_DBM               (-92)
+#define PER_FILTER_ALPHA_NUM        1
+#define PER_FILTER_ALPHA_DEN        4
 #define BLE_GAP_USE_EXPLICIT_PHY_MASKS 0
+#define PM_MIN_CPU_FREQ_MHZ         40      /* XTAL frequency; lowest DFS step. */
+#define ADV_TX_POWER_DBM            20      /* Matches ESP_PWR_LVL_P20. */
+#define BROADCAST_COMPANY_ID        0x02E5  /* Espressif Systems. */
+#define BROADCAST_FRAME_TELEMETRY   0x01
+#define BROADCAST_HEADER_SIZE       12
+#define BROADCAST_REFRESH_MS        5000
+
+#ifdef CONFIG_BLE_LR_BROADCAST_MODE
+#define BROADCAST_MODE              1
+#define BROADCAST_INTERVAL          (CONFIG_BLE_LR_BROADCAST_INTERVAL_MS * 8 / 5)
+#else
+#define BROADCAST_MODE              0
+#define BROADCAST_INTERVAL          0x0640  /* Unused; 1 s in 0.625 ms units. */
+#endif
 
 /* Custom 128-bit UUID base: 7a2eXXXX-5d9b-4d6f-a621-bd2c5b7a9011. */
 static const uint8_t SERVICE_UUID[16] = {
@@ -42,6 +70,10 @@ static const uint8_t CONTROL_UUID[16] = {
     0x11, 0x90, 0x7a, 0x5b, 0x2c, 0xbd, 0x21, 0xa6,
     0x6f, 0x4d, 0x9b, 0x5d, 0x02, 0x10, 0x2e, 0x7a
 };
+static const uint8_t STREAM_UUID[16] = {
+    0x11, 0x90, 0x7a, 0x5b, 0x2c, 0xbd, 0x21, 0xa6,
+    0x6f, 0x4d, 0x9b, 0x5d, 0x03, 0x10, 0x2e, 0x7a
+};
 
 static const char *TAG = "ble_long_range";
 static esp_gatt_if_t s_gatts_if = ESP_GATT_IF_NONE;
@@ -50,12 +82,40 @@ static uint16_t s_connection_handle;
 static esp_bd_addr_t s_peer_address;
 static bool s_connected;
 static bool s_notifications_enabled;
+static bool s_stream_notifications_enabled;
+static volatile bool s_congested;
+static volatile bool s_stream_generator;
+static atomic_uint s_stream_in_flight;
+static atomic_uint s_stream_confirmed_bytes;
+static atomic_uint s_stream_congestion_events;
+static uint32_t s_stream_kbps;
+static uint32_t s_test_record_seq;
+static TaskHandle_t s_stream_task;
+static uint16_t s_mtu = ATT_DEFAULT_MTU;
 static int16_t s_filtered_rssi = -127;
 static uint32_t s_rssi_samples;
+static uint16_t s_filtered_per;
+static atomic_uint s_tx_attempts;
+static atomic_uint s_tx_failures;
 static uint8_t s_current_phy = ESP_BLE_GAP_PHY_1M;
 static esp_power_level_t s_current_power = ESP_PWR_LVL_P9;
+static bool s_auto_link = true;
+static link_controller_t s_link_controller;
+static conn_profile_manager_t s_conn_profile;
+#if CONFIG_BT_CTRL_MODEM_SLEEP
+static bool s_modem_sleep_enabled = true;   /* The controller starts with sleep enabled. */
+#endif
+static StreamBufferHandle_t s_stream_buffer;
+static SemaphoreHandle_t s_stream_write_lock;
 static uint8_t s_telemetry_value[TELEMETRY_MAX_LENGTH] = "waiting-for-connection";
 static uint8_t s_control_value[CONTROL_MAX_LENGTH] = "AUTO";
+static uint8_t s_stream_value[STREAM_MAX_LENGTH];
+static volatile bool s_advertising_started;
+static SemaphoreHandle_t s_broadcast_lock;
+static TaskHandle_t s_broadcast_task;
+static uint8_t s_broadcast_payload[BLE_LONG_RANGE_BROADCAST_MAX_PAYLOAD];
+static size_t s_broadcast_payload_length;
+static uint16_t s_broadcast_seq;
 
 static const uint16_t PRIMARY_SERVICE_UUID = ESP_GATT_UUID_PRI_SERVICE;
 static const uint16_t CHARACTER_DECLARATION_UUID = ESP_GATT_UUID_CHAR_DECLARE;
@@ -65,6 +125,7 @@ static const uint8_t CHAR_PROP_READ_NOTIFY = ESP_GATT_CHAR_PROP_BIT_READ |
 static const uint8_t CHAR_PROP_READ_WRITE = ESP_GATT_CHAR_PROP_BIT_READ |
                                              ESP_GATT_CHAR_PROP_BIT_WRITE;
 static uint8_t CCCD_DEFAULT[2] = {0x00, 0x00};
+static uint8_t STREAM_CCCD_DEFAULT[2] = {0x00, 0x00};
 
 /* Attribute table indexes. */
 enum {
@@ -74,6 +135,9 @@ enum {
     IDX_TELEMETRY_CCCD,
     IDX_CONTROL_DECL,
     IDX_CONTROL_VALUE,
+    IDX_STREAM_DECL,
+    IDX_STREAM_VALUE,
+    IDX_STREAM_CCCD,
     IDX_COUNT
 };
 
@@ -119,6 +183,23 @@ static const esp_gatts_attr_db_t GATT_DATABASE[IDX_COUNT] = {
          {ESP_UUID_LEN_128, (uint8_t *)CONTROL_UUID,
           ESP_GATT_PERM_READ | ESP_GATT_PERM_WRITE,
           CONTROL_MAX_LENGTH, sizeof("AUTO") - 1, s_control_value}},
+
+    [IDX_STREAM_DECL] =
+        {{ESP_GATT_AUTO_RSP},
+         {ESP_UUID_LEN_16, (uint8_t *)&CHARACTER_DECLARATION_UUID,
+          ESP_GATT_PERM_READ, sizeof(uint8_t), sizeof(uint8_t),
+          (uint8_t *)&CHAR_PROP_READ_NOTIFY}},
+
+    [IDX_STREAM_VALUE] =
+        {{ESP_GATT_AUTO_RSP},
+         {ESP_UUID_LEN_128, (uint8_t *)STREAM_UUID,
+          ESP_GATT_PERM_READ, STREAM_MAX_LENGTH, 0, s_stream_value}},
+
+    [IDX_STREAM_CCCD] =
+        {{ESP_GATT_AUTO_RSP},
+         {ESP_UUID_LEN_16, (uint8_t *)&CLIENT_CONFIG_UUID,
+          ESP_GATT_PERM_READ | ESP_GATT_PERM_WRITE,
+          sizeof(STREAM_CCCD_DEFAULT), sizeof(STREAM_CCCD_DEFAULT), STREAM_CCCD_DEFAULT}},
 };
 
 /* Connectable extended advertising on LE Coded PHY. */
@@ -137,6 +218,26 @@ static const esp_ble_gap_ext_adv_params_t EXT_ADV_PARAMS = {
     .scan_req_notif = false,
 };
 
+/*
+ * Non-connectable, non-scannable extended advertising on LE Coded PHY. The
+ * telemetry travels in the AUX_ADV_IND on the secondary channel, so it may
+ * be much longer than a legacy 31-byte advertisement.
+ */
+static const esp_ble_gap_ext_adv_params_t BROADCAST_ADV_PARAMS = {
+    .type = ESP_BLE_GAP_SET_EXT_ADV_PROP_NONCONN_NONSCANNABLE_UNDIRECTED,
+    .interval_min = BROADCAST_INTERVAL,
+    .interval_max = BROADCAST_INTERVAL,
+    .channel_map = ADV_CHNL_ALL,
+    .own_addr_type = BLE_ADDR_TYPE_PUBLIC,
+    .filter_policy = ADV_FILTER_ALLOW_SCAN_ANY_CON_ANY,
+    .tx_power = EXT_ADV_TX_PWR_NO_PREFERENCE,
+    .primary_phy = ESP_BLE_GAP_PHY_CODED,
+    .max_skip = 0,
+    .secondary_phy = ESP_BLE_GAP_PHY_CODED,
+    .sid = 1,
+    .scan_req_notif = false,
+};
+
 /* AD structure: flags, complete name, and complete 128-bit service UUID. */
 static const uint8_t EXT_ADV_DATA[] = {
     0x02, ESP_BLE_AD_TYPE_FLAG, ESP_BLE_ADV_FLAG_GEN_DISC | ESP_BLE_ADV_FLAG_BREDR_NOT_SPT,
@@ -170,6 +271,14 @@ static const char *phy_to_string(uint8_t phy)
     }
 }
 
+/**
+ * Returns the FreeRTOS tick count in milliseconds.
+ */
+static uint32_t now_ms(void)
+{
+    return (uint32_t)pdTICKS_TO_MS(xTaskGetTickCount());
+}
+
 /**
  * Updates the telemetry characteristic and optionally notifies the peer.
  *
@@ -180,12 +289,19 @@ static void publish_telemetry(int8_t rssi)
 {
     int length = snprintf((char *)s_telemetry_value,
                           sizeof(s_telemetry_value),
-                          "rssi=%d,filtered=%d,phy=%s,pwr=%d,samples=%lu",
+                          "rssi=%d,filtered=%d,phy=%s,pwr=%d,samples=%lu,"
+                          "per=%u,backlog=%lu,kbps=%lu,level=%s",
                           rssi,
                           s_filtered_rssi,
                           phy_to_string(s_current_phy),
                           (int)s_current_power,
-                          (unsigned long)s_rssi_samples);
+                          (unsigned long)s_rssi_samples,
+                          s_filtered_per,
+                          (unsigned long)xStreamBufferBytesAvailable(s_stream_buffer),
+                          (unsigned long)s_stream_kbps,
+                          s_auto_link
+                              ? link_controller_level_info(s_link_controller.level)->name
+                              : "MANUAL");
 
     if (length < 0) {
         ESP_LOGE(TAG, "Failed to format telemetry");
@@ -204,6 +320,7 @@ static void publish_telemetry(int8_t rssi)
     }
 
     if (s_connected && s_notifications_enabled) {
+        atomic_fetch_add(&s_tx_attempts, 1);
         err = esp_ble_gatts_send_indicate(s_gatts_if,
                                           s_connection_id,
                                           s_handles[IDX_TELEMETRY_VALUE],
@@ -211,6 +328,7 @@ static void publish_telemetry(int8_t rssi)
                                           s_telemetry_value,
                                           false);
         if (err != ESP_OK) {
+            atomic_fetch_add(&s_tx_failures, 1);
             ESP_LOGW(TAG, "Telemetry notification failed: %s", esp_err_to_name(err));
         }
     }
@@ -263,36 +381,211 @@ static void request_connection_phy(esp_ble_gap_phy_mask_t phy_mask,
 }
 
 /**
- * Applies an adaptive PHY and transmit-power policy from filtered RSSI.
+ * Requests the LL data length for the connection.
+ *
+ * Args:
+ *     tx_octets: Requested LL payload size, 27 to 251 octets.
+ */
+static void request_data_length(uint16_t tx_octets)
+{
+    if (!s_connected) {
+        return;
+    }
+
+    esp_err_t err = esp_ble_gap_set_pkt_data_len(s_peer_address, tx_octets);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Data length request failed: %s", esp_err_to_name(err));
+    }
+}
+
+/**
+ * Applies the PHY, transmit power, and data length of a link level.
  *
- * The policy uses hysteresis implicitly through the low-pass RSSI filter and
- * only changes radio settings when the desired operating region changes.
+ * Args:
+ *     level: Link level chosen by the link controller.
+ */
+static void apply_link_level(link_level_t level)
+{
+    const link_level_info_t *info = link_controller_level_info(level);
+
+    set_connection_power((esp_power_level_t)info->power);
+    request_connection_phy(info->phy_mask, info->phy_options);
+    request_data_length(info->tx_data_length);
+}
+
+/**
+ * Folds the notifications sent since the last RSSI sample into the PER.
+ *
+ * Bluedroid does not report link-layer CRC errors, so the packet error rate
+ * is estimated from notifications the stack rejected or confirmed with an
+ * error. Windows without traffic decay the estimate toward zero.
+ */
+static void update_packet_error_rate(void)
+{
+    uint32_t attempts = atomic_exchange(&s_tx_attempts, 0);
+    uint32_t failures = atomic_exchange(&s_tx_failures, 0);
+    uint32_t sample = 0;
+
+    if (attempts > 0) {
+        sample = (failures >= attempts) ? 1000 : (failures * 1000U) / attempts;
+    }
+
+    s_filtered_per = (uint16_t)(
+        (PER_FILTER_ALPHA_NUM * sample +
+         (PER_FILTER_ALPHA_DEN - PER_FILTER_ALPHA_NUM) * (uint32_t)s_filtered_per) /
+        PER_FILTER_ALPHA_DEN);
+}
+
+/**
+ * Runs the adaptive link controller on the latest link measurements.
+ *
+ * The controller combines filtered RSSI, packet error rate, and the stream
+ * send backlog, and applies hysteresis and dwell times before changing PHY,
+ * transmit power, or data length. Manual control commands suspend it until
+ * AUTO is written.
  */
 static void apply_link_policy(void)
 {
-    if (s_filtered_rssi >= RSSI_STRONG_DBM) {
-        set_connection_power(ESP_PWR_LVL_P3);
-        request_connection_phy(ESP_BLE_GAP_PHY_1M_PREF_MASK,
-                               ESP_BLE_GAP_PHY_OPTIONS_PREF_S2_CODING);
-    } else if (s_filtered_rssi >= RSSI_MODERATE_DBM) {
-        set_connection_power(ESP_PWR_LVL_P9);
-        request_connection_phy(ESP_BLE_GAP_PHY_1M_PREF_MASK,
-                               ESP_BLE_GAP_PHY_OPTIONS_PREF_S2_CODING);
-    } else if (s_filtered_rssi >= RSSI_WEAK_DBM) {
-        set_connection_power(ESP_PWR_LVL_P15);
-        request_connection_phy(ESP_BLE_GAP_PHY_CODED_PREF_MASK,
-                               ESP_BLE_GAP_PHY_OPTIONS_PREF_S2_CODING);
+    if (!s_auto_link) {
+        return;
+    }
+
+    const link_metrics_t metrics = {
+        .rssi_dbm = s_filtered_rssi,
+        .per_permille = s_filtered_per,
+        .backlog_bytes = (uint32_t)xStreamBufferBytesAvailable(s_stream_buffer),
+        .now_ms = now_ms(),
+    };
+
+    if (link_controller_update(&s_link_controller, &metrics)) {
+        ESP_LOGI(TAG, "Link level %s (%s): rssi=%d per=%u backlog=%lu",
+                 link_controller_level_info(s_link_controller.level)->name,
+                 s_link_controller.reason,
+                 metrics.rssi_dbm,
+                 metrics.per_permille,
+                 (unsigned long)metrics.backlog_bytes);
+        apply_link_level(s_link_controller.level);
+    }
+}
+
+/**
+ * Enables or disables Bluetooth controller modem sleep.
+ *
+ * With modem sleep the controller powers the radio down between connection
+ * events. It is only available when CONFIG_BT_CTRL_MODEM_SLEEP is set.
+ *
+ * Args:
+ *     enable: true to allow modem sleep.
+ */
+static void set_modem_sleep(bool enable)
+{
+#if CONFIG_BT_CTRL_MODEM_SLEEP
+    if (enable == s_modem_sleep_enabled) {
+        return;
+    }
+
+    esp_err_t err = enable ? esp_bt_sleep_enable() : esp_bt_sleep_disable();
+    if (err == ESP_OK) {
+        s_modem_sleep_enabled = enable;
     } else {
-        set_connection_power(ESP_PWR_LVL_P20);
-        request_connection_phy(ESP_BLE_GAP_PHY_CODED_PREF_MASK,
-                               ESP_BLE_GAP_PHY_OPTIONS_PREF_S8_CODING);
+        ESP_LOGW(TAG, "Modem sleep %s failed: %s",
+                 enable ? "enable" : "disable", esp_err_to_name(err));
+    }
+#else
+    (void)enable;
+#endif
+}
+
+/**
+ * Requests the connection parameters of a profile and its modem-sleep mode.
+ *
+ * Args:
+ *     profile: Connection profile chosen by the profile manager.
+ */
+static void apply_conn_profile(conn_profile_t profile)
+{
+    if (!s_connected) {
+        return;
+    }
+
+    const conn_profile_info_t *info = conn_profile_info(profile);
+    esp_ble_conn_update_params_t params = {
+        .min_int = info->min_interval,
+        .max_int = info->max_interval,
+        .latency = info->latency,
+        .timeout = info->timeout,
+    };
+    memcpy(params.bda, s_peer_address, sizeof(esp_bd_addr_t));
+
+    esp_err_t err = esp_ble_gap_update_conn_params(&params);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Connection parameter request failed: %s", esp_err_to_name(err));
     }
+    set_modem_sleep(info->modem_sleep);
+}
+
+/**
+ * Runs the connection-profile manager on the current traffic.
+ *
+ * Called once per RSSI sample and after every central write, so a write to
+ * an idle link switches it to the interactive profile straight away.
+ */
+static void update_conn_profile(void)
+{
+    uint32_t backlog = (uint32_t)xStreamBufferBytesAvailable(s_stream_buffer);
+
+    if (conn_profile_update(&s_conn_profile, backlog, now_ms())) {
+        ESP_LOGI(TAG, "Connection profile %s, backlog=%lu",
+                 conn_profile_info(s_conn_profile.profile)->name,
+                 (unsigned long)backlog);
+        apply_conn_profile(s_conn_profile.profile);
+    }
+}
+
+/**
+ * Queues test sensor-log records on the stream characteristic.
+ *
+ * Each record is STREAM_RECORD_SIZE bytes: a little-endian sequence number
+ * followed by a little-endian millisecond time stamp. The central can check
+ * the sequence numbers for gaps. Records are packed back to back, so one
+ * notification carries many of them and a record may span two
+ * notifications.
+ *
+ * Args:
+ *     max_bytes: Upper bound on the number of bytes to queue.
+ *
+ * Returns:
+ *     Number of bytes queued.
+ */
+static size_t queue_test_records(size_t max_bytes)
+{
+    uint8_t block[STREAM_RECORD_SIZE * 16];
+    size_t queued = 0;
+
+    xSemaphoreTake(s_stream_write_lock, portMAX_DELAY);
+    while (queued + sizeof(block) <= max_bytes &&
+           xStreamBufferSpacesAvailable(s_stream_buffer) >= sizeof(block)) {
+        uint32_t stamp_ms = now_ms();
+        for (size_t offset = 0; offset < sizeof(block); offset += STREAM_RECORD_SIZE) {
+            uint32_t seq = s_test_record_seq++;
+            for (size_t i = 0; i < 4; ++i) {
+                block[offset + i] = (uint8_t)(seq >> (8 * i));
+                block[offset + 4 + i] = (uint8_t)(stamp_ms >> (8 * i));
+            }
+        }
+        xStreamBufferSend(s_stream_buffer, block, sizeof(block), 0);
+        queued += sizeof(block);
+    }
+    xSemaphoreGive(s_stream_write_lock);
+    return queued;
 }
 
 /**
  * Processes a control characteristic command.
  *
- * Supported commands are AUTO, 1M, S2, S8, LOW, MEDIUM, HIGH, and MAX.
+ * Supported commands are AUTO, 1M, 2M, S2, S8, LOW, MEDIUM, HIGH, MAX, BURST,
+ * STREAM, and STOP. PHY and power commands suspend the adaptive link
+ * controller.
  *
  * Args:
  *     value: Pointer to the received command bytes.
@@ -314,10 +607,32 @@ static void process_control_command(const uint8_t *value, uint16_t length)
     ESP_LOGI(TAG, "Control command: %s", command);
 
     if (strcmp(command, "AUTO") == 0) {
-        apply_link_policy();
-    } else if (strcmp(command, "1M") == 0) {
+        s_auto_link = true;
+        apply_link_level(s_link_controller.level);
+        return;
+    }
+
+    if (strcmp(command, "BURST") == 0) {
+        ESP_LOGI(TAG, "Queued %u burst bytes",
+                 (unsigned)queue_test_records(STREAM_BURST_BYTES));
+        return;
+    }
+
+    if (strcmp(command, "STREAM") == 0 || strcmp(command, "STOP") == 0) {
+        s_stream_generator = (strcmp(command, "STREAM") == 0);
+        ESP_LOGI(TAG, "Continuous test stream %s", s_stream_generator ? "started" : "stopped");
+        return;
+    }
+
+    bool was_auto = s_auto_link;
+    s_auto_link = false;
+    if (strcmp(command, "1M") == 0) {
         request_connection_phy(ESP_BLE_GAP_PHY_1M_PREF_MASK,
                                ESP_BLE_GAP_PHY_OPTIONS_PREF_S2_CODING);
+    } else if (strcmp(command, "2M") == 0) {
+        request_connection_phy(ESP_BLE_GAP_PHY_2M_PREF_MASK,
+                               ESP_BLE_GAP_PHY_OPTIONS_NO_PREF);
+        request_data_length(251);
     } else if (strcmp(command, "S2") == 0) {
         request_connection_phy(ESP_BLE_GAP_PHY_CODED_PREF_MASK,
                                ESP_BLE_GAP_PHY_OPTIONS_PREF_S2_CODING);
@@ -333,10 +648,56 @@ static void process_control_command(const uint8_t *value, uint16_t length)
     } else if (strcmp(command, "MAX") == 0) {
         set_connection_power(ESP_PWR_LVL_P20);
     } else {
+        s_auto_link = was_auto;
         ESP_LOGW(TAG, "Unknown command");
     }
 }
 
+/**
+ * Writes the latest broadcast telemetry into the advertising set.
+ *
+ * The frame is one manufacturer-specific AD structure:
+ *
+ *     length, 0xFF, company ID (2, LE), frame type (1), sequence (2, LE),
+ *     uptime in seconds (4, LE), advertising TX power in dBm (1), payload
+ *
+ * The sequence number changes with every update, so a gateway that hears
+ * the same frame in several advertising events can drop the repeats. The
+ * set keeps advertising while its data is replaced.
+ */
+static void update_broadcast_data(void)
+{
+    uint8_t frame[BROADCAST_HEADER_SIZE + BLE_LONG_RANGE_BROADCAST_MAX_PAYLOAD];
+    uint32_t uptime_s = now_ms() / 1000U;
+
+    xSemaphoreTake(s_broadcast_lock, portMAX_DELAY);
+    size_t length = BROADCAST_HEADER_SIZE + s_broadcast_payload_length;
+    frame[0] = (uint8_t)(length - 1);
+    frame[1] = ESP_BLE_AD_MANUFACTURER_SPECIFIC_TYPE;
+    frame[2] = (uint8_t)(BROADCAST_COMPANY_ID & 0xFF);
+    frame[3] = (uint8_t)(BROADCAST_COMPANY_ID >> 8);
+    frame[4] = BROADCAST_FRAME_TELEMETRY;
+    frame[5] = (uint8_t)(s_broadcast_seq & 0xFF);
+    frame[6] = (uint8_t)(s_broadcast_seq >> 8);
+    frame[7] = (uint8_t)(uptime_s & 0xFF);
+    frame[8] = (uint8_t)((uptime_s >> 8) & 0xFF);
+    frame[9] = (uint8_t)((uptime_s >> 16) & 0xFF);
+    frame[10] = (uint8_t)(uptime_s >> 24);
+    frame[11] = (uint8_t)ADV_TX_POWER_DBM;
+    memcpy(&frame[BROADCAST_HEADER_SIZE], s_broadcast_payload, s_broadcast_payload_length);
+    ++s_broadcast_seq;
+
+    /* The host copies the data, so the frame can live on the stack. */
+    esp_err_t err = esp_ble_gap_config_ext_adv_data_raw(EXT_ADV_INSTANCE,
+                                                        (uint16_t)length,
+                                                        frame);
+    xSemaphoreGive(s_broadcast_lock);
+
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Broadcast data update failed: %s", esp_err_to_name(err));
+    }
+}
+
 /**
  * Starts the configured extended advertising set.
  */
@@ -354,6 +715,25 @@ static void start_extended_advertising(void)
     }
 }
 
+/**
+ * Refreshes the broadcast frame when the payload changes and at a fixed
+ * period, so the uptime field stays current.
+ *
+ * Args:
+ *     context: Unused FreeRTOS task context pointer.
+ */
+static void broadcast_task(void *context)
+{
+    (void)context;
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(BROADCAST_REFRESH_MS));
+        if (s_advertising_started) {
+            update_broadcast_data();
+        }
+    }
+}
+
 /**
  * Periodically requests RSSI measurements while a peer is connected.
  *
@@ -375,6 +755,106 @@ static void rssi_monitor_task(void *context)
     }
 }
 
+/**
+ * Logs stream throughput for the last report interval.
+ *
+ * Args:
+ *     notifications: Notifications handed to the stack in the interval.
+ *     interval_ms: Length of the interval.
+ */
+static void report_stream_throughput(uint32_t notifications, uint32_t interval_ms)
+{
+    uint32_t bytes = atomic_exchange(&s_stream_confirmed_bytes, 0);
+    uint32_t congestion = atomic_exchange(&s_stream_congestion_events, 0);
+
+    s_stream_kbps = (interval_ms > 0) ? (uint32_t)(((uint64_t)bytes * 8U) / interval_ms) : 0;
+    if (bytes == 0 && notifications == 0) {
+        return;
+    }
+
+    ESP_LOGI(TAG, "Stream: %lu kbit/s, %lu B, %lu notifications, MTU=%u, "
+             "backlog=%lu, congested=%lu",
+             (unsigned long)s_stream_kbps,
+             (unsigned long)bytes,
+             (unsigned long)notifications,
+             s_mtu,
+             (unsigned long)xStreamBufferBytesAvailable(s_stream_buffer),
+             (unsigned long)congestion);
+}
+
+/**
+ * Sends queued stream bytes as notifications while a subscriber can take them.
+ *
+ * Each notification carries as many bytes as the negotiated ATT MTU allows,
+ * so small records queued by the application are packed together. Up to
+ * STREAM_MAX_IN_FLIGHT notifications are outstanding at once; a slot is
+ * freed by ESP_GATTS_CONF_EVT. The task also stops while the stack reports
+ * congestion and is woken by the GATTS callback when either condition
+ * clears.
+ *
+ * Args:
+ *     context: Unused FreeRTOS task context pointer.
+ */
+static void stream_task(void *context)
+{
+    (void)context;
+
+    TickType_t report_start = xTaskGetTickCount();
+    uint32_t notifications = 0;
+
+    while (true) {
+        uint32_t elapsed_ms = (uint32_t)pdTICKS_TO_MS(xTaskGetTickCount() - report_start);
+        if (elapsed_ms >= STREAM_REPORT_MS) {
+            report_stream_throughput(notifications, elapsed_ms);
+            notifications = 0;
+            report_start = xTaskGetTickCount();
+        }
+
+        if (!s_connected || !s_stream_notifications_enabled) {
+            vTaskDelay(pdMS_TO_TICKS(STREAM_IDLE_POLL_MS));
+            continue;
+        }
+
+        if (s_congested || atomic_load(&s_stream_in_flight) >= STREAM_MAX_IN_FLIGHT) {
+            (void)ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(STREAM_IDLE_POLL_MS));
+            continue;
+        }
+
+        if (s_stream_generator &&
+            xStreamBufferBytesAvailable(s_stream_buffer) < STREAM_BUFFER_SIZE / 2) {
+            (void)queue_test_records(STREAM_BUFFER_SIZE / 2);
+        }
+
+        size_t chunk_length = (size_t)s_mtu - 3;
+        if (chunk_length > STREAM_MAX_LENGTH) {
+            chunk_length = STREAM_MAX_LENGTH;
+        }
+
+        size_t length = xStreamBufferReceive(s_stream_buffer,
+                                             s_stream_value,
+                                             chunk_length,
+                                             pdMS_TO_TICKS(100));
+        if (length == 0) {
+            continue;
+        }
+
+        atomic_fetch_add(&s_tx_attempts, 1);
+        atomic_fetch_add(&s_stream_in_flight, 1);
+        esp_err_t err = esp_ble_gatts_send_indicate(s_gatts_if,
+                                                    s_connection_id,
+                                                    s_handles[IDX_STREAM_VALUE],
+                                                    (uint16_t)length,
+                                                    s_stream_value,
+                                                    false);
+        if (err != ESP_OK) {
+            atomic_fetch_sub(&s_stream_in_flight, 1);
+            atomic_fetch_add(&s_tx_failures, 1);
+        } else {
+            ++notifications;
+        }
+    }
+}
+
 /**
  * Handles Bluetooth GAP events.
  *
@@ -387,24 +867,29 @@ static void gap_event_handler(esp_gap_ble_cb_event_t event,
 {
     switch (event) {
         case ESP_GAP_BLE_EXT_ADV_SET_PARAMS_COMPLETE_EVT:
-            if (param->ext_adv_set_params.status == ESP_BT_STATUS_SUCCESS) {
+            if (param->ext_adv_set_params.status != ESP_BT_STATUS_SUCCESS) {
+                ESP_LOGE(TAG, "Extended advertising parameter setup failed");
+            } else if (BROADCAST_MODE) {
+                update_broadcast_data();
+            } else {
                 ESP_ERROR_CHECK(esp_ble_gap_config_ext_adv_data_raw(
                     EXT_ADV_INSTANCE, sizeof(EXT_ADV_DATA), EXT_ADV_DATA));
-            } else {
-                ESP_LOGE(TAG, "Extended advertising parameter setup failed");
             }
             break;
 
         case ESP_GAP_BLE_EXT_ADV_DATA_SET_COMPLETE_EVT:
-            if (param->ext_adv_data_set.status == ESP_BT_STATUS_SUCCESS) {
-                start_extended_advertising();
-            } else {
+            if (param->ext_adv_data_set.status != ESP_BT_STATUS_SUCCESS) {
                 ESP_LOGE(TAG, "Extended advertising data setup failed");
+            } else if (!s_advertising_started) {
+                /* Later broadcast updates replace the data of a running set. */
+                start_extended_advertising();
             }
             break;
 
         case ESP_GAP_BLE_EXT_ADV_START_COMPLETE_EVT:
-            ESP_LOGI(TAG, "Extended Coded PHY advertising status=%d",
+            s_advertising_started = (param->ext_adv_start.status == ESP_BT_STATUS_SUCCESS);
+            ESP_LOGI(TAG, "Extended Coded PHY %s advertising status=%d",
+                     BROADCAST_MODE ? "broadcast" : "connectable",
                      param->ext_adv_start.status);
             break;
 
@@ -429,12 +914,31 @@ static void gap_event_handler(esp_gap_ble_cb_event_t event,
                         RSSI_FILTER_ALPHA_DEN);
                 }
                 ++s_rssi_samples;
+                update_packet_error_rate();
                 publish_telemetry(raw_rssi);
                 apply_link_policy();
+                update_conn_profile();
 
             }
             break;
 
+        case ESP_GAP_BLE_UPDATE_CONN_PARAMS_EVT:
+            /* Interval is in 1.25 ms units; log it in tenths of a millisecond. */
+            ESP_LOGI(TAG, "Connection parameters status=%d: interval=%u.%u ms latency=%u timeout=%u ms",
+                     param->update_conn_params.status,
+                     (param->update_conn_params.conn_int * 125U) / 100U,
+                     ((param->update_conn_params.conn_int * 125U) % 100U) / 10U,
+                     param->update_conn_params.latency,
+                     param->update_conn_params.timeout * 10U);
+            break;
+
+        case ESP_GAP_BLE_SET_PKT_LENGTH_COMPLETE_EVT:
+            ESP_LOGI(TAG, "Data length status=%d: TX=%u RX=%u",
+                     param->pkt_data_length_cmpl.status,
+                     param->pkt_data_length_cmpl.params.tx_len,
+                     param->pkt_data_length_cmpl.params.rx_len);
+            break;
+
         default:
             break;
     }
@@ -485,24 +989,36 @@ static void gatts_event_handler(esp_gatts_cb_event_t event,
             memcpy(s_peer_address, param->connect.remote_bda, sizeof(esp_bd_addr_t));
             s_filtered_rssi = -127;
             s_rssi_samples = 0;
+            s_filtered_per = 0;
+            atomic_store(&s_tx_attempts, 0);
+            atomic_store(&s_tx_failures, 0);
+            s_mtu = ATT_DEFAULT_MTU;
+            s_congested = false;
+            atomic_store(&s_stream_in_flight, 0);
+            s_auto_link = true;
             ESP_LOGI(TAG, "Peer connected, conn_id=%u handle=%u",
                      s_connection_id, s_connection_handle);
 
-            /* Maximum documented ESP32-S3 connection power for range testing. */
-            set_connection_power(ESP_PWR_LVL_P20);
-            request_connection_phy(ESP_BLE_GAP_PHY_CODED_PREF_MASK,
-                                   ESP_BLE_GAP_PHY_OPTIONS_PREF_S8_CODING);
+            /* Start at maximum documented connection power on Coded S=8 for range. */
+            link_controller_reset(&s_link_controller, LINK_LEVEL_CODED_S8, now_ms());
+            apply_link_level(LINK_LEVEL_CODED_S8);
+            conn_profile_reset(&s_conn_profile, now_ms());
+            apply_conn_profile(s_conn_profile.profile);
             break;
 
         case ESP_GATTS_DISCONNECT_EVT:
             ESP_LOGI(TAG, "Peer disconnected, reason=0x%02x", param->disconnect.reason);
             s_connected = false;
             s_notifications_enabled = false;
+            s_stream_notifications_enabled = false;
+            s_stream_generator = false;
             s_current_phy = ESP_BLE_GAP_PHY_1M;
+            set_modem_sleep(true);
             start_extended_advertising();
             break;
 
         case ESP_GATTS_WRITE_EVT:
+            conn_profile_note_interaction(&s_conn_profile, now_ms());
             if (param->write.handle == s_handles[IDX_TELEMETRY_CCCD] &&
                 param->write.len == 2) {
                 uint16_t cccd = (uint16_t)param->write.value[0] |
@@ -510,15 +1026,49 @@ static void gatts_event_handler(esp_gatts_cb_event_t event,
                 s_notifications_enabled = (cccd == 0x0001);
                 ESP_LOGI(TAG, "Notifications %s",
                          s_notifications_enabled ? "enabled" : "disabled");
+            } else if (param->write.handle == s_handles[IDX_STREAM_CCCD] &&
+                       param->write.len == 2) {
+                uint16_t cccd = (uint16_t)param->write.value[0] |
+                                ((uint16_t)param->write.value[1] << 8);
+                s_stream_notifications_enabled = (cccd == 0x0001);
+                ESP_LOGI(TAG, "Stream notifications %s",
+                         s_stream_notifications_enabled ? "enabled" : "disabled");
             } else if (param->write.handle == s_handles[IDX_CONTROL_VALUE]) {
                 process_control_command(param->write.value, param->write.len);
             }
+            update_conn_profile();
             break;
 
         case ESP_GATTS_MTU_EVT:
+            s_mtu = param->mtu.mtu;
             ESP_LOGI(TAG, "Negotiated ATT MTU=%u", param->mtu.mtu);
             break;
 
+        case ESP_GATTS_CONF_EVT:
+            if (param->conf.status != ESP_GATT_OK) {
+                atomic_fetch_add(&s_tx_failures, 1);
+            }
+            if (param->conf.handle == s_handles[IDX_STREAM_VALUE]) {
+                if (param->conf.status == ESP_GATT_OK) {
+                    atomic_fetch_add(&s_stream_confirmed_bytes, param->conf.len);
+                    conn_profile_note_traffic(&s_conn_profile, now_ms());
+                }
+                if (atomic_load(&s_stream_in_flight) > 0) {
+                    atomic_fetch_sub(&s_stream_in_flight, 1);
+                }
+                xTaskNotifyGive(s_stream_task);
+            }
+            break;
+
+        case ESP_GATTS_CONGEST_EVT:
+            s_congested = param->congest.congested;
+            if (s_congested) {
+                atomic_fetch_add(&s_stream_congestion_events, 1);
+            } else {
+                xTaskNotifyGive(s_stream_task);
+            }
+            break;
+
         default:
             break;
     }
@@ -541,6 +1091,31 @@ static esp_err_t initialize_nvs(void)
     return err;
 }
 
+/**
+ * Enables dynamic frequency scaling when power management is configured.
+ *
+ * The Bluetooth driver holds a power-management lock while the radio needs
+ * the full APB clock, so the CPU only drops to the XTAL frequency while the
+ * controller sleeps between connection events.
+ *
+ * Returns:
+ *     ESP_OK: Power management is configured or disabled in sdkconfig.
+ *     Other: An esp_pm_configure() error.
+ */
+static esp_err_t initialize_power_management(void)
+{
+#if CONFIG_PM_ENABLE
+    const esp_pm_config_t pm_config = {
+        .max_freq_mhz = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ,
+        .min_freq_mhz = PM_MIN_CPU_FREQ_MHZ,
+        .light_sleep_enable = false,
+    };
+    return esp_pm_configure(&pm_config);
+#else
+    return ESP_OK;
+#endif
+}
+
 /**
  * Initializes the Bluetooth controller and Bluedroid host stack.
  *
@@ -564,25 +1139,21 @@ static esp_err_t initialize_bluetooth_stack(void)
 }
 
 /**
- * Initializes the BLE long-range GATT server.
+ * Registers the GATT server and starts the connection tasks.
+ *
+ * Advertising starts once the attribute table has been created.
  *
  * Returns:
- *     ESP_OK: Initialization completed successfully.
+ *     ESP_OK: The GATT application is registered.
  *     Other: An ESP-IDF error code identifying the failed operation.
  */
-esp_err_t ble_long_range_init(void)
+static esp_err_t initialize_gatt_server(void)
 {
-    ESP_RETURN_ON_ERROR(initialize_nvs(), TAG, "NVS initialization failed");
-    ESP_RETURN_ON_ERROR(initialize_bluetooth_stack(),
-                        TAG, "Bluetooth stack initialization failed");
-
     ESP_RETURN_ON_ERROR(esp_ble_gatts_register_callback(gatts_event_handler),
                         TAG, "GATT callback registration failed");
-    ESP_RETURN_ON_ERROR(esp_ble_gap_register_callback(gap_event_handler),
-                        TAG, "GAP callback registration failed");
     ESP_RETURN_ON_ERROR(esp_ble_gatts_app_register(PROFILE_APP_ID),
                         TAG, "GATT application registration failed");
-    ESP_RETURN_ON_ERROR(esp_ble_gatt_set_local_mtu(247),
+    ESP_RETURN_ON_ERROR(esp_ble_gatt_set_local_mtu(ATT_LOCAL_MTU),
                         TAG, "Local MTU setup failed");
 
     /* Prefer Coded PHY for future connections; the peer may negotiate another PHY. */
@@ -591,6 +1162,83 @@ esp_err_t ble_long_range_init(void)
                             ESP_BLE_GAP_PHY_CODED_PREF_MASK),
                         TAG, "Default PHY setup failed");
 
+    s_stream_buffer = xStreamBufferCreate(STREAM_BUFFER_SIZE, 1);
+    s_stream_write_lock = xSemaphoreCreateMutex();
+    if (s_stream_buffer == NULL || s_stream_write_lock == NULL) {
+        ESP_LOGE(TAG, "Failed to create stream buffer");
+        return ESP_ERR_NO_MEM;
+    }
+
+    BaseType_t task_created = xTaskCreate(rssi_monitor_task,
+                                           "ble_rssi_monitor",
+                                           3072,
+                                           NULL,
+                                           5,
+                                           NULL);
+    if (task_created != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create RSSI monitor task");
+        return ESP_ERR_NO_MEM;
+    }
+
+    task_created = xTaskCreate(stream_task, "ble_stream", 3072, NULL, 5, &s_stream_task);
+    if (task_created != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create stream task");
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * Configures the connectionless broadcast set and its refresh task.
+ *
+ * Returns:
+ *     ESP_OK: The advertising set is being configured.
+ *     Other: An ESP-IDF error code identifying the failed operation.
+ */
+static esp_err_t initialize_broadcast(void)
+{
+    s_broadcast_lock = xSemaphoreCreateMutex();
+    if (s_broadcast_lock == NULL) {
+        ESP_LOGE(TAG, "Failed to create broadcast lock");
+        return ESP_ERR_NO_MEM;
+    }
+
+    BaseType_t task_created = xTaskCreate(broadcast_task,
+                                           "ble_broadcast",
+                                           3072,
+                                           NULL,
+                                           5,
+                                           &s_broadcast_task);
+    if (task_created != pdPASS) {
+        ESP_LOGE(TAG, "Failed to create broadcast task");
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_RETURN_ON_ERROR(esp_ble_gap_ext_adv_set_params(EXT_ADV_INSTANCE,
+                                                       &BROADCAST_ADV_PARAMS),
+                        TAG, "Broadcast advertising setup failed");
+    return ESP_OK;
+}
+
+/**
+ * Initializes the BLE long-range GATT server or telemetry broadcaster.
+ *
+ * Returns:
+ *     ESP_OK: Initialization completed successfully.
+ *     Other: An ESP-IDF error code identifying the failed operation.
+ */
+esp_err_t ble_long_range_init(void)
+{
+    ESP_RETURN_ON_ERROR(initialize_nvs(), TAG, "NVS initialization failed");
+    ESP_RETURN_ON_ERROR(initialize_power_management(),
+                        TAG, "Power management setup failed");
+    ESP_RETURN_ON_ERROR(initialize_bluetooth_stack(),
+                        TAG, "Bluetooth stack initialization failed");
+
+    ESP_RETURN_ON_ERROR(esp_ble_gap_register_callback(gap_event_handler),
+                        TAG, "GAP callback registration failed");
+
     /* Set default and advertising power through documented controller APIs. */
     ESP_RETURN_ON_ERROR(esp_ble_tx_power_set_enhanced(
                             ESP_BLE_ENHANCED_PWR_TYPE_DEFAULT,
@@ -603,16 +1251,72 @@ esp_err_t ble_long_range_init(void)
                             ESP_PWR_LVL_P20),
                         TAG, "Advertising TX power setup failed");
 
-    BaseType_t task_created = xTaskCreate(rssi_monitor_task,
-                                           "ble_rssi_monitor",
-                                           3072,
-                                           NULL,
-                                           5,
-                                           NULL);
-    if (task_created != pdPASS) {
-        ESP_LOGE(TAG, "Failed to create RSSI monitor task");
-        return ESP_ERR_NO_MEM;
+    if (BROADCAST_MODE) {
+        return initialize_broadcast();
+    }
+    return initialize_gatt_server();
+}
+
+/**
+ * Queues bytes for the stream characteristic.
+ *
+ * Args:
+ *     data: Bytes to send.
+ *     length: Number of bytes.
+ *
+ * Returns:
+ *     ESP_OK: All bytes were queued.
+ *     ESP_ERR_INVALID_ARG: data is NULL or length is zero.
+ *     ESP_ERR_INVALID_STATE: ble_long_range_init() has not run.
+ *     ESP_ERR_NO_MEM: Not enough free space; nothing was queued.
+ */
+esp_err_t ble_long_range_send(const void *data, size_t length)
+{
+    if (data == NULL || length == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_stream_buffer == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    esp_err_t result = ESP_ERR_NO_MEM;
+    xSemaphoreTake(s_stream_write_lock, portMAX_DELAY);
+    if (xStreamBufferSpacesAvailable(s_stream_buffer) >= length) {
+        xStreamBufferSend(s_stream_buffer, data, length, 0);
+        result = ESP_OK;
+    }
+    xSemaphoreGive(s_stream_write_lock);
+    return result;
+}
+
+/**
+ * Replaces the application payload of the broadcast frame.
+ *
+ * Args:
+ *     data: Payload bytes; may be NULL when length is zero.
+ *     length: Number of bytes, up to BLE_LONG_RANGE_BROADCAST_MAX_PAYLOAD.
+ *
+ * Returns:
+ *     ESP_OK: The payload was stored and an update was scheduled.
+ *     ESP_ERR_INVALID_ARG: data is NULL with a non-zero length, or length is too large.
+ *     ESP_ERR_INVALID_STATE: Broadcast mode is disabled or not initialized.
+ */
+esp_err_t ble_long_range_broadcast(const void *data, size_t length)
+{
+    if ((data == NULL && length > 0) || length > BLE_LONG_RANGE_BROADCAST_MAX_PAYLOAD) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!BROADCAST_MODE || s_broadcast_lock == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    xSemaphoreTake(s_broadcast_lock, portMAX_DELAY);
+    if (length > 0) {
+        memcpy(s_broadcast_payload, data, length);
     }
+    s_broadcast_payload_length = length;
+    xSemaphoreGive(s_broadcast_lock);
 
+    xTaskNotifyGive(s_broadcast_task);
     return ESP_OK;
 }
@@ -1,6 +1,8 @@
 #ifndef BLE_LONG_RANGE_H
 #define BLE_LONG_RANGE_H
 
+#include <stddef.h>
+
 #include "esp_err.h"
 
 #ifdef __cplusplus
@@ -8,11 +10,21 @@ extern "C" {
 #endif
 
 /**
- * Initializes the BLE long-range GATT server.
+ * Largest application payload in a broadcast frame.
+ *
+ * The frame then still fits in one AUX_ADV_IND, so a gateway receives it in
+ * a single Coded PHY packet without an advertising chain.
+ */
+#define BLE_LONG_RANGE_BROADCAST_MAX_PAYLOAD 180
+
+/**
+ * Initializes the BLE long-range GATT server or telemetry broadcaster.
  *
- * The function initializes NVS, the Bluetooth controller, Bluedroid, the
- * GATT server, Coded PHY preferences, transmit power, and extended
- * advertising.
+ * The function initializes NVS, the Bluetooth controller, Bluedroid,
+ * transmit power, and extended advertising. By default it also starts the
+ * GATT server with Coded PHY preferences. With
+ * CONFIG_BLE_LR_BROADCAST_MODE it instead starts non-connectable Coded PHY
+ * advertising that carries the payload set with ble_long_range_broadcast().
  *
  * Returns:
  *     ESP_OK: Initialization completed successfully.
@@ -20,6 +32,46 @@ extern "C" {
  */
 esp_err_t ble_long_range_init(void);
 
+/**
+ * Queues bytes for notification on the stream characteristic.
+ *
+ * Queued bytes are sent while a central is connected and subscribed to the
+ * stream characteristic. The number of queued bytes is the backlog the
+ * adaptive link controller uses to decide when LE 2M PHY is worthwhile.
+ * The call never blocks on the radio.
+ *
+ * Args:
+ *     data: Bytes to send.
+ *     length: Number of bytes.
+ *
+ * Returns:
+ *     ESP_OK: All bytes were queued.
+ *     ESP_ERR_INVALID_ARG: data is NULL or length is zero.
+ *     ESP_ERR_INVALID_STATE: ble_long_range_init() has not run.
+ *     ESP_ERR_NO_MEM: Not enough free space; nothing was queued.
+ */
+esp_err_t ble_long_range_send(const void *data, size_t length);
+
+/**
+ * Replaces the application payload of the connectionless broadcast.
+ *
+ * Only available with CONFIG_BLE_LR_BROADCAST_MODE. The payload follows a
+ * small header with a sequence number, uptime, and TX power in a
+ * manufacturer-specific AD structure, and the advertising data is updated
+ * in place without stopping the set. The header is also refreshed every
+ * few seconds when the payload does not change.
+ *
+ * Args:
+ *     data: Payload bytes; may be NULL when length is zero.
+ *     length: Number of bytes, up to BLE_LONG_RANGE_BROADCAST_MAX_PAYLOAD.
+ *
+ * Returns:
+ *     ESP_OK: The payload was stored and an update was scheduled.
+ *     ESP_ERR_INVALID_ARG: data is NULL with a non-zero length, or length is too large.
+ *     ESP_ERR_INVALID_STATE: Broadcast mode is disabled or not initialized.
+ */
+esp_err_t ble_long_range_broadcast(const void *data, size_t length);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,88 @@
+#include "conn_profile.h"
+
+/* Stream backlog that selects the bulk profile. */
+#define BULK_BACKLOG_BYTES          512
+
+/* Time the bulk profile is held after the last delivered stream data. */
+#define BULK_HOLD_MS                2000
+
+/* Time the interactive profile is held after the last central write. */
+#define INTERACTIVE_HOLD_MS         5000
+
+/* Quiet time before the link drops to the idle profile. */
+#define IDLE_AFTER_MS               10000
+
+/* Minimum time on a profile before moving toward idle. */
+#define MIN_DWELL_MS                3000
+
+/*
+ * Supervision timeouts exceed (1 + latency) * max_interval * 2, as the Core
+ * specification requires, with margin for Coded PHY retransmissions.
+ */
+static const conn_profile_info_t PROFILE_INFO[CONN_PROFILE_COUNT] = {
+    /* 400-500 ms interval, two events may be skipped: about 1.5 s to react. */
+    [CONN_PROFILE_IDLE] = {"idle", 320, 400, 2, 500, true},
+    /* 15-30 ms interval leaves room for several full-length packets per event. */
+    [CONN_PROFILE_BULK] = {"bulk", 12, 24, 0, 400, false},
+    /* 7.5 ms, the shortest interval the specification allows. */
+    [CONN_PROFILE_INTERACTIVE] = {"interactive", 6, 6, 0, 400, false},
+};
+
+void conn_profile_reset(conn_profile_manager_t *manager, uint32_t now_ms)
+{
+    manager->profile = CONN_PROFILE_INTERACTIVE;
+    manager->profile_since_ms = now_ms;
+    manager->last_interaction_ms = now_ms;
+    manager->last_traffic_ms = now_ms;
+}
+
+void conn_profile_note_interaction(conn_profile_manager_t *manager, uint32_t now_ms)
+{
+    manager->last_interaction_ms = now_ms;
+}
+
+void conn_profile_note_traffic(conn_profile_manager_t *manager, uint32_t now_ms)
+{
+    manager->last_traffic_ms = now_ms;
+}
+
+bool conn_profile_update(conn_profile_manager_t *manager,
+                         uint32_t backlog_bytes,
+                         uint32_t now_ms)
+{
+    const conn_profile_t current = manager->profile;
+    const uint32_t since_interaction = now_ms - manager->last_interaction_ms;
+    const uint32_t since_traffic = now_ms - manager->last_traffic_ms;
+    conn_profile_t target = current;
+
+    if (backlog_bytes >= BULK_BACKLOG_BYTES) {
+        manager->last_traffic_ms = now_ms;
+        target = CONN_PROFILE_BULK;
+    } else if (current == CONN_PROFILE_BULK && since_traffic < BULK_HOLD_MS) {
+        target = CONN_PROFILE_BULK;
+    } else if (since_interaction < INTERACTIVE_HOLD_MS) {
+        target = CONN_PROFILE_INTERACTIVE;
+    } else if (since_interaction >= IDLE_AFTER_MS && since_traffic >= IDLE_AFTER_MS) {
+        target = CONN_PROFILE_IDLE;
+    }
+
+    if (target == current) {
+        return false;
+    }
+
+    if (target < current && now_ms - manager->profile_since_ms < MIN_DWELL_MS) {
+        return false;
+    }
+
+    manager->profile = target;
+    manager->profile_since_ms = now_ms;
+    return true;
+}
+
+const conn_profile_info_t *conn_profile_info(conn_profile_t profile)
+{
+    if (profile >= CONN_PROFILE_COUNT) {
+        profile = CONN_PROFILE_IDLE;
+    }
+    return &PROFILE_INFO[profile];
+}
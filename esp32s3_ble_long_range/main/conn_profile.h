@@ -0,0 +1,104 @@
+#ifndef CONN_PROFILE_H
+#define CONN_PROFILE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Connection-parameter profiles, from the lowest power to the lowest latency. */
+typedef enum {
+    CONN_PROFILE_IDLE,
+    CONN_PROFILE_BULK,
+    CONN_PROFILE_INTERACTIVE,
+    CONN_PROFILE_COUNT
+} conn_profile_t;
+
+/** Connection parameters for one profile, in Bluetooth Core units. */
+typedef struct {
+    const char *name;
+    uint16_t min_interval;      /* 1.25 ms units. */
+    uint16_t max_interval;      /* 1.25 ms units. */
+    uint16_t latency;           /* Connection events the peripheral may skip. */
+    uint16_t timeout;           /* Supervision timeout in 10 ms units. */
+    bool modem_sleep;           /* Let the controller sleep between events. */
+} conn_profile_info_t;
+
+/** Profile manager state. Treat the fields as read-only outside the manager. */
+typedef struct {
+    conn_profile_t profile;
+    uint32_t profile_since_ms;
+    uint32_t last_interaction_ms;
+    uint32_t last_traffic_ms;
+} conn_profile_manager_t;
+
+/**
+ * Starts a new connection in the interactive profile.
+ *
+ * Service discovery and the first control writes follow a connection, so
+ * the manager begins with the lowest latency.
+ *
+ * Args:
+ *     manager: Manager state to reset.
+ *     now_ms: Current time stamp in milliseconds.
+ */
+void conn_profile_reset(conn_profile_manager_t *manager, uint32_t now_ms);
+
+/**
+ * Records a central write such as a control command or CCCD update.
+ *
+ * Args:
+ *     manager: Manager state.
+ *     now_ms: Current time stamp in milliseconds.
+ */
+void conn_profile_note_interaction(conn_profile_manager_t *manager, uint32_t now_ms);
+
+/**
+ * Records stream data delivered to the central.
+ *
+ * Args:
+ *     manager: Manager state.
+ *     now_ms: Current time stamp in milliseconds.
+ */
+void conn_profile_note_traffic(conn_profile_manager_t *manager, uint32_t now_ms);
+
+/**
+ * Chooses the profile for the current traffic.
+ *
+ * A stream backlog selects the bulk profile. A recent central write
+ * selects the interactive profile. After a quiet period the link moves to
+ * the idle profile. Moves to a lower-latency profile happen at once; moves
+ * toward idle wait out a minimum dwell time so a short pause does not cost
+ * two parameter updates.
+ *
+ * Args:
+ *     manager: Manager state, updated when the profile changes.
+ *     backlog_bytes: Stream bytes waiting to be sent.
+ *     now_ms: Current time stamp in milliseconds.
+ *
+ * Returns:
+ *     true: The profile changed; apply conn_profile_info().
+ *     false: The current profile should be kept.
+ */
+bool conn_profile_update(conn_profile_manager_t *manager,
+                         uint32_t backlog_bytes,
+                         uint32_t now_ms);
+
+/**
+ * Returns the connection parameters for a profile.
+ *
+ * Args:
+ *     profile: Connection profile.
+ *
+ * Returns:
+ *     Pointer to a constant parameter entry.
+ */
+const conn_profile_info_t *conn_profile_info(conn_profile_t profile);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,151 @@
+#include "link_controller.h"
+
+#include "esp_bt.h"
+#include "esp_gap_ble_api.h"
+
+/*
+ * RSSI needed to move up to a level, and to remain on it. The gap between
+ * the two values is the hysteresis band.
+ */
+#define RSSI_ENTER_S2_DBM           (-88)
+#define RSSI_STAY_S2_DBM            (-93)
+#define RSSI_ENTER_1M_DBM           (-78)
+#define RSSI_STAY_1M_DBM            (-84)
+#define RSSI_ENTER_1M_LOW_DBM       (-64)
+#define RSSI_STAY_1M_LOW_DBM        (-70)
+#define RSSI_ENTER_2M_DBM           (-70)
+#define RSSI_STAY_2M_DBM            (-76)
+
+/* Packet error rate limits in parts per thousand. */
+#define PER_STEP_DOWN_PERMILLE      100
+#define PER_UPGRADE_MAX_PERMILLE    20
+
+/* Send backlog that selects LE 2M, and the level that releases it. */
+#define BACKLOG_HIGH_BYTES          2048
+#define BACKLOG_LOW_BYTES           256
+
+/* Minimum time on a level before it may change. */
+#define UPGRADE_DWELL_MS            5000
+#define DOWNGRADE_DWELL_MS          1000
+
+static const link_level_info_t LEVEL_INFO[LINK_LEVEL_COUNT] = {
+    [LINK_LEVEL_CODED_S8] = {"S8", ESP_BLE_GAP_PHY_CODED_PREF_MASK,
+                             ESP_BLE_GAP_PHY_OPTIONS_PREF_S8_CODING,
+                             ESP_PWR_LVL_P20, 27},
+    [LINK_LEVEL_CODED_S2] = {"S2", ESP_BLE_GAP_PHY_CODED_PREF_MASK,
+                             ESP_BLE_GAP_PHY_OPTIONS_PREF_S2_CODING,
+                             ESP_PWR_LVL_P15, 251},
+    [LINK_LEVEL_1M] = {"1M", ESP_BLE_GAP_PHY_1M_PREF_MASK,
+                       ESP_BLE_GAP_PHY_OPTIONS_NO_PREF,
+                       ESP_PWR_LVL_P9, 251},
+    [LINK_LEVEL_1M_LOW_POWER] = {"1M-LOW", ESP_BLE_GAP_PHY_1M_PREF_MASK,
+                                 ESP_BLE_GAP_PHY_OPTIONS_NO_PREF,
+                                 ESP_PWR_LVL_P3, 251},
+    [LINK_LEVEL_2M] = {"2M", ESP_BLE_GAP_PHY_2M_PREF_MASK,
+                       ESP_BLE_GAP_PHY_OPTIONS_NO_PREF,
+                       ESP_PWR_LVL_P9, 251},
+};
+
+/**
+ * Checks an RSSI threshold pair against the current level.
+ *
+ * Args:
+ *     rssi: Filtered RSSI in dBm.
+ *     on_level: true if the link already uses the level being checked.
+ *     enter_dbm: Threshold for moving to the level.
+ *     stay_dbm: Threshold for staying on the level.
+ *
+ * Returns:
+ *     true if RSSI supports the level.
+ */
+static bool rssi_allows(int16_t rssi, bool on_level, int16_t enter_dbm, int16_t stay_dbm)
+{
+    return rssi >= (on_level ? stay_dbm : enter_dbm);
+}
+
+/**
+ * Selects the level RSSI and backlog call for, before PER and dwell rules.
+ *
+ * Args:
+ *     current: Level the link currently uses.
+ *     metrics: Latest link measurements.
+ *
+ * Returns:
+ *     Target level.
+ */
+static link_level_t select_target(link_level_t current, const link_metrics_t *metrics)
+{
+    const int16_t rssi = metrics->rssi_dbm;
+
+    bool want_2m = (current == LINK_LEVEL_2M)
+                       ? metrics->backlog_bytes > BACKLOG_LOW_BYTES
+                       : metrics->backlog_bytes >= BACKLOG_HIGH_BYTES;
+    if (want_2m &&
+        rssi_allows(rssi, current == LINK_LEVEL_2M, RSSI_ENTER_2M_DBM, RSSI_STAY_2M_DBM)) {
+        return LINK_LEVEL_2M;
+    }
+
+    /* Leaving 2M counts as staying in the 1M band it was entered from. */
+    bool on_1m = (current >= LINK_LEVEL_1M);
+    if (rssi_allows(rssi, current == LINK_LEVEL_1M_LOW_POWER,
+                    RSSI_ENTER_1M_LOW_DBM, RSSI_STAY_1M_LOW_DBM)) {
+        return LINK_LEVEL_1M_LOW_POWER;
+    }
+    if (rssi_allows(rssi, on_1m, RSSI_ENTER_1M_DBM, RSSI_STAY_1M_DBM)) {
+        return LINK_LEVEL_1M;
+    }
+    if (rssi_allows(rssi, current >= LINK_LEVEL_CODED_S2, RSSI_ENTER_S2_DBM, RSSI_STAY_S2_DBM)) {
+        return LINK_LEVEL_CODED_S2;
+    }
+    return LINK_LEVEL_CODED_S8;
+}
+
+void link_controller_reset(link_controller_t *controller,
+                           link_level_t level,
+                           uint32_t now_ms)
+{
+    controller->level = level;
+    controller->level_since_ms = now_ms;
+    controller->reason = "reset";
+}
+
+bool link_controller_update(link_controller_t *controller,
+                            const link_metrics_t *metrics)
+{
+    const link_level_t current = controller->level;
+    link_level_t target = select_target(current, metrics);
+    const char *reason = (target > current) ? "rssi/backlog up" : "rssi/backlog down";
+
+    if (metrics->per_permille >= PER_STEP_DOWN_PERMILLE && current > LINK_LEVEL_CODED_S8) {
+        /* Errors despite adequate RSSI: interference or a fading margin. */
+        if (target >= current) {
+            /* 2M falls back to full-power 1M, not the low-power variant. */
+            target = (current == LINK_LEVEL_2M) ? LINK_LEVEL_1M : (link_level_t)(current - 1);
+            reason = "per high";
+        }
+    } else if (metrics->per_permille > PER_UPGRADE_MAX_PERMILLE && target > current) {
+        return false;
+    }
+
+    if (target == current) {
+        return false;
+    }
+
+    uint32_t dwell_ms = metrics->now_ms - controller->level_since_ms;
+    if (dwell_ms < ((target > current) ? UPGRADE_DWELL_MS : DOWNGRADE_DWELL_MS)) {
+        return false;
+    }
+
+    controller->level = target;
+    controller->level_since_ms = metrics->now_ms;
+    controller->reason = reason;
+    return true;
+}
+
+const link_level_info_t *link_controller_level_info(link_level_t level)
+{
+    if (level >= LINK_LEVEL_COUNT) {
+        level = LINK_LEVEL_CODED_S8;
+    }
+    return &LEVEL_INFO[level];
+}
@@ -0,0 +1,98 @@
+#ifndef LINK_CONTROLLER_H
+#define LINK_CONTROLLER_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Link operating levels, ordered from the most robust to the fastest.
+ *
+ * Each level pairs a connection PHY with a transmit-power level and an LL
+ * data length; see link_controller_level_info().
+ */
+typedef enum {
+    LINK_LEVEL_CODED_S8,
+    LINK_LEVEL_CODED_S2,
+    LINK_LEVEL_1M,
+    LINK_LEVEL_1M_LOW_POWER,
+    LINK_LEVEL_2M,
+    LINK_LEVEL_COUNT
+} link_level_t;
+
+/** Radio settings for one link level. */
+typedef struct {
+    const char *name;
+    uint8_t phy_mask;           /* ESP_BLE_GAP_PHY_*_PREF_MASK */
+    uint16_t phy_options;       /* ESP_BLE_GAP_PHY_OPTIONS_* */
+    int8_t power;               /* esp_power_level_t */
+    uint16_t tx_data_length;    /* LL payload octets requested through DLE */
+} link_level_info_t;
+
+/** Link measurements taken once per controller update. */
+typedef struct {
+    int16_t rssi_dbm;           /* Filtered RSSI. */
+    uint16_t per_permille;      /* Filtered packet error rate, 0 to 1000. */
+    uint32_t backlog_bytes;     /* Application bytes waiting to be sent. */
+    uint32_t now_ms;            /* Monotonic time stamp. */
+} link_metrics_t;
+
+/** Controller state. Treat the fields as read-only outside the controller. */
+typedef struct {
+    link_level_t level;
+    uint32_t level_since_ms;
+    const char *reason;         /* Why the last change was made. */
+} link_controller_t;
+
+/**
+ * Resets the controller to a starting level.
+ *
+ * Args:
+ *     controller: Controller state to reset.
+ *     level: Level the link is currently using.
+ *     now_ms: Current time stamp in milliseconds.
+ */
+void link_controller_reset(link_controller_t *controller,
+                           link_level_t level,
+                           uint32_t now_ms);
+
+/**
+ * Chooses the link level for the latest measurements.
+ *
+ * RSSI thresholds have separate enter and stay values, so a level is only
+ * left after RSSI falls several dB below the value that selected it. A high
+ * packet error rate steps the link down one level and blocks upgrades. LE 2M
+ * PHY is only chosen while the send backlog is large. Upgrades wait for a
+ * longer dwell time than downgrades, so fades are handled quickly while a
+ * recovering link is confirmed before it is used at a faster level.
+ *
+ * Args:
+ *     controller: Controller state, updated when the level changes.
+ *     metrics: Latest link measurements.
+ *
+ * Returns:
+ *     true: The level changed; apply link_controller_level_info().
+ *     false: The current level should be kept.
+ */
+bool link_controller_update(link_controller_t *controller,
+                            const link_metrics_t *metrics);
+
+/**
+ * Returns the radio settings for a link level.
+ *
+ * Args:
+ *     level: Link level.
+ *
+ * Returns:
+ *     Pointer to a constant settings entry.
+ */
+const link_level_info_t *link_controller_level_info(link_level_t level);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,494 @@
+#include "ctx_profiler.h"
+
+#if CONFIG_DEMO_PROFILER_ENABLE
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#define PROFILER_RING_RECORDS  CONFIG_DEMO_PROFILER_RING_RECORDS
+#define PROFILER_MAX_TASKS     CONFIG_DEMO_PROFILER_MAX_TASKS
+
+static const char *TAG = "ctx_profiler";
+
+typedef enum
+{
+    PROFILER_RECORD_SWITCH = 0,
+    PROFILER_RECORD_ISR_ENTER,
+    PROFILER_RECORD_ISR_EXIT
+} profiler_record_kind_t;
+
+typedef struct
+{
+    int64_t time_us;
+    TaskHandle_t task_in;
+    TaskHandle_t task_out;
+    uint8_t kind;
+    uint8_t voluntary;
+} profiler_record_t;
+
+/*
+ * One ring per core. The trace hooks of that core are the only writer and
+ * run with interrupts masked; the reader task is the only consumer.
+ */
+typedef struct
+{
+    profiler_record_t records[PROFILER_RING_RECORDS];
+    _Atomic uint32_t head;
+    _Atomic uint32_t tail;
+    _Atomic uint32_t dropped;
+} profiler_ring_t;
+
+/* Per-core hook state, touched only by the trace hooks of that core */
+typedef struct
+{
+    TaskHandle_t task_out;
+    bool out_voluntary;
+    bool blocking;
+} profiler_hook_state_t;
+
+typedef struct
+{
+    TaskHandle_t handle;
+    char name[configMAX_TASK_NAME_LEN];
+    int64_t run_us;
+    uint32_t switches_in;
+    uint32_t preempted;
+    uint32_t voluntary;
+} profiler_task_stats_t;
+
+/* Reader-side view of what each core is doing, rebuilt from the records */
+typedef struct
+{
+    TaskHandle_t current;
+    int64_t since_us;
+    uint32_t isr_depth;
+    int64_t isr_us;
+    uint32_t isr_count;
+} profiler_core_window_t;
+
+static profiler_ring_t s_rings[portNUM_PROCESSORS];
+static profiler_hook_state_t s_hooks[portNUM_PROCESSORS];
+
+static profiler_core_window_t s_cores[portNUM_PROCESSORS];
+static profiler_task_stats_t s_tasks[PROFILER_MAX_TASKS];
+static uint32_t s_task_count;
+static uint32_t s_untracked_switches;
+static int64_t s_window_start_us;
+
+/**
+ * @brief Appends a record to the ring of the calling core.
+ *
+ * Args:
+ *     kind: Record type.
+ *     task_in: Task switched in, or NULL.
+ *     task_out: Task switched out, or NULL.
+ *     voluntary: true if task_out gave up the CPU by blocking.
+ *
+ * Returns:
+ *     None.
+ */
+static void IRAM_ATTR profiler_push(profiler_record_kind_t kind,
+                                    TaskHandle_t task_in,
+                                    TaskHandle_t task_out,
+                                    bool voluntary)
+{
+    UBaseType_t saved = portSET_INTERRUPT_MASK_FROM_ISR();
+    profiler_ring_t *ring = &s_rings[xPortGetCoreID()];
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    if ((tail - head) >= PROFILER_RING_RECORDS)
+    {
+        atomic_store_explicit(&ring->dropped,
+                              atomic_load_explicit(&ring->dropped, memory_order_relaxed) + 1U,
+                              memory_order_relaxed);
+    }
+    else
+    {
+        profiler_record_t *record = &ring->records[tail % PROFILER_RING_RECORDS];
+
+        record->time_us = esp_timer_get_time();
+        record->task_in = task_in;
+        record->task_out = task_out;
+        record->kind = (uint8_t)kind;
+        record->voluntary = voluntary ? 1U : 0U;
+
+        atomic_store_explicit(&ring->tail, tail + 1U, memory_order_release);
+    }
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(saved);
+}
+
+/**
+ * @brief Trace hook: the running task is about to be switched out.
+ *
+ * Args:
+ *     None.
+ *
+ * Returns:
+ *     None.
+ */
+void IRAM_ATTR ctx_profiler_trace_switched_out(void)
+{
+    profiler_hook_state_t *hook = &s_hooks[xPortGetCoreID()];
+
+    hook->task_out = xTaskGetCurrentTaskHandle();
+    hook->out_voluntary = hook->blocking;
+    hook->blocking = false;
+}
+
+/**
+ * @brief Trace hook: the scheduler has selected the next task.
+ *
+ * Args:
+ *     None.
+ *
+ * Returns:
+ *     None.
+ */
+void IRAM_ATTR ctx_profiler_trace_switched_in(void)
+{
+    profiler_hook_state_t *hook = &s_hooks[xPortGetCoreID()];
+    TaskHandle_t task_in = xTaskGetCurrentTaskHandle();
+
+    // The scheduler may pick the same task again; that is not a switch
+    if (task_in != hook->task_out)
+    {
+        profiler_push(PROFILER_RECORD_SWITCH, task_in, hook->task_out, hook->out_voluntary);
+    }
+}
+
+/**
+ * @brief Trace hook: the running task is about to block.
+ *
+ * Args:
+ *     None.
+ *
+ * Returns:
+ *     None.
+ */
+void IRAM_ATTR ctx_profiler_trace_block(void)
+{
+    s_hooks[xPortGetCoreID()].blocking = true;
+}
+
+/**
+ * @brief Trace hook: a task is being suspended.
+ *
+ * Args:
+ *     task: Task being suspended, or NULL for the calling task.
+ *
+ * Returns:
+ *     None.
+ */
+void IRAM_ATTR ctx_profiler_trace_suspend(void *task)
+{
+    if ((task == NULL) || (task == xTaskGetCurrentTaskHandle()))
+    {
+        ctx_profiler_trace_block();
+    }
+}
+
+void IRAM_ATTR ctx_profiler_isr_enter(void)
+{
+    profiler_push(PROFILER_RECORD_ISR_ENTER, NULL, NULL, false);
+}
+
+void IRAM_ATTR ctx_profiler_isr_exit(void)
+{
+    profiler_push(PROFILER_RECORD_ISR_EXIT, NULL, NULL, false);
+}
+
+/**
+ * @brief Finds or adds the statistics entry of a task.
+ *
+ * Args:
+ *     handle: Task handle.
+ *
+ * Returns:
+ *     The entry, or NULL if the table is full.
+ */
+static profiler_task_stats_t *profiler_task_stats(TaskHandle_t handle)
+{
+    for (uint32_t i = 0; i < s_task_count; i++)
+    {
+        if (s_tasks[i].handle == handle)
+        {
+            return &s_tasks[i];
+        }
+    }
+
+    if (s_task_count >= PROFILER_MAX_TASKS)
+    {
+        return NULL;
+    }
+
+    profiler_task_stats_t *stats = &s_tasks[s_task_count++];
+
+    memset(stats, 0, sizeof(*stats));
+    stats->handle = handle;
+    (void)strlcpy(stats->name, pcTaskGetName(handle), sizeof(stats->name));
+
+    return stats;
+}
+
+/**
+ * @brief Charges the time since the last event on a core to its task or its ISR.
+ *
+ * Args:
+ *     core: Reader-side state of the core.
+ *     time_us: Timestamp up to which time is charged.
+ *
+ * Returns:
+ *     None.
+ */
+static void profiler_charge(profiler_core_window_t *core, int64_t time_us)
+{
+    // Records can arrive slightly behind a collect() that already charged past them
+    if (time_us <= core->since_us)
+    {
+        return;
+    }
+
+    int64_t elapsed_us = time_us - core->since_us;
+
+    if (core->isr_depth > 0U)
+    {
+        core->isr_us += elapsed_us;
+    }
+    else if (core->current != NULL)
+    {
+        profiler_task_stats_t *stats = profiler_task_stats(core->current);
+
+        if (stats != NULL)
+        {
+            stats->run_us += elapsed_us;
+        }
+    }
+
+    core->since_us = time_us;
+}
+
+/**
+ * @brief Applies one record to the reader-side state of its core.
+ *
+ * Args:
+ *     core: Reader-side state of the core the record came from.
+ *     record: Record to apply.
+ *
+ * Returns:
+ *     None.
+ */
+static void profiler_apply(profiler_core_window_t *core, const profiler_record_t *record)
+{
+    profiler_charge(core, record->time_us);
+
+    switch (record->kind)
+    {
+        case PROFILER_RECORD_ISR_ENTER:
+            core->isr_depth++;
+            break;
+
+        case PROFILER_RECORD_ISR_EXIT:
+            if (core->isr_depth > 0U)
+            {
+                core->isr_depth--;
+                core->isr_count++;
+            }
+            break;
+
+        case PROFILER_RECORD_SWITCH:
+        default:
+        {
+            profiler_task_stats_t *in = profiler_task_stats(record->task_in);
+
+            if (record->task_out != NULL)
+            {
+                profiler_task_stats_t *out = profiler_task_stats(record->task_out);
+
+                if (out != NULL)
+                {
+                    if (record->voluntary != 0U)
+                    {
+                        out->voluntary++;
+                    }
+                    else
+                    {
+                        out->preempted++;
+                    }
+                }
+            }
+
+            if (in != NULL)
+            {
+                in->switches_in++;
+            }
+            else
+            {
+                s_untracked_switches++;
+            }
+
+            // A switch always happens at task level; recover from a lost ISR exit record
+            core->isr_depth = 0U;
+            core->current = record->task_in;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Drains every ring and charges running tasks up to a point in time.
+ *
+ * Args:
+ *     now_us: Current time, read before draining so every drained record is older.
+ *
+ * Returns:
+ *     None.
+ */
+static void profiler_collect_until(int64_t now_us)
+{
+    for (uint32_t core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        profiler_ring_t *ring = &s_rings[core];
+        uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+        uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+        while (head != tail)
+        {
+            profiler_apply(&s_cores[core], &ring->records[head % PROFILER_RING_RECORDS]);
+            head++;
+        }
+
+        atomic_store_explicit(&ring->head, head, memory_order_release);
+
+        // Charge the task still running on this core up to now
+        profiler_charge(&s_cores[core], now_us);
+    }
+}
+
+void ctx_profiler_init(void)
+{
+    int64_t now_us = esp_timer_get_time();
+
+    memset(s_cores, 0, sizeof(s_cores));
+
+    for (uint32_t core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        // Discard switches recorded before the first window
+        atomic_store_explicit(&s_rings[core].head,
+                              atomic_load_explicit(&s_rings[core].tail, memory_order_acquire),
+                              memory_order_release);
+        s_cores[core].since_us = now_us;
+    }
+
+    s_task_count = 0U;
+    s_untracked_switches = 0U;
+    s_window_start_us = now_us;
+}
+
+void ctx_profiler_collect(void)
+{
+    profiler_collect_until(esp_timer_get_time());
+}
+
+void ctx_profiler_report(void)
+{
+    uint8_t order[PROFILER_MAX_TASKS];
+    uint32_t total_switches = s_untracked_switches;
+    uint32_t dropped = 0U;
+
+    int64_t now_us = esp_timer_get_time();
+
+    profiler_collect_until(now_us);
+
+    int64_t window_us = now_us - s_window_start_us;
+
+    if (window_us <= 0)
+    {
+        return;
+    }
+
+    // Insertion sort by switch count, so a thrashing task comes first
+    for (uint32_t i = 0; i < s_task_count; i++)
+    {
+        uint32_t j = i;
+
+        while ((j > 0U) && (s_tasks[order[j - 1U]].switches_in < s_tasks[i].switches_in))
+        {
+            order[j] = order[j - 1U];
+            j--;
+        }
+
+        order[j] = (uint8_t)i;
+        total_switches += s_tasks[i].switches_in;
+    }
+
+    for (uint32_t core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        dropped += atomic_load_explicit(&s_rings[core].dropped, memory_order_relaxed);
+    }
+
+    ESP_LOGI(TAG,
+             "window_ms=%lld switches=%lu (%lu/s) dropped_records=%lu",
+             (long long)(window_us / 1000),
+             (unsigned long)total_switches,
+             (unsigned long)(((int64_t)total_switches * 1000000) / window_us),
+             (unsigned long)dropped);
+
+    for (uint32_t i = 0; i < s_task_count; i++)
+    {
+        const profiler_task_stats_t *stats = &s_tasks[order[i]];
+
+        if ((stats->run_us == 0) && (stats->switches_in == 0U))
+        {
+            continue;
+        }
+
+        ESP_LOGI(TAG,
+                 "  %-16s cpu=%5.1f%% switches/s=%5lu preempted=%lu voluntary=%lu",
+                 stats->name,
+                 (double)stats->run_us * 100.0 / (double)window_us,
+                 (unsigned long)(((int64_t)stats->switches_in * 1000000) / window_us),
+                 (unsigned long)stats->preempted,
+                 (unsigned long)stats->voluntary);
+    }
+
+    for (uint32_t core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        const profiler_core_window_t *window = &s_cores[core];
+
+        ESP_LOGI(TAG,
+                 "  isr core%lu cpu=%5.2f%% count=%lu",
+                 (unsigned long)core,
+                 (double)window->isr_us * 100.0 / (double)window_us,
+                 (unsigned long)window->isr_count);
+    }
+
+    // Start the next window; tasks keep their table slots
+    for (uint32_t i = 0; i < s_task_count; i++)
+    {
+        s_tasks[i].run_us = 0;
+        s_tasks[i].switches_in = 0U;
+        s_tasks[i].preempted = 0U;
+        s_tasks[i].voluntary = 0U;
+    }
+
+    for (uint32_t core = 0; core < portNUM_PROCESSORS; core++)
+    {
+        s_cores[core].isr_us = 0;
+        s_cores[core].isr_count = 0U;
+    }
+
+    s_untracked_switches = 0U;
+    s_window_start_us = now_us;
+}
+
+#endif
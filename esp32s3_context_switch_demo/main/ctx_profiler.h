@@ -0,0 +1,90 @@
+/**
+ * @file ctx_profiler.h
+ * @brief On-target context-switch and CPU-time profiler built on FreeRTOS trace hooks.
+ *
+ * The trace hooks write one record per context switch, and per instrumented
+ * ISR entry and exit, into a ring owned by the core they run on. A single
+ * reader task drains the rings with ctx_profiler_collect() and turns the
+ * records into per-task CPU time, switch counts, preemptions and voluntary
+ * yields, plus per-core ISR time, which ctx_profiler_report() logs.
+ */
+
+#pragma once
+
+#include "sdkconfig.h"
+
+#if CONFIG_DEMO_PROFILER_ENABLE
+
+/**
+ * @brief Starts a new measurement window.
+ *
+ * Args:
+ *     None.
+ *
+ * Returns:
+ *     None.
+ */
+void ctx_profiler_init(void);
+
+/**
+ * @brief Marks the start of an instrumented interrupt handler.
+ *
+ * Time until the matching ctx_profiler_isr_exit() is charged to the core's
+ * ISR time instead of the interrupted task.
+ *
+ * Args:
+ *     None.
+ *
+ * Returns:
+ *     None.
+ */
+void ctx_profiler_isr_enter(void);
+
+/**
+ * @brief Marks the end of an instrumented interrupt handler.
+ *
+ * Args:
+ *     None.
+ *
+ * Returns:
+ *     None.
+ */
+void ctx_profiler_isr_exit(void);
+
+/**
+ * @brief Drains the per-core rings into the statistics of the current window.
+ *
+ * Must be called often enough that the rings do not overflow, and always
+ * from the same task.
+ *
+ * Args:
+ *     None.
+ *
+ * Returns:
+ *     None.
+ */
+void ctx_profiler_collect(void);
+
+/**
+ * @brief Logs the statistics of the current window and starts a new one.
+ *
+ * Tasks are listed by switch rate, highest first. Call from the task that
+ * calls ctx_profiler_collect().
+ *
+ * Args:
+ *     None.
+ *
+ * Returns:
+ *     None.
+ */
+void ctx_profiler_report(void);
+
+#else
+
+static inline void ctx_profiler_init(void) {}
+static inline void ctx_profiler_isr_enter(void) {}
+static inline void ctx_profiler_isr_exit(void) {}
+static inline void ctx_profiler_collect(void) {}
+static inline void ctx_profiler_report(void) {}
+
+#endif
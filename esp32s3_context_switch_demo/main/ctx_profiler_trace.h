@@ -0,0 +1,42 @@
+/**
+ * @file ctx_profiler_trace.h
+ * @brief FreeRTOS trace hook definitions for the context-switch profiler.
+ *
+ * The top-level CMakeLists.txt force-includes this header into every C file of
+ * the build, so the macros are defined before the FreeRTOS kernel sees its
+ * empty defaults. It must therefore not include any FreeRTOS header itself.
+ */
+
+#pragma once
+
+#include "sdkconfig.h"
+
+#if CONFIG_DEMO_PROFILER_ENABLE
+
+#if CONFIG_APPTRACE_SV_ENABLE
+#error "The context-switch profiler and SystemView both define the FreeRTOS trace hooks"
+#endif
+
+void ctx_profiler_trace_switched_out(void);
+void ctx_profiler_trace_switched_in(void);
+void ctx_profiler_trace_block(void);
+void ctx_profiler_trace_suspend(void *task);
+
+#define traceTASK_SWITCHED_OUT()                    ctx_profiler_trace_switched_out()
+#define traceTASK_SWITCHED_IN()                     ctx_profiler_trace_switched_in()
+
+/* Every path on which the running task gives up the CPU by waiting */
+#define traceTASK_DELAY()                           ctx_profiler_trace_block()
+#define traceTASK_DELAY_UNTIL(...)                  ctx_profiler_trace_block()
+#define traceBLOCKING_ON_QUEUE_RECEIVE(...)         ctx_profiler_trace_block()
+#define traceBLOCKING_ON_QUEUE_SEND(...)            ctx_profiler_trace_block()
+#define traceBLOCKING_ON_QUEUE_PEEK(...)            ctx_profiler_trace_block()
+#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE(...) ctx_profiler_trace_block()
+#define traceBLOCKING_ON_STREAM_BUFFER_SEND(...)    ctx_profiler_trace_block()
+#define traceTASK_NOTIFY_TAKE_BLOCK(...)            ctx_profiler_trace_block()
+#define traceTASK_NOTIFY_WAIT_BLOCK(...)            ctx_profiler_trace_block()
+#define traceEVENT_GROUP_WAIT_BITS_BLOCK(...)       ctx_profiler_trace_block()
+#define traceEVENT_GROUP_SYNC_BLOCK(...)            ctx_profiler_trace_block()
+#define traceTASK_SUSPEND(task)                     ctx_profiler_trace_suspend(task)
+
+#endif
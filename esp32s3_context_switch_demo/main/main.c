@@ -2,6 +2,7 @@
 #include <stdbool.h>
 #include <string.h>
 
+#include "ctx_profiler.h"
 #include "driver/gpio.h"
 #include "driver/gptimer.h"
 #include "esp_check.h"
@@ -28,6 +29,13 @@
 #define EVENT_QUEUE_LENGTH 16
 #define CPU_WORK_ITERATIONS 350U
 
+#define MONITOR_REPORT_PERIOD_MS 5000U
+#if CONFIG_DEMO_PROFILER_ENABLE
+#define MONITOR_POLL_PERIOD_MS   CONFIG_DEMO_PROFILER_DRAIN_MS
+#else
+#define MONITOR_POLL_PERIOD_MS   MONITOR_REPORT_PERIOD_MS
+#endif
+
 static const char *TAG = "ctx_switch_demo";
 
 typedef enum
@@ -215,11 +223,15 @@ static bool IRAM_ATTR control_timer_callback(gptimer_handle_t timer,
     (void)edata;
     (void)user_ctx;
 
+    ctx_profiler_isr_enter();
+
     if (g_control_task_handle != NULL)
     {
         vTaskNotifyGiveFromISR(g_control_task_handle, &higher_priority_task_woken);
     }
 
+    ctx_profiler_isr_exit();
+
     return higher_priority_task_woken == pdTRUE;
 }
 
@@ -399,7 +411,10 @@ static void logger_task(void *argument)
 }
 
 /**
- * @brief Prints FreeRTOS stack high-water marks for the demo tasks.
+ * @brief Prints FreeRTOS stack high-water marks and the context-switch profile.
+ *
+ * Between reports the task wakes every MONITOR_POLL_PERIOD_MS to drain the
+ * profiler rings. Those wakes show up in the profile as well.
  *
  * Args:
  *     argument: Optional task argument, unused by this task.
@@ -409,11 +424,22 @@ static void logger_task(void *argument)
  */
 static void monitor_task(void *argument)
 {
+    TickType_t last_report = xTaskGetTickCount();
+
     (void)argument;
 
     while (true)
     {
-        vTaskDelay(pdMS_TO_TICKS(5000));
+        vTaskDelay(pdMS_TO_TICKS(MONITOR_POLL_PERIOD_MS));
+
+        ctx_profiler_collect();
+
+        if ((xTaskGetTickCount() - last_report) < pdMS_TO_TICKS(MONITOR_REPORT_PERIOD_MS))
+        {
+            continue;
+        }
+
+        last_report = xTaskGetTickCount();
 
         log_lock();
         ESP_LOGI(TAG,
@@ -423,6 +449,7 @@ static void monitor_task(void *argument)
                  (unsigned int)uxTaskGetStackHighWaterMark(g_logger_task_handle),
                  (unsigned int)uxTaskGetStackHighWaterMark(g_monitor_task_handle),
                  (unsigned int)uxTaskGetStackHighWaterMark(g_background_task_handle));
+        ctx_profiler_report();
         log_unlock();
     }
 }
@@ -538,6 +565,9 @@ void app_main(void)
     // Configure GPIO pins used for task execution tracing
     ESP_ERROR_CHECK(configure_trace_gpio());
     
+    // Start the first profiling window before the demo tasks run
+    ctx_profiler_init();
+
     // Create FreeRTOS synchronization objects (queue and mutex)
     ESP_ERROR_CHECK(create_rtos_objects());
     
@@ -0,0 +1,70 @@
+/**
+ * @file arena.c
+ * @brief Bump-pointer scratch arena implementation.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.0.0
+ * @date    2025
+ */
+
+#include "arena.h"
+
+#include <string.h>
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_memory_utils.h"
+
+static const char *TAG = "ARENA";
+
+esp_err_t arena_init(arena_t *arena, const arena_config_t *cfg)
+{
+    memset(arena, 0, sizeof(*arena));
+    if (cfg->size == 0) return ESP_ERR_INVALID_ARG;
+
+    arena->base = heap_caps_aligned_alloc(ARENA_ALIGNMENT, cfg->size, cfg->caps);
+    if (!arena->base && cfg->fallback_caps) {
+        arena->base = heap_caps_aligned_alloc(ARENA_ALIGNMENT, cfg->size, cfg->fallback_caps);
+    }
+    if (!arena->base) {
+        ESP_LOGE(TAG, "No memory for a %u-byte arena", (unsigned)cfg->size);
+        return ESP_ERR_NO_MEM;
+    }
+
+    arena->size   = cfg->size;
+    arena->spiram = esp_ptr_external_ram(arena->base);
+    ESP_LOGI(TAG, "%u-byte arena in %s", (unsigned)arena->size,
+             arena->spiram ? "PSRAM" : "internal RAM");
+    return ESP_OK;
+}
+
+void arena_deinit(arena_t *arena)
+{
+    heap_caps_free(arena->base);
+    memset(arena, 0, sizeof(*arena));
+}
+
+void *arena_alloc(arena_t *arena, size_t size)
+{
+    if (!arena->base) return NULL;
+
+    /* base is ARENA_ALIGNMENT-aligned, so aligning the offset is enough */
+    const size_t start = (arena->used + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    if (start > arena->size || size > arena->size - start) {
+        arena->failures++;
+        return NULL;
+    }
+
+    arena->used = start + size;
+    if (arena->used > arena->peak) arena->peak = arena->used;
+    return arena->base + start;
+}
+
+void arena_reset(arena_t *arena)
+{
+    arena->used = 0;
+}
+
+size_t arena_peak(const arena_t *arena)
+{
+    return arena->peak;
+}
@@ -0,0 +1,111 @@
+/**
+ * @file arena.h
+ * @brief Bump-pointer scratch arena for per-request / per-operation buffers.
+ *
+ * One block is reserved up front and never returned to the heap while the
+ * arena lives.  Allocations advance a pointer inside the block and are
+ * never freed one by one; arena_reset() releases all of them at once when
+ * the request or operation finishes.  Short-lived buffers therefore stop
+ * cycling through malloc()/free(), and the long-running heap stays flat
+ * instead of fragmenting over days of traffic.
+ *
+ * The block can be placed in PSRAM with an internal-RAM fallback.  The
+ * high-water mark is tracked so the block size can be tuned from the field.
+ *
+ * An arena is not thread-safe: give each task (or each serialised
+ * context, such as the httpd task) its own.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.0.0
+ * @date    2025
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ── Constants ────────────────────────────────────────────────────── */
+
+/** Alignment of every allocation, in bytes. */
+#define ARENA_ALIGNMENT 8
+
+/* ── Types ────────────────────────────────────────────────────────── */
+
+/** @brief Arena configuration supplied by the owner. */
+typedef struct {
+    size_t   size;          /**< Block size in bytes                          */
+    uint32_t caps;          /**< Preferred heap caps, e.g. MALLOC_CAP_SPIRAM  */
+    uint32_t fallback_caps; /**< Caps tried when @c caps fails; 0 = none       */
+} arena_config_t;
+
+/** @brief Arena state; treat as opaque and use the functions below. */
+typedef struct {
+    uint8_t *base;      /**< Start of the block, NULL when not initialised */
+    size_t   size;      /**< Block size in bytes                           */
+    size_t   used;      /**< Bytes handed out since the last reset         */
+    size_t   peak;      /**< Highest @c used seen since init               */
+    uint32_t failures;  /**< Allocations refused because the block was full */
+    bool     spiram;    /**< Block lives in PSRAM                          */
+} arena_t;
+
+/* ── API ──────────────────────────────────────────────────────────── */
+
+/**
+ * @brief Reserve the arena block.
+ *
+ * @param[out] arena Arena to initialise.
+ * @param[in]  cfg   Size and memory placement.
+ * @return ESP_OK on success; ESP_ERR_INVALID_ARG for a zero size;
+ *         ESP_ERR_NO_MEM when neither caps could satisfy the request.
+ */
+esp_err_t arena_init(arena_t *arena, const arena_config_t *cfg);
+
+/**
+ * @brief Return the block to the heap.  Safe on an uninitialised arena.
+ *
+ * @param[in,out] arena Arena to release.
+ */
+void arena_deinit(arena_t *arena);
+
+/**
+ * @brief Take @p size bytes from the arena.
+ *
+ * The memory is not zeroed and stays valid until the next arena_reset().
+ *
+ * @param[in,out] arena Arena to allocate from.
+ * @param[in]     size  Bytes requested.
+ * @return ARENA_ALIGNMENT-aligned pointer; NULL when the block is full or
+ *         the arena is not initialised.
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/**
+ * @brief Release every allocation at once.
+ *
+ * Contents are left in place; wipe secrets before resetting.
+ *
+ * @param[in,out] arena Arena to reset.
+ */
+void arena_reset(arena_t *arena);
+
+/**
+ * @brief Highest number of bytes in use at once since arena_init().
+ *
+ * @param[in] arena Arena to query.
+ * @return Peak usage in bytes.
+ */
+size_t arena_peak(const arena_t *arena);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ARENA_H */
@@ -16,6 +16,7 @@
  */
 
 #include "hx711.h"
+#include "hx711_stream.h"
 
 #include <string.h>
 #include <inttypes.h>
@@ -59,8 +60,9 @@ esp_err_t hx711_init(hx711_dev_t *dev, const hx711_config_t *cfg)
     }
 
     memcpy(&dev->cfg, cfg, sizeof(hx711_config_t));
-    dev->tare  = 0;
-    dev->scale = 1.0f;
+    dev->tare   = 0;
+    dev->scale  = 1.0f;
+    dev->stream = NULL;
 
     gpio_config_t sck_conf = {
         .pin_bit_mask = (1ULL << cfg->sck_pin),
@@ -127,6 +129,12 @@ esp_err_t hx711_wait_ready(const hx711_dev_t *dev)
  */
 esp_err_t hx711_read_raw(hx711_dev_t *dev, int32_t *raw)
 {
+    if (dev->stream) {
+        size_t count = 0;
+        return hx711_stream_read(dev, raw, 1,
+                                 pdMS_TO_TICKS(HX711_READY_TIMEOUT_MS), &count);
+    }
+
     esp_err_t err = hx711_wait_ready(dev);
     if (err != ESP_OK) return err;
 
@@ -218,6 +226,15 @@ esp_err_t hx711_get_scale(const hx711_dev_t *dev, float *scale)
     return ESP_OK;
 }
 
+/**
+ * @brief Convert a raw (or averaged raw) sample to grams.
+ */
+esp_err_t hx711_raw_to_weight(const hx711_dev_t *dev, int32_t raw, float *grams)
+{
+    *grams = (float)(raw - dev->tare) / dev->scale;
+    return ESP_OK;
+}
+
 /**
  * @brief Read calibrated weight in grams.
  */
@@ -227,7 +244,7 @@ esp_err_t hx711_get_weight(hx711_dev_t *dev, uint8_t samples, float *grams)
     esp_err_t err = hx711_read_average(dev, samples, &avg);
     if (err != ESP_OK) return err;
 
-    *grams = (float)(avg - dev->tare) / dev->scale;
+    hx711_raw_to_weight(dev, avg, grams);
     ESP_LOGD(TAG, "weight=%.2f g (avg=%" PRId32 " tare=%" PRId32 " scale=%.4f)",
              *grams, avg, dev->tare, dev->scale);
     return ESP_OK;
@@ -238,6 +255,8 @@ esp_err_t hx711_get_weight(hx711_dev_t *dev, uint8_t samples, float *grams)
  */
 esp_err_t hx711_power_down(hx711_dev_t *dev)
 {
+    if (dev->stream) return ESP_ERR_INVALID_STATE;
+
     gpio_set_level(dev->cfg.sck_pin, 0);
     gpio_set_level(dev->cfg.sck_pin, 1);
     ets_delay_us(65);
@@ -250,6 +269,8 @@ esp_err_t hx711_power_down(hx711_dev_t *dev)
  */
 esp_err_t hx711_power_up(hx711_dev_t *dev)
 {
+    if (dev->stream) return ESP_ERR_INVALID_STATE;
+
     gpio_set_level(dev->cfg.sck_pin, 0);
     ESP_LOGI(TAG, "Power up – wait 400 ms before first read");
     return ESP_OK;
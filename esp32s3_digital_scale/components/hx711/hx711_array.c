@@ -0,0 +1,275 @@
+/**
+ * @file hx711_array.c
+ * @brief Shared-SCK HX711 array driver using ESP32-S3 dedicated GPIO.
+ *
+ * The clock sequence is the polled hx711_read_raw() sequence, but SCK is
+ * written and all DOUT pins are sampled through dedicated-GPIO bundles.
+ * Inside the critical section only the raw input word of each bit is
+ * stored; it is transposed into per-channel values after interrupts are
+ * re-enabled, so the section is no longer than for a single device.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.1.0
+ * @date    2025
+ */
+
+#include "hx711_array.h"
+
+#include <string.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "rom/ets_sys.h"
+
+static const char *TAG = "HX711_ARRAY";
+
+/** Number of data bits per conversion. */
+#define HX711_DATA_BITS 24
+
+/* ── Private helpers ──────────────────────────────────────────────── */
+
+/**
+ * @brief Issue one shared SCK pulse and sample every DOUT pin.
+ *
+ * @param[in] arr Initialised array state.
+ * @return DOUT levels, bit i = channel i.
+ */
+static IRAM_ATTR uint32_t hx711_array_clock_pulse(const hx711_array_t *arr)
+{
+    dedic_gpio_bundle_write(arr->sck_bundle, 1, 1);
+    ets_delay_us(1);
+    uint32_t levels = dedic_gpio_bundle_read_in(arr->dout_bundle);
+    dedic_gpio_bundle_write(arr->sck_bundle, 1, 0);
+    ets_delay_us(1);
+    return levels;
+}
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+/**
+ * @brief Initialise an HX711 array and synchronise its converters.
+ */
+esp_err_t hx711_array_init(hx711_array_t *arr, const hx711_array_config_t *cfg)
+{
+    if (!arr || !cfg || cfg->channel_count == 0 ||
+        cfg->channel_count > HX711_ARRAY_MAX_CHANNELS) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(arr, 0, sizeof(*arr));
+    memcpy(&arr->cfg, cfg, sizeof(hx711_array_config_t));
+    for (size_t ch = 0; ch < cfg->channel_count; ch++) {
+        arr->scale[ch] = 1.0f;
+    }
+
+    const int sck_gpio[1] = { cfg->sck_pin };
+    dedic_gpio_bundle_config_t sck_conf = {
+        .gpio_array = sck_gpio,
+        .array_size = 1,
+        .flags = {
+            .out_en = 1,
+        },
+    };
+    esp_err_t err = dedic_gpio_new_bundle(&sck_conf, &arr->sck_bundle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "SCK bundle failed: %s", esp_err_to_name(err));
+        return err;
+    }
+    dedic_gpio_bundle_write(arr->sck_bundle, 1, 0);
+
+    int dout_gpio[HX711_ARRAY_MAX_CHANNELS];
+    uint64_t dout_mask = 0;
+    for (size_t ch = 0; ch < cfg->channel_count; ch++) {
+        dout_gpio[ch] = cfg->dout_pins[ch];
+        dout_mask |= 1ULL << cfg->dout_pins[ch];
+    }
+
+    gpio_config_t dout_conf = {
+        .pin_bit_mask = dout_mask,
+        .mode         = GPIO_MODE_INPUT,
+        .pull_up_en   = GPIO_PULLUP_DISABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type    = GPIO_INTR_DISABLE,
+    };
+    err = gpio_config(&dout_conf);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "DOUT gpio_config failed: %s", esp_err_to_name(err));
+        dedic_gpio_del_bundle(arr->sck_bundle);
+        return err;
+    }
+
+    dedic_gpio_bundle_config_t dout_bundle_conf = {
+        .gpio_array = dout_gpio,
+        .array_size = cfg->channel_count,
+        .flags = {
+            .in_en = 1,
+        },
+    };
+    err = dedic_gpio_new_bundle(&dout_bundle_conf, &arr->dout_bundle);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "DOUT bundle failed: %s", esp_err_to_name(err));
+        dedic_gpio_del_bundle(arr->sck_bundle);
+        return err;
+    }
+
+    /* Power-cycle all converters together so their conversions align. */
+    dedic_gpio_bundle_write(arr->sck_bundle, 1, 1);
+    ets_delay_us(65);
+    dedic_gpio_bundle_write(arr->sck_bundle, 1, 0);
+
+    ESP_LOGI(TAG, "Init OK – %u channels  SCK:GPIO%d  gain:%d",
+             (unsigned)cfg->channel_count, cfg->sck_pin, (int)cfg->gain);
+    return ESP_OK;
+}
+
+/**
+ * @brief Release the dedicated-GPIO bundles.
+ */
+esp_err_t hx711_array_deinit(hx711_array_t *arr)
+{
+    if (arr->dout_bundle) dedic_gpio_del_bundle(arr->dout_bundle);
+    if (arr->sck_bundle)  dedic_gpio_del_bundle(arr->sck_bundle);
+    arr->dout_bundle = NULL;
+    arr->sck_bundle  = NULL;
+    return ESP_OK;
+}
+
+/**
+ * @brief Block until every channel reports data ready (all DOUT LOW).
+ */
+esp_err_t hx711_array_wait_ready(const hx711_array_t *arr)
+{
+    const int64_t deadline = esp_timer_get_time()
+                             + (int64_t)HX711_READY_TIMEOUT_MS * 1000LL;
+
+    while (esp_timer_get_time() < deadline) {
+        if (dedic_gpio_bundle_read_in(arr->dout_bundle) == 0) return ESP_OK;
+        vTaskDelay(pdMS_TO_TICKS(HX711_READY_POLL_DELAY_MS));
+    }
+
+    ESP_LOGW(TAG, "Timeout waiting for all channels ready (DOUT=0x%02" PRIx32 ")",
+             dedic_gpio_bundle_read_in(arr->dout_bundle));
+    return ESP_ERR_TIMEOUT;
+}
+
+/**
+ * @brief Read one raw sample from every channel in a single clock sequence.
+ */
+esp_err_t hx711_array_read_raw(hx711_array_t *arr, int32_t *raw)
+{
+    esp_err_t err = hx711_array_wait_ready(arr);
+    if (err != ESP_OK) return err;
+
+    uint8_t levels[HX711_DATA_BITS];
+
+    portDISABLE_INTERRUPTS();
+
+    for (int i = 0; i < HX711_DATA_BITS; i++) {
+        levels[i] = (uint8_t)hx711_array_clock_pulse(arr);
+    }
+
+    /* Gain-select pulses */
+    for (int i = 0; i < (int)arr->cfg.gain; i++) {
+        hx711_array_clock_pulse(arr);
+    }
+
+    portENABLE_INTERRUPTS();
+
+    /* Transpose: bit i of levels[b] is bit (23 − b) of channel i. */
+    for (size_t ch = 0; ch < arr->cfg.channel_count; ch++) {
+        uint32_t data = 0;
+        for (int i = 0; i < HX711_DATA_BITS; i++) {
+            data = (data << 1) | ((levels[i] >> ch) & 1U);
+        }
+        if (data & 0x800000U) data |= 0xFF000000U;
+        raw[ch] = (int32_t)data;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Average @p samples simultaneous readouts per channel.
+ */
+esp_err_t hx711_array_read_average(hx711_array_t *arr, uint8_t samples,
+                                   int32_t *avg)
+{
+    if (samples == 0 || samples > HX711_MAX_SAMPLES) return ESP_ERR_INVALID_ARG;
+
+    int64_t sum[HX711_ARRAY_MAX_CHANNELS] = { 0 };
+    int     count = 0;
+
+    for (uint8_t i = 0; i < samples; i++) {
+        int32_t raw[HX711_ARRAY_MAX_CHANNELS];
+        if (hx711_array_read_raw(arr, raw) == ESP_OK) {
+            for (size_t ch = 0; ch < arr->cfg.channel_count; ch++) {
+                sum[ch] += raw[ch];
+            }
+            count++;
+        }
+    }
+
+    if (count == 0) {
+        ESP_LOGE(TAG, "hx711_array_read_average: no valid samples");
+        return ESP_FAIL;
+    }
+
+    for (size_t ch = 0; ch < arr->cfg.channel_count; ch++) {
+        avg[ch] = (int32_t)(sum[ch] / count);
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Capture the zero-weight offset of every channel.
+ */
+esp_err_t hx711_array_tare(hx711_array_t *arr, uint8_t samples)
+{
+    int32_t avg[HX711_ARRAY_MAX_CHANNELS];
+    esp_err_t err = hx711_array_read_average(arr, samples, avg);
+    if (err != ESP_OK) return err;
+
+    for (size_t ch = 0; ch < arr->cfg.channel_count; ch++) {
+        arr->tare[ch] = avg[ch];
+        ESP_LOGI(TAG, "Tare[%u]=%" PRId32, (unsigned)ch, arr->tare[ch]);
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Set the scale factor of one channel (raw counts per gram).
+ */
+esp_err_t hx711_array_set_scale(hx711_array_t *arr, size_t channel, float scale)
+{
+    if (channel >= arr->cfg.channel_count || scale == 0.0f) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    arr->scale[channel] = scale;
+    ESP_LOGI(TAG, "Scale[%u]=%.4f", (unsigned)channel, scale);
+    return ESP_OK;
+}
+
+/**
+ * @brief Read calibrated per-channel and total weight in grams.
+ */
+esp_err_t hx711_array_get_weights(hx711_array_t *arr, uint8_t samples,
+                                  float *grams, float *total_g)
+{
+    int32_t avg[HX711_ARRAY_MAX_CHANNELS];
+    esp_err_t err = hx711_array_read_average(arr, samples, avg);
+    if (err != ESP_OK) return err;
+
+    float total = 0.0f;
+    for (size_t ch = 0; ch < arr->cfg.channel_count; ch++) {
+        const float g = (float)(avg[ch] - arr->tare[ch]) / arr->scale[ch];
+        if (grams) grams[ch] = g;
+        total += g;
+    }
+    if (total_g) *total_g = total;
+
+    ESP_LOGD(TAG, "total=%.2f g over %u channels", total,
+             (unsigned)arr->cfg.channel_count);
+    return ESP_OK;
+}
@@ -0,0 +1,362 @@
+/**
+ * @file hx711_stream.c
+ * @brief Interrupt-driven, SPI-clocked HX711 acquisition for ESP32-S3.
+ *
+ * The HX711 signals "data ready" by pulling DOUT LOW.  A negative-edge
+ * GPIO interrupt wakes the acquisition task, which disables the edge
+ * interrupt (DOUT toggles with every data bit), clocks out 24 + gain bits
+ * in one SPI transaction, queues the sample, and re-arms the interrupt.
+ * After the last gain pulse DOUT stays HIGH until the next conversion,
+ * so re-arming immediately after the readout cannot miss a ready edge.
+ *
+ * SPI mode 1 (CPOL 0, CPHA 1) matches the HX711 protocol: SCK idles
+ * LOW, DOUT changes after the rising edge and is sampled on the falling
+ * edge.  SCK never stays HIGH long enough (> 60 µs) to trigger
+ * power-down.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.1.0
+ * @date    2025
+ */
+
+#include "hx711_stream.h"
+
+#include <stdlib.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "esp_log.h"
+
+static const char *TAG = "HX711_STREAM";
+
+/** Number of data bits per conversion. */
+#define HX711_DATA_BITS 24
+
+/** @brief Stream-mode state attached to hx711_dev_t::stream. */
+struct hx711_stream {
+    hx711_dev_t         *dev;      /**< Owning device                     */
+    spi_host_device_t    host;     /**< SPI host clocking the HX711       */
+    spi_device_handle_t  spi;      /**< SPI device on @ref host           */
+    QueueHandle_t        ring;     /**< Sample ring (int32_t items)       */
+    TaskHandle_t         task;     /**< Acquisition task                  */
+    SemaphoreHandle_t    stopped;  /**< Given when the task has exited    */
+    volatile bool        running;  /**< Cleared to request task exit      */
+    volatile uint32_t    samples;  /**< See hx711_stream_stats_t          */
+    volatile uint32_t    overflows;
+    volatile uint32_t    timeouts;
+};
+
+/* ── Private helpers ──────────────────────────────────────────────── */
+
+/**
+ * @brief DOUT falling-edge ISR: conversion ready, wake the reader.
+ *
+ * @param[in] arg Stream state.
+ */
+static void hx711_stream_dout_isr(void *arg)
+{
+    struct hx711_stream *s = (struct hx711_stream *)arg;
+    BaseType_t woken = pdFALSE;
+
+    /* DOUT toggles during the readout; the task re-arms afterwards. */
+    gpio_intr_disable(s->dev->cfg.dout_pin);
+    vTaskNotifyGiveFromISR(s->task, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+/**
+ * @brief Clock one conversion out of the HX711 with the SPI peripheral.
+ *
+ * @param[in]  s   Stream state.
+ * @param[out] raw Sign-extended sample.
+ * @return ESP_OK on success; SPI driver error otherwise.
+ */
+static esp_err_t hx711_stream_readout(struct hx711_stream *s, int32_t *raw)
+{
+    const size_t bits = HX711_DATA_BITS + (size_t)s->dev->cfg.gain;
+    spi_transaction_t t = {
+        .flags    = SPI_TRANS_USE_RXDATA,
+        .length   = bits,
+        .rxlength = bits,
+    };
+
+    esp_err_t err = spi_device_polling_transmit(s->spi, &t);
+    if (err != ESP_OK) return err;
+
+    /* MSB first; bits past the 24th are the gain-select pulses. */
+    uint32_t data = ((uint32_t)t.rx_data[0] << 16) |
+                    ((uint32_t)t.rx_data[1] << 8)  |
+                    (uint32_t)t.rx_data[2];
+    if (data & 0x800000U) data |= 0xFF000000U;
+    *raw = (int32_t)data;
+    return ESP_OK;
+}
+
+/**
+ * @brief Store a sample, discarding the oldest one when the ring is full.
+ *
+ * @param[in] s   Stream state.
+ * @param[in] raw Sample to store.
+ */
+static void hx711_stream_push(struct hx711_stream *s, int32_t raw)
+{
+    if (xQueueSend(s->ring, &raw, 0) != pdTRUE) {
+        int32_t discarded;
+        xQueueReceive(s->ring, &discarded, 0);
+        xQueueSend(s->ring, &raw, 0);
+        s->overflows++;
+    }
+    s->samples++;
+}
+
+/**
+ * @brief Acquisition task: one SPI readout per DOUT ready edge.
+ *
+ * A missed edge cannot stall the stream: after HX711_READY_TIMEOUT_MS
+ * the task checks the DOUT level and reads anyway if it is LOW.
+ *
+ * @param[in] pvParam Stream state.
+ */
+static void hx711_stream_task(void *pvParam)
+{
+    struct hx711_stream *s = (struct hx711_stream *)pvParam;
+    const gpio_num_t dout = s->dev->cfg.dout_pin;
+
+    gpio_intr_enable(dout);
+
+    while (s->running) {
+        uint32_t woken = ulTaskNotifyTake(pdTRUE,
+                                          pdMS_TO_TICKS(HX711_READY_TIMEOUT_MS));
+        if (!s->running) break;
+
+        if (woken == 0 && gpio_get_level(dout) != 0) {
+            s->timeouts++;
+            ESP_LOGW(TAG, "Timeout waiting for HX711 ready");
+            continue;
+        }
+
+        int32_t raw = 0;
+        esp_err_t err = hx711_stream_readout(s, &raw);
+        gpio_intr_enable(dout);
+
+        if (err == ESP_OK) {
+            hx711_stream_push(s, raw);
+        } else {
+            ESP_LOGW(TAG, "SPI readout failed: %s", esp_err_to_name(err));
+        }
+    }
+
+    gpio_intr_disable(dout);
+    xSemaphoreGive(s->stopped);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Release every resource held by a (possibly partial) stream.
+ *
+ * @param[in] s Stream state; freed on return.
+ */
+static void hx711_stream_free(struct hx711_stream *s)
+{
+    if (s->spi) {
+        spi_bus_remove_device(s->spi);
+        spi_bus_free(s->host);
+    }
+    if (s->ring)    vQueueDelete(s->ring);
+    if (s->stopped) vSemaphoreDelete(s->stopped);
+    free(s);
+}
+
+/**
+ * @brief Hand SCK and DOUT back to plain GPIO control.
+ *
+ * @param[in] dev Device whose pins are reconfigured.
+ */
+static void hx711_stream_restore_gpio(const hx711_dev_t *dev)
+{
+    gpio_reset_pin(dev->cfg.sck_pin);
+    gpio_set_direction(dev->cfg.sck_pin, GPIO_MODE_OUTPUT);
+    gpio_set_level(dev->cfg.sck_pin, 0);
+
+    gpio_reset_pin(dev->cfg.dout_pin);
+    gpio_set_direction(dev->cfg.dout_pin, GPIO_MODE_INPUT);
+    gpio_set_pull_mode(dev->cfg.dout_pin, GPIO_FLOATING);
+}
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+/**
+ * @brief Switch an initialised HX711 into interrupt-driven stream mode.
+ */
+esp_err_t hx711_stream_start(hx711_dev_t *dev, const hx711_stream_config_t *cfg)
+{
+    if (!dev || !cfg || cfg->depth == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (dev->stream) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    struct hx711_stream *s = calloc(1, sizeof(*s));
+    if (!s) return ESP_ERR_NO_MEM;
+    s->dev  = dev;
+    s->host = cfg->spi_host;
+
+    s->ring    = xQueueCreate(cfg->depth, sizeof(int32_t));
+    s->stopped = xSemaphoreCreateBinary();
+    if (!s->ring || !s->stopped) {
+        hx711_stream_free(s);
+        return ESP_ERR_NO_MEM;
+    }
+
+    spi_bus_config_t bus_cfg = {
+        .mosi_io_num     = -1,
+        .miso_io_num     = dev->cfg.dout_pin,
+        .sclk_io_num     = dev->cfg.sck_pin,
+        .quadwp_io_num   = -1,
+        .quadhd_io_num   = -1,
+        .max_transfer_sz = 4,
+    };
+    esp_err_t err = spi_bus_initialize(s->host, &bus_cfg, SPI_DMA_DISABLED);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "spi_bus_initialize failed: %s", esp_err_to_name(err));
+        hx711_stream_free(s);
+        hx711_stream_restore_gpio(dev);
+        return err;
+    }
+
+    spi_device_interface_config_t dev_cfg = {
+        .mode           = 1,
+        .clock_speed_hz = cfg->clock_hz,
+        .spics_io_num   = -1,
+        .queue_size     = 1,
+    };
+    err = spi_bus_add_device(s->host, &dev_cfg, &s->spi);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "spi_bus_add_device failed: %s", esp_err_to_name(err));
+        spi_bus_free(s->host);
+        hx711_stream_free(s);
+        hx711_stream_restore_gpio(dev);
+        return err;
+    }
+
+    /* The ISR service may already be installed by another component. */
+    err = gpio_install_isr_service(0);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {
+        ESP_LOGE(TAG, "gpio_install_isr_service failed: %s", esp_err_to_name(err));
+        hx711_stream_free(s);
+        hx711_stream_restore_gpio(dev);
+        return err;
+    }
+    gpio_set_intr_type(dev->cfg.dout_pin, GPIO_INTR_NEGEDGE);
+    gpio_intr_disable(dev->cfg.dout_pin);
+
+    s->running = true;
+    if (xTaskCreatePinnedToCore(hx711_stream_task, "hx711_stream",
+                                HX711_STREAM_TASK_STACK, s,
+                                cfg->task_priority, &s->task,
+                                cfg->task_core) != pdPASS) {
+        hx711_stream_free(s);
+        hx711_stream_restore_gpio(dev);
+        return ESP_ERR_NO_MEM;
+    }
+
+    err = gpio_isr_handler_add(dev->cfg.dout_pin, hx711_stream_dout_isr, s);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "gpio_isr_handler_add failed: %s", esp_err_to_name(err));
+        s->running = false;
+        xTaskNotifyGive(s->task);
+        xSemaphoreTake(s->stopped, portMAX_DELAY);
+        hx711_stream_free(s);
+        hx711_stream_restore_gpio(dev);
+        return err;
+    }
+
+    dev->stream = s;
+    /* A conversion may already be pending; DOUT LOW is level-ready. */
+    xTaskNotifyGive(s->task);
+
+    ESP_LOGI(TAG, "Streaming – SPI host %d @ %d Hz, ring %u samples",
+             (int)cfg->spi_host, cfg->clock_hz, (unsigned)cfg->depth);
+    return ESP_OK;
+}
+
+/**
+ * @brief Stop stream mode and return SCK/DOUT to plain GPIO control.
+ */
+esp_err_t hx711_stream_stop(hx711_dev_t *dev)
+{
+    if (!dev || !dev->stream) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    struct hx711_stream *s = dev->stream;
+    dev->stream = NULL;
+
+    gpio_isr_handler_remove(dev->cfg.dout_pin);
+    s->running = false;
+    xTaskNotifyGive(s->task);
+    xSemaphoreTake(s->stopped, portMAX_DELAY);
+
+    hx711_stream_free(s);
+    hx711_stream_restore_gpio(dev);
+
+    ESP_LOGI(TAG, "Stream stopped");
+    return ESP_OK;
+}
+
+/**
+ * @brief Report whether the device is in stream mode.
+ */
+bool hx711_stream_is_running(const hx711_dev_t *dev)
+{
+    return dev && dev->stream;
+}
+
+/**
+ * @brief Drain up to @p max_samples raw samples from the ring.
+ */
+esp_err_t hx711_stream_read(hx711_dev_t *dev, int32_t *raw, size_t max_samples,
+                            TickType_t wait, size_t *count)
+{
+    if (!dev || !dev->stream) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!raw || !count || max_samples == 0) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    struct hx711_stream *s = dev->stream;
+    size_t n = 0;
+
+    if (xQueueReceive(s->ring, &raw[n], wait) == pdTRUE) {
+        n++;
+        while (n < max_samples && xQueueReceive(s->ring, &raw[n], 0) == pdTRUE) {
+            n++;
+        }
+    }
+
+    *count = n;
+    return (n > 0) ? ESP_OK : ESP_ERR_TIMEOUT;
+}
+
+/**
+ * @brief Copy the acquisition counters.
+ */
+esp_err_t hx711_stream_get_stats(const hx711_dev_t *dev,
+                                 hx711_stream_stats_t *stats)
+{
+    if (!dev || !dev->stream) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (!stats) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    stats->samples   = dev->stream->samples;
+    stats->overflows = dev->stream->overflows;
+    stats->timeouts  = dev->stream->timeouts;
+    return ESP_OK;
+}
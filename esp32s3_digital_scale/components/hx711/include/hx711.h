@@ -61,11 +61,15 @@ typedef struct {
     hx711_gain_t gain;     /**< Channel / gain setting        */
 } hx711_config_t;
 
+/** @brief Stream-mode state, see hx711_stream.h. */
+struct hx711_stream;
+
 /** @brief Runtime state for one HX711 device instance. */
 typedef struct {
-    hx711_config_t cfg;   /**< Copy of user-supplied hardware config */
-    int32_t        tare;  /**< Raw ADC offset captured during tare   */
-    float          scale; /**< raw-count-per-gram conversion factor  */
+    hx711_config_t       cfg;    /**< Copy of user-supplied hardware config */
+    int32_t              tare;   /**< Raw ADC offset captured during tare   */
+    float                scale;  /**< raw-count-per-gram conversion factor  */
+    struct hx711_stream *stream; /**< Stream-mode state; NULL when polled   */
 } hx711_dev_t;
 
 /* ── API ──────────────────────────────────────────────────────────── */
@@ -106,7 +110,9 @@ esp_err_t hx711_wait_ready(const hx711_dev_t *dev);
  * @brief Read one raw 24-bit two's-complement sample.
  *
  * Disables interrupts during the 24 + N clock-pulse sequence to prevent
- * timing glitches. The result is sign-extended to int32_t.
+ * timing glitches. The result is sign-extended to int32_t. In stream
+ * mode the oldest queued sample is returned instead, without touching
+ * the bus.
  *
  * @param[in]  dev Initialised device handle.
  * @param[out] raw Sign-extended 32-bit ADC value.
@@ -161,6 +167,18 @@ esp_err_t hx711_set_scale(hx711_dev_t *dev, float scale);
  */
 esp_err_t hx711_get_scale(const hx711_dev_t *dev, float *scale);
 
+/**
+ * @brief Convert a raw (or averaged raw) sample to grams.
+ *
+ * weight_g = (raw − tare) / scale
+ *
+ * @param[in]  dev   Initialised device handle.
+ * @param[in]  raw   Raw ADC value.
+ * @param[out] grams Calculated weight in grams.
+ * @return ESP_OK always.
+ */
+esp_err_t hx711_raw_to_weight(const hx711_dev_t *dev, int32_t raw, float *grams);
+
 /**
  * @brief Read calibrated weight in grams.
  *
@@ -177,7 +195,7 @@ esp_err_t hx711_get_weight(hx711_dev_t *dev, uint8_t samples, float *grams);
  * @brief Power down the HX711 (SCK held HIGH > 60 µs, ≈1 µA standby).
  *
  * @param[in] dev Initialised device handle.
- * @return ESP_OK always.
+ * @return ESP_OK on success; ESP_ERR_INVALID_STATE while streaming.
  */
 esp_err_t hx711_power_down(hx711_dev_t *dev);
 
@@ -187,7 +205,7 @@ esp_err_t hx711_power_down(hx711_dev_t *dev);
  * Allow ~400 ms before the first reliable reading.
  *
  * @param[in] dev Initialised device handle.
- * @return ESP_OK always.
+ * @return ESP_OK on success; ESP_ERR_INVALID_STATE while streaming.
  */
 esp_err_t hx711_power_up(hx711_dev_t *dev);
 
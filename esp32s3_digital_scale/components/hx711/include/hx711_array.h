@@ -0,0 +1,149 @@
+/**
+ * @file hx711_array.h
+ * @brief Simultaneous readout of several HX711 devices sharing one SCK.
+ *
+ * Each load cell gets its own HX711. All PD_SCK inputs are tied to a
+ * single GPIO while every DOUT has its own pin. One 24 + N clock
+ * sequence then reads every channel at once: the ESP32-S3 dedicated-GPIO
+ * bundle drives SCK and samples all DOUT pins with a single CPU
+ * instruction per bit, so the channels are read in one readout instead
+ * of one after another.
+ *
+ * Because SCK is shared, the power-down / power-up cycle performed by
+ * hx711_array_init() restarts every converter at the same instant, which
+ * aligns their conversion phases.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.1.0
+ * @date    2025
+ */
+
+#ifndef HX711_ARRAY_H
+#define HX711_ARRAY_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "driver/gpio.h"
+#include "driver/dedic_gpio.h"
+#include "hx711.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ── Constants ────────────────────────────────────────────────────── */
+
+/** Maximum channels; the S3 offers 8 dedicated-GPIO inputs per core. */
+#define HX711_ARRAY_MAX_CHANNELS 8
+
+/* ── Types ────────────────────────────────────────────────────────── */
+
+/** @brief Hardware configuration of an HX711 array. */
+typedef struct {
+    gpio_num_t   sck_pin;                             /**< Shared PD_SCK GPIO */
+    gpio_num_t   dout_pins[HX711_ARRAY_MAX_CHANNELS]; /**< DOUT GPIO per channel */
+    size_t       channel_count;                       /**< Channels in use (1 – 8) */
+    hx711_gain_t gain;                                /**< Gain for all channels */
+} hx711_array_config_t;
+
+/** @brief Runtime state of an HX711 array. */
+typedef struct {
+    hx711_array_config_t       cfg;                             /**< Copy of config        */
+    int32_t                    tare[HX711_ARRAY_MAX_CHANNELS];  /**< Raw offset per channel */
+    float                      scale[HX711_ARRAY_MAX_CHANNELS]; /**< Counts per gram        */
+    dedic_gpio_bundle_handle_t sck_bundle;                      /**< 1-bit output bundle    */
+    dedic_gpio_bundle_handle_t dout_bundle;                     /**< N-bit input bundle     */
+} hx711_array_t;
+
+/* ── API ──────────────────────────────────────────────────────────── */
+
+/**
+ * @brief Initialise an HX711 array and synchronise its converters.
+ *
+ * Creates the dedicated-GPIO bundles and power-cycles every HX711 through
+ * the shared SCK so all conversions start together. Dedicated GPIO is
+ * per core: call this and every read function from tasks pinned to the
+ * same core.
+ *
+ * @param[out] arr Uninitialised array state.
+ * @param[in]  cfg Pin and gain configuration.
+ * @return ESP_OK on success; ESP_ERR_INVALID_ARG, or GPIO/bundle error.
+ */
+esp_err_t hx711_array_init(hx711_array_t *arr, const hx711_array_config_t *cfg);
+
+/**
+ * @brief Release the dedicated-GPIO bundles.
+ *
+ * @param[in] arr Initialised array state.
+ * @return ESP_OK always.
+ */
+esp_err_t hx711_array_deinit(hx711_array_t *arr);
+
+/**
+ * @brief Block until every channel reports data ready (all DOUT LOW).
+ *
+ * @param[in] arr Initialised array state.
+ * @return ESP_OK when ready; ESP_ERR_TIMEOUT if any channel stays HIGH.
+ */
+esp_err_t hx711_array_wait_ready(const hx711_array_t *arr);
+
+/**
+ * @brief Read one raw sample from every channel in a single clock sequence.
+ *
+ * @param[in]  arr Initialised array state.
+ * @param[out] raw One sign-extended value per channel.
+ * @return ESP_OK on success; ESP_ERR_TIMEOUT if not ready.
+ */
+esp_err_t hx711_array_read_raw(hx711_array_t *arr, int32_t *raw);
+
+/**
+ * @brief Average @p samples simultaneous readouts per channel.
+ *
+ * @param[in]  arr     Initialised array state.
+ * @param[in]  samples Number of readouts (1 – HX711_MAX_SAMPLES).
+ * @param[out] avg     Averaged raw value per channel.
+ * @return ESP_OK on success; ESP_ERR_INVALID_ARG or ESP_FAIL otherwise.
+ */
+esp_err_t hx711_array_read_average(hx711_array_t *arr, uint8_t samples,
+                                   int32_t *avg);
+
+/**
+ * @brief Capture the zero-weight offset of every channel.
+ *
+ * @param[in] arr     Initialised array state.
+ * @param[in] samples Number of readouts to average.
+ * @return ESP_OK on success; propagated error otherwise.
+ */
+esp_err_t hx711_array_tare(hx711_array_t *arr, uint8_t samples);
+
+/**
+ * @brief Set the scale factor of one channel (raw counts per gram).
+ *
+ * Per-channel factors let corner cells with different sensitivity be
+ * trimmed individually.
+ *
+ * @param[in] arr     Initialised array state.
+ * @param[in] channel Channel index.
+ * @param[in] scale   Non-zero conversion factor.
+ * @return ESP_OK on success; ESP_ERR_INVALID_ARG otherwise.
+ */
+esp_err_t hx711_array_set_scale(hx711_array_t *arr, size_t channel, float scale);
+
+/**
+ * @brief Read calibrated per-channel and total weight in grams.
+ *
+ * @param[in]  arr     Initialised array state.
+ * @param[in]  samples Readouts to average.
+ * @param[out] grams   Weight per channel; may be NULL.
+ * @param[out] total_g Sum of all channels; may be NULL.
+ * @return ESP_OK on success; propagated error otherwise.
+ */
+esp_err_t hx711_array_get_weights(hx711_array_t *arr, uint8_t samples,
+                                  float *grams, float *total_g);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_ARRAY_H */
@@ -0,0 +1,128 @@
+/**
+ * @file hx711_stream.h
+ * @brief Interrupt-driven, hardware-clocked HX711 acquisition.
+ *
+ * In stream mode the HX711 is read without busy-waiting:
+ *   1. A falling-edge interrupt on DOUT signals that a conversion is ready.
+ *   2. A dedicated acquisition task clocks the 24 data bits plus the
+ *      gain-select pulses with an SPI master (SCK = SPI CLK, DOUT = MISO),
+ *      so bit timing comes from the peripheral and interrupts stay enabled.
+ *   3. Each sample is pushed into a FreeRTOS queue used as a ring buffer.
+ *
+ * Consumers drain whole batches with hx711_stream_read() and sleep in
+ * between, so the CPU is free while the HX711 converts. While streaming,
+ * hx711_read_raw(), hx711_read_average(), hx711_tare(), and
+ * hx711_get_weight() transparently take their samples from the stream.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.1.0
+ * @date    2025
+ */
+
+#ifndef HX711_STREAM_H
+#define HX711_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+#include "driver/spi_master.h"
+#include "esp_err.h"
+#include "hx711.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ── Constants ────────────────────────────────────────────────────── */
+
+/** Default SCK frequency: 1 µs HIGH / 1 µs LOW, same as the polled path. */
+#define HX711_STREAM_DEFAULT_CLOCK_HZ 500000
+
+/** Stack in bytes for the acquisition task. */
+#define HX711_STREAM_TASK_STACK       3072
+
+/* ── Types ────────────────────────────────────────────────────────── */
+
+/** @brief Stream-mode configuration supplied by the application. */
+typedef struct {
+    spi_host_device_t spi_host;      /**< SPI host that clocks SCK/DOUT     */
+    int               clock_hz;      /**< SCK frequency (20 kHz – 2.5 MHz)  */
+    size_t            depth;         /**< Ring depth in samples             */
+    UBaseType_t       task_priority; /**< Acquisition task priority         */
+    BaseType_t        task_core;     /**< Core for the acquisition task     */
+} hx711_stream_config_t;
+
+/** @brief Acquisition counters, for diagnostics. */
+typedef struct {
+    uint32_t samples;   /**< Conversions read since the stream started     */
+    uint32_t overflows; /**< Oldest samples discarded because ring was full */
+    uint32_t timeouts;  /**< Ready intervals that exceeded the timeout      */
+} hx711_stream_stats_t;
+
+/* ── API ──────────────────────────────────────────────────────────── */
+
+/**
+ * @brief Switch an initialised HX711 into interrupt-driven stream mode.
+ *
+ * Hands SCK and DOUT to the SPI host, installs the DOUT falling-edge
+ * interrupt, and starts the acquisition task. When the ring is full the
+ * oldest sample is discarded so consumers always see the newest data.
+ *
+ * @param[in] dev Initialised device handle.
+ * @param[in] cfg Stream configuration.
+ * @return ESP_OK on success; ESP_ERR_INVALID_ARG, ESP_ERR_INVALID_STATE if
+ *         already streaming, ESP_ERR_NO_MEM, or SPI/GPIO error otherwise.
+ */
+esp_err_t hx711_stream_start(hx711_dev_t *dev, const hx711_stream_config_t *cfg);
+
+/**
+ * @brief Stop stream mode and return SCK/DOUT to plain GPIO control.
+ *
+ * Blocks until the acquisition task has finished its current readout.
+ * Must not be called while another task is blocked in hx711_stream_read().
+ *
+ * @param[in] dev Streaming device handle.
+ * @return ESP_OK on success; ESP_ERR_INVALID_STATE if not streaming.
+ */
+esp_err_t hx711_stream_stop(hx711_dev_t *dev);
+
+/**
+ * @brief Report whether the device is in stream mode.
+ *
+ * @param[in] dev Initialised device handle.
+ * @return true while streaming.
+ */
+bool hx711_stream_is_running(const hx711_dev_t *dev);
+
+/**
+ * @brief Drain up to @p max_samples raw samples from the ring.
+ *
+ * Waits up to @p wait for the first sample, then returns every further
+ * sample already queued without blocking again.
+ *
+ * @param[in]  dev         Streaming device handle.
+ * @param[out] raw         Destination for sign-extended samples, oldest first.
+ * @param[in]  max_samples Capacity of @p raw.
+ * @param[in]  wait        Ticks to wait for the first sample.
+ * @param[out] count       Number of samples written to @p raw.
+ * @return ESP_OK when at least one sample was read; ESP_ERR_TIMEOUT if
+ *         none arrived; ESP_ERR_INVALID_STATE if not streaming.
+ */
+esp_err_t hx711_stream_read(hx711_dev_t *dev, int32_t *raw, size_t max_samples,
+                            TickType_t wait, size_t *count);
+
+/**
+ * @brief Copy the acquisition counters.
+ *
+ * @param[in]  dev   Streaming device handle.
+ * @param[out] stats Counter snapshot.
+ * @return ESP_OK on success; ESP_ERR_INVALID_STATE if not streaming.
+ */
+esp_err_t hx711_stream_get_stats(const hx711_dev_t *dev,
+                                 hx711_stream_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HX711_STREAM_H */
@@ -0,0 +1,115 @@
+/**
+ * @file init_graph.h
+ * @brief Dependency-ordered parallel bring-up of application modules.
+ *
+ * Each module is an init function plus the set of modules it depends on.
+ * init_graph_run() gives every module its own short-lived task, pinned to
+ * the core the module asks for, which blocks on an event group until the
+ * bits of all its dependencies are set, runs the init function and sets
+ * its own bit.  Modules with no path between them therefore initialise
+ * concurrently: a slow Wi-Fi association no longer holds up the load-cell
+ * tare on the other core.
+ *
+ * A module whose dependency failed (or was itself skipped) is not run and
+ * reports ESP_ERR_INVALID_STATE, so a dependent never sees a half-made
+ * subsystem.  Whether a failure is fatal is left to the caller, which
+ * inspects the per-module results after the run.
+ *
+ * Modules must be listed in dependency order: a module may only depend on
+ * modules before it.  That rules out cycles by construction.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.0.0
+ * @date    2025
+ */
+
+#ifndef INIT_GRAPH_H
+#define INIT_GRAPH_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ── Constants ────────────────────────────────────────────────────── */
+
+/** Most modules per graph: one event-group bit each, leaving the 24-bit
+ *  FreeRTOS event group limit. */
+#define INIT_GRAPH_MAX_MODULES   24
+
+/** Stack in bytes given to a module task when the module leaves it 0. */
+#define INIT_GRAPH_DEFAULT_STACK 4096
+
+/** Bit for module @p index in init_graph_module_t::deps. */
+#define INIT_GRAPH_DEP(index)    (1UL << (index))
+
+/* ── Types ────────────────────────────────────────────────────────── */
+
+/**
+ * @brief Module init function.
+ *
+ * @param[in] arg init_graph_module_t::arg.
+ * @return ESP_OK when the module is usable by its dependents.
+ */
+typedef esp_err_t (*init_graph_fn_t)(void *arg);
+
+/** @brief One node of the graph. */
+typedef struct {
+    const char     *name;       /**< Label used in the boot timeline          */
+    init_graph_fn_t fn;         /**< Init function                            */
+    void           *arg;        /**< Passed to @c fn                          */
+    uint32_t        deps;       /**< INIT_GRAPH_DEP() bits of earlier modules */
+    int             core;       /**< Core to run on, or tskNO_AFFINITY        */
+    uint32_t        stack_size; /**< Task stack; 0 = INIT_GRAPH_DEFAULT_STACK */
+} init_graph_module_t;
+
+/** @brief What happened to one module, times relative to the run start. */
+typedef struct {
+    esp_err_t result;   /**< Init result; ESP_ERR_INVALID_STATE if skipped */
+    int       core;     /**< Core the init function started on, -1 if none */
+    int64_t   ready_us; /**< All dependencies done                         */
+    int64_t   start_us; /**< Init function called                          */
+    int64_t   end_us;   /**< Init function returned (or module skipped)    */
+} init_graph_stage_t;
+
+/* ── API ──────────────────────────────────────────────────────────── */
+
+/**
+ * @brief Run every module once its dependencies are done, and wait for all.
+ *
+ * Module tasks run at the priority of the calling task.  Call from a task
+ * (typically app_main), not from an ISR.
+ *
+ * @param[in]  modules Modules in dependency order.
+ * @param[in]  count   Number of modules, at most INIT_GRAPH_MAX_MODULES.
+ * @param[out] stages  @p count entries, filled in for every module even
+ *                     when nothing is run.
+ * @return ESP_OK when every module succeeded; ESP_ERR_INVALID_ARG for a
+ *         bad count or a dependency on a later module (nothing is run);
+ *         ESP_ERR_NO_MEM when a module task cannot be created; otherwise
+ *         the result of the first module, in list order, that failed.
+ */
+esp_err_t init_graph_run(const init_graph_module_t *modules, size_t count,
+                         init_graph_stage_t *stages);
+
+/**
+ * @brief Log the boot timeline of a finished run, one line per module.
+ *
+ * Each line shows when the module became ready, how long it then waited
+ * for a CPU, how long its init took, and on which core it ran.
+ *
+ * @param[in] modules Modules passed to init_graph_run().
+ * @param[in] count   Number of modules.
+ * @param[in] stages  Stages filled in by init_graph_run().
+ */
+void init_graph_log_timeline(const init_graph_module_t *modules, size_t count,
+                             const init_graph_stage_t *stages);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INIT_GRAPH_H */
@@ -0,0 +1,180 @@
+/**
+ * @file init_graph.c
+ * @brief Dependency-ordered parallel bring-up implementation.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.0.0
+ * @date    2025
+ */
+
+#include "init_graph.h"
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/event_groups.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "INIT_GRAPH";
+
+/* ── Run state (lives on the caller's stack for one run) ──────────── */
+
+typedef struct run run_t;
+
+typedef struct {
+    run_t *run;
+    size_t index;
+} module_slot_t;
+
+struct run {
+    const init_graph_module_t *modules;
+    init_graph_stage_t        *stages;
+    EventGroupHandle_t         done;      /* bit i: module i finished    */
+    uint32_t                   failed;    /* bit i: module i not usable  */
+    TaskHandle_t               caller;    /* notified once per module    */
+    int64_t                    t0_us;
+    module_slot_t              slots[INIT_GRAPH_MAX_MODULES];
+};
+
+static int64_t elapsed_us(const run_t *run)
+{
+    return esp_timer_get_time() - run->t0_us;
+}
+
+/**
+ * @brief Mark module @p index finished and tell the caller.
+ *
+ * The failed bit is published before the done bit, so a dependent that
+ * wakes on the done bit always sees it.  Nothing in @p run is touched
+ * after the notification: the caller may return and drop it.
+ */
+static void finish(run_t *run, size_t index, esp_err_t result)
+{
+    run->stages[index].result = result;
+    if (result != ESP_OK) {
+        __atomic_fetch_or(&run->failed, INIT_GRAPH_DEP(index), __ATOMIC_RELEASE);
+    }
+    xEventGroupSetBits(run->done, INIT_GRAPH_DEP(index));
+    xTaskNotifyGive(run->caller);
+}
+
+static void module_task(void *arg)
+{
+    const module_slot_t *slot = arg;
+    run_t *run = slot->run;
+    const size_t index = slot->index;
+    const init_graph_module_t *module = &run->modules[index];
+    init_graph_stage_t *stage = &run->stages[index];
+
+    if (module->deps) {
+        xEventGroupWaitBits(run->done, module->deps, pdFALSE, pdTRUE, portMAX_DELAY);
+    }
+    stage->ready_us = elapsed_us(run);
+
+    const uint32_t failed = __atomic_load_n(&run->failed, __ATOMIC_ACQUIRE) & module->deps;
+    esp_err_t result;
+    if (failed) {
+        stage->start_us = stage->end_us = stage->ready_us;
+        ESP_LOGW(TAG, "%s skipped: dependency %s failed", module->name,
+                 run->modules[__builtin_ctz(failed)].name);
+        result = ESP_ERR_INVALID_STATE;
+    } else {
+        stage->core     = xPortGetCoreID();
+        stage->start_us = elapsed_us(run);
+        result          = module->fn(module->arg);
+        stage->end_us   = elapsed_us(run);
+        if (result != ESP_OK) {
+            ESP_LOGE(TAG, "%s failed: %s", module->name, esp_err_to_name(result));
+        }
+    }
+
+    finish(run, index, result);
+    vTaskDelete(NULL);
+}
+
+/* ── API ──────────────────────────────────────────────────────────── */
+
+esp_err_t init_graph_run(const init_graph_module_t *modules, size_t count,
+                         init_graph_stage_t *stages)
+{
+    if (count == 0 || count > INIT_GRAPH_MAX_MODULES) return ESP_ERR_INVALID_ARG;
+
+    esp_err_t err = ESP_OK;
+    for (size_t i = 0; i < count; i++) {
+        if (modules[i].deps >> i) {
+            ESP_LOGE(TAG, "%s depends on itself or a later module", modules[i].name);
+            err = ESP_ERR_INVALID_ARG;
+        }
+    }
+
+    run_t run = {
+        .modules = modules,
+        .stages  = stages,
+        .caller  = xTaskGetCurrentTaskHandle(),
+    };
+    if (err == ESP_OK) {
+        run.done = xEventGroupCreate();
+        if (!run.done) err = ESP_ERR_NO_MEM;
+    }
+
+    memset(stages, 0, count * sizeof(*stages));
+    if (err != ESP_OK) {
+        for (size_t i = 0; i < count; i++) {
+            stages[i].result = err;
+            stages[i].core   = -1;
+        }
+        return err;
+    }
+
+    const UBaseType_t priority = uxTaskPriorityGet(NULL);
+    run.t0_us = esp_timer_get_time();
+
+    for (size_t i = 0; i < count; i++) {
+        const init_graph_module_t *module = &modules[i];
+        stages[i].core = -1;
+        run.slots[i]   = (module_slot_t){ .run = &run, .index = i };
+
+        const uint32_t stack = module->stack_size ? module->stack_size
+                                                  : INIT_GRAPH_DEFAULT_STACK;
+        if (xTaskCreatePinnedToCore(module_task, module->name, stack, &run.slots[i],
+                                    priority, NULL, module->core) != pdPASS) {
+            ESP_LOGE(TAG, "No memory for the %s task", module->name);
+            finish(&run, i, ESP_ERR_NO_MEM);
+        }
+    }
+
+    /* One notification per module: every task is past its last use of run */
+    for (size_t i = 0; i < count; i++) {
+        ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+    }
+    vEventGroupDelete(run.done);
+
+    for (size_t i = 0; i < count; i++) {
+        if (stages[i].result != ESP_OK) return stages[i].result;
+    }
+    return ESP_OK;
+}
+
+void init_graph_log_timeline(const init_graph_module_t *modules, size_t count,
+                             const init_graph_stage_t *stages)
+{
+    int64_t total_us  = 0;
+    int64_t serial_us = 0;
+
+    ESP_LOGI(TAG, "%-14s %4s %9s %9s %9s  %s", "module", "core",
+             "ready ms", "wait ms", "init ms", "result");
+    for (size_t i = 0; i < count; i++) {
+        const init_graph_stage_t *s = &stages[i];
+        const int64_t init_us = s->end_us - s->start_us;
+
+        ESP_LOGI(TAG, "%-14s %4d %9.1f %9.1f %9.1f  %s", modules[i].name, s->core,
+                 s->ready_us / 1000.0, (s->start_us - s->ready_us) / 1000.0,
+                 init_us / 1000.0, esp_err_to_name(s->result));
+
+        serial_us += init_us;
+        if (s->end_us > total_us) total_us = s->end_us;
+    }
+    ESP_LOGI(TAG, "All modules done after %.1f ms (init times add up to %.1f ms)",
+             total_us / 1000.0, serial_us / 1000.0);
+}
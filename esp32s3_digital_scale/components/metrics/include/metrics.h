@@ -0,0 +1,200 @@
+/**
+ * @file metrics.h
+ * @brief Runtime metrics registry with Prometheus and binary export.
+ *
+ * Counters, gauges and histograms are registered once at start-up and then
+ * updated from any task or ISR without a lock.  Counters and histograms
+ * keep one cell per core; an update is a relaxed atomic add to the cell of
+ * the core it runs on, so the two cores never contend for a word and a task
+ * migrating mid-update still cannot lose an increment.  Readers add the
+ * cells up when they export.
+ *
+ * Values that some other module already keeps (a client count, a driver's
+ * statistics, heap figures) are registered with a read callback instead,
+ * sampled only when exporting.
+ *
+ * Two exports cover the field cases:
+ *   - metrics_write_prometheus(): text exposition format 0.0.4, for an
+ *     HTTP scrape handler.
+ *   - metrics_encode(): a compact, self-describing binary record with a
+ *     CRC-32.  metrics_dump_serial() prints it base64-encoded on one
+ *     console line starting with METRICS_DUMP_PREFIX, which survives the
+ *     console's LF → CRLF translation and USB-Serial-JTAG alike;
+ *     tools/metrics_decode.py turns captured lines back into text.
+ *
+ * Counter and histogram cells are 32-bit, since the cores have no
+ * lock-free 64-bit atomics.  They wrap after 2^32 per core, which
+ * Prometheus rate() treats as a counter reset.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.0.0
+ * @date    2025
+ */
+
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ── Constants ────────────────────────────────────────────────────── */
+
+/** Most metrics in the registry. */
+#define METRICS_MAX_METRICS    32
+
+/** Most finite bucket bounds per histogram (+Inf is implicit). */
+#define METRICS_MAX_BUCKETS    12
+
+/** Largest binary record metrics_dump_serial() will build, in bytes. */
+#define METRICS_DUMP_MAX_BYTES 2048
+
+/** Start of every serial dump line. */
+#define METRICS_DUMP_PREFIX    "METRICS1 "
+
+/* ── Types ────────────────────────────────────────────────────────── */
+
+/** @brief Metric kind; the values are part of the binary format. */
+typedef enum {
+    METRIC_COUNTER   = 0,   /**< Only goes up                       */
+    METRIC_GAUGE     = 1,   /**< Current value, up or down          */
+    METRIC_HISTOGRAM = 2,   /**< Observations counted into buckets  */
+} metric_type_t;
+
+/** @brief Registered metric; opaque. */
+typedef struct metric metric_t;
+
+/** @brief Read callback of a sampled counter or gauge. */
+typedef int64_t (*metric_read_fn_t)(void);
+
+/**
+ * @brief Sink for exported text.
+ *
+ * @param[in] ctx  Caller context.
+ * @param[in] data Bytes to write, not NUL-terminated.
+ * @param[in] len  Number of bytes.
+ * @return ESP_OK to continue; any error stops the export.
+ */
+typedef esp_err_t (*metrics_write_fn_t)(void *ctx, const char *data, size_t len);
+
+/* ── Registration (start-up, task context) ────────────────────────── */
+
+/**
+ * @brief Register a counter.
+ *
+ * Names follow Prometheus rules ([a-zA-Z_:][a-zA-Z0-9_:]*); counters
+ * should end in _total.  @p name and @p help must stay valid.
+ *
+ * @return The metric, or NULL when the registry is full.  Every update
+ *         function accepts NULL, so callers need not check.
+ */
+metric_t *metrics_counter(const char *name, const char *help);
+
+/** @brief Register a gauge.  See metrics_counter() for the arguments. */
+metric_t *metrics_gauge(const char *name, const char *help);
+
+/**
+ * @brief Register a histogram.
+ *
+ * @param[in] bounds Upper bucket bounds, strictly increasing; copied.
+ * @param[in] count  Number of bounds, 1 to METRICS_MAX_BUCKETS.
+ * @return The metric, or NULL when the registry is full, the bounds are
+ *         invalid or the bucket cells cannot be allocated.
+ */
+metric_t *metrics_histogram(const char *name, const char *help,
+                            const uint32_t *bounds, size_t count);
+
+/**
+ * @brief Register a counter or gauge whose value is read on export.
+ *
+ * @param[in] type METRIC_COUNTER or METRIC_GAUGE.
+ * @param[in] read Called from the exporting task; must not block long.
+ * @return The metric, or NULL when the registry is full or @p type is
+ *         METRIC_HISTOGRAM.
+ */
+metric_t *metrics_sampled(metric_type_t type, const char *name, const char *help,
+                          metric_read_fn_t read);
+
+/**
+ * @brief Register free heap, minimum free heap, largest free block and
+ *        uptime as sampled gauges.
+ */
+void metrics_register_system(void);
+
+/* ── Updates (any task or ISR, lock-free) ─────────────────────────── */
+
+/** @brief Add @p n to a counter. */
+void metrics_add(metric_t *metric, uint32_t n);
+
+/** @brief Add one to a counter. */
+static inline void metrics_inc(metric_t *metric)
+{
+    metrics_add(metric, 1);
+}
+
+/** @brief Set a gauge. */
+void metrics_set(metric_t *metric, int32_t value);
+
+/** @brief Add @p delta, which may be negative, to a gauge. */
+void metrics_gauge_add(metric_t *metric, int32_t delta);
+
+/** @brief Count @p value into the first bucket whose bound is >= it. */
+void metrics_observe(metric_t *metric, uint32_t value);
+
+/* ── Export ───────────────────────────────────────────────────────── */
+
+/**
+ * @brief Write every metric in Prometheus text format 0.0.4.
+ *
+ * @param[in] write Sink, called once per line or less.
+ * @param[in] ctx   Passed to @p write.
+ * @return ESP_OK, or the first error returned by @p write.
+ */
+esp_err_t metrics_write_prometheus(metrics_write_fn_t write, void *ctx);
+
+/**
+ * @brief Encode every metric as one binary record.
+ *
+ * Layout (varint = unsigned LEB128, svarint = zigzag varint):
+ *   u8 version (1), varint uptime_ms, varint metric count, then per metric
+ *   u8 type, u8 name length, name bytes, and
+ *     counter:   varint value
+ *     gauge:     svarint value
+ *     histogram: u8 bucket count n, n × varint bound,
+ *                n + 1 × varint count (last is +Inf, not cumulative),
+ *                varint sum
+ *   and a little-endian CRC-32 (IEEE, as zlib) of everything before it.
+ *
+ * @param[out] buf  Destination.
+ * @param[in]  size Capacity of @p buf.
+ * @param[out] len  Record length on success.
+ * @return ESP_OK; ESP_ERR_INVALID_SIZE when @p buf is too small.
+ */
+esp_err_t metrics_encode(uint8_t *buf, size_t size, size_t *len);
+
+/**
+ * @brief Print the binary record as one base64 line on stdout.
+ *
+ * @return ESP_OK; ESP_ERR_NO_MEM; ESP_ERR_INVALID_SIZE when the record
+ *         exceeds METRICS_DUMP_MAX_BYTES.
+ */
+esp_err_t metrics_dump_serial(void);
+
+/**
+ * @brief Start a low-priority task calling metrics_dump_serial() every
+ *        @p period_ms.
+ *
+ * @return ESP_OK; ESP_ERR_INVALID_ARG for a zero period;
+ *         ESP_ERR_INVALID_STATE if already started; ESP_ERR_NO_MEM.
+ */
+esp_err_t metrics_dump_start(uint32_t period_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* METRICS_H */
@@ -0,0 +1,407 @@
+/**
+ * @file metrics.c
+ * @brief Runtime metrics registry implementation.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.0.0
+ * @date    2025
+ */
+
+#include "metrics.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_rom_crc.h"
+#include "esp_timer.h"
+
+static const char *TAG = "METRICS";
+
+#define FORMAT_VERSION      1
+#define DUMP_TASK_STACK     3072
+#define DUMP_TASK_PRIORITY  1
+
+struct metric {
+    const char      *name;
+    const char      *help;
+    metric_type_t    type;
+    metric_read_fn_t read;                          /* sampled metrics only    */
+    uint32_t         cells[portNUM_PROCESSORS];     /* counter, per core       */
+    int32_t          gauge;
+    uint8_t          n_bounds;
+    uint32_t         bounds[METRICS_MAX_BUCKETS];
+    uint32_t        *hist;  /* per core: n_bounds + 1 bucket counts, then sum */
+};
+
+static metric_t    s_metrics[METRICS_MAX_METRICS];
+static size_t      s_count;     /* published with release, read with acquire */
+static portMUX_TYPE s_register_lock = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t s_dump_task;
+
+/* ── Registration ─────────────────────────────────────────────────── */
+
+/**
+ * @brief Claim a slot, fill it in and publish it.
+ *
+ * The count is bumped only after the slot is complete, so an exporter
+ * running concurrently never sees a half-registered metric.
+ */
+static metric_t *register_metric(const metric_t *init)
+{
+    taskENTER_CRITICAL(&s_register_lock);
+    const size_t index = s_count;
+    if (index < METRICS_MAX_METRICS) {
+        s_metrics[index] = *init;
+        __atomic_store_n(&s_count, index + 1, __ATOMIC_RELEASE);
+    }
+    taskEXIT_CRITICAL(&s_register_lock);
+
+    if (index >= METRICS_MAX_METRICS) {
+        ESP_LOGE(TAG, "Registry full, %s not registered", init->name);
+        return NULL;
+    }
+    return &s_metrics[index];
+}
+
+metric_t *metrics_counter(const char *name, const char *help)
+{
+    return register_metric(&(metric_t){ .name = name, .help = help, .type = METRIC_COUNTER });
+}
+
+metric_t *metrics_gauge(const char *name, const char *help)
+{
+    return register_metric(&(metric_t){ .name = name, .help = help, .type = METRIC_GAUGE });
+}
+
+metric_t *metrics_histogram(const char *name, const char *help,
+                            const uint32_t *bounds, size_t count)
+{
+    if (count == 0 || count > METRICS_MAX_BUCKETS) return NULL;
+    for (size_t i = 1; i < count; i++) {
+        if (bounds[i] <= bounds[i - 1]) return NULL;
+    }
+
+    metric_t init = { .name = name, .help = help, .type = METRIC_HISTOGRAM,
+                      .n_bounds = (uint8_t)count };
+    memcpy(init.bounds, bounds, count * sizeof(bounds[0]));
+    init.hist = heap_caps_calloc(portNUM_PROCESSORS * (count + 2), sizeof(uint32_t),
+                                 MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    if (!init.hist) return NULL;
+
+    metric_t *metric = register_metric(&init);
+    if (!metric) free(init.hist);
+    return metric;
+}
+
+metric_t *metrics_sampled(metric_type_t type, const char *name, const char *help,
+                          metric_read_fn_t read)
+{
+    if (type == METRIC_HISTOGRAM || !read) return NULL;
+    return register_metric(&(metric_t){ .name = name, .help = help, .type = type,
+                                        .read = read });
+}
+
+static int64_t read_heap_free(void)
+{
+    return heap_caps_get_free_size(MALLOC_CAP_8BIT);
+}
+
+static int64_t read_heap_min_free(void)
+{
+    return heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+}
+
+static int64_t read_heap_largest_block(void)
+{
+    return heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+}
+
+static int64_t read_uptime(void)
+{
+    return esp_timer_get_time() / 1000000LL;
+}
+
+void metrics_register_system(void)
+{
+    metrics_sampled(METRIC_GAUGE, "heap_free_bytes",
+                    "Free 8-bit capable heap", read_heap_free);
+    metrics_sampled(METRIC_GAUGE, "heap_min_free_bytes",
+                    "Lowest free 8-bit capable heap since boot", read_heap_min_free);
+    metrics_sampled(METRIC_GAUGE, "heap_largest_free_block_bytes",
+                    "Largest free 8-bit capable block", read_heap_largest_block);
+    metrics_sampled(METRIC_GAUGE, "uptime_seconds",
+                    "Seconds since boot", read_uptime);
+}
+
+/* ── Updates ──────────────────────────────────────────────────────── */
+
+void IRAM_ATTR metrics_add(metric_t *metric, uint32_t n)
+{
+    if (!metric) return;
+    __atomic_fetch_add(&metric->cells[esp_cpu_get_core_id()], n, __ATOMIC_RELAXED);
+}
+
+void IRAM_ATTR metrics_set(metric_t *metric, int32_t value)
+{
+    if (!metric) return;
+    __atomic_store_n(&metric->gauge, value, __ATOMIC_RELAXED);
+}
+
+void IRAM_ATTR metrics_gauge_add(metric_t *metric, int32_t delta)
+{
+    if (!metric) return;
+    __atomic_fetch_add(&metric->gauge, delta, __ATOMIC_RELAXED);
+}
+
+void IRAM_ATTR metrics_observe(metric_t *metric, uint32_t value)
+{
+    if (!metric || !metric->hist) return;
+
+    size_t bucket = 0;
+    while (bucket < metric->n_bounds && value > metric->bounds[bucket]) bucket++;
+
+    uint32_t *cells = &metric->hist[esp_cpu_get_core_id() * (metric->n_bounds + 2)];
+    __atomic_fetch_add(&cells[bucket], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&cells[metric->n_bounds + 1], value, __ATOMIC_RELAXED);
+}
+
+/* ── Reading ──────────────────────────────────────────────────────── */
+
+static size_t metric_count(void)
+{
+    return __atomic_load_n(&s_count, __ATOMIC_ACQUIRE);
+}
+
+static uint64_t counter_value(const metric_t *metric)
+{
+    if (metric->read) return (uint64_t)metric->read();
+
+    uint64_t sum = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        sum += __atomic_load_n(&metric->cells[core], __ATOMIC_RELAXED);
+    }
+    return sum;
+}
+
+static int64_t gauge_value(const metric_t *metric)
+{
+    if (metric->read) return metric->read();
+    return __atomic_load_n(&metric->gauge, __ATOMIC_RELAXED);
+}
+
+/**
+ * @brief Sum one histogram word over the cores.
+ *
+ * @param[in] word Bucket index, or n_bounds + 1 for the sum.
+ */
+static uint64_t hist_word(const metric_t *metric, size_t word)
+{
+    uint64_t sum = 0;
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        sum += __atomic_load_n(&metric->hist[core * (metric->n_bounds + 2) + word],
+                               __ATOMIC_RELAXED);
+    }
+    return sum;
+}
+
+/* ── Prometheus text ──────────────────────────────────────────────── */
+
+static const char *const s_type_names[] = { "counter", "gauge", "histogram" };
+
+esp_err_t metrics_write_prometheus(metrics_write_fn_t write, void *ctx)
+{
+    char line[160];
+    esp_err_t err = ESP_OK;
+    const size_t count = metric_count();
+
+#define EMIT(...)                                                          \
+    do {                                                                   \
+        int n = snprintf(line, sizeof(line), __VA_ARGS__);                 \
+        if (n >= (int)sizeof(line)) n = sizeof(line) - 1;                  \
+        err = write(ctx, line, (size_t)n);                                 \
+        if (err != ESP_OK) return err;                                     \
+    } while (0)
+
+    for (size_t i = 0; i < count; i++) {
+        const metric_t *m = &s_metrics[i];
+
+        EMIT("# HELP %s %s\n", m->name, m->help);
+        EMIT("# TYPE %s %s\n", m->name, s_type_names[m->type]);
+
+        switch (m->type) {
+        case METRIC_COUNTER:
+            EMIT("%s %" PRIu64 "\n", m->name, counter_value(m));
+            break;
+        case METRIC_GAUGE:
+            EMIT("%s %" PRId64 "\n", m->name, gauge_value(m));
+            break;
+        case METRIC_HISTOGRAM: {
+            uint64_t cumulative = 0;
+            for (size_t b = 0; b < m->n_bounds; b++) {
+                cumulative += hist_word(m, b);
+                EMIT("%s_bucket{le=\"%" PRIu32 "\"} %" PRIu64 "\n", m->name,
+                     m->bounds[b], cumulative);
+            }
+            cumulative += hist_word(m, m->n_bounds);
+            EMIT("%s_bucket{le=\"+Inf\"} %" PRIu64 "\n", m->name, cumulative);
+            EMIT("%s_sum %" PRIu64 "\n", m->name, hist_word(m, m->n_bounds + 1));
+            EMIT("%s_count %" PRIu64 "\n", m->name, cumulative);
+            break;
+        }
+        }
+    }
+
+#undef EMIT
+    return err;
+}
+
+/* ── Binary record ────────────────────────────────────────────────── */
+
+typedef struct {
+    uint8_t *buf;
+    size_t   size;
+    size_t   len;
+    bool     overflow;
+} encoder_t;
+
+static void put_byte(encoder_t *enc, uint8_t byte)
+{
+    if (enc->len < enc->size) {
+        enc->buf[enc->len++] = byte;
+    } else {
+        enc->overflow = true;
+    }
+}
+
+static void put_varint(encoder_t *enc, uint64_t value)
+{
+    while (value >= 0x80) {
+        put_byte(enc, (uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    put_byte(enc, (uint8_t)value);
+}
+
+static void put_svarint(encoder_t *enc, int64_t value)
+{
+    put_varint(enc, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+esp_err_t metrics_encode(uint8_t *buf, size_t size, size_t *len)
+{
+    encoder_t enc = { .buf = buf, .size = size };
+    const size_t count = metric_count();
+
+    put_byte(&enc, FORMAT_VERSION);
+    put_varint(&enc, (uint64_t)(esp_timer_get_time() / 1000));
+    put_varint(&enc, count);
+
+    for (size_t i = 0; i < count; i++) {
+        const metric_t *m = &s_metrics[i];
+        const size_t name_len = strnlen(m->name, UINT8_MAX);
+
+        put_byte(&enc, (uint8_t)m->type);
+        put_byte(&enc, (uint8_t)name_len);
+        for (size_t c = 0; c < name_len; c++) put_byte(&enc, (uint8_t)m->name[c]);
+
+        switch (m->type) {
+        case METRIC_COUNTER:
+            put_varint(&enc, counter_value(m));
+            break;
+        case METRIC_GAUGE:
+            put_svarint(&enc, gauge_value(m));
+            break;
+        case METRIC_HISTOGRAM:
+            put_byte(&enc, m->n_bounds);
+            for (size_t b = 0; b < m->n_bounds; b++) put_varint(&enc, m->bounds[b]);
+            for (size_t w = 0; w <= m->n_bounds + 1u; w++) put_varint(&enc, hist_word(m, w));
+            break;
+        }
+    }
+
+    if (enc.overflow || enc.size - enc.len < 4) return ESP_ERR_INVALID_SIZE;
+
+    const uint32_t crc = esp_rom_crc32_le(0, enc.buf, enc.len);
+    for (int shift = 0; shift < 32; shift += 8) put_byte(&enc, (uint8_t)(crc >> shift));
+
+    *len = enc.len;
+    return ESP_OK;
+}
+
+/* ── Serial dump ──────────────────────────────────────────────────── */
+
+static const char s_base64[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+esp_err_t metrics_dump_serial(void)
+{
+    uint8_t *record = malloc(METRICS_DUMP_MAX_BYTES);
+    if (!record) return ESP_ERR_NO_MEM;
+
+    size_t len = 0;
+    esp_err_t err = metrics_encode(record, METRICS_DUMP_MAX_BYTES, &len);
+    if (err != ESP_OK) {
+        free(record);
+        return err;
+    }
+
+    /* One fputs per 48-byte group keeps the line out of a large buffer */
+    char out[65];
+    fputs(METRICS_DUMP_PREFIX, stdout);
+    for (size_t i = 0; i < len; ) {
+        size_t o = 0;
+        for (size_t end = (len - i > 48) ? i + 48 : len; i < end; i += 3) {
+            const size_t n = (len - i < 3) ? len - i : 3;
+            const uint32_t v = (uint32_t)record[i] << 16
+                             | (n > 1 ? (uint32_t)record[i + 1] << 8 : 0)
+                             | (n > 2 ? record[i + 2] : 0);
+            out[o++] = s_base64[(v >> 18) & 0x3F];
+            out[o++] = s_base64[(v >> 12) & 0x3F];
+            out[o++] = n > 1 ? s_base64[(v >> 6) & 0x3F] : '=';
+            out[o++] = n > 2 ? s_base64[v & 0x3F] : '=';
+        }
+        out[o] = '\0';
+        fputs(out, stdout);
+    }
+    fputs("\n", stdout);
+    fflush(stdout);
+
+    free(record);
+    return ESP_OK;
+}
+
+static void dump_task(void *arg)
+{
+    const TickType_t period = pdMS_TO_TICKS((uint32_t)(uintptr_t)arg);
+    TickType_t last_wake = xTaskGetTickCount();
+
+    while (true) {
+        vTaskDelayUntil(&last_wake, period);
+        esp_err_t err = metrics_dump_serial();
+        if (err != ESP_OK) {
+            ESP_LOGW(TAG, "Dump failed: %s", esp_err_to_name(err));
+        }
+    }
+}
+
+esp_err_t metrics_dump_start(uint32_t period_ms)
+{
+    if (period_ms == 0) return ESP_ERR_INVALID_ARG;
+    if (s_dump_task) return ESP_ERR_INVALID_STATE;
+
+    if (xTaskCreate(dump_task, "metrics_dump", DUMP_TASK_STACK,
+                    (void *)(uintptr_t)period_ms, DUMP_TASK_PRIORITY,
+                    &s_dump_task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+    ESP_LOGI(TAG, "Serial dump every %" PRIu32 " ms", period_ms);
+    return ESP_OK;
+}
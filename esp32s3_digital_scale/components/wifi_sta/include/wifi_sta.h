@@ -0,0 +1,241 @@
+/**
+ * @file
+ * @brief Wi-Fi station with retry, reconnect and power-save profiles
+ *
+ * One station interface per application: wifi_sta_init() creates the netif
+ * and registers the event handlers, wifi_sta_connect() starts the driver and
+ * waits for an address, wifi_sta_stop() takes the link down on purpose.
+ *
+ * While associated, the radio sleeps between beacons according to a profile
+ * that can be changed at any time without reconnecting:
+ *
+ *   profile       modem sleep            radio wakes for
+ *   LOW_LATENCY   WIFI_PS_NONE           always on
+ *   BALANCED      WIFI_PS_MIN_MODEM      every DTIM beacon
+ *   LOW_POWER     WIFI_PS_MAX_MODEM      every listen interval
+ *
+ * The AP buffers frames for a sleeping station until it wakes, so inbound
+ * traffic (a request to a web server, an MQTT publish from the broker) can
+ * wait up to one wake period before it is received. Outbound traffic wakes
+ * the radio at once. The listen interval is sent to the AP when associating;
+ * it is rounded up to a multiple of the DTIM period so every wake falls on a
+ * DTIM beacon, after which the AP releases buffered broadcast and multicast
+ * frames such as ARP requests.
+ *
+ * The application initializes NVS before calling wifi_sta_init(). The
+ * driver keeps its configuration in RAM only.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "esp_err.h"
+#include "esp_netif.h"
+#include "esp_wifi_types.h"
+#include "freertos/FreeRTOS.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Power-save profile while associated
+ */
+typedef enum {
+    WIFI_STA_PS_DEFAULT,        /*!< Profile chosen in menuconfig */
+    WIFI_STA_PS_LOW_LATENCY,    /*!< No modem sleep */
+    WIFI_STA_PS_BALANCED,       /*!< Modem sleep, wake every DTIM */
+    WIFI_STA_PS_LOW_POWER,      /*!< Modem sleep, wake every listen interval */
+} wifi_sta_ps_profile_t;
+
+/**
+ * @brief Station configuration
+ *
+ * Zero fields take the menuconfig default.
+ */
+typedef struct {
+    const char *ssid;                   /*!< Network name */
+    const char *password;               /*!< Passphrase, empty for an open network */
+    wifi_auth_mode_t auth_threshold;    /*!< Weakest accepted security, 0 for WPA2-PSK */
+    uint8_t max_retries;                /*!< Reconnect attempts before a connect fails */
+    wifi_sta_ps_profile_t ps_profile;   /*!< Initial power-save profile */
+    uint8_t listen_interval;            /*!< Beacon intervals between wakes in LOW_POWER */
+    uint8_t dtim_period;                /*!< DTIM period of the AP, in beacon intervals */
+} wifi_sta_config_t;
+
+/**
+ * @brief An access point to join without scanning
+ */
+typedef struct {
+    uint8_t bssid[6];       /*!< MAC address of the AP */
+    uint8_t channel;        /*!< Primary channel */
+} wifi_sta_ap_t;
+
+/**
+ * @brief Create the station interface and register the event handlers
+ *
+ * Creates the default event loop and initializes esp_netif unless the
+ * application already did. The strings in @p config are copied.
+ *
+ * @param config Configuration
+ * @return
+ *          - ESP_ERR_INVALID_ARG   if config or the SSID is missing
+ *          - ESP_ERR_INVALID_STATE if already initialized
+ *          - ESP_ERR_NO_MEM        if out of memory
+ *          - ESP_OK                on success
+ */
+esp_err_t wifi_sta_init(const wifi_sta_config_t *config);
+
+/**
+ * @brief Connect and wait for an IPv4 address
+ *
+ * Starts the driver if it is stopped or was deinitialized and returns at
+ * once if the station already has an address. Lost links are retried up to
+ * max_retries times, here and later in the background.
+ *
+ * @param ap AP to join directly on its channel, NULL to scan
+ * @param timeout Ticks to wait
+ * @return
+ *          - ESP_ERR_INVALID_STATE if not initialized
+ *          - ESP_FAIL              if every retry failed
+ *          - ESP_ERR_TIMEOUT       if no address arrived in time
+ *          - ESP_OK                on success
+ */
+esp_err_t wifi_sta_connect(const wifi_sta_ap_t *ap, TickType_t timeout);
+
+/**
+ * @brief Disconnect and stop the driver without retrying
+ *
+ * The radio is off until the next wifi_sta_connect().
+ */
+void wifi_sta_stop(void);
+
+/**
+ * @brief Stop and deinitialize the driver to free its memory
+ *
+ * The netif and event handlers stay, so wifi_sta_connect() can bring the
+ * link up again.
+ */
+void wifi_sta_deinit(void);
+
+/**
+ * @brief Check whether the station has an address
+ */
+bool wifi_sta_is_connected(void);
+
+/**
+ * @brief Get the station netif, for addressing and DHCP control
+ *
+ * @return Netif, NULL before wifi_sta_init()
+ */
+esp_netif_t *wifi_sta_get_netif(void);
+
+/**
+ * @brief Get the address of the station as text
+ *
+ * @return "0.0.0.0" while disconnected
+ */
+const char *wifi_sta_get_ip_str(void);
+
+/**
+ * @brief Get the AP the station is associated with, for a later fast connect
+ *
+ * @param[out] ap BSSID and channel
+ * @return
+ *          - ESP_ERR_WIFI_NOT_CONNECT if not associated
+ *          - ESP_OK                   on success
+ */
+esp_err_t wifi_sta_get_ap(wifi_sta_ap_t *ap);
+
+/**
+ * @brief Switch the power-save profile
+ *
+ * Takes effect at once, also while connected. Before the driver is
+ * initialized the profile is stored and applied when it starts.
+ *
+ * @param profile New profile
+ * @return
+ *          - ESP_ERR_INVALID_ARG if the profile is unknown
+ *          - ESP_OK              on success, or the error of esp_wifi_set_ps()
+ */
+esp_err_t wifi_sta_set_ps_profile(wifi_sta_ps_profile_t profile);
+
+/**
+ * @brief Get the active power-save profile, never WIFI_STA_PS_DEFAULT
+ */
+wifi_sta_ps_profile_t wifi_sta_get_ps_profile(void);
+
+/**
+ * @brief Short name of a profile, for logs
+ *
+ * @param profile Profile
+ * @return Constant string
+ */
+const char *wifi_sta_ps_profile_name(wifi_sta_ps_profile_t profile);
+
+/**
+ * @brief Worst-case extra delay of inbound traffic in a profile
+ *
+ * One wake period: 0 without modem sleep, otherwise the DTIM period or the
+ * listen interval times the beacon interval of the AP, taken as 102.4 ms.
+ *
+ * @param profile Profile
+ * @return Delay in ms
+ */
+uint32_t wifi_sta_wake_period_ms(wifi_sta_ps_profile_t profile);
+
+/**
+ * @brief Options of a power-save benchmark
+ */
+typedef struct {
+    const char *host;           /*!< Host to ping, NULL for the gateway */
+    uint16_t ping_count;        /*!< Echo requests per profile */
+    uint16_t ping_interval_ms;  /*!< Time between requests */
+    uint32_t idle_ms;           /*!< Idle window per profile for the current reading */
+    uint32_t settle_ms;         /*!< Wait after switching profile */
+    int marker_gpio;            /*!< Driven high during both windows for an external meter, -1 for none */
+    bool (*read_current_ua)(void *ctx, uint32_t *ua);   /*!< Current sampler, NULL if none */
+    void *ctx;                  /*!< Argument of read_current_ua */
+} wifi_sta_bench_config_t;
+
+/**
+ * @brief Results of one profile
+ */
+typedef struct {
+    wifi_sta_ps_profile_t profile;  /*!< Profile measured */
+    uint16_t sent;                  /*!< Echo requests sent */
+    uint16_t received;              /*!< Echo replies received */
+    uint32_t rtt_min_ms;            /*!< Fastest round trip */
+    uint32_t rtt_avg_ms;            /*!< Mean round trip */
+    uint32_t rtt_max_ms;            /*!< Slowest round trip */
+    uint32_t idle_ua;               /*!< Mean current while idle, 0 without a sampler */
+    uint32_t ping_ua;               /*!< Mean current while pinging, 0 without a sampler */
+} wifi_sta_bench_result_t;
+
+/**
+ * @brief Measure round-trip time and current in each profile
+ *
+ * Runs LOW_LATENCY, BALANCED and LOW_POWER in turn on the current link,
+ * logs a table and restores the profile that was active. Each profile gets
+ * an idle window, then a ping window.
+ *
+ * The ping is sent by the station, so the request leaves at once and only
+ * the reply may wait in the AP. It shows the cost of a wake period on
+ * request/response traffic started by the device; traffic started by the
+ * network can wait up to wifi_sta_wake_period_ms() longer.
+ *
+ * @param config Options
+ * @param[out] results One entry per profile, in the order above
+ * @return
+ *          - ESP_ERR_INVALID_ARG      if an argument is missing
+ *          - ESP_ERR_WIFI_NOT_CONNECT if the station has no address
+ *          - ESP_ERR_NOT_FOUND        if the host does not resolve
+ *          - ESP_OK                   on success, or the error of the ping session
+ */
+esp_err_t wifi_sta_bench_run(const wifi_sta_bench_config_t *config,
+                             wifi_sta_bench_result_t results[3]);
+
+#ifdef __cplusplus
+}
+#endif
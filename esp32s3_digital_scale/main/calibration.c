@@ -2,8 +2,12 @@
  * @file calibration.c
  * @brief Calibration subsystem implementation.
  *
- * Implements NVS-backed persistence and an interactive UART calibration
- * wizard for the HX711 load-cell interface.
+ * Implements NVS-backed persistence, the sample-fed calibration state
+ * machine, and an interactive UART calibration wizard for the HX711
+ * load-cell interface.  The state lives behind a spinlock: requests
+ * from the httpd or console task only flip state, and all averaging,
+ * fitting, and device updates happen in calibration_feed(), called by
+ * the measurement task.
  *
  * @author  ESP32-S3 Scale Project
  * @version 1.0.0
@@ -15,6 +19,8 @@
 
 #include <stdio.h>
 #include <string.h>
+#include <math.h>
+#include <inttypes.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
@@ -23,6 +29,39 @@
 
 static const char *TAG = "CALIBRATION";
 
+/** Longest the wizard waits for one capture or fit to complete. */
+#define CAL_WAIT_TIMEOUT_MS   10000
+
+/** Wizard status poll period. */
+#define CAL_WAIT_POLL_MS      100
+
+/** @brief One captured reference point. */
+typedef struct {
+    float   grams; /**< Reference weight     */
+    int32_t raw;   /**< Averaged raw reading */
+} calibration_point_t;
+
+/** @brief State machine; protected by s_cal_lock. */
+static struct {
+    calibration_state_t state;
+    calibration_state_t resume_state;   /**< Where a tare returns to      */
+    calibration_point_t points[CALIBRATION_MAX_POINTS];
+    size_t              point_count;
+    float               capture_grams;
+    int64_t             capture_sum;
+    uint32_t            capture_count;
+    uint32_t            capture_target;
+    bool                scale_pending;
+    float               pending_scale;
+    int32_t             last_raw;
+    esp_err_t           last_result;
+    float               scale;
+    int32_t             tare;
+    float               max_residual_g;
+} s_cal = { .state = CAL_STATE_IDLE, .resume_state = CAL_STATE_IDLE };
+
+static portMUX_TYPE s_cal_lock = portMUX_INITIALIZER_UNLOCKED;
+
 /* ── Private helpers ──────────────────────────────────────────────── */
 
 /**
@@ -47,84 +86,415 @@ static void read_line(char *buf, size_t buflen)
     buf[pos] = '\0';
 }
 
-/* ── Public API ───────────────────────────────────────────────────── */
+/**
+ * @brief Start averaging samples; caller must hold s_cal_lock.
+ *
+ * @param[in] state  CAL_STATE_CAPTURING or CAL_STATE_TARING.
+ * @param[in] target Samples to average.
+ */
+static void begin_capture(calibration_state_t state, uint32_t target)
+{
+    s_cal.state          = state;
+    s_cal.capture_sum    = 0;
+    s_cal.capture_count  = 0;
+    s_cal.capture_target = target;
+}
 
 /**
- * @brief Run the interactive UART calibration wizard.
+ * @brief Least-squares fit of raw = tare + scale × grams.
  *
- * Step 1 – Tare: prompts operator to clear the platform, then captures
- *           CONFIG_TARE_SAMPLES readings as the zero reference.
- * Step 2 – Scale: prompts operator to enter the reference weight in
- *           grams and place it on the platform, then measures and
- *           computes scale = (avg_loaded − tare) / reference_grams.
- * Step 3 – Save: calls calibration_save() to persist to NVS.
+ * @param[in]  pts        Reference points.
+ * @param[in]  n          Number of points (≥ 2).
+ * @param[out] scale      Fitted slope, counts per gram.
+ * @param[out] tare       Fitted intercept, raw counts.
+ * @param[out] max_resid  Largest point residual in grams.
+ * @return ESP_OK; ESP_ERR_INVALID_ARG if all points share one weight or
+ *         the slope is zero.
  */
-esp_err_t calibration_run(hx711_dev_t *dev)
+static esp_err_t fit_points(const calibration_point_t *pts, size_t n,
+                            float *scale, int32_t *tare, float *max_resid)
 {
-    char buf[32];
+    double mean_g = 0.0, mean_r = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        mean_g += pts[i].grams;
+        mean_r += pts[i].raw;
+    }
+    mean_g /= (double)n;
+    mean_r /= (double)n;
+
+    double sxx = 0.0, sxy = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        const double dg = pts[i].grams - mean_g;
+        sxx += dg * dg;
+        sxy += dg * ((double)pts[i].raw - mean_r);
+    }
+    if (sxx == 0.0 || sxy == 0.0) return ESP_ERR_INVALID_ARG;
 
-    printf("\n========================================\n");
-    printf("      Digital Scale Calibration Wizard  \n");
-    printf("========================================\n\n");
+    const double slope     = sxy / sxx;
+    const double intercept = mean_r - slope * mean_g;
 
-    /* ── Step 1: Tare ── */
-    printf("[1/3] Remove ALL weight from the platform.\n");
-    printf("      Press ENTER when ready...\n");
-    read_line(buf, sizeof(buf));
+    double worst = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        const double fitted_g = ((double)pts[i].raw - intercept) / slope;
+        const double resid    = fabs(fitted_g - pts[i].grams);
+        if (resid > worst) worst = resid;
+    }
 
-    printf("      Capturing tare (%d samples)...\n", CONFIG_TARE_SAMPLES);
-    esp_err_t err = hx711_tare(dev, CONFIG_TARE_SAMPLES);
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Tare failed: %s", esp_err_to_name(err));
-        return err;
+    *scale     = (float)slope;
+    *tare      = (int32_t)lround(intercept);
+    *max_resid = (float)worst;
+    return ESP_OK;
+}
+
+/**
+ * @brief Wait until the running capture or fit completes (wizard only).
+ *
+ * @return Result of the completed step; ESP_ERR_TIMEOUT if it stalls.
+ */
+static esp_err_t wait_step_done(void)
+{
+    calibration_status_t st;
+
+    for (uint32_t waited = 0; waited < CAL_WAIT_TIMEOUT_MS; waited += CAL_WAIT_POLL_MS) {
+        calibration_get_status(&st);
+        if (st.state != CAL_STATE_CAPTURING && st.state != CAL_STATE_TARING &&
+            st.state != CAL_STATE_FITTING) {
+            return st.last_result;
+        }
+        vTaskDelay(pdMS_TO_TICKS(CAL_WAIT_POLL_MS));
     }
-    printf("      Tare captured: %" PRId32 " raw counts\n\n", dev->tare);
 
-    /* ── Step 2: Known weight ── */
-    printf("[2/3] Enter the reference weight in grams (e.g. 1000): ");
-    fflush(stdout);
-    read_line(buf, sizeof(buf));
+    ESP_LOGE(TAG, "Calibration step timed out; is the measurement task running?");
+    calibration_cancel();
+    return ESP_ERR_TIMEOUT;
+}
+
+/* ── State machine API ────────────────────────────────────────────── */
 
-    float ref_grams = 0.0f;
-    if (sscanf(buf, "%f", &ref_grams) != 1 || ref_grams <= 0.0f) {
-        ESP_LOGE(TAG, "Invalid reference weight: '%s'", buf);
-        return ESP_ERR_INVALID_ARG;
+/**
+ * @brief Open a multi-point calibration session.
+ */
+esp_err_t calibration_start(void)
+{
+    esp_err_t err = ESP_OK;
+
+    portENTER_CRITICAL(&s_cal_lock);
+    if (s_cal.state == CAL_STATE_IDLE || s_cal.state == CAL_STATE_SESSION) {
+        s_cal.state          = CAL_STATE_SESSION;
+        s_cal.point_count    = 0;
+        s_cal.last_result    = ESP_OK;
+        s_cal.max_residual_g = 0.0f;
+    } else {
+        err = ESP_ERR_INVALID_STATE;
     }
+    portEXIT_CRITICAL(&s_cal_lock);
 
-    printf("      Place the %.1f g reference weight on the platform.\n", ref_grams);
-    printf("      Press ENTER when ready...\n");
-    read_line(buf, sizeof(buf));
+    if (err == ESP_OK) ESP_LOGI(TAG, "Calibration session started");
+    return err;
+}
+
+/**
+ * @brief Capture a reference point from the next samples.
+ */
+esp_err_t calibration_capture_point(float ref_grams)
+{
+    if (!(ref_grams >= 0.0f)) return ESP_ERR_INVALID_ARG;
+
+    esp_err_t err = ESP_OK;
+
+    portENTER_CRITICAL(&s_cal_lock);
+    if (s_cal.state != CAL_STATE_SESSION) {
+        err = ESP_ERR_INVALID_STATE;
+    } else if (s_cal.point_count >= CALIBRATION_MAX_POINTS) {
+        err = ESP_ERR_NO_MEM;
+    } else {
+        s_cal.capture_grams = ref_grams;
+        begin_capture(CAL_STATE_CAPTURING, CONFIG_CAL_POINT_SAMPLES);
+    }
+    portEXIT_CRITICAL(&s_cal_lock);
+
+    if (err == ESP_OK) ESP_LOGI(TAG, "Capturing %.1f g point", ref_grams);
+    return err;
+}
+
+/**
+ * @brief Queue the fit of the session's points.
+ */
+esp_err_t calibration_finish(void)
+{
+    esp_err_t err = ESP_OK;
+
+    portENTER_CRITICAL(&s_cal_lock);
+    if (s_cal.state != CAL_STATE_SESSION) {
+        err = ESP_ERR_INVALID_STATE;
+    } else if (s_cal.point_count < 2) {
+        err = ESP_ERR_INVALID_SIZE;
+    } else {
+        s_cal.state = CAL_STATE_FITTING;
+    }
+    portEXIT_CRITICAL(&s_cal_lock);
+    return err;
+}
+
+/**
+ * @brief Abandon the current session or capture.
+ */
+void calibration_cancel(void)
+{
+    portENTER_CRITICAL(&s_cal_lock);
+    s_cal.state        = CAL_STATE_IDLE;
+    s_cal.resume_state = CAL_STATE_IDLE;
+    s_cal.point_count  = 0;
+    portEXIT_CRITICAL(&s_cal_lock);
+    ESP_LOGI(TAG, "Calibration cancelled");
+}
+
+/**
+ * @brief Start a tare capture.
+ */
+esp_err_t calibration_request_tare(void)
+{
+    esp_err_t err = ESP_OK;
+
+    portENTER_CRITICAL(&s_cal_lock);
+    if (s_cal.state == CAL_STATE_IDLE || s_cal.state == CAL_STATE_SESSION) {
+        s_cal.resume_state = s_cal.state;
+        begin_capture(CAL_STATE_TARING, CONFIG_TARE_SAMPLES);
+    } else {
+        err = ESP_ERR_INVALID_STATE;
+    }
+    portEXIT_CRITICAL(&s_cal_lock);
+    return err;
+}
+
+/**
+ * @brief Queue a direct scale-factor change.
+ */
+esp_err_t calibration_request_scale(float scale)
+{
+    if (scale == 0.0f) return ESP_ERR_INVALID_ARG;
+
+    esp_err_t err = ESP_OK;
+
+    portENTER_CRITICAL(&s_cal_lock);
+    if (s_cal.state == CAL_STATE_FITTING) {
+        err = ESP_ERR_INVALID_STATE;
+    } else {
+        s_cal.pending_scale = scale;
+        s_cal.scale_pending = true;
+    }
+    portEXIT_CRITICAL(&s_cal_lock);
+    return err;
+}
+
+/**
+ * @brief Feed one raw sample into the state machine.
+ */
+bool calibration_feed(hx711_dev_t *dev, int32_t raw)
+{
+    bool    apply_tare = false, apply_fit = false, apply_scale = false;
+    int32_t new_tare   = 0;
+    float   new_scale  = 0.0f;
+    float   resid      = 0.0f;
+    esp_err_t fit_err  = ESP_OK;
+
+    portENTER_CRITICAL(&s_cal_lock);
+    s_cal.scale = dev->scale;
+    s_cal.tare  = dev->tare;
+
+    switch (s_cal.state) {
+    case CAL_STATE_CAPTURING:
+    case CAL_STATE_TARING:
+        s_cal.capture_sum += raw;
+        if (++s_cal.capture_count < s_cal.capture_target) break;
+
+        s_cal.last_raw    = (int32_t)(s_cal.capture_sum / s_cal.capture_count);
+        s_cal.last_result = ESP_OK;
+        if (s_cal.state == CAL_STATE_CAPTURING) {
+            s_cal.points[s_cal.point_count].grams = s_cal.capture_grams;
+            s_cal.points[s_cal.point_count].raw   = s_cal.last_raw;
+            s_cal.point_count++;
+            s_cal.state = CAL_STATE_SESSION;
+        } else {
+            new_tare    = s_cal.last_raw;
+            apply_tare  = true;
+            s_cal.state = s_cal.resume_state;
+        }
+        break;
+
+    case CAL_STATE_FITTING:
+        fit_err = fit_points(s_cal.points, s_cal.point_count,
+                             &new_scale, &new_tare, &resid);
+        s_cal.last_result = fit_err;
+        if (fit_err == ESP_OK) {
+            s_cal.max_residual_g = resid;
+            s_cal.state          = CAL_STATE_IDLE;
+            apply_fit            = true;
+        } else {
+            s_cal.state = CAL_STATE_SESSION;   /* let the operator add points */
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    if (s_cal.scale_pending && !apply_fit) {
+        new_scale           = s_cal.pending_scale;
+        s_cal.scale_pending = false;
+        apply_scale         = true;
+    }
+    portEXIT_CRITICAL(&s_cal_lock);
+
+    if (fit_err != ESP_OK) {
+        ESP_LOGW(TAG, "Calibration fit failed: %s", esp_err_to_name(fit_err));
+    }
+    if (!apply_tare && !apply_fit && !apply_scale) return false;
 
-    printf("      Measuring (%d samples)...\n", CONFIG_TARE_SAMPLES);
-    int32_t avg_loaded = 0;
-    err = hx711_read_average(dev, CONFIG_TARE_SAMPLES, &avg_loaded);
+    if (apply_fit || apply_scale) hx711_set_scale(dev, new_scale);
+    if (apply_fit || apply_tare)  dev->tare = new_tare;
+    if (apply_fit) {
+        ESP_LOGI(TAG, "Fit: scale=%.4f counts/g  tare=%" PRId32 "  max residual=%.2f g",
+                 new_scale, new_tare, resid);
+    }
+
+    /* NVS write happens here, off the httpd task; the stream ring
+     * buffers samples for its duration. */
+    esp_err_t err = calibration_save(dev);
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Measurement failed: %s", esp_err_to_name(err));
-        return err;
+        ESP_LOGE(TAG, "NVS save failed: %s", esp_err_to_name(err));
+        portENTER_CRITICAL(&s_cal_lock);
+        s_cal.last_result = err;
+        portEXIT_CRITICAL(&s_cal_lock);
     }
+    return true;
+}
 
-    int32_t delta = avg_loaded - dev->tare;
-    if (delta == 0) {
-        ESP_LOGE(TAG, "No change detected; check wiring.");
-        return ESP_FAIL;
+/**
+ * @brief Read a snapshot of the state machine.
+ */
+void calibration_get_status(calibration_status_t *status)
+{
+    portENTER_CRITICAL(&s_cal_lock);
+    status->state          = s_cal.state;
+    status->points         = s_cal.point_count;
+    status->captured       = s_cal.capture_count;
+    status->last_raw       = s_cal.last_raw;
+    status->last_result    = s_cal.last_result;
+    status->scale          = s_cal.scale;
+    status->tare           = s_cal.tare;
+    status->max_residual_g = s_cal.max_residual_g;
+    portEXIT_CRITICAL(&s_cal_lock);
+}
+
+/**
+ * @brief Return a short lowercase name for a state.
+ */
+const char *calibration_state_name(calibration_state_t state)
+{
+    switch (state) {
+    case CAL_STATE_IDLE:      return "idle";
+    case CAL_STATE_SESSION:   return "session";
+    case CAL_STATE_CAPTURING: return "capturing";
+    case CAL_STATE_TARING:    return "taring";
+    case CAL_STATE_FITTING:   return "fitting";
+    default:                  return "unknown";
     }
+}
+
+/* ── UART wizard ──────────────────────────────────────────────────── */
 
-    float new_scale = (float)delta / ref_grams;
-    err = hx711_set_scale(dev, new_scale);
+/**
+ * @brief Run the interactive UART calibration wizard.
+ *
+ * Step 1 – Zero: prompts operator to clear the platform, then captures a
+ *           0 g reference point.
+ * Step 2 – References: prompts for reference weights until a blank line
+ *           is entered; each is captured as another point.
+ * Step 3 – Fit + save: least-squares fit over all points, applied and
+ *           persisted by the measurement task.
+ */
+esp_err_t calibration_run(hx711_dev_t *dev)
+{
+    char buf[32];
+    calibration_status_t st;
+
+    printf("\n========================================\n");
+    printf("      Digital Scale Calibration Wizard  \n");
+    printf("========================================\n\n");
+
+    esp_err_t err = calibration_start();
     if (err != ESP_OK) return err;
 
-    printf("      Loaded avg : %" PRId32 " raw counts\n", avg_loaded);
-    printf("      Delta      : %" PRId32 " raw counts\n", delta);
-    printf("      Scale factor: %.4f counts/g\n\n", new_scale);
+    /* ── Step 1: Zero point ── */
+    printf("[1/3] Remove ALL weight from the platform.\n");
+    printf("      Press ENTER when ready...\n");
+    read_line(buf, sizeof(buf));
+
+    printf("      Capturing zero point (%d samples)...\n", CONFIG_CAL_POINT_SAMPLES);
+    err = calibration_capture_point(0.0f);
+    if (err == ESP_OK) err = wait_step_done();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Zero capture failed: %s", esp_err_to_name(err));
+        calibration_cancel();
+        return err;
+    }
+    calibration_get_status(&st);
+    printf("      Zero point: %" PRId32 " raw counts\n\n", st.last_raw);
+
+    /* ── Step 2: Reference weights ── */
+    while (true) {
+        printf("[2/3] Enter a reference weight in grams (blank to finish): ");
+        fflush(stdout);
+        read_line(buf, sizeof(buf));
+
+        if (buf[0] == '\0') {
+            calibration_get_status(&st);
+            if (st.points >= 2) break;
+            printf("      At least one reference weight is required.\n");
+            continue;
+        }
+
+        float ref_grams = 0.0f;
+        if (sscanf(buf, "%f", &ref_grams) != 1 || ref_grams <= 0.0f) {
+            printf("      Invalid reference weight: '%s'\n", buf);
+            continue;
+        }
+
+        printf("      Place the %.1f g reference weight on the platform.\n", ref_grams);
+        printf("      Press ENTER when ready...\n");
+        read_line(buf, sizeof(buf));
+
+        err = calibration_capture_point(ref_grams);
+        if (err == ESP_ERR_NO_MEM) {
+            printf("      Point limit (%d) reached.\n", CALIBRATION_MAX_POINTS);
+            break;
+        }
+        if (err == ESP_OK) err = wait_step_done();
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Measurement failed: %s", esp_err_to_name(err));
+            calibration_cancel();
+            return err;
+        }
+        calibration_get_status(&st);
+        printf("      Captured: %" PRId32 " raw counts (%u points)\n\n",
+               st.last_raw, (unsigned)st.points);
+    }
 
-    /* ── Step 3: Save ── */
-    printf("[3/3] Saving calibration to NVS...\n");
-    err = calibration_save(dev);
+    /* ── Step 3: Fit + save ── */
+    printf("[3/3] Fitting and saving calibration...\n");
+    err = calibration_finish();
+    if (err == ESP_OK) err = wait_step_done();
     if (err != ESP_OK) {
-        ESP_LOGE(TAG, "NVS save failed: %s", esp_err_to_name(err));
+        ESP_LOGE(TAG, "Calibration failed: %s", esp_err_to_name(err));
+        calibration_cancel();
         return err;
     }
 
+    calibration_get_status(&st);
+    printf("      Scale factor: %.4f counts/g\n", st.scale);
+    printf("      Tare        : %" PRId32 " raw counts\n", st.tare);
+    printf("      Max residual: %.2f g\n", st.max_residual_g);
     printf("      Calibration saved successfully!\n");
     printf("========================================\n\n");
     return ESP_OK;
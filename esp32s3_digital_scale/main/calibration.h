@@ -1,11 +1,19 @@
 /**
  * @file calibration.h
- * @brief Calibration subsystem – NVS persistence and guided wizard.
+ * @brief Calibration subsystem – NVS persistence, state machine, and wizard.
  *
- * Provides an interactive UART-driven calibration flow:
- *   1. Tare (zero-point capture) with empty platform.
- *   2. Place known reference weight.
- *   3. Compute and store the scale factor.
+ * Calibration runs as a state machine fed by the measurement task with
+ * every raw sample it already consumes, so weighing never stops and no
+ * caller other than the measurement task touches the HX711:
+ *   1. calibration_start() opens a multi-point session.
+ *   2. calibration_capture_point() averages the next samples at a known
+ *      reference weight (0 g for the empty platform).
+ *   3. calibration_finish() fits raw = tare + scale × grams by least
+ *      squares over all points and stores the result via calibration_save().
+ *
+ * Tare and direct scale changes use the same path.  Requests return
+ * immediately; progress is read back with calibration_get_status().
+ * The UART wizard (calibration_run) is a client of the same API.
  *
  * Results are persisted to NVS so they survive reboots.
  *
@@ -17,6 +25,8 @@
 #ifndef CALIBRATION_H
 #define CALIBRATION_H
 
+#include <stdbool.h>
+#include <stddef.h>
 #include "esp_err.h"
 #include "hx711.h"
 
@@ -24,14 +34,119 @@
 extern "C" {
 #endif
 
+/** Maximum reference points in one calibration session. */
+#define CALIBRATION_MAX_POINTS 8
+
+/** @brief Calibration state machine states. */
+typedef enum {
+    CAL_STATE_IDLE = 0,   /**< No session; weighing only              */
+    CAL_STATE_SESSION,    /**< Session open, waiting for next command */
+    CAL_STATE_CAPTURING,  /**< Averaging samples for a reference point */
+    CAL_STATE_TARING,     /**< Averaging samples for a tare            */
+    CAL_STATE_FITTING,    /**< Fit + save pending in measurement task  */
+} calibration_state_t;
+
+/** @brief Snapshot of the calibration state machine. */
+typedef struct {
+    calibration_state_t state;          /**< Current state                        */
+    size_t              points;         /**< Reference points captured            */
+    uint32_t            captured;       /**< Samples in the running capture       */
+    int32_t             last_raw;       /**< Average of the last completed capture */
+    esp_err_t           last_result;    /**< Result of the last completed step    */
+    float               scale;          /**< Applied scale (counts per gram)      */
+    int32_t             tare;           /**< Applied tare (raw counts)            */
+    float               max_residual_g; /**< Worst point residual of last fit     */
+} calibration_status_t;
+
 /**
- * @brief Run the interactive calibration wizard over the UART console.
+ * @brief Open a multi-point calibration session, discarding old points.
+ *
+ * @return ESP_OK; ESP_ERR_INVALID_STATE while a capture or fit is running.
+ */
+esp_err_t calibration_start(void);
+
+/**
+ * @brief Capture a reference point from the next CONFIG_CAL_POINT_SAMPLES samples.
+ *
+ * @param[in] ref_grams Weight on the platform in grams (≥ 0).
+ * @return ESP_OK when the capture has started; ESP_ERR_INVALID_STATE if
+ *         no session is open or a capture is running; ESP_ERR_NO_MEM when
+ *         CALIBRATION_MAX_POINTS points exist; ESP_ERR_INVALID_ARG.
+ */
+esp_err_t calibration_capture_point(float ref_grams);
+
+/**
+ * @brief Fit, apply, and save the session's points.
  *
- * Walks the operator through taring and a known-weight measurement,
- * computes the scale factor, and saves it to NVS.
+ * The fit runs on the next sample fed by the measurement task; the
+ * outcome is reported in calibration_status_t::last_result.
+ *
+ * @return ESP_OK when the fit is queued; ESP_ERR_INVALID_STATE if no
+ *         session is open; ESP_ERR_INVALID_SIZE with fewer than 2 points.
+ */
+esp_err_t calibration_finish(void);
+
+/**
+ * @brief Abandon the current session or capture.
+ */
+void calibration_cancel(void);
+
+/**
+ * @brief Capture a new tare from the next CONFIG_TARE_SAMPLES samples and save it.
+ *
+ * @return ESP_OK when the tare has started; ESP_ERR_INVALID_STATE while
+ *         another capture or fit is running.
+ */
+esp_err_t calibration_request_tare(void);
+
+/**
+ * @brief Apply and save a scale factor on the next sample.
+ *
+ * @param[in] scale Raw counts per gram (non-zero).
+ * @return ESP_OK when queued; ESP_ERR_INVALID_ARG or ESP_ERR_INVALID_STATE.
+ */
+esp_err_t calibration_request_scale(float scale);
+
+/**
+ * @brief Feed one raw sample into the state machine.
+ *
+ * Called by the measurement task, the only task that changes @p dev,
+ * for every raw sample before it is converted.  Completed tares, fits,
+ * and scale changes are applied to @p dev and saved to NVS here.
  *
  * @param[in] dev Initialised HX711 device handle.
- * @return ESP_OK on success; NVS or ADC error otherwise.
+ * @param[in] raw Raw sample (sign-extended 24-bit).
+ * @return true when the calibration of @p dev changed with this sample.
+ */
+bool calibration_feed(hx711_dev_t *dev, int32_t raw);
+
+/**
+ * @brief Read a snapshot of the state machine.
+ *
+ * @param[out] status Current status.
+ */
+void calibration_get_status(calibration_status_t *status);
+
+/**
+ * @brief Return a short lowercase name for a state ("idle", "capturing", …).
+ *
+ * @param[in] state State to name.
+ * @return Static string.
+ */
+const char *calibration_state_name(calibration_state_t state);
+
+/**
+ * @brief Run the interactive calibration wizard over the UART console.
+ *
+ * Walks the operator through an empty-platform point and any number of
+ * known-weight points, then fits and saves the result.  Blocks its caller
+ * on console input, but samples are captured by the measurement task
+ * through the state machine, so weighing continues meanwhile.  Must not
+ * be called from the measurement task.
+ *
+ * @param[in] dev Initialised HX711 device handle (for reporting only).
+ * @return ESP_OK on success; ESP_ERR_TIMEOUT if captures stall; fit or
+ *         NVS error otherwise.
  */
 esp_err_t calibration_run(hx711_dev_t *dev);
 
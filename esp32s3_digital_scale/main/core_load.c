@@ -0,0 +1,94 @@
+/**
+ * @file core_load.c
+ * @brief Idle-task based per-core load sampler.
+ *
+ * With the esp_timer run-time clock the idle counters tick in
+ * microseconds, so each period's idle time is compared directly with the
+ * esp_timer time elapsed.  Counter wrap-around is harmless because only
+ * differences over one short period are used.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.0.0
+ * @date    2025
+ */
+
+#include "core_load.h"
+#include "scale_config.h"
+
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "CORE_LOAD";
+
+/** Latest load per core, -1 until the first period completes. */
+static atomic_int s_load[portNUM_PROCESSORS] = { [0 ... portNUM_PROCESSORS - 1] = -1 };
+
+#if CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+
+static esp_timer_handle_t         s_timer = NULL;
+static configRUN_TIME_COUNTER_TYPE s_last_idle[portNUM_PROCESSORS];
+static int64_t                    s_last_us = 0;
+
+/**
+ * @brief Read every idle counter and turn the deltas into a load.
+ *
+ * @param[in] arg Unused.
+ */
+static void core_load_sample(void *arg)
+{
+    const int64_t now_us     = esp_timer_get_time();
+    const int64_t elapsed_us = now_us - s_last_us;
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        const configRUN_TIME_COUNTER_TYPE idle =
+            ulTaskGetRunTimeCounter(xTaskGetIdleTaskHandleForCore(core));
+
+        if (s_last_us != 0 && elapsed_us > 0) {
+            const int64_t idle_us = (configRUN_TIME_COUNTER_TYPE)(idle - s_last_idle[core]);
+            int busy = 100 - (int)(idle_us * 100 / elapsed_us);
+            if (busy < 0)   busy = 0;
+            if (busy > 100) busy = 100;
+            atomic_store(&s_load[core], busy);
+        }
+        s_last_idle[core] = idle;
+    }
+    s_last_us = now_us;
+}
+
+esp_err_t core_load_start(void)
+{
+    if (s_timer) return ESP_OK;
+
+    const esp_timer_create_args_t args = {
+        .callback = core_load_sample,
+        .name     = "core_load",
+    };
+    esp_err_t err = esp_timer_create(&args, &s_timer);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "esp_timer_create failed: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    core_load_sample(NULL);   /* baseline for the first period */
+    return esp_timer_start_periodic(s_timer, CONFIG_CORE_LOAD_PERIOD_MS * 1000ULL);
+}
+
+#else /* !CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS */
+
+esp_err_t core_load_start(void)
+{
+    ESP_LOGW(TAG, "CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS is off; core load unavailable");
+    return ESP_ERR_NOT_SUPPORTED;
+}
+
+#endif /* CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS */
+
+int core_load_percent(int core)
+{
+    if (core < 0 || core >= portNUM_PROCESSORS) return -1;
+    return atomic_load(&s_load[core]);
+}
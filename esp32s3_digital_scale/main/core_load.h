@@ -0,0 +1,49 @@
+/**
+ * @file core_load.h
+ * @brief Per-core CPU load, sampled from the FreeRTOS idle tasks.
+ *
+ * Every CONFIG_CORE_LOAD_PERIOD_MS an esp_timer callback reads the
+ * run-time counter of each core's idle task; the share of the period a
+ * core did not spend idling is its load.  The latest values are kept in
+ * atomics so /api/status can read them without a lock.
+ *
+ * Requires CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS with the esp_timer
+ * clock source (see sdkconfig.defaults); without it core_load_start()
+ * returns ESP_ERR_NOT_SUPPORTED and every load reads as -1.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.0.0
+ * @date    2025
+ */
+
+#ifndef CORE_LOAD_H
+#define CORE_LOAD_H
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Start the periodic load sampler.
+ *
+ * @return ESP_OK on success; ESP_ERR_NOT_SUPPORTED without run-time
+ *         stats; esp_timer error otherwise.
+ */
+esp_err_t core_load_start(void);
+
+/**
+ * @brief Return the load of one core over the last sampling period.
+ *
+ * @param[in] core Core index (0 or 1).
+ * @return Busy percentage 0 – 100; -1 before the first period, without
+ *         run-time stats, or for an invalid core.
+ */
+int core_load_percent(int core);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CORE_LOAD_H */
@@ -2,18 +2,27 @@
  * @file main.c
  * @brief ESP32-S3 Digital Scale – application entry point.
  *
- * Boot sequence:
- *   1. Initialise NVS flash.
- *   2. Initialise and connect Wi-Fi.
- *   3. Initialise the HX711 driver and load saved calibration from NVS.
- *   4. Perform an initial tare.
- *   5. Start the HTTP / SSE web server.
- *   6. Launch the measurement task (reads HX711, pushes SSE events).
+ * Boot graph (init_graph component; arrows are dependencies):
  *
- * Two FreeRTOS tasks run concurrently after boot:
- *   - task_measure  : reads weight and pushes SSE updates.
- *   - (HTTP server) : handled internally by esp_http_server on its own
- *                     task pool.
+ *   NVS ──────────────┬──► Wi-Fi ───────────────────┐
+ *                     ▼                             ▼
+ *   HX711 ──► calibration load ──► tare ──┬──► web server
+ *                                         └──► measurement task
+ *   core load sampler
+ *
+ * Branches without a path between them run concurrently, so the Wi-Fi
+ * association on CONFIG_NETWORK_CORE overlaps the HX711 settle and tare
+ * on CONFIG_MEASURE_CORE, and weighing starts without waiting for the
+ * network.  The measurement task switches the HX711 to interrupt-driven
+ * stream mode once it runs.  A per-module boot timeline is logged.
+ *
+ * The two cores are split by role.  CONFIG_MEASURE_CORE runs the
+ * measurement pipeline:
+ *   - hx711_stream  : reads every conversion on the DOUT ready interrupt.
+ *   - task_measure  : feeds every sample to calibration and the filter,
+ *                     then publishes the weight.
+ * CONFIG_NETWORK_CORE runs Wi-Fi, lwIP, the esp_http_server task and the
+ * SSE broadcaster, so request bursts cannot delay a conversion readout.
  *
  * @author  ESP32-S3 Scale Project
  * @version 1.0.0
@@ -24,55 +33,170 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 #include "nvs_flash.h"
 
 #include "scale_config.h"
 #include "hx711.h"
+#include "hx711_stream.h"
 #include "calibration.h"
-#include "wifi_manager.h"
+#include "core_load.h"
+#include "init_graph.h"
+#include "metrics.h"
+#include "wifi_sta.h"
 #include "web_server.h"
+#include "weight_filter.h"
 
 static const char *TAG = "MAIN";
 
 /* Global HX711 device handle shared between tasks */
 static hx711_dev_t s_hx711;
 
+/* Runtime metrics of the measurement pipeline, registered by init_metrics() */
+static metric_t *s_m_samples;       /* raw samples processed         */
+static metric_t *s_m_read_errors;   /* failed HX711 reads            */
+static metric_t *s_m_process_us;    /* calibration + filter per batch */
+
 /* ── Tasks ────────────────────────────────────────────────────────── */
 
+/**
+ * @brief Process one raw sample: calibration first, then the filter.
+ *
+ * When the calibration state machine applies a new tare or scale, the
+ * filter history (in the old units) is discarded.
+ *
+ * @param[in]  filter Weight filter state.
+ * @param[in]  raw    Raw HX711 sample.
+ * @param[out] out    Filter output after this sample.
+ */
+static void process_sample(weight_filter_t *filter, int32_t raw,
+                           weight_filter_output_t *out)
+{
+    if (calibration_feed(&s_hx711, raw)) {
+        weight_filter_reset(filter);
+    }
+
+    float grams = 0.0f;
+    hx711_raw_to_weight(&s_hx711, raw, &grams);
+    weight_filter_push(filter, grams, out);
+}
+
+/**
+ * @brief Feed every sample acquired since the last call through the filter.
+ *
+ * In stream mode every conversion queued since the previous call is
+ * drained from the ring and processed one by one, so no conversion is
+ * wasted and the call never busy-waits.  Otherwise one average of
+ * CONFIG_SCALE_SAMPLES polled conversions is processed.
+ *
+ * @param[in]  filter Weight filter state.
+ * @param[out] out    Filter output after the newest sample.
+ * @return ESP_OK on success; propagated HX711 error otherwise.
+ */
+static esp_err_t measure_weight(weight_filter_t *filter,
+                                weight_filter_output_t *out)
+{
+    if (!hx711_stream_is_running(&s_hx711)) {
+        int32_t raw = 0;
+        esp_err_t err = hx711_read_average(&s_hx711, CONFIG_SCALE_SAMPLES, &raw);
+        if (err != ESP_OK) return err;
+        const int64_t start_us = esp_timer_get_time();
+        process_sample(filter, raw, out);
+        metrics_observe(s_m_process_us, (uint32_t)(esp_timer_get_time() - start_us));
+        metrics_inc(s_m_samples);
+        return ESP_OK;
+    }
+
+    int32_t batch[CONFIG_HX711_STREAM_DEPTH];
+    size_t  count = 0;
+    esp_err_t err = hx711_stream_read(&s_hx711, batch, CONFIG_HX711_STREAM_DEPTH,
+                                      pdMS_TO_TICKS(HX711_READY_TIMEOUT_MS),
+                                      &count);
+    if (err != ESP_OK) return err;
+
+    const int64_t start_us = esp_timer_get_time();
+    for (size_t i = 0; i < count; i++) {
+        process_sample(filter, batch[i], out);
+    }
+    metrics_observe(s_m_process_us, (uint32_t)(esp_timer_get_time() - start_us));
+    metrics_add(s_m_samples, count);
+    return ESP_OK;
+}
+
+/**
+ * @brief Switch the HX711 to interrupt-driven stream mode.
+ *
+ * Called from the measurement task: the GPIO ISR service and the SPI
+ * interrupt are allocated on the calling core, so starting the stream
+ * here keeps the DOUT interrupt on CONFIG_MEASURE_CORE with the rest of
+ * the pipeline.  On failure the task falls back to polled reads.
+ */
+static void start_stream(void)
+{
+    const hx711_stream_config_t stream_cfg = {
+        .spi_host      = CONFIG_HX711_SPI_HOST,
+        .clock_hz      = CONFIG_HX711_SPI_CLOCK_HZ,
+        .depth         = CONFIG_HX711_STREAM_DEPTH,
+        .task_priority = CONFIG_HX711_STREAM_PRIORITY,
+        .task_core     = CONFIG_HX711_STREAM_CORE,
+    };
+    esp_err_t err = hx711_stream_start(&s_hx711, &stream_cfg);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "HX711 stream mode unavailable (%s) – polling instead",
+                 esp_err_to_name(err));
+    }
+}
+
 /**
  * @brief Weight measurement task.
  *
- * Runs at CONFIG_MEASURE_TASK_PRIORITY, waking every
+ * Pinned to CONFIG_MEASURE_CORE; starts stream mode, then runs at
+ * CONFIG_MEASURE_TASK_PRIORITY, waking every
  * CONFIG_MEASURE_INTERVAL_MS milliseconds.  Each iteration:
- *   1. Reads CONFIG_SCALE_SAMPLES averaged ADC counts.
- *   2. Converts to grams (calibration already applied).
- *   3. Clamps readings below CONFIG_ZERO_THRESHOLD_G to 0.
- *   4. Logs the value to the UART console.
- *   5. Pushes the value to any connected SSE browser clients.
+ *   1. Feeds the ADC samples acquired since the last iteration to the
+ *      calibration state machine, then filters them
+ *      (moving median → EMA → stability detector).
+ *   2. Clamps readings below CONFIG_ZERO_THRESHOLD_G to 0.
+ *   3. Logs the value and its stability to the UART console.
+ *   4. Pushes both to any connected SSE browser clients.
  *
  * @param[in] pvParam Unused task parameter.
  */
 static void task_measure(void *pvParam)
 {
-    ESP_LOGI(TAG, "Measurement task started");
+    ESP_LOGI(TAG, "Measurement task started on core %d", xPortGetCoreID());
+    start_stream();
+
+    const weight_filter_config_t filter_cfg = {
+        .median_window  = CONFIG_FILTER_MEDIAN_WINDOW,
+        .ema_alpha      = CONFIG_FILTER_EMA_ALPHA,
+        .stable_band_g  = CONFIG_FILTER_STABLE_BAND_G,
+        .stable_samples = CONFIG_FILTER_STABLE_SAMPLES,
+    };
+    weight_filter_t filter;
+    weight_filter_init(&filter, &filter_cfg);
 
     TickType_t last_wake = xTaskGetTickCount();
 
     while (true) {
-        float grams = 0.0f;
-        esp_err_t err = hx711_get_weight(&s_hx711, CONFIG_SCALE_SAMPLES, &grams);
+        weight_filter_output_t out;
+        esp_err_t err = measure_weight(&filter, &out);
 
         if (err == ESP_OK) {
+            float grams = out.grams;
+
             /* Zero-clamp noise near tare */
             if (grams < CONFIG_ZERO_THRESHOLD_G && grams > -CONFIG_ZERO_THRESHOLD_G) {
                 grams = 0.0f;
             }
 
-            ESP_LOGI(TAG, "Weight: %.2f g  (%.3f kg  /  %.3f lb)",
-                     grams, grams / 1000.0f, grams / 453.592f);
+            ESP_LOGI(TAG, "Weight: %.2f g  (%.3f kg  /  %.3f lb)  %s",
+                     grams, grams / 1000.0f, grams / 453.592f,
+                     out.stable ? "stable" : "settling");
 
-            web_server_push_weight(grams);
+            web_server_push_weight(grams, out.stable);
         } else {
+            metrics_inc(s_m_read_errors);
             ESP_LOGW(TAG, "HX711 read error: %s", esp_err_to_name(err));
         }
 
@@ -80,72 +204,196 @@ static void task_measure(void *pvParam)
     }
 }
 
-/* ── app_main ─────────────────────────────────────────────────────── */
+/* ── Boot modules ─────────────────────────────────────────────────── */
 
-/**
- * @brief Application entry point called by the ESP-IDF startup code.
- *
- * Orchestrates the full system initialisation sequence described in the
- * file-level docstring, then launches the measurement task and returns.
- * The FreeRTOS scheduler continues running the tasks indefinitely.
- */
-void app_main(void)
-{
-    ESP_LOGI(TAG, "=== ESP32-S3 Digital Scale v1.0.0 ===");
+/** Module indices, in dependency order (see the boot graph above). */
+enum {
+    MOD_NVS,
+    MOD_HX711,
+    MOD_WIFI,
+    MOD_CALIBRATION,
+    MOD_TARE,
+    MOD_CORE_LOAD,
+    MOD_METRICS,
+    MOD_MEASURE,
+    MOD_WEB,
+    MOD_COUNT
+};
 
-    /* ── 1. NVS ── */
+static esp_err_t init_nvs(void *arg)
+{
     esp_err_t err = nvs_flash_init();
     if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
         ESP_LOGW(TAG, "NVS partition was truncated/upgraded – erasing");
         nvs_flash_erase();
         err = nvs_flash_init();
     }
-    ESP_ERROR_CHECK(err);
+    return err;
+}
 
-    /* ── 2. Wi-Fi ── */
-    ESP_ERROR_CHECK(wifi_manager_init());
-    err = wifi_manager_connect();
-    if (err != ESP_OK) {
-        ESP_LOGE(TAG, "Wi-Fi connection failed. Dashboard will not be available.");
-        /* Continue without Wi-Fi so the scale still works locally */
-    } else {
-        ESP_LOGI(TAG, "Wi-Fi OK – IP: %s", wifi_manager_get_ip());
+static esp_err_t init_wifi(void *arg)
+{
+    const wifi_sta_config_t cfg = {
+        .ssid        = CONFIG_WIFI_SSID,
+        .password    = CONFIG_WIFI_PASSWORD,
+        .max_retries = CONFIG_WIFI_MAX_RETRIES,
+        .ps_profile  = CONFIG_WIFI_PS_PROFILE,
+    };
+    esp_err_t err = wifi_sta_init(&cfg);
+    if (err != ESP_OK) return err;
+
+    err = wifi_sta_connect(NULL, portMAX_DELAY);
+    if (err == ESP_OK) {
+        ESP_LOGI(TAG, "Wi-Fi OK – IP: %s", wifi_sta_get_ip_str());
     }
+    return err;
+}
 
-    /* ── 3. HX711 ── */
-    hx711_config_t hx_cfg = {
+static esp_err_t init_hx711(void *arg)
+{
+    const hx711_config_t hx_cfg = {
         .dout_pin = CONFIG_HX711_DOUT_GPIO,
         .sck_pin  = CONFIG_HX711_SCK_GPIO,
         .gain     = HX711_GAIN_A_128,
     };
-    ESP_ERROR_CHECK(hx711_init(&s_hx711, &hx_cfg));
+    return hx711_init(&s_hx711, &hx_cfg);
+}
 
-    /* Load calibration from NVS, fall back to compile-time defaults */
-    err = calibration_load(&s_hx711);
-    if (err != ESP_OK) {
+/* Load calibration from NVS, fall back to compile-time defaults */
+static esp_err_t init_calibration(void *arg)
+{
+    if (calibration_load(&s_hx711) != ESP_OK) {
         ESP_LOGW(TAG, "No saved calibration – applying compile-time defaults");
         hx711_set_scale(&s_hx711, CONFIG_SCALE_FACTOR);
     }
+    return ESP_OK;
+}
 
-    /* ── 4. Initial tare ── */
+static esp_err_t init_tare(void *arg)
+{
     ESP_LOGI(TAG, "Performing initial tare (%d samples)…", CONFIG_TARE_SAMPLES);
     vTaskDelay(pdMS_TO_TICKS(500)); /* let HX711 settle */
-    ESP_ERROR_CHECK(hx711_tare(&s_hx711, CONFIG_TARE_SAMPLES));
-
-    /* ── 5. Web server ── */
-    if (wifi_manager_is_connected()) {
-        ESP_ERROR_CHECK(web_server_start(&s_hx711));
-        ESP_LOGI(TAG, "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━");
-        ESP_LOGI(TAG, "  Dashboard: http://%s/", wifi_manager_get_ip());
-        ESP_LOGI(TAG, "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━");
+    return hx711_tare(&s_hx711, CONFIG_TARE_SAMPLES);
+}
+
+/* Optional: /api/status reports -1 without it, so a failure is not passed on */
+static esp_err_t init_core_load(void *arg)
+{
+    core_load_start();
+    return ESP_OK;
+}
+
+static int64_t read_stream_overflows(void)
+{
+    hx711_stream_stats_t stats;
+    return hx711_stream_get_stats(&s_hx711, &stats) == ESP_OK ? stats.overflows : 0;
+}
+
+/* Registers the pipeline metrics before the measurement task uses them */
+static esp_err_t init_metrics(void *arg)
+{
+    static const uint32_t process_bounds_us[] = { 50, 100, 200, 500, 1000, 2000, 5000 };
+
+    metrics_register_system();
+    s_m_samples     = metrics_counter("scale_samples_total",
+                                      "Raw HX711 samples through calibration and filter");
+    s_m_read_errors = metrics_counter("scale_read_errors_total",
+                                      "HX711 reads that failed or timed out");
+    s_m_process_us  = metrics_histogram("scale_process_us",
+                                        "Calibration and filter time per batch, microseconds",
+                                        process_bounds_us,
+                                        sizeof(process_bounds_us) / sizeof(process_bounds_us[0]));
+    metrics_sampled(METRIC_COUNTER, "scale_stream_overflows_total",
+                    "Samples lost because the stream ring was full", read_stream_overflows);
+
+    if (CONFIG_METRICS_DUMP_PERIOD_MS > 0) {
+        return metrics_dump_start(CONFIG_METRICS_DUMP_PERIOD_MS);
     }
+    return ESP_OK;
+}
+
+/* The task starts stream mode on its own core */
+static esp_err_t start_measure(void *arg)
+{
+    return xTaskCreatePinnedToCore(task_measure, "scale_measure",
+                                   CONFIG_MEASURE_TASK_STACK,
+                                   NULL,
+                                   CONFIG_MEASURE_TASK_PRIORITY,
+                                   NULL,
+                                   CONFIG_MEASURE_CORE) == pdPASS ? ESP_OK : ESP_ERR_NO_MEM;
+}
+
+static esp_err_t init_web(void *arg)
+{
+    esp_err_t err = web_server_start(&s_hx711);
+    if (err != ESP_OK) return err;
+
+    ESP_LOGI(TAG, "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━");
+    ESP_LOGI(TAG, "  Dashboard: http://%s/", wifi_sta_get_ip_str());
+    ESP_LOGI(TAG, "━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━");
+    return ESP_OK;
+}
+
+static const init_graph_module_t s_modules[MOD_COUNT] = {
+    [MOD_NVS] = {
+        .name = "nvs", .fn = init_nvs, .core = tskNO_AFFINITY,
+    },
+    [MOD_HX711] = {
+        .name = "hx711", .fn = init_hx711, .core = CONFIG_MEASURE_CORE,
+    },
+    [MOD_WIFI] = {
+        .name = "wifi", .fn = init_wifi, .core = CONFIG_NETWORK_CORE,
+        .deps = INIT_GRAPH_DEP(MOD_NVS),
+    },
+    [MOD_CALIBRATION] = {
+        .name = "calibration", .fn = init_calibration, .core = CONFIG_MEASURE_CORE,
+        .deps = INIT_GRAPH_DEP(MOD_NVS) | INIT_GRAPH_DEP(MOD_HX711),
+    },
+    [MOD_TARE] = {
+        .name = "tare", .fn = init_tare, .core = CONFIG_MEASURE_CORE,
+        .deps = INIT_GRAPH_DEP(MOD_CALIBRATION),
+    },
+    [MOD_CORE_LOAD] = {
+        .name = "core_load", .fn = init_core_load, .core = tskNO_AFFINITY,
+    },
+    [MOD_METRICS] = {
+        .name = "metrics", .fn = init_metrics, .core = tskNO_AFFINITY,
+    },
+    [MOD_MEASURE] = {
+        .name = "measure", .fn = start_measure, .core = CONFIG_MEASURE_CORE,
+        .deps = INIT_GRAPH_DEP(MOD_TARE) | INIT_GRAPH_DEP(MOD_METRICS),
+    },
+    [MOD_WEB] = {
+        .name = "web_server", .fn = init_web, .core = CONFIG_NETWORK_CORE,
+        .deps = INIT_GRAPH_DEP(MOD_WIFI) | INIT_GRAPH_DEP(MOD_TARE),
+    },
+};
+
+/* ── app_main ─────────────────────────────────────────────────────── */
 
-    /* ── 6. Measurement task ── */
-    xTaskCreate(task_measure, "scale_measure",
-                CONFIG_MEASURE_TASK_STACK,
-                NULL,
-                CONFIG_MEASURE_TASK_PRIORITY,
-                NULL);
+/**
+ * @brief Application entry point called by the ESP-IDF startup code.
+ *
+ * Runs the boot graph described in the file-level docstring and logs its
+ * timeline.  Wi-Fi is allowed to fail so the scale still works locally;
+ * any other failure is fatal.  The FreeRTOS scheduler continues running
+ * the tasks indefinitely.
+ */
+void app_main(void)
+{
+    ESP_LOGI(TAG, "=== ESP32-S3 Digital Scale v1.0.0 ===");
+
+    init_graph_stage_t stages[MOD_COUNT];
+    init_graph_run(s_modules, MOD_COUNT, stages);   /* per-module results checked below */
+    init_graph_log_timeline(s_modules, MOD_COUNT, stages);
+
+    if (stages[MOD_WIFI].result != ESP_OK) {
+        ESP_LOGE(TAG, "Wi-Fi connection failed. Dashboard will not be available.");
+    }
+    ESP_ERROR_CHECK(stages[MOD_NVS].result);
+    ESP_ERROR_CHECK(stages[MOD_HX711].result);
+    ESP_ERROR_CHECK(stages[MOD_TARE].result);
+    ESP_ERROR_CHECK(stages[MOD_MEASURE].result);
 
     ESP_LOGI(TAG, "System ready.");
 }
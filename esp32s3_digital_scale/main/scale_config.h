@@ -15,6 +15,29 @@
 #ifndef SCALE_CONFIG_H
 #define SCALE_CONFIG_H
 
+/* ── Core split ───────────────────────────────────────────────────── */
+
+/**
+ * Core that runs the measurement pipeline: HX711 acquisition and its
+ * interrupts, calibration, and the weight filter.
+ */
+#define CONFIG_MEASURE_CORE           1
+
+/**
+ * Core that runs httpd and the SSE/WebSocket broadcaster.  Keep it equal
+ * to the Wi-Fi and lwIP task affinity in sdkconfig.defaults.
+ */
+#define CONFIG_NETWORK_CORE           0
+
+/** Period of the per-core load sampler reported on /api/status. */
+#define CONFIG_CORE_LOAD_PERIOD_MS    1000
+
+/**
+ * Period of the METRICS1 line printed on the console (decode with
+ * tools/metrics_decode.py); 0 disables it.  /metrics serves the same data.
+ */
+#define CONFIG_METRICS_DUMP_PERIOD_MS 60000
+
 /* ── HX711 GPIO ───────────────────────────────────────────────────── */
 
 /** GPIO connected to HX711 DOUT (data output). */
@@ -23,17 +46,47 @@
 /** GPIO connected to HX711 SCK (serial clock / PD_SCK). */
 #define CONFIG_HX711_SCK_GPIO         5
 
+/** SPI host that clocks the HX711 in stream mode. */
+#define CONFIG_HX711_SPI_HOST         SPI2_HOST
+
+/** HX711 SCK frequency in stream mode (500 kHz = 1 µs HIGH / 1 µs LOW). */
+#define CONFIG_HX711_SPI_CLOCK_HZ     500000
+
+/** Samples buffered between measurement-task wake-ups (≥ 80 SPS × interval). */
+#define CONFIG_HX711_STREAM_DEPTH     64
+
+/** Priority of the HX711 acquisition task (above the measurement task). */
+#define CONFIG_HX711_STREAM_PRIORITY  10
+
+/** Core the HX711 acquisition task is pinned to. */
+#define CONFIG_HX711_STREAM_CORE      CONFIG_MEASURE_CORE
+
 /* ── Measurement ──────────────────────────────────────────────────── */
 
-/** ADC samples averaged per weight reading (higher = less noise, more latency). */
+/** ADC samples averaged per weight reading in polled mode (higher = less noise, more latency). */
 #define CONFIG_SCALE_SAMPLES          10
 
 /** Interval in ms between consecutive weight readings. */
 #define CONFIG_MEASURE_INTERVAL_MS    500
 
+/** Moving-median window in samples (odd; rejects single-sample spikes). */
+#define CONFIG_FILTER_MEDIAN_WINDOW   7
+
+/** EMA weight of each new median (lower = smoother, slower). */
+#define CONFIG_FILTER_EMA_ALPHA       0.15f
+
+/** Max filtered drift in grams while the weight counts as settling. */
+#define CONFIG_FILTER_STABLE_BAND_G   3.0f
+
+/** Consecutive in-band samples before the weight is "stable" (0.5 s @ 80 SPS). */
+#define CONFIG_FILTER_STABLE_SAMPLES  40
+
 /** Samples averaged during a tare operation. */
 #define CONFIG_TARE_SAMPLES           20
 
+/** Samples averaged per multi-point calibration reference (1 s @ 80 SPS). */
+#define CONFIG_CAL_POINT_SAMPLES      80
+
 /** Default scale factor (raw counts per gram). Replace after calibration. */
 #define CONFIG_SCALE_FACTOR           430.0f
 
@@ -54,6 +107,13 @@
 /** Maximum Wi-Fi connection attempts before giving up. */
 #define CONFIG_WIFI_MAX_RETRIES       5
 
+/**
+ * Modem sleep while connected (wifi_sta.h). The dashboard answers requests
+ * from the browser, which would otherwise wait for the next DTIM wake, and
+ * the scale runs from mains power, so the receiver stays on.
+ */
+#define CONFIG_WIFI_PS_PROFILE        WIFI_STA_PS_LOW_LATENCY
+
 /* ── Web Server ───────────────────────────────────────────────────── */
 
 /** TCP port the HTTP server listens on. */
@@ -62,6 +122,13 @@
 /** Maximum simultaneous HTTP connections. */
 #define CONFIG_WEBSERVER_MAX_SOCKETS  4
 
+/**
+ * Scratch arena for request bodies, JSON responses, and the WebSocket
+ * replay frame; reset after every request.  Must hold the full replay
+ * frame (8 + 6 bytes per history sample).  Placed in PSRAM when present.
+ */
+#define CONFIG_WEBSERVER_ARENA_SIZE   6144
+
 /** Server-Sent Events endpoint path (used by the dashboard). */
 #define CONFIG_SSE_URI                "/events"
 
@@ -80,6 +147,15 @@
 /** Interval in ms between SSE weight-push events. */
 #define CONFIG_SSE_PUSH_INTERVAL_MS   500
 
+/** Maximum concurrent SSE clients. */
+#define CONFIG_SSE_MAX_CLIENTS        4
+
+/** Maximum concurrent /ws clients (MAX_SOCKETS + SSE + WS ≤ LWIP_MAX_SOCKETS − 3). */
+#define CONFIG_WS_MAX_CLIENTS         4
+
+/** Seconds of published weight kept on-device for WebSocket replay. */
+#define CONFIG_WS_HISTORY_SECONDS     300
+
 /* ── FreeRTOS Tasks ───────────────────────────────────────────────── */
 
 /** Stack in bytes for the weight-measurement task. */
@@ -88,10 +164,10 @@
 /** Priority for the measurement task. */
 #define CONFIG_MEASURE_TASK_PRIORITY  5
 
-/** Stack in bytes for the SSE push task. */
+/** Stack in bytes for the SSE broadcaster task. */
 #define CONFIG_SSE_TASK_STACK         4096
 
-/** Priority for the SSE push task. */
+/** Priority for the SSE broadcaster task. */
 #define CONFIG_SSE_TASK_PRIORITY      4
 
 /* ── NVS ──────────────────────────────────────────────────────────── */
@@ -2,10 +2,42 @@
  * @file web_server.c
  * @brief HTTP server, REST API, and SSE implementation.
  *
- * The dashboard HTML/CSS/JS is embedded directly in flash as a C string
- * literal (no SPIFFS/LittleFS required).  The SSE stream is implemented
- * with chunked transfer encoding so the browser receives live weight
- * updates at CONFIG_SSE_PUSH_INTERVAL_MS intervals.
+ * The dashboard HTML/CSS/JS is gzipped at build time and embedded in
+ * flash as a binary blob (no SPIFFS/LittleFS required).
+ *
+ * SSE fan-out is event driven.  web_server_push_weight() only overwrites
+ * a one-slot mailbox, so the measurement task never waits on a socket.
+ * A broadcaster task formats each event once into a reference-counted
+ * buffer and hands it to every client; the bytes are written from the
+ * httpd task via httpd_queue_work() with non-blocking sends.  A client
+ * that is still sending an older event keeps only the newest pending
+ * one, so stale weights are coalesced instead of queued.
+ *
+ * The newest sample also lives in a seqlock cell (weight_cell.h), which
+ * /api/weight and the WebSocket replay read without taking a lock; the
+ * measurement task on CONFIG_MEASURE_CORE therefore never waits for a
+ * request handler.  httpd and the broadcaster are pinned to
+ * CONFIG_NETWORK_CORE, next to the Wi-Fi and lwIP tasks.
+ *
+ * Short-lived buffers built while serving a request (request body, JSON
+ * response, replay frame) come from a bump arena reserved at start-up
+ * and reset when the request or work item finishes, so days of traffic
+ * do not fragment internal RAM.  The arena is only touched from the
+ * httpd task, which runs handlers and queued work one at a time.
+ *
+ * The /ws WebSocket carries the same samples as packed binary frames.
+ * Every published sample is also appended to a history ring (PSRAM when
+ * available); a connecting client first receives the whole ring as one
+ * replay frame, then one small live frame per sample.  Both frame types
+ * are little-endian:
+ *
+ *   replay: u8 type=1, u8 flags, u16 count, u32 t0_ms,
+ *           count × { u16 dt_ms, i32 weight_mg }
+ *   live:   u8 type=2, u8 flags, u16 dt_ms, i32 weight_mg
+ *
+ * flags bit 0 is the stable flag of the newest sample.  dt_ms is the
+ * time since the previous sample the client received (0 for the first
+ * replay record), saturated at 65535.
  *
  * @author  ESP32-S3 Scale Project
  * @version 1.0.0
@@ -14,13 +46,26 @@
 
 #include "web_server.h"
 #include "scale_config.h"
-#include "wifi_manager.h"
+#include "wifi_sta.h"
+#include "calibration.h"
+#include "core_load.h"
+#include "weight_cell.h"
+#include "arena.h"
+#include "metrics.h"
 
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <errno.h>
+#include <stdatomic.h>
+#include <unistd.h>
 #include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
 #include "freertos/semphr.h"
 #include "esp_http_server.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 #include "cJSON.h"
@@ -33,19 +78,80 @@ static const char *TAG = "WEB_SERVER";
 
 static httpd_handle_t  s_server     = NULL;
 static hx711_dev_t    *s_dev        = NULL;
-static float           s_last_weight_g = 0.0f;
-static SemaphoreHandle_t s_weight_mutex = NULL;
-
-/* Track open SSE socket descriptors (simple fixed array) */
-#define MAX_SSE_CLIENTS 4
-static int s_sse_fds[MAX_SSE_CLIENTS];
-static int s_sse_count = 0;
+static weight_cell_t   s_latest;
+static arena_t         s_req_arena;   /**< httpd task only */
+
+/** @brief One formatted SSE event, shared by every client sending it. */
+typedef struct {
+    atomic_int refs;   /**< Holders: broadcaster + clients  */
+    size_t     len;    /**< Bytes in data                   */
+    char       data[]; /**< "event: ...\ndata: ...\n\n"     */
+} sse_event_t;
+
+/** @brief Per-client send state; protected by s_sse_mutex. */
+typedef struct {
+    int          fd;           /**< Socket, -1 when slot free            */
+    sse_event_t *cur;          /**< Event being written                  */
+    size_t       off;          /**< Bytes of cur already sent            */
+    sse_event_t *next;         /**< Newest event waiting behind cur      */
+    bool         work_queued;  /**< sse_send_work pending in httpd task  */
+    uint32_t     coalesced;    /**< Events replaced before being sent    */
+} sse_client_t;
+
+/** @brief One history ring entry. */
+typedef struct {
+    uint32_t t_ms;      /**< Publish time, ms since boot */
+    int32_t  weight_mg; /**< Weight in milligrams        */
+} ws_hist_sample_t;
+
+/** Samples retained for replay (CONFIG_WS_HISTORY_SECONDS of publishes). */
+#define WS_HISTORY_LEN  (CONFIG_WS_HISTORY_SECONDS * 1000 / CONFIG_MEASURE_INTERVAL_MS)
+
+#define WS_FRAME_REPLAY     1
+#define WS_FRAME_LIVE       2
+#define WS_FLAG_STABLE      0x01U
+#define WS_REPLAY_HDR_LEN   8
+#define WS_RECORD_LEN       6
+#define WS_LIVE_LEN         8
+
+_Static_assert(WS_REPLAY_HDR_LEN + WS_HISTORY_LEN * WS_RECORD_LEN <= CONFIG_WEBSERVER_ARENA_SIZE,
+               "CONFIG_WEBSERVER_ARENA_SIZE cannot hold the WebSocket replay frame");
+
+/** @brief Per-client WebSocket state; protected by s_sse_mutex. */
+typedef struct {
+    int      fd;           /**< Socket, -1 when slot free                  */
+    bool     busy;         /**< Replay or live frame pending in httpd task */
+    bool     replayed;     /**< Replay frame has been sent                 */
+    uint32_t last_t_ms;    /**< Timestamp of the last sample sent          */
+    uint8_t  live[WS_LIVE_LEN]; /**< Live frame buffer while busy          */
+    uint32_t dropped;      /**< Live samples skipped while busy            */
+} ws_client_t;
+
+static sse_client_t      s_sse_clients[CONFIG_SSE_MAX_CLIENTS];
+static int               s_sse_count = 0;
 static SemaphoreHandle_t s_sse_mutex = NULL;
+static QueueHandle_t     s_sse_mailbox = NULL;
+static TaskHandle_t      s_sse_task    = NULL;
 
-/* ── Dashboard HTML (embedded) ────────────────────────────────────── */
+static ws_client_t       s_ws_clients[CONFIG_WS_MAX_CLIENTS];
+static int               s_ws_count = 0;
 
-/**
- * @brief Full single-page dashboard served from flash.
+/* Runtime metrics, registered in web_server_start() */
+static metric_t *s_m_requests;      /* API requests served                */
+static metric_t *s_m_sse_coalesced; /* SSE events replaced before sending */
+static metric_t *s_m_ws_dropped;    /* WS live samples skipped while busy */
+
+/* History ring; written by the broadcaster, protected by s_hist_mutex */
+static ws_hist_sample_t *s_hist       = NULL;
+static SemaphoreHandle_t s_hist_mutex = NULL;
+static size_t            s_hist_head  = 0;   /**< Next write index */
+static size_t            s_hist_count = 0;
+
+/* ── Dashboard page (embedded, gzipped) ───────────────────────────── */
+
+/*
+ * Full single-page dashboard, compressed from main/www/index.html at
+ * build time and linked into flash (see main/CMakeLists.txt).
  *
  * Features:
  *   - Live weight display updated via EventSource (SSE).
@@ -55,413 +161,647 @@ static SemaphoreHandle_t s_sse_mutex = NULL;
  *   - Connection status indicator.
  *   - Responsive layout for desktop and mobile.
  */
-static const char DASHBOARD_HTML[] =
-"<!DOCTYPE html>"
-"<html lang=\"en\">"
-"<head>"
-"<meta charset=\"UTF-8\">"
-"<meta name=\"viewport\" content=\"width=device-width,initial-scale=1\">"
-"<title>ESP32-S3 Digital Scale</title>"
-"<script src=\"https://cdn.jsdelivr.net/npm/chart.js@4.4.0/dist/chart.umd.min.js\"></script>"
-"<style>"
-":root{"
-"--bg:#0f172a;--surface:#1e293b;--surface2:#334155;--accent:#38bdf8;"
-"--accent2:#818cf8;--green:#4ade80;--red:#f87171;--yellow:#fbbf24;"
-"--text:#f1f5f9;--muted:#94a3b8;--border:#475569;"
-"--radius:1rem;--shadow:0 4px 24px rgba(0,0,0,.4);"
-"}"
-"*{box-sizing:border-box;margin:0;padding:0}"
-"body{background:var(--bg);color:var(--text);font-family:'Segoe UI',system-ui,sans-serif;"
-"min-height:100vh;display:flex;flex-direction:column;align-items:center;padding:1.5rem}"
-"h1{font-size:1.4rem;font-weight:700;letter-spacing:.05em;color:var(--accent);"
-"margin-bottom:1.5rem;display:flex;align-items:center;gap:.6rem}"
-"h1 svg{width:1.6rem;height:1.6rem}"
-".grid{display:grid;grid-template-columns:repeat(auto-fit,minmax(280px,1fr));"
-"gap:1rem;width:100%;max-width:900px}"
-".card{background:var(--surface);border:1px solid var(--border);"
-"border-radius:var(--radius);padding:1.4rem;box-shadow:var(--shadow)}"
-".card-title{font-size:.75rem;font-weight:600;text-transform:uppercase;"
-"letter-spacing:.1em;color:var(--muted);margin-bottom:.8rem}"
-/* Weight display */
-"#weight-display{font-size:4.5rem;font-weight:800;line-height:1;"
-"letter-spacing:-.02em;color:var(--text);text-align:center;"
-"transition:color .3s}"
-"#weight-unit{font-size:1.4rem;font-weight:400;color:var(--muted);margin-left:.3rem}"
-"#weight-card{text-align:center}"
-/* Status dot */
-".status-row{display:flex;align-items:center;gap:.5rem;margin-top:.8rem;"
-"justify-content:center}"
-".dot{width:.65rem;height:.65rem;border-radius:50%;background:var(--red);"
-"transition:background .4s}"
-".dot.online{background:var(--green);box-shadow:0 0 8px var(--green)}"
-".status-label{font-size:.8rem;color:var(--muted)}"
-/* Buttons */
-".btn{display:inline-flex;align-items:center;justify-content:center;gap:.4rem;"
-"padding:.55rem 1.1rem;border-radius:.6rem;border:none;cursor:pointer;"
-"font-size:.85rem;font-weight:600;transition:opacity .2s,transform .1s}"
-".btn:active{transform:scale(.97)}"
-".btn-accent{background:var(--accent);color:#0f172a}"
-".btn-outline{background:transparent;border:1px solid var(--border);color:var(--text)}"
-".btn-danger{background:var(--red);color:#fff}"
-".btn-row{display:flex;gap:.6rem;flex-wrap:wrap;margin-top:.6rem}"
-/* Unit toggle */
-".unit-toggle{display:flex;gap:.4rem;justify-content:center;margin-top:.8rem}"
-".unit-btn{padding:.35rem .9rem;border-radius:.5rem;border:1px solid var(--border);"
-"background:transparent;color:var(--muted);cursor:pointer;font-size:.8rem;font-weight:600;"
-"transition:all .2s}"
-".unit-btn.active{background:var(--accent2);color:#fff;border-color:var(--accent2)}"
-/* Chart */
-"#history-card{grid-column:1/-1}"
-"canvas{max-height:220px}"
-/* Stats row */
-".stats{display:grid;grid-template-columns:repeat(3,1fr);gap:.6rem;margin-top:.4rem}"
-".stat{background:var(--surface2);border-radius:.6rem;padding:.7rem;text-align:center}"
-".stat-val{font-size:1.2rem;font-weight:700;color:var(--accent)}"
-".stat-lbl{font-size:.7rem;color:var(--muted);margin-top:.2rem}"
-/* Calibration */
-"input[type=number]{background:var(--surface2);border:1px solid var(--border);"
-"border-radius:.5rem;color:var(--text);padding:.45rem .7rem;font-size:.9rem;width:100%;"
-"margin-bottom:.6rem}"
-"input[type=number]:focus{outline:2px solid var(--accent);border-color:transparent}"
-".notice{font-size:.75rem;color:var(--muted);margin-top:.4rem;line-height:1.5}"
-/* Toast */
-"#toast{position:fixed;bottom:1.5rem;right:1.5rem;background:var(--surface);"
-"border:1px solid var(--border);border-radius:.7rem;padding:.7rem 1.1rem;"
-"font-size:.85rem;box-shadow:var(--shadow);opacity:0;pointer-events:none;"
-"transition:opacity .3s;z-index:99}"
-"#toast.show{opacity:1}"
-"@media(max-width:480px){#weight-display{font-size:3rem}}"
-"</style>"
-"</head>"
-"<body>"
-"<h1>"
-"<svg viewBox=\"0 0 24 24\" fill=\"none\" stroke=\"currentColor\" stroke-width=\"2\">"
-"<path d=\"M3 6l9-3 9 3v6c0 5-4 8.5-9 10C7 18.5 3 15 3 12V6z\"/>"
-"<path d=\"M12 8v4l2 2\"/>"
-"</svg>"
-"ESP32-S3 Digital Scale"
-"</h1>"
-
-"<div class=\"grid\">"
-
-/* ── Weight card ── */
-"<div class=\"card\" id=\"weight-card\">"
-"<div class=\"card-title\">Current Weight</div>"
-"<div id=\"weight-display\">---<span id=\"weight-unit\"> g</span></div>"
-"<div class=\"unit-toggle\">"
-"<button class=\"unit-btn active\" onclick=\"setUnit('g')\">g</button>"
-"<button class=\"unit-btn\" onclick=\"setUnit('kg')\">kg</button>"
-"<button class=\"unit-btn\" onclick=\"setUnit('lb')\">lb</button>"
-"</div>"
-"<div class=\"status-row\">"
-"<div class=\"dot\" id=\"dot\"></div>"
-"<span class=\"status-label\" id=\"status-label\">Connecting…</span>"
-"</div>"
-"</div>"
-
-/* ── Controls card ── */
-"<div class=\"card\">"
-"<div class=\"card-title\">Controls</div>"
-"<div class=\"btn-row\">"
-"<button class=\"btn btn-accent\" onclick=\"doTare()\">&#9654; Tare (Zero)</button>"
-"<button class=\"btn btn-outline\" onclick=\"resetStats()\">Reset Stats</button>"
-"</div>"
-"<div class=\"notice\" id=\"tare-status\">Place nothing on the scale before taring.</div>"
-"</div>"
-
-/* ── Stats card ── */
-"<div class=\"card\">"
-"<div class=\"card-title\">Session Statistics</div>"
-"<div class=\"stats\">"
-"<div class=\"stat\"><div class=\"stat-val\" id=\"stat-min\">--</div><div class=\"stat-lbl\">Min</div></div>"
-"<div class=\"stat\"><div class=\"stat-val\" id=\"stat-max\">--</div><div class=\"stat-lbl\">Max</div></div>"
-"<div class=\"stat\"><div class=\"stat-val\" id=\"stat-avg\">--</div><div class=\"stat-lbl\">Avg</div></div>"
-"</div>"
-"</div>"
-
-/* ── Calibration card ── */
-"<div class=\"card\">"
-"<div class=\"card-title\">Calibration</div>"
-"<label style=\"font-size:.8rem;color:var(--muted);display:block;margin-bottom:.3rem\">"
-"Scale factor (counts/g)</label>"
-"<input type=\"number\" id=\"cal-input\" placeholder=\"e.g. 430.0\" step=\"0.1\">"
-"<div class=\"btn-row\">"
-"<button class=\"btn btn-outline\" onclick=\"applyCalibration()\">Apply</button>"
-"</div>"
-"<div class=\"notice\">Calibrate: place known weight, read raw, compute factor = raw/grams.</div>"
-"</div>"
-
-/* ── System card ── */
-"<div class=\"card\">"
-"<div class=\"card-title\">System Info</div>"
-"<div id=\"sys-info\" style=\"font-size:.8rem;color:var(--muted);line-height:2\">Loading…</div>"
-"</div>"
-
-/* ── History chart ── */
-"<div class=\"card\" id=\"history-card\">"
-"<div class=\"card-title\">Weight History (last 60 s)</div>"
-"<canvas id=\"chart\"></canvas>"
-"</div>"
-
-"</div>"
-
-"<div id=\"toast\"></div>"
-
-"<script>"
-"/* ── State ── */"
-"let unit='g',minW=Infinity,maxW=-Infinity,sumW=0,countW=0;"
-"const history=[];"
-"const MAX_HIST=120;" /* 60s @ 500ms */
-
-"/* ── Unit conversion ── */"
-"function toUnit(g){"
-"if(unit==='kg')return(g/1000).toFixed(3);"
-"if(unit==='lb')return(g/453.592).toFixed(3);"
-"return g.toFixed(1);"
-"}"
-"function setUnit(u){"
-"unit=u;"
-"document.querySelectorAll('.unit-btn').forEach(b=>b.classList.toggle('active',b.textContent===u));"
-"document.getElementById('weight-unit').textContent=' '+u;"
-"updateStats();"
-"}"
-
-"/* ── Stats ── */"
-"function updateStats(){"
-"document.getElementById('stat-min').textContent=minW===Infinity?'--':toUnit(minW)+' '+unit;"
-"document.getElementById('stat-max').textContent=maxW===-Infinity?'--':toUnit(maxW)+' '+unit;"
-"document.getElementById('stat-avg').textContent=countW===0?'--':(toUnit(sumW/countW))+' '+unit;"
-"}"
-"function resetStats(){"
-"minW=Infinity;maxW=-Infinity;sumW=0;countW=0;history.length=0;"
-"updateStats();chart.data.labels=[];chart.data.datasets[0].data=[];chart.update();"
-"toast('Stats reset');"
-"}"
-
-"/* ── Weight update ── */"
-"function updateWeight(g){"
-"const el=document.getElementById('weight-display');"
-"const unit_el=document.getElementById('weight-unit');"
-"el.textContent=toUnit(g);"
-"unit_el.textContent=' '+unit;"
-"el.style.color=Math.abs(g)<2?'var(--muted)':'var(--text)';"
-"/* stats */"
-"if(g<minW)minW=g;"
-"if(g>maxW)maxW=g;"
-"sumW+=g;countW++;"
-"updateStats();"
-"/* chart */"
-"const now=new Date();"
-"const label=now.getHours().toString().padStart(2,'0')+':'"
-"+now.getMinutes().toString().padStart(2,'0')+':'"
-"+now.getSeconds().toString().padStart(2,'0');"
-"history.push({t:label,v:g});"
-"if(history.length>MAX_HIST)history.shift();"
-"chart.data.labels=history.map(h=>h.t);"
-"chart.data.datasets[0].data=history.map(h=>h.v);"
-"chart.update('none');"
-"}"
-
-"/* ── SSE ── */"
-"function connectSSE(){"
-"const src=new EventSource('/events');"
-"src.onopen=()=>{"
-"document.getElementById('dot').classList.add('online');"
-"document.getElementById('status-label').textContent='Connected';"
-"};"
-"src.onerror=()=>{"
-"document.getElementById('dot').classList.remove('online');"
-"document.getElementById('status-label').textContent='Reconnecting…';"
-"};"
-"src.addEventListener('weight',e=>{"
-"const d=JSON.parse(e.data);"
-"updateWeight(parseFloat(d.weight_g));"
-"});"
-"}"
-
-"/* ── REST helpers ── */"
-"async function doTare(){"
-"document.getElementById('tare-status').textContent='Taring…';"
-"const r=await fetch('/api/tare',{method:'POST'});"
-"if(r.ok){resetStats();document.getElementById('tare-status').textContent='Tare complete!';toast('Tare applied');}"
-"else document.getElementById('tare-status').textContent='Tare failed!';"
-"}"
-
-"async function applyCalibration(){"
-"const v=parseFloat(document.getElementById('cal-input').value);"
-"if(!v||v<=0){toast('Enter a valid scale factor');return;}"
-"const r=await fetch('/api/calibrate',{method:'POST',headers:{'Content-Type':'application/json'},"
-"body:JSON.stringify({scale:v})});"
-"if(r.ok)toast('Scale factor '+v+' applied');else toast('Calibration failed');"
-"}"
-
-"async function loadStatus(){"
-"try{"
-"const r=await fetch('/api/status');"
-"const d=await r.json();"
-"document.getElementById('sys-info').innerHTML="
-"'IP: <b>'+d.ip+'</b><br>'"
-"+'Uptime: <b>'+d.uptime_s+' s</b><br>'"
-"+'Scale factor: <b>'+d.scale_factor.toFixed(4)+'</b><br>'"
-"+'Free heap: <b>'+d.free_heap+' B</b>';"
-"}catch(e){}"
-"setTimeout(loadStatus,10000);"
-"}"
-
-"/* ── Toast ── */"
-"let toastTimer;"
-"function toast(msg){"
-"const el=document.getElementById('toast');"
-"el.textContent=msg;el.classList.add('show');"
-"clearTimeout(toastTimer);"
-"toastTimer=setTimeout(()=>el.classList.remove('show'),2500);"
-"}"
-
-"/* ── Chart init ── */"
-"const ctx=document.getElementById('chart').getContext('2d');"
-"const chart=new Chart(ctx,{"
-"type:'line',"
-"data:{labels:[],datasets:[{label:'Weight',data:[],"
-"borderColor:'#38bdf8',backgroundColor:'rgba(56,189,248,.08)',"
-"borderWidth:2,pointRadius:0,fill:true,tension:.35}]},"
-"options:{animation:false,responsive:true,maintainAspectRatio:true,"
-"plugins:{legend:{display:false},tooltip:{mode:'index',intersect:false}},"
-"scales:{"
-"x:{ticks:{maxTicksLimit:8,color:'#94a3b8'},grid:{color:'#1e293b'}},"
-"y:{ticks:{color:'#94a3b8'},grid:{color:'#334155'}}"
-"}}});"
-
-"/* ── Boot ── */"
-"connectSSE();"
-"loadStatus();"
-"</script>"
-"</body>"
-"</html>";
+extern const uint8_t dashboard_gz_start[] asm("_binary_index_html_gz_start");
+extern const uint8_t dashboard_gz_end[]   asm("_binary_index_html_gz_end");
+
+/** Strong ETag of the compressed page: quoted 64-bit FNV-1a of its bytes. */
+static char s_dashboard_etag[20];
 
 /* ── SSE helpers ──────────────────────────────────────────────────── */
 
 /**
- * @brief Register a new SSE client socket descriptor.
+ * @brief Drop one reference to an event, freeing it on the last one.
  *
- * Acquires s_sse_mutex, adds @p fd to the tracking array if a slot is
- * free, and releases the mutex.  Silently drops if the array is full.
+ * @param[in] ev Event to release; NULL is ignored.
+ */
+static void sse_event_release(sse_event_t *ev)
+{
+    if (ev && atomic_fetch_sub(&ev->refs, 1) == 1) {
+        free(ev);
+    }
+}
+
+/**
+ * @brief Register a new SSE client socket descriptor.
  *
  * @param[in] fd Socket file descriptor of the new SSE client.
+ * @return ESP_OK on success; ESP_ERR_NO_MEM when all slots are in use.
  */
-static void sse_add_client(int fd)
+static esp_err_t sse_add_client(int fd)
 {
+    esp_err_t err = ESP_ERR_NO_MEM;
+
     xSemaphoreTake(s_sse_mutex, portMAX_DELAY);
-    for (int i = 0; i < MAX_SSE_CLIENTS; i++) {
-        if (s_sse_fds[i] < 0) {
-            s_sse_fds[i] = fd;
+    for (int i = 0; i < CONFIG_SSE_MAX_CLIENTS; i++) {
+        if (s_sse_clients[i].fd < 0) {
+            memset(&s_sse_clients[i], 0, sizeof(sse_client_t));
+            s_sse_clients[i].fd = fd;
             s_sse_count++;
             ESP_LOGI(TAG, "SSE client added fd=%d  total=%d", fd, s_sse_count);
+            err = ESP_OK;
             break;
         }
     }
     xSemaphoreGive(s_sse_mutex);
+    return err;
 }
 
 /**
- * @brief Remove a disconnected SSE client from the tracking array.
+ * @brief Remove a disconnected SSE client and release its events.
  *
  * @param[in] fd Socket file descriptor to remove.
  */
 static void sse_remove_client(int fd)
 {
+    sse_event_t *cur = NULL, *next = NULL;
+
     xSemaphoreTake(s_sse_mutex, portMAX_DELAY);
-    for (int i = 0; i < MAX_SSE_CLIENTS; i++) {
-        if (s_sse_fds[i] == fd) {
-            s_sse_fds[i] = -1;
+    for (int i = 0; i < CONFIG_SSE_MAX_CLIENTS; i++) {
+        sse_client_t *c = &s_sse_clients[i];
+        if (c->fd == fd) {
+            cur  = c->cur;
+            next = c->next;
+            c->fd   = -1;
+            c->cur  = NULL;
+            c->next = NULL;
             s_sse_count--;
-            ESP_LOGI(TAG, "SSE client removed fd=%d  total=%d", fd, s_sse_count);
+            ESP_LOGI(TAG, "SSE client removed fd=%d  total=%d  coalesced=%lu",
+                     fd, s_sse_count, (unsigned long)c->coalesced);
+            break;
+        }
+    }
+    xSemaphoreGive(s_sse_mutex);
+
+    sse_event_release(cur);
+    sse_event_release(next);
+}
+
+/* ── WebSocket helpers ────────────────────────────────────────────── */
+
+/** @brief Store a little-endian u16. */
+static inline void put_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+/** @brief Store a little-endian u32. */
+static inline void put_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/** @brief Time between two samples in ms, saturated to the u16 field. */
+static inline uint16_t ws_delta_ms(uint32_t from_ms, uint32_t to_ms)
+{
+    uint32_t dt = to_ms - from_ms;
+    return (uint16_t)(dt > UINT16_MAX ? UINT16_MAX : dt);
+}
+
+/**
+ * @brief Append one published sample to the history ring.
+ *
+ * Caller must hold s_hist_mutex.
+ *
+ * @param[in] sample Published sample.
+ */
+static void ws_history_append(const weight_sample_t *sample)
+{
+    if (!s_hist) return;
+
+    s_hist[s_hist_head].t_ms      = sample->t_ms;
+    s_hist[s_hist_head].weight_mg = (int32_t)lroundf(sample->weight_g * 1000.0f);
+    s_hist_head = (s_hist_head + 1) % WS_HISTORY_LEN;
+    if (s_hist_count < WS_HISTORY_LEN) s_hist_count++;
+}
+
+/**
+ * @brief Register a new WebSocket client.
+ *
+ * The slot starts busy so no live frame can overtake the replay.
+ *
+ * @param[in] fd Socket file descriptor of the new client.
+ * @return Slot index, or -1 when all slots are in use.
+ */
+static int ws_add_client(int fd)
+{
+    int slot = -1;
+
+    xSemaphoreTake(s_sse_mutex, portMAX_DELAY);
+    for (int i = 0; i < CONFIG_WS_MAX_CLIENTS; i++) {
+        if (s_ws_clients[i].fd < 0) {
+            memset(&s_ws_clients[i], 0, sizeof(ws_client_t));
+            s_ws_clients[i].fd   = fd;
+            s_ws_clients[i].busy = true;
+            s_ws_count++;
+            ESP_LOGI(TAG, "WS client added fd=%d  total=%d", fd, s_ws_count);
+            slot = i;
+            break;
+        }
+    }
+    xSemaphoreGive(s_sse_mutex);
+    return slot;
+}
+
+/**
+ * @brief Remove a disconnected WebSocket client.
+ *
+ * @param[in] fd Socket file descriptor to remove.
+ */
+static void ws_remove_client(int fd)
+{
+    xSemaphoreTake(s_sse_mutex, portMAX_DELAY);
+    for (int i = 0; i < CONFIG_WS_MAX_CLIENTS; i++) {
+        ws_client_t *c = &s_ws_clients[i];
+        if (c->fd == fd) {
+            c->fd = -1;
+            s_ws_count--;
+            ESP_LOGI(TAG, "WS client removed fd=%d  total=%d  dropped=%lu",
+                     fd, s_ws_count, (unsigned long)c->dropped);
+            break;
+        }
+    }
+    xSemaphoreGive(s_sse_mutex);
+}
+
+/**
+ * @brief Send a binary frame on a client socket (runs in the httpd task).
+ *
+ * Closes the session when the send fails.
+ *
+ * @param[in] fd  Client socket.
+ * @param[in] buf Frame payload.
+ * @param[in] len Payload length in bytes.
+ */
+static void ws_send_binary(int fd, const uint8_t *buf, size_t len)
+{
+    httpd_ws_frame_t frame = {
+        .final   = true,
+        .type    = HTTPD_WS_TYPE_BINARY,
+        .payload = (uint8_t *)buf,
+        .len     = len,
+    };
+    if (httpd_ws_send_frame_async(s_server, fd, &frame) != ESP_OK) {
+        ESP_LOGW(TAG, "WS send failed fd=%d; closing", fd);
+        httpd_sess_trigger_close(s_server, fd);
+    }
+}
+
+/**
+ * @brief Send the history replay frame to a new client (httpd task).
+ *
+ * The ring is copied into an arena frame under s_hist_mutex, then sent
+ * without holding any lock.  The stable flag comes from the latest cell.
+ *
+ * @param[in] arg Client slot index cast to a pointer.
+ */
+static void ws_replay_work(void *arg)
+{
+    ws_client_t *c = &s_ws_clients[(intptr_t)arg];
+
+    weight_sample_t latest;
+    weight_cell_read(&s_latest, &latest);
+
+    xSemaphoreTake(s_hist_mutex, portMAX_DELAY);
+    const size_t count = s_hist_count;
+    uint8_t *buf = arena_alloc(&s_req_arena, WS_REPLAY_HDR_LEN + count * WS_RECORD_LEN);
+    uint32_t last_t_ms = 0;
+
+    if (buf) {
+        const size_t first = (s_hist_head + WS_HISTORY_LEN - count) % WS_HISTORY_LEN;
+        buf[0] = WS_FRAME_REPLAY;
+        buf[1] = latest.stable ? WS_FLAG_STABLE : 0;
+        put_le16(&buf[2], (uint16_t)count);
+        put_le32(&buf[4], count ? s_hist[first].t_ms : 0);
+
+        uint8_t *rec = &buf[WS_REPLAY_HDR_LEN];
+        last_t_ms = count ? s_hist[first].t_ms : 0;
+        for (size_t i = 0; i < count; i++) {
+            const ws_hist_sample_t *h = &s_hist[(first + i) % WS_HISTORY_LEN];
+            put_le16(rec, ws_delta_ms(last_t_ms, h->t_ms));
+            put_le32(rec + 2, (uint32_t)h->weight_mg);
+            last_t_ms = h->t_ms;
+            rec += WS_RECORD_LEN;
+        }
+    }
+    xSemaphoreGive(s_hist_mutex);
+
+    if (!buf) {
+        ESP_LOGW(TAG, "WS replay alloc failed");
+        httpd_sess_trigger_close(s_server, c->fd);
+        return;
+    }
+
+    ws_send_binary(c->fd, buf, WS_REPLAY_HDR_LEN + count * WS_RECORD_LEN);
+    arena_reset(&s_req_arena);
+
+    xSemaphoreTake(s_sse_mutex, portMAX_DELAY);
+    c->last_t_ms = last_t_ms;
+    c->replayed  = true;
+    c->busy      = false;
+    xSemaphoreGive(s_sse_mutex);
+}
+
+/**
+ * @brief Send the prepared live frame of one client (httpd task).
+ *
+ * @param[in] arg Client slot index cast to a pointer.
+ */
+static void ws_live_work(void *arg)
+{
+    ws_client_t *c = &s_ws_clients[(intptr_t)arg];
+
+    if (c->fd >= 0) {
+        ws_send_binary(c->fd, c->live, WS_LIVE_LEN);
+    }
+
+    xSemaphoreTake(s_sse_mutex, portMAX_DELAY);
+    c->busy = false;
+    xSemaphoreGive(s_sse_mutex);
+}
+
+/**
+ * @brief Offer one sample to every WebSocket client.
+ *
+ * A client whose previous frame is still pending skips this sample; its
+ * next frame's dt_ms then spans the gap.  Caller must hold s_sse_mutex.
+ *
+ * @param[in] sample Published sample.
+ */
+static void ws_broadcast(const weight_sample_t *sample)
+{
+    const int32_t mg = (int32_t)lroundf(sample->weight_g * 1000.0f);
+
+    for (int i = 0; i < CONFIG_WS_MAX_CLIENTS; i++) {
+        ws_client_t *c = &s_ws_clients[i];
+        if (c->fd < 0) continue;
+        if (c->busy) {
+            if (c->replayed) {
+                c->dropped++;
+                metrics_inc(s_m_ws_dropped);
+            }
+            continue;
+        }
+
+        c->live[0] = WS_FRAME_LIVE;
+        c->live[1] = sample->stable ? WS_FLAG_STABLE : 0;
+        put_le16(&c->live[2], ws_delta_ms(c->last_t_ms, sample->t_ms));
+        put_le32(&c->live[4], (uint32_t)mg);
+
+        if (httpd_queue_work(s_server, ws_live_work, (void *)(intptr_t)i) == ESP_OK) {
+            c->busy      = true;
+            c->last_t_ms = sample->t_ms;
+        }
+    }
+}
+
+/**
+ * @brief httpd session close hook; retires SSE and WebSocket clients.
+ *
+ * Installed as httpd_config_t::close_fn, so it must close the socket.
+ *
+ * @param[in] hd     Server handle.
+ * @param[in] sockfd Socket being closed.
+ */
+static void on_session_close(httpd_handle_t hd, int sockfd)
+{
+    sse_remove_client(sockfd);
+    ws_remove_client(sockfd);
+    close(sockfd);
+}
+
+/**
+ * @brief Write pending events to one client (runs in the httpd task).
+ *
+ * Sends are non-blocking: on EAGAIN the remaining bytes stay in the
+ * client slot and are retried on the next broadcast, so a lagging
+ * browser never stalls the server or other clients.
+ *
+ * @param[in] arg Client slot index cast to a pointer.
+ */
+static void sse_send_work(void *arg)
+{
+    sse_client_t *c = &s_sse_clients[(intptr_t)arg];
+
+    xSemaphoreTake(s_sse_mutex, portMAX_DELAY);
+    c->work_queued = false;
+
+    while (c->fd >= 0) {
+        if (!c->cur) {
+            c->cur  = c->next;
+            c->next = NULL;
+            c->off  = 0;
+        }
+        if (!c->cur) break;
+
+        int sent = send(c->fd, c->cur->data + c->off, c->cur->len - c->off,
+                        MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                ESP_LOGW(TAG, "SSE send failed fd=%d; closing", c->fd);
+                httpd_sess_trigger_close(s_server, c->fd);
+            }
             break;
         }
+
+        c->off += (size_t)sent;
+        if (c->off == c->cur->len) {
+            sse_event_release(c->cur);
+            c->cur = NULL;
+        }
     }
+
     xSemaphoreGive(s_sse_mutex);
 }
 
+/**
+ * @brief Format one SSE event into a shared, reference-counted buffer.
+ *
+ * @param[in] sample Weight sample to encode.
+ * @return New event holding one reference, or NULL when out of memory.
+ */
+static sse_event_t *sse_event_create(const weight_sample_t *sample)
+{
+    char msg[96];
+    int  msg_len = snprintf(msg, sizeof(msg),
+                            "event: weight\ndata: {\"weight_g\":%.2f,\"stable\":%s}\n\n",
+                            sample->weight_g, sample->stable ? "true" : "false");
+
+    sse_event_t *ev = malloc(sizeof(sse_event_t) + (size_t)msg_len);
+    if (!ev) return NULL;
+
+    atomic_init(&ev->refs, 1);
+    ev->len = (size_t)msg_len;
+    memcpy(ev->data, msg, (size_t)msg_len);
+    return ev;
+}
+
+/**
+ * @brief SSE broadcaster task.
+ *
+ * Waits on the one-slot mailbox filled by web_server_push_weight(),
+ * appends the sample to the history ring, formats the event once, and
+ * offers it to every SSE client.  A client that still holds an unsent
+ * event has it replaced by the new one.  WebSocket clients get the
+ * sample as a live binary frame.
+ *
+ * The history is appended here rather than by the publisher so the ring
+ * lock is only ever contended on the network core.  The broadcaster
+ * wakes once per CONFIG_MEASURE_INTERVAL_MS and outruns the publisher,
+ * so in practice no sample is coalesced away before reaching the ring.
+ *
+ * @param[in] pvParam Unused task parameter.
+ */
+static void task_sse_broadcast(void *pvParam)
+{
+    weight_sample_t sample;
+
+    while (true) {
+        xQueueReceive(s_sse_mailbox, &sample, portMAX_DELAY);
+
+        xSemaphoreTake(s_hist_mutex, portMAX_DELAY);
+        ws_history_append(&sample);
+        xSemaphoreGive(s_hist_mutex);
+
+        if (s_ws_count > 0) {
+            xSemaphoreTake(s_sse_mutex, portMAX_DELAY);
+            ws_broadcast(&sample);
+            xSemaphoreGive(s_sse_mutex);
+        }
+        if (s_sse_count == 0) continue;
+
+        sse_event_t *ev = sse_event_create(&sample);
+        if (!ev) {
+            ESP_LOGW(TAG, "SSE event alloc failed");
+            continue;
+        }
+
+        xSemaphoreTake(s_sse_mutex, portMAX_DELAY);
+        for (int i = 0; i < CONFIG_SSE_MAX_CLIENTS; i++) {
+            sse_client_t *c = &s_sse_clients[i];
+            if (c->fd < 0) continue;
+
+            if (c->next) {
+                sse_event_release(c->next);
+                c->coalesced++;
+                metrics_inc(s_m_sse_coalesced);
+            }
+            atomic_fetch_add(&ev->refs, 1);
+            c->next = ev;
+
+            if (!c->work_queued &&
+                httpd_queue_work(s_server, sse_send_work, (void *)(intptr_t)i) == ESP_OK) {
+                c->work_queued = true;
+            }
+        }
+        xSemaphoreGive(s_sse_mutex);
+
+        sse_event_release(ev);
+    }
+}
+
 /* ── URI handlers ─────────────────────────────────────────────────── */
 
 /**
- * @brief Serve the embedded dashboard HTML page.
+ * @brief Take a scratch buffer for the current request from the arena.
+ *
+ * Sends 500 when the arena is exhausted, so callers just return ESP_FAIL.
+ *
+ * @param[in] req Incoming HTTP request handle.
+ * @param[in] len Bytes needed.
+ * @return Buffer valid until the request finishes, or NULL.
+ */
+static char *req_scratch(httpd_req_t *req, size_t len)
+{
+    char *buf = arena_alloc(&s_req_arena, len);
+    if (!buf) {
+        ESP_LOGW(TAG, "Request arena exhausted (%u bytes wanted)", (unsigned)len);
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Out of scratch memory");
+    }
+    return buf;
+}
+
+/**
+ * @brief Run the real handler (from user_ctx), then reset the arena.
+ *
+ * Every handler that takes scratch memory is registered through this
+ * wrapper, so the arena is empty again whichever path the handler
+ * returned through.
+ *
+ * @param[in] req Incoming HTTP request handle.
+ * @return Result of the wrapped handler.
+ */
+static esp_err_t handler_scoped(httpd_req_t *req)
+{
+    esp_err_t (*handler)(httpd_req_t *) = req->user_ctx;
+    metrics_inc(s_m_requests);
+    esp_err_t err = handler(req);
+    arena_reset(&s_req_arena);
+    return err;
+}
+
+/**
+ * @brief Derive the dashboard ETag from the embedded page bytes.
+ *
+ * Computed once at start-up, so the tag changes exactly when the page
+ * content changes and browsers can revalidate with If-None-Match.
+ */
+static void dashboard_init_etag(void)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const uint8_t *p = dashboard_gz_start; p < dashboard_gz_end; p++) {
+        hash ^= *p;
+        hash *= 0x100000001b3ULL;
+    }
+    snprintf(s_dashboard_etag, sizeof(s_dashboard_etag), "\"%016llx\"",
+             (unsigned long long)hash);
+}
+
+/**
+ * @brief Serve the embedded dashboard page.
  *
- * Responds to GET / with the DASHBOARD_HTML string, Content-Type
- * text/html, and HTTP 200.
+ * Sends the pre-gzipped page with Content-Encoding: gzip and a strong
+ * ETag.  When the request's If-None-Match carries the current tag, only
+ * 304 Not Modified is returned, so a refresh costs no page transfer.
  *
  * @param[in] req Incoming HTTP request handle.
  * @return ESP_OK always (httpd_resp_send handles errors internally).
  */
 static esp_err_t handler_root(httpd_req_t *req)
 {
-    httpd_resp_set_type(req, "text/html");
+    httpd_resp_set_hdr(req, "ETag", s_dashboard_etag);
     httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
-    httpd_resp_send(req, DASHBOARD_HTML, strlen(DASHBOARD_HTML));
+
+    char inm[64];
+    if (httpd_req_get_hdr_value_str(req, "If-None-Match", inm, sizeof(inm)) == ESP_OK &&
+        strstr(inm, s_dashboard_etag) != NULL) {
+        httpd_resp_set_status(req, "304 Not Modified");
+        httpd_resp_send(req, NULL, 0);
+        return ESP_OK;
+    }
+
+    httpd_resp_set_type(req, "text/html");
+    httpd_resp_set_hdr(req, "Content-Encoding", "gzip");
+    httpd_resp_send(req, (const char *)dashboard_gz_start,
+                    dashboard_gz_end - dashboard_gz_start);
     return ESP_OK;
 }
 
 /**
  * @brief Return the latest weight as a JSON object.
  *
- * Response body: {"weight_g": 123.45, "unit": "g"}
+ * Response body: {"weight_g": 123.45, "unit": "g", "stable": true}
+ * Read from the seqlock cell, so the handler never blocks the publisher.
  *
  * @param[in] req Incoming HTTP request handle.
  * @return ESP_OK on success.
  */
 static esp_err_t handler_api_weight(httpd_req_t *req)
 {
-    float w = 0.0f;
-    xSemaphoreTake(s_weight_mutex, portMAX_DELAY);
-    w = s_last_weight_g;
-    xSemaphoreGive(s_weight_mutex);
+    weight_sample_t latest;
+    weight_cell_read(&s_latest, &latest);
+
+    const size_t len = 80;
+    char *buf = req_scratch(req, len);
+    if (!buf) return ESP_FAIL;
 
-    char buf[64];
-    snprintf(buf, sizeof(buf), "{\"weight_g\":%.2f,\"unit\":\"g\"}", w);
+    snprintf(buf, len, "{\"weight_g\":%.2f,\"unit\":\"g\",\"stable\":%s}",
+             latest.weight_g, latest.stable ? "true" : "false");
     httpd_resp_set_type(req, "application/json");
     httpd_resp_send(req, buf, strlen(buf));
     return ESP_OK;
 }
 
 /**
- * @brief Execute a tare operation and return {"status":"ok"}.
+ * @brief Write the calibration state machine status as the JSON response.
  *
- * Averages CONFIG_TARE_SAMPLES readings to establish the zero offset,
- * then resets the last weight to 0.
+ * Body: {"state":"session","points":2,"captured":0,"last_raw":8388,
+ *        "result":"ESP_OK","scale":430.0,"tare":-12345,"max_residual_g":0.4}
  *
- * @param[in] req Incoming HTTP request handle.
- * @return ESP_OK on success; HTTP 500 on HX711 failure.
+ * @param[in] req    Incoming HTTP request handle.
+ * @param[in] status HTTP status line, e.g. "200 OK".
+ * @return ESP_OK on success; ESP_FAIL when the arena is exhausted.
  */
-static esp_err_t handler_api_tare(httpd_req_t *req)
+static esp_err_t send_calibration_status(httpd_req_t *req, const char *status)
 {
-    ESP_LOGI(TAG, "HTTP POST /api/tare");
-    esp_err_t err = hx711_tare(s_dev, CONFIG_TARE_SAMPLES);
-    if (err != ESP_OK) {
-        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Tare failed");
-        return ESP_FAIL;
-    }
+    calibration_status_t st;
+    calibration_get_status(&st);
 
-    xSemaphoreTake(s_weight_mutex, portMAX_DELAY);
-    s_last_weight_g = 0.0f;
-    xSemaphoreGive(s_weight_mutex);
+    const size_t len = 224;
+    char *buf = req_scratch(req, len);
+    if (!buf) return ESP_FAIL;
 
+    snprintf(buf, len,
+             "{"
+             "\"state\":\"%s\","
+             "\"points\":%u,"
+             "\"captured\":%lu,"
+             "\"last_raw\":%ld,"
+             "\"result\":\"%s\","
+             "\"scale\":%.4f,"
+             "\"tare\":%ld,"
+             "\"max_residual_g\":%.2f"
+             "}",
+             calibration_state_name(st.state),
+             (unsigned)st.points,
+             (unsigned long)st.captured,
+             (long)st.last_raw,
+             esp_err_to_name(st.last_result),
+             st.scale,
+             (long)st.tare,
+             st.max_residual_g);
+
+    httpd_resp_set_status(req, status);
     httpd_resp_set_type(req, "application/json");
-    httpd_resp_send(req, "{\"status\":\"ok\"}", 14);
+    httpd_resp_send(req, buf, strlen(buf));
     return ESP_OK;
 }
 
 /**
- * @brief Accept a new scale factor via JSON body and apply it.
+ * @brief Start a tare and return 202 with the calibration status.
+ *
+ * The tare is captured from the next CONFIG_TARE_SAMPLES samples by the
+ * measurement task; poll GET /api/calibrate until "state" leaves
+ * "taring".  The handler itself performs no sensor I/O.
+ *
+ * @param[in] req Incoming HTTP request handle.
+ * @return ESP_OK on success; HTTP 409 while a calibration step runs.
+ */
+static esp_err_t handler_api_tare(httpd_req_t *req)
+{
+    ESP_LOGI(TAG, "HTTP POST /api/tare");
+    if (calibration_request_tare() != ESP_OK) {
+        return send_calibration_status(req, "409 Conflict");
+    }
+    return send_calibration_status(req, "202 Accepted");
+}
+
+/**
+ * @brief Drive the calibration state machine from a JSON body.
  *
- * Expected request body: {"scale": 430.0}
- * Persists the new factor to NVS via the hx711 handle.
+ * Accepted bodies:
+ *   {"scale": 430.0}                    – apply and save a scale factor
+ *   {"action": "start"}                 – open a multi-point session
+ *   {"action": "point", "grams": 500}   – capture a reference point
+ *   {"action": "finish"}                – fit, apply, and save
+ *   {"action": "cancel"}                – abandon the session
+ *
+ * Every request returns immediately with the state machine status;
+ * captures and the fit complete in the measurement task.
  *
  * @param[in] req Incoming HTTP request handle.
- * @return ESP_OK on success; HTTP 400/500 on parse or apply failure.
+ * @return ESP_OK on success; HTTP 400 on parse errors, 409 on a state conflict.
  */
 static esp_err_t handler_api_calibrate(httpd_req_t *req)
 {
-    char body[64] = {0};
-    int  recv_len = httpd_req_recv(req, body, sizeof(body) - 1);
+    const size_t body_len = 96;
+    char *body = req_scratch(req, body_len);
+    if (!body) return ESP_FAIL;
+
+    int  recv_len = httpd_req_recv(req, body, body_len - 1);
     if (recv_len <= 0) {
         httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Empty body");
         return ESP_FAIL;
@@ -474,32 +814,60 @@ static esp_err_t handler_api_calibrate(httpd_req_t *req)
         return ESP_FAIL;
     }
 
-    cJSON *scale_item = cJSON_GetObjectItem(json, "scale");
-    if (!cJSON_IsNumber(scale_item) || scale_item->valuedouble <= 0.0) {
-        cJSON_Delete(json);
-        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Missing/invalid 'scale'");
-        return ESP_FAIL;
-    }
+    esp_err_t   err        = ESP_ERR_INVALID_ARG;
+    cJSON      *scale_item  = cJSON_GetObjectItem(json, "scale");
+    cJSON      *action_item = cJSON_GetObjectItem(json, "action");
+    const char *action      = cJSON_IsString(action_item) ? action_item->valuestring : NULL;
 
-    float new_scale = (float)scale_item->valuedouble;
+    if (cJSON_IsNumber(scale_item) && scale_item->valuedouble > 0.0) {
+        err = calibration_request_scale((float)scale_item->valuedouble);
+        if (err == ESP_OK) {
+            ESP_LOGI(TAG, "Scale factor update queued via HTTP: %.4f",
+                     scale_item->valuedouble);
+        }
+    } else if (action && strcmp(action, "start") == 0) {
+        err = calibration_start();
+    } else if (action && strcmp(action, "point") == 0) {
+        cJSON *grams_item = cJSON_GetObjectItem(json, "grams");
+        if (cJSON_IsNumber(grams_item)) {
+            err = calibration_capture_point((float)grams_item->valuedouble);
+        }
+    } else if (action && strcmp(action, "finish") == 0) {
+        err = calibration_finish();
+    } else if (action && strcmp(action, "cancel") == 0) {
+        calibration_cancel();
+        err = ESP_OK;
+    }
     cJSON_Delete(json);
 
-    esp_err_t err = hx711_set_scale(s_dev, new_scale);
-    if (err != ESP_OK) {
-        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Apply failed");
+    if (err == ESP_ERR_INVALID_ARG) {
+        httpd_resp_send_err(req, HTTPD_400_BAD_REQUEST, "Missing/invalid 'scale' or 'action'");
         return ESP_FAIL;
     }
+    if (err != ESP_OK) {
+        return send_calibration_status(req, "409 Conflict");
+    }
+    return send_calibration_status(req, "202 Accepted");
+}
 
-    ESP_LOGI(TAG, "Scale factor updated via HTTP: %.4f", new_scale);
-    httpd_resp_set_type(req, "application/json");
-    httpd_resp_send(req, "{\"status\":\"ok\"}", 14);
-    return ESP_OK;
+/**
+ * @brief Return the calibration state machine status (GET /api/calibrate).
+ *
+ * @param[in] req Incoming HTTP request handle.
+ * @return ESP_OK always.
+ */
+static esp_err_t handler_api_calibrate_status(httpd_req_t *req)
+{
+    return send_calibration_status(req, "200 OK");
 }
 
 /**
  * @brief Return system information as a JSON object.
  *
- * Fields: ip, uptime_s, scale_factor, tare, free_heap, ssid.
+ * Fields: ip, uptime_s, scale_factor, tare, free_heap, ssid,
+ * measure_core, network_core, and core_load (busy % per core over the
+ * last CONFIG_CORE_LOAD_PERIOD_MS; -1 while unavailable), arena_peak
+ * and arena_size (request arena high-water mark and capacity, bytes).
  *
  * @param[in] req Incoming HTTP request handle.
  * @return ESP_OK always.
@@ -509,22 +877,36 @@ static esp_err_t handler_api_status(httpd_req_t *req)
     float scale = 0.0f;
     hx711_get_scale(s_dev, &scale);
 
-    char buf[256];
-    snprintf(buf, sizeof(buf),
+    const size_t len = 384;
+    char *buf = req_scratch(req, len);
+    if (!buf) return ESP_FAIL;
+
+    snprintf(buf, len,
              "{"
              "\"ip\":\"%s\","
              "\"uptime_s\":%lld,"
              "\"scale_factor\":%.4f,"
              "\"tare\":%ld,"
              "\"free_heap\":%lu,"
-             "\"ssid\":\"%s\""
+             "\"ssid\":\"%s\","
+             "\"measure_core\":%d,"
+             "\"network_core\":%d,"
+             "\"core_load\":[%d,%d],"
+             "\"arena_peak\":%u,"
+             "\"arena_size\":%u"
              "}",
-             wifi_manager_get_ip(),
+             wifi_sta_get_ip_str(),
              (long long)(esp_timer_get_time() / 1000000LL),
              scale,
              (long)s_dev->tare,
              (unsigned long)esp_get_free_heap_size(),
-             CONFIG_WIFI_SSID);
+             CONFIG_WIFI_SSID,
+             CONFIG_MEASURE_CORE,
+             CONFIG_NETWORK_CORE,
+             core_load_percent(0),
+             core_load_percent(1),
+             (unsigned)arena_peak(&s_req_arena),
+             (unsigned)CONFIG_WEBSERVER_ARENA_SIZE);
 
     httpd_resp_set_type(req, "application/json");
     httpd_resp_send(req, buf, strlen(buf));
@@ -532,51 +914,112 @@ static esp_err_t handler_api_status(httpd_req_t *req)
 }
 
 /**
- * @brief Handle an SSE subscription request (GET /events).
- *
- * Sends the HTTP/1.1 200 headers with Content-Type: text/event-stream
- * and keeps the connection open, registering the socket as an SSE
- * client.  The actual event data is sent by web_server_push_weight().
+ * @brief Send one piece of the metrics text as an HTTP chunk.
+ */
+static esp_err_t metrics_send_chunk(void *ctx, const char *data, size_t len)
+{
+    return httpd_resp_send_chunk((httpd_req_t *)ctx, data, len);
+}
+
+/**
+ * @brief Serve every registered metric for a Prometheus scrape (GET /metrics).
  *
- * This function blocks until the client disconnects.
+ * The text is streamed in chunked encoding one line at a time, so the
+ * response needs neither the request arena nor a buffer of its own.
  *
  * @param[in] req Incoming HTTP request handle.
- * @return ESP_OK when the client disconnects normally.
+ * @return ESP_OK on success; ESP_FAIL when the client went away.
  */
-static esp_err_t handler_sse(httpd_req_t *req)
+static esp_err_t handler_metrics(httpd_req_t *req)
 {
-    /* SSE headers */
-    httpd_resp_set_type(req, "text/event-stream");
-    httpd_resp_set_hdr(req, "Cache-Control", "no-cache");
-    httpd_resp_set_hdr(req, "Connection",    "keep-alive");
-    httpd_resp_set_hdr(req, "Access-Control-Allow-Origin", "*");
+    metrics_inc(s_m_requests);
+    httpd_resp_set_type(req, "text/plain; version=0.0.4");
+    if (metrics_write_prometheus(metrics_send_chunk, req) != ESP_OK) return ESP_FAIL;
+    return httpd_resp_send_chunk(req, NULL, 0);
+}
+
+/* Sampled by whichever task exports; a torn read of one word cannot happen */
+static int64_t read_sse_clients(void)
+{
+    return s_sse_count;
+}
 
-    /* Send an initial comment to flush the headers */
-    const char *init = ": connected\n\n";
-    httpd_resp_send_chunk(req, init, strlen(init));
+static int64_t read_ws_clients(void)
+{
+    return s_ws_count;
+}
 
+static int64_t read_arena_peak(void)
+{
+    return (int64_t)arena_peak(&s_req_arena);
+}
+
+/**
+ * @brief Handle an SSE subscription request (GET /events).
+ *
+ * Writes the text/event-stream response head directly and registers the
+ * socket as an SSE client, then returns so the httpd task is free again.
+ * The session stays open; events are written by sse_send_work() and the
+ * client is retired by sse_on_close() when the browser disconnects.
+ *
+ * @param[in] req Incoming HTTP request handle.
+ * @return ESP_OK on success; ESP_FAIL when no client slot is free.
+ */
+static esp_err_t handler_sse(httpd_req_t *req)
+{
     int fd = httpd_req_to_sockfd(req);
-    sse_add_client(fd);
+    if (sse_add_client(fd) != ESP_OK) {
+        ESP_LOGW(TAG, "SSE client limit (%d) reached", CONFIG_SSE_MAX_CLIENTS);
+        httpd_resp_send_err(req, HTTPD_500_INTERNAL_SERVER_ERROR, "Too many clients");
+        return ESP_FAIL;
+    }
 
-    /* Keep alive: block in 200 ms heartbeat loop until client drops.
-     * Use lwIP select() + recv() which are available via lwip/sockets.h. */
-    while (true) {
-        vTaskDelay(pdMS_TO_TICKS(200));
-
-        fd_set rfds;
-        FD_ZERO(&rfds);
-        FD_SET(fd, &rfds);
-        struct timeval tv = {0, 0};
-        int sel = select(fd + 1, &rfds, NULL, NULL, &tv);
-        if (sel > 0) {
-            char tmp[4];
-            int n = lwip_recv(fd, tmp, sizeof(tmp), MSG_PEEK | MSG_DONTWAIT);
-            if (n == 0) break; /* client closed connection */
+    static const char head[] =
+        "HTTP/1.1 200 OK\r\n"
+        "Content-Type: text/event-stream\r\n"
+        "Cache-Control: no-cache\r\n"
+        "Connection: keep-alive\r\n"
+        "Access-Control-Allow-Origin: *\r\n"
+        "\r\n"
+        ": connected\n\n";
+
+    if (httpd_send(req, head, sizeof(head) - 1) < 0) {
+        sse_remove_client(fd);
+        return ESP_FAIL;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Handle the /ws WebSocket endpoint.
+ *
+ * On the opening handshake the client is registered and its replay frame
+ * is queued; afterwards incoming frames are read and discarded, since the
+ * stream is server → client only.  Oversized client frames close the
+ * connection.
+ *
+ * @param[in] req Incoming HTTP request handle.
+ * @return ESP_OK on success; ESP_FAIL to drop the connection.
+ */
+static esp_err_t handler_ws(httpd_req_t *req)
+{
+    if (req->method == HTTP_GET) {
+        int slot = ws_add_client(httpd_req_to_sockfd(req));
+        if (slot < 0) {
+            ESP_LOGW(TAG, "WS client limit (%d) reached", CONFIG_WS_MAX_CLIENTS);
+            return ESP_FAIL;
         }
+        return httpd_queue_work(s_server, ws_replay_work, (void *)(intptr_t)slot);
     }
 
-    sse_remove_client(fd);
-    return ESP_OK;
+    httpd_ws_frame_t frame = { 0 };
+    esp_err_t err = httpd_ws_recv_frame(req, &frame, 0);
+    if (err != ESP_OK || frame.len == 0) return err;
+
+    uint8_t discard[32];
+    if (frame.len > sizeof(discard)) return ESP_FAIL;
+    frame.payload = discard;
+    return httpd_ws_recv_frame(req, &frame, sizeof(discard));
 }
 
 /* ── Public API ───────────────────────────────────────────────────── */
@@ -587,38 +1030,93 @@ static esp_err_t handler_sse(httpd_req_t *req)
 esp_err_t web_server_start(hx711_dev_t *dev)
 {
     s_dev = dev;
-
-    s_weight_mutex = xSemaphoreCreateMutex();
+    dashboard_init_etag();
+
+    weight_cell_init(&s_latest);
+    if (!s_m_requests) {
+        s_m_requests      = metrics_counter("scale_http_requests_total",
+                                            "API and /metrics requests served");
+        s_m_sse_coalesced = metrics_counter("scale_sse_coalesced_total",
+                                            "SSE events replaced before reaching a slow client");
+        s_m_ws_dropped    = metrics_counter("scale_ws_dropped_total",
+                                            "WebSocket live samples skipped while a send was pending");
+        metrics_sampled(METRIC_GAUGE, "scale_sse_clients", "Connected SSE clients",
+                        read_sse_clients);
+        metrics_sampled(METRIC_GAUGE, "scale_ws_clients", "Connected WebSocket clients",
+                        read_ws_clients);
+        metrics_sampled(METRIC_GAUGE, "scale_request_arena_peak_bytes",
+                        "Request arena high-water mark", read_arena_peak);
+    }
+    s_hist_mutex   = xSemaphoreCreateMutex();
     s_sse_mutex    = xSemaphoreCreateMutex();
-    for (int i = 0; i < MAX_SSE_CLIENTS; i++) s_sse_fds[i] = -1;
+    s_sse_mailbox  = xQueueCreate(1, sizeof(weight_sample_t));
+    for (int i = 0; i < CONFIG_SSE_MAX_CLIENTS; i++) s_sse_clients[i].fd = -1;
+    for (int i = 0; i < CONFIG_WS_MAX_CLIENTS; i++)  s_ws_clients[i].fd  = -1;
+
+    s_hist = heap_caps_malloc(WS_HISTORY_LEN * sizeof(ws_hist_sample_t),
+                              MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (!s_hist) {
+        s_hist = malloc(WS_HISTORY_LEN * sizeof(ws_hist_sample_t));
+    }
+    if (!s_hist) {
+        ESP_LOGW(TAG, "No memory for %d-sample history; replay disabled", WS_HISTORY_LEN);
+    }
+
+    const arena_config_t arena_cfg = {
+        .size          = CONFIG_WEBSERVER_ARENA_SIZE,
+        .caps          = MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT,
+        .fallback_caps = MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT,
+    };
+    esp_err_t err = arena_init(&s_req_arena, &arena_cfg);
+    if (err != ESP_OK) {
+        return err;
+    }
 
     httpd_config_t cfg  = HTTPD_DEFAULT_CONFIG();
     cfg.server_port     = CONFIG_WEBSERVER_PORT;
-    cfg.max_open_sockets = CONFIG_WEBSERVER_MAX_SOCKETS + MAX_SSE_CLIENTS;
+    cfg.max_open_sockets = CONFIG_WEBSERVER_MAX_SOCKETS + CONFIG_SSE_MAX_CLIENTS
+                           + CONFIG_WS_MAX_CLIENTS;
+    cfg.max_uri_handlers = 12;
     cfg.lru_purge_enable = true;
+    cfg.close_fn         = on_session_close;
+    cfg.core_id          = CONFIG_NETWORK_CORE;
 
-    esp_err_t err = httpd_start(&s_server, &cfg);
+    err = httpd_start(&s_server, &cfg);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "httpd_start failed: %s", esp_err_to_name(err));
+        arena_deinit(&s_req_arena);
         return err;
     }
 
     /* Register URI handlers */
     static const httpd_uri_t uris[] = {
         { .uri = "/",              .method = HTTP_GET,  .handler = handler_root },
-        { .uri = "/api/weight",    .method = HTTP_GET,  .handler = handler_api_weight },
-        { .uri = "/api/tare",      .method = HTTP_POST, .handler = handler_api_tare },
-        { .uri = "/api/calibrate", .method = HTTP_POST, .handler = handler_api_calibrate },
-        { .uri = "/api/status",    .method = HTTP_GET,  .handler = handler_api_status },
+        { .uri = "/api/weight",    .method = HTTP_GET,  .handler = handler_scoped,
+          .user_ctx = handler_api_weight },
+        { .uri = "/api/tare",      .method = HTTP_POST, .handler = handler_scoped,
+          .user_ctx = handler_api_tare },
+        { .uri = "/api/calibrate", .method = HTTP_POST, .handler = handler_scoped,
+          .user_ctx = handler_api_calibrate },
+        { .uri = "/api/calibrate", .method = HTTP_GET,  .handler = handler_scoped,
+          .user_ctx = handler_api_calibrate_status },
+        { .uri = "/api/status",    .method = HTTP_GET,  .handler = handler_scoped,
+          .user_ctx = handler_api_status },
+        { .uri = "/metrics",       .method = HTTP_GET,  .handler = handler_metrics },
         { .uri = "/events",        .method = HTTP_GET,  .handler = handler_sse },
+        { .uri = "/ws",            .method = HTTP_GET,  .handler = handler_ws,
+          .is_websocket = true },
     };
 
     for (size_t i = 0; i < sizeof(uris) / sizeof(uris[0]); i++) {
         httpd_register_uri_handler(s_server, &uris[i]);
     }
 
+    xTaskCreatePinnedToCore(task_sse_broadcast, "sse_bcast", CONFIG_SSE_TASK_STACK,
+                            NULL, CONFIG_SSE_TASK_PRIORITY, &s_sse_task,
+                            CONFIG_NETWORK_CORE);
+
     ESP_LOGI(TAG, "HTTP server started on port %d", CONFIG_WEBSERVER_PORT);
-    ESP_LOGI(TAG, "Dashboard: http://%s/", wifi_manager_get_ip());
+    ESP_LOGI(TAG, "Dashboard: http://%s/", wifi_sta_get_ip_str());
     return ESP_OK;
 }
 
@@ -627,48 +1125,41 @@ esp_err_t web_server_start(hx711_dev_t *dev)
  */
 esp_err_t web_server_stop(void)
 {
+    if (s_sse_task) {
+        vTaskDelete(s_sse_task);
+        s_sse_task = NULL;
+    }
     if (s_server) {
-        httpd_stop(s_server);
+        httpd_stop(s_server);   /* closes sessions → on_session_close() */
         s_server = NULL;
     }
+    arena_deinit(&s_req_arena);
     ESP_LOGI(TAG, "HTTP server stopped");
     return ESP_OK;
 }
 
 /**
- * @brief Push a weight reading to all active SSE clients.
+ * @brief Push a weight reading to all active SSE and WebSocket clients.
  *
- * Formats the message as SSE with a named event type "weight":
- *   event: weight\ndata: {"weight_g":NNN.NN}\n\n
- * Failed sends on individual sockets remove those clients automatically.
+ * Publishes the value to the latest cell for /api/weight and overwrites
+ * the broadcaster mailbox, which also feeds the history ring.  Takes no
+ * lock and never touches a socket, so the cost is constant regardless of
+ * the number or speed of clients.
  */
-esp_err_t web_server_push_weight(float weight_g)
+esp_err_t web_server_push_weight(float weight_g, bool stable)
 {
-    /* Cache latest value for REST endpoint */
-    xSemaphoreTake(s_weight_mutex, portMAX_DELAY);
-    s_last_weight_g = weight_g;
-    xSemaphoreGive(s_weight_mutex);
-
-    if (s_sse_count == 0) return ESP_ERR_NOT_FOUND;
+    const weight_sample_t sample = {
+        .weight_g = weight_g,
+        .stable   = stable,
+        .t_ms     = (uint32_t)(esp_timer_get_time() / 1000LL),
+    };
 
-    char msg[80];
-    int  msg_len = snprintf(msg, sizeof(msg),
-                            "event: weight\ndata: {\"weight_g\":%.2f}\n\n",
-                            weight_g);
+    if (!s_sse_mailbox) return ESP_ERR_INVALID_STATE;   /* server not started */
 
-    xSemaphoreTake(s_sse_mutex, portMAX_DELAY);
-    for (int i = 0; i < MAX_SSE_CLIENTS; i++) {
-        if (s_sse_fds[i] < 0) continue;
-        int sent = lwip_send(s_sse_fds[i], msg, msg_len, MSG_DONTWAIT);
-        if (sent < 0) {
-            ESP_LOGW(TAG, "SSE send failed fd=%d; removing", s_sse_fds[i]);
-            s_sse_fds[i] = -1;
-            s_sse_count--;
-        }
-    }
-    xSemaphoreGive(s_sse_mutex);
+    weight_cell_publish(&s_latest, &sample);
+    xQueueOverwrite(s_sse_mailbox, &sample);
 
-    return ESP_OK;
+    return (s_sse_count == 0 && s_ws_count == 0) ? ESP_ERR_NOT_FOUND : ESP_OK;
 }
 
 /**
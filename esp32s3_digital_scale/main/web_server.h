@@ -8,11 +8,12 @@
  *
  * Endpoints:
  *   GET  /              – Dashboard HTML page
- *   GET  /api/weight    – Current weight JSON  {"weight_g":123.4,"unit":"g"}
- *   GET  /api/status    – System info JSON
+ *   GET  /api/weight    – Current weight JSON  {"weight_g":123.4,"unit":"g","stable":true}
+ *   GET  /api/status    – System info JSON, including per-core load
  *   POST /api/tare      – Trigger tare;        {"status":"ok"}
  *   POST /api/calibrate – Set scale factor;    body: {"scale":430.0}
  *   GET  /events        – SSE stream of weight updates
+ *   GET  /metrics       – Prometheus text exposition of the metrics registry
  *
  * @author  ESP32-S3 Scale Project
  * @version 1.0.0
@@ -22,6 +23,7 @@
 #ifndef WEB_SERVER_H
 #define WEB_SERVER_H
 
+#include <stdbool.h>
 #include "esp_err.h"
 #include "hx711.h"
 
@@ -50,14 +52,22 @@ esp_err_t web_server_stop(void);
 /**
  * @brief Push a weight sample to all connected SSE clients.
  *
- * Called periodically by the SSE push task. Formats the value as a
- * standard SSE message: "data: {\"weight_g\":NNN.NN}\n\n".
+ * Called periodically by the measurement task. Stores the value in a
+ * lock-free latest-sample cell (read by GET /api/weight), hands it to the
+ * SSE broadcaster task and returns in constant time without taking a
+ * lock; the broadcaster formats it as
+ * "event: weight\ndata: {\"weight_g\":NNN.NN,\"stable\":true}\n\n"
+ * and sends it to each client without blocking.
  *
- * @param[in] weight_g Current weight in grams.
- * @return ESP_OK if at least one client received the event;
- *         ESP_ERR_NOT_FOUND if no SSE clients are connected.
+ * Must only be called from one task.
+ *
+ * @param[in] weight_g Current filtered weight in grams.
+ * @param[in] stable   true once the weight has settled.
+ * @return ESP_OK if the event was queued for broadcast;
+ *         ESP_ERR_NOT_FOUND if no SSE or WebSocket clients are connected;
+ *         ESP_ERR_INVALID_STATE before web_server_start().
  */
-esp_err_t web_server_push_weight(float weight_g);
+esp_err_t web_server_push_weight(float weight_g, bool stable);
 
 /**
  * @brief Return the number of currently active SSE connections.
@@ -0,0 +1,58 @@
+/**
+ * @file weight_cell.c
+ * @brief Seqlock latest-weight cell implementation.
+ *
+ * Fence placement follows the usual seqlock pattern: the release fence
+ * after the odd count keeps the sample stores behind it, and the reader's
+ * acquire fence keeps its sample loads ahead of the second count check.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.0.0
+ * @date    2025
+ */
+
+#include "weight_cell.h"
+
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+/** Copies attempted back to back before the reader starts sleeping. */
+#define WEIGHT_CELL_SPIN_TRIES  8
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+void weight_cell_init(weight_cell_t *cell)
+{
+    memset(&cell->sample, 0, sizeof(cell->sample));
+    atomic_init(&cell->seq, 0);
+}
+
+void weight_cell_publish(weight_cell_t *cell, const weight_sample_t *sample)
+{
+    const unsigned seq = atomic_load_explicit(&cell->seq, memory_order_relaxed);
+
+    atomic_store_explicit(&cell->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    cell->sample = *sample;
+    atomic_store_explicit(&cell->seq, seq + 2, memory_order_release);
+}
+
+bool weight_cell_read(weight_cell_t *cell, weight_sample_t *out)
+{
+    for (int tries = 1; ; tries++) {
+        const unsigned before = atomic_load_explicit(&cell->seq, memory_order_acquire);
+        if ((before & 1U) == 0) {
+            *out = cell->sample;
+            atomic_thread_fence(memory_order_acquire);
+            if (atomic_load_explicit(&cell->seq, memory_order_relaxed) == before) {
+                return before != 0;
+            }
+        }
+
+        /* The writer was preempted mid-update; let it finish. */
+        if (tries >= WEIGHT_CELL_SPIN_TRIES) {
+            vTaskDelay(1);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+/**
+ * @file weight_cell.h
+ * @brief Lock-free latest-weight cell shared between the two cores.
+ *
+ * The measurement task publishes every filtered weight into the cell;
+ * HTTP handlers and the broadcaster read the newest value from the
+ * network core.  A sequence counter replaces the mutex (a seqlock): the
+ * writer makes it odd while it copies a sample in and even again when
+ * done, and a reader that sees an odd or changed count simply copies
+ * again.  The writer never waits, so a slow HTTP request can no longer
+ * delay the measurement pipeline.
+ *
+ * There must be a single writer.  Any number of tasks may read.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.0.0
+ * @date    2025
+ */
+
+#ifndef WEIGHT_CELL_H
+#define WEIGHT_CELL_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief One published weight. */
+typedef struct {
+    float    weight_g;  /**< Filtered, zero-clamped weight in grams */
+    bool     stable;    /**< Stability flag from the filter         */
+    uint32_t t_ms;      /**< Publish time, ms since boot            */
+} weight_sample_t;
+
+/** @brief Latest-value cell; initialise with weight_cell_init(). */
+typedef struct {
+    atomic_uint     seq;     /**< Odd while a write is in progress, 0 = empty */
+    weight_sample_t sample;  /**< Newest sample                              */
+} weight_cell_t;
+
+/**
+ * @brief Reset a cell to the empty state.
+ *
+ * @param[out] cell Cell to initialise.
+ */
+void weight_cell_init(weight_cell_t *cell);
+
+/**
+ * @brief Store a new sample (single writer, never blocks).
+ *
+ * @param[in,out] cell   Cell to write.
+ * @param[in]     sample Sample to publish.
+ */
+void weight_cell_publish(weight_cell_t *cell, const weight_sample_t *sample);
+
+/**
+ * @brief Copy out the newest sample.
+ *
+ * Retries while the writer is mid-update; if the writer was preempted
+ * inside its update the reader sleeps a tick between retries instead of
+ * spinning, so it must not be called from an ISR.
+ *
+ * @param[in]  cell Cell to read.
+ * @param[out] out  Newest sample; zeroed when nothing was published yet.
+ * @return true if a sample has been published; false otherwise.
+ */
+bool weight_cell_read(weight_cell_t *cell, weight_sample_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WEIGHT_CELL_H */
@@ -0,0 +1,134 @@
+/**
+ * @file weight_filter.c
+ * @brief Incremental weight filter implementation.
+ *
+ * The median window keeps two views of the same samples: a ring in
+ * arrival order, to know which sample leaves, and a sorted array, to
+ * read the median.  Each push removes the leaving sample from the
+ * sorted array and inserts the new one with a single memmove each,
+ * which for windows of a few samples is cheaper than a two-heap scheme.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.1.0
+ * @date    2025
+ */
+
+#include "weight_filter.h"
+
+#include <math.h>
+#include <string.h>
+
+/* ── Private helpers ──────────────────────────────────────────────── */
+
+/**
+ * @brief Remove one occurrence of @p value from the sorted array.
+ *
+ * @param[in] filter Filter state.
+ * @param[in] value  Sample leaving the window.
+ */
+static void sorted_remove(weight_filter_t *filter, float value)
+{
+    size_t i = 0;
+    while (i < filter->count - 1 && filter->sorted[i] != value) {
+        i++;
+    }
+    memmove(&filter->sorted[i], &filter->sorted[i + 1],
+            (filter->count - 1 - i) * sizeof(float));
+    filter->count--;
+}
+
+/**
+ * @brief Insert @p value into the sorted array.
+ *
+ * @param[in] filter Filter state.
+ * @param[in] value  Sample entering the window.
+ */
+static void sorted_insert(weight_filter_t *filter, float value)
+{
+    size_t i = filter->count;
+    while (i > 0 && filter->sorted[i - 1] > value) {
+        i--;
+    }
+    memmove(&filter->sorted[i + 1], &filter->sorted[i],
+            (filter->count - i) * sizeof(float));
+    filter->sorted[i] = value;
+    filter->count++;
+}
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+/**
+ * @brief Initialise a filter instance.
+ */
+void weight_filter_init(weight_filter_t *filter, const weight_filter_config_t *cfg)
+{
+    memcpy(&filter->cfg, cfg, sizeof(weight_filter_config_t));
+
+    if (filter->cfg.median_window < 1) {
+        filter->cfg.median_window = 1;
+    } else if (filter->cfg.median_window > WEIGHT_FILTER_MAX_WINDOW) {
+        filter->cfg.median_window = WEIGHT_FILTER_MAX_WINDOW;
+    }
+    if (!(filter->cfg.ema_alpha > 0.0f) || filter->cfg.ema_alpha > 1.0f) {
+        filter->cfg.ema_alpha = 1.0f;
+    }
+
+    weight_filter_reset(filter);
+}
+
+/**
+ * @brief Discard all history.
+ */
+void weight_filter_reset(weight_filter_t *filter)
+{
+    filter->count        = 0;
+    filter->head         = 0;
+    filter->ema_g        = 0.0f;
+    filter->settle_ref_g = 0.0f;
+    filter->settle_count = 0;
+}
+
+/**
+ * @brief Feed one weight sample through the filter.
+ */
+void weight_filter_push(weight_filter_t *filter, float grams,
+                        weight_filter_output_t *out)
+{
+    const size_t window = filter->cfg.median_window;
+    const bool   first  = (filter->count == 0);
+
+    /* 1. Moving median */
+    if (filter->count == window) {
+        sorted_remove(filter, filter->ring[filter->head]);
+        filter->ring[filter->head] = grams;
+        filter->head = (filter->head + 1) % window;
+    } else {
+        filter->ring[(filter->head + filter->count) % window] = grams;
+    }
+    sorted_insert(filter, grams);
+
+    const size_t mid = filter->count / 2;
+    const float median = (filter->count & 1U)
+                         ? filter->sorted[mid]
+                         : 0.5f * (filter->sorted[mid - 1] + filter->sorted[mid]);
+
+    /* 2. Exponential moving average, seeded with the first median */
+    if (first) {
+        filter->ema_g        = median;
+        filter->settle_ref_g = median;
+    } else {
+        filter->ema_g += filter->cfg.ema_alpha * (median - filter->ema_g);
+    }
+
+    /* 3. Settle detector: restart the band whenever the EMA leaves it */
+    if (fabsf(filter->ema_g - filter->settle_ref_g) > filter->cfg.stable_band_g) {
+        filter->settle_ref_g = filter->ema_g;
+        filter->settle_count = 0;
+    } else if (filter->settle_count < filter->cfg.stable_samples) {
+        filter->settle_count++;
+    }
+
+    out->grams    = filter->ema_g;
+    out->median_g = median;
+    out->stable   = (filter->settle_count >= filter->cfg.stable_samples);
+}
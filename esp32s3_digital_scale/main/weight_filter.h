@@ -0,0 +1,94 @@
+/**
+ * @file weight_filter.h
+ * @brief Incremental weight filter – moving median, EMA, and stability flag.
+ *
+ * Sits between the HX711 driver and the measurement task and processes
+ * one sample at a time, so every conversion contributes and the output
+ * can be published at any rate without re-reading the sensor:
+ *   1. A moving median over a small sorted window rejects single-sample
+ *      spikes (vibration, cable noise).
+ *   2. An exponential moving average smooths the median output.
+ *   3. A settle detector flags the weight as stable once the EMA has
+ *      stayed within a band for a number of consecutive samples.
+ *
+ * @author  ESP32-S3 Scale Project
+ * @version 1.1.0
+ * @date    2025
+ */
+
+#ifndef WEIGHT_FILTER_H
+#define WEIGHT_FILTER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Largest supported median window (odd values give a true median). */
+#define WEIGHT_FILTER_MAX_WINDOW 15
+
+/** @brief Filter tuning supplied by the application. */
+typedef struct {
+    size_t   median_window;  /**< Median window length (1 – WEIGHT_FILTER_MAX_WINDOW) */
+    float    ema_alpha;      /**< EMA weight of each new median (0 < α ≤ 1)       */
+    float    stable_band_g;  /**< Max EMA drift, in grams, while settling          */
+    uint32_t stable_samples; /**< Consecutive in-band samples before "stable"      */
+} weight_filter_config_t;
+
+/** @brief Runtime state of one filter instance. */
+typedef struct {
+    weight_filter_config_t cfg;                             /**< Copy of config       */
+    float                  ring[WEIGHT_FILTER_MAX_WINDOW];   /**< Samples, arrival order */
+    float                  sorted[WEIGHT_FILTER_MAX_WINDOW]; /**< Same samples, sorted  */
+    size_t                 count;                           /**< Samples in window     */
+    size_t                 head;                            /**< Oldest sample in ring */
+    float                  ema_g;                           /**< Smoothed weight       */
+    float                  settle_ref_g;                    /**< Start of settle band  */
+    uint32_t               settle_count;                    /**< In-band sample count  */
+} weight_filter_t;
+
+/** @brief Filter output after one sample. */
+typedef struct {
+    float grams;    /**< Median + EMA filtered weight     */
+    float median_g; /**< Median of the current window     */
+    bool  stable;   /**< Weight has settled               */
+} weight_filter_output_t;
+
+/**
+ * @brief Initialise a filter instance.
+ *
+ * Out-of-range settings are clamped: the window to 1 – WEIGHT_FILTER_MAX_WINDOW
+ * and α to (0, 1].
+ *
+ * @param[out] filter Filter state to initialise.
+ * @param[in]  cfg    Filter tuning.
+ */
+void weight_filter_init(weight_filter_t *filter, const weight_filter_config_t *cfg);
+
+/**
+ * @brief Discard all history, e.g. after a tare or calibration change.
+ *
+ * @param[in] filter Initialised filter state.
+ */
+void weight_filter_reset(weight_filter_t *filter);
+
+/**
+ * @brief Feed one weight sample through the filter.
+ *
+ * Cost is O(window) for the sorted-window update and O(1) otherwise.
+ *
+ * @param[in]  filter Initialised filter state.
+ * @param[in]  grams  New sample in grams.
+ * @param[out] out    Filter output after this sample.
+ */
+void weight_filter_push(weight_filter_t *filter, float grams,
+                        weight_filter_output_t *out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* WEIGHT_FILTER_H */
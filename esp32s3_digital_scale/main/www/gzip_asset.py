@@ -0,0 +1,28 @@
+#!/usr/bin/env python3
+"""Gzip a web asset for embedding in the firmware image.
+
+The gzip header timestamp is zeroed so identical input always yields
+identical output, which keeps the dashboard ETag stable across builds.
+
+Usage: gzip_asset.py <input> <output>
+"""
+
+import gzip
+import sys
+
+
+def main() -> int:
+    if len(sys.argv) != 3:
+        print(__doc__, file=sys.stderr)
+        return 1
+
+    src, dst = sys.argv[1], sys.argv[2]
+    with open(src, "rb") as f:
+        data = f.read()
+    with open(dst, "wb") as f:
+        f.write(gzip.compress(data, compresslevel=9, mtime=0))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+"""
+Metrics dump decoder
+
+Finds the METRICS1 lines that metrics_dump_serial() prints on the console,
+checks their CRC and prints each record in Prometheus text format, with the
+device uptime as a comment.  The record layout is documented at
+metrics_encode() in components/metrics/include/metrics.h.
+
+Usage:
+    idf.py monitor | tee capture.txt
+    python3 tools/metrics_decode.py capture.txt
+    python3 tools/metrics_decode.py capture.txt --last
+"""
+
+import argparse
+import base64
+import binascii
+import struct
+import sys
+import zlib
+
+PREFIX = "METRICS1 "
+TYPES = ("counter", "gauge", "histogram")
+
+
+class Reader:
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def byte(self):
+        value = self.data[self.pos]
+        self.pos += 1
+        return value
+
+    def varint(self):
+        value = shift = 0
+        while True:
+            byte = self.byte()
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if byte < 0x80:
+                return value
+
+    def svarint(self):
+        value = self.varint()
+        return (value >> 1) ^ -(value & 1)
+
+    def text(self, length):
+        value = self.data[self.pos:self.pos + length].decode("ascii")
+        self.pos += length
+        return value
+
+
+def decode(record):
+    """Return (uptime_ms, [(type, name, value)]); raises ValueError."""
+    if len(record) < 5:
+        raise ValueError("record too short")
+    body, crc = record[:-4], struct.unpack("<I", record[-4:])[0]
+    if zlib.crc32(body) != crc:
+        raise ValueError("CRC mismatch")
+
+    reader = Reader(body)
+    if reader.byte() != 1:
+        raise ValueError("unknown record version")
+    uptime_ms = reader.varint()
+    metrics = []
+    for _ in range(reader.varint()):
+        kind = reader.byte()
+        name = reader.text(reader.byte())
+        if kind == 0:
+            value = reader.varint()
+        elif kind == 1:
+            value = reader.svarint()
+        elif kind == 2:
+            bounds = [reader.varint() for _ in range(reader.byte())]
+            counts = [reader.varint() for _ in range(len(bounds) + 1)]
+            value = (bounds, counts, reader.varint())
+        else:
+            raise ValueError("unknown metric type %d" % kind)
+        metrics.append((TYPES[kind], name, value))
+    return uptime_ms, metrics
+
+
+def to_prometheus(uptime_ms, metrics):
+    lines = ["# uptime %.3f s" % (uptime_ms / 1000.0)]
+    for kind, name, value in metrics:
+        lines.append("# TYPE %s %s" % (name, kind))
+        if kind != "histogram":
+            lines.append("%s %d" % (name, value))
+            continue
+        bounds, counts, total = value
+        cumulative = 0
+        for bound, count in zip(bounds + ["+Inf"], counts):
+            cumulative += count
+            lines.append('%s_bucket{le="%s"} %d' % (name, bound, cumulative))
+        lines.append("%s_sum %d" % (name, total))
+        lines.append("%s_count %d" % (name, cumulative))
+    return "\n".join(lines)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("capture", help="console capture holding METRICS1 lines")
+    parser.add_argument("--last", action="store_true",
+                        help="print only the newest valid record")
+    args = parser.parse_args()
+
+    records = []
+    with open(args.capture, errors="replace") as handle:
+        for number, line in enumerate(handle, 1):
+            start = line.find(PREFIX)
+            if start < 0:
+                continue
+            try:
+                payload = base64.b64decode(line[start + len(PREFIX):].strip(),
+                                           validate=True)
+                records.append(decode(payload))
+            except (binascii.Error, ValueError, IndexError,
+                    UnicodeDecodeError) as error:
+                sys.stderr.write("line %d skipped: %s\n" % (number, error))
+
+    if not records:
+        sys.exit("no valid metrics record found")
+    for record in records[-1:] if args.last else records:
+        print(to_prometheus(*record))
+        print()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,364 @@
+/**
+ * @file
+ * @brief Per-cycle energy accounting for deep-sleep duty-cycled firmware
+ */
+
+#include "energy_profiler.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include "sdkconfig.h"
+
+#if CONFIG_ENERGY_PROFILER
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_attr.h"
+#include "esp_log.h"
+#include "esp_rtc_time.h"
+#include "esp_sleep.h"
+#include "esp_timer.h"
+#if !CONFIG_ENERGY_PROFILER_SENSOR_NONE
+#include "driver/i2c_master.h"
+#endif
+#endif
+
+static const char *const PHASE_NAMES[ENERGY_PHASE_COUNT] = {
+    [ENERGY_PHASE_BOOT] = "boot",
+    [ENERGY_PHASE_ACTIVE] = "active",
+    [ENERGY_PHASE_SENSOR] = "sensor",
+    [ENERGY_PHASE_RADIO] = "radio",
+    [ENERGY_PHASE_SLEEP] = "sleep",
+};
+
+const char *energy_profiler_phase_name(energy_phase_t phase)
+{
+    return (phase < ENERGY_PHASE_COUNT) ? PHASE_NAMES[phase] : "?";
+}
+
+#if CONFIG_ENERGY_PROFILER
+
+static const char *TAG = "energy";
+
+#define RTC_MAGIC       0x454E5031U
+
+/* Charge is kept in uA * us (pC); 1 nAh = 3.6 uC. */
+#define PC_PER_NAH      3600000ULL
+
+/* Prints a charge in nAh as uAh with three decimals. */
+#define UAH_FMT         "%" PRIu64 ".%03" PRIu64
+#define UAH_ARGS(nah)   ((uint64_t)(nah) / 1000U), ((uint64_t)(nah) % 1000U)
+
+typedef struct {
+    uint64_t time_us;
+    uint64_t charge_pc;
+} phase_total_t;
+
+static const uint32_t NOMINAL_UA[ENERGY_PHASE_COUNT] = {
+    [ENERGY_PHASE_BOOT] = CONFIG_ENERGY_PROFILER_BOOT_UA,
+    [ENERGY_PHASE_ACTIVE] = CONFIG_ENERGY_PROFILER_ACTIVE_UA,
+    [ENERGY_PHASE_SENSOR] = CONFIG_ENERGY_PROFILER_SENSOR_UA,
+    [ENERGY_PHASE_RADIO] = CONFIG_ENERGY_PROFILER_RADIO_UA,
+    [ENERGY_PHASE_SLEEP] = CONFIG_ENERGY_PROFILER_SLEEP_UA,
+};
+
+/* Totals since the last report; survive deep sleep. */
+static RTC_DATA_ATTR uint32_t s_magic;
+static RTC_DATA_ATTR uint32_t s_cycles;
+static RTC_DATA_ATTR phase_total_t s_totals[ENERGY_PHASE_COUNT];
+static RTC_DATA_ATTR uint64_t s_cycle_min_pc;
+static RTC_DATA_ATTR uint64_t s_cycle_max_pc;
+static RTC_DATA_ATTR uint64_t s_sleep_start_rtc_us;    /* 0 when no sleep is pending. */
+
+/* This wake. */
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static phase_total_t s_wake[ENERGY_PHASE_COUNT];
+static energy_phase_t s_phase;
+static int64_t s_phase_since_us;
+static uint32_t s_current_ua;
+static bool s_running;
+static bool s_after_sleep;
+static bool s_measured;
+
+/**
+ * @brief Book the time since the last boundary to the current phase
+ *
+ * Call with s_lock held.
+ */
+static void accumulate_locked(int64_t now_us)
+{
+    uint64_t dt_us = (uint64_t)(now_us - s_phase_since_us);
+    s_wake[s_phase].time_us += dt_us;
+    s_wake[s_phase].charge_pc += dt_us * s_current_ua;
+    s_phase_since_us = now_us;
+}
+
+#if !CONFIG_ENERGY_PROFILER_SENSOR_NONE
+
+#define INA_REG_SHUNT_VOLTAGE   0x01
+#if CONFIG_ENERGY_PROFILER_SENSOR_INA219
+#define INA_SHUNT_LSB_NV        10000   /* 10 uV */
+#else
+#define INA_SHUNT_LSB_NV        2500    /* 2.5 uV */
+#endif
+
+static i2c_master_dev_handle_t s_ina;
+
+/**
+ * @brief Read the current through the shunt
+ *
+ * The shunt voltage register needs no calibration, and the reset
+ * configuration of both parts converts it continuously.
+ */
+static esp_err_t ina_read_ua(uint32_t *ua)
+{
+    uint8_t reg = INA_REG_SHUNT_VOLTAGE;
+    uint8_t raw[2];
+    esp_err_t err = i2c_master_transmit_receive(s_ina, &reg, 1, raw, sizeof(raw), 10);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    int16_t shunt = (int16_t)((raw[0] << 8) | raw[1]);
+    int64_t current = (int64_t)shunt * INA_SHUNT_LSB_NV / CONFIG_ENERGY_PROFILER_SHUNT_MOHM;
+    *ua = (current > 0) ? (uint32_t)current : 0U;
+    return ESP_OK;
+}
+
+static void sampler_task(void *arg)
+{
+    (void)arg;
+    TickType_t period = pdMS_TO_TICKS(CONFIG_ENERGY_PROFILER_SAMPLE_MS);
+    TickType_t last_wake = xTaskGetTickCount();
+
+    while (true) {
+        uint32_t ua;
+        if (ina_read_ua(&ua) == ESP_OK) {
+            int64_t now_us = esp_timer_get_time();
+            taskENTER_CRITICAL(&s_lock);
+            if (s_running) {
+                accumulate_locked(now_us);
+                s_current_ua = ua;
+            }
+            taskEXIT_CRITICAL(&s_lock);
+        }
+        xTaskDelayUntil(&last_wake, (period > 0) ? period : 1);
+    }
+}
+
+/**
+ * @brief Open the I2C bus to the current sensor and start sampling
+ *
+ * @return true if the sensor answered
+ */
+static bool sampler_start(void)
+{
+    i2c_master_bus_config_t bus_cfg = {
+        .i2c_port = -1,
+        .sda_io_num = CONFIG_ENERGY_PROFILER_I2C_SDA_GPIO,
+        .scl_io_num = CONFIG_ENERGY_PROFILER_I2C_SCL_GPIO,
+        .clk_source = I2C_CLK_SRC_DEFAULT,
+        .glitch_ignore_cnt = 7,
+        .flags.enable_internal_pullup = true,
+    };
+    i2c_master_bus_handle_t bus;
+    esp_err_t err = i2c_new_master_bus(&bus_cfg, &bus);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "I2C bus: %s; using nominal currents", esp_err_to_name(err));
+        return false;
+    }
+
+    i2c_device_config_t dev_cfg = {
+        .dev_addr_length = I2C_ADDR_BIT_LEN_7,
+        .device_address = CONFIG_ENERGY_PROFILER_I2C_ADDR,
+        .scl_speed_hz = 400000,
+    };
+    uint32_t ua;
+    err = i2c_master_bus_add_device(bus, &dev_cfg, &s_ina);
+    if (err == ESP_OK) {
+        err = ina_read_ua(&ua);
+    }
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "Current sensor at 0x%02x: %s; using nominal currents",
+                 CONFIG_ENERGY_PROFILER_I2C_ADDR, esp_err_to_name(err));
+        if (s_ina != NULL) {
+            i2c_master_bus_rm_device(s_ina);
+            s_ina = NULL;
+        }
+        i2c_del_master_bus(bus);
+        return false;
+    }
+
+    if (xTaskCreate(sampler_task, "energy", 2048, NULL, configMAX_PRIORITIES - 2, NULL) != pdPASS) {
+        return false;
+    }
+    return true;
+}
+
+#endif /* !CONFIG_ENERGY_PROFILER_SENSOR_NONE */
+
+/**
+ * @brief Log the totals since the last report
+ */
+static void report(void)
+{
+    uint64_t time_us = 0;
+    uint64_t charge_pc = 0;
+    for (int i = 0; i < ENERGY_PHASE_COUNT; i++) {
+        time_us += s_totals[i].time_us;
+        charge_pc += s_totals[i].charge_pc;
+    }
+
+    uint64_t avg_nah = charge_pc / s_cycles / PC_PER_NAH;
+    uint64_t min_nah = s_cycle_min_pc / PC_PER_NAH;
+    uint64_t max_nah = s_cycle_max_pc / PC_PER_NAH;
+    ESP_LOGI(TAG, "%" PRIu32 " cycles of %" PRIu64 " ms: " UAH_FMT " uAh/cycle (min " UAH_FMT
+             ", max " UAH_FMT "), average %" PRIu64 " uA%s",
+             s_cycles, time_us / s_cycles / 1000U, UAH_ARGS(avg_nah), UAH_ARGS(min_nah),
+             UAH_ARGS(max_nah), (time_us > 0) ? charge_pc / time_us : 0U,
+             s_measured ? "" : " (nominal currents)");
+
+    for (int i = 0; i < ENERGY_PHASE_COUNT; i++) {
+        uint64_t nah = s_totals[i].charge_pc / s_cycles / PC_PER_NAH;
+        uint64_t share = (charge_pc > 0) ? s_totals[i].charge_pc * 100U / charge_pc : 0U;
+        ESP_LOGI(TAG, "  %-6s %8" PRIu64 " ms/cycle " UAH_FMT " uAh/cycle %3" PRIu64 "%%",
+                 PHASE_NAMES[i], s_totals[i].time_us / s_cycles / 1000U, UAH_ARGS(nah), share);
+    }
+}
+
+void energy_profiler_init(void)
+{
+    int64_t now_us = esp_timer_get_time();
+
+    if (s_magic != RTC_MAGIC || esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_UNDEFINED) {
+        // Power cycle or reset: nothing to compare with.
+        memset(s_totals, 0, sizeof(s_totals));
+        s_cycles = 0;
+        s_sleep_start_rtc_us = 0;
+        s_magic = RTC_MAGIC;
+    }
+
+    memset(s_wake, 0, sizeof(s_wake));
+
+    if (s_sleep_start_rtc_us != 0) {
+        // The RTC clock ran through sleep; esp_timer restarted at the wake.
+        uint64_t since_us = esp_rtc_get_time_us() - s_sleep_start_rtc_us;
+        uint64_t sleep_us = (since_us > (uint64_t)now_us) ? since_us - (uint64_t)now_us : 0U;
+        s_wake[ENERGY_PHASE_SLEEP].time_us = sleep_us;
+        s_wake[ENERGY_PHASE_SLEEP].charge_pc = sleep_us * NOMINAL_UA[ENERGY_PHASE_SLEEP];
+        s_sleep_start_rtc_us = 0;
+        s_after_sleep = true;
+    }
+
+    // esp_timer starts early in the boot; nothing could be sampled before now.
+    s_wake[ENERGY_PHASE_BOOT].time_us = (uint64_t)now_us;
+    s_wake[ENERGY_PHASE_BOOT].charge_pc = (uint64_t)now_us * NOMINAL_UA[ENERGY_PHASE_BOOT];
+
+    s_phase = ENERGY_PHASE_BOOT;
+    s_phase_since_us = now_us;
+    s_current_ua = NOMINAL_UA[ENERGY_PHASE_BOOT];
+    s_running = true;
+
+#if !CONFIG_ENERGY_PROFILER_SENSOR_NONE
+    s_measured = sampler_start();
+#endif
+}
+
+void energy_profiler_mark(energy_phase_t phase)
+{
+    if (phase >= ENERGY_PHASE_SLEEP) {
+        return;
+    }
+
+    int64_t now_us = esp_timer_get_time();
+    taskENTER_CRITICAL(&s_lock);
+    if (s_running) {
+        accumulate_locked(now_us);
+        s_phase = phase;
+        if (!s_measured) {
+            s_current_ua = NOMINAL_UA[phase];
+        }
+    }
+    taskEXIT_CRITICAL(&s_lock);
+}
+
+bool energy_profiler_read_current(uint32_t *ua)
+{
+    taskENTER_CRITICAL(&s_lock);
+    bool measured = s_running && s_measured;
+    *ua = s_current_ua;
+    taskEXIT_CRITICAL(&s_lock);
+    return measured;
+}
+
+void energy_profiler_enter_sleep(void)
+{
+    int64_t now_us = esp_timer_get_time();
+    taskENTER_CRITICAL(&s_lock);
+    if (!s_running) {
+        taskEXIT_CRITICAL(&s_lock);
+        return;
+    }
+    accumulate_locked(now_us);
+    s_running = false;
+    taskEXIT_CRITICAL(&s_lock);
+
+    uint64_t awake_us = 0;
+    uint64_t cycle_pc = 0;
+    for (int i = 0; i < ENERGY_PHASE_COUNT; i++) {
+        if (i != ENERGY_PHASE_SLEEP) {
+            awake_us += s_wake[i].time_us;
+        }
+        cycle_pc += s_wake[i].charge_pc;
+    }
+
+    ESP_LOGD(TAG, "cycle: slept %" PRIu64 " ms, awake %" PRIu64 " ms, " UAH_FMT " uAh",
+             s_wake[ENERGY_PHASE_SLEEP].time_us / 1000U, awake_us / 1000U,
+             UAH_ARGS(cycle_pc / PC_PER_NAH));
+
+    // A wake without a sleep before it is not a full cycle.
+    if (s_after_sleep) {
+        for (int i = 0; i < ENERGY_PHASE_COUNT; i++) {
+            s_totals[i].time_us += s_wake[i].time_us;
+            s_totals[i].charge_pc += s_wake[i].charge_pc;
+        }
+        if (s_cycles == 0 || cycle_pc < s_cycle_min_pc) {
+            s_cycle_min_pc = cycle_pc;
+        }
+        if (s_cycles == 0 || cycle_pc > s_cycle_max_pc) {
+            s_cycle_max_pc = cycle_pc;
+        }
+        s_cycles++;
+
+        if (s_cycles >= CONFIG_ENERGY_PROFILER_REPORT_CYCLES) {
+            report();
+            memset(s_totals, 0, sizeof(s_totals));
+            s_cycles = 0;
+        }
+    }
+
+    s_sleep_start_rtc_us = esp_rtc_get_time_us();
+}
+
+#else /* !CONFIG_ENERGY_PROFILER */
+
+void energy_profiler_init(void)
+{
+}
+
+void energy_profiler_mark(energy_phase_t phase)
+{
+    (void)phase;
+}
+
+bool energy_profiler_read_current(uint32_t *ua)
+{
+    *ua = 0;
+    return false;
+}
+
+void energy_profiler_enter_sleep(void)
+{
+}
+
+#endif /* CONFIG_ENERGY_PROFILER */
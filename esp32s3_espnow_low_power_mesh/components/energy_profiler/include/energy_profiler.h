@@ -0,0 +1,91 @@
+/**
+ * @file
+ * @brief Per-cycle energy accounting for deep-sleep duty-cycled firmware
+ *
+ * A cycle is one deep sleep plus the wake that follows it. The application
+ * marks the phase it is in (boot, sensor, radio, other active work) and
+ * calls energy_profiler_enter_sleep() right before esp_deep_sleep_start().
+ * Phase boundaries are timestamped with esp_timer; the sleep is timed with
+ * the RTC clock, which keeps running through deep sleep.
+ *
+ * The charge of each phase is its duration times a current. Awake phases use
+ * an INA219/INA226 on I2C when one is configured, sampled in a background
+ * task; otherwise, and always for boot before energy_profiler_init() and for
+ * deep sleep, the nominal currents set in menuconfig are used.
+ *
+ * Totals are kept in RTC memory and reported every
+ * CONFIG_ENERGY_PROFILER_REPORT_CYCLES cycles, in uAh per cycle, so that the
+ * effect of a change can be read off the log.
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Firmware phases that are accounted separately
+ */
+typedef enum {
+    ENERGY_PHASE_BOOT,      /*!< Reset or wake until the first other phase */
+    ENERGY_PHASE_ACTIVE,    /*!< CPU awake, no sensor or radio work */
+    ENERGY_PHASE_SENSOR,    /*!< Sensor powered and being read */
+    ENERGY_PHASE_RADIO,     /*!< Radio on */
+    ENERGY_PHASE_SLEEP,     /*!< Deep sleep before this wake */
+    ENERGY_PHASE_COUNT,
+} energy_phase_t;
+
+/**
+ * @brief Start accounting for this wake
+ *
+ * Call early in app_main(). Books the deep sleep that just ended, validates
+ * the RTC totals (they are cleared after a power cycle) and starts the
+ * current sampler if one is configured. The boot phase runs until the first
+ * energy_profiler_mark().
+ */
+void energy_profiler_init(void);
+
+/**
+ * @brief Enter a phase
+ *
+ * Ends the current phase. Safe to call from any task.
+ *
+ * @param phase Phase that starts now
+ */
+void energy_profiler_mark(energy_phase_t phase);
+
+/**
+ * @brief Close the cycle before deep sleep
+ *
+ * Ends the last awake phase, adds the wake to the RTC totals, logs the
+ * report when one is due and records the time sleep starts. Call last,
+ * right before esp_deep_sleep_start().
+ */
+void energy_profiler_enter_sleep(void);
+
+/**
+ * @brief Latest reading of the current sensor
+ *
+ * Lets other code sample the supply current, for example while comparing
+ * radio settings. Readings arrive every CONFIG_ENERGY_PROFILER_SAMPLE_MS.
+ *
+ * @param[out] ua Current in uA
+ * @return true if a sensor is sampling, false if only nominal currents are known
+ */
+bool energy_profiler_read_current(uint32_t *ua);
+
+/**
+ * @brief Short name of a phase, for logs
+ *
+ * @param phase Phase
+ * @return Constant string
+ */
+const char *energy_profiler_phase_name(energy_phase_t phase);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,191 @@
+/*
+ * Host-side mesh simulator.
+ *
+ * Runs hundreds of virtual root, router and leaf nodes against a shared
+ * lossy radio channel and reports how the protocol scales: reading
+ * delivery, duplicate suppression, per-node airtime and root load for
+ * each node count in a sweep. The protocol code is the firmware's own
+ * (mesh_protocol, mesh_crc16, mesh_dedup, mesh_route); see sim_node.c for
+ * the node logic and sim_radio.c for the channel model.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim.h"
+
+#define MAX_SWEEP 32U
+
+static void usage(const char *program)
+{
+    sim_config_t defaults;
+    sim_config_defaults(&defaults);
+
+    fprintf(stderr,
+            "usage: %s [options]\n"
+            "  --nodes LIST        node counts to sweep, root included (default: 25,50,100,200,300)\n"
+            "  --routers FRACTION  share of non-root nodes that route (default: %.2f)\n"
+            "  --spacing M         area side is M * sqrt(nodes) metres (default: %.0f)\n"
+            "  --tx-power DBM      transmit power (default: %.0f)\n"
+            "  --path-loss-exp N   log-distance exponent (default: %.1f)\n"
+            "  --shadowing DB      per-link shadowing std deviation (default: %.0f)\n"
+            "  --sensitivity DBM   50 %% reception level and CCA level (default: %.0f)\n"
+            "  --capture DB        margin that survives an overlap (default: %.0f)\n"
+            "  --loss P            extra random frame loss, 0..1 (default: %.2f)\n"
+            "  --latency MIN:MAX   frame end to receive task, us (default: %u:%u)\n"
+            "  --wake S            leaf wake interval (default: %u)\n"
+            "  --batch N           readings per leaf transmission (default: %u)\n"
+            "  --rx-cost US        CPU time per handled frame (default: %u)\n"
+            "  --tx-cost US        CPU time per sent frame (default: %u)\n"
+            "  --warmup S          seconds before counting starts (default: %u)\n"
+            "  --duration S        end of the counted window (default: %u)\n"
+            "  --seed N            random seed (default: %llu)\n"
+            "  --csv FILE          write per-node figures of every run\n",
+            program, defaults.router_fraction, defaults.spacing_m,
+            defaults.tx_power_dbm, defaults.path_loss_exponent,
+            defaults.shadowing_db, defaults.sensitivity_dbm, defaults.capture_db,
+            defaults.extra_loss, defaults.latency_min_us, defaults.latency_max_us,
+            defaults.wake_interval_s, defaults.batch_samples,
+            defaults.rx_cost_us, defaults.tx_cost_us,
+            defaults.warmup_s, defaults.duration_s,
+            (unsigned long long)defaults.seed);
+}
+
+static size_t parse_list(const char *text, uint32_t *values, size_t capacity)
+{
+    size_t count = 0U;
+    char *end = NULL;
+
+    while ((*text != '\0') && (count < capacity)) {
+        const unsigned long value = strtoul(text, &end, 10);
+        if ((end == text) || ((*end != ',') && (*end != '\0'))) {
+            return 0U;
+        }
+        values[count++] = (uint32_t)value;
+        text = (*end == ',') ? end + 1 : end;
+    }
+    return (*text == '\0') ? count : 0U;
+}
+
+static double percent(uint64_t part, uint64_t whole)
+{
+    return (whole > 0U) ? (100.0 * (double)part / (double)whole) : 0.0;
+}
+
+int main(int argc, char **argv)
+{
+    sim_config_t config;
+    sim_config_defaults(&config);
+    uint32_t sweep[MAX_SWEEP] = { 25U, 50U, 100U, 200U, 300U };
+    size_t sweep_count = 5U;
+    const char *csv_path = NULL;
+
+    for (int i = 1; i < argc; ++i) {
+        const char *option = argv[i];
+        const char *value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (value == NULL) {
+            usage(argv[0]);
+            return 2;
+        }
+        ++i;
+
+        if (strcmp(option, "--nodes") == 0) {
+            sweep_count = parse_list(value, sweep, MAX_SWEEP);
+        } else if (strcmp(option, "--routers") == 0) {
+            config.router_fraction = atof(value);
+        } else if (strcmp(option, "--spacing") == 0) {
+            config.spacing_m = atof(value);
+        } else if (strcmp(option, "--tx-power") == 0) {
+            config.tx_power_dbm = atof(value);
+        } else if (strcmp(option, "--path-loss-exp") == 0) {
+            config.path_loss_exponent = atof(value);
+        } else if (strcmp(option, "--shadowing") == 0) {
+            config.shadowing_db = atof(value);
+        } else if (strcmp(option, "--sensitivity") == 0) {
+            config.sensitivity_dbm = atof(value);
+        } else if (strcmp(option, "--capture") == 0) {
+            config.capture_db = atof(value);
+        } else if (strcmp(option, "--loss") == 0) {
+            config.extra_loss = atof(value);
+        } else if (strcmp(option, "--latency") == 0) {
+            if (sscanf(value, "%u:%u", &config.latency_min_us,
+                       &config.latency_max_us) != 2) {
+                sweep_count = 0U;
+            }
+        } else if (strcmp(option, "--wake") == 0) {
+            config.wake_interval_s = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(option, "--batch") == 0) {
+            config.batch_samples = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(option, "--rx-cost") == 0) {
+            config.rx_cost_us = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(option, "--tx-cost") == 0) {
+            config.tx_cost_us = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(option, "--warmup") == 0) {
+            config.warmup_s = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(option, "--duration") == 0) {
+            config.duration_s = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(option, "--seed") == 0) {
+            config.seed = strtoull(value, NULL, 10);
+        } else if (strcmp(option, "--csv") == 0) {
+            csv_path = value;
+        } else {
+            sweep_count = 0U;
+        }
+
+        if (sweep_count == 0U) {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    FILE *csv = NULL;
+    if (csv_path != NULL) {
+        csv = fopen(csv_path, "w");
+        if (csv == NULL) {
+            perror(csv_path);
+            return 1;
+        }
+        sim_write_csv_header(csv);
+    }
+
+    printf("%5s %4s %4s %6s %5s %7s %6s %6s %6s %7s %6s %8s %7s %9s %6s %6s %6s\n",
+           "nodes", "rtrs", "hops", "bcast%", "reads", "deliv%", "dupes", "lat_s",
+           "dedup%", "air_avg", "air_mx", "mx_node", "rootair", "root_rx/s",
+           "root%", "coll", "drops");
+
+    int status = 0;
+    for (size_t i = 0; i < sweep_count; ++i) {
+        config.nodes = sweep[i];
+
+        sim_result_t result;
+        if (sim_run(&config, &result, csv) != 0) {
+            fprintf(stderr, "run with %u nodes failed: invalid settings or out of memory\n",
+                    sweep[i]);
+            status = 1;
+            break;
+        }
+
+        printf("%5u %4u %4.2f %5.1f%% %5llu %6.2f%% %6llu %6.2f %5.2f%% %6.3f%% %5.2f%% %8u "
+               "%6.2f%% %9.1f %5.1f%% %6llu %6llu\n",
+               result.nodes, result.routers, result.mean_hops,
+               percent(result.leaf_broadcasts, result.leaf_frames),
+               (unsigned long long)result.readings,
+               percent(result.readings_delivered, result.readings),
+               (unsigned long long)result.readings_duplicated,
+               result.mean_latency_s,
+               percent(result.root_duplicates + result.router_duplicates,
+                       result.root_frames + result.router_frames),
+               result.airtime_mean_pct, result.airtime_max_pct, result.airtime_max_id,
+               result.root_airtime_pct, result.root_rx_per_s, result.root_cpu_pct,
+               (unsigned long long)result.collisions,
+               (unsigned long long)(result.pool_drops + result.queue_drops +
+                                    result.ttl_drops));
+        fflush(stdout);
+    }
+
+    if (csv != NULL) {
+        fclose(csv);
+    }
+    return status;
+}
@@ -0,0 +1,75 @@
+/*
+ * Compiles the real deduplication and routing sources into this file so
+ * their static tables can be saved and restored per simulated node. They
+ * must not be added to the build a second time.
+ */
+
+#include "mesh_state.h"
+
+#include <string.h>
+
+#include "../main/mesh_dedup.c"
+#include "../main/mesh_route.c"
+
+typedef struct {
+    dedup_entry_t dedup_table[DEDUP_TABLE_SIZE];
+    uint32_t dedup_clock;
+    route_entry_t routes[ROUTE_TABLE_SIZE];
+    int32_t parent_index;
+} mesh_state_t;
+
+uint16_t mesh_state_node_id;
+
+static mesh_state_t *s_loaded;
+
+/**
+ * @brief Copies the live statics into a node's buffer.
+ *
+ * Args:
+ *     state: Destination buffer.
+ */
+static void mesh_state_store(mesh_state_t *state)
+{
+    memcpy(state->dedup_table, s_table, sizeof(s_table));
+    state->dedup_clock = s_clock;
+    memcpy(state->routes, s_routes, sizeof(s_routes));
+    state->parent_index = s_parent_index;
+}
+
+size_t mesh_state_size(void)
+{
+    return sizeof(mesh_state_t);
+}
+
+void mesh_state_init(void *state)
+{
+    mesh_state_t *fresh = state;
+
+    memset(fresh, 0, sizeof(*fresh));
+    fresh->parent_index = ROUTE_NO_PARENT;
+}
+
+void mesh_state_load(void *state, uint16_t node_id)
+{
+    mesh_state_t *next = state;
+
+    if (next == s_loaded) {
+        return;
+    }
+    if (s_loaded != NULL) {
+        mesh_state_store(s_loaded);
+    }
+
+    memcpy(s_table, next->dedup_table, sizeof(s_table));
+    s_clock = next->dedup_clock;
+    memcpy(s_routes, next->routes, sizeof(s_routes));
+    s_parent_index = next->parent_index;
+
+    s_loaded = next;
+    mesh_state_node_id = node_id;
+}
+
+void mesh_state_unload(void)
+{
+    s_loaded = NULL;
+}
@@ -0,0 +1,59 @@
+#ifndef MESH_STATE_H
+#define MESH_STATE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * mesh_dedup.c and mesh_route.c keep their tables in file-scope statics,
+ * one set per chip. The simulator runs hundreds of nodes in one process,
+ * so it gives every node a private copy of those statics and loads it
+ * before calling into the real code on that node's behalf.
+ */
+
+/** Node ID seen by the loaded state as CONFIG_APP_NODE_ID. */
+extern uint16_t mesh_state_node_id;
+
+/**
+ * @brief Returns the size of one node's saved dedup and route state.
+ *
+ * Returns:
+ *     Size in bytes.
+ */
+size_t mesh_state_size(void);
+
+/**
+ * @brief Fills a state buffer with the power-on contents of both tables.
+ *
+ * Args:
+ *     state: Buffer of mesh_state_size() bytes.
+ */
+void mesh_state_init(void *state);
+
+/**
+ * @brief Makes a node's state the one the mesh sources operate on.
+ *
+ * The previously loaded node's tables are written back to its buffer
+ * first. Loading the node that is already loaded costs nothing.
+ *
+ * Args:
+ *     state: Buffer of the node to load.
+ *     node_id: Logical ID of that node.
+ */
+void mesh_state_load(void *state, uint16_t node_id);
+
+/**
+ * @brief Forgets the loaded node without saving it, before its buffer is
+ * freed.
+ */
+void mesh_state_unload(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
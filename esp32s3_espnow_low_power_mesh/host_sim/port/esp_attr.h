@@ -0,0 +1,5 @@
+/* Host stand-in for ESP-IDF esp_attr.h. RTC memory is ordinary memory here;
+ * mesh_state.c saves and restores it per simulated node. */
+#pragma once
+
+#define RTC_DATA_ATTR
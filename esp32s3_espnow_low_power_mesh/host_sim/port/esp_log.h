@@ -0,0 +1,14 @@
+/* Host stand-in for ESP-IDF esp_log.h. Only errors reach stderr; the
+ * simulator prints its own report. The others still evaluate their
+ * arguments so the sources compile without unused-variable warnings. */
+#pragma once
+
+#include <stdio.h>
+
+#define ESP_LOG_DISCARD(fmt, ...) \
+    do { if (0) { fprintf(stderr, fmt, ##__VA_ARGS__); } } while (0)
+
+#define ESP_LOGE(tag, fmt, ...) fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) ESP_LOG_DISCARD(fmt, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) ESP_LOG_DISCARD(fmt, ##__VA_ARGS__)
+#define ESP_LOGD(tag, fmt, ...) ESP_LOG_DISCARD(fmt, ##__VA_ARGS__)
@@ -0,0 +1,17 @@
+/* Host stand-in for the ESP32 ROM CRC routines: a bit-serial CRC-16/CCITT
+ * with the ROM's inversion on entry and exit. */
+#pragma once
+
+#include <stdint.h>
+
+static inline uint16_t esp_rom_crc16_be(uint16_t crc, const uint8_t *buf, uint32_t len)
+{
+    crc = (uint16_t)~crc;
+    for (uint32_t i = 0; i < len; ++i) {
+        crc ^= (uint16_t)buf[i] << 8U;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1U) ^ 0x1021U) : (uint16_t)(crc << 1U);
+        }
+    }
+    return (uint16_t)~crc;
+}
@@ -0,0 +1,13 @@
+/* Host stand-in for the FreeRTOS types and critical sections used by the
+ * linked mesh sources. The simulator is single-threaded, so the critical
+ * sections compile to nothing. */
+#pragma once
+
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
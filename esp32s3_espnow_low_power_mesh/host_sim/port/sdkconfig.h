@@ -0,0 +1,37 @@
+/* Host stand-in for the generated sdkconfig.h.
+ *
+ * The options read by the linked mesh sources and by the simulated node
+ * logic, at their Kconfig defaults. The table sizes can be overridden
+ * from CMake to try other values at scale. */
+#pragma once
+
+#include <stdint.h>
+
+/* Node whose state is loaded (see mesh_state.h). mesh_route.c compares
+ * advertised parents against it, so it cannot be a constant. */
+extern uint16_t mesh_state_node_id;
+#define CONFIG_APP_NODE_ID mesh_state_node_id
+
+#define CONFIG_APP_CRC16_SLICE4 1
+#define CONFIG_APP_DYNAMIC_ROUTING 1
+#define CONFIG_APP_ROUTE_EXPIRY_SEC 180
+#define CONFIG_APP_ROUTE_MIN_RSSI -90
+#define CONFIG_APP_FORWARD_TTL 6
+#define CONFIG_APP_RX_POOL_SIZE 16
+
+#ifndef CONFIG_APP_ROUTE_TABLE_SIZE
+#define CONFIG_APP_ROUTE_TABLE_SIZE 8
+#endif
+
+#ifndef CONFIG_APP_DEDUP_TABLE_SIZE
+#define CONFIG_APP_DEDUP_TABLE_SIZE 32
+#endif
+
+/* Leaf and root timing; the simulator takes these as defaults for its
+ * command-line options. */
+#define CONFIG_APP_WAKE_INTERVAL_SEC 60
+#define CONFIG_APP_BEACON_INTERVAL_MS 1000
+#define CONFIG_APP_BEACON_WAIT_MS 600
+#define CONFIG_APP_ACK_TIMEOUT_MS 120
+#define CONFIG_APP_MAX_RETRIES 3
+#define CONFIG_APP_BATCH_SAMPLES 1
@@ -0,0 +1,423 @@
+#include "sim.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "mesh_route.h"
+#include "mesh_state.h"
+#include "sdkconfig.h"
+#include "sim_internal.h"
+
+#define US_PER_S 1000000ULL
+
+void sim_config_defaults(sim_config_t *config)
+{
+    *config = (sim_config_t){
+        .nodes = 100U,
+        .router_fraction = 0.2,
+        .spacing_m = 30.0,
+        .tx_power_dbm = 20.0,
+        .path_loss_exponent = 3.5,
+        .shadowing_db = 4.0,
+        .sensitivity_dbm = -95.0,
+        .capture_db = 10.0,
+        .extra_loss = 0.0,
+        .latency_min_us = 200U,
+        .latency_max_us = 2000U,
+        .wake_interval_s = CONFIG_APP_WAKE_INTERVAL_SEC,
+        .batch_samples = CONFIG_APP_BATCH_SAMPLES,
+        .beacon_interval_ms = CONFIG_APP_BEACON_INTERVAL_MS,
+        .beacon_wait_ms = CONFIG_APP_BEACON_WAIT_MS,
+        .ack_timeout_ms = CONFIG_APP_ACK_TIMEOUT_MS,
+        .max_retries = CONFIG_APP_MAX_RETRIES,
+        .rx_cost_us = 150U,
+        .tx_cost_us = 100U,
+        .warmup_s = 120U,
+        .duration_s = 720U,
+        .seed = 1U,
+    };
+}
+
+// ---------------------------------------------------------------------------
+// Random numbers
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Returns the next splitmix64 value.
+ *
+ * Args:
+ *     state: Generator state; advanced in place.
+ *
+ * Returns:
+ *     64 random bits.
+ */
+static uint64_t splitmix64(uint64_t *state)
+{
+    uint64_t z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+double sim_uniform(sim_t *sim)
+{
+    return (double)(splitmix64(&sim->rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+double sim_gaussian(sim_t *sim)
+{
+    // Box-Muller; 1 - u keeps the logarithm finite.
+    const double u = 1.0 - sim_uniform(sim);
+    const double v = sim_uniform(sim);
+    return sqrt(-2.0 * log(u)) * cos(2.0 * M_PI * v);
+}
+
+// ---------------------------------------------------------------------------
+// Event queue: a binary min-heap on (time, order)
+// ---------------------------------------------------------------------------
+
+static bool event_before(const sim_event_t *a, const sim_event_t *b)
+{
+    return (a->time_us < b->time_us) ||
+           ((a->time_us == b->time_us) && (a->order < b->order));
+}
+
+bool sim_schedule(sim_t *sim, uint64_t time_us, sim_event_type_t type,
+                  uint32_t node, uint32_t epoch, mesh_rx_frame_t *item)
+{
+    if (sim->event_count == sim->event_capacity) {
+        const size_t capacity = (sim->event_capacity == 0U) ? 1024U
+                                                            : sim->event_capacity * 2U;
+        sim_event_t *grown = realloc(sim->events, capacity * sizeof(*grown));
+        if (grown == NULL) {
+            return false;
+        }
+        sim->events = grown;
+        sim->event_capacity = capacity;
+    }
+
+    const sim_event_t event = {
+        .time_us = time_us,
+        .order = sim->event_order++,
+        .type = type,
+        .node = node,
+        .epoch = epoch,
+        .item = item,
+    };
+
+    size_t hole = sim->event_count++;
+    while (hole > 0U) {
+        const size_t parent = (hole - 1U) / 2U;
+        if (!event_before(&event, &sim->events[parent])) {
+            break;
+        }
+        sim->events[hole] = sim->events[parent];
+        hole = parent;
+    }
+    sim->events[hole] = event;
+    return true;
+}
+
+static sim_event_t pop_event(sim_t *sim)
+{
+    const sim_event_t first = sim->events[0];
+    const sim_event_t last = sim->events[--sim->event_count];
+
+    size_t hole = 0U;
+    for (;;) {
+        size_t child = (hole * 2U) + 1U;
+        if (child >= sim->event_count) {
+            break;
+        }
+        if (((child + 1U) < sim->event_count) &&
+            event_before(&sim->events[child + 1U], &sim->events[child])) {
+            ++child;
+        }
+        if (!event_before(&sim->events[child], &last)) {
+            break;
+        }
+        sim->events[hole] = sim->events[child];
+        hole = child;
+    }
+    if (sim->event_count > 0U) {
+        sim->events[hole] = last;
+    }
+    return first;
+}
+
+// ---------------------------------------------------------------------------
+// Helpers shared with the radio and node models
+// ---------------------------------------------------------------------------
+
+bool sim_counting(const sim_t *sim)
+{
+    return (sim->now_us >= sim->window_start_us) &&
+           (sim->now_us < sim->window_end_us);
+}
+
+uint32_t sim_now_s(const sim_t *sim)
+{
+    return (uint32_t)(sim->now_us / US_PER_S);
+}
+
+uint32_t sim_index_of_id(const sim_t *sim, uint16_t node_id)
+{
+    // Node IDs are assigned as index + 1, with the root at ID 1.
+    const uint32_t index = (uint32_t)node_id - 1U;
+    return (index < sim->node_count) ? index : SIM_BROADCAST;
+}
+
+uint32_t sim_index_of_mac(const sim_t *sim, const uint8_t mac[6])
+{
+    if (mesh_is_broadcast_mac(mac)) {
+        return SIM_BROADCAST;
+    }
+    return sim_index_of_id(sim, (uint16_t)((mac[4] << 8) | mac[5]));
+}
+
+// ---------------------------------------------------------------------------
+// Run
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Hands one received frame to its node's receive task.
+ *
+ * The task handles frames one at a time, so a frame that arrives while
+ * the CPU is busy waits in the pool until the previous one is done.
+ *
+ * Args:
+ *     sim: Simulation.
+ *     event: EV_RX event.
+ */
+static void handle_rx(sim_t *sim, const sim_event_t *event)
+{
+    sim_node_t *node = &sim->nodes[event->node];
+
+    if (!node->awake) {
+        // The leaf stopped ESP-NOW before the frame was processed.
+        node->rx_pending--;
+        free(event->item);
+        return;
+    }
+    if (sim->now_us < node->cpu_free_us) {
+        sim_schedule(sim, node->cpu_free_us, EV_RX, event->node, 0U, event->item);
+        return;
+    }
+
+    const uint32_t sends = node->sends;
+    node_receive(sim, node, event->item);
+    const uint64_t cost = sim->config->rx_cost_us +
+                          ((uint64_t)sim->config->tx_cost_us * (node->sends - sends));
+
+    node->cpu_free_us = sim->now_us + cost;
+    node->rx_pending--;
+    if (sim_counting(sim)) {
+        node->cpu_us += cost;
+        node->rx_frames++;
+    }
+    free(event->item);
+}
+
+static void dispatch(sim_t *sim, const sim_event_t *event)
+{
+    sim_node_t *node = &sim->nodes[event->node];
+
+    switch (event->type) {
+    case EV_ROOT_BEACON:
+        node_root_beacon(sim, node);
+        sim_schedule(sim, sim->now_us + (sim->config->beacon_interval_ms * 1000ULL),
+                     EV_ROOT_BEACON, event->node, 0U, NULL);
+        break;
+    case EV_LEAF_WAKE:
+        node_leaf_wake(sim, node);
+        break;
+    case EV_LEAF_TIMER:
+        node_leaf_timer(sim, node, event->epoch);
+        break;
+    case EV_TX_TRY:
+        radio_try_transmit(sim, node);
+        break;
+    case EV_TX_END:
+        radio_end_transmit(sim, node);
+        break;
+    case EV_RX:
+        handle_rx(sim, event);
+        break;
+    }
+}
+
+/**
+ * @brief Adds the per-node figures into the result and the CSV.
+ *
+ * Args:
+ *     sim: Finished simulation.
+ *     node_csv: Optional per-node output.
+ */
+static void summarize(sim_t *sim, FILE *node_csv)
+{
+    sim_result_t *result = sim->result;
+    const double window_us = (double)(sim->window_end_us - sim->window_start_us);
+    double airtime_sum = 0.0;
+    double latency_sum = 0.0;
+
+    for (uint32_t i = 0; i < sim->node_count; ++i) {
+        sim_node_t *node = &sim->nodes[i];
+        const double airtime_pct = 100.0 * (double)node->airtime_us / window_us;
+
+        airtime_sum += airtime_pct;
+        if (airtime_pct > result->airtime_max_pct) {
+            result->airtime_max_pct = airtime_pct;
+            result->airtime_max_id = node->id;
+        }
+
+        mesh_route_t route = {0};
+        bool routed = false;
+        if (node->role != SIM_ROLE_ROOT) {
+            mesh_state_load(node->mesh_state, node->id);
+            routed = mesh_route_get_parent(sim_now_s(sim), &route);
+        }
+
+        uint32_t readings = 0U;
+        uint32_t delivered = 0U;
+        for (uint32_t r = 0; r < node->reading_count; ++r) {
+            const sim_reading_t *reading = &node->readings[r];
+            if ((reading->taken_us < sim->window_start_us) ||
+                (reading->taken_us >= sim->window_end_us)) {
+                continue;
+            }
+            ++readings;
+            if (reading->deliveries > 0U) {
+                ++delivered;
+                latency_sum += (double)(reading->first_delivery_us - reading->taken_us);
+            }
+            if (reading->deliveries > 1U) {
+                result->readings_duplicated++;
+            }
+        }
+        result->readings += readings;
+        result->readings_delivered += delivered;
+
+        if (node->role == SIM_ROLE_ROOT) {
+            result->root_airtime_pct = airtime_pct;
+            result->root_rx_per_s = (double)node->rx_frames * US_PER_S / window_us;
+            result->root_cpu_pct = 100.0 * (double)node->cpu_us / window_us;
+        }
+
+        if (node_csv != NULL) {
+            static const char *const ROLE_NAMES[] = { "root", "router", "leaf" };
+            fprintf(node_csv, "%u,%u,%s,%.1f,%.1f,%d,%u,%u,%.3f,%u,%.2f,%u,%u\n",
+                    sim->node_count, node->id, ROLE_NAMES[node->role],
+                    node->x_m, node->y_m,
+                    routed ? (int)route.next_hop_id : -1,
+                    routed ? route.hop_count : 0U,
+                    node->tx_frames, airtime_pct, node->rx_frames,
+                    100.0 * (double)node->cpu_us / window_us,
+                    readings, delivered);
+        }
+    }
+
+    result->airtime_mean_pct = airtime_sum / sim->node_count;
+    const uint64_t routed_frames = result->leaf_frames - result->leaf_broadcasts;
+    result->mean_hops = (routed_frames > 0U)
+                            ? (double)sim->leaf_hop_sum / routed_frames : 0.0;
+    result->mean_latency_s = (result->readings_delivered > 0U)
+                                 ? latency_sum / US_PER_S / result->readings_delivered
+                                 : 0.0;
+}
+
+static void release(sim_t *sim)
+{
+    for (size_t i = 0; i < sim->event_count; ++i) {
+        free(sim->events[i].item);
+    }
+    free(sim->events);
+
+    if (sim->nodes != NULL) {
+        for (uint32_t i = 0; i < sim->node_count; ++i) {
+            free(sim->nodes[i].links);
+            free(sim->nodes[i].mesh_state);
+            free(sim->nodes[i].sent);
+            free(sim->nodes[i].readings);
+        }
+        free(sim->nodes);
+    }
+    mesh_state_unload();
+}
+
+void sim_write_csv_header(FILE *node_csv)
+{
+    fprintf(node_csv, "nodes,id,role,x_m,y_m,parent,hops,tx_frames,airtime_pct,"
+                      "rx_frames,cpu_pct,readings,delivered\n");
+}
+
+int sim_run(const sim_config_t *config, sim_result_t *result, FILE *node_csv)
+{
+    if ((config->nodes < 2U) || (config->nodes > UINT16_MAX - 1U) ||
+        (config->batch_samples == 0U) ||
+        (config->batch_samples > MESH_BATCH_MAX_SAMPLES) ||
+        (config->duration_s <= config->warmup_s) ||
+        (config->latency_max_us < config->latency_min_us)) {
+        return -1;
+    }
+
+    memset(result, 0, sizeof(*result));
+    sim_t sim = {
+        .config = config,
+        .node_count = config->nodes,
+        .window_start_us = config->warmup_s * US_PER_S,
+        .window_end_us = config->duration_s * US_PER_S,
+        .rng = config->seed ^ ((uint64_t)config->nodes << 32),
+        .result = result,
+    };
+
+    sim.nodes = calloc(sim.node_count, sizeof(*sim.nodes));
+    if ((sim.nodes == NULL) || !radio_build_topology(&sim)) {
+        release(&sim);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < sim.node_count; ++i) {
+        sim_node_t *node = &sim.nodes[i];
+        node->mesh_state = malloc(mesh_state_size());
+        if (node->mesh_state == NULL) {
+            release(&sim);
+            return -1;
+        }
+        mesh_state_init(node->mesh_state);
+
+        switch (node->role) {
+        case SIM_ROLE_ROOT:
+            node->awake = true;
+            sim_schedule(&sim, 0U, EV_ROOT_BEACON, i, 0U, NULL);
+            break;
+        case SIM_ROLE_ROUTER:
+            node->awake = true;
+            result->routers++;
+            break;
+        case SIM_ROLE_LEAF:
+            result->leaves++;
+            sim_schedule(&sim,
+                         (uint64_t)(sim_uniform(&sim) * config->wake_interval_s * US_PER_S),
+                         EV_LEAF_WAKE, i, 0U, NULL);
+            break;
+        }
+    }
+    result->nodes = sim.node_count;
+
+    // Keep running after the window so readings taken near its end, and
+    // still waiting for their batch to fill, get their chance to arrive.
+    const uint64_t end_us = sim.window_end_us +
+                            ((config->batch_samples + 1ULL) *
+                             config->wake_interval_s * US_PER_S);
+
+    while ((sim.event_count > 0U) && (sim.events[0].time_us < end_us)) {
+        const sim_event_t event = pop_event(&sim);
+        sim.now_us = event.time_us;
+        dispatch(&sim, &event);
+    }
+
+    summarize(&sim, node_csv);
+    release(&sim);
+    return 0;
+}
@@ -0,0 +1,111 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Index of the root node, whose node ID is 1. */
+#define SIM_ROOT_INDEX 0U
+
+typedef struct {
+    // Topology and radio.
+    uint32_t nodes;              // Including the root.
+    double router_fraction;      // Share of non-root nodes that are routers.
+    double spacing_m;            // Area side is spacing_m * sqrt(nodes).
+    double tx_power_dbm;
+    double path_loss_exponent;   // Log-distance model, 40 dB at 1 m.
+    double shadowing_db;         // Standard deviation of per-link shadowing.
+    double sensitivity_dbm;      // 50 % frame reception; also the CCA level.
+    double capture_db;           // Margin a frame needs over an overlapping one.
+    double extra_loss;           // Random loss applied on top of the link model.
+    uint32_t latency_min_us;     // Frame end to receive-task pickup.
+    uint32_t latency_max_us;
+
+    // Firmware settings, defaulting to the Kconfig values.
+    uint32_t wake_interval_s;
+    uint32_t batch_samples;
+    uint32_t beacon_interval_ms;
+    uint32_t beacon_wait_ms;
+    uint32_t ack_timeout_ms;
+    uint32_t max_retries;
+
+    // CPU cost model for root load.
+    uint32_t rx_cost_us;         // Per received frame handled.
+    uint32_t tx_cost_us;         // Per frame handed to ESP-NOW.
+
+    // Run control.
+    uint32_t warmup_s;           // Routes settle; nothing is counted.
+    uint32_t duration_s;         // End of the measurement window.
+    uint64_t seed;
+} sim_config_t;
+
+typedef struct {
+    uint32_t nodes;
+    uint32_t routers;
+    uint32_t leaves;
+    uint64_t leaf_frames;           // Sensor frames leaves built in the window.
+    uint64_t leaf_broadcasts;       // Of those, sent without a route.
+    double mean_hops;               // Route length of the routed ones.
+
+    uint64_t readings;              // Taken by leaves in the window.
+    uint64_t readings_delivered;    // Of those, reached the root at least once.
+    uint64_t readings_duplicated;   // Of those, delivered more than once.
+    double mean_latency_s;          // Reading taken to first delivery.
+
+    uint64_t root_frames;           // Sensor frames handled by the root.
+    uint64_t root_duplicates;       // Of those, suppressed by mesh_dedup.
+    uint64_t router_frames;
+    uint64_t router_duplicates;
+    uint64_t ttl_drops;
+    uint64_t pool_drops;            // Receive pool full.
+    uint64_t queue_drops;           // Transmit queue full.
+    uint64_t collisions;            // Decodable frames lost to overlap.
+    uint64_t decode_errors;         // Batches mesh_batch_decode() rejected.
+
+    double airtime_mean_pct;        // Transmit duty cycle over all nodes.
+    double airtime_max_pct;
+    uint16_t airtime_max_id;
+    double root_airtime_pct;
+    double root_rx_per_s;           // Frames of any type the root handled.
+    double root_cpu_pct;
+} sim_result_t;
+
+/**
+ * @brief Fills a configuration with the defaults of sdkconfig.h and the
+ * radio model.
+ *
+ * Args:
+ *     config: Configuration to fill.
+ */
+void sim_config_defaults(sim_config_t *config);
+
+/**
+ * @brief Simulates one network from power-on to the end of the window.
+ *
+ * Args:
+ *     config: Network and run settings.
+ *     result: Receives the totals.
+ *     node_csv: When not NULL, receives one CSV row per node.
+ *
+ * Returns:
+ *     0 on success; -1 when the configuration is invalid or memory runs out.
+ */
+int sim_run(const sim_config_t *config, sim_result_t *result, FILE *node_csv);
+
+/**
+ * @brief Writes the header row matching the rows of sim_run().
+ *
+ * Args:
+ *     node_csv: Destination file.
+ */
+void sim_write_csv_header(FILE *node_csv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef SIM_INTERNAL_H
+#define SIM_INTERNAL_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mesh_protocol.h"
+#include "mesh_rx.h"
+#include "sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Destination index of a broadcast frame. */
+#define SIM_BROADCAST UINT32_MAX
+
+/** Frames a node can hear at once; further overlapping ones are lost. */
+#define SIM_MAX_ARRIVALS 16U
+
+/** Frames ESP-NOW accepts before esp_now_send() would fail. */
+#define SIM_TX_QUEUE_LENGTH 16U
+
+typedef enum {
+    SIM_ROLE_ROOT,
+    SIM_ROLE_ROUTER,
+    SIM_ROLE_LEAF,
+} sim_role_t;
+
+typedef enum {
+    LEAF_ASLEEP,
+    LEAF_LISTENING,      // Waiting up to beacon_wait_ms for a beacon.
+    LEAF_WAITING_ACK,
+    LEAF_BACKING_OFF,
+} sim_leaf_phase_t;
+
+typedef enum {
+    EV_ROOT_BEACON,
+    EV_LEAF_WAKE,
+    EV_LEAF_TIMER,       // Listen window, ACK timeout or retry backoff.
+    EV_TX_TRY,
+    EV_TX_END,
+    EV_RX,
+} sim_event_type_t;
+
+typedef struct {
+    uint32_t peer;
+    float rssi;
+} sim_link_t;
+
+typedef struct {
+    uint32_t sender;
+    float rssi;
+    bool corrupted;
+} sim_arrival_t;
+
+typedef struct {
+    uint32_t destination;  // Node index or SIM_BROADCAST.
+    uint8_t length;
+    uint8_t frame[MESH_MAX_PACKET_SIZE];
+} sim_frame_t;
+
+// Readings a leaf put into the frame with a given sequence number.
+typedef struct {
+    uint32_t first;
+    uint32_t count;
+} sim_sent_t;
+
+// One reading taken by a leaf, for delivery accounting.
+typedef struct {
+    uint64_t taken_us;
+    uint64_t first_delivery_us;
+    uint16_t deliveries;
+} sim_reading_t;
+
+typedef struct {
+    uint16_t id;
+    uint8_t mac[6];
+    sim_role_t role;
+    double x_m;
+    double y_m;
+    sim_link_t *links;
+    uint32_t link_count;
+    void *mesh_state;
+
+    // Radio.
+    bool awake;
+    bool transmitting;
+    bool tx_scheduled;
+    uint64_t tx_end_us;
+    sim_frame_t tx_frame;
+    sim_frame_t queue[SIM_TX_QUEUE_LENGTH];
+    uint32_t queue_head;
+    uint32_t queue_count;
+    sim_arrival_t arrivals[SIM_MAX_ARRIVALS];
+    uint32_t arrival_count;
+
+    // CPU: one receive task draining the pool in order.
+    uint64_t cpu_free_us;
+    uint32_t rx_pending;
+    uint32_t sends;
+
+    // Firmware state, RTC memory included.
+    uint16_t sequence;
+    uint16_t beacon_sequence;
+    mesh_sample_t pending[MESH_BATCH_MAX_SAMPLES];
+    uint32_t pending_ids[MESH_BATCH_MAX_SAMPLES];
+    uint32_t pending_count;
+    uint32_t boot_count;
+    sim_leaf_phase_t phase;
+    uint32_t epoch;        // Bumped to cancel an outstanding leaf timer.
+    uint32_t attempt;
+    uint8_t out_frame[MESH_MAX_PACKET_SIZE];
+    size_t out_length;
+    size_t out_samples;
+    uint32_t out_destination;
+
+    // Accounting.
+    sim_sent_t *sent;      // Indexed by sequence number.
+    uint32_t sent_capacity;
+    sim_reading_t *readings;
+    uint32_t reading_count;
+    uint32_t reading_capacity;
+    uint64_t airtime_us;
+    uint64_t cpu_us;
+    uint32_t tx_frames;
+    uint32_t rx_frames;
+} sim_node_t;
+
+typedef struct {
+    uint64_t time_us;
+    uint64_t order;        // Keeps same-time events first in, first out.
+    sim_event_type_t type;
+    uint32_t node;
+    uint32_t epoch;
+    mesh_rx_frame_t *item;
+} sim_event_t;
+
+typedef struct {
+    const sim_config_t *config;
+    sim_node_t *nodes;
+    uint32_t node_count;
+    uint64_t now_us;
+    uint64_t window_start_us;
+    uint64_t window_end_us;
+    uint64_t rng;
+
+    sim_event_t *events;
+    size_t event_count;
+    size_t event_capacity;
+    uint64_t event_order;
+
+    sim_result_t *result;  // Counters accumulate here during the window.
+    uint64_t leaf_hop_sum;
+} sim_t;
+
+// sim.c
+bool sim_schedule(sim_t *sim, uint64_t time_us, sim_event_type_t type,
+                  uint32_t node, uint32_t epoch, mesh_rx_frame_t *item);
+double sim_uniform(sim_t *sim);
+double sim_gaussian(sim_t *sim);
+bool sim_counting(const sim_t *sim);
+uint32_t sim_now_s(const sim_t *sim);
+uint32_t sim_index_of_id(const sim_t *sim, uint16_t node_id);
+uint32_t sim_index_of_mac(const sim_t *sim, const uint8_t mac[6]);
+
+// sim_radio.c
+bool radio_build_topology(sim_t *sim);
+uint32_t radio_airtime_us(size_t length);
+void radio_send(sim_t *sim, sim_node_t *node, uint32_t destination,
+                const uint8_t *frame, size_t length);
+void radio_try_transmit(sim_t *sim, sim_node_t *node);
+void radio_end_transmit(sim_t *sim, sim_node_t *node);
+void radio_power_down(sim_node_t *node);
+
+// sim_node.c
+void node_root_beacon(sim_t *sim, sim_node_t *node);
+void node_leaf_wake(sim_t *sim, sim_node_t *node);
+void node_leaf_timer(sim_t *sim, sim_node_t *node, uint32_t epoch);
+void node_receive(sim_t *sim, sim_node_t *node, mesh_rx_frame_t *item);
+void node_send_done(sim_t *sim, sim_node_t *node, uint32_t destination,
+                    bool delivered);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
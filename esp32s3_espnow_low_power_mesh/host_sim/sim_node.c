@@ -0,0 +1,498 @@
+/*
+ * Node behaviour, mirrored from main/main.c.
+ *
+ * main.c is tied to ESP-NOW, FreeRTOS and a role fixed at build time, so
+ * it cannot be linked here. The functions below follow it branch for
+ * branch and call the same mesh_protocol, mesh_dedup and mesh_route code;
+ * each names the firmware function it stands for. Keep them in step when
+ * main.c changes, or the simulator measures a protocol the nodes do not run.
+ *
+ * Not modelled: TDMA slots, payload sealing, the root uplink and firmware
+ * distribution, all of which are off in the default configuration.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "mesh_dedup.h"
+#include "mesh_protocol.h"
+#include "mesh_route.h"
+#include "mesh_state.h"
+#include "sdkconfig.h"
+#include "sim_internal.h"
+
+#define US_PER_MS 1000ULL
+#define US_PER_S 1000000ULL
+
+static uint32_t node_index(const sim_t *sim, const sim_node_t *node)
+{
+    return (uint32_t)(node - sim->nodes);
+}
+
+static uint32_t uptime_ms(const sim_t *sim)
+{
+    return (uint32_t)(sim->now_us / US_PER_MS);
+}
+
+/**
+ * @brief Finalizes a frame and hands it to the radio (send_frame()).
+ *
+ * Args:
+ *     sim: Simulation.
+ *     node: Sending node.
+ *     destination: Node index or SIM_BROADCAST.
+ *     frame: Frame starting with a mesh_packet_t header.
+ *     length: Total frame length in bytes.
+ */
+static void send_frame(sim_t *sim, sim_node_t *node, uint32_t destination,
+                       uint8_t *frame, size_t length)
+{
+    mesh_frame_finalize(frame, length);
+    radio_send(sim, node, destination, frame, length);
+}
+
+/**
+ * @brief Sends an application ACK to the immediate sender (send_ack()).
+ *
+ * Args:
+ *     sim: Simulation.
+ *     node: Acknowledging node.
+ *     destination: Node index of the immediate sender.
+ *     acknowledged_sequence: Sequence number being acknowledged.
+ */
+static void send_ack(sim_t *sim, sim_node_t *node, uint32_t destination,
+                     uint16_t acknowledged_sequence)
+{
+    mesh_packet_t ack = {
+        .version = MESH_PROTOCOL_VERSION,
+        .type = MESH_PACKET_ACK,
+        .source_id = node->id,
+        .destination_id = MESH_BROADCAST_NODE_ID,
+        .sequence = acknowledged_sequence,
+        .ttl = 1U,
+        .uptime_ms = uptime_ms(sim),
+    };
+    send_frame(sim, node, destination, (uint8_t *)&ack, sizeof(ack));
+}
+
+/**
+ * @brief Broadcasts a beacon (send_beacon()).
+ *
+ * Args:
+ *     sim: Simulation.
+ *     node: Sending node.
+ *     info: Route fields to advertise.
+ */
+static void send_beacon(sim_t *sim, sim_node_t *node, const mesh_beacon_info_t *info)
+{
+    const mesh_packet_t header = {
+        .version = MESH_PROTOCOL_VERSION,
+        .type = MESH_PACKET_BEACON,
+        .source_id = node->id,
+        .destination_id = MESH_BROADCAST_NODE_ID,
+        .sequence = ++node->beacon_sequence,
+        .ttl = 1U,
+        .uptime_ms = uptime_ms(sim),
+    };
+
+    uint8_t frame[MESH_BEACON_FRAME_SIZE];
+    memcpy(frame, &header, sizeof(header));
+    memcpy(frame + sizeof(header), info, sizeof(*info));
+    send_frame(sim, node, SIM_BROADCAST, frame, sizeof(frame));
+}
+
+/**
+ * @brief Returns the next hop for upstream traffic (upstream_mac()).
+ *
+ * Without a route the firmware falls back to APP_PARENT_MAC, which
+ * defaults to the broadcast address.
+ *
+ * Args:
+ *     sim: Simulation.
+ *     node: Sending node.
+ *     hops: Receives the route's hop count, 0 without a route; may be NULL.
+ *
+ * Returns:
+ *     Node index of the parent, or SIM_BROADCAST.
+ */
+static uint32_t upstream(sim_t *sim, sim_node_t *node, uint8_t *hops)
+{
+    mesh_route_t route = {0};
+    uint32_t next_hop = SIM_BROADCAST;
+
+    mesh_state_load(node->mesh_state, node->id);
+    if (mesh_route_get_parent(sim_now_s(sim), &route)) {
+        next_hop = sim_index_of_mac(sim, route.next_hop_mac);
+    }
+    if (hops != NULL) {
+        *hops = route.hop_count;
+    }
+    return next_hop;
+}
+
+// ---------------------------------------------------------------------------
+// Leaf cycle
+// ---------------------------------------------------------------------------
+
+static void leaf_sleep(sim_t *sim, sim_node_t *node)
+{
+    radio_power_down(node);
+    node->phase = LEAF_ASLEEP;
+    node->epoch++;
+    sim_schedule(sim, sim->now_us + (sim->config->wake_interval_s * US_PER_S),
+                 EV_LEAF_WAKE, node_index(sim, node), 0U, NULL);
+}
+
+static void leaf_arm_timer(sim_t *sim, sim_node_t *node, sim_leaf_phase_t phase,
+                           uint64_t delay_us)
+{
+    node->phase = phase;
+    node->epoch++;
+    sim_schedule(sim, sim->now_us + delay_us, EV_LEAF_TIMER,
+                 node_index(sim, node), node->epoch, NULL);
+}
+
+/**
+ * @brief Takes one reading into the buffer (leaf_record_sample()).
+ *
+ * Returns:
+ *     True when enough readings are buffered to transmit.
+ */
+static bool leaf_record_sample(sim_t *sim, sim_node_t *node)
+{
+    if (node->pending_count >= MESH_BATCH_MAX_SAMPLES) {
+        memmove(&node->pending[0], &node->pending[1],
+                (MESH_BATCH_MAX_SAMPLES - 1U) * sizeof(node->pending[0]));
+        memmove(&node->pending_ids[0], &node->pending_ids[1],
+                (MESH_BATCH_MAX_SAMPLES - 1U) * sizeof(node->pending_ids[0]));
+        node->pending_count = MESH_BATCH_MAX_SAMPLES - 1U;
+    }
+
+    if (node->reading_count == node->reading_capacity) {
+        const uint32_t capacity = (node->reading_capacity == 0U) ? 32U
+                                                                 : node->reading_capacity * 2U;
+        sim_reading_t *grown = realloc(node->readings, capacity * sizeof(*grown));
+        if (grown == NULL) {
+            return false;
+        }
+        node->readings = grown;
+        node->reading_capacity = capacity;
+    }
+    node->readings[node->reading_count] = (sim_reading_t){ .taken_us = sim->now_us };
+
+    // populate_demo_sensor_data()
+    const uint32_t step = node->boot_count % 50U;
+    mesh_sample_t *sample = &node->pending[node->pending_count];
+    sample->time_s = sim_now_s(sim);
+    sample->temperature_centi_c = (int16_t)(2200 + (int32_t)step * 3);
+    sample->humidity_centi_pct = (uint16_t)(4800 + step * 5U);
+    sample->battery_mv = (uint16_t)(4200U - (node->boot_count % 900U));
+    node->pending_ids[node->pending_count++] = node->reading_count++;
+
+    return node->pending_count >= sim->config->batch_samples;
+}
+
+static void leaf_consume_samples(sim_node_t *node, size_t count)
+{
+    if (count >= node->pending_count) {
+        node->pending_count = 0U;
+        return;
+    }
+    memmove(&node->pending[0], &node->pending[count],
+            (node->pending_count - count) * sizeof(node->pending[0]));
+    memmove(&node->pending_ids[0], &node->pending_ids[count],
+            (node->pending_count - count) * sizeof(node->pending_ids[0]));
+    node->pending_count -= (uint32_t)count;
+}
+
+/**
+ * @brief Remembers which readings went out under a sequence number, so
+ * the root can credit them on delivery.
+ */
+static void leaf_log_frame(sim_node_t *node, uint16_t sequence, size_t count)
+{
+    if (sequence >= node->sent_capacity) {
+        uint32_t capacity = (node->sent_capacity == 0U) ? 64U : node->sent_capacity;
+        while (capacity <= sequence) {
+            capacity *= 2U;
+        }
+        sim_sent_t *grown = realloc(node->sent, capacity * sizeof(*grown));
+        if (grown == NULL) {
+            return;
+        }
+        memset(&grown[node->sent_capacity], 0,
+               (capacity - node->sent_capacity) * sizeof(*grown));
+        node->sent = grown;
+        node->sent_capacity = capacity;
+    }
+    node->sent[sequence] = (sim_sent_t){
+        .first = node->pending_ids[0],
+        .count = (uint32_t)count,
+    };
+}
+
+static void leaf_send_attempt(sim_t *sim, sim_node_t *node)
+{
+    send_frame(sim, node, node->out_destination, node->out_frame, node->out_length);
+    leaf_arm_timer(sim, node, LEAF_WAITING_ACK,
+                   sim->config->ack_timeout_ms * US_PER_MS);
+}
+
+/**
+ * @brief Builds the next sensor frame and sends its first attempt
+ * (transmit_sensor_packet_with_retry()).
+ */
+static void leaf_begin_transmit(sim_t *sim, sim_node_t *node)
+{
+    mesh_packet_t packet = {
+        .version = MESH_PROTOCOL_VERSION,
+        .type = MESH_PACKET_SENSOR,
+        .source_id = node->id,
+        .destination_id = 0U,
+        .sequence = ++node->sequence,
+        .ttl = CONFIG_APP_FORWARD_TTL,
+        .flags = 0U,
+        .uptime_ms = uptime_ms(sim),
+    };
+
+    node->out_samples = 1U;
+    if (node->pending_count == 1U) {
+        packet.temperature_centi_c = node->pending[0].temperature_centi_c;
+        packet.humidity_centi_pct = node->pending[0].humidity_centi_pct;
+        packet.battery_mv = node->pending[0].battery_mv;
+        memcpy(node->out_frame, &packet, sizeof(packet));
+        node->out_length = sizeof(packet);
+    } else {
+        node->out_length = mesh_batch_encode(&packet, node->pending, node->pending_count,
+                                             sim_now_s(sim), node->out_frame,
+                                             sizeof(node->out_frame), &node->out_samples);
+        if (node->out_length == 0U) {
+            leaf_sleep(sim, node);
+            return;
+        }
+    }
+
+    leaf_log_frame(node, packet.sequence, node->out_samples);
+    uint8_t hops = 0U;
+    node->out_destination = upstream(sim, node, &hops);
+    if (sim_counting(sim)) {
+        sim->result->leaf_frames++;
+        if (node->out_destination == SIM_BROADCAST) {
+            sim->result->leaf_broadcasts++;
+        } else {
+            sim->leaf_hop_sum += hops;
+        }
+    }
+    node->attempt = 0U;
+    leaf_send_attempt(sim, node);
+}
+
+void node_leaf_wake(sim_t *sim, sim_node_t *node)
+{
+    node->boot_count++;
+    if (!leaf_record_sample(sim, node)) {
+        // Radio stays off until the batch is due.
+        sim_schedule(sim, sim->now_us + (sim->config->wake_interval_s * US_PER_S),
+                     EV_LEAF_WAKE, node_index(sim, node), 0U, NULL);
+        return;
+    }
+
+    // run_leaf_cycle(): listen for a beacon before sending.
+    node->awake = true;
+    node->cpu_free_us = sim->now_us;
+    leaf_arm_timer(sim, node, LEAF_LISTENING, sim->config->beacon_wait_ms * US_PER_MS);
+}
+
+void node_leaf_timer(sim_t *sim, sim_node_t *node, uint32_t epoch)
+{
+    if (epoch != node->epoch) {
+        return;
+    }
+
+    switch (node->phase) {
+    case LEAF_LISTENING:
+        leaf_begin_transmit(sim, node);
+        break;
+    case LEAF_WAITING_ACK:
+        // Small backoff avoids repeated collisions with neighboring nodes.
+        leaf_arm_timer(sim, node, LEAF_BACKING_OFF,
+                       (15U + (node->attempt * 20U)) * US_PER_MS);
+        break;
+    case LEAF_BACKING_OFF:
+        if (++node->attempt > sim->config->max_retries) {
+            // Readings stay buffered for the next cycle.
+            leaf_sleep(sim, node);
+        } else {
+            leaf_send_attempt(sim, node);
+        }
+        break;
+    case LEAF_ASLEEP:
+        break;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Root beacons and packet processing
+// ---------------------------------------------------------------------------
+
+void node_root_beacon(sim_t *sim, sim_node_t *node)
+{
+    // root_beacon_task(): zero hops, zero cost.
+    const mesh_beacon_info_t info = {
+        .hop_count = 0U,
+        .path_cost = 0U,
+        .parent_id = MESH_BROADCAST_NODE_ID,
+    };
+    send_beacon(sim, node, &info);
+
+    const uint64_t start_us = (node->cpu_free_us > sim->now_us) ? node->cpu_free_us
+                                                                : sim->now_us;
+    node->cpu_free_us = start_us + sim->config->tx_cost_us;
+    if (sim_counting(sim)) {
+        node->cpu_us += sim->config->tx_cost_us;
+    }
+}
+
+/**
+ * @brief Learns routes from a beacon and relays it on routers
+ * (handle_beacon()).
+ */
+static void handle_beacon(sim_t *sim, sim_node_t *node, const mesh_rx_frame_t *item)
+{
+    mesh_beacon_info_t info;
+    memcpy(&info, item->frame + sizeof(mesh_packet_t), sizeof(info));
+
+    const uint32_t now_s = sim_now_s(sim);
+    mesh_state_load(node->mesh_state, node->id);
+    mesh_route_update_from_beacon(item->source_mac, item->packet.source_id,
+                                  item->packet.sequence, &info, item->rssi, now_s);
+
+    mesh_route_t route;
+    if (!mesh_route_get_parent(now_s, &route)) {
+        return;
+    }
+
+    if ((node->role == SIM_ROLE_ROUTER) &&
+        (memcmp(route.next_hop_mac, item->source_mac, sizeof(route.next_hop_mac)) == 0)) {
+        mesh_beacon_info_t relayed = info;
+        relayed.hop_count = route.hop_count;
+        relayed.path_cost = route.path_cost;
+        relayed.parent_id = route.next_hop_id;
+        send_beacon(sim, node, &relayed);
+    }
+}
+
+/**
+ * @brief Credits the readings of a delivered frame to their leaf
+ * (deliver_sensor_packet() / deliver_sensor_batch()).
+ */
+static void root_deliver(sim_t *sim, const mesh_rx_frame_t *item)
+{
+    const mesh_packet_t *packet = &item->packet;
+    size_t count = 1U;
+
+    if (packet->type == MESH_PACKET_SENSOR_BATCH) {
+        mesh_sample_t samples[MESH_BATCH_MAX_SAMPLES];
+        if (mesh_batch_decode(item->frame, item->length, sim_now_s(sim), samples,
+                              MESH_BATCH_MAX_SAMPLES, &count) != ESP_OK) {
+            sim->result->decode_errors++;
+            return;
+        }
+    }
+
+    const uint32_t source = sim_index_of_id(sim, packet->source_id);
+    if (source == SIM_BROADCAST) {
+        return;
+    }
+    sim_node_t *leaf = &sim->nodes[source];
+    if ((packet->sequence >= leaf->sent_capacity) ||
+        (leaf->sent[packet->sequence].count != count)) {
+        sim->result->decode_errors++;
+        return;
+    }
+
+    const sim_sent_t *sent = &leaf->sent[packet->sequence];
+    for (uint32_t r = sent->first; r < sent->first + sent->count; ++r) {
+        sim_reading_t *reading = &leaf->readings[r];
+        if (reading->deliveries++ == 0U) {
+            reading->first_delivery_us = sim->now_us;
+        }
+    }
+}
+
+void node_receive(sim_t *sim, sim_node_t *node, mesh_rx_frame_t *item)
+{
+    // process_received_packet()
+    mesh_packet_t *packet = &item->packet;
+
+    if (packet->type == MESH_PACKET_BEACON) {
+        if (node->role != SIM_ROLE_ROOT) {
+            handle_beacon(sim, node, item);
+        }
+        if ((node->role == SIM_ROLE_LEAF) && (node->phase == LEAF_LISTENING)) {
+            // run_leaf_cycle() stops listening at the first beacon.
+            leaf_begin_transmit(sim, node);
+        }
+        return;
+    }
+
+    if (packet->type == MESH_PACKET_ACK) {
+        if ((node->role == SIM_ROLE_LEAF) && (node->phase == LEAF_WAITING_ACK) &&
+            (packet->sequence == node->sequence)) {
+            leaf_consume_samples(node, node->out_samples);
+            if (node->pending_count > 0U) {
+                // Flush the whole buffer before sleeping.
+                leaf_begin_transmit(sim, node);
+            } else {
+                leaf_sleep(sim, node);
+            }
+        }
+        return;
+    }
+
+    if ((packet->type != MESH_PACKET_SENSOR) &&
+        (packet->type != MESH_PACKET_SENSOR_BATCH)) {
+        return;
+    }
+
+    const bool counting = sim_counting(sim);
+    if (counting && (node->role == SIM_ROLE_ROOT)) {
+        sim->result->root_frames++;
+    } else if (counting && (node->role == SIM_ROLE_ROUTER)) {
+        sim->result->router_frames++;
+    }
+
+    // ACK the immediate sender even when the payload is a duplicate.
+    send_ack(sim, node, sim_index_of_mac(sim, item->source_mac), packet->sequence);
+
+    mesh_state_load(node->mesh_state, node->id);
+    if (mesh_dedup_check_and_record(packet->source_id, packet->sequence)) {
+        if (counting && (node->role == SIM_ROLE_ROOT)) {
+            sim->result->root_duplicates++;
+        } else if (counting && (node->role == SIM_ROLE_ROUTER)) {
+            sim->result->router_duplicates++;
+        }
+        return;
+    }
+
+    if (node->role == SIM_ROLE_ROOT) {
+        root_deliver(sim, item);
+    } else if (node->role == SIM_ROLE_ROUTER) {
+        if (packet->ttl <= 1U) {
+            if (counting) {
+                sim->result->ttl_drops++;
+            }
+            return;
+        }
+        packet->ttl--;
+        send_frame(sim, node, upstream(sim, node, NULL), item->frame, item->length);
+    }
+    // Leaves ignore sensor packets beyond the ACK.
+}
+
+void node_send_done(sim_t *sim, sim_node_t *node, uint32_t destination, bool delivered)
+{
+    // espnow_send_callback(): MAC-layer ACKs feed the ETX estimate.
+    mesh_state_load(node->mesh_state, node->id);
+    mesh_route_report_delivery(sim->nodes[destination].mac, delivered);
+}
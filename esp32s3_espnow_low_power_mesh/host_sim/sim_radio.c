@@ -0,0 +1,335 @@
+/*
+ * Virtual 2.4 GHz channel shared by every node.
+ *
+ * Link budget: log-distance path loss (40 dB at 1 m) with fixed per-link
+ * log-normal shadowing, symmetric in both directions. A frame is decoded
+ * with a probability that rises from 50 % at the sensitivity level, and
+ * extra_loss is applied on top.
+ *
+ * Medium access is a simplified 802.11 DCF: a node defers while it senses
+ * any frame at or above the sensitivity level, then waits DIFS plus a
+ * random backoff. Nodes out of range of each other can still collide at a
+ * receiver in between (hidden terminals). Overlapping frames destroy each
+ * other at a receiver unless one is stronger by capture_db, and a node
+ * that is transmitting hears nothing.
+ *
+ * Unicast frames succeed at the link layer when the destination decodes
+ * them; the MAC ACK costs the receiver airtime but is assumed not to
+ * collide. ESP-NOW's own link-layer retransmissions are not modelled.
+ */
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sdkconfig.h"
+#include "sim_internal.h"
+
+// ESP-NOW's default rate is 802.11b 1 Mbit/s with the long preamble.
+#define PLCP_US 192U
+#define US_PER_BYTE 8U
+// MAC header, category, OUI, random value, vendor element header and FCS
+// around the ESP-NOW payload.
+#define ESPNOW_OVERHEAD_BYTES 43U
+#define SIFS_US 10U
+#define DIFS_US 50U
+#define SLOT_US 20U
+#define CW_MIN 31U
+#define MAC_ACK_US (SIFS_US + PLCP_US + (14U * US_PER_BYTE))
+
+// Links weaker than this below the sensitivity neither decode nor
+// interfere meaningfully and are left out of the neighbor lists.
+#define LINK_CUTOFF_DB 10.0
+
+// Reception probability rises through the sensitivity level with this
+// slope, in dB per e-fold of the odds.
+#define RX_SLOPE_DB 1.0
+
+static bool add_link(sim_node_t *node, uint32_t peer, float rssi)
+{
+    if ((node->link_count & (node->link_count - 1U)) == 0U) {
+        const uint32_t capacity = (node->link_count == 0U) ? 8U : node->link_count * 2U;
+        sim_link_t *grown = realloc(node->links, capacity * sizeof(*grown));
+        if (grown == NULL) {
+            return false;
+        }
+        node->links = grown;
+    }
+    node->links[node->link_count++] = (sim_link_t){ .peer = peer, .rssi = rssi };
+    return true;
+}
+
+bool radio_build_topology(sim_t *sim)
+{
+    const sim_config_t *config = sim->config;
+    const double side_m = config->spacing_m * sqrt((double)sim->node_count);
+    const uint32_t routers = (uint32_t)lround(config->router_fraction *
+                                              (sim->node_count - 1U));
+
+    for (uint32_t i = 0; i < sim->node_count; ++i) {
+        sim_node_t *node = &sim->nodes[i];
+        node->id = (uint16_t)(i + 1U);
+        node->mac[0] = 0x02U;  // Locally administered.
+        node->mac[4] = (uint8_t)(node->id >> 8);
+        node->mac[5] = (uint8_t)node->id;
+
+        if (i == SIM_ROOT_INDEX) {
+            node->role = SIM_ROLE_ROOT;
+            node->x_m = side_m / 2.0;
+            node->y_m = side_m / 2.0;
+        } else {
+            node->role = (i <= routers) ? SIM_ROLE_ROUTER : SIM_ROLE_LEAF;
+            node->x_m = sim_uniform(sim) * side_m;
+            node->y_m = sim_uniform(sim) * side_m;
+        }
+    }
+
+    const double cutoff_dbm = config->sensitivity_dbm - LINK_CUTOFF_DB;
+    for (uint32_t i = 0; i < sim->node_count; ++i) {
+        for (uint32_t j = i + 1U; j < sim->node_count; ++j) {
+            const double dx = sim->nodes[i].x_m - sim->nodes[j].x_m;
+            const double dy = sim->nodes[i].y_m - sim->nodes[j].y_m;
+            const double distance_m = fmax(1.0, sqrt((dx * dx) + (dy * dy)));
+            const double path_loss_db = 40.0 +
+                                        (10.0 * config->path_loss_exponent *
+                                         log10(distance_m)) +
+                                        (config->shadowing_db * sim_gaussian(sim));
+            const double rssi = config->tx_power_dbm - path_loss_db;
+
+            if (rssi < cutoff_dbm) {
+                continue;
+            }
+            if (!add_link(&sim->nodes[i], j, (float)rssi) ||
+                !add_link(&sim->nodes[j], i, (float)rssi)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+uint32_t radio_airtime_us(size_t length)
+{
+    return PLCP_US + ((ESPNOW_OVERHEAD_BYTES + (uint32_t)length) * US_PER_BYTE);
+}
+
+/**
+ * @brief Schedules the next channel access attempt after DIFS and a backoff.
+ *
+ * Args:
+ *     sim: Simulation.
+ *     node: Node with frames queued.
+ *     earliest_us: Time the medium is expected to be free.
+ */
+static void schedule_access(sim_t *sim, sim_node_t *node, uint64_t earliest_us)
+{
+    const uint32_t slots = (uint32_t)(sim_uniform(sim) * (CW_MIN + 1U));
+    node->tx_scheduled = sim_schedule(sim, earliest_us + DIFS_US + (slots * SLOT_US),
+                                      EV_TX_TRY, (uint32_t)(node - sim->nodes),
+                                      0U, NULL);
+}
+
+void radio_send(sim_t *sim, sim_node_t *node, uint32_t destination,
+                const uint8_t *frame, size_t length)
+{
+    node->sends++;
+    if (node->queue_count == SIM_TX_QUEUE_LENGTH) {
+        if (sim_counting(sim)) {
+            sim->result->queue_drops++;
+        }
+        return;
+    }
+
+    sim_frame_t *slot = &node->queue[(node->queue_head + node->queue_count) %
+                                     SIM_TX_QUEUE_LENGTH];
+    slot->destination = destination;
+    slot->length = (uint8_t)length;
+    memcpy(slot->frame, frame, length);
+    node->queue_count++;
+
+    if (!node->transmitting && !node->tx_scheduled) {
+        node->tx_scheduled = sim_schedule(sim, sim->now_us + DIFS_US, EV_TX_TRY,
+                                          (uint32_t)(node - sim->nodes), 0U, NULL);
+    }
+}
+
+void radio_try_transmit(sim_t *sim, sim_node_t *node)
+{
+    node->tx_scheduled = false;
+    if (node->transmitting || (node->queue_count == 0U)) {
+        return;
+    }
+
+    // Clear channel assessment: defer to anything decodable on the air.
+    uint64_t busy_until_us = 0U;
+    for (uint32_t a = 0; a < node->arrival_count; ++a) {
+        const sim_arrival_t *arrival = &node->arrivals[a];
+        if (arrival->rssi >= sim->config->sensitivity_dbm) {
+            const uint64_t end_us = sim->nodes[arrival->sender].tx_end_us;
+            busy_until_us = (end_us > busy_until_us) ? end_us : busy_until_us;
+        }
+    }
+    if (busy_until_us > sim->now_us) {
+        schedule_access(sim, node, busy_until_us);
+        return;
+    }
+
+    node->tx_frame = node->queue[node->queue_head];
+    node->queue_head = (node->queue_head + 1U) % SIM_TX_QUEUE_LENGTH;
+    node->queue_count--;
+
+    const uint32_t airtime_us = radio_airtime_us(node->tx_frame.length);
+    const uint32_t index = (uint32_t)(node - sim->nodes);
+    const float capture_db = (float)sim->config->capture_db;
+
+    node->transmitting = true;
+    node->tx_end_us = sim->now_us + airtime_us;
+    if (sim_counting(sim)) {
+        node->airtime_us += airtime_us;
+        node->tx_frames++;
+    }
+
+    // Half duplex: whatever this node was receiving is lost.
+    for (uint32_t a = 0; a < node->arrival_count; ++a) {
+        node->arrivals[a].corrupted = true;
+    }
+
+    for (uint32_t l = 0; l < node->link_count; ++l) {
+        const sim_link_t *link = &node->links[l];
+        sim_node_t *receiver = &sim->nodes[link->peer];
+        if (!receiver->awake) {
+            continue;
+        }
+
+        bool corrupted = receiver->transmitting;
+        for (uint32_t a = 0; a < receiver->arrival_count; ++a) {
+            sim_arrival_t *arrival = &receiver->arrivals[a];
+            if (link->rssi > arrival->rssi - capture_db) {
+                arrival->corrupted = true;
+            }
+            if (arrival->rssi > link->rssi - capture_db) {
+                corrupted = true;
+            }
+        }
+
+        if (receiver->arrival_count < SIM_MAX_ARRIVALS) {
+            receiver->arrivals[receiver->arrival_count++] = (sim_arrival_t){
+                .sender = index,
+                .rssi = link->rssi,
+                .corrupted = corrupted,
+            };
+        }
+    }
+
+    sim_schedule(sim, node->tx_end_us, EV_TX_END, index, 0U, NULL);
+}
+
+/**
+ * @brief Copies a decoded frame into the receiver's pool, as
+ * mesh_rx_submit() does, and queues it for the receive task.
+ *
+ * Args:
+ *     sim: Simulation.
+ *     receiver: Node that decoded the frame.
+ *     sender: Node that sent it.
+ *     rssi: Received signal strength in dBm.
+ *     frame: Frame that was on the air.
+ */
+static void deliver(sim_t *sim, sim_node_t *receiver, const sim_node_t *sender,
+                    float rssi, const sim_frame_t *frame)
+{
+    if (mesh_packet_validate(frame->frame, frame->length) != ESP_OK) {
+        return;
+    }
+    if (receiver->rx_pending >= CONFIG_APP_RX_POOL_SIZE) {
+        if (sim_counting(sim)) {
+            sim->result->pool_drops++;
+        }
+        return;
+    }
+
+    mesh_rx_frame_t *item = malloc(sizeof(*item));
+    if (item == NULL) {
+        return;
+    }
+    memcpy(item->source_mac, sender->mac, sizeof(item->source_mac));
+    item->length = frame->length;
+    item->rssi = (int8_t)fmax(-128.0, fmin(127.0, lround(rssi)));
+    memcpy(item->frame, frame->frame, frame->length);
+
+    const uint32_t spread = sim->config->latency_max_us - sim->config->latency_min_us;
+    const uint64_t latency_us = sim->config->latency_min_us +
+                                (uint64_t)(sim_uniform(sim) * spread);
+    if (!sim_schedule(sim, sim->now_us + latency_us, EV_RX,
+                      (uint32_t)(receiver - sim->nodes), 0U, item)) {
+        free(item);
+        return;
+    }
+    receiver->rx_pending++;
+}
+
+void radio_end_transmit(sim_t *sim, sim_node_t *node)
+{
+    const uint32_t index = (uint32_t)(node - sim->nodes);
+    const sim_frame_t *frame = &node->tx_frame;
+    const double sensitivity_dbm = sim->config->sensitivity_dbm;
+    bool delivered = false;
+
+    node->transmitting = false;
+
+    for (uint32_t l = 0; l < node->link_count; ++l) {
+        const sim_link_t *link = &node->links[l];
+        sim_node_t *receiver = &sim->nodes[link->peer];
+
+        uint32_t a = 0;
+        while ((a < receiver->arrival_count) &&
+               (receiver->arrivals[a].sender != index)) {
+            ++a;
+        }
+        if (a == receiver->arrival_count) {
+            continue;  // Asleep when the frame started, or no room to hear it.
+        }
+        const bool corrupted = receiver->arrivals[a].corrupted;
+        receiver->arrivals[a] = receiver->arrivals[--receiver->arrival_count];
+
+        if (!receiver->awake ||
+            ((frame->destination != SIM_BROADCAST) && (frame->destination != link->peer))) {
+            continue;
+        }
+        if (corrupted) {
+            if ((link->rssi >= sensitivity_dbm) && sim_counting(sim)) {
+                sim->result->collisions++;
+            }
+            continue;
+        }
+
+        const double p = (1.0 - sim->config->extra_loss) /
+                         (1.0 + exp(-(link->rssi - sensitivity_dbm) / RX_SLOPE_DB));
+        if (sim_uniform(sim) >= p) {
+            continue;
+        }
+
+        deliver(sim, receiver, node, link->rssi, frame);
+        if (frame->destination == link->peer) {
+            // The hardware ACKs before the frame reaches the pool.
+            delivered = true;
+            if (sim_counting(sim)) {
+                receiver->airtime_us += MAC_ACK_US;
+            }
+        }
+    }
+
+    if (frame->destination != SIM_BROADCAST) {
+        node_send_done(sim, node, frame->destination, delivered);
+    }
+    if (node->queue_count > 0U) {
+        schedule_access(sim, node, sim->now_us);
+    }
+}
+
+void radio_power_down(sim_node_t *node)
+{
+    node->awake = false;
+    node->queue_count = 0U;
+    node->arrival_count = 0U;
+}
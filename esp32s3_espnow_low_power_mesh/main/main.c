@@ -2,6 +2,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/time.h>
 
 #include "esp_check.h"
 #include "esp_event.h"
@@ -12,43 +13,42 @@
 #include "esp_wifi.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
-#include "freertos/queue.h"
 #include "freertos/task.h"
 #include "nvs_flash.h"
 
+#include "energy_profiler.h"
+#include "mesh_crc16.h"
+#include "mesh_crypto.h"
+#include "mesh_dedup.h"
+#include "mesh_ota.h"
 #include "mesh_protocol.h"
+#include "mesh_route.h"
+#include "mesh_rx.h"
+#include "mesh_tdma.h"
+#include "mesh_uplink.h"
 #include "power_manager.h"
 
-#define RX_QUEUE_LENGTH 12U
 #define RX_EVENT_PACKET BIT0
 #define RX_EVENT_BEACON BIT1
 #define RX_EVENT_ACK BIT2
-#define MAX_RECENT_SEQUENCES 16U
+#define RX_STATS_INTERVAL_MS 10000U
 
 static const char *TAG = "mesh_app";
 static const uint8_t BROADCAST_MAC[6] = {
     0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU
 };
 
-typedef struct {
-    uint8_t source_mac[6];
-    mesh_packet_t packet;
-} rx_item_t;
-
-typedef struct {
-    uint16_t source_id;
-    uint16_t sequence;
-} sequence_record_t;
-
 RTC_DATA_ATTR static uint16_t s_sequence = 0U;
 RTC_DATA_ATTR static uint32_t s_boot_count = 0U;
 
-static QueueHandle_t s_rx_queue;
+// Leaf readings buffered across deep-sleep cycles until a batch is sent.
+RTC_DATA_ATTR static mesh_sample_t s_pending_samples[MESH_BATCH_MAX_SAMPLES];
+RTC_DATA_ATTR static uint32_t s_pending_count = 0U;
+
 static EventGroupHandle_t s_events;
 static uint8_t s_parent_mac[6];
 static uint16_t s_last_acked_sequence;
-static sequence_record_t s_recent_sequences[MAX_RECENT_SEQUENCES];
-static size_t s_recent_index;
+static uint16_t s_beacon_sequence;
 
 /**
  * @brief Returns the configured logical node role name.
@@ -67,6 +67,34 @@ static const char *node_role_name(void)
 #endif
 }
 
+/**
+ * @brief Returns microseconds on the RTC-backed system clock.
+ *
+ * Unlike esp_timer, the system time keeps counting through deep sleep, so
+ * buffered samples, learned routes, and the TDMA schedule from earlier wake
+ * cycles share one time base.
+ *
+ * Returns:
+ *     Current system time in microseconds.
+ */
+static uint64_t rtc_clock_us(void)
+{
+    struct timeval now;
+    gettimeofday(&now, NULL);
+    return ((uint64_t)now.tv_sec * 1000000ULL) + (uint64_t)now.tv_usec;
+}
+
+/**
+ * @brief Returns seconds on the RTC-backed system clock.
+ *
+ * Returns:
+ *     Current system time in seconds.
+ */
+static uint32_t rtc_clock_s(void)
+{
+    return (uint32_t)(rtc_clock_us() / 1000000ULL);
+}
+
 /**
  * @brief Initializes NVS and erases incompatible data when required.
  *
@@ -96,6 +124,12 @@ static esp_err_t initialize_wifi(void)
     ESP_RETURN_ON_ERROR(esp_netif_init(), TAG, "esp_netif_init failed");
     ESP_RETURN_ON_ERROR(esp_event_loop_create_default(), TAG,
                         "event loop creation failed");
+#if CONFIG_APP_UPLINK_MQTT
+    // The MQTT uplink needs an IP interface on the station.
+    if (esp_netif_create_default_wifi_sta() == NULL) {
+        return ESP_FAIL;
+    }
+#endif
 
     wifi_init_config_t config = WIFI_INIT_CONFIG_DEFAULT();
     ESP_RETURN_ON_ERROR(esp_wifi_init(&config), TAG, "esp_wifi_init failed");
@@ -166,10 +200,18 @@ static void espnow_send_callback(const uint8_t *destination_mac,
              destination_mac[0], destination_mac[1], destination_mac[2],
              destination_mac[3], destination_mac[4], destination_mac[5],
              (status == ESP_NOW_SEND_SUCCESS) ? "ok" : "failed");
+
+#if CONFIG_APP_DYNAMIC_ROUTING
+    // MAC-layer ACKs of unicast frames feed the ETX link estimate.
+    if (!mesh_is_broadcast_mac(destination_mac)) {
+        mesh_route_report_delivery(destination_mac,
+                                   status == ESP_NOW_SEND_SUCCESS);
+    }
+#endif
 }
 
 /**
- * @brief ESP-NOW receive callback that copies packets into a FreeRTOS queue.
+ * @brief ESP-NOW receive callback that copies packets into the receive pool.
  *
  * Args:
  *     info: Reception metadata containing source and destination MAC addresses.
@@ -180,21 +222,14 @@ static void espnow_receive_callback(const esp_now_recv_info_t *info,
                                     const uint8_t *data,
                                     int length)
 {
-    if ((info == NULL) || (data == NULL) ||
-        (length != (int)sizeof(mesh_packet_t))) {
+    if ((info == NULL) || (data == NULL)) {
         return;
     }
 
-    if (mesh_packet_validate(data, (size_t)length) != ESP_OK) {
-        return;
-    }
-
-    rx_item_t item = {0};
-    memcpy(item.source_mac, info->src_addr, sizeof(item.source_mac));
-    memcpy(&item.packet, data, sizeof(item.packet));
-
     // The callback runs in the Wi-Fi task, so never block here.
-    if (xQueueSend(s_rx_queue, &item, 0) == pdTRUE) {
+    const int8_t rssi = (info->rx_ctrl != NULL) ? (int8_t)info->rx_ctrl->rssi
+                                                : INT8_MIN;
+    if (mesh_rx_submit(info->src_addr, rssi, data, length)) {
         xEventGroupSetBits(s_events, RX_EVENT_PACKET);
     }
 }
@@ -239,6 +274,25 @@ static esp_err_t initialize_espnow(void)
     return ESP_OK;
 }
 
+/**
+ * @brief Finalizes and sends a frame of any length to an ESP-NOW peer.
+ *
+ * Args:
+ *     destination_mac: Destination peer MAC address.
+ *     frame: Frame starting with a mesh_packet_t header.
+ *     length: Total frame length in bytes.
+ *
+ * Returns:
+ *     ESP_OK on success or an ESP-NOW transmission error code.
+ */
+static esp_err_t send_frame(const uint8_t destination_mac[6],
+                            uint8_t *frame,
+                            size_t length)
+{
+    mesh_frame_finalize(frame, length);
+    return esp_now_send(destination_mac, frame, length);
+}
+
 /**
  * @brief Sends a finalized mesh packet to an ESP-NOW peer.
  *
@@ -252,10 +306,7 @@ static esp_err_t initialize_espnow(void)
 static esp_err_t send_packet(const uint8_t destination_mac[6],
                              mesh_packet_t *packet)
 {
-    mesh_packet_finalize(packet);
-    return esp_now_send(destination_mac,
-                        (const uint8_t *)packet,
-                        sizeof(*packet));
+    return send_frame(destination_mac, (uint8_t *)packet, sizeof(*packet));
 }
 
 /**
@@ -288,29 +339,112 @@ static esp_err_t send_ack(const uint8_t destination_mac[6],
 }
 
 /**
- * @brief Checks and records recently received packet sequences.
+ * @brief Broadcasts a beacon advertising this node's route and time base.
  *
  * Args:
- *     source_id: Logical source node identifier.
- *     sequence: Packet sequence number.
+ *     info: Route and TDMA fields to advertise.
+ *
+ * Returns:
+ *     ESP_OK on success or an ESP-NOW error code.
+ */
+static esp_err_t send_beacon(const mesh_beacon_info_t *info)
+{
+    const mesh_packet_t header = {
+        .version = MESH_PROTOCOL_VERSION,
+        .type = MESH_PACKET_BEACON,
+        .source_id = CONFIG_APP_NODE_ID,
+        .destination_id = MESH_BROADCAST_NODE_ID,
+        .sequence = ++s_beacon_sequence,
+        .ttl = 1U,
+        .uptime_ms = (uint32_t)(esp_timer_get_time() / 1000ULL),
+    };
+
+    uint8_t frame[MESH_BEACON_FRAME_SIZE];
+    memcpy(frame, &header, sizeof(header));
+    memcpy(frame + sizeof(header), info, sizeof(*info));
+    return send_frame(BROADCAST_MAC, frame, sizeof(frame));
+}
+
+/**
+ * @brief Returns the MAC address that upstream traffic should be sent to.
+ *
+ * With APP_DYNAMIC_ROUTING this is the parent learned from beacons, falling
+ * back to APP_PARENT_MAC until a route is known.
  *
  * Returns:
- *     True when the packet is a duplicate; otherwise false.
+ *     Next-hop MAC address; valid until the next call.
  */
-static bool is_duplicate_packet(uint16_t source_id, uint16_t sequence)
+static const uint8_t *upstream_mac(void)
 {
-    for (size_t i = 0; i < MAX_RECENT_SEQUENCES; ++i) {
-        if ((s_recent_sequences[i].source_id == source_id) &&
-            (s_recent_sequences[i].sequence == sequence)) {
-            return true;
+#if CONFIG_APP_DYNAMIC_ROUTING
+#if CONFIG_APP_ENABLE_ENCRYPTION
+    const bool encrypted = true;
+#else
+    const bool encrypted = false;
+#endif
+    static mesh_route_t route;
+
+    if (mesh_route_get_parent(rtc_clock_s(), &route)) {
+        if (add_peer(route.next_hop_mac, encrypted) == ESP_OK) {
+            return route.next_hop_mac;
         }
+        ESP_LOGW(TAG, "Peer for routed parent %u unavailable", route.next_hop_id);
+    }
+#endif
+    return s_parent_mac;
+}
+
+#if CONFIG_APP_MESH_OTA
+static const mesh_ota_transport_t OTA_TRANSPORT = {
+    .send = send_frame,
+    .upstream_mac = upstream_mac,
+};
+#endif
+
+#if CONFIG_APP_DYNAMIC_ROUTING && !CONFIG_APP_ROLE_ROOT
+/**
+ * @brief Learns routes from a beacon and, on routers, propagates it downstream.
+ *
+ * Routers only re-broadcast beacons heard from their own parent, so every
+ * router emits one beacon per root beacon interval.
+ *
+ * Args:
+ *     item: Queue item holding a validated beacon frame.
+ */
+static void handle_beacon(const mesh_rx_frame_t *item)
+{
+    mesh_beacon_info_t info;
+    memcpy(&info, item->frame + sizeof(mesh_packet_t), sizeof(info));
+
+    const uint32_t now_s = rtc_clock_s();
+    const bool changed = mesh_route_update_from_beacon(
+        item->source_mac, item->packet.source_id, item->packet.sequence,
+        &info, item->rssi, now_s);
+
+    mesh_route_t route;
+    if (!mesh_route_get_parent(now_s, &route)) {
+        return;
+    }
+
+    if (changed) {
+        ESP_LOGI(TAG, "Parent is node %u hops=%u cost=%u rssi=%d",
+                 route.next_hop_id, route.hop_count, route.path_cost,
+                 route.rssi);
     }
 
-    s_recent_sequences[s_recent_index].source_id = source_id;
-    s_recent_sequences[s_recent_index].sequence = sequence;
-    s_recent_index = (s_recent_index + 1U) % MAX_RECENT_SEQUENCES;
-    return false;
+#if CONFIG_APP_ROLE_ROUTER
+    if (memcmp(route.next_hop_mac, item->source_mac,
+               sizeof(route.next_hop_mac)) == 0) {
+        // Re-advertise our own route; TDMA fields pass through unchanged.
+        mesh_beacon_info_t relayed = info;
+        relayed.hop_count = route.hop_count;
+        relayed.path_cost = route.path_cost;
+        relayed.parent_id = route.next_hop_id;
+        ESP_ERROR_CHECK_WITHOUT_ABORT(send_beacon(&relayed));
+    }
+#endif
 }
+#endif
 
 /**
  * @brief Logs a received sensor packet at the root gateway.
@@ -336,16 +470,100 @@ static void log_sensor_packet(const mesh_packet_t *packet,
 }
 
 /**
- * @brief Processes one received packet according to the configured node role.
+ * @brief Logs a received sensor packet and queues its reading for the uplink.
+ *
+ * Args:
+ *     item: Pool frame holding a validated MESH_PACKET_SENSOR packet.
+ */
+static void deliver_sensor_packet(const mesh_rx_frame_t *item)
+{
+    const mesh_packet_t *packet = &item->packet;
+    log_sensor_packet(packet, item->source_mac);
+
+#if CONFIG_APP_UPLINK
+    const mesh_sample_t sample = {
+        .time_s = (uint32_t)(esp_timer_get_time() / 1000000LL),
+        .temperature_centi_c = packet->temperature_centi_c,
+        .humidity_centi_pct = packet->humidity_centi_pct,
+        .battery_mv = packet->battery_mv,
+    };
+    if (mesh_uplink_submit(packet->source_id, packet->sequence,
+                           &sample, 1U) != ESP_OK) {
+        ESP_LOGW(TAG, "Uplink queue full; reading src=%u seq=%u lost",
+                 packet->source_id, packet->sequence);
+    }
+#endif
+}
+
+/**
+ * @brief Logs every reading of a received sensor batch and queues them for
+ * the uplink.
  *
  * Args:
- *     item: Queue item containing the source MAC and validated packet.
+ *     item: Pool frame holding a validated MESH_PACKET_SENSOR_BATCH frame.
  */
-static void process_received_packet(const rx_item_t *item)
+static void deliver_sensor_batch(const mesh_rx_frame_t *item)
 {
     const mesh_packet_t *packet = &item->packet;
+    const uint32_t now_s = (uint32_t)(esp_timer_get_time() / 1000000LL);
+    mesh_sample_t samples[MESH_BATCH_MAX_SAMPLES];
+    size_t count = 0U;
+
+    if (mesh_batch_decode(item->frame, item->length, now_s, samples,
+                          MESH_BATCH_MAX_SAMPLES, &count) != ESP_OK) {
+        ESP_LOGW(TAG, "Malformed batch src=%u seq=%u dropped",
+                 packet->source_id, packet->sequence);
+        return;
+    }
+
+    ESP_LOGI(TAG,
+             "Batch src=%u seq=%u samples=%u bytes=%u ttl=%u "
+             "via=%02X:%02X:%02X:%02X:%02X:%02X",
+             packet->source_id, packet->sequence, (unsigned)count,
+             item->length, packet->ttl,
+             item->source_mac[0], item->source_mac[1], item->source_mac[2],
+             item->source_mac[3], item->source_mac[4], item->source_mac[5]);
+
+    for (size_t i = 0; i < count; ++i) {
+        ESP_LOGI(TAG,
+                 "  [%u] age=%lu s temp=%.2f C humidity=%.2f %% battery=%u mV",
+                 (unsigned)i,
+                 (unsigned long)(now_s - samples[i].time_s),
+                 samples[i].temperature_centi_c / 100.0,
+                 samples[i].humidity_centi_pct / 100.0,
+                 samples[i].battery_mv);
+    }
+
+#if CONFIG_APP_UPLINK
+    if (mesh_uplink_submit(packet->source_id, packet->sequence,
+                           samples, count) != ESP_OK) {
+        ESP_LOGW(TAG, "Uplink queue full; batch src=%u seq=%u truncated",
+                 packet->source_id, packet->sequence);
+    }
+#endif
+}
+
+/**
+ * @brief Processes one received packet according to the configured node role.
+ *
+ * Routers modify the frame in place before forwarding it.
+ *
+ * Args:
+ *     item: Pool frame containing the source MAC and validated packet.
+ */
+static void process_received_packet(mesh_rx_frame_t *item)
+{
+    mesh_packet_t *packet = &item->packet;
 
     if (packet->type == MESH_PACKET_BEACON) {
+#if CONFIG_APP_DYNAMIC_ROUTING && !CONFIG_APP_ROLE_ROOT
+        handle_beacon(item);
+#endif
+#if CONFIG_APP_TDMA && CONFIG_APP_ROLE_LEAF
+        mesh_beacon_info_t info;
+        memcpy(&info, item->frame + sizeof(mesh_packet_t), sizeof(info));
+        mesh_tdma_on_beacon(&info, rtc_clock_us());
+#endif
         xEventGroupSetBits(s_events, RX_EVENT_BEACON);
         return;
     }
@@ -356,21 +574,58 @@ static void process_received_packet(const rx_item_t *item)
         return;
     }
 
-    if (packet->type != MESH_PACKET_SENSOR) {
+#if CONFIG_APP_MESH_OTA
+    // Update traffic is never acknowledged, deduplicated, or forwarded as is.
+    if ((packet->type == MESH_PACKET_OTA_ANNOUNCE) ||
+        (packet->type == MESH_PACKET_OTA_CHUNK) ||
+        (packet->type == MESH_PACKET_OTA_REQUEST)) {
+        mesh_ota_handle_frame(item);
+        return;
+    }
+#endif
+
+    if ((packet->type != MESH_PACKET_SENSOR) &&
+        (packet->type != MESH_PACKET_SENSOR_BATCH)) {
         return;
     }
 
+#if CONFIG_APP_ROLE_ROOT && CONFIG_APP_PAYLOAD_ENCRYPTION
+    // Unsealed or forged readings are neither acknowledged nor delivered.
+    size_t opened_length = item->length;
+    const esp_err_t open_err = mesh_crypto_open(item->frame, &opened_length);
+    if (open_err != ESP_OK) {
+        ESP_LOGW(TAG, "Rejected sealed packet src=%u seq=%u: %s",
+                 packet->source_id, packet->sequence, esp_err_to_name(open_err));
+        return;
+    }
+    item->length = (uint8_t)opened_length;
+#endif
+
+#if CONFIG_APP_ROLE_ROOT && CONFIG_APP_UPLINK
+    // Withhold the ACK while the uplink is backed up; the sender keeps its
+    // readings and retries on a later cycle.
+    if (!mesh_uplink_has_room(MESH_BATCH_MAX_SAMPLES)) {
+        ESP_LOGW(TAG, "Uplink backlog; deferring src=%u seq=%u",
+                 packet->source_id, packet->sequence);
+        return;
+    }
+#endif
+
     // ACK the immediate sender even when the payload is a duplicate.
     ESP_ERROR_CHECK_WITHOUT_ABORT(send_ack(item->source_mac, packet->sequence));
 
-    if (is_duplicate_packet(packet->source_id, packet->sequence)) {
+    if (mesh_dedup_check_and_record(packet->source_id, packet->sequence)) {
         ESP_LOGD(TAG, "Duplicate packet src=%u seq=%u ignored",
                  packet->source_id, packet->sequence);
         return;
     }
 
 #if CONFIG_APP_ROLE_ROOT
-    log_sensor_packet(packet, item->source_mac);
+    if (packet->type == MESH_PACKET_SENSOR_BATCH) {
+        deliver_sensor_batch(item);
+    } else {
+        deliver_sensor_packet(item);
+    }
 #elif CONFIG_APP_ROLE_ROUTER
     if (packet->ttl <= 1U) {
         ESP_LOGW(TAG, "Dropping packet src=%u seq=%u because TTL expired",
@@ -378,11 +633,12 @@ static void process_received_packet(const rx_item_t *item)
         return;
     }
 
-    mesh_packet_t forwarded = *packet;
-    forwarded.ttl--;
-    ESP_ERROR_CHECK_WITHOUT_ABORT(send_packet(s_parent_mac, &forwarded));
-    ESP_LOGI(TAG, "Forwarded src=%u seq=%u ttl=%u",
-             forwarded.source_id, forwarded.sequence, forwarded.ttl);
+    // Batches are forwarded verbatim; only the header TTL and CRC change.
+    packet->ttl--;
+    ESP_ERROR_CHECK_WITHOUT_ABORT(
+        send_frame(upstream_mac(), item->frame, item->length));
+    ESP_LOGI(TAG, "Forwarded src=%u seq=%u ttl=%u bytes=%u",
+             packet->source_id, packet->sequence, packet->ttl, item->length);
 #else
     // Leaf nodes normally transmit only, but still accept ACKs and beacons.
     ESP_LOGD(TAG, "Leaf ignored sensor packet from node %u",
@@ -391,13 +647,37 @@ static void process_received_packet(const rx_item_t *item)
 }
 
 /**
- * @brief Drains the receive queue and processes all pending packets.
+ * @brief Drains the receive pool and processes all pending packets in place.
  */
 static void drain_receive_queue(void)
 {
-    rx_item_t item;
-    while (xQueueReceive(s_rx_queue, &item, 0) == pdTRUE) {
-        process_received_packet(&item);
+    mesh_rx_frame_t *item;
+    while ((item = mesh_rx_take(0)) != NULL) {
+        process_received_packet(item);
+        mesh_rx_release(item);
+    }
+}
+
+/**
+ * @brief Logs the receive counters when frames were dropped since the last call.
+ *
+ * Args:
+ *     last_dropped: Drop total at the previous call; updated in place.
+ */
+static void log_receive_drops(uint32_t *last_dropped)
+{
+    mesh_rx_stats_t stats;
+    mesh_rx_get_stats(&stats);
+
+    const uint32_t dropped = stats.dropped_invalid + stats.dropped_pool_empty;
+    if (dropped != *last_dropped) {
+        ESP_LOGW(TAG, "RX received=%lu invalid=%lu pool_full=%lu peak=%lu/%d",
+                 (unsigned long)stats.received,
+                 (unsigned long)stats.dropped_invalid,
+                 (unsigned long)stats.dropped_pool_empty,
+                 (unsigned long)stats.in_use_high_water,
+                 CONFIG_APP_RX_POOL_SIZE);
+        *last_dropped = dropped;
     }
 }
 
@@ -405,20 +685,67 @@ static void drain_receive_queue(void)
  * @brief Builds deterministic demo sensor values without external hardware.
  *
  * Args:
- *     packet: Packet whose sensor fields will be populated.
+ *     sample: Sample whose sensor fields will be populated.
  */
-static void populate_demo_sensor_data(mesh_packet_t *packet)
+static void populate_demo_sensor_data(mesh_sample_t *sample)
 {
-    const uint32_t sample = s_boot_count % 50U;
+    const uint32_t step = s_boot_count % 50U;
 
     // Replace these values with real I2C, SPI, ADC, or 1-Wire readings.
-    packet->temperature_centi_c = (int16_t)(2200 + (int32_t)sample * 3);
-    packet->humidity_centi_pct = (uint16_t)(4800 + sample * 5U);
-    packet->battery_mv = (uint16_t)(4200U - (s_boot_count % 900U));
+    sample->temperature_centi_c = (int16_t)(2200 + (int32_t)step * 3);
+    sample->humidity_centi_pct = (uint16_t)(4800 + step * 5U);
+    sample->battery_mv = (uint16_t)(4200U - (s_boot_count % 900U));
+}
+
+/**
+ * @brief Takes one reading and appends it to the RTC sample buffer.
+ *
+ * When the buffer is full, for example after several unacknowledged
+ * bursts, the oldest reading is discarded.
+ *
+ * Returns:
+ *     True when enough readings are buffered to transmit this cycle.
+ */
+static bool leaf_record_sample(void)
+{
+    if (s_pending_count >= MESH_BATCH_MAX_SAMPLES) {
+        memmove(&s_pending_samples[0], &s_pending_samples[1],
+                (MESH_BATCH_MAX_SAMPLES - 1U) * sizeof(s_pending_samples[0]));
+        s_pending_count = MESH_BATCH_MAX_SAMPLES - 1U;
+    }
+
+    mesh_sample_t *sample = &s_pending_samples[s_pending_count++];
+    sample->time_s = rtc_clock_s();
+    populate_demo_sensor_data(sample);
+
+    return s_pending_count >= CONFIG_APP_BATCH_SAMPLES;
 }
 
 /**
- * @brief Sends one sensor packet and waits for an application ACK.
+ * @brief Removes acknowledged readings from the front of the RTC buffer.
+ *
+ * Args:
+ *     count: Number of readings delivered.
+ */
+static void leaf_consume_samples(size_t count)
+{
+    if (count >= s_pending_count) {
+        s_pending_count = 0U;
+        return;
+    }
+
+    memmove(&s_pending_samples[0], &s_pending_samples[count],
+            (s_pending_count - count) * sizeof(s_pending_samples[0]));
+    s_pending_count -= count;
+}
+
+/**
+ * @brief Sends buffered readings in one frame and waits for an application ACK.
+ *
+ * A single buffered reading goes out as a classic MESH_PACKET_SENSOR so
+ * batching stays wire-compatible with APP_BATCH_SAMPLES=1. Otherwise as
+ * many readings as fit are delta-encoded into one MESH_PACKET_SENSOR_BATCH
+ * frame and removed from the buffer once acknowledged.
  *
  * Returns:
  *     ESP_OK when acknowledged; ESP_ERR_TIMEOUT when all retries fail.
@@ -435,15 +762,46 @@ static esp_err_t transmit_sensor_packet_with_retry(void)
         .flags = 0U,
         .uptime_ms = (uint32_t)(esp_timer_get_time() / 1000ULL),
     };
-    populate_demo_sensor_data(&packet);
+
+    uint8_t frame[MESH_MAX_PACKET_SIZE];
+    size_t frame_length = sizeof(packet);
+    size_t sample_count = 1U;
+#if CONFIG_APP_PAYLOAD_ENCRYPTION
+    const size_t batch_capacity = sizeof(frame) - sizeof(mesh_seal_trailer_t);
+#else
+    const size_t batch_capacity = sizeof(frame);
+#endif
+
+    if (s_pending_count == 1U) {
+        packet.temperature_centi_c = s_pending_samples[0].temperature_centi_c;
+        packet.humidity_centi_pct = s_pending_samples[0].humidity_centi_pct;
+        packet.battery_mv = s_pending_samples[0].battery_mv;
+        memcpy(frame, &packet, sizeof(packet));
+    } else {
+        frame_length = mesh_batch_encode(&packet, s_pending_samples,
+                                         s_pending_count, rtc_clock_s(),
+                                         frame, batch_capacity, &sample_count);
+        if (frame_length == 0U) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+    }
+
+#if CONFIG_APP_PAYLOAD_ENCRYPTION
+    // Sealed once; retries resend the same ciphertext and nonce.
+    ESP_RETURN_ON_ERROR(mesh_crypto_seal(frame, &frame_length, sizeof(frame)),
+                        TAG, "sensor packet seal failed");
+#endif
+
+    const uint8_t *destination_mac = upstream_mac();
 
     for (uint32_t attempt = 0U; attempt <= CONFIG_APP_MAX_RETRIES; ++attempt) {
         xEventGroupClearBits(s_events, RX_EVENT_ACK);
         s_last_acked_sequence = 0U;
 
-        ESP_LOGI(TAG, "Sending sensor packet seq=%u attempt=%lu",
-                 packet.sequence, (unsigned long)(attempt + 1U));
-        ESP_RETURN_ON_ERROR(send_packet(s_parent_mac, &packet), TAG,
+        ESP_LOGI(TAG, "Sending sensor packet seq=%u samples=%u bytes=%u attempt=%lu",
+                 packet.sequence, (unsigned)sample_count,
+                 (unsigned)frame_length, (unsigned long)(attempt + 1U));
+        ESP_RETURN_ON_ERROR(send_frame(destination_mac, frame, frame_length), TAG,
                             "sensor packet send failed");
 
         const TickType_t timeout_ticks = pdMS_TO_TICKS(CONFIG_APP_ACK_TIMEOUT_MS);
@@ -464,6 +822,7 @@ static esp_err_t transmit_sensor_packet_with_retry(void)
             if (((bits & RX_EVENT_ACK) != 0U) &&
                 (s_last_acked_sequence == packet.sequence)) {
                 ESP_LOGI(TAG, "Packet seq=%u acknowledged", packet.sequence);
+                leaf_consume_samples(sample_count);
                 return ESP_OK;
             }
         }
@@ -484,21 +843,35 @@ static esp_err_t transmit_sensor_packet_with_retry(void)
 static void root_beacon_task(void *context)
 {
     (void)context;
-    uint16_t beacon_sequence = 0U;
 
     while (true) {
-        mesh_packet_t beacon = {
-            .version = MESH_PROTOCOL_VERSION,
-            .type = MESH_PACKET_BEACON,
-            .source_id = CONFIG_APP_NODE_ID,
-            .destination_id = MESH_BROADCAST_NODE_ID,
-            .sequence = ++beacon_sequence,
-            .ttl = 1U,
-            .uptime_ms = (uint32_t)(esp_timer_get_time() / 1000ULL),
+#if CONFIG_APP_TDMA
+        // Send on slot boundaries so every beacon opens one leaf slot; the
+        // extra tick keeps the wake-up past the boundary.
+        const uint64_t wait_ms = mesh_tdma_ms_until_next_slot(
+            (uint64_t)(esp_timer_get_time() / 1000LL));
+        vTaskDelay(pdMS_TO_TICKS(wait_ms) + 1U);
+#endif
+
+        // The root is the routing destination: zero hops, zero cost.
+        mesh_beacon_info_t info = {
+            .hop_count = 0U,
+            .path_cost = 0U,
+            .parent_id = MESH_BROADCAST_NODE_ID,
         };
+#if CONFIG_APP_TDMA
+        mesh_tdma_fill_root_beacon(&info,
+                                   (uint64_t)(esp_timer_get_time() / 1000LL));
+#endif
+        ESP_ERROR_CHECK_WITHOUT_ABORT(send_beacon(&info));
+#if CONFIG_APP_MESH_OTA
+        // Leaves listen right after the beacon, so the announcement goes next.
+        mesh_ota_announce();
+#endif
 
-        ESP_ERROR_CHECK_WITHOUT_ABORT(send_packet(BROADCAST_MAC, &beacon));
+#if !CONFIG_APP_TDMA
         vTaskDelay(pdMS_TO_TICKS(CONFIG_APP_BEACON_INTERVAL_MS));
+#endif
     }
 }
 
@@ -511,6 +884,7 @@ static void root_beacon_task(void *context)
 static void receiver_task(void *context)
 {
     (void)context;
+    uint32_t last_dropped = 0U;
 
     while (true) {
         EventBits_t bits = xEventGroupWaitBits(
@@ -518,14 +892,94 @@ static void receiver_task(void *context)
             RX_EVENT_PACKET,
             pdTRUE,
             pdFALSE,
-            portMAX_DELAY);
+            pdMS_TO_TICKS(RX_STATS_INTERVAL_MS));
 
         if ((bits & RX_EVENT_PACKET) != 0U) {
             drain_receive_queue();
         }
+        log_receive_drops(&last_dropped);
     }
 }
 
+/**
+ * @brief Puts a leaf into deep sleep until its next wake-up.
+ *
+ * A leaf that follows a TDMA schedule wakes just before its slot; otherwise
+ * it sleeps for the fixed APP_WAKE_INTERVAL_SEC.
+ */
+static void leaf_enter_deep_sleep(void)
+{
+#if CONFIG_APP_TDMA
+    const uint64_t sleep_us = mesh_tdma_sleep_us(CONFIG_APP_NODE_ID,
+                                                 rtc_clock_us());
+    if (sleep_us > 0U) {
+        ESP_LOGI(TAG, "Next wake before slot %u",
+                 mesh_tdma_slot_for(CONFIG_APP_NODE_ID));
+        ESP_ERROR_CHECK(power_manager_enter_deep_sleep_us(sleep_us));
+    }
+#endif
+    ESP_ERROR_CHECK(power_manager_enter_deep_sleep(
+        CONFIG_APP_WAKE_INTERVAL_SEC));
+}
+
+#if CONFIG_APP_MESH_OTA
+/**
+ * @brief Stays awake to collect image chunks while an update is incomplete.
+ *
+ * Asks the parent for the missing chunks, then listens for up to
+ * APP_MESH_OTA_LEAF_LISTEN_MS and asks again whenever chunks stop arriving
+ * for APP_MESH_OTA_REQUEST_INTERVAL_MS. Progress lives in RTC memory and
+ * flash, so the next wake continues where this one stopped. A complete
+ * image is verified and installed, which restarts the leaf.
+ */
+static void leaf_receive_update(void)
+{
+    if (!mesh_ota_in_progress()) {
+        return;
+    }
+
+    ESP_ERROR_CHECK_WITHOUT_ABORT(mesh_ota_request_missing());
+
+    const TickType_t start = xTaskGetTickCount();
+    const TickType_t listen_ticks = pdMS_TO_TICKS(CONFIG_APP_MESH_OTA_LEAF_LISTEN_MS);
+    const TickType_t retry_ticks = pdMS_TO_TICKS(CONFIG_APP_MESH_OTA_REQUEST_INTERVAL_MS);
+    const uint16_t first = mesh_ota_received_chunks();
+    uint16_t received = first;
+    TickType_t last_progress = start;
+
+    while (mesh_ota_in_progress() &&
+           ((xTaskGetTickCount() - start) < listen_ticks)) {
+        EventBits_t bits = xEventGroupWaitBits(
+            s_events,
+            RX_EVENT_PACKET,
+            pdTRUE,
+            pdFALSE,
+            pdMS_TO_TICKS(20));
+
+        if ((bits & RX_EVENT_PACKET) != 0U) {
+            drain_receive_queue();
+        }
+
+        if (mesh_ota_received_chunks() != received) {
+            received = mesh_ota_received_chunks();
+            last_progress = xTaskGetTickCount();
+        } else if ((xTaskGetTickCount() - last_progress) >= retry_ticks) {
+            ESP_ERROR_CHECK_WITHOUT_ABORT(mesh_ota_request_missing());
+            last_progress = xTaskGetTickCount();
+        }
+    }
+
+    ESP_LOGI(TAG, "Update: %u chunks this wake, %u in total",
+             (unsigned)(uint16_t)(received - first), (unsigned)received);
+
+    // Only returns when no image is complete or it failed verification.
+    const esp_err_t err = mesh_ota_apply();
+    if ((err != ESP_OK) && (err != ESP_ERR_INVALID_STATE)) {
+        ESP_LOGW(TAG, "Update not installed: %s", esp_err_to_name(err));
+    }
+}
+#endif
+
 /**
  * @brief Runs the complete wake, synchronize, transmit, and sleep cycle.
  * 
@@ -533,11 +987,21 @@ static void receiver_task(void *context)
  */
 static void run_leaf_cycle(void)
 {
-    ESP_LOGI(TAG, "Waiting up to %d ms for a synchronization beacon",
-             CONFIG_APP_BEACON_WAIT_MS);
+    uint32_t wait_ms = CONFIG_APP_BEACON_WAIT_MS;
+    bool beacon_received = false;
+#if CONFIG_APP_TDMA
+    // On schedule, only listen until the beacon that opens our slot is due.
+    const bool scheduled = mesh_tdma_is_synced();
+    if (scheduled) {
+        wait_ms = mesh_tdma_listen_window_ms(CONFIG_APP_NODE_ID,
+                                             rtc_clock_us());
+    }
+#endif
+
+    ESP_LOGI(TAG, "Waiting up to %lu ms for a synchronization beacon",
+             (unsigned long)wait_ms);
 
-    const TickType_t wait_end = xTaskGetTickCount() +
-                                pdMS_TO_TICKS(CONFIG_APP_BEACON_WAIT_MS);
+    const TickType_t wait_end = xTaskGetTickCount() + pdMS_TO_TICKS(wait_ms);
     while (xTaskGetTickCount() < wait_end) {
         EventBits_t bits = xEventGroupWaitBits(
             s_events,
@@ -551,21 +1015,42 @@ static void run_leaf_cycle(void)
         }
         if ((bits & RX_EVENT_BEACON) != 0U) {
             ESP_LOGI(TAG, "Synchronization beacon received");
+            beacon_received = true;
             break;
         }
     }
 
-    esp_err_t err = transmit_sensor_packet_with_retry();
+#if CONFIG_APP_TDMA
+    if (scheduled && !beacon_received) {
+        // Still transmit in the predicted slot; resync on a later wake.
+        ESP_LOGW(TAG, "Slot beacon missed");
+        mesh_tdma_on_missed_beacon();
+    }
+#else
+    (void)beacon_received;
+#endif
+
+    // Flush the whole buffer; large deltas can spill into several frames.
+    esp_err_t err;
+    do {
+        err = transmit_sensor_packet_with_retry();
+    } while ((err == ESP_OK) && (s_pending_count > 0U));
+
     if (err != ESP_OK) {
-        ESP_LOGW(TAG, "Sensor packet was not acknowledged: %s",
-                 esp_err_to_name(err));
+        ESP_LOGW(TAG, "Sensor packet was not acknowledged: %s; "
+                 "%lu readings kept for the next cycle",
+                 esp_err_to_name(err), (unsigned long)s_pending_count);
     }
 
+#if CONFIG_APP_MESH_OTA
+    leaf_receive_update();
+#endif
+
     // Stop Wi-Fi before deep sleep to minimize shutdown current transients.
     ESP_ERROR_CHECK_WITHOUT_ABORT(esp_now_deinit());
     ESP_ERROR_CHECK_WITHOUT_ABORT(esp_wifi_stop());
-    ESP_ERROR_CHECK(power_manager_enter_deep_sleep(
-        CONFIG_APP_WAKE_INTERVAL_SEC));
+    energy_profiler_mark(ENERGY_PHASE_ACTIVE);
+    leaf_enter_deep_sleep();
 }
 
 /**
@@ -573,22 +1058,40 @@ static void run_leaf_cycle(void)
  */
 void app_main(void)
 {
+    // Charge the deep sleep that just ended and start timing the wake.
+    energy_profiler_init();
     ++s_boot_count;
 
+#if CONFIG_APP_ROLE_LEAF
+    // Buffer the reading and skip the radio entirely until a batch is due.
+    energy_profiler_mark(ENERGY_PHASE_SENSOR);
+    const bool batch_due = leaf_record_sample();
+    energy_profiler_mark(ENERGY_PHASE_ACTIVE);
+    if (!batch_due) {
+        ESP_LOGI(TAG, "Buffered reading %lu/%d; radio stays off",
+                 (unsigned long)s_pending_count, CONFIG_APP_BATCH_SAMPLES);
+        leaf_enter_deep_sleep();
+    }
+#endif
+
     // Initialize NVS, FreeRTOS queues, events, Wi-Fi, and ESP-NOW.
     ESP_ERROR_CHECK(initialize_nvs());
+#if CONFIG_APP_PAYLOAD_ENCRYPTION
+    ESP_ERROR_CHECK(mesh_crypto_init());
+#endif
     
-    // Create a queue for received packets and an event group for RX events.
-    s_rx_queue = xQueueCreate(RX_QUEUE_LENGTH, sizeof(rx_item_t));
+    // Create the receive frame pool and its index queues.
+    ESP_ERROR_CHECK(mesh_rx_init());
     
     // Create an event group to signal received packets, beacons, and ACKs.
     s_events = xEventGroupCreate();
-    if ((s_rx_queue == NULL) || (s_events == NULL)) {
+    if (s_events == NULL) {
         ESP_LOGE(TAG, "Failed to allocate FreeRTOS synchronization objects");
         abort();
     }
 
     // Initialize Wi-Fi in station mode on the configured ESP-NOW channel.
+    energy_profiler_mark(ENERGY_PHASE_RADIO);
     ESP_ERROR_CHECK(initialize_wifi());
     
     // Initialize ESP-NOW, register callbacks, and add required peers.
@@ -608,12 +1111,37 @@ void app_main(void)
              (unsigned long)s_boot_count,
              power_manager_wakeup_cause_string());
 
+#if CONFIG_APP_CRC16_BENCHMARK
+    mesh_crc16_benchmark();
+#endif
+
+#if CONFIG_APP_MESH_OTA
+    const esp_err_t ota_err = mesh_ota_init(&OTA_TRANSPORT);
+    if (ota_err != ESP_OK) {
+        ESP_LOGW(TAG, "Mesh firmware distribution unavailable: %s",
+                 esp_err_to_name(ota_err));
+    }
+#endif
+
     // Start the appropriate tasks or run the leaf cycle based on the node role.    
 #if CONFIG_APP_ROLE_ROOT
+#if CONFIG_APP_UPLINK
+    ESP_ERROR_CHECK(mesh_uplink_start());
+#endif
     xTaskCreate(root_beacon_task, "root_beacon", 4096, NULL, 5, NULL);
     xTaskCreate(receiver_task, "mesh_rx", 4096, NULL, 6, NULL);
+#if CONFIG_APP_MESH_OTA
+    if (ota_err == ESP_OK) {
+        ESP_ERROR_CHECK(mesh_ota_start());
+    }
+#endif
 #elif CONFIG_APP_ROLE_ROUTER
     xTaskCreate(receiver_task, "mesh_rx", 4096, NULL, 6, NULL);
+#if CONFIG_APP_MESH_OTA
+    if (ota_err == ESP_OK) {
+        ESP_ERROR_CHECK(mesh_ota_start());
+    }
+#endif
 #else
     run_leaf_cycle();
 #endif
@@ -0,0 +1,63 @@
+#ifndef MESH_CRC16_H
+#define MESH_CRC16_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "mesh_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Bit-serial CRC-16/CCITT-FALSE reference implementation.
+ *
+ * Args:
+ *     data: Pointer to the data buffer.
+ *     length: Number of bytes to process.
+ *
+ * Returns:
+ *     The calculated 16-bit CRC value.
+ */
+uint16_t mesh_crc16_ccitt_bitwise(const uint8_t *data, size_t length);
+
+/**
+ * @brief Slice-by-4 table-driven CRC-16/CCITT-FALSE (2 KB of tables).
+ *
+ * Args:
+ *     data: Pointer to the data buffer.
+ *     length: Number of bytes to process.
+ *
+ * Returns:
+ *     The calculated 16-bit CRC value.
+ */
+uint16_t mesh_crc16_ccitt_slice4(const uint8_t *data, size_t length);
+
+/**
+ * @brief CRC-16/CCITT-FALSE through the ROM esp_rom_crc16_be() routine.
+ *
+ * Args:
+ *     data: Pointer to the data buffer.
+ *     length: Number of bytes to process.
+ *
+ * Returns:
+ *     The calculated 16-bit CRC value.
+ */
+uint16_t mesh_crc16_ccitt_rom(const uint8_t *data, size_t length);
+
+/**
+ * @brief Benchmarks every CRC implementation and logs cycles per frame.
+ *
+ * Runs each implementation over a mesh_packet_t-sized frame and a
+ * MESH_MAX_PACKET_SIZE frame, checks the standard "123456789" check
+ * value, and flags any implementation that disagrees with the bit-serial
+ * reference.
+ */
+void mesh_crc16_benchmark(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,393 @@
+#include "mesh_crypto.h"
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_attr.h"
+#include "sdkconfig.h"
+
+#if CONFIG_APP_PAYLOAD_ENCRYPTION
+
+#include "mbedtls/ccm.h"
+#include "mbedtls/md.h"
+#include "nvs.h"
+
+#include "mesh_dedup.h"
+
+#define CRYPTO_KEY_SIZE 16U
+#define CRYPTO_NONCE_SIZE 13U
+#define CRYPTO_SESSION_CACHE CONFIG_APP_CRYPTO_SESSION_CACHE
+#define CRYPTO_NVS_NAMESPACE "mesh_crypto"
+#define CRYPTO_NVS_EPOCH_KEY "epoch"
+
+// Authenticated header bytes: everything before the TTL, plus the flags.
+#define CRYPTO_AAD_SIZE (offsetof(mesh_packet_t, ttl) + 1U)
+// Encrypted header bytes: the sensor fields between the flags and the CRC.
+#define CRYPTO_HEADER_PLAIN_OFFSET offsetof(mesh_packet_t, uptime_ms)
+#define CRYPTO_HEADER_PLAIN_SIZE \
+    (offsetof(mesh_packet_t, payload_crc) - CRYPTO_HEADER_PLAIN_OFFSET)
+
+_Static_assert(sizeof(mesh_seal_trailer_t) == MESH_SEAL_TRAILER_SIZE,
+               "trailer layout must match the validator");
+
+typedef struct {
+    bool in_use;
+    uint16_t source_id;
+    uint32_t epoch;
+    uint32_t highest_counter;
+    uint32_t last_used;
+    mbedtls_ccm_context ccm;
+} crypto_session_t;
+
+static uint8_t s_network_key[CRYPTO_KEY_SIZE];
+
+// Receive-side sessions, only touched by the task that drains the pool.
+static crypto_session_t s_sessions[CRYPTO_SESSION_CACHE];
+static mbedtls_ccm_context s_trial;
+static uint32_t s_clock;
+
+// Transmit session of this node, only touched by the sending task.
+static mbedtls_ccm_context s_tx;
+static uint32_t s_tx_key_epoch;
+
+// The epoch survives deep sleep here and is advanced in NVS on cold boot.
+RTC_DATA_ATTR static uint32_t s_epoch;
+RTC_DATA_ATTR static uint32_t s_counter;
+
+/**
+ * @brief Parses APP_NETWORK_KEY as 32 hexadecimal digits.
+ *
+ * Returns:
+ *     ESP_OK on success; ESP_ERR_INVALID_ARG for malformed text.
+ */
+static esp_err_t parse_network_key(void)
+{
+    const char *text = CONFIG_APP_NETWORK_KEY;
+    if (strlen(text) != (CRYPTO_KEY_SIZE * 2U)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t i = 0U; i < CRYPTO_KEY_SIZE; ++i) {
+        unsigned int value;
+        if (sscanf(&text[i * 2U], "%2x", &value) != 1) {
+            return ESP_ERR_INVALID_ARG;
+        }
+        s_network_key[i] = (uint8_t)value;
+    }
+    return ESP_OK;
+}
+
+/**
+ * @brief Advances the persistent session epoch by one.
+ *
+ * Returns:
+ *     ESP_OK on success or an NVS error code.
+ */
+static esp_err_t advance_epoch(void)
+{
+    nvs_handle_t handle;
+    esp_err_t err = nvs_open(CRYPTO_NVS_NAMESPACE, NVS_READWRITE, &handle);
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    uint32_t stored = 0U;
+    err = nvs_get_u32(handle, CRYPTO_NVS_EPOCH_KEY, &stored);
+    if ((err == ESP_OK) || (err == ESP_ERR_NVS_NOT_FOUND)) {
+        // Epoch 0 is reserved for "not loaded yet".
+        stored = (stored == UINT32_MAX) ? 1U : stored + 1U;
+        err = nvs_set_u32(handle, CRYPTO_NVS_EPOCH_KEY, stored);
+    }
+    if (err == ESP_OK) {
+        err = nvs_commit(handle);
+    }
+    nvs_close(handle);
+
+    if (err == ESP_OK) {
+        s_epoch = stored;
+        s_counter = 0U;
+    }
+    return err;
+}
+
+/**
+ * @brief Derives a session key and loads it into a CCM context.
+ *
+ * The key is HMAC-SHA256(network key, "mesh-session" | source | epoch)
+ * truncated to 128 bits.
+ *
+ * Args:
+ *     ccm: Context to load; re-initialized first.
+ *     source_id: Node that seals with this key.
+ *     epoch: Session epoch of that node.
+ *
+ * Returns:
+ *     ESP_OK on success; ESP_FAIL when mbedTLS rejects the key.
+ */
+static esp_err_t load_session_key(mbedtls_ccm_context *ccm,
+                                  uint16_t source_id,
+                                  uint32_t epoch)
+{
+    static const char LABEL[] = "mesh-session";
+    uint8_t input[sizeof(LABEL) - 1U + sizeof(source_id) + sizeof(epoch)];
+    uint8_t digest[32];
+
+    memcpy(input, LABEL, sizeof(LABEL) - 1U);
+    memcpy(&input[sizeof(LABEL) - 1U], &source_id, sizeof(source_id));
+    memcpy(&input[sizeof(LABEL) - 1U + sizeof(source_id)], &epoch, sizeof(epoch));
+
+    int ret = mbedtls_md_hmac(mbedtls_md_info_from_type(MBEDTLS_MD_SHA256),
+                              s_network_key, sizeof(s_network_key),
+                              input, sizeof(input), digest);
+
+    mbedtls_ccm_free(ccm);
+    mbedtls_ccm_init(ccm);
+    if (ret == 0) {
+        ret = mbedtls_ccm_setkey(ccm, MBEDTLS_CIPHER_ID_AES, digest,
+                                 CRYPTO_KEY_SIZE * 8U);
+    }
+    memset(digest, 0, sizeof(digest));
+    return (ret == 0) ? ESP_OK : ESP_FAIL;
+}
+
+/**
+ * @brief Builds the CCM nonce of a sealed frame.
+ *
+ * Args:
+ *     header: Frame header.
+ *     trailer: Frame trailer carrying epoch and counter.
+ *     nonce: Receives CRYPTO_NONCE_SIZE bytes.
+ */
+static void build_nonce(const mesh_packet_t *header,
+                        const mesh_seal_trailer_t *trailer,
+                        uint8_t nonce[CRYPTO_NONCE_SIZE])
+{
+    memset(nonce, 0, CRYPTO_NONCE_SIZE);
+    memcpy(&nonce[0], &header->source_id, sizeof(header->source_id));
+    memcpy(&nonce[2], &trailer->epoch, sizeof(trailer->epoch));
+    memcpy(&nonce[6], &trailer->counter, sizeof(trailer->counter));
+    nonce[10] = header->type;
+}
+
+/**
+ * @brief Copies the authenticated header bytes, skipping the TTL.
+ *
+ * Args:
+ *     frame: Frame starting with a mesh_packet_t header.
+ *     aad: Receives CRYPTO_AAD_SIZE bytes.
+ */
+static void build_aad(const uint8_t *frame, uint8_t aad[CRYPTO_AAD_SIZE])
+{
+    memcpy(aad, frame, offsetof(mesh_packet_t, ttl));
+    aad[CRYPTO_AAD_SIZE - 1U] = frame[offsetof(mesh_packet_t, flags)];
+}
+
+/**
+ * @brief Moves the encrypted regions of a frame into or out of one buffer.
+ *
+ * Args:
+ *     frame: Frame whose regions are gathered or scattered.
+ *     body_length: Frame length without the trailer.
+ *     buffer: Contiguous plaintext or ciphertext.
+ *     gather: True copies frame to buffer, false copies buffer to frame.
+ *
+ * Returns:
+ *     Number of bytes in the contiguous buffer.
+ */
+static size_t move_regions(uint8_t *frame, size_t body_length,
+                           uint8_t *buffer, bool gather)
+{
+    const size_t body = body_length - sizeof(mesh_packet_t);
+    uint8_t *header_region = &frame[CRYPTO_HEADER_PLAIN_OFFSET];
+    uint8_t *body_region = &frame[sizeof(mesh_packet_t)];
+
+    if (gather) {
+        memcpy(buffer, header_region, CRYPTO_HEADER_PLAIN_SIZE);
+        memcpy(&buffer[CRYPTO_HEADER_PLAIN_SIZE], body_region, body);
+    } else {
+        memcpy(header_region, buffer, CRYPTO_HEADER_PLAIN_SIZE);
+        memcpy(body_region, &buffer[CRYPTO_HEADER_PLAIN_SIZE], body);
+    }
+    return CRYPTO_HEADER_PLAIN_SIZE + body;
+}
+
+/**
+ * @brief Finds the cached session of a source, or the slot to replace.
+ *
+ * Args:
+ *     source_id: Sealing node.
+ *     found: Set to true when the returned entry belongs to the source.
+ *
+ * Returns:
+ *     The source's entry, a free entry, or the least recently used one.
+ */
+static crypto_session_t *session_lookup(uint16_t source_id, bool *found)
+{
+    crypto_session_t *victim = &s_sessions[0];
+
+    for (size_t i = 0U; i < CRYPTO_SESSION_CACHE; ++i) {
+        crypto_session_t *session = &s_sessions[i];
+        if (session->in_use && (session->source_id == source_id)) {
+            *found = true;
+            return session;
+        }
+        if (victim->in_use &&
+            (!session->in_use || (session->last_used < victim->last_used))) {
+            victim = session;
+        }
+    }
+
+    *found = false;
+    return victim;
+}
+
+esp_err_t mesh_crypto_init(void)
+{
+    esp_err_t err = parse_network_key();
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    mbedtls_ccm_init(&s_tx);
+    mbedtls_ccm_init(&s_trial);
+    for (size_t i = 0U; i < CRYPTO_SESSION_CACHE; ++i) {
+        mbedtls_ccm_init(&s_sessions[i].ccm);
+    }
+
+    if (s_epoch == 0U) {
+        err = advance_epoch();
+    }
+    return err;
+}
+
+esp_err_t mesh_crypto_seal(uint8_t *frame, size_t *length, size_t capacity)
+{
+    if ((frame == NULL) || (length == NULL) ||
+        (*length < sizeof(mesh_packet_t)) ||
+        (*length + sizeof(mesh_seal_trailer_t) > capacity) ||
+        (*length + sizeof(mesh_seal_trailer_t) > MESH_MAX_PACKET_SIZE)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    // A wrapped counter would repeat nonces; start a new epoch instead.
+    if (s_counter == UINT32_MAX) {
+        const esp_err_t err = advance_epoch();
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    if (s_tx_key_epoch != s_epoch) {
+        const esp_err_t err = load_session_key(&s_tx, CONFIG_APP_NODE_ID, s_epoch);
+        if (err != ESP_OK) {
+            return err;
+        }
+        s_tx_key_epoch = s_epoch;
+    }
+
+    frame[offsetof(mesh_packet_t, flags)] |= MESH_PACKET_FLAG_SEALED;
+
+    mesh_packet_t header;
+    memcpy(&header, frame, sizeof(header));
+    mesh_seal_trailer_t trailer = {
+        .epoch = s_epoch,
+        .counter = ++s_counter,
+    };
+
+    uint8_t nonce[CRYPTO_NONCE_SIZE];
+    uint8_t aad[CRYPTO_AAD_SIZE];
+    uint8_t buffer[MESH_MAX_PACKET_SIZE];
+    build_nonce(&header, &trailer, nonce);
+    build_aad(frame, aad);
+    const size_t plain = move_regions(frame, *length, buffer, true);
+
+    if (mbedtls_ccm_encrypt_and_tag(&s_tx, plain, nonce, sizeof(nonce),
+                                    aad, sizeof(aad), buffer, buffer,
+                                    trailer.tag, sizeof(trailer.tag)) != 0) {
+        return ESP_FAIL;
+    }
+
+    move_regions(frame, *length, buffer, false);
+    memcpy(&frame[*length], &trailer, sizeof(trailer));
+    *length += sizeof(trailer);
+    return ESP_OK;
+}
+
+esp_err_t mesh_crypto_open(uint8_t *frame, size_t *length)
+{
+    if ((frame == NULL) || (length == NULL) ||
+        (*length < sizeof(mesh_packet_t) + sizeof(mesh_seal_trailer_t)) ||
+        (*length > MESH_MAX_PACKET_SIZE)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    mesh_packet_t header;
+    memcpy(&header, frame, sizeof(header));
+    if ((header.flags & MESH_PACKET_FLAG_SEALED) == 0U) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const size_t body_length = *length - sizeof(mesh_seal_trailer_t);
+    mesh_seal_trailer_t trailer;
+    memcpy(&trailer, &frame[body_length], sizeof(trailer));
+
+    bool found = false;
+    crypto_session_t *session = session_lookup(header.source_id, &found);
+
+    // Older epochs and counters far below the newest belong to replays.
+    // Counters inside the duplicate window are left to the duplicate
+    // filter, so retransmissions are still acknowledged.
+    if (found &&
+        ((trailer.epoch < session->epoch) ||
+         ((trailer.epoch == session->epoch) &&
+          (trailer.counter < session->highest_counter) &&
+          ((session->highest_counter - trailer.counter) >= MESH_DEDUP_WINDOW_BITS)))) {
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    // A new epoch is tried on a scratch context so forged frames cannot
+    // evict a working session.
+    const bool new_key = !found || (trailer.epoch != session->epoch);
+    mbedtls_ccm_context *ccm = &session->ccm;
+    if (new_key) {
+        if (load_session_key(&s_trial, header.source_id, trailer.epoch) != ESP_OK) {
+            return ESP_FAIL;
+        }
+        ccm = &s_trial;
+    }
+
+    uint8_t nonce[CRYPTO_NONCE_SIZE];
+    uint8_t aad[CRYPTO_AAD_SIZE];
+    uint8_t buffer[MESH_MAX_PACKET_SIZE];
+    build_nonce(&header, &trailer, nonce);
+    build_aad(frame, aad);
+    const size_t sealed = move_regions(frame, body_length, buffer, true);
+
+    if (mbedtls_ccm_auth_decrypt(ccm, sealed, nonce, sizeof(nonce),
+                                 aad, sizeof(aad), buffer, buffer,
+                                 trailer.tag, sizeof(trailer.tag)) != 0) {
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    if (new_key) {
+        // Hand the verified key schedule to the cache slot.
+        mbedtls_ccm_free(&session->ccm);
+        session->ccm = s_trial;
+        mbedtls_ccm_init(&s_trial);
+        session->in_use = true;
+        session->source_id = header.source_id;
+        session->epoch = trailer.epoch;
+        session->highest_counter = 0U;
+    }
+    if (trailer.counter > session->highest_counter) {
+        session->highest_counter = trailer.counter;
+    }
+    session->last_used = ++s_clock;
+
+    move_regions(frame, body_length, buffer, false);
+    frame[offsetof(mesh_packet_t, flags)] &= (uint8_t)~MESH_PACKET_FLAG_SEALED;
+    *length = body_length;
+    return ESP_OK;
+}
+
+#endif
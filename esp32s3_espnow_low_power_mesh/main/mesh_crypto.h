@@ -0,0 +1,82 @@
+#ifndef MESH_CRYPTO_H
+#define MESH_CRYPTO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "mesh_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define MESH_CRYPTO_TAG_SIZE 8U
+
+/*
+ * Trailer appended to sealed sensor frames. The nonce is built from the
+ * source ID, session epoch, and frame counter, so it never repeats for a
+ * session key.
+ */
+typedef struct __attribute__((packed)) {
+    uint32_t epoch;
+    uint32_t counter;
+    uint8_t tag[MESH_CRYPTO_TAG_SIZE];
+} mesh_seal_trailer_t;
+
+/**
+ * @brief Loads the network key and this node's session epoch.
+ *
+ * The epoch is kept in RTC memory across deep sleep and advanced in NVS on
+ * every cold boot, so a node never reuses a nonce after losing power.
+ * NVS must be initialized first.
+ *
+ * Returns:
+ *     ESP_OK on success; ESP_ERR_INVALID_ARG for a malformed
+ *     APP_NETWORK_KEY; otherwise an NVS error code.
+ */
+esp_err_t mesh_crypto_init(void);
+
+/**
+ * @brief Encrypts and authenticates a sensor frame in place.
+ *
+ * Routing fields stay readable so routers can forward without keys: the
+ * version, type, addresses, sequence, and flags are authenticated, the
+ * sensor fields and batch body are encrypted, and the TTL and CRC are left
+ * out. Sets MESH_PACKET_FLAG_SEALED and appends a mesh_seal_trailer_t.
+ *
+ * Args:
+ *     frame: Frame to seal; must have room for the trailer.
+ *     length: Frame length; updated to include the trailer.
+ *     capacity: Size of the frame buffer.
+ *
+ * Returns:
+ *     ESP_OK on success; ESP_ERR_INVALID_SIZE when the trailer does not
+ *     fit; otherwise an error from key setup or encryption.
+ */
+esp_err_t mesh_crypto_seal(uint8_t *frame, size_t *length, size_t capacity);
+
+/**
+ * @brief Verifies and decrypts a sealed sensor frame in place.
+ *
+ * The per-source session key is derived on first use and then served
+ * from an LRU cache, so the hot receive path costs one AES-CCM pass.
+ * On success the trailer is removed and the sealed flag cleared; the CRC
+ * is not recomputed.
+ *
+ * Args:
+ *     frame: Received sealed frame.
+ *     length: Frame length; updated to exclude the trailer.
+ *
+ * Returns:
+ *     ESP_OK on success; ESP_ERR_INVALID_STATE for an unsealed frame;
+ *     ESP_ERR_INVALID_VERSION for a stale epoch or counter;
+ *     ESP_ERR_INVALID_CRC when authentication fails.
+ */
+esp_err_t mesh_crypto_open(uint8_t *frame, size_t *length);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
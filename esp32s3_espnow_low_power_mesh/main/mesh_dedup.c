@@ -0,0 +1,122 @@
+#include "mesh_dedup.h"
+
+#include <string.h>
+
+#include "sdkconfig.h"
+
+#define DEDUP_TABLE_SIZE ((uint32_t)CONFIG_APP_DEDUP_TABLE_SIZE)
+#define DEDUP_TABLE_MASK (DEDUP_TABLE_SIZE - 1U)
+
+_Static_assert((DEDUP_TABLE_SIZE & DEDUP_TABLE_MASK) == 0U,
+               "APP_DEDUP_TABLE_SIZE must be a power of two");
+
+typedef struct {
+    bool in_use;
+    uint16_t source_id;
+    uint16_t highest;     // Newest sequence seen from this source.
+    uint32_t window;      // Bit n set: sequence (highest - n) was seen.
+    uint32_t last_heard;  // Table clock at the last packet, for eviction.
+} dedup_entry_t;
+
+// Only touched from the task that drains the receive queue.
+static dedup_entry_t s_table[DEDUP_TABLE_SIZE];
+static uint32_t s_clock;
+
+/**
+ * @brief Maps a source ID onto its home slot with a multiplicative hash.
+ *
+ * Args:
+ *     source_id: Logical source node identifier.
+ *
+ * Returns:
+ *     Home slot index.
+ */
+static uint32_t dedup_home_slot(uint16_t source_id)
+{
+    // Fibonacci hashing spreads consecutive node IDs across the table.
+    return (((uint32_t)source_id * 2654435761U) >> 16) & DEDUP_TABLE_MASK;
+}
+
+/**
+ * @brief Finds the slot of a source, claiming a free or stale one if absent.
+ *
+ * Args:
+ *     source_id: Logical source node identifier.
+ *
+ * Returns:
+ *     Matching slot, or a slot the caller must initialize.
+ */
+static dedup_entry_t *dedup_lookup(uint16_t source_id)
+{
+    const uint32_t home = dedup_home_slot(source_id);
+    dedup_entry_t *victim = NULL;
+
+    for (uint32_t probe = 0U; probe < DEDUP_TABLE_SIZE; ++probe) {
+        dedup_entry_t *entry = &s_table[(home + probe) & DEDUP_TABLE_MASK];
+
+        if (!entry->in_use) {
+            // Entries are never deleted, so a free slot ends the cluster.
+            return entry;
+        }
+        if (entry->source_id == source_id) {
+            return entry;
+        }
+        if ((victim == NULL) ||
+            ((s_clock - entry->last_heard) > (s_clock - victim->last_heard))) {
+            victim = entry;
+        }
+    }
+
+    // Table full: reuse the least recently heard slot in place, which
+    // keeps every other probe chain intact.
+    victim->in_use = false;
+    return victim;
+}
+
+void mesh_dedup_reset(void)
+{
+    memset(s_table, 0, sizeof(s_table));
+    s_clock = 0U;
+}
+
+bool mesh_dedup_check_and_record(uint16_t source_id, uint16_t sequence)
+{
+    dedup_entry_t *entry = dedup_lookup(source_id);
+    entry->last_heard = ++s_clock;
+
+    if (!entry->in_use || (entry->source_id != source_id)) {
+        entry->in_use = true;
+        entry->source_id = source_id;
+        entry->highest = sequence;
+        entry->window = 1U;
+        return false;
+    }
+
+    // Signed 16-bit distance is correct across 65535 -> 0 wraparound.
+    const int16_t ahead = (int16_t)(uint16_t)(sequence - entry->highest);
+
+    if (ahead > 0) {
+        entry->window = ((uint32_t)ahead < MESH_DEDUP_WINDOW_BITS)
+                            ? ((entry->window << ahead) | 1U)
+                            : 1U;
+        entry->highest = sequence;
+        return false;
+    }
+
+    const uint32_t behind = (uint32_t)(-(int32_t)ahead);
+    if (behind >= MESH_DEDUP_WINDOW_BITS) {
+        // Far older than any retry could be: the sender restarted its
+        // sequence counter, so follow it instead of dropping forever.
+        entry->highest = sequence;
+        entry->window = 1U;
+        return false;
+    }
+
+    const uint32_t bit = 1UL << behind;
+    if ((entry->window & bit) != 0U) {
+        return true;
+    }
+
+    entry->window |= bit;
+    return false;
+}
@@ -0,0 +1,45 @@
+#ifndef MESH_DEDUP_H
+#define MESH_DEDUP_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Number of sequence numbers behind the newest one that are tracked. */
+#define MESH_DEDUP_WINDOW_BITS 32U
+
+/**
+ * @brief Clears every tracked source.
+ */
+void mesh_dedup_reset(void);
+
+/**
+ * @brief Checks a packet against the replay window of its source and records it.
+ *
+ * Each source ID owns one slot of an open-addressed hash table holding the
+ * newest sequence seen and a bitmap of the MESH_DEDUP_WINDOW_BITS sequences
+ * before it. Sequence comparisons are modulo 2^16, so wraparound is handled.
+ * A sequence further behind than the window is taken as a sender restart
+ * and re-seeds the window rather than being dropped forever.
+ *
+ * When the table is full, the least recently heard source in the probe
+ * sequence is evicted, which keeps memory bounded at
+ * CONFIG_APP_DEDUP_TABLE_SIZE entries.
+ *
+ * Args:
+ *     source_id: Logical source node identifier.
+ *     sequence: Packet sequence number.
+ *
+ * Returns:
+ *     True when the packet was already seen; otherwise false.
+ */
+bool mesh_dedup_check_and_record(uint16_t source_id, uint16_t sequence);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
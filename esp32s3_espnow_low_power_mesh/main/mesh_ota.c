@@ -0,0 +1,767 @@
+#include "mesh_ota.h"
+
+#include <string.h>
+
+#include "esp_attr.h"
+#include "sdkconfig.h"
+
+#if CONFIG_APP_MESH_OTA
+
+#include "esp_image_format.h"
+#include "esp_log.h"
+#include "esp_ota_ops.h"
+#include "esp_partition.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "mbedtls/sha256.h"
+#include "nvs.h"
+
+#define OTA_MAX_IMAGE_SIZE ((uint32_t)CONFIG_APP_MESH_OTA_MAX_IMAGE_KB * 1024U)
+#define OTA_MAX_CHUNKS ((OTA_MAX_IMAGE_SIZE + MESH_OTA_CHUNK_SIZE - 1U) / MESH_OTA_CHUNK_SIZE)
+#define OTA_SECTOR_SIZE 4096U
+#define OTA_MAX_SECTORS ((OTA_MAX_IMAGE_SIZE + OTA_SECTOR_SIZE - 1U) / OTA_SECTOR_SIZE)
+#define OTA_BITMAP_BYTES(bits) (((bits) + 7U) / 8U)
+#define OTA_HASH_BLOCK 512U
+#define OTA_NVS_NAMESPACE "mesh_ota"
+#define OTA_NVS_INSTALLED_KEY "installed"
+
+_Static_assert(OTA_MAX_CHUNKS <= UINT16_MAX, "chunk indices are 16-bit");
+_Static_assert(MESH_OTA_CHUNK_HEADER_SIZE + MESH_OTA_CHUNK_SIZE <= MESH_MAX_PACKET_SIZE,
+               "a full chunk must fit in one frame");
+
+#if CONFIG_APP_ROLE_ROOT
+#define OTA_LOCAL_ROLE 0U
+#elif CONFIG_APP_ROLE_ROUTER
+#define OTA_LOCAL_ROLE MESH_OTA_ROLE_ROUTER
+#else
+#define OTA_LOCAL_ROLE MESH_OTA_ROLE_LEAF
+#endif
+
+typedef struct {
+    mesh_ota_announce_t image;  // image_id 0 while no image is known.
+    uint16_t received;
+    uint8_t have[OTA_BITMAP_BYTES(OTA_MAX_CHUNKS)];
+    uint8_t erased[OTA_BITMAP_BYTES(OTA_MAX_SECTORS)];
+} ota_download_t;
+
+static const char *TAG = "mesh_ota";
+static const uint8_t BROADCAST_MAC[6] = {
+    0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU, 0xFFU
+};
+
+// Leaves resume a download here after deep sleep; the chunks themselves
+// are already in flash. A cold boot starts the image over.
+RTC_DATA_ATTR static ota_download_t s_download;
+// Image that esp_ota_set_boot_partition() refused; never fetched again.
+RTC_DATA_ATTR static uint32_t s_rejected_id;
+
+// Root: partition holding the staged image. Others: next OTA partition.
+static const esp_partition_t *s_partition;
+static const mesh_ota_transport_t *s_transport;
+static uint32_t s_installed_id;
+static bool s_targeted;
+static uint16_t s_sequence;
+
+// Guards the bitmaps and counters shared by the receive and serve tasks.
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+
+#if !CONFIG_APP_ROLE_LEAF
+// Chunks children asked for since they were last broadcast.
+static uint8_t s_wanted[OTA_BITMAP_BYTES(OTA_MAX_CHUNKS)];
+static uint16_t s_cursor;
+static TaskHandle_t s_serve_task;
+#endif
+#if CONFIG_APP_ROLE_ROUTER
+static bool s_request_due;
+#endif
+
+static bool bit_test(const uint8_t *map, uint32_t bit)
+{
+    return (map[bit / 8U] & (uint8_t)(1U << (bit % 8U))) != 0U;
+}
+
+static void bit_set(uint8_t *map, uint32_t bit)
+{
+    map[bit / 8U] |= (uint8_t)(1U << (bit % 8U));
+}
+
+static void bit_clear(uint8_t *map, uint32_t bit)
+{
+    map[bit / 8U] &= (uint8_t)~(1U << (bit % 8U));
+}
+
+/**
+ * @brief Returns the size of one chunk of the current image.
+ *
+ * Args:
+ *     index: Chunk index below the chunk count.
+ *
+ * Returns:
+ *     MESH_OTA_CHUNK_SIZE, or less for the last chunk.
+ */
+static uint32_t chunk_length(uint32_t index)
+{
+    const uint32_t offset = index * MESH_OTA_CHUNK_SIZE;
+    const uint32_t remaining = s_download.image.image_size - offset;
+    return (remaining < MESH_OTA_CHUNK_SIZE) ? remaining : MESH_OTA_CHUNK_SIZE;
+}
+
+/**
+ * @brief Writes a mesh header of the given type at the start of a frame.
+ *
+ * Args:
+ *     frame: Destination frame buffer.
+ *     type: MESH_PACKET_OTA_* type.
+ *
+ * Returns:
+ *     Header length in bytes.
+ */
+static size_t begin_frame(uint8_t *frame, uint8_t type)
+{
+    taskENTER_CRITICAL(&s_lock);
+    const uint16_t sequence = ++s_sequence;
+    taskEXIT_CRITICAL(&s_lock);
+
+    const mesh_packet_t header = {
+        .version = MESH_PROTOCOL_VERSION,
+        .type = type,
+        .source_id = CONFIG_APP_NODE_ID,
+        .destination_id = MESH_BROADCAST_NODE_ID,
+        .sequence = sequence,
+        .ttl = 1U,
+        .uptime_ms = (uint32_t)(esp_timer_get_time() / 1000ULL),
+    };
+    memcpy(frame, &header, sizeof(header));
+    return sizeof(header);
+}
+
+/**
+ * @brief Computes the SHA-256 of the first bytes of a partition.
+ *
+ * Args:
+ *     partition: Partition to read.
+ *     length: Number of bytes to hash.
+ *     digest: Receives the 32-byte digest.
+ *
+ * Returns:
+ *     ESP_OK on success or a flash read error code.
+ */
+static esp_err_t partition_sha256(const esp_partition_t *partition,
+                                  uint32_t length,
+                                  uint8_t digest[32])
+{
+    uint8_t block[OTA_HASH_BLOCK];
+    mbedtls_sha256_context sha;
+    esp_err_t err = ESP_OK;
+
+    mbedtls_sha256_init(&sha);
+    mbedtls_sha256_starts(&sha, 0);
+    for (uint32_t offset = 0U; offset < length; offset += sizeof(block)) {
+        const uint32_t size = ((length - offset) < sizeof(block))
+                                  ? (length - offset) : sizeof(block);
+        err = esp_partition_read(partition, offset, block, size);
+        if (err != ESP_OK) {
+            break;
+        }
+        mbedtls_sha256_update(&sha, block, size);
+    }
+    mbedtls_sha256_finish(&sha, digest);
+    mbedtls_sha256_free(&sha);
+    return err;
+}
+
+#if CONFIG_APP_ROLE_ROOT
+/**
+ * @brief Loads and hashes the image staged for distribution.
+ *
+ * Returns:
+ *     ESP_OK on success; ESP_ERR_NOT_FOUND without a partition or a valid
+ *     image; ESP_ERR_INVALID_SIZE when the image exceeds the size limit.
+ */
+static esp_err_t load_staged_image(void)
+{
+    s_partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                           ESP_PARTITION_SUBTYPE_ANY,
+                                           CONFIG_APP_MESH_OTA_IMAGE_PARTITION);
+    if (s_partition == NULL) {
+        ESP_LOGW(TAG, "No \"%s\" partition; nothing to distribute",
+                 CONFIG_APP_MESH_OTA_IMAGE_PARTITION);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    const esp_partition_pos_t position = {
+        .offset = s_partition->address,
+        .size = s_partition->size,
+    };
+    esp_image_metadata_t metadata;
+    if (esp_image_get_metadata(&position, &metadata) != ESP_OK) {
+        ESP_LOGI(TAG, "No valid image staged in \"%s\"",
+                 CONFIG_APP_MESH_OTA_IMAGE_PARTITION);
+        s_partition = NULL;
+        return ESP_ERR_NOT_FOUND;
+    }
+    if (metadata.image_len > OTA_MAX_IMAGE_SIZE) {
+        ESP_LOGE(TAG, "Staged image of %lu bytes exceeds APP_MESH_OTA_MAX_IMAGE_KB",
+                 (unsigned long)metadata.image_len);
+        s_partition = NULL;
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    mesh_ota_announce_t *image = &s_download.image;
+    memset(&s_download, 0, sizeof(s_download));
+    const esp_err_t err = partition_sha256(s_partition, metadata.image_len,
+                                           image->sha256);
+    if (err != ESP_OK) {
+        s_partition = NULL;
+        return err;
+    }
+
+    memcpy(&image->image_id, image->sha256, sizeof(image->image_id));
+    image->image_size = metadata.image_len;
+    image->chunk_count = (uint16_t)((metadata.image_len + MESH_OTA_CHUNK_SIZE - 1U) /
+                                    MESH_OTA_CHUNK_SIZE);
+#if CONFIG_APP_MESH_OTA_TARGET_ROUTERS
+    image->target_roles = MESH_OTA_ROLE_ROUTER;
+#else
+    image->target_roles = MESH_OTA_ROLE_LEAF;
+#endif
+    memset(s_download.have, 0xFF, sizeof(s_download.have));
+    s_download.received = image->chunk_count;
+
+    ESP_LOGI(TAG, "Serving image %08lX: %lu bytes in %u chunks",
+             (unsigned long)image->image_id, (unsigned long)image->image_size,
+             image->chunk_count);
+    return ESP_OK;
+}
+#else
+/**
+ * @brief Locates the update partition and the last installed image.
+ *
+ * Returns:
+ *     ESP_OK on success; ESP_ERR_NOT_FOUND without an OTA partition.
+ */
+static esp_err_t open_update_partition(void)
+{
+    s_partition = esp_ota_get_next_update_partition(NULL);
+    if (s_partition == NULL) {
+        ESP_LOGW(TAG, "Partition table has no OTA slots; mesh updates disabled");
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    nvs_handle_t handle;
+    if (nvs_open(OTA_NVS_NAMESPACE, NVS_READONLY, &handle) == ESP_OK) {
+        nvs_get_u32(handle, OTA_NVS_INSTALLED_KEY, &s_installed_id);
+        nvs_close(handle);
+    }
+
+#if CONFIG_BOOTLOADER_APP_ROLLBACK_ENABLE
+    // Reaching the mesh proves the new image works well enough to keep.
+    esp_ota_img_states_t state;
+    if ((esp_ota_get_state_partition(esp_ota_get_running_partition(), &state) == ESP_OK) &&
+        (state == ESP_OTA_IMG_PENDING_VERIFY)) {
+        esp_ota_mark_app_valid_cancel_rollback();
+    }
+#endif
+
+    // The RTC copy of a download may predate a restart into another slot.
+    if ((s_download.image.image_id != 0U) &&
+        (s_download.image.image_size > s_partition->size)) {
+        memset(&s_download, 0, sizeof(s_download));
+    }
+    s_targeted = ((s_download.image.target_roles & OTA_LOCAL_ROLE) != 0U) &&
+                 (s_download.image.image_id != s_installed_id);
+    return ESP_OK;
+}
+
+/**
+ * @brief Starts downloading an announced image unless it is current.
+ *
+ * Args:
+ *     announce: Announcement received from the mesh.
+ *
+ * Returns:
+ *     True when the announced image is the one being downloaded.
+ */
+static bool adopt_image(const mesh_ota_announce_t *announce)
+{
+    if (announce->image_id == s_download.image.image_id) {
+        return true;
+    }
+
+    const uint32_t expected_chunks =
+        (announce->image_size + MESH_OTA_CHUNK_SIZE - 1U) / MESH_OTA_CHUNK_SIZE;
+    if ((announce->image_id == 0U) || (announce->image_size == 0U) ||
+        (announce->image_size > OTA_MAX_IMAGE_SIZE) ||
+        (announce->image_size > s_partition->size) ||
+        (announce->chunk_count != expected_chunks) ||
+        (announce->image_id == s_rejected_id)) {
+        return false;
+    }
+
+    const bool targeted = ((announce->target_roles & OTA_LOCAL_ROLE) != 0U) &&
+                          (announce->image_id != s_installed_id);
+#if CONFIG_APP_ROLE_LEAF
+    // Leaves only spend flash and airtime on their own firmware.
+    if (!targeted) {
+        return false;
+    }
+#endif
+
+    taskENTER_CRITICAL(&s_lock);
+    memset(&s_download, 0, sizeof(s_download));
+    s_download.image = *announce;
+    s_targeted = targeted;
+#if CONFIG_APP_ROLE_ROUTER
+    memset(s_wanted, 0, sizeof(s_wanted));
+#endif
+    taskEXIT_CRITICAL(&s_lock);
+
+    ESP_LOGI(TAG, "Downloading image %08lX: %lu bytes in %u chunks%s",
+             (unsigned long)announce->image_id,
+             (unsigned long)announce->image_size, announce->chunk_count,
+             targeted ? "" : " (cached for children)");
+    return true;
+}
+
+/**
+ * @brief Adopts an announced image and, on routers, relays the announcement.
+ *
+ * Routers relay only their parent's announcements, the same rule that keeps
+ * beacon relaying loop-free.
+ *
+ * Args:
+ *     item: Pool frame holding a MESH_PACKET_OTA_ANNOUNCE frame.
+ */
+static void handle_announce(const mesh_rx_frame_t *item)
+{
+    mesh_ota_announce_t announce;
+    memcpy(&announce, item->frame + sizeof(mesh_packet_t), sizeof(announce));
+    if (!adopt_image(&announce)) {
+        return;
+    }
+
+#if CONFIG_APP_ROLE_ROUTER
+    if (memcmp(item->source_mac, s_transport->upstream_mac(),
+               sizeof(item->source_mac)) == 0) {
+        uint8_t frame[MESH_OTA_ANNOUNCE_FRAME_SIZE];
+        const size_t offset = begin_frame(frame, MESH_PACKET_OTA_ANNOUNCE);
+        memcpy(frame + offset, &announce, sizeof(announce));
+        s_transport->send(BROADCAST_MAC, frame, sizeof(frame));
+    }
+#endif
+}
+
+/**
+ * @brief Stores a chunk of the current image in the update partition.
+ *
+ * Flash sectors are erased the first time a chunk touches them, so chunks
+ * can arrive in any order over many wake cycles without erasing the whole
+ * partition up front.
+ *
+ * Args:
+ *     item: Pool frame holding a MESH_PACKET_OTA_CHUNK frame.
+ */
+static void handle_chunk(const mesh_rx_frame_t *item)
+{
+    mesh_ota_chunk_info_t info;
+    memcpy(&info, item->frame + sizeof(mesh_packet_t), sizeof(info));
+
+    const mesh_ota_announce_t *image = &s_download.image;
+    if ((image->image_id == 0U) || (info.image_id != image->image_id) ||
+        (info.chunk_index >= image->chunk_count) ||
+        bit_test(s_download.have, info.chunk_index)) {
+        return;
+    }
+
+    const uint32_t length = chunk_length(info.chunk_index);
+    if ((size_t)item->length != MESH_OTA_CHUNK_HEADER_SIZE + length) {
+        return;
+    }
+
+    const uint32_t offset = (uint32_t)info.chunk_index * MESH_OTA_CHUNK_SIZE;
+    for (uint32_t sector = offset / OTA_SECTOR_SIZE;
+         sector <= (offset + length - 1U) / OTA_SECTOR_SIZE; ++sector) {
+        if (bit_test(s_download.erased, sector)) {
+            continue;
+        }
+        const esp_err_t err = esp_partition_erase_range(
+            s_partition, sector * OTA_SECTOR_SIZE, OTA_SECTOR_SIZE);
+        if (err != ESP_OK) {
+            ESP_LOGE(TAG, "Erasing sector %lu failed: %s",
+                     (unsigned long)sector, esp_err_to_name(err));
+            return;
+        }
+        bit_set(s_download.erased, sector);
+    }
+
+    const esp_err_t err = esp_partition_write(
+        s_partition, offset, item->frame + MESH_OTA_CHUNK_HEADER_SIZE, length);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Writing chunk %u failed: %s", info.chunk_index,
+                 esp_err_to_name(err));
+        return;
+    }
+
+    taskENTER_CRITICAL(&s_lock);
+    bit_set(s_download.have, info.chunk_index);
+    s_download.received++;
+    taskEXIT_CRITICAL(&s_lock);
+
+    if ((s_download.received % 256U) == 0U) {
+        ESP_LOGI(TAG, "Image %08lX: %u/%u chunks",
+                 (unsigned long)image->image_id, s_download.received,
+                 image->chunk_count);
+    }
+#if CONFIG_APP_ROLE_ROUTER
+    // A child may be waiting for this chunk.
+    xTaskNotifyGive(s_serve_task);
+#endif
+}
+
+/**
+ * @brief Reports whether a chunk should be requested from the parent.
+ *
+ * Args:
+ *     index: Chunk index.
+ *
+ * Returns:
+ *     True when the chunk is missing and this node or a child needs it.
+ */
+static bool chunk_needed(uint32_t index)
+{
+    if (bit_test(s_download.have, index)) {
+        return false;
+    }
+#if CONFIG_APP_ROLE_ROUTER
+    return s_targeted || bit_test(s_wanted, index);
+#else
+    return true;
+#endif
+}
+#endif
+
+#if !CONFIG_APP_ROLE_LEAF
+/**
+ * @brief Merges a child's request into the wanted bitmap.
+ *
+ * Args:
+ *     item: Pool frame holding a MESH_PACKET_OTA_REQUEST frame.
+ */
+static void handle_request(const mesh_rx_frame_t *item)
+{
+    uint32_t image_id;
+    memcpy(&image_id, item->frame + sizeof(mesh_packet_t), sizeof(image_id));
+    if ((image_id == 0U) || (image_id != s_download.image.image_id)) {
+        return;
+    }
+
+    const size_t range_count = (item->length - MESH_OTA_REQUEST_HEADER_SIZE) /
+                               sizeof(mesh_ota_range_t);
+    const uint32_t chunk_count = s_download.image.chunk_count;
+
+    taskENTER_CRITICAL(&s_lock);
+    for (size_t i = 0U; i < range_count; ++i) {
+        mesh_ota_range_t range;
+        memcpy(&range,
+               item->frame + MESH_OTA_REQUEST_HEADER_SIZE + (i * sizeof(range)),
+               sizeof(range));
+        uint32_t end = (uint32_t)range.first + range.count;
+        if (end > chunk_count) {
+            end = chunk_count;
+        }
+        for (uint32_t chunk = range.first; chunk < end; ++chunk) {
+            bit_set(s_wanted, chunk);
+#if CONFIG_APP_ROLE_ROUTER
+            if (!bit_test(s_download.have, chunk)) {
+                s_request_due = true;
+            }
+#endif
+        }
+    }
+    taskEXIT_CRITICAL(&s_lock);
+
+    xTaskNotifyGive(s_serve_task);
+}
+
+/**
+ * @brief Picks the next wanted chunk that can be served and clears it.
+ *
+ * The scan resumes after the last chunk sent, so every wanted chunk goes
+ * out once per pass however many children asked for it.
+ *
+ * Args:
+ *     index: Receives the chunk index.
+ *
+ * Returns:
+ *     True when a chunk was picked.
+ */
+static bool take_wanted_chunk(uint16_t *index)
+{
+    const uint32_t chunk_count = s_download.image.chunk_count;
+    bool found = false;
+
+    taskENTER_CRITICAL(&s_lock);
+    for (uint32_t step = 0U; step < chunk_count; ++step) {
+        const uint32_t chunk = (s_cursor + step) % chunk_count;
+        if (bit_test(s_wanted, chunk) && bit_test(s_download.have, chunk)) {
+            bit_clear(s_wanted, chunk);
+            s_cursor = (uint16_t)((chunk + 1U) % chunk_count);
+            *index = (uint16_t)chunk;
+            found = true;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL(&s_lock);
+    return found;
+}
+
+/**
+ * @brief Reads one chunk from flash and broadcasts it.
+ *
+ * Args:
+ *     index: Chunk index held locally.
+ */
+static void send_chunk(uint16_t index)
+{
+    uint8_t frame[MESH_OTA_CHUNK_HEADER_SIZE + MESH_OTA_CHUNK_SIZE];
+    size_t offset = begin_frame(frame, MESH_PACKET_OTA_CHUNK);
+
+    const mesh_ota_chunk_info_t info = {
+        .image_id = s_download.image.image_id,
+        .chunk_index = index,
+    };
+    memcpy(frame + offset, &info, sizeof(info));
+    offset += sizeof(info);
+
+    const uint32_t length = chunk_length(index);
+    if (esp_partition_read(s_partition, (uint32_t)index * MESH_OTA_CHUNK_SIZE,
+                           frame + offset, length) != ESP_OK) {
+        ESP_LOGE(TAG, "Reading chunk %u failed", index);
+        return;
+    }
+    s_transport->send(BROADCAST_MAC, frame, offset + length);
+}
+
+/**
+ * @brief Broadcasts requested chunks, paced to leave airtime for sensor traffic.
+ *
+ * Routers also ask upstream for chunks their children want but they lack,
+ * and apply the image themselves when it targets routers.
+ *
+ * Args:
+ *     context: Unused task argument.
+ */
+static void serve_task(void *context)
+{
+    (void)context;
+
+    while (true) {
+        uint16_t index;
+        if (take_wanted_chunk(&index)) {
+            send_chunk(index);
+            vTaskDelay(pdMS_TO_TICKS(CONFIG_APP_MESH_OTA_CHUNK_INTERVAL_MS));
+            continue;
+        }
+
+#if CONFIG_APP_ROLE_ROUTER
+        if (s_request_due || mesh_ota_in_progress()) {
+            s_request_due = false;
+            ESP_ERROR_CHECK_WITHOUT_ABORT(mesh_ota_request_missing());
+        }
+        if (s_targeted && (s_download.image.image_id != 0U) &&
+            (s_download.received == s_download.image.chunk_count)) {
+            ESP_ERROR_CHECK_WITHOUT_ABORT(mesh_ota_apply());
+        }
+#endif
+
+        // Woken early by requests and new chunks; the timeout re-requests
+        // chunks whose request or broadcast was lost.
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONFIG_APP_MESH_OTA_REQUEST_INTERVAL_MS));
+    }
+}
+#endif
+
+esp_err_t mesh_ota_init(const mesh_ota_transport_t *transport)
+{
+    if ((transport == NULL) || (transport->send == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    s_transport = transport;
+
+#if CONFIG_APP_ROLE_ROOT
+    return load_staged_image();
+#else
+    return open_update_partition();
+#endif
+}
+
+esp_err_t mesh_ota_start(void)
+{
+#if CONFIG_APP_ROLE_LEAF
+    return ESP_ERR_NOT_SUPPORTED;
+#else
+    if (s_partition == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (xTaskCreate(serve_task, "mesh_ota", 4096, NULL, 4, &s_serve_task) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+#endif
+}
+
+void mesh_ota_announce(void)
+{
+#if CONFIG_APP_ROLE_ROOT
+    if (s_partition == NULL) {
+        return;
+    }
+
+    uint8_t frame[MESH_OTA_ANNOUNCE_FRAME_SIZE];
+    const size_t offset = begin_frame(frame, MESH_PACKET_OTA_ANNOUNCE);
+    memcpy(frame + offset, &s_download.image, sizeof(s_download.image));
+    s_transport->send(BROADCAST_MAC, frame, sizeof(frame));
+#endif
+}
+
+void mesh_ota_handle_frame(const mesh_rx_frame_t *item)
+{
+    if ((item == NULL) || (s_partition == NULL)) {
+        return;
+    }
+
+    switch (item->packet.type) {
+#if !CONFIG_APP_ROLE_ROOT
+    case MESH_PACKET_OTA_ANNOUNCE:
+        handle_announce(item);
+        break;
+    case MESH_PACKET_OTA_CHUNK:
+        handle_chunk(item);
+        break;
+#endif
+#if !CONFIG_APP_ROLE_LEAF
+    case MESH_PACKET_OTA_REQUEST:
+        handle_request(item);
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+bool mesh_ota_in_progress(void)
+{
+    return (s_partition != NULL) && s_targeted &&
+           (s_download.image.image_id != 0U) &&
+           (s_download.received < s_download.image.chunk_count);
+}
+
+uint16_t mesh_ota_received_chunks(void)
+{
+    return s_download.received;
+}
+
+esp_err_t mesh_ota_request_missing(void)
+{
+#if CONFIG_APP_ROLE_ROOT
+    return ESP_OK;
+#else
+    if ((s_partition == NULL) || (s_download.image.image_id == 0U)) {
+        return ESP_OK;
+    }
+
+    uint8_t frame[MESH_MAX_PACKET_SIZE];
+    size_t length = begin_frame(frame, MESH_PACKET_OTA_REQUEST);
+    memcpy(frame + length, &s_download.image.image_id, sizeof(uint32_t));
+    length += sizeof(uint32_t);
+
+    // Collect runs of needed chunks until the frame is full.
+    size_t ranges = 0U;
+    mesh_ota_range_t range = {0};
+    taskENTER_CRITICAL(&s_lock);
+    for (uint32_t chunk = 0U;
+         (chunk < s_download.image.chunk_count) && (ranges < MESH_OTA_MAX_RANGES);
+         ++chunk) {
+        if (chunk_needed(chunk)) {
+            if (range.count == 0U) {
+                range.first = (uint16_t)chunk;
+            }
+            range.count++;
+            if (chunk + 1U < s_download.image.chunk_count) {
+                continue;
+            }
+        }
+        if (range.count > 0U) {
+            memcpy(frame + length, &range, sizeof(range));
+            length += sizeof(range);
+            ranges++;
+            range.count = 0U;
+        }
+    }
+    taskEXIT_CRITICAL(&s_lock);
+
+    if (ranges == 0U) {
+        return ESP_OK;
+    }
+
+    ESP_LOGD(TAG, "Requesting %u runs of image %08lX", (unsigned)ranges,
+             (unsigned long)s_download.image.image_id);
+    return s_transport->send(s_transport->upstream_mac(), frame, length);
+#endif
+}
+
+esp_err_t mesh_ota_apply(void)
+{
+#if CONFIG_APP_ROLE_ROOT
+    return ESP_ERR_INVALID_STATE;
+#else
+    const mesh_ota_announce_t image = s_download.image;
+    if ((s_partition == NULL) || !s_targeted || (image.image_id == 0U) ||
+        (s_download.received != image.chunk_count)) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    uint8_t digest[32];
+    esp_err_t err = partition_sha256(s_partition, image.image_size, digest);
+    if (err != ESP_OK) {
+        return err;
+    }
+    if (memcmp(digest, image.sha256, sizeof(digest)) != 0) {
+        ESP_LOGE(TAG, "Image %08lX failed SHA-256 check; downloading again",
+                 (unsigned long)image.image_id);
+        taskENTER_CRITICAL(&s_lock);
+        memset(s_download.have, 0, sizeof(s_download.have));
+        memset(s_download.erased, 0, sizeof(s_download.erased));
+        s_download.received = 0U;
+        taskEXIT_CRITICAL(&s_lock);
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    // Also checks the image format, and its signature with secure boot.
+    err = esp_ota_set_boot_partition(s_partition);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Image %08lX rejected: %s", (unsigned long)image.image_id,
+                 esp_err_to_name(err));
+        s_rejected_id = image.image_id;
+        memset(&s_download, 0, sizeof(s_download));
+        s_targeted = false;
+        return err;
+    }
+
+    nvs_handle_t handle;
+    if (nvs_open(OTA_NVS_NAMESPACE, NVS_READWRITE, &handle) == ESP_OK) {
+        nvs_set_u32(handle, OTA_NVS_INSTALLED_KEY, image.image_id);
+        nvs_commit(handle);
+        nvs_close(handle);
+    }
+
+    ESP_LOGI(TAG, "Image %08lX verified; restarting into %s",
+             (unsigned long)image.image_id, s_partition->label);
+    esp_restart();
+    return ESP_OK;
+#endif
+}
+
+#endif
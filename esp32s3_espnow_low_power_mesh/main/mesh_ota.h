@@ -0,0 +1,128 @@
+#ifndef MESH_OTA_H
+#define MESH_OTA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "mesh_protocol.h"
+#include "mesh_rx.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Firmware distribution over the mesh.
+ *
+ * The root serves an image staged in its APP_MESH_OTA_IMAGE_PARTITION
+ * data partition and announces it after every beacon. Targeted nodes
+ * record which chunks they hold in an RTC-memory bitmap, write chunks
+ * straight into their next OTA partition, and unicast the runs they still
+ * miss to their parent. A parent merges all requests into one bitmap and
+ * broadcasts each wanted chunk once per pass, so a chunk costs the same
+ * airtime however many children asked for it.
+ *
+ * Routers always cache the image in their own OTA partition and serve
+ * their children from it, asking upstream only for chunks they lack.
+ * Once every chunk is present the image is checked against the announced
+ * SHA-256 and activated with esp_ota_set_boot_partition().
+ */
+
+typedef struct {
+    // Finalizes and sends a frame; the frame buffer may be modified.
+    esp_err_t (*send)(const uint8_t destination_mac[6], uint8_t *frame,
+                      size_t length);
+    // Returns the current parent MAC; unused on the root.
+    const uint8_t *(*upstream_mac)(void);
+} mesh_ota_transport_t;
+
+/**
+ * @brief Prepares firmware distribution for the configured role.
+ *
+ * The root loads and hashes the staged image. Routers and leaves locate
+ * their next OTA partition and read the last installed image ID from NVS,
+ * which must be initialized first. Until this succeeds every other call
+ * is a no-op.
+ *
+ * Args:
+ *     transport: Frame transmit hooks; must stay valid.
+ *
+ * Returns:
+ *     ESP_OK on success; ESP_ERR_NOT_FOUND when the partition table has no
+ *     suitable partition or no valid image is staged.
+ */
+esp_err_t mesh_ota_init(const mesh_ota_transport_t *transport);
+
+/**
+ * @brief Starts the task that broadcasts requested chunks (root and routers).
+ *
+ * Returns:
+ *     ESP_OK on success; ESP_ERR_INVALID_STATE before a successful
+ *     mesh_ota_init(); ESP_ERR_NO_MEM when the task cannot be created.
+ */
+esp_err_t mesh_ota_start(void);
+
+/**
+ * @brief Broadcasts the announcement of the served image (root only).
+ *
+ * Called right after each beacon, while sleeping leaves are listening.
+ */
+void mesh_ota_announce(void);
+
+/**
+ * @brief Handles a validated MESH_PACKET_OTA_* frame from the receive pool.
+ *
+ * Args:
+ *     item: Pool frame holding the OTA frame.
+ */
+void mesh_ota_handle_frame(const mesh_rx_frame_t *item);
+
+/**
+ * @brief Reports whether this node is downloading an image meant for it.
+ *
+ * Returns:
+ *     True while a targeted image is incomplete.
+ */
+bool mesh_ota_in_progress(void);
+
+/**
+ * @brief Returns the number of chunks of the current image held locally.
+ *
+ * Returns:
+ *     Chunk count, or 0 when no image is known.
+ */
+uint16_t mesh_ota_received_chunks(void);
+
+/**
+ * @brief Asks the parent for the chunks this node still misses.
+ *
+ * Sends up to MESH_OTA_MAX_RANGES runs, lowest chunk first; later gaps are
+ * requested on a later call.
+ *
+ * Returns:
+ *     ESP_OK when a request was sent or nothing is missing; otherwise an
+ *     ESP-NOW error code.
+ */
+esp_err_t mesh_ota_request_missing(void);
+
+/**
+ * @brief Verifies a complete targeted image and boots into it.
+ *
+ * On a SHA-256 mismatch the chunk bitmap is cleared so the image is
+ * downloaded again; an image esp_ota_set_boot_partition() rejects is
+ * ignored from then on.
+ *
+ * Returns:
+ *     Does not return on success; ESP_ERR_INVALID_STATE when no targeted
+ *     image is complete; ESP_ERR_INVALID_CRC on a digest mismatch;
+ *     otherwise a flash or OTA error code.
+ */
+esp_err_t mesh_ota_apply(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
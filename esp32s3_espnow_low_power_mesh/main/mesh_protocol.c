@@ -1,11 +1,17 @@
 #include "mesh_protocol.h"
 
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 
+#include "sdkconfig.h"
+#include "mesh_crc16.h"
+
 /**
  * @brief Calculates a CRC-16/CCITT-FALSE checksum.
  *
+ * Dispatches to the implementation selected by APP_CRC16_IMPL.
+ *
  * Args:
  *     data: Pointer to the data buffer.
  *     length: Number of bytes to process.
@@ -15,17 +21,107 @@
  */
 uint16_t mesh_crc16_ccitt(const uint8_t *data, size_t length)
 {
-    uint16_t crc = 0xFFFFU;
+#if CONFIG_APP_CRC16_ROM
+    return mesh_crc16_ccitt_rom(data, length);
+#elif CONFIG_APP_CRC16_BITWISE
+    return mesh_crc16_ccitt_bitwise(data, length);
+#else
+    return mesh_crc16_ccitt_slice4(data, length);
+#endif
+}
+
+/**
+ * @brief Appends an unsigned LEB128 varint.
+ *
+ * Args:
+ *     value: Value to encode.
+ *     out: Destination buffer.
+ *     pos: Write position, advanced past the varint.
+ *     capacity: Size of the destination buffer.
+ *
+ * Returns:
+ *     True when the varint fit; otherwise false and pos is unchanged.
+ */
+static bool put_varint(uint32_t value, uint8_t *out, size_t *pos,
+                       size_t capacity)
+{
+    size_t p = *pos;
+    do {
+        if (p >= capacity) {
+            return false;
+        }
+        const uint8_t low = (uint8_t)(value & 0x7FU);
+        value >>= 7;
+        out[p++] = (value != 0U) ? (uint8_t)(low | 0x80U) : low;
+    } while (value != 0U);
+
+    *pos = p;
+    return true;
+}
 
-    for (size_t i = 0; i < length; ++i) {
-        crc ^= (uint16_t)data[i] << 8U;
-        for (uint8_t bit = 0; bit < 8U; ++bit) {
-            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1U) ^ 0x1021U)
-                                  : (uint16_t)(crc << 1U);
+/**
+ * @brief Reads an unsigned LEB128 varint.
+ *
+ * Args:
+ *     in: Source buffer.
+ *     pos: Read position, advanced past the varint.
+ *     length: Size of the source buffer.
+ *     value: Receives the decoded value.
+ *
+ * Returns:
+ *     True on success; false on truncation or overlong encoding.
+ */
+static bool get_varint(const uint8_t *in, size_t *pos, size_t length,
+                       uint32_t *value)
+{
+    uint32_t result = 0U;
+    for (uint32_t shift = 0U; shift < 35U; shift += 7U) {
+        if (*pos >= length) {
+            return false;
+        }
+        const uint8_t byte = in[(*pos)++];
+        result |= (uint32_t)(byte & 0x7FU) << shift;
+        if ((byte & 0x80U) == 0U) {
+            *value = result;
+            return true;
         }
     }
+    return false;
+}
+
+/**
+ * @brief Maps a signed delta onto an unsigned value with small magnitude.
+ */
+static uint32_t zigzag_encode(int32_t value)
+{
+    return ((uint32_t)value << 1) ^ (0U - ((uint32_t)value >> 31));
+}
+
+/**
+ * @brief Inverse of zigzag_encode().
+ */
+static int32_t zigzag_decode(uint32_t value)
+{
+    return (int32_t)((value >> 1) ^ (0U - (value & 1U)));
+}
+
+/**
+ * @brief Finalizes a frame of any length by assigning its header CRC field.
+ *
+ * Args:
+ *     frame: Frame starting with a mesh_packet_t header.
+ *     length: Total frame length in bytes.
+ */
+void mesh_frame_finalize(uint8_t *frame, size_t length)
+{
+    if ((frame == NULL) || (length < sizeof(mesh_packet_t))) {
+        return;
+    }
 
-    return crc;
+    uint16_t crc = 0U;
+    memcpy(frame + offsetof(mesh_packet_t, payload_crc), &crc, sizeof(crc));
+    crc = mesh_crc16_ccitt(frame, length);
+    memcpy(frame + offsetof(mesh_packet_t, payload_crc), &crc, sizeof(crc));
 }
 
 /**
@@ -40,14 +136,166 @@ void mesh_packet_finalize(mesh_packet_t *packet)
         return;
     }
 
-    packet->payload_crc = 0U;
-    packet->payload_crc = mesh_crc16_ccitt((const uint8_t *)packet,
-                                          sizeof(*packet));
+    mesh_frame_finalize((uint8_t *)packet, sizeof(*packet));
+}
+
+/**
+ * @brief Builds a delta-encoded sensor batch frame.
+ *
+ * Args:
+ *     header: Template for the header; its type and sensor fields are replaced.
+ *     samples: Buffered samples, oldest first.
+ *     count: Number of buffered samples.
+ *     now_s: Current time on the same clock as the sample timestamps.
+ *     frame: Destination buffer.
+ *     capacity: Size of the destination buffer.
+ *     encoded_count: Receives the number of samples placed in the frame.
+ *
+ * Returns:
+ *     Frame length in bytes, or 0 when the arguments do not fit.
+ */
+size_t mesh_batch_encode(const mesh_packet_t *header,
+                         const mesh_sample_t *samples,
+                         size_t count,
+                         uint32_t now_s,
+                         uint8_t *frame,
+                         size_t capacity,
+                         size_t *encoded_count)
+{
+    if ((header == NULL) || (samples == NULL) || (frame == NULL) ||
+        (encoded_count == NULL) || (count == 0U)) {
+        return 0U;
+    }
+
+    if (capacity > MESH_MAX_PACKET_SIZE) {
+        capacity = MESH_MAX_PACKET_SIZE;
+    }
+    if (count > MESH_BATCH_MAX_SAMPLES) {
+        count = MESH_BATCH_MAX_SAMPLES;
+    }
+
+    mesh_packet_t packet = *header;
+    packet.type = MESH_PACKET_SENSOR_BATCH;
+    packet.temperature_centi_c = samples[0].temperature_centi_c;
+    packet.humidity_centi_pct = samples[0].humidity_centi_pct;
+    packet.battery_mv = samples[0].battery_mv;
+
+    // Header, sample count, and base age must fit before any delta.
+    size_t pos = sizeof(packet) + 1U;
+    if ((capacity < pos) ||
+        !put_varint(now_s - samples[0].time_s, frame, &pos, capacity)) {
+        return 0U;
+    }
+
+    size_t encoded = 1U;
+    for (; encoded < count; ++encoded) {
+        const mesh_sample_t *prev = &samples[encoded - 1U];
+        const mesh_sample_t *cur = &samples[encoded];
+        size_t next = pos;
+
+        // Commit a sample only when all four fields fit.
+        if (!put_varint(cur->time_s - prev->time_s, frame, &next, capacity) ||
+            !put_varint(zigzag_encode((int32_t)cur->temperature_centi_c -
+                                      prev->temperature_centi_c),
+                        frame, &next, capacity) ||
+            !put_varint(zigzag_encode((int32_t)cur->humidity_centi_pct -
+                                      prev->humidity_centi_pct),
+                        frame, &next, capacity) ||
+            !put_varint(zigzag_encode((int32_t)cur->battery_mv -
+                                      prev->battery_mv),
+                        frame, &next, capacity)) {
+            break;
+        }
+        pos = next;
+    }
+
+    memcpy(frame, &packet, sizeof(packet));
+    frame[sizeof(packet)] = (uint8_t)encoded;
+    *encoded_count = encoded;
+    return pos;
+}
+
+/**
+ * @brief Decodes the samples of a validated sensor batch frame.
+ *
+ * Args:
+ *     frame: Frame bytes.
+ *     length: Frame length in bytes.
+ *     now_s: Receiver time that decoded timestamps are expressed against.
+ *     samples: Destination array, oldest first.
+ *     capacity: Number of entries in the destination array.
+ *     count: Receives the number of decoded samples.
+ *
+ * Returns:
+ *     ESP_OK on success; ESP_ERR_INVALID_SIZE when the body is malformed.
+ */
+esp_err_t mesh_batch_decode(const uint8_t *frame,
+                            size_t length,
+                            uint32_t now_s,
+                            mesh_sample_t *samples,
+                            size_t capacity,
+                            size_t *count)
+{
+    if ((frame == NULL) || (samples == NULL) || (count == NULL) ||
+        (length < sizeof(mesh_packet_t) + 1U)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    mesh_packet_t packet;
+    memcpy(&packet, frame, sizeof(packet));
+
+    const size_t total = frame[sizeof(packet)];
+    if ((total == 0U) || (total > capacity)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    size_t pos = sizeof(packet) + 1U;
+    uint32_t age_s;
+    if (!get_varint(frame, &pos, length, &age_s)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    samples[0].time_s = now_s - age_s;
+    samples[0].temperature_centi_c = packet.temperature_centi_c;
+    samples[0].humidity_centi_pct = packet.humidity_centi_pct;
+    samples[0].battery_mv = packet.battery_mv;
+
+    for (size_t i = 1U; i < total; ++i) {
+        uint32_t dt_s, d_temp, d_hum, d_batt;
+        if (!get_varint(frame, &pos, length, &dt_s) ||
+            !get_varint(frame, &pos, length, &d_temp) ||
+            !get_varint(frame, &pos, length, &d_hum) ||
+            !get_varint(frame, &pos, length, &d_batt)) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+
+        const mesh_sample_t *prev = &samples[i - 1U];
+        samples[i].time_s = prev->time_s + dt_s;
+        samples[i].temperature_centi_c =
+            (int16_t)(prev->temperature_centi_c + zigzag_decode(d_temp));
+        samples[i].humidity_centi_pct =
+            (uint16_t)(prev->humidity_centi_pct + zigzag_decode(d_hum));
+        samples[i].battery_mv =
+            (uint16_t)(prev->battery_mv + zigzag_decode(d_batt));
+    }
+
+    if (pos != length) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    *count = total;
+    return ESP_OK;
 }
 
 /**
  * @brief Validates packet size, version, type, and CRC.
  *
+ * Beacons must be exactly MESH_BEACON_FRAME_SIZE bytes, sensor batches
+ * may be up to MESH_MAX_PACKET_SIZE bytes, and every other packet type
+ * must be exactly sizeof(mesh_packet_t). Only sensor packets and batches
+ * may be sealed; their sizes then exclude the MESH_SEAL_TRAILER_SIZE-byte
+ * trailer. The seal itself is checked by mesh_crypto_open().
+ *
  * Args:
  *     data: Received byte buffer.
  *     length: Number of bytes in the buffer.
@@ -57,7 +305,8 @@ void mesh_packet_finalize(mesh_packet_t *packet)
  */
 esp_err_t mesh_packet_validate(const uint8_t *data, size_t length)
 {
-    if ((data == NULL) || (length != sizeof(mesh_packet_t))) {
+    if ((data == NULL) || (length < sizeof(mesh_packet_t)) ||
+        (length > MESH_MAX_PACKET_SIZE)) {
         return ESP_ERR_INVALID_SIZE;
     }
 
@@ -69,14 +318,52 @@ esp_err_t mesh_packet_validate(const uint8_t *data, size_t length)
     }
 
     if ((packet.type < MESH_PACKET_BEACON) ||
-        (packet.type > MESH_PACKET_ACK)) {
+        (packet.type > MESH_PACKET_OTA_REQUEST)) {
         return ESP_ERR_INVALID_ARG;
     }
 
+    size_t body_length = length;
+    if ((packet.flags & MESH_PACKET_FLAG_SEALED) != 0U) {
+        if (((packet.type != MESH_PACKET_SENSOR) &&
+             (packet.type != MESH_PACKET_SENSOR_BATCH)) ||
+            (length < sizeof(packet) + MESH_SEAL_TRAILER_SIZE)) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+        body_length -= MESH_SEAL_TRAILER_SIZE;
+    }
+
+    if (packet.type == MESH_PACKET_BEACON) {
+        if (length != MESH_BEACON_FRAME_SIZE) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+    } else if (packet.type == MESH_PACKET_OTA_ANNOUNCE) {
+        if (length != MESH_OTA_ANNOUNCE_FRAME_SIZE) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+    } else if (packet.type == MESH_PACKET_OTA_CHUNK) {
+        if ((length <= MESH_OTA_CHUNK_HEADER_SIZE) ||
+            (length > MESH_OTA_CHUNK_HEADER_SIZE + MESH_OTA_CHUNK_SIZE)) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+    } else if (packet.type == MESH_PACKET_OTA_REQUEST) {
+        if ((length <= MESH_OTA_REQUEST_HEADER_SIZE) ||
+            (((length - MESH_OTA_REQUEST_HEADER_SIZE) %
+              sizeof(mesh_ota_range_t)) != 0U)) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+    } else if ((packet.type == MESH_PACKET_SENSOR_BATCH) !=
+               (body_length > sizeof(packet))) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint8_t frame[MESH_MAX_PACKET_SIZE];
+    memcpy(frame, data, length);
     const uint16_t received_crc = packet.payload_crc;
-    packet.payload_crc = 0U;
-    const uint16_t calculated_crc = mesh_crc16_ccitt(
-        (const uint8_t *)&packet, sizeof(packet));
+    mesh_frame_finalize(frame, length);
+
+    uint16_t calculated_crc;
+    memcpy(&calculated_crc, frame + offsetof(mesh_packet_t, payload_crc),
+           sizeof(calculated_crc));
 
     return (received_crc == calculated_crc) ? ESP_OK : ESP_ERR_INVALID_CRC;
 }
@@ -14,11 +14,21 @@ extern "C" {
 #define MESH_PROTOCOL_VERSION 1U
 #define MESH_BROADCAST_NODE_ID 0xFFFFU
 #define MESH_MAX_PACKET_SIZE 250U
+#define MESH_BATCH_MAX_SAMPLES 32U
+
+// Header flag: sensor fields and body are AES-CCM encrypted and the frame
+// ends in a MESH_SEAL_TRAILER_SIZE-byte trailer (see mesh_crypto.h).
+#define MESH_PACKET_FLAG_SEALED 0x01U
+#define MESH_SEAL_TRAILER_SIZE 16U
 
 typedef enum {
     MESH_PACKET_BEACON = 1,
     MESH_PACKET_SENSOR = 2,
     MESH_PACKET_ACK = 3,
+    MESH_PACKET_SENSOR_BATCH = 4,
+    MESH_PACKET_OTA_ANNOUNCE = 5,
+    MESH_PACKET_OTA_CHUNK = 6,
+    MESH_PACKET_OTA_REQUEST = 7,
 } mesh_packet_type_t;
 
 typedef struct __attribute__((packed)) {
@@ -36,6 +46,97 @@ typedef struct __attribute__((packed)) {
     uint16_t payload_crc;
 } mesh_packet_t;
 
+/*
+ * A MESH_PACKET_BEACON frame is a mesh_packet_t header followed by a
+ * mesh_beacon_info_t advertising the sender's route to the root. The root
+ * advertises hop count 0 and cost 0; routers re-broadcast the beacons of
+ * their chosen parent with their own hop count and cost.
+ *
+ * With MESH_BEACON_FLAG_TDMA set, the beacon also carries the root's time
+ * base: network_time_ms is the root clock, and the cycle is slot_count
+ * slots of slot_ms each, with the beacon sent slot_offset_ms into slot
+ * slot_index. Routers copy these fields unchanged when re-broadcasting.
+ */
+
+#define MESH_BEACON_FLAG_TDMA 0x01U
+
+typedef struct __attribute__((packed)) {
+    uint8_t hop_count;
+    uint8_t flags;
+    uint16_t path_cost;
+    uint16_t parent_id;
+    uint32_t network_time_ms;
+    uint16_t slot_ms;
+    uint16_t slot_count;
+    uint16_t slot_index;
+    uint16_t slot_offset_ms;
+} mesh_beacon_info_t;
+
+#define MESH_BEACON_FRAME_SIZE (sizeof(mesh_packet_t) + sizeof(mesh_beacon_info_t))
+
+/*
+ * A MESH_PACKET_SENSOR_BATCH frame is a mesh_packet_t header whose sensor
+ * fields hold the oldest sample, followed by:
+ *
+ *     uint8_t sample_count
+ *     varint  age_s of the oldest sample when the frame was built
+ *     (sample_count - 1) x {varint dt_s, zigzag varint d_temperature,
+ *                           zigzag varint d_humidity, zigzag varint d_battery}
+ *
+ * Deltas are taken against the previous sample, so slowly changing
+ * readings cost one byte per field. payload_crc covers the whole frame.
+ */
+
+typedef struct {
+    uint32_t time_s;
+    int16_t temperature_centi_c;
+    uint16_t humidity_centi_pct;
+    uint16_t battery_mv;
+} mesh_sample_t;
+
+/*
+ * Firmware distribution (see mesh_ota.h). Every frame is a mesh_packet_t
+ * header, whose sensor fields are unused, followed by:
+ *
+ *     MESH_PACKET_OTA_ANNOUNCE  mesh_ota_announce_t describing the image
+ *     MESH_PACKET_OTA_CHUNK     mesh_ota_chunk_info_t, then up to
+ *                               MESH_OTA_CHUNK_SIZE image bytes
+ *     MESH_PACKET_OTA_REQUEST   uint32_t image_id, then 1..MESH_OTA_MAX_RANGES
+ *                               mesh_ota_range_t runs of missing chunks
+ *
+ * Announcements and chunks are broadcast; requests are unicast to the
+ * parent. image_id is the first four bytes of the image SHA-256.
+ */
+
+#define MESH_OTA_CHUNK_SIZE 200U
+#define MESH_OTA_ROLE_ROUTER 0x01U
+#define MESH_OTA_ROLE_LEAF 0x02U
+
+typedef struct __attribute__((packed)) {
+    uint32_t image_id;
+    uint32_t image_size;
+    uint16_t chunk_count;
+    uint8_t target_roles;
+    uint8_t reserved;
+    uint8_t sha256[32];
+} mesh_ota_announce_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t image_id;
+    uint16_t chunk_index;
+} mesh_ota_chunk_info_t;
+
+typedef struct __attribute__((packed)) {
+    uint16_t first;
+    uint16_t count;
+} mesh_ota_range_t;
+
+#define MESH_OTA_ANNOUNCE_FRAME_SIZE (sizeof(mesh_packet_t) + sizeof(mesh_ota_announce_t))
+#define MESH_OTA_CHUNK_HEADER_SIZE (sizeof(mesh_packet_t) + sizeof(mesh_ota_chunk_info_t))
+#define MESH_OTA_REQUEST_HEADER_SIZE (sizeof(mesh_packet_t) + sizeof(uint32_t))
+#define MESH_OTA_MAX_RANGES \
+    ((MESH_MAX_PACKET_SIZE - MESH_OTA_REQUEST_HEADER_SIZE) / sizeof(mesh_ota_range_t))
+
 /**
  * @brief Calculates a CRC-16/CCITT-FALSE checksum.
  *
@@ -48,6 +149,15 @@ typedef struct __attribute__((packed)) {
  */
 uint16_t mesh_crc16_ccitt(const uint8_t *data, size_t length);
 
+/**
+ * @brief Finalizes a frame of any length by assigning its header CRC field.
+ *
+ * Args:
+ *     frame: Frame starting with a mesh_packet_t header.
+ *     length: Total frame length in bytes.
+ */
+void mesh_frame_finalize(uint8_t *frame, size_t length);
+
 /**
  * @brief Finalizes a packet by assigning its CRC field.
  *
@@ -56,6 +166,53 @@ uint16_t mesh_crc16_ccitt(const uint8_t *data, size_t length);
  */
 void mesh_packet_finalize(mesh_packet_t *packet);
 
+/**
+ * @brief Builds a delta-encoded sensor batch frame.
+ *
+ * Samples are encoded oldest first until the next one would not fit in
+ * the frame; the caller keeps the remainder for a later frame.
+ *
+ * Args:
+ *     header: Template for the header; its type and sensor fields are replaced.
+ *     samples: Buffered samples, oldest first.
+ *     count: Number of buffered samples.
+ *     now_s: Current time on the same clock as the sample timestamps.
+ *     frame: Destination buffer.
+ *     capacity: Size of the destination buffer.
+ *     encoded_count: Receives the number of samples placed in the frame.
+ *
+ * Returns:
+ *     Frame length in bytes, or 0 when the arguments do not fit.
+ */
+size_t mesh_batch_encode(const mesh_packet_t *header,
+                         const mesh_sample_t *samples,
+                         size_t count,
+                         uint32_t now_s,
+                         uint8_t *frame,
+                         size_t capacity,
+                         size_t *encoded_count);
+
+/**
+ * @brief Decodes the samples of a validated sensor batch frame.
+ *
+ * Args:
+ *     frame: Frame bytes.
+ *     length: Frame length in bytes.
+ *     now_s: Receiver time that decoded timestamps are expressed against.
+ *     samples: Destination array, oldest first.
+ *     capacity: Number of entries in the destination array.
+ *     count: Receives the number of decoded samples.
+ *
+ * Returns:
+ *     ESP_OK on success; ESP_ERR_INVALID_SIZE when the body is malformed.
+ */
+esp_err_t mesh_batch_decode(const uint8_t *frame,
+                            size_t length,
+                            uint32_t now_s,
+                            mesh_sample_t *samples,
+                            size_t capacity,
+                            size_t *count);
+
 /**
  * @brief Validates packet size, version, type, and CRC.
  *
@@ -0,0 +1,306 @@
+#include "mesh_route.h"
+
+#include <string.h>
+
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
+
+#if CONFIG_APP_DYNAMIC_ROUTING
+
+#define ROUTE_TABLE_SIZE CONFIG_APP_ROUTE_TABLE_SIZE
+#define ROUTE_NO_PARENT (-1)
+
+// Packet reception ratio in Q8 fixed point, smoothed with alpha = 1/8.
+#define PRR_ONE 256U
+#define PRR_INITIAL 192U
+#define PRR_MIN_USABLE 16U
+#define PRR_SHIFT 3U
+
+// Longer beacon gaps mean the node slept or the neighbor restarted; they
+// say nothing about the link and are not counted as losses.
+#define MAX_COUNTED_BEACON_GAP 16U
+
+typedef struct {
+    bool in_use;
+    uint8_t mac[6];
+    uint16_t node_id;
+    uint8_t advertised_hops;
+    int8_t rssi;
+    uint16_t advertised_cost;
+    uint16_t prr_q8;
+    uint16_t last_sequence;
+    uint32_t last_heard_s;
+} route_entry_t;
+
+// Kept in RTC memory so a leaf remembers its neighbors across deep sleep.
+RTC_DATA_ATTR static route_entry_t s_routes[ROUTE_TABLE_SIZE];
+RTC_DATA_ATTR static int32_t s_parent_index = ROUTE_NO_PARENT;
+
+// Beacons arrive from the receive task, delivery reports from the Wi-Fi task.
+static portMUX_TYPE s_route_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * @brief Folds one reception or loss into a link's reception ratio.
+ *
+ * Args:
+ *     entry: Neighbor entry to update.
+ *     received: True for a received or acknowledged frame.
+ */
+static void prr_update(route_entry_t *entry, bool received)
+{
+    if (received) {
+        entry->prr_q8 += (uint16_t)((PRR_ONE - entry->prr_q8) >> PRR_SHIFT);
+    } else {
+        entry->prr_q8 -= (uint16_t)(entry->prr_q8 >> PRR_SHIFT);
+    }
+}
+
+/**
+ * @brief Computes the path cost to the root through one neighbor.
+ *
+ * Args:
+ *     entry: Neighbor entry.
+ *
+ * Returns:
+ *     Advertised cost plus the link ETX in 1/16 units, saturated.
+ */
+static uint32_t route_path_cost(const route_entry_t *entry)
+{
+    if ((entry->advertised_cost == MESH_ROUTE_COST_INFINITE) ||
+        (entry->prr_q8 < PRR_MIN_USABLE)) {
+        return MESH_ROUTE_COST_INFINITE;
+    }
+
+    // ETX = 1 / (forward PRR * reverse PRR); links are assumed symmetric.
+    const uint32_t prr = entry->prr_q8;
+    const uint32_t link_cost =
+        (MESH_ROUTE_COST_PER_HOP * PRR_ONE * PRR_ONE) / (prr * prr);
+    const uint32_t cost = entry->advertised_cost + link_cost;
+
+    return (cost < MESH_ROUTE_COST_INFINITE) ? cost : MESH_ROUTE_COST_INFINITE;
+}
+
+/**
+ * @brief Checks whether a neighbor can currently serve as parent.
+ *
+ * Args:
+ *     entry: Neighbor entry.
+ *     now_s: Current time in seconds.
+ *
+ * Returns:
+ *     True when the entry is fresh, strong enough, and within the hop limit.
+ */
+static bool route_usable(const route_entry_t *entry, uint32_t now_s)
+{
+    return entry->in_use &&
+           ((now_s - entry->last_heard_s) <= CONFIG_APP_ROUTE_EXPIRY_SEC) &&
+           (entry->rssi >= CONFIG_APP_ROUTE_MIN_RSSI) &&
+           (entry->advertised_hops < CONFIG_APP_FORWARD_TTL) &&
+           (route_path_cost(entry) < MESH_ROUTE_COST_INFINITE);
+}
+
+/**
+ * @brief Finds the entry of a neighbor MAC address.
+ *
+ * Args:
+ *     mac: Neighbor MAC address.
+ *
+ * Returns:
+ *     Entry index, or ROUTE_NO_PARENT when the neighbor is unknown.
+ */
+static int32_t route_find(const uint8_t mac[6])
+{
+    for (int32_t i = 0; i < ROUTE_TABLE_SIZE; ++i) {
+        if (s_routes[i].in_use &&
+            (memcmp(s_routes[i].mac, mac, sizeof(s_routes[i].mac)) == 0)) {
+            return i;
+        }
+    }
+    return ROUTE_NO_PARENT;
+}
+
+/**
+ * @brief Picks a slot for a new neighbor.
+ *
+ * Prefers a free slot, then the stalest unusable entry, then the most
+ * expensive one. The current parent is never evicted.
+ *
+ * Args:
+ *     now_s: Current time in seconds.
+ *
+ * Returns:
+ *     Slot index, or ROUTE_NO_PARENT when only the parent remains.
+ */
+static int32_t route_allocate(uint32_t now_s)
+{
+    int32_t victim = ROUTE_NO_PARENT;
+    bool victim_usable = true;
+    uint32_t victim_score = 0U;
+
+    for (int32_t i = 0; i < ROUTE_TABLE_SIZE; ++i) {
+        const route_entry_t *entry = &s_routes[i];
+        if (!entry->in_use) {
+            return i;
+        }
+        if (i == s_parent_index) {
+            continue;
+        }
+
+        const bool usable = route_usable(entry, now_s);
+        const uint32_t score = usable ? route_path_cost(entry)
+                                      : (now_s - entry->last_heard_s);
+        if ((victim == ROUTE_NO_PARENT) ||
+            (victim_usable && !usable) ||
+            ((victim_usable == usable) && (score > victim_score))) {
+            victim = i;
+            victim_usable = usable;
+            victim_score = score;
+        }
+    }
+    return victim;
+}
+
+/**
+ * @brief Re-evaluates the parent with hysteresis.
+ *
+ * Args:
+ *     now_s: Current time in seconds.
+ *
+ * Returns:
+ *     True when the selected parent changed.
+ */
+static bool route_select(uint32_t now_s)
+{
+    int32_t best = ROUTE_NO_PARENT;
+    uint32_t best_cost = MESH_ROUTE_COST_INFINITE;
+
+    for (int32_t i = 0; i < ROUTE_TABLE_SIZE; ++i) {
+        const route_entry_t *entry = &s_routes[i];
+        if (!route_usable(entry, now_s)) {
+            continue;
+        }
+
+        // Ties go to fewer hops, then to the stronger signal.
+        const uint32_t cost = route_path_cost(entry);
+        if ((best == ROUTE_NO_PARENT) || (cost < best_cost) ||
+            ((cost == best_cost) &&
+             ((entry->advertised_hops < s_routes[best].advertised_hops) ||
+              ((entry->advertised_hops == s_routes[best].advertised_hops) &&
+               (entry->rssi > s_routes[best].rssi))))) {
+            best = i;
+            best_cost = cost;
+        }
+    }
+
+    const int32_t current = s_parent_index;
+    if ((current != ROUTE_NO_PARENT) && (best != current) &&
+        route_usable(&s_routes[current], now_s)) {
+        const uint32_t current_cost = route_path_cost(&s_routes[current]);
+        if ((best_cost + (current_cost >> 3)) >= current_cost) {
+            return false;
+        }
+    }
+
+    s_parent_index = best;
+    return best != current;
+}
+
+bool mesh_route_update_from_beacon(const uint8_t mac[6],
+                                   uint16_t neighbor_id,
+                                   uint16_t beacon_sequence,
+                                   const mesh_beacon_info_t *info,
+                                   int8_t rssi,
+                                   uint32_t now_s)
+{
+    if ((mac == NULL) || (info == NULL)) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&s_route_lock);
+
+    int32_t index = route_find(mac);
+    if (index == ROUTE_NO_PARENT) {
+        index = route_allocate(now_s);
+        if (index == ROUTE_NO_PARENT) {
+            portEXIT_CRITICAL(&s_route_lock);
+            return false;
+        }
+
+        route_entry_t *fresh = &s_routes[index];
+        memset(fresh, 0, sizeof(*fresh));
+        fresh->in_use = true;
+        memcpy(fresh->mac, mac, sizeof(fresh->mac));
+        fresh->prr_q8 = PRR_INITIAL;
+    } else {
+        route_entry_t *known = &s_routes[index];
+        const uint16_t gap = (uint16_t)(beacon_sequence - known->last_sequence);
+        if (gap == 0U) {
+            // Same beacon heard twice; nothing new about the link.
+            portEXIT_CRITICAL(&s_route_lock);
+            return false;
+        }
+        if (gap <= MAX_COUNTED_BEACON_GAP) {
+            for (uint16_t missed = 1U; missed < gap; ++missed) {
+                prr_update(known, false);
+            }
+        }
+        prr_update(known, true);
+    }
+
+    route_entry_t *entry = &s_routes[index];
+    entry->node_id = neighbor_id;
+    entry->last_sequence = beacon_sequence;
+    entry->last_heard_s = now_s;
+    entry->rssi = rssi;
+    entry->advertised_hops = info->hop_count;
+
+    // A neighbor whose route runs through this node would form a loop.
+    entry->advertised_cost = (info->parent_id == CONFIG_APP_NODE_ID)
+                                 ? MESH_ROUTE_COST_INFINITE
+                                 : info->path_cost;
+
+    const bool changed = route_select(now_s);
+    portEXIT_CRITICAL(&s_route_lock);
+    return changed;
+}
+
+void mesh_route_report_delivery(const uint8_t mac[6], bool delivered)
+{
+    if (mac == NULL) {
+        return;
+    }
+
+    portENTER_CRITICAL(&s_route_lock);
+    const int32_t index = route_find(mac);
+    if (index != ROUTE_NO_PARENT) {
+        prr_update(&s_routes[index], delivered);
+    }
+    portEXIT_CRITICAL(&s_route_lock);
+}
+
+bool mesh_route_get_parent(uint32_t now_s, mesh_route_t *route)
+{
+    if (route == NULL) {
+        return false;
+    }
+
+    portENTER_CRITICAL(&s_route_lock);
+    route_select(now_s);
+
+    const int32_t index = s_parent_index;
+    const bool found = (index != ROUTE_NO_PARENT);
+    if (found) {
+        const route_entry_t *entry = &s_routes[index];
+        memcpy(route->next_hop_mac, entry->mac, sizeof(route->next_hop_mac));
+        route->next_hop_id = entry->node_id;
+        route->hop_count = (uint8_t)(entry->advertised_hops + 1U);
+        route->rssi = entry->rssi;
+        route->path_cost = (uint16_t)route_path_cost(entry);
+    }
+    portEXIT_CRITICAL(&s_route_lock);
+
+    return found;
+}
+
+#endif
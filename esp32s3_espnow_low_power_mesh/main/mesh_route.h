@@ -0,0 +1,84 @@
+#ifndef MESH_ROUTE_H
+#define MESH_ROUTE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mesh_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Path cost of a perfect link, in 1/16 ETX units. */
+#define MESH_ROUTE_COST_PER_HOP 16U
+/** Cost that marks a route as unusable. */
+#define MESH_ROUTE_COST_INFINITE 0xFFFFU
+
+typedef struct {
+    uint8_t next_hop_mac[6];
+    uint16_t next_hop_id;
+    uint8_t hop_count;
+    int8_t rssi;
+    uint16_t path_cost;
+} mesh_route_t;
+
+/**
+ * @brief Learns or refreshes a route towards the root from a neighbor beacon.
+ *
+ * Each neighbor keeps an exponentially weighted packet reception ratio fed
+ * by beacon sequence gaps and unicast delivery reports. Its link cost is
+ * the ETX estimate 1 / PRR^2, and its path cost is that plus the cost the
+ * neighbor advertises. Beacons weaker than CONFIG_APP_ROUTE_MIN_RSSI, or
+ * advertising a route through this node, are ignored.
+ *
+ * Args:
+ *     mac: Neighbor MAC address.
+ *     neighbor_id: Logical node ID of the neighbor.
+ *     beacon_sequence: Sequence number of the beacon.
+ *     info: Route advertised in the beacon.
+ *     rssi: Received signal strength of the beacon in dBm.
+ *     now_s: Current time in seconds; must keep counting through deep sleep.
+ *
+ * Returns:
+ *     True when the selected parent changed.
+ */
+bool mesh_route_update_from_beacon(const uint8_t mac[6],
+                                   uint16_t neighbor_id,
+                                   uint16_t beacon_sequence,
+                                   const mesh_beacon_info_t *info,
+                                   int8_t rssi,
+                                   uint32_t now_s);
+
+/**
+ * @brief Feeds the link-layer result of a unicast send into the link estimate.
+ *
+ * Safe to call from the ESP-NOW send callback.
+ *
+ * Args:
+ *     mac: Destination MAC address.
+ *     delivered: True when the peer acknowledged the frame.
+ */
+void mesh_route_report_delivery(const uint8_t mac[6], bool delivered);
+
+/**
+ * @brief Returns the selected parent towards the root.
+ *
+ * The parent only changes when another neighbor is cheaper by more than
+ * 1/8 of the current path cost, or when the current one expires after
+ * CONFIG_APP_ROUTE_EXPIRY_SEC without a beacon.
+ *
+ * Args:
+ *     now_s: Current time in seconds.
+ *     route: Receives the selected route.
+ *
+ * Returns:
+ *     True when a usable route exists; otherwise false.
+ */
+bool mesh_route_get_parent(uint32_t now_s, mesh_route_t *route);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
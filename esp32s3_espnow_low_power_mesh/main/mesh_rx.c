@@ -0,0 +1,92 @@
+#include "mesh_rx.h"
+
+#include <string.h>
+
+#include "freertos/queue.h"
+#include "sdkconfig.h"
+
+#define RX_POOL_SIZE CONFIG_APP_RX_POOL_SIZE
+
+_Static_assert(RX_POOL_SIZE <= UINT8_MAX, "pool indices are passed as bytes");
+
+// Frames stay in this pool from the receive callback until they are
+// released; only one-byte slot indices travel through the queues.
+static mesh_rx_frame_t s_pool[RX_POOL_SIZE];
+static QueueHandle_t s_free_slots;
+static QueueHandle_t s_ready_slots;
+
+// Written only by the Wi-Fi task; 32-bit reads elsewhere are atomic.
+static mesh_rx_stats_t s_stats;
+
+esp_err_t mesh_rx_init(void)
+{
+    s_free_slots = xQueueCreate(RX_POOL_SIZE, sizeof(uint8_t));
+    s_ready_slots = xQueueCreate(RX_POOL_SIZE, sizeof(uint8_t));
+    if ((s_free_slots == NULL) || (s_ready_slots == NULL)) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    for (uint8_t i = 0U; i < RX_POOL_SIZE; ++i) {
+        xQueueSend(s_free_slots, &i, 0);
+    }
+    return ESP_OK;
+}
+
+bool mesh_rx_submit(const uint8_t source_mac[6], int8_t rssi,
+                    const uint8_t *data, int length)
+{
+    if ((length < (int)sizeof(mesh_packet_t)) ||
+        (length > (int)MESH_MAX_PACKET_SIZE) ||
+        (mesh_packet_validate(data, (size_t)length) != ESP_OK)) {
+        s_stats.dropped_invalid++;
+        return false;
+    }
+
+    uint8_t slot;
+    if (xQueueReceive(s_free_slots, &slot, 0) != pdTRUE) {
+        s_stats.dropped_pool_empty++;
+        return false;
+    }
+
+    mesh_rx_frame_t *frame = &s_pool[slot];
+    memcpy(frame->source_mac, source_mac, sizeof(frame->source_mac));
+    frame->rssi = rssi;
+    frame->length = (uint8_t)length;
+    memcpy(frame->frame, data, (size_t)length);
+
+    const uint32_t in_use = RX_POOL_SIZE - uxQueueMessagesWaiting(s_free_slots);
+    if (in_use > s_stats.in_use_high_water) {
+        s_stats.in_use_high_water = in_use;
+    }
+
+    // Cannot fail: both queues hold every slot index.
+    xQueueSend(s_ready_slots, &slot, 0);
+    s_stats.received++;
+    return true;
+}
+
+mesh_rx_frame_t *mesh_rx_take(TickType_t timeout)
+{
+    uint8_t slot;
+    if (xQueueReceive(s_ready_slots, &slot, timeout) != pdTRUE) {
+        return NULL;
+    }
+    return &s_pool[slot];
+}
+
+void mesh_rx_release(mesh_rx_frame_t *frame)
+{
+    if (frame == NULL) {
+        return;
+    }
+
+    const uint8_t slot = (uint8_t)(frame - s_pool);
+    xQueueSend(s_free_slots, &slot, 0);
+}
+
+void mesh_rx_get_stats(mesh_rx_stats_t *stats)
+{
+    if (stats != NULL) {
+        *stats = s_stats;
+    }
+}
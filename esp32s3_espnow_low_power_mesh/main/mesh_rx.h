@@ -0,0 +1,89 @@
+#ifndef MESH_RX_H
+#define MESH_RX_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "mesh_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    uint8_t source_mac[6];
+    uint8_t length;
+    int8_t rssi;
+    union {
+        mesh_packet_t packet;
+        uint8_t frame[MESH_MAX_PACKET_SIZE];
+    };
+} mesh_rx_frame_t;
+
+typedef struct {
+    uint32_t received;
+    uint32_t dropped_invalid;
+    uint32_t dropped_pool_empty;
+    uint32_t in_use_high_water;
+} mesh_rx_stats_t;
+
+/**
+ * @brief Allocates the frame pool and its free and ready index queues.
+ *
+ * Returns:
+ *     ESP_OK on success; ESP_ERR_NO_MEM when the queues cannot be created.
+ */
+esp_err_t mesh_rx_init(void);
+
+/**
+ * @brief Validates a received frame and copies it once into a pool slot.
+ *
+ * Called from the ESP-NOW receive callback. Never blocks: when no slot is
+ * free the frame is counted as dropped.
+ *
+ * Args:
+ *     source_mac: Sender MAC address.
+ *     rssi: Received signal strength in dBm.
+ *     data: Received frame bytes.
+ *     length: Number of received bytes.
+ *
+ * Returns:
+ *     True when the frame was queued for processing.
+ */
+bool mesh_rx_submit(const uint8_t source_mac[6], int8_t rssi,
+                    const uint8_t *data, int length);
+
+/**
+ * @brief Takes the next ready frame for in-place processing.
+ *
+ * Args:
+ *     timeout: Ticks to wait for a frame.
+ *
+ * Returns:
+ *     Frame owned by the caller until mesh_rx_release(), or NULL on timeout.
+ */
+mesh_rx_frame_t *mesh_rx_take(TickType_t timeout);
+
+/**
+ * @brief Returns a processed frame to the pool.
+ *
+ * Args:
+ *     frame: Frame obtained from mesh_rx_take().
+ */
+void mesh_rx_release(mesh_rx_frame_t *frame);
+
+/**
+ * @brief Copies the receive counters.
+ *
+ * Args:
+ *     stats: Receives the counters.
+ */
+void mesh_rx_get_stats(mesh_rx_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
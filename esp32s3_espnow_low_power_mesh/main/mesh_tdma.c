@@ -0,0 +1,229 @@
+#include "mesh_tdma.h"
+
+#include <stdlib.h>
+
+#include "esp_attr.h"
+#include "sdkconfig.h"
+
+#if CONFIG_APP_TDMA
+
+// Shorter spans between syncs are dominated by beacon latency jitter.
+#define MIN_DRIFT_SPAN_MS 5000U
+// Larger errors than 5 % are measurement faults, not clock drift.
+#define MAX_DRIFT_PPM 50000
+// Guard margin until the first drift measurement; covers an uncalibrated
+// RC slow clock.
+#define UNCALIBRATED_MARGIN_PPM 20000U
+#define PPM_SCALE 1000000LL
+
+typedef struct {
+    bool synced;
+    bool drift_valid;
+    uint8_t missed;
+    uint16_t slot_ms;
+    uint16_t slot_count;
+    int32_t drift_ppm;          // Positive when the local RTC runs fast.
+    uint64_t sync_local_us;
+    uint32_t sync_network_ms;
+    uint32_t sync_cycle_pos_ms; // Position in the cycle at the last sync.
+} tdma_state_t;
+
+// Kept in RTC memory so the schedule and drift survive deep sleep.
+RTC_DATA_ATTR static tdma_state_t s_tdma;
+
+/**
+ * @brief Returns the cycle length of the current schedule.
+ */
+static uint32_t cycle_ms(void)
+{
+    return (uint32_t)s_tdma.slot_ms * s_tdma.slot_count;
+}
+
+/**
+ * @brief Converts local RTC time since the last sync into root milliseconds.
+ *
+ * Args:
+ *     local_us: Current local RTC time in microseconds.
+ *
+ * Returns:
+ *     Elapsed root time in milliseconds.
+ */
+static uint64_t network_elapsed_ms(uint64_t local_us)
+{
+    if (local_us <= s_tdma.sync_local_us) {
+        return 0U;
+    }
+
+    const int64_t local_elapsed_us = (int64_t)(local_us - s_tdma.sync_local_us);
+    return (uint64_t)((local_elapsed_us * PPM_SCALE) /
+                      (PPM_SCALE + s_tdma.drift_ppm) / 1000LL);
+}
+
+/**
+ * @brief Converts a root-time interval into local RTC microseconds.
+ *
+ * Args:
+ *     network_ms: Interval on the root clock in milliseconds.
+ *
+ * Returns:
+ *     The same interval on the local clock in microseconds.
+ */
+static uint64_t local_interval_us(uint64_t network_ms)
+{
+    return (uint64_t)(((int64_t)network_ms * 1000LL *
+                       (PPM_SCALE + s_tdma.drift_ppm)) / PPM_SCALE);
+}
+
+/**
+ * @brief Returns the timing guard for a given time since the last sync.
+ *
+ * Args:
+ *     span_ms: Root time since the last sync in milliseconds.
+ *
+ * Returns:
+ *     Guard time in milliseconds.
+ */
+static uint32_t guard_ms(uint64_t span_ms)
+{
+    const uint64_t margin_ppm = s_tdma.drift_valid
+                                    ? CONFIG_APP_TDMA_DRIFT_MARGIN_PPM
+                                    : UNCALIBRATED_MARGIN_PPM;
+    return CONFIG_APP_TDMA_GUARD_MS +
+           (uint32_t)((span_ms * margin_ppm) / 1000000ULL);
+}
+
+void mesh_tdma_fill_root_beacon(mesh_beacon_info_t *info, uint64_t root_time_ms)
+{
+    uint32_t slots = (CONFIG_APP_WAKE_INTERVAL_SEC * 1000U) /
+                     CONFIG_APP_BEACON_INTERVAL_MS;
+    if (slots == 0U) {
+        slots = 1U;
+    } else if (slots > UINT16_MAX) {
+        slots = UINT16_MAX;
+    }
+
+    const uint32_t cycle = slots * CONFIG_APP_BEACON_INTERVAL_MS;
+    const uint32_t position = (uint32_t)(root_time_ms % cycle);
+
+    info->flags |= MESH_BEACON_FLAG_TDMA;
+    info->network_time_ms = (uint32_t)root_time_ms;
+    info->slot_ms = CONFIG_APP_BEACON_INTERVAL_MS;
+    info->slot_count = (uint16_t)slots;
+    info->slot_index = (uint16_t)(position / CONFIG_APP_BEACON_INTERVAL_MS);
+    info->slot_offset_ms = (uint16_t)(position % CONFIG_APP_BEACON_INTERVAL_MS);
+}
+
+uint32_t mesh_tdma_ms_until_next_slot(uint64_t root_time_ms)
+{
+    return CONFIG_APP_BEACON_INTERVAL_MS -
+           (uint32_t)(root_time_ms % CONFIG_APP_BEACON_INTERVAL_MS);
+}
+
+void mesh_tdma_on_beacon(const mesh_beacon_info_t *info, uint64_t local_us)
+{
+    if ((info == NULL) || ((info->flags & MESH_BEACON_FLAG_TDMA) == 0U) ||
+        (info->slot_ms == 0U) || (info->slot_count == 0U) ||
+        (info->slot_index >= info->slot_count)) {
+        return;
+    }
+
+    const bool same_layout = s_tdma.synced &&
+                             (s_tdma.slot_ms == info->slot_ms) &&
+                             (s_tdma.slot_count == info->slot_count);
+
+    if (same_layout) {
+        // Compare local and root elapsed time to measure RTC drift.
+        const uint32_t network_ms = info->network_time_ms - s_tdma.sync_network_ms;
+        if ((network_ms >= MIN_DRIFT_SPAN_MS) && (local_us > s_tdma.sync_local_us)) {
+            const int64_t local_elapsed_us = (int64_t)(local_us - s_tdma.sync_local_us);
+            const int64_t network_elapsed_us = (int64_t)network_ms * 1000LL;
+            const int64_t observed_ppm =
+                ((local_elapsed_us - network_elapsed_us) * PPM_SCALE) /
+                network_elapsed_us;
+
+            if (llabs(observed_ppm) <= MAX_DRIFT_PPM) {
+                s_tdma.drift_ppm = s_tdma.drift_valid
+                    ? s_tdma.drift_ppm + (int32_t)((observed_ppm - s_tdma.drift_ppm) / 4)
+                    : (int32_t)observed_ppm;
+                s_tdma.drift_valid = true;
+            }
+        } else if (network_ms < MIN_DRIFT_SPAN_MS) {
+            // Keep the older reference so the next drift span stays long.
+            s_tdma.missed = 0U;
+            return;
+        }
+    }
+
+    s_tdma.slot_ms = info->slot_ms;
+    s_tdma.slot_count = info->slot_count;
+    s_tdma.sync_local_us = local_us;
+    s_tdma.sync_network_ms = info->network_time_ms;
+    s_tdma.sync_cycle_pos_ms = (uint32_t)info->slot_index * info->slot_ms +
+                               info->slot_offset_ms;
+    s_tdma.synced = true;
+    s_tdma.missed = 0U;
+}
+
+void mesh_tdma_on_missed_beacon(void)
+{
+    if (s_tdma.synced && (++s_tdma.missed >= CONFIG_APP_TDMA_MAX_MISSED)) {
+        s_tdma.synced = false;
+        s_tdma.missed = 0U;
+    }
+}
+
+bool mesh_tdma_is_synced(void)
+{
+    return s_tdma.synced;
+}
+
+uint16_t mesh_tdma_slot_for(uint16_t node_id)
+{
+    return s_tdma.synced ? (uint16_t)(node_id % s_tdma.slot_count) : 0U;
+}
+
+uint32_t mesh_tdma_listen_window_ms(uint16_t node_id, uint64_t local_us)
+{
+    if (!s_tdma.synced) {
+        return 0U;
+    }
+
+    const uint32_t cycle = cycle_ms();
+    const uint64_t elapsed = network_elapsed_ms(local_us);
+    const uint32_t position = (uint32_t)((s_tdma.sync_cycle_pos_ms + elapsed) % cycle);
+    const uint32_t slot_start = (uint32_t)mesh_tdma_slot_for(node_id) * s_tdma.slot_ms;
+
+    // Signed distance to our slot start, folded into half a cycle.
+    int32_t until_slot = (int32_t)((slot_start + cycle - position) % cycle);
+    if (until_slot > (int32_t)(cycle / 2U)) {
+        until_slot -= (int32_t)cycle;
+    }
+
+    const int32_t window = until_slot + (int32_t)guard_ms(elapsed);
+    return (window > 0) ? (uint32_t)window : 0U;
+}
+
+uint64_t mesh_tdma_sleep_us(uint16_t node_id, uint64_t local_us)
+{
+    if (!s_tdma.synced) {
+        return 0U;
+    }
+
+    const uint32_t cycle = cycle_ms();
+    const uint64_t elapsed = network_elapsed_ms(local_us);
+    const uint32_t position = (uint32_t)((s_tdma.sync_cycle_pos_ms + elapsed) % cycle);
+    const uint32_t slot_start = (uint32_t)mesh_tdma_slot_for(node_id) * s_tdma.slot_ms;
+
+    uint64_t until_slot = (slot_start + cycle - position) % cycle;
+    while (true) {
+        const uint64_t lead = CONFIG_APP_TDMA_WAKE_LEAD_MS +
+                              guard_ms(elapsed + until_slot);
+        if (until_slot > lead) {
+            return local_interval_us(until_slot - lead);
+        }
+        // Too close to this cycle's slot; aim for the next cycle.
+        until_slot += cycle;
+    }
+}
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef MESH_TDMA_H
+#define MESH_TDMA_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "mesh_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Fills the TDMA fields of a root beacon.
+ *
+ * The cycle lasts APP_WAKE_INTERVAL_SEC and is split into slots of
+ * APP_BEACON_INTERVAL_MS, so every root beacon opens one slot.
+ *
+ * Args:
+ *     info: Beacon info to complete.
+ *     root_time_ms: Root clock in milliseconds when the beacon is sent.
+ */
+void mesh_tdma_fill_root_beacon(mesh_beacon_info_t *info, uint64_t root_time_ms);
+
+/**
+ * @brief Returns how long the root should wait until the next slot boundary.
+ *
+ * Args:
+ *     root_time_ms: Current root clock in milliseconds.
+ *
+ * Returns:
+ *     Milliseconds until the next slot starts.
+ */
+uint32_t mesh_tdma_ms_until_next_slot(uint64_t root_time_ms);
+
+/**
+ * @brief Synchronizes the leaf schedule to a received TDMA beacon.
+ *
+ * The first beacon sets the time base. Later beacons also measure the
+ * local RTC clock error against the root clock and fold it into a
+ * drift estimate kept in RTC memory, so long sleeps stay on schedule.
+ *
+ * Args:
+ *     info: Beacon info carrying the time base.
+ *     local_us: Local RTC time in microseconds when the beacon arrived.
+ */
+void mesh_tdma_on_beacon(const mesh_beacon_info_t *info, uint64_t local_us);
+
+/**
+ * @brief Records a wake cycle in which the expected beacon never arrived.
+ *
+ * After APP_TDMA_MAX_MISSED consecutive misses the leaf drops its schedule
+ * and falls back to the free-running wake interval.
+ */
+void mesh_tdma_on_missed_beacon(void);
+
+/**
+ * @brief Reports whether the leaf currently follows a TDMA schedule.
+ *
+ * Returns:
+ *     True when synchronized.
+ */
+bool mesh_tdma_is_synced(void);
+
+/**
+ * @brief Returns this node's slot in the current schedule.
+ *
+ * Args:
+ *     node_id: Logical node ID; the slot is node_id modulo the slot count.
+ *
+ * Returns:
+ *     Slot index, or 0 when not synchronized.
+ */
+uint16_t mesh_tdma_slot_for(uint16_t node_id);
+
+/**
+ * @brief Returns how long to listen for the beacon that opens our slot.
+ *
+ * Args:
+ *     node_id: Logical node ID.
+ *     local_us: Current local RTC time in microseconds.
+ *
+ * Returns:
+ *     Listen window in milliseconds, or 0 when not synchronized.
+ */
+uint32_t mesh_tdma_listen_window_ms(uint16_t node_id, uint64_t local_us);
+
+/**
+ * @brief Computes the deep-sleep time that wakes the leaf just before its slot.
+ *
+ * The wake time leads the slot by APP_TDMA_WAKE_LEAD_MS for boot and radio
+ * start-up, plus a guard that grows with the time since the last sync.
+ *
+ * Args:
+ *     node_id: Logical node ID.
+ *     local_us: Current local RTC time in microseconds.
+ *
+ * Returns:
+ *     Sleep time in microseconds, or 0 when not synchronized.
+ */
+uint64_t mesh_tdma_sleep_us(uint16_t node_id, uint64_t local_us);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
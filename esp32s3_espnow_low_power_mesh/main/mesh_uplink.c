@@ -0,0 +1,331 @@
+#include "mesh_uplink.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/task.h"
+#include "sdkconfig.h"
+
+#if CONFIG_APP_UPLINK
+
+#if CONFIG_APP_UPLINK_MQTT
+#include "esp_event.h"
+#include "esp_wifi.h"
+#include "mqtt_client.h"
+#endif
+
+#define UPLINK_BATCH_READINGS CONFIG_APP_UPLINK_BATCH_READINGS
+#define UPLINK_QUEUE_READINGS CONFIG_APP_UPLINK_QUEUE_READINGS
+#define UPLINK_RETRY_MS 1000U
+
+// Worst-case JSON text of one reading plus the document envelope.
+#define UPLINK_READING_JSON_MAX 96U
+#define UPLINK_ENVELOPE_JSON_MAX 64U
+#define UPLINK_DOCUMENT_SIZE \
+    (UPLINK_ENVELOPE_JSON_MAX + (UPLINK_BATCH_READINGS * UPLINK_READING_JSON_MAX))
+
+_Static_assert(UPLINK_QUEUE_READINGS >= MESH_BATCH_MAX_SAMPLES,
+               "the uplink queue must hold one full sensor batch");
+
+typedef struct {
+    uint16_t source_id;
+    uint16_t sequence;
+    mesh_sample_t sample;
+} uplink_reading_t;
+
+static const char *TAG = "mesh_uplink";
+
+static QueueHandle_t s_queue;
+
+// Only touched by the uplink task.
+static uplink_reading_t s_batch[UPLINK_BATCH_READINGS];
+static char s_document[UPLINK_DOCUMENT_SIZE];
+
+#if CONFIG_APP_UPLINK_MQTT
+static esp_mqtt_client_handle_t s_mqtt;
+static volatile bool s_mqtt_connected;
+
+/**
+ * @brief Rejoins the access point after a disconnect.
+ */
+static void wifi_event_handler(void *context,
+                               esp_event_base_t base,
+                               int32_t event_id,
+                               void *event_data)
+{
+    (void)context;
+    (void)base;
+    (void)event_id;
+    (void)event_data;
+
+    ESP_LOGW(TAG, "Uplink access point lost; reconnecting");
+    esp_wifi_connect();
+}
+
+/**
+ * @brief Tracks the broker connection state.
+ */
+static void mqtt_event_handler(void *context,
+                               esp_event_base_t base,
+                               int32_t event_id,
+                               void *event_data)
+{
+    (void)context;
+    (void)base;
+    (void)event_data;
+
+    if (event_id == MQTT_EVENT_CONNECTED) {
+        s_mqtt_connected = true;
+        ESP_LOGI(TAG, "Connected to %s", CONFIG_APP_UPLINK_MQTT_URI);
+    } else if (event_id == MQTT_EVENT_DISCONNECTED) {
+        s_mqtt_connected = false;
+        ESP_LOGW(TAG, "Broker disconnected");
+    }
+}
+
+/**
+ * @brief Joins the uplink access point and starts the MQTT client.
+ *
+ * Returns:
+ *     ESP_OK on success or a Wi-Fi or MQTT error code.
+ */
+static esp_err_t transport_start(void)
+{
+    wifi_config_t wifi = {0};
+    strlcpy((char *)wifi.sta.ssid, CONFIG_APP_UPLINK_WIFI_SSID,
+            sizeof(wifi.sta.ssid));
+    strlcpy((char *)wifi.sta.password, CONFIG_APP_UPLINK_WIFI_PASSWORD,
+            sizeof(wifi.sta.password));
+
+    esp_err_t err = esp_wifi_set_config(WIFI_IF_STA, &wifi);
+    if (err == ESP_OK) {
+        err = esp_event_handler_register(WIFI_EVENT,
+                                         WIFI_EVENT_STA_DISCONNECTED,
+                                         wifi_event_handler,
+                                         NULL);
+    }
+    if (err == ESP_OK) {
+        err = esp_wifi_connect();
+    }
+    if (err != ESP_OK) {
+        return err;
+    }
+
+    const esp_mqtt_client_config_t config = {
+        .broker.address.uri = CONFIG_APP_UPLINK_MQTT_URI,
+    };
+    s_mqtt = esp_mqtt_client_init(&config);
+    if (s_mqtt == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    err = esp_mqtt_client_register_event(s_mqtt, ESP_EVENT_ANY_ID,
+                                         mqtt_event_handler, NULL);
+    if (err != ESP_OK) {
+        return err;
+    }
+    return esp_mqtt_client_start(s_mqtt);
+}
+
+/**
+ * @brief Publishes one document to the configured topic.
+ *
+ * Returns:
+ *     True when the client accepted the document.
+ */
+static bool transport_publish(const char *document, size_t length)
+{
+    if (!s_mqtt_connected) {
+        return false;
+    }
+
+    // QoS 1: the client keeps the document in its outbox until acknowledged.
+    return esp_mqtt_client_publish(s_mqtt, CONFIG_APP_UPLINK_MQTT_TOPIC,
+                                   document, (int)length, 1, 0) >= 0;
+}
+#else
+static esp_err_t transport_start(void)
+{
+    return ESP_OK;
+}
+
+/**
+ * @brief Writes one document as a prefixed line on the console.
+ *
+ * Returns:
+ *     Always true.
+ */
+static bool transport_publish(const char *document, size_t length)
+{
+    printf("UPLINK %.*s\n", (int)length, document);
+    fflush(stdout);
+    return true;
+}
+#endif
+
+/**
+ * @brief Serializes a batch of readings as one compact JSON document.
+ *
+ * Readings carry fixed-point values in their wire units; "t" is the root
+ * uptime in seconds at which the reading was taken, "now" the root uptime
+ * when the document was built.
+ *
+ * Args:
+ *     readings: Readings to encode.
+ *     count: Number of readings.
+ *
+ * Returns:
+ *     Document length in bytes, or 0 when it did not fit.
+ */
+static size_t encode_document(const uplink_reading_t *readings, size_t count)
+{
+    const uint32_t now_s = (uint32_t)(esp_timer_get_time() / 1000000LL);
+    size_t used = 0U;
+    int written = snprintf(s_document, sizeof(s_document),
+                           "{\"root\":%d,\"now\":%lu,\"readings\":[",
+                           CONFIG_APP_NODE_ID, (unsigned long)now_s);
+
+    for (size_t i = 0U; (written > 0) && (i < count); ++i) {
+        used += (size_t)written;
+        if (used >= sizeof(s_document)) {
+            return 0U;
+        }
+
+        const uplink_reading_t *reading = &readings[i];
+        written = snprintf(s_document + used, sizeof(s_document) - used,
+                           "%s{\"src\":%u,\"seq\":%u,\"t\":%lu,"
+                           "\"temp\":%d,\"hum\":%u,\"bat\":%u}",
+                           (i == 0U) ? "" : ",",
+                           reading->source_id,
+                           reading->sequence,
+                           (unsigned long)reading->sample.time_s,
+                           reading->sample.temperature_centi_c,
+                           reading->sample.humidity_centi_pct,
+                           reading->sample.battery_mv);
+    }
+    if (written <= 0) {
+        return 0U;
+    }
+    used += (size_t)written;
+
+    if (used + 2U >= sizeof(s_document)) {
+        return 0U;
+    }
+    s_document[used++] = ']';
+    s_document[used++] = '}';
+    s_document[used] = '\0';
+    return used;
+}
+
+/**
+ * @brief Collects readings and publishes them by size or age threshold.
+ *
+ * A document goes out when APP_UPLINK_BATCH_READINGS readings are buffered
+ * or the oldest has waited APP_UPLINK_FLUSH_MS. While publishing fails the
+ * batch is kept and the queue is left to fill, which pushes back on the
+ * receive path.
+ *
+ * Args:
+ *     context: Unused task argument.
+ */
+static void uplink_task(void *context)
+{
+    (void)context;
+    size_t count = 0U;
+    TickType_t deadline = 0U;
+
+    while (true) {
+        TickType_t wait = portMAX_DELAY;
+        if (count > 0U) {
+            const TickType_t remaining = deadline - xTaskGetTickCount();
+            wait = ((int32_t)remaining > 0) ? remaining : 0U;
+        }
+
+        if ((count < UPLINK_BATCH_READINGS) &&
+            (xQueueReceive(s_queue, &s_batch[count], wait) == pdTRUE)) {
+            if (count == 0U) {
+                deadline = xTaskGetTickCount() +
+                           pdMS_TO_TICKS(CONFIG_APP_UPLINK_FLUSH_MS);
+            }
+            if (++count < UPLINK_BATCH_READINGS) {
+                continue;
+            }
+        }
+        if (count == 0U) {
+            continue;
+        }
+
+        const size_t length = encode_document(s_batch, count);
+        if (length == 0U) {
+            ESP_LOGE(TAG, "Document overflow; %u readings dropped",
+                     (unsigned)count);
+            count = 0U;
+            continue;
+        }
+
+        if (!transport_publish(s_document, length)) {
+            ESP_LOGW(TAG, "Publish failed; holding %u readings, %u queued",
+                     (unsigned)count,
+                     (unsigned)uxQueueMessagesWaiting(s_queue));
+            vTaskDelay(pdMS_TO_TICKS(UPLINK_RETRY_MS));
+            continue;
+        }
+
+        ESP_LOGD(TAG, "Published %u readings in %u bytes",
+                 (unsigned)count, (unsigned)length);
+        count = 0U;
+    }
+}
+
+esp_err_t mesh_uplink_start(void)
+{
+    s_queue = xQueueCreate(UPLINK_QUEUE_READINGS, sizeof(uplink_reading_t));
+    if (s_queue == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    const esp_err_t err = transport_start();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Uplink transport failed to start: %s",
+                 esp_err_to_name(err));
+        return err;
+    }
+
+    if (xTaskCreate(uplink_task, "mesh_uplink", 4096, NULL, 4, NULL) != pdPASS) {
+        return ESP_ERR_NO_MEM;
+    }
+    return ESP_OK;
+}
+
+bool mesh_uplink_has_room(size_t readings)
+{
+    return (s_queue != NULL) && (uxQueueSpacesAvailable(s_queue) >= readings);
+}
+
+esp_err_t mesh_uplink_submit(uint16_t source_id,
+                             uint16_t sequence,
+                             const mesh_sample_t *samples,
+                             size_t count)
+{
+    if ((s_queue == NULL) || ((samples == NULL) && (count > 0U))) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t i = 0U; i < count; ++i) {
+        const uplink_reading_t reading = {
+            .source_id = source_id,
+            .sequence = sequence,
+            .sample = samples[i],
+        };
+        if (xQueueSend(s_queue, &reading, 0) != pdTRUE) {
+            return ESP_ERR_TIMEOUT;
+        }
+    }
+    return ESP_OK;
+}
+
+#endif
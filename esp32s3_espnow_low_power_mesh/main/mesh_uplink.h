@@ -0,0 +1,64 @@
+#ifndef MESH_UPLINK_H
+#define MESH_UPLINK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "mesh_protocol.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Creates the uplink queue and task and starts the configured transport.
+ *
+ * With the MQTT transport this also joins the configured access point and
+ * connects to the broker; publishing starts once the broker accepts us.
+ *
+ * Returns:
+ *     ESP_OK on success or an allocation or transport error code.
+ */
+esp_err_t mesh_uplink_start(void);
+
+/**
+ * @brief Reports whether the uplink queue can take more readings.
+ *
+ * The root withholds its ACK when this fails, so the sender keeps its
+ * readings and retries instead of them being dropped at the root.
+ *
+ * Args:
+ *     readings: Number of readings about to be submitted.
+ *
+ * Returns:
+ *     True when that many readings fit without blocking.
+ */
+bool mesh_uplink_has_room(size_t readings);
+
+/**
+ * @brief Queues decoded readings of one packet for the next uplink document.
+ *
+ * Must only be called from the receive task, which is the sole producer.
+ *
+ * Args:
+ *     source_id: Originating node ID.
+ *     sequence: Packet sequence number.
+ *     samples: Decoded readings with times on the root clock in seconds.
+ *     count: Number of readings.
+ *
+ * Returns:
+ *     ESP_OK when every reading was queued; ESP_ERR_TIMEOUT when the queue
+ *     filled up part way.
+ */
+esp_err_t mesh_uplink_submit(uint16_t source_id,
+                             uint16_t sequence,
+                             const mesh_sample_t *samples,
+                             size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
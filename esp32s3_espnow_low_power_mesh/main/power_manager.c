@@ -5,31 +5,35 @@
 #include "esp_log.h"
 #include "esp_sleep.h"
 
+#include "energy_profiler.h"
+
 static const char *TAG = "power";
 
 /**
  * @brief Configures a timer wake source and enters deep sleep.
  *
  * Args:
- *     sleep_seconds: Requested sleep interval in seconds.
+ *     sleep_us: Requested sleep interval in microseconds.
  *
  * Returns:
  *     ESP_OK before deep sleep starts, or an error code when configuration fails.
  */
-esp_err_t power_manager_enter_deep_sleep(uint32_t sleep_seconds)
+esp_err_t power_manager_enter_deep_sleep_us(uint64_t sleep_us)
 {
-    if (sleep_seconds == 0U) {
+    if (sleep_us == 0U) {
         return ESP_ERR_INVALID_ARG;
     }
 
-    const uint64_t sleep_time_us = (uint64_t)sleep_seconds * 1000000ULL;
-    esp_err_t err = esp_sleep_enable_timer_wakeup(sleep_time_us);
+    esp_err_t err = esp_sleep_enable_timer_wakeup(sleep_us);
     if (err != ESP_OK) {
         return err;
     }
 
-    ESP_LOGI(TAG, "Entering deep sleep for %lu seconds",
-             (unsigned long)sleep_seconds);
+    ESP_LOGI(TAG, "Entering deep sleep for %llu ms",
+             (unsigned long long)(sleep_us / 1000ULL));
+
+    // Ends the cycle for the energy profiler before the CPU powers down.
+    energy_profiler_enter_sleep();
 
     // Flush the log output before powering down the CPU and UART.
     fflush(stdout);
@@ -38,6 +42,25 @@ esp_err_t power_manager_enter_deep_sleep(uint32_t sleep_seconds)
     return ESP_OK;
 }
 
+/**
+ * @brief Configures a timer wake source and enters deep sleep.
+ *
+ * Args:
+ *     sleep_seconds: Requested sleep interval in seconds.
+ *
+ * Returns:
+ *     ESP_OK before deep sleep starts, or an error code when configuration fails.
+ */
+esp_err_t power_manager_enter_deep_sleep(uint32_t sleep_seconds)
+{
+    if (sleep_seconds == 0U) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return power_manager_enter_deep_sleep_us((uint64_t)sleep_seconds *
+                                             1000000ULL);
+}
+
 /**
  * @brief Returns a human-readable description of the wake-up cause.
  *
@@ -20,6 +20,19 @@ extern "C" {
  */
 esp_err_t power_manager_enter_deep_sleep(uint32_t sleep_seconds);
 
+/**
+ * @brief Configures a timer wake source and enters deep sleep.
+ *
+ * Microsecond variant used to wake just before a scheduled TDMA slot.
+ *
+ * Args:
+ *     sleep_us: Requested sleep interval in microseconds.
+ *
+ * Returns:
+ *     ESP_OK before deep sleep starts, or an error code when configuration fails.
+ */
+esp_err_t power_manager_enter_deep_sleep_us(uint64_t sleep_us);
+
 /**
  * @brief Returns a human-readable description of the wake-up cause.
  *
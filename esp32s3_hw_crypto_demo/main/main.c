@@ -1,18 +1,33 @@
 #include <inttypes.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "esp_chip_info.h"
 #include "esp_check.h"
+#include "esp_cpu.h"
 #include "esp_err.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
+#include "esp_partition.h"
 #include "esp_random.h"
 #include "esp_system.h"
 #include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "mbedtls/aes.h"
+#include "mbedtls/ecdh.h"
+#include "mbedtls/ecdsa.h"
 #include "mbedtls/gcm.h"
 #include "mbedtls/sha256.h"
+#include "nvs.h"
+#include "nvs_flash.h"
+#include "soc/soc_caps.h"
 
 #define AES_KEY_SIZE_BYTES       32U
 #define GCM_IV_SIZE_BYTES        12U
@@ -20,6 +35,32 @@
 #define SHA256_DIGEST_SIZE_BYTES 32U
 #define BENCHMARK_BUFFER_SIZE    1024U
 #define BENCHMARK_ITERATIONS     1000U
+#define SWEEP_MIN_SIZE           16U
+#define SWEEP_MAX_SIZE           65536U
+#define SWEEP_BYTES_PER_SIZE     (512U * 1024U)
+#define SWEEP_MIN_ITERATIONS     16U
+#define SESSION_TEST_SIZE        1000U
+#define AES_SWEEP_SIZE_COUNT     13U
+#define AES_SWEEP_BYTES_PER_SIZE (256U * 1024U)
+#define AES_SWEEP_KNEE_PERCENT   90U
+#define IMAGE_CHUNK_SIZE         (16U * 1024U)
+#define IMAGE_PIPELINE_DEPTH     3U
+#define IMAGE_READER_STACK_SIZE  3072U
+#define IMAGE_READER_CORE        (portNUM_PROCESSORS - 1)
+#define IV_FIXED_FIELD_BYTES     4U
+#define IV_RESERVATION_BLOCK     65536U
+#define IV_MAX_PER_BOOT          (UINT32_MAX - IV_RESERVATION_BLOCK)
+#define IV_NVS_NAMESPACE         "iv_alloc"
+#define IV_TEST_TASK_COUNT       2U
+#define IV_TEST_PER_TASK         40000U
+#define ECC_CURVE                MBEDTLS_ECP_DP_SECP256R1
+#define ECC_SHARED_SECRET_BYTES  32U
+#define ECDSA_SIGNATURE_MAX_BYTES MBEDTLS_ECDSA_MAX_SIG_LEN(256)
+#define ECC_BENCHMARK_ITERATIONS 16U
+#define ECC_HANDSHAKE_VERIFIES   2U
+
+_Static_assert((SWEEP_MIN_SIZE << (AES_SWEEP_SIZE_COUNT - 1U)) == SWEEP_MAX_SIZE,
+               "AES sweep must double from SWEEP_MIN_SIZE to SWEEP_MAX_SIZE");
 
 static const char *TAG = "HW_CRYPTO";
 
@@ -105,6 +146,178 @@ static void increment_iv_counter(uint8_t iv[GCM_IV_SIZE_BYTES])
     }
 }
 
+/**
+ * @brief Deterministic GCM IV source that survives resets without reuse.
+ *
+ * Each IV is a 4-byte fixed field followed by a 64-bit big-endian invocation
+ * counter, as in NIST SP 800-38D section 8.2.1. The fixed field is generated
+ * once and stored in NVS. Counter values are reserved in NVS in blocks of
+ * IV_RESERVATION_BLOCK, so a reset skips the rest of the current block instead
+ * of repeating it, and NVS is written once per block rather than per message.
+ */
+typedef struct {
+    nvs_handle_t nvs;
+    uint8_t fixed[IV_FIXED_FIELD_BYTES];
+    uint64_t boot_base;             // First counter value of this boot
+    atomic_uint_fast32_t issued;    // Counters handed out this boot
+    atomic_uint_fast32_t reserved;  // Counters this boot covered by NVS
+    SemaphoreHandle_t reserve_lock;
+} iv_allocator_t;
+
+static iv_allocator_t s_iv_allocator;
+
+/**
+ * @brief Persists the next reservation block.
+ *
+ * The new limit is committed to NVS before any counter below it is handed
+ * out. Caller holds reserve_lock.
+ *
+ * @param allocator Initialized allocator.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_SIZE once IV_MAX_PER_BOOT counters are reserved.
+ * @return NVS error codes otherwise.
+ */
+static esp_err_t iv_allocator_reserve_block(iv_allocator_t *allocator)
+{
+    uint32_t reserved = atomic_load(&allocator->reserved);
+
+    if (reserved >= IV_MAX_PER_BOOT) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint32_t next_reserved = reserved + IV_RESERVATION_BLOCK;
+
+    ESP_RETURN_ON_ERROR(
+        nvs_set_u64(allocator->nvs, "next", allocator->boot_base + next_reserved),
+        TAG,
+        "IV reservation write failed");
+    ESP_RETURN_ON_ERROR(nvs_commit(allocator->nvs), TAG, "IV reservation commit failed");
+
+    atomic_store(&allocator->reserved, next_reserved);
+    return ESP_OK;
+}
+
+/**
+ * @brief Loads the fixed field and reserves the first counter block of this boot.
+ *
+ * nvs_flash_init() must have been called. Counters start where the previous
+ * boot's reservation ended, so values it may have issued are never repeated.
+ *
+ * @param allocator Allocator to initialize.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NO_MEM when the reservation lock cannot be created.
+ * @return NVS error codes otherwise.
+ */
+static esp_err_t iv_allocator_init(iv_allocator_t *allocator)
+{
+    size_t fixed_length = sizeof(allocator->fixed);
+    uint64_t next = 0U;
+    esp_err_t ret;
+
+    memset(allocator, 0, sizeof(*allocator));
+    allocator->reserve_lock = xSemaphoreCreateMutex();
+
+    if (allocator->reserve_lock == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    ESP_GOTO_ON_ERROR(
+        nvs_open(IV_NVS_NAMESPACE, NVS_READWRITE, &allocator->nvs),
+        fail_lock,
+        TAG,
+        "IV NVS open failed");
+
+    // Generate the device's fixed field on first use.
+    ret = nvs_get_blob(allocator->nvs, "fixed", allocator->fixed, &fixed_length);
+
+    if (ret == ESP_ERR_NVS_NOT_FOUND) {
+        fill_random_bytes(allocator->fixed, sizeof(allocator->fixed));
+        ret = nvs_set_blob(allocator->nvs, "fixed", allocator->fixed, sizeof(allocator->fixed));
+    } else if (ret == ESP_OK && fixed_length != sizeof(allocator->fixed)) {
+        ret = ESP_ERR_INVALID_SIZE;
+    }
+
+    ESP_GOTO_ON_ERROR(ret, fail_nvs, TAG, "IV fixed field unavailable");
+
+    // Resume after the last reservation, not after the last IV actually used.
+    ret = nvs_get_u64(allocator->nvs, "next", &next);
+
+    if (ret != ESP_OK && ret != ESP_ERR_NVS_NOT_FOUND) {
+        ESP_LOGE(TAG, "IV counter read failed: %s", esp_err_to_name(ret));
+        goto fail_nvs;
+    }
+
+    if (next > UINT64_MAX - ((uint64_t)IV_MAX_PER_BOOT + IV_RESERVATION_BLOCK)) {
+        ESP_LOGE(TAG, "IV counter space exhausted; rotate the key");
+        ret = ESP_ERR_INVALID_SIZE;
+        goto fail_nvs;
+    }
+
+    allocator->boot_base = next;
+    ESP_GOTO_ON_ERROR(iv_allocator_reserve_block(allocator), fail_nvs, TAG, "IV reservation failed");
+
+    ESP_LOGI(TAG, "IV allocator: counters from %" PRIu64 ", reserved to %" PRIu64,
+             allocator->boot_base, allocator->boot_base + atomic_load(&allocator->reserved));
+    return ESP_OK;
+
+fail_nvs:
+    nvs_close(allocator->nvs);
+
+fail_lock:
+    vSemaphoreDelete(allocator->reserve_lock);
+    allocator->reserve_lock = NULL;
+    return ret;
+}
+
+/**
+ * @brief Hands out the next unique IV.
+ *
+ * Safe to call from any number of tasks. A counter is claimed with one atomic
+ * increment, with no lock, RNG call, or NVS write. Only the call that runs past
+ * the reserved block takes the lock and commits the next block to NVS.
+ *
+ * @param allocator Initialized allocator.
+ * @param iv Destination for a 12-byte GCM IV.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_SIZE when this boot's counter range is exhausted.
+ * @return NVS error codes when a new block cannot be reserved.
+ */
+static esp_err_t iv_allocator_next(iv_allocator_t *allocator, uint8_t iv[GCM_IV_SIZE_BYTES])
+{
+    uint32_t index = atomic_fetch_add_explicit(&allocator->issued, 1U, memory_order_relaxed);
+
+    if (index >= IV_MAX_PER_BOOT) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    // The claimed index is already unique; wait only until NVS covers it.
+    if (index >= atomic_load_explicit(&allocator->reserved, memory_order_acquire)) {
+        esp_err_t ret = ESP_OK;
+
+        xSemaphoreTake(allocator->reserve_lock, portMAX_DELAY);
+
+        while (ret == ESP_OK && index >= atomic_load(&allocator->reserved)) {
+            ret = iv_allocator_reserve_block(allocator);
+        }
+
+        xSemaphoreGive(allocator->reserve_lock);
+        ESP_RETURN_ON_ERROR(ret, TAG, "IV reservation failed");
+    }
+
+    uint64_t counter = allocator->boot_base + index;
+
+    memcpy(iv, allocator->fixed, IV_FIXED_FIELD_BYTES);
+
+    for (size_t byte = 0U; byte < GCM_IV_SIZE_BYTES - IV_FIXED_FIELD_BYTES; ++byte) {
+        iv[GCM_IV_SIZE_BYTES - 1U - byte] = (uint8_t)(counter >> (8U * byte));
+    }
+
+    return ESP_OK;
+}
+
 /**
  * @brief Encrypts and authenticates data with AES-256-GCM.
  *
@@ -253,6 +466,234 @@ static esp_err_t aes_gcm_decrypt(
     return ESP_OK;
 }
 
+/**
+ * @brief Reusable AES-256-GCM context for a sequence of messages under one key.
+ *
+ * The key schedule is computed once by aes_gcm_session_init(). Each message is
+ * then processed with aes_gcm_session_starts(), any number of
+ * aes_gcm_session_update() calls, and aes_gcm_session_finish() or
+ * aes_gcm_session_finish_verify().
+ */
+typedef struct {
+    mbedtls_gcm_context context;
+    bool message_active;
+} aes_gcm_session_t;
+
+/**
+ * @brief Initializes a session and expands the AES key.
+ *
+ * @param session Session to initialize.
+ * @param key Pointer to a 32-byte AES key.
+ *
+ * @return ESP_OK on success; otherwise ESP_FAIL.
+ */
+static esp_err_t aes_gcm_session_init(
+    aes_gcm_session_t *session,
+    const uint8_t key[AES_KEY_SIZE_BYTES])
+{
+    int result;
+
+    mbedtls_gcm_init(&session->context);
+    session->message_active = false;
+
+    // Set the AES key once for every message in this session.
+    result = mbedtls_gcm_setkey(
+        &session->context,
+        MBEDTLS_CIPHER_ID_AES,
+        key,
+        AES_KEY_SIZE_BYTES * 8U);
+
+    if (result != 0) {
+        ESP_LOGE(TAG, "mbedtls_gcm_setkey failed: -0x%04X", -result);
+        mbedtls_gcm_free(&session->context);
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Starts one message in an initialized session.
+ *
+ * @param session Initialized session with no message in progress.
+ * @param mode MBEDTLS_GCM_ENCRYPT or MBEDTLS_GCM_DECRYPT.
+ * @param iv Pointer to the initialization vector.
+ * @param iv_length Initialization-vector length in bytes.
+ * @param aad Pointer to optional additional authenticated data, or NULL.
+ * @param aad_length Additional authenticated-data length in bytes.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_STATE when a message is already in progress.
+ * @return ESP_FAIL for cryptographic errors.
+ */
+static esp_err_t aes_gcm_session_starts(
+    aes_gcm_session_t *session,
+    int mode,
+    const uint8_t *iv,
+    size_t iv_length,
+    const uint8_t *aad,
+    size_t aad_length)
+{
+    int result;
+
+    if (session->message_active) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    // Load the IV; the key schedule from aes_gcm_session_init() is reused.
+    result = mbedtls_gcm_starts(&session->context, mode, iv, iv_length);
+
+    if (result != 0) {
+        ESP_LOGE(TAG, "mbedtls_gcm_starts failed: -0x%04X", -result);
+        return ESP_FAIL;
+    }
+
+    // Authenticate the additional data before any payload.
+    if (aad_length > 0U) {
+        result = mbedtls_gcm_update_ad(&session->context, aad, aad_length);
+
+        if (result != 0) {
+            ESP_LOGE(TAG, "mbedtls_gcm_update_ad failed: -0x%04X", -result);
+            return ESP_FAIL;
+        }
+    }
+
+    session->message_active = true;
+    return ESP_OK;
+}
+
+/**
+ * @brief Encrypts or decrypts the next chunk of the current message.
+ *
+ * Chunks may have any length. Output is produced for every input byte, so
+ * output must hold length bytes and may be the same buffer as input.
+ *
+ * @param session Session with a message in progress.
+ * @param input Pointer to the next plaintext or ciphertext bytes.
+ * @param length Number of bytes in this chunk.
+ * @param output Destination buffer for length bytes.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_STATE when no message is in progress.
+ * @return ESP_FAIL for cryptographic errors.
+ */
+static esp_err_t aes_gcm_session_update(
+    aes_gcm_session_t *session,
+    const uint8_t *input,
+    size_t length,
+    uint8_t *output)
+{
+    size_t output_length = 0U;
+    int result;
+
+    if (!session->message_active) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    result = mbedtls_gcm_update(
+        &session->context,
+        input,
+        length,
+        output,
+        length,
+        &output_length);
+
+    // GCM is a stream mode; a short write would lose bytes of this chunk.
+    if (result != 0 || output_length != length) {
+        ESP_LOGE(TAG, "mbedtls_gcm_update failed: -0x%04X", -result);
+        session->message_active = false;
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Finishes the current message and writes its authentication tag.
+ *
+ * @param session Session with a message in progress.
+ * @param tag Destination buffer for the 16-byte authentication tag.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_INVALID_STATE when no message is in progress.
+ * @return ESP_FAIL for cryptographic errors.
+ */
+static esp_err_t aes_gcm_session_finish(
+    aes_gcm_session_t *session,
+    uint8_t tag[GCM_TAG_SIZE_BYTES])
+{
+    size_t output_length = 0U;
+    int result;
+
+    if (!session->message_active) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    session->message_active = false;
+
+    // Every payload byte was already returned by aes_gcm_session_update().
+    result = mbedtls_gcm_finish(
+        &session->context,
+        NULL,
+        0U,
+        &output_length,
+        tag,
+        GCM_TAG_SIZE_BYTES);
+
+    if (result != 0) {
+        ESP_LOGE(TAG, "mbedtls_gcm_finish failed: -0x%04X", -result);
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Finishes a decrypted message and checks its authentication tag.
+ *
+ * Plaintext returned by aes_gcm_session_update() must not be used until this
+ * function returns ESP_OK.
+ *
+ * @param session Session with a decrypt message in progress.
+ * @param expected_tag Pointer to the received 16-byte authentication tag.
+ *
+ * @return ESP_OK when the tag matches.
+ * @return ESP_ERR_INVALID_CRC when tag verification fails.
+ * @return ESP_ERR_INVALID_STATE when no message is in progress.
+ * @return ESP_FAIL for cryptographic errors.
+ */
+static esp_err_t aes_gcm_session_finish_verify(
+    aes_gcm_session_t *session,
+    const uint8_t expected_tag[GCM_TAG_SIZE_BYTES])
+{
+    uint8_t tag[GCM_TAG_SIZE_BYTES];
+    uint8_t difference = 0U;
+
+    ESP_RETURN_ON_ERROR(
+        aes_gcm_session_finish(session, tag),
+        TAG,
+        "AES-GCM session finish failed");
+
+    // Compare every byte so the time taken does not reveal the mismatch position.
+    for (size_t index = 0; index < sizeof(tag); ++index) {
+        difference |= (uint8_t)(tag[index] ^ expected_tag[index]);
+    }
+
+    memset(tag, 0, sizeof(tag));
+    return difference == 0U ? ESP_OK : ESP_ERR_INVALID_CRC;
+}
+
+/**
+ * @brief Releases a session and clears its key schedule.
+ *
+ * @param session Session to release.
+ */
+static void aes_gcm_session_free(aes_gcm_session_t *session)
+{
+    mbedtls_gcm_free(&session->context);
+    session->message_active = false;
+}
+
 /**
  * @brief Calculates a SHA-256 digest using Mbed TLS.
  *
@@ -354,6 +795,128 @@ static esp_err_t run_aes_gcm_known_answer_test(void)
     return ESP_OK;
 }
 
+/**
+ * @brief Checks streamed session output against the one-shot functions.
+ *
+ * Encrypts one message in uneven chunks through a session and compares the
+ * ciphertext and tag with aes_gcm_encrypt(). The ciphertext is then decrypted
+ * through the same session with tag verification, and a modified tag must be
+ * rejected.
+ *
+ * @return ESP_OK when streamed and one-shot results agree.
+ */
+static esp_err_t run_aes_gcm_session_test(void)
+{
+    static const uint8_t aad[] = "stream=test";
+    static const size_t chunk_sizes[] = {1U, 15U, 16U, 17U, 255U, 400U};
+
+    uint8_t key[AES_KEY_SIZE_BYTES];
+    uint8_t iv[GCM_IV_SIZE_BYTES];
+    uint8_t expected_tag[GCM_TAG_SIZE_BYTES];
+    uint8_t tag[GCM_TAG_SIZE_BYTES];
+    uint8_t *plaintext = malloc(SESSION_TEST_SIZE);
+    uint8_t *expected = malloc(SESSION_TEST_SIZE);
+    uint8_t *output = malloc(SESSION_TEST_SIZE);
+    aes_gcm_session_t session;
+    esp_err_t ret = ESP_FAIL;
+
+    if (plaintext == NULL || expected == NULL || output == NULL) {
+        ESP_LOGE(TAG, "Session test buffer allocation failed");
+        goto out;
+    }
+
+    fill_random_bytes(key, sizeof(key));
+    fill_random_bytes(iv, sizeof(iv));
+    fill_random_bytes(plaintext, SESSION_TEST_SIZE);
+
+    // Produce the reference result with the one-shot function.
+    ESP_GOTO_ON_ERROR(
+        aes_gcm_encrypt(key, iv, sizeof(iv), aad, sizeof(aad) - 1U,
+                        plaintext, SESSION_TEST_SIZE, expected, expected_tag),
+        out,
+        TAG,
+        "Reference encryption failed");
+
+    ESP_GOTO_ON_ERROR(aes_gcm_session_init(&session, key), out, TAG, "Session init failed");
+
+    // Encrypt in chunks that straddle the 16-byte block boundary.
+    size_t offset = 0U;
+    size_t chunk_index = 0U;
+
+    ret = aes_gcm_session_starts(&session, MBEDTLS_GCM_ENCRYPT, iv, sizeof(iv), aad, sizeof(aad) - 1U);
+
+    while (ret == ESP_OK && offset < SESSION_TEST_SIZE) {
+        size_t chunk = chunk_sizes[chunk_index++ % (sizeof(chunk_sizes) / sizeof(chunk_sizes[0]))];
+
+        if (chunk > SESSION_TEST_SIZE - offset) {
+            chunk = SESSION_TEST_SIZE - offset;
+        }
+
+        ret = aes_gcm_session_update(&session, &plaintext[offset], chunk, &output[offset]);
+        offset += chunk;
+    }
+
+    if (ret == ESP_OK) {
+        ret = aes_gcm_session_finish(&session, tag);
+    }
+
+    if (ret != ESP_OK ||
+        !buffers_equal(output, expected, SESSION_TEST_SIZE) ||
+        !buffers_equal(tag, expected_tag, sizeof(tag))) {
+        ESP_LOGE(TAG, "Streamed AES-GCM encryption does not match one-shot result");
+        ret = ESP_FAIL;
+        goto free_session;
+    }
+
+    // Decrypt in place in one chunk and verify the tag.
+    ret = aes_gcm_session_starts(&session, MBEDTLS_GCM_DECRYPT, iv, sizeof(iv), aad, sizeof(aad) - 1U);
+
+    if (ret == ESP_OK) {
+        ret = aes_gcm_session_update(&session, output, SESSION_TEST_SIZE, output);
+    }
+
+    if (ret == ESP_OK) {
+        ret = aes_gcm_session_finish_verify(&session, tag);
+    }
+
+    if (ret != ESP_OK || !buffers_equal(output, plaintext, SESSION_TEST_SIZE)) {
+        ESP_LOGE(TAG, "Streamed AES-GCM decryption failed");
+        ret = ESP_FAIL;
+        goto free_session;
+    }
+
+    // A modified tag must be rejected.
+    tag[0] ^= 0x01U;
+    ret = aes_gcm_session_starts(&session, MBEDTLS_GCM_DECRYPT, iv, sizeof(iv), aad, sizeof(aad) - 1U);
+
+    if (ret == ESP_OK) {
+        ret = aes_gcm_session_update(&session, expected, SESSION_TEST_SIZE, output);
+    }
+
+    if (ret == ESP_OK) {
+        ret = aes_gcm_session_finish_verify(&session, tag);
+    }
+
+    if (ret != ESP_ERR_INVALID_CRC) {
+        ESP_LOGE(TAG, "Streamed AES-GCM accepted a modified tag");
+        ret = ESP_FAIL;
+        goto free_session;
+    }
+
+    ESP_LOGI(TAG, "AES-256-GCM streamed session test: PASS");
+    ret = ESP_OK;
+
+free_session:
+    aes_gcm_session_free(&session);
+
+out:
+    memset(key, 0, sizeof(key));
+    free(plaintext);
+    free(expected);
+    free(output);
+    return ret;
+}
+
 /**
  * @brief Runs a SHA-256 known-answer validation test.
  *
@@ -407,9 +970,9 @@ static esp_err_t run_authenticated_encryption_demo(void)
     uint8_t tag[GCM_TAG_SIZE_BYTES] = {0};
     uint8_t tampered_ciphertext[sizeof(ciphertext)] = {0};
 
-    // Generate a random AES key and IV for the demonstration.
+    // Generate a random AES key and take the next IV from the allocator.
     fill_random_bytes(key, sizeof(key));
-    fill_random_bytes(iv, sizeof(iv));
+    ESP_RETURN_ON_ERROR(iv_allocator_next(&s_iv_allocator, iv), TAG, "IV allocation failed");
 
     // Encrypt the plaintext and generate the authentication tag.
     ESP_RETURN_ON_ERROR(
@@ -552,26 +1115,373 @@ static esp_err_t benchmark_aes_gcm(void)
 }
 
 /**
- * @brief Measures SHA-256 throughput for 1024-byte buffers.
+ * @brief Compares per-message and per-session AES-256-GCM cost across sizes.
+ *
+ * For each payload size from SWEEP_MIN_SIZE to SWEEP_MAX_SIZE, the same
+ * messages are encrypted twice: once with aes_gcm_encrypt(), which initializes
+ * the context and expands the key for every message, and once through a
+ * session whose key was set before timing started. The difference per message
+ * is the setup overhead a session removes, which dominates for small packets.
  *
  * @return ESP_OK when all benchmark operations complete successfully.
  */
-static esp_err_t benchmark_sha256(void)
+static esp_err_t benchmark_aes_gcm_session(void)
 {
-    uint8_t input[BENCHMARK_BUFFER_SIZE];
-    uint8_t digest[SHA256_DIGEST_SIZE_BYTES];
+    uint8_t key[AES_KEY_SIZE_BYTES];
+    uint8_t iv[GCM_IV_SIZE_BYTES];
+    uint8_t tag[GCM_TAG_SIZE_BYTES];
+    uint8_t *input = malloc(SWEEP_MAX_SIZE);
+    uint8_t *output = malloc(SWEEP_MAX_SIZE);
+    aes_gcm_session_t session;
+    esp_err_t ret = ESP_OK;
+
+    if (input == NULL || output == NULL) {
+        ESP_LOGE(TAG, "Session benchmark buffer allocation failed");
+        free(input);
+        free(output);
+        return ESP_ERR_NO_MEM;
+    }
 
-    fill_random_bytes(input, sizeof(input));
+    fill_random_bytes(key, sizeof(key));
+    fill_random_bytes(iv, sizeof(iv));
+    fill_random_bytes(input, SWEEP_MAX_SIZE);
 
-    int64_t start_time_us = esp_timer_get_time();
+    ESP_GOTO_ON_ERROR(aes_gcm_session_init(&session, key), out, TAG, "Session init failed");
 
-    // Perform multiple SHA-256 operations, modifying the input buffer each time.
-    for (uint32_t iteration = 0U;
-         iteration < BENCHMARK_ITERATIONS;
-         ++iteration) {
-        esp_err_t result = calculate_sha256(input, sizeof(input), digest);
+    ESP_LOGI(TAG, "AES-GCM per-message vs per-session:");
+    ESP_LOGI(TAG, "%8s %10s %10s %10s %10s %10s",
+             "bytes", "msg us", "sess us", "saved us", "msg MiB/s", "sess MiB/s");
 
-        if (result != ESP_OK) {
+    for (size_t size = SWEEP_MIN_SIZE; size <= SWEEP_MAX_SIZE; size *= 4U) {
+        uint32_t iterations = SWEEP_BYTES_PER_SIZE / size;
+
+        if (iterations < SWEEP_MIN_ITERATIONS) {
+            iterations = SWEEP_MIN_ITERATIONS;
+        }
+
+        // Per message: init, setkey, crypt_and_tag, and free every time.
+        int64_t start_time_us = esp_timer_get_time();
+
+        for (uint32_t iteration = 0U; iteration < iterations && ret == ESP_OK; ++iteration) {
+            increment_iv_counter(iv);
+            ret = aes_gcm_encrypt(key, iv, sizeof(iv), NULL, 0U, input, size, output, tag);
+        }
+
+        int64_t message_time_us = esp_timer_get_time() - start_time_us;
+
+        // Per session: the key schedule is already in place.
+        start_time_us = esp_timer_get_time();
+
+        for (uint32_t iteration = 0U; iteration < iterations && ret == ESP_OK; ++iteration) {
+            increment_iv_counter(iv);
+            ret = aes_gcm_session_starts(&session, MBEDTLS_GCM_ENCRYPT, iv, sizeof(iv), NULL, 0U);
+
+            if (ret == ESP_OK) {
+                ret = aes_gcm_session_update(&session, input, size, output);
+            }
+
+            if (ret == ESP_OK) {
+                ret = aes_gcm_session_finish(&session, tag);
+            }
+        }
+
+        int64_t session_time_us = esp_timer_get_time() - start_time_us;
+
+        if (ret != ESP_OK) {
+            ESP_LOGE(TAG, "Session benchmark failed at %u bytes", (unsigned)size);
+            break;
+        }
+
+        double message_us = (double)message_time_us / (double)iterations;
+        double session_us = (double)session_time_us / (double)iterations;
+        double total_mib = ((double)size * (double)iterations) / (1024.0 * 1024.0);
+
+        ESP_LOGI(TAG, "%8u %10.2f %10.2f %10.2f %10.2f %10.2f",
+                 (unsigned)size,
+                 message_us,
+                 session_us,
+                 message_us - session_us,
+                 total_mib / ((double)message_time_us / 1000000.0),
+                 total_mib / ((double)session_time_us / 1000000.0));
+    }
+
+    aes_gcm_session_free(&session);
+
+out:
+    memset(key, 0, sizeof(key));
+    free(input);
+    free(output);
+    return ret;
+}
+
+/**
+ * @brief AES modes covered by benchmark_aes_sweep().
+ */
+typedef enum {
+    AES_SWEEP_CTR = 0,
+    AES_SWEEP_CBC,
+    AES_SWEEP_GCM,
+    AES_SWEEP_MODE_COUNT
+} aes_sweep_mode_t;
+
+/**
+ * @brief Buffer placements covered by benchmark_aes_sweep().
+ */
+typedef enum {
+    AES_SWEEP_INTERNAL = 0,
+    AES_SWEEP_PSRAM,
+    AES_SWEEP_MEMORY_COUNT
+} aes_sweep_memory_t;
+
+static const char *const aes_sweep_mode_names[AES_SWEEP_MODE_COUNT] = {
+    "CTR",
+    "CBC",
+    "GCM"
+};
+
+static const char *const aes_sweep_memory_names[AES_SWEEP_MEMORY_COUNT] = {
+    "internal",
+    "PSRAM"
+};
+
+static const uint32_t aes_sweep_memory_caps[AES_SWEEP_MEMORY_COUNT] = {
+    MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA,
+    MALLOC_CAP_SPIRAM
+};
+
+/**
+ * @brief Key state shared by every measurement of the sweep.
+ */
+typedef struct {
+    mbedtls_aes_context aes;
+    aes_gcm_session_t gcm;
+    uint8_t iv[GCM_IV_SIZE_BYTES];
+} aes_sweep_state_t;
+
+/**
+ * @brief Encrypts one buffer with the selected mode.
+ *
+ * Keys are expanded before timing starts, so only the data path is measured.
+ *
+ * @param state Sweep key state.
+ * @param mode AES mode to run.
+ * @param input Pointer to plaintext input.
+ * @param output Destination buffer for ciphertext.
+ * @param length Number of bytes; a multiple of 16 for CBC.
+ *
+ * @return ESP_OK on success; otherwise ESP_FAIL.
+ */
+static esp_err_t aes_sweep_encrypt(
+    aes_sweep_state_t *state,
+    aes_sweep_mode_t mode,
+    const uint8_t *input,
+    uint8_t *output,
+    size_t length)
+{
+    uint8_t counter[16] = {0};
+    uint8_t stream_block[16];
+    uint8_t tag[GCM_TAG_SIZE_BYTES];
+    size_t offset = 0U;
+    int result;
+
+    increment_iv_counter(state->iv);
+    memcpy(counter, state->iv, sizeof(state->iv));
+
+    switch (mode) {
+    case AES_SWEEP_CTR:
+        result = mbedtls_aes_crypt_ctr(&state->aes, length, &offset, counter, stream_block, input, output);
+        break;
+
+    case AES_SWEEP_CBC:
+        result = mbedtls_aes_crypt_cbc(&state->aes, MBEDTLS_AES_ENCRYPT, length, counter, input, output);
+        break;
+
+    case AES_SWEEP_GCM:
+        ESP_RETURN_ON_ERROR(
+            aes_gcm_session_starts(&state->gcm, MBEDTLS_GCM_ENCRYPT, state->iv, sizeof(state->iv), NULL, 0U),
+            TAG,
+            "GCM starts failed");
+        ESP_RETURN_ON_ERROR(
+            aes_gcm_session_update(&state->gcm, input, length, output),
+            TAG,
+            "GCM update failed");
+        return aes_gcm_session_finish(&state->gcm, tag);
+
+    default:
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (result != 0) {
+        ESP_LOGE(TAG, "AES-%s failed: -0x%04X", aes_sweep_mode_names[mode], -result);
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Sweeps AES throughput across sizes, modes, and buffer placement.
+ *
+ * Sizes double from SWEEP_MIN_SIZE to SWEEP_MAX_SIZE. Each point encrypts
+ * about AES_SWEEP_BYTES_PER_SIZE bytes and reports MB/s and CPU cycles per
+ * byte. On the ESP32-S3, the Mbed TLS port drives the AES peripheral through
+ * DMA for longer inputs, so the sweep shows the size where DMA setup stops
+ * dominating. The smallest size reaching AES_SWEEP_KNEE_PERCENT of the peak
+ * is reported for each mode and placement.
+ *
+ * The implementation is fixed at build time. Build with
+ * sdkconfig.defaults.software to measure software AES with the same sweep.
+ *
+ * @return ESP_OK when all benchmark operations complete successfully.
+ */
+static esp_err_t benchmark_aes_sweep(void)
+{
+    // Static to keep the AES and GCM contexts off the main task stack.
+    static float throughput_mb_s[AES_SWEEP_MODE_COUNT][AES_SWEEP_MEMORY_COUNT][AES_SWEEP_SIZE_COUNT];
+    static aes_sweep_state_t state;
+
+    uint8_t key[AES_KEY_SIZE_BYTES];
+    esp_err_t ret = ESP_OK;
+
+    fill_random_bytes(key, sizeof(key));
+    fill_random_bytes(state.iv, sizeof(state.iv));
+    memset(throughput_mb_s, 0, sizeof(throughput_mb_s));
+
+    // Expand the keys once so the sweep measures only the data path.
+    mbedtls_aes_init(&state.aes);
+
+    if (mbedtls_aes_setkey_enc(&state.aes, key, AES_KEY_SIZE_BYTES * 8U) != 0) {
+        ESP_LOGE(TAG, "mbedtls_aes_setkey_enc failed");
+        mbedtls_aes_free(&state.aes);
+        return ESP_FAIL;
+    }
+
+    ESP_GOTO_ON_ERROR(aes_gcm_session_init(&state.gcm, key), free_aes, TAG, "Session init failed");
+
+#if CONFIG_MBEDTLS_HARDWARE_AES
+    ESP_LOGI(TAG, "AES sweep (hardware AES):");
+#else
+    ESP_LOGI(TAG, "AES sweep (software AES):");
+#endif
+    ESP_LOGI(TAG, "%4s %8s %8s %10s %10s", "mode", "memory", "bytes", "MB/s", "cycles/B");
+
+    for (int memory = 0; memory < AES_SWEEP_MEMORY_COUNT && ret == ESP_OK; ++memory) {
+        uint8_t *input = heap_caps_malloc(SWEEP_MAX_SIZE, aes_sweep_memory_caps[memory]);
+        uint8_t *output = heap_caps_malloc(SWEEP_MAX_SIZE, aes_sweep_memory_caps[memory]);
+
+        if (input == NULL || output == NULL) {
+            ESP_LOGW(TAG, "%s buffers unavailable; skipping", aes_sweep_memory_names[memory]);
+            heap_caps_free(input);
+            heap_caps_free(output);
+            continue;
+        }
+
+        fill_random_bytes(input, SWEEP_MAX_SIZE);
+
+        for (int mode = 0; mode < AES_SWEEP_MODE_COUNT && ret == ESP_OK; ++mode) {
+            size_t size = SWEEP_MIN_SIZE;
+
+            for (size_t index = 0U; index < AES_SWEEP_SIZE_COUNT && ret == ESP_OK; ++index, size *= 2U) {
+                uint32_t iterations = AES_SWEEP_BYTES_PER_SIZE / size;
+
+                if (iterations < SWEEP_MIN_ITERATIONS) {
+                    iterations = SWEEP_MIN_ITERATIONS;
+                }
+
+                // The cycle counter wraps after about 17 s at 240 MHz; one point stays well below.
+                int64_t start_time_us = esp_timer_get_time();
+                uint32_t start_cycles = esp_cpu_get_cycle_count();
+
+                for (uint32_t iteration = 0U; iteration < iterations && ret == ESP_OK; ++iteration) {
+                    ret = aes_sweep_encrypt(&state, (aes_sweep_mode_t)mode, input, output, size);
+                }
+
+                uint32_t cycles = esp_cpu_get_cycle_count() - start_cycles;
+                int64_t elapsed_time_us = esp_timer_get_time() - start_time_us;
+
+                if (ret != ESP_OK) {
+                    ESP_LOGE(TAG, "AES sweep failed: %s %u bytes",
+                             aes_sweep_mode_names[mode], (unsigned)size);
+                    break;
+                }
+
+                double total_bytes = (double)size * (double)iterations;
+                double mb_s = total_bytes / (double)elapsed_time_us;   // bytes/us == MB/s
+
+                throughput_mb_s[mode][memory][index] = (float)mb_s;
+                ESP_LOGI(TAG, "%4s %8s %8u %10.2f %10.2f",
+                         aes_sweep_mode_names[mode],
+                         aes_sweep_memory_names[memory],
+                         (unsigned)size,
+                         mb_s,
+                         (double)cycles / total_bytes);
+            }
+        }
+
+        heap_caps_free(input);
+        heap_caps_free(output);
+    }
+
+    // Report where each curve flattens out.
+    for (int mode = 0; mode < AES_SWEEP_MODE_COUNT && ret == ESP_OK; ++mode) {
+        for (int memory = 0; memory < AES_SWEEP_MEMORY_COUNT; ++memory) {
+            const float *curve = throughput_mb_s[mode][memory];
+            float peak = 0.0f;
+
+            for (size_t index = 0U; index < AES_SWEEP_SIZE_COUNT; ++index) {
+                if (curve[index] > peak) {
+                    peak = curve[index];
+                }
+            }
+
+            if (peak == 0.0f) {
+                continue;
+            }
+
+            size_t knee = 0U;
+
+            while (curve[knee] * 100.0f < peak * (float)AES_SWEEP_KNEE_PERCENT) {
+                ++knee;
+            }
+
+            ESP_LOGI(TAG, "%s/%s: peak %.2f MB/s, %u%% of peak from %u bytes",
+                     aes_sweep_mode_names[mode],
+                     aes_sweep_memory_names[memory],
+                     (double)peak,
+                     (unsigned)AES_SWEEP_KNEE_PERCENT,
+                     (unsigned)(SWEEP_MIN_SIZE << knee));
+        }
+    }
+
+    aes_gcm_session_free(&state.gcm);
+
+free_aes:
+    mbedtls_aes_free(&state.aes);
+    memset(key, 0, sizeof(key));
+    return ret;
+}
+
+/**
+ * @brief Measures SHA-256 throughput for 1024-byte buffers.
+ *
+ * @return ESP_OK when all benchmark operations complete successfully.
+ */
+static esp_err_t benchmark_sha256(void)
+{
+    uint8_t input[BENCHMARK_BUFFER_SIZE];
+    uint8_t digest[SHA256_DIGEST_SIZE_BYTES];
+
+    fill_random_bytes(input, sizeof(input));
+
+    int64_t start_time_us = esp_timer_get_time();
+
+    // Perform multiple SHA-256 operations, modifying the input buffer each time.
+    for (uint32_t iteration = 0U;
+         iteration < BENCHMARK_ITERATIONS;
+         ++iteration) {
+        esp_err_t result = calculate_sha256(input, sizeof(input), digest);
+
+        if (result != ESP_OK) {
             ESP_LOGE(TAG, "SHA benchmark failed at iteration %" PRIu32, iteration);
             return result;
         }
@@ -601,6 +1511,796 @@ static esp_err_t benchmark_sha256(void)
     return ESP_OK;
 }
 
+/**
+ * @brief One filled pipeline buffer handed from the reader to the hasher.
+ */
+typedef struct {
+    uint8_t slot;
+    size_t length;
+} image_chunk_t;
+
+/**
+ * @brief State shared by the image reader task and the hashing caller.
+ */
+typedef struct {
+    const uint8_t *source;
+    size_t length;
+    uint8_t *buffers[IMAGE_PIPELINE_DEPTH];
+    QueueHandle_t free_slots;
+    QueueHandle_t full_slots;
+    SemaphoreHandle_t reader_done;
+} image_pipeline_t;
+
+/**
+ * @brief Copies the mapped image into free pipeline buffers, in order.
+ *
+ * Reading through the flash cache does not take the SPI flash lock, so the
+ * other core keeps hashing while this task waits for cache misses.
+ *
+ * @param arg Pointer to the image_pipeline_t.
+ */
+static void image_reader_task(void *arg)
+{
+    image_pipeline_t *pipeline = arg;
+    size_t offset = 0U;
+
+    while (offset < pipeline->length) {
+        image_chunk_t chunk;
+        size_t remaining = pipeline->length - offset;
+
+        xQueueReceive(pipeline->free_slots, &chunk.slot, portMAX_DELAY);
+        chunk.length = remaining < IMAGE_CHUNK_SIZE ? remaining : IMAGE_CHUNK_SIZE;
+
+        memcpy(pipeline->buffers[chunk.slot], &pipeline->source[offset], chunk.length);
+        xQueueSend(pipeline->full_slots, &chunk, portMAX_DELAY);
+        offset += chunk.length;
+    }
+
+    xSemaphoreGive(pipeline->reader_done);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Hashes a flash region with read and hash on one core, one chunk at a time.
+ *
+ * This is the single-core reference: every esp_partition_read() completes
+ * before the SHA peripheral sees the chunk.
+ *
+ * @param partition Partition holding the image.
+ * @param length Number of bytes to hash from the start of the partition.
+ * @param digest Destination buffer for the 32-byte digest.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NO_MEM when the read buffer cannot be allocated.
+ * @return ESP_FAIL or a flash error code otherwise.
+ */
+static esp_err_t verify_image_sequential(
+    const esp_partition_t *partition,
+    size_t length,
+    uint8_t digest[SHA256_DIGEST_SIZE_BYTES])
+{
+    mbedtls_sha256_context context;
+    uint8_t *buffer = heap_caps_malloc(IMAGE_CHUNK_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+    esp_err_t ret = ESP_OK;
+    int result;
+
+    if (buffer == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    mbedtls_sha256_init(&context);
+    result = mbedtls_sha256_starts(&context, 0);
+
+    for (size_t offset = 0U; offset < length && result == 0 && ret == ESP_OK; offset += IMAGE_CHUNK_SIZE) {
+        size_t chunk = length - offset < IMAGE_CHUNK_SIZE ? length - offset : IMAGE_CHUNK_SIZE;
+
+        ret = esp_partition_read(partition, offset, buffer, chunk);
+
+        if (ret == ESP_OK) {
+            result = mbedtls_sha256_update(&context, buffer, chunk);
+        }
+    }
+
+    if (ret == ESP_OK && result == 0) {
+        result = mbedtls_sha256_finish(&context, digest);
+    }
+
+    if (ret == ESP_OK && result != 0) {
+        ESP_LOGE(TAG, "SHA-256 image hash failed: -0x%04X", -result);
+        ret = ESP_FAIL;
+    }
+
+    mbedtls_sha256_free(&context);
+    heap_caps_free(buffer);
+    return ret;
+}
+
+/**
+ * @brief Hashes a flash region while a task on the other core reads ahead.
+ *
+ * The partition is memory-mapped, and image_reader_task() copies it into
+ * IMAGE_PIPELINE_DEPTH internal buffers. The caller hashes each buffer
+ * through the SHA peripheral as soon as it is filled, so flash latency and
+ * hashing overlap. The digest is the standard SHA-256 of the region and
+ * matches verify_image_sequential().
+ *
+ * @param partition Partition holding the image.
+ * @param length Number of bytes to hash from the start of the partition.
+ * @param digest Destination buffer for the 32-byte digest.
+ *
+ * @return ESP_OK on success.
+ * @return ESP_ERR_NO_MEM when buffers, queues, or the reader task cannot be created.
+ * @return ESP_FAIL or a flash error code otherwise.
+ */
+static esp_err_t verify_image_pipelined(
+    const esp_partition_t *partition,
+    size_t length,
+    uint8_t digest[SHA256_DIGEST_SIZE_BYTES])
+{
+    image_pipeline_t pipeline = {0};
+    esp_partition_mmap_handle_t map_handle;
+    const void *mapped = NULL;
+    mbedtls_sha256_context context;
+    esp_err_t ret;
+    int result;
+
+    ret = esp_partition_mmap(partition, 0U, length, ESP_PARTITION_MMAP_DATA, &mapped, &map_handle);
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "esp_partition_mmap failed: %s", esp_err_to_name(ret));
+        return ret;
+    }
+
+    pipeline.source = mapped;
+    pipeline.length = length;
+    pipeline.free_slots = xQueueCreate(IMAGE_PIPELINE_DEPTH, sizeof(uint8_t));
+    pipeline.full_slots = xQueueCreate(IMAGE_PIPELINE_DEPTH, sizeof(image_chunk_t));
+    pipeline.reader_done = xSemaphoreCreateBinary();
+    ret = (pipeline.free_slots && pipeline.full_slots && pipeline.reader_done) ? ESP_OK : ESP_ERR_NO_MEM;
+
+    // Every buffer starts out free for the reader.
+    for (uint8_t slot = 0U; slot < IMAGE_PIPELINE_DEPTH && ret == ESP_OK; ++slot) {
+        pipeline.buffers[slot] = heap_caps_malloc(IMAGE_CHUNK_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_DMA);
+
+        if (pipeline.buffers[slot] == NULL) {
+            ret = ESP_ERR_NO_MEM;
+            break;
+        }
+
+        xQueueSend(pipeline.free_slots, &slot, 0);
+    }
+
+    if (ret == ESP_OK &&
+        xTaskCreatePinnedToCore(image_reader_task, "image_reader", IMAGE_READER_STACK_SIZE, &pipeline,
+                                uxTaskPriorityGet(NULL), NULL, IMAGE_READER_CORE) != pdPASS) {
+        ret = ESP_ERR_NO_MEM;
+    }
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Image pipeline setup failed");
+        goto cleanup;
+    }
+
+    mbedtls_sha256_init(&context);
+    result = mbedtls_sha256_starts(&context, 0);
+
+    // Keep draining after a hash error so the reader can always finish.
+    for (size_t hashed = 0U; hashed < length;) {
+        image_chunk_t chunk;
+
+        xQueueReceive(pipeline.full_slots, &chunk, portMAX_DELAY);
+
+        if (result == 0) {
+            result = mbedtls_sha256_update(&context, pipeline.buffers[chunk.slot], chunk.length);
+        }
+
+        hashed += chunk.length;
+        xQueueSend(pipeline.free_slots, &chunk.slot, portMAX_DELAY);
+    }
+
+    if (result == 0) {
+        result = mbedtls_sha256_finish(&context, digest);
+    }
+
+    if (result != 0) {
+        ESP_LOGE(TAG, "SHA-256 image hash failed: -0x%04X", -result);
+        ret = ESP_FAIL;
+    }
+
+    mbedtls_sha256_free(&context);
+    xSemaphoreTake(pipeline.reader_done, portMAX_DELAY);
+
+cleanup:
+    for (size_t slot = 0U; slot < IMAGE_PIPELINE_DEPTH; ++slot) {
+        heap_caps_free(pipeline.buffers[slot]);
+    }
+
+    if (pipeline.free_slots != NULL) {
+        vQueueDelete(pipeline.free_slots);
+    }
+
+    if (pipeline.full_slots != NULL) {
+        vQueueDelete(pipeline.full_slots);
+    }
+
+    if (pipeline.reader_done != NULL) {
+        vSemaphoreDelete(pipeline.reader_done);
+    }
+
+    esp_partition_munmap(map_handle);
+    return ret;
+}
+
+/**
+ * @brief Compares single-core and pipelined verification of the app image.
+ *
+ * Hashes the whole first app partition both ways, checks that the digests
+ * agree, and reports end-to-end time and throughput. Unlike benchmark_sha256(),
+ * the timing includes reading the image from flash.
+ *
+ * @return ESP_OK when both digests are computed and equal.
+ */
+static esp_err_t benchmark_image_verification(void)
+{
+    const esp_partition_t *partition =
+        esp_partition_find_first(ESP_PARTITION_TYPE_APP, ESP_PARTITION_SUBTYPE_ANY, NULL);
+    uint8_t sequential_digest[SHA256_DIGEST_SIZE_BYTES];
+    uint8_t pipelined_digest[SHA256_DIGEST_SIZE_BYTES];
+
+    if (partition == NULL) {
+        ESP_LOGE(TAG, "No app partition found");
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    size_t length = partition->size;
+    double length_mib = (double)length / (1024.0 * 1024.0);
+
+    ESP_LOGI(TAG, "Image verification: partition '%s', %u bytes", partition->label, (unsigned)length);
+
+    // Read then hash each chunk on this core.
+    int64_t start_time_us = esp_timer_get_time();
+    ESP_RETURN_ON_ERROR(
+        verify_image_sequential(partition, length, sequential_digest),
+        TAG,
+        "Sequential image hash failed");
+    int64_t sequential_time_us = esp_timer_get_time() - start_time_us;
+
+    // Read ahead on the other core while this core hashes.
+    start_time_us = esp_timer_get_time();
+    ESP_RETURN_ON_ERROR(
+        verify_image_pipelined(partition, length, pipelined_digest),
+        TAG,
+        "Pipelined image hash failed");
+    int64_t pipelined_time_us = esp_timer_get_time() - start_time_us;
+
+    if (!buffers_equal(sequential_digest, pipelined_digest, sizeof(pipelined_digest))) {
+        ESP_LOGE(TAG, "Pipelined image digest does not match sequential digest");
+        return ESP_FAIL;
+    }
+
+    ESP_LOGI(TAG, "Sequential: %" PRId64 " us (%.2f MiB/s)",
+             sequential_time_us, length_mib / ((double)sequential_time_us / 1000000.0));
+    ESP_LOGI(TAG, "Pipelined:  %" PRId64 " us (%.2f MiB/s), %.2fx",
+             pipelined_time_us, length_mib / ((double)pipelined_time_us / 1000000.0),
+             (double)sequential_time_us / (double)pipelined_time_us);
+    print_hex("Image SHA-256: ", pipelined_digest, sizeof(pipelined_digest));
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Arguments for one iv_allocator_test_task().
+ */
+typedef struct {
+    atomic_uint_fast32_t *seen;     // One bit per counter index of this boot
+    uint32_t base_index;            // allocator->issued when the test started
+    atomic_uint_fast32_t *duplicates;
+    SemaphoreHandle_t done;
+    esp_err_t result;
+} iv_test_args_t;
+
+/**
+ * @brief Draws IV_TEST_PER_TASK IVs and marks each counter in a shared bitmap.
+ *
+ * @param arg Pointer to an iv_test_args_t.
+ */
+static void iv_allocator_test_task(void *arg)
+{
+    iv_test_args_t *args = arg;
+    uint8_t iv[GCM_IV_SIZE_BYTES];
+
+    args->result = ESP_OK;
+
+    for (uint32_t count = 0U; count < IV_TEST_PER_TASK && args->result == ESP_OK; ++count) {
+        args->result = iv_allocator_next(&s_iv_allocator, iv);
+
+        // Recover the boot-local index from the big-endian counter field.
+        uint64_t counter = 0U;
+
+        for (size_t byte = IV_FIXED_FIELD_BYTES; byte < GCM_IV_SIZE_BYTES; ++byte) {
+            counter = (counter << 8U) | iv[byte];
+        }
+
+        uint32_t index = (uint32_t)(counter - s_iv_allocator.boot_base) - args->base_index;
+        uint32_t mask = 1U << (index % 32U);
+
+        if (index >= IV_TEST_TASK_COUNT * IV_TEST_PER_TASK ||
+            (atomic_fetch_or(&args->seen[index / 32U], mask) & mask) != 0U) {
+            atomic_fetch_add(args->duplicates, 1U);
+        }
+    }
+
+    xSemaphoreGive(args->done);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Compares allocator IVs with RNG IVs and checks cross-core uniqueness.
+ *
+ * Times BENCHMARK_ITERATIONS IVs from fill_random_bytes() and from the
+ * allocator. Then one task per core draws IV_TEST_PER_TASK IVs concurrently,
+ * enough to cross a reservation block, and every counter must appear once.
+ *
+ * @return ESP_OK when all IVs are unique.
+ */
+static esp_err_t benchmark_iv_allocator(void)
+{
+    static const size_t bitmap_words = (IV_TEST_TASK_COUNT * IV_TEST_PER_TASK + 31U) / 32U;
+
+    uint8_t iv[GCM_IV_SIZE_BYTES];
+    iv_test_args_t args[IV_TEST_TASK_COUNT];
+    atomic_uint_fast32_t duplicates = 0U;
+    esp_err_t ret = ESP_OK;
+
+    // Per-message RNG IVs.
+    int64_t start_time_us = esp_timer_get_time();
+
+    for (uint32_t iteration = 0U; iteration < BENCHMARK_ITERATIONS; ++iteration) {
+        fill_random_bytes(iv, sizeof(iv));
+    }
+
+    int64_t random_time_us = esp_timer_get_time() - start_time_us;
+
+    // Allocator IVs.
+    start_time_us = esp_timer_get_time();
+
+    for (uint32_t iteration = 0U; iteration < BENCHMARK_ITERATIONS && ret == ESP_OK; ++iteration) {
+        ret = iv_allocator_next(&s_iv_allocator, iv);
+    }
+
+    int64_t allocator_time_us = esp_timer_get_time() - start_time_us;
+    ESP_RETURN_ON_ERROR(ret, TAG, "IV allocator benchmark failed");
+
+    ESP_LOGI(TAG, "IV generation: RNG %.3f us/IV, allocator %.3f us/IV",
+             (double)random_time_us / BENCHMARK_ITERATIONS,
+             (double)allocator_time_us / BENCHMARK_ITERATIONS);
+
+    // Concurrent uniqueness check, one task per core.
+    atomic_uint_fast32_t *seen = heap_caps_calloc(bitmap_words, sizeof(*seen), MALLOC_CAP_INTERNAL);
+    SemaphoreHandle_t done = xSemaphoreCreateCounting(IV_TEST_TASK_COUNT, 0U);
+
+    if (seen == NULL || done == NULL) {
+        ret = ESP_ERR_NO_MEM;
+        goto out;
+    }
+
+    uint32_t base_index = atomic_load(&s_iv_allocator.issued);
+    UBaseType_t started = 0U;
+
+    for (UBaseType_t task = 0U; task < IV_TEST_TASK_COUNT; ++task) {
+        args[task] = (iv_test_args_t){
+            .seen = seen,
+            .base_index = base_index,
+            .duplicates = &duplicates,
+            .done = done,
+        };
+
+        if (xTaskCreatePinnedToCore(iv_allocator_test_task, "iv_test", 3072U, &args[task],
+                                    uxTaskPriorityGet(NULL), NULL,
+                                    (BaseType_t)(task % portNUM_PROCESSORS)) != pdPASS) {
+            ret = ESP_ERR_NO_MEM;
+            break;
+        }
+
+        ++started;
+    }
+
+    for (UBaseType_t task = 0U; task < started; ++task) {
+        xSemaphoreTake(done, portMAX_DELAY);
+
+        if (args[task].result != ESP_OK) {
+            ret = args[task].result;
+        }
+    }
+
+    if (ret == ESP_OK && atomic_load(&duplicates) != 0U) {
+        ESP_LOGE(TAG, "IV allocator produced %u duplicate counters", (unsigned)atomic_load(&duplicates));
+        ret = ESP_FAIL;
+    }
+
+    if (ret == ESP_OK) {
+        ESP_LOGI(TAG, "IV allocator: %u IVs from %u tasks unique, reserved to %" PRIu64 ": PASS",
+                 (unsigned)(IV_TEST_TASK_COUNT * IV_TEST_PER_TASK), (unsigned)IV_TEST_TASK_COUNT,
+                 s_iv_allocator.boot_base + atomic_load(&s_iv_allocator.reserved));
+    }
+
+out:
+    heap_caps_free(seen);
+
+    if (done != NULL) {
+        vSemaphoreDelete(done);
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Mbed TLS random callback backed by the hardware RNG.
+ *
+ * @param context Unused.
+ * @param output Destination buffer.
+ * @param length Number of random bytes to generate.
+ *
+ * @return Always 0.
+ */
+static int ecc_random(void *context, unsigned char *output, size_t length)
+{
+    (void)context;
+    fill_random_bytes(output, length);
+    return 0;
+}
+
+/**
+ * @brief Generates a P-256 ECDSA key pair.
+ *
+ * @param context Initialized ECDSA context that receives the key pair.
+ *
+ * @return ESP_OK on success; otherwise ESP_FAIL.
+ */
+static esp_err_t ecdsa_generate_key(mbedtls_ecdsa_context *context)
+{
+    int result = mbedtls_ecdsa_genkey(context, ECC_CURVE, ecc_random, NULL);
+
+    if (result != 0) {
+        ESP_LOGE(TAG, "mbedtls_ecdsa_genkey failed: -0x%04X", -result);
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Signs a SHA-256 digest and writes a DER-encoded ECDSA signature.
+ *
+ * @param context ECDSA context holding the private key.
+ * @param digest Digest to sign.
+ * @param signature Destination buffer of ECDSA_SIGNATURE_MAX_BYTES bytes.
+ * @param signature_length Receives the signature length in bytes.
+ *
+ * @return ESP_OK on success; otherwise ESP_FAIL.
+ */
+static esp_err_t ecdsa_sign_digest(
+    mbedtls_ecdsa_context *context,
+    const uint8_t digest[SHA256_DIGEST_SIZE_BYTES],
+    uint8_t signature[ECDSA_SIGNATURE_MAX_BYTES],
+    size_t *signature_length)
+{
+    int result = mbedtls_ecdsa_write_signature(
+        context,
+        MBEDTLS_MD_SHA256,
+        digest,
+        SHA256_DIGEST_SIZE_BYTES,
+        signature,
+        ECDSA_SIGNATURE_MAX_BYTES,
+        signature_length,
+        ecc_random,
+        NULL);
+
+    if (result != 0) {
+        ESP_LOGE(TAG, "mbedtls_ecdsa_write_signature failed: -0x%04X", -result);
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Verifies a DER-encoded ECDSA signature over a SHA-256 digest.
+ *
+ * @param context ECDSA context holding the public key.
+ * @param digest Digest that was signed.
+ * @param signature Signature to check.
+ * @param signature_length Signature length in bytes.
+ *
+ * @return ESP_OK when the signature is valid.
+ * @return ESP_ERR_INVALID_CRC when the signature does not match.
+ * @return ESP_FAIL for other cryptographic errors.
+ */
+static esp_err_t ecdsa_verify_digest(
+    mbedtls_ecdsa_context *context,
+    const uint8_t digest[SHA256_DIGEST_SIZE_BYTES],
+    const uint8_t *signature,
+    size_t signature_length)
+{
+    int result = mbedtls_ecdsa_read_signature(
+        context,
+        digest,
+        SHA256_DIGEST_SIZE_BYTES,
+        signature,
+        signature_length);
+
+    if (result == MBEDTLS_ERR_ECP_VERIFY_FAILED) {
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    if (result != 0) {
+        ESP_LOGE(TAG, "mbedtls_ecdsa_read_signature failed: -0x%04X", -result);
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief One side of an ephemeral P-256 ECDH exchange.
+ */
+typedef struct {
+    mbedtls_mpi secret;
+    mbedtls_ecp_point public_point;
+} ecdh_party_t;
+
+/**
+ * @brief Generates a fresh ECDH key pair, as a TLS client does per handshake.
+ *
+ * @param group Loaded P-256 group.
+ * @param party Initialized party that receives the key pair.
+ *
+ * @return ESP_OK on success; otherwise ESP_FAIL.
+ */
+static esp_err_t ecdh_generate_key(mbedtls_ecp_group *group, ecdh_party_t *party)
+{
+    int result = mbedtls_ecdh_gen_public(
+        group,
+        &party->secret,
+        &party->public_point,
+        ecc_random,
+        NULL);
+
+    if (result != 0) {
+        ESP_LOGE(TAG, "mbedtls_ecdh_gen_public failed: -0x%04X", -result);
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Computes the ECDH shared secret with a peer's public point.
+ *
+ * @param group Loaded P-256 group.
+ * @param party Local key pair.
+ * @param peer_public Public point received from the peer.
+ * @param shared Destination for the 32-byte big-endian x-coordinate.
+ *
+ * @return ESP_OK on success; otherwise ESP_FAIL.
+ */
+static esp_err_t ecdh_compute_secret(
+    mbedtls_ecp_group *group,
+    ecdh_party_t *party,
+    const mbedtls_ecp_point *peer_public,
+    uint8_t shared[ECC_SHARED_SECRET_BYTES])
+{
+    mbedtls_mpi z;
+    mbedtls_mpi_init(&z);
+
+    int result = mbedtls_ecdh_compute_shared(
+        group,
+        &z,
+        peer_public,
+        &party->secret,
+        ecc_random,
+        NULL);
+
+    if (result == 0) {
+        result = mbedtls_mpi_write_binary(&z, shared, ECC_SHARED_SECRET_BYTES);
+    }
+
+    mbedtls_mpi_free(&z);
+
+    if (result != 0) {
+        ESP_LOGE(TAG, "ECDH shared secret failed: -0x%04X", -result);
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+static void ecdh_party_init(ecdh_party_t *party)
+{
+    mbedtls_mpi_init(&party->secret);
+    mbedtls_ecp_point_init(&party->public_point);
+}
+
+static void ecdh_party_free(ecdh_party_t *party)
+{
+    mbedtls_mpi_free(&party->secret);
+    mbedtls_ecp_point_free(&party->public_point);
+}
+
+/**
+ * @brief Checks ECDSA P-256 sign/verify and ECDH P-256 key agreement.
+ *
+ * A signature must verify against its digest and must fail once one digest
+ * byte changes. Two ECDH parties must derive the same shared secret.
+ *
+ * @return ESP_OK when all checks pass.
+ */
+static esp_err_t run_ecc_self_test(void)
+{
+    static const uint8_t message[] = "firmware manifest v1";
+
+    uint8_t digest[SHA256_DIGEST_SIZE_BYTES];
+    uint8_t signature[ECDSA_SIGNATURE_MAX_BYTES];
+    uint8_t shared_client[ECC_SHARED_SECRET_BYTES];
+    uint8_t shared_server[ECC_SHARED_SECRET_BYTES];
+    size_t signature_length = 0U;
+    mbedtls_ecdsa_context ecdsa;
+    mbedtls_ecp_group group;
+    ecdh_party_t client;
+    ecdh_party_t server;
+    esp_err_t ret;
+
+    mbedtls_ecdsa_init(&ecdsa);
+    mbedtls_ecp_group_init(&group);
+    ecdh_party_init(&client);
+    ecdh_party_init(&server);
+
+    ESP_GOTO_ON_ERROR(calculate_sha256(message, sizeof(message) - 1U, digest), out, TAG,
+                      "SHA-256 operation failed");
+    ESP_GOTO_ON_ERROR(ecdsa_generate_key(&ecdsa), out, TAG, "ECDSA key generation failed");
+    ESP_GOTO_ON_ERROR(ecdsa_sign_digest(&ecdsa, digest, signature, &signature_length), out, TAG,
+                      "ECDSA signing failed");
+    ESP_GOTO_ON_ERROR(ecdsa_verify_digest(&ecdsa, digest, signature, signature_length), out, TAG,
+                      "ECDSA signature did not verify");
+
+    // A signature over a different digest must be rejected.
+    digest[0] ^= 0x01U;
+    ret = ecdsa_verify_digest(&ecdsa, digest, signature, signature_length);
+
+    if (ret != ESP_ERR_INVALID_CRC) {
+        ESP_LOGE(TAG, "ECDSA accepted a signature for a modified digest");
+        ret = ESP_FAIL;
+        goto out;
+    }
+
+    ESP_LOGI(TAG, "ECDSA P-256 sign/verify test: PASS");
+
+    if (mbedtls_ecp_group_load(&group, ECC_CURVE) != 0) {
+        ESP_LOGE(TAG, "mbedtls_ecp_group_load failed");
+        ret = ESP_FAIL;
+        goto out;
+    }
+
+    ESP_GOTO_ON_ERROR(ecdh_generate_key(&group, &client), out, TAG, "ECDH key generation failed");
+    ESP_GOTO_ON_ERROR(ecdh_generate_key(&group, &server), out, TAG, "ECDH key generation failed");
+    ESP_GOTO_ON_ERROR(ecdh_compute_secret(&group, &client, &server.public_point, shared_client),
+                      out, TAG, "ECDH failed");
+    ESP_GOTO_ON_ERROR(ecdh_compute_secret(&group, &server, &client.public_point, shared_server),
+                      out, TAG, "ECDH failed");
+
+    if (!buffers_equal(shared_client, shared_server, sizeof(shared_client))) {
+        ESP_LOGE(TAG, "ECDH parties derived different secrets");
+        ret = ESP_FAIL;
+        goto out;
+    }
+
+    ESP_LOGI(TAG, "ECDH P-256 key agreement test: PASS");
+    ret = ESP_OK;
+
+out:
+    memset(shared_client, 0, sizeof(shared_client));
+    memset(shared_server, 0, sizeof(shared_server));
+    ecdh_party_free(&client);
+    ecdh_party_free(&server);
+    mbedtls_ecp_group_free(&group);
+    mbedtls_ecdsa_free(&ecdsa);
+    return ret;
+}
+
+/**
+ * @brief Measures the P-256 operations of a TLS handshake.
+ *
+ * Times ECDSA signing and verification, ECDH key generation, and the ECDH
+ * shared secret. Whether these run on the MPI or ECC peripheral or in
+ * software is fixed by the Mbed TLS configuration; build with
+ * sdkconfig.defaults.software to measure the software path.
+ *
+ * The closing estimate adds what a client spends on ECC per full
+ * ECDHE-ECDSA handshake: one ephemeral key pair, one shared secret, and
+ * ECC_HANDSHAKE_VERIFIES signature checks (the server's key exchange and
+ * its certificate). A resumed session skips all of them.
+ *
+ * @return ESP_OK when all benchmark operations complete successfully.
+ */
+static esp_err_t benchmark_ecc(void)
+{
+    uint8_t digest[SHA256_DIGEST_SIZE_BYTES];
+    uint8_t signature[ECDSA_SIGNATURE_MAX_BYTES];
+    uint8_t shared[ECC_SHARED_SECRET_BYTES];
+    size_t signature_length = 0U;
+    mbedtls_ecdsa_context ecdsa;
+    mbedtls_ecp_group group;
+    ecdh_party_t local;
+    ecdh_party_t peer;
+    int64_t sign_time_us = 0;
+    int64_t verify_time_us = 0;
+    int64_t keygen_time_us = 0;
+    int64_t shared_time_us = 0;
+    esp_err_t ret = ESP_OK;
+
+    mbedtls_ecdsa_init(&ecdsa);
+    mbedtls_ecp_group_init(&group);
+    ecdh_party_init(&local);
+    ecdh_party_init(&peer);
+
+    fill_random_bytes(digest, sizeof(digest));
+    ESP_GOTO_ON_ERROR(ecdsa_generate_key(&ecdsa), out, TAG, "ECDSA key generation failed");
+
+    if (mbedtls_ecp_group_load(&group, ECC_CURVE) != 0) {
+        ESP_LOGE(TAG, "mbedtls_ecp_group_load failed");
+        ret = ESP_FAIL;
+        goto out;
+    }
+
+    ESP_GOTO_ON_ERROR(ecdh_generate_key(&group, &peer), out, TAG, "ECDH key generation failed");
+
+    for (uint32_t iteration = 0U; iteration < ECC_BENCHMARK_ITERATIONS; ++iteration) {
+        // Sign a different digest every time, as for distinct handshakes.
+        digest[iteration % sizeof(digest)]++;
+
+        int64_t start_time_us = esp_timer_get_time();
+        ret = ecdsa_sign_digest(&ecdsa, digest, signature, &signature_length);
+        sign_time_us += esp_timer_get_time() - start_time_us;
+        ESP_GOTO_ON_ERROR(ret, out, TAG, "ECDSA benchmark failed at iteration %" PRIu32, iteration);
+
+        start_time_us = esp_timer_get_time();
+        ret = ecdsa_verify_digest(&ecdsa, digest, signature, signature_length);
+        verify_time_us += esp_timer_get_time() - start_time_us;
+        ESP_GOTO_ON_ERROR(ret, out, TAG, "ECDSA benchmark failed at iteration %" PRIu32, iteration);
+
+        start_time_us = esp_timer_get_time();
+        ret = ecdh_generate_key(&group, &local);
+        keygen_time_us += esp_timer_get_time() - start_time_us;
+        ESP_GOTO_ON_ERROR(ret, out, TAG, "ECDH benchmark failed at iteration %" PRIu32, iteration);
+
+        start_time_us = esp_timer_get_time();
+        ret = ecdh_compute_secret(&group, &local, &peer.public_point, shared);
+        shared_time_us += esp_timer_get_time() - start_time_us;
+        ESP_GOTO_ON_ERROR(ret, out, TAG, "ECDH benchmark failed at iteration %" PRIu32, iteration);
+    }
+
+    double sign_ms = (double)sign_time_us / 1000.0 / ECC_BENCHMARK_ITERATIONS;
+    double verify_ms = (double)verify_time_us / 1000.0 / ECC_BENCHMARK_ITERATIONS;
+    double keygen_ms = (double)keygen_time_us / 1000.0 / ECC_BENCHMARK_ITERATIONS;
+    double shared_ms = (double)shared_time_us / 1000.0 / ECC_BENCHMARK_ITERATIONS;
+
+    ESP_LOGI(TAG, "ECC P-256 benchmark (%u operations each):", (unsigned)ECC_BENCHMARK_ITERATIONS);
+    ESP_LOGI(TAG, "  ECDSA sign     %8.2f ms/op  %6.1f op/s", sign_ms, 1000.0 / sign_ms);
+    ESP_LOGI(TAG, "  ECDSA verify   %8.2f ms/op  %6.1f op/s", verify_ms, 1000.0 / verify_ms);
+    ESP_LOGI(TAG, "  ECDH key pair  %8.2f ms/op  %6.1f op/s", keygen_ms, 1000.0 / keygen_ms);
+    ESP_LOGI(TAG, "  ECDH secret    %8.2f ms/op  %6.1f op/s", shared_ms, 1000.0 / shared_ms);
+    ESP_LOGI(TAG, "TLS client ECC per full handshake: %.2f ms",
+             keygen_ms + shared_ms + ECC_HANDSHAKE_VERIFIES * verify_ms);
+
+out:
+    memset(shared, 0, sizeof(shared));
+    ecdh_party_free(&local);
+    ecdh_party_free(&peer);
+    mbedtls_ecp_group_free(&group);
+    mbedtls_ecdsa_free(&ecdsa);
+    return ret;
+}
+
 /**
  * @brief Prints basic chip and build configuration information.
  */
@@ -620,24 +2320,54 @@ static void print_platform_information(void)
     ESP_LOGW(TAG, "Mbed TLS hardware AES: disabled");
 #endif
 
+#if CONFIG_MBEDTLS_AES_HW_SMALL_DATA_LEN_OPTIM
+    ESP_LOGI(TAG, "Mbed TLS AES block mode for small inputs: enabled");
+#endif
+
 #if CONFIG_MBEDTLS_HARDWARE_SHA
     ESP_LOGI(TAG, "Mbed TLS hardware SHA: enabled");
 #else
     ESP_LOGW(TAG, "Mbed TLS hardware SHA: disabled");
 #endif
+
+#if CONFIG_MBEDTLS_HARDWARE_MPI
+    ESP_LOGI(TAG, "Mbed TLS hardware MPI: enabled");
+#else
+    ESP_LOGW(TAG, "Mbed TLS hardware MPI: disabled");
+#endif
+
+#if CONFIG_MBEDTLS_HARDWARE_ECC
+    ESP_LOGI(TAG, "Mbed TLS hardware ECC: enabled");
+#elif SOC_ECC_SUPPORTED
+    ESP_LOGW(TAG, "Mbed TLS hardware ECC: disabled");
+#endif
 }
 
 /**
  * @brief Application entry point.
  *
  * Runs known-answer validation, an authenticated-encryption demonstration,
- * tamper detection, and AES/SHA performance benchmarks.
+ * tamper detection, a streamed-session check, ECDSA and ECDH checks, and
+ * AES/SHA/ECC performance benchmarks.
  */
 void app_main(void)
 {
     ESP_LOGI(TAG, "ESP32-S3 hardware-accelerated cryptography demo");
     print_platform_information();
 
+    // Initialize NVS for the IV allocator's fixed field and counter reservation.
+    esp_err_t err = nvs_flash_init();
+
+    if (err == ESP_ERR_NVS_NO_FREE_PAGES || err == ESP_ERR_NVS_NEW_VERSION_FOUND) {
+        // Erasing also drops the IV state; a new random fixed field keeps IVs distinct.
+        ESP_LOGW(TAG, "NVS partition was truncated or upgraded; erasing");
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        err = nvs_flash_init();
+    }
+
+    ESP_ERROR_CHECK(err);
+    ESP_ERROR_CHECK(iv_allocator_init(&s_iv_allocator));
+
     // Run AES-GCM known-answer test.
     ESP_ERROR_CHECK(run_aes_gcm_known_answer_test());
     
@@ -646,12 +2376,33 @@ void app_main(void)
     
     // Run authenticated-encryption demonstration and tamper detection.
     ESP_ERROR_CHECK(run_authenticated_encryption_demo());
+
+    // Check that streamed session output matches the one-shot functions.
+    ESP_ERROR_CHECK(run_aes_gcm_session_test());
+
+    // Check ECDSA signatures and ECDH agreement before timing them.
+    ESP_ERROR_CHECK(run_ecc_self_test());
     
     // Run AES-GCM benchmark first because it does not modify the input buffer.
     ESP_ERROR_CHECK(benchmark_aes_gcm());
+
+    // Compare per-message setup cost with a reused session across packet sizes.
+    ESP_ERROR_CHECK(benchmark_aes_gcm_session());
+
+    // Sweep sizes, modes, and buffer placement to find the DMA crossover points.
+    ESP_ERROR_CHECK(benchmark_aes_sweep());
     
     // Run SHA-256 benchmark last because it modifies the input buffer on every iteration.
     ESP_ERROR_CHECK(benchmark_sha256());
 
+    // Verify the app image from flash on one core, then with read-ahead on the other core.
+    ESP_ERROR_CHECK(benchmark_image_verification());
+
+    // Compare allocator IVs with RNG IVs and check uniqueness across cores.
+    ESP_ERROR_CHECK(benchmark_iv_allocator());
+
+    // Time the P-256 operations that dominate a TLS handshake.
+    ESP_ERROR_CHECK(benchmark_ecc());
+
     ESP_LOGI(TAG, "All cryptographic tests completed successfully");
 }
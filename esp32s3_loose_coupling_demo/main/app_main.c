@@ -4,7 +4,7 @@
 #include "app_event.h"
 #include "button_input.h"
 #include "climate_controller.h"
-#include "event_queue.h"
+#include "event_bus.h"
 #include "fake_temperature.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -12,48 +12,50 @@
 #include "pwm_fan.h"
 
 #define APP_TAG                       "APP"
-#define APP_EVENT_QUEUE_LENGTH        16u
 #define APP_TEMP_TASK_PERIOD_MS       1000u
 #define APP_CONTROL_TASK_STACK_WORDS  4096u
 #define APP_TEMP_TASK_STACK_WORDS     3072u
+#define APP_STATUS_TASK_STACK_WORDS   3072u
 #define APP_CONTROL_TASK_PRIORITY     5u
 #define APP_TEMP_TASK_PRIORITY        4u
+#define APP_STATUS_TASK_PRIORITY      3u
 #define APP_FAN_ON_THRESHOLD_C        40
 #define APP_FAN_OFF_THRESHOLD_C       35
 
-static event_queue_t s_event_queue;
+static event_bus_t s_event_bus;
+static event_publisher_t s_button_publisher;
+static event_publisher_t s_temperature_publisher;
+static event_publisher_t s_control_publisher;
+static event_subscriber_t s_control_subscriber;
+static event_subscriber_t s_status_subscriber;
 static climate_controller_t s_climate_controller;
 static bool s_previous_fan_state = false;
 
 /**
- * @brief Forwards button events from the input module to the application queue.
+ * @brief Publishes button events from the input module on the event bus.
+ *
+ * Runs in interrupt context; publishing from an ISR is lock-free.
  *
  * Args:
  *     event: Button event generated by the input module.
- *     context: Pointer to the application event queue.
+ *     context: Pointer to the button publisher.
  */
 static void app_button_event_callback(app_event_t event, void *context)
 {
-    BaseType_t higher_priority_task_woken = pdFALSE;
-    event_queue_t *queue = (event_queue_t *)context;
-
-    (void)event_queue_push_from_isr(queue, &event, &higher_priority_task_woken);
+    event_publisher_t *publisher = (event_publisher_t *)context;
 
-    if (higher_priority_task_woken == pdTRUE)
-    {
-        portYIELD_FROM_ISR();
-    }
+    (void)event_bus_publish_from_isr(publisher, &event);
 }
 
 /**
- * @brief Publishes periodic temperature samples to the application event queue.
+ * @brief Publishes periodic temperature samples on the event bus.
  *
  * Args:
- *     argument: Pointer to the application event queue.
+ *     argument: Pointer to the temperature publisher.
  */
 static void temperature_task(void *argument)
 {
-    event_queue_t *queue = (event_queue_t *)argument;
+    event_publisher_t *publisher = (event_publisher_t *)argument;
 
     while (true)
     {
@@ -69,7 +71,7 @@ static void temperature_task(void *argument)
                 .data.temperature_c = temperature_c
             };
 
-            (void)event_queue_push(queue, &event, pdMS_TO_TICKS(50));
+            (void)event_bus_publish(publisher, &event);
         }
 
         vTaskDelay(pdMS_TO_TICKS(APP_TEMP_TASK_PERIOD_MS));
@@ -79,17 +81,19 @@ static void temperature_task(void *argument)
 /**
  * @brief Processes application events and updates loosely coupled services.
  *
+ * Publishes a fan state event whenever the climate controller switches the fan.
+ *
  * Args:
- *     argument: Pointer to the application event queue.
+ *     argument: Pointer to the control subscriber.
  */
 static void control_task(void *argument)
 {
-    event_queue_t *queue = (event_queue_t *)argument;
+    event_subscriber_t *subscriber = (event_subscriber_t *)argument;
     app_event_t event;
 
     while (true)
     {
-        if (event_queue_pop(queue, &event, portMAX_DELAY))
+        if (event_bus_receive(subscriber, &event, portMAX_DELAY))
         {
             switch (event.type)
             {
@@ -106,8 +110,14 @@ static void control_task(void *argument)
 
                     if (fan_state != s_previous_fan_state)
                     {
+                        app_event_t fan_event =
+                        {
+                            .type = APP_EVENT_FAN_STATE_CHANGED,
+                            .data.fan_percent = fan_percent
+                        };
+
                         s_previous_fan_state = fan_state;
-                        logger_info(APP_TAG, fan_state ? "fan state changed to ON" : "fan state changed to OFF");
+                        (void)event_bus_publish(&s_control_publisher, &fan_event);
                     }
                     break;
                 }
@@ -127,6 +137,44 @@ static void control_task(void *argument)
     }
 }
 
+/**
+ * @brief Reports fan state changes and button presses.
+ *
+ * A second subscriber to the button topic: both tasks receive every press
+ * from the same ISR publish.
+ *
+ * Args:
+ *     argument: Pointer to the status subscriber.
+ */
+static void status_task(void *argument)
+{
+    event_subscriber_t *subscriber = (event_subscriber_t *)argument;
+    app_event_t event;
+    uint32_t button_presses = 0;
+
+    while (true)
+    {
+        if (!event_bus_receive(subscriber, &event, portMAX_DELAY))
+        {
+            continue;
+        }
+
+        if (event.type == APP_EVENT_FAN_STATE_CHANGED)
+        {
+            logger_info(APP_TAG, (event.data.fan_percent > 0u) ? "fan state changed to ON" : "fan state changed to OFF");
+        }
+        else if (event.type == APP_EVENT_BUTTON_PRESSED)
+        {
+            button_presses++;
+            logger_infof(APP_TAG,
+                         "status: %lu button presses, %lu events dropped",
+                         (unsigned long)button_presses,
+                         (unsigned long)(event_bus_dropped(&s_control_subscriber) +
+                                         event_bus_dropped(subscriber)));
+        }
+    }
+}
+
 /**
  * @brief Application entry point.
  */
@@ -136,10 +184,24 @@ void app_main(void)
     logger_init();
     logger_info(APP_TAG, "ESP32-S3 loose coupling demo started");
 
-    // Initialize the application event queue
-    if (!event_queue_init(&s_event_queue, APP_EVENT_QUEUE_LENGTH))
+    // Set up the event bus: all publishers and subscribers are added before any task runs
+    bool bus_ready = event_bus_init(&s_event_bus) &&
+                     event_bus_add_publisher(&s_event_bus, &s_button_publisher, true) &&
+                     event_bus_add_publisher(&s_event_bus, &s_temperature_publisher, false) &&
+                     event_bus_add_publisher(&s_event_bus, &s_control_publisher, false) &&
+                     event_bus_subscribe(&s_event_bus,
+                                         &s_control_subscriber,
+                                         EVENT_BUS_TOPIC(APP_EVENT_TEMPERATURE_SAMPLE) |
+                                         EVENT_BUS_TOPIC(APP_EVENT_BUTTON_PRESSED) |
+                                         EVENT_BUS_TOPIC(APP_EVENT_BUTTON_RELEASED)) &&
+                     event_bus_subscribe(&s_event_bus,
+                                         &s_status_subscriber,
+                                         EVENT_BUS_TOPIC(APP_EVENT_FAN_STATE_CHANGED) |
+                                         EVENT_BUS_TOPIC(APP_EVENT_BUTTON_PRESSED));
+
+    if (!bus_ready)
     {
-        logger_info(APP_TAG, "failed to create event queue");
+        logger_info(APP_TAG, "failed to set up event bus");
         return;
     }
 
@@ -156,14 +218,14 @@ void app_main(void)
                             APP_FAN_OFF_THRESHOLD_C);
 
     // Register the button event callback and initialize the button input module
-    button_input_register_callback(app_button_event_callback, &s_event_queue);
+    button_input_register_callback(app_button_event_callback, &s_button_publisher);
     button_input_init();
 
-    // Create the control and temperature tasks
+    // Create the control task
     (void)xTaskCreate(control_task,
                       "control_task",
                       APP_CONTROL_TASK_STACK_WORDS,
-                      &s_event_queue,
+                      &s_control_subscriber,
                       APP_CONTROL_TASK_PRIORITY,
                       0);
 
@@ -171,7 +233,15 @@ void app_main(void)
     (void)xTaskCreate(temperature_task,
                       "temperature_task",
                       APP_TEMP_TASK_STACK_WORDS,
-                      &s_event_queue,
+                      &s_temperature_publisher,
                       APP_TEMP_TASK_PRIORITY,
                       0);
+
+    // Create the status task
+    (void)xTaskCreate(status_task,
+                      "status_task",
+                      APP_STATUS_TASK_STACK_WORDS,
+                      &s_status_subscriber,
+                      APP_STATUS_TASK_PRIORITY,
+                      0);
 }
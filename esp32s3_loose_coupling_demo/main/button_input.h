@@ -2,7 +2,6 @@
 #define BUTTON_INPUT_H
 
 #include "app_event.h"
-#include "event_queue.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -0,0 +1,333 @@
+#include "event_bus.h"
+
+#include <string.h>
+
+#include "esp_attr.h"
+
+/**
+ * @brief Appends an event to a ring; called only by the ring's publisher.
+ *
+ * Args:
+ *     ring: Ring to write.
+ *     event: Event to append.
+ *
+ * Returns:
+ *     true if the event was stored, false if the ring was full.
+ */
+static IRAM_ATTR bool event_ring_push(event_ring_t *ring, const app_event_t *event)
+{
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+    if ((tail - head) >= EVENT_BUS_RING_LENGTH)
+    {
+        atomic_store_explicit(&ring->dropped,
+                              atomic_load_explicit(&ring->dropped, memory_order_relaxed) + 1u,
+                              memory_order_relaxed);
+        return false;
+    }
+
+    ring->slots[tail & (EVENT_BUS_RING_LENGTH - 1u)] = *event;
+
+    // Release: the slot contents become visible before the new tail
+    atomic_store_explicit(&ring->tail, tail + 1u, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Removes the oldest event from a ring; called only by the subscriber.
+ *
+ * Args:
+ *     ring: Ring to read.
+ *     event: Destination event object.
+ *
+ * Returns:
+ *     true if an event was removed, false if the ring was empty.
+ */
+static bool event_ring_pop(event_ring_t *ring, app_event_t *event)
+{
+    uint32_t head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if (head == tail)
+    {
+        return false;
+    }
+
+    *event = ring->slots[head & (EVENT_BUS_RING_LENGTH - 1u)];
+
+    // Release: the slot is read before the publisher may reuse it
+    atomic_store_explicit(&ring->head, head + 1u, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Copies an event into the ring of every matching subscriber.
+ *
+ * Args:
+ *     publisher: Publishing side.
+ *     event: Event to publish.
+ *     notify: true to wake each subscriber that received the event.
+ *
+ * Returns:
+ *     true if no matching subscriber had a full ring, otherwise false.
+ */
+static IRAM_ATTR bool event_bus_deliver(event_publisher_t *publisher,
+                                        const app_event_t *event,
+                                        bool notify)
+{
+    event_bus_t *bus = publisher->bus;
+    event_topic_mask_t topic = EVENT_BUS_TOPIC(event->type);
+    uint32_t count = atomic_load_explicit(&bus->subscriber_count, memory_order_acquire);
+    bool delivered = true;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        event_subscriber_t *subscriber = bus->subscribers[i];
+
+        if ((subscriber->topics & topic) == 0u)
+        {
+            continue;
+        }
+
+        if (!event_ring_push(&subscriber->rings[publisher->index], event))
+        {
+            delivered = false;
+            continue;
+        }
+
+        if (notify)
+        {
+            TaskHandle_t task = atomic_load_explicit(&subscriber->task, memory_order_acquire);
+
+            if (task != 0)
+            {
+                (void)xTaskNotifyGive(task);
+            }
+        }
+    }
+
+    return delivered;
+}
+
+/**
+ * @brief Initializes the event bus.
+ *
+ * Args:
+ *     bus: Pointer to the event bus instance.
+ *
+ * Returns:
+ *     true if the bus was initialized successfully, false otherwise.
+ */
+bool event_bus_init(event_bus_t *bus)
+{
+    if (bus == 0)
+    {
+        return false;
+    }
+
+    memset(bus, 0, sizeof(*bus));
+    return true;
+}
+
+/**
+ * @brief Adds a publisher to the bus.
+ *
+ * Args:
+ *     bus: Pointer to the event bus instance.
+ *     publisher: Pointer to the publisher to initialize.
+ *     from_isr: Whether the publisher runs in interrupt context.
+ *
+ * Returns:
+ *     true if the publisher was added successfully, false otherwise.
+ */
+bool event_bus_add_publisher(event_bus_t *bus,
+                             event_publisher_t *publisher,
+                             bool from_isr)
+{
+    if ((bus == 0) || (publisher == 0) || (bus->publisher_count >= EVENT_BUS_MAX_PUBLISHERS))
+    {
+        return false;
+    }
+
+    publisher->bus = bus;
+    publisher->index = bus->publisher_count++;
+    publisher->from_isr = from_isr;
+
+    if (from_isr)
+    {
+        bus->has_isr_publishers = true;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Adds a subscriber to the bus.
+ *
+ * Args:
+ *     bus: Pointer to the event bus instance.
+ *     subscriber: Pointer to the subscriber to initialize.
+ *     topics: Topics the subscriber receives.
+ *
+ * Returns:
+ *     true if the subscriber was added successfully, false otherwise.
+ */
+bool event_bus_subscribe(event_bus_t *bus,
+                         event_subscriber_t *subscriber,
+                         event_topic_mask_t topics)
+{
+    if ((bus == 0) || (subscriber == 0))
+    {
+        return false;
+    }
+
+    uint32_t count = atomic_load_explicit(&bus->subscriber_count, memory_order_relaxed);
+
+    if (count >= EVENT_BUS_MAX_SUBSCRIBERS)
+    {
+        return false;
+    }
+
+    memset(subscriber, 0, sizeof(*subscriber));
+    subscriber->bus = bus;
+    subscriber->topics = topics;
+    bus->subscribers[count] = subscriber;
+
+    // Release: publishers only see the new count once the subscriber is set up
+    atomic_store_explicit(&bus->subscriber_count, count + 1u, memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Publishes an event from a task.
+ *
+ * Args:
+ *     publisher: Pointer to the publisher.
+ *     event: Pointer to the event to publish.
+ *
+ * Returns:
+ *     true if the event reached every matching subscriber, false otherwise.
+ */
+bool event_bus_publish(event_publisher_t *publisher, const app_event_t *event)
+{
+    if ((publisher == 0) || (publisher->bus == 0) || (event == 0))
+    {
+        return false;
+    }
+
+    return event_bus_deliver(publisher, event, true);
+}
+
+/**
+ * @brief Publishes an event from an interrupt service routine.
+ *
+ * Args:
+ *     publisher: Pointer to the publisher.
+ *     event: Pointer to the event to publish.
+ *
+ * Returns:
+ *     true if the event reached every matching subscriber, false otherwise.
+ */
+IRAM_ATTR bool event_bus_publish_from_isr(event_publisher_t *publisher, const app_event_t *event)
+{
+    if ((publisher == 0) || (publisher->bus == 0) || (event == 0))
+    {
+        return false;
+    }
+
+    // Task notifications would take the kernel spinlock, so subscribers poll instead
+    return event_bus_deliver(publisher, event, false);
+}
+
+/**
+ * @brief Receives an event for a subscriber.
+ *
+ * Args:
+ *     subscriber: Pointer to the subscriber.
+ *     event: Pointer to the event to fill.
+ *     timeout_ticks: Timeout in ticks.
+ *
+ * Returns:
+ *     true if an event was received, false otherwise.
+ */
+bool event_bus_receive(event_subscriber_t *subscriber,
+                       app_event_t *event,
+                       TickType_t timeout_ticks)
+{
+    if ((subscriber == 0) || (subscriber->bus == 0) || (event == 0))
+    {
+        return false;
+    }
+
+    event_bus_t *bus = subscriber->bus;
+    TickType_t start = xTaskGetTickCount();
+
+    if (atomic_load_explicit(&subscriber->task, memory_order_relaxed) == 0)
+    {
+        atomic_store_explicit(&subscriber->task, xTaskGetCurrentTaskHandle(), memory_order_release);
+    }
+
+    while (true)
+    {
+        for (uint32_t n = 0; n < bus->publisher_count; n++)
+        {
+            uint32_t index = subscriber->next_ring;
+
+            subscriber->next_ring = (index + 1u) % bus->publisher_count;
+
+            if (event_ring_pop(&subscriber->rings[index], event))
+            {
+                return true;
+            }
+        }
+
+        TickType_t elapsed = xTaskGetTickCount() - start;
+        TickType_t wait = portMAX_DELAY;
+
+        if (timeout_ticks != portMAX_DELAY)
+        {
+            if (elapsed >= timeout_ticks)
+            {
+                return false;
+            }
+
+            wait = timeout_ticks - elapsed;
+        }
+
+        if (bus->has_isr_publishers && (wait > pdMS_TO_TICKS(EVENT_BUS_ISR_POLL_MS)))
+        {
+            wait = pdMS_TO_TICKS(EVENT_BUS_ISR_POLL_MS);
+        }
+
+        // A publish after the scan above leaves the notification pending,
+        // so this returns at once instead of missing the event
+        (void)ulTaskNotifyTake(pdTRUE, wait);
+    }
+}
+
+/**
+ * @brief Sums the events dropped for a subscriber.
+ *
+ * Args:
+ *     subscriber: Pointer to the subscriber.
+ *
+ * Returns:
+ *     Number of events dropped because a ring was full.
+ */
+uint32_t event_bus_dropped(const event_subscriber_t *subscriber)
+{
+    uint32_t dropped = 0;
+
+    if ((subscriber == 0) || (subscriber->bus == 0))
+    {
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < subscriber->bus->publisher_count; i++)
+    {
+        dropped += atomic_load_explicit(&subscriber->rings[i].dropped, memory_order_relaxed);
+    }
+
+    return dropped;
+}
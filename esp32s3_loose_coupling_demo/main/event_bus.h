@@ -0,0 +1,182 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "app_event.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EVENT_BUS_MAX_PUBLISHERS   4u
+#define EVENT_BUS_MAX_SUBSCRIBERS  4u
+
+/* Must be a power of two */
+#define EVENT_BUS_RING_LENGTH      16u
+
+/* How often a waiting subscriber checks for events published from an ISR */
+#define EVENT_BUS_ISR_POLL_MS      10u
+
+/* Topic bit of an event type; every app_event_type_t value is a topic */
+#define EVENT_BUS_TOPIC(type)      (1ul << (uint32_t)(type))
+
+typedef uint32_t event_topic_mask_t;
+
+/*
+ * Single-producer single-consumer ring between one publisher and one
+ * subscriber. head is written only by the subscriber, tail and dropped only
+ * by the publisher, so neither side needs a lock.
+ */
+typedef struct
+{
+    app_event_t slots[EVENT_BUS_RING_LENGTH];
+    _Atomic uint32_t head;
+    _Atomic uint32_t tail;
+    _Atomic uint32_t dropped;
+} event_ring_t;
+
+struct event_bus;
+
+typedef struct
+{
+    struct event_bus *bus;
+    event_topic_mask_t topics;
+    _Atomic(TaskHandle_t) task;
+    uint32_t next_ring;
+    event_ring_t rings[EVENT_BUS_MAX_PUBLISHERS];
+} event_subscriber_t;
+
+typedef struct
+{
+    struct event_bus *bus;
+    uint32_t index;
+    bool from_isr;
+} event_publisher_t;
+
+typedef struct event_bus
+{
+    event_subscriber_t *subscribers[EVENT_BUS_MAX_SUBSCRIBERS];
+    _Atomic uint32_t subscriber_count;
+    uint32_t publisher_count;
+    bool has_isr_publishers;
+} event_bus_t;
+
+/**
+ * @brief Initializes an empty event bus.
+ *
+ * Publishers and subscribers are added during startup, before any event is
+ * published.
+ *
+ * Args:
+ *     bus: Bus object to initialize.
+ *
+ * Returns:
+ *     true if the bus was initialized, otherwise false.
+ */
+bool event_bus_init(event_bus_t *bus);
+
+/**
+ * @brief Registers a publisher on the bus.
+ *
+ * Every publisher gets its own ring in each subscriber, so one publisher
+ * object must only be used from one task or one ISR.
+ *
+ * Args:
+ *     bus: Bus object.
+ *     publisher: Publisher object to initialize.
+ *     from_isr: true if the publisher will call event_bus_publish_from_isr().
+ *
+ * Returns:
+ *     true if the publisher was added, false if the bus is full.
+ */
+bool event_bus_add_publisher(event_bus_t *bus,
+                             event_publisher_t *publisher,
+                             bool from_isr);
+
+/**
+ * @brief Subscribes to a set of topics.
+ *
+ * The subscriber is bound to the task that first calls event_bus_receive()
+ * on it.
+ *
+ * Args:
+ *     bus: Bus object.
+ *     subscriber: Subscriber object to initialize.
+ *     topics: Bitmask of EVENT_BUS_TOPIC() values to receive.
+ *
+ * Returns:
+ *     true if the subscriber was added, false if the bus is full.
+ */
+bool event_bus_subscribe(event_bus_t *bus,
+                         event_subscriber_t *subscriber,
+                         event_topic_mask_t topics);
+
+/**
+ * @brief Publishes an event from task context.
+ *
+ * The event is copied into the ring of every subscriber whose topics match
+ * and those subscribers are woken. Never blocks; a full ring drops the event
+ * for that subscriber only.
+ *
+ * Args:
+ *     publisher: Publisher object owned by the calling task.
+ *     event: Event to publish.
+ *
+ * Returns:
+ *     true if every matching subscriber got the event, otherwise false.
+ */
+bool event_bus_publish(event_publisher_t *publisher, const app_event_t *event);
+
+/**
+ * @brief Publishes an event from interrupt context.
+ *
+ * Lock-free: the event is only written to the subscriber rings, without any
+ * kernel call. Waiting subscribers pick it up within EVENT_BUS_ISR_POLL_MS.
+ *
+ * Args:
+ *     publisher: Publisher object owned by the calling ISR.
+ *     event: Event to publish.
+ *
+ * Returns:
+ *     true if every matching subscriber got the event, otherwise false.
+ */
+bool event_bus_publish_from_isr(event_publisher_t *publisher, const app_event_t *event);
+
+/**
+ * @brief Receives the next event for a subscriber.
+ *
+ * Rings are served round-robin so one busy publisher cannot starve another.
+ *
+ * Args:
+ *     subscriber: Subscriber object owned by the calling task.
+ *     event: Destination event object.
+ *     timeout_ticks: Maximum time to wait for an event.
+ *
+ * Returns:
+ *     true if an event was received, otherwise false.
+ */
+bool event_bus_receive(event_subscriber_t *subscriber,
+                       app_event_t *event,
+                       TickType_t timeout_ticks);
+
+/**
+ * @brief Counts events dropped for a subscriber because its rings were full.
+ *
+ * Args:
+ *     subscriber: Subscriber object.
+ *
+ * Returns:
+ *     Number of dropped events.
+ */
+uint32_t event_bus_dropped(const event_subscriber_t *subscriber);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,352 @@
+/**
+ * @file
+ * @brief Program-counter sampling to find hot code running from flash
+ */
+
+#include "hot_path_profiler.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "sdkconfig.h"
+
+#if CONFIG_HOT_PATH_PROFILER
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "driver/gptimer.h"
+#include "esp_attr.h"
+#include "esp_cpu.h"
+#include "esp_log.h"
+#include "soc/soc.h"
+
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
+#include "xtensa_context.h"
+#else
+#include "riscv/rvruntime-frames.h"
+#endif
+
+#if CONFIG_HOT_PATH_PROFILER_STALL_COUNTER
+#include "xtensa-debug-module.h"
+#include "xtensa_perfmon_access.h"
+#include "xtensa_perfmon_masks.h"
+#endif
+
+static const char *TAG = "hot_path";
+
+#define TIMER_RESOLUTION_HZ 1000000U
+#define SETUP_STACK_BYTES   3072
+#define MAX_PROBES          16U
+#define STALL_COUNTER_ID    0
+
+#if CONFIG_HOT_PATH_PROFILER_STALL_COUNTER
+#define STALL_COUNTED 1
+#else
+#define STALL_COUNTED 0
+#endif
+
+_Static_assert((CONFIG_HOT_PATH_PROFILER_SLOTS & (CONFIG_HOT_PATH_PROFILER_SLOTS - 1)) == 0,
+               "CONFIG_HOT_PATH_PROFILER_SLOTS must be a power of two");
+
+/* One sampled address. pc == 0 marks a free slot. */
+typedef struct {
+    uint32_t pc;
+    uint32_t samples;
+    uint32_t stall_cycles;
+} pc_slot_t;
+
+typedef struct {
+    int core;
+    esp_err_t result;
+    SemaphoreHandle_t done;
+} setup_args_t;
+
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static pc_slot_t s_slots[CONFIG_HOT_PATH_PROFILER_SLOTS];
+static uint32_t s_samples;
+static uint32_t s_flash_samples;
+static uint32_t s_idle_samples;
+static uint32_t s_dropped;
+
+static gptimer_handle_t s_timers[portNUM_PROCESSORS];
+static TaskHandle_t s_idle_tasks[portNUM_PROCESSORS];
+#if CONFIG_HOT_PATH_PROFILER_STALL_COUNTER
+static uint32_t s_last_stall[portNUM_PROCESSORS];
+#endif
+static uint32_t s_sampled_cores;
+static bool s_running;
+
+static inline bool IRAM_ATTR pc_in_flash(uint32_t pc)
+{
+    return pc >= SOC_IROM_LOW && pc < SOC_IROM_HIGH;
+}
+
+#if CONFIG_HOT_PATH_PROFILER_STALL_COUNTER
+/* xtensa_perfmon_value() lives in flash; the ISR must not touch flash. */
+static inline uint32_t IRAM_ATTR read_stall_counter(void)
+{
+    uint32_t value;
+    __asm__ volatile("rer %0, %1" : "=r"(value) : "r"(ERI_PERFMON_PM0 + STALL_COUNTER_ID * 4));
+    return value;
+}
+#endif
+
+/**
+ * @brief Return the PC the current task was interrupted at
+ *
+ * On the outermost interrupt entry both FreeRTOS ports store the stack
+ * pointer, which then points at the saved exception frame, in pxTopOfStack,
+ * the first member of the TCB. When the timer interrupt is nested in another
+ * interrupt the frame belongs to the outer one, so the sample shows where
+ * the task was when that interrupt began.
+ */
+static inline uint32_t IRAM_ATTR interrupted_pc(TaskHandle_t task)
+{
+    const void *frame = *(const void *const *)task;
+#if CONFIG_IDF_TARGET_ARCH_XTENSA
+    return (uint32_t)((const XtExcFrame *)frame)->pc;
+#else
+    return (uint32_t)((const RvExcFrame *)frame)->mepc;
+#endif
+}
+
+static void IRAM_ATTR record_sample(uint32_t pc, uint32_t stall_cycles)
+{
+    uint32_t index = ((pc >> 1) * 2654435761U) & (CONFIG_HOT_PATH_PROFILER_SLOTS - 1U);
+
+    portENTER_CRITICAL_ISR(&s_lock);
+    s_samples++;
+    if (pc_in_flash(pc)) {
+        s_flash_samples++;
+    }
+
+    for (uint32_t probe = 0; probe < MAX_PROBES; probe++) {
+        pc_slot_t *slot = &s_slots[index];
+        if (slot->pc == pc || slot->pc == 0U) {
+            slot->pc = pc;
+            slot->samples++;
+            slot->stall_cycles += stall_cycles;
+            portEXIT_CRITICAL_ISR(&s_lock);
+            return;
+        }
+        index = (index + 1U) & (CONFIG_HOT_PATH_PROFILER_SLOTS - 1U);
+    }
+
+    s_dropped++;
+    portEXIT_CRITICAL_ISR(&s_lock);
+}
+
+static bool IRAM_ATTR sample_isr(gptimer_handle_t timer,
+                                 const gptimer_alarm_event_data_t *event,
+                                 void *arg)
+{
+    (void)timer;
+    (void)event;
+    const int core = (int)(intptr_t)arg;
+    uint32_t stall_cycles = 0;
+
+#if CONFIG_HOT_PATH_PROFILER_STALL_COUNTER
+    const uint32_t stall_now = read_stall_counter();
+    stall_cycles = stall_now - s_last_stall[core];
+    s_last_stall[core] = stall_now;
+#endif
+
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    if (task == NULL) {
+        return false;
+    }
+
+    if (task == s_idle_tasks[core]) {
+        portENTER_CRITICAL_ISR(&s_lock);
+        s_idle_samples++;
+        portEXIT_CRITICAL_ISR(&s_lock);
+        return false;
+    }
+
+    record_sample(interrupted_pc(task), stall_cycles);
+    return false;
+}
+
+/* Runs pinned to args->core so the timer interrupt is allocated there. */
+static void setup_task(void *arg)
+{
+    setup_args_t *args = arg;
+    const int core = args->core;
+    const gptimer_config_t timer_config = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = TIMER_RESOLUTION_HZ,
+    };
+    const gptimer_alarm_config_t alarm_config = {
+        .alarm_count = TIMER_RESOLUTION_HZ / CONFIG_HOT_PATH_PROFILER_RATE_HZ,
+        .reload_count = 0,
+        .flags.auto_reload_on_alarm = true,
+    };
+    const gptimer_event_callbacks_t callbacks = {
+        .on_alarm = sample_isr,
+    };
+
+#if CONFIG_HOT_PATH_PROFILER_STALL_COUNTER
+    // The counter belongs to the core that configures it.
+    xtensa_perfmon_stop();
+    xtensa_perfmon_init(STALL_COUNTER_ID, XTPERF_CNT_I_STALL, XTPERF_MASK_I_STALL_ICM, 0, -1);
+    xtensa_perfmon_reset(STALL_COUNTER_ID);
+    xtensa_perfmon_start();
+    s_last_stall[core] = read_stall_counter();
+#endif
+
+    gptimer_handle_t timer = NULL;
+    esp_err_t err = gptimer_new_timer(&timer_config, &timer);
+    if (err == ESP_OK) {
+        err = gptimer_set_alarm_action(timer, &alarm_config);
+    }
+    if (err == ESP_OK) {
+        err = gptimer_register_event_callbacks(timer, &callbacks, (void *)(intptr_t)core);
+    }
+    if (err == ESP_OK) {
+        err = gptimer_enable(timer);
+    }
+    if (err == ESP_OK) {
+        err = gptimer_start(timer);
+        if (err != ESP_OK) {
+            gptimer_disable(timer);
+        }
+    }
+    if (err != ESP_OK && timer != NULL) {
+        gptimer_del_timer(timer);
+        timer = NULL;
+    }
+
+    s_timers[core] = timer;
+    args->result = err;
+    xSemaphoreGive(args->done);
+    vTaskDelete(NULL);
+}
+
+esp_err_t hot_path_profiler_start(void)
+{
+    if (s_running) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    SemaphoreHandle_t done = xSemaphoreCreateBinary();
+    if (done == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    memset(s_slots, 0, sizeof(s_slots));
+    s_samples = 0;
+    s_flash_samples = 0;
+    s_idle_samples = 0;
+    s_dropped = 0;
+    portEXIT_CRITICAL(&s_lock);
+
+    esp_err_t first_error = ESP_OK;
+    s_sampled_cores = 0;
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        if ((CONFIG_HOT_PATH_PROFILER_CORE_MASK & (1U << core)) == 0) {
+            continue;
+        }
+
+        s_idle_tasks[core] = xTaskGetIdleTaskHandleForCore(core);
+        setup_args_t args = {.core = core, .result = ESP_ERR_NO_MEM, .done = done};
+        if (xTaskCreatePinnedToCore(setup_task, "hot_path_setup", SETUP_STACK_BYTES, &args,
+                                    configMAX_PRIORITIES - 1, NULL, core) == pdPASS) {
+            xSemaphoreTake(done, portMAX_DELAY);
+        }
+
+        if (args.result == ESP_OK) {
+            s_sampled_cores |= 1U << core;
+        } else {
+            ESP_LOGW(TAG, "Core %d not sampled: %s", core, esp_err_to_name(args.result));
+            if (first_error == ESP_OK) {
+                first_error = args.result;
+            }
+        }
+    }
+
+    vSemaphoreDelete(done);
+
+    if (s_sampled_cores == 0) {
+        return first_error != ESP_OK ? first_error : ESP_ERR_INVALID_ARG;
+    }
+
+    s_running = true;
+    ESP_LOGI(TAG, "Sampling cores 0x%" PRIx32 " at %d Hz", s_sampled_cores,
+             CONFIG_HOT_PATH_PROFILER_RATE_HZ);
+    return ESP_OK;
+}
+
+void hot_path_profiler_stop(void)
+{
+    if (!s_running) {
+        return;
+    }
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        if (s_timers[core] == NULL) {
+            continue;
+        }
+        gptimer_stop(s_timers[core]);
+        gptimer_disable(s_timers[core]);
+        gptimer_del_timer(s_timers[core]);
+        s_timers[core] = NULL;
+    }
+
+    s_running = false;
+}
+
+void hot_path_profiler_dump(void)
+{
+    portENTER_CRITICAL(&s_lock);
+    const uint32_t samples = s_samples;
+    const uint32_t flash_samples = s_flash_samples;
+    const uint32_t idle_samples = s_idle_samples;
+    const uint32_t dropped = s_dropped;
+    portEXIT_CRITICAL(&s_lock);
+
+    printf("HOTPATH begin rate=%d cores=0x%" PRIx32 " samples=%" PRIu32 " flash=%" PRIu32
+           " idle=%" PRIu32 " dropped=%" PRIu32 " stall=%d\n",
+           CONFIG_HOT_PATH_PROFILER_RATE_HZ, s_sampled_cores, samples, flash_samples,
+           idle_samples, dropped, STALL_COUNTED);
+
+    // Slots are only ever added, so reading one at a time is consistent.
+    for (uint32_t i = 0; i < CONFIG_HOT_PATH_PROFILER_SLOTS; i++) {
+        portENTER_CRITICAL(&s_lock);
+        const pc_slot_t slot = s_slots[i];
+        portEXIT_CRITICAL(&s_lock);
+
+        if (slot.pc != 0U) {
+            printf("HOTPATH %08" PRIx32 " %" PRIu32 " %" PRIu32 "\n",
+                   slot.pc, slot.samples, slot.stall_cycles);
+        }
+    }
+
+    printf("HOTPATH end\n");
+
+    if (samples > 0) {
+        ESP_LOGI(TAG, "%" PRIu32 " busy samples, %" PRIu32 "%% from flash, %" PRIu32 " dropped",
+                 samples, (uint32_t)((uint64_t)flash_samples * 100U / samples), dropped);
+    }
+}
+
+#else /* !CONFIG_HOT_PATH_PROFILER */
+
+esp_err_t hot_path_profiler_start(void)
+{
+    return ESP_OK;
+}
+
+void hot_path_profiler_stop(void)
+{
+}
+
+void hot_path_profiler_dump(void)
+{
+}
+
+#endif /* CONFIG_HOT_PATH_PROFILER */
@@ -0,0 +1,57 @@
+/**
+ * @file
+ * @brief Program-counter sampling to find hot code running from flash
+ *
+ * A GPTimer interrupt on each sampled core reads the program counter of the
+ * interrupted task from the exception frame FreeRTOS saved on interrupt
+ * entry, and counts samples per address. On Xtensa targets a performance
+ * counter also accumulates instruction-cache miss stall cycles, and the
+ * stalls since the previous sample are charged to the sampled address.
+ *
+ * Samples taken while a core runs its idle task are only counted. The dump
+ * lists raw addresses; tools/gen_iram_fragment.py resolves them against the
+ * ELF, ranks the functions that run from flash, and writes a linker fragment
+ * that moves the top ones into IRAM within a byte budget.
+ */
+
+#pragma once
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Clear the sample table and start sampling the configured cores
+ *
+ * Creates one GPTimer per core in CONFIG_HOT_PATH_PROFILER_CORE_MASK from a
+ * short-lived task pinned to that core, so the interrupt runs there.
+ *
+ * @return ESP_OK if at least one core is sampled, ESP_ERR_INVALID_STATE if
+ *         already running, ESP_ERR_NO_MEM, or the GPTimer error of the
+ *         first core when no core could be sampled
+ */
+esp_err_t hot_path_profiler_start(void);
+
+/**
+ * @brief Stop sampling and release the timers
+ *
+ * The sample table is kept for hot_path_profiler_dump().
+ */
+void hot_path_profiler_stop(void);
+
+/**
+ * @brief Print the sample table as HOTPATH lines on the console
+ *
+ * Format, one record per line:
+ *
+ *     HOTPATH begin rate=<hz> cores=<mask> samples=<n> flash=<n> idle=<n> dropped=<n> stall=<0|1>
+ *     HOTPATH <pc hex> <samples> <stall cycles>
+ *     HOTPATH end
+ */
+void hot_path_profiler_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
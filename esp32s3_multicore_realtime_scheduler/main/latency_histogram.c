@@ -0,0 +1,196 @@
+#include "latency_histogram.h"
+
+#include <stddef.h>
+
+#define LINEAR_LIMIT (1U << LATENCY_HISTOGRAM_LINEAR_BITS)
+
+/**
+ * @brief Maps a value to its bucket index.
+ *
+ * @param value Value to map.
+ * @return Bucket index in [0, LATENCY_HISTOGRAM_BUCKETS).
+ */
+static uint32_t bucket_index(uint32_t value)
+{
+    if (value < LINEAR_LIMIT) {
+        return value;
+    }
+
+    const uint32_t msb = 31U - (uint32_t)__builtin_clz(value);
+    const uint32_t shift = msb - (LATENCY_HISTOGRAM_LINEAR_BITS - 1U);
+    const uint32_t mantissa = (value >> shift) - LATENCY_HISTOGRAM_SUB_BUCKETS;
+
+    return LINEAR_LIMIT +
+        ((msb - LATENCY_HISTOGRAM_LINEAR_BITS) *
+         LATENCY_HISTOGRAM_SUB_BUCKETS) +
+        mantissa;
+}
+
+/**
+ * @brief Returns the largest value that maps to a bucket.
+ *
+ * @param index Bucket index.
+ * @return Inclusive upper bound of the bucket.
+ */
+static uint32_t bucket_upper_bound(uint32_t index)
+{
+    if (index < LINEAR_LIMIT) {
+        return index;
+    }
+
+    const uint32_t offset = index - LINEAR_LIMIT;
+    const uint32_t msb = LATENCY_HISTOGRAM_LINEAR_BITS +
+        (offset / LATENCY_HISTOGRAM_SUB_BUCKETS);
+    const uint32_t mantissa = LATENCY_HISTOGRAM_SUB_BUCKETS +
+        (offset % LATENCY_HISTOGRAM_SUB_BUCKETS);
+    const uint32_t shift = msb - (LATENCY_HISTOGRAM_LINEAR_BITS - 1U);
+    const uint64_t upper = ((uint64_t)(mantissa + 1U) << shift) - 1U;
+
+    return (upper > UINT32_MAX) ? UINT32_MAX : (uint32_t)upper;
+}
+
+/**
+ * @brief Clears a histogram.
+ *
+ * @param histogram Histogram to initialize.
+ */
+void latency_histogram_init(latency_histogram_t *histogram)
+{
+    if (histogram == NULL) {
+        return;
+    }
+
+    for (uint32_t index = 0U; index < LATENCY_HISTOGRAM_BUCKETS; ++index) {
+        atomic_init(&histogram->counts[index], 0U);
+    }
+    atomic_init(&histogram->total, 0U);
+    atomic_init(&histogram->max, 0U);
+}
+
+/**
+ * @brief Records one value. Safe for a single writer without locking.
+ *
+ * @param histogram Histogram to update.
+ * @param value Value to record.
+ */
+void latency_histogram_record(latency_histogram_t *histogram, uint32_t value)
+{
+    if (histogram == NULL) {
+        return;
+    }
+
+    // Single writer: plain load/store pairs avoid read-modify-write atomics.
+    atomic_uint_fast32_t *bucket = &histogram->counts[bucket_index(value)];
+    atomic_store_explicit(
+        bucket,
+        atomic_load_explicit(bucket, memory_order_relaxed) + 1U,
+        memory_order_relaxed);
+
+    if (value > atomic_load_explicit(&histogram->max, memory_order_relaxed)) {
+        atomic_store_explicit(&histogram->max, value, memory_order_relaxed);
+    }
+
+    atomic_store_explicit(
+        &histogram->total,
+        atomic_load_explicit(&histogram->total, memory_order_relaxed) + 1U,
+        memory_order_release);
+}
+
+/**
+ * @brief Returns the value at or below which a fraction of samples fall.
+ *
+ * @param histogram Histogram to query.
+ * @param per_100k Requested fraction in parts per 100000, e.g. 99900.
+ * @return Percentile value, or 0 when the histogram is empty.
+ */
+uint32_t latency_histogram_percentile(
+    const latency_histogram_t *histogram,
+    uint32_t per_100k)
+{
+    if (histogram == NULL) {
+        return 0U;
+    }
+
+    const uint32_t total = (uint32_t)atomic_load_explicit(
+        &histogram->total,
+        memory_order_acquire);
+    if (total == 0U) {
+        return 0U;
+    }
+
+    const uint32_t max = (uint32_t)atomic_load_explicit(
+        &histogram->max,
+        memory_order_relaxed);
+    uint64_t rank = (((uint64_t)total * per_100k) + 99999U) / 100000U;
+    if (rank == 0U) {
+        rank = 1U;
+    }
+
+    uint64_t seen = 0U;
+    for (uint32_t index = 0U; index < LATENCY_HISTOGRAM_BUCKETS; ++index) {
+        seen += atomic_load_explicit(
+            &histogram->counts[index],
+            memory_order_relaxed);
+        if (seen >= rank) {
+            const uint32_t upper = bucket_upper_bound(index);
+            return (upper < max) ? upper : max;
+        }
+    }
+
+    return max;
+}
+
+/**
+ * @brief Computes p50, p99, p99.9 and max in a single pass.
+ *
+ * @param histogram Histogram to query.
+ * @param percentiles Destination summary.
+ */
+void latency_histogram_get_percentiles(
+    const latency_histogram_t *histogram,
+    latency_percentiles_t *percentiles)
+{
+    if ((histogram == NULL) || (percentiles == NULL)) {
+        return;
+    }
+
+    static const uint32_t ranks_per_100k[3] = { 50000U, 99000U, 99900U };
+    uint32_t values[3] = { 0U, 0U, 0U };
+
+    const uint32_t total = (uint32_t)atomic_load_explicit(
+        &histogram->total,
+        memory_order_acquire);
+    const uint32_t max = (uint32_t)atomic_load_explicit(
+        &histogram->max,
+        memory_order_relaxed);
+
+    if (total > 0U) {
+        uint64_t seen = 0U;
+        size_t next = 0U;
+
+        for (uint32_t index = 0U;
+             (index < LATENCY_HISTOGRAM_BUCKETS) && (next < 3U);
+             ++index) {
+            seen += atomic_load_explicit(
+                &histogram->counts[index],
+                memory_order_relaxed);
+            while ((next < 3U) &&
+                   (seen * 100000U >= (uint64_t)total * ranks_per_100k[next])) {
+                const uint32_t upper = bucket_upper_bound(index);
+                values[next] = (upper < max) ? upper : max;
+                next++;
+            }
+        }
+
+        // Counts read after total may lag; fall back to the maximum.
+        while (next < 3U) {
+            values[next++] = max;
+        }
+    }
+
+    percentiles->count = total;
+    percentiles->p50 = values[0];
+    percentiles->p99 = values[1];
+    percentiles->p999 = values[2];
+    percentiles->max = max;
+}
@@ -0,0 +1,89 @@
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Values below 2^LATENCY_HISTOGRAM_LINEAR_BITS get one bucket each. Every
+ * higher power-of-two range is split into 2^(LATENCY_HISTOGRAM_LINEAR_BITS-1)
+ * equal sub-buckets, so the bucket width stays within 1/16 of the value.
+ */
+#define LATENCY_HISTOGRAM_LINEAR_BITS 5U
+#define LATENCY_HISTOGRAM_SUB_BUCKETS (1U << (LATENCY_HISTOGRAM_LINEAR_BITS - 1U))
+#define LATENCY_HISTOGRAM_BUCKETS \
+    ((1U << LATENCY_HISTOGRAM_LINEAR_BITS) + \
+     ((32U - LATENCY_HISTOGRAM_LINEAR_BITS) * LATENCY_HISTOGRAM_SUB_BUCKETS))
+
+/**
+ * @brief Log-linear (HDR-style) histogram of 32-bit latency values.
+ *
+ * One writer records values with relaxed atomics; any number of readers may
+ * compute percentiles concurrently. Readers can observe a record that is
+ * only partly applied, which shifts a percentile by at most one sample.
+ */
+typedef struct {
+    atomic_uint_fast32_t counts[LATENCY_HISTOGRAM_BUCKETS];
+    atomic_uint_fast32_t total;
+    atomic_uint_fast32_t max;
+} latency_histogram_t;
+
+/**
+ * @brief Summary of the tail of a histogram.
+ */
+typedef struct {
+    uint32_t count;
+    uint32_t p50;
+    uint32_t p99;
+    uint32_t p999;
+    uint32_t max;
+} latency_percentiles_t;
+
+/**
+ * @brief Clears a histogram.
+ *
+ * @param histogram Histogram to initialize.
+ */
+void latency_histogram_init(latency_histogram_t *histogram);
+
+/**
+ * @brief Records one value. Safe for a single writer without locking.
+ *
+ * @param histogram Histogram to update.
+ * @param value Value to record.
+ */
+void latency_histogram_record(latency_histogram_t *histogram, uint32_t value);
+
+/**
+ * @brief Returns the value at or below which a fraction of samples fall.
+ *
+ * The result is the upper bound of the bucket that contains the requested
+ * rank, so it never under-reports the tail. The recorded maximum caps it.
+ *
+ * @param histogram Histogram to query.
+ * @param per_100k Requested fraction in parts per 100000, e.g. 99900.
+ * @return Percentile value, or 0 when the histogram is empty.
+ */
+uint32_t latency_histogram_percentile(
+    const latency_histogram_t *histogram,
+    uint32_t per_100k);
+
+/**
+ * @brief Computes p50, p99, p99.9 and max in a single pass.
+ *
+ * @param histogram Histogram to query.
+ * @param percentiles Destination summary.
+ */
+void latency_histogram_get_percentiles(
+    const latency_histogram_t *histogram,
+    latency_percentiles_t *percentiles);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -3,26 +3,88 @@
 #include <string.h>
 
 /**
- * @brief Initializes a single-producer, single-consumer ring buffer.
+ * @brief Initializes a lock-free ring buffer.
  *
  * @param ring Ring-buffer instance to initialize.
+ * @param mode Producer model for this ring.
  */
-void lockfree_ring_init(lockfree_ring_t *ring)
+void lockfree_ring_init(lockfree_ring_t *ring, lockfree_ring_mode_t mode)
 {
     if (ring == NULL) {
         return;
     }
 
     memset(ring->items, 0, sizeof(ring->items));
+    for (size_t index = 0U; index < LF_RING_CAPACITY; ++index) {
+        // A slot is writable for position p while its sequence equals p.
+        atomic_init(&ring->slot_sequence[index], index);
+    }
     atomic_init(&ring->write_index, 0U);
     atomic_init(&ring->read_index, 0U);
     atomic_init(&ring->dropped_samples, 0U);
+    ring->mode = mode;
+}
+
+/**
+ * @brief Claims and publishes one slot when several producers share the ring.
+ *
+ * @param ring Ring-buffer instance.
+ * @param sample Sample to store.
+ * @return true when the item was stored, otherwise false when full.
+ */
+static bool lockfree_ring_push_multi(
+    lockfree_ring_t *ring,
+    const timing_sample_t *sample)
+{
+    size_t position = atomic_load_explicit(
+        &ring->write_index,
+        memory_order_relaxed);
+    size_t slot;
+
+    while (true) {
+        slot = position % LF_RING_CAPACITY;
+        const size_t sequence = atomic_load_explicit(
+            &ring->slot_sequence[slot],
+            memory_order_acquire);
+        const intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+
+        if (difference == 0) {
+            if (atomic_compare_exchange_weak_explicit(
+                    &ring->write_index,
+                    &position,
+                    position + 1U,
+                    memory_order_relaxed,
+                    memory_order_relaxed)) {
+                break;
+            }
+        } else if (difference < 0) {
+            // The consumer has not released this slot from the previous lap.
+            atomic_fetch_add_explicit(
+                &ring->dropped_samples,
+                1U,
+                memory_order_relaxed);
+            return false;
+        } else {
+            position = atomic_load_explicit(
+                &ring->write_index,
+                memory_order_relaxed);
+        }
+    }
+
+    ring->items[slot] = *sample;
+    atomic_store_explicit(
+        &ring->slot_sequence[slot],
+        position + 1U,
+        memory_order_release);
+
+    return true;
 }
 
 /**
  * @brief Pushes one item into the ring buffer.
  *
- * This function is safe for exactly one producer and one consumer.
+ * In LF_RING_MODE_SPSC this function must only be called by one producer.
+ * In LF_RING_MODE_MPSC it may be called concurrently from any context.
  *
  * @param ring Ring-buffer instance.
  * @param sample Sample to store.
@@ -34,15 +96,18 @@ bool lockfree_ring_push(lockfree_ring_t *ring, const timing_sample_t *sample)
         return false;
     }
 
+    if (ring->mode == LF_RING_MODE_MPSC) {
+        return lockfree_ring_push_multi(ring, sample);
+    }
+
     const size_t write_index = atomic_load_explicit(
         &ring->write_index,
         memory_order_relaxed);
-    const size_t next_index = (write_index + 1U) % LF_RING_CAPACITY;
     const size_t read_index = atomic_load_explicit(
         &ring->read_index,
         memory_order_acquire);
 
-    if (next_index == read_index) {
+    if ((write_index - read_index) >= LF_RING_CAPACITY) {
         atomic_fetch_add_explicit(
             &ring->dropped_samples,
             1U,
@@ -50,48 +115,167 @@ bool lockfree_ring_push(lockfree_ring_t *ring, const timing_sample_t *sample)
         return false;
     }
 
-    ring->items[write_index] = *sample;
+    ring->items[write_index % LF_RING_CAPACITY] = *sample;
     atomic_store_explicit(
         &ring->write_index,
-        next_index,
+        write_index + 1U,
         memory_order_release);
 
     return true;
 }
 
 /**
- * @brief Removes one item from the ring buffer.
+ * @brief Counts readable items that are contiguous in the storage array.
  *
- * This function is safe for exactly one producer and one consumer.
+ * @param ring Ring-buffer instance.
+ * @param read_index Current consumer position.
+ * @param max_count Upper bound for the returned count.
+ * @return Number of items that may be read starting at read_index.
+ */
+static size_t lockfree_ring_readable(
+    lockfree_ring_t *ring,
+    size_t read_index,
+    size_t max_count)
+{
+    const size_t first_slot = read_index % LF_RING_CAPACITY;
+    const size_t until_wrap = LF_RING_CAPACITY - first_slot;
+    const size_t limit = (max_count < until_wrap) ? max_count : until_wrap;
+
+    if (ring->mode == LF_RING_MODE_MPSC) {
+        size_t count = 0U;
+
+        // Producers may finish out of order, so stop at the first gap.
+        while ((count < limit) &&
+               (atomic_load_explicit(
+                    &ring->slot_sequence[first_slot + count],
+                    memory_order_acquire) == (read_index + count + 1U))) {
+            ++count;
+        }
+
+        return count;
+    }
+
+    const size_t write_index = atomic_load_explicit(
+        &ring->write_index,
+        memory_order_acquire);
+    const size_t available = write_index - read_index;
+
+    return (available < limit) ? available : limit;
+}
+
+/**
+ * @brief Returns items obtained from lockfree_ring_peek() to the producers.
  *
  * @param ring Ring-buffer instance.
- * @param sample Destination for the retrieved sample.
- * @return true when an item was retrieved, otherwise false when empty.
+ * @param count Number of items to release. Must not exceed the last span.
  */
-bool lockfree_ring_pop(lockfree_ring_t *ring, timing_sample_t *sample)
+void lockfree_ring_commit(lockfree_ring_t *ring, size_t count)
 {
-    if ((ring == NULL) || (sample == NULL)) {
-        return false;
+    if ((ring == NULL) || (count == 0U)) {
+        return;
     }
 
     const size_t read_index = atomic_load_explicit(
         &ring->read_index,
         memory_order_relaxed);
-    const size_t write_index = atomic_load_explicit(
-        &ring->write_index,
-        memory_order_acquire);
 
-    if (read_index == write_index) {
-        return false;
+    if (ring->mode == LF_RING_MODE_MPSC) {
+        for (size_t offset = 0U; offset < count; ++offset) {
+            const size_t position = read_index + offset;
+            atomic_store_explicit(
+                &ring->slot_sequence[position % LF_RING_CAPACITY],
+                position + LF_RING_CAPACITY,
+                memory_order_release);
+        }
     }
 
-    *sample = ring->items[read_index];
     atomic_store_explicit(
         &ring->read_index,
-        (read_index + 1U) % LF_RING_CAPACITY,
+        read_index + count,
         memory_order_release);
+}
 
-    return true;
+/**
+ * @brief Exposes the oldest readable items without copying them.
+ *
+ * @param ring Ring-buffer instance.
+ * @param span Receives a pointer to the first readable item.
+ * @param max_count Maximum number of items to expose.
+ * @return Number of items in the span, or 0 when the ring is empty.
+ */
+size_t lockfree_ring_peek(
+    lockfree_ring_t *ring,
+    const timing_sample_t **span,
+    size_t max_count)
+{
+    if ((ring == NULL) || (span == NULL) || (max_count == 0U)) {
+        return 0U;
+    }
+
+    const size_t read_index = atomic_load_explicit(
+        &ring->read_index,
+        memory_order_relaxed);
+    const size_t count = lockfree_ring_readable(ring, read_index, max_count);
+
+    *span = &ring->items[read_index % LF_RING_CAPACITY];
+    return count;
+}
+
+/**
+ * @brief Removes up to max_count items from the ring buffer.
+ *
+ * @param ring Ring-buffer instance.
+ * @param samples Destination array with room for max_count samples.
+ * @param max_count Maximum number of samples to retrieve.
+ * @return Number of samples copied into samples.
+ */
+size_t lockfree_ring_pop_batch(
+    lockfree_ring_t *ring,
+    timing_sample_t *samples,
+    size_t max_count)
+{
+    if (samples == NULL) {
+        return 0U;
+    }
+
+    size_t total = 0U;
+
+    // At most two spans are needed: one before and one after the wrap.
+    while (total < max_count) {
+        const timing_sample_t *span = NULL;
+        const size_t count = lockfree_ring_peek(
+            ring,
+            &span,
+            max_count - total);
+
+        if (count == 0U) {
+            break;
+        }
+
+        memcpy(&samples[total], span, count * sizeof(*span));
+        lockfree_ring_commit(ring, count);
+        total += count;
+    }
+
+    return total;
+}
+
+/**
+ * @brief Removes one item from the ring buffer.
+ *
+ * This function must only be called by the single consumer.
+ *
+ * @param ring Ring-buffer instance.
+ * @param sample Destination for the retrieved sample.
+ * @return true when an item was retrieved, otherwise false when empty.
+ */
+bool lockfree_ring_pop(lockfree_ring_t *ring, timing_sample_t *sample)
+{
+    if ((ring == NULL) || (sample == NULL)) {
+        return false;
+    }
+
+    return lockfree_ring_pop_batch(ring, sample, 1U) == 1U;
 }
 
 /**
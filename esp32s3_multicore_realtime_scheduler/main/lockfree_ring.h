@@ -11,6 +11,11 @@ extern "C" {
 #endif
 
 #define LF_RING_CAPACITY 128U
+#define LF_RING_CACHE_LINE_SIZE 64U
+
+_Static_assert(
+    (LF_RING_CAPACITY & (LF_RING_CAPACITY - 1U)) == 0U,
+    "LF_RING_CAPACITY must be a power of two");
 
 typedef struct {
     int64_t timestamp_us;
@@ -20,24 +25,42 @@ typedef struct {
     bool deadline_missed;
 } timing_sample_t;
 
+/**
+ * @brief Producer model selected when the ring is initialized.
+ */
+typedef enum {
+    LF_RING_MODE_SPSC = 0,   /**< Exactly one producer and one consumer. */
+    LF_RING_MODE_MPSC,       /**< Any number of producers, one consumer. */
+} lockfree_ring_mode_t;
+
 typedef struct {
     timing_sample_t items[LF_RING_CAPACITY];
-    atomic_size_t write_index;
-    atomic_size_t read_index;
+    atomic_size_t slot_sequence[LF_RING_CAPACITY];
+    lockfree_ring_mode_t mode;
+    // Producer and consumer indices live on separate cache lines.
+    _Alignas(LF_RING_CACHE_LINE_SIZE) atomic_size_t write_index;
     atomic_uint_fast32_t dropped_samples;
+    _Alignas(LF_RING_CACHE_LINE_SIZE) atomic_size_t read_index;
 } lockfree_ring_t;
 
 /**
- * @brief Initializes a single-producer, single-consumer ring buffer.
+ * @brief Initializes a lock-free ring buffer.
+ *
+ * In LF_RING_MODE_SPSC the ring publishes items through the shared write
+ * index. In LF_RING_MODE_MPSC producers claim slots with a compare-and-swap
+ * and publish each slot through its own sequence number, so producers on
+ * different cores, timer callbacks, or ISRs never wait on each other.
  *
  * @param ring Ring-buffer instance to initialize.
+ * @param mode Producer model for this ring.
  */
-void lockfree_ring_init(lockfree_ring_t *ring);
+void lockfree_ring_init(lockfree_ring_t *ring, lockfree_ring_mode_t mode);
 
 /**
  * @brief Pushes one item into the ring buffer.
  *
- * This function is safe for exactly one producer and one consumer.
+ * In LF_RING_MODE_SPSC this function must only be called by one producer.
+ * In LF_RING_MODE_MPSC it may be called concurrently from any context.
  *
  * @param ring Ring-buffer instance.
  * @param sample Sample to store.
@@ -48,7 +71,7 @@ bool lockfree_ring_push(lockfree_ring_t *ring, const timing_sample_t *sample);
 /**
  * @brief Removes one item from the ring buffer.
  *
- * This function is safe for exactly one producer and one consumer.
+ * This function must only be called by the single consumer.
  *
  * @param ring Ring-buffer instance.
  * @param sample Destination for the retrieved sample.
@@ -56,6 +79,47 @@ bool lockfree_ring_push(lockfree_ring_t *ring, const timing_sample_t *sample);
  */
 bool lockfree_ring_pop(lockfree_ring_t *ring, timing_sample_t *sample);
 
+/**
+ * @brief Removes up to max_count items from the ring buffer.
+ *
+ * In LF_RING_MODE_SPSC the whole batch is claimed with a single acquire load
+ * and released with a single release store.
+ *
+ * @param ring Ring-buffer instance.
+ * @param samples Destination array with room for max_count samples.
+ * @param max_count Maximum number of samples to retrieve.
+ * @return Number of samples copied into samples.
+ */
+size_t lockfree_ring_pop_batch(
+    lockfree_ring_t *ring,
+    timing_sample_t *samples,
+    size_t max_count);
+
+/**
+ * @brief Exposes the oldest readable items without copying them.
+ *
+ * The returned span is contiguous in memory, so it ends at the physical end
+ * of the storage array even if more items are readable after the wrap. The
+ * items stay owned by the consumer until lockfree_ring_commit() is called.
+ *
+ * @param ring Ring-buffer instance.
+ * @param span Receives a pointer to the first readable item.
+ * @param max_count Maximum number of items to expose.
+ * @return Number of items in the span, or 0 when the ring is empty.
+ */
+size_t lockfree_ring_peek(
+    lockfree_ring_t *ring,
+    const timing_sample_t **span,
+    size_t max_count);
+
+/**
+ * @brief Returns items obtained from lockfree_ring_peek() to the producers.
+ *
+ * @param ring Ring-buffer instance.
+ * @param count Number of items to release. Must not exceed the last span.
+ */
+void lockfree_ring_commit(lockfree_ring_t *ring, size_t count);
+
 /**
  * @brief Returns the number of samples dropped because the buffer was full.
  *
@@ -1,3 +1,7 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_err.h"
+#include "hot_path_profiler.h"
 #include "realtime_scheduler.h"
 
 /**
@@ -6,4 +10,12 @@
 void app_main(void)
 {
     realtime_scheduler_start();
+
+#if CONFIG_HOT_PATH_PROFILER
+    // Sample the jobs once they run at their steady-state rates.
+    ESP_ERROR_CHECK(hot_path_profiler_start());
+    vTaskDelay(pdMS_TO_TICKS(CONFIG_HOT_PATH_PROFILER_WINDOW_S * 1000U));
+    hot_path_profiler_stop();
+    hot_path_profiler_dump();
+#endif
 }
@@ -7,6 +7,7 @@
 #include <string.h>
 
 #include "driver/gpio.h"
+#include "driver/gptimer.h"
 #include "esp_attr.h"
 #include "esp_cpu.h"
 #include "esp_err.h"
@@ -15,51 +16,211 @@
 #include "esp_timer.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "sdkconfig.h"
 
+#include "latency_histogram.h"
 #include "lockfree_ring.h"
+#include "spsc_ring.h"
+#include "task_placement.h"
+#include "telemetry_stream.h"
 
-#define CONTROL_CORE                 0
-#define SERVICE_CORE                 1
+#define CONTROL_CORE                 TASK_PLACEMENT_CONTROL_CORE
+#define SERVICE_CORE                 TASK_PLACEMENT_SERVICE_CORE
 
 #define CONTROL_TASK_PRIORITY        22
 #define TELEMETRY_TASK_PRIORITY      8
+#define PLACEMENT_TASK_PRIORITY      6
 #define STRESS_TASK_PRIORITY         5
 
 #define CONTROL_TASK_STACK_SIZE      4096
 #define TELEMETRY_TASK_STACK_SIZE    4096
 #define STRESS_TASK_STACK_SIZE       4096
 
-#define CONTROL_PERIOD_US            1000U
-#define CONTROL_DEADLINE_US          800U
-#define CONTROL_WORK_ITERATIONS      220U
+#define CURRENT_LOOP_ITERATIONS      220U
+#define VELOCITY_LOOP_ITERATIONS     800U
+#define POSITION_LOOP_ITERATIONS     2500U
+#define CURRENT_DEGRADED_ITERATIONS  60U
+#define POSITION_DEGRADED_ITERATIONS 600U
+#define BUDGET_POLL_MASK             31U
+
+#define RELEASE_TIMER_RESOLUTION_HZ  1000000U
+#define RELEASE_DRAIN_TIMEOUT_MS     100U
+#define DEGRADE_HOLD_RELEASES        CONFIG_RT_DEGRADE_HOLD_RELEASES
+#define SCHEDULABILITY_HORIZON_US    1000000U
 
 #define PROFILE_GPIO                 GPIO_NUM_2
 #define DEADLINE_MISS_GPIO           GPIO_NUM_3
 
+#define TIMING_RING_CAPACITY         128U
+
+#define JITTER_HISTOGRAM_BUCKETS     32U
+#define JITTER_BUCKET_US             CONFIG_RT_JITTER_BUCKET_US
+#define JITTER_PHASE_MS              (CONFIG_RT_JITTER_PHASE_S * 1000U)
+
 #define TELEMETRY_REPORT_MS          1000U
 #define STRESS_DELAY_MS              1U
 
 static const char *TAG = "realtime_sched";
 
-static TaskHandle_t s_control_task_handle;
-static esp_timer_handle_t s_release_timer;
-static lockfree_ring_t s_timing_ring;
-static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+/**
+ * @brief Periodic job body. Receives the release index and returns a command.
+ */
+typedef uint32_t (*rt_job_fn_t)(uint32_t release_index);
 
-static atomic_uint_fast32_t s_release_sequence;
-static atomic_uint_fast32_t s_notification_overruns;
+/**
+ * @brief Action taken after a job instance misses its deadline or budget.
+ */
+typedef enum {
+    RT_OVERRUN_CONTINUE = 0,  /**< Record the miss and run the next release. */
+    RT_OVERRUN_SKIP_NEXT,     /**< Drop the following release to catch up. */
+    RT_OVERRUN_DEGRADE,       /**< Run degraded_job for a number of releases. */
+} rt_overrun_policy_t;
 
-static volatile uint32_t s_shared_guarded_value;
+/**
+ * @brief Reason a job instance completed after its deadline.
+ */
+typedef enum {
+    RT_MISS_CAUSE_OVERRUN = 0,  /**< The instance exceeded its own budget. */
+    RT_MISS_CAUSE_INTERFERENCE, /**< The instance started late. */
+    RT_MISS_CAUSE_CASCADE,      /**< An earlier release was still pending. */
+    RT_MISS_CAUSE_COUNT
+} rt_miss_cause_t;
+
+/**
+ * @brief Declarative description of one periodic real-time job.
+ */
+typedef struct {
+    const char *name;
+    rt_job_fn_t job;
+    rt_job_fn_t degraded_job;
+    rt_overrun_policy_t overrun_policy;
+    uint32_t period_us;
+    uint32_t deadline_us;
+    uint32_t wcet_budget_us;
+    BaseType_t core;
+} rt_task_config_t;
 
 typedef struct {
     uint64_t samples;
     uint64_t deadline_misses;
+    uint64_t misses_by_cause[RT_MISS_CAUSE_COUNT];
+    uint64_t budget_overruns;
     uint32_t min_execution_cycles;
     uint32_t max_execution_cycles;
     uint32_t max_release_jitter_us;
+    uint32_t max_response_time_us;
 } timing_stats_t;
 
-static timing_stats_t s_timing_stats;
+// One producer (the job's dispatcher) and one consumer (telemetry_task).
+SPSC_RING_DEFINE(timing_sample_ring, timing_sample_t, TIMING_RING_CAPACITY)
+
+/**
+ * @brief Mechanism that delivers the periodic release tick.
+ */
+typedef enum {
+    RELEASE_SOURCE_GPTIMER = 0,
+    RELEASE_SOURCE_ESP_TIMER,
+    RELEASE_SOURCE_COUNT
+} release_source_t;
+
+static const char *const s_release_source_names[RELEASE_SOURCE_COUNT] = {
+    "gptimer",
+    "esp_timer",
+};
+
+static const char *const s_overrun_policy_names[] = {
+    "continue",
+    "skip_next",
+    "degrade",
+};
+
+typedef struct {
+    const rt_task_config_t *config;
+    uint32_t period_ticks;
+    uint32_t ticks_until_release;
+    atomic_uint_fast32_t pending_releases;
+    atomic_uint_fast32_t release_overruns;
+    atomic_uint_fast32_t skipped_releases;
+    atomic_uint_fast32_t degraded_runs;
+    atomic_uint_fast32_t budget_cancellations;
+    uint32_t consumed_releases;
+    uint32_t generation;
+    bool skip_next_release;
+    uint32_t degraded_releases_left;
+    uint32_t last_command;
+    timing_stats_t stats;
+    atomic_uint_fast32_t
+        jitter_histogram[RELEASE_SOURCE_COUNT][JITTER_HISTOGRAM_BUCKETS];
+    latency_histogram_t execution_cycles_histogram;
+    latency_histogram_t release_jitter_histogram;
+    latency_histogram_t response_time_histogram;
+    timing_sample_ring_t ring;
+} rt_job_state_t;
+
+static uint32_t current_loop(uint32_t release_index);
+static uint32_t velocity_loop(uint32_t release_index);
+static uint32_t position_loop(uint32_t release_index);
+static uint32_t current_loop_degraded(uint32_t release_index);
+static uint32_t position_loop_degraded(uint32_t release_index);
+
+/**
+ * Job table. Each job runs on the dispatcher of its core and is selected by
+ * earliest absolute deadline. Add or retune loops here; the release timer
+ * period and the startup schedulability check are derived from this table.
+ * overrun_policy decides what happens after a missed deadline or budget;
+ * RT_OVERRUN_DEGRADE requires a degraded_job.
+ */
+static const rt_task_config_t s_task_table[] = {
+    {
+        .name = "current",
+        .job = current_loop,
+        .degraded_job = current_loop_degraded,
+        .overrun_policy = RT_OVERRUN_DEGRADE,
+        .period_us = 1000U,
+        .deadline_us = 800U,
+        .wcet_budget_us = 100U,
+        .core = CONTROL_CORE,
+    },
+    {
+        .name = "velocity",
+        .job = velocity_loop,
+        .degraded_job = NULL,
+        .overrun_policy = RT_OVERRUN_SKIP_NEXT,
+        .period_us = 4000U,
+        .deadline_us = 3000U,
+        .wcet_budget_us = 200U,
+        .core = CONTROL_CORE,
+    },
+    {
+        .name = "position",
+        .job = position_loop,
+        .degraded_job = position_loop_degraded,
+        .overrun_policy = RT_OVERRUN_DEGRADE,
+        .period_us = 20000U,
+        .deadline_us = 15000U,
+        .wcet_budget_us = 400U,
+        .core = CONTROL_CORE,
+    },
+};
+
+#define RT_TASK_COUNT (sizeof(s_task_table) / sizeof(s_task_table[0]))
+
+static rt_job_state_t s_jobs[RT_TASK_COUNT];
+static TaskHandle_t s_dispatcher_handles[portNUM_PROCESSORS];
+static gptimer_handle_t s_release_timer;
+static esp_timer_handle_t s_release_esp_timer;
+static atomic_int s_active_release_source;
+static atomic_uint_fast32_t s_release_generation;
+static atomic_bool s_dispatcher_busy[portNUM_PROCESSORS];
+static atomic_bool s_budget_expired[portNUM_PROCESSORS];
+#if CONFIG_RT_BUDGET_WATCHDOG
+static gptimer_handle_t s_budget_timers[portNUM_PROCESSORS];
+#endif
+static uint32_t s_release_base_us;
+static int64_t s_release_epoch_us;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static volatile uint32_t s_shared_guarded_value;
 
 /**
  * @brief Configures profiling GPIO outputs.
@@ -79,20 +240,38 @@ static void configure_profile_gpios(void)
     ESP_ERROR_CHECK(gpio_set_level(DEADLINE_MISS_GPIO, 0));
 }
 
+/**
+ * @brief Reports whether the budget watchdog fired for the running job.
+ *
+ * @return true when the job on the calling core should stop early.
+ */
+static inline bool job_budget_expired(void)
+{
+    return atomic_load_explicit(
+        &s_budget_expired[esp_cpu_get_core_id()],
+        memory_order_relaxed);
+}
+
 /**
  * @brief Performs deterministic synthetic control-loop work.
  *
  * The arithmetic is intentionally deterministic and avoids dynamic memory,
- * logging, and blocking calls inside the real-time path.
+ * logging, and blocking calls inside the real-time path. The budget
+ * watchdog flag is polled every few iterations so an overrunning instance
+ * stops close to its budget instead of delaying the next release.
  *
  * @param input Input sample.
+ * @param iterations Synthetic workload size.
  * @return Simulated actuator command.
  */
-static uint32_t execute_control_algorithm(uint32_t input)
+static uint32_t execute_control_algorithm(uint32_t input, uint32_t iterations)
 {
     uint32_t accumulator = input ^ 0xA5A55A5AU;
 
-    for (uint32_t index = 0U; index < CONTROL_WORK_ITERATIONS; ++index) {
+    for (uint32_t index = 0U; index < iterations; ++index) {
+        if (((index & BUDGET_POLL_MASK) == 0U) && job_budget_expired()) {
+            break;
+        }
         accumulator = (accumulator << 5U) | (accumulator >> 27U);
         accumulator ^= (index * 2654435761U);
         accumulator += 0x9E3779B9U;
@@ -102,38 +281,235 @@ static uint32_t execute_control_algorithm(uint32_t input)
 }
 
 /**
- * @brief Updates timing statistics from the control task.
+ * @brief Runs the synthetic 1 kHz current loop.
+ *
+ * @param release_index Release number of this job instance.
+ * @return Simulated actuator command.
+ */
+static uint32_t current_loop(uint32_t release_index)
+{
+    return execute_control_algorithm(release_index, CURRENT_LOOP_ITERATIONS);
+}
+
+/**
+ * @brief Runs the synthetic 250 Hz velocity loop.
+ *
+ * @param release_index Release number of this job instance.
+ * @return Simulated actuator command.
+ */
+static uint32_t velocity_loop(uint32_t release_index)
+{
+    return execute_control_algorithm(release_index, VELOCITY_LOOP_ITERATIONS);
+}
+
+/**
+ * @brief Runs the synthetic 50 Hz position loop.
+ *
+ * @param release_index Release number of this job instance.
+ * @return Simulated actuator command.
+ */
+static uint32_t position_loop(uint32_t release_index)
+{
+    return execute_control_algorithm(release_index, POSITION_LOOP_ITERATIONS);
+}
+
+/**
+ * @brief Runs the reduced-order current loop used while degraded.
+ *
+ * @param release_index Release number of this job instance.
+ * @return Simulated actuator command.
+ */
+static uint32_t current_loop_degraded(uint32_t release_index)
+{
+    return execute_control_algorithm(
+        release_index,
+        CURRENT_DEGRADED_ITERATIONS);
+}
+
+/**
+ * @brief Runs the reduced-order position loop used while degraded.
+ *
+ * @param release_index Release number of this job instance.
+ * @return Simulated actuator command.
+ */
+static uint32_t position_loop_degraded(uint32_t release_index)
+{
+    return execute_control_algorithm(
+        release_index,
+        POSITION_DEGRADED_ITERATIONS);
+}
+
+/**
+ * @brief Returns the greatest common divisor of two periods.
+ *
+ * @param a First value.
+ * @param b Second value.
+ * @return Greatest common divisor.
+ */
+static uint32_t gcd_u32(uint32_t a, uint32_t b)
+{
+    while (b != 0U) {
+        const uint32_t remainder = a % b;
+        a = b;
+        b = remainder;
+    }
+
+    return a;
+}
+
+/**
+ * @brief Checks non-preemptive EDF schedulability for the jobs on one core.
+ *
+ * Jobs on a dispatcher run to completion, so the test uses the processor
+ * demand criterion with blocking: for every absolute deadline t within the
+ * horizon, the demand of all jobs with deadlines at or before t plus the
+ * longest budget of any job with a later deadline must fit within t.
+ *
+ * @param core Core whose jobs are checked.
+ * @return true when the job set is schedulable or the core has no jobs.
+ */
+static bool check_core_schedulability(BaseType_t core)
+{
+    uint64_t utilization_ppm = 0U;
+    uint64_t hyperperiod_us = 1U;
+    uint32_t max_deadline_us = 0U;
+    size_t job_count = 0U;
+
+    for (size_t index = 0U; index < RT_TASK_COUNT; ++index) {
+        const rt_task_config_t *config = &s_task_table[index];
+        if (config->core != core) {
+            continue;
+        }
+
+        job_count++;
+        utilization_ppm +=
+            ((uint64_t)config->wcet_budget_us * 1000000ULL) /
+            config->period_us;
+        if (hyperperiod_us <= SCHEDULABILITY_HORIZON_US) {
+            hyperperiod_us = (hyperperiod_us / gcd_u32(
+                (uint32_t)hyperperiod_us, config->period_us)) *
+                config->period_us;
+        }
+        if (config->deadline_us > max_deadline_us) {
+            max_deadline_us = config->deadline_us;
+        }
+    }
+
+    if (job_count == 0U) {
+        return true;
+    }
+
+    ESP_LOGI(
+        TAG,
+        "core %d: %u jobs, budget utilization %" PRIu32 ".%03" PRIu32 " %%",
+        core,
+        (unsigned)job_count,
+        (uint32_t)(utilization_ppm / 10000U),
+        (uint32_t)((utilization_ppm % 10000U) / 10U));
+
+    if (utilization_ppm > 1000000U) {
+        ESP_LOGE(TAG, "core %d: budget utilization exceeds 100 %%", core);
+        return false;
+    }
+
+    uint64_t horizon_us = hyperperiod_us + max_deadline_us;
+    if (horizon_us > SCHEDULABILITY_HORIZON_US) {
+        horizon_us = SCHEDULABILITY_HORIZON_US;
+    }
+
+    for (size_t index = 0U; index < RT_TASK_COUNT; ++index) {
+        const rt_task_config_t *checked = &s_task_table[index];
+        if (checked->core != core) {
+            continue;
+        }
+
+        for (uint64_t t = checked->deadline_us; t <= horizon_us;
+             t += checked->period_us) {
+            uint64_t demand_us = 0U;
+            uint32_t blocking_us = 0U;
+
+            for (size_t other = 0U; other < RT_TASK_COUNT; ++other) {
+                const rt_task_config_t *config = &s_task_table[other];
+                if (config->core != core) {
+                    continue;
+                }
+
+                if (t >= config->deadline_us) {
+                    demand_us +=
+                        (((t - config->deadline_us) / config->period_us) + 1U) *
+                        config->wcet_budget_us;
+                } else if (config->wcet_budget_us > blocking_us) {
+                    blocking_us = config->wcet_budget_us;
+                }
+            }
+
+            if ((demand_us + blocking_us) > t) {
+                ESP_LOGE(
+                    TAG,
+                    "core %d: demand %" PRIu64 " us + blocking %" PRIu32
+                    " us exceeds %" PRIu64 " us at %s deadline",
+                    core,
+                    demand_us,
+                    blocking_us,
+                    t,
+                    checked->name);
+                return false;
+            }
+        }
+    }
+
+    ESP_LOGI(TAG, "core %d: job set is schedulable", core);
+    return true;
+}
+
+/**
+ * @brief Updates timing statistics from a dispatcher task.
  *
- * @param execution_cycles Measured control execution time in CPU cycles.
+ * @param stats Statistics block of the job that just completed.
+ * @param execution_cycles Measured job execution time in CPU cycles.
  * @param release_jitter_us Measured release jitter in microseconds.
+ * @param response_time_us Time from intended release to completion.
  * @param deadline_missed true when the deadline was missed.
+ * @param miss_cause Reason for the miss. Ignored when deadline_missed is false.
+ * @param budget_overrun true when execution exceeded the WCET budget.
  */
 static void update_timing_statistics(
+    timing_stats_t *stats,
     uint32_t execution_cycles,
     uint32_t release_jitter_us,
-    bool deadline_missed)
+    uint32_t response_time_us,
+    bool deadline_missed,
+    rt_miss_cause_t miss_cause,
+    bool budget_overrun)
 {
     portENTER_CRITICAL(&s_stats_lock);
 
-    if (s_timing_stats.samples == 0U) {
-        s_timing_stats.min_execution_cycles = execution_cycles;
-        s_timing_stats.max_execution_cycles = execution_cycles;
+    if (stats->samples == 0U) {
+        stats->min_execution_cycles = execution_cycles;
+        stats->max_execution_cycles = execution_cycles;
     } else {
-        if (execution_cycles < s_timing_stats.min_execution_cycles) {
-            s_timing_stats.min_execution_cycles = execution_cycles;
+        if (execution_cycles < stats->min_execution_cycles) {
+            stats->min_execution_cycles = execution_cycles;
         }
-        if (execution_cycles > s_timing_stats.max_execution_cycles) {
-            s_timing_stats.max_execution_cycles = execution_cycles;
+        if (execution_cycles > stats->max_execution_cycles) {
+            stats->max_execution_cycles = execution_cycles;
         }
     }
 
-    if (release_jitter_us > s_timing_stats.max_release_jitter_us) {
-        s_timing_stats.max_release_jitter_us = release_jitter_us;
+    if (release_jitter_us > stats->max_release_jitter_us) {
+        stats->max_release_jitter_us = release_jitter_us;
+    }
+    if (response_time_us > stats->max_response_time_us) {
+        stats->max_response_time_us = response_time_us;
     }
 
-    s_timing_stats.samples++;
+    stats->samples++;
     if (deadline_missed) {
-        s_timing_stats.deadline_misses++;
+        stats->deadline_misses++;
+        stats->misses_by_cause[miss_cause]++;
+    }
+    if (budget_overrun) {
+        stats->budget_overruns++;
     }
 
     portEXIT_CRITICAL(&s_stats_lock);
@@ -142,113 +518,597 @@ static void update_timing_statistics(
 /**
  * @brief Copies timing statistics for noncritical reporting.
  *
+ * @param stats Statistics block to copy.
  * @return Snapshot of the current timing statistics.
  */
-static timing_stats_t get_timing_statistics_snapshot(void)
+static timing_stats_t get_timing_statistics_snapshot(const timing_stats_t *stats)
 {
     timing_stats_t snapshot;
 
     portENTER_CRITICAL(&s_stats_lock);
-    snapshot = s_timing_stats;
+    snapshot = *stats;
     portEXIT_CRITICAL(&s_stats_lock);
 
     return snapshot;
 }
 
 /**
- * @brief Releases the control task from the periodic high-resolution timer.
+ * @brief Counts down every job period and marks due jobs as released.
+ *
+ * The release tick is the greatest common divisor of all job periods. Each
+ * job counts down its own period in ticks, so no division runs here. This is
+ * shared by both release sources.
+ *
+ * @param core_released Set to true for every core that owns a due job.
+ */
+static void IRAM_ATTR release_due_jobs(bool core_released[portNUM_PROCESSORS])
+{
+    for (size_t index = 0U; index < RT_TASK_COUNT; ++index) {
+        rt_job_state_t *job = &s_jobs[index];
+
+        if (--job->ticks_until_release != 0U) {
+            continue;
+        }
+        job->ticks_until_release = job->period_ticks;
+
+        const uint32_t previous = atomic_fetch_add_explicit(
+            &job->pending_releases,
+            1U,
+            memory_order_release);
+        if (previous > 0U) {
+            atomic_fetch_add_explicit(
+                &job->release_overruns,
+                1U,
+                memory_order_relaxed);
+        }
+
+        core_released[job->config->core] = true;
+    }
+}
+
+/**
+ * @brief Releases every due job from the GPTimer alarm ISR.
+ *
+ * The dispatchers are notified directly from the ISR, so no task sits
+ * between the alarm and the job.
+ *
+ * @param timer Timer that raised the alarm. Not used.
+ * @param event Alarm event data. Not used.
+ * @param context Optional callback argument. Not used.
+ * @return true when a higher-priority task was woken.
+ */
+static bool IRAM_ATTR release_timer_isr(
+    gptimer_handle_t timer,
+    const gptimer_alarm_event_data_t *event,
+    void *context)
+{
+    (void)timer;
+    (void)event;
+    (void)context;
+
+    BaseType_t higher_priority_task_woken = pdFALSE;
+    bool core_released[portNUM_PROCESSORS] = { false };
+
+    release_due_jobs(core_released);
+
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; ++core) {
+        if (core_released[core]) {
+            vTaskNotifyGiveFromISR(
+                s_dispatcher_handles[core],
+                &higher_priority_task_woken);
+        }
+    }
+
+    return higher_priority_task_woken == pdTRUE;
+}
+
+/**
+ * @brief Releases every due job from the esp_timer task.
+ *
+ * This is the baseline path: the esp_timer ISR first wakes the esp_timer
+ * task, which then runs this callback and notifies the dispatchers.
  *
  * @param argument Optional callback argument. Not used.
  */
-static void control_release_timer_callback(void *argument)
+static void release_esp_timer_callback(void *argument)
 {
     (void)argument;
 
-    const uint32_t previous = atomic_fetch_add_explicit(
-        &s_release_sequence,
+    bool core_released[portNUM_PROCESSORS] = { false };
+
+    release_due_jobs(core_released);
+
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; ++core) {
+        if (core_released[core]) {
+            xTaskNotifyGive(s_dispatcher_handles[core]);
+        }
+    }
+}
+
+#if CONFIG_RT_BUDGET_WATCHDOG
+/**
+ * @brief Flags the running job of one core as out of budget.
+ *
+ * The ISR preempts the job on its own core. The job polls the flag and
+ * returns early; the dispatcher then counts the cancellation.
+ *
+ * @param timer Timer that raised the alarm. Not used.
+ * @param event Alarm event data. Not used.
+ * @param context Core index cast to a pointer.
+ * @return false, because no task is woken.
+ */
+static bool IRAM_ATTR budget_timer_isr(
+    gptimer_handle_t timer,
+    const gptimer_alarm_event_data_t *event,
+    void *context)
+{
+    (void)timer;
+    (void)event;
+
+    atomic_store_explicit(
+        &s_budget_expired[(BaseType_t)(intptr_t)context],
+        true,
+        memory_order_relaxed);
+
+    return false;
+}
+
+/**
+ * @brief Creates the one-shot budget watchdog of the calling core.
+ *
+ * @param core Core the calling dispatcher is pinned to.
+ */
+static void create_budget_timer(BaseType_t core)
+{
+    const gptimer_config_t timer_config = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = RELEASE_TIMER_RESOLUTION_HZ,
+    };
+    const gptimer_event_callbacks_t callbacks = {
+        .on_alarm = budget_timer_isr,
+    };
+
+    ESP_ERROR_CHECK(gptimer_new_timer(&timer_config, &s_budget_timers[core]));
+    ESP_ERROR_CHECK(gptimer_register_event_callbacks(
+        s_budget_timers[core],
+        &callbacks,
+        (void *)(intptr_t)core));
+    ESP_ERROR_CHECK(gptimer_enable(s_budget_timers[core]));
+}
+
+/**
+ * @brief Arms the budget watchdog for the job about to start.
+ *
+ * @param core Core that runs the job.
+ * @param budget_us Execution budget of the job.
+ */
+static void arm_budget_timer(BaseType_t core, uint32_t budget_us)
+{
+    const gptimer_alarm_config_t alarm_config = {
+        .alarm_count = budget_us,
+        .reload_count = 0U,
+        .flags.auto_reload_on_alarm = false,
+    };
+
+    atomic_store_explicit(&s_budget_expired[core], false, memory_order_relaxed);
+    ESP_ERROR_CHECK(gptimer_set_raw_count(s_budget_timers[core], 0U));
+    ESP_ERROR_CHECK(gptimer_set_alarm_action(
+        s_budget_timers[core],
+        &alarm_config));
+    ESP_ERROR_CHECK(gptimer_start(s_budget_timers[core]));
+}
+
+/**
+ * @brief Stops the budget watchdog after the job returned.
+ *
+ * @param core Core that ran the job.
+ * @return true when the watchdog fired while the job was running.
+ */
+static bool disarm_budget_timer(BaseType_t core)
+{
+    ESP_ERROR_CHECK(gptimer_stop(s_budget_timers[core]));
+
+    return atomic_exchange_explicit(
+        &s_budget_expired[core],
+        false,
+        memory_order_relaxed);
+}
+#endif
+
+/**
+ * @brief Returns the intended release time of a job instance.
+ *
+ * @param job Job state.
+ * @param release_index Zero-based release number.
+ * @return Release time on the esp_timer time base in microseconds.
+ */
+static int64_t job_release_time_us(
+    const rt_job_state_t *job,
+    uint32_t release_index)
+{
+    return s_release_epoch_us + (int64_t)s_release_base_us +
+        ((int64_t)release_index * (int64_t)job->config->period_us);
+}
+
+/**
+ * @brief Picks the released job with the earliest absolute deadline.
+ *
+ * @param core Core whose jobs are considered.
+ * @return Job to run next, or NULL when nothing is pending.
+ */
+static rt_job_state_t *select_earliest_deadline_job(BaseType_t core)
+{
+    rt_job_state_t *selected = NULL;
+    int64_t selected_deadline_us = INT64_MAX;
+    const uint32_t generation = atomic_load_explicit(
+        &s_release_generation,
+        memory_order_acquire);
+
+    for (size_t index = 0U; index < RT_TASK_COUNT; ++index) {
+        rt_job_state_t *job = &s_jobs[index];
+        if (job->config->core != core) {
+            continue;
+        }
+
+        // A restarted release source counts releases from a new epoch.
+        if (job->generation != generation) {
+            job->generation = generation;
+            job->consumed_releases = 0U;
+        }
+
+        const uint32_t pending = atomic_load_explicit(
+            &job->pending_releases,
+            memory_order_acquire);
+        if (pending == 0U) {
+            continue;
+        }
+
+        const int64_t deadline_us = job_release_time_us(
+            job,
+            job->consumed_releases + pending - 1U) +
+            (int64_t)job->config->deadline_us;
+        if (deadline_us < selected_deadline_us) {
+            selected = job;
+            selected_deadline_us = deadline_us;
+        }
+    }
+
+    return selected;
+}
+
+/**
+ * @brief Picks the job body for the next instance and counts degraded runs.
+ *
+ * @param job Job about to run.
+ * @return Full or degraded job function.
+ */
+static rt_job_fn_t select_job_variant(rt_job_state_t *job)
+{
+    if (job->degraded_releases_left == 0U) {
+        return job->config->job;
+    }
+
+    job->degraded_releases_left--;
+    atomic_fetch_add_explicit(&job->degraded_runs, 1U, memory_order_relaxed);
+    return job->config->degraded_job;
+}
+
+/**
+ * @brief Applies the job's overrun policy after a missed deadline or budget.
+ *
+ * @param job Job whose instance just completed late.
+ */
+static void apply_overrun_policy(rt_job_state_t *job)
+{
+    switch (job->config->overrun_policy) {
+    case RT_OVERRUN_SKIP_NEXT:
+        job->skip_next_release = true;
+        break;
+    case RT_OVERRUN_DEGRADE:
+        // Each further miss restarts the hold, so recovery needs a clean run.
+        job->degraded_releases_left = DEGRADE_HOLD_RELEASES;
+        break;
+    case RT_OVERRUN_CONTINUE:
+    default:
+        break;
+    }
+}
+
+/**
+ * @brief Runs one job instance and records its timing.
+ *
+ * Releases that piled up while the job waited are collapsed into the
+ * latest one; they were already counted as overruns by the release ISR.
+ * A late instance triggers the job's overrun policy, and with the budget
+ * watchdog enabled an instance that exhausts its budget is cut short and
+ * the previous command is held.
+ *
+ * @param job Job to run.
+ * @param core Core of the calling dispatcher.
+ */
+static void run_job(rt_job_state_t *job, BaseType_t core)
+{
+    const uint32_t taken = atomic_exchange_explicit(
+        &job->pending_releases,
+        0U,
+        memory_order_acquire);
+    if (taken == 0U) {
+        return;
+    }
+
+    job->consumed_releases += taken;
+    if (job->skip_next_release) {
+        job->skip_next_release = false;
+        atomic_fetch_add_explicit(
+            &job->skipped_releases,
+            1U,
+            memory_order_relaxed);
+        return;
+    }
+
+    const uint32_t release_index = job->consumed_releases - 1U;
+    const int64_t release_time_us = job_release_time_us(job, release_index);
+    const int64_t start_time_us = esp_timer_get_time();
+
+    const int64_t jitter_signed = start_time_us - release_time_us;
+    const uint32_t release_jitter_us = (uint32_t)(
+        (jitter_signed >= 0) ? jitter_signed : -jitter_signed);
+
+    const int source = atomic_load_explicit(
+        &s_active_release_source,
+        memory_order_relaxed);
+    uint32_t bucket = release_jitter_us / JITTER_BUCKET_US;
+    if (bucket >= JITTER_HISTOGRAM_BUCKETS) {
+        bucket = JITTER_HISTOGRAM_BUCKETS - 1U;
+    }
+    atomic_fetch_add_explicit(
+        &job->jitter_histogram[source][bucket],
         1U,
         memory_order_relaxed);
 
-    if ((previous > 0U) && (eTaskGetState(s_control_task_handle) != eBlocked)) {
+    const rt_job_fn_t job_fn = select_job_variant(job);
+
+    gpio_set_level(PROFILE_GPIO, 1);
+#if CONFIG_RT_BUDGET_WATCHDOG
+    arm_budget_timer(core, job->config->wcet_budget_us);
+#else
+    (void)core;
+#endif
+    const uint32_t start_cycles = esp_cpu_get_cycle_count();
+
+    const uint32_t command = job_fn(release_index);
+
+    const uint32_t execution_cycles =
+        esp_cpu_get_cycle_count() - start_cycles;
+#if CONFIG_RT_BUDGET_WATCHDOG
+    const bool cancelled = disarm_budget_timer(core);
+#else
+    const bool cancelled = false;
+#endif
+    const int64_t completion_time_us = esp_timer_get_time();
+    const uint32_t response_time_us = (uint32_t)(
+        completion_time_us - release_time_us);
+    const bool deadline_missed =
+        response_time_us > job->config->deadline_us;
+    const bool budget_overrun = cancelled ||
+        ((uint32_t)(completion_time_us - start_time_us) >
+         job->config->wcet_budget_us);
+
+    // A cancelled instance produced no valid output, so the last one holds.
+    if (cancelled) {
         atomic_fetch_add_explicit(
-            &s_notification_overruns,
+            &job->budget_cancellations,
             1U,
             memory_order_relaxed);
+    } else {
+        job->last_command = command;
+    }
+    volatile uint32_t actuator_sink = job->last_command;
+    (void)actuator_sink;
+
+    rt_miss_cause_t miss_cause = RT_MISS_CAUSE_INTERFERENCE;
+    if (taken > 1U) {
+        miss_cause = RT_MISS_CAUSE_CASCADE;
+    } else if (budget_overrun) {
+        miss_cause = RT_MISS_CAUSE_OVERRUN;
+    }
+    if (deadline_missed || budget_overrun) {
+        apply_overrun_policy(job);
     }
 
-    xTaskNotifyGive(s_control_task_handle);
+    gpio_set_level(DEADLINE_MISS_GPIO, deadline_missed ? 1 : 0);
+    gpio_set_level(PROFILE_GPIO, 0);
+
+    const timing_sample_t sample = {
+        .timestamp_us = release_time_us,
+        .execution_cycles = execution_cycles,
+        .release_jitter_us = release_jitter_us,
+        .sequence = release_index,
+        .deadline_missed = deadline_missed,
+    };
+
+    (void)timing_sample_ring_push(&job->ring, &sample);
+    latency_histogram_record(
+        &job->execution_cycles_histogram,
+        execution_cycles);
+    latency_histogram_record(&job->release_jitter_histogram, release_jitter_us);
+    latency_histogram_record(&job->response_time_histogram, response_time_us);
+    update_timing_statistics(
+        &job->stats,
+        execution_cycles,
+        release_jitter_us,
+        response_time_us,
+        deadline_missed,
+        miss_cause,
+        budget_overrun);
+
+    if (deadline_missed) {
+        // The pulse remains high briefly so it is easy to capture externally.
+        esp_rom_delay_us(20U);
+        gpio_set_level(DEADLINE_MISS_GPIO, 0);
+    }
 }
 
 /**
- * @brief Executes the pinned hard real-time control task.
+ * @brief Executes released jobs of one core in earliest-deadline order.
  *
- * @param argument Optional task argument. Not used.
+ * @param argument Core index cast to a pointer.
  */
-static void control_task(void *argument)
+static void job_dispatcher_task(void *argument)
 {
-    (void)argument;
+    const BaseType_t core = (BaseType_t)(intptr_t)argument;
 
-    uint32_t expected_sequence = 0U;
-    int64_t expected_release_us = esp_timer_get_time() + CONTROL_PERIOD_US;
-    volatile uint32_t actuator_sink = 0U;
+#if CONFIG_RT_BUDGET_WATCHDOG
+    // The alarm interrupt must preempt this core, so create it from here.
+    create_budget_timer(core);
+#endif
 
     while (true) {
-        const uint32_t notifications = ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
-        const int64_t release_time_us = esp_timer_get_time();
+        (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        atomic_store_explicit(
+            &s_dispatcher_busy[core],
+            true,
+            memory_order_relaxed);
 
-        if (notifications > 1U) {
-            atomic_fetch_add_explicit(
-                &s_notification_overruns,
-                notifications - 1U,
-                memory_order_relaxed);
+        rt_job_state_t *job;
+        while ((job = select_earliest_deadline_job(core)) != NULL) {
+            run_job(job, core);
         }
 
-        const int64_t jitter_signed = release_time_us - expected_release_us;
-        const uint32_t release_jitter_us = (uint32_t)(
-            (jitter_signed >= 0) ? jitter_signed : -jitter_signed);
+        atomic_store_explicit(
+            &s_dispatcher_busy[core],
+            false,
+            memory_order_release);
+    }
+}
 
-        expected_sequence += notifications;
-        expected_release_us += (int64_t)CONTROL_PERIOD_US * notifications;
+/**
+ * @brief Starts delivering release ticks from one source.
+ *
+ * Must only be called while no source is running and no release is
+ * pending, so the ISR countdowns and the epoch can be rewritten safely.
+ *
+ * @param source Release source to start.
+ */
+static void start_release_source(release_source_t source)
+{
+    for (size_t index = 0U; index < RT_TASK_COUNT; ++index) {
+        // Every job is released on the first tick.
+        s_jobs[index].ticks_until_release = 1U;
+    }
 
-        gpio_set_level(PROFILE_GPIO, 1);
-        const uint32_t start_cycles = esp_cpu_get_cycle_count();
+    atomic_store_explicit(
+        &s_active_release_source,
+        (int)source,
+        memory_order_relaxed);
+    s_release_epoch_us = esp_timer_get_time();
+    atomic_fetch_add_explicit(
+        &s_release_generation,
+        1U,
+        memory_order_release);
 
-        actuator_sink = execute_control_algorithm(expected_sequence);
+    if (source == RELEASE_SOURCE_GPTIMER) {
+        ESP_ERROR_CHECK(gptimer_set_raw_count(s_release_timer, 0U));
+        ESP_ERROR_CHECK(gptimer_start(s_release_timer));
+    } else {
+        ESP_ERROR_CHECK(esp_timer_start_periodic(
+            s_release_esp_timer,
+            s_release_base_us));
+    }
+}
 
-        const uint32_t execution_cycles =
-            esp_cpu_get_cycle_count() - start_cycles;
-        const int64_t completion_time_us = esp_timer_get_time();
-        const uint32_t response_time_us = (uint32_t)(
-            completion_time_us - release_time_us);
-        const bool deadline_missed = response_time_us > CONTROL_DEADLINE_US;
+/**
+ * @brief Stops a release source and waits until all dispatchers are idle.
+ *
+ * @param source Release source to stop.
+ */
+static void stop_release_source(release_source_t source)
+{
+    if (source == RELEASE_SOURCE_GPTIMER) {
+        ESP_ERROR_CHECK(gptimer_stop(s_release_timer));
+    } else {
+        ESP_ERROR_CHECK(esp_timer_stop(s_release_esp_timer));
+    }
 
-        gpio_set_level(DEADLINE_MISS_GPIO, deadline_missed ? 1 : 0);
-        gpio_set_level(PROFILE_GPIO, 0);
+    const int64_t deadline_us = esp_timer_get_time() +
+        ((int64_t)RELEASE_DRAIN_TIMEOUT_MS * 1000LL);
+    bool drained = false;
 
-        const timing_sample_t sample = {
-            .timestamp_us = release_time_us,
-            .execution_cycles = execution_cycles,
-            .release_jitter_us = release_jitter_us,
-            .sequence = expected_sequence,
-            .deadline_missed = deadline_missed,
-        };
+    while (!drained && (esp_timer_get_time() < deadline_us)) {
+        drained = true;
+        for (size_t index = 0U; index < RT_TASK_COUNT; ++index) {
+            drained &= atomic_load_explicit(
+                &s_jobs[index].pending_releases,
+                memory_order_acquire) == 0U;
+        }
+        for (BaseType_t core = 0; core < portNUM_PROCESSORS; ++core) {
+            drained &= !atomic_load_explicit(
+                &s_dispatcher_busy[core],
+                memory_order_acquire);
+        }
+        if (!drained) {
+            vTaskDelay(pdMS_TO_TICKS(1U));
+        }
+    }
+
+    if (!drained) {
+        ESP_LOGW(TAG, "dispatchers still busy after stopping %s",
+                 s_release_source_names[source]);
+    }
+}
+
+/**
+ * @brief Logs the release-jitter histograms of both sources side by side.
+ */
+static void log_jitter_histograms(void)
+{
+    for (size_t job_index = 0U; job_index < RT_TASK_COUNT; ++job_index) {
+        rt_job_state_t *job = &s_jobs[job_index];
+
+        ESP_LOGI(
+            TAG,
+            "jitter job=%s bucket_us=%u %10s %10s",
+            job->config->name,
+            (unsigned)JITTER_BUCKET_US,
+            s_release_source_names[RELEASE_SOURCE_GPTIMER],
+            s_release_source_names[RELEASE_SOURCE_ESP_TIMER]);
+
+        for (uint32_t bucket = 0U; bucket < JITTER_HISTOGRAM_BUCKETS;
+             ++bucket) {
+            const uint32_t gptimer_count = (uint32_t)atomic_load_explicit(
+                &job->jitter_histogram[RELEASE_SOURCE_GPTIMER][bucket],
+                memory_order_relaxed);
+            const uint32_t esp_timer_count = (uint32_t)atomic_load_explicit(
+                &job->jitter_histogram[RELEASE_SOURCE_ESP_TIMER][bucket],
+                memory_order_relaxed);
 
-        (void)lockfree_ring_push(&s_timing_ring, &sample);
-        update_timing_statistics(
-            execution_cycles,
-            release_jitter_us,
-            deadline_missed);
+            if ((gptimer_count == 0U) && (esp_timer_count == 0U)) {
+                continue;
+            }
 
-        if (deadline_missed) {
-            // The pulse remains high briefly so it is easy to capture externally.
-            esp_rom_delay_us(20U);
-            gpio_set_level(DEADLINE_MISS_GPIO, 0);
+            if (bucket == (JITTER_HISTOGRAM_BUCKETS - 1U)) {
+                ESP_LOGI(
+                    TAG,
+                    "  >= %4" PRIu32 " us        %10" PRIu32 " %10" PRIu32,
+                    bucket * JITTER_BUCKET_US,
+                    gptimer_count,
+                    esp_timer_count);
+            } else {
+                ESP_LOGI(
+                    TAG,
+                    "  %4" PRIu32 "..%4" PRIu32 " us  %10" PRIu32 " %10" PRIu32,
+                    bucket * JITTER_BUCKET_US,
+                    ((bucket + 1U) * JITTER_BUCKET_US) - 1U,
+                    gptimer_count,
+                    esp_timer_count);
+            }
         }
     }
 }
 
 /**
- * @brief Consumes timing samples and reports aggregated statistics.
+ * @brief Consumes timing samples and reports statistics for every job.
  *
  * @param argument Optional task argument. Not used.
  */
@@ -256,58 +1116,183 @@ static void telemetry_task(void *argument)
 {
     (void)argument;
 
-    uint64_t consumed_samples = 0U;
-    uint64_t consumed_deadline_misses = 0U;
+#if CONFIG_RT_TELEMETRY_BINARY
+    if (telemetry_stream_init() != ESP_OK) {
+        ESP_LOGW(TAG, "binary telemetry disabled");
+    }
+#endif
+
+    uint64_t consumed_samples[RT_TASK_COUNT] = { 0U };
+    uint64_t consumed_deadline_misses[RT_TASK_COUNT] = { 0U };
     int64_t last_report_us = esp_timer_get_time();
+    int64_t phase_start_us = last_report_us;
 
     while (true) {
-        timing_sample_t sample;
-
-        while (lockfree_ring_pop(&s_timing_ring, &sample)) {
-            consumed_samples++;
-            if (sample.deadline_missed) {
-                consumed_deadline_misses++;
+        for (size_t job_index = 0U; job_index < RT_TASK_COUNT; ++job_index) {
+            rt_job_state_t *job = &s_jobs[job_index];
+            const timing_sample_t *span = NULL;
+            size_t count;
+
+            // Drain whole spans in place so one acquire/release pair covers a
+            // batch.
+            while ((count = timing_sample_ring_peek(
+                        &job->ring,
+                        &span,
+                        TIMING_RING_CAPACITY)) > 0U) {
+                for (size_t index = 0U; index < count; ++index) {
+                    if (span[index].deadline_missed) {
+                        consumed_deadline_misses[job_index]++;
+                    }
+                }
+                consumed_samples[job_index] += count;
+#if CONFIG_RT_TELEMETRY_BINARY
+                telemetry_stream_send((uint8_t)job_index, span, count);
+#endif
+                timing_sample_ring_commit(&job->ring, count);
             }
         }
 
         const int64_t now_us = esp_timer_get_time();
         if ((now_us - last_report_us) >=
             ((int64_t)TELEMETRY_REPORT_MS * 1000LL)) {
-            const timing_stats_t stats = get_timing_statistics_snapshot();
-            const uint32_t overruns = (uint32_t)atomic_load_explicit(
-                &s_notification_overruns,
-                memory_order_relaxed);
+            for (size_t job_index = 0U; job_index < RT_TASK_COUNT;
+                 ++job_index) {
+                rt_job_state_t *job = &s_jobs[job_index];
+                const timing_stats_t stats =
+                    get_timing_statistics_snapshot(&job->stats);
+                const uint32_t overruns = (uint32_t)atomic_load_explicit(
+                    &job->release_overruns,
+                    memory_order_relaxed);
+                const uint32_t skipped = (uint32_t)atomic_load_explicit(
+                    &job->skipped_releases,
+                    memory_order_relaxed);
+                const uint32_t degraded = (uint32_t)atomic_load_explicit(
+                    &job->degraded_runs,
+                    memory_order_relaxed);
+                const uint32_t cancelled = (uint32_t)atomic_load_explicit(
+                    &job->budget_cancellations,
+                    memory_order_relaxed);
+
+                ESP_LOGI(
+                    TAG,
+                    "job=%s samples=%" PRIu64
+                    " consumed=%" PRIu64
+                    " misses=%" PRIu64
+                    " consumed_misses=%" PRIu64
+                    " min_cycles=%" PRIu32
+                    " max_cycles=%" PRIu32
+                    " max_jitter_us=%" PRIu32
+                    " max_response_us=%" PRIu32
+                    " budget_overruns=%" PRIu64
+                    " overruns=%" PRIu32
+                    " dropped=%" PRIu32,
+                    job->config->name,
+                    stats.samples,
+                    consumed_samples[job_index],
+                    stats.deadline_misses,
+                    consumed_deadline_misses[job_index],
+                    stats.min_execution_cycles,
+                    stats.max_execution_cycles,
+                    stats.max_release_jitter_us,
+                    stats.max_response_time_us,
+                    stats.budget_overruns,
+                    overruns,
+                    timing_sample_ring_get_dropped(&job->ring));
+
+                ESP_LOGI(
+                    TAG,
+                    "job=%s policy=%s miss_overrun=%" PRIu64
+                    " miss_interference=%" PRIu64
+                    " miss_cascade=%" PRIu64
+                    " skipped=%" PRIu32
+                    " degraded=%" PRIu32
+                    " cancelled=%" PRIu32,
+                    job->config->name,
+                    s_overrun_policy_names[job->config->overrun_policy],
+                    stats.misses_by_cause[RT_MISS_CAUSE_OVERRUN],
+                    stats.misses_by_cause[RT_MISS_CAUSE_INTERFERENCE],
+                    stats.misses_by_cause[RT_MISS_CAUSE_CASCADE],
+                    skipped,
+                    degraded,
+                    cancelled);
+
+                latency_percentiles_t cycles;
+                latency_percentiles_t jitter;
+                latency_percentiles_t response;
+                latency_histogram_get_percentiles(
+                    &job->execution_cycles_histogram,
+                    &cycles);
+                latency_histogram_get_percentiles(
+                    &job->release_jitter_histogram,
+                    &jitter);
+                latency_histogram_get_percentiles(
+                    &job->response_time_histogram,
+                    &response);
+
+                ESP_LOGI(
+                    TAG,
+                    "job=%s p50/p99/p99.9/max"
+                    " cycles=%" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32
+                    " jitter_us=%" PRIu32 "/%" PRIu32 "/%" PRIu32 "/%" PRIu32
+                    " response_us=%" PRIu32 "/%" PRIu32 "/%" PRIu32
+                    "/%" PRIu32,
+                    job->config->name,
+                    cycles.p50,
+                    cycles.p99,
+                    cycles.p999,
+                    cycles.max,
+                    jitter.p50,
+                    jitter.p99,
+                    jitter.p999,
+                    jitter.max,
+                    response.p50,
+                    response.p99,
+                    response.p999,
+                    response.max);
+            }
 
+#if CONFIG_RT_TELEMETRY_BINARY
             ESP_LOGI(
                 TAG,
-                "samples=%" PRIu64
-                " consumed=%" PRIu64
-                " misses=%" PRIu64
-                " consumed_misses=%" PRIu64
-                " min_cycles=%" PRIu32
-                " max_cycles=%" PRIu32
-                " max_jitter_us=%" PRIu32
-                " overruns=%" PRIu32
-                " dropped=%" PRIu32,
-                stats.samples,
-                consumed_samples,
-                stats.deadline_misses,
-                consumed_deadline_misses,
-                stats.min_execution_cycles,
-                stats.max_execution_cycles,
-                stats.max_release_jitter_us,
-                overruns,
-                lockfree_ring_get_dropped(&s_timing_ring));
+                "binary_frames_dropped=%" PRIu32,
+                telemetry_stream_get_dropped_frames());
+#endif
 
             last_report_us = now_us;
         }
 
+        if ((now_us - phase_start_us) >= ((int64_t)JITTER_PHASE_MS * 1000LL)) {
+#if CONFIG_RT_RELEASE_SOURCE_COMPARE
+            const release_source_t current = (release_source_t)
+                atomic_load_explicit(
+                    &s_active_release_source,
+                    memory_order_relaxed);
+            const release_source_t next =
+                (current == RELEASE_SOURCE_GPTIMER) ?
+                RELEASE_SOURCE_ESP_TIMER : RELEASE_SOURCE_GPTIMER;
+
+            stop_release_source(current);
+            if (next == RELEASE_SOURCE_GPTIMER) {
+                // Both sources have completed a phase.
+                log_jitter_histograms();
+            }
+            ESP_LOGI(TAG, "release source -> %s", s_release_source_names[next]);
+            start_release_source(next);
+#else
+            log_jitter_histograms();
+#endif
+            phase_start_us = esp_timer_get_time();
+        }
+
         vTaskDelay(pdMS_TO_TICKS(10U));
     }
 }
 
 /**
- * @brief Generates service-core load and protected shared-state activity.
+ * @brief Generates background load and protected shared-state activity.
+ *
+ * Runs as a background task, so it returns whenever the placement balancer
+ * wants it on the other core and is restarted there.
  *
  * @param argument Optional task argument. Not used.
  */
@@ -317,7 +1302,7 @@ static void service_stress_task(void *argument)
 
     uint32_t local = 0x12345678U;
 
-    while (true) {
+    while (!task_placement_migration_pending()) {
         for (uint32_t index = 0U; index < 10000U; ++index) {
             local ^= local << 13U;
             local ^= local >> 17U;
@@ -334,22 +1319,121 @@ static void service_stress_task(void *argument)
 }
 
 /**
- * @brief Creates the high-resolution periodic release timer.
+ * @brief Initializes per-job state and derives the release timer period.
+ */
+static void init_job_table(void)
+{
+    s_release_base_us = 0U;
+    for (size_t index = 0U; index < RT_TASK_COUNT; ++index) {
+        s_release_base_us = gcd_u32(
+            s_release_base_us,
+            s_task_table[index].period_us);
+    }
+
+    for (size_t index = 0U; index < RT_TASK_COUNT; ++index) {
+        rt_job_state_t *job = &s_jobs[index];
+
+        memset(&job->stats, 0, sizeof(job->stats));
+        job->config = &s_task_table[index];
+        job->period_ticks = job->config->period_us / s_release_base_us;
+        // Every job is released on the first alarm.
+        job->ticks_until_release = 1U;
+        atomic_init(&job->pending_releases, 0U);
+        atomic_init(&job->release_overruns, 0U);
+        atomic_init(&job->skipped_releases, 0U);
+        atomic_init(&job->degraded_runs, 0U);
+        atomic_init(&job->budget_cancellations, 0U);
+        job->consumed_releases = 0U;
+        job->generation = 0U;
+        job->skip_next_release = false;
+        job->degraded_releases_left = 0U;
+        job->last_command = 0U;
+        configASSERT((job->config->overrun_policy != RT_OVERRUN_DEGRADE) ||
+                     (job->config->degraded_job != NULL));
+        for (size_t source = 0U; source < RELEASE_SOURCE_COUNT; ++source) {
+            for (size_t bucket = 0U; bucket < JITTER_HISTOGRAM_BUCKETS;
+                 ++bucket) {
+                atomic_init(&job->jitter_histogram[source][bucket], 0U);
+            }
+        }
+        latency_histogram_init(&job->execution_cycles_histogram);
+        latency_histogram_init(&job->release_jitter_histogram);
+        latency_histogram_init(&job->response_time_histogram);
+        timing_sample_ring_init(&job->ring);
+    }
+}
+
+/**
+ * @brief Creates the GPTimer release source on the calling core.
+ *
+ * The GPTimer interrupt is allocated on the core that registers the
+ * callbacks, so this runs in a short-lived task pinned to CONTROL_CORE.
+ *
+ * @param argument Handle of the task waiting for completion.
  */
-static void create_control_release_timer(void)
+static void release_timer_setup_task(void *argument)
+{
+    const TaskHandle_t waiter = (TaskHandle_t)argument;
+    const gptimer_config_t timer_config = {
+        .clk_src = GPTIMER_CLK_SRC_DEFAULT,
+        .direction = GPTIMER_COUNT_UP,
+        .resolution_hz = RELEASE_TIMER_RESOLUTION_HZ,
+    };
+    const gptimer_event_callbacks_t callbacks = {
+        .on_alarm = release_timer_isr,
+    };
+    const gptimer_alarm_config_t alarm_config = {
+        .alarm_count = s_release_base_us,
+        .reload_count = 0U,
+        .flags.auto_reload_on_alarm = true,
+    };
+
+    ESP_ERROR_CHECK(gptimer_new_timer(&timer_config, &s_release_timer));
+    ESP_ERROR_CHECK(gptimer_register_event_callbacks(
+        s_release_timer,
+        &callbacks,
+        NULL));
+    ESP_ERROR_CHECK(gptimer_enable(s_release_timer));
+    ESP_ERROR_CHECK(gptimer_set_alarm_action(s_release_timer, &alarm_config));
+
+    xTaskNotifyGive(waiter);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Creates both release sources and starts the configured one.
+ */
+static void create_release_timers(void)
 {
     const esp_timer_create_args_t timer_args = {
-        .callback = control_release_timer_callback,
+        .callback = release_esp_timer_callback,
         .arg = NULL,
         .dispatch_method = ESP_TIMER_TASK,
-        .name = "control_release",
+        .name = "job_release",
         .skip_unhandled_events = false,
     };
 
-    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &s_release_timer));
-    ESP_ERROR_CHECK(esp_timer_start_periodic(
-        s_release_timer,
-        CONTROL_PERIOD_US));
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &s_release_esp_timer));
+
+    const task_placement_spec_t setup_spec = {
+        .function = release_timer_setup_task,
+        .name = "release_setup",
+        .stack_size = CONTROL_TASK_STACK_SIZE,
+        .argument = xTaskGetCurrentTaskHandle(),
+        .priority = CONTROL_TASK_PRIORITY,
+        .task_class = TASK_CLASS_LATENCY_CRITICAL,
+    };
+    ESP_ERROR_CHECK(task_placement_spawn_on_core(
+        &setup_spec,
+        CONTROL_CORE,
+        NULL));
+    (void)ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+#if CONFIG_RT_RELEASE_SOURCE_ESP_TIMER
+    start_release_source(RELEASE_SOURCE_ESP_TIMER);
+#else
+    start_release_source(RELEASE_SOURCE_GPTIMER);
+#endif
 }
 
 /**
@@ -357,47 +1441,104 @@ static void create_control_release_timer(void)
  */
 void realtime_scheduler_start(void)
 {
-    memset(&s_timing_stats, 0, sizeof(s_timing_stats));
-    atomic_init(&s_release_sequence, 0U);
-    atomic_init(&s_notification_overruns, 0U);
-    lockfree_ring_init(&s_timing_ring);
+    atomic_init(&s_active_release_source, (int)RELEASE_SOURCE_GPTIMER);
+    atomic_init(&s_release_generation, 0U);
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; ++core) {
+        atomic_init(&s_dispatcher_busy[core], false);
+        atomic_init(&s_budget_expired[core], false);
+    }
+    init_job_table();
     configure_profile_gpios();
 
-    BaseType_t result = xTaskCreatePinnedToCore(
-        control_task,
-        "control_task",
-        CONTROL_TASK_STACK_SIZE,
-        NULL,
-        CONTROL_TASK_PRIORITY,
-        &s_control_task_handle,
-        CONTROL_CORE);
-    configASSERT(result == pdPASS);
-
-    result = xTaskCreatePinnedToCore(
-        telemetry_task,
-        "telemetry_task",
-        TELEMETRY_TASK_STACK_SIZE,
-        NULL,
-        TELEMETRY_TASK_PRIORITY,
-        NULL,
-        SERVICE_CORE);
-    configASSERT(result == pdPASS);
-
-    result = xTaskCreatePinnedToCore(
-        service_stress_task,
-        "service_stress",
-        STRESS_TASK_STACK_SIZE,
-        NULL,
-        STRESS_TASK_PRIORITY,
-        NULL,
-        SERVICE_CORE);
-    configASSERT(result == pdPASS);
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; ++core) {
+        if (!check_core_schedulability(core)) {
+            ESP_LOGW(TAG, "core %d: deadline misses are expected", core);
+        }
+    }
+
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; ++core) {
+        bool core_used = false;
+        for (size_t index = 0U; index < RT_TASK_COUNT; ++index) {
+            core_used |= (s_task_table[index].core == core);
+        }
+        if (!core_used) {
+            continue;
+        }
 
-    create_control_release_timer();
+        // Each dispatcher serves the jobs of its own core.
+        const task_placement_spec_t dispatcher_spec = {
+            .function = job_dispatcher_task,
+            .name = (core == CONTROL_CORE) ? "rt_dispatch0" : "rt_dispatch1",
+            .stack_size = CONTROL_TASK_STACK_SIZE,
+            .argument = (void *)(intptr_t)core,
+            .priority = CONTROL_TASK_PRIORITY,
+            .task_class = TASK_CLASS_LATENCY_CRITICAL,
+        };
+        ESP_ERROR_CHECK(task_placement_spawn_on_core(
+            &dispatcher_spec,
+            core,
+            &s_dispatcher_handles[core]));
+    }
+
+    const task_placement_spec_t telemetry_spec = {
+        .function = telemetry_task,
+        .name = "telemetry_task",
+        .stack_size = TELEMETRY_TASK_STACK_SIZE,
+        .argument = NULL,
+        .priority = TELEMETRY_TASK_PRIORITY,
+        .task_class = TASK_CLASS_THROUGHPUT,
+    };
+    ESP_ERROR_CHECK(task_placement_spawn(&telemetry_spec, NULL));
+
+    const task_placement_spec_t stress_spec = {
+        .function = service_stress_task,
+        .name = "service_stress",
+        .stack_size = STRESS_TASK_STACK_SIZE,
+        .argument = NULL,
+        .priority = STRESS_TASK_PRIORITY,
+        .task_class = TASK_CLASS_BACKGROUND,
+    };
+    ESP_ERROR_CHECK(task_placement_spawn(&stress_spec, NULL));
+
+    ESP_ERROR_CHECK(task_placement_start_balancer(PLACEMENT_TASK_PRIORITY));
+
+    create_release_timers();
 
     ESP_LOGI(TAG, "Real-time scheduler demo started");
-    ESP_LOGI(TAG, "Control task pinned to core %d", CONTROL_CORE);
-    ESP_LOGI(TAG, "Service tasks pinned to core %d", SERVICE_CORE);
+    ESP_LOGI(
+        TAG,
+        "%u jobs released by %s every %" PRIu32 " us",
+        (unsigned)RT_TASK_COUNT,
+        s_release_source_names[atomic_load_explicit(
+            &s_active_release_source,
+            memory_order_relaxed)],
+        s_release_base_us);
+#if CONFIG_RT_RELEASE_SOURCE_COMPARE
+    ESP_LOGI(
+        TAG,
+        "Comparing release sources, %u s per phase",
+        (unsigned)CONFIG_RT_JITTER_PHASE_S);
+#endif
+    for (size_t index = 0U; index < RT_TASK_COUNT; ++index) {
+        const rt_task_config_t *config = &s_task_table[index];
+        ESP_LOGI(
+            TAG,
+            "job=%s period=%" PRIu32 " us deadline=%" PRIu32
+            " us budget=%" PRIu32 " us core=%d overrun=%s",
+            config->name,
+            config->period_us,
+            config->deadline_us,
+            config->wcet_budget_us,
+            config->core,
+            s_overrun_policy_names[config->overrun_policy]);
+    }
+#if CONFIG_RT_BUDGET_WATCHDOG
+    ESP_LOGI(TAG, "Budget watchdog cancels jobs that exhaust their budget");
+#endif
+    ESP_LOGI(
+        TAG,
+        "Telemetry pinned to core %d, background load placed by balancer",
+        SERVICE_CORE);
     ESP_LOGI(
         TAG,
         "GPIO %d: execution pulse, GPIO %d: deadline-miss pulse",
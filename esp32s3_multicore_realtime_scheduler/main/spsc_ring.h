@@ -0,0 +1,170 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Alignment used to keep producer state, consumer state, and storage on
+ * separate cache lines. 64 bytes covers every ESP32-S3 data-cache line
+ * configuration, including rings placed in PSRAM.
+ */
+#define SPSC_RING_CACHE_LINE_SIZE 64U
+
+/**
+ * @brief Generates a typed single-producer, single-consumer ring buffer.
+ *
+ * The macro expands to a ring type named <name>_t and the static inline
+ * functions <name>_init(), <name>_push(), <name>_pop(), <name>_pop_batch(),
+ * <name>_peek(), <name>_commit(), <name>_count(), and <name>_get_dropped().
+ * <name>_peek() exposes a contiguous span of readable elements in place and
+ * <name>_commit() releases them back to the producer.
+ *
+ * The capacity must be a power of two, which lets indices run freely and be
+ * masked instead of reduced with a modulo. All slots are usable.
+ *
+ * Each side owns one cache line holding its published index and a private
+ * copy of the opposite index. The opposite index is only reloaded when the
+ * cached copy says the ring looks full or empty, so in steady state each
+ * operation touches a single shared line.
+ *
+ * @param name Prefix for the generated type and functions.
+ * @param type Element type stored by value.
+ * @param capacity Number of elements. Must be a power of two.
+ */
+#define SPSC_RING_DEFINE(name, type, capacity)                                 \
+    _Static_assert(((capacity) & ((capacity) - 1U)) == 0U,                     \
+                   #name " capacity must be a power of two");                  \
+                                                                               \
+    typedef struct {                                                           \
+        struct {                                                               \
+            _Alignas(SPSC_RING_CACHE_LINE_SIZE) atomic_size_t head;            \
+            size_t cached_tail;                                                \
+            atomic_uint_fast32_t dropped;                                      \
+        } producer;                                                            \
+        struct {                                                               \
+            _Alignas(SPSC_RING_CACHE_LINE_SIZE) atomic_size_t tail;            \
+            size_t cached_head;                                                \
+        } consumer;                                                            \
+        _Alignas(SPSC_RING_CACHE_LINE_SIZE) type items[(capacity)];            \
+    } name##_t;                                                                \
+                                                                               \
+    static inline void name##_init(name##_t *ring)                             \
+    {                                                                          \
+        memset(ring->items, 0, sizeof(ring->items));                           \
+        atomic_init(&ring->producer.head, 0U);                                 \
+        ring->producer.cached_tail = 0U;                                       \
+        atomic_init(&ring->producer.dropped, 0U);                              \
+        atomic_init(&ring->consumer.tail, 0U);                                 \
+        ring->consumer.cached_head = 0U;                                       \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_push(name##_t *ring, const type *item)           \
+    {                                                                          \
+        const size_t head = atomic_load_explicit(&ring->producer.head,         \
+                                                 memory_order_relaxed);        \
+                                                                               \
+        if ((head - ring->producer.cached_tail) >= (capacity)) {               \
+            ring->producer.cached_tail = atomic_load_explicit(                 \
+                &ring->consumer.tail, memory_order_acquire);                   \
+            if ((head - ring->producer.cached_tail) >= (capacity)) {           \
+                atomic_fetch_add_explicit(&ring->producer.dropped, 1U,         \
+                                          memory_order_relaxed);               \
+                return false;                                                  \
+            }                                                                  \
+        }                                                                      \
+                                                                               \
+        ring->items[head & ((capacity) - 1U)] = *item;                         \
+        atomic_store_explicit(&ring->producer.head, head + 1U,                 \
+                              memory_order_release);                           \
+        return true;                                                           \
+    }                                                                          \
+                                                                               \
+    static inline size_t name##_pop_batch(name##_t *ring,                      \
+                                          type *items,                         \
+                                          size_t max_count)                    \
+    {                                                                          \
+        const size_t tail = atomic_load_explicit(&ring->consumer.tail,         \
+                                                 memory_order_relaxed);        \
+        size_t available = ring->consumer.cached_head - tail;                  \
+                                                                               \
+        if (available < max_count) {                                           \
+            ring->consumer.cached_head = atomic_load_explicit(                 \
+                &ring->producer.head, memory_order_acquire);                   \
+            available = ring->consumer.cached_head - tail;                     \
+        }                                                                      \
+                                                                               \
+        const size_t count = (available < max_count) ? available : max_count;  \
+        for (size_t offset = 0U; offset < count; ++offset) {                   \
+            items[offset] = ring->items[(tail + offset) & ((capacity) - 1U)];  \
+        }                                                                      \
+                                                                               \
+        if (count > 0U) {                                                      \
+            atomic_store_explicit(&ring->consumer.tail, tail + count,          \
+                                  memory_order_release);                       \
+        }                                                                      \
+        return count;                                                          \
+    }                                                                          \
+                                                                               \
+    static inline bool name##_pop(name##_t *ring, type *item)                  \
+    {                                                                          \
+        return name##_pop_batch(ring, item, 1U) == 1U;                         \
+    }                                                                          \
+                                                                               \
+    static inline size_t name##_peek(name##_t *ring,                           \
+                                     const type **span,                        \
+                                     size_t max_count)                         \
+    {                                                                          \
+        const size_t tail = atomic_load_explicit(&ring->consumer.tail,         \
+                                                 memory_order_relaxed);        \
+        const size_t first = tail & ((capacity) - 1U);                         \
+        const size_t until_wrap = (capacity) - first;                          \
+        const size_t limit =                                                   \
+            (max_count < until_wrap) ? max_count : until_wrap;                 \
+        size_t available = ring->consumer.cached_head - tail;                  \
+                                                                               \
+        if (available < limit) {                                               \
+            ring->consumer.cached_head = atomic_load_explicit(                 \
+                &ring->producer.head, memory_order_acquire);                   \
+            available = ring->consumer.cached_head - tail;                     \
+        }                                                                      \
+                                                                               \
+        *span = &ring->items[first];                                           \
+        return (available < limit) ? available : limit;                        \
+    }                                                                          \
+                                                                               \
+    static inline void name##_commit(name##_t *ring, size_t count)             \
+    {                                                                          \
+        const size_t tail = atomic_load_explicit(&ring->consumer.tail,         \
+                                                 memory_order_relaxed);        \
+        atomic_store_explicit(&ring->consumer.tail, tail + count,              \
+                              memory_order_release);                           \
+    }                                                                          \
+                                                                               \
+    static inline size_t name##_count(name##_t *ring)                          \
+    {                                                                          \
+        const size_t tail = atomic_load_explicit(&ring->consumer.tail,         \
+                                                 memory_order_acquire);        \
+        const size_t head = atomic_load_explicit(&ring->producer.head,         \
+                                                 memory_order_acquire);        \
+        return head - tail;                                                    \
+    }                                                                          \
+                                                                               \
+    static inline uint32_t name##_get_dropped(name##_t *ring)                  \
+    {                                                                          \
+        return (uint32_t)atomic_load_explicit(&ring->producer.dropped,         \
+                                              memory_order_relaxed);           \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
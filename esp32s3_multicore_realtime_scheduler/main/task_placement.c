@@ -0,0 +1,549 @@
+#include "task_placement.h"
+
+#include <inttypes.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "sdkconfig.h"
+
+#define NO_TARGET_CORE           (-1)
+#define BALANCER_STACK_SIZE      4096
+#define SYSTEM_STATE_CAPACITY    40U
+
+#define BALANCE_PERIOD_MS        CONFIG_RT_PLACEMENT_BALANCE_MS
+#define IMBALANCE_PCT            ((uint32_t)CONFIG_RT_PLACEMENT_IMBALANCE_PCT)
+#define COOLDOWN_PERIODS         ((uint32_t)CONFIG_RT_PLACEMENT_COOLDOWN_PERIODS)
+#define REPORT_PERIODS \
+    (((CONFIG_RT_PLACEMENT_REPORT_S * 1000U) + BALANCE_PERIOD_MS - 1U) / \
+     BALANCE_PERIOD_MS)
+
+#if !CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS
+#error "task_placement needs CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS"
+#endif
+
+typedef struct {
+    task_placement_spec_t spec;
+    TaskHandle_t handle;
+    BaseType_t core;
+    bool movable;
+    atomic_int target_core;
+    // Owned by the balancer task.
+    TaskHandle_t sampled_handle;
+    uint32_t sampled_runtime;
+    uint32_t load_pct;
+} placed_task_t;
+
+static const char *TAG = "task_placement";
+
+static portMUX_TYPE s_lock = portMUX_INITIALIZER_UNLOCKED;
+static placed_task_t s_tasks[TASK_PLACEMENT_MAX_TASKS];
+static size_t s_task_count;
+static atomic_uint s_core_utilization[portNUM_PROCESSORS];
+static atomic_uint s_migrations;
+static TaskHandle_t s_balancer_handle;
+static TaskStatus_t s_system_state[SYSTEM_STATE_CAPACITY];
+
+static const char *const s_class_names[TASK_CLASS_COUNT] = {
+    [TASK_CLASS_LATENCY_CRITICAL] = "latency",
+    [TASK_CLASS_THROUGHPUT] = "throughput",
+    [TASK_CLASS_BACKGROUND] = "background",
+};
+
+/**
+ * @brief Runs a movable task and recreates it when it returns to migrate.
+ *
+ * @param argument Placement slot of the task.
+ */
+static void placement_trampoline(void *argument)
+{
+    placed_task_t *task = (placed_task_t *)argument;
+
+    while (true) {
+        task->spec.function(task->spec.argument);
+
+        const int target = atomic_exchange_explicit(
+            &task->target_core,
+            NO_TARGET_CORE,
+            memory_order_acq_rel);
+        if (target == NO_TARGET_CORE) {
+            ESP_LOGE(TAG, "%s returned without a migration request",
+                     task->spec.name);
+            portENTER_CRITICAL(&s_lock);
+            task->handle = NULL;
+            portEXIT_CRITICAL(&s_lock);
+            break;
+        }
+
+        TaskHandle_t handle = NULL;
+        if (xTaskCreatePinnedToCore(
+                placement_trampoline,
+                task->spec.name,
+                task->spec.stack_size,
+                task,
+                task->spec.priority,
+                &handle,
+                (BaseType_t)target) == pdPASS) {
+            portENTER_CRITICAL(&s_lock);
+            task->handle = handle;
+            task->core = (BaseType_t)target;
+            portEXIT_CRITICAL(&s_lock);
+            atomic_fetch_add_explicit(&s_migrations, 1U, memory_order_relaxed);
+            break;
+        }
+
+        // Could not allocate the replacement; resume here instead.
+        ESP_LOGW(TAG, "%s: migration to core %d failed", task->spec.name,
+                 target);
+    }
+
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Claims a placement slot and creates the task pinned to a core.
+ *
+ * @param spec Task description.
+ * @param core Core to pin the task to.
+ * @param movable Whether the balancer may move the task later.
+ * @param handle Optional output for the task handle.
+ * @return ESP_OK on success, or the error described in task_placement.h.
+ */
+static esp_err_t spawn_pinned(
+    const task_placement_spec_t *spec,
+    BaseType_t core,
+    bool movable,
+    TaskHandle_t *handle)
+{
+    if ((spec == NULL) || (spec->function == NULL) || (spec->name == NULL) ||
+        (spec->task_class >= TASK_CLASS_COUNT) || (core < 0) ||
+        (core >= portNUM_PROCESSORS)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    placed_task_t *task = NULL;
+    portENTER_CRITICAL(&s_lock);
+    if (s_task_count < TASK_PLACEMENT_MAX_TASKS) {
+        task = &s_tasks[s_task_count++];
+        memset(task, 0, sizeof(*task));
+        task->spec = *spec;
+        task->core = core;
+        task->movable = movable;
+        atomic_init(&task->target_core, NO_TARGET_CORE);
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    if (task == NULL) {
+        ESP_LOGE(TAG, "%s: no free placement slot", spec->name);
+        return ESP_ERR_NO_MEM;
+    }
+
+    TaskHandle_t created = NULL;
+    const BaseType_t result = xTaskCreatePinnedToCore(
+        movable ? placement_trampoline : spec->function,
+        spec->name,
+        spec->stack_size,
+        movable ? (void *)task : spec->argument,
+        spec->priority,
+        &created,
+        core);
+    if (result != pdPASS) {
+        // The slot stays claimed with a NULL handle and is ignored.
+        ESP_LOGE(TAG, "%s: task creation failed", spec->name);
+        return ESP_ERR_NO_MEM;
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    task->handle = created;
+    portEXIT_CRITICAL(&s_lock);
+
+    if (handle != NULL) {
+        *handle = created;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Returns the core with the lowest utilization in the last sample.
+ *
+ * Ties go to the service core so the control core stays quiet until the
+ * balancer has data.
+ *
+ * @return Least-loaded core.
+ */
+static BaseType_t least_loaded_core(void)
+{
+    BaseType_t best = TASK_PLACEMENT_SERVICE_CORE;
+    uint32_t best_utilization = task_placement_get_core_utilization(best);
+
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; ++core) {
+        const uint32_t utilization = task_placement_get_core_utilization(core);
+        if (utilization < best_utilization) {
+            best = core;
+            best_utilization = utilization;
+        }
+    }
+
+    return best;
+}
+
+/**
+ * @brief Finds a task's run-time counter in the current system snapshot.
+ *
+ * @param count Number of valid entries in s_system_state.
+ * @param handle Task to look up.
+ * @param runtime Output for the task's run-time counter.
+ * @return true if the task is in the snapshot.
+ */
+static bool find_runtime(
+    UBaseType_t count,
+    TaskHandle_t handle,
+    uint32_t *runtime)
+{
+    for (UBaseType_t index = 0U; index < count; ++index) {
+        if (s_system_state[index].xHandle == handle) {
+            *runtime = (uint32_t)s_system_state[index].ulRunTimeCounter;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Converts a run-time delta into a percentage of the sample period.
+ *
+ * @param delta Run time spent in the period.
+ * @param elapsed Length of the period in run-time counter units.
+ * @return Percentage clamped to 100.
+ */
+static uint32_t percent_of(uint32_t delta, uint32_t elapsed)
+{
+    const uint64_t percent = ((uint64_t)delta * 100U) / elapsed;
+
+    return (percent > 100U) ? 100U : (uint32_t)percent;
+}
+
+/**
+ * @brief Updates per-core utilization from the idle tasks' run time.
+ *
+ * @param count Number of valid entries in s_system_state.
+ * @param elapsed Length of the period, or 0 to only record a baseline.
+ * @param last_idle Idle run time per core at the previous sample.
+ */
+static void sample_core_utilization(
+    UBaseType_t count,
+    uint32_t elapsed,
+    uint32_t last_idle[portNUM_PROCESSORS])
+{
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; ++core) {
+        uint32_t idle;
+        if (!find_runtime(count, xTaskGetIdleTaskHandleForCore(core), &idle)) {
+            continue;
+        }
+
+        if (elapsed > 0U) {
+            atomic_store_explicit(
+                &s_core_utilization[core],
+                100U - percent_of(idle - last_idle[core], elapsed),
+                memory_order_relaxed);
+        }
+        last_idle[core] = idle;
+    }
+}
+
+/**
+ * @brief Updates the load of every tracked task.
+ *
+ * A task that migrated since the last sample has a new handle and starts
+ * from a fresh baseline.
+ *
+ * @param count Number of valid entries in s_system_state.
+ * @param elapsed Length of the period, or 0 to only record a baseline.
+ */
+static void sample_task_loads(UBaseType_t count, uint32_t elapsed)
+{
+    portENTER_CRITICAL(&s_lock);
+    const size_t task_count = s_task_count;
+    portEXIT_CRITICAL(&s_lock);
+
+    for (size_t index = 0U; index < task_count; ++index) {
+        placed_task_t *task = &s_tasks[index];
+
+        portENTER_CRITICAL(&s_lock);
+        const TaskHandle_t handle = task->handle;
+        portEXIT_CRITICAL(&s_lock);
+
+        uint32_t runtime;
+        if ((handle == NULL) || !find_runtime(count, handle, &runtime)) {
+            task->sampled_handle = NULL;
+            task->load_pct = 0U;
+            continue;
+        }
+
+        task->load_pct = ((elapsed > 0U) && (handle == task->sampled_handle)) ?
+            percent_of(runtime - task->sampled_runtime, elapsed) : 0U;
+        task->sampled_handle = handle;
+        task->sampled_runtime = runtime;
+    }
+}
+
+/**
+ * @brief Asks one background task to move off the busiest core.
+ *
+ * Picks the movable task whose load brings the two cores closest together.
+ * Tasks at least as heavy as the gap are skipped, since moving them would
+ * only flip the imbalance.
+ *
+ * @return true if a migration was requested.
+ */
+static bool rebalance(void)
+{
+    BaseType_t busiest = 0;
+    BaseType_t idlest = 0;
+    for (BaseType_t core = 1; core < portNUM_PROCESSORS; ++core) {
+        const uint32_t utilization = task_placement_get_core_utilization(core);
+        if (utilization > task_placement_get_core_utilization(busiest)) {
+            busiest = core;
+        }
+        if (utilization < task_placement_get_core_utilization(idlest)) {
+            idlest = core;
+        }
+    }
+
+    const uint32_t busy = task_placement_get_core_utilization(busiest);
+    const uint32_t idle = task_placement_get_core_utilization(idlest);
+    const uint32_t gap = busy - idle;
+    if (gap < IMBALANCE_PCT) {
+        return false;
+    }
+
+    placed_task_t *candidate = NULL;
+    uint32_t best_residual = gap;
+
+    portENTER_CRITICAL(&s_lock);
+    for (size_t index = 0U; index < s_task_count; ++index) {
+        placed_task_t *task = &s_tasks[index];
+        if (!task->movable || (task->handle == NULL) ||
+            (task->core != busiest) || (task->load_pct == 0U) ||
+            (task->load_pct >= gap) ||
+            (atomic_load_explicit(&task->target_core, memory_order_relaxed) !=
+             NO_TARGET_CORE)) {
+            continue;
+        }
+
+        const uint32_t moved = 2U * task->load_pct;
+        const uint32_t residual = (moved > gap) ? (moved - gap) : (gap - moved);
+        if (residual < best_residual) {
+            candidate = task;
+            best_residual = residual;
+        }
+    }
+    if (candidate != NULL) {
+        atomic_store_explicit(
+            &candidate->target_core,
+            (int)idlest,
+            memory_order_release);
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    if (candidate == NULL) {
+        return false;
+    }
+
+    ESP_LOGI(
+        TAG,
+        "moving %s core %d -> %d (busy %" PRIu32 "%% vs %" PRIu32
+        "%%, task %" PRIu32 "%%)",
+        candidate->spec.name,
+        busiest,
+        idlest,
+        busy,
+        idle,
+        candidate->load_pct);
+    return true;
+}
+
+/**
+ * @brief Logs per-core utilization and the placement of every tracked task.
+ */
+static void log_utilization(void)
+{
+    for (BaseType_t core = 0; core < portNUM_PROCESSORS; ++core) {
+        ESP_LOGI(
+            TAG,
+            "core %d busy %" PRIu32 "%%",
+            core,
+            task_placement_get_core_utilization(core));
+    }
+
+    portENTER_CRITICAL(&s_lock);
+    const size_t task_count = s_task_count;
+    portEXIT_CRITICAL(&s_lock);
+
+    for (size_t index = 0U; index < task_count; ++index) {
+        const placed_task_t *task = &s_tasks[index];
+
+        portENTER_CRITICAL(&s_lock);
+        const bool alive = (task->handle != NULL);
+        const BaseType_t core = task->core;
+        portEXIT_CRITICAL(&s_lock);
+
+        if (!alive) {
+            continue;
+        }
+        ESP_LOGI(
+            TAG,
+            "  %-16s %-10s core %d load %" PRIu32 "%%",
+            task->spec.name,
+            task_placement_class_name(task->spec.task_class),
+            core,
+            task->load_pct);
+    }
+
+    ESP_LOGI(
+        TAG,
+        "migrations=%u",
+        atomic_load_explicit(&s_migrations, memory_order_relaxed));
+}
+
+/**
+ * @brief Samples core and task load every period and moves background
+ *        tasks off the busier core.
+ *
+ * @param argument Optional task argument. Not used.
+ */
+static void balancer_task(void *argument)
+{
+    (void)argument;
+
+    uint32_t last_idle[portNUM_PROCESSORS] = { 0U };
+    uint32_t last_total = 0U;
+    bool primed = false;
+    uint32_t cooldown = 0U;
+    uint32_t periods_until_report = REPORT_PERIODS;
+
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(BALANCE_PERIOD_MS));
+
+        configRUN_TIME_COUNTER_TYPE total = 0U;
+        const UBaseType_t count = uxTaskGetSystemState(
+            s_system_state,
+            SYSTEM_STATE_CAPACITY,
+            &total);
+        if (count == 0U) {
+            ESP_LOGW(TAG, "more than %u tasks, load not sampled",
+                     (unsigned)SYSTEM_STATE_CAPACITY);
+            continue;
+        }
+
+        const uint32_t elapsed = primed ? ((uint32_t)total - last_total) : 0U;
+        last_total = (uint32_t)total;
+        primed = true;
+
+        sample_core_utilization(count, elapsed, last_idle);
+        sample_task_loads(count, elapsed);
+        if (elapsed == 0U) {
+            continue;
+        }
+
+        if (cooldown > 0U) {
+            --cooldown;
+        } else if (rebalance()) {
+            cooldown = COOLDOWN_PERIODS;
+        }
+
+        if (--periods_until_report == 0U) {
+            periods_until_report = REPORT_PERIODS;
+            log_utilization();
+        }
+    }
+}
+
+esp_err_t task_placement_spawn(
+    const task_placement_spec_t *spec,
+    TaskHandle_t *handle)
+{
+    if (spec == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    switch (spec->task_class) {
+    case TASK_CLASS_LATENCY_CRITICAL:
+        return spawn_pinned(spec, TASK_PLACEMENT_CONTROL_CORE, false, handle);
+    case TASK_CLASS_THROUGHPUT:
+        return spawn_pinned(spec, TASK_PLACEMENT_SERVICE_CORE, false, handle);
+    case TASK_CLASS_BACKGROUND:
+        return spawn_pinned(spec, least_loaded_core(), true, handle);
+    default:
+        return ESP_ERR_INVALID_ARG;
+    }
+}
+
+esp_err_t task_placement_spawn_on_core(
+    const task_placement_spec_t *spec,
+    BaseType_t core,
+    TaskHandle_t *handle)
+{
+    return spawn_pinned(spec, core, false, handle);
+}
+
+bool task_placement_migration_pending(void)
+{
+    const TaskHandle_t self = xTaskGetCurrentTaskHandle();
+    bool pending = false;
+
+    portENTER_CRITICAL(&s_lock);
+    for (size_t index = 0U; index < s_task_count; ++index) {
+        if (s_tasks[index].handle == self) {
+            pending = atomic_load_explicit(
+                &s_tasks[index].target_core,
+                memory_order_acquire) != NO_TARGET_CORE;
+            break;
+        }
+    }
+    portEXIT_CRITICAL(&s_lock);
+
+    return pending;
+}
+
+esp_err_t task_placement_start_balancer(UBaseType_t priority)
+{
+    if (s_balancer_handle != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const task_placement_spec_t spec = {
+        .function = balancer_task,
+        .name = "placement",
+        .stack_size = BALANCER_STACK_SIZE,
+        .argument = NULL,
+        .priority = priority,
+        .task_class = TASK_CLASS_THROUGHPUT,
+    };
+
+    ESP_LOGI(
+        TAG,
+        "balancer: %u ms period, %u%% threshold, %u period cooldown",
+        (unsigned)BALANCE_PERIOD_MS,
+        (unsigned)IMBALANCE_PCT,
+        (unsigned)COOLDOWN_PERIODS);
+    return task_placement_spawn(&spec, &s_balancer_handle);
+}
+
+uint32_t task_placement_get_core_utilization(BaseType_t core)
+{
+    if ((core < 0) || (core >= portNUM_PROCESSORS)) {
+        return 0U;
+    }
+
+    return atomic_load_explicit(&s_core_utilization[core], memory_order_relaxed);
+}
+
+const char *task_placement_class_name(task_class_t task_class)
+{
+    return ((unsigned)task_class < TASK_CLASS_COUNT) ?
+        s_class_names[task_class] : "?";
+}
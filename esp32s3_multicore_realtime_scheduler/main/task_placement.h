@@ -0,0 +1,121 @@
+#ifndef TASK_PLACEMENT_H
+#define TASK_PLACEMENT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TASK_PLACEMENT_CONTROL_CORE  0
+#define TASK_PLACEMENT_SERVICE_CORE  1
+#define TASK_PLACEMENT_MAX_TASKS     16U
+
+/**
+ * @brief Placement policy declared by the task that is being spawned.
+ */
+typedef enum {
+    TASK_CLASS_LATENCY_CRITICAL = 0, /**< Pinned to the control core. */
+    TASK_CLASS_THROUGHPUT,           /**< Pinned to the service core. */
+    TASK_CLASS_BACKGROUND,           /**< Least-loaded core, may migrate. */
+    TASK_CLASS_COUNT,
+} task_class_t;
+
+typedef struct {
+    TaskFunction_t function;
+    const char *name;
+    uint32_t stack_size;
+    void *argument;
+    UBaseType_t priority;
+    task_class_t task_class;
+} task_placement_spec_t;
+
+/**
+ * @brief Creates a task on the core its class asks for.
+ *
+ * Latency-critical tasks go to TASK_PLACEMENT_CONTROL_CORE and throughput
+ * tasks to TASK_PLACEMENT_SERVICE_CORE. Background tasks start on the core
+ * with the lowest measured utilization and can later be moved by the
+ * balancer. The spec is copied, so it may live on the caller's stack, but
+ * the name string must stay valid for as long as the task exists.
+ *
+ * @param spec Task description.
+ * @param handle Optional output for the task handle. For background tasks
+ *               this is only the first handle; migration creates a new one.
+ * @return ESP_OK on success, ESP_ERR_INVALID_ARG for a bad spec,
+ *         ESP_ERR_NO_MEM if the task or its placement slot could not be
+ *         allocated.
+ */
+esp_err_t task_placement_spawn(
+    const task_placement_spec_t *spec,
+    TaskHandle_t *handle);
+
+/**
+ * @brief Creates a task on an explicit core, bypassing the class policy.
+ *
+ * For tasks whose core is part of their function, such as per-core
+ * dispatchers or tasks that allocate interrupts. The task is still
+ * tracked for utilization reports but is never migrated.
+ *
+ * @param spec Task description. task_class is used for reporting only.
+ * @param core Core to pin the task to.
+ * @param handle Optional output for the task handle.
+ * @return Same as task_placement_spawn().
+ */
+esp_err_t task_placement_spawn_on_core(
+    const task_placement_spec_t *spec,
+    BaseType_t core,
+    TaskHandle_t *handle);
+
+/**
+ * @brief Reports whether the balancer wants the calling task to move.
+ *
+ * FreeRTOS cannot change the affinity of a running task, so migration is
+ * cooperative: a background task polls this at a point where it holds no
+ * locks and returns from its task function when it reads true. The
+ * placement layer then recreates it on the target core with the same
+ * argument. Tasks that never return simply never migrate.
+ *
+ * @return true if the calling task should return from its task function.
+ */
+bool task_placement_migration_pending(void);
+
+/**
+ * @brief Starts the task that samples per-core load and moves background
+ *        tasks.
+ *
+ * Core load is derived from each idle task's run-time counter, so
+ * CONFIG_FREERTOS_GENERATE_RUN_TIME_STATS must be enabled.
+ *
+ * @param priority Priority of the balancer task.
+ * @return ESP_OK on success, ESP_ERR_INVALID_STATE if already started,
+ *         ESP_ERR_NO_MEM if the task could not be created.
+ */
+esp_err_t task_placement_start_balancer(UBaseType_t priority);
+
+/**
+ * @brief Returns the utilization of a core over the last sampling period.
+ *
+ * @param core Core to query.
+ * @return Busy percentage in [0, 100], or 0 before the first sample.
+ */
+uint32_t task_placement_get_core_utilization(BaseType_t core);
+
+/**
+ * @brief Returns the name of a placement class for logging.
+ *
+ * @param task_class Placement class.
+ * @return Static string.
+ */
+const char *task_placement_class_name(task_class_t task_class);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
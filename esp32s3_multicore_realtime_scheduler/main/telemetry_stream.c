@@ -0,0 +1,283 @@
+#include "telemetry_stream.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "sdkconfig.h"
+
+#if CONFIG_RT_TELEMETRY_PORT_UART
+#include "driver/uart.h"
+#else
+#include "driver/usb_serial_jtag.h"
+#endif
+
+#define VARINT_MAX_BYTES        5U
+#define FRAME_HEADER_BYTES      16U
+#define FRAME_SAMPLE_MAX_BYTES  (4U * VARINT_MAX_BYTES)
+#define FRAME_CRC_BYTES         2U
+#define FRAME_PAYLOAD_MAX_BYTES \
+    (FRAME_HEADER_BYTES + \
+     (TELEMETRY_STREAM_MAX_SAMPLES * FRAME_SAMPLE_MAX_BYTES) + \
+     FRAME_CRC_BYTES)
+// COBS adds one byte per 254 payload bytes plus one, and two delimiters.
+#define FRAME_ENCODED_MAX_BYTES \
+    (FRAME_PAYLOAD_MAX_BYTES + (FRAME_PAYLOAD_MAX_BYTES / 254U) + 3U)
+
+#define TX_BUFFER_BYTES         CONFIG_RT_TELEMETRY_TX_BUFFER_BYTES
+#define WRITE_TIMEOUT_TICKS     pdMS_TO_TICKS(5U)
+
+static const char *TAG = "telemetry_stream";
+
+static uint8_t s_payload[FRAME_PAYLOAD_MAX_BYTES];
+static uint8_t s_encoded[FRAME_ENCODED_MAX_BYTES];
+static uint32_t s_dropped_frames;
+static bool s_ready;
+
+/**
+ * @brief Updates a CRC-16/CCITT-FALSE value.
+ *
+ * @param data Bytes to include.
+ * @param length Number of bytes.
+ * @return CRC over data, starting from 0xFFFF.
+ */
+static uint16_t crc16_ccitt(const uint8_t *data, size_t length)
+{
+    uint16_t crc = 0xFFFFU;
+
+    for (size_t index = 0U; index < length; ++index) {
+        crc ^= (uint16_t)data[index] << 8U;
+        for (uint32_t bit = 0U; bit < 8U; ++bit) {
+            crc = (crc & 0x8000U) ? (uint16_t)((crc << 1U) ^ 0x1021U) :
+                                    (uint16_t)(crc << 1U);
+        }
+    }
+
+    return crc;
+}
+
+/**
+ * @brief Appends an unsigned LEB128 varint.
+ *
+ * @param out Destination buffer.
+ * @param value Value to encode.
+ * @return Number of bytes written.
+ */
+static size_t put_varint(uint8_t *out, uint32_t value)
+{
+    size_t length = 0U;
+
+    while (value >= 0x80U) {
+        out[length++] = (uint8_t)(value | 0x80U);
+        value >>= 7U;
+    }
+    out[length++] = (uint8_t)value;
+
+    return length;
+}
+
+/**
+ * @brief Appends a little-endian integer of the given width.
+ *
+ * @param out Destination buffer.
+ * @param value Value to encode.
+ * @param bytes Number of bytes.
+ * @return Number of bytes written.
+ */
+static size_t put_le(uint8_t *out, uint64_t value, size_t bytes)
+{
+    for (size_t index = 0U; index < bytes; ++index) {
+        out[index] = (uint8_t)(value >> (8U * index));
+    }
+
+    return bytes;
+}
+
+/**
+ * @brief COBS-encodes a payload between two zero delimiters.
+ *
+ * @param input Payload bytes.
+ * @param length Payload length.
+ * @param output Destination with room for FRAME_ENCODED_MAX_BYTES.
+ * @return Encoded length including both delimiters.
+ */
+static size_t cobs_encode(const uint8_t *input, size_t length, uint8_t *output)
+{
+    size_t out = 0U;
+    output[out++] = 0U;
+
+    size_t code_index = out++;
+    uint8_t code = 1U;
+
+    for (size_t index = 0U; index < length; ++index) {
+        if (input[index] == 0U) {
+            output[code_index] = code;
+            code_index = out++;
+            code = 1U;
+        } else {
+            output[out++] = input[index];
+            if (++code == 0xFFU) {
+                output[code_index] = code;
+                code_index = out++;
+                code = 1U;
+            }
+        }
+    }
+
+    output[code_index] = code;
+    output[out++] = 0U;
+
+    return out;
+}
+
+/**
+ * @brief Writes one encoded frame without blocking the caller for long.
+ *
+ * @param frame Encoded frame.
+ * @param length Frame length.
+ */
+static void write_frame(const uint8_t *frame, size_t length)
+{
+#if CONFIG_RT_TELEMETRY_PORT_UART
+    const int written = uart_write_bytes(
+        CONFIG_RT_TELEMETRY_UART_PORT,
+        frame,
+        length);
+#else
+    const int written = usb_serial_jtag_write_bytes(
+        frame,
+        length,
+        WRITE_TIMEOUT_TICKS);
+#endif
+
+    if (written != (int)length) {
+        s_dropped_frames++;
+    }
+}
+
+/**
+ * @brief Installs the driver of the configured binary telemetry port.
+ *
+ * @return ESP_OK on success, or the driver error.
+ */
+esp_err_t telemetry_stream_init(void)
+{
+    esp_err_t result;
+
+#if CONFIG_RT_TELEMETRY_PORT_UART
+    const uart_config_t uart_config = {
+        .baud_rate = CONFIG_RT_TELEMETRY_UART_BAUD,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+
+    // A large TX ring lets the UART ISR refill the FIFO while this task
+    // keeps encoding; uart_write_bytes() only copies into the ring.
+    result = uart_driver_install(
+        CONFIG_RT_TELEMETRY_UART_PORT,
+        UART_HW_FIFO_LEN(CONFIG_RT_TELEMETRY_UART_PORT) * 2,
+        TX_BUFFER_BYTES,
+        0,
+        NULL,
+        0);
+    if (result == ESP_OK) {
+        result = uart_param_config(CONFIG_RT_TELEMETRY_UART_PORT, &uart_config);
+    }
+    if (result == ESP_OK) {
+        result = uart_set_pin(
+            CONFIG_RT_TELEMETRY_UART_PORT,
+            CONFIG_RT_TELEMETRY_UART_TX_GPIO,
+            UART_PIN_NO_CHANGE,
+            UART_PIN_NO_CHANGE,
+            UART_PIN_NO_CHANGE);
+    }
+#else
+    usb_serial_jtag_driver_config_t jtag_config = {
+        .tx_buffer_size = TX_BUFFER_BYTES,
+        .rx_buffer_size = 256U,
+    };
+
+    result = usb_serial_jtag_driver_install(&jtag_config);
+#endif
+
+    if (result != ESP_OK) {
+        ESP_LOGE(TAG, "port init failed: %s", esp_err_to_name(result));
+        return result;
+    }
+
+    s_ready = true;
+    return ESP_OK;
+}
+
+/**
+ * @brief Encodes timing samples into COBS frames and queues them for output.
+ *
+ * @param job_index Index of the job that produced the samples.
+ * @param samples Samples to send.
+ * @param count Number of samples.
+ */
+void telemetry_stream_send(
+    uint8_t job_index,
+    const timing_sample_t *samples,
+    size_t count)
+{
+    if (!s_ready || (samples == NULL)) {
+        return;
+    }
+
+    while (count > 0U) {
+        const size_t frame_samples = (count < TELEMETRY_STREAM_MAX_SAMPLES) ?
+            count : TELEMETRY_STREAM_MAX_SAMPLES;
+        size_t length = 0U;
+
+        length += put_le(&s_payload[length], TELEMETRY_STREAM_VERSION, 1U);
+        length += put_le(&s_payload[length], job_index, 1U);
+        length += put_le(&s_payload[length], frame_samples, 2U);
+        length += put_le(&s_payload[length], samples[0].sequence, 4U);
+        length += put_le(
+            &s_payload[length],
+            (uint64_t)samples[0].timestamp_us,
+            8U);
+
+        int64_t previous_timestamp_us = samples[0].timestamp_us;
+        uint32_t previous_sequence = samples[0].sequence;
+
+        for (size_t index = 0U; index < frame_samples; ++index) {
+            const timing_sample_t *sample = &samples[index];
+
+            length += put_varint(
+                &s_payload[length],
+                (uint32_t)(sample->timestamp_us - previous_timestamp_us));
+            length += put_varint(
+                &s_payload[length],
+                ((sample->sequence - previous_sequence) << 1U) |
+                    (sample->deadline_missed ? 1U : 0U));
+            length += put_varint(&s_payload[length], sample->execution_cycles);
+            length += put_varint(&s_payload[length], sample->release_jitter_us);
+
+            previous_timestamp_us = sample->timestamp_us;
+            previous_sequence = sample->sequence;
+        }
+
+        length += put_le(&s_payload[length], crc16_ccitt(s_payload, length), 2U);
+
+        write_frame(s_encoded, cobs_encode(s_payload, length, s_encoded));
+
+        samples += frame_samples;
+        count -= frame_samples;
+    }
+}
+
+/**
+ * @brief Returns the number of frames dropped because the port was busy.
+ *
+ * @return Number of dropped frames.
+ */
+uint32_t telemetry_stream_get_dropped_frames(void)
+{
+    return s_dropped_frames;
+}
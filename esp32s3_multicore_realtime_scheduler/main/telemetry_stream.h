@@ -0,0 +1,63 @@
+#ifndef TELEMETRY_STREAM_H
+#define TELEMETRY_STREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#include "lockfree_ring.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TELEMETRY_STREAM_VERSION      1U
+#define TELEMETRY_STREAM_MAX_SAMPLES  64U
+
+/**
+ * @brief Installs the driver of the configured binary telemetry port.
+ *
+ * @return ESP_OK on success, or the driver error.
+ */
+esp_err_t telemetry_stream_init(void);
+
+/**
+ * @brief Encodes timing samples into COBS frames and queues them for output.
+ *
+ * Samples are split into frames of at most TELEMETRY_STREAM_MAX_SAMPLES.
+ * Each frame is self-contained: it carries the absolute timestamp and
+ * sequence of its first sample, and the remaining samples are
+ * delta-encoded as unsigned LEB128 varints. Every frame is delimited by a
+ * zero byte on both sides so it can share a port with text logs.
+ *
+ * Frame payload before COBS encoding, all integers little-endian:
+ *
+ *   u8  version, u8 job index, u16 sample count,
+ *   u32 first sequence, u64 first timestamp in us,
+ *   per sample: varint timestamp delta in us,
+ *               varint (sequence delta << 1 | deadline_missed),
+ *               varint execution cycles, varint release jitter in us,
+ *   u16 CRC-16/CCITT-FALSE over everything above.
+ *
+ * @param job_index Index of the job that produced the samples.
+ * @param samples Samples to send.
+ * @param count Number of samples.
+ */
+void telemetry_stream_send(
+    uint8_t job_index,
+    const timing_sample_t *samples,
+    size_t count);
+
+/**
+ * @brief Returns the number of frames dropped because the port was busy.
+ *
+ * @return Number of dropped frames.
+ */
+uint32_t telemetry_stream_get_dropped_frames(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
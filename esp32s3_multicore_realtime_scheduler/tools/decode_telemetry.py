@@ -0,0 +1,160 @@
+#!/usr/bin/env python3
+"""
+Binary timing telemetry decoder
+
+Reads the COBS-framed timing stream produced when CONFIG_RT_TELEMETRY_BINARY
+is enabled and writes one CSV row per timing sample. Bytes outside valid
+frames, such as interleaved ESP_LOG text, are skipped.
+
+Requirements:
+    pip install pyserial    (only for reading from a serial port)
+
+Usage:
+    python3 decode_telemetry.py /dev/ttyACM0 > trace.csv
+    python3 decode_telemetry.py COM5 --baud 2000000 > trace.csv
+    python3 decode_telemetry.py --file capture.bin > trace.csv
+"""
+
+import argparse
+import struct
+import sys
+
+STREAM_VERSION = 1
+HEADER = struct.Struct("<BBHIQ")
+
+
+def crc16_ccitt(data):
+    """CRC-16/CCITT-FALSE, matching crc16_ccitt() in telemetry_stream.c."""
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+            crc &= 0xFFFF
+    return crc
+
+
+def cobs_decode(frame):
+    """Decode one COBS frame without delimiters. Returns None if malformed."""
+    out = bytearray()
+    index = 0
+    while index < len(frame):
+        code = frame[index]
+        if code == 0 or index + code > len(frame) + 1:
+            return None
+        out += frame[index + 1:index + code]
+        index += code
+        if code < 0xFF and index < len(frame):
+            out.append(0)
+    return bytes(out)
+
+
+def read_varint(data, offset):
+    """Read an unsigned LEB128 varint. Returns (value, next_offset)."""
+    value = 0
+    shift = 0
+    while True:
+        if offset >= len(data):
+            raise ValueError("truncated varint")
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        if byte < 0x80:
+            return value, offset
+        shift += 7
+
+
+def parse_payload(payload):
+    """Yield (job, sequence, timestamp_us, cycles, jitter_us, missed) tuples."""
+    if len(payload) < HEADER.size + 2:
+        raise ValueError("short frame")
+    body, crc = payload[:-2], struct.unpack("<H", payload[-2:])[0]
+    if crc16_ccitt(body) != crc:
+        raise ValueError("crc mismatch")
+
+    version, job, count, sequence, timestamp = HEADER.unpack_from(body)
+    if version != STREAM_VERSION:
+        raise ValueError("unsupported version %d" % version)
+
+    offset = HEADER.size
+    for _ in range(count):
+        delta_us, offset = read_varint(body, offset)
+        sequence_field, offset = read_varint(body, offset)
+        cycles, offset = read_varint(body, offset)
+        jitter_us, offset = read_varint(body, offset)
+        timestamp += delta_us
+        sequence = (sequence + (sequence_field >> 1)) & 0xFFFFFFFF
+        yield job, sequence, timestamp, cycles, jitter_us, sequence_field & 1
+
+
+def decode_stream(chunks, out, stats):
+    """Split byte chunks on zero delimiters and write CSV rows."""
+    pending = bytearray()
+    for chunk in chunks:
+        pending += chunk
+        while True:
+            end = pending.find(b"\x00")
+            if end < 0:
+                break
+            frame = bytes(pending[:end])
+            del pending[:end + 1]
+            if not frame:
+                continue
+            payload = cobs_decode(frame)
+            try:
+                if payload is None:
+                    raise ValueError("bad cobs")
+                for row in parse_payload(payload):
+                    out.write("%d,%d,%d,%d,%d,%d\n" % row)
+                    stats["samples"] += 1
+                stats["frames"] += 1
+            except ValueError:
+                stats["skipped"] += 1
+
+
+def serial_chunks(port, baud):
+    import serial
+
+    with serial.Serial(port, baud, timeout=0.1) as connection:
+        while True:
+            data = connection.read(4096)
+            if data:
+                yield data
+
+
+def file_chunks(path):
+    with open(path, "rb") as handle:
+        while True:
+            data = handle.read(65536)
+            if not data:
+                return
+            yield data
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("port", nargs="?", help="serial port to read from")
+    parser.add_argument("--baud", type=int, default=2000000)
+    parser.add_argument("--file", help="decode a raw capture file instead")
+    args = parser.parse_args()
+
+    if not args.port and not args.file:
+        parser.error("give a serial port or --file")
+
+    chunks = file_chunks(args.file) if args.file else \
+        serial_chunks(args.port, args.baud)
+    stats = {"frames": 0, "samples": 0, "skipped": 0}
+
+    sys.stdout.write("job,sequence,timestamp_us,execution_cycles,"
+                     "release_jitter_us,deadline_missed\n")
+    try:
+        decode_stream(chunks, sys.stdout, stats)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        sys.stderr.write("frames=%(frames)d samples=%(samples)d "
+                         "skipped=%(skipped)d\n" % stats)
+
+
+if __name__ == "__main__":
+    main()
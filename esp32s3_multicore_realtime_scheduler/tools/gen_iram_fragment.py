@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+"""
+IRAM linker fragment generator
+
+Reads the HOTPATH dump printed by hot_path_profiler_dump(), resolves the
+sampled addresses against the application ELF, and ranks the functions that
+run from flash by instruction-cache miss stall cycles (or by samples when the
+stall counter is not available). The top functions that fit in the byte
+budget are written to an ESP-IDF linker fragment with the noflash scheme,
+which places them in IRAM on the next build.
+
+Run it from the project directory after `idf.py build`, so the ELF and the
+component archives match the firmware that produced the dump.
+
+Usage:
+    python3 tools/gen_iram_fragment.py capture.txt --budget 4096
+    python3 tools/gen_iram_fragment.py capture.txt --build-dir build \\
+        --budget 8192 --min-samples 5 --out main/linker.lf
+"""
+
+import argparse
+import bisect
+import collections
+import glob
+import json
+import os
+import re
+import subprocess
+import sys
+
+# Instruction bus addresses of flash-mapped code (ESP32, then S2/S3/C-series).
+FLASH_RANGES = ((0x400C2000, 0x40C00000), (0x42000000, 0x44000000))
+FUNCTION_TYPES = "tTwW"
+OBJECT_SUFFIX = re.compile(r"\.(c|cc|cpp|cxx|S|s)?\.?(obj|o)$")
+
+Function = collections.namedtuple("Function", "address size name")
+Candidate = collections.namedtuple(
+    "Candidate", "name archive object size samples stall")
+
+
+def in_flash(address):
+    return any(low <= address < high for low, high in FLASH_RANGES)
+
+
+def parse_dump(lines):
+    """Return (header fields, [(pc, samples, stall_cycles)]) of the last dump."""
+    header = None
+    rows = []
+    for line in lines:
+        start = line.find("HOTPATH ")
+        if start < 0:
+            continue
+        fields = line[start:].split()
+        if fields[1] == "begin":
+            header = dict(field.split("=", 1) for field in fields[2:])
+            rows = []
+        elif fields[1] == "end":
+            if header is not None:
+                return header, rows
+        elif header is not None and len(fields) == 4:
+            rows.append((int(fields[1], 16), int(fields[2]), int(fields[3])))
+    raise ValueError("no complete HOTPATH dump found")
+
+
+def run_nm(nm, arguments):
+    result = subprocess.run([nm, "--defined-only"] + arguments,
+                            check=True, capture_output=True, text=True)
+    return result.stdout.splitlines()
+
+
+def read_functions(nm, elf):
+    """Sized function symbols of the ELF, sorted by address."""
+    functions = []
+    for line in run_nm(nm, ["--print-size", "--numeric-sort", elf]):
+        fields = line.split()
+        if len(fields) == 4 and fields[2] in FUNCTION_TYPES:
+            size = int(fields[1], 16)
+            if size > 0:
+                functions.append(Function(int(fields[0], 16), size, fields[3]))
+    return functions
+
+
+def read_objects(nm, build_dir):
+    """Map function name -> [(archive, object)] over the component archives."""
+    archives = glob.glob(os.path.join(build_dir, "esp-idf", "**", "lib*.a"),
+                         recursive=True)
+    owners = collections.defaultdict(list)
+    for archive in archives:
+        for line in run_nm(nm, ["--print-file-name", archive]):
+            # <path>/libmain.a:realtime_scheduler.c.obj:00000000 t name
+            location, _, rest = line.rpartition(":")
+            fields = rest.split()
+            if len(fields) != 3 or fields[1] not in FUNCTION_TYPES:
+                continue
+            obj = location.rpartition(":")[2]
+            owners[fields[2]].append(
+                (os.path.basename(archive), OBJECT_SUFFIX.sub("", obj)))
+    return owners
+
+
+def resolve(functions, rows):
+    """Sum samples and stall cycles per function. Returns {Function: [s, c]}."""
+    starts = [function.address for function in functions]
+    totals = collections.defaultdict(lambda: [0, 0])
+    for pc, samples, stall in rows:
+        index = bisect.bisect_right(starts, pc) - 1
+        if index < 0:
+            continue
+        function = functions[index]
+        if pc < function.address + function.size:
+            totals[function][0] += samples
+            totals[function][1] += stall
+    return totals
+
+
+def select(candidates, budget, by_stall):
+    """Greedy pick in score order; skips functions that no longer fit."""
+    key = (lambda c: (c.stall, c.samples)) if by_stall else \
+        (lambda c: (c.samples, c.stall))
+    chosen = []
+    used = 0
+    for candidate in sorted(candidates, key=key, reverse=True):
+        if used + candidate.size <= budget:
+            chosen.append(candidate)
+            used += candidate.size
+    return chosen, used
+
+
+def write_fragment(path, chosen, header, budget, used, total_stall):
+    samples = int(header.get("samples", 0))
+    flash = int(header.get("flash", 0))
+    lines = [
+        "# Generated by tools/gen_iram_fragment.py from a hot path profile.",
+        "# %d busy samples, %d%% from flash at %s Hz; budget %d bytes, %d used."
+        % (samples, flash * 100 // samples if samples else 0,
+           header.get("rate", "?"), budget, used),
+        "#",
+        "# %-36s %-24s %6s %8s %7s" % ("function", "object", "bytes",
+                                       "samples", "stall%"),
+    ]
+    for c in chosen:
+        share = 100.0 * c.stall / total_stall if total_stall else 0.0
+        lines.append("# %-36s %-24s %6d %8d %6.1f%%"
+                     % (c.name, c.object, c.size, c.samples, share))
+
+    by_archive = collections.defaultdict(list)
+    for c in chosen:
+        by_archive[c.archive].append(c)
+
+    for archive in sorted(by_archive):
+        stem = re.sub(r"\W", "_", archive[3:-2] if archive.startswith("lib")
+                      else archive)
+        lines += ["", "[mapping:hot_path_%s]" % stem,
+                  "archive: %s" % archive, "entries:"]
+        for c in sorted(by_archive[archive], key=lambda c: (c.object, c.name)):
+            lines.append("    %s:%s (noflash)" % (c.object, c.name))
+
+    with open(path, "w") as handle:
+        handle.write("\n".join(lines) + "\n")
+
+
+def default_nm(build_dir):
+    with open(os.path.join(build_dir, "project_description.json")) as handle:
+        target = json.load(handle)["target"]
+    if target in ("esp32", "esp32s2", "esp32s3"):
+        return "xtensa-%s-elf-nm" % target
+    return "riscv32-esp-elf-nm"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[1])
+    parser.add_argument("dump", help="console capture holding a HOTPATH dump")
+    parser.add_argument("--build-dir", default="build")
+    parser.add_argument("--elf", help="application ELF (default: from build)")
+    parser.add_argument("--nm", help="toolchain nm (default: from target)")
+    parser.add_argument("--budget", type=int, default=4096,
+                        help="IRAM bytes to spend (default 4096)")
+    parser.add_argument("--min-samples", type=int, default=3,
+                        help="ignore functions sampled fewer times")
+    parser.add_argument("--out", default=os.path.join("main", "linker.lf"))
+    args = parser.parse_args()
+
+    with open(args.dump, errors="replace") as handle:
+        header, rows = parse_dump(handle)
+
+    nm = args.nm or default_nm(args.build_dir)
+    elf = args.elf
+    if elf is None:
+        with open(os.path.join(args.build_dir,
+                               "project_description.json")) as handle:
+            elf = os.path.join(args.build_dir, json.load(handle)["app_elf"])
+
+    totals = resolve(read_functions(nm, elf), rows)
+    owners = read_objects(nm, args.build_dir)
+
+    candidates = []
+    for function, (samples, stall) in totals.items():
+        if not in_flash(function.address) or samples < args.min_samples:
+            continue
+        places = owners.get(function.name, [])
+        if len(places) != 1:
+            # Not in a component archive (libc, ROM stubs) or an ambiguous
+            # static name that a fragment entry cannot single out.
+            sys.stderr.write("skipped %s: %s\n" % (
+                function.name, "ambiguous" if places else "no archive"))
+            continue
+        archive, obj = places[0]
+        candidates.append(Candidate(function.name, archive, obj,
+                                    function.size, samples, stall))
+
+    total_stall = sum(c.stall for c in candidates)
+    by_stall = header.get("stall") == "1" and total_stall > 0
+    chosen, used = select(candidates, args.budget, by_stall)
+    write_fragment(args.out, chosen, header, args.budget, used, total_stall)
+
+    sys.stderr.write("%d of %d flash functions, %d of %d bytes, ranked by %s"
+                     " -> %s\n" % (len(chosen), len(candidates), used,
+                                   args.budget,
+                                   "stall cycles" if by_stall else "samples",
+                                   args.out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,122 @@
+#ifndef PID_AUTOTUNE_H
+#define PID_AUTOTUNE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    PID_AUTOTUNE_RUNNING = 0,
+    PID_AUTOTUNE_DONE,
+    PID_AUTOTUNE_FAILED,
+} pid_autotune_state_t;
+
+typedef enum
+{
+    PID_AUTOTUNE_RULE_ZIEGLER_NICHOLS = 0,
+    PID_AUTOTUNE_RULE_TYREUS_LUYBEN,
+} pid_autotune_rule_t;
+
+typedef struct
+{
+    float setpoint;
+    float output_bias;
+    float relay_amplitude;
+    float hysteresis;
+    float sample_time_s;
+    uint32_t cycles_required;
+    uint32_t max_samples;
+    uint32_t sample_count;
+    uint32_t last_rising_sample;
+    uint32_t cycles_measured;
+    float period_sum_s;
+    float amplitude_sum;
+    float peak_high;
+    float peak_low;
+    float output;
+    bool relay_high;
+    bool started;
+    float ultimate_gain;
+    float ultimate_period_s;
+    pid_autotune_state_t state;
+} pid_autotune_t;
+
+/**
+ * Starts a relay-feedback autotune experiment (Astrom-Hagglund method).
+ *
+ * The tuner drives the process with output_bias +/- relay_amplitude,
+ * switching each time the measurement crosses the setpoint band, until the
+ * process settles into a limit cycle. The amplitude and period of that
+ * cycle give the ultimate gain and period of the loop.
+ *
+ * Args:
+ *     tuner: Pointer to the autotune instance.
+ *     setpoint: Process value the limit cycle oscillates around.
+ *     output_bias: Output that holds the process near the setpoint.
+ *     relay_amplitude: Output step above and below the bias.
+ *     hysteresis: Half width of the switching band, above the measurement noise.
+ *     cycles: Number of full oscillations to average, after the first one is discarded.
+ *     sample_time_s: Controller sample time in seconds.
+ *     timeout_s: Experiment is abandoned after this many seconds.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_autotune_init(pid_autotune_t *tuner,
+                       float setpoint,
+                       float output_bias,
+                       float relay_amplitude,
+                       float hysteresis,
+                       uint32_t cycles,
+                       float sample_time_s,
+                       float timeout_s);
+
+/**
+ * Runs one sample of the autotune experiment.
+ *
+ * Call at the controller sample rate in place of pid_f32_compute() and
+ * apply the returned output to the actuator while the state is
+ * PID_AUTOTUNE_RUNNING.
+ *
+ * Args:
+ *     tuner: Pointer to the autotune instance.
+ *     measurement: Current measured process variable.
+ *     output: Receives the relay output to apply.
+ *
+ * Returns:
+ *     PID_AUTOTUNE_RUNNING while measuring, PID_AUTOTUNE_DONE once the
+ *     ultimate gain and period are known, or PID_AUTOTUNE_FAILED on timeout.
+ */
+pid_autotune_state_t pid_autotune_update(pid_autotune_t *tuner, float measurement, float *output);
+
+/**
+ * Computes PID gains from the measured ultimate gain and period.
+ *
+ * Ziegler-Nichols gives a fast, lightly damped response. Tyreus-Luyben is
+ * more conservative and suits plants where overshoot matters.
+ *
+ * Args:
+ *     tuner: Pointer to a finished autotune instance.
+ *     rule: Tuning rule to apply.
+ *     kp: Receives the proportional gain.
+ *     ki: Receives the integral gain.
+ *     kd: Receives the derivative gain.
+ *
+ * Returns:
+ *     True on success, false if the experiment has not finished.
+ */
+bool pid_autotune_get_gains(const pid_autotune_t *tuner,
+                            pid_autotune_rule_t rule,
+                            float *kp,
+                            float *ki,
+                            float *kd);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
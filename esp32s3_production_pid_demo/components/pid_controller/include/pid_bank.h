@@ -0,0 +1,174 @@
+#ifndef PID_BANK_H
+#define PID_BANK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * A bank of floating-point PID controllers that share one sample time.
+ *
+ * Each field is an array with one entry per channel (struct of arrays), so
+ * pid_bank_compute() walks every array linearly instead of jumping between
+ * controller structs. All arrays live in one allocation.
+ */
+typedef struct
+{
+    size_t channel_count;
+    float sample_time_s;
+    float inverse_sample_time;
+    float *kp;
+    float *ki;
+    float *kd;
+    float *output_min;
+    float *output_max;
+    float *integral_min;
+    float *integral_max;
+    float *derivative_filter_alpha;
+    float *slew_max_delta;
+    float *integral;
+    float *previous_measurement;
+    float *filtered_derivative;
+    float *previous_output;
+    bool first_run;
+    void *storage;
+} pid_bank_t;
+
+/**
+ * Allocates a PID bank.
+ *
+ * Every channel starts with zero gains, an output range of 0.0 to 0.0 and
+ * the same defaults as pid_f32_init(); configure each channel before use.
+ *
+ * Args:
+ *     bank: Pointer to the PID bank.
+ *     channel_count: Number of control loops in the bank.
+ *     sample_time_s: Fixed sample time shared by every channel, in seconds.
+ *
+ * Returns:
+ *     True on success, false if an argument is invalid or memory is exhausted.
+ */
+bool pid_bank_init(pid_bank_t *bank, size_t channel_count, float sample_time_s);
+
+/**
+ * Frees the memory held by a PID bank.
+ *
+ * Args:
+ *     bank: Pointer to the PID bank.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_bank_deinit(pid_bank_t *bank);
+
+/**
+ * Configures one channel, like pid_f32_init() does for a single controller.
+ *
+ * Resets the integral limits to the output range, the derivative filter
+ * to its default and disables slew-rate limiting for the channel.
+ *
+ * Args:
+ *     bank: Pointer to the PID bank.
+ *     channel: Channel index.
+ *     kp: Proportional gain.
+ *     ki: Integral gain.
+ *     kd: Derivative gain.
+ *     output_min: Minimum allowed controller output.
+ *     output_max: Maximum allowed controller output.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_bank_configure_channel(pid_bank_t *bank,
+                                size_t channel,
+                                float kp,
+                                float ki,
+                                float kd,
+                                float output_min,
+                                float output_max);
+
+/**
+ * Configures the allowed range of one channel's integral accumulator.
+ *
+ * Args:
+ *     bank: Pointer to the PID bank.
+ *     channel: Channel index.
+ *     integral_min: Minimum allowed integral state.
+ *     integral_max: Maximum allowed integral state.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_bank_set_integral_limits(pid_bank_t *bank,
+                                  size_t channel,
+                                  float integral_min,
+                                  float integral_max);
+
+/**
+ * Configures derivative low-pass filtering for one channel.
+ *
+ * Args:
+ *     bank: Pointer to the PID bank.
+ *     channel: Channel index.
+ *     alpha: Filter coefficient from 0.0 to 1.0. Higher values react faster.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_bank_set_derivative_filter(pid_bank_t *bank, size_t channel, float alpha);
+
+/**
+ * Configures the maximum output change rate for one channel.
+ *
+ * Args:
+ *     bank: Pointer to the PID bank.
+ *     channel: Channel index.
+ *     slew_rate_limit_per_s: Maximum output units per second. Use 0.0 to disable.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_bank_set_slew_rate_limit(pid_bank_t *bank, size_t channel, float slew_rate_limit_per_s);
+
+/**
+ * Resets the runtime state of every channel while keeping the configuration.
+ *
+ * Args:
+ *     bank: Pointer to the PID bank.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_bank_reset(pid_bank_t *bank);
+
+/**
+ * Computes one update of every channel in the bank.
+ *
+ * Each channel follows pid_f32_compute(): derivative-on-measurement with
+ * low-pass filtering, conditional integration anti-windup, output clamping
+ * and slew-rate limiting. The loop is branch-free per channel, and divides
+ * by the sample time are replaced with a multiply by its precomputed
+ * inverse.
+ *
+ * Args:
+ *     bank: Pointer to the PID bank.
+ *     setpoints: Desired target value per channel.
+ *     measurements: Current measured process variable per channel.
+ *     outputs: Receives the saturated and slew-limited output per channel.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_bank_compute(pid_bank_t *bank,
+                      const float *setpoints,
+                      const float *measurements,
+                      float *outputs);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,193 @@
+#ifndef PID_CORE_H
+#define PID_CORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Compile-time specialized PID controller.
+ *
+ * PID_CORE_DEFINE(name, numeric, features) generates name_t, name_init(),
+ * name_reset() and name_compute() as static inline code. The feature mask is
+ * a constant, so the compiler drops every disabled feature from
+ * name_compute(); no per-sample branch is left for it. Output clamping and
+ * conditional-integration anti-windup are always on. The derivative acts on
+ * the measurement, as in pid_f32_t.
+ *
+ * numeric selects the value type:
+ *     F32: float values.
+ *     Q16: pid_q16_t-compatible Q16.16 values with a Q32 integral term;
+ *          integer only, so it can run in an interrupt.
+ *
+ * Example:
+ *     PID_CORE_DEFINE(motor_pid, F32, PID_CORE_DERIVATIVE_FILTER | PID_CORE_SLEW_LIMIT)
+ *
+ *     motor_pid_t pid;
+ *     motor_pid_init(&pid, &config);
+ *     output = motor_pid_compute(&pid, setpoint, measurement);
+ */
+
+#define PID_CORE_DERIVATIVE_FILTER (1U << 0)
+#define PID_CORE_INTEGRAL_CLAMP    (1U << 1)
+#define PID_CORE_SLEW_LIMIT        (1U << 2)
+
+typedef struct
+{
+    float kp;
+    float ki;
+    float kd;
+    float sample_time_s;
+    float output_min;
+    float output_max;
+    /** Used with PID_CORE_INTEGRAL_CLAMP; bounds the integral of the error. */
+    float integral_min;
+    float integral_max;
+    /** Used with PID_CORE_DERIVATIVE_FILTER; 1.0 means no filtering. */
+    float derivative_filter_alpha;
+    /** Used with PID_CORE_SLEW_LIMIT; output change per second. */
+    float slew_rate_limit_per_s;
+} pid_core_config_t;
+
+/* Numeric backends. The coefficient type holds ki * Ts, which gets 28
+ * fractional bits in Q16 so short sample times keep their resolution. */
+#define PID_CORE_F32_VALUE_T                float
+#define PID_CORE_F32_COEF_T                 float
+#define PID_CORE_F32_ACCUM_T                float
+#define PID_CORE_F32_VALUE(x)               ((float)(x))
+#define PID_CORE_F32_COEF(x)                ((float)(x))
+#define PID_CORE_F32_ACCUM(x)               ((float)(x))
+#define PID_CORE_F32_MUL(a, b)              ((a) * (b))
+#define PID_CORE_F32_MUL_COEF(c, v)         ((c) * (v))
+#define PID_CORE_F32_TO_ACCUM(v)            (v)
+#define PID_CORE_F32_FROM_ACCUM(a)          (a)
+
+#define PID_CORE_Q16_VALUE_T                int32_t
+#define PID_CORE_Q16_COEF_T                 int32_t
+#define PID_CORE_Q16_ACCUM_T                int64_t
+#define PID_CORE_Q16_VALUE(x)               ((int32_t)((double)(x) * 65536.0))
+#define PID_CORE_Q16_COEF(x)                ((int32_t)((double)(x) * 268435456.0))
+#define PID_CORE_Q16_ACCUM(x)               ((int64_t)((double)(x) * 4294967296.0))
+#define PID_CORE_Q16_MUL(a, b)              ((int64_t)(a) * (int64_t)(b))
+#define PID_CORE_Q16_MUL_COEF(c, v)         (((int64_t)(c) * (int64_t)(v)) >> 12)
+#define PID_CORE_Q16_TO_ACCUM(v)            ((int64_t)(v) * 65536)
+#define PID_CORE_Q16_FROM_ACCUM(a)          ((int32_t)((a) >> 16))
+
+#define PID_CORE_CLAMP(value, min_value, max_value) \
+    (((value) > (max_value)) ? (max_value) : (((value) < (min_value)) ? (min_value) : (value)))
+
+#define PID_CORE_DEFINE(name, numeric, features)                                                               \
+    typedef struct                                                                                             \
+    {                                                                                                          \
+        PID_CORE_##numeric##_VALUE_T kp;                                                                       \
+        PID_CORE_##numeric##_VALUE_T kd_over_ts;                                                               \
+        PID_CORE_##numeric##_COEF_T ki_ts;                                                                     \
+        PID_CORE_##numeric##_VALUE_T derivative_alpha;                                                         \
+        PID_CORE_##numeric##_VALUE_T slew_max_delta;                                                           \
+        PID_CORE_##numeric##_ACCUM_T output_min;                                                               \
+        PID_CORE_##numeric##_ACCUM_T output_max;                                                               \
+        PID_CORE_##numeric##_ACCUM_T integral_term_min;                                                        \
+        PID_CORE_##numeric##_ACCUM_T integral_term_max;                                                        \
+        PID_CORE_##numeric##_ACCUM_T integral_term;                                                            \
+        PID_CORE_##numeric##_VALUE_T previous_measurement;                                                     \
+        PID_CORE_##numeric##_VALUE_T filtered_derivative;                                                      \
+        PID_CORE_##numeric##_VALUE_T previous_output;                                                          \
+        bool first_run;                                                                                        \
+    } name##_t;                                                                                                \
+                                                                                                               \
+    static inline void name##_reset(name##_t *pid)                                                             \
+    {                                                                                                          \
+        pid->integral_term = PID_CORE_##numeric##_ACCUM(0);                                                    \
+        pid->previous_measurement = PID_CORE_##numeric##_VALUE(0);                                             \
+        pid->filtered_derivative = PID_CORE_##numeric##_VALUE(0);                                              \
+        pid->previous_output = PID_CORE_##numeric##_FROM_ACCUM(pid->output_min);                               \
+        pid->first_run = true;                                                                                 \
+    }                                                                                                          \
+                                                                                                               \
+    static inline bool name##_init(name##_t *pid, const pid_core_config_t *config)                             \
+    {                                                                                                          \
+        if (pid == NULL || config == NULL || config->sample_time_s <= 0.0f ||                                  \
+            config->output_min >= config->output_max)                                                          \
+        {                                                                                                      \
+            return false;                                                                                      \
+        }                                                                                                      \
+                                                                                                               \
+        pid->kp = PID_CORE_##numeric##_VALUE(config->kp);                                                      \
+        pid->kd_over_ts = PID_CORE_##numeric##_VALUE(config->kd / config->sample_time_s);                      \
+        pid->ki_ts = PID_CORE_##numeric##_COEF(config->ki * config->sample_time_s);                            \
+        pid->derivative_alpha = PID_CORE_##numeric##_VALUE(config->derivative_filter_alpha);                   \
+        pid->slew_max_delta = PID_CORE_##numeric##_VALUE(config->slew_rate_limit_per_s *                       \
+                                                         config->sample_time_s);                               \
+        pid->output_min = PID_CORE_##numeric##_ACCUM(config->output_min);                                      \
+        pid->output_max = PID_CORE_##numeric##_ACCUM(config->output_max);                                      \
+        pid->integral_term_min = PID_CORE_##numeric##_ACCUM(config->ki * config->integral_min);                \
+        pid->integral_term_max = PID_CORE_##numeric##_ACCUM(config->ki * config->integral_max);                \
+        name##_reset(pid);                                                                                     \
+                                                                                                               \
+        return true;                                                                                           \
+    }                                                                                                          \
+                                                                                                               \
+    static inline PID_CORE_##numeric##_VALUE_T name##_compute(name##_t *pid,                                   \
+                                                              PID_CORE_##numeric##_VALUE_T setpoint,           \
+                                                              PID_CORE_##numeric##_VALUE_T measurement)        \
+    {                                                                                                          \
+        const PID_CORE_##numeric##_VALUE_T error = setpoint - measurement;                                     \
+        PID_CORE_##numeric##_VALUE_T derivative;                                                               \
+        PID_CORE_##numeric##_ACCUM_T integral_term;                                                            \
+        PID_CORE_##numeric##_ACCUM_T output;                                                                   \
+        PID_CORE_##numeric##_VALUE_T result;                                                                   \
+                                                                                                               \
+        if (pid->first_run)                                                                                    \
+        {                                                                                                      \
+            pid->previous_measurement = measurement;                                                           \
+            pid->first_run = false;                                                                            \
+        }                                                                                                      \
+                                                                                                               \
+        derivative = PID_CORE_##numeric##_FROM_ACCUM(                                                          \
+            PID_CORE_##numeric##_MUL(pid->kd_over_ts, pid->previous_measurement - measurement));               \
+        if (((features) & PID_CORE_DERIVATIVE_FILTER) != 0U)                                                   \
+        {                                                                                                      \
+            pid->filtered_derivative += PID_CORE_##numeric##_FROM_ACCUM(                                       \
+                PID_CORE_##numeric##_MUL(pid->derivative_alpha, derivative - pid->filtered_derivative));       \
+            derivative = pid->filtered_derivative;                                                             \
+        }                                                                                                      \
+                                                                                                               \
+        output = PID_CORE_##numeric##_MUL(pid->kp, error) + PID_CORE_##numeric##_TO_ACCUM(derivative);        \
+                                                                                                               \
+        /* Integrate unless the output is saturated and the error pushes further in. */                        \
+        if (((output + pid->integral_term) < pid->output_max || error < 0) &&                                  \
+            ((output + pid->integral_term) > pid->output_min || error > 0))                                    \
+        {                                                                                                      \
+            integral_term = pid->integral_term + PID_CORE_##numeric##_MUL_COEF(pid->ki_ts, error);             \
+            if (((features) & PID_CORE_INTEGRAL_CLAMP) != 0U)                                                  \
+            {                                                                                                  \
+                integral_term = PID_CORE_CLAMP(integral_term, pid->integral_term_min, pid->integral_term_max); \
+            }                                                                                                  \
+            pid->integral_term = integral_term;                                                                \
+        }                                                                                                      \
+                                                                                                               \
+        output = PID_CORE_CLAMP(output + pid->integral_term, pid->output_min, pid->output_max);                \
+        result = PID_CORE_##numeric##_FROM_ACCUM(output);                                                      \
+                                                                                                               \
+        if (((features) & PID_CORE_SLEW_LIMIT) != 0U)                                                          \
+        {                                                                                                      \
+            result = PID_CORE_CLAMP(result,                                                                    \
+                                    pid->previous_output - pid->slew_max_delta,                                \
+                                    pid->previous_output + pid->slew_max_delta);                               \
+        }                                                                                                      \
+                                                                                                               \
+        pid->previous_measurement = measurement;                                                               \
+        pid->previous_output = result;                                                                         \
+                                                                                                               \
+        return result;                                                                                         \
+    }
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
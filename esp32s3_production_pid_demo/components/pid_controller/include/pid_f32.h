@@ -2,11 +2,20 @@
 #define PID_F32_H
 
 #include <stdbool.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+typedef struct
+{
+    float operating_point;
+    float kp;
+    float ki;
+    float kd;
+} pid_f32_gain_point_t;
+
 typedef struct
 {
     float kp;
@@ -19,8 +28,13 @@ typedef struct
     float integral_max;
     float slew_rate_limit_per_s;
     float derivative_filter_alpha;
+    float setpoint_weight;
+    const pid_f32_gain_point_t *gain_schedule;
+    size_t gain_schedule_count;
     float integral;
+    float previous_setpoint;
     float previous_measurement;
+    float previous_feed_forward;
     float filtered_derivative;
     float previous_output;
     bool first_run;
@@ -88,9 +102,28 @@ void pid_f32_set_derivative_filter(pid_f32_t *pid, float alpha);
  */
 void pid_f32_set_slew_rate_limit(pid_f32_t *pid, float slew_rate_limit_per_s);
 
+/**
+ * Configures setpoint weighting for the proportional term (2-DOF PID).
+ *
+ * The proportional term acts on weight * setpoint - measurement. Weights
+ * below 1.0 soften the kick on setpoint steps without slowing the response
+ * to disturbances, which the integral and derivative terms still see in full.
+ *
+ * Args:
+ *     pid: Pointer to the PID controller instance.
+ *     weight: Setpoint weight from 0.0 to 1.0. Use 1.0 for a classic PID.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_f32_set_setpoint_weight(pid_f32_t *pid, float weight);
+
 /**
  * Updates PID gains at runtime.
  *
+ * Once the controller is running, the integral is adjusted so the output
+ * for the last inputs stays the same under the new gains (bumpless transfer).
+ *
  * Args:
  *     pid: Pointer to the PID controller instance.
  *     kp: Proportional gain.
@@ -102,6 +135,40 @@ void pid_f32_set_slew_rate_limit(pid_f32_t *pid, float slew_rate_limit_per_s);
  */
 void pid_f32_set_gains(pid_f32_t *pid, float kp, float ki, float kd);
 
+/**
+ * Sets a gain-schedule table.
+ *
+ * The table is not copied and must stay valid while it is in use. Points
+ * must be sorted by ascending operating point.
+ *
+ * Args:
+ *     pid: Pointer to the PID controller instance.
+ *     points: Gain points, or NULL to remove the schedule.
+ *     count: Number of gain points.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_f32_set_gain_schedule(pid_f32_t *pid,
+                               const pid_f32_gain_point_t *points,
+                               size_t count);
+
+/**
+ * Applies the scheduled gains for an operating point.
+ *
+ * Gains are interpolated linearly between the two nearest table points and
+ * held at the first or last point outside the table. They are applied
+ * through pid_f32_set_gains(), so the transfer is bumpless.
+ *
+ * Args:
+ *     pid: Pointer to the PID controller instance.
+ *     operating_point: Current value of the scheduling variable, such as speed or load.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_f32_schedule_gains(pid_f32_t *pid, float operating_point);
+
 /**
  * Preloads the PID internal state for smooth manual-to-automatic transition.
  *
@@ -147,6 +214,24 @@ void pid_f32_reset(pid_f32_t *pid);
  */
 float pid_f32_compute(pid_f32_t *pid, float setpoint, float measurement);
 
+/**
+ * Computes one PID update with an additional feed-forward term.
+ *
+ * The feed-forward term is added to the PID terms before clamping and is
+ * included in the anti-windup decision, so the integral only has to correct
+ * what the feed-forward model gets wrong.
+ *
+ * Args:
+ *     pid: Pointer to the PID controller instance.
+ *     setpoint: Desired target value.
+ *     measurement: Current measured process variable.
+ *     feed_forward: Model-based output contribution, in output units.
+ *
+ * Returns:
+ *     Saturated and slew-limited controller output.
+ */
+float pid_f32_compute_ff(pid_f32_t *pid, float setpoint, float measurement, float feed_forward);
+
 #ifdef __cplusplus
 }
 #endif
@@ -23,7 +23,11 @@ typedef struct
     pid_q16_t output_max;
     pid_q16_t integral_min;
     pid_q16_t integral_max;
-    pid_q16_t integral;
+    int32_t ki_ts_q28;
+    pid_q16_t kd_over_ts;
+    int64_t integral_term_min_q32;
+    int64_t integral_term_max_q32;
+    int64_t integral_term_q32;
     pid_q16_t previous_measurement;
     pid_q16_t previous_output;
     bool first_run;
@@ -86,9 +90,35 @@ void pid_q16_init(pid_q16_controller_t *pid,
                   pid_q16_t output_min,
                   pid_q16_t output_max);
 
+/**
+ * Updates PID gains at runtime.
+ *
+ * The per-sample coefficients are recomputed here, so this is the only
+ * place besides initialization that divides. The accumulated integral term
+ * is kept in output units, so changing ki does not bump the output.
+ *
+ * Args:
+ *     pid: Pointer to the PID controller instance.
+ *     kp: Proportional gain in Q16.16 format.
+ *     ki: Integral gain in Q16.16 format.
+ *     kd: Derivative gain in Q16.16 format.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_q16_set_gains(pid_q16_controller_t *pid,
+                       pid_q16_t kp,
+                       pid_q16_t ki,
+                       pid_q16_t kd);
+
 /**
  * Computes one Q16.16 fixed-point PID update.
  *
+ * Uses coefficients precomputed by pid_q16_init() and pid_q16_set_gains():
+ * kd / sample_time_s in Q16.16 and ki * sample_time_s in Q4.28, so small
+ * sample times keep their precision. Each call does one multiply per term,
+ * accumulates in 64 bits and saturates once, with no division.
+ *
  * Args:
  *     pid: Pointer to the PID controller instance.
  *     setpoint: Desired target value in Q16.16 format.
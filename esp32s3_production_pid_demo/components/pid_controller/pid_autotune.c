@@ -0,0 +1,209 @@
+#include "pid_autotune.h"
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * Starts a relay-feedback autotune experiment.
+ *
+ * @param tuner The autotune instance.
+ * @param setpoint The setpoint to oscillate around.
+ * @param output_bias The output that holds the process near the setpoint.
+ * @param relay_amplitude The relay step above and below the bias.
+ * @param hysteresis The half width of the switching band.
+ * @param cycles The number of oscillations to average.
+ * @param sample_time_s The sample time in seconds.
+ * @param timeout_s The experiment timeout in seconds.
+ */
+void pid_autotune_init(pid_autotune_t *tuner,
+                       float setpoint,
+                       float output_bias,
+                       float relay_amplitude,
+                       float hysteresis,
+                       uint32_t cycles,
+                       float sample_time_s,
+                       float timeout_s)
+{
+    if (tuner == NULL)
+    {
+        return;
+    }
+
+    memset(tuner, 0, sizeof(*tuner));
+    tuner->setpoint = setpoint;
+    tuner->output_bias = output_bias;
+    tuner->relay_amplitude = fabsf(relay_amplitude);
+    tuner->hysteresis = fabsf(hysteresis);
+    tuner->sample_time_s = sample_time_s;
+    tuner->cycles_required = (cycles > 0U) ? cycles : 1U;
+    tuner->max_samples = (sample_time_s > 0.0f) ? (uint32_t)(timeout_s / sample_time_s) : 0U;
+    tuner->output = output_bias;
+    tuner->state = (sample_time_s > 0.0f && relay_amplitude != 0.0f) ? PID_AUTOTUNE_RUNNING : PID_AUTOTUNE_FAILED;
+}
+
+/**
+ * Runs one sample of the autotune experiment.
+ *
+ * A cycle is timed from one upward relay switch to the next. The peaks
+ * seen between those switches give the oscillation amplitude. The first
+ * cycle is skipped, since the process is still moving into the limit cycle.
+ *
+ * @param tuner The autotune instance.
+ * @param measurement The measurement value.
+ * @param output Receives the relay output.
+ * @return The experiment state.
+ */
+pid_autotune_state_t pid_autotune_update(pid_autotune_t *tuner, float measurement, float *output)
+{
+    bool switched_high = false;
+    float amplitude;
+    float ultimate_amplitude;
+
+    if (tuner == NULL)
+    {
+        return PID_AUTOTUNE_FAILED;
+    }
+
+    if (tuner->state != PID_AUTOTUNE_RUNNING)
+    {
+        if (output != NULL)
+        {
+            *output = tuner->output;
+        }
+        return tuner->state;
+    }
+
+    tuner->sample_count++;
+    if (tuner->sample_count > tuner->max_samples)
+    {
+        tuner->state = PID_AUTOTUNE_FAILED;
+        tuner->output = tuner->output_bias;
+    }
+    else
+    {
+        if (!tuner->started)
+        {
+            tuner->relay_high = measurement < tuner->setpoint;
+            tuner->peak_high = measurement;
+            tuner->peak_low = measurement;
+            tuner->started = true;
+        }
+
+        tuner->peak_high = (measurement > tuner->peak_high) ? measurement : tuner->peak_high;
+        tuner->peak_low = (measurement < tuner->peak_low) ? measurement : tuner->peak_low;
+
+        if (tuner->relay_high && measurement > tuner->setpoint + tuner->hysteresis)
+        {
+            tuner->relay_high = false;
+        }
+        else if (!tuner->relay_high && measurement < tuner->setpoint - tuner->hysteresis)
+        {
+            tuner->relay_high = true;
+            switched_high = true;
+        }
+
+        if (switched_high)
+        {
+            if (tuner->last_rising_sample != 0U)
+            {
+                amplitude = 0.5f * (tuner->peak_high - tuner->peak_low);
+
+                // The first complete cycle still carries the approach transient.
+                if (tuner->cycles_measured > 0U)
+                {
+                    tuner->period_sum_s += (float)(tuner->sample_count - tuner->last_rising_sample) *
+                                           tuner->sample_time_s;
+                    tuner->amplitude_sum += amplitude;
+                }
+                tuner->cycles_measured++;
+            }
+
+            tuner->last_rising_sample = tuner->sample_count;
+            tuner->peak_high = measurement;
+            tuner->peak_low = measurement;
+
+            if (tuner->cycles_measured > tuner->cycles_required)
+            {
+                amplitude = tuner->amplitude_sum / (float)tuner->cycles_required;
+                ultimate_amplitude = (amplitude > tuner->hysteresis) ?
+                                     sqrtf((amplitude * amplitude) - (tuner->hysteresis * tuner->hysteresis)) :
+                                     0.0f;
+
+                tuner->ultimate_period_s = tuner->period_sum_s / (float)tuner->cycles_required;
+                if (ultimate_amplitude > 0.0f && tuner->ultimate_period_s > 0.0f)
+                {
+                    // Describing function of an ideal relay, corrected for hysteresis.
+                    tuner->ultimate_gain = (4.0f * tuner->relay_amplitude) / ((float)M_PI * ultimate_amplitude);
+                    tuner->state = PID_AUTOTUNE_DONE;
+                }
+                else
+                {
+                    tuner->state = PID_AUTOTUNE_FAILED;
+                }
+            }
+        }
+
+        tuner->output = tuner->relay_high ?
+                        tuner->output_bias + tuner->relay_amplitude :
+                        tuner->output_bias - tuner->relay_amplitude;
+    }
+
+    if (output != NULL)
+    {
+        *output = tuner->output;
+    }
+
+    return tuner->state;
+}
+
+/**
+ * Computes PID gains from the ultimate gain and period.
+ *
+ * The rules give Kp, Ti and Td; the parallel-form gains used by pid_f32_t
+ * are ki = Kp / Ti and kd = Kp * Td.
+ *
+ * @param tuner The autotune instance.
+ * @param rule The tuning rule.
+ * @param kp Receives the proportional gain.
+ * @param ki Receives the integral gain.
+ * @param kd Receives the derivative gain.
+ * @return True if gains were computed.
+ */
+bool pid_autotune_get_gains(const pid_autotune_t *tuner,
+                            pid_autotune_rule_t rule,
+                            float *kp,
+                            float *ki,
+                            float *kd)
+{
+    float proportional;
+    float integral_time_s;
+    float derivative_time_s;
+
+    if (tuner == NULL || kp == NULL || ki == NULL || kd == NULL || tuner->state != PID_AUTOTUNE_DONE)
+    {
+        return false;
+    }
+
+    switch (rule)
+    {
+    case PID_AUTOTUNE_RULE_TYREUS_LUYBEN:
+        proportional = tuner->ultimate_gain / 2.2f;
+        integral_time_s = 2.2f * tuner->ultimate_period_s;
+        derivative_time_s = tuner->ultimate_period_s / 6.3f;
+        break;
+
+    case PID_AUTOTUNE_RULE_ZIEGLER_NICHOLS:
+    default:
+        proportional = 0.6f * tuner->ultimate_gain;
+        integral_time_s = 0.5f * tuner->ultimate_period_s;
+        derivative_time_s = 0.125f * tuner->ultimate_period_s;
+        break;
+    }
+
+    *kp = proportional;
+    *ki = proportional / integral_time_s;
+    *kd = proportional * derivative_time_s;
+
+    return true;
+}
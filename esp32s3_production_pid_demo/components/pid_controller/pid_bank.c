@@ -0,0 +1,319 @@
+#include "pid_bank.h"
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PID_BANK_ARRAY_COUNT         13U
+#define PID_BANK_DEFAULT_FILTER      0.15f
+
+/**
+ * Clamps a float value between a minimum and maximum.
+ *
+ * @param value The value to clamp.
+ * @param min_value The minimum value.
+ * @param max_value The maximum value.
+ * @return The clamped value.
+ */
+static inline float clamp_f32(float value, float min_value, float max_value)
+{
+    value = (value > max_value) ? max_value : value;
+    return (value < min_value) ? min_value : value;
+}
+
+/**
+ * Checks that a bank exists and a channel index is inside it.
+ *
+ * @param bank The PID bank.
+ * @param channel The channel index.
+ * @return True if the channel can be accessed.
+ */
+static bool is_valid_channel(const pid_bank_t *bank, size_t channel)
+{
+    return bank != NULL && bank->storage != NULL && channel < bank->channel_count;
+}
+
+/**
+ * Allocates a PID bank.
+ *
+ * @param bank The PID bank.
+ * @param channel_count The number of channels.
+ * @param sample_time_s The shared sample time in seconds.
+ * @return True on success.
+ */
+bool pid_bank_init(pid_bank_t *bank, size_t channel_count, float sample_time_s)
+{
+    float **arrays[PID_BANK_ARRAY_COUNT];
+    float *storage;
+    size_t stride;
+
+    if (bank == NULL || channel_count == 0U || sample_time_s <= 0.0f)
+    {
+        return false;
+    }
+
+    // Round each array up to four floats so every array starts 16-byte aligned.
+    stride = (channel_count + 3U) & ~(size_t)3U;
+    storage = aligned_alloc(16, PID_BANK_ARRAY_COUNT * stride * sizeof(float));
+    if (storage == NULL)
+    {
+        return false;
+    }
+
+    memset(bank, 0, sizeof(*bank));
+    arrays[0] = &bank->kp;
+    arrays[1] = &bank->ki;
+    arrays[2] = &bank->kd;
+    arrays[3] = &bank->output_min;
+    arrays[4] = &bank->output_max;
+    arrays[5] = &bank->integral_min;
+    arrays[6] = &bank->integral_max;
+    arrays[7] = &bank->derivative_filter_alpha;
+    arrays[8] = &bank->slew_max_delta;
+    arrays[9] = &bank->integral;
+    arrays[10] = &bank->previous_measurement;
+    arrays[11] = &bank->filtered_derivative;
+    arrays[12] = &bank->previous_output;
+
+    for (size_t i = 0; i < PID_BANK_ARRAY_COUNT; i++)
+    {
+        *arrays[i] = storage + (i * stride);
+    }
+
+    bank->storage = storage;
+    bank->channel_count = channel_count;
+    bank->sample_time_s = sample_time_s;
+    bank->inverse_sample_time = 1.0f / sample_time_s;
+
+    for (size_t channel = 0; channel < channel_count; channel++)
+    {
+        pid_bank_configure_channel(bank, channel, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f);
+    }
+    pid_bank_reset(bank);
+
+    return true;
+}
+
+/**
+ * Frees a PID bank.
+ *
+ * @param bank The PID bank.
+ */
+void pid_bank_deinit(pid_bank_t *bank)
+{
+    if (bank == NULL)
+    {
+        return;
+    }
+
+    free(bank->storage);
+    memset(bank, 0, sizeof(*bank));
+}
+
+/**
+ * Configures one channel of the PID bank.
+ *
+ * @param bank The PID bank.
+ * @param channel The channel index.
+ * @param kp The proportional gain.
+ * @param ki The integral gain.
+ * @param kd The derivative gain.
+ * @param output_min The minimum output value.
+ * @param output_max The maximum output value.
+ */
+void pid_bank_configure_channel(pid_bank_t *bank,
+                                size_t channel,
+                                float kp,
+                                float ki,
+                                float kd,
+                                float output_min,
+                                float output_max)
+{
+    if (!is_valid_channel(bank, channel))
+    {
+        return;
+    }
+
+    bank->kp[channel] = kp;
+    bank->ki[channel] = ki;
+    bank->kd[channel] = kd;
+    bank->output_min[channel] = output_min;
+    bank->output_max[channel] = output_max;
+    bank->integral_min[channel] = output_min;
+    bank->integral_max[channel] = output_max;
+    bank->derivative_filter_alpha[channel] = PID_BANK_DEFAULT_FILTER;
+    bank->slew_max_delta[channel] = INFINITY;
+}
+
+/**
+ * Sets the integral limits of one channel.
+ *
+ * @param bank The PID bank.
+ * @param channel The channel index.
+ * @param integral_min The minimum integral value.
+ * @param integral_max The maximum integral value.
+ */
+void pid_bank_set_integral_limits(pid_bank_t *bank,
+                                  size_t channel,
+                                  float integral_min,
+                                  float integral_max)
+{
+    if (!is_valid_channel(bank, channel))
+    {
+        return;
+    }
+
+    bank->integral_min[channel] = integral_min;
+    bank->integral_max[channel] = integral_max;
+    bank->integral[channel] = clamp_f32(bank->integral[channel], integral_min, integral_max);
+}
+
+/**
+ * Sets the derivative filter of one channel.
+ *
+ * @param bank The PID bank.
+ * @param channel The channel index.
+ * @param alpha The filter coefficient.
+ */
+void pid_bank_set_derivative_filter(pid_bank_t *bank, size_t channel, float alpha)
+{
+    if (!is_valid_channel(bank, channel))
+    {
+        return;
+    }
+
+    bank->derivative_filter_alpha[channel] = clamp_f32(alpha, 0.0f, 1.0f);
+}
+
+/**
+ * Sets the slew rate limit of one channel.
+ *
+ * The limit is stored as the largest change per sample, with infinity
+ * standing for no limit so the compute loop needs no branch for it.
+ *
+ * @param bank The PID bank.
+ * @param channel The channel index.
+ * @param slew_rate_limit_per_s The slew rate limit per second.
+ */
+void pid_bank_set_slew_rate_limit(pid_bank_t *bank, size_t channel, float slew_rate_limit_per_s)
+{
+    if (!is_valid_channel(bank, channel))
+    {
+        return;
+    }
+
+    bank->slew_max_delta[channel] = (slew_rate_limit_per_s > 0.0f) ?
+                                    slew_rate_limit_per_s * bank->sample_time_s :
+                                    INFINITY;
+}
+
+/**
+ * Resets the runtime state of every channel.
+ *
+ * @param bank The PID bank.
+ */
+void pid_bank_reset(pid_bank_t *bank)
+{
+    if (bank == NULL || bank->storage == NULL)
+    {
+        return;
+    }
+
+    memset(bank->integral, 0, bank->channel_count * sizeof(float));
+    memset(bank->previous_measurement, 0, bank->channel_count * sizeof(float));
+    memset(bank->filtered_derivative, 0, bank->channel_count * sizeof(float));
+    memset(bank->previous_output, 0, bank->channel_count * sizeof(float));
+    bank->first_run = true;
+}
+
+/**
+ * Computes one update of every channel.
+ *
+ * @param bank The PID bank.
+ * @param setpoints The setpoint of each channel.
+ * @param measurements The measurement of each channel.
+ * @param outputs The output of each channel.
+ */
+void pid_bank_compute(pid_bank_t *bank,
+                      const float *setpoints,
+                      const float *measurements,
+                      float *outputs)
+{
+    const float *restrict kp;
+    const float *restrict ki;
+    const float *restrict kd;
+    const float *restrict output_min;
+    const float *restrict output_max;
+    const float *restrict integral_min;
+    const float *restrict integral_max;
+    const float *restrict alpha;
+    const float *restrict slew_max_delta;
+    float *restrict integral;
+    float *restrict previous_measurement;
+    float *restrict filtered_derivative;
+    float *restrict previous_output;
+    size_t count;
+    float sample_time_s;
+    float inverse_sample_time;
+
+    if (bank == NULL || bank->storage == NULL || setpoints == NULL || measurements == NULL || outputs == NULL)
+    {
+        return;
+    }
+
+    kp = bank->kp;
+    ki = bank->ki;
+    kd = bank->kd;
+    output_min = bank->output_min;
+    output_max = bank->output_max;
+    integral_min = bank->integral_min;
+    integral_max = bank->integral_max;
+    alpha = bank->derivative_filter_alpha;
+    slew_max_delta = bank->slew_max_delta;
+    integral = bank->integral;
+    previous_measurement = bank->previous_measurement;
+    filtered_derivative = bank->filtered_derivative;
+    previous_output = bank->previous_output;
+    count = bank->channel_count;
+    sample_time_s = bank->sample_time_s;
+    inverse_sample_time = bank->inverse_sample_time;
+
+    if (bank->first_run)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            previous_measurement[i] = measurements[i];
+            filtered_derivative[i] = 0.0f;
+            previous_output[i] = clamp_f32(previous_output[i], output_min[i], output_max[i]);
+        }
+        bank->first_run = false;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const float measurement = measurements[i];
+        const float error = setpoints[i] - measurement;
+        const float proportional = kp[i] * error;
+        const float derivative_raw = (previous_measurement[i] - measurement) * inverse_sample_time;
+        const float filtered = filtered_derivative[i] + alpha[i] * (derivative_raw - filtered_derivative[i]);
+        const float derivative = kd[i] * filtered;
+        const float output_unsaturated = proportional + (ki[i] * integral[i]) + derivative;
+        const bool can_integrate = ((output_unsaturated < output_max[i]) && (output_unsaturated > output_min[i])) ||
+                                   ((output_unsaturated >= output_max[i]) && (error < 0.0f)) ||
+                                   ((output_unsaturated <= output_min[i]) && (error > 0.0f));
+        const float integrated = clamp_f32(integral[i] + (error * sample_time_s), integral_min[i], integral_max[i]);
+        float output;
+
+        integral[i] = can_integrate ? integrated : integral[i];
+
+        output = clamp_f32(proportional + (ki[i] * integral[i]) + derivative, output_min[i], output_max[i]);
+        output = clamp_f32(output,
+                           previous_output[i] - slew_max_delta[i],
+                           previous_output[i] + slew_max_delta[i]);
+
+        filtered_derivative[i] = filtered;
+        previous_measurement[i] = measurement;
+        previous_output[i] = output;
+        outputs[i] = output;
+    }
+}
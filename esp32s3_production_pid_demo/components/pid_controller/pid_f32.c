@@ -59,6 +59,9 @@ void pid_f32_init(pid_f32_t *pid,
     pid->integral_max = output_max;
     pid->slew_rate_limit_per_s = 0.0f;
     pid->derivative_filter_alpha = 0.15f;
+    pid->setpoint_weight = 1.0f;
+    pid->gain_schedule = NULL;
+    pid->gain_schedule_count = 0U;
     pid_f32_reset(pid);
 }
 
@@ -115,9 +118,29 @@ void pid_f32_set_slew_rate_limit(pid_f32_t *pid, float slew_rate_limit_per_s)
     pid->slew_rate_limit_per_s = slew_rate_limit_per_s < 0.0f ? 0.0f : slew_rate_limit_per_s;
 }
 
+/**
+ * Sets the setpoint weight of the proportional term.
+ *
+ * @param pid The PID controller instance.
+ * @param weight The setpoint weight.
+ */
+void pid_f32_set_setpoint_weight(pid_f32_t *pid, float weight)
+{
+    if (pid == NULL)
+    {
+        return;
+    }
+
+    pid->setpoint_weight = clamp_f32(weight, 0.0f, 1.0f);
+}
+
 /**
  * Sets the PID gains for the controller.
  *
+ * When the controller is running, the integral absorbs the change in the
+ * proportional and derivative terms for the last inputs, so the output
+ * continues from where it was. This needs a nonzero new ki.
+ *
  * @param pid The PID controller instance.
  * @param kp The proportional gain.
  * @param ki The integral gain.
@@ -125,16 +148,96 @@ void pid_f32_set_slew_rate_limit(pid_f32_t *pid, float slew_rate_limit_per_s)
  */
 void pid_f32_set_gains(pid_f32_t *pid, float kp, float ki, float kd)
 {
+    float weighted_error;
+    float integral_term;
+
     if (pid == NULL)
     {
         return;
     }
 
+    if (!pid->first_run && ki != 0.0f)
+    {
+        weighted_error = (pid->setpoint_weight * pid->previous_setpoint) - pid->previous_measurement;
+        integral_term = (pid->ki * pid->integral) +
+                        ((pid->kp - kp) * weighted_error) +
+                        ((pid->kd - kd) * pid->filtered_derivative);
+        pid->integral = clamp_f32(integral_term / ki, pid->integral_min, pid->integral_max);
+    }
+
     pid->kp = kp;
     pid->ki = ki;
     pid->kd = kd;
 }
 
+/**
+ * Sets the gain-schedule table.
+ *
+ * @param pid The PID controller instance.
+ * @param points The gain points, sorted by operating point.
+ * @param count The number of gain points.
+ */
+void pid_f32_set_gain_schedule(pid_f32_t *pid,
+                               const pid_f32_gain_point_t *points,
+                               size_t count)
+{
+    if (pid == NULL)
+    {
+        return;
+    }
+
+    pid->gain_schedule = (count > 0U) ? points : NULL;
+    pid->gain_schedule_count = (points != NULL) ? count : 0U;
+}
+
+/**
+ * Applies the scheduled gains for an operating point.
+ *
+ * @param pid The PID controller instance.
+ * @param operating_point The current operating point.
+ */
+void pid_f32_schedule_gains(pid_f32_t *pid, float operating_point)
+{
+    const pid_f32_gain_point_t *points;
+    const pid_f32_gain_point_t *low;
+    const pid_f32_gain_point_t *high;
+    size_t count;
+    float fraction;
+
+    if (pid == NULL || pid->gain_schedule == NULL)
+    {
+        return;
+    }
+
+    points = pid->gain_schedule;
+    count = pid->gain_schedule_count;
+
+    if (count == 1U || operating_point <= points[0].operating_point)
+    {
+        pid_f32_set_gains(pid, points[0].kp, points[0].ki, points[0].kd);
+        return;
+    }
+
+    if (operating_point >= points[count - 1U].operating_point)
+    {
+        pid_f32_set_gains(pid, points[count - 1U].kp, points[count - 1U].ki, points[count - 1U].kd);
+        return;
+    }
+
+    high = &points[1];
+    while (operating_point > high->operating_point)
+    {
+        high++;
+    }
+    low = high - 1;
+
+    fraction = (operating_point - low->operating_point) / (high->operating_point - low->operating_point);
+    pid_f32_set_gains(pid,
+                      low->kp + (fraction * (high->kp - low->kp)),
+                      low->ki + (fraction * (high->ki - low->ki)),
+                      low->kd + (fraction * (high->kd - low->kd)));
+}
+
 /**
  * Sets the manual output for the PID controller.
  *
@@ -157,12 +260,12 @@ void pid_f32_set_manual_output(pid_f32_t *pid,
     }
 
     current_output = clamp_f32(current_output, pid->output_min, pid->output_max);
-    error = setpoint - measurement;
+    error = (pid->setpoint_weight * setpoint) - measurement;
     proportional = pid->kp * error;
 
     if (pid->ki != 0.0f)
     {
-        pid->integral = (current_output - proportional) / pid->ki;
+        pid->integral = (current_output - proportional - pid->previous_feed_forward) / pid->ki;
         pid->integral = clamp_f32(pid->integral, pid->integral_min, pid->integral_max);
     }
     else
@@ -171,6 +274,7 @@ void pid_f32_set_manual_output(pid_f32_t *pid,
     }
 
     pid->previous_output = current_output;
+    pid->previous_setpoint = setpoint;
     pid->previous_measurement = measurement;
     pid->filtered_derivative = 0.0f;
     pid->first_run = false;
@@ -189,7 +293,9 @@ void pid_f32_reset(pid_f32_t *pid)
     }
 
     pid->integral = 0.0f;
+    pid->previous_setpoint = 0.0f;
     pid->previous_measurement = 0.0f;
+    pid->previous_feed_forward = 0.0f;
     pid->filtered_derivative = 0.0f;
     pid->previous_output = 0.0f;
     pid->first_run = true;
@@ -204,6 +310,20 @@ void pid_f32_reset(pid_f32_t *pid)
  * @return The computed PID output.
  */
 float pid_f32_compute(pid_f32_t *pid, float setpoint, float measurement)
+{
+    return pid_f32_compute_ff(pid, setpoint, measurement, 0.0f);
+}
+
+/**
+ * Computes the PID output with a feed-forward term.
+ *
+ * @param pid The PID controller instance.
+ * @param setpoint The setpoint value.
+ * @param measurement The measurement value.
+ * @param feed_forward The feed-forward term.
+ * @return The computed PID output.
+ */
+float pid_f32_compute_ff(pid_f32_t *pid, float setpoint, float measurement, float feed_forward)
 {
     float error;
     float proportional;
@@ -229,14 +349,14 @@ float pid_f32_compute(pid_f32_t *pid, float setpoint, float measurement)
     }
 
     error = setpoint - measurement;
-    proportional = pid->kp * error;
+    proportional = pid->kp * ((pid->setpoint_weight * setpoint) - measurement);
 
     derivative_raw = -(measurement - pid->previous_measurement) / pid->sample_time_s;
     pid->filtered_derivative += pid->derivative_filter_alpha *
                                 (derivative_raw - pid->filtered_derivative);
     derivative = pid->kd * pid->filtered_derivative;
 
-    output_unsaturated = proportional + (pid->ki * pid->integral) + derivative;
+    output_unsaturated = proportional + (pid->ki * pid->integral) + derivative + feed_forward;
 
     can_integrate = ((output_unsaturated < pid->output_max) && (output_unsaturated > pid->output_min)) ||
                     ((output_unsaturated >= pid->output_max) && (error < 0.0f)) ||
@@ -248,7 +368,7 @@ float pid_f32_compute(pid_f32_t *pid, float setpoint, float measurement)
         pid->integral = clamp_f32(pid->integral, pid->integral_min, pid->integral_max);
     }
 
-    output = proportional + (pid->ki * pid->integral) + derivative;
+    output = proportional + (pid->ki * pid->integral) + derivative + feed_forward;
     output = clamp_f32(output, pid->output_min, pid->output_max);
 
     if (pid->slew_rate_limit_per_s > 0.0f)
@@ -266,7 +386,9 @@ float pid_f32_compute(pid_f32_t *pid, float setpoint, float measurement)
         }
     }
 
+    pid->previous_setpoint = setpoint;
     pid->previous_measurement = measurement;
+    pid->previous_feed_forward = feed_forward;
     pid->previous_output = output;
 
     return output;
@@ -1,16 +1,17 @@
 #include "pid_q16.h"
 
 #include <stddef.h>
+#include <stdint.h>
 
 /**
- * Clamps a Q16 value to a specified range.
+ * Clamps a 64-bit value to a specified range.
  *
  * @param value The value to clamp.
  * @param min_value The minimum value.
  * @param max_value The maximum value.
  * @return The clamped value.
  */
-static pid_q16_t clamp_q16(pid_q16_t value, pid_q16_t min_value, pid_q16_t max_value)
+static int64_t clamp_i64(int64_t value, int64_t min_value, int64_t max_value)
 {
     if (value > max_value)
     {
@@ -25,6 +26,43 @@ static pid_q16_t clamp_q16(pid_q16_t value, pid_q16_t min_value, pid_q16_t max_v
     return value;
 }
 
+/**
+ * Precomputes the per-sample coefficients from the gains and sample time.
+ *
+ * The integral limits bound the integral of the error, as in the float
+ * controller. Since the controller accumulates ki * integral directly, the
+ * limits are scaled by ki here as well.
+ *
+ * @param pid The PID controller instance.
+ */
+static void update_coefficients(pid_q16_controller_t *pid)
+{
+    int64_t term_a;
+    int64_t term_b;
+
+    // Q16.16 * Q16.16 is Q32; keep 28 fractional bits so ki * Ts stays nonzero at short sample times.
+    pid->ki_ts_q28 = (int32_t)clamp_i64(((int64_t)pid->ki * pid->sample_time_s) >> 4, INT32_MIN, INT32_MAX);
+
+    if (pid->sample_time_s != 0)
+    {
+        pid->kd_over_ts = (pid_q16_t)clamp_i64(((int64_t)pid->kd << PID_Q16_SHIFT) / pid->sample_time_s,
+                                               INT32_MIN,
+                                               INT32_MAX);
+    }
+    else
+    {
+        pid->kd_over_ts = 0;
+    }
+
+    term_a = (int64_t)pid->ki * pid->integral_min;
+    term_b = (int64_t)pid->ki * pid->integral_max;
+    pid->integral_term_min_q32 = (term_a < term_b) ? term_a : term_b;
+    pid->integral_term_max_q32 = (term_a < term_b) ? term_b : term_a;
+    pid->integral_term_q32 = clamp_i64(pid->integral_term_q32,
+                                       pid->integral_term_min_q32,
+                                       pid->integral_term_max_q32);
+}
+
 /**
  * Converts a float value to a Q16 value.
  *
@@ -91,10 +129,35 @@ void pid_q16_init(pid_q16_controller_t *pid,
     pid->output_max = output_max;
     pid->integral_min = output_min;
     pid->integral_max = output_max;
-    pid->integral = 0;
+    pid->integral_term_q32 = 0;
     pid->previous_measurement = 0;
     pid->previous_output = 0;
     pid->first_run = true;
+    update_coefficients(pid);
+}
+
+/**
+ * Sets the PID gains and recomputes the per-sample coefficients.
+ *
+ * @param pid The PID controller instance.
+ * @param kp The proportional gain.
+ * @param ki The integral gain.
+ * @param kd The derivative gain.
+ */
+void pid_q16_set_gains(pid_q16_controller_t *pid,
+                       pid_q16_t kp,
+                       pid_q16_t ki,
+                       pid_q16_t kd)
+{
+    if (pid == NULL)
+    {
+        return;
+    }
+
+    pid->kp = kp;
+    pid->ki = ki;
+    pid->kd = kd;
+    update_coefficients(pid);
 }
 
 /**
@@ -110,10 +173,10 @@ pid_q16_t pid_q16_compute(pid_q16_controller_t *pid,
                            pid_q16_t measurement)
 {
     pid_q16_t error;
-    pid_q16_t proportional;
-    pid_q16_t derivative;
-    pid_q16_t output_unsaturated;
-    pid_q16_t output;
+    int64_t proportional_derivative;
+    int64_t output_q32;
+    int64_t output_min_q32;
+    int64_t output_max_q32;
     bool can_integrate;
 
     if (pid == NULL || pid->sample_time_s == 0)
@@ -128,29 +191,29 @@ pid_q16_t pid_q16_compute(pid_q16_controller_t *pid,
     }
 
     error = setpoint - measurement;
-    proportional = pid_q16_mul(pid->kp, error);
+    output_min_q32 = (int64_t)pid->output_min << PID_Q16_SHIFT;
+    output_max_q32 = (int64_t)pid->output_max << PID_Q16_SHIFT;
 
-    derivative = -pid_q16_mul(pid->kd,
-                              (pid_q16_t)(((int64_t)(measurement - pid->previous_measurement) << PID_Q16_SHIFT) /
-                                          pid->sample_time_s));
+    // Every term is Q32 in output units, so they sum without intermediate shifts.
+    proportional_derivative = (int64_t)pid->kp * error -
+                              (int64_t)pid->kd_over_ts * ((int64_t)measurement - pid->previous_measurement);
+    output_q32 = proportional_derivative + pid->integral_term_q32;
 
-    output_unsaturated = proportional + pid_q16_mul(pid->ki, pid->integral) + derivative;
-
-    can_integrate = ((output_unsaturated < pid->output_max) && (output_unsaturated > pid->output_min)) ||
-                    ((output_unsaturated >= pid->output_max) && (error < 0)) ||
-                    ((output_unsaturated <= pid->output_min) && (error > 0));
+    can_integrate = ((output_q32 < output_max_q32) && (output_q32 > output_min_q32)) ||
+                    ((output_q32 >= output_max_q32) && (error < 0)) ||
+                    ((output_q32 <= output_min_q32) && (error > 0));
 
     if (can_integrate)
     {
-        pid->integral += pid_q16_mul(error, pid->sample_time_s);
-        pid->integral = clamp_q16(pid->integral, pid->integral_min, pid->integral_max);
+        // Q4.28 * Q16.16 is Q44; shift down to the Q32 accumulator.
+        pid->integral_term_q32 = clamp_i64(pid->integral_term_q32 + (((int64_t)pid->ki_ts_q28 * error) >> 12),
+                                           pid->integral_term_min_q32,
+                                           pid->integral_term_max_q32);
+        output_q32 = proportional_derivative + pid->integral_term_q32;
     }
 
-    output = proportional + pid_q16_mul(pid->ki, pid->integral) + derivative;
-    output = clamp_q16(output, pid->output_min, pid->output_max);
-
     pid->previous_measurement = measurement;
-    pid->previous_output = output;
+    pid->previous_output = (pid_q16_t)(clamp_i64(output_q32, output_min_q32, output_max_q32) >> PID_Q16_SHIFT);
 
-    return output;
+    return pid->previous_output;
 }
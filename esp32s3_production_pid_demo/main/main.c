@@ -4,6 +4,7 @@
 
 #include "driver/ledc.h"
 #include "esp_check.h"
+#include "esp_cpu.h"
 #include "esp_err.h"
 #include "esp_log.h"
 #include "esp_timer.h"
@@ -11,8 +12,13 @@
 #include "freertos/task.h"
 #include "nvs_flash.h"
 
+#include "pid_autotune.h"
+#include "pid_bank.h"
+#include "pid_core.h"
 #include "pid_f32.h"
+#include "pid_fast_loop.h"
 #include "pid_q16.h"
+#include "pid_sim.h"
 #include "simulated_motor.h"
 
 #define DEMO_PWM_GPIO              2
@@ -23,10 +29,52 @@
 #define PID_SAMPLE_TIME_S          0.010f
 #define PID_CONTROL_TASK_STACK     4096
 #define PID_CONTROL_TASK_PRIORITY  5
+#define PID_BENCH_ITERATIONS       2000U
+#define PID_BANK_BENCH_CHANNELS    16U
+
+// Relay autotune runs once, after the loop has settled on the hand-set gains.
+#define PID_AUTOTUNE_ENABLE          1
+#define PID_AUTOTUNE_START_SAMPLE    300U
+#define PID_AUTOTUNE_RELAY_PERCENT   10.0f
+#define PID_AUTOTUNE_HYSTERESIS_RPM  20.0f
+#define PID_AUTOTUNE_CYCLES          4U
+#define PID_AUTOTUNE_TIMEOUT_S       30.0f
+#define PID_AUTOTUNE_RULE            PID_AUTOTUNE_RULE_TYREUS_LUYBEN
+
+// Feed-forward from the no-load motor model: full PWM gives MOTOR_MAX_SPEED_RPM.
+#define PID_FEED_FORWARD_ENABLE      1
+#define MOTOR_MAX_SPEED_RPM          3200.0f
+#define PID_SETPOINT_WEIGHT          0.7f
+
+// The schedule replaces the hand-set or autotuned gains, so it is off by default.
+#define PID_GAIN_SCHEDULE_ENABLE     0
+
+// Batch simulation at startup, before the real-time task takes over the motor.
+#define PID_SIM_HARNESS_ENABLE       1
+#define PID_SIM_DURATION_S           25.0f
+#define PID_SIM_SETTLE_BAND_RPM      20.0f
+
+// Hardware-clocked loop: needs a real plant with its feedback on the ADC pin.
+#define PID_FAST_LOOP_ENABLE         0
+#define PID_FAST_LOOP_HZ             20000U
+#define PID_FAST_LOOP_ADC_CHANNEL    ADC_CHANNEL_0
+#define PID_FAST_LOOP_SAMPLES        2U
+#define PID_FAST_LOOP_SETPOINT       0.5f
+#define PID_FAST_LOOP_LOG_MS         1000
+
+// Same loop as pid_f32 with only clamping and anti-windup compiled in.
+PID_CORE_DEFINE(bench_pid, F32, 0)
 
 static const char *TAG = "pid_demo";
 static pid_f32_t s_motor_pid;
 
+// Gains by setpoint speed; the motor needs less gain the faster it runs.
+static const pid_f32_gain_point_t s_gain_schedule[] = {
+    { .operating_point = 600.0f, .kp = 0.10f, .ki = 0.45f, .kd = 0.002f },
+    { .operating_point = 1800.0f, .kp = 0.08f, .ki = 0.35f, .kd = 0.002f },
+    { .operating_point = 3000.0f, .kp = 0.06f, .ki = 0.25f, .kd = 0.002f },
+};
+
 /** Initializes the PWM output for the motor command.
  *
  * @return ESP_OK if PWM was configured successfully, otherwise an ESP-IDF error code.
@@ -106,6 +154,282 @@ static void run_fixed_point_pid_demo(void)
     ESP_LOGI(TAG, "Q16.16 PID smoke test output: %.2f", pid_q16_to_float(output));
 }
 
+/** Measures the cost of one Q16.16 and one float PID update in CPU cycles.
+ *
+ * Both controllers run the same gains on the same measurement sequence, with
+ * the float derivative filter disabled so the outputs are comparable.
+ *
+ * @return None.
+ */
+static void run_pid_benchmark(void)
+{
+    pid_f32_t pid_f32;
+    pid_q16_controller_t pid_q16;
+    bench_pid_t pid_core;
+    const pid_core_config_t core_config = {
+        .kp = 0.08f,
+        .ki = 0.35f,
+        .kd = 0.002f,
+        .sample_time_s = PID_SAMPLE_TIME_S,
+        .output_min = 0.0f,
+        .output_max = 100.0f,
+    };
+    pid_q16_t measurements_q16[64];
+    float measurements_f32[64];
+    volatile int32_t sink_q16 = 0;
+    volatile float sink_f32 = 0.0f;
+    float max_difference = 0.0f;
+    uint32_t start_cycles;
+    uint32_t q16_cycles;
+    uint32_t f32_cycles;
+    uint32_t core_cycles;
+
+    for (uint32_t i = 0; i < 64U; i++)
+    {
+        measurements_f32[i] = 1400.0f + (float)(i * 7U);
+        measurements_q16[i] = pid_q16_from_float(measurements_f32[i]);
+    }
+
+    pid_q16_init(&pid_q16,
+                 pid_q16_from_float(0.08f),
+                 pid_q16_from_float(0.35f),
+                 pid_q16_from_float(0.002f),
+                 pid_q16_from_float(PID_SAMPLE_TIME_S),
+                 pid_q16_from_float(0.0f),
+                 pid_q16_from_float(100.0f));
+    pid_f32_init(&pid_f32, 0.08f, 0.35f, 0.002f, PID_SAMPLE_TIME_S, 0.0f, 100.0f);
+    pid_f32_set_derivative_filter(&pid_f32, 1.0f);
+
+    start_cycles = esp_cpu_get_cycle_count();
+    for (uint32_t i = 0; i < PID_BENCH_ITERATIONS; i++)
+    {
+        sink_q16 = pid_q16_compute(&pid_q16, pid_q16_from_float(1500.0f), measurements_q16[i & 63U]);
+    }
+    q16_cycles = esp_cpu_get_cycle_count() - start_cycles;
+
+    start_cycles = esp_cpu_get_cycle_count();
+    for (uint32_t i = 0; i < PID_BENCH_ITERATIONS; i++)
+    {
+        sink_f32 = pid_f32_compute(&pid_f32, 1500.0f, measurements_f32[i & 63U]);
+    }
+    f32_cycles = esp_cpu_get_cycle_count() - start_cycles;
+
+    bench_pid_init(&pid_core, &core_config);
+    start_cycles = esp_cpu_get_cycle_count();
+    for (uint32_t i = 0; i < PID_BENCH_ITERATIONS; i++)
+    {
+        sink_f32 = bench_pid_compute(&pid_core, 1500.0f, measurements_f32[i & 63U]);
+    }
+    core_cycles = esp_cpu_get_cycle_count() - start_cycles;
+
+    // Replay a short run side by side to check that both controllers agree.
+    pid_q16_init(&pid_q16,
+                 pid_q16_from_float(0.08f),
+                 pid_q16_from_float(0.35f),
+                 pid_q16_from_float(0.002f),
+                 pid_q16_from_float(PID_SAMPLE_TIME_S),
+                 pid_q16_from_float(0.0f),
+                 pid_q16_from_float(100.0f));
+    pid_f32_reset(&pid_f32);
+    for (uint32_t i = 0; i < 64U; i++)
+    {
+        float difference = pid_q16_to_float(pid_q16_compute(&pid_q16, pid_q16_from_float(1500.0f), measurements_q16[i])) -
+                           pid_f32_compute(&pid_f32, 1500.0f, measurements_f32[i]);
+
+        if (difference < 0.0f)
+        {
+            difference = -difference;
+        }
+        if (difference > max_difference)
+        {
+            max_difference = difference;
+        }
+    }
+
+    (void)sink_q16;
+    (void)sink_f32;
+
+    ESP_LOGI(TAG,
+             "PID benchmark: q16=%" PRIu32 " cycles/update, f32=%" PRIu32 " cycles/update, core=%" PRIu32
+             " cycles/update, max difference=%.4f",
+             q16_cycles / PID_BENCH_ITERATIONS,
+             f32_cycles / PID_BENCH_ITERATIONS,
+             core_cycles / PID_BENCH_ITERATIONS,
+             max_difference);
+}
+
+/** Measures a 16-channel PID bank against 16 separate float controllers.
+ *
+ * Both sides use the same configuration and inputs, so the logged cycle
+ * counts compare only the memory layout and loop structure.
+ *
+ * @return None.
+ */
+static void run_pid_bank_benchmark(void)
+{
+    static pid_f32_t controllers[PID_BANK_BENCH_CHANNELS];
+    static float setpoints[PID_BANK_BENCH_CHANNELS];
+    static float measurements[PID_BANK_BENCH_CHANNELS];
+    static float outputs[PID_BANK_BENCH_CHANNELS];
+    pid_bank_t bank;
+    uint32_t start_cycles;
+    uint32_t bank_cycles;
+    uint32_t single_cycles;
+
+    if (!pid_bank_init(&bank, PID_BANK_BENCH_CHANNELS, PID_SAMPLE_TIME_S))
+    {
+        ESP_LOGE(TAG, "Failed to allocate the PID bank");
+        return;
+    }
+
+    for (uint32_t i = 0; i < PID_BANK_BENCH_CHANNELS; i++)
+    {
+        pid_f32_init(&controllers[i], 0.08f, 0.35f, 0.002f, PID_SAMPLE_TIME_S, 0.0f, 100.0f);
+        pid_f32_set_slew_rate_limit(&controllers[i], 250.0f);
+        pid_bank_configure_channel(&bank, i, 0.08f, 0.35f, 0.002f, 0.0f, 100.0f);
+        pid_bank_set_slew_rate_limit(&bank, i, 250.0f);
+        setpoints[i] = 1500.0f;
+        measurements[i] = 1200.0f + (float)(i * 20U);
+    }
+
+    start_cycles = esp_cpu_get_cycle_count();
+    for (uint32_t n = 0; n < PID_BENCH_ITERATIONS; n++)
+    {
+        pid_bank_compute(&bank, setpoints, measurements, outputs);
+    }
+    bank_cycles = esp_cpu_get_cycle_count() - start_cycles;
+
+    start_cycles = esp_cpu_get_cycle_count();
+    for (uint32_t n = 0; n < PID_BENCH_ITERATIONS; n++)
+    {
+        for (uint32_t i = 0; i < PID_BANK_BENCH_CHANNELS; i++)
+        {
+            outputs[i] = pid_f32_compute(&controllers[i], setpoints[i], measurements[i]);
+        }
+    }
+    single_cycles = esp_cpu_get_cycle_count() - start_cycles;
+
+    pid_bank_deinit(&bank);
+
+    ESP_LOGI(TAG,
+             "PID bank benchmark: %u channels, bank=%" PRIu32 " cycles/channel, separate=%" PRIu32 " cycles/channel",
+             (unsigned int)PID_BANK_BENCH_CHANNELS,
+             bank_cycles / (PID_BENCH_ITERATIONS * PID_BANK_BENCH_CHANNELS),
+             single_cycles / (PID_BENCH_ITERATIONS * PID_BANK_BENCH_CHANNELS));
+}
+
+/** Applies the result of an autotune experiment to the motor PID.
+ *
+ * The new gains are applied bumplessly: the integral is preloaded so the
+ * first PID output equals the last relay output. If tuning failed, the
+ * previous gains are kept and resumed the same way.
+ *
+ * @param tuner The finished autotune instance.
+ * @param current_output The last output applied by the relay.
+ * @param setpoint The current setpoint.
+ * @param measurement The current measurement.
+ * @return None.
+ */
+static void finish_autotune(const pid_autotune_t *tuner,
+                            float current_output,
+                            float setpoint,
+                            float measurement)
+{
+    float kp;
+    float ki;
+    float kd;
+
+    if (pid_autotune_get_gains(tuner, PID_AUTOTUNE_RULE, &kp, &ki, &kd))
+    {
+        ESP_LOGI(TAG,
+                 "Autotune done: Ku=%.3f, Pu=%.3f s -> kp=%.4f, ki=%.4f, kd=%.5f",
+                 tuner->ultimate_gain,
+                 tuner->ultimate_period_s,
+                 kp,
+                 ki,
+                 kd);
+        pid_f32_set_gains(&s_motor_pid, kp, ki, kd);
+    }
+    else
+    {
+        ESP_LOGW(TAG, "Autotune failed, keeping the previous gains");
+    }
+
+    pid_f32_set_manual_output(&s_motor_pid, current_output, setpoint, measurement);
+}
+
+/** Logs the metrics of one simulation run.
+ *
+ * @param label Short name of the run.
+ * @param result The simulation result.
+ * @return None.
+ */
+static void log_sim_result(const char *label, const pid_sim_result_t *result)
+{
+    ESP_LOGI(TAG,
+             "sim %s: IAE=%.1f ISE=%.0f overshoot=%.1f %% settling=%.2f s unsettled=%" PRIu32
+             " cycles avg=%" PRIu32 " max=%" PRIu32,
+             label,
+             result->iae,
+             result->ise,
+             result->max_overshoot_percent,
+             result->max_settling_time_s,
+             result->unsettled_steps,
+             result->average_cycles,
+             result->max_cycles);
+}
+
+/** Runs both controllers and a small kp sweep through the batch simulation.
+ *
+ * The profile replays the setpoint and load sequence of pid_control_task()
+ * in simulated time, so each run takes milliseconds instead of 25 seconds.
+ *
+ * @return None.
+ */
+static void run_pid_sim_harness(void)
+{
+    static const pid_sim_step_t profile[] = {
+        { .time_s = 0.0f, .setpoint_rpm = 1800.0f, .load_percent = 15.0f },
+        { .time_s = 5.0f, .setpoint_rpm = 2400.0f, .load_percent = 15.0f },
+        { .time_s = 10.0f, .setpoint_rpm = 2400.0f, .load_percent = 45.0f },
+        { .time_s = 15.0f, .setpoint_rpm = 1200.0f, .load_percent = 45.0f },
+        { .time_s = 20.0f, .setpoint_rpm = 1200.0f, .load_percent = 10.0f },
+    };
+    static const float kp_sweep[] = { 0.04f, 0.08f, 0.12f, 0.16f };
+    pid_sim_config_t config = {
+        .controller = PID_SIM_CONTROLLER_F32,
+        .kp = 0.08f,
+        .ki = 0.35f,
+        .kd = 0.002f,
+        .sample_time_s = PID_SAMPLE_TIME_S,
+        .duration_s = PID_SIM_DURATION_S,
+        .settle_band_rpm = PID_SIM_SETTLE_BAND_RPM,
+        .profile = profile,
+        .profile_length = sizeof(profile) / sizeof(profile[0]),
+    };
+    pid_sim_result_t result;
+    char label[16];
+    int64_t start_us = esp_timer_get_time();
+
+    pid_sim_run(&config, &result);
+    log_sim_result("f32", &result);
+
+    config.controller = PID_SIM_CONTROLLER_Q16;
+    pid_sim_run(&config, &result);
+    log_sim_result("q16", &result);
+
+    config.controller = PID_SIM_CONTROLLER_F32;
+    for (size_t i = 0; i < sizeof(kp_sweep) / sizeof(kp_sweep[0]); i++)
+    {
+        config.kp = kp_sweep[i];
+        pid_sim_run(&config, &result);
+        snprintf(label, sizeof(label), "kp=%.2f", kp_sweep[i]);
+        log_sim_result(label, &result);
+    }
+
+    ESP_LOGI(TAG, "Simulation harness finished in %" PRId64 " ms", (esp_timer_get_time() - start_us) / 1000);
+}
+
 /** Periodic PID control task.
  *
  * This task controls a simulated motor plant and also updates a real PWM pin so
@@ -121,18 +445,63 @@ static void pid_control_task(void *arg)
     float setpoint_rpm = 1800.0f;
     float load_percent = 15.0f;
     float measurement_rpm;
-    float pwm_percent;
+    float pwm_percent = 0.0f;
+    float feed_forward_percent;
+    pid_autotune_t tuner;
+    bool autotune_active = false;
+    bool autotune_done = (PID_AUTOTUNE_ENABLE == 0);
 
     (void)arg;
 
     while (true)
     {
         measurement_rpm = simulated_motor_get_speed_rpm();
-        pwm_percent = pid_f32_compute(&s_motor_pid, setpoint_rpm, measurement_rpm);
+
+        if (!autotune_done && sample_count == PID_AUTOTUNE_START_SAMPLE)
+        {
+            // Relay around the current operating point, so the plant stays near the setpoint.
+            ESP_LOGI(TAG, "Autotune started around %.1f rpm, bias %.1f %%", setpoint_rpm, pwm_percent);
+            pid_autotune_init(&tuner,
+                              setpoint_rpm,
+                              pwm_percent,
+                              PID_AUTOTUNE_RELAY_PERCENT,
+                              PID_AUTOTUNE_HYSTERESIS_RPM,
+                              PID_AUTOTUNE_CYCLES,
+                              PID_SAMPLE_TIME_S,
+                              PID_AUTOTUNE_TIMEOUT_S);
+            autotune_active = true;
+            autotune_done = true;
+        }
+
+        if (autotune_active)
+        {
+            if (pid_autotune_update(&tuner, measurement_rpm, &pwm_percent) != PID_AUTOTUNE_RUNNING)
+            {
+                finish_autotune(&tuner, pwm_percent, setpoint_rpm, measurement_rpm);
+                autotune_active = false;
+            }
+        }
+        else
+        {
+            if (PID_GAIN_SCHEDULE_ENABLE)
+            {
+                pid_f32_schedule_gains(&s_motor_pid, setpoint_rpm);
+            }
+
+            feed_forward_percent = PID_FEED_FORWARD_ENABLE ? (setpoint_rpm * 100.0f) / MOTOR_MAX_SPEED_RPM : 0.0f;
+            pwm_percent = pid_f32_compute_ff(&s_motor_pid, setpoint_rpm, measurement_rpm, feed_forward_percent);
+        }
 
         pwm_set_duty_percent(pwm_percent);
         simulated_motor_update(pwm_percent, load_percent, PID_SAMPLE_TIME_S);
 
+        // The setpoint and load sequence pauses while the autotune experiment runs.
+        if (autotune_active)
+        {
+            vTaskDelayUntil(&last_wake_time, pdMS_TO_TICKS(PID_SAMPLE_TIME_MS));
+            continue;
+        }
+
         sample_count++;
 
         // Step changes create visible responses for tuning and data logging.
@@ -168,6 +537,44 @@ static void pid_control_task(void *arg)
     }
 }
 
+/** Runs the hardware-clocked PID loop and logs its statistics.
+ *
+ * The loop itself runs in the ADC interrupt; this task only reports.
+ *
+ * @return None. This function does not return.
+ */
+static void run_fast_loop(void)
+{
+    const pid_fast_loop_config_t config = {
+        .pwm_gpio = DEMO_PWM_GPIO,
+        .loop_freq_hz = PID_FAST_LOOP_HZ,
+        .adc_channel = PID_FAST_LOOP_ADC_CHANNEL,
+        .samples_per_loop = PID_FAST_LOOP_SAMPLES,
+        .kp = pid_q16_from_float(0.8f),
+        .ki = pid_q16_from_float(40.0f),
+        .kd = pid_q16_from_float(0.0f),
+    };
+    pid_fast_loop_stats_t stats;
+    uint32_t last_loops = 0;
+
+    pid_fast_loop_set_setpoint(PID_FAST_LOOP_SETPOINT);
+    ESP_ERROR_CHECK(pid_fast_loop_start(&config));
+
+    while (true)
+    {
+        vTaskDelay(pdMS_TO_TICKS(PID_FAST_LOOP_LOG_MS));
+        pid_fast_loop_get_stats(&stats);
+        ESP_LOGI(TAG,
+                 "fast loop: %" PRIu32 " updates/s meas=%.3f out=%.3f isr cycles last=%" PRIu32 " max=%" PRIu32,
+                 stats.loops - last_loops,
+                 stats.last_measurement,
+                 stats.last_output,
+                 stats.last_isr_cycles,
+                 stats.max_isr_cycles);
+        last_loops = stats.loops;
+    }
+}
+
 /** Application entry point.
  *
  * @return None.
@@ -185,6 +592,12 @@ void app_main(void)
     }
     ESP_ERROR_CHECK(ret);
 
+    // The fast loop owns the PWM pin through MCPWM instead of LEDC.
+    if (PID_FAST_LOOP_ENABLE)
+    {
+        run_fast_loop();
+    }
+
     // Initialize the LEDC PWM output for the motor command.
     ESP_ERROR_CHECK(pwm_init());
     
@@ -206,12 +619,28 @@ void app_main(void)
     pid_f32_set_derivative_filter(&s_motor_pid, 0.12f);
     // Set the slew rate limit for the PID controller.
     pid_f32_set_slew_rate_limit(&s_motor_pid, 250.0f);
+    // Soften the proportional kick on setpoint steps.
+    pid_f32_set_setpoint_weight(&s_motor_pid, PID_SETPOINT_WEIGHT);
+    pid_f32_set_gain_schedule(&s_motor_pid, s_gain_schedule, sizeof(s_gain_schedule) / sizeof(s_gain_schedule[0]));
     // Set the manual output for the PID controller.
     pid_f32_set_manual_output(&s_motor_pid, 0.0f, 1800.0f, 0.0f);
 
     // Run a small fixed-point PID smoke test to demonstrate the Q16.16 API.
     run_fixed_point_pid_demo();
 
+    // Compare the cost of the fixed-point and floating-point updates.
+    run_pid_benchmark();
+    run_pid_bank_benchmark();
+
+    // Score the controllers over the demo profile in simulated time.
+    if (PID_SIM_HARNESS_ENABLE)
+    {
+        run_pid_sim_harness();
+
+        // The harness leaves the shared motor model running; restart it from rest.
+        simulated_motor_init(0.0f);
+    }
+
     ESP_LOGI(TAG, "Production-grade PID demo started");
     ESP_LOGI(TAG, "PWM output is available on GPIO%d", DEMO_PWM_GPIO);
 
@@ -0,0 +1,360 @@
+#include "pid_fast_loop.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "driver/mcpwm_prelude.h"
+#include "esp_check.h"
+#include "esp_cpu.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "soc/soc_caps.h"
+
+#define PID_FAST_PWM_RESOLUTION_HZ   40000000U
+#define PID_FAST_ADC_MAX_RAW         ((1U << SOC_ADC_DIGI_MAX_BITWIDTH) - 1U)
+#define PID_FAST_ADC_POOL_FRAMES     4U
+
+static const char *TAG = "pid_fast_loop";
+
+static mcpwm_timer_handle_t s_timer;
+static mcpwm_oper_handle_t s_operator;
+static mcpwm_cmpr_handle_t s_comparator;
+static mcpwm_gen_handle_t s_generator;
+static adc_continuous_handle_t s_adc;
+static uint32_t s_period_ticks;
+static adc_channel_t s_adc_channel;
+
+static pid_q16_controller_t s_pid;
+static volatile pid_q16_t s_setpoint;
+
+typedef struct
+{
+    uint32_t loops;
+    uint32_t last_isr_cycles;
+    uint32_t max_isr_cycles;
+    pid_q16_t last_measurement;
+    pid_q16_t last_output;
+} isr_stats_t;
+
+static isr_stats_t s_stats;
+static portMUX_TYPE s_stats_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * ADC frame-done callback; runs one controller update per frame.
+ *
+ * Xtensa interrupts may not use the FPU, so the update uses the Q16.16
+ * controller only. The compare value is a shadow register that the MCPWM
+ * latches when the timer wraps to zero, so the new duty never lands in the
+ * middle of a PWM period.
+ *
+ * @param handle The ADC continuous handle.
+ * @param edata The finished frame.
+ * @param user_data Unused.
+ * @return False; no task is woken.
+ */
+static bool on_conv_done(adc_continuous_handle_t handle, const adc_continuous_evt_data_t *edata, void *user_data)
+{
+    const uint32_t start_cycles = esp_cpu_get_cycle_count();
+    const adc_digi_output_data_t *samples = (const adc_digi_output_data_t *)edata->conv_frame_buffer;
+    const uint32_t sample_count = edata->size / SOC_ADC_DIGI_RESULT_BYTES;
+    uint32_t raw_sum = 0;
+    uint32_t raw_count = 0;
+    pid_q16_t measurement;
+    pid_q16_t output;
+    uint32_t cycles;
+
+    (void)handle;
+    (void)user_data;
+
+    for (uint32_t i = 0; i < sample_count; i++)
+    {
+        if (samples[i].type2.channel == (uint32_t)s_adc_channel)
+        {
+            raw_sum += samples[i].type2.data;
+            raw_count++;
+        }
+    }
+
+    if (raw_count == 0U)
+    {
+        return false;
+    }
+
+    // Average, then scale counts to a Q16.16 fraction of full scale.
+    measurement = (pid_q16_t)(((uint64_t)raw_sum << PID_Q16_SHIFT) / ((uint64_t)raw_count * PID_FAST_ADC_MAX_RAW));
+    output = pid_q16_compute(&s_pid, s_setpoint, measurement);
+    mcpwm_comparator_set_compare_value(s_comparator, (uint32_t)(((uint64_t)output * s_period_ticks) >> PID_Q16_SHIFT));
+
+    cycles = esp_cpu_get_cycle_count() - start_cycles;
+
+    portENTER_CRITICAL_ISR(&s_stats_lock);
+    s_stats.loops++;
+    s_stats.last_isr_cycles = cycles;
+    if (cycles > s_stats.max_isr_cycles)
+    {
+        s_stats.max_isr_cycles = cycles;
+    }
+    s_stats.last_measurement = measurement;
+    s_stats.last_output = output;
+    portEXIT_CRITICAL_ISR(&s_stats_lock);
+
+    return false;
+}
+
+/**
+ * Releases every driver object created by pid_fast_loop_start().
+ *
+ * The ADC must already be stopped.
+ */
+static void release_resources(void)
+{
+    if (s_adc != NULL)
+    {
+        adc_continuous_deinit(s_adc);
+        s_adc = NULL;
+    }
+
+    if (s_timer != NULL)
+    {
+        mcpwm_timer_start_stop(s_timer, MCPWM_TIMER_STOP_EMPTY);
+        mcpwm_timer_disable(s_timer);
+    }
+
+    if (s_generator != NULL)
+    {
+        mcpwm_del_generator(s_generator);
+        s_generator = NULL;
+    }
+
+    if (s_comparator != NULL)
+    {
+        mcpwm_del_comparator(s_comparator);
+        s_comparator = NULL;
+    }
+
+    if (s_operator != NULL)
+    {
+        mcpwm_del_operator(s_operator);
+        s_operator = NULL;
+    }
+
+    if (s_timer != NULL)
+    {
+        mcpwm_del_timer(s_timer);
+        s_timer = NULL;
+    }
+}
+
+/**
+ * Sets up the MCPWM output: high at the period start, low at the compare.
+ *
+ * @param config The loop configuration.
+ * @return ESP_OK on success, otherwise an ESP-IDF error code.
+ */
+static esp_err_t pwm_init(const pid_fast_loop_config_t *config)
+{
+    s_period_ticks = PID_FAST_PWM_RESOLUTION_HZ / config->loop_freq_hz;
+
+    const mcpwm_timer_config_t timer_config = {
+        .group_id = 0,
+        .clk_src = MCPWM_TIMER_CLK_SRC_DEFAULT,
+        .resolution_hz = PID_FAST_PWM_RESOLUTION_HZ,
+        .count_mode = MCPWM_TIMER_COUNT_MODE_UP,
+        .period_ticks = s_period_ticks,
+    };
+    const mcpwm_operator_config_t operator_config = {
+        .group_id = 0,
+    };
+    const mcpwm_comparator_config_t comparator_config = {
+        .flags.update_cmp_on_tez = true,
+    };
+    const mcpwm_generator_config_t generator_config = {
+        .gen_gpio_num = config->pwm_gpio,
+    };
+
+    ESP_RETURN_ON_ERROR(mcpwm_new_timer(&timer_config, &s_timer), TAG, "Failed to create MCPWM timer");
+    ESP_RETURN_ON_ERROR(mcpwm_new_operator(&operator_config, &s_operator), TAG, "Failed to create MCPWM operator");
+    ESP_RETURN_ON_ERROR(mcpwm_operator_connect_timer(s_operator, s_timer), TAG, "Failed to connect MCPWM timer");
+    ESP_RETURN_ON_ERROR(mcpwm_new_comparator(s_operator, &comparator_config, &s_comparator),
+                        TAG,
+                        "Failed to create MCPWM comparator");
+    ESP_RETURN_ON_ERROR(mcpwm_comparator_set_compare_value(s_comparator, 0), TAG, "Failed to set compare value");
+    ESP_RETURN_ON_ERROR(mcpwm_new_generator(s_operator, &generator_config, &s_generator),
+                        TAG,
+                        "Failed to create MCPWM generator");
+    ESP_RETURN_ON_ERROR(mcpwm_generator_set_action_on_timer_event(s_generator,
+                                                                  MCPWM_GEN_TIMER_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP,
+                                                                                               MCPWM_TIMER_EVENT_EMPTY,
+                                                                                               MCPWM_GEN_ACTION_HIGH)),
+                        TAG,
+                        "Failed to set timer action");
+    ESP_RETURN_ON_ERROR(mcpwm_generator_set_action_on_compare_event(s_generator,
+                                                                    MCPWM_GEN_COMPARE_EVENT_ACTION(MCPWM_TIMER_DIRECTION_UP,
+                                                                                                   s_comparator,
+                                                                                                   MCPWM_GEN_ACTION_LOW)),
+                        TAG,
+                        "Failed to set compare action");
+    ESP_RETURN_ON_ERROR(mcpwm_timer_enable(s_timer), TAG, "Failed to enable MCPWM timer");
+
+    return mcpwm_timer_start_stop(s_timer, MCPWM_TIMER_START_NO_STOP);
+}
+
+/**
+ * Sets up ADC continuous mode with one loop's samples per DMA frame.
+ *
+ * @param config The loop configuration.
+ * @return ESP_OK on success, otherwise an ESP-IDF error code.
+ */
+static esp_err_t adc_init(const pid_fast_loop_config_t *config)
+{
+    const uint32_t frame_size = config->samples_per_loop * SOC_ADC_DIGI_RESULT_BYTES;
+
+    // Nothing reads the pool; frames are consumed in the callback, so let the driver drop old ones.
+    const adc_continuous_handle_cfg_t handle_config = {
+        .max_store_buf_size = frame_size * PID_FAST_ADC_POOL_FRAMES,
+        .conv_frame_size = frame_size,
+        .flags.flush_pool = true,
+    };
+    adc_digi_pattern_config_t pattern = {
+        .atten = ADC_ATTEN_DB_12,
+        .channel = config->adc_channel,
+        .unit = ADC_UNIT_1,
+        .bit_width = SOC_ADC_DIGI_MAX_BITWIDTH,
+    };
+    const adc_continuous_config_t adc_config = {
+        .pattern_num = 1,
+        .adc_pattern = &pattern,
+        .sample_freq_hz = config->loop_freq_hz * config->samples_per_loop,
+        .conv_mode = ADC_CONV_SINGLE_UNIT_1,
+        .format = ADC_DIGI_OUTPUT_FORMAT_TYPE2,
+    };
+    const adc_continuous_evt_cbs_t callbacks = {
+        .on_conv_done = on_conv_done,
+    };
+
+    ESP_RETURN_ON_ERROR(adc_continuous_new_handle(&handle_config, &s_adc), TAG, "Failed to create ADC handle");
+    ESP_RETURN_ON_ERROR(adc_continuous_config(s_adc, &adc_config), TAG, "Failed to configure ADC");
+    ESP_RETURN_ON_ERROR(adc_continuous_register_event_callbacks(s_adc, &callbacks, NULL),
+                        TAG,
+                        "Failed to register ADC callback");
+
+    return adc_continuous_start(s_adc);
+}
+
+/**
+ * Starts the hardware-clocked PID loop.
+ *
+ * @param config The loop configuration.
+ * @return ESP_OK on success, otherwise an ESP-IDF error code.
+ */
+esp_err_t pid_fast_loop_start(const pid_fast_loop_config_t *config)
+{
+    esp_err_t ret;
+
+    ESP_RETURN_ON_FALSE(config != NULL, ESP_ERR_INVALID_ARG, TAG, "Configuration is NULL");
+    ESP_RETURN_ON_FALSE(config->loop_freq_hz > 0U && config->samples_per_loop > 0U,
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "Loop rate and samples per loop must be greater than zero");
+    ESP_RETURN_ON_FALSE(config->loop_freq_hz * config->samples_per_loop <= SOC_ADC_SAMPLE_FREQ_THRES_HIGH,
+                        ESP_ERR_INVALID_ARG,
+                        TAG,
+                        "ADC sample rate is too high");
+    ESP_RETURN_ON_FALSE(s_timer == NULL, ESP_ERR_INVALID_STATE, TAG, "Loop already running");
+
+    s_adc_channel = config->adc_channel;
+    memset(&s_stats, 0, sizeof(s_stats));
+    pid_q16_init(&s_pid,
+                 config->kp,
+                 config->ki,
+                 config->kd,
+                 (pid_q16_t)(PID_Q16_ONE / config->loop_freq_hz),
+                 0,
+                 PID_Q16_ONE);
+
+    // The PWM must run before the first ADC frame can update its compare value.
+    ret = pwm_init(config);
+    if (ret == ESP_OK)
+    {
+        ret = adc_init(config);
+    }
+
+    if (ret != ESP_OK)
+    {
+        release_resources();
+        return ret;
+    }
+
+    ESP_LOGI(TAG,
+             "Fast loop at %" PRIu32 " Hz, %" PRIu32 " ADC samples per loop, PWM period %" PRIu32 " ticks",
+             config->loop_freq_hz,
+             config->samples_per_loop,
+             s_period_ticks);
+
+    return ESP_OK;
+}
+
+/**
+ * Stops the hardware-clocked PID loop.
+ *
+ * @return ESP_OK on success, otherwise an ESP-IDF error code.
+ */
+esp_err_t pid_fast_loop_stop(void)
+{
+    ESP_RETURN_ON_FALSE(s_timer != NULL, ESP_ERR_INVALID_STATE, TAG, "Loop is not running");
+
+    // Stop the controller first, so nothing raises the duty again.
+    adc_continuous_stop(s_adc);
+    mcpwm_comparator_set_compare_value(s_comparator, 0);
+    release_resources();
+
+    return ESP_OK;
+}
+
+/**
+ * Sets the loop setpoint.
+ *
+ * @param setpoint The setpoint as a fraction of full scale.
+ */
+void pid_fast_loop_set_setpoint(float setpoint)
+{
+    if (setpoint < 0.0f)
+    {
+        setpoint = 0.0f;
+    }
+    else if (setpoint > 1.0f)
+    {
+        setpoint = 1.0f;
+    }
+
+    // A 32-bit store is atomic, so the interrupt sees either the old or the new value.
+    s_setpoint = pid_q16_from_float(setpoint);
+}
+
+/**
+ * Copies the loop statistics.
+ *
+ * @param stats Receives the statistics.
+ */
+void pid_fast_loop_get_stats(pid_fast_loop_stats_t *stats)
+{
+    isr_stats_t snapshot;
+
+    if (stats == NULL)
+    {
+        return;
+    }
+
+    portENTER_CRITICAL(&s_stats_lock);
+    snapshot = s_stats;
+    s_stats.max_isr_cycles = 0;
+    portEXIT_CRITICAL(&s_stats_lock);
+
+    // The interrupt keeps Q16.16 values to stay off the FPU.
+    stats->loops = snapshot.loops;
+    stats->last_isr_cycles = snapshot.last_isr_cycles;
+    stats->max_isr_cycles = snapshot.max_isr_cycles;
+    stats->last_measurement = pid_q16_to_float(snapshot.last_measurement);
+    stats->last_output = pid_q16_to_float(snapshot.last_output);
+}
@@ -0,0 +1,93 @@
+#ifndef PID_FAST_LOOP_H
+#define PID_FAST_LOOP_H
+
+#include <stdint.h>
+
+#include "esp_adc/adc_continuous.h"
+#include "esp_err.h"
+
+#include "pid_q16.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct
+{
+    int pwm_gpio;
+    uint32_t loop_freq_hz;
+    adc_channel_t adc_channel;
+    uint32_t samples_per_loop;
+    pid_q16_t kp;
+    pid_q16_t ki;
+    pid_q16_t kd;
+} pid_fast_loop_config_t;
+
+typedef struct
+{
+    uint32_t loops;
+    uint32_t last_isr_cycles;
+    uint32_t max_isr_cycles;
+    float last_measurement;
+    float last_output;
+} pid_fast_loop_stats_t;
+
+/**
+ * Starts a PID loop clocked by the ADC and PWM hardware instead of the tick.
+ *
+ * An MCPWM timer generates the actuator PWM at loop_freq_hz. The ADC runs in
+ * continuous DMA mode at loop_freq_hz * samples_per_loop, so every DMA frame
+ * holds one loop's samples. The frame-done interrupt averages them, runs the
+ * Q16.16 controller and writes the MCPWM compare value, which the hardware
+ * latches at the next PWM period start.
+ *
+ * Measurement, setpoint and output are fractions of full scale: 0.0 to 1.0
+ * of the ADC range and of the PWM period. Gains are in those units.
+ *
+ * Args:
+ *     config: Pointer to the loop configuration.
+ *
+ * Returns:
+ *     ESP_OK on success.
+ *     ESP_ERR_INVALID_ARG if the configuration is invalid.
+ *     ESP_ERR_INVALID_STATE if the loop is already running.
+ *     Another ESP-IDF error code if the MCPWM or ADC driver cannot be set up.
+ */
+esp_err_t pid_fast_loop_start(const pid_fast_loop_config_t *config);
+
+/**
+ * Stops the loop, drives the PWM output low and releases the drivers.
+ *
+ * Returns:
+ *     ESP_OK on success.
+ *     ESP_ERR_INVALID_STATE if the loop is not running.
+ */
+esp_err_t pid_fast_loop_stop(void);
+
+/**
+ * Sets the loop setpoint.
+ *
+ * Args:
+ *     setpoint: Target as a fraction of the ADC full scale, 0.0 to 1.0.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_fast_loop_set_setpoint(float setpoint);
+
+/**
+ * Copies the loop statistics and resets the maximum ISR time.
+ *
+ * Args:
+ *     stats: Receives the statistics.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_fast_loop_get_stats(pid_fast_loop_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,185 @@
+#include "pid_sim.h"
+
+#include <math.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "esp_cpu.h"
+
+#include "pid_f32.h"
+#include "pid_q16.h"
+#include "simulated_motor.h"
+
+typedef struct
+{
+    uint32_t start_sample;
+    uint32_t last_outside_sample;
+    float from_rpm;
+    float to_rpm;
+    float peak_overshoot_rpm;
+    bool active;
+} step_tracker_t;
+
+/**
+ * Records the overshoot and settling time of the current setpoint step.
+ *
+ * @param tracker The step being closed.
+ * @param end_sample The sample where the step ends.
+ * @param sample_time_s The sample time in seconds.
+ * @param result The result to update.
+ */
+static void finish_step(const step_tracker_t *tracker,
+                        uint32_t end_sample,
+                        float sample_time_s,
+                        pid_sim_result_t *result)
+{
+    float step_size;
+    float overshoot_percent;
+    float settling_time_s;
+
+    if (!tracker->active)
+    {
+        return;
+    }
+
+    step_size = fabsf(tracker->to_rpm - tracker->from_rpm);
+    if (step_size > 0.0f)
+    {
+        overshoot_percent = (tracker->peak_overshoot_rpm * 100.0f) / step_size;
+        if (overshoot_percent > result->max_overshoot_percent)
+        {
+            result->max_overshoot_percent = overshoot_percent;
+        }
+    }
+
+    // Still outside the band on the last sample of the step means it never settled.
+    if (tracker->last_outside_sample + 1U >= end_sample)
+    {
+        result->unsettled_steps++;
+        return;
+    }
+
+    settling_time_s = (float)(tracker->last_outside_sample + 1U - tracker->start_sample) * sample_time_s;
+    if (settling_time_s > result->max_settling_time_s)
+    {
+        result->max_settling_time_s = settling_time_s;
+    }
+}
+
+/**
+ * Runs a closed-loop simulation of the motor.
+ *
+ * @param config The simulation configuration.
+ * @param result Receives the performance metrics.
+ */
+void pid_sim_run(const pid_sim_config_t *config, pid_sim_result_t *result)
+{
+    pid_f32_t pid_f32;
+    pid_q16_controller_t pid_q16;
+    step_tracker_t step = { 0 };
+    uint64_t total_cycles = 0;
+    uint32_t sample_count;
+    size_t next_profile = 0;
+    float setpoint_rpm = 0.0f;
+    float load_percent = 0.0f;
+
+    if (config == NULL || result == NULL || config->sample_time_s <= 0.0f || config->profile == NULL ||
+        config->profile_length == 0U)
+    {
+        return;
+    }
+
+    memset(result, 0, sizeof(*result));
+    sample_count = (uint32_t)(config->duration_s / config->sample_time_s);
+
+    // Same limits and filtering as the real-time demo controller.
+    pid_f32_init(&pid_f32, config->kp, config->ki, config->kd, config->sample_time_s, 0.0f, 100.0f);
+    pid_f32_set_integral_limits(&pid_f32, -200.0f, 200.0f);
+    pid_f32_set_derivative_filter(&pid_f32, 0.12f);
+    pid_f32_set_slew_rate_limit(&pid_f32, 250.0f);
+    pid_q16_init(&pid_q16,
+                 pid_q16_from_float(config->kp),
+                 pid_q16_from_float(config->ki),
+                 pid_q16_from_float(config->kd),
+                 pid_q16_from_float(config->sample_time_s),
+                 pid_q16_from_float(0.0f),
+                 pid_q16_from_float(100.0f));
+    simulated_motor_init(0.0f);
+
+    for (uint32_t sample = 0; sample < sample_count; sample++)
+    {
+        const float time_s = (float)sample * config->sample_time_s;
+        float measurement_rpm;
+        float output_percent;
+        float error_rpm;
+        float overshoot_rpm;
+        uint32_t start_cycles;
+        uint32_t cycles;
+
+        while (next_profile < config->profile_length && config->profile[next_profile].time_s <= time_s)
+        {
+            const pid_sim_step_t *entry = &config->profile[next_profile];
+
+            if (entry->setpoint_rpm != setpoint_rpm)
+            {
+                finish_step(&step, sample, config->sample_time_s, result);
+                step = (step_tracker_t){
+                    .start_sample = sample,
+                    .last_outside_sample = sample,
+                    .from_rpm = simulated_motor_get_speed_rpm(),
+                    .to_rpm = entry->setpoint_rpm,
+                    .peak_overshoot_rpm = 0.0f,
+                    .active = true,
+                };
+            }
+            setpoint_rpm = entry->setpoint_rpm;
+            load_percent = entry->load_percent;
+            next_profile++;
+        }
+
+        measurement_rpm = simulated_motor_get_speed_rpm();
+
+        start_cycles = esp_cpu_get_cycle_count();
+        if (config->controller == PID_SIM_CONTROLLER_Q16)
+        {
+            output_percent = pid_q16_to_float(pid_q16_compute(&pid_q16,
+                                                              pid_q16_from_float(setpoint_rpm),
+                                                              pid_q16_from_float(measurement_rpm)));
+        }
+        else
+        {
+            output_percent = pid_f32_compute(&pid_f32, setpoint_rpm, measurement_rpm);
+        }
+        cycles = esp_cpu_get_cycle_count() - start_cycles;
+
+        simulated_motor_update(output_percent, load_percent, config->sample_time_s);
+
+        total_cycles += cycles;
+        if (cycles > result->max_cycles)
+        {
+            result->max_cycles = cycles;
+        }
+
+        error_rpm = setpoint_rpm - measurement_rpm;
+        result->iae += fabsf(error_rpm) * config->sample_time_s;
+        result->ise += error_rpm * error_rpm * config->sample_time_s;
+
+        if (step.active)
+        {
+            overshoot_rpm = (step.to_rpm >= step.from_rpm) ? -error_rpm : error_rpm;
+            if (overshoot_rpm > step.peak_overshoot_rpm)
+            {
+                step.peak_overshoot_rpm = overshoot_rpm;
+            }
+            if (fabsf(error_rpm) > config->settle_band_rpm)
+            {
+                step.last_outside_sample = sample;
+            }
+        }
+    }
+
+    finish_step(&step, sample_count, config->sample_time_s, result);
+
+    result->samples = sample_count;
+    result->average_cycles = (sample_count > 0U) ? (uint32_t)(total_cycles / sample_count) : 0U;
+}
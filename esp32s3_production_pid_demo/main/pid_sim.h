@@ -0,0 +1,75 @@
+#ifndef PID_SIM_H
+#define PID_SIM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    PID_SIM_CONTROLLER_F32 = 0,
+    PID_SIM_CONTROLLER_Q16,
+} pid_sim_controller_t;
+
+typedef struct
+{
+    float time_s;
+    float setpoint_rpm;
+    float load_percent;
+} pid_sim_step_t;
+
+typedef struct
+{
+    pid_sim_controller_t controller;
+    float kp;
+    float ki;
+    float kd;
+    float sample_time_s;
+    float duration_s;
+    float settle_band_rpm;
+    const pid_sim_step_t *profile;
+    size_t profile_length;
+} pid_sim_config_t;
+
+typedef struct
+{
+    float iae;
+    float ise;
+    float max_overshoot_percent;
+    float max_settling_time_s;
+    uint32_t unsettled_steps;
+    uint32_t samples;
+    uint32_t average_cycles;
+    uint32_t max_cycles;
+} pid_sim_result_t;
+
+/**
+ * Runs a closed-loop simulation of the motor as fast as the CPU allows.
+ *
+ * The simulated motor and a fresh controller are stepped once per sample
+ * time, with no delays, while the profile sets the setpoint and load. The
+ * simulated motor state is reinitialized, so this must not run while the
+ * real-time control task uses the motor.
+ *
+ * Overshoot is measured after each setpoint change, as a percentage of the
+ * step size. Settling time is the time from the change until the speed stays
+ * inside the settle band; a step that never settles before the next profile
+ * entry is counted as unsettled. Cycles cover only the controller update.
+ *
+ * Args:
+ *     config: Simulation configuration; profile entries must be sorted by time.
+ *     result: Receives the performance metrics.
+ *
+ * Returns:
+ *     None.
+ */
+void pid_sim_run(const pid_sim_config_t *config, pid_sim_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,94 @@
+/**
+ * @file lora_payload.c
+ * @brief Packed binary frame encoder for the RYLR896 text interface.
+ */
+
+#include "lora_payload.h"
+
+#include <stdbool.h>
+
+/* ---- Module-private constants ----------------------------------------- */
+
+/** Frame header: version, sequence number, reading count. */
+#define HEADER_BYTES   4U
+
+/** Packed size of one reading: age_s and value. */
+#define READING_BYTES  4U
+
+/** Largest binary frame. */
+#define FRAME_MAX_BYTES  (HEADER_BYTES + READING_BYTES * LORA_PAYLOAD_MAX_READINGS)
+
+static const char BASE64[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/* ---- Private helpers -------------------------------------------------- */
+
+static void put_u16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)(v & 0xFFU);
+    p[1] = (uint8_t)(v >> 8);
+}
+
+/**
+ * @brief Standard base64 with '=' padding.
+ *
+ * @return Text length; @p out must hold 4 * ceil(len / 3) + 1 bytes.
+ */
+static size_t base64_encode(const uint8_t *in, size_t len, char *out)
+{
+    size_t o = 0;
+    for (size_t i = 0; i < len; i += 3U) {
+        uint32_t b = (uint32_t)in[i] << 16;
+        bool has1 = (i + 1U) < len;
+        bool has2 = (i + 2U) < len;
+        if (has1) {
+            b |= (uint32_t)in[i + 1U] << 8;
+        }
+        if (has2) {
+            b |= in[i + 2U];
+        }
+        out[o++] = BASE64[(b >> 18) & 0x3FU];
+        out[o++] = BASE64[(b >> 12) & 0x3FU];
+        out[o++] = has1 ? BASE64[(b >> 6) & 0x3FU] : '=';
+        out[o++] = has2 ? BASE64[b & 0x3FU] : '=';
+    }
+    out[o] = '\0';
+    return o;
+}
+
+/* ---- Public API implementation ---------------------------------------- */
+
+size_t lora_payload_encoded_len(size_t count)
+{
+    size_t bytes = HEADER_BYTES + READING_BYTES * count;
+    return 4U * ((bytes + 2U) / 3U);
+}
+
+size_t lora_payload_encode(uint16_t seq,
+                           const lora_reading_t *readings,
+                           size_t count,
+                           uint32_t now_s,
+                           char *out,
+                           size_t out_size)
+{
+    if (readings == NULL || out == NULL ||
+        count == 0U || count > LORA_PAYLOAD_MAX_READINGS ||
+        out_size < lora_payload_encoded_len(count) + 1U) {
+        return 0;
+    }
+
+    uint8_t frame[FRAME_MAX_BYTES];
+    frame[0] = LORA_PAYLOAD_VERSION;
+    put_u16(&frame[1], seq);
+    frame[3] = (uint8_t)count;
+
+    uint8_t *p = &frame[HEADER_BYTES];
+    for (size_t i = 0; i < count; i++) {
+        uint32_t age = (now_s > readings[i].time_s) ? now_s - readings[i].time_s : 0U;
+        put_u16(p, (uint16_t)((age > 0xFFFFU) ? 0xFFFFU : age));
+        put_u16(p + 2, (uint16_t)readings[i].value);
+        p += READING_BYTES;
+    }
+
+    return base64_encode(frame, (size_t)(p - frame), out);
+}
@@ -0,0 +1,75 @@
+/**
+ * @file lora_payload.h
+ * @brief Packed binary frames for several readings, encoded for AT+SEND.
+ *
+ * An ASCII payload such as "SENSOR:PKT#123" spends most of its airtime on
+ * text.  A frame instead packs readings as little-endian integers and
+ * base64-encodes the result, since the AT interface carries text only.
+ *
+ * Frame layout before base64 (little-endian):
+ *
+ *   Offset | Size | Field
+ *   -------|------|-----------------------------------------------
+ *   0      | 1    | Version (LORA_PAYLOAD_VERSION)
+ *   1      | 2    | Frame sequence number
+ *   3      | 1    | Reading count N
+ *   4      | 4*N  | N x { uint16 age_s, int16 value }, oldest first
+ *
+ * age_s is the reading's age in seconds when the frame was built,
+ * saturated at 65535.  The receiver subtracts it from its arrival time.
+ */
+
+#ifndef LORA_PAYLOAD_H
+#define LORA_PAYLOAD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Frame format version in the first byte. */
+#define LORA_PAYLOAD_VERSION       1U
+
+/** Most readings in one frame; keeps the text within 240 bytes. */
+#define LORA_PAYLOAD_MAX_READINGS  32U
+
+/** One queued reading. */
+typedef struct {
+    uint32_t time_s;    /**< RTC time in seconds when it was taken. */
+    int16_t value;      /**< Sensor value in application units. */
+} lora_reading_t;
+
+/**
+ * @brief Length of the base64 text for a frame of @p count readings.
+ *
+ * @param count  Number of readings.
+ * @return Text length in bytes, excluding the NUL terminator.
+ */
+size_t lora_payload_encoded_len(size_t count);
+
+/**
+ * @brief Build and base64-encode one frame.
+ *
+ * @param seq       Frame sequence number.
+ * @param readings  Readings, oldest first.
+ * @param count     Number of readings (1 to LORA_PAYLOAD_MAX_READINGS).
+ * @param now_s     Current RTC time in seconds, for the ages.
+ * @param out       Destination for the NUL-terminated text.
+ * @param out_size  Size of @p out.
+ *
+ * @return Text length, or 0 if @p count is out of range or @p out is too small.
+ */
+size_t lora_payload_encode(uint16_t seq,
+                           const lora_reading_t *readings,
+                           size_t count,
+                           uint32_t now_s,
+                           char *out,
+                           size_t out_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LORA_PAYLOAD_H */
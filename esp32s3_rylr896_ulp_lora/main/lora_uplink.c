@@ -0,0 +1,190 @@
+/**
+ * @file lora_uplink.c
+ * @brief Reading queue and duty-cycle-aware uplink scheduler.
+ */
+
+#include "lora_uplink.h"
+
+#include <inttypes.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "esp_attr.h"
+#include "esp_log.h"
+
+#include "lora_payload.h"
+#include "rylr896.h"
+
+/* ---- Module-private constants ----------------------------------------- */
+
+static const char *TAG = "UPLINK";
+
+/** Changes whenever the RTC layout below changes. */
+#define UPLINK_MAGIC  0x4C555031UL
+
+/**
+ * Bytes the module adds to each packet on air (addressing and length).
+ * Not documented by REYAX; assumed, so the estimate errs on the long side.
+ */
+#define LINK_OVERHEAD_BYTES  6U
+
+/** Budget cap: one hour's allowance. */
+#define BUDGET_CAP_MS  (3600U * LORA_DUTY_CYCLE_PERMILLE)
+
+/** Bandwidth in Hz for the AT+PARAMETER bandwidth code. */
+#define BANDWIDTH_HZ   (RYLR896_BANDWIDTH_CODE == 9 ? 500000U : \
+                        RYLR896_BANDWIDTH_CODE == 8 ? 250000U : 125000U)
+
+/* ---- Module-private state (RTC slow memory, survives deep sleep) ------- */
+
+static RTC_DATA_ATTR uint32_t s_magic;
+static RTC_DATA_ATTR lora_reading_t s_queue[LORA_QUEUE_CAPACITY];
+static RTC_DATA_ATTR uint32_t s_head;       /* Index of the oldest reading. */
+static RTC_DATA_ATTR uint32_t s_count;
+static RTC_DATA_ATTR uint32_t s_dropped;    /* Readings lost to a full queue. */
+static RTC_DATA_ATTR uint16_t s_frame_seq;
+static RTC_DATA_ATTR uint32_t s_budget_ms;  /* Airtime available now. */
+static RTC_DATA_ATTR uint32_t s_budget_time_s;
+
+/* ---- Private helpers -------------------------------------------------- */
+
+/**
+ * @brief RTC time in seconds; keeps counting through deep sleep.
+ */
+static uint32_t now_s(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (uint32_t)tv.tv_sec;
+}
+
+/**
+ * @brief Add the airtime earned since the last refill.
+ */
+static void refill_budget(uint32_t now)
+{
+    uint32_t elapsed = now - s_budget_time_s;
+    s_budget_time_s = now;
+
+    /* LORA_DUTY_CYCLE_PERMILLE ms of airtime per elapsed second. */
+    uint64_t budget = (uint64_t)s_budget_ms + (uint64_t)elapsed * LORA_DUTY_CYCLE_PERMILLE;
+    s_budget_ms = (budget > BUDGET_CAP_MS) ? BUDGET_CAP_MS : (uint32_t)budget;
+}
+
+/* ---- Public API implementation ---------------------------------------- */
+
+void lora_uplink_init(void)
+{
+    if (s_magic == UPLINK_MAGIC &&
+        s_head < LORA_QUEUE_CAPACITY &&
+        s_count <= LORA_QUEUE_CAPACITY) {
+        return;
+    }
+
+    memset(s_queue, 0, sizeof(s_queue));
+    s_head = 0;
+    s_count = 0;
+    s_dropped = 0;
+    s_frame_seq = 0;
+    s_budget_ms = BUDGET_CAP_MS;
+    s_budget_time_s = now_s();
+    s_magic = UPLINK_MAGIC;
+}
+
+void lora_uplink_add(int16_t value)
+{
+    if (s_count == LORA_QUEUE_CAPACITY) {
+        /* Keep the newest readings. */
+        s_head = (s_head + 1U) % LORA_QUEUE_CAPACITY;
+        s_count--;
+        s_dropped++;
+    }
+
+    lora_reading_t *r = &s_queue[(s_head + s_count) % LORA_QUEUE_CAPACITY];
+    r->time_s = now_s();
+    r->value = value;
+    s_count++;
+}
+
+size_t lora_uplink_pending(void)
+{
+    return s_count;
+}
+
+uint32_t lora_uplink_airtime_ms(size_t payload_len)
+{
+    const uint32_t sf = RYLR896_SPREADING_FACTOR;
+    const uint32_t symbol_us = (1UL << sf) * 1000000UL / BANDWIDTH_HZ;
+    /* Low data rate optimisation is on for symbols of 16 ms or longer. */
+    const uint32_t de = (symbol_us >= 16000U) ? 1U : 0U;
+
+    /* Explicit header, CRC on. */
+    int32_t bits = 8 * (int32_t)(payload_len + LINK_OVERHEAD_BYTES)
+                   - 4 * (int32_t)sf + 28 + 16;
+    int32_t per_block = 4 * (int32_t)(sf - 2U * de);
+    uint32_t blocks = (bits > 0) ? (uint32_t)((bits + per_block - 1) / per_block) : 0U;
+    uint32_t payload_symbols = 8U + blocks * (RYLR896_CODING_RATE + 4U);
+
+    /* Preamble: n + 4.25 symbols. */
+    uint64_t total_us = (uint64_t)(RYLR896_PREAMBLE * 4U + 17U) * symbol_us / 4U
+                        + (uint64_t)payload_symbols * symbol_us;
+    return (uint32_t)((total_us + 999U) / 1000U);
+}
+
+bool lora_uplink_service(lora_uplink_send_fn send)
+{
+    if (s_count == 0U || send == NULL) {
+        return false;
+    }
+
+    uint32_t now = now_s();
+    refill_budget(now);
+
+    uint32_t oldest_age = now - s_queue[s_head].time_s;
+    if (s_count < LORA_READINGS_PER_FRAME && oldest_age < LORA_MAX_LATENCY_S) {
+        return false;
+    }
+
+    size_t n = (s_count < LORA_PAYLOAD_MAX_READINGS) ? s_count : LORA_PAYLOAD_MAX_READINGS;
+    lora_reading_t readings[LORA_PAYLOAD_MAX_READINGS];
+    for (size_t i = 0; i < n; i++) {
+        readings[i] = s_queue[(s_head + i) % LORA_QUEUE_CAPACITY];
+    }
+
+    char text[4U * ((4U + 4U * LORA_PAYLOAD_MAX_READINGS + 2U) / 3U) + 1U];
+    size_t len = lora_payload_encode(s_frame_seq, readings, n, now, text, sizeof(text));
+    if (len == 0U) {
+        ESP_LOGE(TAG, "Frame encoding failed (%u readings)", (unsigned int)n);
+        return false;
+    }
+
+    uint32_t airtime = lora_uplink_airtime_ms(len);
+    if (LORA_DUTY_CYCLE_PERMILLE > 0U && airtime > s_budget_ms) {
+        uint32_t wait_s = (airtime - s_budget_ms + LORA_DUTY_CYCLE_PERMILLE - 1U)
+                          / LORA_DUTY_CYCLE_PERMILLE;
+        ESP_LOGW(TAG, "Duty cycle: %" PRIu32 " ms needed, %" PRIu32 " ms left - "
+                 "holding %u readings for ~%" PRIu32 " s",
+                 airtime, s_budget_ms, (unsigned int)s_count, wait_s);
+        return false;
+    }
+
+    /* Charged before sending: a lost reply does not mean nothing went out. */
+    s_budget_ms = (airtime > s_budget_ms) ? 0U : s_budget_ms - airtime;
+
+    if (!send(text)) {
+        ESP_LOGE(TAG, "Frame %u not sent - %u readings kept",
+                 (unsigned int)s_frame_seq, (unsigned int)s_count);
+        return false;
+    }
+
+    ESP_LOGI(TAG, "Frame %u: %u readings, %u bytes, ~%" PRIu32 " ms airtime, "
+             "%" PRIu32 " ms budget left, %" PRIu32 " dropped",
+             (unsigned int)s_frame_seq, (unsigned int)n, (unsigned int)len,
+             airtime, s_budget_ms, s_dropped);
+
+    s_head = (s_head + (uint32_t)n) % LORA_QUEUE_CAPACITY;
+    s_count -= (uint32_t)n;
+    s_dropped = 0;
+    s_frame_seq++;
+    return true;
+}
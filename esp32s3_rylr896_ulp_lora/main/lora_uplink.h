@@ -0,0 +1,96 @@
+/**
+ * @file lora_uplink.h
+ * @brief Reading queue and duty-cycle-aware uplink scheduler.
+ *
+ * Readings are queued in RTC slow memory, so they survive deep sleep, and
+ * go out several per frame (see lora_payload.h).  Each frame's time on air
+ * is estimated from the radio settings in rylr896.h and charged against a
+ * duty-cycle budget.  A frame is sent only when the budget covers it;
+ * otherwise the readings wait and the next frame carries more of them.
+ *
+ * The budget is a token bucket: airtime accrues at
+ * LORA_DUTY_CYCLE_PERMILLE per second, up to one hour's allowance.  This
+ * matches the 1 % limit of the EU868 sub-bands when set to 10.
+ *
+ * The queue is not thread-safe; call from one task.
+ */
+
+#ifndef LORA_UPLINK_H
+#define LORA_UPLINK_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ---- Configuration ----------------------------------------------------- */
+
+/** Allowed share of airtime in 1/1000 (10 = 1 %, EU868).  0 = no limit. */
+#define LORA_DUTY_CYCLE_PERMILLE   10U
+
+/** Readings that make a frame worth sending. */
+#define LORA_READINGS_PER_FRAME    8U
+
+/** Oldest a queued reading may get before a shorter frame is sent. */
+#define LORA_MAX_LATENCY_S         900U
+
+/** Readings held while waiting; the oldest is dropped when full. */
+#define LORA_QUEUE_CAPACITY        64U
+
+/* ---- Public API -------------------------------------------------------- */
+
+/**
+ * @brief Sends one payload; returns true if the module accepted it.
+ */
+typedef bool (*lora_uplink_send_fn)(const char *payload);
+
+/**
+ * @brief Validate the RTC state after a wake.
+ *
+ * Clears the queue and refills the budget after a power cycle or when the
+ * RTC layout changed.
+ */
+void lora_uplink_init(void);
+
+/**
+ * @brief Queue a reading stamped with the current RTC time.
+ *
+ * @param value  Sensor value in application units.
+ */
+void lora_uplink_add(int16_t value);
+
+/**
+ * @brief Send a frame if one is due and the budget allows it.
+ *
+ * A frame is due when LORA_READINGS_PER_FRAME readings are queued or the
+ * oldest is LORA_MAX_LATENCY_S old.  It carries as many queued readings as
+ * fit.  The airtime is charged whenever a send is attempted, since the
+ * module may have transmitted even if the reply was lost.
+ *
+ * @param send  Function that transmits the payload.
+ * @return true if a frame was sent and its readings removed.
+ */
+bool lora_uplink_service(lora_uplink_send_fn send);
+
+/**
+ * @brief Estimated time on air of a payload, in milliseconds.
+ *
+ * Uses the Semtech LoRa airtime formula with the settings in rylr896.h.
+ *
+ * @param payload_len  AT+SEND payload length in bytes.
+ */
+uint32_t lora_uplink_airtime_ms(size_t payload_len);
+
+/**
+ * @brief Number of queued readings.
+ */
+size_t lora_uplink_pending(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LORA_UPLINK_H */
@@ -21,6 +21,15 @@
  *   3. Clears the shared flag variables.
  *   4. Re-enters deep sleep.
  *
+ * With LORA_TX_ON_ULP set, the cold boot also configures the RYLR896 and
+ * the ULP sends the routine AT+SEND itself.  The main CPU then wakes only
+ * when the module does not acknowledge a packet (ulp_tx_error != 0), and
+ * retries that packet through its own UART driver.
+ *
+ * With LORA_TX_ON_ULP clear, each ULP wake queues a reading in RTC memory
+ * and lora_uplink sends them in packed frames, several readings per
+ * packet, only as often as the regional duty cycle allows.
+ *
  * Power budget (typical, hardware-dependent)
  * ------------------------------------------
  *   Deep sleep (main CPU off, ULP running) : ~25 uA
@@ -37,6 +46,7 @@
 #include "esp_log.h"
 #include "esp_err.h"
 #include "esp_system.h"
+#include "esp_attr.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 
@@ -60,6 +70,9 @@
 /* LoRa module driver */
 #include "rylr896.h"
 
+/* Packed multi-reading frames (LORA_TX_ON_ULP = 0) */
+#include "lora_uplink.h"
+
 /* ---- Configuration ----------------------------------------------------- */
 
 static const char *TAG = "MAIN";
@@ -74,13 +87,36 @@ static const char *TAG = "MAIN";
  */
 #define ULP_WAKEUP_PERIOD_US   1000000ULL   /* 1 second */
 
+/**
+ * @brief Send routine packets from the ULP instead of waking the main CPU.
+ *
+ * 1 = the ULP bit-bangs AT+SEND on the RTC GPIOs and the main CPU boots only
+ *     for configuration (cold boot) and transmit errors.
+ * 0 = the main CPU takes a reading on every ULP wake and sends packed
+ *     multi-reading frames within the duty-cycle budget (lora_uplink.h).
+ *     The ULP mode keeps short text packets.
+ */
+#define LORA_TX_ON_ULP         1
+
+/**
+ * @brief Payload text before the packet number (ULP mode, max 31 chars).
+ */
+#define LORA_PAYLOAD_PREFIX    "SENSOR:PKT#"
+
 /**
  * @brief LoRa payload format string.
  *
  * The actual payload is formatted at runtime with the current wakeup count
  * so each packet carries unique content.
  */
-#define LORA_PAYLOAD_FMT       "SENSOR:PKT#%" PRIu32
+#define LORA_PAYLOAD_FMT       LORA_PAYLOAD_PREFIX "%" PRIu32
+
+#if LORA_TX_ON_ULP
+_Static_assert(CONFIG_ULP_RISCV_UART_BAUDRATE == RYLR896_BAUD_RATE,
+               "The ULP UART and the RYLR896 driver must use the same baud rate");
+_Static_assert(sizeof(LORA_PAYLOAD_PREFIX) <= 32,
+               "LORA_PAYLOAD_PREFIX does not fit ulp_payload_prefix");
+#endif
 
 /* ---- Private helpers -------------------------------------------------- */
 
@@ -124,6 +160,11 @@ static esp_err_t start_ulp_program(void)
         return err;
     }
 
+    // Loading clears the ULP variables; set the transmit inputs before it runs.
+    ulp_tx_on_ulp = LORA_TX_ON_ULP;
+    ulp_tx_dest   = RYLR896_DEST_ADDR;
+    memcpy((void *)&ulp_payload_prefix, LORA_PAYLOAD_PREFIX, sizeof(LORA_PAYLOAD_PREFIX));
+
     // Start the ULP program running; does not return if successful.
     err = ulp_riscv_run();
     if (err != ESP_OK) {
@@ -142,19 +183,18 @@ static esp_err_t start_ulp_program(void)
  * Initialises the UART driver, sends one packet, then releases the driver
  * to minimise power consumption.  Active window target: <200 ms.
  *
- * @param counter  Current value of ulp_wakeup_counter used in the payload.
+ * @param payload  Text to send.
+ *
+ * @return true if the module acknowledged the packet.
  */
-static void perform_lora_transmission(uint32_t counter)
+static bool send_payload(const char *payload)
 {
     // Initialise the RYLR896 LoRa module; returns false on failure.
     if (!rylr896_init()) {
         ESP_LOGE(TAG, "Failed to initialise RYLR896 - skipping TX");
-        return;
+        return false;
     }
 
-    char payload[64];
-    snprintf(payload, sizeof(payload), LORA_PAYLOAD_FMT, counter);
-
     // Send the LoRa data; returns false on failure.
     bool ok = rylr896_send_data(payload);
     if (!ok) {
@@ -163,7 +203,36 @@ static void perform_lora_transmission(uint32_t counter)
 
     // Deinitialise the LoRa module to save power until the next transmission.
     rylr896_deinit();
+    return ok;
+}
+
+#if LORA_TX_ON_ULP
+/**
+ * @brief Send the text packet the ULP would have sent.
+ *
+ * @param counter  Number used in the payload.
+ *
+ * @return true if the module acknowledged the packet.
+ */
+static bool perform_lora_transmission(uint32_t counter)
+{
+    char payload[64];
+    snprintf(payload, sizeof(payload), LORA_PAYLOAD_FMT, counter);
+    return send_payload(payload);
+}
+#else
+/**
+ * @brief Take one sensor reading.
+ *
+ * Placeholder: returns a count that survives deep sleep, so each queued
+ * reading can be told apart at the receiver.  Replace with the real sensor.
+ */
+static int16_t read_sensor(void)
+{
+    static RTC_DATA_ATTR uint16_t s_demo_reading;
+    return (int16_t)s_demo_reading++;
 }
+#endif
 
 /**
  * @brief Configure and enter deep sleep with the ULP wakeup source enabled.
@@ -182,6 +251,11 @@ static void enter_deep_sleep(void)
         esp_restart();
     }
 
+#if LORA_TX_ON_ULP
+    // The ULP drives the module's UART pins through the RTC IO pads.
+    esp_sleep_pd_config(ESP_PD_DOMAIN_RTC_PERIPH, ESP_PD_OPTION_ON);
+#endif
+
     ESP_LOGI(TAG, "Entering deep sleep - wake source: ULP");
 
     /*
@@ -213,16 +287,38 @@ void app_main(void)
          * The ULP incremented its counter and signalled us.  Check the
          * shared tx_due flag; if set, transmit a LoRa packet.
          */
-        ESP_LOGI(TAG, "Woke from ULP (counter=%" PRIu32 ", tx_due=%" PRIu32 ")",
+        ESP_LOGI(TAG, "Woke from ULP (counter=%" PRIu32 ", tx_due=%" PRIu32 ", tx_error=%" PRIu32 ")",
                  (uint32_t)ulp_wakeup_counter,
-                 (uint32_t)ulp_tx_due);
+                 (uint32_t)ulp_tx_due,
+                 (uint32_t)ulp_tx_error);
 
         if ((uint32_t)ulp_tx_due != 0U) {
-            // Perform the LoRa transmission with the current wakeup counter value in the payload.
-            perform_lora_transmission((uint32_t)ulp_wakeup_counter);
+#if LORA_TX_ON_ULP
+            /*
+             * The module did not acknowledge the ULP's packet.  Retry through
+             * the UART driver, which also re-applies the module settings.
+             */
+            ESP_LOGW(TAG, "ULP packet %" PRIu32 " not acknowledged - retrying",
+                     (uint32_t)ulp_tx_count);
+            if (perform_lora_transmission((uint32_t)ulp_tx_count)) {
+                ulp_tx_count = (uint32_t)ulp_tx_count + 1U;
+            }
+#else
+            /*
+             * Queue a reading; the uplink sends a packed frame once enough
+             * have collected and the duty-cycle budget allows it.
+             */
+            lora_uplink_init();
+            lora_uplink_add(read_sensor());
+            if (!lora_uplink_service(send_payload)) {
+                ESP_LOGI(TAG, "%u readings queued", (unsigned int)lora_uplink_pending());
+            }
+#endif
             // Clear shared flags — ULP reads these on the next cycle.
             ulp_wakeup_counter = 0;
             ulp_tx_due         = 0;
+            // Last, so the ULP cannot start another packet before the counter is reset.
+            ulp_tx_error       = 0;
         } else {
             // Spurious wakeup — should not occur with current ULP logic.
             ESP_LOGW(TAG, "Woke from ULP but tx_due not set");
@@ -244,6 +340,18 @@ void app_main(void)
         ulp_wakeup_counter = 0;
         ulp_tx_due         = 0;
 
+#if LORA_TX_ON_ULP
+        /*
+         * The ULP only sends AT+SEND.  Address, network ID, band and baud
+         * rate are set here once; the module keeps them.
+         */
+        if (rylr896_init()) {
+            rylr896_deinit();
+        } else {
+            ESP_LOGE(TAG, "RYLR896 configuration failed - the first ULP packet will retry it");
+        }
+#endif
+
         // Start the ULP program; does not return if successful.
         esp_err_t err = start_ulp_program();
         if (err != ESP_OK) {
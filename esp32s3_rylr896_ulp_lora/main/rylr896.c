@@ -3,6 +3,11 @@
  * @brief REYAX RYLR896 LoRa module UART driver implementation.
  *
  * Implements UART-based AT command communication with the RYLR896.
+ * Commands go through a queue to an engine task, which owns the UART.
+ * A command completes as soon as its response line arrives, so latency is
+ * bound by the module's reply rather than by RYLR896_CMD_TIMEOUT_MS.
+ * Unsolicited +RCV lines are parsed as they arrive and passed to the
+ * receive callback instead of being flushed.
  * All public functions validate their inputs and check ESP-IDF return codes;
  * failures are logged and propagated to the caller — no silent failures.
  */
@@ -11,13 +16,17 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <stdbool.h>
 
 #include "driver/uart.h"
 #include "driver/gpio.h"
+#include "driver/rtc_io.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
 
 /* ---- Module-private constants ----------------------------------------- */
 
@@ -26,98 +35,470 @@ static const char *TAG = "RYLR896";
 /** Carriage-return + line-feed terminator used by all AT commands. */
 #define AT_CRLF          "\r\n"
 
-/** Expected positive acknowledgement substring from the module. */
+/** Expected positive acknowledgement prefix from the module. */
 #define AT_OK_RESPONSE   "+OK"
 
-/** Expected error substring returned by the module on bad commands. */
+/** Error prefix returned by the module on bad commands ("+ERR=<code>"). */
 #define AT_ERR_RESPONSE  "+ERR"
 
+/** Prefix of an unsolicited received-packet line. */
+#define AT_RCV_RESPONSE  "+RCV="
+
 /** Scratch buffer size for building AT command strings. */
 #define CMD_BUF_SIZE     320
 
-/** Receive buffer size for reading responses. */
-#define RESP_BUF_SIZE    128
+/** Longest response line kept; +RCV carries up to 240 payload bytes. */
+#define LINE_BUF_SIZE    300
+
+/** Commands that may wait for the engine. */
+#define CMD_QUEUE_LEN    4
+
+/** UART driver event queue length. */
+#define UART_EVENT_QUEUE_LEN  16
+
+/** AT engine task stack size and priority. */
+#define ENGINE_STACK_SIZE  3072
+#define ENGINE_PRIORITY    10
+
+/* ---- Module-private types --------------------------------------------- */
+
+/** Outcome of one AT command. */
+typedef enum {
+    AT_RESULT_OK,       /**< Line starting with the expected prefix. */
+    AT_RESULT_ERROR,    /**< "+ERR=<code>" from the module. */
+    AT_RESULT_TIMEOUT,  /**< No matching line within the timeout. */
+} at_result_t;
+
+/**
+ * @brief One queued AT command.
+ *
+ * Lives on the caller's stack; the caller blocks on @c done until the
+ * engine has filled in @c result.
+ */
+typedef struct {
+    const char *line;           /**< Full command including CRLF. */
+    size_t len;                 /**< Length of @c line. */
+    const char *expect;         /**< Response prefix that completes it. */
+    TickType_t timeout;         /**< Time allowed for the response. */
+    at_result_t result;         /**< Set by the engine. */
+    int err_code;               /**< Code from "+ERR=<code>", else 0. */
+    SemaphoreHandle_t done;     /**< Given by the engine on completion. */
+    StaticSemaphore_t done_buf;
+} at_cmd_t;
 
 /* ---- Module-private state --------------------------------------------- */
 
 /** True after rylr896_init() succeeds; guards against double-init. */
 static bool s_is_initialised = false;
 
-/* ---- Private helpers -------------------------------------------------- */
+/** UART driver events (data received, overflow, ...). */
+static QueueHandle_t s_uart_events;
+
+/** Commands waiting for the engine; a NULL entry stops the engine. */
+static QueueHandle_t s_cmd_queue;
+
+/** Lets the engine block on both queues at once. */
+static QueueSetHandle_t s_queue_set;
+
+/** AT engine task; NULL when not running. */
+static TaskHandle_t s_engine_task;
+
+/** Given by the engine task just before it exits. */
+static SemaphoreHandle_t s_engine_stopped;
+
+/** Handler for unsolicited +RCV lines. */
+static rylr896_receive_cb_t s_receive_cb;
+static void *s_receive_ctx;
+
+/* ---- AT engine -------------------------------------------------------- */
+
+/**
+ * @brief Parse "+RCV=<addr>,<len>,<data>,<rssi>,<snr>" and pass it on.
+ *
+ * The data field may contain commas, so it is cut by its length.
+ */
+static void handle_rcv(char *line)
+{
+    char *p = line + strlen(AT_RCV_RESPONSE);
+    char *end;
+
+    unsigned long addr = strtoul(p, &end, 10);
+    if (*end != ',') {
+        goto malformed;
+    }
+    unsigned long len = strtoul(end + 1, &end, 10);
+    if (*end != ',' || len > strlen(end + 1)) {
+        goto malformed;
+    }
+    char *data = end + 1;
+    p = data + len;
+    if (*p != ',') {
+        goto malformed;
+    }
+    *p = '\0';
+    long rssi = strtol(p + 1, &end, 10);
+    long snr = (*end == ',') ? strtol(end + 1, NULL, 10) : 0;
+
+    ESP_LOGD(TAG, "Received %lu bytes from %lu (RSSI %ld, SNR %ld)", len, addr, rssi, snr);
+    if (s_receive_cb != NULL) {
+        const rylr896_packet_t packet = {
+            .address = (uint16_t)addr,
+            .data = data,
+            .len = (size_t)len,
+            .rssi = (int16_t)rssi,
+            .snr = (int16_t)snr,
+        };
+        s_receive_cb(&packet, s_receive_ctx);
+    }
+    return;
+
+malformed:
+    ESP_LOGW(TAG, "Malformed +RCV line: %s", line);
+}
 
 /**
- * @brief Flush the UART RX buffer to discard stale data.
+ * @brief Handle one complete response line.
+ *
+ * @param line    NUL-terminated line without CR/LF.
+ * @param active  Command waiting for a response, or NULL.
+ * @return true if the line completed @p active.
  */
-static void flush_rx(void)
+static bool handle_line(char *line, at_cmd_t *active)
 {
-    uart_flush_input(RYLR896_UART_PORT);
+    if (line[0] == '\0') {
+        return false;
+    }
+
+    if (strncmp(line, AT_RCV_RESPONSE, strlen(AT_RCV_RESPONSE)) == 0) {
+        handle_rcv(line);
+        return false;
+    }
+
+    if (active == NULL) {
+        ESP_LOGD(TAG, "Unsolicited: %s", line);
+        return false;
+    }
+
+    if (strncmp(line, active->expect, strlen(active->expect)) == 0) {
+        active->result = AT_RESULT_OK;
+        return true;
+    }
+
+    if (strncmp(line, AT_ERR_RESPONSE, strlen(AT_ERR_RESPONSE)) == 0) {
+        active->result = AT_RESULT_ERROR;
+        active->err_code = (line[4] == '=') ? atoi(line + 5) : 0;
+        return true;
+    }
+
+    /* Noise, for example after a baud-rate change. */
+    ESP_LOGD(TAG, "Ignored: %s", line);
+    return false;
 }
 
 /**
- * @brief Send a raw AT command string (without CRLF) and wait for "+OK".
+ * @brief Engine task: sends queued commands and dispatches response lines.
  *
- * Appends CRLF, writes to UART, then reads back the response line.
+ * One command is in flight at a time.  It completes as soon as its
+ * response line arrives, or when its timeout expires.  +RCV lines are
+ * handled whenever they arrive, so nothing is flushed.
+ */
+static void at_engine_task(void *arg)
+{
+    (void)arg;
+
+    static char line[LINE_BUF_SIZE];
+    size_t line_len = 0;
+    bool overlong = false;
+    at_cmd_t *active = NULL;
+    TickType_t deadline = 0;
+
+    for (;;) {
+        /* Start the next command when the module is free. */
+        if (active == NULL) {
+            at_cmd_t *next = NULL;
+            if (xQueueReceive(s_cmd_queue, &next, 0) == pdTRUE) {
+                if (next == NULL) {
+                    break;  /* Stop request from rylr896_deinit(). */
+                }
+                active = next;
+                active->err_code = 0;
+                int written = uart_write_bytes(RYLR896_UART_PORT, active->line, active->len);
+                if (written != (int)active->len) {
+                    ESP_LOGE(TAG, "UART write failed (wrote %d / %u bytes)",
+                             written, (unsigned int)active->len);
+                    active->result = AT_RESULT_TIMEOUT;
+                    xSemaphoreGive(active->done);
+                    active = NULL;
+                    continue;
+                }
+                deadline = xTaskGetTickCount() + active->timeout;
+            }
+        }
+
+        TickType_t wait = portMAX_DELAY;
+        if (active != NULL) {
+            TickType_t now = xTaskGetTickCount();
+            wait = ((int32_t)(deadline - now) > 0) ? deadline - now : 0;
+        }
+
+        QueueSetMemberHandle_t ready = xQueueSelectFromSet(s_queue_set, wait);
+        if (ready == NULL) {
+            if (active != NULL) {
+                active->result = AT_RESULT_TIMEOUT;
+                xSemaphoreGive(active->done);
+                active = NULL;
+            }
+            continue;
+        }
+
+        if (ready == s_cmd_queue) {
+            /* Taken at the top of the loop once no command is in flight. */
+            continue;
+        }
+
+        uart_event_t event;
+        if (xQueueReceive(s_uart_events, &event, 0) != pdTRUE) {
+            continue;
+        }
+
+        if (event.type == UART_FIFO_OVF || event.type == UART_BUFFER_FULL) {
+            ESP_LOGW(TAG, "UART RX overflow - dropping buffered data");
+            uart_flush_input(RYLR896_UART_PORT);
+            line_len = 0;
+            continue;
+        }
+        if (event.type != UART_DATA) {
+            continue;
+        }
+
+        uint8_t chunk[64];
+        size_t remaining = event.size;
+        while (remaining > 0U) {
+            size_t want = remaining < sizeof(chunk) ? remaining : sizeof(chunk);
+            int got = uart_read_bytes(RYLR896_UART_PORT, chunk, want, 0);
+            if (got <= 0) {
+                break;
+            }
+            remaining -= (size_t)got;
+
+            for (int i = 0; i < got; i++) {
+                char c = (char)chunk[i];
+                if (c == '\r') {
+                    continue;
+                }
+                if (c != '\n') {
+                    if (line_len < sizeof(line) - 1U) {
+                        line[line_len++] = c;
+                    } else {
+                        overlong = true;
+                    }
+                    continue;
+                }
+
+                line[line_len] = '\0';
+                if (overlong) {
+                    ESP_LOGW(TAG, "Dropped overlong line");
+                } else if (handle_line(line, active)) {
+                    xSemaphoreGive(active->done);
+                    active = NULL;
+                }
+                line_len = 0;
+                overlong = false;
+            }
+        }
+    }
+
+    if (active != NULL) {
+        active->result = AT_RESULT_TIMEOUT;
+        xSemaphoreGive(active->done);
+    }
+    xSemaphoreGive(s_engine_stopped);
+    vTaskDelete(NULL);
+}
+
+/**
+ * @brief Stop the engine task and release the UART driver and queues.
  *
- * @param cmd  Null-terminated AT command string (without trailing CRLF).
+ * Safe to call with any subset of the resources created.
+ */
+static void release_uart(void)
+{
+    if (s_engine_task != NULL) {
+        at_cmd_t *stop = NULL;
+        xQueueSend(s_cmd_queue, &stop, portMAX_DELAY);
+        xSemaphoreTake(s_engine_stopped, portMAX_DELAY);
+        s_engine_task = NULL;
+    }
+
+    if (s_queue_set != NULL) {
+        xQueueRemoveFromSet(s_cmd_queue, s_queue_set);
+        xQueueRemoveFromSet(s_uart_events, s_queue_set);
+        vQueueDelete(s_queue_set);
+        s_queue_set = NULL;
+    }
+    if (s_cmd_queue != NULL) {
+        vQueueDelete(s_cmd_queue);
+        s_cmd_queue = NULL;
+    }
+    if (s_engine_stopped != NULL) {
+        vSemaphoreDelete(s_engine_stopped);
+        s_engine_stopped = NULL;
+    }
+    if (s_uart_events != NULL) {
+        uart_driver_delete(RYLR896_UART_PORT);
+        s_uart_events = NULL;
+    }
+}
+
+/**
+ * @brief Create the command queue and start the engine task.
  *
- * @return true if "+OK" was found in the response within the timeout.
- * @return false on write error or timeout / unexpected response.
+ * @return true on success.
  */
-static bool send_at_command(const char *cmd)
+static bool start_engine(void)
 {
-    if (cmd == NULL) {
-        ESP_LOGE(TAG, "send_at_command: NULL command");
+    s_cmd_queue = xQueueCreate(CMD_QUEUE_LEN, sizeof(at_cmd_t *));
+    s_queue_set = xQueueCreateSet(CMD_QUEUE_LEN + UART_EVENT_QUEUE_LEN);
+    s_engine_stopped = xSemaphoreCreateBinary();
+    if (s_cmd_queue == NULL || s_queue_set == NULL || s_engine_stopped == NULL) {
+        ESP_LOGE(TAG, "Out of memory for the AT engine");
+        return false;
+    }
+
+    if (xQueueAddToSet(s_cmd_queue, s_queue_set) != pdPASS ||
+        xQueueAddToSet(s_uart_events, s_queue_set) != pdPASS) {
+        ESP_LOGE(TAG, "xQueueAddToSet failed");
         return false;
     }
 
-    /* Build the full command with CRLF terminator. */
+    if (xTaskCreate(at_engine_task, "rylr896_at", ENGINE_STACK_SIZE, NULL,
+                    ENGINE_PRIORITY, &s_engine_task) != pdPASS) {
+        s_engine_task = NULL;
+        ESP_LOGE(TAG, "Failed to create the AT engine task");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Queue an AT command (without CRLF) and wait for its response.
+ *
+ * Returns as soon as a line starting with @p expect or "+ERR" arrives.
+ *
+ * @param cmd         Null-terminated AT command string.
+ * @param expect      Response prefix that counts as success.
+ * @param timeout_ms  Time allowed for the response.
+ *
+ * @return The command outcome.
+ */
+static at_result_t at_exec(const char *cmd, const char *expect, uint32_t timeout_ms)
+{
     char full_cmd[CMD_BUF_SIZE];
     int len = snprintf(full_cmd, sizeof(full_cmd), "%s%s", cmd, AT_CRLF);
     if (len < 0 || len >= (int)sizeof(full_cmd)) {
-        ESP_LOGE(TAG, "send_at_command: command too long (%d chars)", len);
-        return false;
+        ESP_LOGE(TAG, "at_exec: command too long (%d chars)", len);
+        return AT_RESULT_ERROR;
     }
 
-    /* Discard any previously buffered RX data. */
-    flush_rx();
+    at_cmd_t req = {
+        .line = full_cmd,
+        .len = (size_t)len,
+        .expect = expect,
+        .timeout = pdMS_TO_TICKS(timeout_ms),
+        .result = AT_RESULT_TIMEOUT,
+    };
+    req.done = xSemaphoreCreateBinaryStatic(&req.done_buf);
 
-    /* Transmit the command. */
-    int written = uart_write_bytes(RYLR896_UART_PORT, full_cmd, (size_t)len);
-    if (written != len) {
-        ESP_LOGE(TAG, "UART write failed (wrote %d / %d bytes)", written, len);
-        return false;
+    at_cmd_t *item = &req;
+    if (xQueueSend(s_cmd_queue, &item, pdMS_TO_TICKS(timeout_ms)) != pdTRUE) {
+        ESP_LOGE(TAG, "AT engine busy - '%s' not sent", cmd);
+        return AT_RESULT_TIMEOUT;
     }
 
-    /* Wait for the TX FIFO to drain so we read a clean response. */
-    esp_err_t drain_err = uart_wait_tx_done(RYLR896_UART_PORT,
-                              pdMS_TO_TICKS(RYLR896_CMD_TIMEOUT_MS));
-    if (drain_err != ESP_OK) {
-        ESP_LOGE(TAG, "uart_wait_tx_done: %s", esp_err_to_name(drain_err));
+    /* The engine always completes the request, at the latest on timeout. */
+    xSemaphoreTake(req.done, portMAX_DELAY);
+    return req.result;
+}
+
+/**
+ * @brief Send an AT command (without CRLF) and wait for "+OK".
+ *
+ * @param cmd  Null-terminated AT command string (without trailing CRLF).
+ *
+ * @return true if "+OK" arrived within the timeout.
+ * @return false on write error, "+ERR" or timeout.
+ */
+static bool send_at_command(const char *cmd)
+{
+    if (cmd == NULL) {
+        ESP_LOGE(TAG, "send_at_command: NULL command");
         return false;
     }
 
-    /* Read the response. */
-    uint8_t resp[RESP_BUF_SIZE];
-    memset(resp, 0, sizeof(resp));
-    int rxlen = uart_read_bytes(RYLR896_UART_PORT,
-                                resp,
-                                sizeof(resp) - 1U,
-                                pdMS_TO_TICKS(RYLR896_CMD_TIMEOUT_MS));
-    if (rxlen <= 0) {
+    TickType_t start = xTaskGetTickCount();
+    at_result_t result = at_exec(cmd, AT_OK_RESPONSE, RYLR896_CMD_TIMEOUT_MS);
+    ESP_LOGD(TAG, "'%s' -> %d in %u ms", cmd, (int)result,
+             (unsigned int)pdTICKS_TO_MS(xTaskGetTickCount() - start));
+
+    switch (result) {
+    case AT_RESULT_OK:
+        return true;
+    case AT_RESULT_ERROR:
+        ESP_LOGE(TAG, "Module rejected '%s'", cmd);
+        return false;
+    default:
         ESP_LOGE(TAG, "No response to command: %s (timeout %d ms)",
                  cmd, RYLR896_CMD_TIMEOUT_MS);
         return false;
     }
+}
 
-    resp[rxlen] = '\0';  /* Null-terminate for string search. */
-    ESP_LOGD(TAG, "Response (%d bytes): %s", rxlen, (char *)resp);
-
-    if (strstr((char *)resp, AT_OK_RESPONSE) != NULL) {
+/**
+ * @brief Make sure the module answers at RYLR896_BAUD_RATE.
+ *
+ * A module fresh from the factory runs at RYLR896_FACTORY_BAUD_RATE.  If the
+ * ping at the configured rate fails, the factory rate is tried and the
+ * module is switched with AT+IPR, which it stores in non-volatile memory.
+ *
+ * @return true if the module answers AT at RYLR896_BAUD_RATE.
+ */
+static bool sync_baud_rate(void)
+{
+    if (send_at_command("AT")) {
         return true;
     }
 
-    ESP_LOGE(TAG, "Unexpected response to '%s': %s", cmd, (char *)resp);
-    return false;
+    ESP_LOGW(TAG, "No answer at %d baud - trying factory rate %d",
+             RYLR896_BAUD_RATE, RYLR896_FACTORY_BAUD_RATE);
+
+    esp_err_t err = uart_set_baudrate(RYLR896_UART_PORT, RYLR896_FACTORY_BAUD_RATE);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "uart_set_baudrate: %s", esp_err_to_name(err));
+        return false;
+    }
+
+    bool found = send_at_command("AT");
+    if (found) {
+        char cmd[CMD_BUF_SIZE];
+        snprintf(cmd, sizeof(cmd), "AT+IPR=%d", RYLR896_BAUD_RATE);
+        /* The module may switch before its reply is complete; the ping
+         * below is the real check. */
+        (void)send_at_command(cmd);
+    }
+
+    err = uart_set_baudrate(RYLR896_UART_PORT, RYLR896_BAUD_RATE);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "uart_set_baudrate: %s", esp_err_to_name(err));
+        return false;
+    }
+
+    if (!found) {
+        return false;
+    }
+
+    /* Give the module time to apply the new rate. */
+    vTaskDelay(pdMS_TO_TICKS(50));
+    return send_at_command("AT");
 }
 
 /* ---- Public API implementation ---------------------------------------- */
@@ -148,6 +529,17 @@ bool rylr896_init(void)
         return false;
     }
 
+    /*
+     * The ULP drives these pins through the RTC IO mux when it transmits on
+     * its own; route them back to the digital UART.
+     */
+    if (rtc_gpio_is_valid_gpio(RYLR896_TX_PIN)) {
+        rtc_gpio_deinit(RYLR896_TX_PIN);
+    }
+    if (rtc_gpio_is_valid_gpio(RYLR896_RX_PIN)) {
+        rtc_gpio_deinit(RYLR896_RX_PIN);
+    }
+
     err = uart_set_pin(RYLR896_UART_PORT,
                        RYLR896_TX_PIN,
                        RYLR896_RX_PIN,
@@ -161,9 +553,15 @@ bool rylr896_init(void)
     err = uart_driver_install(RYLR896_UART_PORT,
                               RYLR896_RX_BUF_SIZE,
                               RYLR896_TX_BUF_SIZE,
-                              0, NULL, 0);
+                              UART_EVENT_QUEUE_LEN, &s_uart_events, 0);
     if (err != ESP_OK) {
         ESP_LOGE(TAG, "uart_driver_install: %s", esp_err_to_name(err));
+        s_uart_events = NULL;
+        return false;
+    }
+
+    if (!start_engine()) {
+        release_uart();
         return false;
     }
 
@@ -171,9 +569,9 @@ bool rylr896_init(void)
     vTaskDelay(pdMS_TO_TICKS(100));
 
     /* Send AT (ping) — module should respond "+OK". */
-    if (!send_at_command("AT")) {
+    if (!sync_baud_rate()) {
         ESP_LOGE(TAG, "Module did not respond to AT ping");
-        uart_driver_delete(RYLR896_UART_PORT);
+        release_uart();
         return false;
     }
 
@@ -182,7 +580,7 @@ bool rylr896_init(void)
     snprintf(cmd, sizeof(cmd), "AT+ADDRESS=%d", RYLR896_ADDRESS);
     if (!send_at_command(cmd)) {
         ESP_LOGE(TAG, "Failed to set ADDRESS");
-        uart_driver_delete(RYLR896_UART_PORT);
+        release_uart();
         return false;
     }
 
@@ -190,7 +588,7 @@ bool rylr896_init(void)
     snprintf(cmd, sizeof(cmd), "AT+NETWORKID=%d", RYLR896_NETWORK_ID);
     if (!send_at_command(cmd)) {
         ESP_LOGE(TAG, "Failed to set NETWORKID");
-        uart_driver_delete(RYLR896_UART_PORT);
+        release_uart();
         return false;
     }
 
@@ -198,7 +596,17 @@ bool rylr896_init(void)
     snprintf(cmd, sizeof(cmd), "AT+BAND=%u", (unsigned int)RYLR896_BAND_HZ);
     if (!send_at_command(cmd)) {
         ESP_LOGE(TAG, "Failed to set BAND");
-        uart_driver_delete(RYLR896_UART_PORT);
+        release_uart();
+        return false;
+    }
+
+    /* Set spreading factor, bandwidth, coding rate and preamble. */
+    snprintf(cmd, sizeof(cmd), "AT+PARAMETER=%d,%d,%d,%d",
+             RYLR896_SPREADING_FACTOR, RYLR896_BANDWIDTH_CODE,
+             RYLR896_CODING_RATE, RYLR896_PREAMBLE);
+    if (!send_at_command(cmd)) {
+        ESP_LOGE(TAG, "Failed to set PARAMETER");
+        release_uart();
         return false;
     }
 
@@ -220,7 +628,7 @@ void rylr896_deinit(void)
 
     /* Ensure all TX bytes have been clocked out. */
     uart_wait_tx_done(RYLR896_UART_PORT, pdMS_TO_TICKS(200));
-    uart_driver_delete(RYLR896_UART_PORT);
+    release_uart();
     s_is_initialised = false;
     ESP_LOGD(TAG, "UART driver released");
 }
@@ -275,4 +683,12 @@ bool rylr896_send_data(const char *data)
     }
 
     return ok;
-}
\ No newline at end of file
+}
+/**
+ * @brief Set the handler for unsolicited +RCV packets.
+ */
+void rylr896_set_receive_callback(rylr896_receive_cb_t cb, void *ctx)
+{
+    s_receive_cb = cb;
+    s_receive_ctx = ctx;
+}
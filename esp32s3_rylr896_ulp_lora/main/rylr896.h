@@ -11,13 +11,16 @@
  *   ESP32-S3 3V3     -> RYLR896 VCC
  *   ESP32-S3 GND     -> RYLR896 GND
  *
- * The RYLR896 operates at 115200 baud by default.
+ * The RYLR896 ships at 115200 baud. The driver runs it at RYLR896_BAUD_RATE
+ * (9600), which the ULP's bit-banged UART can also reach; rylr896_init()
+ * switches a factory-fresh module over once.
  */
 
 #ifndef RYLR896_H
 #define RYLR896_H
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 #include "driver/uart.h"
 
@@ -36,8 +39,16 @@ extern "C" {
 /** GPIO number for ESP32-S3 RX -> RYLR896 TX. */
 #define RYLR896_RX_PIN       18
 
-/** UART baud rate (RYLR896 factory default). */
-#define RYLR896_BAUD_RATE    115200
+/**
+ * UART baud rate used with the module.
+ *
+ * Must equal CONFIG_ULP_RISCV_UART_BAUDRATE so the ULP can send AT+SEND
+ * itself (see ulp_lora_scheduler.c).  The setting is stored in the module.
+ */
+#define RYLR896_BAUD_RATE    9600
+
+/** RYLR896 factory-default baud rate, tried when the module does not answer. */
+#define RYLR896_FACTORY_BAUD_RATE  115200
 
 /** UART RX ring-buffer size in bytes. */
 #define RYLR896_RX_BUF_SIZE  256
@@ -59,18 +70,59 @@ extern "C" {
 /** Destination address for AT+SEND (0 = broadcast). */
 #define RYLR896_DEST_ADDR    0
 
+/*
+ * Radio parameters for AT+PARAMETER.  These are the module defaults; they
+ * are set explicitly so the airtime estimate in lora_uplink.c holds.
+ */
+
+/** Spreading factor (7–12). */
+#define RYLR896_SPREADING_FACTOR  9
+
+/** Bandwidth code: 7 = 125 kHz, 8 = 250 kHz, 9 = 500 kHz. */
+#define RYLR896_BANDWIDTH_CODE    7
+
+/** Coding rate: 1 = 4/5 … 4 = 4/8. */
+#define RYLR896_CODING_RATE       1
+
+/** Programmed preamble length in symbols. */
+#define RYLR896_PREAMBLE          12
+
 /* ---- Timeout configuration -------------------------------------------- */
 
 /** Maximum time (ms) to wait for a single AT command response. */
 #define RYLR896_CMD_TIMEOUT_MS   3000
 
+/* ---- Public types ------------------------------------------------------ */
+
+/**
+ * @brief A packet received by the module (unsolicited "+RCV" line).
+ */
+typedef struct {
+    uint16_t address;   /**< Sender address. */
+    const char *data;   /**< Payload, NUL-terminated; valid during the callback only. */
+    size_t len;         /**< Payload length in bytes. */
+    int16_t rssi;       /**< Received signal strength in dBm. */
+    int16_t snr;        /**< Signal-to-noise ratio in dB. */
+} rylr896_packet_t;
+
+/**
+ * @brief Handler for received packets.
+ *
+ * Runs in the driver's AT engine task; keep it short and do not call
+ * other rylr896_* functions from it.
+ */
+typedef void (*rylr896_receive_cb_t)(const rylr896_packet_t *packet, void *ctx);
+
 /* ---- Public API -------------------------------------------------------- */
 
 /**
  * @brief Initialise the UART peripheral and configure the RYLR896 module.
  *
  * Installs the UART driver, configures baud rate / framing, and sends the
- * required AT setup commands (ADDRESS, NETWORKID, BAND).
+ * required AT setup commands (ADDRESS, NETWORKID, BAND).  A module that
+ * does not answer at RYLR896_BAUD_RATE is tried at the factory rate and
+ * switched with AT+IPR.  The UART pins are taken back from the RTC IO mux
+ * in case the ULP was driving them.
  *
  * Must be called once before any rylr896_send_data() call.  After the
  * transmission session is complete, call rylr896_deinit() to release
@@ -95,7 +147,8 @@ void rylr896_deinit(void);
  * @brief Send a null-terminated string payload via the RYLR896 LoRa module.
  *
  * Formats and transmits an AT+SEND command, then blocks until the module
- * responds with "+OK" or the command timeout elapses.
+ * responds with "+OK" (or "+ERR") or the command timeout elapses.  Packets
+ * received meanwhile go to the receive callback.
  *
  * @param data  Null-terminated ASCII string to transmit (max 240 bytes per
  *              RYLR896 datasheet limit).  Must not be NULL.
@@ -106,6 +159,17 @@ void rylr896_deinit(void);
  */
 bool rylr896_send_data(const char *data);
 
+/**
+ * @brief Set the handler for packets the module receives.
+ *
+ * Packets arrive as unsolicited "+RCV" lines while the driver is
+ * initialised.  Without a handler they are logged at debug level.
+ *
+ * @param cb   Handler, or NULL to remove it.
+ * @param ctx  Passed to @p cb unchanged.
+ */
+void rylr896_set_receive_callback(rylr896_receive_cb_t cb, void *ctx);
+
 #ifdef __cplusplus
 }
 #endif
@@ -18,10 +18,21 @@
  *
  * main.c accesses the symbols using the header names (with the ulp_ prefix),
  * so main.c uses ulp_wakeup_counter and ulp_tx_due — which is correct.
+ *
+ * ULP transmit mode
+ * -----------------
+ * When the main CPU sets tx_on_ulp, the ULP sends the routine AT+SEND
+ * itself over a bit-banged UART on the RTC GPIOs wired to the RYLR896
+ * (the ESP32-S3 has no LP UART), and checks for "+OK".  The main CPU is
+ * woken only when the module does not acknowledge; tx_error says why.
  */
 
+#include <stdbool.h>
 #include <stdint.h>
+#include "sdkconfig.h"
 #include "ulp_riscv_utils.h"
+#include "ulp_riscv_gpio.h"
+#include "ulp_riscv_uart_ulp_core.h"
 
 /* ---- Shared variables (exported to main CPU with "ulp_" prefix added) -- */
 
@@ -41,6 +52,34 @@ volatile uint32_t wakeup_counter = 0;
  */
 volatile uint32_t tx_due = 0;
 
+/**
+ * @brief Non-zero when the ULP sends packets itself (set by the main CPU).
+ */
+volatile uint32_t tx_on_ulp = 0;
+
+/**
+ * @brief Destination address for AT+SEND (set by the main CPU).
+ */
+volatile uint32_t tx_dest = 0;
+
+/**
+ * @brief NUL-terminated payload prefix, written by the main CPU.
+ *
+ * The packet number is appended in decimal.  Declared as words because
+ * the generated header exports every symbol as uint32_t.
+ */
+volatile uint32_t payload_prefix[8];
+
+/**
+ * @brief Packets acknowledged by the module while sent from the ULP.
+ */
+volatile uint32_t tx_count = 0;
+
+/**
+ * @brief Reason for the last ULP transmit failure (TX_ERR_*), 0 if none.
+ */
+volatile uint32_t tx_error = 0;
+
 /* ---- Configuration ----------------------------------------------------- */
 
 /**
@@ -51,6 +90,161 @@ volatile uint32_t tx_due = 0;
  */
 #define TX_INTERVAL_COUNT  60U
 
+/** RTC GPIOs wired to the module; must match RYLR896_TX_PIN / RYLR896_RX_PIN. */
+#define LORA_TX_PIN        GPIO_NUM_17
+#define LORA_RX_PIN        GPIO_NUM_18
+
+/** ULP cycles per UART bit at CONFIG_ULP_RISCV_UART_BAUDRATE. */
+#define BIT_CYCLES         ((uint32_t)(ULP_RISCV_CYCLES_PER_US * 1000000.0 / \
+                                       CONFIG_ULP_RISCV_UART_BAUDRATE))
+
+/** Time allowed for the module's reply; matches RYLR896_CMD_TIMEOUT_MS. */
+#define REPLY_TIMEOUT_CYCLES  ((uint32_t)(ULP_RISCV_CYCLES_PER_MS * 3000))
+
+/** Gap that ends a reply line once it has started. */
+#define CHAR_GAP_CYCLES    (BIT_CYCLES * 20U)
+
+/** tx_error values. */
+#define TX_ERR_NO_REPLY    1U   /* Nothing received within the timeout. */
+#define TX_ERR_REJECTED    2U   /* Reply was not "+OK" (e.g. "+ERR=..."). */
+
+/* ---- Bit-banged UART --------------------------------------------------- */
+
+static ulp_riscv_uart_t s_uart;
+
+/**
+ * @brief Take the module's pins into the RTC IO mux.
+ *
+ * Repeated before every packet because the main CPU hands the pins back
+ * to its UART whenever it talks to the module.
+ */
+static void lora_uart_init(void)
+{
+    ulp_riscv_uart_cfg_t cfg = {
+        .tx_pin = LORA_TX_PIN,
+    };
+    ulp_riscv_uart_init(&s_uart, &cfg);
+
+    ulp_riscv_gpio_init(LORA_RX_PIN);
+    ulp_riscv_gpio_input_enable(LORA_RX_PIN);
+}
+
+static void lora_puts(const char *str)
+{
+    while (*str != '\0') {
+        ulp_riscv_uart_putc(&s_uart, *str++);
+    }
+}
+
+/**
+ * @brief Receive one byte, sampling each bit at its centre.
+ *
+ * @param timeout_cycles  Maximum wait for the start bit.
+ * @return The byte, or -1 on timeout.
+ */
+static int lora_getc(uint32_t timeout_cycles)
+{
+    uint32_t start = ulp_riscv_get_cpu_cycles();
+    while (ulp_riscv_gpio_get_level(LORA_RX_PIN)) {
+        if (ulp_riscv_get_cpu_cycles() - start > timeout_cycles) {
+            return -1;
+        }
+    }
+
+    /* Falling edge of the start bit; bit n is centred 1.5 + n bit times on. */
+    uint32_t edge = ulp_riscv_get_cpu_cycles();
+    uint32_t c = 0;
+    for (uint32_t bit = 0; bit < 8U; bit++) {
+        uint32_t centre = BIT_CYCLES + BIT_CYCLES / 2U + bit * BIT_CYCLES;
+        while (ulp_riscv_get_cpu_cycles() - edge < centre) {
+        }
+        c |= (uint32_t)ulp_riscv_gpio_get_level(LORA_RX_PIN) << bit;
+    }
+
+    /* Wait out the stop bit so the next start bit is not missed. */
+    while (ulp_riscv_get_cpu_cycles() - edge < BIT_CYCLES * 10U) {
+    }
+    return (int)c;
+}
+
+/* ---- AT+SEND ----------------------------------------------------------- */
+
+/** Appends the decimal form of v at buf[pos]; returns the new length. */
+static uint32_t put_u32(char *buf, uint32_t pos, uint32_t v)
+{
+    char tmp[10];
+    uint32_t n = 0;
+    do {
+        tmp[n++] = (char)('0' + v % 10U);
+        v /= 10U;
+    } while (v != 0U);
+    while (n > 0U) {
+        buf[pos++] = tmp[--n];
+    }
+    return pos;
+}
+
+/**
+ * @brief Send one AT+SEND packet and wait for the module's reply.
+ *
+ * @return 0 on "+OK", otherwise a TX_ERR_* value.
+ */
+static uint32_t lora_send_packet(void)
+{
+    /* Payload: prefix plus packet number. */
+    const volatile char *prefix = (const volatile char *)payload_prefix;
+    char payload[sizeof(payload_prefix) + 10];
+    uint32_t len = 0;
+    while (len < sizeof(payload_prefix) - 1U && prefix[len] != '\0') {
+        payload[len] = prefix[len];
+        len++;
+    }
+    len = put_u32(payload, len, tx_count);
+    payload[len] = '\0';
+
+    /* AT+SEND=<dest>,<length>,<payload> */
+    char cmd[64];
+    uint32_t pos = 0;
+    const char *head = "AT+SEND=";
+    while (*head != '\0') {
+        cmd[pos++] = *head++;
+    }
+    pos = put_u32(cmd, pos, tx_dest);
+    cmd[pos++] = ',';
+    pos = put_u32(cmd, pos, len);
+    cmd[pos++] = ',';
+    cmd[pos] = '\0';
+
+    lora_uart_init();
+    /* One idle character so the module's receiver is in sync. */
+    ulp_riscv_delay_cycles(BIT_CYCLES * 10U);
+
+    lora_puts(cmd);
+    lora_puts(payload);
+    lora_puts("\r\n");
+
+    /* Read the reply line; only its start matters.  The length cap stops
+     * line noise from keeping the ULP awake. */
+    char reply[4] = {0};
+    uint32_t got = 0;
+    uint32_t total = 0;
+    int c = lora_getc(REPLY_TIMEOUT_CYCLES);
+    while (c >= 0 && c != '\n' && total++ < 64U) {
+        if (got < sizeof(reply)) {
+            reply[got++] = (char)c;
+        }
+        c = lora_getc(CHAR_GAP_CYCLES);
+    }
+
+    if (got == 0U) {
+        return TX_ERR_NO_REPLY;
+    }
+    if (got < 3U || reply[0] != '+' || reply[1] != 'O' || reply[2] != 'K') {
+        return TX_ERR_REJECTED;
+    }
+    return 0;
+}
+
 /* ---- Entry point ------------------------------------------------------- */
 
 /**
@@ -60,6 +254,15 @@ int main(void)
 {
     wakeup_counter++;
 
+    if (wakeup_counter >= TX_INTERVAL_COUNT && tx_on_ulp != 0U && tx_error == 0U) {
+        tx_error = lora_send_packet();
+        if (tx_error == 0U) {
+            /* Acknowledged: the main CPU stays asleep. */
+            tx_count++;
+            wakeup_counter = 0;
+        }
+    }
+
     if (wakeup_counter >= TX_INTERVAL_COUNT) {
         tx_due = 1U;
         // Wake the main CPU to handle the transmission; does not return if successful.
@@ -0,0 +1,585 @@
+#include "flash_ring.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_partition.h"
+#include "esp_rom_crc.h"
+
+#define RING_TAG "flash_ring"
+#define RING_PARTITION_LABEL "ring"
+
+#define RING_SECTOR_SIZE 4096U
+#define RING_HEADER_SECTOR_COUNT 2U
+#define RING_MIN_DATA_SECTORS 2U
+#define RING_ENTRY_SIZE 32U
+#define RING_ENTRIES_PER_SECTOR (RING_SECTOR_SIZE / RING_ENTRY_SIZE)
+#define RING_DATA_OFFSET (RING_HEADER_SECTOR_COUNT * RING_SECTOR_SIZE)
+
+#define RING_HEADER_MAGIC 0x52494E47UL
+#define RING_ENTRY_MAGIC 0x5245U
+#define RING_FORMAT_VERSION 1U
+
+// Flash encryption works on 16-byte blocks.
+#define RING_ENCRYPTION_BLOCK_SIZE 16U
+
+/**
+ * @brief Defines the ring header kept in each of the two header sectors.
+ *
+ * The valid copy with the higher generation wins, so a header can be
+ * rewritten in the other sector without ever losing the current one.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t format_version;
+    uint16_t entry_size;
+    uint32_t generation;
+    uint32_t data_sector_count;
+    uint8_t reserved[12];
+    uint32_t checksum;
+} ring_header_t;
+
+/**
+ * @brief Defines one ring entry.
+ *
+ * The checksum is seeded with the header generation, so entries left over
+ * from an earlier format never validate.
+ */
+typedef struct {
+    uint32_t sequence;
+    uint16_t magic;
+    uint8_t length;
+    uint8_t reserved;
+    uint8_t payload[FLASH_RING_MAX_PAYLOAD_SIZE];
+    uint32_t checksum;
+} ring_entry_t;
+
+_Static_assert(sizeof(ring_header_t) == RING_ENTRY_SIZE,
+               "the ring header must fill one entry");
+_Static_assert(sizeof(ring_entry_t) == RING_ENTRY_SIZE,
+               "ring entries must have the documented size");
+_Static_assert((RING_ENTRY_SIZE % RING_ENCRYPTION_BLOCK_SIZE) == 0U,
+               "ring entries must be whole flash encryption blocks");
+_Static_assert((RING_SECTOR_SIZE % RING_ENTRY_SIZE) == 0U,
+               "ring entries must not straddle sectors");
+
+/**
+ * @brief Holds the open ring.
+ */
+typedef struct {
+    const esp_partition_t *partition;
+    uint32_t generation;
+    uint32_t header_sector;
+    uint32_t data_sector_count;
+    uint32_t next_slot;
+    bool has_latest;
+    ring_entry_t latest;
+} ring_state_t;
+
+static ring_state_t s_ring;
+
+/**
+ * @brief Calculates the checksum of a ring header.
+ *
+ * Args:
+ *     header: Header to checksum.
+ *
+ * Returns:
+ *     The CRC-32 of every header byte except the checksum field.
+ */
+static uint32_t calculate_header_checksum(const ring_header_t *header)
+{
+    return esp_rom_crc32_le(
+        0U,
+        (const uint8_t *)header,
+        offsetof(ring_header_t, checksum));
+}
+
+/**
+ * @brief Calculates the checksum of a ring entry.
+ *
+ * Args:
+ *     entry: Entry to checksum.
+ *
+ * Returns:
+ *     The CRC-32 of every entry byte except the checksum field, seeded
+ *     with the ring generation.
+ */
+static uint32_t calculate_entry_checksum(const ring_entry_t *entry)
+{
+    return esp_rom_crc32_le(
+        s_ring.generation,
+        (const uint8_t *)entry,
+        offsetof(ring_entry_t, checksum));
+}
+
+/**
+ * @brief Returns the partition offset of an entry slot.
+ *
+ * Args:
+ *     slot: Slot index counted from the first data sector.
+ *
+ * Returns:
+ *     Byte offset of the slot within the partition.
+ */
+static size_t slot_offset(uint32_t slot)
+{
+    return RING_DATA_OFFSET + ((size_t)slot * RING_ENTRY_SIZE);
+}
+
+/**
+ * @brief Reads one slot and checks whether it holds a valid entry.
+ *
+ * Args:
+ *     slot: Slot to read.
+ *     entry: Receives the decrypted slot contents.
+ *
+ * Returns:
+ *     true when the slot holds an entry of the current format.
+ */
+static bool read_entry(uint32_t slot, ring_entry_t *entry)
+{
+    if (esp_partition_read(
+            s_ring.partition,
+            slot_offset(slot),
+            entry,
+            sizeof(*entry)) != ESP_OK) {
+        return false;
+    }
+
+    return (entry->magic == RING_ENTRY_MAGIC) &&
+           (entry->length <= FLASH_RING_MAX_PAYLOAD_SIZE) &&
+           (entry->checksum == calculate_entry_checksum(entry));
+}
+
+/**
+ * @brief Checks whether a slot has never been programmed since its erase.
+ *
+ * Encrypted reads of erased flash return noise, so the raw contents are
+ * inspected instead.
+ *
+ * Args:
+ *     slot: Slot to inspect.
+ *
+ * Returns:
+ *     true when every raw byte of the slot is 0xFF.
+ */
+static bool slot_is_erased(uint32_t slot)
+{
+    uint8_t raw[RING_ENTRY_SIZE];
+
+    if (esp_partition_read_raw(
+            s_ring.partition,
+            slot_offset(slot),
+            raw,
+            sizeof(raw)) != ESP_OK) {
+        return false;
+    }
+
+    for (size_t index = 0U; index < sizeof(raw); ++index) {
+        if (raw[index] != 0xFFU) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Reads one header copy.
+ *
+ * Args:
+ *     sector: Header sector index, 0 or 1.
+ *     header: Receives the header.
+ *
+ * Returns:
+ *     true when the copy is intact.
+ */
+static bool read_header(uint32_t sector, ring_header_t *header)
+{
+    if (esp_partition_read(
+            s_ring.partition,
+            (size_t)sector * RING_SECTOR_SIZE,
+            header,
+            sizeof(*header)) != ESP_OK) {
+        return false;
+    }
+
+    return (header->magic == RING_HEADER_MAGIC) &&
+           (header->checksum == calculate_header_checksum(header));
+}
+
+/**
+ * @brief Erases the ring and writes a new header generation.
+ *
+ * The data sectors are erased before the new header is written to the
+ * inactive header sector, so an interrupted format leaves either the old
+ * header, which then fails to find entries, or the new empty ring.
+ *
+ * Args:
+ *     generation: Generation of the new header.
+ *     header_sector: Header sector to write.
+ *
+ * Returns:
+ *     ESP_OK when the ring is formatted.
+ *     Another ESP-IDF error code when a flash operation fails.
+ */
+static esp_err_t format_ring(uint32_t generation, uint32_t header_sector)
+{
+    ESP_LOGW(
+        RING_TAG,
+        "Formatting ring: %u data sectors, generation %u",
+        (unsigned int)s_ring.data_sector_count,
+        (unsigned int)generation);
+
+    esp_err_t result = esp_partition_erase_range(
+        s_ring.partition,
+        RING_DATA_OFFSET,
+        (size_t)s_ring.data_sector_count * RING_SECTOR_SIZE);
+
+    if (result == ESP_OK) {
+        result = esp_partition_erase_range(
+            s_ring.partition,
+            (size_t)header_sector * RING_SECTOR_SIZE,
+            RING_SECTOR_SIZE);
+    }
+
+    ring_header_t header = {
+        .magic = RING_HEADER_MAGIC,
+        .format_version = RING_FORMAT_VERSION,
+        .entry_size = RING_ENTRY_SIZE,
+        .generation = generation,
+        .data_sector_count = s_ring.data_sector_count,
+        .reserved = {0},
+        .checksum = 0U,
+    };
+    header.checksum = calculate_header_checksum(&header);
+
+    if (result == ESP_OK) {
+        result = esp_partition_write(
+            s_ring.partition,
+            (size_t)header_sector * RING_SECTOR_SIZE,
+            &header,
+            sizeof(header));
+    }
+
+    if (result != ESP_OK) {
+        ESP_LOGE(RING_TAG, "Ring format failed: %s", esp_err_to_name(result));
+        return result;
+    }
+
+    s_ring.generation = generation;
+    s_ring.header_sector = header_sector;
+    s_ring.next_slot = 0U;
+    s_ring.has_latest = false;
+    return ESP_OK;
+}
+
+/**
+ * @brief Selects the newest valid header, formatting when there is none.
+ *
+ * Returns:
+ *     ESP_OK when a header matching this build's geometry is active.
+ *     Another ESP-IDF error code when formatting fails.
+ */
+static esp_err_t load_header(void)
+{
+    ring_header_t copies[RING_HEADER_SECTOR_COUNT];
+    bool valid[RING_HEADER_SECTOR_COUNT];
+    int newest = -1;
+
+    for (uint32_t sector = 0U; sector < RING_HEADER_SECTOR_COUNT; ++sector) {
+        valid[sector] = read_header(sector, &copies[sector]);
+
+        if (valid[sector] &&
+            ((newest < 0) ||
+             (copies[sector].generation > copies[newest].generation))) {
+            newest = (int)sector;
+        }
+    }
+
+    if (newest >= 0) {
+        const ring_header_t *header = &copies[newest];
+
+        if ((header->format_version == RING_FORMAT_VERSION) &&
+            (header->entry_size == RING_ENTRY_SIZE) &&
+            (header->data_sector_count == s_ring.data_sector_count)) {
+            s_ring.generation = header->generation;
+            s_ring.header_sector = (uint32_t)newest;
+            return ESP_OK;
+        }
+
+        ESP_LOGW(RING_TAG, "Ring header does not match this partition");
+    }
+
+    const uint32_t generation =
+        (newest >= 0) ? (copies[newest].generation + 1U) : 1U;
+    const uint32_t header_sector =
+        (newest >= 0) ? ((uint32_t)newest ^ 1U) : 0U;
+
+    return format_ring(generation, header_sector);
+}
+
+/**
+ * @brief Checks whether a data sector was written in the current lap.
+ *
+ * Args:
+ *     sector: Data sector index.
+ *     first: First entry of data sector 0.
+ *
+ * Returns:
+ *     true when the sector's first entry is valid and not older than the
+ *     first entry of sector 0.
+ */
+static bool sector_in_current_lap(uint32_t sector, const ring_entry_t *first)
+{
+    ring_entry_t entry;
+
+    if (!read_entry(sector * RING_ENTRIES_PER_SECTOR, &entry)) {
+        return false;
+    }
+
+    return (int32_t)(entry.sequence - first->sequence) >= 0;
+}
+
+/**
+ * @brief Finds the newest entry and the next free slot.
+ *
+ * Sectors are filled in order and erased just before the head enters
+ * them. Sectors 0 up to the head sector therefore start with valid
+ * entries of increasing sequence, and every later sector is older or
+ * erased, so the head sector can be binary-searched on first entries.
+ * Within a sector programmed slots form a prefix, so the last programmed
+ * slot is binary-searched on raw erased state. A torn entry at the end of
+ * that prefix is skipped by continuing in the next sector; a torn first
+ * entry makes its sector look older, so it is erased and reused.
+ */
+static void recover_head(void)
+{
+    const uint32_t sector_count = s_ring.data_sector_count;
+    ring_entry_t first;
+    uint32_t head_sector = sector_count - 1U;
+
+    // Sector 0 is only invalid on an empty ring or right after wrapping
+    // into it, when the newest entries end the last sector.
+    if (read_entry(0U, &first)) {
+        uint32_t low = 0U;
+        uint32_t high = sector_count - 1U;
+
+        while (low < high) {
+            const uint32_t middle = low + ((high - low + 1U) / 2U);
+
+            if (sector_in_current_lap(middle, &first)) {
+                low = middle;
+            } else {
+                high = middle - 1U;
+            }
+        }
+
+        head_sector = low;
+    }
+
+    const uint32_t base = head_sector * RING_ENTRIES_PER_SECTOR;
+    const uint32_t next_sector_base =
+        ((head_sector + 1U) % sector_count) * RING_ENTRIES_PER_SECTOR;
+
+    // Count the programmed prefix of the head sector.
+    uint32_t low = 0U;
+    uint32_t high = RING_ENTRIES_PER_SECTOR;
+
+    while (low < high) {
+        const uint32_t middle = low + ((high - low) / 2U);
+
+        if (slot_is_erased(base + middle)) {
+            high = middle;
+        } else {
+            low = middle + 1U;
+        }
+    }
+
+    const uint32_t programmed = low;
+    s_ring.has_latest = false;
+    s_ring.next_slot = next_sector_base;
+
+    if ((programmed > 0U) && read_entry(base + programmed - 1U, &s_ring.latest)) {
+        s_ring.has_latest = true;
+        if (programmed < RING_ENTRIES_PER_SECTOR) {
+            s_ring.next_slot = base + programmed;
+        }
+    } else if ((programmed > 1U) &&
+               read_entry(base + programmed - 2U, &s_ring.latest)) {
+        ESP_LOGW(RING_TAG, "Skipping torn ring entry");
+        s_ring.has_latest = true;
+    } else if (head_sector == (sector_count - 1U)) {
+        // Nothing valid anywhere: start again at the first data sector.
+        s_ring.next_slot = 0U;
+    }
+}
+
+esp_err_t flash_ring_init(void)
+{
+    if (s_ring.partition != NULL) {
+        return ESP_OK;
+    }
+
+    const esp_partition_t *partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA,
+        ESP_PARTITION_SUBTYPE_ANY,
+        RING_PARTITION_LABEL);
+
+    if (partition == NULL) {
+        ESP_LOGE(RING_TAG, "Partition '%s' was not found", RING_PARTITION_LABEL);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    if (!partition->encrypted) {
+        ESP_LOGE(
+            RING_TAG,
+            "Partition '%s' is not marked encrypted",
+            RING_PARTITION_LABEL);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (((partition->size % RING_SECTOR_SIZE) != 0U) ||
+        (partition->size <
+         ((RING_HEADER_SECTOR_COUNT + RING_MIN_DATA_SECTORS) * RING_SECTOR_SIZE))) {
+        ESP_LOGE(
+            RING_TAG,
+            "Partition '%s' size %u is not usable",
+            RING_PARTITION_LABEL,
+            (unsigned int)partition->size);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    memset(&s_ring, 0, sizeof(s_ring));
+    s_ring.partition = partition;
+    s_ring.data_sector_count =
+        (partition->size / RING_SECTOR_SIZE) - RING_HEADER_SECTOR_COUNT;
+
+    const esp_err_t result = load_header();
+    if (result != ESP_OK) {
+        s_ring.partition = NULL;
+        return result;
+    }
+
+    recover_head();
+
+    ESP_LOGI(
+        RING_TAG,
+        "Ring ready: %u slots, next slot %u, newest sequence %u",
+        (unsigned int)(s_ring.data_sector_count * RING_ENTRIES_PER_SECTOR),
+        (unsigned int)s_ring.next_slot,
+        s_ring.has_latest ? (unsigned int)s_ring.latest.sequence : 0U);
+    return ESP_OK;
+}
+
+esp_err_t flash_ring_append(const void *payload, size_t length)
+{
+    if ((payload == NULL) && (length > 0U)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (length > FLASH_RING_MAX_PAYLOAD_SIZE) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    if (s_ring.partition == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const uint32_t slot = s_ring.next_slot;
+    const uint32_t slot_count =
+        s_ring.data_sector_count * RING_ENTRIES_PER_SECTOR;
+    const bool sector_start = (slot % RING_ENTRIES_PER_SECTOR) == 0U;
+
+    esp_err_t result = ESP_OK;
+
+    // Entering a sector is the only time the ring erases.
+    if (sector_start) {
+        result = esp_partition_erase_range(
+            s_ring.partition,
+            slot_offset(slot),
+            RING_SECTOR_SIZE);
+        if (result != ESP_OK) {
+            ESP_LOGE(RING_TAG, "Ring erase failed: %s", esp_err_to_name(result));
+            return result;
+        }
+    }
+
+    ring_entry_t entry = {
+        .sequence = s_ring.has_latest ? (s_ring.latest.sequence + 1U) : 1U,
+        .magic = RING_ENTRY_MAGIC,
+        .length = (uint8_t)length,
+        .reserved = 0U,
+        .payload = {0},
+        .checksum = 0U,
+    };
+    if (length > 0U) {
+        memcpy(entry.payload, payload, length);
+    }
+    entry.checksum = calculate_entry_checksum(&entry);
+
+    result = esp_partition_write(
+        s_ring.partition,
+        slot_offset(slot),
+        &entry,
+        sizeof(entry));
+
+    ring_entry_t verification;
+    if ((result == ESP_OK) &&
+        (!read_entry(slot, &verification) ||
+         (memcmp(&verification, &entry, sizeof(entry)) != 0))) {
+        result = ESP_ERR_INVALID_CRC;
+    }
+
+    if (result != ESP_OK) {
+        // A partly programmed slot cannot be rewritten. A torn first slot
+        // is recovered by erasing its sector again; otherwise the ring
+        // resumes in the next sector, exactly as boot-time recovery would.
+        ESP_LOGE(RING_TAG, "Ring write failed: %s", esp_err_to_name(result));
+        if (!sector_start) {
+            s_ring.next_slot =
+                (((slot / RING_ENTRIES_PER_SECTOR) + 1U) *
+                 RING_ENTRIES_PER_SECTOR) % slot_count;
+        }
+        return result;
+    }
+
+    s_ring.latest = entry;
+    s_ring.has_latest = true;
+    s_ring.next_slot = (slot + 1U) % slot_count;
+    return ESP_OK;
+}
+
+esp_err_t flash_ring_read_latest(
+    void *payload,
+    size_t capacity,
+    size_t *length,
+    uint32_t *sequence)
+{
+    if ((length == NULL) || ((payload == NULL) && (capacity > 0U))) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (s_ring.partition == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (!s_ring.has_latest) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    if (s_ring.latest.length > capacity) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    memcpy(payload, s_ring.latest.payload, s_ring.latest.length);
+    *length = s_ring.latest.length;
+    if (sequence != NULL) {
+        *sequence = s_ring.latest.sequence;
+    }
+
+    return ESP_OK;
+}
@@ -0,0 +1,83 @@
+#ifndef FLASH_RING_H
+#define FLASH_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define FLASH_RING_MAX_PAYLOAD_SIZE 20U
+
+/**
+ * @brief Opens the raw flash ring and recovers its newest entry.
+ *
+ * The ring lives directly in the "ring" partition without a filesystem.
+ * Two header sectors hold the ring geometry in a ping-pong pair; the
+ * remaining sectors hold fixed-size entries written in order. Boot-time
+ * recovery binary-searches for the head, so it reads O(log n) entries
+ * instead of scanning the partition. A missing or mismatched header
+ * formats the ring.
+ *
+ * Returns:
+ *     ESP_OK when the ring is ready.
+ *     ESP_ERR_NOT_FOUND when the ring partition does not exist.
+ *     ESP_ERR_INVALID_STATE when the partition is not marked encrypted.
+ *     ESP_ERR_INVALID_SIZE when the partition is too small or misaligned.
+ *     Another ESP-IDF error code when a flash operation fails.
+ */
+esp_err_t flash_ring_init(void);
+
+/**
+ * @brief Appends one entry to the ring.
+ *
+ * An append is a single program of one 32-byte entry, which is aligned
+ * for flash encryption. When the head enters a new sector the sector is
+ * erased first, so erases rotate through the whole ring.
+ *
+ * Args:
+ *     payload: Bytes to store.
+ *     length: Number of bytes in payload.
+ *
+ * Returns:
+ *     ESP_OK when the entry is written and verified.
+ *     ESP_ERR_INVALID_ARG when payload is NULL and length is not zero.
+ *     ESP_ERR_INVALID_SIZE when length exceeds FLASH_RING_MAX_PAYLOAD_SIZE.
+ *     ESP_ERR_INVALID_STATE when the ring is not initialized.
+ *     ESP_ERR_INVALID_CRC when the written entry does not read back.
+ *     Another ESP-IDF error code when a flash operation fails.
+ */
+esp_err_t flash_ring_append(const void *payload, size_t length);
+
+/**
+ * @brief Copies the newest entry of the ring.
+ *
+ * The newest entry is cached in RAM, so this does not access flash.
+ *
+ * Args:
+ *     payload: Destination buffer.
+ *     capacity: Size of the destination buffer.
+ *     length: Receives the entry length.
+ *     sequence: Optional; receives the entry sequence number.
+ *
+ * Returns:
+ *     ESP_OK when an entry is copied.
+ *     ESP_ERR_NOT_FOUND when the ring is empty.
+ *     ESP_ERR_INVALID_ARG when a required pointer is NULL.
+ *     ESP_ERR_INVALID_STATE when the ring is not initialized.
+ *     ESP_ERR_INVALID_SIZE when capacity is too small.
+ */
+esp_err_t flash_ring_read_latest(
+    void *payload,
+    size_t capacity,
+    size_t *length,
+    uint32_t *sequence);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
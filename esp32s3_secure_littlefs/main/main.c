@@ -1,4 +1,5 @@
 #include <inttypes.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -7,13 +8,31 @@
 #include "esp_system.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "sdkconfig.h"
 
+#include "flash_ring.h"
 #include "secure_storage.h"
+#include "storage_benchmark.h"
 
 #define APP_TAG "secure_littlefs"
 #define STORAGE_TASK_STACK_SIZE 6144U
 #define STORAGE_TASK_PRIORITY 5U
 #define STORAGE_TEST_INTERVAL_MS 15000U
+#define DEMO_BLOB_NAME "demo_image"
+#define DEMO_BLOB_SIZE (128U * 1024U)
+
+/**
+ * @brief Tracks the position within the generated demonstration blob.
+ */
+typedef struct {
+    size_t offset;
+    bool mismatch;
+} demo_blob_cursor_t;
+
+// Placeholder key; production firmware must derive the blob key on the
+// device, for example from the eFuse-backed HMAC peripheral.
+static const uint8_t DEMO_BLOB_KEY[SECURE_STORAGE_BLOB_KEY_SIZE] =
+    "DEMO-BLOB-KEY-NOT-A-REAL-SECRET";
 
 /**
  * @brief Builds the demonstration payload stored in LittleFS.
@@ -82,11 +101,238 @@ static void print_demonstration_record(
         (const char *)record->payload);
 }
 
+/**
+ * @brief Appends the next value of the demonstration update counter.
+ *
+ * Frequently changing values go to the append-only journal, where each
+ * update is one small append instead of a full record replacement.
+ *
+ * Args:
+ *     counter: Last persisted counter value; incremented on success.
+ *
+ * Returns:
+ *     ESP_OK when the new value is journaled.
+ *     Another ESP-IDF error code when the append fails.
+ */
+static esp_err_t append_update_counter(uint32_t *counter)
+{
+    secure_storage_record_t entry = {
+        .sequence = *counter + 1U,
+        .payload_length = 0U,
+        .payload = {0},
+    };
+
+    const int written = snprintf(
+        (char *)entry.payload,
+        SECURE_STORAGE_JOURNAL_MAX_PAYLOAD_SIZE,
+        "{\"updates\":%" PRIu32 "}",
+        entry.sequence);
+
+    if ((written < 0) ||
+        ((size_t)written >= SECURE_STORAGE_JOURNAL_MAX_PAYLOAD_SIZE)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    entry.payload_length = (size_t)written;
+
+    const esp_err_t result = secure_storage_append_journal(&entry);
+    if (result == ESP_OK) {
+        *counter = entry.sequence;
+        ESP_LOGI(APP_TAG, "Journaled update counter: %" PRIu32, *counter);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Returns one byte of the deterministic demonstration blob.
+ *
+ * Args:
+ *     offset: Byte position within the blob.
+ *
+ * Returns:
+ *     The byte expected at offset.
+ */
+static uint8_t demo_blob_byte(size_t offset)
+{
+    uint32_t value = (uint32_t)offset * 2654435761UL;
+    value ^= value >> 15;
+    return (uint8_t)value;
+}
+
+/**
+ * @brief Produces the demonstration blob in caller-sized pieces.
+ *
+ * Args:
+ *     context: demo_blob_cursor_t tracking the write position.
+ *     buffer: Destination for generated bytes.
+ *     capacity: Maximum number of bytes to produce.
+ *     produced: Receives the number of bytes generated.
+ *
+ * Returns:
+ *     ESP_OK always.
+ */
+static esp_err_t produce_demo_blob(
+    void *context,
+    uint8_t *buffer,
+    size_t capacity,
+    size_t *produced)
+{
+    demo_blob_cursor_t *cursor = context;
+    size_t count = DEMO_BLOB_SIZE - cursor->offset;
+
+    if (count > capacity) {
+        count = capacity;
+    }
+
+    for (size_t index = 0U; index < count; ++index) {
+        buffer[index] = demo_blob_byte(cursor->offset + index);
+    }
+
+    cursor->offset += count;
+    *produced = count;
+    return ESP_OK;
+}
+
+/**
+ * @brief Compares loaded blob bytes with the generated sequence.
+ *
+ * Args:
+ *     context: demo_blob_cursor_t tracking the read position.
+ *     data: Verified plaintext from the blob.
+ *     length: Number of bytes in data.
+ *
+ * Returns:
+ *     ESP_OK always; mismatches are recorded in the cursor.
+ */
+static esp_err_t verify_demo_blob(
+    void *context,
+    const uint8_t *data,
+    size_t length)
+{
+    demo_blob_cursor_t *cursor = context;
+
+    for (size_t index = 0U; index < length; ++index) {
+        if (data[index] != demo_blob_byte(cursor->offset + index)) {
+            cursor->mismatch = true;
+        }
+    }
+
+    cursor->offset += length;
+    return ESP_OK;
+}
+
+/**
+ * @brief Stores the demonstration blob and streams it back for comparison.
+ *
+ * The blob is far larger than the chunk buffers, which shows that the
+ * memory needed for encrypted blobs does not grow with their size.
+ *
+ * Returns:
+ *     ESP_OK when the blob round-trips unchanged.
+ *     ESP_ERR_INVALID_RESPONSE when the loaded content differs.
+ *     Another ESP-IDF error code when storing or loading fails.
+ */
+static esp_err_t round_trip_demo_blob(void)
+{
+    esp_err_t result = secure_storage_set_blob_key(DEMO_BLOB_KEY);
+
+    demo_blob_cursor_t writer = {0};
+    if (result == ESP_OK) {
+        result = secure_storage_store_blob(
+            DEMO_BLOB_NAME,
+            produce_demo_blob,
+            &writer);
+    }
+
+    demo_blob_cursor_t reader = {0};
+    size_t loaded_length = 0U;
+    if (result == ESP_OK) {
+        result = secure_storage_load_blob(
+            DEMO_BLOB_NAME,
+            verify_demo_blob,
+            &reader,
+            &loaded_length);
+    }
+
+    if ((result == ESP_OK) &&
+        (reader.mismatch || (loaded_length != DEMO_BLOB_SIZE))) {
+        result = ESP_ERR_INVALID_RESPONSE;
+    }
+
+    if (result == ESP_OK) {
+        ESP_LOGI(
+            APP_TAG,
+            "Encrypted blob verified: %u bytes",
+            (unsigned int)loaded_length);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Checkpoints the accumulated uptime in the raw flash ring.
+ *
+ * Each checkpoint is one small flash program without filesystem overhead,
+ * which suits state saved as often as once per second.
+ *
+ * Args:
+ *     base_seconds: Uptime accumulated before this boot.
+ *
+ * Returns:
+ *     ESP_OK when the checkpoint is written.
+ *     Another ESP-IDF error code when the append fails.
+ */
+static esp_err_t checkpoint_uptime(uint32_t base_seconds)
+{
+    const uint32_t total_seconds =
+        base_seconds + (uint32_t)(xTaskGetTickCount() / configTICK_RATE_HZ);
+
+    return flash_ring_append(&total_seconds, sizeof(total_seconds));
+}
+
+/**
+ * @brief Increments the boot counter kept in the keyed store.
+ *
+ * Returns:
+ *     ESP_OK when the new count is stored.
+ *     Another ESP-IDF error code when reading or writing fails.
+ */
+static esp_err_t update_boot_count(void)
+{
+    uint32_t boot_count = 0U;
+    size_t length = 0U;
+
+    esp_err_t result = secure_storage_get(
+        "boot_count",
+        &boot_count,
+        sizeof(boot_count),
+        &length);
+
+    if ((result == ESP_OK) && (length != sizeof(boot_count))) {
+        result = ESP_ERR_INVALID_SIZE;
+    }
+
+    if ((result != ESP_OK) && (result != ESP_ERR_NOT_FOUND)) {
+        return result;
+    }
+
+    boot_count = (result == ESP_OK) ? (boot_count + 1U) : 1U;
+    result = secure_storage_put("boot_count", &boot_count, sizeof(boot_count));
+    if (result == ESP_OK) {
+        ESP_LOGI(APP_TAG, "Boot count: %" PRIu32, boot_count);
+    }
+
+    return result;
+}
+
 /**
  * @brief Executes the recurring secure storage verification workflow.
  *
  * The task loads the most recent valid record, increments its sequence number,
- * atomically stores a new record, and reads it back for verification.
+ * atomically stores a new record, and reads it back for verification. It also
+ * appends an update counter to the journal on every pass, and checkpoints
+ * the accumulated uptime in the flash ring. At start-up it also
+ * round-trips a large encrypted blob.
  *
  * Args:
  *     context: Unused FreeRTOS task context.
@@ -98,6 +344,32 @@ static void secure_storage_task(void *context)
     uint32_t next_sequence = 1U;
     secure_storage_record_t existing_record = {0};
 
+#if CONFIG_SECURE_STORAGE_BENCHMARK
+    const esp_err_t benchmark_result = storage_benchmark_run();
+    if (benchmark_result != ESP_OK) {
+        ESP_LOGE(
+            APP_TAG,
+            "Storage benchmark failed: %s",
+            esp_err_to_name(benchmark_result));
+    }
+#endif
+
+    const esp_err_t boot_result = update_boot_count();
+    if (boot_result != ESP_OK) {
+        ESP_LOGE(
+            APP_TAG,
+            "Boot counter update failed: %s",
+            esp_err_to_name(boot_result));
+    }
+
+    const esp_err_t blob_result = round_trip_demo_blob();
+    if (blob_result != ESP_OK) {
+        ESP_LOGE(
+            APP_TAG,
+            "Encrypted blob round trip failed: %s",
+            esp_err_to_name(blob_result));
+    }
+
     const esp_err_t load_result =
         secure_storage_load_record(&existing_record);
 
@@ -113,6 +385,35 @@ static void secure_storage_task(void *context)
             esp_err_to_name(load_result));
     }
 
+    uint32_t update_counter = 0U;
+    secure_storage_record_t counter_record = {0};
+    const esp_err_t journal_result =
+        secure_storage_load_journal(&counter_record);
+
+    if (journal_result == ESP_OK) {
+        update_counter = counter_record.sequence;
+        ESP_LOGI(APP_TAG, "Recovered update counter: %" PRIu32, update_counter);
+    } else if (journal_result != ESP_ERR_NOT_FOUND) {
+        ESP_LOGE(
+            APP_TAG,
+            "Journal recovery failed: %s",
+            esp_err_to_name(journal_result));
+    }
+
+    uint32_t uptime_base = 0U;
+    size_t uptime_length = 0U;
+    const esp_err_t ring_result = flash_ring_read_latest(
+        &uptime_base,
+        sizeof(uptime_base),
+        &uptime_length,
+        NULL);
+
+    if ((ring_result == ESP_OK) && (uptime_length == sizeof(uptime_base))) {
+        ESP_LOGI(APP_TAG, "Recovered uptime checkpoint: %" PRIu32 " s", uptime_base);
+    } else {
+        uptime_base = 0U;
+    }
+
     while (true) {
         secure_storage_record_t new_record = {
             .sequence = next_sequence,
@@ -144,6 +445,23 @@ static void secure_storage_task(void *context)
                 esp_err_to_name(result));
         }
 
+        const esp_err_t counter_result = append_update_counter(&update_counter);
+        if (counter_result != ESP_OK) {
+            ESP_LOGE(
+                APP_TAG,
+                "Journal append failed: %s",
+                esp_err_to_name(counter_result));
+        }
+
+        const esp_err_t checkpoint_result = checkpoint_uptime(uptime_base);
+        if ((checkpoint_result != ESP_OK) &&
+            (checkpoint_result != ESP_ERR_INVALID_STATE)) {
+            ESP_LOGE(
+                APP_TAG,
+                "Uptime checkpoint failed: %s",
+                esp_err_to_name(checkpoint_result));
+        }
+
         (void)secure_storage_print_usage();
         vTaskDelay(pdMS_TO_TICKS(STORAGE_TEST_INTERVAL_MS));
     }
@@ -177,6 +495,15 @@ void app_main(void)
         return;
     }
 
+    // The raw flash ring is optional; the demo runs without it.
+    const esp_err_t ring_result = flash_ring_init();
+    if (ring_result != ESP_OK) {
+        ESP_LOGW(
+            APP_TAG,
+            "Flash ring unavailable: %s",
+            esp_err_to_name(ring_result));
+    }
+
     // Create the secure storage task.
     const BaseType_t task_result = xTaskCreate(
         secure_storage_task,
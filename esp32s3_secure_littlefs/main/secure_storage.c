@@ -2,28 +2,53 @@
 
 #include <errno.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include "arena.h"
 #include "esp_flash_encrypt.h"
+#include "esp_heap_caps.h"
 #include "esp_littlefs.h"
 #include "esp_log.h"
 #include "esp_partition.h"
+#include "esp_random.h"
 #include "esp_secure_boot.h"
+#include "mbedtls/gcm.h"
+#include "mbedtls/platform_util.h"
 
 #define STORAGE_TAG "secure_storage"
 #define STORAGE_PARTITION_LABEL "storage"
-#define STORAGE_BASE_PATH "/littlefs"
+#define STORAGE_BASE_PATH SECURE_STORAGE_BASE_PATH
 #define STORAGE_PRIMARY_PATH STORAGE_BASE_PATH "/device_record.bin"
 #define STORAGE_BACKUP_PATH STORAGE_BASE_PATH "/device_record.bak"
 #define STORAGE_TEMP_PATH STORAGE_BASE_PATH "/device_record.tmp"
+#define STORAGE_JOURNAL_PATH STORAGE_BASE_PATH "/device_journal.log"
+#define STORAGE_JOURNAL_TEMP_PATH STORAGE_BASE_PATH "/device_journal.tmp"
+#define STORAGE_KV_PATH STORAGE_BASE_PATH "/device_store.kv"
+#define STORAGE_BLOB_SUFFIX ".blob"
+#define STORAGE_BLOB_TEMP_SUFFIX ".btmp"
+#define STORAGE_BLOB_PATH_SIZE                                               \
+    (sizeof(STORAGE_BASE_PATH "/") + SECURE_STORAGE_BLOB_NAME_MAX_LENGTH + \
+     sizeof(STORAGE_BLOB_TEMP_SUFFIX))
 
 #define RECORD_MAGIC 0x53524631UL
 #define RECORD_FORMAT_VERSION 1U
 #define FNV1A_OFFSET_BASIS 2166136261UL
 #define FNV1A_PRIME 16777619UL
+#define JOURNAL_ENTRY_MAGIC 0x534A4531UL
+#define JOURNAL_FORMAT_VERSION 1U
+#define KV_SLOT_MAGIC 0x534B5631UL
+#define KV_FORMAT_VERSION 1U
+#define KV_SLOTS_PER_KEY 2U
+#define BLOB_MAGIC 0x53424C31UL
+#define BLOB_FORMAT_VERSION 1U
+#define BLOB_NONCE_PREFIX_SIZE 8U
+#define BLOB_NONCE_SIZE 12U
+#define BLOB_TAG_SIZE 16U
+#define BLOB_SEALED_CHUNK_SIZE (SECURE_STORAGE_BLOB_CHUNK_SIZE + BLOB_TAG_SIZE)
 
 /**
  * @brief Defines the serialized header stored before every payload.
@@ -38,7 +63,114 @@ typedef struct {
     uint32_t header_checksum;
 } storage_record_header_t;
 
+/**
+ * @brief Defines one fixed-size journal entry.
+ *
+ * The checksum covers every preceding byte of the entry, so a torn append
+ * fails validation regardless of where the write stopped.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t format_version;
+    uint16_t payload_length;
+    uint32_t journal_sequence;
+    uint32_t record_sequence;
+    uint8_t payload[SECURE_STORAGE_JOURNAL_MAX_PAYLOAD_SIZE];
+    uint32_t checksum;
+} storage_journal_entry_t;
+
+/**
+ * @brief Caches the journal state found by the last scan.
+ */
+typedef struct {
+    bool scanned;
+    bool has_latest;
+    uint32_t entry_count;
+    storage_journal_entry_t latest;
+} storage_journal_state_t;
+
+/**
+ * @brief Defines the header at the start of every key-value slot.
+ *
+ * A slot is the header followed by SECURE_STORAGE_VALUE_MAX_SIZE value
+ * bytes, so slot offsets follow from the slot index alone.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t format_version;
+    uint16_t value_length;
+    uint32_t generation;
+    char key[SECURE_STORAGE_KEY_MAX_LENGTH + 1U];
+    uint32_t value_checksum;
+    uint32_t header_checksum;
+} storage_kv_header_t;
+
+/**
+ * @brief Defines one complete serialized key-value slot.
+ */
+typedef struct {
+    storage_kv_header_t header;
+    uint8_t value[SECURE_STORAGE_VALUE_MAX_SIZE];
+} storage_kv_slot_t;
+
+/**
+ * @brief Describes one key in the in-RAM index.
+ */
+typedef struct {
+    char key[SECURE_STORAGE_KEY_MAX_LENGTH + 1U];
+    uint32_t pair_index;
+    uint32_t generation;
+    uint8_t active_slot;
+} storage_kv_index_entry_t;
+
+/**
+ * @brief Holds the open key-value file and its index.
+ */
+typedef struct {
+    FILE *stream;
+    size_t key_count;
+    uint32_t pair_count;
+    storage_kv_index_entry_t entries[SECURE_STORAGE_MAX_KEYS];
+} storage_kv_state_t;
+
+/**
+ * @brief Defines the header at the start of every encrypted blob.
+ *
+ * The header is followed by sealed chunks, each holding up to chunk_size
+ * ciphertext bytes and a BLOB_TAG_SIZE tag. The first chunk shorter than
+ * chunk_size is the final one; a blob whose length is an exact multiple of
+ * chunk_size ends with an empty final chunk.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t format_version;
+    uint16_t header_size;
+    uint32_t chunk_size;
+    uint8_t nonce_prefix[BLOB_NONCE_PREFIX_SIZE];
+    uint32_t header_checksum;
+} storage_blob_header_t;
+
+/**
+ * @brief Holds the per-operation blob buffers.
+ *
+ * Both buffers come from one DMA-capable arena so the AES peripheral can
+ * work on them without bounce copies.
+ */
+typedef struct {
+    uint8_t *plaintext;
+    uint8_t *sealed;
+} storage_blob_buffers_t;
+
 static bool s_is_mounted;
+static storage_journal_state_t s_journal;
+static storage_kv_state_t s_kv;
+// Slot buffer shared by the key-value functions; too large for task stacks.
+static storage_kv_slot_t s_kv_slot;
+static mbedtls_gcm_context s_blob_gcm;
+static bool s_blob_key_set;
+// Reserved on the first blob operation and kept until deinit, so repeated
+// blob operations do not allocate and free 8 KB of internal RAM each time.
+static arena_t s_blob_arena;
 
 /**
  * @brief Calculates a 32-bit FNV-1a checksum.
@@ -366,191 +498,947 @@ static esp_err_t restore_primary_from_backup(
     return ESP_OK;
 }
 
-esp_err_t secure_storage_init(void)
+/**
+ * @brief Calculates the checksum of a journal entry.
+ *
+ * Args:
+ *     entry: Entry to checksum.
+ *
+ * Returns:
+ *     FNV-1a checksum of every byte before the checksum field.
+ */
+static uint32_t calculate_journal_checksum(const storage_journal_entry_t *entry)
 {
-    if (s_is_mounted) {
-        return ESP_OK;
-    }
+    return calculate_fnv1a(
+        (const uint8_t *)entry,
+        offsetof(storage_journal_entry_t, checksum));
+}
 
-    const esp_partition_t *partition = esp_partition_find_first(
-        ESP_PARTITION_TYPE_DATA,
-        ESP_PARTITION_SUBTYPE_ANY,
-        STORAGE_PARTITION_LABEL);
+/**
+ * @brief Checks whether a journal entry is complete and intact.
+ *
+ * Args:
+ *     entry: Entry read from the journal.
+ *
+ * Returns:
+ *     true when the format and checksum are valid.
+ */
+static bool journal_entry_is_valid(const storage_journal_entry_t *entry)
+{
+    return (entry->magic == JOURNAL_ENTRY_MAGIC) &&
+           (entry->format_version == JOURNAL_FORMAT_VERSION) &&
+           (entry->payload_length <= SECURE_STORAGE_JOURNAL_MAX_PAYLOAD_SIZE) &&
+           (entry->checksum == calculate_journal_checksum(entry));
+}
 
-    if (partition == NULL) {
-        ESP_LOGE(
-            STORAGE_TAG,
-            "Partition '%s' was not found",
-            STORAGE_PARTITION_LABEL);
-        return ESP_ERR_NOT_FOUND;
+/**
+ * @brief Writes one journal entry to an open stream and synchronizes it.
+ *
+ * Args:
+ *     stream: Stream opened for writing or appending.
+ *     entry: Complete entry with a valid checksum.
+ *
+ * Returns:
+ *     ESP_OK when the entry is written and synchronized.
+ *     ESP_FAIL when writing or synchronization fails.
+ */
+static esp_err_t write_journal_entry(
+    FILE *stream,
+    const storage_journal_entry_t *entry)
+{
+    if (fwrite(entry, 1U, sizeof(*entry), stream) != sizeof(*entry)) {
+        ESP_LOGE(STORAGE_TAG, "Failed to write journal entry");
+        return ESP_FAIL;
     }
 
-    if (!partition->encrypted) {
-        ESP_LOGE(
-            STORAGE_TAG,
-            "Partition '%s' is not marked encrypted",
-            STORAGE_PARTITION_LABEL);
-        return ESP_ERR_INVALID_STATE;
-    }
+    return flush_and_sync(stream);
+}
 
-    const esp_vfs_littlefs_conf_t configuration = {
-        .base_path = STORAGE_BASE_PATH,
-        .partition_label = STORAGE_PARTITION_LABEL,
-        .format_if_mount_failed = false,
-        .dont_mount = false,
-    };
+/**
+ * @brief Scans the journal and recovers from an interrupted append.
+ *
+ * Entries are read in order until the first invalid one. The entry with the
+ * highest journal sequence number becomes the latest record, and anything
+ * after the last valid entry is truncated away.
+ *
+ * Returns:
+ *     ESP_OK when the journal is scanned or does not exist yet.
+ *     ESP_FAIL when reading or truncation fails.
+ */
+static esp_err_t scan_journal(void)
+{
+    memset(&s_journal, 0, sizeof(s_journal));
 
-    const esp_err_t result = esp_vfs_littlefs_register(&configuration);
+    // A leftover temporary file belongs to a compaction that never committed.
+    esp_err_t result = remove_if_present(STORAGE_JOURNAL_TEMP_PATH);
     if (result != ESP_OK) {
-        ESP_LOGE(
-            STORAGE_TAG,
-            "LittleFS mount failed: %s",
-            esp_err_to_name(result));
         return result;
     }
 
-    s_is_mounted = true;
-    ESP_LOGI(STORAGE_TAG, "LittleFS mounted at %s", STORAGE_BASE_PATH);
-    return ESP_OK;
-}
-
-esp_err_t secure_storage_deinit(void)
-{
-    if (!s_is_mounted) {
+    FILE *stream = fopen(STORAGE_JOURNAL_PATH, "rb");
+    if (stream == NULL) {
+        if (errno != ENOENT) {
+            ESP_LOGE(STORAGE_TAG, "Failed to open journal: errno=%d", errno);
+            return errno_to_esp_err(errno);
+        }
+        s_journal.scanned = true;
         return ESP_OK;
     }
 
-    const esp_err_t result =
-        esp_vfs_littlefs_unregister(STORAGE_PARTITION_LABEL);
-
-    if (result == ESP_OK) {
-        s_is_mounted = false;
-        ESP_LOGI(STORAGE_TAG, "LittleFS unmounted");
-    }
+    storage_journal_entry_t entry;
+    bool torn_tail = false;
 
-    return result;
-}
+    while (true) {
+        const size_t read = fread(&entry, 1U, sizeof(entry), stream);
+        if (read == 0U) {
+            break;
+        }
 
-void secure_storage_report_security_state(void)
-{
-    const bool flash_encryption_enabled = esp_flash_encryption_enabled();
-    const bool secure_boot_enabled = esp_secure_boot_enabled();
+        if ((read != sizeof(entry)) || !journal_entry_is_valid(&entry)) {
+            torn_tail = true;
+            break;
+        }
 
-    ESP_LOGI(
-        STORAGE_TAG,
-        "Flash Encryption: %s",
-        flash_encryption_enabled ? "ENABLED" : "DISABLED");
-    ESP_LOGI(
-        STORAGE_TAG,
-        "Secure Boot: %s",
-        secure_boot_enabled ? "ENABLED" : "DISABLED");
+        if (!s_journal.has_latest ||
+            (entry.journal_sequence > s_journal.latest.journal_sequence)) {
+            s_journal.latest = entry;
+            s_journal.has_latest = true;
+        }
+        s_journal.entry_count++;
+    }
 
-    const esp_partition_t *partition = esp_partition_find_first(
-        ESP_PARTITION_TYPE_DATA,
-        ESP_PARTITION_SUBTYPE_ANY,
-        STORAGE_PARTITION_LABEL);
+    if (ferror(stream) != 0) {
+        ESP_LOGE(STORAGE_TAG, "Failed to read journal: errno=%d", errno);
+        result = ESP_FAIL;
+    }
 
-    if (partition == NULL) {
-        ESP_LOGE(
-            STORAGE_TAG,
-            "Storage partition '%s' is missing",
-            STORAGE_PARTITION_LABEL);
-        return;
+    if (fclose(stream) != 0) {
+        ESP_LOGE(STORAGE_TAG, "Failed to close journal: errno=%d", errno);
+        result = ESP_FAIL;
     }
 
-    ESP_LOGI(
-        STORAGE_TAG,
-        "Storage partition encrypted flag: %s",
-        partition->encrypted ? "SET" : "NOT SET");
+    if ((result == ESP_OK) && torn_tail) {
+        const off_t valid_bytes =
+            (off_t)(s_journal.entry_count * sizeof(storage_journal_entry_t));
 
-    if (!flash_encryption_enabled) {
         ESP_LOGW(
             STORAGE_TAG,
-            "Raw LittleFS data is not protected until Flash Encryption is enabled");
-    }
+            "Journal ends in an invalid entry; truncating to %u entries",
+            (unsigned int)s_journal.entry_count);
 
-    if (!secure_boot_enabled) {
-        ESP_LOGW(
-            STORAGE_TAG,
-            "Unsigned firmware may bypass storage controls until Secure Boot is enabled");
+        if (truncate(STORAGE_JOURNAL_PATH, valid_bytes) != 0) {
+            ESP_LOGE(STORAGE_TAG, "Failed to truncate journal: errno=%d", errno);
+            result = ESP_FAIL;
+        }
     }
+
+    s_journal.scanned = (result == ESP_OK);
+    return result;
 }
 
-esp_err_t secure_storage_load_record(secure_storage_record_t *record)
+/**
+ * @brief Rewrites the journal so that it holds only its newest entry.
+ *
+ * The replacement is written and synchronized under a temporary path and
+ * then renamed over the journal, which LittleFS performs atomically.
+ *
+ * Returns:
+ *     ESP_OK when the compacted journal is committed.
+ *     Another ESP-IDF error code when a filesystem operation fails.
+ */
+static esp_err_t compact_journal(void)
 {
-    if (record == NULL) {
-        return ESP_ERR_INVALID_ARG;
-    }
-
-    esp_err_t primary_result =
-        read_record_file(STORAGE_PRIMARY_PATH, record);
-
-    if (primary_result == ESP_OK) {
-        return ESP_OK;
+    FILE *stream = fopen(STORAGE_JOURNAL_TEMP_PATH, "wb");
+    if (stream == NULL) {
+        ESP_LOGE(STORAGE_TAG, "Failed to open journal temp: errno=%d", errno);
+        return errno_to_esp_err(errno);
     }
 
-    secure_storage_record_t backup_record = {0};
-    const esp_err_t backup_result =
-        read_record_file(STORAGE_BACKUP_PATH, &backup_record);
-
-    if (backup_result == ESP_OK) {
-        *record = backup_record;
-        const esp_err_t restore_result =
-            restore_primary_from_backup(&backup_record);
-
-        if (restore_result != ESP_OK) {
-            ESP_LOGW(
-                STORAGE_TAG,
-                "Backup is valid, but primary restoration failed: %s",
-                esp_err_to_name(restore_result));
-        }
-
-        return ESP_OK;
+    esp_err_t result = ESP_OK;
+    if (s_journal.has_latest) {
+        result = write_journal_entry(stream, &s_journal.latest);
     }
 
-    if ((primary_result == ESP_ERR_NOT_FOUND) &&
-        (backup_result == ESP_ERR_NOT_FOUND)) {
-        return ESP_ERR_NOT_FOUND;
+    if (fclose(stream) != 0) {
+        ESP_LOGE(STORAGE_TAG, "Failed to close journal temp: errno=%d", errno);
+        result = ESP_FAIL;
     }
 
-    ESP_LOGE(
-        STORAGE_TAG,
-        "No valid record; primary=%s, backup=%s",
-        esp_err_to_name(primary_result),
-        esp_err_to_name(backup_result));
-    return ESP_ERR_INVALID_CRC;
-}
-
-esp_err_t secure_storage_store_record(
-    const secure_storage_record_t *record)
-{
-    esp_err_t result = validate_public_record(record);
-    if (result != ESP_OK) {
-        return result;
+    if ((result == ESP_OK) &&
+        (rename(STORAGE_JOURNAL_TEMP_PATH, STORAGE_JOURNAL_PATH) != 0)) {
+        ESP_LOGE(STORAGE_TAG, "Failed to commit compacted journal: errno=%d", errno);
+        result = ESP_FAIL;
     }
 
-    // Remove any temporary file left by an interrupted older transaction.
-    result = remove_if_present(STORAGE_TEMP_PATH);
     if (result != ESP_OK) {
+        (void)remove_if_present(STORAGE_JOURNAL_TEMP_PATH);
         return result;
     }
 
-    result = write_record_file(STORAGE_TEMP_PATH, record);
-    if (result != ESP_OK) {
-        (void)remove_if_present(STORAGE_TEMP_PATH);
-        return result;
-    }
+    s_journal.entry_count = s_journal.has_latest ? 1U : 0U;
+    return ESP_OK;
+}
 
-    // Read the temporary file back before replacing the committed record.
-    secure_storage_record_t verification_record = {0};
-    result = read_record_file(STORAGE_TEMP_PATH, &verification_record);
-    if (result != ESP_OK) {
-        (void)remove_if_present(STORAGE_TEMP_PATH);
-        return result;
-    }
+/**
+ * @brief Calculates the checksum for a key-value slot header.
+ *
+ * Args:
+ *     header: Header to checksum.
+ *
+ * Returns:
+ *     The checksum of every header byte except the checksum field itself.
+ */
+static uint32_t calculate_kv_header_checksum(const storage_kv_header_t *header)
+{
+    return calculate_fnv1a(
+        (const uint8_t *)header,
+        offsetof(storage_kv_header_t, header_checksum));
+}
 
-    if ((verification_record.sequence != record->sequence) ||
-        (verification_record.payload_length != record->payload_length) ||
+/**
+ * @brief Checks whether a key-value slot is complete and intact.
+ *
+ * Args:
+ *     slot: Slot read from the key-value file.
+ *
+ * Returns:
+ *     true when the header and value checksums are valid.
+ */
+static bool kv_slot_is_valid(const storage_kv_slot_t *slot)
+{
+    const storage_kv_header_t *header = &slot->header;
+
+    return (header->magic == KV_SLOT_MAGIC) &&
+           (header->format_version == KV_FORMAT_VERSION) &&
+           (header->value_length <= SECURE_STORAGE_VALUE_MAX_SIZE) &&
+           (header->key[SECURE_STORAGE_KEY_MAX_LENGTH] == '\0') &&
+           (header->key[0] != '\0') &&
+           (header->header_checksum == calculate_kv_header_checksum(header)) &&
+           (header->value_checksum ==
+            calculate_fnv1a(slot->value, header->value_length));
+}
+
+/**
+ * @brief Reads one key-value slot by index.
+ *
+ * Args:
+ *     slot_index: Slot position in the file.
+ *     slot: Destination slot.
+ *
+ * Returns:
+ *     true when a complete slot was read; false at end of file or on error.
+ */
+static bool read_kv_slot(uint32_t slot_index, storage_kv_slot_t *slot)
+{
+    const long offset = (long)(slot_index * sizeof(storage_kv_slot_t));
+
+    return (fseek(s_kv.stream, offset, SEEK_SET) == 0) &&
+           (fread(slot, 1U, sizeof(*slot), s_kv.stream) == sizeof(*slot));
+}
+
+/**
+ * @brief Finds a key in the in-RAM index.
+ *
+ * Args:
+ *     key: NUL-terminated key.
+ *
+ * Returns:
+ *     The index entry, or NULL when the key is unknown.
+ */
+static storage_kv_index_entry_t *find_kv_entry(const char *key)
+{
+    for (size_t index = 0; index < s_kv.key_count; ++index) {
+        if (strcmp(s_kv.entries[index].key, key) == 0) {
+            return &s_kv.entries[index];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Opens the key-value file and builds the in-RAM index.
+ *
+ * Each slot pair resolves to the valid slot with the higher generation.
+ * Pairs without a valid slot are the result of an interrupted first write
+ * and are reused when they sit at the end of the file.
+ *
+ * Returns:
+ *     ESP_OK when the index is loaded.
+ *     ESP_FAIL when the file cannot be opened or created.
+ */
+static esp_err_t load_kv_index(void)
+{
+    memset(&s_kv, 0, sizeof(s_kv));
+
+    s_kv.stream = fopen(STORAGE_KV_PATH, "r+b");
+    if ((s_kv.stream == NULL) && (errno == ENOENT)) {
+        s_kv.stream = fopen(STORAGE_KV_PATH, "w+b");
+    }
+
+    if (s_kv.stream == NULL) {
+        ESP_LOGE(STORAGE_TAG, "Failed to open key-value store: errno=%d", errno);
+        return ESP_FAIL;
+    }
+
+    storage_kv_slot_t *slot = &s_kv_slot;
+
+    for (uint32_t pair = 0U; ; ++pair) {
+        storage_kv_index_entry_t candidate = {0};
+        bool found = false;
+        bool at_end = false;
+
+        for (uint8_t half = 0U; half < KV_SLOTS_PER_KEY; ++half) {
+            if (!read_kv_slot((pair * KV_SLOTS_PER_KEY) + half, slot)) {
+                at_end = (half == 0U);
+                break;
+            }
+
+            if (kv_slot_is_valid(slot) &&
+                (!found || (slot->header.generation > candidate.generation))) {
+                memcpy(candidate.key, slot->header.key, sizeof(candidate.key));
+                candidate.pair_index = pair;
+                candidate.generation = slot->header.generation;
+                candidate.active_slot = half;
+                found = true;
+            }
+        }
+
+        if (at_end) {
+            break;
+        }
+
+        if (!found) {
+            continue;
+        }
+
+        if ((s_kv.key_count >= SECURE_STORAGE_MAX_KEYS) ||
+            (find_kv_entry(candidate.key) != NULL)) {
+            ESP_LOGW(STORAGE_TAG, "Ignoring extra key-value pair %u",
+                     (unsigned int)pair);
+            continue;
+        }
+
+        s_kv.entries[s_kv.key_count++] = candidate;
+        s_kv.pair_count = pair + 1U;
+    }
+
+    ESP_LOGI(STORAGE_TAG, "Key-value index loaded: %u keys",
+             (unsigned int)s_kv.key_count);
+    return ESP_OK;
+}
+
+/**
+ * @brief Checks that a blob name is safe to use in a file name.
+ *
+ * Args:
+ *     name: Candidate blob name.
+ *
+ * Returns:
+ *     true for 1 to SECURE_STORAGE_BLOB_NAME_MAX_LENGTH lowercase letters,
+ *     digits, or underscores.
+ */
+static bool blob_name_is_valid(const char *name)
+{
+    if (name == NULL) {
+        return false;
+    }
+
+    size_t length = 0U;
+    for (; name[length] != '\0'; ++length) {
+        const char character = name[length];
+        const bool allowed = ((character >= 'a') && (character <= 'z')) ||
+                             ((character >= '0') && (character <= '9')) ||
+                             (character == '_');
+
+        if (!allowed || (length >= SECURE_STORAGE_BLOB_NAME_MAX_LENGTH)) {
+            return false;
+        }
+    }
+
+    return length > 0U;
+}
+
+/**
+ * @brief Calculates the checksum for a blob header.
+ *
+ * Args:
+ *     header: Header to checksum.
+ *
+ * Returns:
+ *     The checksum of every header byte except the checksum field itself.
+ */
+static uint32_t calculate_blob_header_checksum(
+    const storage_blob_header_t *header)
+{
+    return calculate_fnv1a(
+        (const uint8_t *)header,
+        offsetof(storage_blob_header_t, header_checksum));
+}
+
+/**
+ * @brief Takes the DMA-capable buffers for one blob operation.
+ *
+ * The blob arena is reserved on first use and then reused by every later
+ * operation.
+ *
+ * Args:
+ *     buffers: Receives the plaintext and sealed chunk buffers.
+ *
+ * Returns:
+ *     ESP_OK when the buffers are available.
+ *     ESP_ERR_NO_MEM when DMA-capable memory is exhausted.
+ */
+static esp_err_t allocate_blob_buffers(storage_blob_buffers_t *buffers)
+{
+    if (s_blob_arena.base == NULL) {
+        const arena_config_t configuration = {
+            .size = SECURE_STORAGE_BLOB_CHUNK_SIZE + BLOB_SEALED_CHUNK_SIZE,
+            .caps = MALLOC_CAP_DMA | MALLOC_CAP_INTERNAL,
+            .fallback_caps = 0U,
+        };
+
+        if (arena_init(&s_blob_arena, &configuration) != ESP_OK) {
+            ESP_LOGE(STORAGE_TAG, "Failed to allocate blob chunk buffers");
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    buffers->plaintext = arena_alloc(&s_blob_arena, SECURE_STORAGE_BLOB_CHUNK_SIZE);
+    buffers->sealed = arena_alloc(&s_blob_arena, BLOB_SEALED_CHUNK_SIZE);
+    if ((buffers->plaintext == NULL) || (buffers->sealed == NULL)) {
+        arena_reset(&s_blob_arena);
+        buffers->plaintext = NULL;
+        buffers->sealed = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Wipes plaintext from the blob buffers and returns them to the arena.
+ *
+ * Args:
+ *     buffers: Buffers returned by allocate_blob_buffers().
+ */
+static void free_blob_buffers(storage_blob_buffers_t *buffers)
+{
+    if (buffers->plaintext != NULL) {
+        mbedtls_platform_zeroize(
+            buffers->plaintext,
+            SECURE_STORAGE_BLOB_CHUNK_SIZE);
+        arena_reset(&s_blob_arena);
+    }
+
+    buffers->plaintext = NULL;
+    buffers->sealed = NULL;
+}
+
+/**
+ * @brief Encrypts or decrypts one blob chunk with AES-GCM.
+ *
+ * The nonce is the blob's random prefix followed by the big-endian chunk
+ * index. The header, chunk index, and final flag are authenticated, so a
+ * chunk cannot be moved, dropped, or relabelled as the last one.
+ *
+ * Args:
+ *     header: Header of the blob the chunk belongs to.
+ *     chunk_index: Position of the chunk in the blob.
+ *     is_final: true for the final chunk.
+ *     input: Plaintext when sealing; ciphertext when opening.
+ *     length: Number of bytes in input.
+ *     output: Ciphertext when sealing; plaintext when opening.
+ *     tag: Tag written when sealing; tag verified when opening.
+ *     seal: true to encrypt; false to decrypt and verify.
+ *
+ * Returns:
+ *     ESP_OK on success.
+ *     ESP_ERR_INVALID_CRC when an opened chunk fails authentication.
+ *     ESP_FAIL for another cipher error.
+ */
+static esp_err_t crypt_blob_chunk(
+    const storage_blob_header_t *header,
+    uint32_t chunk_index,
+    bool is_final,
+    const uint8_t *input,
+    size_t length,
+    uint8_t *output,
+    uint8_t *tag,
+    bool seal)
+{
+    uint8_t nonce[BLOB_NONCE_SIZE];
+    memcpy(nonce, header->nonce_prefix, BLOB_NONCE_PREFIX_SIZE);
+    nonce[8] = (uint8_t)(chunk_index >> 24);
+    nonce[9] = (uint8_t)(chunk_index >> 16);
+    nonce[10] = (uint8_t)(chunk_index >> 8);
+    nonce[11] = (uint8_t)chunk_index;
+
+    uint8_t additional_data[sizeof(*header) + 5U];
+    memcpy(additional_data, header, sizeof(*header));
+    memcpy(&additional_data[sizeof(*header)], &nonce[8], 4U);
+    additional_data[sizeof(*header) + 4U] = is_final ? 1U : 0U;
+
+    int status;
+    if (seal) {
+        status = mbedtls_gcm_crypt_and_tag(
+            &s_blob_gcm,
+            MBEDTLS_GCM_ENCRYPT,
+            length,
+            nonce,
+            sizeof(nonce),
+            additional_data,
+            sizeof(additional_data),
+            input,
+            output,
+            BLOB_TAG_SIZE,
+            tag);
+    } else {
+        status = mbedtls_gcm_auth_decrypt(
+            &s_blob_gcm,
+            length,
+            nonce,
+            sizeof(nonce),
+            additional_data,
+            sizeof(additional_data),
+            tag,
+            BLOB_TAG_SIZE,
+            input,
+            output);
+    }
+
+    if (status == MBEDTLS_ERR_GCM_AUTH_FAILED) {
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    if (status != 0) {
+        ESP_LOGE(STORAGE_TAG, "AES-GCM failed: -0x%04x", (unsigned int)-status);
+        return ESP_FAIL;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Pulls plaintext from a blob source until a chunk is full.
+ *
+ * Args:
+ *     source: Caller's plaintext source.
+ *     context: Passed to the source.
+ *     buffer: Chunk buffer to fill.
+ *     length: Receives the number of bytes gathered.
+ *     ended: Set once the source reports the end of the blob.
+ *
+ * Returns:
+ *     ESP_OK when the chunk is gathered.
+ *     ESP_ERR_INVALID_SIZE when the source overruns the buffer.
+ *     The source's error code when it fails.
+ */
+static esp_err_t fill_blob_chunk(
+    secure_storage_blob_source_t source,
+    void *context,
+    uint8_t *buffer,
+    size_t *length,
+    bool *ended)
+{
+    *length = 0U;
+
+    while (!*ended && (*length < SECURE_STORAGE_BLOB_CHUNK_SIZE)) {
+        const size_t capacity = SECURE_STORAGE_BLOB_CHUNK_SIZE - *length;
+        size_t produced = 0U;
+
+        const esp_err_t result =
+            source(context, buffer + *length, capacity, &produced);
+        if (result != ESP_OK) {
+            return result;
+        }
+
+        if (produced > capacity) {
+            return ESP_ERR_INVALID_SIZE;
+        }
+
+        if (produced == 0U) {
+            *ended = true;
+        }
+
+        *length += produced;
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Writes a complete encrypted blob to an open stream.
+ *
+ * Args:
+ *     stream: Destination stream positioned at the start of the file.
+ *     source: Caller's plaintext source.
+ *     context: Passed to the source.
+ *     buffers: Chunk buffers for the operation.
+ *
+ * Returns:
+ *     ESP_OK when every chunk is written and synchronized.
+ *     An error from the source, the cipher, or the filesystem.
+ */
+static esp_err_t write_blob_stream(
+    FILE *stream,
+    secure_storage_blob_source_t source,
+    void *context,
+    const storage_blob_buffers_t *buffers)
+{
+    storage_blob_header_t header = {
+        .magic = BLOB_MAGIC,
+        .format_version = BLOB_FORMAT_VERSION,
+        .header_size = sizeof(storage_blob_header_t),
+        .chunk_size = SECURE_STORAGE_BLOB_CHUNK_SIZE,
+        .header_checksum = 0U,
+    };
+    // A fresh random prefix per blob keeps nonces unique under one key.
+    esp_fill_random(header.nonce_prefix, sizeof(header.nonce_prefix));
+    header.header_checksum = calculate_blob_header_checksum(&header);
+
+    if (fwrite(&header, 1U, sizeof(header), stream) != sizeof(header)) {
+        ESP_LOGE(STORAGE_TAG, "Failed to write blob header: errno=%d", errno);
+        return ESP_FAIL;
+    }
+
+    bool ended = false;
+    bool is_final = false;
+
+    for (uint32_t chunk_index = 0U; !is_final; ++chunk_index) {
+        size_t length = 0U;
+        esp_err_t result = fill_blob_chunk(
+            source,
+            context,
+            buffers->plaintext,
+            &length,
+            &ended);
+        if (result != ESP_OK) {
+            return result;
+        }
+
+        is_final = length < SECURE_STORAGE_BLOB_CHUNK_SIZE;
+        result = crypt_blob_chunk(
+            &header,
+            chunk_index,
+            is_final,
+            buffers->plaintext,
+            length,
+            buffers->sealed,
+            buffers->sealed + length,
+            true);
+        if (result != ESP_OK) {
+            return result;
+        }
+
+        const size_t sealed_length = length + BLOB_TAG_SIZE;
+        if (fwrite(buffers->sealed, 1U, sealed_length, stream) !=
+            sealed_length) {
+            ESP_LOGE(
+                STORAGE_TAG,
+                "Failed to write blob chunk %u: errno=%d",
+                (unsigned int)chunk_index,
+                errno);
+            return ESP_FAIL;
+        }
+    }
+
+    return flush_and_sync(stream);
+}
+
+/**
+ * @brief Reads, verifies, and delivers every chunk of an open blob.
+ *
+ * Args:
+ *     stream: Source stream positioned at the start of the file.
+ *     sink: Caller's plaintext sink.
+ *     context: Passed to the sink.
+ *     buffers: Chunk buffers for the operation.
+ *     total_length: Receives the number of plaintext bytes delivered.
+ *
+ * Returns:
+ *     ESP_OK when the final chunk is verified and nothing follows it.
+ *     ESP_ERR_INVALID_RESPONSE for a bad header, truncation, or trailing data.
+ *     ESP_ERR_INVALID_CRC when a chunk fails authentication.
+ *     The sink's error code, or ESP_FAIL for a read error.
+ */
+static esp_err_t read_blob_stream(
+    FILE *stream,
+    secure_storage_blob_sink_t sink,
+    void *context,
+    const storage_blob_buffers_t *buffers,
+    size_t *total_length)
+{
+    storage_blob_header_t header = {0};
+
+    if (fread(&header, 1U, sizeof(header), stream) != sizeof(header)) {
+        return ferror(stream) ? ESP_FAIL : ESP_ERR_INVALID_RESPONSE;
+    }
+
+    if ((header.magic != BLOB_MAGIC) ||
+        (header.format_version != BLOB_FORMAT_VERSION) ||
+        (header.header_size != sizeof(storage_blob_header_t)) ||
+        (header.chunk_size != SECURE_STORAGE_BLOB_CHUNK_SIZE) ||
+        (header.header_checksum != calculate_blob_header_checksum(&header))) {
+        ESP_LOGW(STORAGE_TAG, "Blob header failed validation");
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    *total_length = 0U;
+    bool is_final = false;
+
+    for (uint32_t chunk_index = 0U; !is_final; ++chunk_index) {
+        const size_t sealed_length =
+            fread(buffers->sealed, 1U, BLOB_SEALED_CHUNK_SIZE, stream);
+
+        if (ferror(stream)) {
+            ESP_LOGE(STORAGE_TAG, "Failed to read blob: errno=%d", errno);
+            return ESP_FAIL;
+        }
+
+        if (sealed_length < BLOB_TAG_SIZE) {
+            ESP_LOGW(
+                STORAGE_TAG,
+                "Blob truncated before chunk %u",
+                (unsigned int)chunk_index);
+            return ESP_ERR_INVALID_RESPONSE;
+        }
+
+        const size_t length = sealed_length - BLOB_TAG_SIZE;
+        is_final = length < SECURE_STORAGE_BLOB_CHUNK_SIZE;
+
+        esp_err_t result = crypt_blob_chunk(
+            &header,
+            chunk_index,
+            is_final,
+            buffers->sealed,
+            length,
+            buffers->plaintext,
+            buffers->sealed + length,
+            false);
+        if (result != ESP_OK) {
+            ESP_LOGW(
+                STORAGE_TAG,
+                "Blob chunk %u failed authentication",
+                (unsigned int)chunk_index);
+            return result;
+        }
+
+        result = sink(context, buffers->plaintext, length);
+        if (result != ESP_OK) {
+            return result;
+        }
+
+        *total_length += length;
+    }
+
+    if (fgetc(stream) != EOF) {
+        ESP_LOGW(STORAGE_TAG, "Blob has data after its final chunk");
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t secure_storage_init(void)
+{
+    if (s_is_mounted) {
+        return ESP_OK;
+    }
+
+    const esp_partition_t *partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA,
+        ESP_PARTITION_SUBTYPE_ANY,
+        STORAGE_PARTITION_LABEL);
+
+    if (partition == NULL) {
+        ESP_LOGE(
+            STORAGE_TAG,
+            "Partition '%s' was not found",
+            STORAGE_PARTITION_LABEL);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    if (!partition->encrypted) {
+        ESP_LOGE(
+            STORAGE_TAG,
+            "Partition '%s' is not marked encrypted",
+            STORAGE_PARTITION_LABEL);
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const esp_vfs_littlefs_conf_t configuration = {
+        .base_path = STORAGE_BASE_PATH,
+        .partition_label = STORAGE_PARTITION_LABEL,
+        .format_if_mount_failed = false,
+        .dont_mount = false,
+    };
+
+    const esp_err_t result = esp_vfs_littlefs_register(&configuration);
+    if (result != ESP_OK) {
+        ESP_LOGE(
+            STORAGE_TAG,
+            "LittleFS mount failed: %s",
+            esp_err_to_name(result));
+        return result;
+    }
+
+    s_is_mounted = true;
+    ESP_LOGI(STORAGE_TAG, "LittleFS mounted at %s", STORAGE_BASE_PATH);
+
+    const esp_err_t index_result = load_kv_index();
+    if (index_result != ESP_OK) {
+        (void)secure_storage_deinit();
+        return index_result;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t secure_storage_deinit(void)
+{
+    if (!s_is_mounted) {
+        return ESP_OK;
+    }
+
+    if ((s_kv.stream != NULL) && (fclose(s_kv.stream) != 0)) {
+        ESP_LOGE(STORAGE_TAG, "Failed to close key-value store: errno=%d", errno);
+    }
+    memset(&s_kv, 0, sizeof(s_kv));
+    arena_deinit(&s_blob_arena);
+
+    const esp_err_t result =
+        esp_vfs_littlefs_unregister(STORAGE_PARTITION_LABEL);
+
+    if (result == ESP_OK) {
+        s_is_mounted = false;
+        memset(&s_journal, 0, sizeof(s_journal));
+        ESP_LOGI(STORAGE_TAG, "LittleFS unmounted");
+    }
+
+    return result;
+}
+
+void secure_storage_report_security_state(void)
+{
+    const bool flash_encryption_enabled = esp_flash_encryption_enabled();
+    const bool secure_boot_enabled = esp_secure_boot_enabled();
+
+    ESP_LOGI(
+        STORAGE_TAG,
+        "Flash Encryption: %s",
+        flash_encryption_enabled ? "ENABLED" : "DISABLED");
+    ESP_LOGI(
+        STORAGE_TAG,
+        "Secure Boot: %s",
+        secure_boot_enabled ? "ENABLED" : "DISABLED");
+
+    const esp_partition_t *partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA,
+        ESP_PARTITION_SUBTYPE_ANY,
+        STORAGE_PARTITION_LABEL);
+
+    if (partition == NULL) {
+        ESP_LOGE(
+            STORAGE_TAG,
+            "Storage partition '%s' is missing",
+            STORAGE_PARTITION_LABEL);
+        return;
+    }
+
+    ESP_LOGI(
+        STORAGE_TAG,
+        "Storage partition encrypted flag: %s",
+        partition->encrypted ? "SET" : "NOT SET");
+
+    if (!flash_encryption_enabled) {
+        ESP_LOGW(
+            STORAGE_TAG,
+            "Raw LittleFS data is not protected until Flash Encryption is enabled");
+    }
+
+    if (!secure_boot_enabled) {
+        ESP_LOGW(
+            STORAGE_TAG,
+            "Unsigned firmware may bypass storage controls until Secure Boot is enabled");
+    }
+}
+
+esp_err_t secure_storage_load_record(secure_storage_record_t *record)
+{
+    if (record == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    esp_err_t primary_result =
+        read_record_file(STORAGE_PRIMARY_PATH, record);
+
+    if (primary_result == ESP_OK) {
+        return ESP_OK;
+    }
+
+    secure_storage_record_t backup_record = {0};
+    const esp_err_t backup_result =
+        read_record_file(STORAGE_BACKUP_PATH, &backup_record);
+
+    if (backup_result == ESP_OK) {
+        *record = backup_record;
+        const esp_err_t restore_result =
+            restore_primary_from_backup(&backup_record);
+
+        if (restore_result != ESP_OK) {
+            ESP_LOGW(
+                STORAGE_TAG,
+                "Backup is valid, but primary restoration failed: %s",
+                esp_err_to_name(restore_result));
+        }
+
+        return ESP_OK;
+    }
+
+    if ((primary_result == ESP_ERR_NOT_FOUND) &&
+        (backup_result == ESP_ERR_NOT_FOUND)) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    ESP_LOGE(
+        STORAGE_TAG,
+        "No valid record; primary=%s, backup=%s",
+        esp_err_to_name(primary_result),
+        esp_err_to_name(backup_result));
+    return ESP_ERR_INVALID_CRC;
+}
+
+esp_err_t secure_storage_store_record(
+    const secure_storage_record_t *record)
+{
+    esp_err_t result = validate_public_record(record);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    // Remove any temporary file left by an interrupted older transaction.
+    result = remove_if_present(STORAGE_TEMP_PATH);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    result = write_record_file(STORAGE_TEMP_PATH, record);
+    if (result != ESP_OK) {
+        (void)remove_if_present(STORAGE_TEMP_PATH);
+        return result;
+    }
+
+    // Read the temporary file back before replacing the committed record.
+    secure_storage_record_t verification_record = {0};
+    result = read_record_file(STORAGE_TEMP_PATH, &verification_record);
+    if (result != ESP_OK) {
+        (void)remove_if_present(STORAGE_TEMP_PATH);
+        return result;
+    }
+
+    if ((verification_record.sequence != record->sequence) ||
+        (verification_record.payload_length != record->payload_length) ||
         (memcmp(
             verification_record.payload,
             record->payload,
@@ -614,15 +1502,362 @@ esp_err_t secure_storage_store_record(
     return ESP_OK;
 }
 
+esp_err_t secure_storage_load_journal(secure_storage_record_t *record)
+{
+    if (record == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!s_journal.scanned) {
+        const esp_err_t result = scan_journal();
+        if (result != ESP_OK) {
+            return result;
+        }
+    }
+
+    if (!s_journal.has_latest) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    memset(record, 0, sizeof(*record));
+    record->sequence = s_journal.latest.record_sequence;
+    record->payload_length = s_journal.latest.payload_length;
+    memcpy(record->payload, s_journal.latest.payload, record->payload_length);
+    return ESP_OK;
+}
+
+esp_err_t secure_storage_append_journal(
+    const secure_storage_record_t *record)
+{
+    esp_err_t result = validate_public_record(record);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    if (record->payload_length > SECURE_STORAGE_JOURNAL_MAX_PAYLOAD_SIZE) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    if (!s_journal.scanned) {
+        result = scan_journal();
+        if (result != ESP_OK) {
+            return result;
+        }
+    }
+
+    if (s_journal.entry_count >= SECURE_STORAGE_JOURNAL_MAX_ENTRIES) {
+        result = compact_journal();
+        if (result != ESP_OK) {
+            return result;
+        }
+    }
+
+    storage_journal_entry_t entry = {
+        .magic = JOURNAL_ENTRY_MAGIC,
+        .format_version = JOURNAL_FORMAT_VERSION,
+        .payload_length = (uint16_t)record->payload_length,
+        .journal_sequence = s_journal.has_latest
+            ? (s_journal.latest.journal_sequence + 1U)
+            : 1U,
+        .record_sequence = record->sequence,
+        .payload = {0},
+        .checksum = 0U,
+    };
+    memcpy(entry.payload, record->payload, record->payload_length);
+    entry.checksum = calculate_journal_checksum(&entry);
+
+    FILE *stream = fopen(STORAGE_JOURNAL_PATH, "ab");
+    if (stream == NULL) {
+        ESP_LOGE(STORAGE_TAG, "Failed to open journal: errno=%d", errno);
+        return errno_to_esp_err(errno);
+    }
+
+    result = write_journal_entry(stream, &entry);
+
+    if (fclose(stream) != 0) {
+        ESP_LOGE(STORAGE_TAG, "Failed to close journal: errno=%d", errno);
+        result = ESP_FAIL;
+    }
+
+    if (result != ESP_OK) {
+        // Rescan before the next append so a partial entry is truncated.
+        s_journal.scanned = false;
+        return result;
+    }
+
+    s_journal.latest = entry;
+    s_journal.has_latest = true;
+    s_journal.entry_count++;
+    return ESP_OK;
+}
+
+esp_err_t secure_storage_put(const char *key, const void *value, size_t length)
+{
+    if ((key == NULL) || (key[0] == '\0') ||
+        (strlen(key) > SECURE_STORAGE_KEY_MAX_LENGTH) ||
+        ((value == NULL) && (length > 0U))) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (length > SECURE_STORAGE_VALUE_MAX_SIZE) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    if (s_kv.stream == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    storage_kv_index_entry_t *entry = find_kv_entry(key);
+    storage_kv_index_entry_t updated = {0};
+
+    if (entry != NULL) {
+        updated = *entry;
+        updated.active_slot ^= 1U;
+        updated.generation++;
+    } else {
+        if (s_kv.key_count >= SECURE_STORAGE_MAX_KEYS) {
+            return ESP_ERR_NO_MEM;
+        }
+        strlcpy(updated.key, key, sizeof(updated.key));
+        updated.pair_index = s_kv.pair_count;
+        updated.generation = 1U;
+        updated.active_slot = 0U;
+    }
+
+    storage_kv_slot_t *slot = &s_kv_slot;
+    memset(slot, 0, sizeof(*slot));
+    slot->header.magic = KV_SLOT_MAGIC;
+    slot->header.format_version = KV_FORMAT_VERSION;
+    slot->header.value_length = (uint16_t)length;
+    slot->header.generation = updated.generation;
+    strlcpy(slot->header.key, key, sizeof(slot->header.key));
+    if (length > 0U) {
+        memcpy(slot->value, value, length);
+    }
+    slot->header.value_checksum = calculate_fnv1a(slot->value, length);
+    slot->header.header_checksum = calculate_kv_header_checksum(&slot->header);
+
+    const uint32_t slot_index =
+        (updated.pair_index * KV_SLOTS_PER_KEY) + updated.active_slot;
+    const long offset = (long)(slot_index * sizeof(storage_kv_slot_t));
+
+    if ((fseek(s_kv.stream, offset, SEEK_SET) != 0) ||
+        (fwrite(slot, 1U, sizeof(*slot), s_kv.stream) != sizeof(*slot))) {
+        ESP_LOGE(STORAGE_TAG, "Failed to write key '%s': errno=%d", key, errno);
+        return ESP_FAIL;
+    }
+
+    const esp_err_t result = flush_and_sync(s_kv.stream);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    // Only a synchronized slot becomes visible through the index.
+    if (entry != NULL) {
+        *entry = updated;
+    } else {
+        s_kv.entries[s_kv.key_count++] = updated;
+        s_kv.pair_count = updated.pair_index + 1U;
+    }
+
+    return ESP_OK;
+}
+
+esp_err_t secure_storage_get(
+    const char *key,
+    void *value,
+    size_t capacity,
+    size_t *length)
+{
+    if ((key == NULL) || (length == NULL) ||
+        ((value == NULL) && (capacity > 0U))) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (s_kv.stream == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const storage_kv_index_entry_t *entry = find_kv_entry(key);
+    if (entry == NULL) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    storage_kv_slot_t *slot = &s_kv_slot;
+    const uint32_t slot_index =
+        (entry->pair_index * KV_SLOTS_PER_KEY) + entry->active_slot;
+
+    if (!read_kv_slot(slot_index, slot)) {
+        ESP_LOGE(STORAGE_TAG, "Failed to read key '%s': errno=%d", key, errno);
+        return ESP_FAIL;
+    }
+
+    if (!kv_slot_is_valid(slot) ||
+        (slot->header.generation != entry->generation) ||
+        (strcmp(slot->header.key, key) != 0)) {
+        ESP_LOGW(STORAGE_TAG, "Key '%s' failed validation", key);
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    if (slot->header.value_length > capacity) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    memcpy(value, slot->value, slot->header.value_length);
+    *length = slot->header.value_length;
+    return ESP_OK;
+}
+
+esp_err_t secure_storage_set_blob_key(const uint8_t *key)
+{
+    if (key == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (s_blob_key_set) {
+        mbedtls_gcm_free(&s_blob_gcm);
+        s_blob_key_set = false;
+    }
+
+    mbedtls_gcm_init(&s_blob_gcm);
+    const int status = mbedtls_gcm_setkey(
+        &s_blob_gcm,
+        MBEDTLS_CIPHER_ID_AES,
+        key,
+        SECURE_STORAGE_BLOB_KEY_SIZE * 8U);
+
+    if (status != 0) {
+        ESP_LOGE(STORAGE_TAG, "Blob key rejected: -0x%04x", (unsigned int)-status);
+        mbedtls_gcm_free(&s_blob_gcm);
+        return ESP_FAIL;
+    }
+
+    s_blob_key_set = true;
+    return ESP_OK;
+}
+
+esp_err_t secure_storage_store_blob(
+    const char *name,
+    secure_storage_blob_source_t source,
+    void *context)
+{
+    if (!blob_name_is_valid(name) || (source == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!s_is_mounted || !s_blob_key_set) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    char path[STORAGE_BLOB_PATH_SIZE];
+    char temp_path[STORAGE_BLOB_PATH_SIZE];
+    (void)snprintf(path, sizeof(path),
+                   STORAGE_BASE_PATH "/%s" STORAGE_BLOB_SUFFIX, name);
+    (void)snprintf(temp_path, sizeof(temp_path),
+                   STORAGE_BASE_PATH "/%s" STORAGE_BLOB_TEMP_SUFFIX, name);
+
+    // Remove any temporary blob left by an interrupted older store.
+    esp_err_t result = remove_if_present(temp_path);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    storage_blob_buffers_t buffers = {0};
+    result = allocate_blob_buffers(&buffers);
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    FILE *stream = fopen(temp_path, "wb");
+    if (stream == NULL) {
+        ESP_LOGE(STORAGE_TAG, "Failed to open %s: errno=%d", temp_path, errno);
+        free_blob_buffers(&buffers);
+        return errno_to_esp_err(errno);
+    }
+
+    result = write_blob_stream(stream, source, context, &buffers);
+    free_blob_buffers(&buffers);
+
+    if (fclose(stream) != 0) {
+        ESP_LOGE(STORAGE_TAG, "Failed to close %s: errno=%d", temp_path, errno);
+        result = ESP_FAIL;
+    }
+
+    // LittleFS replaces the committed blob atomically on rename.
+    if ((result == ESP_OK) && (rename(temp_path, path) != 0)) {
+        ESP_LOGE(STORAGE_TAG, "Failed to commit %s: errno=%d", path, errno);
+        result = ESP_FAIL;
+    }
+
+    if (result != ESP_OK) {
+        (void)remove_if_present(temp_path);
+    }
+
+    return result;
+}
+
+esp_err_t secure_storage_load_blob(
+    const char *name,
+    secure_storage_blob_sink_t sink,
+    void *context,
+    size_t *total_length)
+{
+    if (!blob_name_is_valid(name) || (sink == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (!s_is_mounted || !s_blob_key_set) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    char path[STORAGE_BLOB_PATH_SIZE];
+    (void)snprintf(path, sizeof(path),
+                   STORAGE_BASE_PATH "/%s" STORAGE_BLOB_SUFFIX, name);
+
+    FILE *stream = fopen(path, "rb");
+    if (stream == NULL) {
+        if (errno != ENOENT) {
+            ESP_LOGE(STORAGE_TAG, "Failed to open %s: errno=%d", path, errno);
+        }
+        return errno_to_esp_err(errno);
+    }
+
+    storage_blob_buffers_t buffers = {0};
+    esp_err_t result = allocate_blob_buffers(&buffers);
+
+    size_t delivered = 0U;
+    if (result == ESP_OK) {
+        result = read_blob_stream(stream, sink, context, &buffers, &delivered);
+    }
+    free_blob_buffers(&buffers);
+
+    if (fclose(stream) != 0) {
+        ESP_LOGE(STORAGE_TAG, "Failed to close %s: errno=%d", path, errno);
+        result = ESP_FAIL;
+    }
+
+    if ((result == ESP_OK) && (total_length != NULL)) {
+        *total_length = delivered;
+    }
+
+    return result;
+}
+
+esp_err_t secure_storage_get_usage(size_t *total_bytes, size_t *used_bytes)
+{
+    if ((total_bytes == NULL) || (used_bytes == NULL)) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    return esp_littlefs_info(STORAGE_PARTITION_LABEL, total_bytes, used_bytes);
+}
+
 esp_err_t secure_storage_print_usage(void)
 {
     size_t total_bytes = 0U;
     size_t used_bytes = 0U;
 
-    const esp_err_t result = esp_littlefs_info(
-        STORAGE_PARTITION_LABEL,
-        &total_bytes,
-        &used_bytes);
+    const esp_err_t result = secure_storage_get_usage(&total_bytes, &used_bytes);
 
     if (result == ESP_OK) {
         ESP_LOGI(
@@ -632,5 +1867,13 @@ esp_err_t secure_storage_print_usage(void)
             (unsigned int)total_bytes);
     }
 
+    if (s_blob_arena.base != NULL) {
+        ESP_LOGI(
+            STORAGE_TAG,
+            "Blob arena peak: %u / %u bytes",
+            (unsigned int)arena_peak(&s_blob_arena),
+            (unsigned int)s_blob_arena.size);
+    }
+
     return result;
 }
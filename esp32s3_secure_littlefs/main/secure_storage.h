@@ -10,7 +10,50 @@
 extern "C" {
 #endif
 
+#define SECURE_STORAGE_BASE_PATH "/littlefs"
 #define SECURE_STORAGE_MAX_PAYLOAD_SIZE 512U
+#define SECURE_STORAGE_JOURNAL_MAX_PAYLOAD_SIZE 64U
+#define SECURE_STORAGE_JOURNAL_MAX_ENTRIES 64U
+#define SECURE_STORAGE_KEY_MAX_LENGTH 15U
+#define SECURE_STORAGE_VALUE_MAX_SIZE 256U
+#define SECURE_STORAGE_MAX_KEYS 32U
+#define SECURE_STORAGE_BLOB_KEY_SIZE 32U
+#define SECURE_STORAGE_BLOB_CHUNK_SIZE 4096U
+#define SECURE_STORAGE_BLOB_NAME_MAX_LENGTH 15U
+
+/**
+ * @brief Supplies the next plaintext bytes of a blob being stored.
+ *
+ * Args:
+ *     context: Caller context passed to secure_storage_store_blob().
+ *     buffer: Destination for plaintext bytes.
+ *     capacity: Maximum number of bytes to produce.
+ *     produced: Receives the number of bytes written; 0 ends the blob.
+ *
+ * Returns:
+ *     ESP_OK to continue; any other code aborts the store.
+ */
+typedef esp_err_t (*secure_storage_blob_source_t)(
+    void *context,
+    uint8_t *buffer,
+    size_t capacity,
+    size_t *produced);
+
+/**
+ * @brief Receives authenticated plaintext bytes of a blob being loaded.
+ *
+ * Args:
+ *     context: Caller context passed to secure_storage_load_blob().
+ *     data: Verified plaintext of one chunk.
+ *     length: Number of bytes in data.
+ *
+ * Returns:
+ *     ESP_OK to continue; any other code aborts the load.
+ */
+typedef esp_err_t (*secure_storage_blob_sink_t)(
+    void *context,
+    const uint8_t *data,
+    size_t length);
 
 /**
  * @brief Describes an application record stored in LittleFS.
@@ -26,7 +69,8 @@ typedef struct {
  *
  * The function verifies that the configured partition exists and carries the
  * encrypted partition flag. The flag causes transparent hardware encryption
- * only when ESP32-S3 Flash Encryption is active.
+ * only when ESP32-S3 Flash Encryption is active. It also opens the keyed
+ * store file and loads its index into RAM.
  *
  * Returns:
  *     ESP_OK when the filesystem is mounted.
@@ -89,6 +133,183 @@ esp_err_t secure_storage_load_record(secure_storage_record_t *record);
  */
 esp_err_t secure_storage_store_record(const secure_storage_record_t *record);
 
+/**
+ * @brief Loads the newest valid record from the append-only journal.
+ *
+ * The first call scans the journal, keeps the entry with the highest
+ * journal sequence number, and truncates a torn entry left by an
+ * interrupted append so later appends start on an entry boundary.
+ *
+ * Args:
+ *     record: Destination for the validated record.
+ *
+ * Returns:
+ *     ESP_OK when a valid entry is loaded.
+ *     ESP_ERR_NOT_FOUND when the journal holds no valid entry.
+ *     ESP_ERR_INVALID_ARG when record is NULL.
+ *     Another ESP-IDF error code when file access fails.
+ */
+esp_err_t secure_storage_load_journal(secure_storage_record_t *record);
+
+/**
+ * @brief Appends a small record to the journal as one fixed-size entry.
+ *
+ * Intended for frequently updated values such as counters. An update costs
+ * one append and one sync instead of the temporary-file and rename sequence
+ * of secure_storage_store_record(). When the journal holds
+ * SECURE_STORAGE_JOURNAL_MAX_ENTRIES entries, it is first compacted to its
+ * newest entry through a temporary file and one rename.
+ *
+ * Args:
+ *     record: Record to append; the payload must not exceed
+ *         SECURE_STORAGE_JOURNAL_MAX_PAYLOAD_SIZE bytes.
+ *
+ * Returns:
+ *     ESP_OK when the entry is appended and synchronized.
+ *     ESP_ERR_INVALID_ARG when record is NULL.
+ *     ESP_ERR_INVALID_SIZE when the payload is too large.
+ *     Another ESP-IDF error code when a filesystem operation fails.
+ */
+esp_err_t secure_storage_append_journal(const secure_storage_record_t *record);
+
+/**
+ * @brief Stores a value under a key in the indexed key-value file.
+ *
+ * Every key owns two fixed-size slots. The new value is written to the
+ * inactive slot with a higher generation number, so an interrupted write
+ * leaves the previous value intact. An update costs one seek, one write,
+ * and one sync on a file that stays open.
+ *
+ * Args:
+ *     key: NUL-terminated key of at most SECURE_STORAGE_KEY_MAX_LENGTH
+ *         characters.
+ *     value: Bytes to store; may be NULL when length is 0.
+ *     length: Number of bytes, at most SECURE_STORAGE_VALUE_MAX_SIZE.
+ *
+ * Returns:
+ *     ESP_OK when the value is written and synchronized.
+ *     ESP_ERR_INVALID_ARG when the key or value pointer is invalid.
+ *     ESP_ERR_INVALID_SIZE when the value is too large.
+ *     ESP_ERR_NO_MEM when SECURE_STORAGE_MAX_KEYS keys already exist.
+ *     ESP_ERR_INVALID_STATE when storage is not initialized.
+ *     ESP_FAIL when a filesystem operation fails.
+ */
+esp_err_t secure_storage_put(const char *key, const void *value, size_t length);
+
+/**
+ * @brief Reads the value stored under a key.
+ *
+ * The key is resolved through the in-RAM index, so the lookup costs one
+ * seek and one read of the active slot.
+ *
+ * Args:
+ *     key: NUL-terminated key.
+ *     value: Destination buffer.
+ *     capacity: Size of the destination buffer.
+ *     length: Receives the stored value length.
+ *
+ * Returns:
+ *     ESP_OK when the value is read and its checksum matches.
+ *     ESP_ERR_NOT_FOUND when the key does not exist.
+ *     ESP_ERR_INVALID_ARG when an argument is invalid.
+ *     ESP_ERR_INVALID_SIZE when capacity is smaller than the value.
+ *     ESP_ERR_INVALID_CRC when the slot changed or was corrupted on flash.
+ *     ESP_ERR_INVALID_STATE when storage is not initialized.
+ *     ESP_FAIL when a filesystem operation fails.
+ */
+esp_err_t secure_storage_get(
+    const char *key,
+    void *value,
+    size_t capacity,
+    size_t *length);
+
+/**
+ * @brief Sets the AES-256 key used for encrypted blobs.
+ *
+ * Production firmware should derive the key on the device, for example
+ * with the eFuse-backed HMAC peripheral, rather than embedding it.
+ *
+ * Args:
+ *     key: SECURE_STORAGE_BLOB_KEY_SIZE key bytes.
+ *
+ * Returns:
+ *     ESP_OK when the key is loaded.
+ *     ESP_ERR_INVALID_ARG when key is NULL.
+ *     ESP_FAIL when the AES-GCM context rejects the key.
+ */
+esp_err_t secure_storage_set_blob_key(const uint8_t *key);
+
+/**
+ * @brief Encrypts and stores a blob of any size with constant memory.
+ *
+ * Plaintext is pulled from the source one SECURE_STORAGE_BLOB_CHUNK_SIZE
+ * chunk at a time into a DMA-capable buffer and sealed with hardware
+ * AES-GCM. Every chunk carries its own tag, and the chunk index and
+ * final-chunk flag are authenticated, so reordered, truncated, or extended
+ * blobs fail to load. The blob is written under a temporary name and
+ * renamed into place only when complete.
+ *
+ * Args:
+ *     name: Blob name of lowercase letters, digits, and underscores,
+ *         at most SECURE_STORAGE_BLOB_NAME_MAX_LENGTH characters.
+ *     source: Callback producing the plaintext.
+ *     context: Passed to the source.
+ *
+ * Returns:
+ *     ESP_OK when the complete blob is committed.
+ *     ESP_ERR_INVALID_ARG when the name or source is invalid.
+ *     ESP_ERR_INVALID_STATE when no blob key is set.
+ *     ESP_ERR_NO_MEM when the chunk buffer cannot be allocated.
+ *     The source's error code, or ESP_FAIL for a filesystem failure.
+ */
+esp_err_t secure_storage_store_blob(
+    const char *name,
+    secure_storage_blob_source_t source,
+    void *context);
+
+/**
+ * @brief Streams a stored blob through authenticated decryption.
+ *
+ * Each chunk is passed to the sink only after its tag verifies. A later
+ * chunk can still fail, so the sink must treat the data as provisional
+ * until this function returns ESP_OK.
+ *
+ * Args:
+ *     name: Blob name used with secure_storage_store_blob().
+ *     sink: Callback receiving the plaintext.
+ *     context: Passed to the sink.
+ *     total_length: Optional; receives the plaintext length.
+ *
+ * Returns:
+ *     ESP_OK when the whole blob is verified and delivered.
+ *     ESP_ERR_NOT_FOUND when the blob does not exist.
+ *     ESP_ERR_INVALID_ARG when the name or sink is invalid.
+ *     ESP_ERR_INVALID_STATE when no blob key is set.
+ *     ESP_ERR_INVALID_RESPONSE when the blob format is invalid or truncated.
+ *     ESP_ERR_INVALID_CRC when a chunk fails authentication.
+ *     ESP_ERR_NO_MEM when the chunk buffer cannot be allocated.
+ *     The sink's error code, or ESP_FAIL for a filesystem failure.
+ */
+esp_err_t secure_storage_load_blob(
+    const char *name,
+    secure_storage_blob_sink_t sink,
+    void *context,
+    size_t *total_length);
+
+/**
+ * @brief Reads LittleFS total and used capacity.
+ *
+ * Args:
+ *     total_bytes: Receives the filesystem capacity.
+ *     used_bytes: Receives the bytes currently allocated.
+ *
+ * Returns:
+ *     ESP_OK when the usage information is available.
+ *     ESP_ERR_INVALID_ARG when an output pointer is NULL.
+ *     Another ESP-IDF error code from the LittleFS query.
+ */
+esp_err_t secure_storage_get_usage(size_t *total_bytes, size_t *used_bytes);
+
 /**
  * @brief Prints LittleFS total and used capacity.
  *
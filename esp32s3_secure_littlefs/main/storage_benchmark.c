@@ -0,0 +1,538 @@
+#include "storage_benchmark.h"
+
+#include "sdkconfig.h"
+
+#if CONFIG_SECURE_STORAGE_BENCHMARK
+
+#include <errno.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "esp_log.h"
+#include "esp_spi_flash_counters.h"
+#include "esp_timer.h"
+
+#include "secure_storage.h"
+
+#define BENCHMARK_TAG "storage_benchmark"
+#define BENCHMARK_ITERATIONS CONFIG_SECURE_STORAGE_BENCHMARK_ITERATIONS
+#define BENCHMARK_RECOVERY_ITERATIONS 20U
+#define BENCHMARK_FILL_CHUNK_SIZE 4096U
+#define BENCHMARK_TORN_APPEND_SIZE 40U
+
+// The benchmark damages these files on purpose to exercise recovery.
+#define BENCHMARK_FILL_PATH SECURE_STORAGE_BASE_PATH "/bench_fill.bin"
+#define BENCHMARK_PRIMARY_PATH SECURE_STORAGE_BASE_PATH "/device_record.bin"
+#define BENCHMARK_JOURNAL_PATH SECURE_STORAGE_BASE_PATH "/device_journal.log"
+
+/**
+ * @brief Collects latency samples for one measurement.
+ */
+typedef struct {
+    uint32_t samples_us[BENCHMARK_ITERATIONS];
+    size_t count;
+} benchmark_samples_t;
+
+/**
+ * @brief Holds flash traffic observed during one measurement.
+ */
+typedef struct {
+    uint32_t written_bytes;
+    uint32_t erased_bytes;
+} benchmark_traffic_t;
+
+static const size_t s_record_sizes[] = {
+    32U,
+    128U,
+    SECURE_STORAGE_MAX_PAYLOAD_SIZE,
+};
+
+static const uint32_t s_fill_percentages[] = {0U, 50U, 75U, 90U};
+
+// Large buffers stay off the task stack.
+static benchmark_samples_t s_samples;
+static secure_storage_record_t s_record;
+static uint8_t s_fill_chunk[BENCHMARK_FILL_CHUNK_SIZE];
+static uint32_t s_sequence;
+
+/**
+ * @brief Orders two latency samples for qsort().
+ *
+ * Args:
+ *     left: First sample.
+ *     right: Second sample.
+ *
+ * Returns:
+ *     A negative, zero, or positive value in ascending order.
+ */
+static int compare_samples(const void *left, const void *right)
+{
+    const uint32_t a = *(const uint32_t *)left;
+    const uint32_t b = *(const uint32_t *)right;
+
+    return (a > b) - (a < b);
+}
+
+/**
+ * @brief Returns a percentile of sorted samples.
+ *
+ * Args:
+ *     samples: Samples sorted in ascending order.
+ *     percentile: Percentile from 0 to 100.
+ *
+ * Returns:
+ *     The sample at the nearest rank, or 0 when there are no samples.
+ */
+static uint32_t sample_percentile(
+    const benchmark_samples_t *samples,
+    uint32_t percentile)
+{
+    if (samples->count == 0U) {
+        return 0U;
+    }
+
+    size_t rank = ((samples->count * percentile) + 99U) / 100U;
+    if (rank > 0U) {
+        --rank;
+    }
+
+    return samples->samples_us[rank];
+}
+
+/**
+ * @brief Starts a new measurement.
+ */
+static void measurement_begin(void)
+{
+    s_samples.count = 0U;
+    esp_flash_reset_counters();
+}
+
+/**
+ * @brief Ends the timing of one operation and records its latency.
+ *
+ * Args:
+ *     start_us: Timestamp taken immediately before the operation.
+ */
+static void measurement_sample(int64_t start_us)
+{
+    if (s_samples.count < BENCHMARK_ITERATIONS) {
+        s_samples.samples_us[s_samples.count++] =
+            (uint32_t)(esp_timer_get_time() - start_us);
+    }
+}
+
+/**
+ * @brief Reads the flash traffic since measurement_begin().
+ *
+ * Returns:
+ *     Bytes written and erased through the flash driver.
+ */
+static benchmark_traffic_t measurement_traffic(void)
+{
+    const esp_flash_counters_t *counters = esp_flash_get_counters();
+    const benchmark_traffic_t traffic = {
+        .written_bytes = counters->write.bytes,
+        .erased_bytes = counters->erase.bytes,
+    };
+
+    return traffic;
+}
+
+/**
+ * @brief Logs the latency percentiles of the current measurement.
+ *
+ * Args:
+ *     label: Measurement description.
+ */
+static void report_latency(const char *label)
+{
+    qsort(
+        s_samples.samples_us,
+        s_samples.count,
+        sizeof(s_samples.samples_us[0]),
+        compare_samples);
+
+    ESP_LOGI(
+        BENCHMARK_TAG,
+        "%-28s n=%3u p50=%6" PRIu32 " p90=%6" PRIu32
+        " p99=%6" PRIu32 " max=%6" PRIu32 " us",
+        label,
+        (unsigned int)s_samples.count,
+        sample_percentile(&s_samples, 50U),
+        sample_percentile(&s_samples, 90U),
+        sample_percentile(&s_samples, 99U),
+        sample_percentile(&s_samples, 100U));
+}
+
+/**
+ * @brief Logs the flash traffic per logical update of the current measurement.
+ *
+ * Args:
+ *     label: Measurement description.
+ *     updates: Number of logical updates performed.
+ *     logical_bytes: Payload bytes of one update.
+ */
+static void report_traffic(
+    const char *label,
+    uint32_t updates,
+    size_t logical_bytes)
+{
+    const benchmark_traffic_t traffic = measurement_traffic();
+    const uint32_t written = traffic.written_bytes / updates;
+    const uint32_t erased = traffic.erased_bytes / updates;
+
+    ESP_LOGI(
+        BENCHMARK_TAG,
+        "%-28s written=%6" PRIu32 " B/update erased=%6" PRIu32
+        " B/update amplification=%" PRIu32 "x",
+        label,
+        written,
+        erased,
+        (logical_bytes > 0U) ? (written / (uint32_t)logical_bytes) : 0U);
+}
+
+/**
+ * @brief Fills the demonstration record with a payload of the given size.
+ *
+ * Args:
+ *     payload_length: Number of payload bytes.
+ */
+static void prepare_record(size_t payload_length)
+{
+    s_record.sequence = ++s_sequence;
+    s_record.payload_length = payload_length;
+
+    for (size_t index = 0U; index < payload_length; ++index) {
+        s_record.payload[index] = (uint8_t)(s_record.sequence + index);
+    }
+}
+
+/**
+ * @brief Grows the fill file until LittleFS reaches a usage percentage.
+ *
+ * Args:
+ *     percentage: Target share of the filesystem in use.
+ *     reached: Receives the usage percentage actually reached.
+ *
+ * Returns:
+ *     ESP_OK when the target is reached or already exceeded.
+ *     ESP_ERR_NO_MEM when the filesystem fills up first.
+ *     Another ESP-IDF error code when a write or usage query fails.
+ */
+static esp_err_t fill_to_percentage(uint32_t percentage, uint32_t *reached)
+{
+    size_t total_bytes = 0U;
+    size_t used_bytes = 0U;
+
+    esp_err_t result = secure_storage_get_usage(&total_bytes, &used_bytes);
+    if ((result != ESP_OK) || (total_bytes == 0U)) {
+        return (result != ESP_OK) ? result : ESP_ERR_INVALID_SIZE;
+    }
+
+    const uint64_t target_bytes = ((uint64_t)total_bytes * percentage) / 100U;
+    FILE *stream = NULL;
+
+    if (used_bytes < target_bytes) {
+        stream = fopen(BENCHMARK_FILL_PATH, "ab");
+        if (stream == NULL) {
+            ESP_LOGE(BENCHMARK_TAG, "Failed to open fill file: errno=%d", errno);
+            return ESP_FAIL;
+        }
+        memset(s_fill_chunk, 0xA5, sizeof(s_fill_chunk));
+    }
+
+    while ((result == ESP_OK) && (used_bytes < target_bytes)) {
+        if ((fwrite(s_fill_chunk, 1U, sizeof(s_fill_chunk), stream) !=
+             sizeof(s_fill_chunk)) ||
+            (fflush(stream) != 0)) {
+            result = ESP_ERR_NO_MEM;
+            break;
+        }
+
+        result = secure_storage_get_usage(&total_bytes, &used_bytes);
+    }
+
+    if ((stream != NULL) && (fclose(stream) != 0) && (result == ESP_OK)) {
+        result = ESP_FAIL;
+    }
+
+    *reached = (uint32_t)(((uint64_t)used_bytes * 100U) / total_bytes);
+    return result;
+}
+
+/**
+ * @brief Times record stores and loads for one payload size.
+ *
+ * Args:
+ *     payload_length: Record payload size in bytes.
+ *
+ * Returns:
+ *     ESP_OK when every operation succeeds, or the first error code.
+ */
+static esp_err_t benchmark_records(size_t payload_length)
+{
+    char label[32];
+    esp_err_t result = ESP_OK;
+
+    measurement_begin();
+    for (uint32_t i = 0U; (result == ESP_OK) && (i < BENCHMARK_ITERATIONS); ++i) {
+        prepare_record(payload_length);
+        const int64_t start_us = esp_timer_get_time();
+        result = secure_storage_store_record(&s_record);
+        measurement_sample(start_us);
+    }
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    (void)snprintf(label, sizeof(label), "store_record %u B",
+                   (unsigned int)payload_length);
+    report_latency(label);
+    report_traffic(label, BENCHMARK_ITERATIONS, payload_length);
+
+    measurement_begin();
+    for (uint32_t i = 0U; (result == ESP_OK) && (i < BENCHMARK_ITERATIONS); ++i) {
+        const int64_t start_us = esp_timer_get_time();
+        result = secure_storage_load_record(&s_record);
+        measurement_sample(start_us);
+    }
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    (void)snprintf(label, sizeof(label), "load_record %u B",
+                   (unsigned int)payload_length);
+    report_latency(label);
+    return ESP_OK;
+}
+
+/**
+ * @brief Times journal appends of a full-size journal payload.
+ *
+ * The iteration count exceeds the journal capacity, so the samples include
+ * the appends that compact the journal first.
+ *
+ * Returns:
+ *     ESP_OK when every append succeeds, or the first error code.
+ */
+static esp_err_t benchmark_journal(void)
+{
+    esp_err_t result = ESP_OK;
+
+    measurement_begin();
+    for (uint32_t i = 0U; (result == ESP_OK) && (i < BENCHMARK_ITERATIONS); ++i) {
+        prepare_record(SECURE_STORAGE_JOURNAL_MAX_PAYLOAD_SIZE);
+        const int64_t start_us = esp_timer_get_time();
+        result = secure_storage_append_journal(&s_record);
+        measurement_sample(start_us);
+    }
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    report_latency("append_journal 64 B");
+    report_traffic(
+        "append_journal 64 B",
+        BENCHMARK_ITERATIONS,
+        SECURE_STORAGE_JOURNAL_MAX_PAYLOAD_SIZE);
+    return ESP_OK;
+}
+
+/**
+ * @brief Unmounts and remounts secure storage, timing the mount.
+ *
+ * Returns:
+ *     ESP_OK when storage is mounted again, or the first error code.
+ */
+static esp_err_t remount_timed(void)
+{
+    esp_err_t result = secure_storage_deinit();
+    if (result != ESP_OK) {
+        return result;
+    }
+
+    const int64_t start_us = esp_timer_get_time();
+    result = secure_storage_init();
+    measurement_sample(start_us);
+    return result;
+}
+
+/**
+ * @brief Appends bytes that look like an append cut off by a power loss.
+ *
+ * Returns:
+ *     ESP_OK when the torn tail is written, otherwise ESP_FAIL.
+ */
+static esp_err_t append_torn_journal_tail(void)
+{
+    FILE *stream = fopen(BENCHMARK_JOURNAL_PATH, "ab");
+    if (stream == NULL) {
+        return ESP_FAIL;
+    }
+
+    memset(s_fill_chunk, 0x5A, BENCHMARK_TORN_APPEND_SIZE);
+    const bool written =
+        fwrite(s_fill_chunk, 1U, BENCHMARK_TORN_APPEND_SIZE, stream) ==
+        BENCHMARK_TORN_APPEND_SIZE;
+
+    return ((fclose(stream) == 0) && written) ? ESP_OK : ESP_FAIL;
+}
+
+/**
+ * @brief Cuts the primary record short as if its write was interrupted.
+ *
+ * Returns:
+ *     ESP_OK when the primary is truncated, otherwise ESP_FAIL.
+ */
+static esp_err_t tear_primary_record(void)
+{
+    return (truncate(BENCHMARK_PRIMARY_PATH, 8) == 0) ? ESP_OK : ESP_FAIL;
+}
+
+/**
+ * @brief Times the recovery work performed after a power cut.
+ *
+ * Returns:
+ *     ESP_OK when every recovery succeeds, or the first error code.
+ */
+static esp_err_t benchmark_recovery(void)
+{
+    esp_err_t result = ESP_OK;
+
+    measurement_begin();
+    for (uint32_t i = 0U;
+         (result == ESP_OK) && (i < BENCHMARK_RECOVERY_ITERATIONS);
+         ++i) {
+        result = remount_timed();
+    }
+    if (result != ESP_OK) {
+        return result;
+    }
+    report_latency("mount + key index");
+
+    // Each pass remounts so the journal scan is not served from its cache.
+    measurement_begin();
+    for (uint32_t i = 0U;
+         (result == ESP_OK) && (i < BENCHMARK_RECOVERY_ITERATIONS);
+         ++i) {
+        result = append_torn_journal_tail();
+        if (result == ESP_OK) {
+            result = secure_storage_deinit();
+        }
+        if (result == ESP_OK) {
+            result = secure_storage_init();
+        }
+        if (result == ESP_OK) {
+            const int64_t start_us = esp_timer_get_time();
+            result = secure_storage_load_journal(&s_record);
+            measurement_sample(start_us);
+        }
+    }
+    if (result != ESP_OK) {
+        return result;
+    }
+    report_latency("journal scan, torn tail");
+
+    // A fresh store leaves the previous record as a valid backup.
+    measurement_begin();
+    for (uint32_t i = 0U;
+         (result == ESP_OK) && (i < BENCHMARK_RECOVERY_ITERATIONS);
+         ++i) {
+        prepare_record(SECURE_STORAGE_MAX_PAYLOAD_SIZE);
+        result = secure_storage_store_record(&s_record);
+        if (result == ESP_OK) {
+            result = tear_primary_record();
+        }
+        if (result == ESP_OK) {
+            const int64_t start_us = esp_timer_get_time();
+            result = secure_storage_load_record(&s_record);
+            measurement_sample(start_us);
+        }
+    }
+    if (result != ESP_OK) {
+        return result;
+    }
+    report_latency("restore primary from backup");
+    return ESP_OK;
+}
+
+/**
+ * @brief Runs every measurement at the current fill level.
+ *
+ * Returns:
+ *     ESP_OK when every measurement succeeds, or the first error code.
+ */
+static esp_err_t benchmark_fill_level(void)
+{
+    esp_err_t result = ESP_OK;
+
+    for (size_t index = 0U;
+         (result == ESP_OK) &&
+         (index < (sizeof(s_record_sizes) / sizeof(s_record_sizes[0])));
+         ++index) {
+        result = benchmark_records(s_record_sizes[index]);
+    }
+
+    if (result == ESP_OK) {
+        result = benchmark_journal();
+    }
+
+    if (result == ESP_OK) {
+        result = benchmark_recovery();
+    }
+
+    return result;
+}
+
+esp_err_t storage_benchmark_run(void)
+{
+    ESP_LOGI(
+        BENCHMARK_TAG,
+        "Storage benchmark: %u iterations per measurement",
+        (unsigned int)BENCHMARK_ITERATIONS);
+#ifdef CONFIG_LITTLEFS_BLOCK_CYCLES
+    ESP_LOGI(
+        BENCHMARK_TAG,
+        "LittleFS block cycles: %d",
+        CONFIG_LITTLEFS_BLOCK_CYCLES);
+#endif
+
+    esp_err_t result = ESP_OK;
+
+    for (size_t index = 0U;
+         (result == ESP_OK) &&
+         (index < (sizeof(s_fill_percentages) / sizeof(s_fill_percentages[0])));
+         ++index) {
+        uint32_t reached = 0U;
+        result = fill_to_percentage(s_fill_percentages[index], &reached);
+
+        if (result == ESP_OK) {
+            ESP_LOGI(
+                BENCHMARK_TAG,
+                "--- Fill level %" PRIu32 "%% (target %" PRIu32 "%%) ---",
+                reached,
+                s_fill_percentages[index]);
+            result = benchmark_fill_level();
+        }
+    }
+
+    if (result != ESP_OK) {
+        ESP_LOGE(
+            BENCHMARK_TAG,
+            "Storage benchmark stopped: %s",
+            esp_err_to_name(result));
+    }
+
+    if ((unlink(BENCHMARK_FILL_PATH) != 0) && (errno != ENOENT)) {
+        ESP_LOGW(BENCHMARK_TAG, "Failed to remove fill file: errno=%d", errno);
+    }
+
+    return result;
+}
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef STORAGE_BENCHMARK_H
+#define STORAGE_BENCHMARK_H
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Measures secure storage latency and flash traffic and logs a report.
+ *
+ * For each fill level the benchmark times record stores and loads at
+ * several payload sizes, journal appends, and the recovery work done after
+ * a power cut: remounting, scanning a journal with a torn tail, and
+ * restoring a damaged primary record from its backup. Each measurement
+ * reports p50, p90, p99, and maximum latency, plus the bytes written to
+ * and erased from flash per logical update.
+ *
+ * Secure storage must be initialized. The benchmark overwrites the
+ * demonstration record and journal, and removes its fill file when done.
+ *
+ * Returns:
+ *     ESP_OK when every measurement completes.
+ *     The first storage error code otherwise.
+ */
+esp_err_t storage_benchmark_run(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
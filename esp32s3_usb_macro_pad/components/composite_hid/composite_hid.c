@@ -0,0 +1,353 @@
+#include "composite_hid.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "class/hid/hid_device.h"
+#include "esp_log.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "tinyusb.h"
+
+#define COMPOSITE_HID_POLL_INTERVAL_MS 1U
+#define COMPOSITE_HID_ENDPOINT_IN 0x81U
+#define COMPOSITE_HID_ENDPOINT_SIZE 16U
+#define COMPOSITE_HID_MAX_POWER_MA 100U
+#define COMPOSITE_HID_MAX_REPORT_LENGTH 8U
+
+#define COMPOSITE_HID_CONFIG_TOTAL_LENGTH \
+    (TUD_CONFIG_DESC_LEN + (CFG_TUD_HID * TUD_HID_DESC_LEN))
+
+typedef enum
+{
+    COMPOSITE_HID_SLOT_KEYBOARD = 0,
+    COMPOSITE_HID_SLOT_CONSUMER,
+    COMPOSITE_HID_SLOT_MOUSE,
+    COMPOSITE_HID_SLOT_COUNT,
+} composite_hid_slot_t;
+
+/**
+ * @brief One-report mailbox of a report type.
+ *
+ * The free semaphore is available while the mailbox is empty. sequence
+ * orders pending reports of different types by the time they were queued.
+ */
+typedef struct
+{
+    SemaphoreHandle_t free;
+    bool pending;
+    uint32_t sequence;
+    uint8_t length;
+    uint8_t data[COMPOSITE_HID_MAX_REPORT_LENGTH];
+} composite_hid_mailbox_t;
+
+static const char *TAG = "composite_hid";
+
+static const uint8_t s_report_ids[COMPOSITE_HID_SLOT_COUNT] =
+{
+    [COMPOSITE_HID_SLOT_KEYBOARD] = COMPOSITE_HID_REPORT_ID_KEYBOARD,
+    [COMPOSITE_HID_SLOT_CONSUMER] = COMPOSITE_HID_REPORT_ID_CONSUMER,
+    [COMPOSITE_HID_SLOT_MOUSE] = COMPOSITE_HID_REPORT_ID_MOUSE,
+};
+
+static const uint8_t s_hid_report_descriptor[] =
+{
+    TUD_HID_REPORT_DESC_KEYBOARD(HID_REPORT_ID(COMPOSITE_HID_REPORT_ID_KEYBOARD)),
+    TUD_HID_REPORT_DESC_CONSUMER(HID_REPORT_ID(COMPOSITE_HID_REPORT_ID_CONSUMER)),
+    TUD_HID_REPORT_DESC_MOUSE(HID_REPORT_ID(COMPOSITE_HID_REPORT_ID_MOUSE)),
+};
+
+static const uint8_t s_configuration_descriptor[] =
+{
+    TUD_CONFIG_DESCRIPTOR(
+        1,
+        1,
+        0,
+        COMPOSITE_HID_CONFIG_TOTAL_LENGTH,
+        TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP,
+        COMPOSITE_HID_MAX_POWER_MA),
+
+    TUD_HID_DESCRIPTOR(
+        0,
+        4,
+        HID_ITF_PROTOCOL_NONE,
+        sizeof(s_hid_report_descriptor),
+        COMPOSITE_HID_ENDPOINT_IN,
+        COMPOSITE_HID_ENDPOINT_SIZE,
+        COMPOSITE_HID_POLL_INTERVAL_MS),
+};
+
+static const char s_language_id[] = {0x09, 0x04};
+static const char *s_string_descriptors[5];
+static composite_hid_mailbox_t s_mailboxes[COMPOSITE_HID_SLOT_COUNT];
+static SemaphoreHandle_t s_scheduler_lock;
+static uint32_t s_next_sequence;
+
+/**
+ * @brief Hands the oldest pending report to TinyUSB if the endpoint is free.
+ *
+ * Called whenever a report is queued and whenever the host has read the
+ * previous one. The caller must hold s_scheduler_lock.
+ */
+static void composite_hid_send_next(void)
+{
+    if (!tud_hid_ready())
+    {
+        return;
+    }
+
+    composite_hid_mailbox_t *oldest = NULL;
+    size_t oldest_slot = 0;
+
+    for (size_t slot = 0; slot < COMPOSITE_HID_SLOT_COUNT; ++slot)
+    {
+        composite_hid_mailbox_t *mailbox = &s_mailboxes[slot];
+
+        // The difference stays correct when the counter wraps.
+        if (mailbox->pending &&
+            ((oldest == NULL) || ((int32_t)(mailbox->sequence - oldest->sequence) < 0)))
+        {
+            oldest = mailbox;
+            oldest_slot = slot;
+        }
+    }
+
+    if ((oldest != NULL) &&
+        tud_hid_report(s_report_ids[oldest_slot], oldest->data, oldest->length))
+    {
+        oldest->pending = false;
+        xSemaphoreGive(oldest->free);
+    }
+}
+
+/**
+ * @brief Copies a report into its mailbox and tries to send it.
+ *
+ * Args:
+ *     slot: Mailbox of the report type.
+ *     data: Report payload without the report ID.
+ *     length: Payload length in bytes.
+ *     timeout_ms: Maximum time to wait for the mailbox to empty.
+ *
+ * Returns:
+ *     ESP_OK: The report was queued.
+ *     ESP_ERR_INVALID_STATE: The USB device is not mounted.
+ *     ESP_ERR_TIMEOUT: The mailbox did not empty in time.
+ */
+static esp_err_t composite_hid_queue(
+    composite_hid_slot_t slot,
+    const void *data,
+    uint8_t length,
+    uint32_t timeout_ms)
+{
+    composite_hid_mailbox_t *mailbox = &s_mailboxes[slot];
+
+    if ((s_scheduler_lock == NULL) || !tud_mounted())
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (xSemaphoreTake(mailbox->free, pdMS_TO_TICKS(timeout_ms)) != pdTRUE)
+    {
+        return tud_mounted() ? ESP_ERR_TIMEOUT : ESP_ERR_INVALID_STATE;
+    }
+
+    xSemaphoreTake(s_scheduler_lock, portMAX_DELAY);
+    memcpy(mailbox->data, data, length);
+    mailbox->length = length;
+    mailbox->sequence = s_next_sequence++;
+    mailbox->pending = true;
+    composite_hid_send_next();
+    xSemaphoreGive(s_scheduler_lock);
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Drops every pending report and wakes the waiting senders.
+ */
+static void composite_hid_discard_pending(void)
+{
+    xSemaphoreTake(s_scheduler_lock, portMAX_DELAY);
+    for (size_t slot = 0; slot < COMPOSITE_HID_SLOT_COUNT; ++slot)
+    {
+        if (s_mailboxes[slot].pending)
+        {
+            s_mailboxes[slot].pending = false;
+            xSemaphoreGive(s_mailboxes[slot].free);
+        }
+    }
+    xSemaphoreGive(s_scheduler_lock);
+}
+
+uint8_t const *tud_hid_descriptor_report_cb(uint8_t instance)
+{
+    (void)instance;
+    return s_hid_report_descriptor;
+}
+
+uint16_t tud_hid_get_report_cb(
+    uint8_t instance,
+    uint8_t report_id,
+    hid_report_type_t report_type,
+    uint8_t *buffer,
+    uint16_t requested_length)
+{
+    (void)instance;
+    (void)report_id;
+    (void)report_type;
+    (void)buffer;
+    (void)requested_length;
+
+    // Returning zero stalls unsupported GET_REPORT requests as TinyUSB expects.
+    return 0;
+}
+
+void tud_hid_set_report_cb(
+    uint8_t instance,
+    uint8_t report_id,
+    hid_report_type_t report_type,
+    uint8_t const *buffer,
+    uint16_t buffer_size)
+{
+    (void)instance;
+    (void)report_id;
+    (void)report_type;
+    (void)buffer;
+    (void)buffer_size;
+}
+
+void tud_hid_report_complete_cb(
+    uint8_t instance,
+    uint8_t const *report,
+    uint16_t length)
+{
+    (void)instance;
+    (void)report;
+    (void)length;
+
+    xSemaphoreTake(s_scheduler_lock, portMAX_DELAY);
+    composite_hid_send_next();
+    xSemaphoreGive(s_scheduler_lock);
+}
+
+void tud_mount_cb(void)
+{
+    ESP_LOGI(TAG, "USB host mounted the device");
+}
+
+void tud_umount_cb(void)
+{
+    ESP_LOGI(TAG, "USB host unmounted the device");
+    composite_hid_discard_pending();
+}
+
+void tud_suspend_cb(bool remote_wakeup_enabled)
+{
+    ESP_LOGI(TAG, "USB bus suspended; remote wakeup=%s",
+             remote_wakeup_enabled ? "enabled" : "disabled");
+}
+
+void tud_resume_cb(void)
+{
+    ESP_LOGI(TAG, "USB bus resumed");
+
+    // Reports queued while suspended are still pending.
+    xSemaphoreTake(s_scheduler_lock, portMAX_DELAY);
+    composite_hid_send_next();
+    xSemaphoreGive(s_scheduler_lock);
+}
+
+esp_err_t composite_hid_init(const composite_hid_config_t *config)
+{
+    if (config == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (s_scheduler_lock != NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    s_string_descriptors[0] = s_language_id;
+    s_string_descriptors[1] = config->manufacturer;
+    s_string_descriptors[2] = config->product;
+    s_string_descriptors[3] = config->serial_number;
+    s_string_descriptors[4] = config->interface_name;
+
+    for (size_t slot = 0; slot < COMPOSITE_HID_SLOT_COUNT; ++slot)
+    {
+        s_mailboxes[slot].free = xSemaphoreCreateBinary();
+        if (s_mailboxes[slot].free == NULL)
+        {
+            return ESP_ERR_NO_MEM;
+        }
+        xSemaphoreGive(s_mailboxes[slot].free);
+    }
+
+    // Created last: a non-NULL lock marks the component as initialized.
+    SemaphoreHandle_t lock = xSemaphoreCreateMutex();
+    if (lock == NULL)
+    {
+        return ESP_ERR_NO_MEM;
+    }
+    s_scheduler_lock = lock;
+
+    tinyusb_config_t tusb_config = {
+        .device_descriptor = NULL,
+        .string_descriptor = s_string_descriptors,
+        .string_descriptor_count =
+            sizeof(s_string_descriptors) / sizeof(s_string_descriptors[0]),
+#if TUD_OPT_HIGH_SPEED
+        .fs_configuration_descriptor = s_configuration_descriptor,
+        .hs_configuration_descriptor = s_configuration_descriptor,
+#else
+        .configuration_descriptor = s_configuration_descriptor,
+#endif
+        .external_phy = false,
+        .self_powered = false,
+        .vbus_monitor_io = -1,
+    };
+
+    ESP_LOGI(TAG, "Installing TinyUSB composite HID driver");
+    return tinyusb_driver_install(&tusb_config);
+}
+
+esp_err_t composite_hid_send_keyboard(
+    uint8_t modifier,
+    const uint8_t keycodes[6],
+    uint32_t timeout_ms)
+{
+    hid_keyboard_report_t report = {
+        .modifier = modifier,
+        .reserved = 0,
+    };
+
+    memcpy(report.keycode, keycodes, sizeof(report.keycode));
+    return composite_hid_queue(COMPOSITE_HID_SLOT_KEYBOARD, &report, sizeof(report), timeout_ms);
+}
+
+esp_err_t composite_hid_send_consumer(uint16_t usage, uint32_t timeout_ms)
+{
+    return composite_hid_queue(COMPOSITE_HID_SLOT_CONSUMER, &usage, sizeof(usage), timeout_ms);
+}
+
+esp_err_t composite_hid_send_mouse(
+    uint8_t buttons,
+    int8_t delta_x,
+    int8_t delta_y,
+    int8_t wheel,
+    int8_t pan,
+    uint32_t timeout_ms)
+{
+    const hid_mouse_report_t report = {
+        .buttons = buttons,
+        .x = delta_x,
+        .y = delta_y,
+        .wheel = wheel,
+        .pan = pan,
+    };
+
+    return composite_hid_queue(COMPOSITE_HID_SLOT_MOUSE, &report, sizeof(report), timeout_ms);
+}
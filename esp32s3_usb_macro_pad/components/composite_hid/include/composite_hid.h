@@ -0,0 +1,121 @@
+#ifndef COMPOSITE_HID_H
+#define COMPOSITE_HID_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Report IDs of the composite HID interface.
+ */
+typedef enum
+{
+    COMPOSITE_HID_REPORT_ID_KEYBOARD = 1,
+    COMPOSITE_HID_REPORT_ID_CONSUMER = 2,
+    COMPOSITE_HID_REPORT_ID_MOUSE = 3,
+} composite_hid_report_id_t;
+
+/**
+ * @brief USB strings of the composite device.
+ */
+typedef struct
+{
+    const char *manufacturer;
+    const char *product;
+    const char *serial_number;
+    const char *interface_name;
+} composite_hid_config_t;
+
+/**
+ * @brief Installs TinyUSB with one HID interface carrying three reports.
+ *
+ * The interface has a six-key keyboard, a consumer control usage, and a
+ * relative mouse report, and the host polls it every millisecond. This
+ * component implements every tud_hid_* callback, so an application that
+ * uses it must not define them.
+ *
+ * Args:
+ *     config: USB strings. The pointers must stay valid while USB runs.
+ *
+ * Returns:
+ *     ESP_OK: The TinyUSB driver was installed successfully.
+ *     ESP_ERR_INVALID_ARG: config is NULL.
+ *     ESP_ERR_INVALID_STATE: The component is already initialized.
+ *     ESP_ERR_NO_MEM: The scheduler objects could not be created.
+ *     Other: An ESP-IDF or TinyUSB driver error code.
+ */
+esp_err_t composite_hid_init(const composite_hid_config_t *config);
+
+/**
+ * @brief Queues one keyboard report.
+ *
+ * Each report type has a one-report mailbox. The call waits until the
+ * previous keyboard report has been handed to USB, stores this one, and
+ * returns without waiting for the host to read it.
+ *
+ * One report is sent per USB frame, oldest first. Because every type holds
+ * at most one pending report, a report never waits behind more than one
+ * report of each other type, so a long keyboard sequence cannot hold back
+ * mouse or consumer reports. Reports of different types reach the host in
+ * the order they were queued.
+ *
+ * Args:
+ *     modifier: HID keyboard modifier bitmap.
+ *     keycodes: Six HID usage IDs of the pressed keys; unused entries are 0.
+ *     timeout_ms: Maximum time to wait for the mailbox.
+ *
+ * Returns:
+ *     ESP_OK: The report was queued.
+ *     ESP_ERR_INVALID_STATE: The USB device is not mounted.
+ *     ESP_ERR_TIMEOUT: The previous keyboard report was not sent in time.
+ */
+esp_err_t composite_hid_send_keyboard(
+    uint8_t modifier,
+    const uint8_t keycodes[6],
+    uint32_t timeout_ms);
+
+/**
+ * @brief Queues one consumer control report.
+ *
+ * Args:
+ *     usage: Consumer page usage ID, such as 0x00E9 for Volume Up, or 0 to
+ *         release the control.
+ *     timeout_ms: Maximum time to wait for the mailbox.
+ *
+ * Returns:
+ *     The same codes as composite_hid_send_keyboard().
+ */
+esp_err_t composite_hid_send_consumer(uint16_t usage, uint32_t timeout_ms);
+
+/**
+ * @brief Queues one relative mouse report.
+ *
+ * Args:
+ *     buttons: Mouse button bitmap; bit 0 is the left button.
+ *     delta_x: Horizontal movement in counts.
+ *     delta_y: Vertical movement in counts.
+ *     wheel: Vertical wheel movement in detents.
+ *     pan: Horizontal wheel movement in detents.
+ *     timeout_ms: Maximum time to wait for the mailbox.
+ *
+ * Returns:
+ *     The same codes as composite_hid_send_keyboard().
+ */
+esp_err_t composite_hid_send_mouse(
+    uint8_t buttons,
+    int8_t delta_x,
+    int8_t delta_y,
+    int8_t wheel,
+    int8_t pan,
+    uint32_t timeout_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -3,6 +3,7 @@
 #include "usb_hid_keyboard.h"
 
 #include "esp_log.h"
+#include "nvs_flash.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/queue.h"
 #include "freertos/task.h"
@@ -18,14 +19,25 @@ static const char *TAG = "macro_pad";
 /**
  * @brief Initializes the USB macro pad and starts its worker tasks.
  *
- * The application uses one task for periodic button scanning and one task for
+ * The application uses one interrupt-driven button task and one task for
  * serialized macro execution. A FreeRTOS queue decouples input processing
  * from USB report timing.
  */
 void app_main(void)
 {
     ESP_LOGI(TAG, "Starting ESP32-S3 USB macro pad");
-    ESP_LOGI(TAG, "Buttons: GPIO4=Copy, GPIO5=Paste, GPIO6=Save, GPIO7=Task Manager");
+    ESP_LOGI(TAG, "Default buttons: GPIO4=Copy, GPIO5=Paste, GPIO6=Save, GPIO7=Task Manager");
+
+    // Initialize NVS, which holds the user macro set. A partition written by an
+    // older NVS version or without free pages is erased and reinitialized.
+    esp_err_t nvs_result = nvs_flash_init();
+    if ((nvs_result == ESP_ERR_NVS_NO_FREE_PAGES) ||
+        (nvs_result == ESP_ERR_NVS_NEW_VERSION_FOUND))
+    {
+        ESP_ERROR_CHECK(nvs_flash_erase());
+        nvs_result = nvs_flash_init();
+    }
+    ESP_ERROR_CHECK(nvs_result);
 
     // Initialize the button driver. This configures the GPIO pins and sets up any necessary interrupts for button scanning.
     ESP_ERROR_CHECK(button_driver_init());
@@ -40,8 +52,8 @@ void app_main(void)
         sizeof(button_event_t));
     configASSERT(macro_event_queue != NULL);
 
-    // Create the button scanning task. This task will periodically read the state of the buttons 
-    // and send events to the macro engine task via the queue.
+    // Create the button scanning task. This task sleeps until a button edge, debounces the inputs,
+    // and sends events to the macro engine task via the queue.
     BaseType_t task_created = xTaskCreate(
         button_driver_task,
         "button_scan",
@@ -3,14 +3,43 @@
 #include <stdbool.h>
 
 #include "driver/gpio.h"
+#include "esp_attr.h"
+#include "esp_check.h"
 #include "esp_log.h"
+#include "esp_rom_sys.h"
+#include "esp_timer.h"
 #include "freertos/task.h"
 
-#define BUTTON_SCAN_PERIOD_MS 5U
-#define BUTTON_DEBOUNCE_TIME_MS 20U
+#define BUTTON_SAMPLE_PERIOD_US 1000U
+#define BUTTON_INTEGRATOR_MAX 4U
+#define BUTTON_MATRIX_SETTLE_US 5U
+
+#define BUTTON_NOTIFY_EDGE (1UL << 0)
+#define BUTTON_NOTIFY_SAMPLE (1UL << 1)
 
 static const char *TAG = "button_driver";
 
+#if BUTTON_DRIVER_MATRIX_SCAN
+static const gpio_num_t s_row_pins[BUTTON_DRIVER_MATRIX_ROWS] =
+{
+    GPIO_NUM_4,
+    GPIO_NUM_5,
+    GPIO_NUM_6,
+    GPIO_NUM_7,
+};
+
+static const gpio_num_t s_column_pins[BUTTON_DRIVER_MATRIX_COLUMNS] =
+{
+    GPIO_NUM_8,
+    GPIO_NUM_9,
+    GPIO_NUM_10,
+    GPIO_NUM_11,
+};
+
+// Any pressed key pulls its column low while the rows are held low.
+#define BUTTON_WAKE_PIN_COUNT BUTTON_DRIVER_MATRIX_COLUMNS
+static const gpio_num_t *const s_wake_pins = s_column_pins;
+#else
 static const gpio_num_t s_button_pins[BUTTON_DRIVER_BUTTON_COUNT] =
 {
     GPIO_NUM_4,
@@ -19,62 +48,271 @@ static const gpio_num_t s_button_pins[BUTTON_DRIVER_BUTTON_COUNT] =
     GPIO_NUM_7,
 };
 
+#define BUTTON_WAKE_PIN_COUNT BUTTON_DRIVER_BUTTON_COUNT
+static const gpio_num_t *const s_wake_pins = s_button_pins;
+#endif
+
 typedef struct
 {
-    bool raw_pressed;
+    uint8_t integrator;
     bool stable_pressed;
-    TickType_t raw_change_tick;
 } button_state_t;
 
+static TaskHandle_t volatile s_button_task;
+static esp_timer_handle_t s_sample_timer;
+
+/**
+ * @brief Wakes the button task on a falling edge of any wake input.
+ */
+static void IRAM_ATTR button_driver_edge_isr(void *arg)
+{
+    BaseType_t higher_priority_task_woken = pdFALSE;
+
+    (void)arg;
+
+    if (s_button_task != NULL)
+    {
+        xTaskNotifyFromISR(s_button_task, BUTTON_NOTIFY_EDGE, eSetBits,
+                           &higher_priority_task_woken);
+    }
+
+    portYIELD_FROM_ISR(higher_priority_task_woken);
+}
+
+/**
+ * @brief Requests one debounce sample from the button task.
+ */
+static void button_driver_sample_timer_cb(void *arg)
+{
+    (void)arg;
+
+    if (s_button_task != NULL)
+    {
+        xTaskNotify(s_button_task, BUTTON_NOTIFY_SAMPLE, eSetBits);
+    }
+}
+
+#if BUTTON_DRIVER_MATRIX_SCAN
 /**
- * @brief Reads one active-low button input.
+ * @brief Drives every matrix row to the same level.
  *
  * Args:
- *     button_index: Zero-based index into the configured button table.
+ *     level: 0 to pull all rows low, 1 to release them.
+ */
+static void button_driver_set_rows(uint32_t level)
+{
+    for (size_t row = 0; row < BUTTON_DRIVER_MATRIX_ROWS; ++row)
+    {
+        gpio_set_level(s_row_pins[row], level);
+    }
+}
+#endif
+
+/**
+ * @brief Reads the raw state of every button.
+ *
+ * In matrix mode one row at a time is pulled low and the columns are read.
+ * The rows are left low afterwards so that a new press raises a column
+ * interrupt.
+ *
+ * Args:
+ *     pressed: Receives true for each button whose switch is closed.
  *
  * Returns:
- *     true: The switch is currently pressed.
- *     false: The switch is currently released.
+ *     true: At least one switch is closed.
+ *     false: All switches are open.
  */
-static bool button_driver_read_pressed(size_t button_index)
+static bool button_driver_read_pressed(bool pressed[BUTTON_DRIVER_BUTTON_COUNT])
 {
-    return gpio_get_level(s_button_pins[button_index]) == 0;
+    bool any_pressed = false;
+
+#if BUTTON_DRIVER_MATRIX_SCAN
+    button_driver_set_rows(1U);
+
+    for (size_t row = 0; row < BUTTON_DRIVER_MATRIX_ROWS; ++row)
+    {
+        gpio_set_level(s_row_pins[row], 0U);
+        esp_rom_delay_us(BUTTON_MATRIX_SETTLE_US);
+
+        for (size_t column = 0; column < BUTTON_DRIVER_MATRIX_COLUMNS; ++column)
+        {
+            const size_t index = (row * BUTTON_DRIVER_MATRIX_COLUMNS) + column;
+            pressed[index] = gpio_get_level(s_column_pins[column]) == 0;
+            any_pressed |= pressed[index];
+        }
+
+        gpio_set_level(s_row_pins[row], 1U);
+    }
+
+    button_driver_set_rows(0U);
+#else
+    for (size_t index = 0; index < BUTTON_DRIVER_BUTTON_COUNT; ++index)
+    {
+        pressed[index] = gpio_get_level(s_button_pins[index]) == 0;
+        any_pressed |= pressed[index];
+    }
+#endif
+
+    return any_pressed;
+}
+
+/**
+ * @brief Enables or disables the edge interrupts that wake the task.
+ */
+static void button_driver_set_wake_enabled(bool enabled)
+{
+    for (size_t index = 0; index < BUTTON_WAKE_PIN_COUNT; ++index)
+    {
+        if (enabled)
+        {
+            gpio_intr_enable(s_wake_pins[index]);
+        }
+        else
+        {
+            gpio_intr_disable(s_wake_pins[index]);
+        }
+    }
 }
 
 /**
  * @brief Initializes the button driver.
  *
- * This function configures the GPIO pins for button inputs.
+ * This function configures the GPIO pins, installs the edge interrupts, and
+ * creates the debounce sample timer.
  *
  * Returns:
  *     ESP_OK: The button driver was initialized successfully.
- *     Other: Error returned by the GPIO configuration function.
+ *     Other: Error returned by the GPIO or timer functions.
  */
 esp_err_t button_driver_init(void)
 {
-    uint64_t pin_mask = 0U;
+    uint64_t input_mask = 0U;
 
-    for (size_t index = 0; index < BUTTON_DRIVER_BUTTON_COUNT; ++index)
+    for (size_t index = 0; index < BUTTON_WAKE_PIN_COUNT; ++index)
+    {
+        input_mask |= (1ULL << s_wake_pins[index]);
+    }
+
+#if BUTTON_DRIVER_MATRIX_SCAN
+    uint64_t row_mask = 0U;
+
+    for (size_t row = 0; row < BUTTON_DRIVER_MATRIX_ROWS; ++row)
     {
-        pin_mask |= (1ULL << s_button_pins[index]);
+        row_mask |= (1ULL << s_row_pins[row]);
     }
 
-    const gpio_config_t config =
+    const gpio_config_t row_config =
     {
-        .pin_bit_mask = pin_mask,
+        .pin_bit_mask = row_mask,
+        .mode = GPIO_MODE_OUTPUT_OD,
+        .pull_up_en = GPIO_PULLUP_DISABLE,
+        .pull_down_en = GPIO_PULLDOWN_DISABLE,
+        .intr_type = GPIO_INTR_DISABLE,
+    };
+
+    ESP_RETURN_ON_ERROR(gpio_config(&row_config), TAG, "Row GPIO configuration failed");
+    button_driver_set_rows(0U);
+#endif
+
+    const gpio_config_t input_config =
+    {
+        .pin_bit_mask = input_mask,
         .mode = GPIO_MODE_INPUT,
         .pull_up_en = GPIO_PULLUP_ENABLE,
         .pull_down_en = GPIO_PULLDOWN_DISABLE,
-        .intr_type = GPIO_INTR_DISABLE,
+        .intr_type = GPIO_INTR_NEGEDGE,
     };
 
-    return gpio_config(&config);
+    ESP_RETURN_ON_ERROR(gpio_config(&input_config), TAG, "Input GPIO configuration failed");
+
+    // Another component may already have installed the shared ISR service.
+    const esp_err_t isr_result = gpio_install_isr_service(0);
+    ESP_RETURN_ON_FALSE((isr_result == ESP_OK) || (isr_result == ESP_ERR_INVALID_STATE),
+                        isr_result, TAG, "GPIO ISR service installation failed");
+
+    for (size_t index = 0; index < BUTTON_WAKE_PIN_COUNT; ++index)
+    {
+        ESP_RETURN_ON_ERROR(gpio_isr_handler_add(s_wake_pins[index], button_driver_edge_isr, NULL),
+                            TAG, "GPIO ISR handler registration failed");
+    }
+
+    const esp_timer_create_args_t timer_args =
+    {
+        .callback = button_driver_sample_timer_cb,
+        .name = "button_sample",
+    };
+
+    return esp_timer_create(&timer_args, &s_sample_timer);
+}
+
+/**
+ * @brief Feeds one sample into the integrating debouncers.
+ *
+ * Each integrator counts up while its switch reads closed and down while it
+ * reads open. The stable state changes only when the count reaches either
+ * end, so a bounce has to last several consecutive samples to register.
+ *
+ * Args:
+ *     states: Debouncer state of every button.
+ *     event_queue: Queue that receives press events.
+ *
+ * Returns:
+ *     true: A button is pressed or still settling, so sampling must go on.
+ *     false: Every button is released and settled.
+ */
+static bool button_driver_debounce(button_state_t *states, QueueHandle_t event_queue)
+{
+    bool pressed[BUTTON_DRIVER_BUTTON_COUNT];
+    bool active = false;
+
+    (void)button_driver_read_pressed(pressed);
+
+    for (size_t index = 0; index < BUTTON_DRIVER_BUTTON_COUNT; ++index)
+    {
+        button_state_t *state = &states[index];
+
+        if (pressed[index] && (state->integrator < BUTTON_INTEGRATOR_MAX))
+        {
+            ++state->integrator;
+        }
+        else if (!pressed[index] && (state->integrator > 0U))
+        {
+            --state->integrator;
+        }
+
+        if (state->integrator == 0U)
+        {
+            state->stable_pressed = false;
+        }
+        else if ((state->integrator == BUTTON_INTEGRATOR_MAX) && !state->stable_pressed)
+        {
+            state->stable_pressed = true;
+
+            // Only the press edge generates a macro event.
+            const button_event_t event =
+            {
+                .button_index = (uint8_t)index,
+            };
+
+            if (xQueueSend(event_queue, &event, 0) != pdPASS)
+            {
+                ESP_LOGW(TAG, "Macro queue full; button %u dropped",
+                         (unsigned int)(index + 1U));
+            }
+        }
+
+        active |= (state->integrator != 0U);
+    }
+
+    return active;
 }
 
 /**
  * @brief Task function for the button driver.
  *
- * This task periodically reads the state of the buttons and sends events to the macro engine task.
+ * This task sleeps until a button edge interrupt fires, debounces the inputs
+ * from the sample timer until they are all released, and sends events to the
+ * macro engine task.
  *
  * Args:
  *     context: Pointer to the FreeRTOS queue handle.
@@ -83,62 +321,56 @@ void button_driver_task(void *context)
 {
     QueueHandle_t event_queue = (QueueHandle_t)context;
     button_state_t states[BUTTON_DRIVER_BUTTON_COUNT] = {0};
-    const TickType_t scan_period = pdMS_TO_TICKS(BUTTON_SCAN_PERIOD_MS);
-    const TickType_t debounce_ticks = pdMS_TO_TICKS(BUTTON_DEBOUNCE_TIME_MS);
+    bool pressed[BUTTON_DRIVER_BUTTON_COUNT];
+    bool sampling = false;
 
     configASSERT(event_queue != NULL);
+    configASSERT(s_sample_timer != NULL);
 
-    const TickType_t initial_tick = xTaskGetTickCount();
+    // Buttons held at startup are treated as already pressed.
+    (void)button_driver_read_pressed(pressed);
 
     for (size_t index = 0; index < BUTTON_DRIVER_BUTTON_COUNT; ++index)
     {
-        const bool pressed = button_driver_read_pressed(index);
-        states[index].raw_pressed = pressed;
-        states[index].stable_pressed = pressed;
-        states[index].raw_change_tick = initial_tick;
+        states[index].stable_pressed = pressed[index];
+        states[index].integrator = pressed[index] ? BUTTON_INTEGRATOR_MAX : 0U;
     }
 
+    s_button_task = xTaskGetCurrentTaskHandle();
     ESP_LOGI(TAG, "Button scanner started");
 
     while (true)
     {
-        const TickType_t now = xTaskGetTickCount();
+        uint32_t notification = 0U;
 
-        for (size_t index = 0; index < BUTTON_DRIVER_BUTTON_COUNT; ++index)
+        if (!sampling)
         {
-            const bool current_raw_pressed = button_driver_read_pressed(index);
+            // Check once more after enabling the interrupts, so an edge that
+            // arrived while they were off is not lost.
+            button_driver_set_wake_enabled(true);
 
-            if (current_raw_pressed != states[index].raw_pressed)
+            if (!button_driver_read_pressed(pressed))
             {
-                states[index].raw_pressed = current_raw_pressed;
-                states[index].raw_change_tick = now;
+                (void)xTaskNotifyWait(0U, UINT32_MAX, &notification, portMAX_DELAY);
             }
 
-            const bool debounce_elapsed =
-                (now - states[index].raw_change_tick) >= debounce_ticks;
+            // The edge interrupts would only repeat what the timer samples.
+            button_driver_set_wake_enabled(false);
+            ESP_ERROR_CHECK(esp_timer_start_periodic(s_sample_timer, BUTTON_SAMPLE_PERIOD_US));
+            sampling = true;
+        }
 
-            if (debounce_elapsed &&
-                (states[index].stable_pressed != states[index].raw_pressed))
-            {
-                states[index].stable_pressed = states[index].raw_pressed;
-
-                // Only the press edge generates a macro event.
-                if (states[index].stable_pressed)
-                {
-                    const button_event_t event =
-                    {
-                        .button_index = (uint8_t)index,
-                    };
-
-                    if (xQueueSend(event_queue, &event, 0) != pdPASS)
-                    {
-                        ESP_LOGW(TAG, "Macro queue full; button %u dropped",
-                                 (unsigned int)(index + 1U));
-                    }
-                }
-            }
+        (void)xTaskNotifyWait(0U, UINT32_MAX, &notification, portMAX_DELAY);
+
+        if ((notification & BUTTON_NOTIFY_SAMPLE) == 0U)
+        {
+            continue;
         }
 
-        vTaskDelay(scan_period);
+        if (!button_driver_debounce(states, event_queue))
+        {
+            (void)esp_timer_stop(s_sample_timer);
+            sampling = false;
+        }
     }
 }
@@ -12,8 +12,25 @@
 extern "C" {
 #endif
 
+/**
+ * Set to 1 to read the buttons as a row/column key matrix instead of one
+ * GPIO per button. The pins are listed in button_driver.c.
+ */
+#ifndef BUTTON_DRIVER_MATRIX_SCAN
+#define BUTTON_DRIVER_MATRIX_SCAN 0
+#endif
+
+#if BUTTON_DRIVER_MATRIX_SCAN
+/** Number of matrix rows, driven by the scanner. */
+#define BUTTON_DRIVER_MATRIX_ROWS 4U
+/** Number of matrix columns, read with pull-ups. */
+#define BUTTON_DRIVER_MATRIX_COLUMNS 4U
+/** Number of physical macro-pad buttons. Button index is row * columns + column. */
+#define BUTTON_DRIVER_BUTTON_COUNT (BUTTON_DRIVER_MATRIX_ROWS * BUTTON_DRIVER_MATRIX_COLUMNS)
+#else
 /** Number of physical macro-pad buttons. */
 #define BUTTON_DRIVER_BUTTON_COUNT 4U
+#endif
 
 /**
  * @brief Event generated when a debounced button is pressed.
@@ -26,13 +43,17 @@ typedef struct
 /**
  * @brief Initializes the macro-pad button inputs.
  *
- * The four buttons are configured as active-low GPIO inputs with internal
+ * The buttons are configured as active-low GPIO inputs with internal
  * pull-up resistors. Each switch must connect its GPIO pin to ground when
- * pressed.
+ * pressed. In matrix mode the rows are open-drain outputs held low while
+ * idle, and each switch connects a row to a column.
+ *
+ * A falling-edge interrupt is installed on every input and the sample timer
+ * is created, but neither does anything until button_driver_task() runs.
  *
  * Returns:
  *     ESP_OK: The GPIO inputs were configured successfully.
- *     Other: An ESP-IDF GPIO driver error code.
+ *     Other: An ESP-IDF GPIO or timer error code.
  */
 esp_err_t button_driver_init(void);
 
@@ -40,8 +61,11 @@ esp_err_t button_driver_init(void);
  * @brief Runs the button scanner and publishes debounced press events.
  *
  * This function is intended to be used directly as a FreeRTOS task entry
- * point. It scans the inputs periodically, performs time-based software
- * debouncing, and sends one event for each released-to-pressed transition.
+ * point. While every button is released the task blocks until a GPIO edge
+ * interrupt wakes it. It then samples the inputs from a 1 ms timer through
+ * an integrating debouncer until all buttons are released and settled, and
+ * goes back to sleep. One event is sent for each released-to-pressed
+ * transition, a few milliseconds after the contact first closes.
  *
  * Args:
  *     context: QueueHandle_t cast to void*. The queue receives button_event_t
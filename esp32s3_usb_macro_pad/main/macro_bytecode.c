@@ -0,0 +1,355 @@
+#include "macro_bytecode.h"
+
+#include <stdbool.h>
+#include <string.h>
+
+#include "class/hid/hid.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "usb_hid_keyboard.h"
+
+#define MACRO_KEY_SLOTS 6U
+#define MACRO_FIRST_MODIFIER_USAGE HID_KEY_CONTROL_LEFT
+#define MACRO_LAST_MODIFIER_USAGE HID_KEY_GUI_RIGHT
+#define MACRO_MOUSE_BUTTON_MASK 0x1FU
+
+typedef struct
+{
+    uint8_t modifier;
+    uint8_t keycodes[MACRO_KEY_SLOTS];
+    uint8_t mouse_buttons;
+} macro_hid_state_t;
+
+static const uint8_t s_ascii_to_keycode[128][2] = {HID_ASCII_TO_KEYCODE};
+
+/**
+ * @brief Returns the number of fixed operand bytes of an opcode.
+ *
+ * Args:
+ *     opcode: Instruction opcode.
+ *
+ * Returns:
+ *     Operand length in bytes, or -1 for an unknown opcode. MACRO_OP_TEXT
+ *     returns 1 for its length byte; the text follows.
+ */
+static int macro_bytecode_operand_length(uint8_t opcode)
+{
+    switch (opcode)
+    {
+        case MACRO_OP_END:
+        case MACRO_OP_RELEASE_ALL:
+            return 0;
+
+        case MACRO_OP_KEY_DOWN:
+        case MACRO_OP_KEY_UP:
+        case MACRO_OP_KEY_TAP:
+        case MACRO_OP_TEXT:
+        case MACRO_OP_MOUSE_BUTTONS:
+            return 1;
+
+        case MACRO_OP_DELAY:
+        case MACRO_OP_CONSUMER:
+            return 2;
+
+        case MACRO_OP_MOUSE_MOVE:
+            return 3;
+
+        default:
+            return -1;
+    }
+}
+
+/**
+ * @brief Checks whether a keyboard usage is a modifier key.
+ */
+static bool macro_bytecode_is_modifier(uint8_t usage)
+{
+    return (usage >= MACRO_FIRST_MODIFIER_USAGE) &&
+           (usage <= MACRO_LAST_MODIFIER_USAGE);
+}
+
+esp_err_t macro_bytecode_validate(const uint8_t *code, size_t length)
+{
+    size_t offset = 0;
+
+    if (code == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    while (offset < length)
+    {
+        const uint8_t opcode = code[offset];
+        const int operand_length = macro_bytecode_operand_length(opcode);
+
+        if ((operand_length < 0) ||
+            ((offset + 1U + (size_t)operand_length) > length))
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+
+        const uint8_t *operands = &code[offset + 1U];
+        offset += 1U + (size_t)operand_length;
+
+        switch (opcode)
+        {
+            case MACRO_OP_END:
+                return ESP_OK;
+
+            case MACRO_OP_KEY_DOWN:
+            case MACRO_OP_KEY_UP:
+            case MACRO_OP_KEY_TAP:
+                if ((operands[0] == HID_KEY_NONE) ||
+                    (operands[0] > MACRO_LAST_MODIFIER_USAGE))
+                {
+                    return ESP_ERR_INVALID_ARG;
+                }
+                break;
+
+            case MACRO_OP_TEXT:
+                if ((offset + operands[0]) > length)
+                {
+                    return ESP_ERR_INVALID_ARG;
+                }
+
+                // Reject characters the layout table cannot type.
+                for (size_t index = 0; index < operands[0]; ++index)
+                {
+                    const uint8_t character = code[offset + index];
+                    if ((character >= 128U) ||
+                        (s_ascii_to_keycode[character][1] == HID_KEY_NONE))
+                    {
+                        return ESP_ERR_INVALID_ARG;
+                    }
+                }
+
+                offset += operands[0];
+                break;
+
+            case MACRO_OP_MOUSE_BUTTONS:
+                if ((operands[0] & ~MACRO_MOUSE_BUTTON_MASK) != 0U)
+                {
+                    return ESP_ERR_INVALID_ARG;
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    // The buffer ended before MACRO_OP_END.
+    return ESP_ERR_INVALID_ARG;
+}
+
+/**
+ * @brief Presses or releases one key in the held-key state.
+ *
+ * Returns:
+ *     ESP_OK: The state changed or already matched.
+ *     ESP_ERR_INVALID_SIZE: Six non-modifier keys are already held.
+ */
+static esp_err_t macro_bytecode_set_key(
+    macro_hid_state_t *state,
+    uint8_t usage,
+    bool pressed)
+{
+    if (macro_bytecode_is_modifier(usage))
+    {
+        const uint8_t bit = (uint8_t)(1U << (usage - MACRO_FIRST_MODIFIER_USAGE));
+        state->modifier = pressed ? (uint8_t)(state->modifier | bit)
+                                  : (uint8_t)(state->modifier & ~bit);
+        return ESP_OK;
+    }
+
+    size_t free_slot = MACRO_KEY_SLOTS;
+
+    for (size_t slot = 0; slot < MACRO_KEY_SLOTS; ++slot)
+    {
+        if (state->keycodes[slot] == usage)
+        {
+            if (!pressed)
+            {
+                state->keycodes[slot] = HID_KEY_NONE;
+            }
+            return ESP_OK;
+        }
+
+        if ((state->keycodes[slot] == HID_KEY_NONE) && (free_slot == MACRO_KEY_SLOTS))
+        {
+            free_slot = slot;
+        }
+    }
+
+    if (!pressed)
+    {
+        return ESP_OK;
+    }
+
+    if (free_slot == MACRO_KEY_SLOTS)
+    {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    state->keycodes[free_slot] = usage;
+    return ESP_OK;
+}
+
+/**
+ * @brief Types ASCII text, one report per character where possible.
+ *
+ * Each report presses the next character, which also releases the previous
+ * one. An extra report is needed only when Shift changes, so the host applies
+ * it before the key, or when a key repeats and must be seen released first.
+ * Keys held before the text are released.
+ */
+static esp_err_t macro_bytecode_type_text(
+    macro_hid_state_t *state,
+    const uint8_t *text,
+    size_t length)
+{
+    uint8_t keycodes[MACRO_KEY_SLOTS] = {0};
+    uint8_t modifier = state->modifier;
+    esp_err_t result = ESP_OK;
+
+    memset(state->keycodes, 0, sizeof(state->keycodes));
+    state->modifier = 0;
+
+    for (size_t index = 0; (index < length) && (result == ESP_OK); ++index)
+    {
+        const uint8_t *entry = s_ascii_to_keycode[text[index]];
+        const uint8_t next_modifier = entry[0] ? KEYBOARD_MODIFIER_LEFTSHIFT : 0U;
+
+        if ((next_modifier != modifier) || (entry[1] == keycodes[0]))
+        {
+            modifier = next_modifier;
+            keycodes[0] = HID_KEY_NONE;
+            result = usb_hid_keyboard_send_keys(modifier, keycodes);
+        }
+
+        if (result == ESP_OK)
+        {
+            keycodes[0] = entry[1];
+            result = usb_hid_keyboard_send_keys(modifier, keycodes);
+        }
+    }
+
+    if (result == ESP_OK)
+    {
+        keycodes[0] = HID_KEY_NONE;
+        result = usb_hid_keyboard_send_keys(0, keycodes);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Releases every key and mouse button that is still held.
+ */
+static esp_err_t macro_bytecode_release_all(macro_hid_state_t *state)
+{
+    static const uint8_t s_no_keys[MACRO_KEY_SLOTS] = {0};
+    esp_err_t result = ESP_OK;
+
+    if ((state->modifier != 0U) ||
+        (memcmp(state->keycodes, s_no_keys, sizeof(s_no_keys)) != 0))
+    {
+        memset(state->keycodes, 0, sizeof(state->keycodes));
+        state->modifier = 0;
+        result = usb_hid_keyboard_send_keys(0, state->keycodes);
+    }
+
+    if ((result == ESP_OK) && (state->mouse_buttons != 0U))
+    {
+        state->mouse_buttons = 0;
+        result = usb_hid_keyboard_send_mouse(0, 0, 0, 0);
+    }
+
+    return result;
+}
+
+esp_err_t macro_bytecode_run(const uint8_t *code)
+{
+    macro_hid_state_t state = {0};
+    esp_err_t result = ESP_OK;
+    size_t offset = 0;
+
+    while (result == ESP_OK)
+    {
+        const uint8_t opcode = code[offset];
+        const uint8_t *operands = &code[offset + 1U];
+        offset += 1U + (size_t)macro_bytecode_operand_length(opcode);
+
+        switch (opcode)
+        {
+            case MACRO_OP_END:
+                return macro_bytecode_release_all(&state);
+
+            case MACRO_OP_KEY_DOWN:
+            case MACRO_OP_KEY_UP:
+                result = macro_bytecode_set_key(&state, operands[0],
+                                                opcode == MACRO_OP_KEY_DOWN);
+                if (result == ESP_OK)
+                {
+                    result = usb_hid_keyboard_send_keys(state.modifier, state.keycodes);
+                }
+                break;
+
+            case MACRO_OP_KEY_TAP:
+                result = macro_bytecode_set_key(&state, operands[0], true);
+                if (result == ESP_OK)
+                {
+                    result = usb_hid_keyboard_send_keys(state.modifier, state.keycodes);
+                }
+                if (result == ESP_OK)
+                {
+                    (void)macro_bytecode_set_key(&state, operands[0], false);
+                    result = usb_hid_keyboard_send_keys(state.modifier, state.keycodes);
+                }
+                break;
+
+            case MACRO_OP_RELEASE_ALL:
+                result = macro_bytecode_release_all(&state);
+                break;
+
+            case MACRO_OP_TEXT:
+                result = macro_bytecode_type_text(&state, &operands[1], operands[0]);
+                offset += operands[0];
+                break;
+
+            case MACRO_OP_DELAY:
+                vTaskDelay(pdMS_TO_TICKS((uint32_t)operands[0] |
+                                         ((uint32_t)operands[1] << 8)));
+                break;
+
+            case MACRO_OP_CONSUMER:
+                result = usb_hid_keyboard_send_consumer(
+                    (uint16_t)(operands[0] | (operands[1] << 8)));
+                if (result == ESP_OK)
+                {
+                    result = usb_hid_keyboard_send_consumer(0);
+                }
+                break;
+
+            case MACRO_OP_MOUSE_BUTTONS:
+                state.mouse_buttons = operands[0];
+                result = usb_hid_keyboard_send_mouse(state.mouse_buttons, 0, 0, 0);
+                break;
+
+            case MACRO_OP_MOUSE_MOVE:
+                result = usb_hid_keyboard_send_mouse(state.mouse_buttons,
+                                                     (int8_t)operands[0],
+                                                     (int8_t)operands[1],
+                                                     (int8_t)operands[2]);
+                break;
+
+            default:
+                result = ESP_ERR_INVALID_ARG;
+                break;
+        }
+    }
+
+    // Best effort: do not leave keys stuck down after a failure.
+    (void)macro_bytecode_release_all(&state);
+    return result;
+}
@@ -0,0 +1,75 @@
+#ifndef MACRO_BYTECODE_H
+#define MACRO_BYTECODE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Macro bytecode instructions.
+ *
+ * A macro is a sequence of one-byte opcodes, each followed by its operands.
+ * Multi-byte operands are little-endian. Every instruction that changes the
+ * HID state sends exactly one report, so a macro runs at the USB report rate
+ * unless it contains DELAY instructions.
+ *
+ * Keyboard usages 0xE0 through 0xE7 are the modifier keys (left Ctrl, Shift,
+ * Alt, GUI, then the right-hand ones). Up to six other keys can be held.
+ */
+typedef enum
+{
+    MACRO_OP_END = 0x00,           /**< End of macro. Held keys are released. */
+    MACRO_OP_KEY_DOWN = 0x01,      /**< usage: press and hold a key. */
+    MACRO_OP_KEY_UP = 0x02,        /**< usage: release a held key. */
+    MACRO_OP_KEY_TAP = 0x03,       /**< usage: press and release a key. */
+    MACRO_OP_RELEASE_ALL = 0x04,   /**< Release all keys and mouse buttons. */
+    MACRO_OP_TEXT = 0x05,          /**< length, ASCII bytes: type text. */
+    MACRO_OP_DELAY = 0x06,         /**< u16 milliseconds: pause. */
+    MACRO_OP_CONSUMER = 0x07,      /**< u16 usage: tap a consumer control. */
+    MACRO_OP_MOUSE_BUTTONS = 0x08, /**< bitmap: set the held mouse buttons. */
+    MACRO_OP_MOUSE_MOVE = 0x09,    /**< s8 x, s8 y, s8 wheel: move the mouse. */
+} macro_opcode_t;
+
+/**
+ * @brief Checks that a macro is well formed.
+ *
+ * The macro must end with MACRO_OP_END inside the buffer, and every opcode
+ * and operand must be valid. Macros are checked once when they are loaded,
+ * so the interpreter does not need to check them again.
+ *
+ * Args:
+ *     code: Macro bytecode.
+ *     length: Number of bytes in code.
+ *
+ * Returns:
+ *     ESP_OK: The macro can be run.
+ *     ESP_ERR_INVALID_ARG: code is NULL or the macro is malformed.
+ */
+esp_err_t macro_bytecode_validate(const uint8_t *code, size_t length);
+
+/**
+ * @brief Runs a validated macro.
+ *
+ * Reports are sent back to back, each one as soon as the host has read the
+ * previous one. All keys and mouse buttons are released when the macro ends
+ * or fails.
+ *
+ * Args:
+ *     code: Macro bytecode accepted by macro_bytecode_validate().
+ *
+ * Returns:
+ *     ESP_OK: The macro ran to completion.
+ *     Other: Error returned by the USB HID keyboard module.
+ */
+esp_err_t macro_bytecode_run(const uint8_t *code);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,64 +1,178 @@
 #include "macro_engine.h"
 
 #include <stddef.h>
+#include <string.h>
 
 #include "button_driver.h"
 #include "class/hid/hid.h"
 #include "esp_err.h"
 #include "esp_log.h"
-#include "usb_hid_keyboard.h"
+#include "macro_bytecode.h"
+#include "nvs.h"
+
+#define MACRO_SET_MAGIC "MPAD"
+#define MACRO_SET_MAGIC_LENGTH 4U
+#define MACRO_SET_VERSION 1U
+#define MACRO_SET_HEADER_LENGTH (MACRO_SET_MAGIC_LENGTH + 2U)
+#define MACRO_SET_MAX_SIZE 2048U
+#define MACRO_NVS_NAMESPACE "macro_pad"
+#define MACRO_NVS_KEY "macros"
 
 static const char *TAG = "macro_engine";
 
-static const macro_id_t s_button_macro_map[BUTTON_DRIVER_BUTTON_COUNT] =
+static const uint8_t s_default_copy[] =
+{
+    MACRO_OP_KEY_DOWN, HID_KEY_CONTROL_LEFT,
+    MACRO_OP_KEY_TAP, HID_KEY_C,
+    MACRO_OP_END,
+};
+
+static const uint8_t s_default_paste[] =
+{
+    MACRO_OP_KEY_DOWN, HID_KEY_CONTROL_LEFT,
+    MACRO_OP_KEY_TAP, HID_KEY_V,
+    MACRO_OP_END,
+};
+
+static const uint8_t s_default_save[] =
+{
+    MACRO_OP_KEY_DOWN, HID_KEY_CONTROL_LEFT,
+    MACRO_OP_KEY_TAP, HID_KEY_S,
+    MACRO_OP_END,
+};
+
+static const uint8_t s_default_task_manager[] =
+{
+    MACRO_OP_KEY_DOWN, HID_KEY_CONTROL_LEFT,
+    MACRO_OP_KEY_DOWN, HID_KEY_SHIFT_LEFT,
+    MACRO_OP_KEY_TAP, HID_KEY_ESCAPE,
+    MACRO_OP_END,
+};
+
+static const uint8_t *const s_default_macros[MACRO_ID_COUNT] =
 {
-    MACRO_ID_COPY,
-    MACRO_ID_PASTE,
-    MACRO_ID_SAVE,
-    MACRO_ID_TASK_MANAGER,
+    [MACRO_ID_COPY] = s_default_copy,
+    [MACRO_ID_PASTE] = s_default_paste,
+    [MACRO_ID_SAVE] = s_default_save,
+    [MACRO_ID_TASK_MANAGER] = s_default_task_manager,
 };
 
+static uint8_t s_macro_set[MACRO_SET_MAX_SIZE];
+static const uint8_t *s_button_macros[BUTTON_DRIVER_BUTTON_COUNT];
+
 /**
- * @brief Executes one predefined keyboard macro.
+ * @brief Parses and validates a macro set image.
+ *
+ * Layout: "MPAD", version, macro count, one little-endian u16 length per
+ * macro, then the macros back to back. Macro i is assigned to button i.
  *
  * Args:
- *     macro_id: Logical macro to execute.
+ *     set: Macro set image. It must stay valid while the macros are in use.
+ *     size: Image size in bytes.
  *
  * Returns:
- *     ESP_OK: The macro report sequence was submitted.
- *     ESP_ERR_INVALID_ARG: The macro identifier is not valid.
- *     Other: Error returned by the USB HID keyboard module.
+ *     ESP_OK: Every macro is valid and assigned to its button.
+ *     ESP_ERR_INVALID_ARG: The image or one of its macros is malformed.
  */
-static esp_err_t macro_engine_execute(macro_id_t macro_id)
+static esp_err_t macro_engine_parse_set(const uint8_t *set, size_t size)
 {
-    switch (macro_id)
+    const uint8_t *macros[BUTTON_DRIVER_BUTTON_COUNT] = {NULL};
+
+    if ((size < MACRO_SET_HEADER_LENGTH) ||
+        (memcmp(set, MACRO_SET_MAGIC, MACRO_SET_MAGIC_LENGTH) != 0) ||
+        (set[MACRO_SET_MAGIC_LENGTH] != MACRO_SET_VERSION))
     {
-        case MACRO_ID_COPY:
-            ESP_LOGI(TAG, "Executing Copy: Ctrl+C");
-            return usb_hid_keyboard_send_shortcut(
-                KEYBOARD_MODIFIER_LEFTCTRL,
-                HID_KEY_C);
-
-        case MACRO_ID_PASTE:
-            ESP_LOGI(TAG, "Executing Paste: Ctrl+V");
-            return usb_hid_keyboard_send_shortcut(
-                KEYBOARD_MODIFIER_LEFTCTRL,
-                HID_KEY_V);
-
-        case MACRO_ID_SAVE:
-            ESP_LOGI(TAG, "Executing Save: Ctrl+S");
-            return usb_hid_keyboard_send_shortcut(
-                KEYBOARD_MODIFIER_LEFTCTRL,
-                HID_KEY_S);
-
-        case MACRO_ID_TASK_MANAGER:
-            ESP_LOGI(TAG, "Executing Task Manager: Ctrl+Shift+Esc");
-            return usb_hid_keyboard_send_shortcut(
-                KEYBOARD_MODIFIER_LEFTCTRL | KEYBOARD_MODIFIER_LEFTSHIFT,
-                HID_KEY_ESCAPE);
-
-        default:
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const size_t count = set[MACRO_SET_MAGIC_LENGTH + 1U];
+    size_t offset = MACRO_SET_HEADER_LENGTH + (2U * count);
+
+    if ((count == 0U) || (count > BUTTON_DRIVER_BUTTON_COUNT) || (offset > size))
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        const uint8_t *length_bytes = &set[MACRO_SET_HEADER_LENGTH + (2U * index)];
+        const size_t length = (size_t)length_bytes[0] | ((size_t)length_bytes[1] << 8);
+
+        if (((offset + length) > size) ||
+            (macro_bytecode_validate(&set[offset], length) != ESP_OK))
+        {
+            ESP_LOGW(TAG, "Macro %u is malformed", (unsigned int)index);
             return ESP_ERR_INVALID_ARG;
+        }
+
+        macros[index] = &set[offset];
+        offset += length;
+    }
+
+    if (offset != size)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memcpy(s_button_macros, macros, sizeof(s_button_macros));
+    return ESP_OK;
+}
+
+/**
+ * @brief Loads the macro set stored in NVS.
+ *
+ * Returns:
+ *     ESP_OK: The stored macros replaced the defaults.
+ *     ESP_ERR_NVS_NOT_FOUND: No macro set is stored.
+ *     Other: NVS error, or ESP_ERR_INVALID_ARG for a malformed image.
+ */
+static esp_err_t macro_engine_load_from_nvs(void)
+{
+    nvs_handle_t handle;
+    size_t size = sizeof(s_macro_set);
+
+    esp_err_t result = nvs_open(MACRO_NVS_NAMESPACE, NVS_READONLY, &handle);
+    if (result != ESP_OK)
+    {
+        return result;
+    }
+
+    result = nvs_get_blob(handle, MACRO_NVS_KEY, s_macro_set, &size);
+    nvs_close(handle);
+    if (result != ESP_OK)
+    {
+        return result;
+    }
+
+    return macro_engine_parse_set(s_macro_set, size);
+}
+
+/**
+ * @brief Assigns the built-in macros, then replaces them from NVS if possible.
+ */
+static void macro_engine_load_macros(void)
+{
+    for (size_t index = 0; index < BUTTON_DRIVER_BUTTON_COUNT; ++index)
+    {
+        const macro_id_t macro_id = (macro_id_t)index;
+        s_button_macros[index] = (macro_id < MACRO_ID_COUNT)
+                                     ? s_default_macros[macro_id]
+                                     : NULL;
+    }
+
+    const esp_err_t result = macro_engine_load_from_nvs();
+    if (result == ESP_OK)
+    {
+        ESP_LOGI(TAG, "Loaded macros from NVS");
+    }
+    else if ((result == ESP_ERR_NVS_NOT_FOUND) || (result == ESP_ERR_NVS_NOT_INITIALIZED))
+    {
+        ESP_LOGI(TAG, "No stored macros; using built-in defaults");
+    }
+    else
+    {
+        ESP_LOGW(TAG, "Stored macros rejected (%s); using built-in defaults",
+                 esp_err_to_name(result));
     }
 }
 
@@ -76,6 +190,7 @@ void macro_engine_task(void *context)
     button_event_t event;
 
     configASSERT(event_queue != NULL);
+    macro_engine_load_macros();
     ESP_LOGI(TAG, "Macro engine started");
 
     while (true)
@@ -92,8 +207,17 @@ void macro_engine_task(void *context)
             continue;
         }
 
-        const macro_id_t macro_id = s_button_macro_map[event.button_index];
-        const esp_err_t result = macro_engine_execute(macro_id);
+        const uint8_t *macro = s_button_macros[event.button_index];
+        if (macro == NULL)
+        {
+            ESP_LOGW(TAG, "No macro assigned to button %u",
+                     (unsigned int)event.button_index);
+            continue;
+        }
+
+        ESP_LOGI(TAG, "Running macro for button %u",
+                 (unsigned int)event.button_index);
+        const esp_err_t result = macro_bytecode_run(macro);
 
         if (result != ESP_OK)
         {
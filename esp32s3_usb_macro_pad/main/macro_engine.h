@@ -11,7 +11,9 @@ extern "C" {
 #endif
 
 /**
- * @brief Identifiers for the example macro assignments.
+ * @brief Identifiers for the built-in macros, in button order.
+ *
+ * The built-in macros are used when NVS holds no valid macro set.
  */
 typedef enum
 {
@@ -26,8 +28,11 @@ typedef enum
  * @brief Runs the macro execution service.
  *
  * This function is intended to be used directly as a FreeRTOS task entry
- * point. It receives button events, maps them to macros, and sends the
- * corresponding USB HID keyboard shortcut.
+ * point. At startup it loads the macro set blob from NVS namespace
+ * "macro_pad", key "macros", and falls back to the built-in macros when the
+ * blob is missing or invalid. It then receives button events and runs the
+ * bytecode macro assigned to each button. NVS must be initialized before the
+ * task starts.
  *
  * Args:
  *     context: QueueHandle_t cast to void*. The queue must contain
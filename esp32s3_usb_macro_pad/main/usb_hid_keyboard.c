@@ -1,199 +1,52 @@
 #include "usb_hid_keyboard.h"
 
-#include <stdbool.h>
-#include <stddef.h>
+#include "composite_hid.h"
 
-#include "class/hid/hid_device.h"
-#include "esp_log.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
-#include "tinyusb.h"
-
-#define HID_REPORT_ID_KEYBOARD 1U
 #define HID_READY_TIMEOUT_MS 250U
-#define HID_KEY_HOLD_TIME_MS 12U
-
-#define USB_CONFIG_TOTAL_LENGTH \
-    (TUD_CONFIG_DESC_LEN + (CFG_TUD_HID * TUD_HID_DESC_LEN))
-
-static const char *TAG = "usb_hid_keyboard";
-
-static const uint8_t s_hid_report_descriptor[] =
-{
-    TUD_HID_REPORT_DESC_KEYBOARD(HID_REPORT_ID(HID_REPORT_ID_KEYBOARD))
-};
-
-static const char *s_string_descriptors[] =
-{
-    (const char[]){0x09, 0x04},
-    "Yamil Embedded",
-    "ESP32-S3 USB Macro Pad",
-    "MACROPAD-001",
-    "Macro Pad Keyboard",
-};
-
-static const uint8_t s_configuration_descriptor[] =
-{
-    TUD_CONFIG_DESCRIPTOR(
-        1,
-        1,
-        0,
-        USB_CONFIG_TOTAL_LENGTH,
-        TUSB_DESC_CONFIG_ATT_REMOTE_WAKEUP,
-        100),
-
-    TUD_HID_DESCRIPTOR(
-        0,
-        4,
-        HID_ITF_PROTOCOL_KEYBOARD,
-        sizeof(s_hid_report_descriptor),
-        0x81,
-        16,
-        10),
-};
-
-/**
- * @brief Waits until the HID IN endpoint can accept another report.
- *
- * Args:
- *     timeout_ms: Maximum wait duration in milliseconds.
- *
- * Returns:
- *     ESP_OK: The HID endpoint is ready.
- *     ESP_ERR_INVALID_STATE: The USB device is no longer mounted.
- *     ESP_ERR_TIMEOUT: The endpoint did not become ready before timeout.
- */
-static esp_err_t usb_hid_keyboard_wait_ready(uint32_t timeout_ms)
-{
-    const TickType_t start_tick = xTaskGetTickCount();
-    const TickType_t timeout_ticks = pdMS_TO_TICKS(timeout_ms);
-
-    while (!tud_hid_ready())
-    {
-        if (!tud_mounted())
-        {
-            return ESP_ERR_INVALID_STATE;
-        }
-
-        if ((xTaskGetTickCount() - start_tick) >= timeout_ticks)
-        {
-            return ESP_ERR_TIMEOUT;
-        }
-
-        vTaskDelay(pdMS_TO_TICKS(1));
-    }
-
-    return ESP_OK;
-}
-
-uint8_t const *tud_hid_descriptor_report_cb(uint8_t instance)
-{
-    (void)instance;
-    return s_hid_report_descriptor;
-}
-
-uint16_t tud_hid_get_report_cb(
-    uint8_t instance,
-    uint8_t report_id,
-    hid_report_type_t report_type,
-    uint8_t *buffer,
-    uint16_t requested_length)
-{
-    (void)instance;
-    (void)report_id;
-    (void)report_type;
-    (void)buffer;
-    (void)requested_length;
-
-    // Returning zero stalls unsupported GET_REPORT requests as TinyUSB expects.
-    return 0;
-}
 
-void tud_hid_set_report_cb(
-    uint8_t instance,
-    uint8_t report_id,
-    hid_report_type_t report_type,
-    uint8_t const *buffer,
-    uint16_t buffer_size)
+esp_err_t usb_hid_keyboard_init(void)
 {
-    (void)instance;
-    (void)report_id;
-    (void)report_type;
-    (void)buffer;
-    (void)buffer_size;
-}
+    static const composite_hid_config_t config = {
+        .manufacturer = "Yamil Embedded",
+        .product = "ESP32-S3 USB Macro Pad",
+        .serial_number = "MACROPAD-001",
+        .interface_name = "Macro Pad Keyboard",
+    };
 
-void tud_mount_cb(void)
-{
-    ESP_LOGI(TAG, "USB host mounted the macro pad");
+    return composite_hid_init(&config);
 }
 
-void tud_umount_cb(void)
+esp_err_t usb_hid_keyboard_send_keys(uint8_t modifier, const uint8_t keycodes[6])
 {
-    ESP_LOGI(TAG, "USB host unmounted the macro pad");
+    return composite_hid_send_keyboard(modifier, keycodes, HID_READY_TIMEOUT_MS);
 }
 
-void tud_suspend_cb(bool remote_wakeup_enabled)
+esp_err_t usb_hid_keyboard_send_consumer(uint16_t usage)
 {
-    ESP_LOGI(TAG, "USB bus suspended; remote wakeup=%s",
-             remote_wakeup_enabled ? "enabled" : "disabled");
+    return composite_hid_send_consumer(usage, HID_READY_TIMEOUT_MS);
 }
 
-void tud_resume_cb(void)
+esp_err_t usb_hid_keyboard_send_mouse(
+    uint8_t buttons,
+    int8_t delta_x,
+    int8_t delta_y,
+    int8_t wheel)
 {
-    ESP_LOGI(TAG, "USB bus resumed");
-}
-
-esp_err_t usb_hid_keyboard_init(void)
-{
-    tinyusb_config_t config = {
-        .device_descriptor = NULL,
-        .string_descriptor = s_string_descriptors,
-        .string_descriptor_count =
-            sizeof(s_string_descriptors) / sizeof(s_string_descriptors[0]),
-#if TUD_OPT_HIGH_SPEED
-        .fs_configuration_descriptor = s_configuration_descriptor,
-        .hs_configuration_descriptor = s_configuration_descriptor,
-#else
-        .configuration_descriptor = s_configuration_descriptor,
-#endif
-        .external_phy = false,
-        .self_powered = false,
-        .vbus_monitor_io = -1,
-    };
-
-    ESP_LOGI(TAG, "Installing TinyUSB HID keyboard driver");
-    return tinyusb_driver_install(&config);
+    return composite_hid_send_mouse(buttons, delta_x, delta_y, wheel, 0, HID_READY_TIMEOUT_MS);
 }
 
 esp_err_t usb_hid_keyboard_send_shortcut(uint8_t modifier, uint8_t keycode)
 {
     uint8_t keycodes[6] = {0};
-    esp_err_t result;
-
-    if (!tud_mounted())
-    {
-        return ESP_ERR_INVALID_STATE;
-    }
-
-    result = usb_hid_keyboard_wait_ready(HID_READY_TIMEOUT_MS);
-    if (result != ESP_OK)
-    {
-        return result;
-    }
 
     keycodes[0] = keycode;
-    tud_hid_keyboard_report(HID_REPORT_ID_KEYBOARD, modifier, keycodes);
-
-    // Give the host enough time to observe the pressed state.
-    vTaskDelay(pdMS_TO_TICKS(HID_KEY_HOLD_TIME_MS));
-
-    result = usb_hid_keyboard_wait_ready(HID_READY_TIMEOUT_MS);
+    esp_err_t result = usb_hid_keyboard_send_keys(modifier, keycodes);
     if (result != ESP_OK)
     {
         return result;
     }
 
-    tud_hid_keyboard_report(HID_REPORT_ID_KEYBOARD, 0, NULL);
-    return ESP_OK;
+    // The release waits until the press report has been handed to USB.
+    keycodes[0] = 0;
+    return usb_hid_keyboard_send_keys(0, keycodes);
 }
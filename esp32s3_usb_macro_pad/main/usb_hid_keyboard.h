@@ -12,12 +12,65 @@ extern "C" {
 /**
  * @brief Initializes TinyUSB as a USB HID keyboard device.
  *
+ * The device is the composite_hid component: one HID interface carrying a
+ * six-key keyboard, a consumer control usage, and a relative mouse report.
+ * The host polls it every millisecond.
+ *
  * Returns:
  *     ESP_OK: The TinyUSB driver was installed successfully.
  *     Other: An ESP-IDF or TinyUSB driver error code.
  */
 esp_err_t usb_hid_keyboard_init(void);
 
+/**
+ * @brief Sends one keyboard report.
+ *
+ * The call waits until the previous keyboard report has been handed to USB,
+ * then queues this one and returns without waiting for it to be read.
+ * Successive calls therefore send one report per USB frame. Reports of all
+ * three types share the frames in the order they were queued.
+ *
+ * Args:
+ *     modifier: HID keyboard modifier bitmap.
+ *     keycodes: Six HID usage IDs of the pressed keys; unused entries are 0.
+ *
+ * Returns:
+ *     ESP_OK: The report was queued.
+ *     ESP_ERR_INVALID_STATE: The USB device is not mounted.
+ *     ESP_ERR_TIMEOUT: The previous report was not sent in time.
+ */
+esp_err_t usb_hid_keyboard_send_keys(uint8_t modifier, const uint8_t keycodes[6]);
+
+/**
+ * @brief Sends one consumer control report.
+ *
+ * Args:
+ *     usage: Consumer page usage ID, such as 0x00E9 for Volume Up, or 0 to
+ *         release the control.
+ *
+ * Returns:
+ *     The same codes as usb_hid_keyboard_send_keys().
+ */
+esp_err_t usb_hid_keyboard_send_consumer(uint16_t usage);
+
+/**
+ * @brief Sends one relative mouse report.
+ *
+ * Args:
+ *     buttons: Mouse button bitmap; bit 0 is the left button.
+ *     delta_x: Horizontal movement in counts.
+ *     delta_y: Vertical movement in counts.
+ *     wheel: Vertical wheel movement in detents.
+ *
+ * Returns:
+ *     The same codes as usb_hid_keyboard_send_keys().
+ */
+esp_err_t usb_hid_keyboard_send_mouse(
+    uint8_t buttons,
+    int8_t delta_x,
+    int8_t delta_y,
+    int8_t wheel);
+
 /**
  * @brief Sends a keyboard shortcut followed by an all-keys-released report.
  *
@@ -28,7 +81,7 @@ esp_err_t usb_hid_keyboard_init(void);
  * Returns:
  *     ESP_OK: Both press and release reports were submitted.
  *     ESP_ERR_INVALID_STATE: The USB device is not mounted.
- *     ESP_ERR_TIMEOUT: The HID endpoint did not become ready in time.
+ *     ESP_ERR_TIMEOUT: The previous report was not sent in time.
  */
 esp_err_t usb_hid_keyboard_send_shortcut(uint8_t modifier, uint8_t keycode);
 
@@ -1,5 +1,7 @@
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
+#include <sys/param.h>
 
 #include "class/hid/hid_device.h"
 #include "driver/gpio.h"
@@ -7,6 +9,8 @@
 #include "esp_err.h"
 #include "esp_log.h"
 #include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
 #include "tinyusb.h"
 #include "tinyusb_default_config.h"
@@ -18,6 +22,9 @@ static const char *TAG = "usb_mouse";
 
 static bool s_usb_suspended = false;
 static bool s_remote_wakeup_enabled = false;
+static QueueHandle_t s_motion_queue;
+static SemaphoreHandle_t s_motion_idle;
+static TaskHandle_t s_planner_task;
 
 typedef enum {
     MOUSE_DIRECTION_RIGHT = 0,
@@ -27,6 +34,18 @@ typedef enum {
     MOUSE_DIRECTION_COUNT,
 } mouse_direction_t;
 
+/*
+ * One straight motion segment. The planner spreads the distances evenly over
+ * the duration, sending one report per USB frame.
+ */
+typedef struct {
+    int32_t x;
+    int32_t y;
+    int32_t wheel;
+    uint8_t buttons;
+    uint32_t duration_ms;
+} mouse_motion_t;
+
 /**
  * Initializes the BOOT button as an active-low GPIO input.
  *
@@ -105,6 +124,40 @@ static bool mouse_report_is_ready(void)
     return tud_mounted() && !s_usb_suspended && tud_hid_ready();
 }
 
+/**
+ * Waits until the HID interface can accept the next report.
+ *
+ * The wait ends as soon as TinyUSB reports that the previous report was read
+ * by the host, so reports follow each other at the host polling rate.
+ *
+ * Args:
+ *     None.
+ *
+ * Returns:
+ *     True when a report can be sent. False when the device is unmounted or
+ *     suspended, or when the host did not read the previous report in time.
+ */
+static bool mouse_wait_report_ready(void)
+{
+    const TickType_t start = xTaskGetTickCount();
+    const TickType_t timeout = pdMS_TO_TICKS(USB_MOUSE_REPORT_TIMEOUT_MS);
+
+    while (!mouse_report_is_ready()) {
+        if (!tud_mounted() || s_usb_suspended) {
+            return false;
+        }
+
+        const TickType_t elapsed = xTaskGetTickCount() - start;
+        if (elapsed >= timeout) {
+            return false;
+        }
+
+        ulTaskNotifyTake(pdTRUE, timeout - elapsed);
+    }
+
+    return true;
+}
+
 /**
  * Sends one HID mouse report to the host.
  *
@@ -113,133 +166,205 @@ static bool mouse_report_is_ready(void)
  *         middle.
  *     x_delta: Relative movement on the X axis.
  *     y_delta: Relative movement on the Y axis.
- *     wheel_delta: Relative movement of the vertical scroll wheel.
+ *     wheel_delta: Relative movement of the vertical scroll wheel, in the
+ *         units currently selected by the host.
  *
  * Returns:
  *     True when the report was queued. Otherwise, false.
  */
-static bool mouse_send_report(uint8_t buttons, int8_t x_delta, int8_t y_delta, int8_t wheel_delta)
+static bool mouse_send_report(uint8_t buttons, int16_t x_delta, int16_t y_delta, int16_t wheel_delta)
 {
-    if (!mouse_report_is_ready()) {
+    if (!mouse_wait_report_ready()) {
         return false;
     }
 
-    tud_hid_mouse_report(
-        USB_HID_REPORT_ID_MOUSE,
-        buttons,
-        x_delta,
-        y_delta,
-        wheel_delta,
-        0
-    );
+    const usb_hid_mouse_report_t report = {
+        .buttons = buttons,
+        .x = x_delta,
+        .y = y_delta,
+        .wheel = wheel_delta,
+        .pan = 0,
+    };
 
-    return true;
+    return tud_hid_report(USB_HID_REPORT_ID_MOUSE, &report, sizeof(report));
 }
 
 /**
- * Moves the mouse by one relative step.
+ * Returns the interpolated position of one axis after a given report.
  *
  * Args:
- *     x_delta: Relative movement on the X axis.
- *     y_delta: Relative movement on the Y axis.
+ *     total: Distance of the whole segment.
+ *     step: Number of reports already sent, from 0 to steps.
+ *     steps: Number of reports in the segment.
  *
  * Returns:
- *     True when the movement report was queued. Otherwise, false.
+ *     Distance covered after the given report. The value for the last report
+ *     equals total, so rounding never adds up to a drift.
  */
-static bool mouse_move(int8_t x_delta, int8_t y_delta)
+static int32_t mouse_interpolate(int32_t total, uint32_t step, uint32_t steps)
 {
-    return mouse_send_report(0, x_delta, y_delta, 0);
+    return (int32_t)(((int64_t)total * step) / steps);
 }
 
 /**
- * Releases all mouse buttons and stops all mouse movement.
+ * Streams one motion segment as a sequence of reports, one per USB frame.
  *
  * Args:
- *     None.
+ *     motion: Segment to play.
+ *     wheel_remainder: Wheel counts not yet sent because the host uses whole
+ *         detents. Carried from one segment to the next.
  *
  * Returns:
- *     True when the neutral report was queued. Otherwise, false.
+ *     True when every report of the segment was sent. Otherwise, false.
  */
-static bool mouse_release_all(void)
+static bool mouse_play_motion(const mouse_motion_t *motion, int32_t *wheel_remainder)
 {
-    return mouse_send_report(0, 0, 0, 0);
+    const bool moves = (motion->x != 0) || (motion->y != 0) || (motion->wheel != 0);
+
+    if (!moves) {
+        // A button change needs one report; the rest of the segment is a hold.
+        if (!mouse_send_report(motion->buttons, 0, 0, 0)) {
+            return false;
+        }
+
+        vTaskDelay(pdMS_TO_TICKS(motion->duration_ms));
+        return true;
+    }
+
+    // One report per millisecond, but never more than a 16-bit delta each.
+    uint32_t steps = (motion->duration_ms > 0) ? motion->duration_ms : 1;
+    const uint32_t largest = MAX(abs(motion->x), MAX(abs(motion->y), abs(motion->wheel)));
+    steps = MAX(steps, (largest + INT16_MAX - 1) / INT16_MAX);
+
+    const int32_t wheel_divisor = USB_HID_WHEEL_COUNTS_PER_DETENT / usb_hid_wheel_counts_per_detent();
+
+    for (uint32_t step = 1; step <= steps; step++) {
+        const int32_t x_delta = mouse_interpolate(motion->x, step, steps) -
+                                mouse_interpolate(motion->x, step - 1, steps);
+        const int32_t y_delta = mouse_interpolate(motion->y, step, steps) -
+                                mouse_interpolate(motion->y, step - 1, steps);
+
+        *wheel_remainder += mouse_interpolate(motion->wheel, step, steps) -
+                            mouse_interpolate(motion->wheel, step - 1, steps);
+        const int32_t wheel_delta = *wheel_remainder / wheel_divisor;
+        *wheel_remainder -= wheel_delta * wheel_divisor;
+
+        if (!mouse_send_report(motion->buttons, (int16_t)x_delta, (int16_t)y_delta, (int16_t)wheel_delta)) {
+            return false;
+        }
+    }
+
+    return true;
 }
 
 /**
- * Sends a left-click sequence to the USB host.
+ * Plays queued motion segments back to back at the USB polling rate.
  *
  * Args:
- *     None.
+ *     arg: Unused.
  *
  * Returns:
- *     True when both the press and release reports were queued. Otherwise,
- *     false.
+ *     None.
  */
-static bool mouse_left_click(void)
+static void mouse_planner_task(void *arg)
 {
-    if (!mouse_send_report(USB_MOUSE_LEFT_BUTTON, 0, 0, 0)) {
-        return false;
-    }
+    (void)arg;
+
+    mouse_motion_t motion;
+    int32_t wheel_remainder = 0;
 
-    vTaskDelay(pdMS_TO_TICKS(USB_MOUSE_CLICK_HOLD_MS));
+    while (true) {
+        if (xQueueReceive(s_motion_queue, &motion, portMAX_DELAY) != pdPASS) {
+            continue;
+        }
 
-    return mouse_release_all();
+        if (!mouse_play_motion(&motion, &wheel_remainder)) {
+            // A trajectory cut short is not resumed later; drop what is left.
+            ESP_LOGW(TAG, "Mouse report not accepted; motion queue flushed");
+            xQueueReset(s_motion_queue);
+            wheel_remainder = 0;
+        }
+
+        if (uxQueueMessagesWaiting(s_motion_queue) == 0) {
+            xSemaphoreGive(s_motion_idle);
+        }
+    }
 }
 
 /**
- * Sends several relative movement reports in the same direction.
+ * Queues one motion segment for the planner task.
  *
  * Args:
- *     x_delta: Relative movement on the X axis for each report.
- *     y_delta: Relative movement on the Y axis for each report.
- *     steps: Number of movement reports to send.
+ *     x: Distance to move on the X axis, in counts.
+ *     y: Distance to move on the Y axis, in counts.
+ *     wheel: Distance to scroll, in 1/USB_HID_WHEEL_COUNTS_PER_DETENT of a
+ *         detent.
+ *     buttons: Button bitmap held during the segment.
+ *     duration_ms: Time over which the distances are spread.
  *
  * Returns:
- *     None.
+ *     True when the segment was queued. Otherwise, false.
  */
-static void mouse_move_steps(int8_t x_delta, int8_t y_delta, uint16_t steps)
+static bool mouse_motion_enqueue(int32_t x, int32_t y, int32_t wheel, uint8_t buttons, uint32_t duration_ms)
 {
-    for (uint16_t i = 0; i < steps; i++) {
-        mouse_move(x_delta, y_delta);
-        vTaskDelay(pdMS_TO_TICKS(USB_MOUSE_REPORT_DELAY_MS));
-    }
+    const mouse_motion_t motion = {
+        .x = x,
+        .y = y,
+        .wheel = wheel,
+        .buttons = buttons,
+        .duration_ms = duration_ms,
+    };
+
+    return xQueueSend(s_motion_queue, &motion, pdMS_TO_TICKS(USB_MOUSE_REPORT_TIMEOUT_MS)) == pdPASS;
 }
 
 /**
- * Draws a square-like cursor trajectory on the host computer.
+ * Queues a left-click sequence.
  *
  * Args:
  *     None.
  *
  * Returns:
+ *     True when both the press and release segments were queued. Otherwise,
+ *     false.
+ */
+static bool mouse_left_click(void)
+{
+    return mouse_motion_enqueue(0, 0, 0, USB_MOUSE_LEFT_BUTTON, USB_MOUSE_CLICK_HOLD_MS) &&
+           mouse_motion_enqueue(0, 0, 0, 0, 0);
+}
+
+/**
+ * Queues a square cursor trajectory. Each side is one straight segment.
+ *
+ * Args:
  *     None.
+ *
+ * Returns:
+ *     True when all four sides were queued. Otherwise, false.
  */
-static void mouse_draw_square(void)
+static bool mouse_draw_square(void)
 {
+    static const int8_t directions[MOUSE_DIRECTION_COUNT][2] = {
+        [MOUSE_DIRECTION_RIGHT] = {1, 0},
+        [MOUSE_DIRECTION_DOWN] = {0, 1},
+        [MOUSE_DIRECTION_LEFT] = {-1, 0},
+        [MOUSE_DIRECTION_UP] = {0, -1},
+    };
+
     for (mouse_direction_t direction = MOUSE_DIRECTION_RIGHT;
          direction < MOUSE_DIRECTION_COUNT;
          direction++) {
-        switch (direction) {
-        case MOUSE_DIRECTION_RIGHT:
-            mouse_move_steps(USB_MOUSE_MOVE_DELTA, 0, USB_MOUSE_SQUARE_SIDE_STEPS);
-            break;
-
-        case MOUSE_DIRECTION_DOWN:
-            mouse_move_steps(0, USB_MOUSE_MOVE_DELTA, USB_MOUSE_SQUARE_SIDE_STEPS);
-            break;
-
-        case MOUSE_DIRECTION_LEFT:
-            mouse_move_steps(-USB_MOUSE_MOVE_DELTA, 0, USB_MOUSE_SQUARE_SIDE_STEPS);
-            break;
-
-        case MOUSE_DIRECTION_UP:
-            mouse_move_steps(0, -USB_MOUSE_MOVE_DELTA, USB_MOUSE_SQUARE_SIDE_STEPS);
-            break;
-
-        default:
-            break;
+        if (!mouse_motion_enqueue(directions[direction][0] * USB_MOUSE_SQUARE_SIDE_COUNTS,
+                                  directions[direction][1] * USB_MOUSE_SQUARE_SIDE_COUNTS,
+                                  0,
+                                  0,
+                                  USB_MOUSE_SQUARE_SIDE_MS)) {
+            return false;
         }
     }
+
+    return true;
 }
 
 /**
@@ -255,12 +380,41 @@ static void mouse_run_demo(void)
 {
     ESP_LOGI(TAG, "Running USB mouse demo");
 
-    mouse_draw_square();
-    vTaskDelay(pdMS_TO_TICKS(USB_MOUSE_REPORT_DELAY_MS));
-    mouse_left_click();
+    // Clear a completion left over from an earlier run.
+    xSemaphoreTake(s_motion_idle, 0);
+
+    if (!mouse_draw_square() ||
+        !mouse_motion_enqueue(0, 0, 0, 0, USB_MOUSE_PAUSE_MS) ||
+        !mouse_left_click()) {
+        ESP_LOGW(TAG, "Motion queue full");
+    }
+
+    xSemaphoreTake(s_motion_idle, pdMS_TO_TICKS(USB_MOUSE_DEMO_TIMEOUT_MS));
     vTaskDelay(pdMS_TO_TICKS(USB_MOUSE_DEMO_REPEAT_DELAY_MS));
 }
 
+/**
+ * TinyUSB callback invoked when the host has read an input report.
+ *
+ * Args:
+ *     instance: HID interface instance.
+ *     report: Report that was sent.
+ *     len: Report length in bytes.
+ *
+ * Returns:
+ *     None.
+ */
+void tud_hid_report_complete_cb(uint8_t instance, uint8_t const *report, uint16_t len)
+{
+    (void)instance;
+    (void)report;
+    (void)len;
+
+    if (s_planner_task != NULL) {
+        xTaskNotifyGive(s_planner_task);
+    }
+}
+
 /**
  * TinyUSB callback invoked when the USB bus is suspended by the host.
  *
@@ -315,6 +469,20 @@ void app_main(void)
     // even if USB initialization takes a while
     ESP_ERROR_CHECK(usb_mouse_init());
 
+    // The planner streams queued trajectories, one report per host poll.
+    s_motion_queue = xQueueCreate(USB_MOUSE_MOTION_QUEUE_LENGTH, sizeof(mouse_motion_t));
+    s_motion_idle = xSemaphoreCreateBinary();
+    configASSERT((s_motion_queue != NULL) && (s_motion_idle != NULL));
+
+    BaseType_t task_created = xTaskCreate(
+        mouse_planner_task,
+        "mouse_planner",
+        USB_MOUSE_PLANNER_STACK_SIZE,
+        NULL,
+        USB_MOUSE_PLANNER_PRIORITY,
+        &s_planner_task);
+    configASSERT(task_created == pdPASS);
+
     ESP_LOGI(TAG, "TinyUSB initialized");
     ESP_LOGI(TAG, "Waiting %d ms before sending reports", USB_MOUSE_STARTUP_DELAY_MS);
     vTaskDelay(pdMS_TO_TICKS(USB_MOUSE_STARTUP_DELAY_MS));
@@ -1,16 +1,84 @@
 #include "usb_descriptors.h"
 
+#include <stdbool.h>
+
 #include "tinyusb.h"
 
 #define USB_HID_TOTAL_DESCRIPTOR_LEN (TUD_CONFIG_DESC_LEN + TUD_HID_DESC_LEN)
 #define USB_HID_INTERFACE_NUMBER     0
 #define USB_HID_ENDPOINT_IN          0x81
 #define USB_HID_ENDPOINT_SIZE        16
-#define USB_HID_POLL_INTERVAL_MS     10
+#define USB_HID_POLL_INTERVAL_MS     1
 #define USB_HID_MAX_POWER_MA         100
 
+#define USB_HID_AXIS_MIN             (-32767)
+#define USB_HID_AXIS_MAX             32767
+#define USB_HID_USAGE_RESOLUTION_MULTIPLIER 0x48
+
+static bool s_wheel_high_resolution = false;
+
+/*
+ * Five buttons followed by 16-bit X, Y, wheel, and horizontal pan. The wheel
+ * sits in a logical collection with a Resolution Multiplier feature. A host
+ * that supports high-resolution scrolling sets the multiplier to 1, and each
+ * wheel count then means 1/120 of a detent.
+ */
 const uint8_t usb_hid_report_descriptor[] = {
-    TUD_HID_REPORT_DESC_MOUSE(HID_REPORT_ID(USB_HID_REPORT_ID_MOUSE))
+    HID_USAGE_PAGE(HID_USAGE_PAGE_DESKTOP),
+    HID_USAGE(HID_USAGE_DESKTOP_MOUSE),
+    HID_COLLECTION(HID_COLLECTION_APPLICATION),
+        HID_REPORT_ID(USB_HID_REPORT_ID_MOUSE)
+        HID_USAGE(HID_USAGE_DESKTOP_POINTER),
+        HID_COLLECTION(HID_COLLECTION_PHYSICAL),
+            HID_USAGE_PAGE(HID_USAGE_PAGE_BUTTON),
+            HID_USAGE_MIN(1),
+            HID_USAGE_MAX(5),
+            HID_LOGICAL_MIN(0),
+            HID_LOGICAL_MAX(1),
+            HID_REPORT_COUNT(5),
+            HID_REPORT_SIZE(1),
+            HID_INPUT(HID_DATA | HID_VARIABLE | HID_ABSOLUTE),
+            HID_REPORT_COUNT(1),
+            HID_REPORT_SIZE(3),
+            HID_INPUT(HID_CONSTANT),
+
+            HID_USAGE_PAGE(HID_USAGE_PAGE_DESKTOP),
+            HID_USAGE(HID_USAGE_DESKTOP_X),
+            HID_USAGE(HID_USAGE_DESKTOP_Y),
+            HID_LOGICAL_MIN_N(USB_HID_AXIS_MIN, 2),
+            HID_LOGICAL_MAX_N(USB_HID_AXIS_MAX, 2),
+            HID_REPORT_COUNT(2),
+            HID_REPORT_SIZE(16),
+            HID_INPUT(HID_DATA | HID_VARIABLE | HID_RELATIVE),
+
+            HID_COLLECTION(HID_COLLECTION_LOGICAL),
+                HID_REPORT_ID(USB_HID_REPORT_ID_WHEEL_MULTIPLIER)
+                HID_USAGE(USB_HID_USAGE_RESOLUTION_MULTIPLIER),
+                HID_LOGICAL_MIN(0),
+                HID_LOGICAL_MAX(1),
+                HID_PHYSICAL_MIN(1),
+                HID_PHYSICAL_MAX(USB_HID_WHEEL_COUNTS_PER_DETENT),
+                HID_REPORT_COUNT(1),
+                HID_REPORT_SIZE(2),
+                HID_FEATURE(HID_DATA | HID_VARIABLE | HID_ABSOLUTE),
+                HID_REPORT_SIZE(6),
+                HID_FEATURE(HID_CONSTANT),
+
+                HID_REPORT_ID(USB_HID_REPORT_ID_MOUSE)
+                HID_USAGE(HID_USAGE_DESKTOP_WHEEL),
+                HID_PHYSICAL_MIN(0),
+                HID_PHYSICAL_MAX(0),
+                HID_LOGICAL_MIN_N(USB_HID_AXIS_MIN, 2),
+                HID_LOGICAL_MAX_N(USB_HID_AXIS_MAX, 2),
+                HID_REPORT_SIZE(16),
+                HID_INPUT(HID_DATA | HID_VARIABLE | HID_RELATIVE),
+            HID_COLLECTION_END,
+
+            HID_USAGE_PAGE(HID_USAGE_PAGE_CONSUMER),
+            HID_USAGE_N(HID_USAGE_CONSUMER_AC_PAN, 2),
+            HID_INPUT(HID_DATA | HID_VARIABLE | HID_RELATIVE),
+        HID_COLLECTION_END,
+    HID_COLLECTION_END,
 };
 
 const uint8_t usb_hid_configuration_descriptor[] = {
@@ -45,6 +113,21 @@ const char *usb_hid_string_descriptor[] = {
 const uint8_t usb_hid_string_descriptor_count =
     sizeof(usb_hid_string_descriptor) / sizeof(usb_hid_string_descriptor[0]);
 
+/**
+ * Returns how many wheel counts make one detent on the host.
+ *
+ * Args:
+ *     None.
+ *
+ * Returns:
+ *     USB_HID_WHEEL_COUNTS_PER_DETENT after the host has enabled the
+ *     resolution multiplier. Otherwise, 1.
+ */
+uint16_t usb_hid_wheel_counts_per_detent(void)
+{
+    return s_wheel_high_resolution ? USB_HID_WHEEL_COUNTS_PER_DETENT : 1;
+}
+
 /**
  * Returns the HID report descriptor used by the USB mouse interface.
  *
@@ -72,8 +155,9 @@ uint8_t const *tud_hid_descriptor_report_cb(uint8_t instance)
  *     reqlen: Requested report length in bytes.
  *
  * Returns:
- *     Zero because this demo does not provide feature or output reports through
- *     the control endpoint.
+ *     One byte for the resolution multiplier feature report. Zero for every
+ *     other report, which this demo does not provide through the control
+ *     endpoint.
  */
 uint16_t tud_hid_get_report_cb(
     uint8_t instance,
@@ -83,12 +167,15 @@ uint16_t tud_hid_get_report_cb(
     uint16_t reqlen)
 {
     (void)instance;
-    (void)report_id;
-    (void)report_type;
-    (void)buffer;
-    (void)reqlen;
 
-    return 0;
+    if ((report_type != HID_REPORT_TYPE_FEATURE) ||
+        (report_id != USB_HID_REPORT_ID_WHEEL_MULTIPLIER) ||
+        (reqlen < 1)) {
+        return 0;
+    }
+
+    buffer[0] = s_wheel_high_resolution ? 1 : 0;
+    return 1;
 }
 
 /**
@@ -100,6 +187,9 @@ uint16_t tud_hid_get_report_cb(
  *     report_type: HID report type sent by the host.
  *     buffer: Received report payload.
  *     bufsize: Number of bytes in the received report payload.
+ *
+ * Only the resolution multiplier feature report is used. The multiplier is
+ * the last byte whether or not TinyUSB has already removed the report ID.
  */
 void tud_hid_set_report_cb(
     uint8_t instance,
@@ -109,8 +199,12 @@ void tud_hid_set_report_cb(
     uint16_t bufsize)
 {
     (void)instance;
-    (void)report_id;
-    (void)report_type;
-    (void)buffer;
-    (void)bufsize;
+
+    if ((report_type != HID_REPORT_TYPE_FEATURE) ||
+        (report_id != USB_HID_REPORT_ID_WHEEL_MULTIPLIER) ||
+        (bufsize < 1)) {
+        return;
+    }
+
+    s_wheel_high_resolution = (buffer[bufsize - 1] & 0x03) != 0;
 }
@@ -10,13 +10,28 @@ extern "C" {
 
 enum {
     USB_HID_REPORT_ID_MOUSE = 1,
+    USB_HID_REPORT_ID_WHEEL_MULTIPLIER = 2,
 };
 
+/* Wheel counts per detent while the host has the resolution multiplier on. */
+#define USB_HID_WHEEL_COUNTS_PER_DETENT 120
+
+/* Input report USB_HID_REPORT_ID_MOUSE, without the report ID byte. */
+typedef struct TU_ATTR_PACKED {
+    uint8_t buttons;
+    int16_t x;
+    int16_t y;
+    int16_t wheel;
+    int16_t pan;
+} usb_hid_mouse_report_t;
+
 extern const uint8_t usb_hid_report_descriptor[];
 extern const uint8_t usb_hid_configuration_descriptor[];
 extern const char *usb_hid_string_descriptor[];
 extern const uint8_t usb_hid_string_descriptor_count;
 
+uint16_t usb_hid_wheel_counts_per_detent(void);
+
 #ifdef __cplusplus
 }
 #endif
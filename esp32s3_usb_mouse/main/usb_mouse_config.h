@@ -4,13 +4,19 @@
 #include "driver/gpio.h"
 
 #define USB_MOUSE_BOOT_BUTTON_GPIO      GPIO_NUM_0
-#define USB_MOUSE_MOVE_DELTA            5
-#define USB_MOUSE_SQUARE_SIDE_STEPS     25
-#define USB_MOUSE_REPORT_DELAY_MS       20
+#define USB_MOUSE_SQUARE_SIDE_COUNTS    125
+#define USB_MOUSE_SQUARE_SIDE_MS        500
+#define USB_MOUSE_PAUSE_MS              20
 #define USB_MOUSE_CLICK_HOLD_MS         60
 #define USB_MOUSE_STARTUP_DELAY_MS      3000
 #define USB_MOUSE_IDLE_DELAY_MS         100
 #define USB_MOUSE_DEMO_REPEAT_DELAY_MS  1500
+#define USB_MOUSE_DEMO_TIMEOUT_MS       5000
+
+#define USB_MOUSE_MOTION_QUEUE_LENGTH   16
+#define USB_MOUSE_PLANNER_STACK_SIZE    3072
+#define USB_MOUSE_PLANNER_PRIORITY      5
+#define USB_MOUSE_REPORT_TIMEOUT_MS     50
 
 #define USB_MOUSE_LEFT_BUTTON           0x01
 #define USB_MOUSE_RIGHT_BUTTON          0x02
@@ -0,0 +1,536 @@
+/**
+ * @file msc_cache.c
+ * @brief RAM write-back cache and throughput counters for the MSC volume.
+ *
+ * Cached data is only ever data the host or the FAT driver wrote, so every
+ * valid sector in a line is dirty. Reads are served from flash and patched
+ * with the cached sectors; they never allocate lines.
+ */
+
+#include "msc_cache.h"
+
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/param.h>
+
+#include "esp_check.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_memory_utils.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "freertos/task.h"
+#include "tusb.h"
+
+#define CACHE_LINE_SIZE 4096U
+#define CACHE_SECTOR_SIZE CONFIG_WL_SECTOR_SIZE
+#define CACHE_SECTORS_PER_LINE (CACHE_LINE_SIZE / CACHE_SECTOR_SIZE)
+#define CACHE_UNUSED_LINE UINT32_MAX
+#define CACHE_INTERNAL_MAX_LINES 8U
+#define CACHE_FLUSH_TASK_STACK 3072
+#define CACHE_FLUSH_TASK_PRIORITY 2
+
+#define SCSI_CMD_SYNCHRONIZE_CACHE_10 0x35
+#define SCSI_CMD_SYNCHRONIZE_CACHE_16 0x91
+
+/** @brief One erase block of cached sectors. */
+typedef struct {
+    uint32_t base;     /**< Line address, or CACHE_UNUSED_LINE. */
+    uint32_t present;  /**< Bitmap of sectors held in data. */
+    uint32_t last_use; /**< Access stamp for least-recently-used eviction. */
+    uint8_t *data;
+} cache_line_t;
+
+typedef struct {
+    uint64_t bytes;
+    int64_t first_us;
+    int64_t last_us;
+} transfer_window_t;
+
+esp_err_t __real_wl_read(wl_handle_t handle, size_t src_addr, void *dest, size_t size);
+esp_err_t __real_wl_write(wl_handle_t handle, size_t dest_addr, const void *src, size_t size);
+esp_err_t __real_wl_erase_range(wl_handle_t handle, size_t start_addr, size_t size);
+int32_t __real_tud_msc_scsi_cb(uint8_t lun, uint8_t const scsi_cmd[16], void *buffer, uint16_t bufsize);
+int32_t __real_tud_msc_read10_cb(uint8_t lun, uint32_t lba, uint32_t offset, void *buffer, uint32_t bufsize);
+int32_t __real_tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *buffer, uint32_t bufsize);
+
+static const char *TAG = "msc_cache";
+
+static wl_handle_t s_wl_handle = WL_INVALID_HANDLE;
+static cache_line_t *s_lines;
+static size_t s_line_count;
+static uint32_t s_use_counter;
+static SemaphoreHandle_t s_lock;
+static esp_timer_handle_t s_idle_timer;
+static TaskHandle_t s_flush_task;
+static msc_cache_stats_t s_stats;
+
+static transfer_window_t s_read_window;
+static transfer_window_t s_write_window;
+static portMUX_TYPE s_window_lock = portMUX_INITIALIZER_UNLOCKED;
+
+/**
+ * @brief Checks whether an access targets the cached volume.
+ */
+static bool cache_is_active(wl_handle_t handle)
+{
+    return (s_lines != NULL) && (handle == s_wl_handle);
+}
+
+/**
+ * @brief Checks whether an address range is made of whole sectors.
+ */
+static bool cache_is_sector_aligned(size_t addr, size_t size)
+{
+    return ((addr % CACHE_SECTOR_SIZE) == 0) && ((size % CACHE_SECTOR_SIZE) == 0);
+}
+
+/**
+ * @brief Finds the cached line of an erase block.
+ *
+ * @param base Line address.
+ * @return The line, or NULL when the block is not cached.
+ */
+static cache_line_t *cache_find_line(uint32_t base)
+{
+    for (size_t index = 0; index < s_line_count; ++index) {
+        if (s_lines[index].base == base) {
+            return &s_lines[index];
+        }
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Writes one line back with a single erase of its block.
+ *
+ * Sectors the line does not hold are read from flash first, so the erase
+ * does not lose them. The caller must hold s_lock.
+ *
+ * @param line Line to write back.
+ * @return ESP_OK on success, or a wear-levelling error code.
+ */
+static esp_err_t cache_flush_line(cache_line_t *line)
+{
+    if (line->base == CACHE_UNUSED_LINE) {
+        return ESP_OK;
+    }
+
+    for (uint32_t sector = 0; sector < CACHE_SECTORS_PER_LINE; ++sector) {
+        if ((line->present & (1UL << sector)) == 0) {
+            ESP_RETURN_ON_ERROR(__real_wl_read(s_wl_handle,
+                                               line->base + (sector * CACHE_SECTOR_SIZE),
+                                               &line->data[sector * CACHE_SECTOR_SIZE],
+                                               CACHE_SECTOR_SIZE),
+                                TAG, "Fill read failed");
+            ++s_stats.sectors_filled;
+        }
+    }
+
+    ESP_RETURN_ON_ERROR(__real_wl_erase_range(s_wl_handle, line->base, CACHE_LINE_SIZE),
+                        TAG, "Line erase failed");
+    ESP_RETURN_ON_ERROR(__real_wl_write(s_wl_handle, line->base, line->data, CACHE_LINE_SIZE),
+                        TAG, "Line write failed");
+
+    ++s_stats.lines_flushed;
+    line->base = CACHE_UNUSED_LINE;
+    line->present = 0;
+    return ESP_OK;
+}
+
+/**
+ * @brief Returns the line of an erase block, allocating one if needed.
+ *
+ * A free line is used first. Otherwise the least recently used line is
+ * written back. The caller must hold s_lock.
+ *
+ * @param base Line address.
+ * @param line Output pointer for the line.
+ * @return ESP_OK on success, or the error of the evicted line's write-back.
+ */
+static esp_err_t cache_get_line(uint32_t base, cache_line_t **line)
+{
+    cache_line_t *victim = NULL;
+
+    for (size_t index = 0; index < s_line_count; ++index) {
+        cache_line_t *candidate = &s_lines[index];
+
+        if (candidate->base == base) {
+            *line = candidate;
+            candidate->last_use = ++s_use_counter;
+            return ESP_OK;
+        }
+
+        if ((victim == NULL) ||
+            (candidate->base == CACHE_UNUSED_LINE) ||
+            ((victim->base != CACHE_UNUSED_LINE) &&
+             ((int32_t)(candidate->last_use - victim->last_use) < 0))) {
+            victim = candidate;
+        }
+    }
+
+    if (victim->base != CACHE_UNUSED_LINE) {
+        ++s_stats.evictions;
+        ESP_RETURN_ON_ERROR(cache_flush_line(victim), TAG, "Eviction failed");
+    }
+
+    victim->base = base;
+    victim->present = 0;
+    victim->last_use = ++s_use_counter;
+    *line = victim;
+    return ESP_OK;
+}
+
+/**
+ * @brief Writes back every line that overlaps an address range.
+ *
+ * Used before an access the cache cannot merge. The caller must hold s_lock.
+ */
+static esp_err_t cache_flush_range(size_t addr, size_t size)
+{
+    for (size_t index = 0; index < s_line_count; ++index) {
+        cache_line_t *line = &s_lines[index];
+
+        if ((line->base != CACHE_UNUSED_LINE) &&
+            (line->base < (addr + size)) &&
+            ((line->base + CACHE_LINE_SIZE) > addr)) {
+            ESP_RETURN_ON_ERROR(cache_flush_line(line), TAG, "Range flush failed");
+        }
+    }
+
+    return ESP_OK;
+}
+
+/**
+ * @brief Restarts the idle write-back timer after a cached write.
+ */
+static void cache_touch_idle_timer(void)
+{
+    (void)esp_timer_stop(s_idle_timer);
+    (void)esp_timer_start_once(s_idle_timer, (uint64_t)CONFIG_APP_MSC_CACHE_IDLE_FLUSH_MS * 1000U);
+}
+
+/**
+ * @brief Wakes the flush task when no write arrived for the idle period.
+ */
+static void cache_idle_timer_callback(void *arg)
+{
+    (void)arg;
+    xTaskNotifyGive(s_flush_task);
+}
+
+/**
+ * @brief Writes the cache back outside the esp_timer task.
+ */
+static void cache_flush_task(void *arg)
+{
+    (void)arg;
+
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        if (msc_cache_flush() != ESP_OK) {
+            ESP_LOGE(TAG, "Idle write-back failed");
+        }
+    }
+}
+
+/**
+ * @brief Adds one transfer to a throughput window.
+ */
+static void cache_record_transfer(transfer_window_t *window, int64_t start_us, int32_t bytes)
+{
+    const int64_t end_us = esp_timer_get_time();
+
+    if (bytes <= 0) {
+        return;
+    }
+
+    portENTER_CRITICAL(&s_window_lock);
+    if (window->bytes == 0) {
+        window->first_us = start_us;
+    }
+    window->bytes += (uint64_t)bytes;
+    window->last_us = end_us;
+    portEXIT_CRITICAL(&s_window_lock);
+}
+
+/**
+ * @brief Converts a window for the caller and clears it.
+ */
+static void cache_take_window(transfer_window_t *window, msc_cache_window_t *out)
+{
+    out->bytes = window->bytes;
+    out->active_us = (window->bytes > 0) ? (uint32_t)(window->last_us - window->first_us) : 0;
+    window->bytes = 0;
+}
+
+esp_err_t __wrap_wl_read(wl_handle_t handle, size_t src_addr, void *dest, size_t size)
+{
+    if (!cache_is_active(handle)) {
+        return __real_wl_read(handle, src_addr, dest, size);
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+
+    esp_err_t result = __real_wl_read(handle, src_addr, dest, size);
+
+    // Patch the flash contents with every cached sector in the range.
+    for (size_t index = 0; (result == ESP_OK) && (index < s_line_count); ++index) {
+        const cache_line_t *line = &s_lines[index];
+
+        if ((line->base == CACHE_UNUSED_LINE) ||
+            (line->base >= (src_addr + size)) ||
+            ((line->base + CACHE_LINE_SIZE) <= src_addr)) {
+            continue;
+        }
+
+        for (uint32_t sector = 0; sector < CACHE_SECTORS_PER_LINE; ++sector) {
+            const size_t sector_start = line->base + (sector * CACHE_SECTOR_SIZE);
+            const size_t copy_start = MAX(sector_start, src_addr);
+            const size_t copy_end = MIN(sector_start + CACHE_SECTOR_SIZE, src_addr + size);
+
+            if (((line->present & (1UL << sector)) != 0) && (copy_start < copy_end)) {
+                memcpy((uint8_t *)dest + (copy_start - src_addr),
+                       &line->data[copy_start - line->base],
+                       copy_end - copy_start);
+            }
+        }
+    }
+
+    xSemaphoreGive(s_lock);
+    return result;
+}
+
+esp_err_t __wrap_wl_erase_range(wl_handle_t handle, size_t start_addr, size_t size)
+{
+    if (!cache_is_active(handle)) {
+        return __real_wl_erase_range(handle, start_addr, size);
+    }
+
+    esp_err_t result = ESP_OK;
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+
+    if (!cache_is_sector_aligned(start_addr, size)) {
+        result = cache_flush_range(start_addr, size);
+        if (result == ESP_OK) {
+            result = __real_wl_erase_range(handle, start_addr, size);
+        }
+        xSemaphoreGive(s_lock);
+        return result;
+    }
+
+    size_t addr = start_addr;
+    const size_t end = start_addr + size;
+
+    while ((result == ESP_OK) && (addr < end)) {
+        const uint32_t base = (uint32_t)(addr - (addr % CACHE_LINE_SIZE));
+        const size_t chunk_end = MIN((size_t)base + CACHE_LINE_SIZE, end);
+
+        if ((addr == base) && (chunk_end == base + CACHE_LINE_SIZE)) {
+            // A whole block is erased directly; cached data for it is void.
+            cache_line_t *line = cache_find_line(base);
+            if (line != NULL) {
+                line->base = CACHE_UNUSED_LINE;
+                line->present = 0;
+            }
+            result = __real_wl_erase_range(handle, base, CACHE_LINE_SIZE);
+        } else {
+            cache_line_t *line = NULL;
+            result = cache_get_line(base, &line);
+
+            for (size_t sector_addr = addr; (result == ESP_OK) && (sector_addr < chunk_end);
+                 sector_addr += CACHE_SECTOR_SIZE) {
+                memset(&line->data[sector_addr - base], 0xFF, CACHE_SECTOR_SIZE);
+                line->present |= 1UL << ((sector_addr - base) / CACHE_SECTOR_SIZE);
+            }
+        }
+
+        addr = chunk_end;
+    }
+
+    cache_touch_idle_timer();
+    xSemaphoreGive(s_lock);
+    return result;
+}
+
+esp_err_t __wrap_wl_write(wl_handle_t handle, size_t dest_addr, const void *src, size_t size)
+{
+    if (!cache_is_active(handle)) {
+        return __real_wl_write(handle, dest_addr, src, size);
+    }
+
+    esp_err_t result = ESP_OK;
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+
+    if (!cache_is_sector_aligned(dest_addr, size)) {
+        result = cache_flush_range(dest_addr, size);
+        if (result == ESP_OK) {
+            result = __real_wl_write(handle, dest_addr, src, size);
+        }
+        xSemaphoreGive(s_lock);
+        return result;
+    }
+
+    for (size_t offset = 0; (result == ESP_OK) && (offset < size); offset += CACHE_SECTOR_SIZE) {
+        const size_t addr = dest_addr + offset;
+        const uint32_t base = (uint32_t)(addr - (addr % CACHE_LINE_SIZE));
+        const uint32_t sector_bit = 1UL << ((addr - base) / CACHE_SECTOR_SIZE);
+        const uint8_t *source = (const uint8_t *)src + offset;
+        cache_line_t *line = cache_find_line(base);
+
+        if ((line == NULL) || ((line->present & sector_bit) == 0)) {
+            // Only sectors erased through the cache can be merged. Anything
+            // else is written through; a later line flush reads it back.
+            result = __real_wl_write(handle, addr, source, CACHE_SECTOR_SIZE);
+            continue;
+        }
+
+        // Program semantics: a write can only clear bits.
+        uint8_t *target = &line->data[addr - base];
+        for (size_t index = 0; index < CACHE_SECTOR_SIZE; ++index) {
+            target[index] &= source[index];
+        }
+        line->last_use = ++s_use_counter;
+    }
+
+    cache_touch_idle_timer();
+    xSemaphoreGive(s_lock);
+    return result;
+}
+
+int32_t __wrap_tud_msc_scsi_cb(uint8_t lun, uint8_t const scsi_cmd[16], void *buffer, uint16_t bufsize)
+{
+    if ((scsi_cmd[0] != SCSI_CMD_SYNCHRONIZE_CACHE_10) &&
+        (scsi_cmd[0] != SCSI_CMD_SYNCHRONIZE_CACHE_16)) {
+        return __real_tud_msc_scsi_cb(lun, scsi_cmd, buffer, bufsize);
+    }
+
+    if (msc_cache_flush() != ESP_OK) {
+        // MEDIUM ERROR, WRITE ERROR
+        tud_msc_set_sense(lun, SCSI_SENSE_MEDIUM_ERROR, 0x0C, 0x00);
+        return -1;
+    }
+
+    return 0;
+}
+
+int32_t __wrap_tud_msc_read10_cb(uint8_t lun, uint32_t lba, uint32_t offset, void *buffer, uint32_t bufsize)
+{
+    const int64_t start_us = esp_timer_get_time();
+    const int32_t result = __real_tud_msc_read10_cb(lun, lba, offset, buffer, bufsize);
+
+    cache_record_transfer(&s_read_window, start_us, result);
+    return result;
+}
+
+int32_t __wrap_tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *buffer, uint32_t bufsize)
+{
+    const int64_t start_us = esp_timer_get_time();
+    const int32_t result = __real_tud_msc_write10_cb(lun, lba, offset, buffer, bufsize);
+
+    cache_record_transfer(&s_write_window, start_us, result);
+    return result;
+}
+
+esp_err_t msc_cache_init(wl_handle_t wl_handle)
+{
+#if !CONFIG_APP_MSC_WRITE_CACHE
+    (void)wl_handle;
+    ESP_LOGI(TAG, "Write cache disabled");
+    return ESP_OK;
+#endif
+
+    ESP_RETURN_ON_FALSE(wl_handle != WL_INVALID_HANDLE, ESP_ERR_INVALID_ARG, TAG, "Invalid volume");
+    ESP_RETURN_ON_FALSE(s_lines == NULL, ESP_ERR_INVALID_STATE, TAG, "Cache already started");
+
+    size_t line_count = CONFIG_APP_MSC_CACHE_LINES;
+    uint8_t *data = heap_caps_malloc(line_count * CACHE_LINE_SIZE, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+    if (data == NULL) {
+        line_count = MIN(line_count, CACHE_INTERNAL_MAX_LINES);
+        data = heap_caps_malloc(line_count * CACHE_LINE_SIZE, MALLOC_CAP_INTERNAL | MALLOC_CAP_8BIT);
+    }
+    ESP_RETURN_ON_FALSE(data != NULL, ESP_ERR_NO_MEM, TAG, "No memory for cache lines");
+
+    cache_line_t *lines = calloc(line_count, sizeof(cache_line_t));
+    s_lock = xSemaphoreCreateMutex();
+    if ((lines == NULL) || (s_lock == NULL)) {
+        free(lines);
+        free(data);
+        ESP_LOGE(TAG, "No memory for cache state");
+        return ESP_ERR_NO_MEM;
+    }
+
+    for (size_t index = 0; index < line_count; ++index) {
+        lines[index].base = CACHE_UNUSED_LINE;
+        lines[index].data = &data[index * CACHE_LINE_SIZE];
+    }
+
+    ESP_RETURN_ON_FALSE(xTaskCreate(cache_flush_task, "msc_flush", CACHE_FLUSH_TASK_STACK, NULL,
+                                    CACHE_FLUSH_TASK_PRIORITY, &s_flush_task) == pdPASS,
+                        ESP_ERR_NO_MEM, TAG, "Unable to create the flush task");
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = cache_idle_timer_callback,
+        .name = "msc_idle_flush",
+    };
+    ESP_RETURN_ON_ERROR(esp_timer_create(&timer_args, &s_idle_timer), TAG, "Unable to create the idle timer");
+
+    s_line_count = line_count;
+    s_wl_handle = wl_handle;
+    s_lines = lines;
+
+    ESP_LOGI(TAG, "Write cache: %u lines of %u bytes in %s RAM",
+             (unsigned)line_count,
+             (unsigned)CACHE_LINE_SIZE,
+             esp_ptr_external_ram(data) ? "external" : "internal");
+    return ESP_OK;
+}
+
+esp_err_t msc_cache_flush(void)
+{
+    esp_err_t result = ESP_OK;
+
+    if (s_lines == NULL) {
+        return ESP_OK;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    (void)esp_timer_stop(s_idle_timer);
+
+    // Keep going after an error so one bad block does not hold back the rest.
+    for (size_t index = 0; index < s_line_count; ++index) {
+        const esp_err_t line_result = cache_flush_line(&s_lines[index]);
+        if (result == ESP_OK) {
+            result = line_result;
+        }
+    }
+
+    xSemaphoreGive(s_lock);
+    return result;
+}
+
+void msc_cache_take_windows(msc_cache_window_t *reads, msc_cache_window_t *writes)
+{
+    portENTER_CRITICAL(&s_window_lock);
+    cache_take_window(&s_read_window, reads);
+    cache_take_window(&s_write_window, writes);
+    portEXIT_CRITICAL(&s_window_lock);
+}
+
+void msc_cache_get_stats(msc_cache_stats_t *stats)
+{
+    if (s_lines == NULL) {
+        memset(stats, 0, sizeof(*stats));
+        return;
+    }
+
+    xSemaphoreTake(s_lock, portMAX_DELAY);
+    *stats = s_stats;
+    xSemaphoreGive(s_lock);
+}
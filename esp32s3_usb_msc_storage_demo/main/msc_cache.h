@@ -0,0 +1,82 @@
+/**
+ * @file msc_cache.h
+ * @brief RAM write-back cache and throughput counters for the MSC volume.
+ *
+ * The MSC component writes every host sector with a wear-levelling erase
+ * followed by a write. On internal flash each of those 512-byte erases costs
+ * a full 4 KiB erase block. The cache sits between the MSC component and the
+ * wear-levelling layer, collects erased and written sectors in lines of one
+ * erase block, and writes each line back with a single erase.
+ *
+ * The calls are intercepted with the linker's --wrap option, so neither the
+ * MSC component nor the FAT driver needs to be changed.
+ */
+
+#ifndef MSC_CACHE_H
+#define MSC_CACHE_H
+
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "wear_levelling.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @brief Data moved by the host in one measurement window. */
+typedef struct {
+    uint64_t bytes;     /**< Bytes transferred by READ(10) or WRITE(10). */
+    uint32_t active_us; /**< Time from the first to the end of the last transfer. */
+} msc_cache_window_t;
+
+/** @brief Cache counters since startup. */
+typedef struct {
+    uint32_t lines_flushed;   /**< Lines written back to flash. */
+    uint32_t sectors_filled;  /**< Sectors read back to complete partial lines. */
+    uint32_t evictions;       /**< Lines written back to make room. */
+} msc_cache_stats_t;
+
+/**
+ * @brief Starts caching writes to one wear-levelling volume.
+ *
+ * Lines are allocated in PSRAM when it is available and in internal RAM
+ * otherwise, with fewer lines. Without this call, or when the cache is
+ * disabled in menuconfig, every access goes straight to wear levelling.
+ *
+ * @param wl_handle Volume used by the MSC storage adapter.
+ *
+ * @return ESP_OK on success, or an ESP-IDF error code.
+ */
+esp_err_t msc_cache_init(wl_handle_t wl_handle);
+
+/**
+ * @brief Writes every cached line back to flash.
+ *
+ * Called for SCSI SYNCHRONIZE CACHE, when the volume changes owner, and by
+ * the idle timer.
+ *
+ * @return ESP_OK on success, or the first wear-levelling error.
+ */
+esp_err_t msc_cache_flush(void);
+
+/**
+ * @brief Returns the host transfer windows and starts new ones.
+ *
+ * @param reads Output for READ(10) traffic.
+ * @param writes Output for WRITE(10) traffic.
+ */
+void msc_cache_take_windows(msc_cache_window_t *reads, msc_cache_window_t *writes);
+
+/**
+ * @brief Copies the cache counters.
+ *
+ * @param stats Output pointer.
+ */
+void msc_cache_get_stats(msc_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -1,10 +1,11 @@
 /**
  * @file usb_msc_storage_demo.c
- * @brief USB Mass Storage Class device backed by an internal FAT partition.
+ * @brief USB Mass Storage Class device backed by an internal FAT partition or an SD card.
  *
  * This example turns the ESP32-S3 into a USB flash drive. The project uses the
  * native USB-OTG peripheral, the Espressif TinyUSB component, a FAT file system,
- * and wear levelling over a dedicated internal flash partition.
+ * and either wear levelling over a dedicated internal flash partition or an SD
+ * card on the 4-bit SDMMC host.
  *
  * The firmware first gives the application exclusive ownership of the volume,
  * creates educational text files, and then transfers exclusive ownership to the
@@ -15,10 +16,15 @@
 #include <stdio.h>
 #include <string.h>
 
+#include "driver/sdmmc_host.h"
 #include "esp_err.h"
 #include "esp_check.h"
 #include "esp_log.h"
 #include "esp_partition.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "msc_cache.h"
+#include "sdmmc_cmd.h"
 #include "tinyusb.h"
 #include "tinyusb_default_config.h"
 #include "tinyusb_msc.h"
@@ -29,6 +35,13 @@
 #define STORAGE_PARTITION_LABEL "usb_storage"
 #define STORAGE_MAX_OPEN_FILES 4
 
+// An SD card is exposed as it is; only the internal partition gets the example files.
+#if CONFIG_APP_MSC_STORAGE_SDMMC
+#define STORAGE_CREATE_DEMO_FILES 0
+#else
+#define STORAGE_CREATE_DEMO_FILES 1
+#endif
+
 #define USB_VID 0x303A
 #define USB_PID 0x4013
 #define USB_BCD_DEVICE 0x0100
@@ -40,7 +53,11 @@
 static const char *TAG = "usb_msc_demo";
 
 static tinyusb_msc_storage_handle_t s_storage_handle = NULL;
+#if CONFIG_APP_MSC_STORAGE_SDMMC
+static sdmmc_card_t s_sd_card;
+#else
 static wl_handle_t s_wl_handle = WL_INVALID_HANDLE;
+#endif
 
 enum {
     USB_INTERFACE_MSC = 0,
@@ -91,6 +108,49 @@ static const char *s_string_descriptors[] = {
     "Mass Storage Interface",
 };
 
+#if CONFIG_APP_MSC_STORAGE_SDMMC
+/** @brief Initializes an SD card on the SDMMC host in 4-bit mode.
+ *
+ * The SDMMC host moves data by DMA. A READ(10) or WRITE(10) transfer of several
+ * blocks becomes a single multi-block card command, so the host transfer size
+ * is passed straight through to the card.
+ *
+ * @param card Output card description used by the MSC storage adapter.
+ *
+ * @return ESP_OK when the card was detected and initialized, or an ESP-IDF error code.
+ */
+static esp_err_t initialize_sdmmc_storage(sdmmc_card_t *card)
+{
+    if (card == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    sdmmc_host_t host = SDMMC_HOST_DEFAULT();
+#if CONFIG_APP_MSC_SDMMC_HIGH_SPEED
+    host.max_freq_khz = SDMMC_FREQ_HIGHSPEED;
+#else
+    host.max_freq_khz = SDMMC_FREQ_DEFAULT;
+#endif
+
+    sdmmc_slot_config_t slot_config = SDMMC_SLOT_CONFIG_DEFAULT();
+    slot_config.width = 4;
+    slot_config.clk = CONFIG_APP_MSC_SDMMC_CLK_GPIO;
+    slot_config.cmd = CONFIG_APP_MSC_SDMMC_CMD_GPIO;
+    slot_config.d0 = CONFIG_APP_MSC_SDMMC_D0_GPIO;
+    slot_config.d1 = CONFIG_APP_MSC_SDMMC_D1_GPIO;
+    slot_config.d2 = CONFIG_APP_MSC_SDMMC_D2_GPIO;
+    slot_config.d3 = CONFIG_APP_MSC_SDMMC_D3_GPIO;
+    // Most card sockets have pull-ups; the internal ones cover boards without them.
+    slot_config.flags |= SDMMC_SLOT_FLAG_INTERNAL_PULLUP;
+
+    ESP_RETURN_ON_ERROR(host.init(), TAG, "SDMMC host initialization failed");
+    ESP_RETURN_ON_ERROR(sdmmc_host_init_slot(host.slot, &slot_config), TAG, "SDMMC slot initialization failed");
+    ESP_RETURN_ON_ERROR(sdmmc_card_init(&host, card), TAG, "No SD card detected");
+
+    sdmmc_card_print_info(stdout, card);
+    return ESP_OK;
+}
+#else
  /** @brief Initializes the flash storage for USB MSC operation.
   *
   * @param wl_handle Output pointer that receives the wear-levelling handle.
@@ -121,6 +181,7 @@ static esp_err_t initialize_flash_storage(wl_handle_t *wl_handle)
 
     return wl_mount(partition, wl_handle);
 }
+#endif
 
 /** @brief Writes text to a file on the application-owned FAT volume.
  *
@@ -245,6 +306,11 @@ static void storage_mount_changed_callback(tinyusb_msc_storage_handle_t handle,
     switch (event->id) {
     case TINYUSB_MSC_EVENT_MOUNT_START:
         ESP_LOGI(TAG, "Storage ownership transition started");
+
+        // An eject hands the volume back; cached sectors go to flash first.
+        if (msc_cache_flush() != ESP_OK) {
+            ESP_LOGE(TAG, "Write cache flush failed");
+        }
         break;
 
     case TINYUSB_MSC_EVENT_MOUNT_COMPLETE:
@@ -275,11 +341,8 @@ static void storage_mount_changed_callback(tinyusb_msc_storage_handle_t handle,
  */
 static esp_err_t initialize_msc_storage(void)
 {
-    ESP_RETURN_ON_ERROR(initialize_flash_storage(&s_wl_handle), TAG, "Flash storage initialization failed");
-
     tinyusb_msc_storage_config_t storage_config = {
         .mount_point = TINYUSB_MSC_STORAGE_MOUNT_USB,
-        .medium.wl_handle = s_wl_handle,
         .fat_fs = {
             .base_path = STORAGE_BASE_PATH,
             .config = {
@@ -291,10 +354,28 @@ static esp_err_t initialize_msc_storage(void)
         },
     };
 
+#if CONFIG_APP_MSC_STORAGE_SDMMC
+    ESP_RETURN_ON_ERROR(initialize_sdmmc_storage(&s_sd_card), TAG, "SD card initialization failed");
+
+    // A card may hold field data, so it is never reformatted behind the user's back.
+    storage_config.medium.card = &s_sd_card;
+    storage_config.fat_fs.config.format_if_mount_failed = false;
+
+    ESP_RETURN_ON_ERROR(
+        tinyusb_msc_new_storage_sdmmc(&storage_config, &s_storage_handle),
+        TAG,
+        "Unable to create the MSC storage adapter");
+#else
+    ESP_RETURN_ON_ERROR(initialize_flash_storage(&s_wl_handle), TAG, "Flash storage initialization failed");
+    ESP_RETURN_ON_ERROR(msc_cache_init(s_wl_handle), TAG, "Write cache initialization failed");
+
+    storage_config.medium.wl_handle = s_wl_handle;
+
     ESP_RETURN_ON_ERROR(
         tinyusb_msc_new_storage_spiflash(&storage_config, &s_storage_handle),
         TAG,
         "Unable to create the MSC storage adapter");
+#endif
 
     ESP_RETURN_ON_ERROR(
         tinyusb_msc_set_storage_callback(storage_mount_changed_callback, NULL),
@@ -351,9 +432,52 @@ static void log_storage_geometry(void)
     }
 }
 
+/**
+ * @brief Logs host read and write throughput once per interval with traffic.
+ *
+ * The rate is measured over the time between the first and the last transfer
+ * of the interval, so it matches what a copy on the host reports.
+ *
+ * @return void
+ */
+static void log_throughput_forever(void)
+{
+    const TickType_t interval = pdMS_TO_TICKS(CONFIG_APP_MSC_THROUGHPUT_LOG_S * 1000);
+
+    while (true) {
+        vTaskDelay(interval);
+
+        msc_cache_window_t reads;
+        msc_cache_window_t writes;
+        msc_cache_take_windows(&reads, &writes);
+
+        if ((reads.bytes == 0) && (writes.bytes == 0)) {
+            continue;
+        }
+
+        // Bytes per microsecond are MB/s.
+        ESP_LOGI(TAG,
+                 "Host read: %" PRIu64 " KiB at %.2f MB/s, write: %" PRIu64 " KiB at %.2f MB/s",
+                 reads.bytes / 1024,
+                 (reads.active_us > 0) ? ((double)reads.bytes / reads.active_us) : 0.0,
+                 writes.bytes / 1024,
+                 (writes.active_us > 0) ? ((double)writes.bytes / writes.active_us) : 0.0);
+
+#if CONFIG_APP_MSC_WRITE_CACHE
+        msc_cache_stats_t stats;
+        msc_cache_get_stats(&stats);
+        ESP_LOGI(TAG,
+                 "Write cache: %" PRIu32 " lines flushed, %" PRIu32 " evictions, %" PRIu32 " sectors filled",
+                 stats.lines_flushed,
+                 stats.evictions,
+                 stats.sectors_filled);
+#endif
+    }
+}
+
 /** @brief Main application entry point.
  *
- * Initializes the flash-backed FAT volume, creates educational files, installs
+ * Initializes the flash-backed or SD card FAT volume, creates educational files, installs
  * TinyUSB, and transfers the volume to the connected USB host.
  * 
  * @return void 
@@ -367,7 +491,9 @@ void app_main(void)
     ESP_ERROR_CHECK(initialize_msc_storage());
     
     // The example files are created before the USB host can access the volume to avoid conflicts.
-    ESP_ERROR_CHECK(create_demo_files());
+    if (STORAGE_CREATE_DEMO_FILES) {
+        ESP_ERROR_CHECK(create_demo_files());
+    }
     
     // Log the geometry for educational purposes, even though the application doesn't use it directly.
     log_storage_geometry();
@@ -384,4 +510,8 @@ void app_main(void)
     ESP_LOGI(TAG, "USB Mass Storage device is ready");
     ESP_LOGI(TAG, "Connect the native USB port and look for 'ESP32-S3 USB Storage Lab'");
     ESP_LOGI(TAG, "Safely eject the volume before unplugging it");
+
+    if (CONFIG_APP_MSC_THROUGHPUT_LOG_S > 0) {
+        log_throughput_forever();
+    }
 }
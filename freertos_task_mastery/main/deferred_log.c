@@ -0,0 +1,336 @@
+/**
+ * @file deferred_log.c
+ * @brief Deferred binary logger with per-core lock-free rings.
+ *
+ * Each core owns one single-producer/single-consumer ring. A writer masks
+ * interrupts on its own core while it fills a slot, so no other task or ISR
+ * can write to that ring in between and no cross-core lock is needed; the
+ * only shared state is the head and tail indices, published with
+ * release/acquire ordering. The output task is the single consumer of every
+ * ring and merges them by timestamp.
+ */
+
+#include "deferred_log.h"
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_cpu.h"
+#include "esp_timer.h"
+#include "freertos/task.h"
+
+#define DLOG_LINE_LENGTH 256U
+#define DLOG_SPEC_LENGTH 16U
+#define DLOG_TASK_STACK 3072U
+
+typedef struct {
+    const char *format;
+    int64_t timestamp_us;
+    uint32_t arg_count;
+    uint64_t args[DLOG_MAX_ARGS];
+} dlog_record_t;
+
+typedef struct {
+    dlog_record_t records[DLOG_RING_RECORDS];
+    atomic_uint head;
+    atomic_uint tail;
+    atomic_uint dropped;
+} dlog_ring_t;
+
+static dlog_ring_t s_rings[portNUM_PROCESSORS];
+static TaskHandle_t s_output_task_handle = NULL;
+
+void dlog_write(const char *format, uint32_t arg_count, const uint64_t *args)
+{
+    if (arg_count > DLOG_MAX_ARGS) {
+        arg_count = DLOG_MAX_ARGS;
+    }
+
+    // Nothing else can run on this core until the mask is cleared
+    const UBaseType_t saved_mask = portSET_INTERRUPT_MASK_FROM_ISR();
+    dlog_ring_t *ring = &s_rings[esp_cpu_get_core_id()];
+
+    const unsigned int head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    const unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+
+    if ((head - tail) >= DLOG_RING_RECORDS) {
+        atomic_fetch_add_explicit(&ring->dropped, 1U, memory_order_relaxed);
+    } else {
+        dlog_record_t *record = &ring->records[head % DLOG_RING_RECORDS];
+
+        record->format = format;
+        record->timestamp_us = esp_timer_get_time();
+        record->arg_count = arg_count;
+        memcpy(record->args, args, arg_count * sizeof(args[0]));
+
+        atomic_store_explicit(&ring->head, head + 1U, memory_order_release);
+    }
+
+    portCLEAR_INTERRUPT_MASK_FROM_ISR(saved_mask);
+}
+
+uint32_t dlog_dropped(void)
+{
+    uint32_t total = 0;
+
+    for (size_t core = 0; core < portNUM_PROCESSORS; core++) {
+        total += atomic_load_explicit(&s_rings[core].dropped, memory_order_relaxed);
+    }
+
+    return total;
+}
+
+/**
+ * @brief Formats one conversion specification with one raw argument.
+ *
+ * Args:
+ *     out: Destination buffer.
+ *     size: Space left in out, including the terminator.
+ *     spec: Null-terminated conversion specification such as "%-8lu".
+ *     length: Length modifier parsed from spec ("", "h", "hh", "l", "ll", "z", "j", "t").
+ *     conversion: Conversion character.
+ *     value: Raw argument as packed by DLOG_ARG().
+ *
+ * Returns:
+ *     snprintf() result, or -1 for an unsupported specification.
+ */
+static int format_one(char *out, size_t size, const char *spec, const char *length,
+                      char conversion, uint64_t value)
+{
+    switch (conversion) {
+    case 'd':
+    case 'i':
+        if (strcmp(length, "ll") == 0) {
+            return snprintf(out, size, spec, (long long)value);
+        } else if (strcmp(length, "l") == 0) {
+            return snprintf(out, size, spec, (long)value);
+        } else if (strcmp(length, "j") == 0) {
+            return snprintf(out, size, spec, (intmax_t)value);
+        } else if ((strcmp(length, "z") == 0) || (strcmp(length, "t") == 0)) {
+            return snprintf(out, size, spec, (ptrdiff_t)value);
+        }
+        return snprintf(out, size, spec, (int)value);
+
+    case 'u':
+    case 'o':
+    case 'x':
+    case 'X':
+        if (strcmp(length, "ll") == 0) {
+            return snprintf(out, size, spec, (unsigned long long)value);
+        } else if (strcmp(length, "l") == 0) {
+            return snprintf(out, size, spec, (unsigned long)value);
+        } else if (strcmp(length, "j") == 0) {
+            return snprintf(out, size, spec, (uintmax_t)value);
+        } else if ((strcmp(length, "z") == 0) || (strcmp(length, "t") == 0)) {
+            return snprintf(out, size, spec, (size_t)value);
+        }
+        return snprintf(out, size, spec, (unsigned int)value);
+
+    case 'c':
+        return snprintf(out, size, spec, (int)value);
+
+    case 'f':
+    case 'F':
+    case 'e':
+    case 'E':
+    case 'g':
+    case 'G':
+    case 'a':
+    case 'A': {
+        union {
+            uint64_t u;
+            double d;
+        } bits = { .u = value };
+
+        return snprintf(out, size, spec, bits.d);
+    }
+
+    case 's': {
+        const char *text = (const char *)(uintptr_t)value;
+        return snprintf(out, size, spec, (text != NULL) ? text : "(null)");
+    }
+
+    case 'p':
+        return snprintf(out, size, spec, (void *)(uintptr_t)value);
+
+    default:
+        return -1;
+    }
+}
+
+/**
+ * @brief Expands a record into text.
+ *
+ * Args:
+ *     out: Destination buffer.
+ *     size: Size of out.
+ *     record: Record to format.
+ */
+static void format_record(char *out, size_t size, const dlog_record_t *record)
+{
+    const char *p = record->format;
+    size_t pos = 0;
+    uint32_t next_arg = 0;
+
+    // Leading blank lines go before the timestamp
+    while ((*p == '\n') && (pos + 1U < size)) {
+        out[pos++] = *p++;
+    }
+
+    int written = snprintf(&out[pos], size - pos, "(%lu) ",
+                           (unsigned long)(record->timestamp_us / 1000));
+    pos += (written > 0) ? (size_t)written : 0U;
+
+    while ((*p != '\0') && (pos + 1U < size)) {
+        if (*p != '%') {
+            out[pos++] = *p++;
+            continue;
+        }
+
+        if (p[1] == '%') {
+            out[pos++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // Parse %[flags][width][.precision][length]conversion
+        const char *start = p++;
+        while ((*p != '\0') && (strchr("-+ #0", *p) != NULL)) {
+            p++;
+        }
+        while ((*p >= '0') && (*p <= '9')) {
+            p++;
+        }
+        if (*p == '.') {
+            p++;
+            while ((*p >= '0') && (*p <= '9')) {
+                p++;
+            }
+        }
+
+        const char *length_start = p;
+        while ((*p != '\0') && (strchr("hlzjt", *p) != NULL)) {
+            p++;
+        }
+
+        char length[3] = { 0 };
+        const size_t length_size = (size_t)(p - length_start);
+        const char conversion = *p;
+
+        if (conversion != '\0') {
+            p++;
+        }
+
+        char spec[DLOG_SPEC_LENGTH];
+        const size_t spec_size = (size_t)(p - start);
+
+        written = -1;
+        if ((length_size < sizeof(length)) && (spec_size < sizeof(spec)) &&
+            (next_arg < record->arg_count)) {
+            memcpy(length, length_start, length_size);
+            memcpy(spec, start, spec_size);
+            spec[spec_size] = '\0';
+            written = format_one(&out[pos], size - pos, spec, length, conversion,
+                                 record->args[next_arg]);
+            next_arg++;
+        }
+
+        if (written < 0) {
+            written = snprintf(&out[pos], size - pos, "<?>");
+        }
+
+        pos += ((size_t)written < (size - pos)) ? (size_t)written : (size - pos - 1U);
+    }
+
+    out[pos] = '\0';
+}
+
+/**
+ * @brief Formats and prints every queued record, oldest first across cores.
+ */
+static void drain_rings(void)
+{
+    static char line[DLOG_LINE_LENGTH];
+
+    while (true) {
+        dlog_ring_t *oldest = NULL;
+        const dlog_record_t *oldest_record = NULL;
+
+        for (size_t core = 0; core < portNUM_PROCESSORS; core++) {
+            dlog_ring_t *ring = &s_rings[core];
+            const unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+            const unsigned int head = atomic_load_explicit(&ring->head, memory_order_acquire);
+
+            if (head == tail) {
+                continue;
+            }
+
+            const dlog_record_t *record = &ring->records[tail % DLOG_RING_RECORDS];
+            if ((oldest_record == NULL) || (record->timestamp_us < oldest_record->timestamp_us)) {
+                oldest = ring;
+                oldest_record = record;
+            }
+        }
+
+        if (oldest == NULL) {
+            return;
+        }
+
+        format_record(line, sizeof(line), oldest_record);
+
+        // The slot may be reused as soon as the tail moves past it
+        atomic_fetch_add_explicit(&oldest->tail, 1U, memory_order_release);
+
+        fputs(line, stdout);
+    }
+}
+
+/**
+ * @brief Low-priority task that turns queued records into console output.
+ *
+ * Args:
+ *     parameter: Unused task parameter.
+ */
+static void dlog_output_task(void *parameter)
+{
+    uint32_t reported_drops = 0;
+
+    (void)parameter;
+
+    while (true) {
+        vTaskDelay(pdMS_TO_TICKS(DLOG_FLUSH_PERIOD_MS));
+
+        drain_rings();
+
+        const uint32_t drops = dlog_dropped();
+        if (drops != reported_drops) {
+            printf("[dlog] %lu record(s) dropped, ring full\n",
+                   (unsigned long)(drops - reported_drops));
+            reported_drops = drops;
+        }
+
+        fflush(stdout);
+    }
+}
+
+esp_err_t dlog_init(UBaseType_t priority)
+{
+    if (s_output_task_handle != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    if (xTaskCreate(dlog_output_task,
+                    "dlog_output",
+                    DLOG_TASK_STACK,
+                    NULL,
+                    priority,
+                    &s_output_task_handle) != pdPASS) {
+        s_output_task_handle = NULL;
+        return ESP_ERR_NO_MEM;
+    }
+
+    return ESP_OK;
+}
@@ -0,0 +1,123 @@
+/**
+ * @file deferred_log.h
+ * @brief Deferred binary logger with per-core lock-free rings.
+ *
+ * DLOG() does not format anything. It stores the format string pointer, a
+ * timestamp and the raw argument values in a fixed-size record in the ring
+ * of the calling core, which takes a few dozen cycles and never blocks. A
+ * low-priority output task later formats the records, oldest first across
+ * both cores, and writes them to the console.
+ *
+ * Because formatting happens later, the format string and every %s argument
+ * must stay valid forever (string literals or static strings). Up to
+ * DLOG_MAX_ARGS arguments of integer, floating-point, char pointer or void
+ * pointer type are supported; cast other pointer types to (void *). Width and
+ * precision given as '*' are not supported.
+ *
+ * When a ring is full the new record is dropped and counted; the output task
+ * reports the number of dropped records the next time it runs.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+#define DLOG_MAX_ARGS 6U
+#define DLOG_RING_RECORDS 32U
+#define DLOG_FLUSH_PERIOD_MS 20U
+
+/**
+ * @brief Logs a printf-style message without formatting it on the caller's time.
+ *
+ * Args:
+ *     format: String literal format; must outlive the call.
+ *     ...: Up to DLOG_MAX_ARGS arguments.
+ */
+#define DLOG(format, ...)                                                   \
+    dlog_write((format),                                                    \
+               DLOG_COUNT_ARGS(__VA_ARGS__),                                \
+               (const uint64_t[DLOG_MAX_ARGS]){ DLOG_MAP_ARGS(__VA_ARGS__) })
+
+/**
+ * @brief Starts the output task that formats and prints queued records.
+ *
+ * Records written before this call are kept and printed once it runs.
+ *
+ * Args:
+ *     priority: Output task priority; should be below every task that logs.
+ *
+ * Returns:
+ *     ESP_OK on success, ESP_ERR_INVALID_STATE if already started, or
+ *     ESP_ERR_NO_MEM if the task could not be created.
+ */
+esp_err_t dlog_init(UBaseType_t priority);
+
+/**
+ * @brief Appends one record to the calling core's ring. Use DLOG() instead.
+ *
+ * Safe from tasks and ISRs on either core.
+ *
+ * Args:
+ *     format: Format string; must outlive the call.
+ *     arg_count: Number of valid entries in args.
+ *     args: Raw argument values packed by DLOG_ARG().
+ */
+void dlog_write(const char *format, uint32_t arg_count, const uint64_t *args);
+
+/**
+ * @brief Returns the total number of records dropped because a ring was full.
+ */
+uint32_t dlog_dropped(void);
+
+/* ---------------------------------------------------------------------------
+ * Argument packing helpers used by DLOG().
+ * ------------------------------------------------------------------------- */
+
+static inline uint64_t dlog_pack_int(uint64_t value)
+{
+    return value;
+}
+
+static inline uint64_t dlog_pack_double(double value)
+{
+    union {
+        double d;
+        uint64_t u;
+    } bits = { .d = value };
+
+    return bits.u;
+}
+
+static inline uint64_t dlog_pack_ptr(const void *value)
+{
+    return (uint64_t)(uintptr_t)value;
+}
+
+/* Signed integers are sign-extended, so the formatter can narrow them back */
+#define DLOG_ARG(x) _Generic((x),                                           \
+        float: dlog_pack_double,                                            \
+        double: dlog_pack_double,                                           \
+        char *: dlog_pack_ptr,                                              \
+        const char *: dlog_pack_ptr,                                        \
+        void *: dlog_pack_ptr,                                              \
+        const void *: dlog_pack_ptr,                                        \
+        default: dlog_pack_int)(x)
+
+#define DLOG_COUNT_ARGS(...) \
+    DLOG_COUNT_ARGS_(0 __VA_OPT__(,) __VA_ARGS__, 6, 5, 4, 3, 2, 1, 0)
+#define DLOG_COUNT_ARGS_(z, a, b, c, d, e, f, n, ...) (n)
+
+#define DLOG_MAP_ARGS(...) \
+    DLOG_MAP_SELECT_(__VA_ARGS__ __VA_OPT__(,) DLOG_MAP_6, DLOG_MAP_5, DLOG_MAP_4, \
+                     DLOG_MAP_3, DLOG_MAP_2, DLOG_MAP_1, DLOG_MAP_0)(__VA_ARGS__)
+#define DLOG_MAP_SELECT_(a, b, c, d, e, f, m, ...) m
+#define DLOG_MAP_0(...) 0
+#define DLOG_MAP_1(a) DLOG_ARG(a)
+#define DLOG_MAP_2(a, ...) DLOG_ARG(a), DLOG_MAP_1(__VA_ARGS__)
+#define DLOG_MAP_3(a, ...) DLOG_ARG(a), DLOG_MAP_2(__VA_ARGS__)
+#define DLOG_MAP_4(a, ...) DLOG_ARG(a), DLOG_MAP_3(__VA_ARGS__)
+#define DLOG_MAP_5(a, ...) DLOG_ARG(a), DLOG_MAP_4(__VA_ARGS__)
+#define DLOG_MAP_6(a, ...) DLOG_ARG(a), DLOG_MAP_5(__VA_ARGS__)
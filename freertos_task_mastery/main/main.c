@@ -3,16 +3,16 @@
  * @brief Demonstrates practical FreeRTOS task design patterns with ESP-IDF.
  *
  * This example shows periodic tasks, event-driven tasks, queues, mutexes,
- * task notifications, event groups, task monitoring, task priorities, and
- * stack high-water-mark inspection.
+ * task notifications, event groups, task monitoring, task priorities,
+ * stack high-water-mark inspection, and deferred logging that keeps console
+ * output off the time-critical tasks.
  */
 
 #include <inttypes.h>
 #include <stdbool.h>
-#include <stdarg.h>
-#include <stdio.h>
 #include <string.h>
 
+#include "deferred_log.h"
 #include "driver/gpio.h"
 #include "esp_heap_caps.h"
 #include "esp_log.h"
@@ -20,7 +20,6 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/event_groups.h"
 #include "freertos/queue.h"
-#include "freertos/semphr.h"
 #include "freertos/task.h"
 
 #define STATUS_LED_GPIO GPIO_NUM_2
@@ -30,6 +29,7 @@
 #define SENSOR_ACTIVE_BIT BIT1
 #define SHUTDOWN_REQUEST_BIT BIT2
 #define NOTIFY_SAMPLE_READY BIT0
+#define DLOG_OUTPUT_PRIORITY 1U
 
 static const char *TAG = "task_mastery";
 
@@ -40,38 +40,11 @@ typedef struct {
 } sensor_sample_t;
 
 static QueueHandle_t s_sensor_queue = NULL;
-static SemaphoreHandle_t s_console_mutex = NULL;
 static EventGroupHandle_t s_system_events = NULL;
 static TaskHandle_t s_sensor_task_handle = NULL;
 static TaskHandle_t s_logger_task_handle = NULL;
 static TaskHandle_t s_notification_task_handle = NULL;
 
-/**
- * @brief Prints a formatted message while protecting the console output.
- *
- * Args:
- *     format: printf-compatible format string.
- *     ...: Values referenced by the format string.
- */
-static void safe_printf(const char *format, ...)
-{
-    va_list arguments;
-
-    if (s_console_mutex == NULL) {
-        return;
-    }
-
-    if (xSemaphoreTake(s_console_mutex, pdMS_TO_TICKS(100)) != pdTRUE) {
-        return;
-    }
-
-    va_start(arguments, format);
-    vprintf(format, arguments);
-    va_end(arguments);
-
-    xSemaphoreGive(s_console_mutex);
-}
-
 /**
  * @brief Configures the optional status LED GPIO.
  *
@@ -138,8 +111,8 @@ static void sensor_task(void *parameter)
         };
 
         if (xQueueSend(s_sensor_queue, &sample, pdMS_TO_TICKS(100)) != pdPASS) {
-            safe_printf("[sensor] Queue full. Sample %" PRIu32 " dropped.\n",
-                        sample.sample_number);
+            DLOG("[sensor] Queue full. Sample %" PRIu32 " dropped.\n",
+                 sample.sample_number);
         } else if (s_notification_task_handle != NULL) {
             xTaskNotify(s_notification_task_handle,
                         NOTIFY_SAMPLE_READY,
@@ -151,7 +124,7 @@ static void sensor_task(void *parameter)
     }
 
     xEventGroupClearBits(s_system_events, SENSOR_ACTIVE_BIT);
-    safe_printf("[sensor] Task shutting down cleanly.\n");
+    DLOG("[sensor] Task shutting down cleanly.\n");
     s_sensor_task_handle = NULL;
     vTaskDelete(NULL);
 }
@@ -170,10 +143,10 @@ static void logger_task(void *parameter)
 
     while (true) {
         if (xQueueReceive(s_sensor_queue, &sample, pdMS_TO_TICKS(250)) == pdPASS) {
-            safe_printf("[logger] Sample %" PRIu32 ": %.2f C at tick %" PRIu32 "\n",
-                        sample.sample_number,
-                        (double)sample.temperature_c,
-                        (uint32_t)sample.timestamp_ticks);
+            DLOG("[logger] Sample %" PRIu32 ": %.2f C at tick %" PRIu32 "\n",
+                 sample.sample_number,
+                 (double)sample.temperature_c,
+                 (uint32_t)sample.timestamp_ticks);
         }
 
         const EventBits_t bits = xEventGroupGetBits(s_system_events);
@@ -183,7 +156,7 @@ static void logger_task(void *parameter)
         }
     }
 
-    safe_printf("[logger] Queue drained. Task shutting down cleanly.\n");
+    DLOG("[logger] Queue drained. Task shutting down cleanly.\n");
     s_logger_task_handle = NULL;
     vTaskDelete(NULL);
 }
@@ -221,7 +194,7 @@ static void notification_task(void *parameter)
     }
 
     ESP_ERROR_CHECK(gpio_set_level(STATUS_LED_GPIO, 0));
-    safe_printf("[notify] Notification task shutting down cleanly.\n");
+    DLOG("[notify] Notification task shutting down cleanly.\n");
     s_notification_task_handle = NULL;
     vTaskDelete(NULL);
 }
@@ -236,7 +209,7 @@ static void notification_task(void *parameter)
 static void print_task_status(const char *name, TaskHandle_t handle)
 {
     if (handle == NULL) {
-        safe_printf("[monitor] %-18s not running\n", name);
+        DLOG("[monitor] %-18s not running\n", name);
         return;
     }
 
@@ -244,11 +217,11 @@ static void print_task_status(const char *name, TaskHandle_t handle)
     const UBaseType_t priority = uxTaskPriorityGet(handle);
     const eTaskState state = eTaskGetState(handle);
 
-    safe_printf("[monitor] %-18s state=%d priority=%u stack_hwm=%u bytes\n",
-                name,
-                (int)state,
-                (unsigned int)priority,
-                (unsigned int)high_water_mark);
+    DLOG("[monitor] %-18s state=%d priority=%u stack_hwm=%u bytes\n",
+         name,
+         (int)state,
+         (unsigned int)priority,
+         (unsigned int)high_water_mark);
 }
 
 /**
@@ -262,9 +235,9 @@ static void monitor_task(void *parameter)
     (void)parameter;
 
     while ((xEventGroupGetBits(s_system_events) & SHUTDOWN_REQUEST_BIT) == 0U) {
-        safe_printf("\n[monitor] Free heap: %u bytes, queued samples: %u\n",
-                    (unsigned int)heap_caps_get_free_size(MALLOC_CAP_8BIT),
-                    (unsigned int)uxQueueMessagesWaiting(s_sensor_queue));
+        DLOG("\n[monitor] Free heap: %u bytes, queued samples: %u\n",
+             (unsigned int)heap_caps_get_free_size(MALLOC_CAP_8BIT),
+             (unsigned int)uxQueueMessagesWaiting(s_sensor_queue));
 
         print_task_status("sensor_task", s_sensor_task_handle);
         print_task_status("logger_task", s_logger_task_handle);
@@ -273,7 +246,7 @@ static void monitor_task(void *parameter)
         vTaskDelay(pdMS_TO_TICKS(5000));
     }
 
-    safe_printf("[monitor] Monitor task shutting down.\n");
+    DLOG("[monitor] Monitor task shutting down.\n");
     vTaskDelete(NULL);
 }
 
@@ -285,12 +258,10 @@ static void monitor_task(void *parameter)
  */
 static bool create_rtos_objects(void)
 {
-    s_console_mutex = xSemaphoreCreateMutex();
     s_sensor_queue = xQueueCreate(LOGGER_QUEUE_LENGTH, sizeof(sensor_sample_t));
     s_system_events = xEventGroupCreate();
 
-    if ((s_console_mutex == NULL) ||
-        (s_sensor_queue == NULL) ||
+    if ((s_sensor_queue == NULL) ||
         (s_system_events == NULL)) {
         ESP_LOGE(TAG, "Failed to create one or more RTOS objects");
         return false;
@@ -368,6 +339,12 @@ void app_main(void)
     // Configure the optional status LED GPIO for visual feedback
     configure_status_led();
 
+    // Start the deferred log output task below every task that logs
+    if (dlog_init(DLOG_OUTPUT_PRIORITY) != ESP_OK) {
+        ESP_LOGE(TAG, "Failed to start deferred logger");
+        return;
+    }
+
     // Create all RTOS objects before starting any tasks
     if (!create_rtos_objects()) {
         ESP_LOGE(TAG, "Application initialization aborted");
@@ -0,0 +1,123 @@
+#include "bench.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define BENCH_MIN_BATCH_NS 20000000.0
+#define BENCH_REPEATS 9U
+#define BENCH_MAX_ITERATIONS ((size_t)1 << 30)
+
+static volatile uint32_t s_sink;
+
+uint64_t bench_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t ticks;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+    return ticks;
+#else
+    return 0U;
+#endif
+}
+
+bool bench_has_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void bench_sink(uint32_t value)
+{
+    s_sink ^= value;
+}
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec * 1e9 + (double)ts.tv_nsec;
+}
+
+static int compare_double(const void *left, const void *right)
+{
+    const double a = *(const double *)left;
+    const double b = *(const double *)right;
+    return (a > b) - (a < b);
+}
+
+void bench_measure(const bench_case_t *bench_case, bench_result_t *result)
+{
+    size_t iterations = 1U;
+
+    // Grow the batch until timer resolution and call overhead are noise.
+    for (;;) {
+        const double start = now_ns();
+        bench_case->run(bench_case->context, iterations);
+        const double elapsed = now_ns() - start;
+        if ((elapsed >= BENCH_MIN_BATCH_NS) || (iterations >= BENCH_MAX_ITERATIONS)) {
+            break;
+        }
+        iterations *= 2U;
+    }
+
+    double ns[BENCH_REPEATS];
+    double cycles_min = 0.0;
+
+    for (size_t repeat = 0; repeat < BENCH_REPEATS; ++repeat) {
+        const uint64_t cycles_start = bench_cycles();
+        const double start = now_ns();
+        bench_case->run(bench_case->context, iterations);
+        const double elapsed = now_ns() - start;
+        const double cycles = (double)(bench_cycles() - cycles_start) / (double)iterations;
+
+        ns[repeat] = elapsed / (double)iterations;
+        if ((repeat == 0U) || (cycles < cycles_min)) {
+            cycles_min = cycles;
+        }
+    }
+
+    qsort(ns, BENCH_REPEATS, sizeof(ns[0]), compare_double);
+    result->ns_per_op_min = ns[0];
+    result->ns_per_op_median = ns[BENCH_REPEATS / 2U];
+    result->cycles_per_op_min = bench_has_cycles() ? cycles_min : 0.0;
+    result->iterations = iterations;
+}
+
+double bench_threshold(const char *path, const char *name)
+{
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        return -1.0;
+    }
+
+    char line[256];
+    double threshold = -1.0;
+    while (fgets(line, sizeof(line), file) != NULL) {
+        char *comment = strchr(line, '#');
+        if (comment != NULL) {
+            *comment = '\0';
+        }
+
+        char case_name[128];
+        double value;
+        if ((sscanf(line, "%127s %lf", case_name, &value) == 2) &&
+            (strcmp(case_name, name) == 0)) {
+            threshold = value;
+            break;
+        }
+    }
+
+    fclose(file);
+    return threshold;
+}
@@ -0,0 +1,72 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Runs @p iterations operations of one benchmark case.
+ *
+ * The harness times whole batches, so the function should loop
+ * internally and feed its results into bench_sink() to keep the compiler
+ * from removing the work.
+ */
+typedef void (*bench_fn_t)(void *context, size_t iterations);
+
+typedef struct {
+    const char *name;
+    bench_fn_t run;
+    void *context;
+} bench_case_t;
+
+typedef struct {
+    double ns_per_op_min;
+    double ns_per_op_median;
+    double cycles_per_op_min;   /**< 0 when no cycle counter is available. */
+    size_t iterations;          /**< Operations per timed batch. */
+} bench_result_t;
+
+/**
+ * @brief Reads the host cycle counter.
+ *
+ * rdtsc on x86-64 (a constant-rate reference clock on current CPUs, not
+ * core clock cycles), the virtual counter on AArch64, 0 elsewhere.
+ */
+uint64_t bench_cycles(void);
+
+/** Returns true when bench_cycles() reads a real counter. */
+bool bench_has_cycles(void);
+
+/** Keeps a computed value alive. */
+void bench_sink(uint32_t value);
+
+/**
+ * @brief Measures one case.
+ *
+ * The batch size is doubled until a batch takes at least the minimum
+ * batch time, then several batches are timed. The minimum is the figure
+ * used for regression checks because it is the least disturbed by the
+ * rest of the system; the median shows how noisy the run was.
+ */
+void bench_measure(const bench_case_t *bench_case, bench_result_t *result);
+
+/**
+ * @brief Looks up the ns/op ceiling of a case in a thresholds file.
+ *
+ * Lines hold "<case name> <max ns/op>"; '#' starts a comment.
+ *
+ * @return The ceiling, or a negative value when the file or the case is
+ *         missing.
+ */
+double bench_threshold(const char *path, const char *name);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
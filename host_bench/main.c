@@ -0,0 +1,460 @@
+/*
+ * Host micro-benchmarks for the pure-logic components of the firmware
+ * projects in this repository.
+ *
+ * The sources are compiled unchanged from their projects; port/ supplies
+ * the few ESP-IDF headers they include. Every case runs the real function
+ * on realistic inputs and reports ns/op, and results can be checked
+ * against a thresholds file so a change that slows a hot path fails the
+ * run.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bench.h"
+
+#include "climate_controller.h"
+#include "lockfree_ring.h"
+#include "mesh_crc16.h"
+#include "mesh_protocol.h"
+#include "pid_controller.h"
+#include "pid_f32.h"
+#include "pid_q16.h"
+#include "simulated_motor.h"
+
+#ifndef HOST_BENCH_THRESHOLDS
+#define HOST_BENCH_THRESHOLDS "thresholds.txt"
+#endif
+
+#define CRC_BUFFER_SIZE MESH_MAX_PACKET_SIZE
+
+// ---------------------------------------------------------------------------
+// Inputs
+// ---------------------------------------------------------------------------
+
+// Measurement trace for the PID cases: a slow ramp with a little ripple, so
+// the controllers see changing errors instead of a constant input.
+#define TRACE_LENGTH 256U
+
+static float s_trace[TRACE_LENGTH];
+static pid_q16_t s_trace_q16[TRACE_LENGTH];
+static int16_t s_temperature_trace[TRACE_LENGTH];
+static uint8_t s_crc_buffer[CRC_BUFFER_SIZE];
+
+static void init_inputs(void)
+{
+    for (size_t i = 0; i < TRACE_LENGTH; ++i) {
+        const float ripple = (float)((i * 37U) % 11U) - 5.0f;
+        s_trace[i] = 800.0f + (float)i * 2.0f + ripple;
+        s_trace_q16[i] = pid_q16_from_float(s_trace[i]);
+        s_temperature_trace[i] = (int16_t)(20 + (int)((i / 8U) % 20U));
+    }
+
+    for (size_t i = 0; i < sizeof(s_crc_buffer); ++i) {
+        s_crc_buffer[i] = (uint8_t)(i * 131U + 7U);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// PID controllers
+// ---------------------------------------------------------------------------
+
+static void bench_pid_f32(void *context, size_t iterations)
+{
+    (void)context;
+    pid_f32_t pid;
+    pid_f32_init(&pid, 0.08f, 0.6f, 0.002f, 0.01f, 0.0f, 100.0f);
+    pid_f32_set_integral_limits(&pid, -100.0f, 100.0f);
+    pid_f32_set_derivative_filter(&pid, 0.2f);
+
+    float sum = 0.0f;
+    for (size_t i = 0; i < iterations; ++i) {
+        sum += pid_f32_compute(&pid, 1200.0f, s_trace[i % TRACE_LENGTH]);
+    }
+    bench_sink((uint32_t)sum);
+}
+
+static void bench_pid_q16(void *context, size_t iterations)
+{
+    (void)context;
+    pid_q16_controller_t pid;
+    pid_q16_init(&pid,
+                 pid_q16_from_float(0.08f),
+                 pid_q16_from_float(0.6f),
+                 pid_q16_from_float(0.002f),
+                 pid_q16_from_float(0.01f),
+                 pid_q16_from_float(0.0f),
+                 pid_q16_from_float(100.0f));
+
+    const pid_q16_t setpoint = pid_q16_from_float(1200.0f);
+    uint32_t sum = 0U;
+    for (size_t i = 0; i < iterations; ++i) {
+        sum += (uint32_t)pid_q16_compute(&pid, setpoint, s_trace_q16[i % TRACE_LENGTH]);
+    }
+    bench_sink(sum);
+}
+
+static void bench_pid_controller(void *context, size_t iterations)
+{
+    (void)context;
+    const pid_config_t config = {
+        .kp = 2.0f,
+        .ki = 0.5f,
+        .kd = 0.1f,
+        .sample_time_s = 0.01f,
+        .output_min = -100.0f,
+        .output_max = 100.0f,
+        .integral_min = -50.0f,
+        .integral_max = 50.0f,
+        .derivative_filter_tau_s = 0.05f,
+    };
+    pid_controller_t pid;
+    pid_init(&pid, &config);
+    pid_set_setpoint(&pid, 1200.0f);
+
+    float sum = 0.0f;
+    for (size_t i = 0; i < iterations; ++i) {
+        float output;
+        pid_compute(&pid, s_trace[i % TRACE_LENGTH], &output);
+        sum += output;
+    }
+    bench_sink((uint32_t)sum);
+}
+
+// ---------------------------------------------------------------------------
+// Mesh protocol
+// ---------------------------------------------------------------------------
+
+typedef uint16_t (*crc_fn_t)(const uint8_t *data, size_t length);
+
+typedef struct {
+    crc_fn_t crc;
+    size_t length;
+} crc_case_t;
+
+static void bench_crc(void *context, size_t iterations)
+{
+    const crc_case_t *crc_case = context;
+    uint32_t sum = 0U;
+    for (size_t i = 0; i < iterations; ++i) {
+        // Vary one byte so consecutive calls cannot be folded together.
+        s_crc_buffer[0] = (uint8_t)i;
+        sum += crc_case->crc(s_crc_buffer, crc_case->length);
+    }
+    bench_sink(sum);
+}
+
+static mesh_packet_t make_sensor_packet(void)
+{
+    mesh_packet_t packet = {
+        .version = MESH_PROTOCOL_VERSION,
+        .type = MESH_PACKET_SENSOR,
+        .source_id = 0x0102U,
+        .destination_id = 0x0001U,
+        .sequence = 42U,
+        .ttl = 4U,
+        .uptime_ms = 123456U,
+        .temperature_centi_c = 2315,
+        .humidity_centi_pct = 4870,
+        .battery_mv = 3710U,
+    };
+    mesh_packet_finalize(&packet);
+    return packet;
+}
+
+static void bench_packet_validate(void *context, size_t iterations)
+{
+    (void)context;
+    const mesh_packet_t packet = make_sensor_packet();
+    uint32_t failures = 0U;
+    for (size_t i = 0; i < iterations; ++i) {
+        failures += (mesh_packet_validate((const uint8_t *)&packet, sizeof(packet)) != ESP_OK);
+    }
+    bench_sink(failures);
+}
+
+typedef struct {
+    mesh_packet_t header;
+    mesh_sample_t samples[MESH_BATCH_MAX_SAMPLES];
+    uint8_t frame[MESH_MAX_PACKET_SIZE];
+    size_t frame_length;
+    uint32_t now_s;
+} batch_case_t;
+
+static void init_batch_case(batch_case_t *batch)
+{
+    memset(batch, 0, sizeof(*batch));
+    batch->header = make_sensor_packet();
+    batch->now_s = 100000U;
+    for (size_t i = 0; i < MESH_BATCH_MAX_SAMPLES; ++i) {
+        batch->samples[i].time_s = batch->now_s - (uint32_t)((MESH_BATCH_MAX_SAMPLES - i) * 30U);
+        batch->samples[i].temperature_centi_c = (int16_t)(2200 + (int)(i * 7U % 50U));
+        batch->samples[i].humidity_centi_pct = (uint16_t)(4500U + i * 3U);
+        batch->samples[i].battery_mv = (uint16_t)(3800U - i);
+    }
+
+    size_t encoded = 0U;
+    batch->frame_length = mesh_batch_encode(&batch->header, batch->samples,
+                                            MESH_BATCH_MAX_SAMPLES, batch->now_s,
+                                            batch->frame, sizeof(batch->frame), &encoded);
+}
+
+static void bench_batch_encode(void *context, size_t iterations)
+{
+    batch_case_t *batch = context;
+    uint8_t frame[MESH_MAX_PACKET_SIZE];
+    size_t total = 0U;
+    for (size_t i = 0; i < iterations; ++i) {
+        size_t encoded = 0U;
+        total += mesh_batch_encode(&batch->header, batch->samples, MESH_BATCH_MAX_SAMPLES,
+                                   batch->now_s, frame, sizeof(frame), &encoded);
+    }
+    bench_sink((uint32_t)total);
+}
+
+static void bench_batch_decode(void *context, size_t iterations)
+{
+    const batch_case_t *batch = context;
+    mesh_sample_t samples[MESH_BATCH_MAX_SAMPLES];
+    size_t total = 0U;
+    for (size_t i = 0; i < iterations; ++i) {
+        size_t count = 0U;
+        mesh_batch_decode(batch->frame, batch->frame_length, batch->now_s,
+                          samples, MESH_BATCH_MAX_SAMPLES, &count);
+        total += count;
+    }
+    bench_sink((uint32_t)total);
+}
+
+// ---------------------------------------------------------------------------
+// Lock-free ring (single thread: measures the uncontended fast path)
+// ---------------------------------------------------------------------------
+
+static lockfree_ring_t s_ring;
+
+static void bench_ring_push_pop(void *context, size_t iterations)
+{
+    (void)context;
+    lockfree_ring_init(&s_ring, LF_RING_MODE_SPSC);
+    timing_sample_t sample = { 0 };
+    uint32_t sum = 0U;
+    for (size_t i = 0; i < iterations; ++i) {
+        sample.sequence = (uint32_t)i;
+        lockfree_ring_push(&s_ring, &sample);
+        timing_sample_t out;
+        if (lockfree_ring_pop(&s_ring, &out)) {
+            sum += out.sequence;
+        }
+    }
+    bench_sink(sum);
+}
+
+// One op is one item: a full ring is filled, then drained in one batch.
+static void bench_ring_pop_batch(void *context, size_t iterations)
+{
+    (void)context;
+    lockfree_ring_init(&s_ring, LF_RING_MODE_SPSC);
+    timing_sample_t sample = { 0 };
+    timing_sample_t out[LF_RING_CAPACITY];
+    uint32_t sum = 0U;
+    size_t done = 0U;
+    while (done < iterations) {
+        size_t chunk = iterations - done;
+        if (chunk > LF_RING_CAPACITY) {
+            chunk = LF_RING_CAPACITY;
+        }
+        for (size_t i = 0; i < chunk; ++i) {
+            sample.sequence = (uint32_t)(done + i);
+            lockfree_ring_push(&s_ring, &sample);
+        }
+        const size_t popped = lockfree_ring_pop_batch(&s_ring, out, chunk);
+        sum += out[popped - 1U].sequence;
+        done += chunk;
+    }
+    bench_sink(sum);
+}
+
+// ---------------------------------------------------------------------------
+// Loose-coupling climate controller and simulated motor
+// ---------------------------------------------------------------------------
+
+static uint32_t s_fan_writes;
+
+static void fan_set_percent(uint8_t percent)
+{
+    s_fan_writes += percent;
+}
+
+static bool temperature_read(int16_t *temperature_c)
+{
+    *temperature_c = 25;
+    return true;
+}
+
+static void bench_climate_update(void *context, size_t iterations)
+{
+    (void)context;
+    static const fan_output_t fan = { .set_percent = fan_set_percent };
+    static const temperature_source_t source = { .read_celsius = temperature_read };
+    climate_controller_t controller;
+    climate_controller_init(&controller, &source, &fan, 30, 27);
+
+    uint32_t sum = 0U;
+    for (size_t i = 0; i < iterations; ++i) {
+        sum += climate_controller_update(&controller, s_temperature_trace[i % TRACE_LENGTH]);
+    }
+    bench_sink(sum + s_fan_writes);
+}
+
+static void bench_motor_update(void *context, size_t iterations)
+{
+    (void)context;
+    simulated_motor_init(0.0f);
+    for (size_t i = 0; i < iterations; ++i) {
+        simulated_motor_update(60.0f, (float)(i % 40U), 0.01f);
+    }
+    bench_sink((uint32_t)simulated_motor_get_speed_rpm());
+}
+
+// ---------------------------------------------------------------------------
+// Runner
+// ---------------------------------------------------------------------------
+
+// Known-answer checks, run before timing so a fast but wrong routine fails.
+static int run_checks(void)
+{
+    static const uint8_t check_input[] = "123456789";
+    const size_t check_length = sizeof(check_input) - 1U;
+    int failures = 0;
+
+    if (mesh_crc16_ccitt_bitwise(check_input, check_length) != 0x29B1U) {
+        fprintf(stderr, "check failed: crc16 bitwise\n");
+        failures++;
+    }
+    if (mesh_crc16_ccitt_slice4(check_input, check_length) != 0x29B1U) {
+        fprintf(stderr, "check failed: crc16 slice4\n");
+        failures++;
+    }
+    if (mesh_crc16_ccitt_slice4(s_crc_buffer, sizeof(s_crc_buffer)) !=
+        mesh_crc16_ccitt_bitwise(s_crc_buffer, sizeof(s_crc_buffer))) {
+        fprintf(stderr, "check failed: crc16 slice4 differs from bitwise\n");
+        failures++;
+    }
+
+    const mesh_packet_t packet = make_sensor_packet();
+    if (mesh_packet_validate((const uint8_t *)&packet, sizeof(packet)) != ESP_OK) {
+        fprintf(stderr, "check failed: finalized packet does not validate\n");
+        failures++;
+    }
+
+    return failures;
+}
+
+static void usage(const char *program)
+{
+    fprintf(stderr,
+            "usage: %s [--filter SUBSTRING] [--thresholds FILE] [--record FACTOR]\n"
+            "  --filter      run only cases whose name contains SUBSTRING\n"
+            "  --thresholds  ns/op ceilings to enforce (default: %s)\n"
+            "  --record      print a thresholds file with ceilings at FACTOR x the\n"
+            "                measured minimum instead of checking\n",
+            program, HOST_BENCH_THRESHOLDS);
+}
+
+int main(int argc, char **argv)
+{
+    const char *filter = NULL;
+    const char *thresholds = HOST_BENCH_THRESHOLDS;
+    double record_factor = 0.0;
+
+    for (int i = 1; i < argc; ++i) {
+        if ((strcmp(argv[i], "--filter") == 0) && (i + 1 < argc)) {
+            filter = argv[++i];
+        } else if ((strcmp(argv[i], "--thresholds") == 0) && (i + 1 < argc)) {
+            thresholds = argv[++i];
+        } else if ((strcmp(argv[i], "--record") == 0) && (i + 1 < argc)) {
+            record_factor = atof(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+    }
+
+    init_inputs();
+    if (run_checks() != 0) {
+        return 1;
+    }
+
+    static batch_case_t batch;
+    init_batch_case(&batch);
+
+    crc_case_t crc_bitwise_packet = { mesh_crc16_ccitt_bitwise, sizeof(mesh_packet_t) };
+    crc_case_t crc_slice4_packet = { mesh_crc16_ccitt_slice4, sizeof(mesh_packet_t) };
+    crc_case_t crc_bitwise_frame = { mesh_crc16_ccitt_bitwise, CRC_BUFFER_SIZE };
+    crc_case_t crc_slice4_frame = { mesh_crc16_ccitt_slice4, CRC_BUFFER_SIZE };
+
+    // The ROM CRC variant is not benchmarked: port/esp_rom_crc.h only
+    // stands in for it functionally.
+    const bench_case_t cases[] = {
+        { "pid_f32_compute", bench_pid_f32, NULL },
+        { "pid_q16_compute", bench_pid_q16, NULL },
+        { "pid_controller_compute", bench_pid_controller, NULL },
+        { "crc16_bitwise_packet", bench_crc, &crc_bitwise_packet },
+        { "crc16_slice4_packet", bench_crc, &crc_slice4_packet },
+        { "crc16_bitwise_250b", bench_crc, &crc_bitwise_frame },
+        { "crc16_slice4_250b", bench_crc, &crc_slice4_frame },
+        { "mesh_packet_validate", bench_packet_validate, NULL },
+        { "mesh_batch_encode_32", bench_batch_encode, &batch },
+        { "mesh_batch_decode_32", bench_batch_decode, &batch },
+        { "ring_push_pop", bench_ring_push_pop, NULL },
+        { "ring_pop_batch_per_item", bench_ring_pop_batch, NULL },
+        { "climate_controller_update", bench_climate_update, NULL },
+        { "simulated_motor_update", bench_motor_update, NULL },
+    };
+
+    if (record_factor > 0.0) {
+        printf("# ns/op ceilings recorded at %.2fx the measured minimum.\n", record_factor);
+    } else {
+        printf("%-28s %10s %10s %10s %10s\n", "case", "min ns/op", "med ns/op", "ticks/op", "limit");
+    }
+
+    int regressions = 0;
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); ++i) {
+        const bench_case_t *bench_case = &cases[i];
+        if ((filter != NULL) && (strstr(bench_case->name, filter) == NULL)) {
+            continue;
+        }
+
+        bench_result_t result;
+        bench_measure(bench_case, &result);
+
+        if (record_factor > 0.0) {
+            printf("%-28s %.1f\n", bench_case->name, result.ns_per_op_min * record_factor);
+            continue;
+        }
+
+        const double limit = bench_threshold(thresholds, bench_case->name);
+        const bool regressed = (limit > 0.0) && (result.ns_per_op_min > limit);
+        char limit_text[16] = "-";
+        if (limit > 0.0) {
+            snprintf(limit_text, sizeof(limit_text), "%.1f", limit);
+        }
+        printf("%-28s %10.2f %10.2f %10.1f %10s%s\n",
+               bench_case->name,
+               result.ns_per_op_min,
+               result.ns_per_op_median,
+               result.cycles_per_op_min,
+               limit_text,
+               regressed ? "  REGRESSION" : "");
+        regressions += regressed;
+    }
+
+    fflush(stdout);
+    if (regressions != 0) {
+        fprintf(stderr, "%d case(s) slower than their threshold\n", regressions);
+        return 1;
+    }
+    return 0;
+}
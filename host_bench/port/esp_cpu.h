@@ -0,0 +1,11 @@
+/* Host stand-in for ESP-IDF esp_cpu.h. */
+#pragma once
+
+#include <stdint.h>
+
+#include "bench.h"
+
+static inline uint32_t esp_cpu_get_cycle_count(void)
+{
+    return (uint32_t)bench_cycles();
+}